@@ -13,19 +13,21 @@ AssetManager::AssetManager() = default;
 
 AssetManager::~AssetManager() = default;
 
-void AssetManager::PushFront(std::unique_ptr<AssetResolver> resolver) {
+void AssetManager::PushFront(std::shared_ptr<AssetResolver> resolver) {
   if (resolver == nullptr || !resolver->IsValid()) {
     return;
   }
 
+  std::scoped_lock lock(resolvers_mutex_);
   resolvers_.push_front(std::move(resolver));
 }
 
-void AssetManager::PushBack(std::unique_ptr<AssetResolver> resolver) {
+void AssetManager::PushBack(std::shared_ptr<AssetResolver> resolver) {
   if (resolver == nullptr || !resolver->IsValid()) {
     return;
   }
 
+  std::scoped_lock lock(resolvers_mutex_);
   resolvers_.push_back(std::move(resolver));
 }
 
@@ -35,8 +37,9 @@ void AssetManager::UpdateResolverByType(
   if (updated_asset_resolver == nullptr) {
     return;
   }
+  std::scoped_lock lock(resolvers_mutex_);
   bool updated = false;
-  std::deque<std::unique_ptr<AssetResolver>> new_resolvers;
+  Resolvers new_resolvers;
   for (auto& old_resolver : resolvers_) {
     if (!updated && old_resolver->GetType() == type) {
       // Push the replacement updated resolver in place of the old_resolver.
@@ -53,19 +56,31 @@ void AssetManager::UpdateResolverByType(
   resolvers_.swap(new_resolvers);
 }
 
-std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
+AssetManager::Resolvers AssetManager::TakeResolvers() {
+  std::scoped_lock lock(resolvers_mutex_);
   return std::move(resolvers_);
 }
 
+AssetManager::Resolvers AssetManager::GetResolvers() const {
+  std::scoped_lock lock(resolvers_mutex_);
+  return resolvers_;
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
   if (asset_name.size() == 0) {
     return nullptr;
   }
+  return FindAsMapping(GetResolvers(), asset_name);
+}
+
+std::unique_ptr<fml::Mapping> AssetManager::FindAsMapping(
+    const Resolvers& resolvers,
+    const std::string& asset_name) {
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
-  for (const auto& resolver : resolvers_) {
+  for (const auto& resolver : resolvers) {
     auto mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
       return mapping;
@@ -85,7 +100,7 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMappings", "pattern",
                asset_pattern.c_str());
-  for (const auto& resolver : resolvers_) {
+  for (const auto& resolver : GetResolvers()) {
     auto resolver_mappings = resolver->GetAsMappings(asset_pattern, subdir);
     mappings.insert(mappings.end(),
                     std::make_move_iterator(resolver_mappings.begin()),
@@ -94,8 +109,92 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   return mappings;
 }
 
+namespace {
+
+// The assets of one call to |AssetManager::GetAsMappingsAsync|.
+struct AsyncLoadBatch {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<fml::Mapping>> mappings;
+  size_t remaining;
+  fml::RefPtr<fml::TaskRunner> callback_task_runner;
+  AssetManager::MappingsCallback callback;
+};
+
+void CompleteBatch(const std::shared_ptr<AsyncLoadBatch>& batch) {
+  batch->callback_task_runner->PostTask([batch]() {
+    batch->callback(std::move(batch->mappings));
+  });
+}
+
+}  // namespace
+
+void AssetManager::GetAsMappingsAsync(
+    std::vector<std::string> asset_names,
+    std::shared_ptr<fml::ConcurrentTaskRunner> load_task_runner,
+    fml::RefPtr<fml::TaskRunner> callback_task_runner,
+    MappingsCallback callback) {
+  TRACE_EVENT0("flutter", "AssetManager::GetAsMappingsAsync");
+  auto batch = std::make_shared<AsyncLoadBatch>();
+  batch->mappings.resize(asset_names.size());
+  batch->remaining = asset_names.size();
+  batch->callback_task_runner = std::move(callback_task_runner);
+  batch->callback = std::move(callback);
+  if (asset_names.empty()) {
+    CompleteBatch(batch);
+    return;
+  }
+
+  // The loads use the resolvers of the time of the call, which stay alive
+  // even if the asset manager changes while they run.
+  auto resolvers = std::make_shared<const Resolvers>(GetResolvers());
+
+  for (size_t i = 0; i < asset_names.size(); i++) {
+    LoadCallback on_loaded = [batch, i](std::shared_ptr<fml::Mapping> mapping) {
+      bool done = false;
+      {
+        std::scoped_lock lock(batch->mutex);
+        batch->mappings[i] = std::move(mapping);
+        done = --batch->remaining == 0;
+      }
+      if (done) {
+        CompleteBatch(batch);
+      }
+    };
+
+    bool is_first_request = false;
+    {
+      std::scoped_lock lock(pending_loads_mutex_);
+      auto& waiters = pending_loads_[asset_names[i]];
+      is_first_request = waiters.empty();
+      waiters.push_back(std::move(on_loaded));
+    }
+    if (is_first_request) {
+      load_task_runner->PostTask([self = shared_from_this(), resolvers,
+                                  asset_name = asset_names[i]]() {
+        self->FinishLoad(asset_name, FindAsMapping(*resolvers, asset_name));
+      });
+    }
+  }
+}
+
+void AssetManager::FinishLoad(const std::string& asset_name,
+                              std::shared_ptr<fml::Mapping> mapping) {
+  std::vector<LoadCallback> waiters;
+  {
+    std::scoped_lock lock(pending_loads_mutex_);
+    auto found = pending_loads_.find(asset_name);
+    FML_DCHECK(found != pending_loads_.end());
+    waiters = std::move(found->second);
+    pending_loads_.erase(found);
+  }
+  for (const auto& waiter : waiters) {
+    waiter(mapping);
+  }
+}
+
 // |AssetResolver|
 bool AssetManager::IsValid() const {
+  std::scoped_lock lock(resolvers_mutex_);
   return resolvers_.size() > 0;
 }
 
@@ -6,25 +6,36 @@
 #define FLUTTER_ASSETS_ASSET_MANAGER_H_
 
 #include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <optional>
 #include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/task_runner.h"
 
 namespace flutter {
 
-class AssetManager final : public AssetResolver {
+class AssetManager final : public AssetResolver,
+                           public std::enable_shared_from_this<AssetManager> {
  public:
+  using MappingsCallback =
+      std::function<void(std::vector<std::shared_ptr<fml::Mapping>>)>;
+  using Resolvers = std::deque<std::shared_ptr<AssetResolver>>;
+
   AssetManager();
 
   ~AssetManager() override;
 
-  void PushFront(std::unique_ptr<AssetResolver> resolver);
+  void PushFront(std::shared_ptr<AssetResolver> resolver);
 
-  void PushBack(std::unique_ptr<AssetResolver> resolver);
+  void PushBack(std::shared_ptr<AssetResolver> resolver);
 
   //--------------------------------------------------------------------------
   /// @brief      Replaces an asset resolver of the specified `type` with
@@ -54,7 +65,12 @@ class AssetManager final : public AssetResolver {
       std::unique_ptr<AssetResolver> updated_asset_resolver,
       AssetResolver::AssetResolverType type);
 
-  std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
+  //--------------------------------------------------------------------------
+  /// @brief      Removes all the resolvers from the asset manager. The
+  ///             asynchronous loads that are in flight keep using the
+  ///             resolvers they started with.
+  ///
+  Resolvers TakeResolvers();
 
   // |AssetResolver|
   bool IsValid() const override;
@@ -74,8 +90,62 @@ class AssetManager final : public AssetResolver {
       const std::string& asset_pattern,
       const std::optional<std::string>& subdir) const override;
 
+  //--------------------------------------------------------------------------
+  /// @brief      A copy of the resolvers of the asset manager, to look up
+  ///             assets on another thread with |FindAsMapping| while the
+  ///             asset manager may change.
+  ///
+  Resolvers GetResolvers() const;
+
+  //--------------------------------------------------------------------------
+  /// @brief      Looks up an asset in the given resolvers, in order.
+  ///
+  static std::unique_ptr<fml::Mapping> FindAsMapping(
+      const Resolvers& resolvers,
+      const std::string& asset_name);
+
+  //--------------------------------------------------------------------------
+  /// @brief      Loads the assets with the given names without blocking the
+  ///             calling thread.
+  ///
+  ///             Every asset is looked up on `load_task_runner`, so that the
+  ///             reads of different assets run in parallel. Concurrent
+  ///             requests for an asset that is already being loaded wait for
+  ///             that load instead of reading it again, and share its
+  ///             mapping.
+  ///
+  ///             The asset manager must be owned by a `std::shared_ptr`, which
+  ///             the loads hold on to until they are done. The loads use the
+  ///             resolvers of the asset manager at the time of the call.
+  ///
+  /// @param[in]  asset_names           The names of the assets to load.
+  /// @param[in]  load_task_runner      The task runner to read assets on.
+  /// @param[in]  callback_task_runner  The task runner to invoke `callback`
+  ///                                   on.
+  /// @param[in]  callback              Called with the mappings of the assets
+  ///                                   in the order of `asset_names`, or null
+  ///                                   for the assets that were not found.
+  ///
+  void GetAsMappingsAsync(
+      std::vector<std::string> asset_names,
+      std::shared_ptr<fml::ConcurrentTaskRunner> load_task_runner,
+      fml::RefPtr<fml::TaskRunner> callback_task_runner,
+      MappingsCallback callback);
+
  private:
-  std::deque<std::unique_ptr<AssetResolver>> resolvers_;
+  using LoadCallback = std::function<void(std::shared_ptr<fml::Mapping>)>;
+
+  // The resolvers are shared with the loads running on other threads, which
+  // use a copy of the list taken under the lock.
+  mutable std::mutex resolvers_mutex_;
+  Resolvers resolvers_;
+
+  // The callbacks waiting for each asset that is being loaded asynchronously.
+  std::mutex pending_loads_mutex_;
+  std::unordered_map<std::string, std::vector<LoadCallback>> pending_loads_;
+
+  void FinishLoad(const std::string& asset_name,
+                  std::shared_ptr<fml::Mapping> mapping);
 
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
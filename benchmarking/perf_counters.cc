@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/perf_counters.h"
+
+#include "flutter/fml/build_config.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define PERF_COUNTERS_SUPPORTED 1
+#endif
+
+namespace benchmarking {
+
+#if defined(PERF_COUNTERS_SUPPORTED)
+
+namespace {
+
+struct CounterDescription {
+  const char* name;
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr CounterDescription kCounterDescriptions[] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"page_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+};
+
+int OpenCounter(const CounterDescription& description) {
+  struct perf_event_attr attr = {};
+  attr.size = sizeof(attr);
+  attr.type = description.type;
+  attr.config = description.config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // Count the calling thread on any CPU.
+  return static_cast<int>(
+      syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+  for (const auto& description : kCounterDescriptions) {
+    int fd = OpenCounter(description);
+    if (fd >= 0) {
+      counters_.push_back({description.name, fd});
+    }
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (const auto& counter : counters_) {
+    close(counter.fd);
+  }
+}
+
+void PerfCounters::Start() {
+  for (const auto& counter : counters_) {
+    ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+void PerfCounters::Stop() {
+  for (const auto& counter : counters_) {
+    ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, 0);
+  }
+}
+
+std::vector<PerfCounters::Value> PerfCounters::Read() const {
+  std::vector<Value> values;
+  for (const auto& counter : counters_) {
+    uint64_t count = 0;
+    if (read(counter.fd, &count, sizeof(count)) == sizeof(count)) {
+      values.push_back({counter.name, count});
+    }
+  }
+  return values;
+}
+
+#else  // defined(PERF_COUNTERS_SUPPORTED)
+
+PerfCounters::PerfCounters() = default;
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::Start() {}
+
+void PerfCounters::Stop() {}
+
+std::vector<PerfCounters::Value> PerfCounters::Read() const {
+  return {};
+}
+
+#endif  // defined(PERF_COUNTERS_SUPPORTED)
+
+ScopedPerfCounters::ScopedPerfCounters(::benchmark::State& state)
+    : state_(state) {
+  counters_.Start();
+}
+
+ScopedPerfCounters::~ScopedPerfCounters() {
+  counters_.Stop();
+  const double iterations = static_cast<double>(state_.iterations());
+  if (iterations <= 0) {
+    return;
+  }
+  for (const auto& value : counters_.Read()) {
+    state_.counters[value.name] = static_cast<double>(value.count) / iterations;
+  }
+}
+
+}  // namespace benchmarking
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_BENCHMARKING_PERF_COUNTERS_H_
+#define FLUTTER_BENCHMARKING_PERF_COUNTERS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+namespace benchmarking {
+
+// Reads hardware performance counters of the calling thread. Counters are
+// only available on Linux and Android through perf_event_open, and only if
+// the kernel allows it (see /proc/sys/kernel/perf_event_paranoid). Elsewhere,
+// or when no counter could be opened, |IsValid| returns false and the
+// counters read as empty.
+class PerfCounters {
+ public:
+  struct Value {
+    std::string name;
+    uint64_t count;
+  };
+
+  PerfCounters();
+  ~PerfCounters();
+
+  bool IsValid() const { return !counters_.empty(); }
+
+  void Start();
+  void Stop();
+
+  // The counts accumulated between all Start/Stop pairs so far.
+  std::vector<Value> Read() const;
+
+ private:
+  struct Counter {
+    const char* name;
+    int fd;
+  };
+
+  std::vector<Counter> counters_;
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+};
+
+// Counts hardware events for the lifetime of this object and reports them as
+// per-iteration user counters of |state|, e.g. "cycles" or "cache_misses".
+// Construct it before the |state.KeepRunning()| loop. Events are counted
+// while timing is paused too, so keep untimed setup out of the loop for
+// precise numbers.
+class ScopedPerfCounters {
+ public:
+  explicit ScopedPerfCounters(::benchmark::State& state);
+  ~ScopedPerfCounters();
+
+ private:
+  ::benchmark::State& state_;
+  PerfCounters counters_;
+
+  ScopedPerfCounters(const ScopedPerfCounters&) = delete;
+  ScopedPerfCounters& operator=(const ScopedPerfCounters&) = delete;
+};
+
+}  // namespace benchmarking
+
+#endif  // FLUTTER_BENCHMARKING_PERF_COUNTERS_H_
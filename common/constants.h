@@ -2,6 +2,17 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#ifndef FLUTTER_COMMON_CONSTANTS_H_
+#define FLUTTER_COMMON_CONSTANTS_H_
+
+#include <cstdint>
+
 namespace flutter {
 constexpr double kMegaByteSizeInBytes = (1 << 20);
+
+// The ID of the view that every engine renders into. Platforms that support
+// multiple views identify the other views with different IDs.
+constexpr int64_t kFlutterImplicitViewId = 0;
 }  // namespace flutter
+
+#endif  // FLUTTER_COMMON_CONSTANTS_H_
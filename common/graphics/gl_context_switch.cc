@@ -10,6 +10,10 @@ SwitchableGLContext::SwitchableGLContext() = default;
 
 SwitchableGLContext::~SwitchableGLContext() = default;
 
+bool SwitchableGLContext::IsCurrent() {
+  return false;
+}
+
 GLContextResult::GLContextResult() = default;
 
 GLContextResult::~GLContextResult() = default;
@@ -28,11 +32,18 @@ GLContextDefaultResult::~GLContextDefaultResult() = default;
 GLContextSwitch::GLContextSwitch(std::unique_ptr<SwitchableGLContext> context)
     : context_(std::move(context)) {
   FML_CHECK(context_ != nullptr);
+  if (context_->IsCurrent()) {
+    result_ = true;
+    return;
+  }
   result_ = context_->SetCurrent();
+  switched_ = true;
 };
 
 GLContextSwitch::~GLContextSwitch() {
-  context_->RemoveCurrent();
+  if (switched_) {
+    context_->RemoveCurrent();
+  }
 };
 
 }  // namespace flutter
@@ -34,6 +34,12 @@ class SwitchableGLContext {
   // object from current context;
   virtual bool RemoveCurrent() = 0;
 
+  // Implement this to report whether the context wrapped by this
+  // |SwitchableGLContext| object already is the current context on the calling
+  // thread. If it is, |GLContextSwitch| neither sets nor removes it. The
+  // default implementation reports false, so the context is always switched.
+  virtual bool IsCurrent();
+
   FML_DISALLOW_COPY_AND_ASSIGN(SwitchableGLContext);
 };
 
@@ -91,6 +97,9 @@ class GLContextDefaultResult : public GLContextResult {
 ///
 /// In destruction, it should restore the current context to what was
 /// before the construction of this switch.
+///
+/// If the context already is current, e.g. because switches are nested, the
+/// switch leaves it as it is and skips both the set and the removal.
 class GLContextSwitch final : public GLContextResult {
  public:
   //----------------------------------------------------------------------------
@@ -105,6 +114,9 @@ class GLContextSwitch final : public GLContextResult {
 
  private:
   std::unique_ptr<SwitchableGLContext> context_;
+  // Whether the constructor set the context, which is then removed again in
+  // the destructor.
+  bool switched_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GLContextSwitch);
 };
@@ -4,11 +4,16 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
+#include <functional>
 #include <future>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
+#include "flutter/fml/async_file.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
@@ -18,6 +23,8 @@
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/version/version.h"
 #include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 
@@ -30,6 +37,113 @@ std::shared_ptr<AssetManager> PersistentCache::asset_manager_;
 std::mutex PersistentCache::instance_mutex_;
 std::unique_ptr<PersistentCache> PersistentCache::gPersistentCache;
 
+static std::string KeyToString(const SkData& key) {
+  return std::string(static_cast<const char*>(key.data()), key.size());
+}
+
+// The usage of the cache entries, saved as the |kShaderUsageFileName| file in
+// the cache directory in the format
+// {"launch": <n>, "shaders": {"<SkKeyToFilePath>": [<last launch>, <count>]}}.
+struct PersistentCache::ShaderUsage {
+  struct Entry {
+    // The last launch the entry was loaded or stored in.
+    uint32_t last_used_launch = 0;
+    // The number of launches the entry was loaded or stored in.
+    uint32_t use_count = 0;
+  };
+
+  std::mutex mutex;
+  // The number of this launch. Launches are only counted if they save their
+  // usage.
+  uint32_t launch = 1;
+  // Whether any entry was used in this launch.
+  bool used_in_launch = false;
+  // The entries by key.
+  std::unordered_map<std::string, Entry> entries;
+
+  void Load(const fml::UniqueFD& directory);
+
+  void RecordUse(const SkData& key) {
+    std::scoped_lock lock(mutex);
+    Entry& entry = entries[KeyToString(key)];
+    if (entry.use_count == 0 || entry.last_used_launch != launch) {
+      entry.last_used_launch = launch;
+      entry.use_count++;
+      used_in_launch = true;
+    }
+  }
+
+  // Whether the entry with the given key was not used during more than
+  // |max_unused_launches| launches. Must be called with |mutex| held.
+  //
+  // Entries that were stored before their usage was tracked are considered
+  // to have been used in the previous launch.
+  bool IsUnusedLocked(const std::string& key, size_t max_unused_launches) {
+    auto found = entries.find(key);
+    if (found == entries.end()) {
+      entries[key] = {launch - 1, 0};
+      return false;
+    }
+    return launch - found->second.last_used_launch > max_unused_launches;
+  }
+
+  std::string Serialize();
+};
+
+void PersistentCache::ShaderUsage::Load(const fml::UniqueFD& directory) {
+  sk_sp<SkData> data = LoadFile(directory, kShaderUsageFileName);
+  if (data == nullptr) {
+    return;
+  }
+  rapidjson::Document json_doc;
+  rapidjson::ParseResult parse_result = json_doc.Parse(
+      static_cast<const char*>(data->data()), data->size());
+  if (parse_result != rapidjson::ParseErrorCode::kParseErrorNone ||
+      !json_doc.IsObject() || !json_doc.HasMember("launch") ||
+      !json_doc["launch"].IsUint() || !json_doc.HasMember("shaders") ||
+      !json_doc["shaders"].IsObject()) {
+    FML_LOG(ERROR) << "Failed to parse the shader usage file.";
+    return;
+  }
+  launch = json_doc["launch"].GetUint() + 1;
+  for (auto& item : json_doc["shaders"].GetObject()) {
+    const auto& value = item.value;
+    if (!value.IsArray() || value.Size() != 2 || !value[0u].IsUint() ||
+        !value[1u].IsUint()) {
+      continue;
+    }
+    auto key = fml::Base32Decode(item.name.GetString());
+    if (key.first) {
+      entries[key.second] = {value[0u].GetUint(), value[1u].GetUint()};
+    }
+  }
+}
+
+std::string PersistentCache::ShaderUsage::Serialize() {
+  rapidjson::Document json_doc;
+  json_doc.SetObject();
+  auto& allocator = json_doc.GetAllocator();
+  json_doc.AddMember("launch", launch, allocator);
+  rapidjson::Value shaders(rapidjson::kObjectType);
+  for (const auto& entry : entries) {
+    auto name = fml::Base32Encode(entry.first);
+    if (!name.first) {
+      continue;
+    }
+    rapidjson::Value value(rapidjson::kArrayType);
+    value.PushBack(entry.second.last_used_launch, allocator);
+    value.PushBack(entry.second.use_count, allocator);
+    shaders.AddMember(rapidjson::Value(name.second, allocator), value,
+                      allocator);
+  }
+  json_doc.AddMember("shaders", shaders, allocator);
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  json_doc.Accept(writer);
+  return std::string(buffer.GetString(), buffer.GetSize());
+}
+
 std::string PersistentCache::SkKeyToFilePath(const SkData& data) {
   if (data.data() == nullptr || data.size() == 0) {
     return "";
@@ -86,9 +200,17 @@ bool PersistentCache::Purge() {
   FML_CHECK(GetWorkerTaskRunner());
 
   std::promise<bool> removed;
-  GetWorkerTaskRunner()->PostTask([&removed,
-                                   cache_directory = cache_directory_]() {
+  std::vector<std::shared_ptr<PersistentCacheArchive>> archives = {
+      archive_, sksl_archive_};
+  GetWorkerTaskRunner()->PostTask([&removed, cache_directory = cache_directory_,
+                                   archives]() {
     if (cache_directory->is_valid()) {
+      // The archives unmap their files before they are deleted.
+      for (const auto& archive : archives) {
+        if (archive) {
+          archive->Clear();
+        }
+      }
       // Only remove files but not directories.
       FML_LOG(INFO) << "Purge persistent cache.";
       fml::FileVisitor delete_file = [](const fml::UniqueFD& directory,
@@ -192,8 +314,31 @@ sk_sp<SkData> ParseBase64(const std::string& input) {
   return data;
 }
 
-size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
+std::vector<PersistentCache::SkSLCache>
+PersistentCache::LoadSkSLsToPrecompile() const {
   auto known_sksls = LoadSkSLs();
+  if (const size_t max_unused_launches = max_unused_launches_) {
+    // Leave the SkSLs that were not used for a while to be compiled on first
+    // use, so that they are recorded as used before they would be pruned.
+    std::scoped_lock lock(shader_usage_->mutex);
+    const auto& usage = *shader_usage_;
+    auto is_unused = [&usage, max_unused_launches](const SkSLCache& sksl) {
+      auto found = usage.entries.find(KeyToString(*sksl.first));
+      if (found == usage.entries.end()) {
+        return false;
+      }
+      const uint32_t last_used_launch = found->second.last_used_launch;
+      return usage.launch - last_used_launch > max_unused_launches / 2;
+    };
+    known_sksls.erase(
+        std::remove_if(known_sksls.begin(), known_sksls.end(), is_unused),
+        known_sksls.end());
+  }
+  return known_sksls;
+}
+
+size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
+  auto known_sksls = LoadSkSLsToPrecompile();
   // A trace must be present even if no precompilations have been completed.
   FML_TRACE_EVENT("flutter", "PersistentCache::PrecompileKnownSkSLs", "count",
                   known_sksls.size());
@@ -202,13 +347,9 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
     return 0;
   }
 
-  size_t precompiled_count = 0;
-  for (const auto& sksl : known_sksls) {
-    TRACE_EVENT0("flutter", "PrecompilingSkSL");
-    if (context->precompileShader(*sksl.first, *sksl.second)) {
-      precompiled_count++;
-    }
-  }
+  size_t next_index = 0;
+  const size_t precompiled_count =
+      PrecompileSkSLs(context, known_sksls, &next_index);
 
   FML_TRACE_COUNTER("flutter", "PersistentCache::PrecompiledSkSLs",
                     reinterpret_cast<int64_t>(this),  // Trace Counter ID
@@ -216,15 +357,83 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
   return precompiled_count;
 }
 
+size_t PersistentCache::PrecompileSkSLs(GrDirectContext* context,
+                                        const std::vector<SkSLCache>& sksls,
+                                        size_t* next_index,
+                                        fml::TimePoint deadline) const {
+  if (context == nullptr) {
+    return 0;
+  }
+
+  size_t precompiled_count = 0;
+  while (*next_index < sksls.size()) {
+    const auto& sksl = sksls[(*next_index)++];
+    {
+      TRACE_EVENT0("flutter", "PrecompilingSkSL");
+      if (context->precompileShader(*sksl.first, *sksl.second)) {
+        precompiled_count++;
+      }
+    }
+    FML_TRACE_COUNTER("flutter", "PersistentCache::SkSLPrecompilation",
+                      reinterpret_cast<int64_t>(context),  // Trace Counter ID
+                      "Visited", *next_index, "Remaining",
+                      sksls.size() - *next_index);
+    if (fml::TimePoint::Now() >= deadline) {
+      break;
+    }
+  }
+  return precompiled_count;
+}
+
+// Calls |add_sksl| with every SkSL of a bundle in the JSON format of the
+// |PersistentCache::kAssetFileName| asset. Returns false if the bundle could
+// not be parsed.
+static bool ParseSkSLBundle(
+    const fml::Mapping& bundle,
+    const std::function<void(sk_sp<SkData>, sk_sp<SkData>)>& add_sksl) {
+  rapidjson::Document json_doc;
+  rapidjson::ParseResult parse_result = json_doc.Parse(
+      reinterpret_cast<const char*>(bundle.GetMapping()), bundle.GetSize());
+  if (parse_result != rapidjson::ParseErrorCode::kParseErrorNone ||
+      !json_doc.IsObject() || !json_doc.HasMember("data") ||
+      !json_doc["data"].IsObject()) {
+    return false;
+  }
+  for (auto& item : json_doc["data"].GetObject()) {
+    if (!item.value.IsString()) {
+      FML_LOG(ERROR) << "Failed to load: " << item.name.GetString();
+      continue;
+    }
+    sk_sp<SkData> key = ParseBase32(item.name.GetString());
+    sk_sp<SkData> sksl = ParseBase64(item.value.GetString());
+    if (key != nullptr && sksl != nullptr) {
+      add_sksl(std::move(key), std::move(sksl));
+    } else {
+      FML_LOG(ERROR) << "Failed to load: " << item.name.GetString();
+    }
+  }
+  return true;
+}
+
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
   std::vector<PersistentCache::SkSLCache> result;
-  fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
-                                       const std::string& filename) {
+  std::unordered_set<std::string> keys;
+  auto add_sksl = [&result, &keys](sk_sp<SkData> key, sk_sp<SkData> sksl) {
+    if (keys.emplace(static_cast<const char*>(key->data()), key->size())
+            .second) {
+      result.push_back({std::move(key), std::move(sksl)});
+    }
+  };
+  fml::FileVisitor visitor = [&add_sksl](const fml::UniqueFD& directory,
+                                         const std::string& filename) {
+    if (filename == PersistentCacheArchive::kFileName) {
+      return true;
+    }
     sk_sp<SkData> key = ParseBase32(filename);
     sk_sp<SkData> data = LoadFile(directory, filename);
     if (key != nullptr && data != nullptr) {
-      result.push_back({key, data});
+      add_sksl(std::move(key), std::move(data));
     } else {
       FML_LOG(ERROR) << "Failed to load: " << filename;
     }
@@ -240,8 +449,25 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
     fml::UniqueFD fresh_dir =
         fml::OpenDirectoryReadOnly(*cache_directory_, kSkSLSubdirName);
     if (fresh_dir.is_valid()) {
+      // The archive keeps the SkSLs in the order they were first compiled.
+      if (auto archive = PersistentCacheArchive::Open(fresh_dir)) {
+        for (auto& entry : archive->GetEntries()) {
+          add_sksl(std::move(entry.first), std::move(entry.second));
+        }
+      }
       fml::VisitFiles(fresh_dir, visitor);
     }
+
+    std::scoped_lock lock(shader_usage_->mutex);
+    const auto& usage = shader_usage_->entries;
+    auto use_count = [&usage](const SkSLCache& sksl) -> uint32_t {
+      auto found = usage.find(KeyToString(*sksl.first));
+      return found == usage.end() ? 0 : found->second.use_count;
+    };
+    std::stable_sort(result.begin(), result.end(),
+                     [&use_count](const SkSLCache& a, const SkSLCache& b) {
+                       return use_count(a) > use_count(b);
+                     });
   }
 
   std::unique_ptr<fml::Mapping> mapping = nullptr;
@@ -252,37 +478,82 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
     FML_LOG(INFO) << "No sksl asset found.";
   } else {
     FML_LOG(INFO) << "Found sksl asset. Loading SkSLs from it...";
-    rapidjson::Document json_doc;
-    rapidjson::ParseResult parse_result =
-        json_doc.Parse(reinterpret_cast<const char*>(mapping->GetMapping()),
-                       mapping->GetSize());
-    if (parse_result != rapidjson::ParseErrorCode::kParseErrorNone) {
+    if (!ParseSkSLBundle(*mapping, add_sksl)) {
       FML_LOG(ERROR) << "Failed to parse json file: " << kAssetFileName;
-    } else {
-      for (auto& item : json_doc["data"].GetObject()) {
-        sk_sp<SkData> key = ParseBase32(item.name.GetString());
-        sk_sp<SkData> sksl = ParseBase64(item.value.GetString());
-        if (key != nullptr && sksl != nullptr) {
-          result.push_back({key, sksl});
-        } else {
-          FML_LOG(ERROR) << "Failed to load: " << item.name.GetString();
-        }
-      }
     }
   }
 
+  std::scoped_lock lock(sksl_bundles_mutex_);
+  for (const auto& bundle : sksl_bundles_) {
+    ParseSkSLBundle(*bundle, add_sksl);
+  }
+
   return result;
 }
 
+bool PersistentCache::AddSkSLBundle(
+    std::shared_ptr<const fml::Mapping> bundle) {
+  if (!bundle ||
+      !ParseSkSLBundle(*bundle, [](sk_sp<SkData> key, sk_sp<SkData> sksl) {})) {
+    FML_LOG(ERROR) << "Failed to parse the SkSL bundle.";
+    return false;
+  }
+  std::scoped_lock lock(sksl_bundles_mutex_);
+  sksl_bundles_.push_back(std::move(bundle));
+  return true;
+}
+
+std::string PersistentCache::ExportSkSLBundle() const {
+  TRACE_EVENT0("flutter", "PersistentCache::ExportSkSLBundle");
+  rapidjson::Document json_doc;
+  json_doc.SetObject();
+  auto& allocator = json_doc.GetAllocator();
+  json_doc.AddMember("engineRevision",
+                     rapidjson::Value(GetFlutterEngineVersion(), allocator),
+                     allocator);
+  rapidjson::Value data(rapidjson::kObjectType);
+  for (const auto& sksl : LoadSkSLs()) {
+    const size_t b64_size =
+        SkBase64::Encode(sksl.second->data(), sksl.second->size(), nullptr);
+    std::string b64(b64_size, '\0');
+    SkBase64::Encode(sksl.second->data(), sksl.second->size(), b64.data());
+    data.AddMember(rapidjson::Value(SkKeyToFilePath(*sksl.first), allocator),
+                   rapidjson::Value(b64, allocator), allocator);
+  }
+  json_doc.AddMember("data", data, allocator);
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  json_doc.Accept(writer);
+  return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+static std::shared_ptr<PersistentCacheArchive> OpenArchive(
+    const std::shared_ptr<fml::UniqueFD>& directory,
+    bool read_only) {
+  if (!directory || !directory->is_valid()) {
+    return nullptr;
+  }
+  if (read_only) {
+    return PersistentCacheArchive::Open(*directory);
+  }
+  return PersistentCacheArchive::OpenForAppend(*directory);
+}
+
 PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      archive_(OpenArchive(cache_directory_, read_only)),
+      sksl_archive_(OpenArchive(sksl_cache_directory_, read_only)),
+      shader_usage_(std::make_shared<ShaderUsage>()) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
+    return;
   }
+  shader_usage_->Load(*cache_directory_);
 }
 
 PersistentCache::~PersistentCache() = default;
@@ -291,6 +562,10 @@ bool PersistentCache::IsValid() const {
   return cache_directory_ && cache_directory_->is_valid();
 }
 
+std::shared_ptr<fml::UniqueFD> PersistentCache::GetCacheDirectory() const {
+  return IsValid() ? cache_directory_ : nullptr;
+}
+
 sk_sp<SkData> PersistentCache::LoadFile(const fml::UniqueFD& dir,
                                         const std::string& file_name) {
   auto file = fml::OpenFileReadOnly(dir, file_name.c_str());
@@ -310,34 +585,23 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (!IsValid()) {
     return nullptr;
   }
-  auto file_name = SkKeyToFilePath(key);
-  if (file_name.size() == 0) {
-    return nullptr;
+  sk_sp<SkData> result = archive_ ? archive_->Find(key) : nullptr;
+  if (result == nullptr) {
+    auto file_name = SkKeyToFilePath(key);
+    if (file_name.size() == 0) {
+      return nullptr;
+    }
+    result = PersistentCache::LoadFile(*cache_directory_, file_name);
   }
-  auto result = PersistentCache::LoadFile(*cache_directory_, file_name);
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
+    shader_usage_->RecordUse(key);
   }
   return result;
 }
 
-static void PersistentCacheStore(fml::RefPtr<fml::TaskRunner> worker,
-                                 std::shared_ptr<fml::UniqueFD> cache_directory,
-                                 std::string key,
-                                 std::unique_ptr<fml::Mapping> value) {
-  auto task = fml::MakeCopyable([cache_directory,             //
-                                 file_name = std::move(key),  //
-                                 mapping = std::move(value)   //
-  ]() mutable {
-    TRACE_EVENT0("flutter", "PersistentCacheStore");
-    if (!fml::WriteAtomically(*cache_directory,   //
-                              file_name.c_str(),  //
-                              *mapping)           //
-    ) {
-      FML_LOG(WARNING) << "Could not write cache contents to persistent store.";
-    }
-  });
-
+static void RunOnWorker(fml::RefPtr<fml::TaskRunner> worker,
+                        fml::closure task) {
   if (!worker) {
     FML_LOG(WARNING)
         << "The persistent cache has no available workers. Performing the task "
@@ -349,6 +613,49 @@ static void PersistentCacheStore(fml::RefPtr<fml::TaskRunner> worker,
   }
 }
 
+// Writes whole files through the file IO of the process, which doesn't block
+// its file thread while the storage device works. Without any worker the file
+// is written on the current thread, like the other cache writes.
+static void PersistentCacheStore(fml::RefPtr<fml::TaskRunner> worker,
+                                 std::shared_ptr<fml::UniqueFD> cache_directory,
+                                 std::string key,
+                                 std::unique_ptr<fml::Mapping> value) {
+  TRACE_EVENT0("flutter", "PersistentCacheStore");
+  if (!worker) {
+    RunOnWorker(nullptr, [&]() {
+      if (!fml::WriteAtomically(*cache_directory, key.c_str(), *value)) {
+        FML_LOG(WARNING)
+            << "Could not write cache contents to persistent store.";
+      }
+    });
+    return;
+  }
+  fml::AsyncFileIO::GetForProcess().WriteAtomically(
+      std::move(cache_directory), std::move(key), std::move(value),
+      [](bool success) {
+        if (!success) {
+          FML_LOG(WARNING)
+              << "Could not write cache contents to persistent store.";
+        }
+      });
+}
+
+static void PersistentCacheArchiveStore(
+    fml::RefPtr<fml::TaskRunner> worker,
+    std::shared_ptr<PersistentCacheArchive> archive,
+    sk_sp<SkData> key,
+    std::unique_ptr<fml::Mapping> value) {
+  RunOnWorker(worker, fml::MakeCopyable([archive,                    //
+                                         key = std::move(key),       //
+                                         mapping = std::move(value)  //
+  ]() mutable {
+    TRACE_EVENT0("flutter", "PersistentCacheStore");
+    if (!archive->Append(*key, *mapping)) {
+      FML_LOG(WARNING) << "Could not write cache contents to persistent store.";
+    }
+  }));
+}
+
 // |GrContextOptions::PersistentCache|
 void PersistentCache::store(const SkData& key, const SkData& data) {
   stored_new_shaders_ = true;
@@ -361,12 +668,12 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
-  auto file_name = SkKeyToFilePath(key);
-
-  if (file_name.size() == 0) {
+  if (key.size() == 0) {
     return;
   }
 
+  shader_usage_->RecordUse(key);
+
   auto mapping = std::make_unique<fml::DataMapping>(
       std::vector<uint8_t>{data.bytes(), data.bytes() + data.size()});
 
@@ -374,9 +681,69 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
-  PersistentCacheStore(GetWorkerTaskRunner(),
-                       cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
-                       std::move(file_name), std::move(mapping));
+  auto archive = cache_sksl_ ? sksl_archive_ : archive_;
+  if (!archive) {
+    return;
+  }
+  PersistentCacheArchiveStore(GetWorkerTaskRunner(), std::move(archive),
+                              SkData::MakeWithCopy(key.data(), key.size()),
+                              std::move(mapping));
+}
+
+void PersistentCache::PruneUnusedShaders() {
+  const size_t max_unused_launches = max_unused_launches_;
+  if (is_read_only_ || !IsValid() || max_unused_launches == 0) {
+    return;
+  }
+  std::vector<std::shared_ptr<PersistentCacheArchive>> archives = {
+      archive_, sksl_archive_};
+  RunOnWorker(GetWorkerTaskRunner(), [shader_usage = shader_usage_,
+                                      max_unused_launches, archives]() {
+    TRACE_EVENT0("flutter", "PersistentCache::PruneUnusedShaders");
+    std::scoped_lock lock(shader_usage->mutex);
+    auto is_unused = [&shader_usage, max_unused_launches](const SkData& key) {
+      return shader_usage->IsUnusedLocked(KeyToString(key),
+                                          max_unused_launches);
+    };
+    size_t removed = 0;
+    for (const auto& archive : archives) {
+      if (archive) {
+        removed += archive->Compact(
+            [&is_unused](const SkData& key) { return !is_unused(key); });
+      }
+    }
+    auto& entries = shader_usage->entries;
+    for (auto it = entries.begin(); it != entries.end();) {
+      if (shader_usage->launch - it->second.last_used_launch >
+          max_unused_launches) {
+        it = entries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (removed > 0) {
+      FML_LOG(INFO) << "Pruned " << removed
+                    << " unused persistent cache entries.";
+    }
+  });
+}
+
+void PersistentCache::StoreShaderUsage() {
+  if (is_read_only_ || !IsValid()) {
+    return;
+  }
+  std::string usage;
+  {
+    std::scoped_lock lock(shader_usage_->mutex);
+    if (!shader_usage_->used_in_launch) {
+      return;
+    }
+    usage = shader_usage_->Serialize();
+  }
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
+                       kShaderUsageFileName,
+                       std::make_unique<fml::DataMapping>(std::vector<uint8_t>(
+                           usage.begin(), usage.end())));
 }
 
 void PersistentCache::DumpSkp(const SkData& data) {
@@ -428,6 +795,33 @@ void PersistentCache::SetAssetManager(std::shared_ptr<AssetManager> value) {
   asset_manager_ = value;
 }
 
+std::unique_ptr<fml::Mapping> PersistentCache::LoadMetalBinaryArchive()
+    const {
+  if (IsValid()) {
+    auto file = fml::OpenFileReadOnly(*cache_directory_,
+                                      kMetalBinaryArchiveFileName);
+    if (file.is_valid()) {
+      auto mapping = std::make_unique<fml::FileMapping>(file);
+      if (mapping->GetSize() > 0) {
+        return mapping;
+      }
+    }
+  }
+  if (asset_manager_) {
+    return asset_manager_->GetAsMapping(kMetalBinaryArchiveAssetName);
+  }
+  return nullptr;
+}
+
+bool PersistentCache::StoreMetalBinaryArchive(const fml::Mapping& archive) {
+  if (is_read_only_ || !IsValid() || archive.GetSize() == 0) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "PersistentCache::StoreMetalBinaryArchive");
+  return fml::WriteAtomically(*cache_directory_, kMetalBinaryArchiveFileName,
+                              archive);
+}
+
 std::vector<std::unique_ptr<fml::Mapping>>
 PersistentCache::GetSkpsFromAssetManager() const {
   if (!asset_manager_) {
@@ -5,13 +5,16 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 #define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <set>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/common/graphics/persistent_cache_archive.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
 
@@ -25,6 +28,16 @@ class ShellTest;
 ///
 /// This is mainly used for Shaders but is also written to by Dart.  It is
 /// thread-safe for reading and writing from multiple threads.
+///
+/// New entries are appended to a single |PersistentCacheArchive| per cache
+/// directory. Entries stored as individual files named after
+/// |SkKeyToFilePath|, e.g. shipped by embedders in read-only caches, are still
+/// loaded.
+///
+/// The cache counts the launches that used it and remembers, per entry, the
+/// last launch the entry was loaded or stored in and in how many launches it
+/// was. This is saved by |StoreShaderUsage| and lets |PruneUnusedShaders|
+/// remove the entries of shaders the app no longer draws.
 class PersistentCache : public GrContextOptions::PersistentCache {
  public:
   // Mutable static switch that can be set before GetCacheForProcess. If true,
@@ -66,17 +79,63 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // Return whether the purge is successful.
   bool Purge();
 
+  // Entries that were not used during more than this many launches are
+  // removed by |PruneUnusedShaders|. Zero, the default, keeps all entries.
+  void SetMaxUnusedLaunches(size_t launches) {
+    max_unused_launches_ = launches;
+  }
+
+  // Remove the archived entries that were not used during more than
+  // |SetMaxUnusedLaunches| launches. Entries stored as individual files are
+  // kept. This rewrites the archives on the worker task runner.
+  void PruneUnusedShaders();
+
+  // Save which entries were used in this launch, if any was. This is written
+  // on the worker task runner and should be called when the app may be about
+  // to be killed, e.g. when its surface is destroyed. Launches that never
+  // save their usage do not count towards |SetMaxUnusedLaunches|.
+  void StoreShaderUsage();
+
+  // The directory the shaders are cached in, or nullptr if there is none.
+  // Other caches that should be invalidated together with the shaders, e.g.
+  // when the engine version changes, may keep their files there too.
+  std::shared_ptr<fml::UniqueFD> GetCacheDirectory() const;
+
   // |GrContextOptions::PersistentCache|
   sk_sp<SkData> load(const SkData& key) override;
 
   using SkSLCache = std::pair<sk_sp<SkData>, sk_sp<SkData>>;
 
   /// Load all the SkSL shader caches in the right directory.
+  ///
+  /// The SkSLs gathered during previous runs come first, the ones used in
+  /// the most launches first and otherwise in the order they were first
+  /// compiled. They are followed by the ones packaged with the application
+  /// and the ones of the bundles added with |AddSkSLBundle|. Each key is only
+  /// returned once.
   std::vector<SkSLCache> LoadSkSLs() const;
 
+  /// Adds a bundle of SkSLs to the ones returned by |LoadSkSLs|. The bundle
+  /// has the JSON format of the |kAssetFileName| asset. Returns false if the
+  /// bundle could not be parsed, in which case it is not added.
+  bool AddSkSLBundle(std::shared_ptr<const fml::Mapping> bundle);
+
+  /// Encodes the SkSLs returned by |LoadSkSLs| as a bundle in the JSON format
+  /// of the |kAssetFileName| asset, so that the SkSLs gathered at runtime can
+  /// be shipped with the next build of the application.
+  std::string ExportSkSLBundle() const;
+
+  /// The SkSLs of |LoadSkSLs| that should be precompiled. If
+  /// |SetMaxUnusedLaunches| is set, SkSLs not used during more than half as
+  /// many launches are left out. Skia does not load precompiled shaders from
+  /// the cache again, so they are left to be compiled on first use, which
+  /// records that they are still used before they would be pruned.
+  std::vector<SkSLCache> LoadSkSLsToPrecompile() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Precompile SkSLs packaged with the application and gathered
-  ///             during previous runs in the given context.
+  ///             during previous runs in the given context, as returned by
+  ///             |LoadSkSLsToPrecompile|.
   ///
   /// @warning    The context must be the rendering context. This context may be
   ///             destroyed during application suspension and subsequently
@@ -89,6 +148,42 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   ///
   size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Precompile the SkSLs starting at |next_index| until all of
+  ///             them are visited or |deadline| has passed. This lets the
+  ///             precompilation be spread over several frames.
+  ///
+  ///             At least one SkSL is visited per call. The progress is
+  ///             reported through the "PersistentCache::SkSLPrecompilation"
+  ///             trace counter.
+  ///
+  /// @param      context     The rendering context to precompile shaders in.
+  /// @param      sksls       The SkSLs to precompile, usually the result of
+  ///                         |LoadSkSLsToPrecompile|.
+  /// @param      next_index  The index of the first SkSL to visit. It is
+  ///                         updated with the index of the first SkSL that
+  ///                         was not visited.
+  /// @param      deadline    The time after which no new SkSL is visited.
+  ///
+  /// @return     The number of SkSLs precompiled by this call.
+  ///
+  size_t PrecompileSkSLs(GrDirectContext* context,
+                         const std::vector<SkSLCache>& sksls,
+                         size_t* next_index,
+                         fml::TimePoint deadline = fml::TimePoint::Max()) const;
+
+  /// Load the serialized MTLBinaryArchive of the Metal pipelines built during
+  /// previous runs, or else the |kMetalBinaryArchiveAssetName| asset packaged
+  /// with the application. Returns nullptr if there is neither.
+  std::unique_ptr<fml::Mapping> LoadMetalBinaryArchive() const;
+
+  /// Store a serialized MTLBinaryArchive in the cache directory for
+  /// |LoadMetalBinaryArchive| to load in later runs. The file can also be
+  /// copied out of the cache directory to be packaged with the application as
+  /// the |kMetalBinaryArchiveAssetName| asset. Returns false if the cache is
+  /// read-only or the archive could not be written.
+  bool StoreMetalBinaryArchive(const fml::Mapping& archive);
+
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
@@ -104,8 +199,15 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kMetalBinaryArchiveFileName[] =
+      "io.flutter.metal_binary_archive";
+  static constexpr char kMetalBinaryArchiveAssetName[] =
+      "io.flutter.metal_binary_archive";
+  static constexpr char kShaderUsageFileName[] = "io.flutter.shader_usage.json";
 
  private:
+  struct ShaderUsage;
+
   static std::string cache_base_path_;
 
   static std::shared_ptr<AssetManager> asset_manager_;
@@ -132,6 +234,21 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   bool stored_new_shaders_ = false;
   bool is_dumping_skp_ = false;
 
+  mutable std::mutex sksl_bundles_mutex_;
+  std::vector<std::shared_ptr<const fml::Mapping>> sksl_bundles_;
+
+  // The archives of |cache_directory_|, which |load| looks keys up in, and
+  // of |sksl_cache_directory_|. They are shared with the tasks on the worker
+  // task runner that append to and compact them, and are only opened for
+  // appending if the cache is not read-only.
+  const std::shared_ptr<PersistentCacheArchive> archive_;
+  const std::shared_ptr<PersistentCacheArchive> sksl_archive_;
+
+  // When the entries were last used. It is shared with the pruning task on
+  // the worker task runner.
+  const std::shared_ptr<ShaderUsage> shader_usage_;
+  std::atomic<size_t> max_unused_launches_ = 0;
+
   static sk_sp<SkData> LoadFile(const fml::UniqueFD& dir,
                                 const std::string& filen_ame);
 
@@ -0,0 +1,384 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_archive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// "FLPC" when read as a little endian integer. An archive written on a machine
+// with a different byte order is not recognized and gets overwritten.
+constexpr uint32_t kArchiveMagic = 0x43504C46;
+constexpr uint32_t kArchiveVersion = 1;
+
+struct ArchiveHeader {
+  uint32_t magic;
+  uint32_t version;
+};
+
+struct RecordHeader {
+  uint32_t key_size;
+  uint32_t value_size;
+  uint32_t checksum;
+};
+
+// FNV-1a over the key followed by the value. This only needs to detect records
+// that were not completely written, not malicious modifications.
+uint32_t Checksum(const uint8_t* key,
+                  size_t key_size,
+                  const uint8_t* value,
+                  size_t value_size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < key_size; i++) {
+    hash = (hash ^ key[i]) * 16777619u;
+  }
+  for (size_t i = 0; i < value_size; i++) {
+    hash = (hash ^ value[i]) * 16777619u;
+  }
+  return hash;
+}
+
+// Calls |visitor| with the header and key offset of every complete record.
+//
+// Returns the offset just past the last complete record, which is where the
+// next record should be appended, or 0 if the archive header is not valid.
+template <typename Visitor>
+size_t VisitRecords(const uint8_t* data, size_t size, const Visitor& visitor) {
+  ArchiveHeader header;
+  if (data == nullptr || size < sizeof(header)) {
+    return 0;
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != kArchiveMagic || header.version != kArchiveVersion) {
+    return 0;
+  }
+
+  size_t offset = sizeof(header);
+  RecordHeader record;
+  while (size - offset >= sizeof(record)) {
+    std::memcpy(&record, data + offset, sizeof(record));
+    const size_t key_offset = offset + sizeof(record);
+    if (record.key_size == 0 || size - key_offset < record.key_size ||
+        size - key_offset - record.key_size < record.value_size) {
+      break;
+    }
+    visitor(record, key_offset);
+    offset = key_offset + record.key_size + record.value_size;
+  }
+  return offset;
+}
+
+}  // namespace
+
+std::unique_ptr<PersistentCacheArchive> PersistentCacheArchive::Open(
+    const fml::UniqueFD& directory) {
+  TRACE_EVENT0("flutter", "PersistentCacheArchive::Open");
+  auto file = fml::OpenFileReadOnly(directory, kFileName);
+  if (!file.is_valid()) {
+    return nullptr;
+  }
+  std::unique_ptr<PersistentCacheArchive> archive(
+      new PersistentCacheArchive(fml::UniqueFD()));
+  std::scoped_lock lock(archive->append_mutex_);
+  if (!archive->Load(std::move(file))) {
+    return nullptr;
+  }
+  return archive;
+}
+
+std::unique_ptr<PersistentCacheArchive> PersistentCacheArchive::OpenForAppend(
+    const fml::UniqueFD& directory) {
+  TRACE_EVENT0("flutter", "PersistentCacheArchive::OpenForAppend");
+  std::unique_ptr<PersistentCacheArchive> archive(
+      new PersistentCacheArchive(fml::Duplicate(directory.get())));
+  if (!archive->directory_.is_valid()) {
+    return nullptr;
+  }
+  if (!fml::FileExists(directory, kFileName)) {
+    return archive;
+  }
+  auto file = fml::OpenFile(directory, kFileName, false,
+                            fml::FilePermission::kReadWrite);
+  std::scoped_lock lock(archive->append_mutex_);
+  if (!file.is_valid() || !archive->Load(std::move(file))) {
+    return nullptr;
+  }
+  return archive;
+}
+
+PersistentCacheArchive::PersistentCacheArchive(fml::UniqueFD directory)
+    : directory_(std::move(directory)) {}
+
+PersistentCacheArchive::~PersistentCacheArchive() = default;
+
+bool PersistentCacheArchive::Load(fml::UniqueFD file) {
+  auto mapping = std::make_unique<fml::FileMapping>(file);
+  if (!mapping->IsValid()) {
+    return false;
+  }
+  size_t end = VisitRecords(mapping->GetMapping(), mapping->GetSize(),
+                            [](const RecordHeader&, size_t) {});
+  if (!directory_.is_valid()) {
+    if (end == 0) {
+      if (mapping->GetSize() > 0) {
+        FML_LOG(ERROR)
+            << "Ignoring persistent cache archive with unknown format.";
+      }
+      return false;
+    }
+  } else if (end == 0 || end != mapping->GetSize()) {
+    // The file can only be shrunk while it is not mapped. An archive of an
+    // unknown format, e.g. of another version, is started over.
+    mapping.reset();
+    const ArchiveHeader header = {kArchiveMagic, kArchiveVersion};
+    if (end == 0 && !(fml::TruncateFile(file, 0) &&
+                      fml::WriteFileAt(
+                          file, 0, reinterpret_cast<const uint8_t*>(&header),
+                          sizeof(header)))) {
+      return false;
+    }
+    end = std::max(end, sizeof(header));
+    if (!fml::TruncateFile(file, end)) {
+      return false;
+    }
+    mapping = std::make_unique<fml::FileMapping>(file);
+    if (!mapping->IsValid()) {
+      return false;
+    }
+  }
+
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  keys_.clear();
+  const uint8_t* data = mapping->GetMapping();
+  VisitRecords(data, mapping->GetSize(),
+               [this, data](const RecordHeader& record, size_t key_offset) {
+                 Entry entry;
+                 entry.value_offset = key_offset + record.key_size;
+                 entry.value_size = record.value_size;
+                 entry.checksum = record.checksum;
+                 AddEntryLocked(
+                     std::string(
+                         reinterpret_cast<const char*>(data + key_offset),
+                         record.key_size),
+                     std::move(entry));
+               });
+  mapping_ = std::move(mapping);
+  if (directory_.is_valid()) {
+    file_ = std::move(file);
+    end_offset_ = end;
+  }
+  return true;
+}
+
+void PersistentCacheArchive::AddEntryLocked(std::string key, Entry entry) {
+  auto [found, inserted] =
+      index_.insert_or_assign(std::move(key), std::move(entry));
+  if (inserted) {
+    keys_.push_back(&found->first);
+  }
+}
+
+bool PersistentCacheArchive::Append(const SkData& key,
+                                    const fml::Mapping& value) {
+  constexpr size_t kMaxFieldSize = std::numeric_limits<uint32_t>::max();
+  if (key.size() == 0 || key.size() > kMaxFieldSize ||
+      value.GetSize() > kMaxFieldSize || !directory_.is_valid()) {
+    return false;
+  }
+
+  std::scoped_lock append_lock(append_mutex_);
+  if (!file_.is_valid()) {
+    auto file = fml::OpenFile(directory_, kFileName, true,
+                              fml::FilePermission::kReadWrite);
+    if (!file.is_valid() || !Load(std::move(file))) {
+      return false;
+    }
+  }
+
+  RecordHeader record = {
+      static_cast<uint32_t>(key.size()),
+      static_cast<uint32_t>(value.GetSize()),
+      Checksum(key.bytes(), key.size(), value.GetMapping(), value.GetSize())};
+  // A record that is only partly written is overwritten by the next one, and
+  // cut off when the archive is next opened.
+  size_t offset = end_offset_;
+  if (!fml::WriteFileAt(file_, offset,
+                        reinterpret_cast<const uint8_t*>(&record),
+                        sizeof(record))) {
+    return false;
+  }
+  offset += sizeof(record);
+  if (!fml::WriteFileAt(file_, offset, key.bytes(), key.size())) {
+    return false;
+  }
+  offset += key.size();
+  if (value.GetSize() > 0 && !fml::WriteFileAt(file_, offset,
+                                               value.GetMapping(),
+                                               value.GetSize())) {
+    return false;
+  }
+  end_offset_ = offset + value.GetSize();
+
+  Entry entry;
+  entry.value = SkData::MakeWithCopy(value.GetMapping(), value.GetSize());
+  entry.value_size = value.GetSize();
+  std::scoped_lock lock(mutex_);
+  AddEntryLocked(std::string(static_cast<const char*>(key.data()), key.size()),
+                 std::move(entry));
+  return true;
+}
+
+size_t PersistentCacheArchive::Compact(
+    const std::function<bool(const SkData& key)>& keep) {
+  TRACE_EVENT0("flutter", "PersistentCacheArchive::Compact");
+  std::scoped_lock append_lock(append_mutex_);
+  if (!file_.is_valid()) {
+    return 0;
+  }
+
+  size_t entry_count = 0;
+  std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>> entries;
+  {
+    std::scoped_lock lock(mutex_);
+    entry_count = index_.size();
+    entries = GetEntriesLocked();
+  }
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [&keep](const auto& entry) {
+                                 return !keep(*entry.first);
+                               }),
+                entries.end());
+  if (entries.size() == entry_count) {
+    return 0;
+  }
+
+  size_t size = sizeof(ArchiveHeader);
+  for (const auto& entry : entries) {
+    size += sizeof(RecordHeader) + entry.first->size() + entry.second->size();
+  }
+  std::vector<uint8_t> data(size);
+  const ArchiveHeader header = {kArchiveMagic, kArchiveVersion};
+  std::memcpy(data.data(), &header, sizeof(header));
+  size_t offset = sizeof(header);
+  for (const auto& entry : entries) {
+    const SkData& key = *entry.first;
+    const SkData& value = *entry.second;
+    RecordHeader record = {
+        static_cast<uint32_t>(key.size()), static_cast<uint32_t>(value.size()),
+        Checksum(key.bytes(), key.size(), value.bytes(), value.size())};
+    std::memcpy(data.data() + offset, &record, sizeof(record));
+    offset += sizeof(record);
+    std::memcpy(data.data() + offset, key.data(), key.size());
+    offset += key.size();
+    if (value.size() > 0) {
+      std::memcpy(data.data() + offset, value.data(), value.size());
+      offset += value.size();
+    }
+  }
+
+  // Files that are mapped or open can't be replaced on every platform. The
+  // kept entries are served from memory in the meantime.
+  {
+    std::scoped_lock lock(mutex_);
+    mapping_.reset();
+    index_.clear();
+    keys_.clear();
+    for (const auto& entry : entries) {
+      Entry kept;
+      kept.value = entry.second;
+      kept.value_size = entry.second->size();
+      AddEntryLocked(std::string(static_cast<const char*>(entry.first->data()),
+                                 entry.first->size()),
+                     std::move(kept));
+    }
+  }
+  file_.reset();
+  end_offset_ = 0;
+
+  const bool written = fml::WriteAtomically(directory_, kFileName,
+                                            fml::DataMapping(std::move(data)));
+  auto file = fml::OpenFile(directory_, kFileName, false,
+                            fml::FilePermission::kReadWrite);
+  if (!file.is_valid() || !Load(std::move(file))) {
+    FML_LOG(ERROR) << "Could not reopen the compacted persistent cache "
+                      "archive.";
+  }
+  return written ? entry_count - entries.size() : 0;
+}
+
+void PersistentCacheArchive::Clear() {
+  std::scoped_lock append_lock(append_mutex_);
+  {
+    std::scoped_lock lock(mutex_);
+    mapping_.reset();
+    index_.clear();
+    keys_.clear();
+  }
+  file_.reset();
+  end_offset_ = 0;
+  if (directory_.is_valid()) {
+    fml::UnlinkFile(directory_, kFileName);
+  }
+}
+
+size_t PersistentCacheArchive::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return index_.size();
+}
+
+sk_sp<SkData> PersistentCacheArchive::Find(const SkData& key) const {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(
+      std::string(static_cast<const char*>(key.data()), key.size()));
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  return GetValueLocked(found->first, found->second);
+}
+
+std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>>
+PersistentCacheArchive::GetEntries() const {
+  std::scoped_lock lock(mutex_);
+  return GetEntriesLocked();
+}
+
+std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>>
+PersistentCacheArchive::GetEntriesLocked() const {
+  std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>> result;
+  result.reserve(keys_.size());
+  for (const std::string* key : keys_) {
+    sk_sp<SkData> value = GetValueLocked(*key, index_.at(*key));
+    if (value != nullptr) {
+      result.push_back(
+          {SkData::MakeWithCopy(key->data(), key->size()), std::move(value)});
+    }
+  }
+  return result;
+}
+
+sk_sp<SkData> PersistentCacheArchive::GetValueLocked(const std::string& key,
+                                                     const Entry& entry) const {
+  if (entry.value != nullptr) {
+    return entry.value;
+  }
+  const uint8_t* value = mapping_->GetMapping() + entry.value_offset;
+  if (Checksum(reinterpret_cast<const uint8_t*>(key.data()), key.size(), value,
+               entry.value_size) != entry.checksum) {
+    FML_LOG(ERROR) << "Ignoring corrupted persistent cache archive entry.";
+    return nullptr;
+  }
+  return SkData::MakeWithCopy(value, entry.value_size);
+}
+
+}  // namespace flutter
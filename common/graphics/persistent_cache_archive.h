@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_ARCHIVE_H_
+#define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_ARCHIVE_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A single file that packs the entries of a persistent cache
+///             directory.
+///
+///             The archive starts with a small header followed by the records
+///             in the order they were appended. Each record is a header with
+///             the key size, value size and checksum, followed by the key and
+///             value bytes. Opening an archive maps the file and indexes the
+///             record headers without copying any value.
+///
+///             Records are appended with plain writes at the end of the file,
+///             which is never truncated or replaced while it is mapped, and
+///             added to the index as they are written. The values |Find| and
+///             |GetEntries| return are copies, so nothing outside of the
+///             archive keeps the file mapped.
+///
+///             When the same key is appended more than once, the last record
+///             wins. A record that was not completely written, e.g. because
+///             the process was killed during |Append|, ends the archive and is
+///             cut off when the archive is next opened for appending.
+///
+///             All methods are thread-safe. Appending and compacting are
+///             expected to happen on a single worker thread, while lookups
+///             happen on any thread.
+///
+class PersistentCacheArchive {
+ public:
+  static constexpr char kFileName[] = "io.flutter.persistent_cache.archive";
+
+  //----------------------------------------------------------------------------
+  /// @brief      Maps and indexes the archive in the given directory for
+  ///             reading.
+  ///
+  /// @return     The archive, or nullptr if the directory has no valid archive.
+  ///
+  static std::unique_ptr<PersistentCacheArchive> Open(
+      const fml::UniqueFD& directory);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Maps and indexes the archive in the given directory for
+  ///             reading and appending. The archive file is only created by
+  ///             the first |Append| if there is none yet.
+  ///
+  /// @return     The archive, or nullptr if the existing archive could not be
+  ///             opened for writing.
+  ///
+  static std::unique_ptr<PersistentCacheArchive> OpenForAppend(
+      const fml::UniqueFD& directory);
+
+  ~PersistentCacheArchive();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends a record to an archive opened with |OpenForAppend|.
+  ///             The value is kept in memory until the archive is compacted
+  ///             or opened again, so that the file does not have to be mapped
+  ///             again.
+  ///
+  /// @return     Whether the record was written.
+  ///
+  bool Append(const SkData& key, const fml::Mapping& value);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Rewrites an archive opened with |OpenForAppend| with only the
+  ///             intact entries whose key |keep| returns true for. The
+  ///             entries keep their order. The file is unmapped and closed
+  ///             before it is atomically replaced, and mapped again after.
+  ///
+  /// @return     The number of entries removed.
+  ///
+  size_t Compact(const std::function<bool(const SkData& key)>& keep);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes every entry of an archive opened with
+  ///             |OpenForAppend| and deletes its file, which the next |Append|
+  ///             creates again.
+  ///
+  void Clear();
+
+  /// The number of distinct keys in the archive.
+  size_t GetEntryCount() const;
+
+  /// The value of the last record with the given key, or nullptr if there is
+  /// none or its contents are corrupted.
+  sk_sp<SkData> Find(const SkData& key) const;
+
+  /// The key and value of every intact entry, in the order they were first
+  /// appended.
+  std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>> GetEntries() const;
+
+ private:
+  struct Entry {
+    // The value of an entry appended since the file was mapped, or nullptr
+    // for an entry in the mapping.
+    sk_sp<SkData> value;
+    size_t value_offset = 0;
+    size_t value_size = 0;
+    uint32_t checksum = 0;
+  };
+
+  // Invalid for an archive opened for reading only.
+  const fml::UniqueFD directory_;
+
+  // Serializes |Append|, |Compact| and |Clear|, and guards the fields below,
+  // so that the lookups only wait for the updates of the index.
+  std::mutex append_mutex_;
+  fml::UniqueFD file_;
+  size_t end_offset_ = 0;
+
+  mutable std::mutex mutex_;
+  std::unique_ptr<fml::FileMapping> mapping_;
+  std::unordered_map<std::string, Entry> index_;
+  std::vector<const std::string*> keys_;
+
+  explicit PersistentCacheArchive(fml::UniqueFD directory);
+
+  // Maps and indexes |file|, which is opened for writing unless the archive
+  // is read only. An incomplete record at the end, or the contents of a file
+  // that is not an archive, are cut off before the file is mapped. Must be
+  // called with |append_mutex_| held.
+  bool Load(fml::UniqueFD file);
+
+  // Adds an entry to the index. Must be called with |mutex_| held.
+  void AddEntryLocked(std::string key, Entry entry);
+
+  sk_sp<SkData> GetValueLocked(const std::string& key,
+                               const Entry& entry) const;
+
+  std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>> GetEntriesLocked()
+      const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentCacheArchive);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_ARCHIVE_H_
@@ -38,30 +38,77 @@ std::string Settings::ToString() const {
   stream << "trace_skia: " << trace_skia << std::endl;
   stream << "trace_startup: " << trace_startup << std::endl;
   stream << "trace_systrace: " << trace_systrace << std::endl;
+  stream << "trace_to_file: " << trace_to_file << std::endl;
   stream << "dump_skp_on_shader_compilation: " << dump_skp_on_shader_compilation
          << std::endl;
+  stream << "dump_skp_on_jank: " << dump_skp_on_jank << std::endl;
   stream << "cache_sksl: " << cache_sksl << std::endl;
   stream << "purge_persistent_cache: " << purge_persistent_cache << std::endl;
+  stream << "persist_fallback_font_cache: " << persist_fallback_font_cache
+         << std::endl;
   stream << "endless_trace_buffer: " << endless_trace_buffer << std::endl;
   stream << "enable_dart_profiling: " << enable_dart_profiling << std::endl;
   stream << "disable_dart_asserts: " << disable_dart_asserts << std::endl;
   stream << "enable_observatory: " << enable_observatory << std::endl;
   stream << "enable_observatory_publication: " << enable_observatory_publication
          << std::endl;
+  stream << "lazy_observatory_startup: " << lazy_observatory_startup
+         << std::endl;
   stream << "observatory_host: " << observatory_host << std::endl;
   stream << "observatory_port: " << observatory_port << std::endl;
   stream << "use_test_fonts: " << use_test_fonts << std::endl;
+  stream << "enable_display_list: " << enable_display_list << std::endl;
+  stream << "enable_yuv_image_decoding: " << enable_yuv_image_decoding
+         << std::endl;
   stream << "enable_software_rendering: " << enable_software_rendering
          << std::endl;
   stream << "log_tag: " << log_tag << std::endl;
   stream << "icu_initialization_required: " << icu_initialization_required
          << std::endl;
   stream << "icu_data_path: " << icu_data_path << std::endl;
+  stream << "lazy_icu_initialization: " << lazy_icu_initialization
+         << std::endl;
   stream << "assets_dir: " << assets_dir << std::endl;
   stream << "assets_path: " << assets_path << std::endl;
   stream << "frame_rasterized_callback set: " << !!frame_rasterized_callback
          << std::endl;
+  stream << "frame_timings_report_callback set: "
+         << !!frame_timings_report_callback
+         << std::endl;
   stream << "old_gen_heap_size: " << old_gen_heap_size << std::endl;
+  stream << "raster_cache_max_bytes: " << raster_cache_max_bytes << std::endl;
+  stream << "raster_cache_scale_tolerance: " << raster_cache_scale_tolerance
+         << std::endl;
+  stream << "raster_cache_scale_mipmaps: " << raster_cache_scale_mipmaps
+         << std::endl;
+  stream << "acquire_metal_drawable_at_present: "
+         << acquire_metal_drawable_at_present << std::endl;
+  stream << "metal_maximum_drawable_count: " << metal_maximum_drawable_count
+         << std::endl;
+  stream << "enable_platform_view_transactions: "
+         << enable_platform_view_transactions << std::endl;
+  stream << "enable_async_raster_cache: " << enable_async_raster_cache
+         << std::endl;
+  stream << "enable_adaptive_pipeline_depth: "
+         << enable_adaptive_pipeline_depth << std::endl;
+  stream << "enable_just_in_time_begin_frame: "
+         << enable_just_in_time_begin_frame << std::endl;
+  stream << "idle_frame_rate: " << idle_frame_rate << std::endl;
+  stream << "enable_parallel_preroll: " << enable_parallel_preroll
+         << std::endl;
+  stream << "enable_tiled_software_paint: " << enable_tiled_software_paint
+         << std::endl;
+  stream << "enable_threaded_present: " << enable_threaded_present
+         << std::endl;
+  stream << "drop_stale_frames: " << drop_stale_frames << std::endl;
+  stream << "decoded_image_cache_max_bytes: " << decoded_image_cache_max_bytes
+         << std::endl;
+  stream << "image_gc_threshold_bytes: " << image_gc_threshold_bytes
+         << std::endl;
+  stream << "texture_upload_budget_bytes: " << texture_upload_budget_bytes
+         << std::endl;
+  stream << "text_layout_cache_max_bytes: " << text_layout_cache_max_bytes
+         << std::endl;
   return stream.str();
 }
 
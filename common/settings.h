@@ -35,13 +35,44 @@ class FrameTiming {
   static constexpr Phase kPhases[kCount] = {
       kVsyncStart, kBuildStart, kBuildFinish, kRasterStart, kRasterFinish};
 
+  // The parts of the time between |kRasterStart| and |kRasterFinish|, and the
+  // time the GPU took. Unlike the phases above, these are only available in
+  // the engine and are not reported to the framework. A part that could not be
+  // measured is zero.
+  enum RasterPhase {
+    // Prerolling the layer tree.
+    kPreroll,
+    // Painting the layer tree into the canvas of the frame.
+    kPaint,
+    // Flushing the drawing commands of the frame to the GPU.
+    kFlush,
+    // Presenting the frame, which includes swapping buffers.
+    kPresent,
+    // Waiting for a buffer to present the frame into, as part of |kPresent|.
+    // Only measured by surfaces that acquire the buffer while presenting, see
+    // |Settings::acquire_metal_drawable_at_present|.
+    kBufferWait,
+    // The time from submitting the drawing commands to the GPU until the GPU
+    // finished executing them. This is only known once the GPU is done, so it
+    // is the GPU time of the latest frame that finished on the GPU by the time
+    // this frame was rasterized, and usually not of this frame itself.
+    kGpu,
+    kRasterPhaseCount
+  };
+
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
     return data_[phase] = value;
   }
 
+  fml::TimeDelta Get(RasterPhase phase) const { return raster_data_[phase]; }
+  fml::TimeDelta Set(RasterPhase phase, fml::TimeDelta value) {
+    return raster_data_[phase] = value;
+  }
+
  private:
   fml::TimePoint data_[kCount];
+  fml::TimeDelta raster_data_[kRasterPhaseCount];
 };
 
 using TaskObserverAdd =
@@ -61,6 +92,8 @@ using Mappings = std::vector<std::unique_ptr<const fml::Mapping>>;
 using MappingsCallback = std::function<Mappings(void)>;
 
 using FrameRasterizedCallback = std::function<void(const FrameTiming&)>;
+using FrameTimingsReportCallback =
+    std::function<void(const std::vector<FrameTiming>&)>;
 
 class DartIsolate;
 
@@ -82,6 +115,11 @@ struct Settings {
   std::string isolate_snapshot_instr_path;  // deprecated
   MappingCallback isolate_snapshot_instr;
 
+  // Whether the snapshots that are mapped from files at the paths above are
+  // read into memory on a background thread as soon as they are mapped, so
+  // that the first frames don't stall on page faults.
+  bool prefault_snapshots = false;
+
   // Returns the Mapping to a kernel buffer which contains sources for dart:*
   // libraries.
   MappingCallback dart_library_sources_kernel;
@@ -107,12 +145,40 @@ struct Settings {
   std::string trace_allowlist;
   bool trace_startup = false;
   bool trace_systrace = false;
+  // Record the trace events of the engine natively and write them to this
+  // file in the Perfetto protobuf format when the shell is destroyed. See
+  // fml/perfetto_trace_writer.h.
+  std::string trace_to_file;
+  // Keep the most recent trace events of each thread in memory so that they
+  // can be dumped after a janky frame. See fml/flight_recorder.h.
+  bool enable_flight_recorder = true;
+  // The flight recorder is dumped to the caches directory when a frame takes
+  // longer than this many frame budgets from vsync to the end of
+  // rasterization. Zero disables the automatic dumps.
+  double flight_recorder_jank_threshold = 4;
+  // Also dump an SKP of the janky frame next to the trace events. Serializing
+  // the frame delays the next one, so the dumps are opt-in.
+  bool dump_skp_on_jank = false;
   bool dump_skp_on_shader_compilation = false;
+  // Draw the SKPs packaged in the "shaders" asset directory on the IO thread
+  // at launch so that their shaders are compiled before the app draws them.
+  bool warmup_skps = false;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
+  // Remove the persistent shader cache entries that were not used during more
+  // than this many launches of the app. Zero keeps all entries.
+  size_t persistent_cache_max_unused_launches = 0;
+  // Save the fallback fonts resolved by the platform font manager next to the
+  // persistent shader cache so that the next launch does not resolve them
+  // again.
+  bool persist_fallback_font_cache = false;
   bool endless_trace_buffer = false;
   bool enable_dart_profiling = false;
   bool disable_dart_asserts = false;
+  // The number of background isolates that are spawned in the group of the
+  // root isolate before its entrypoint runs, and that Dart code can check out
+  // through IsolatePool in dart:ui. Zero disables the pool.
+  size_t isolate_pool_size = 0;
 
   // Whether embedder only allows secure connections.
   bool may_insecurely_connect_to_all_domains = true;
@@ -136,6 +202,12 @@ struct Settings {
   // which cannot be accepted or dismissed in a CI environment.
   bool enable_observatory_publication = true;
 
+  // Whether the Dart VM service only starts once it is asked for with
+  // `DartServiceIsolate::RequestStartup`, instead of as the VM starts. This
+  // keeps the startup of profile builds close to that of release builds when
+  // nobody connects to the VM service.
+  bool lazy_observatory_startup = false;
+
   // The IP address to which the Dart VM service is bound.
   std::string observatory_host;
 
@@ -158,6 +230,14 @@ struct Settings {
   // Selects the SkParagraph implementation of the text layout engine.
   bool enable_skparagraph = false;
 
+  // Records pictures into engine display lists instead of SkPictures.
+  bool enable_display_list = false;
+
+  // Decodes the images that support it, like baseline JPEGs, into their YUV
+  // planes, which are uploaded and converted to RGB when they are first drawn
+  // instead of being converted on the CPU and uploaded as RGBA.
+  bool enable_yuv_image_decoding = false;
+
   // All shells in the process share the same VM. The last shell to shutdown
   // should typically shut down the VM as well. However, applications depend on
   // the behavior of "warming-up" the VM by creating a shell that does not do
@@ -221,6 +301,10 @@ struct Settings {
   bool icu_initialization_required = true;
   std::string icu_data_path;
   MappingCallback icu_mapper;
+  // Whether the ICU data is only handed to ICU when text is first laid out,
+  // or by a background task after the shell is created, instead of as the
+  // shell is created.
+  bool lazy_icu_initialization = false;
 
   // Assets settings
   fml::UniqueFD::element_type assets_dir =
@@ -231,6 +315,11 @@ struct Settings {
   // soon as a frame is rasterized.
   FrameRasterizedCallback frame_rasterized_callback;
 
+  // Callback to handle the timings of rasterized frames in batches, like the
+  // timings reported to ui.PlatformDispatcher.onReportTimings but without any
+  // Dart involvement. This is called on the raster thread.
+  FrameTimingsReportCallback frame_timings_report_callback;
+
   // This data will be available to the isolate immediately on launch via the
   // PlatformDispatcher.getPersistentIsolateData callback. This is meant for
   // information that the isolate cannot request asynchronously (platform
@@ -246,6 +335,154 @@ struct Settings {
   /// https://github.com/dart-lang/sdk/blob/ca64509108b3e7219c50d6c52877c85ab6a35ff2/runtime/vm/flag_list.h#L150
   int64_t old_gen_heap_size = -1;
 
+  /// The maximum number of bytes of raster cache images that are retained
+  /// across frames even when they were not drawn in the last frame. Unused
+  /// entries are evicted least recently used first once this budget is
+  /// exceeded. When 0, every raster cache entry not drawn in a frame is evicted
+  /// at the end of that frame.
+  size_t raster_cache_max_bytes = 0;
+
+  /// Whether the budgets of Skia's resource cache and of the raster cache are
+  /// sized together from the memory of the device, the frame size and how
+  /// much either cache churns, instead of from the frame size alone. This
+  /// overrides raster_cache_max_bytes.
+  bool adaptive_gpu_memory_budget = false;
+
+  /// The memory the platform allows the application to use, e.g. the memory
+  /// class of the device, that the adaptive GPU memory budget stays within.
+  /// When 0, only the physical memory of the device is taken into account.
+  size_t gpu_memory_limit_bytes = 0;
+
+  /// How far the scale a picture or layer is drawn at may differ from the one
+  /// of a raster cache image for it to be drawn from that image, e.g. 0.25 for
+  /// 25%, while no image at its own scale is ready. This keeps scale
+  /// animations drawing from the cache. When 0, images are only drawn at the
+  /// scale they were rasterized at.
+  double raster_cache_scale_tolerance = 0;
+
+  /// Whether raster cache images get mip levels so that they are sampled
+  /// smoothly when drawn scaled down under raster_cache_scale_tolerance.
+  bool raster_cache_scale_mipmaps = false;
+
+  /// Whether pictures that become worth caching in the raster cache are
+  /// rasterized on the IO task runner instead of on the raster task runner
+  /// during the frame. The pictures are drawn directly until their raster cache
+  /// entry is ready.
+  bool enable_async_raster_cache = false;
+
+  /// Whether the images the raster cache rasterizes pictures into are stored
+  /// in the persistent cache directory, so that later launches upload them
+  /// instead of rasterizing the same pictures again.
+  bool enable_persistent_raster_cache = false;
+
+  /// Whether the images stored across launches by the raster cache are
+  /// compressed. They take less space but take longer to load.
+  bool compress_persistent_raster_cache = false;
+
+  /// Whether Metal surfaces backed by a CAMetalLayer render each frame into an
+  /// intermediate texture and only acquire the next drawable of the layer when
+  /// presenting the frame. The GPU work of the frame is then submitted before
+  /// waiting for a drawable, at the cost of copying the frame into it.
+  bool acquire_metal_drawable_at_present = false;
+
+  /// The maximumDrawableCount of the CAMetalLayers of Metal surfaces, either
+  /// 2 or 3. When 0, the default of the layer is kept.
+  size_t metal_maximum_drawable_count = 0;
+
+  /// Whether Android platform views are composited without merging the raster
+  /// and platform threads. Frames are rasterized on the raster thread and the
+  /// platform view mutations of each frame are posted to the platform thread
+  /// as one transaction. The threads are only merged for the frames that set
+  /// up the platform views and their overlay surfaces.
+  bool enable_platform_view_transactions = false;
+
+  /// Whether the depth of the layer tree pipeline is picked at runtime from
+  /// the observed build and raster times. A single frame is kept in flight
+  /// while building and rasterizing fit in the frame budget, which lowers
+  /// latency. More frames are kept in flight when they don't, which favors
+  /// throughput.
+  bool enable_adaptive_pipeline_depth = false;
+
+  /// Whether frames begin some time after their vsync rather than right away,
+  /// so that they are predicted to finish just before their target time. The
+  /// delay follows the observed build and raster times and keeps a safety
+  /// margin, which shortens the time from input to display.
+  bool enable_just_in_time_begin_frame = false;
+
+  /// The frame rate to produce frames at while only a small part of the screen
+  /// changes from one frame to the next, such as for a blinking cursor. Frames
+  /// whose layer tree did not change at all are not drawn. 0 keeps producing
+  /// and drawing every frame at the rate of the display.
+  double idle_frame_rate = 0;
+
+  /// Whether layers with many children may preroll them concurrently on the
+  /// concurrent worker task runner instead of only on the raster thread.
+  bool enable_parallel_preroll = false;
+
+  /// Whether frames rendered in software are recorded first and then painted
+  /// in tiles concurrently on the concurrent worker task runner instead of only
+  /// on the raster thread. Has no effect on GPU backed surfaces.
+  bool enable_tiled_software_paint = false;
+
+  /// Whether frames of surfaces that support it are presented on a dedicated
+  /// thread, so that the raster thread can acquire and preroll the next frame
+  /// while the previous one is still presenting. The surface bounds how many
+  /// frames may be presenting once the next frame is painted. Only software
+  /// surfaces support it.
+  bool enable_threaded_present = false;
+
+  /// Whether the rasterizer skips to the newest frame when it fell behind,
+  /// dropping the frames that were produced before it without drawing them.
+  /// Favors showing the latest state over showing every frame.
+  bool drop_stale_frames = false;
+
+  /// Whether the steps of bringing up a shell that don't depend on each other
+  /// run in parallel. The default font manager is created on a worker thread
+  /// while the other subsystems are set up, and the IO subsystem is set up
+  /// without waiting for the vsync waiter.
+  bool enable_parallel_shell_startup = false;
+
+  /// The maximum number of bytes of decoded images that are retained by the IO
+  /// manager so that decoding the same encoded image at the same size again
+  /// shares the existing image instead of decoding it again. Entries are
+  /// evicted least recently used first once this budget is exceeded, and all of
+  /// them on a low memory warning. When 0, decoded images are not cached.
+  size_t decoded_image_cache_max_bytes = 0;
+
+  /// The number of bytes of decoded images uploaded to the GPU per frame
+  /// interval. Decoded images beyond the budget wait for the next interval, so
+  /// that bursts of uploads do not contend with rendering. When 0, images are
+  /// uploaded as soon as they are decoded.
+  size_t texture_upload_budget_bytes = 0;
+
+  /// The number of bytes of images alive in the process above which the next
+  /// idle notification hints the Dart VM to collect garbage, so that the
+  /// images that are no longer reachable release their textures. The
+  /// threshold is moved up by as much after each hint, so that the images that
+  /// stay reachable don't cause a collection at every idle notification. When
+  /// 0, the VM only collects the images based on their external size.
+  size_t image_gc_threshold_bytes = 0;
+
+  /// Whether the shells spawned from a shell with |Shell::Spawn| share its
+  /// caches of decoded images and raster cache entries instead of building
+  /// their own. They always share its font collection and GPU context.
+  bool share_spawned_engine_caches = false;
+
+  /// Whether assets requested by the framework over the asset channel are
+  /// read on the worker threads of the Dart VM instead of the UI thread.
+  bool load_assets_asynchronously = false;
+
+  /// The maximum number of bytes of shaped words that are retained by the
+  /// process wide text layout cache, or -1 for the default budget. The cache is
+  /// shared by every engine in the process, so the budget of the last shell
+  /// that was created applies.
+  int64_t text_layout_cache_max_bytes = -1;
+
+  /// Whether the pointer moves between two frames are coalesced into one move
+  /// per pointer, which is resampled to the target time of the frame. This
+  /// overrides the dispatcher chosen by the platform view.
+  bool resample_pointer_events = false;
+
   /// A timestamp representing when the engine started. The value is based
   /// on the clock used by the Dart timeline APIs. This timestamp is used
   /// to log a timeline event that tracks the latency of engine startup.
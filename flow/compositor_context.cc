@@ -9,10 +9,89 @@
 
 namespace flutter {
 
+std::optional<SkRect> FrameDamage::ComputeClipRect(LayerTree& layer_tree) {
+  frame_damage_ = std::nullopt;
+  buffer_damage_ = std::nullopt;
+
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+  if (!layer_tree.root_layer()) {
+    return std::nullopt;
+  }
+
+  if (prev_layer_tree_ == &layer_tree) {
+    // The same layer tree is drawn again, only the damage that the framebuffer
+    // accumulated needs to be repainted.
+    SkIRect buffer_damage = additional_damage_;
+    if (!buffer_damage.intersect(SkIRect::MakeSize(layer_tree.frame_size()))) {
+      buffer_damage.setEmpty();
+    }
+    frame_damage_ = SkIRect::MakeEmpty();
+    if (!clip_to_damage_) {
+      return std::nullopt;
+    }
+    buffer_damage_ = buffer_damage;
+    return SkRect::Make(buffer_damage);
+  }
+
+  // The paint regions of the previous layer tree are only recorded if it was
+  // diffed itself. If it wasn't, there is nothing to diff against.
+  const bool can_diff = prev_layer_tree_ && prev_layer_tree_->root_layer() &&
+                        !prev_layer_tree_->paint_region_map().empty() &&
+                        prev_layer_tree_->frame_size() ==
+                            layer_tree.frame_size() &&
+                        prev_layer_tree_->device_pixel_ratio() ==
+                            layer_tree.device_pixel_ratio();
+
+  const PaintRegionMap empty_paint_region_map;
+  DiffContext context(layer_tree.frame_size(), layer_tree.device_pixel_ratio(),
+                      layer_tree.paint_region_map(),
+                      can_diff ? prev_layer_tree_->paint_region_map()
+                               : empty_paint_region_map);
+  context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
+                                       layer_tree.frame_size().height()));
+  if (can_diff) {
+    layer_tree.root_layer()->Diff(&context, prev_layer_tree_->root_layer());
+  } else {
+    context.MarkSubtreeDirty();
+    layer_tree.root_layer()->Diff(&context, nullptr);
+  }
+  context.statistics().LogStatistics();
+
+  if (!can_diff) {
+    return std::nullopt;
+  }
+
+  Damage damage = context.ComputeDamage(additional_damage_);
+  frame_damage_ = damage.frame_damage;
+  if (!clip_to_damage_) {
+    return std::nullopt;
+  }
+  buffer_damage_ = damage.buffer_damage;
+  return SkRect::Make(damage.buffer_damage);
+#else
+  return std::nullopt;
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
+}
+
 CompositorContext::CompositorContext(fml::Milliseconds frame_budget)
-    : raster_time_(frame_budget), ui_time_(frame_budget) {}
+    : raster_cache_(std::make_shared<RasterCache>()),
+      raster_time_(frame_budget),
+      ui_time_(frame_budget) {}
+
+CompositorContext::~CompositorContext() {
+  raster_cache_->RemoveUser();
+}
 
-CompositorContext::~CompositorContext() = default;
+void CompositorContext::ShareRasterCache(CompositorContext& other) {
+  if (raster_cache_ == other.raster_cache_) {
+    return;
+  }
+  raster_cache_->RemoveUser();
+  raster_cache_ = other.raster_cache_;
+  raster_cache_->AddUser();
+  raster_cache_hits_ = raster_cache_->GetDrawHitCount();
+  raster_cache_misses_ = raster_cache_->GetDrawMissCount();
+}
 
 void CompositorContext::BeginFrame(ScopedFrame& frame,
                                    bool enable_instrumentation) {
@@ -24,12 +103,42 @@ void CompositorContext::BeginFrame(ScopedFrame& frame,
 
 void CompositorContext::EndFrame(ScopedFrame& frame,
                                  bool enable_instrumentation) {
-  raster_cache_.SweepAfterFrame();
+  raster_cache_->SweepAfterFrame();
   if (enable_instrumentation) {
     raster_time_.Stop();
+    RecordFrameStatistics(frame);
   }
 }
 
+void CompositorContext::RecordFrameStatistics(ScopedFrame& frame) {
+  FrameStatistics::Frame& statistics = frame_statistics_.current_frame();
+  // The draws of the other contexts sharing the raster cache since the
+  // previous frame are counted as well.
+  const size_t hits = raster_cache_->GetDrawHitCount();
+  const size_t misses = raster_cache_->GetDrawMissCount();
+  statistics.raster_cache_hits = hits - raster_cache_hits_;
+  statistics.raster_cache_misses = misses - raster_cache_misses_;
+  raster_cache_hits_ = hits;
+  raster_cache_misses_ = misses;
+
+  // These walk the raster cache or take locks, so they are only collected
+  // once per sample.
+  if (frame_statistics_.IsLastFrameOfSample()) {
+    statistics.raster_cache_bytes =
+        raster_cache_->EstimatePictureCacheByteSize() +
+        raster_cache_->EstimateLayerCacheByteSize();
+    if (frame.gr_context()) {
+      frame.gr_context()->getResourceCacheUsage(
+          &statistics.gpu_resource_count, &statistics.gpu_resource_bytes);
+    }
+    if (unref_queue_) {
+      statistics.pending_unref_objects = unref_queue_->GetPendingCount();
+    }
+  }
+
+  frame_statistics_.EndFrame();
+}
+
 std::unique_ptr<CompositorContext::ScopedFrame> CompositorContext::AcquireFrame(
     GrDirectContext* gr_context,
     SkCanvas* canvas,
@@ -69,9 +178,14 @@ CompositorContext::ScopedFrame::~ScopedFrame() {
 
 RasterStatus CompositorContext::ScopedFrame::Raster(
     flutter::LayerTree& layer_tree,
-    bool ignore_raster_cache) {
+    bool ignore_raster_cache,
+    FrameDamage* frame_damage) {
   TRACE_EVENT0("flutter", "CompositorContext::ScopedFrame::Raster");
+  const fml::TimePoint preroll_start = fml::TimePoint::Now();
   bool root_needs_readback = layer_tree.Preroll(*this, ignore_raster_cache);
+  const fml::TimePoint paint_start = fml::TimePoint::Now();
+  preroll_duration_ = paint_start - preroll_start;
+  paint_duration_ = fml::TimeDelta::Zero();
   bool needs_save_layer = root_needs_readback && !surface_supports_readback();
   PostPrerollResult post_preroll_result = PostPrerollResult::kSuccess;
   if (view_embedder_ && raster_thread_merger_) {
@@ -85,9 +199,23 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   if (post_preroll_result == PostPrerollResult::kSkipAndRetryFrame) {
     return RasterStatus::kSkipAndRetry;
   }
+
+  if (before_paint_callback_) {
+    before_paint_callback_();
+  }
+
+  std::optional<SkRect> clip_rect;
+  if (frame_damage) {
+    clip_rect = frame_damage->ComputeClipRect(layer_tree);
+  }
+
   // Clearing canvas after preroll reduces one render target switch when preroll
   // paints some raster cache.
   if (canvas()) {
+    if (clip_rect) {
+      canvas()->save();
+      canvas()->clipRect(*clip_rect);
+    }
     if (needs_save_layer) {
       FML_LOG(INFO) << "Using SaveLayer to protect non-readback surface";
       SkRect bounds = SkRect::Make(layer_tree.frame_size());
@@ -97,21 +225,37 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
     }
     canvas()->clear(SK_ColorTRANSPARENT);
   }
-  layer_tree.Paint(*this, ignore_raster_cache);
+  // Tiles are painted straight into the pixels of the frame canvas, which only
+  // works for software rendering and without a save layer in effect.
+  fml::ConcurrentTaskRunner* paint_task_runner =
+      context_.concurrent_paint_task_runner();
+  bool painted = false;
+  if (paint_task_runner && canvas() && !gr_context() && !view_embedder_ &&
+      !needs_save_layer) {
+    painted =
+        layer_tree.PaintInTiles(*this, paint_task_runner, ignore_raster_cache);
+  }
+  if (!painted) {
+    layer_tree.Paint(*this, ignore_raster_cache);
+  }
   if (canvas() && needs_save_layer) {
     canvas()->restore();
   }
+  if (canvas() && clip_rect) {
+    canvas()->restore();
+  }
+  paint_duration_ = fml::TimePoint::Now() - paint_start;
   return RasterStatus::kSuccess;
 }
 
 void CompositorContext::OnGrContextCreated() {
   texture_registry_.OnGrContextCreated();
-  raster_cache_.Clear();
+  raster_cache_->Clear();
 }
 
 void CompositorContext::OnGrContextDestroyed() {
   texture_registry_.OnGrContextDestroyed();
-  raster_cache_.Clear();
+  raster_cache_->Clear();
 }
 
 }  // namespace flutter
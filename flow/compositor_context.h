@@ -6,12 +6,16 @@
 #define FLUTTER_FLOW_COMPOSITOR_CONTEXT_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -50,6 +54,55 @@ enum class RasterStatus {
   kDiscarded
 };
 
+// Computes the region of a frame that needs to be repainted when the surface
+// supports partial repaint.
+class FrameDamage {
+ public:
+  // The layer tree that was presented before the frame whose damage is
+  // computed. Without one, the whole frame is considered damaged.
+  void SetPreviousLayerTree(const LayerTree* prev_layer_tree) {
+    prev_layer_tree_ = prev_layer_tree;
+  }
+
+  // Damage accumulated in the target framebuffer since it was last rendered
+  // to. This is repainted in addition to the region that changed between the
+  // previous and the current layer tree.
+  void AddAdditionalDamage(const SkIRect& damage) {
+    additional_damage_.join(damage);
+  }
+
+  // Whether painting is clipped to the damage, which it is by default.
+  // Without it the damage is only measured, and the whole framebuffer is
+  // repainted.
+  void SetClipToDamage(bool clip_to_damage) {
+    clip_to_damage_ = clip_to_damage;
+  }
+
+  // Diffs |layer_tree| against the previous layer tree and returns the rect
+  // that painting needs to be clipped to. Returns nullopt if the whole frame
+  // needs to be repainted.
+  //
+  // This also records the paint regions of |layer_tree| so that the next
+  // frame can be diffed against it.
+  std::optional<SkRect> ComputeClipRect(LayerTree& layer_tree);
+
+  // The region of the frame that changed since the previous frame. Only
+  // available after ComputeClipRect was called, unset if the whole frame
+  // changed.
+  std::optional<SkIRect> GetFrameDamage() const { return frame_damage_; }
+
+  // The region of the framebuffer that is repainted. Only available after
+  // ComputeClipRect was called, unset if the whole framebuffer is repainted.
+  std::optional<SkIRect> GetBufferDamage() const { return buffer_damage_; }
+
+ private:
+  const LayerTree* prev_layer_tree_ = nullptr;
+  SkIRect additional_damage_ = SkIRect::MakeEmpty();
+  bool clip_to_damage_ = true;
+  std::optional<SkIRect> frame_damage_;
+  std::optional<SkIRect> buffer_damage_;
+};
+
 class CompositorContext {
  public:
   class ScopedFrame {
@@ -77,10 +130,26 @@ class CompositorContext {
 
     bool surface_supports_readback() { return surface_supports_readback_; }
 
+    bool instrumentation_enabled() const { return instrumentation_enabled_; }
+
     GrDirectContext* gr_context() const { return gr_context_; }
 
+    // When |frame_damage| is provided, painting is clipped to the region of
+    // the frame that needs to be repainted.
     virtual RasterStatus Raster(LayerTree& layer_tree,
-                                bool ignore_raster_cache);
+                                bool ignore_raster_cache,
+                                FrameDamage* frame_damage);
+
+    // Called by |Raster| once the layer tree is prerolled, right before the
+    // canvas is drawn into.
+    void set_before_paint_callback(fml::closure callback) {
+      before_paint_callback_ = std::move(callback);
+    }
+
+    // How long prerolling and painting the layer tree took in the last call
+    // to |Raster|.
+    fml::TimeDelta preroll_duration() const { return preroll_duration_; }
+    fml::TimeDelta paint_duration() const { return paint_duration_; }
 
    private:
     CompositorContext& context_;
@@ -91,6 +160,9 @@ class CompositorContext {
     const bool instrumentation_enabled_;
     const bool surface_supports_readback_;
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
+    fml::TimeDelta preroll_duration_;
+    fml::TimeDelta paint_duration_;
+    fml::closure before_paint_callback_;
 
     FML_DISALLOW_COPY_AND_ASSIGN(ScopedFrame);
   };
@@ -112,7 +184,12 @@ class CompositorContext {
 
   void OnGrContextDestroyed();
 
-  RasterCache& raster_cache() { return raster_cache_; }
+  RasterCache& raster_cache() { return *raster_cache_; }
+
+  // Draws the frames of this context with the raster cache of |other|
+  // instead of its own, so that the entries and byte budget of the cache are
+  // shared between them. Both contexts must be used on the same thread.
+  void ShareRasterCache(CompositorContext& other);
 
   TextureRegistry& texture_registry() { return texture_registry_; }
 
@@ -122,17 +199,57 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  FrameStatistics& frame_statistics() { return frame_statistics_; }
+
+  // Lets the frame statistics include the objects |unref_queue| has yet to
+  // release.
+  void SetSkiaUnrefQueue(fml::RefPtr<SkiaUnrefQueue> unref_queue) {
+    unref_queue_ = std::move(unref_queue);
+  }
+
+  // Lets layers with many children preroll them concurrently on |task_runner|
+  // instead of only on the raster thread. Passing nullptr disables that.
+  void SetConcurrentPrerollTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+    concurrent_preroll_task_runner_ = std::move(task_runner);
+  }
+
+  fml::ConcurrentTaskRunner* concurrent_preroll_task_runner() const {
+    return concurrent_preroll_task_runner_.get();
+  }
+
+  // Lets frames that are rendered in software be painted in tiles
+  // concurrently on |task_runner|. See |LayerTree::PaintInTiles|. Passing
+  // nullptr disables that.
+  void SetConcurrentPaintTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+    concurrent_paint_task_runner_ = std::move(task_runner);
+  }
+
+  fml::ConcurrentTaskRunner* concurrent_paint_task_runner() const {
+    return concurrent_paint_task_runner_.get();
+  }
+
  private:
-  RasterCache raster_cache_;
+  std::shared_ptr<RasterCache> raster_cache_;
   TextureRegistry texture_registry_;
   Counter frame_count_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
+  FrameStatistics frame_statistics_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+  // The draw counts of the raster cache at the end of the previous frame.
+  size_t raster_cache_hits_ = 0;
+  size_t raster_cache_misses_ = 0;
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_preroll_task_runner_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_paint_task_runner_;
 
   void BeginFrame(ScopedFrame& frame, bool enable_instrumentation);
 
   void EndFrame(ScopedFrame& frame, bool enable_instrumentation);
 
+  void RecordFrameStatistics(ScopedFrame& frame);
+
   FML_DISALLOW_COPY_AND_ASSIGN(CompositorContext);
 };
 
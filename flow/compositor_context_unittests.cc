@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/compositor_context.h"
+
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/testing/diff_context_test.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+
+using FrameDamageTest = DiffContextTest;
+
+TEST_F(FrameDamageTest, RepaintsWholeFrameWithoutPreviousLayerTree) {
+  auto picture = CreatePicture(SkRect::MakeLTRB(10, 10, 60, 60), 1);
+  LayerTree tree(SkISize::Make(1000, 1000), 1.0f);
+  tree.set_root_layer(CreateContainerLayer(CreatePictureLayer(picture)));
+
+  FrameDamage frame_damage;
+  EXPECT_FALSE(frame_damage.ComputeClipRect(tree).has_value());
+  EXPECT_FALSE(frame_damage.GetFrameDamage().has_value());
+  EXPECT_FALSE(frame_damage.GetBufferDamage().has_value());
+
+  // The paint regions are still recorded for the next frame to diff against.
+  EXPECT_FALSE(tree.paint_region_map().empty());
+}
+
+TEST_F(FrameDamageTest, ClipsToRegionThatChanged) {
+  auto picture1 = CreatePicture(SkRect::MakeLTRB(10, 10, 60, 60), 1);
+  LayerTree tree1(SkISize::Make(1000, 1000), 1.0f);
+  tree1.set_root_layer(CreateContainerLayer(CreatePictureLayer(picture1)));
+  FrameDamage().ComputeClipRect(tree1);
+
+  auto picture2 = CreatePicture(SkRect::MakeLTRB(20, 20, 70, 70), 1);
+  LayerTree tree2(SkISize::Make(1000, 1000), 1.0f);
+  tree2.set_root_layer(CreateContainerLayer(CreatePictureLayer(picture2)));
+
+  FrameDamage frame_damage;
+  frame_damage.SetPreviousLayerTree(&tree1);
+  auto clip_rect = frame_damage.ComputeClipRect(tree2);
+  ASSERT_TRUE(clip_rect.has_value());
+  EXPECT_EQ(*clip_rect, SkRect::MakeLTRB(10, 10, 70, 70));
+  EXPECT_EQ(frame_damage.GetFrameDamage(), SkIRect::MakeLTRB(10, 10, 70, 70));
+  EXPECT_EQ(frame_damage.GetBufferDamage(), SkIRect::MakeLTRB(10, 10, 70, 70));
+}
+
+TEST_F(FrameDamageTest, RepaintsAdditionalDamage) {
+  auto picture = CreatePicture(SkRect::MakeLTRB(10, 10, 60, 60), 1);
+  LayerTree tree1(SkISize::Make(1000, 1000), 1.0f);
+  tree1.set_root_layer(CreateContainerLayer(CreatePictureLayer(picture)));
+  FrameDamage().ComputeClipRect(tree1);
+
+  LayerTree tree2(SkISize::Make(1000, 1000), 1.0f);
+  tree2.set_root_layer(CreateContainerLayer(CreatePictureLayer(picture)));
+
+  FrameDamage frame_damage;
+  frame_damage.SetPreviousLayerTree(&tree1);
+  frame_damage.AddAdditionalDamage(SkIRect::MakeLTRB(100, 100, 200, 200));
+  auto clip_rect = frame_damage.ComputeClipRect(tree2);
+  ASSERT_TRUE(clip_rect.has_value());
+  EXPECT_EQ(*clip_rect, SkRect::MakeLTRB(100, 100, 200, 200));
+  EXPECT_EQ(frame_damage.GetFrameDamage(), SkIRect::MakeEmpty());
+}
+
+TEST_F(FrameDamageTest, RepaintsWholeFrameAfterResize) {
+  auto picture = CreatePicture(SkRect::MakeLTRB(10, 10, 60, 60), 1);
+  LayerTree tree1(SkISize::Make(1000, 1000), 1.0f);
+  tree1.set_root_layer(CreateContainerLayer(CreatePictureLayer(picture)));
+  FrameDamage().ComputeClipRect(tree1);
+
+  LayerTree tree2(SkISize::Make(500, 500), 1.0f);
+  tree2.set_root_layer(CreateContainerLayer(CreatePictureLayer(picture)));
+
+  FrameDamage frame_damage;
+  frame_damage.SetPreviousLayerTree(&tree1);
+  EXPECT_FALSE(frame_damage.ComputeClipRect(tree2).has_value());
+}
+
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
+
+TEST(FrameStatisticsTest, SummarizesEverySample) {
+  FrameStatistics statistics;
+  for (size_t i = 0; i < FrameStatistics::kFramesPerSample; i++) {
+    EXPECT_EQ(statistics.sample_count(), 0u);
+    FrameStatistics::Frame& frame = statistics.current_frame();
+    frame.raster_cache_hits = 3;
+    frame.raster_cache_misses = 1;
+    frame.save_layers = 2;
+    frame.frames_in_flight = i % 3;
+    frame.dropped_frames = i % 2;
+    frame.damaged_fraction = 0.5;
+    if (statistics.IsLastFrameOfSample()) {
+      frame.raster_cache_bytes = 1024;
+      frame.pending_unref_objects = 7;
+    }
+    statistics.EndFrame();
+  }
+
+  ASSERT_EQ(statistics.sample_count(), 1u);
+  const FrameStatistics::Sample& sample = statistics.last_sample();
+  EXPECT_DOUBLE_EQ(sample.raster_cache_hit_rate, 0.75);
+  EXPECT_DOUBLE_EQ(sample.save_layers_per_frame, 2);
+  EXPECT_DOUBLE_EQ(sample.damaged_fraction, 0.5);
+  EXPECT_EQ(sample.max_frames_in_flight, 2u);
+  EXPECT_EQ(sample.dropped_frames, FrameStatistics::kFramesPerSample / 2);
+  EXPECT_EQ(sample.raster_cache_bytes, 1024u);
+  EXPECT_EQ(sample.pending_unref_objects, 7u);
+}
+
+TEST(FrameStatisticsTest, HitRateIsNegativeWithoutRasterCacheDraws) {
+  FrameStatistics statistics;
+  for (size_t i = 0; i < FrameStatistics::kFramesPerSample; i++) {
+    statistics.EndFrame();
+  }
+  EXPECT_LT(statistics.last_sample().raster_cache_hit_rate, 0);
+}
+
+TEST(FrameStatisticsTest, MakesTextOncePerSample) {
+  FrameStatistics statistics;
+  int made = 0;
+  auto make_text = [&made](const FrameStatistics::Sample&) {
+    made++;
+    return SkTextBlob::MakeFromString("text", SkFont());
+  };
+
+  statistics.GetSampleText(make_text);
+  statistics.EndFrame();
+  statistics.GetSampleText(make_text);
+  EXPECT_EQ(made, 1);
+
+  for (size_t i = 1; i < FrameStatistics::kFramesPerSample; i++) {
+    statistics.EndFrame();
+  }
+  statistics.GetSampleText(make_text);
+  EXPECT_EQ(made, 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -18,6 +18,7 @@ DiffContext::DiffContext(SkISize frame_size,
 void DiffContext::BeginSubtree() {
   state_stack_.push_back(state_);
   state_.rect_index_ = rects_->size();
+  state_.damage_index_ = damage_rects_.size();
 }
 
 void DiffContext::EndSubtree() {
@@ -27,7 +28,7 @@ void DiffContext::EndSubtree() {
 }
 
 DiffContext::State::State()
-    : dirty(false), cull_rect(kGiantRect), rect_index_(0) {}
+    : dirty(false), cull_rect(kGiantRect), rect_index_(0), damage_index_(0) {}
 
 void DiffContext::PushTransform(const SkMatrix& transform) {
   state_.transform.preConcat(transform);
@@ -110,6 +111,17 @@ void DiffContext::AddReadbackRegion(const SkIRect& rect) {
   readbacks_.push_back(std::move(readback));
 }
 
+bool DiffContext::IsRegionDamaged(const SkIRect& rect) const {
+  SkRect damage(damage_);
+  for (const auto& r : readbacks_) {
+    SkRect readback = SkRect::Make(r.rect);
+    if (readback.intersects(damage)) {
+      damage.join(readback);
+    }
+  }
+  return damage.intersects(SkRect::Make(rect));
+}
+
 PaintRegion DiffContext::CurrentSubtreeRegion() const {
   bool has_readback = std::any_of(
       readbacks_.begin(), readbacks_.end(),
@@ -117,15 +129,24 @@ PaintRegion DiffContext::CurrentSubtreeRegion() const {
   return PaintRegion(rects_, state_.rect_index_, rects_->size(), has_readback);
 }
 
+SkRect DiffContext::GetSubtreeDamage() const {
+  SkRect damage = SkRect::MakeEmpty();
+  for (size_t i = state_.damage_index_; i < damage_rects_.size(); ++i) {
+    damage.join(damage_rects_[i]);
+  }
+  return damage;
+}
+
 void DiffContext::AddDamage(const PaintRegion& damage) {
   FML_DCHECK(damage.is_valid());
   for (const auto& r : damage) {
-    damage_.join(r);
+    AddDamage(r);
   }
 }
 
 void DiffContext::AddDamage(const SkRect& rect) {
   damage_.join(rect);
+  damage_rects_.push_back(rect);
 }
 
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
@@ -147,8 +168,7 @@ PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
 void DiffContext::Statistics::LogStatistics() {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER("flutter", "DiffContext", reinterpret_cast<int64_t>(this),
-                    "NewPictures", new_pictures_, "PicturesTooComplexToCompare",
-                    pictures_too_complex_to_compare_, "DeepComparePictures",
+                    "NewPictures", new_pictures_, "DeepComparePictures",
                     deep_compare_pictures_, "SameInstancePictures",
                     same_instance_pictures_,
                     "DifferentInstanceButEqualPictures",
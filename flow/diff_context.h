@@ -103,6 +103,19 @@ class DiffContext {
   // Readback rect is in screen coordinates.
   void AddReadbackRegion(const SkIRect& rect);
 
+  // Returns whether anything diffed so far, which is everything painted below
+  // the current layer, changed within |rect|. Readback regions registered so
+  // far that overlap the damage count as changed as well.
+  //
+  // Rect is in screen coordinates.
+  bool IsRegionDamaged(const SkIRect& rect) const;
+
+  // Returns the bounds of the damage added since the current subtree began,
+  // e.g. by the children of a layer that diffed them within its subtree.
+  //
+  // Rect is in screen coordinates.
+  SkRect GetSubtreeDamage() const;
+
   // Returns the paint region for current subtree; Each rect in paint region is
   // in screen coordinates; Once a layer accumulates the paint regions of its
   // children, this PaintRegion value can be associated with the current layer
@@ -136,17 +149,13 @@ class DiffContext {
     // Picture replaced by different picture
     void AddNewPicture() { ++new_pictures_; }
 
-    // Picture that would require deep comparison but was considered too complex
-    // to serialize and thus was treated as new picture
-    void AddPictureTooComplexToCompare() { ++pictures_too_complex_to_compare_; }
-
     // Picture that has identical instance between frames
     void AddSameInstancePicture() { ++same_instance_pictures_; };
 
-    // Picture that had to be serialized to compare for equality
+    // Picture that had to be compared by content hash for equality
     void AddDeepComparePicture() { ++deep_compare_pictures_; }
 
-    // Picture that had to be serialized to compare (different instances),
+    // Picture that had to be compared by content hash (different instances),
     // but were equal
     void AddDifferentInstanceButEqualPicture() {
       ++different_instance_but_equal_pictures_;
@@ -157,7 +166,6 @@ class DiffContext {
 
    private:
     int new_pictures_ = 0;
-    int pictures_too_complex_to_compare_ = 0;
     int same_instance_pictures_ = 0;
     int deep_compare_pictures_ = 0;
     int different_instance_but_equal_pictures_ = 0;
@@ -173,6 +181,7 @@ class DiffContext {
     SkRect cull_rect;
     SkMatrix transform;
     size_t rect_index_;
+    size_t damage_index_;
   };
 
   std::shared_ptr<std::vector<SkRect>> rects_;
@@ -182,6 +191,9 @@ class DiffContext {
   std::vector<State> state_stack_;
 
   SkRect damage_ = SkRect::MakeEmpty();
+  // Every rect joined into |damage_|, so that the damage of a subtree can be
+  // told apart.
+  std::vector<SkRect> damage_rects_;
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
@@ -0,0 +1,1578 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkDrawable.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkRegion.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkVertices.h"
+#include "third_party/skia/src/core/SkDrawShadowInfo.h"
+
+namespace flutter {
+
+namespace {
+
+#define FOR_EACH_DISPLAY_LIST_OP(V) \
+  V(Save)                           \
+  V(SaveLayer)                      \
+  V(Restore)                        \
+  V(Translate)                      \
+  V(Scale)                          \
+  V(Concat)                         \
+  V(SetMatrix)                      \
+  V(ClipRect)                       \
+  V(ClipRRect)                      \
+  V(ClipPath)                       \
+  V(ClipRegion)                     \
+  V(DrawPaint)                      \
+  V(DrawRect)                       \
+  V(DrawOval)                       \
+  V(DrawRRect)                      \
+  V(DrawDRRect)                     \
+  V(DrawArc)                        \
+  V(DrawPath)                       \
+  V(DrawPoints)                     \
+  V(DrawRegion)                     \
+  V(DrawImage)                      \
+  V(DrawImageRect)                  \
+  V(DrawImageLattice)               \
+  V(DrawAtlas)                      \
+  V(DrawVertices)                   \
+  V(DrawTextBlob)                   \
+  V(DrawPatch)                      \
+  V(DrawEdgeAAQuad)                 \
+  V(DrawShadowRec)                  \
+  V(DrawPicture)                    \
+  V(DrawAnnotation)
+
+enum class OpType : uint8_t {
+#define DISPLAY_LIST_OP_TYPE(name) k##name,
+  FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_TYPE)
+#undef DISPLAY_LIST_OP_TYPE
+};
+
+// Every operation is padded to a multiple of this, so that the one after it
+// is aligned as well.
+constexpr size_t kOpAlignment = 8;
+
+constexpr size_t AlignOpSize(size_t size) {
+  return (size + kOpAlignment - 1) & ~(kOpAlignment - 1);
+}
+
+// The buffer of a recorder starts out large enough for a few dozen
+// operations and doubles from there.
+constexpr size_t kMinAllocation = 1024;
+
+// The ids of display lists start above the range of SkPicture::uniqueID.
+std::atomic<uint64_t> next_unique_id = uint64_t{1} << 32;
+
+// The header of every operation. The operation is followed by |size| minus
+// its own size bytes of arrays, like the points of DrawPointsOp.
+struct Op {
+  OpType type;
+  uint32_t size;
+};
+
+// The array of |T| that starts |offset| bytes after |ptr|.
+template <typename T>
+const T* ArrayAt(const void* ptr, size_t offset = 0) {
+  return reinterpret_cast<const T*>(static_cast<const uint8_t*>(ptr) + offset);
+}
+
+// An operation that draws, which is skipped by the playback when its bounds,
+// if they were cheap enough to compute while recording, are outside of the
+// clip.
+struct DrawOp : Op {
+  bool bounded = false;
+  SkRect bounds = SkRect::MakeEmpty();
+
+  bool Rejects(SkCanvas* canvas) const {
+    return bounded && canvas->quickReject(bounds);
+  }
+};
+
+// Sets the bounds of |op| to those of |geometry| as drawn with |paint|,
+// unless the effects of the paint prevent computing them cheaply.
+void SetBounds(DrawOp* op, const SkRect& geometry, const SkPaint* paint) {
+  if (!paint) {
+    op->bounds = geometry;
+  } else if (paint->canComputeFastBounds()) {
+    SkRect storage;
+    op->bounds = paint->computeFastBounds(geometry, &storage);
+  } else {
+    return;
+  }
+  op->bounded = true;
+}
+
+// The paint of the operations that may draw without one.
+struct OptionalPaint {
+  explicit OptionalPaint(const SkPaint* paint)
+      : has_paint(paint != nullptr), paint(paint ? *paint : SkPaint()) {}
+
+  const bool has_paint;
+  const SkPaint paint;
+
+  const SkPaint* get() const { return has_paint ? &paint : nullptr; }
+
+  bool operator==(const OptionalPaint& other) const {
+    return has_paint == other.has_paint && (!has_paint || paint == other.paint);
+  }
+};
+
+struct SaveOp final : Op {
+  static constexpr auto kType = OpType::kSave;
+
+  void RenderTo(SkCanvas* canvas) const { canvas->save(); }
+
+  bool Equals(const SaveOp& other) const { return true; }
+};
+
+struct SaveLayerOp final : Op {
+  static constexpr auto kType = OpType::kSaveLayer;
+
+  explicit SaveLayerOp(const SkCanvas::SaveLayerRec& rec)
+      : has_bounds(rec.fBounds != nullptr),
+        bounds(rec.fBounds ? *rec.fBounds : SkRect::MakeEmpty()),
+        paint(rec.fPaint),
+        backdrop(sk_ref_sp(rec.fBackdrop)),
+        flags(rec.fSaveLayerFlags) {}
+
+  const bool has_bounds;
+  const SkRect bounds;
+  const OptionalPaint paint;
+  const sk_sp<const SkImageFilter> backdrop;
+  const SkCanvas::SaveLayerFlags flags;
+
+  void RenderTo(SkCanvas* canvas) const {
+    canvas->saveLayer(SkCanvas::SaveLayerRec(has_bounds ? &bounds : nullptr,
+                                             paint.get(), backdrop.get(),
+                                             flags));
+  }
+
+  bool Equals(const SaveLayerOp& other) const {
+    return has_bounds == other.has_bounds && bounds == other.bounds &&
+           paint == other.paint && backdrop == other.backdrop &&
+           flags == other.flags;
+  }
+};
+
+struct RestoreOp final : Op {
+  static constexpr auto kType = OpType::kRestore;
+
+  void RenderTo(SkCanvas* canvas) const { canvas->restore(); }
+
+  bool Equals(const RestoreOp& other) const { return true; }
+};
+
+struct TranslateOp final : Op {
+  static constexpr auto kType = OpType::kTranslate;
+
+  TranslateOp(SkScalar dx, SkScalar dy) : dx(dx), dy(dy) {}
+
+  const SkScalar dx;
+  const SkScalar dy;
+
+  void RenderTo(SkCanvas* canvas) const { canvas->translate(dx, dy); }
+
+  bool Equals(const TranslateOp& other) const {
+    return dx == other.dx && dy == other.dy;
+  }
+};
+
+struct ScaleOp final : Op {
+  static constexpr auto kType = OpType::kScale;
+
+  ScaleOp(SkScalar sx, SkScalar sy) : sx(sx), sy(sy) {}
+
+  const SkScalar sx;
+  const SkScalar sy;
+
+  void RenderTo(SkCanvas* canvas) const { canvas->scale(sx, sy); }
+
+  bool Equals(const ScaleOp& other) const {
+    return sx == other.sx && sy == other.sy;
+  }
+};
+
+struct ConcatOp final : Op {
+  static constexpr auto kType = OpType::kConcat;
+
+  explicit ConcatOp(const SkM44& matrix) : matrix(matrix) {}
+
+  const SkM44 matrix;
+
+  void RenderTo(SkCanvas* canvas) const { canvas->concat(matrix); }
+
+  bool Equals(const ConcatOp& other) const { return matrix == other.matrix; }
+};
+
+// Replaces the matrix that was recorded so far, which on playback is
+// relative to the matrix of the canvas the display list is drawn into.
+struct SetMatrixOp final : Op {
+  static constexpr auto kType = OpType::kSetMatrix;
+
+  explicit SetMatrixOp(const SkM44& matrix) : matrix(matrix) {}
+
+  const SkM44 matrix;
+
+  void RenderTo(SkCanvas* canvas, const SkM44& base_matrix) const {
+    canvas->setMatrix(base_matrix * matrix);
+  }
+
+  bool Equals(const SetMatrixOp& other) const {
+    return matrix == other.matrix;
+  }
+};
+
+struct ClipRectOp final : Op {
+  static constexpr auto kType = OpType::kClipRect;
+
+  ClipRectOp(const SkRect& rect, SkClipOp clip_op, bool anti_alias)
+      : rect(rect), clip_op(clip_op), anti_alias(anti_alias) {}
+
+  const SkRect rect;
+  const SkClipOp clip_op;
+  const bool anti_alias;
+
+  void RenderTo(SkCanvas* canvas) const {
+    canvas->clipRect(rect, clip_op, anti_alias);
+  }
+
+  bool Equals(const ClipRectOp& other) const {
+    return rect == other.rect && clip_op == other.clip_op &&
+           anti_alias == other.anti_alias;
+  }
+};
+
+struct ClipRRectOp final : Op {
+  static constexpr auto kType = OpType::kClipRRect;
+
+  ClipRRectOp(const SkRRect& rrect, SkClipOp clip_op, bool anti_alias)
+      : rrect(rrect), clip_op(clip_op), anti_alias(anti_alias) {}
+
+  const SkRRect rrect;
+  const SkClipOp clip_op;
+  const bool anti_alias;
+
+  void RenderTo(SkCanvas* canvas) const {
+    canvas->clipRRect(rrect, clip_op, anti_alias);
+  }
+
+  bool Equals(const ClipRRectOp& other) const {
+    return rrect == other.rrect && clip_op == other.clip_op &&
+           anti_alias == other.anti_alias;
+  }
+};
+
+struct ClipPathOp final : Op {
+  static constexpr auto kType = OpType::kClipPath;
+
+  ClipPathOp(const SkPath& path, SkClipOp clip_op, bool anti_alias)
+      : path(path), clip_op(clip_op), anti_alias(anti_alias) {}
+
+  const SkPath path;
+  const SkClipOp clip_op;
+  const bool anti_alias;
+
+  void RenderTo(SkCanvas* canvas) const {
+    canvas->clipPath(path, clip_op, anti_alias);
+  }
+
+  bool Equals(const ClipPathOp& other) const {
+    return path == other.path && clip_op == other.clip_op &&
+           anti_alias == other.anti_alias;
+  }
+};
+
+struct ClipRegionOp final : Op {
+  static constexpr auto kType = OpType::kClipRegion;
+
+  ClipRegionOp(const SkRegion& region, SkClipOp clip_op)
+      : region(region), clip_op(clip_op) {}
+
+  const SkRegion region;
+  const SkClipOp clip_op;
+
+  void RenderTo(SkCanvas* canvas) const { canvas->clipRegion(region, clip_op); }
+
+  bool Equals(const ClipRegionOp& other) const {
+    return region == other.region && clip_op == other.clip_op;
+  }
+};
+
+struct DrawPaintOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawPaint;
+
+  explicit DrawPaintOp(const SkPaint& paint) : paint(paint) {}
+
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const { canvas->drawPaint(paint); }
+
+  bool Equals(const DrawPaintOp& other) const { return paint == other.paint; }
+};
+
+struct DrawRectOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawRect;
+
+  DrawRectOp(const SkRect& rect, const SkPaint& paint)
+      : rect(rect), paint(paint) {}
+
+  const SkRect rect;
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawRect(rect, paint);
+    }
+  }
+
+  bool Equals(const DrawRectOp& other) const {
+    return rect == other.rect && paint == other.paint;
+  }
+};
+
+struct DrawOvalOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawOval;
+
+  DrawOvalOp(const SkRect& oval, const SkPaint& paint)
+      : oval(oval), paint(paint) {}
+
+  const SkRect oval;
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawOval(oval, paint);
+    }
+  }
+
+  bool Equals(const DrawOvalOp& other) const {
+    return oval == other.oval && paint == other.paint;
+  }
+};
+
+struct DrawRRectOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawRRect;
+
+  DrawRRectOp(const SkRRect& rrect, const SkPaint& paint)
+      : rrect(rrect), paint(paint) {}
+
+  const SkRRect rrect;
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawRRect(rrect, paint);
+    }
+  }
+
+  bool Equals(const DrawRRectOp& other) const {
+    return rrect == other.rrect && paint == other.paint;
+  }
+};
+
+struct DrawDRRectOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawDRRect;
+
+  DrawDRRectOp(const SkRRect& outer, const SkRRect& inner, const SkPaint& paint)
+      : outer(outer), inner(inner), paint(paint) {}
+
+  const SkRRect outer;
+  const SkRRect inner;
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawDRRect(outer, inner, paint);
+    }
+  }
+
+  bool Equals(const DrawDRRectOp& other) const {
+    return outer == other.outer && inner == other.inner &&
+           paint == other.paint;
+  }
+};
+
+struct DrawArcOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawArc;
+
+  DrawArcOp(const SkRect& oval,
+            SkScalar start_angle,
+            SkScalar sweep_angle,
+            bool use_center,
+            const SkPaint& paint)
+      : oval(oval),
+        start_angle(start_angle),
+        sweep_angle(sweep_angle),
+        use_center(use_center),
+        paint(paint) {}
+
+  const SkRect oval;
+  const SkScalar start_angle;
+  const SkScalar sweep_angle;
+  const bool use_center;
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawArc(oval, start_angle, sweep_angle, use_center, paint);
+    }
+  }
+
+  bool Equals(const DrawArcOp& other) const {
+    return oval == other.oval && start_angle == other.start_angle &&
+           sweep_angle == other.sweep_angle && use_center == other.use_center &&
+           paint == other.paint;
+  }
+};
+
+struct DrawPathOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawPath;
+
+  DrawPathOp(const SkPath& path, const SkPaint& paint)
+      : path(path), paint(paint) {}
+
+  const SkPath path;
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawPath(path, paint);
+    }
+  }
+
+  bool Equals(const DrawPathOp& other) const {
+    return path == other.path && paint == other.paint;
+  }
+};
+
+// Followed by |count| points.
+struct DrawPointsOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawPoints;
+
+  DrawPointsOp(SkCanvas::PointMode mode, size_t count, const SkPaint& paint)
+      : mode(mode), count(count), paint(paint) {}
+
+  const SkCanvas::PointMode mode;
+  const size_t count;
+  const SkPaint paint;
+
+  const SkPoint* points() const { return ArrayAt<SkPoint>(this + 1); }
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawPoints(mode, count, points(), paint);
+    }
+  }
+
+  bool Equals(const DrawPointsOp& other) const {
+    return mode == other.mode && count == other.count &&
+           paint == other.paint &&
+           memcmp(points(), other.points(), count * sizeof(SkPoint)) == 0;
+  }
+};
+
+struct DrawRegionOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawRegion;
+
+  DrawRegionOp(const SkRegion& region, const SkPaint& paint)
+      : region(region), paint(paint) {}
+
+  const SkRegion region;
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawRegion(region, paint);
+    }
+  }
+
+  bool Equals(const DrawRegionOp& other) const {
+    return region == other.region && paint == other.paint;
+  }
+};
+
+struct DrawImageOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawImage;
+
+  DrawImageOp(const SkImage* image,
+              SkScalar left,
+              SkScalar top,
+              const SkSamplingOptions& sampling,
+              const SkPaint* paint)
+      : image(sk_ref_sp(image)),
+        left(left),
+        top(top),
+        sampling(sampling),
+        paint(paint) {}
+
+  const sk_sp<const SkImage> image;
+  const SkScalar left;
+  const SkScalar top;
+  const SkSamplingOptions sampling;
+  const OptionalPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawImage(image.get(), left, top, sampling, paint.get());
+    }
+  }
+
+  bool Equals(const DrawImageOp& other) const {
+    return image == other.image && left == other.left && top == other.top &&
+           sampling == other.sampling && paint == other.paint;
+  }
+};
+
+struct DrawImageRectOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawImageRect;
+
+  DrawImageRectOp(const SkImage* image,
+                  const SkRect& src,
+                  const SkRect& dst,
+                  const SkSamplingOptions& sampling,
+                  const SkPaint* paint,
+                  SkCanvas::SrcRectConstraint constraint)
+      : image(sk_ref_sp(image)),
+        src(src),
+        dst(dst),
+        sampling(sampling),
+        paint(paint),
+        constraint(constraint) {}
+
+  const sk_sp<const SkImage> image;
+  const SkRect src;
+  const SkRect dst;
+  const SkSamplingOptions sampling;
+  const OptionalPaint paint;
+  const SkCanvas::SrcRectConstraint constraint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawImageRect(image.get(), src, dst, sampling, paint.get(),
+                            constraint);
+    }
+  }
+
+  bool Equals(const DrawImageRectOp& other) const {
+    return image == other.image && src == other.src && dst == other.dst &&
+           sampling == other.sampling && paint == other.paint &&
+           constraint == other.constraint;
+  }
+};
+
+// Followed by the x and y divs, and for every cell of the lattice its color
+// and its rect type, if the lattice has them.
+struct DrawImageLatticeOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawImageLattice;
+
+  DrawImageLatticeOp(const SkImage* image,
+                     const SkCanvas::Lattice& lattice,
+                     const SkRect& dst,
+                     SkFilterMode filter,
+                     const SkPaint* paint)
+      : image(sk_ref_sp(image)),
+        x_count(lattice.fXCount),
+        y_count(lattice.fYCount),
+        has_colors(lattice.fColors != nullptr),
+        has_rect_types(lattice.fRectTypes != nullptr),
+        has_lattice_bounds(lattice.fBounds != nullptr),
+        lattice_bounds(lattice.fBounds ? *lattice.fBounds
+                                       : SkIRect::MakeEmpty()),
+        dst(dst),
+        filter(filter),
+        paint(paint) {}
+
+  const sk_sp<const SkImage> image;
+  const int x_count;
+  const int y_count;
+  const bool has_colors;
+  const bool has_rect_types;
+  const bool has_lattice_bounds;
+  const SkIRect lattice_bounds;
+  const SkRect dst;
+  const SkFilterMode filter;
+  const OptionalPaint paint;
+
+  static size_t ExtraSize(int x_count,
+                          int y_count,
+                          bool has_colors,
+                          bool has_rect_types) {
+    const size_t cells = (x_count + 1) * (y_count + 1);
+    return (x_count + y_count) * sizeof(int) +
+           (has_colors ? cells * sizeof(SkColor) : 0) +
+           (has_rect_types ? cells * sizeof(SkCanvas::Lattice::RectType) : 0);
+  }
+
+  const int* x_divs() const { return ArrayAt<int>(this + 1); }
+
+  const int* y_divs() const { return x_divs() + x_count; }
+
+  const SkColor* colors() const {
+    return has_colors ? ArrayAt<SkColor>(y_divs() + y_count) : nullptr;
+  }
+
+  const SkCanvas::Lattice::RectType* rect_types() const {
+    if (!has_rect_types) {
+      return nullptr;
+    }
+    const size_t colors_size =
+        has_colors ? (x_count + 1) * (y_count + 1) * sizeof(SkColor) : 0;
+    return ArrayAt<SkCanvas::Lattice::RectType>(y_divs() + y_count,
+                                                colors_size);
+  }
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (Rejects(canvas)) {
+      return;
+    }
+    SkCanvas::Lattice lattice;
+    lattice.fXDivs = x_divs();
+    lattice.fYDivs = y_divs();
+    lattice.fRectTypes = rect_types();
+    lattice.fXCount = x_count;
+    lattice.fYCount = y_count;
+    lattice.fBounds = has_lattice_bounds ? &lattice_bounds : nullptr;
+    lattice.fColors = colors();
+    canvas->drawImageLattice(image.get(), lattice, dst, filter, paint.get());
+  }
+
+  bool Equals(const DrawImageLatticeOp& other) const {
+    return image == other.image && x_count == other.x_count &&
+           y_count == other.y_count && has_colors == other.has_colors &&
+           has_rect_types == other.has_rect_types &&
+           has_lattice_bounds == other.has_lattice_bounds &&
+           lattice_bounds == other.lattice_bounds && dst == other.dst &&
+           filter == other.filter && paint == other.paint &&
+           memcmp(x_divs(), other.x_divs(),
+                  ExtraSize(x_count, y_count, has_colors, has_rect_types)) ==
+               0;
+  }
+};
+
+// Followed by |count| transforms, texture rects and, if the atlas has them,
+// colors.
+struct DrawAtlasOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawAtlas;
+
+  DrawAtlasOp(const SkImage* atlas,
+              int count,
+              bool has_colors,
+              SkBlendMode mode,
+              const SkSamplingOptions& sampling,
+              const SkRect* cull,
+              const SkPaint* paint)
+      : atlas(sk_ref_sp(atlas)),
+        count(count),
+        has_colors(has_colors),
+        mode(mode),
+        sampling(sampling),
+        has_cull(cull != nullptr),
+        cull(cull ? *cull : SkRect::MakeEmpty()),
+        paint(paint) {}
+
+  const sk_sp<const SkImage> atlas;
+  const int count;
+  const bool has_colors;
+  const SkBlendMode mode;
+  const SkSamplingOptions sampling;
+  const bool has_cull;
+  const SkRect cull;
+  const OptionalPaint paint;
+
+  static size_t ExtraSize(int count, bool has_colors) {
+    return count * (sizeof(SkRSXform) + sizeof(SkRect) +
+                    (has_colors ? sizeof(SkColor) : 0));
+  }
+
+  const SkRSXform* xforms() const { return ArrayAt<SkRSXform>(this + 1); }
+
+  const SkRect* tex() const { return ArrayAt<SkRect>(xforms() + count); }
+
+  const SkColor* colors() const {
+    return has_colors ? ArrayAt<SkColor>(tex() + count) : nullptr;
+  }
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawAtlas(atlas.get(), xforms(), tex(), colors(), count, mode,
+                        sampling, has_cull ? &cull : nullptr, paint.get());
+    }
+  }
+
+  bool Equals(const DrawAtlasOp& other) const {
+    return atlas == other.atlas && count == other.count &&
+           has_colors == other.has_colors && mode == other.mode &&
+           sampling == other.sampling && has_cull == other.has_cull &&
+           cull == other.cull && paint == other.paint &&
+           memcmp(xforms(), other.xforms(), ExtraSize(count, has_colors)) == 0;
+  }
+};
+
+struct DrawVerticesOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawVertices;
+
+  DrawVerticesOp(const SkVertices* vertices,
+                 SkBlendMode mode,
+                 const SkPaint& paint)
+      : vertices(sk_ref_sp(vertices)), mode(mode), paint(paint) {}
+
+  const sk_sp<const SkVertices> vertices;
+  const SkBlendMode mode;
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawVertices(vertices.get(), mode, paint);
+    }
+  }
+
+  bool Equals(const DrawVerticesOp& other) const {
+    return vertices == other.vertices && mode == other.mode &&
+           paint == other.paint;
+  }
+};
+
+struct DrawTextBlobOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawTextBlob;
+
+  DrawTextBlobOp(const SkTextBlob* blob,
+                 SkScalar x,
+                 SkScalar y,
+                 const SkPaint& paint)
+      : blob(sk_ref_sp(blob)), x(x), y(y), paint(paint) {}
+
+  const sk_sp<const SkTextBlob> blob;
+  const SkScalar x;
+  const SkScalar y;
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawTextBlob(blob.get(), x, y, paint);
+    }
+  }
+
+  bool Equals(const DrawTextBlobOp& other) const {
+    return blob == other.blob && x == other.x && y == other.y &&
+           paint == other.paint;
+  }
+};
+
+struct DrawPatchOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawPatch;
+
+  DrawPatchOp(const SkPoint cubics[12],
+              const SkColor colors[4],
+              const SkPoint tex_coords[4],
+              SkBlendMode mode,
+              const SkPaint& paint)
+      : has_colors(colors != nullptr),
+        has_tex_coords(tex_coords != nullptr),
+        mode(mode),
+        paint(paint) {
+    memcpy(this->cubics, cubics, sizeof(this->cubics));
+    if (colors) {
+      memcpy(this->colors, colors, sizeof(this->colors));
+    }
+    if (tex_coords) {
+      memcpy(this->tex_coords, tex_coords, sizeof(this->tex_coords));
+    }
+  }
+
+  SkPoint cubics[12];
+  SkColor colors[4] = {};
+  SkPoint tex_coords[4] = {};
+  const bool has_colors;
+  const bool has_tex_coords;
+  const SkBlendMode mode;
+  const SkPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawPatch(cubics, has_colors ? colors : nullptr,
+                        has_tex_coords ? tex_coords : nullptr, mode, paint);
+    }
+  }
+
+  bool Equals(const DrawPatchOp& other) const {
+    return memcmp(cubics, other.cubics, sizeof(cubics)) == 0 &&
+           memcmp(colors, other.colors, sizeof(colors)) == 0 &&
+           memcmp(tex_coords, other.tex_coords, sizeof(tex_coords)) == 0 &&
+           has_colors == other.has_colors &&
+           has_tex_coords == other.has_tex_coords && mode == other.mode &&
+           paint == other.paint;
+  }
+};
+
+struct DrawEdgeAAQuadOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawEdgeAAQuad;
+
+  DrawEdgeAAQuadOp(const SkRect& rect,
+                   const SkPoint clip[4],
+                   SkCanvas::QuadAAFlags aa_flags,
+                   const SkColor4f& color,
+                   SkBlendMode mode)
+      : rect(rect),
+        has_clip(clip != nullptr),
+        aa_flags(aa_flags),
+        color(color),
+        mode(mode) {
+    if (clip) {
+      memcpy(this->clip, clip, sizeof(this->clip));
+    }
+  }
+
+  const SkRect rect;
+  SkPoint clip[4] = {};
+  const bool has_clip;
+  const SkCanvas::QuadAAFlags aa_flags;
+  const SkColor4f color;
+  const SkBlendMode mode;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->experimental_DrawEdgeAAQuad(rect, has_clip ? clip : nullptr,
+                                          aa_flags, color, mode);
+    }
+  }
+
+  bool Equals(const DrawEdgeAAQuadOp& other) const {
+    return rect == other.rect && memcmp(clip, other.clip, sizeof(clip)) == 0 &&
+           has_clip == other.has_clip && aa_flags == other.aa_flags &&
+           color == other.color && mode == other.mode;
+  }
+};
+
+struct DrawShadowRecOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawShadowRec;
+
+  DrawShadowRecOp(const SkPath& path, const SkDrawShadowRec& rec)
+      : path(path), rec(rec) {}
+
+  const SkPath path;
+  const SkDrawShadowRec rec;
+
+  void RenderTo(SkCanvas* canvas) const {
+    canvas->private_draw_shadow_rec(path, rec);
+  }
+
+  bool Equals(const DrawShadowRecOp& other) const {
+    // The shadow rec is a plain struct of floats and colors.
+    return path == other.path && memcmp(&rec, &other.rec, sizeof(rec)) == 0;
+  }
+};
+
+struct DrawPictureOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawPicture;
+
+  DrawPictureOp(const SkPicture* picture,
+                const SkMatrix* matrix,
+                const SkPaint* paint)
+      : picture(sk_ref_sp(picture)),
+        has_matrix(matrix != nullptr),
+        matrix(matrix ? *matrix : SkMatrix::I()),
+        paint(paint) {}
+
+  const sk_sp<const SkPicture> picture;
+  const bool has_matrix;
+  const SkMatrix matrix;
+  const OptionalPaint paint;
+
+  void RenderTo(SkCanvas* canvas) const {
+    if (!Rejects(canvas)) {
+      canvas->drawPicture(picture.get(), has_matrix ? &matrix : nullptr,
+                          paint.get());
+    }
+  }
+
+  bool Equals(const DrawPictureOp& other) const {
+    return picture == other.picture && has_matrix == other.has_matrix &&
+           matrix == other.matrix && paint == other.paint;
+  }
+};
+
+// Followed by the key, including its terminating null character.
+struct DrawAnnotationOp final : DrawOp {
+  static constexpr auto kType = OpType::kDrawAnnotation;
+
+  DrawAnnotationOp(const SkRect& rect, size_t key_size, SkData* value)
+      : rect(rect), key_size(key_size), value(sk_ref_sp(value)) {}
+
+  const SkRect rect;
+  const size_t key_size;
+  const sk_sp<SkData> value;
+
+  const char* key() const { return ArrayAt<char>(this + 1); }
+
+  void RenderTo(SkCanvas* canvas) const {
+    canvas->drawAnnotation(rect, key(), value.get());
+  }
+
+  bool Equals(const DrawAnnotationOp& other) const {
+    return rect == other.rect && key_size == other.key_size &&
+           memcmp(key(), other.key(), key_size) == 0 && value == other.value;
+  }
+};
+
+template <typename T>
+void RenderOp(const T& op, SkCanvas* canvas, const SkM44& base_matrix) {
+  op.RenderTo(canvas);
+}
+
+void RenderOp(const SetMatrixOp& op,
+              SkCanvas* canvas,
+              const SkM44& base_matrix) {
+  op.RenderTo(canvas, base_matrix);
+}
+
+void DestroyOps(uint8_t* storage, size_t used) {
+  uint8_t* end = storage + used;
+  while (storage < end) {
+    Op* op = reinterpret_cast<Op*>(storage);
+    storage += op->size;
+    switch (op->type) {
+#define DISPLAY_LIST_DESTROY_OP(name)        \
+  case OpType::k##name:                      \
+    static_cast<name##Op*>(op)->~name##Op(); \
+    break;
+      FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_DESTROY_OP)
+#undef DISPLAY_LIST_DESTROY_OP
+    }
+  }
+}
+
+}  // namespace
+
+DisplayList::DisplayList(std::unique_ptr<uint8_t[]> storage,
+                         size_t used,
+                         int op_count,
+                         const SkRect& bounds)
+    : storage_(std::move(storage)),
+      used_(used),
+      op_count_(op_count),
+      bounds_(bounds),
+      unique_id_(next_unique_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+DisplayList::~DisplayList() {
+  DestroyOps(storage_.get(), used_);
+}
+
+bool DisplayList::Equals(const DisplayList& other) const {
+  if (this == &other) {
+    return true;
+  }
+  if (op_count_ != other.op_count_ || used_ != other.used_ ||
+      bounds_ != other.bounds_) {
+    return false;
+  }
+  const uint8_t* ptr = storage_.get();
+  const uint8_t* other_ptr = other.storage_.get();
+  const uint8_t* end = ptr + used_;
+  while (ptr < end) {
+    const Op* op = reinterpret_cast<const Op*>(ptr);
+    const Op* other_op = reinterpret_cast<const Op*>(other_ptr);
+    if (op->type != other_op->type || op->size != other_op->size) {
+      return false;
+    }
+    switch (op->type) {
+#define DISPLAY_LIST_COMPARE_OP(name)                     \
+  case OpType::k##name:                                   \
+    if (!static_cast<const name##Op*>(op)->Equals(        \
+            *static_cast<const name##Op*>(other_op))) {   \
+      return false;                                       \
+    }                                                     \
+    break;
+      FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_COMPARE_OP)
+#undef DISPLAY_LIST_COMPARE_OP
+    }
+    ptr += op->size;
+    other_ptr += op->size;
+  }
+  return true;
+}
+
+void DisplayList::RenderTo(SkCanvas* canvas) const {
+  SkAutoCanvasRestore save(canvas, true);
+  const SkM44 base_matrix = canvas->getLocalToDevice();
+  const uint8_t* ptr = storage_.get();
+  const uint8_t* end = ptr + used_;
+  while (ptr < end) {
+    const Op* op = reinterpret_cast<const Op*>(ptr);
+    switch (op->type) {
+#define DISPLAY_LIST_RENDER_OP(name)                                         \
+  case OpType::k##name:                                                      \
+    RenderOp(*static_cast<const name##Op*>(op), canvas, base_matrix);        \
+    break;
+      FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_RENDER_OP)
+#undef DISPLAY_LIST_RENDER_OP
+    }
+    ptr += op->size;
+  }
+}
+
+sk_sp<SkPicture> DisplayList::ToSkPicture() const {
+  SkPictureRecorder recorder;
+  RenderTo(recorder.beginRecording(bounds_));
+  return recorder.finishRecordingAsPicture();
+}
+
+DisplayListCanvasRecorder::DisplayListCanvasRecorder(const SkRect& bounds)
+    : SkCanvasVirtualEnforcer<SkNoDrawCanvas>(bounds.roundOut()),
+      bounds_(bounds) {}
+
+DisplayListCanvasRecorder::~DisplayListCanvasRecorder() {
+  DestroyOps(storage_.get(), used_);
+}
+
+sk_sp<DisplayList> DisplayListCanvasRecorder::Build() {
+  FlushSprites();
+  restoreToCount(1);
+  sk_sp<DisplayList> display_list(
+      new DisplayList(std::move(storage_), used_, op_count_, bounds_));
+  used_ = 0;
+  allocated_ = 0;
+  op_count_ = 0;
+  return display_list;
+}
+
+template <typename T, typename... Args>
+T* DisplayListCanvasRecorder::Push(size_t extra, Args&&... args) {
+  static_assert(alignof(T) <= kOpAlignment);
+  // Every operation, including the ones that change the matrix or the clip,
+  // ends the sprite batch, so its sprites share the state of the canvas.
+  if (!sprites_.src.empty()) {
+    FlushSprites();
+  }
+  const size_t size = AlignOpSize(sizeof(T) + extra);
+  if (used_ + size > allocated_) {
+    // The operations are moved along with their bytes, which none of them
+    // mind as they do not point into themselves.
+    allocated_ = std::max({allocated_ * 2, used_ + size, kMinAllocation});
+    std::unique_ptr<uint8_t[]> storage(new uint8_t[allocated_]);
+    if (used_ > 0) {
+      memcpy(storage.get(), storage_.get(), used_);
+    }
+    storage_ = std::move(storage);
+  }
+  T* op = new (storage_.get() + used_) T(std::forward<Args>(args)...);
+  op->type = T::kType;
+  op->size = static_cast<uint32_t>(size);
+  used_ += size;
+  op_count_++;
+  return op;
+}
+
+template <typename Draw>
+void DisplayListCanvasRecorder::PushPicture(const Draw& draw) {
+  SkPictureRecorder recorder;
+  draw(recorder.beginRecording(getLocalClipBounds()));
+  sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+  if (picture) {
+    onDrawPicture(picture.get(), nullptr, nullptr);
+  }
+}
+
+void DisplayListCanvasRecorder::AccumulateDraw(const SkRect* geometry,
+                                               const SkPaint* paint) {
+  // Whatever blend mode they use, fully transparent draws into a view that
+  // starts out transparent leave it empty.
+  if (paint && paint->getAlpha() == 0) {
+    return;
+  }
+  SkRect device_bounds = SkRect::Make(getDeviceClipBounds());
+  const SkMatrix matrix = getTotalMatrix();
+  if (geometry && !DrawsUnbounded() && !matrix.hasPerspective() &&
+      (!paint || paint->canComputeFastBounds())) {
+    SkRect storage;
+    const SkRect& local_bounds =
+        paint ? paint->computeFastBounds(*geometry, &storage) : *geometry;
+    if (!device_bounds.intersect(matrix.mapRect(local_bounds))) {
+      return;
+    }
+  }
+  if (device_bounds.isEmpty()) {
+    return;
+  }
+  did_draw_ = true;
+  draw_bounds_.join(device_bounds);
+}
+
+bool DisplayListCanvasRecorder::BatchSprite(const SkImage* image,
+                                            const SkRect& src,
+                                            const SkRect& dst,
+                                            const SkSamplingOptions& sampling,
+                                            const SkPaint* paint,
+                                            SrcRectConstraint constraint) {
+  // An atlas sprite can only scale uniformly, and does not keep the sampling
+  // inside of its texture rect, which only matters for a strict constraint
+  // when the rect is not the whole image.
+  if (src.isEmpty() || dst.isEmpty() ||
+      !SkScalarNearlyEqual(dst.width() / src.width(),
+                           dst.height() / src.height()) ||
+      (constraint == kStrict_SrcRectConstraint &&
+       src != SkRect::Make(image->bounds()))) {
+    return false;
+  }
+  // The effects of the paint apply to each image rect on its own, but to all
+  // of the sprites of an atlas at once. Blend modes that read the destination
+  // would also see the sprites of the same draw that overlap.
+  if (paint && (paint->getShader() || paint->getMaskFilter() ||
+                paint->getPathEffect() || paint->getImageFilter() ||
+                paint->getBlendMode() > SkBlendMode::kLastCoeffMode)) {
+    return false;
+  }
+  if (!sprites_.src.empty() &&
+      (sprites_.image.get() != image || sprites_.sampling != sampling ||
+       sprites_.has_paint != (paint != nullptr) ||
+       (paint && sprites_.paint != *paint))) {
+    FlushSprites();
+  }
+  if (sprites_.src.empty()) {
+    sprites_.image = sk_ref_sp(image);
+    sprites_.sampling = sampling;
+    sprites_.has_paint = paint != nullptr;
+    sprites_.paint = paint ? *paint : SkPaint();
+    sprites_.constraint = constraint;
+  }
+  sprites_.src.push_back(src);
+  sprites_.dst.push_back(dst);
+  return true;
+}
+
+void DisplayListCanvasRecorder::FlushSprites() {
+  if (sprites_.src.empty()) {
+    return;
+  }
+  // Pushing the operations below would flush the batch again.
+  SpriteBatch batch = std::move(sprites_);
+  sprites_ = SpriteBatch();
+  const SkPaint* paint = batch.has_paint ? &batch.paint : nullptr;
+  const int count = static_cast<int>(batch.src.size());
+  if (count == 1) {
+    SetBounds(Push<DrawImageRectOp>(0, batch.image.get(), batch.src[0],
+                                    batch.dst[0], batch.sampling, paint,
+                                    batch.constraint),
+              batch.dst[0], paint);
+    return;
+  }
+  SkRect cull = SkRect::MakeEmpty();
+  for (const SkRect& dst : batch.dst) {
+    cull.join(dst);
+  }
+  auto* op = Push<DrawAtlasOp>(DrawAtlasOp::ExtraSize(count, false),
+                               batch.image.get(), count, false,
+                               SkBlendMode::kModulate, batch.sampling, &cull,
+                               paint);
+  SkRSXform* xforms = reinterpret_cast<SkRSXform*>(op + 1);
+  for (int i = 0; i < count; i++) {
+    const SkRect& src = batch.src[i];
+    const SkRect& dst = batch.dst[i];
+    xforms[i] = SkRSXform::Make(dst.width() / src.width(), 0, dst.fLeft,
+                                dst.fTop);
+  }
+  memcpy(xforms + count, batch.src.data(), count * sizeof(SkRect));
+  SetBounds(op, cull, paint);
+}
+
+void DisplayListCanvasRecorder::willSave() {
+  Push<SaveOp>(0);
+  unbounded_saves_.push_back(DrawsUnbounded());
+}
+
+SkCanvas::SaveLayerStrategy DisplayListCanvasRecorder::getSaveLayerStrategy(
+    const SaveLayerRec& rec) {
+  Push<SaveLayerOp>(0, rec);
+  // A backdrop filter draws into the layer before anything else does.
+  if (rec.fBackdrop) {
+    AccumulateDraw(rec.fBounds, nullptr);
+  }
+  unbounded_saves_.push_back(DrawsUnbounded() ||
+                             (rec.fPaint && rec.fPaint->getImageFilter()));
+  return kNoLayer_SaveLayerStrategy;
+}
+
+bool DisplayListCanvasRecorder::onDoSaveBehind(const SkRect*) {
+  // The canvas treats this as a regular save, and so does the display list.
+  Push<SaveOp>(0);
+  unbounded_saves_.push_back(DrawsUnbounded());
+  return false;
+}
+
+void DisplayListCanvasRecorder::willRestore() {
+  Push<RestoreOp>(0);
+  if (!unbounded_saves_.empty()) {
+    unbounded_saves_.pop_back();
+  }
+}
+
+void DisplayListCanvasRecorder::didConcat44(const SkM44& matrix) {
+  Push<ConcatOp>(0, matrix);
+}
+
+void DisplayListCanvasRecorder::didSetM44(const SkM44& matrix) {
+  Push<SetMatrixOp>(0, matrix);
+}
+
+void DisplayListCanvasRecorder::didScale(SkScalar sx, SkScalar sy) {
+  Push<ScaleOp>(0, sx, sy);
+}
+
+void DisplayListCanvasRecorder::didTranslate(SkScalar dx, SkScalar dy) {
+  Push<TranslateOp>(0, dx, dy);
+}
+
+void DisplayListCanvasRecorder::onClipRect(const SkRect& rect,
+                                           SkClipOp op,
+                                           ClipEdgeStyle style) {
+  Push<ClipRectOp>(0, rect, op, style == kSoft_ClipEdgeStyle);
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipRect(rect, op, style);
+}
+
+void DisplayListCanvasRecorder::onClipRRect(const SkRRect& rrect,
+                                            SkClipOp op,
+                                            ClipEdgeStyle style) {
+  Push<ClipRRectOp>(0, rrect, op, style == kSoft_ClipEdgeStyle);
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipRRect(rrect, op, style);
+}
+
+void DisplayListCanvasRecorder::onClipPath(const SkPath& path,
+                                           SkClipOp op,
+                                           ClipEdgeStyle style) {
+  Push<ClipPathOp>(0, path, op, style == kSoft_ClipEdgeStyle);
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipPath(path, op, style);
+}
+
+void DisplayListCanvasRecorder::onClipRegion(const SkRegion& region,
+                                             SkClipOp op) {
+  Push<ClipRegionOp>(0, region, op);
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipRegion(region, op);
+}
+
+void DisplayListCanvasRecorder::onDrawPaint(const SkPaint& paint) {
+  Push<DrawPaintOp>(0, paint);
+  AccumulateDraw(nullptr, &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawBehind(const SkPaint&) {
+  // Only draws into the area of a save behind, which the display list
+  // records as a regular save.
+}
+
+void DisplayListCanvasRecorder::onDrawPoints(PointMode mode,
+                                             size_t count,
+                                             const SkPoint pts[],
+                                             const SkPaint& paint) {
+  auto* op = Push<DrawPointsOp>(count * sizeof(SkPoint), mode, count, paint);
+  memcpy(op + 1, pts, count * sizeof(SkPoint));
+  // Points are always stroked, whatever the style of the paint.
+  SkPaint stroke_paint(paint);
+  stroke_paint.setStyle(SkPaint::kStroke_Style);
+  SkRect bounds;
+  bounds.setBounds(pts, static_cast<int>(count));
+  SetBounds(op, bounds, &stroke_paint);
+  AccumulateDraw(&bounds, &stroke_paint);
+}
+
+void DisplayListCanvasRecorder::onDrawRect(const SkRect& rect,
+                                           const SkPaint& paint) {
+  SetBounds(Push<DrawRectOp>(0, rect, paint), rect, &paint);
+  AccumulateDraw(&rect, &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawRegion(const SkRegion& region,
+                                             const SkPaint& paint) {
+  const SkRect bounds = SkRect::Make(region.getBounds());
+  SetBounds(Push<DrawRegionOp>(0, region, paint), bounds, &paint);
+  AccumulateDraw(&bounds, &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawOval(const SkRect& oval,
+                                           const SkPaint& paint) {
+  SetBounds(Push<DrawOvalOp>(0, oval, paint), oval, &paint);
+  AccumulateDraw(&oval, &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawArc(const SkRect& oval,
+                                          SkScalar start_angle,
+                                          SkScalar sweep_angle,
+                                          bool use_center,
+                                          const SkPaint& paint) {
+  SetBounds(Push<DrawArcOp>(0, oval, start_angle, sweep_angle, use_center,
+                            paint),
+            oval, &paint);
+  AccumulateDraw(&oval, &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawRRect(const SkRRect& rrect,
+                                            const SkPaint& paint) {
+  SetBounds(Push<DrawRRectOp>(0, rrect, paint), rrect.getBounds(), &paint);
+  AccumulateDraw(&rrect.getBounds(), &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawDRRect(const SkRRect& outer,
+                                             const SkRRect& inner,
+                                             const SkPaint& paint) {
+  SetBounds(Push<DrawDRRectOp>(0, outer, inner, paint), outer.getBounds(),
+            &paint);
+  AccumulateDraw(&outer.getBounds(), &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawPath(const SkPath& path,
+                                           const SkPaint& paint) {
+  auto* op = Push<DrawPathOp>(0, path, paint);
+  // Inverse fills cover everything outside of the path.
+  if (!path.isInverseFillType()) {
+    SetBounds(op, path.getBounds(), &paint);
+    AccumulateDraw(&path.getBounds(), &paint);
+  } else {
+    AccumulateDraw(nullptr, &paint);
+  }
+}
+
+void DisplayListCanvasRecorder::onDrawTextBlob(const SkTextBlob* blob,
+                                               SkScalar x,
+                                               SkScalar y,
+                                               const SkPaint& paint) {
+  const SkRect bounds = blob->bounds().makeOffset(x, y);
+  SetBounds(Push<DrawTextBlobOp>(0, blob, x, y, paint), bounds, &paint);
+  AccumulateDraw(&bounds, &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawPatch(const SkPoint cubics[12],
+                                            const SkColor colors[4],
+                                            const SkPoint tex_coords[4],
+                                            SkBlendMode mode,
+                                            const SkPaint& paint) {
+  auto* op = Push<DrawPatchOp>(0, cubics, colors, tex_coords, mode, paint);
+  SkRect bounds;
+  bounds.setBounds(cubics, 12);
+  SetBounds(op, bounds, &paint);
+  AccumulateDraw(&bounds, &paint);
+}
+
+#ifdef SK_SUPPORT_LEGACY_ONDRAWIMAGERECT
+void DisplayListCanvasRecorder::onDrawImage(const SkImage* image,
+                                            SkScalar left,
+                                            SkScalar top,
+                                            const SkPaint* paint) {
+  onDrawImage2(image, left, top, SkSamplingOptions(), paint);
+}
+
+void DisplayListCanvasRecorder::onDrawImageRect(const SkImage* image,
+                                                const SkRect* src,
+                                                const SkRect& dst,
+                                                const SkPaint* paint,
+                                                SrcRectConstraint constraint) {
+  onDrawImageRect2(image, src ? *src : SkRect::Make(image->bounds()), dst,
+                   SkSamplingOptions(), paint, constraint);
+}
+
+void DisplayListCanvasRecorder::onDrawImageLattice(const SkImage* image,
+                                                   const Lattice& lattice,
+                                                   const SkRect& dst,
+                                                   const SkPaint* paint) {
+  onDrawImageLattice2(image, lattice, dst, SkFilterMode::kNearest, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawAtlas(const SkImage* atlas,
+                                            const SkRSXform xform[],
+                                            const SkRect tex[],
+                                            const SkColor colors[],
+                                            int count,
+                                            SkBlendMode mode,
+                                            const SkRect* cull,
+                                            const SkPaint* paint) {
+  onDrawAtlas2(atlas, xform, tex, colors, count, mode, SkSamplingOptions(),
+               cull, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawEdgeAAImageSet(
+    const ImageSetEntry set[],
+    int count,
+    const SkPoint dst_clips[],
+    const SkMatrix pre_view_matrices[],
+    const SkPaint* paint,
+    SrcRectConstraint constraint) {
+  onDrawEdgeAAImageSet2(set, count, dst_clips, pre_view_matrices,
+                        SkSamplingOptions(), paint, constraint);
+}
+#endif
+
+void DisplayListCanvasRecorder::onDrawImage2(const SkImage* image,
+                                             SkScalar left,
+                                             SkScalar top,
+                                             const SkSamplingOptions& sampling,
+                                             const SkPaint* paint) {
+  const SkRect dst =
+      SkRect::MakeXYWH(left, top, image->width(), image->height());
+  AccumulateDraw(&dst, paint);
+  if (BatchSprite(image, SkRect::Make(image->bounds()), dst, sampling, paint,
+                  kFast_SrcRectConstraint)) {
+    return;
+  }
+  SetBounds(Push<DrawImageOp>(0, image, left, top, sampling, paint), dst,
+            paint);
+}
+
+void DisplayListCanvasRecorder::onDrawImageRect2(
+    const SkImage* image,
+    const SkRect& src,
+    const SkRect& dst,
+    const SkSamplingOptions& sampling,
+    const SkPaint* paint,
+    SrcRectConstraint constraint) {
+  AccumulateDraw(&dst, paint);
+  if (BatchSprite(image, src, dst, sampling, paint, constraint)) {
+    return;
+  }
+  SetBounds(
+      Push<DrawImageRectOp>(0, image, src, dst, sampling, paint, constraint),
+      dst, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawImageLattice2(const SkImage* image,
+                                                    const Lattice& lattice,
+                                                    const SkRect& dst,
+                                                    SkFilterMode filter,
+                                                    const SkPaint* paint) {
+  const size_t extra_size = DrawImageLatticeOp::ExtraSize(
+      lattice.fXCount, lattice.fYCount, lattice.fColors != nullptr,
+      lattice.fRectTypes != nullptr);
+  auto* op = Push<DrawImageLatticeOp>(extra_size, image, lattice, dst, filter,
+                                      paint);
+  uint8_t* extra = reinterpret_cast<uint8_t*>(op + 1);
+  const size_t cells = (lattice.fXCount + 1) * (lattice.fYCount + 1);
+  memcpy(extra, lattice.fXDivs, lattice.fXCount * sizeof(int));
+  extra += lattice.fXCount * sizeof(int);
+  memcpy(extra, lattice.fYDivs, lattice.fYCount * sizeof(int));
+  extra += lattice.fYCount * sizeof(int);
+  if (lattice.fColors) {
+    memcpy(extra, lattice.fColors, cells * sizeof(SkColor));
+    extra += cells * sizeof(SkColor);
+  }
+  if (lattice.fRectTypes) {
+    memcpy(extra, lattice.fRectTypes,
+           cells * sizeof(SkCanvas::Lattice::RectType));
+  }
+  SetBounds(op, dst, paint);
+  AccumulateDraw(&dst, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawVerticesObject(const SkVertices* vertices,
+                                                     SkBlendMode mode,
+                                                     const SkPaint& paint) {
+  SetBounds(Push<DrawVerticesOp>(0, vertices, mode, paint), vertices->bounds(),
+            &paint);
+  AccumulateDraw(&vertices->bounds(), &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawAtlas2(const SkImage* atlas,
+                                             const SkRSXform xform[],
+                                             const SkRect tex[],
+                                             const SkColor colors[],
+                                             int count,
+                                             SkBlendMode mode,
+                                             const SkSamplingOptions& sampling,
+                                             const SkRect* cull,
+                                             const SkPaint* paint) {
+  const bool has_colors = colors != nullptr;
+  auto* op = Push<DrawAtlasOp>(DrawAtlasOp::ExtraSize(count, has_colors),
+                               atlas, count, has_colors, mode, sampling, cull,
+                               paint);
+  uint8_t* extra = reinterpret_cast<uint8_t*>(op + 1);
+  memcpy(extra, xform, count * sizeof(SkRSXform));
+  extra += count * sizeof(SkRSXform);
+  memcpy(extra, tex, count * sizeof(SkRect));
+  extra += count * sizeof(SkRect);
+  if (has_colors) {
+    memcpy(extra, colors, count * sizeof(SkColor));
+  }
+  // Without a cull rect, the bounds would have to be computed from every
+  // transform.
+  if (cull) {
+    SetBounds(op, *cull, paint);
+  }
+  AccumulateDraw(cull, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawShadowRec(const SkPath& path,
+                                                const SkDrawShadowRec& rec) {
+  Push<DrawShadowRecOp>(0, path, rec);
+  // Shadows reach beyond the path by an amount that depends on the lights.
+  AccumulateDraw(nullptr, nullptr);
+}
+
+void DisplayListCanvasRecorder::onDrawPicture(const SkPicture* picture,
+                                              const SkMatrix* matrix,
+                                              const SkPaint* paint) {
+  auto* op = Push<DrawPictureOp>(0, picture, matrix, paint);
+  SkRect bounds = picture->cullRect();
+  if (matrix) {
+    matrix->mapRect(&bounds);
+  }
+  SetBounds(op, bounds, paint);
+  AccumulateDraw(&bounds, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawDrawable(SkDrawable* drawable,
+                                               const SkMatrix* matrix) {
+  // Like an SkPictureRecorder without a drawable list, the drawable is
+  // recorded as it currently draws.
+  sk_sp<SkPicture> picture = drawable->newPictureSnapshot();
+  if (picture) {
+    onDrawPicture(picture.get(), matrix, nullptr);
+  }
+}
+
+void DisplayListCanvasRecorder::onDrawAnnotation(const SkRect& rect,
+                                                 const char key[],
+                                                 SkData* value) {
+  const size_t key_size = strlen(key) + 1;
+  auto* op = Push<DrawAnnotationOp>(key_size, rect, key_size, value);
+  memcpy(op + 1, key, key_size);
+}
+
+void DisplayListCanvasRecorder::onDrawEdgeAAQuad(const SkRect& rect,
+                                                 const SkPoint clip[4],
+                                                 SkCanvas::QuadAAFlags aa_flags,
+                                                 const SkColor4f& color,
+                                                 SkBlendMode mode) {
+  SetBounds(Push<DrawEdgeAAQuadOp>(0, rect, clip, aa_flags, color, mode), rect,
+            nullptr);
+  if (color.fA > 0) {
+    AccumulateDraw(&rect, nullptr);
+  }
+}
+
+void DisplayListCanvasRecorder::onDrawEdgeAAImageSet2(
+    const ImageSetEntry set[],
+    int count,
+    const SkPoint dst_clips[],
+    const SkMatrix pre_view_matrices[],
+    const SkSamplingOptions& sampling,
+    const SkPaint* paint,
+    SrcRectConstraint constraint) {
+  PushPicture([&](SkCanvas* canvas) {
+    canvas->experimental_DrawEdgeAAImageSet(set, count, dst_clips,
+                                            pre_view_matrices, sampling, paint,
+                                            constraint);
+  });
+}
+
+}  // namespace flutter
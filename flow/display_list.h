@@ -0,0 +1,405 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkCanvasVirtualEnforcer.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A recording of drawing operations, which the engine can play back, compare
+/// and inspect without going through an SkPicture.
+///
+/// The operations are stored one after the other in a single buffer, each
+/// prefixed by its type and size, so recording does not allocate per
+/// operation and playback walks through memory in order. Draw operations
+/// whose bounds are cheap to compute at recording time carry them, and
+/// playback skips the ones that fall outside of the clip of the canvas, e.g.
+/// when the display list is drawn into one tile of a frame.
+///
+/// Images, text blobs, vertices and nested pictures are held by reference,
+/// so like an SkPicture a display list may keep GPU resources alive and is
+/// released through the unref queue.
+///
+class DisplayList : public SkRefCnt {
+ public:
+  ~DisplayList() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bounds the display list was recorded with, which, like
+  ///             the cull rect of an SkPicture, are not tightened to the
+  ///             operations that were recorded.
+  ///
+  const SkRect& bounds() const { return bounds_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of operations, including the ones that only
+  ///             change the state of the canvas.
+  ///
+  int op_count() const { return op_count_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The memory held by the display list itself, not counting
+  ///             the objects it references.
+  ///
+  size_t bytes() const { return sizeof(DisplayList) + used_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Identifies the display list, e.g. in raster cache keys.
+  ///             The ids start above the range of
+  ///             |SkPicture::uniqueID|, so that they never collide with the
+  ///             ids of pictures.
+  ///
+  uint64_t unique_id() const { return unique_id_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the display list draws the same operations as
+  ///             |other|. Referenced objects, like images, paths effects and
+  ///             text blobs, are compared by instance.
+  ///
+  bool Equals(const DisplayList& other) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Plays the operations back into |canvas|, skipping the draw
+  ///             operations that |canvas| can quickly reject.
+  ///
+  void RenderTo(SkCanvas* canvas) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the display list into an SkPicture, for the APIs
+  ///             that take one, like |SkImageFilters::Picture|.
+  ///
+  sk_sp<SkPicture> ToSkPicture() const;
+
+ private:
+  DisplayList(std::unique_ptr<uint8_t[]> storage,
+              size_t used,
+              int op_count,
+              const SkRect& bounds);
+
+  const std::unique_ptr<uint8_t[]> storage_;
+  const size_t used_;
+  const int op_count_;
+  const SkRect bounds_;
+  const uint64_t unique_id_;
+
+  friend class DisplayListCanvasRecorder;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayList);
+};
+
+// The approximate size of the memory held by |display_list|, for the counters
+// of the unref queue.
+inline size_t GetApproximateByteSize(const DisplayList& display_list) {
+  return display_list.bytes();
+}
+
+//------------------------------------------------------------------------------
+/// A canvas that records the operations drawn into it into a |DisplayList|.
+///
+/// Operations that a display list has no representation for, like edge
+/// antialiased image sets and drawables, are recorded into a nested SkPicture,
+/// so nothing drawn into the canvas is lost.
+///
+class DisplayListCanvasRecorder final
+    : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
+ public:
+  explicit DisplayListCanvasRecorder(const SkRect& bounds);
+
+  ~DisplayListCanvasRecorder() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Restores the saves that are still outstanding and returns
+  ///             the operations recorded so far. The canvas must not be
+  ///             drawn into afterwards.
+  ///
+  sk_sp<DisplayList> Build();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether anything that is not fully transparent was drawn
+  ///             inside of the clip so far. Clears to transparent, like the
+  ///             ones that start every frame, do not count.
+  ///
+  bool did_draw() const { return did_draw_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bounds in device space of what was drawn so far, or
+  ///             empty if nothing was. Draws whose bounds are not cheap to
+  ///             compute count as covering the whole clip, so the bounds
+  ///             may be larger than the pixels actually drawn, but never
+  ///             smaller.
+  ///
+  const SkRect& draw_bounds() const { return draw_bounds_; }
+
+ private:
+  SkRect bounds_;
+  std::unique_ptr<uint8_t[]> storage_;
+  size_t used_ = 0;
+  size_t allocated_ = 0;
+  int op_count_ = 0;
+  bool did_draw_ = false;
+  SkRect draw_bounds_ = SkRect::MakeEmpty();
+
+  // For each outstanding save, whether the draws inside of it may reach
+  // beyond their own bounds, because a layer they are drawn into filters
+  // them.
+  std::vector<bool> unbounded_saves_;
+
+  bool DrawsUnbounded() const {
+    return !unbounded_saves_.empty() && unbounded_saves_.back();
+  }
+
+  // Adds a draw of |geometry| with |paint| to the draw bounds. A null
+  // |geometry| stands for a draw that covers the whole clip.
+  void AccumulateDraw(const SkRect* geometry, const SkPaint* paint);
+
+  // Appends an operation of type |T| followed by |extra| bytes of arrays,
+  // which the caller fills in.
+  template <typename T, typename... Args>
+  T* Push(size_t extra, Args&&... args);
+
+  // Records the operations |draw| draws into a nested picture.
+  template <typename Draw>
+  void PushPicture(const Draw& draw);
+
+  // Consecutive draws of parts of the same image, which are recorded as a
+  // single atlas draw once a draw that cannot join them comes along. Icons,
+  // emoji or the sprites of a game that share an image then cost one draw
+  // instead of one per image rect.
+  struct SpriteBatch {
+    sk_sp<const SkImage> image;
+    SkSamplingOptions sampling;
+    bool has_paint = false;
+    SkPaint paint;
+    SrcRectConstraint constraint = kFast_SrcRectConstraint;
+    std::vector<SkRect> src;
+    std::vector<SkRect> dst;
+  };
+  SpriteBatch sprites_;
+
+  // Adds the draw of |src| of |image| into |dst| to the sprite batch, which
+  // is flushed first if the draw cannot join it. Returns false if the draw
+  // cannot be recorded as a sprite at all.
+  bool BatchSprite(const SkImage* image,
+                   const SkRect& src,
+                   const SkRect& dst,
+                   const SkSamplingOptions& sampling,
+                   const SkPaint* paint,
+                   SrcRectConstraint constraint);
+
+  // Records the sprite batch, as an atlas draw if it holds more than one
+  // sprite.
+  void FlushSprites();
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void willSave() override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  bool onDoSaveBehind(const SkRect*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void willRestore() override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void didConcat44(const SkM44&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void didSetM44(const SkM44&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void didScale(SkScalar, SkScalar) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void didTranslate(SkScalar, SkScalar) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipRect(const SkRect&, SkClipOp, ClipEdgeStyle) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipRRect(const SkRRect&, SkClipOp, ClipEdgeStyle) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipPath(const SkPath&, SkClipOp, ClipEdgeStyle) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipRegion(const SkRegion&, SkClipOp) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPaint(const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawBehind(const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPoints(PointMode,
+                    size_t count,
+                    const SkPoint pts[],
+                    const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawRect(const SkRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawRegion(const SkRegion&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawOval(const SkRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawArc(const SkRect&,
+                 SkScalar,
+                 SkScalar,
+                 bool,
+                 const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawRRect(const SkRRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPath(const SkPath&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawTextBlob(const SkTextBlob* blob,
+                      SkScalar x,
+                      SkScalar y,
+                      const SkPaint& paint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPatch(const SkPoint cubics[12],
+                   const SkColor colors[4],
+                   const SkPoint texCoords[4],
+                   SkBlendMode,
+                   const SkPaint& paint) override;
+
+#ifdef SK_SUPPORT_LEGACY_ONDRAWIMAGERECT
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImage(const SkImage*,
+                   SkScalar left,
+                   SkScalar top,
+                   const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImageRect(const SkImage*,
+                       const SkRect* src,
+                       const SkRect& dst,
+                       const SkPaint*,
+                       SrcRectConstraint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImageLattice(const SkImage*,
+                          const Lattice&,
+                          const SkRect&,
+                          const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawAtlas(const SkImage*,
+                   const SkRSXform[],
+                   const SkRect[],
+                   const SkColor[],
+                   int,
+                   SkBlendMode,
+                   const SkRect*,
+                   const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawEdgeAAImageSet(const ImageSetEntry[],
+                            int count,
+                            const SkPoint[],
+                            const SkMatrix[],
+                            const SkPaint*,
+                            SrcRectConstraint) override;
+#endif
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImage2(const SkImage*,
+                    SkScalar left,
+                    SkScalar top,
+                    const SkSamplingOptions&,
+                    const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImageRect2(const SkImage*,
+                        const SkRect& src,
+                        const SkRect& dst,
+                        const SkSamplingOptions&,
+                        const SkPaint*,
+                        SrcRectConstraint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImageLattice2(const SkImage*,
+                           const Lattice&,
+                           const SkRect&,
+                           SkFilterMode,
+                           const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawVerticesObject(const SkVertices*,
+                            SkBlendMode,
+                            const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawAtlas2(const SkImage*,
+                    const SkRSXform[],
+                    const SkRect[],
+                    const SkColor[],
+                    int,
+                    SkBlendMode,
+                    const SkSamplingOptions&,
+                    const SkRect*,
+                    const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawShadowRec(const SkPath&, const SkDrawShadowRec&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPicture(const SkPicture*,
+                     const SkMatrix*,
+                     const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawDrawable(SkDrawable*, const SkMatrix*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawAnnotation(const SkRect&, const char[], SkData*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawEdgeAAQuad(const SkRect&,
+                        const SkPoint[4],
+                        SkCanvas::QuadAAFlags,
+                        const SkColor4f&,
+                        SkBlendMode) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawEdgeAAImageSet2(const ImageSetEntry[],
+                             int count,
+                             const SkPoint[],
+                             const SkMatrix[],
+                             const SkSamplingOptions&,
+                             const SkPaint*,
+                             SrcRectConstraint) override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListCanvasRecorder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_H_
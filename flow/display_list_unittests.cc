@@ -0,0 +1,359 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr SkRect kBounds = SkRect::MakeWH(100, 100);
+
+// Draws a few operations that exercise the matrix, the clip and layers.
+void DrawScene(SkCanvas* canvas, SkColor color) {
+  SkPaint paint;
+  paint.setColor(color);
+  canvas->save();
+  canvas->translate(10, 10);
+  canvas->clipRect(SkRect::MakeWH(50, 50));
+  canvas->drawRect(SkRect::MakeWH(80, 80), paint);
+  canvas->restore();
+  SkPaint layer_paint;
+  layer_paint.setAlpha(0x80);
+  canvas->saveLayer(nullptr, &layer_paint);
+  canvas->drawCircle(60, 60, 20, paint);
+  canvas->restore();
+}
+
+sk_sp<DisplayList> RecordScene(SkColor color) {
+  DisplayListCanvasRecorder recorder(kBounds);
+  DrawScene(&recorder, color);
+  return recorder.Build();
+}
+
+sk_sp<DisplayList> RecordImage(const sk_sp<SkImage>& image) {
+  DisplayListCanvasRecorder recorder(kBounds);
+  recorder.drawImage(image, 0, 0);
+  return recorder.Build();
+}
+
+sk_sp<SkImage> MakeImage() {
+  auto surface = SkSurface::MakeRasterN32Premul(10, 10);
+  surface->getCanvas()->clear(SK_ColorRED);
+  return surface->makeImageSnapshot();
+}
+
+// Counts the rects that reach the canvas.
+class RectCountingCanvas : public SkNoDrawCanvas {
+ public:
+  RectCountingCanvas() : SkNoDrawCanvas(100, 100) {}
+
+  int rect_count() const { return rect_count_; }
+
+ protected:
+  void onDrawRect(const SkRect& rect, const SkPaint& paint) override {
+    rect_count_++;
+  }
+
+ private:
+  int rect_count_ = 0;
+};
+
+// Counts the image draws that reach the canvas.
+class ImageCountingCanvas : public SkNoDrawCanvas {
+ public:
+  ImageCountingCanvas() : SkNoDrawCanvas(100, 100) {}
+
+  int image_rect_count() const { return image_rect_count_; }
+  int atlas_count() const { return atlas_count_; }
+
+ protected:
+  void onDrawImageRect2(const SkImage*,
+                        const SkRect&,
+                        const SkRect&,
+                        const SkSamplingOptions&,
+                        const SkPaint*,
+                        SrcRectConstraint) override {
+    image_rect_count_++;
+  }
+
+  void onDrawAtlas2(const SkImage*,
+                    const SkRSXform[],
+                    const SkRect[],
+                    const SkColor[],
+                    int,
+                    SkBlendMode,
+                    const SkSamplingOptions&,
+                    const SkRect*,
+                    const SkPaint*) override {
+    atlas_count_++;
+  }
+
+ private:
+  int image_rect_count_ = 0;
+  int atlas_count_ = 0;
+};
+
+// Draws four quarters of |image| next to each other.
+void DrawSprites(SkCanvas* canvas, const sk_sp<SkImage>& image) {
+  for (int i = 0; i < 4; i++) {
+    const SkRect src = SkRect::MakeXYWH((i % 2) * 5, (i / 2) * 5, 5, 5);
+    canvas->drawImageRect(image, src, SkRect::MakeXYWH(i * 20, 10, 10, 10),
+                          SkSamplingOptions(), nullptr,
+                          SkCanvas::kFast_SrcRectConstraint);
+  }
+}
+
+}  // namespace
+
+TEST(DisplayListTest, RecordsOperationsAndBounds) {
+  auto display_list = RecordScene(SK_ColorBLUE);
+  // save, translate, clipRect, drawRect, restore, saveLayer, drawCircle (as an
+  // oval) and restore.
+  EXPECT_EQ(display_list->op_count(), 8);
+  EXPECT_EQ(display_list->bounds(), kBounds);
+  EXPECT_GT(display_list->bytes(), sizeof(DisplayList));
+  EXPECT_EQ(GetApproximateByteSize(*display_list), display_list->bytes());
+}
+
+TEST(DisplayListTest, BuildRestoresOutstandingSaves) {
+  DisplayListCanvasRecorder recorder(kBounds);
+  recorder.save();
+  recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+  auto display_list = recorder.Build();
+  EXPECT_EQ(display_list->op_count(), 3);
+
+  SkNoDrawCanvas canvas(100, 100);
+  display_list->RenderTo(&canvas);
+  EXPECT_EQ(canvas.getSaveCount(), 1);
+}
+
+TEST(DisplayListTest, UniqueIdsAreDistinct) {
+  auto first = RecordScene(SK_ColorBLUE);
+  auto second = RecordScene(SK_ColorBLUE);
+  EXPECT_NE(first->unique_id(), second->unique_id());
+  // Display list ids are kept apart from the ones of SkPictures, which share
+  // the keys of the raster cache with them.
+  EXPECT_GE(first->unique_id(), uint64_t{1} << 32);
+}
+
+TEST(DisplayListTest, EqualsComparesOperations) {
+  auto display_list = RecordScene(SK_ColorBLUE);
+  EXPECT_TRUE(display_list->Equals(*RecordScene(SK_ColorBLUE)));
+  EXPECT_FALSE(display_list->Equals(*RecordScene(SK_ColorGREEN)));
+
+  DisplayListCanvasRecorder recorder(kBounds);
+  DrawScene(&recorder, SK_ColorBLUE);
+  recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+  EXPECT_FALSE(display_list->Equals(*recorder.Build()));
+}
+
+TEST(DisplayListTest, EqualsComparesImagesByInstance) {
+  auto image = MakeImage();
+  EXPECT_TRUE(RecordImage(image)->Equals(*RecordImage(image)));
+  EXPECT_FALSE(RecordImage(image)->Equals(*RecordImage(MakeImage())));
+}
+
+TEST(DisplayListTest, RenderToSkipsOperationsOutsideTheClip) {
+  DisplayListCanvasRecorder recorder(kBounds);
+  recorder.drawRect(SkRect::MakeXYWH(0, 0, 10, 10), SkPaint());
+  recorder.drawRect(SkRect::MakeXYWH(80, 80, 10, 10), SkPaint());
+  auto display_list = recorder.Build();
+
+  RectCountingCanvas canvas;
+  canvas.clipRect(SkRect::MakeWH(20, 20));
+  display_list->RenderTo(&canvas);
+  EXPECT_EQ(canvas.rect_count(), 1);
+}
+
+TEST(DisplayListTest, RenderToMatchesSkPicture) {
+  const SkImageInfo info = SkImageInfo::MakeN32Premul(100, 100);
+  auto expected = SkSurface::MakeRaster(info);
+  auto actual = SkSurface::MakeRaster(info);
+
+  // The matrix of the canvas applies to the display list, including its
+  // setMatrix operations.
+  expected->getCanvas()->translate(5, 5);
+  actual->getCanvas()->translate(5, 5);
+
+  SkPictureRecorder picture_recorder;
+  DrawScene(picture_recorder.beginRecording(kBounds), SK_ColorBLUE);
+  picture_recorder.finishRecordingAsPicture()->playback(
+      expected->getCanvas());
+  RecordScene(SK_ColorBLUE)->RenderTo(actual->getCanvas());
+
+  SkBitmap expected_bitmap, actual_bitmap;
+  expected_bitmap.allocPixels(info);
+  actual_bitmap.allocPixels(info);
+  ASSERT_TRUE(expected->readPixels(expected_bitmap, 0, 0));
+  ASSERT_TRUE(actual->readPixels(actual_bitmap, 0, 0));
+  EXPECT_EQ(memcmp(expected_bitmap.getPixels(), actual_bitmap.getPixels(),
+                   expected_bitmap.computeByteSize()),
+            0);
+}
+
+TEST(DisplayListTest, ToSkPictureKeepsOperations) {
+  auto display_list = RecordScene(SK_ColorBLUE);
+  auto picture = display_list->ToSkPicture();
+  ASSERT_NE(picture, nullptr);
+  EXPECT_EQ(picture->cullRect(), display_list->bounds());
+  EXPECT_GT(picture->approximateOpCount(), 0);
+}
+
+TEST(DisplayListTest, BatchesRectsOfTheSameImageIntoAnAtlas) {
+  auto image = MakeImage();
+  DisplayListCanvasRecorder recorder(kBounds);
+  DrawSprites(&recorder, image);
+  auto display_list = recorder.Build();
+  EXPECT_EQ(display_list->op_count(), 1);
+
+  ImageCountingCanvas canvas;
+  display_list->RenderTo(&canvas);
+  EXPECT_EQ(canvas.atlas_count(), 1);
+  EXPECT_EQ(canvas.image_rect_count(), 0);
+}
+
+TEST(DisplayListTest, SpriteBatchRendersLikeTheImageRects) {
+  const SkImageInfo info = SkImageInfo::MakeN32Premul(100, 100);
+  auto expected = SkSurface::MakeRaster(info);
+  auto actual = SkSurface::MakeRaster(info);
+  auto image_surface = SkSurface::MakeRasterN32Premul(10, 10);
+  image_surface->getCanvas()->clear(SK_ColorRED);
+  image_surface->getCanvas()->drawRect(SkRect::MakeWH(5, 5), SkPaint());
+  auto image = image_surface->makeImageSnapshot();
+
+  DrawSprites(expected->getCanvas(), image);
+  DisplayListCanvasRecorder recorder(kBounds);
+  DrawSprites(&recorder, image);
+  recorder.Build()->RenderTo(actual->getCanvas());
+
+  SkBitmap expected_bitmap, actual_bitmap;
+  expected_bitmap.allocPixels(info);
+  actual_bitmap.allocPixels(info);
+  ASSERT_TRUE(expected->readPixels(expected_bitmap, 0, 0));
+  ASSERT_TRUE(actual->readPixels(actual_bitmap, 0, 0));
+  EXPECT_EQ(memcmp(expected_bitmap.getPixels(), actual_bitmap.getPixels(),
+                   expected_bitmap.computeByteSize()),
+            0);
+}
+
+TEST(DisplayListTest, DoesNotBatchIncompatibleImageDraws) {
+  auto image = MakeImage();
+  const SkRect src = SkRect::MakeWH(5, 5);
+
+  // Different images.
+  DisplayListCanvasRecorder images_recorder(kBounds);
+  images_recorder.drawImage(image, 0, 0);
+  images_recorder.drawImage(MakeImage(), 20, 0);
+  EXPECT_EQ(images_recorder.Build()->op_count(), 2);
+
+  // A scale that an atlas sprite cannot express.
+  DisplayListCanvasRecorder scale_recorder(kBounds);
+  scale_recorder.drawImageRect(image, src, SkRect::MakeWH(10, 5),
+                               SkSamplingOptions(), nullptr,
+                               SkCanvas::kFast_SrcRectConstraint);
+  scale_recorder.drawImageRect(image, src, SkRect::MakeXYWH(20, 0, 10, 5),
+                               SkSamplingOptions(), nullptr,
+                               SkCanvas::kFast_SrcRectConstraint);
+  EXPECT_EQ(scale_recorder.Build()->op_count(), 2);
+
+  // A strict constraint on part of the image.
+  DisplayListCanvasRecorder strict_recorder(kBounds);
+  strict_recorder.drawImageRect(image, src, src, SkSamplingOptions(), nullptr,
+                                SkCanvas::kStrict_SrcRectConstraint);
+  strict_recorder.drawImageRect(image, src, src.makeOffset(20, 0),
+                                SkSamplingOptions(), nullptr,
+                                SkCanvas::kStrict_SrcRectConstraint);
+  EXPECT_EQ(strict_recorder.Build()->op_count(), 2);
+
+  // A change of the matrix in between.
+  DisplayListCanvasRecorder matrix_recorder(kBounds);
+  matrix_recorder.drawImage(image, 0, 0);
+  matrix_recorder.translate(20, 0);
+  matrix_recorder.drawImage(image, 0, 0);
+  EXPECT_EQ(matrix_recorder.Build()->op_count(), 3);
+}
+
+TEST(DisplayListTest, TransparentDrawsDoNotCountAsDrawing) {
+  DisplayListCanvasRecorder recorder(kBounds);
+  EXPECT_FALSE(recorder.did_draw());
+  recorder.translate(50, 50);
+  recorder.clear(SK_ColorTRANSPARENT);
+  SkPaint paint;
+  paint.setAlpha(0);
+  recorder.drawRect(SkRect::MakeWH(10, 10), paint);
+  EXPECT_FALSE(recorder.did_draw());
+  EXPECT_TRUE(recorder.draw_bounds().isEmpty());
+
+  recorder.drawCircle(0, 0, 10, SkPaint());
+  EXPECT_TRUE(recorder.did_draw());
+  EXPECT_EQ(recorder.draw_bounds(), SkRect::MakeLTRB(40, 40, 60, 60));
+}
+
+TEST(DisplayListTest, DrawsOutsideOfTheClipDoNotCountAsDrawing) {
+  DisplayListCanvasRecorder recorder(kBounds);
+  recorder.clipRect(SkRect::MakeWH(50, 50));
+  recorder.drawRect(SkRect::MakeXYWH(60, 60, 10, 10), SkPaint());
+  recorder.drawImage(MakeImage(), 70, 0);
+  EXPECT_FALSE(recorder.did_draw());
+
+  recorder.drawRect(SkRect::MakeXYWH(40, 40, 20, 20), SkPaint());
+  EXPECT_TRUE(recorder.did_draw());
+  EXPECT_EQ(recorder.draw_bounds(), SkRect::MakeLTRB(40, 40, 50, 50));
+}
+
+TEST(DisplayListTest, DrawBoundsAreInDeviceSpace) {
+  DisplayListCanvasRecorder recorder(kBounds);
+  recorder.save();
+  recorder.translate(10, 20);
+  recorder.scale(2, 2);
+  recorder.drawImage(MakeImage(), 0, 0);
+  recorder.restore();
+  SkPaint stroke;
+  stroke.setStyle(SkPaint::kStroke_Style);
+  stroke.setStrokeWidth(2);
+  stroke.setStrokeJoin(SkPaint::kRound_Join);
+  recorder.drawRect(SkRect::MakeXYWH(70, 70, 10, 10), stroke);
+  EXPECT_EQ(recorder.draw_bounds(), SkRect::MakeLTRB(10, 20, 81, 81));
+}
+
+TEST(DisplayListTest, DrawsWithoutCheapBoundsCoverTheClip) {
+  DisplayListCanvasRecorder paint_recorder(kBounds);
+  paint_recorder.clipRect(SkRect::MakeXYWH(10, 10, 30, 30));
+  paint_recorder.drawPaint(SkPaint());
+  EXPECT_EQ(paint_recorder.draw_bounds(), SkRect::MakeXYWH(10, 10, 30, 30));
+
+  // A blur reaches beyond the bounds of what is drawn into its layer.
+  DisplayListCanvasRecorder layer_recorder(kBounds);
+  SkPaint layer_paint;
+  layer_paint.setImageFilter(SkImageFilters::Blur(5, 5, nullptr));
+  layer_recorder.saveLayer(nullptr, &layer_paint);
+  layer_recorder.drawRect(SkRect::MakeXYWH(40, 40, 10, 10), SkPaint());
+  layer_recorder.restore();
+  layer_recorder.drawRect(SkRect::MakeXYWH(40, 40, 10, 10), SkPaint());
+  EXPECT_EQ(layer_recorder.draw_bounds(), kBounds);
+}
+
+TEST(DisplayListTest, BatchedSpritesCountAsDrawing) {
+  DisplayListCanvasRecorder recorder(kBounds);
+  auto image = MakeImage();
+  recorder.drawImage(image, 0, 0);
+  recorder.drawImage(image, 20, 0);
+  EXPECT_TRUE(recorder.did_draw());
+  EXPECT_EQ(recorder.draw_bounds(), SkRect::MakeWH(30, 10));
+}
+
+}  // namespace testing
+}  // namespace flutter
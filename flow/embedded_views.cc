@@ -4,6 +4,10 @@
 
 #include "flutter/flow/embedded_views.h"
 
+#include <new>
+
+#include "flutter/fml/logging.h"
+
 namespace flutter {
 
 void ExternalViewEmbedder::SubmitFrame(
@@ -13,57 +17,96 @@ void ExternalViewEmbedder::SubmitFrame(
   frame->Submit();
 };
 
+template <typename T>
+void MutatorsStack::Push(const T& value) {
+  if (!heap_ && inline_size_ < kInlineCapacity) {
+    new (inline_mutators() + inline_size_) Mutator(value);
+    inline_size_++;
+    return;
+  }
+  if (!heap_) {
+    auto heap = std::make_shared<std::vector<Mutator>>();
+    heap->reserve(2 * kInlineCapacity);
+    heap->insert(heap->end(), Begin(), End());
+    Clear();
+    heap_ = std::move(heap);
+  } else if (heap_.use_count() > 1) {
+    heap_ = std::make_shared<std::vector<Mutator>>(*heap_);
+  }
+  heap_->emplace_back(value);
+}
+
 void MutatorsStack::PushClipRect(const SkRect& rect) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(rect);
-  vector_.push_back(element);
+  Push(rect);
 };
 
 void MutatorsStack::PushClipRRect(const SkRRect& rrect) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(rrect);
-  vector_.push_back(element);
+  Push(rrect);
 };
 
 void MutatorsStack::PushClipPath(const SkPath& path) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(path);
-  vector_.push_back(element);
+  Push(path);
 };
 
 void MutatorsStack::PushTransform(const SkMatrix& matrix) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(matrix);
-  vector_.push_back(element);
+  Push(matrix);
 };
 
 void MutatorsStack::PushOpacity(const int& alpha) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(alpha);
-  vector_.push_back(element);
+  Push(alpha);
 };
 
 void MutatorsStack::Pop() {
-  vector_.pop_back();
-};
-
-const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator
-MutatorsStack::Top() const {
-  return vector_.rend();
-};
-
-const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator
-MutatorsStack::Bottom() const {
-  return vector_.rbegin();
+  FML_DCHECK(!is_empty());
+  if (!heap_) {
+    inline_size_--;
+    inline_mutators()[inline_size_].~Mutator();
+    return;
+  }
+  if (heap_.use_count() == 1) {
+    heap_->pop_back();
+    return;
+  }
+  // A copy of the stack still refers to the mutators, so the remaining ones
+  // are copied instead, back into the inline storage if they fit.
+  std::shared_ptr<std::vector<Mutator>> heap = std::move(heap_);
+  auto end = heap->end() - 1;
+  if (heap->size() - 1 > kInlineCapacity) {
+    heap_ = std::make_shared<std::vector<Mutator>>(heap->begin(), end);
+    return;
+  }
+  for (auto iter = heap->begin(); iter != end; ++iter) {
+    new (inline_mutators() + inline_size_) Mutator(*iter);
+    inline_size_++;
+  }
 };
 
-const std::vector<std::shared_ptr<Mutator>>::const_iterator
-MutatorsStack::Begin() const {
-  return vector_.begin();
-};
+void MutatorsStack::CopyFrom(const MutatorsStack& other) {
+  FML_DCHECK(is_empty());
+  if (other.size() > kInlineCapacity) {
+    heap_ = other.heap_;
+    return;
+  }
+  for (auto iter = other.Begin(); iter != other.End(); ++iter) {
+    new (inline_mutators() + inline_size_) Mutator(*iter);
+    inline_size_++;
+  }
+}
 
-const std::vector<std::shared_ptr<Mutator>>::const_iterator MutatorsStack::End()
-    const {
-  return vector_.end();
-};
+void MutatorsStack::Clear() {
+  for (size_t i = 0; i < inline_size_; i++) {
+    inline_mutators()[i].~Mutator();
+  }
+  inline_size_ = 0;
+  heap_.reset();
+}
 
 bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return false;
 }
 
+bool ExternalViewEmbedder::SubmitsFramesWithoutThreadMerging() {
+  return false;
+}
+
 }  // namespace flutter
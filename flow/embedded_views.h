@@ -5,6 +5,10 @@
 #ifndef FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 #define FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <vector>
 
 #include "flutter/flow/surface_frame.h"
@@ -32,8 +36,7 @@ enum MutatorType { clip_rect, clip_rrect, clip_path, transform, opacity };
 // clipped. One mutation object must only contain one type of mutation.
 class Mutator {
  public:
-  Mutator(const Mutator& other) {
-    type_ = other.type_;
+  Mutator(const Mutator& other) : type_(other.type_) {
     switch (other.type_) {
       case clip_rect:
         rect_ = other.rect_;
@@ -42,7 +45,7 @@ class Mutator {
         rrect_ = other.rrect_;
         break;
       case clip_path:
-        path_ = new SkPath(*other.path_);
+        new (&path_) SkPath(other.path_);
         break;
       case transform:
         matrix_ = other.matrix_;
@@ -57,16 +60,23 @@ class Mutator {
 
   explicit Mutator(const SkRect& rect) : type_(clip_rect), rect_(rect) {}
   explicit Mutator(const SkRRect& rrect) : type_(clip_rrect), rrect_(rrect) {}
-  explicit Mutator(const SkPath& path)
-      : type_(clip_path), path_(new SkPath(path)) {}
+  explicit Mutator(const SkPath& path) : type_(clip_path), path_(path) {}
   explicit Mutator(const SkMatrix& matrix)
       : type_(transform), matrix_(matrix) {}
   explicit Mutator(const int& alpha) : type_(opacity), alpha_(alpha) {}
 
+  Mutator& operator=(const Mutator& other) {
+    if (this != &other) {
+      this->~Mutator();
+      new (this) Mutator(other);
+    }
+    return *this;
+  }
+
   const MutatorType& GetType() const { return type_; }
   const SkRect& GetRect() const { return rect_; }
   const SkRRect& GetRRect() const { return rrect_; }
-  const SkPath& GetPath() const { return *path_; }
+  const SkPath& GetPath() const { return path_; }
   const SkMatrix& GetMatrix() const { return matrix_; }
   const int& GetAlpha() const { return alpha_; }
   float GetAlphaFloat() const { return (alpha_ / 255.0); }
@@ -81,7 +91,7 @@ class Mutator {
       case clip_rrect:
         return rrect_ == other.rrect_;
       case clip_path:
-        return *path_ == *other.path_;
+        return path_ == other.path_;
       case transform:
         return matrix_ == other.matrix_;
       case opacity:
@@ -93,24 +103,26 @@ class Mutator {
 
   bool operator!=(const Mutator& other) const { return !operator==(other); }
 
-  bool IsClipType() {
+  bool IsClipType() const {
     return type_ == clip_rect || type_ == clip_rrect || type_ == clip_path;
   }
 
   ~Mutator() {
     if (type_ == clip_path) {
-      delete path_;
+      path_.~SkPath();
     }
   };
 
  private:
   MutatorType type_;
 
+  // The path is held by value, it shares its points with the path it was
+  // copied from.
   union {
     SkRect rect_;
     SkRRect rrect_;
     SkMatrix matrix_;
-    SkPath* path_;
+    SkPath path_;
     int alpha_;
   };
 
@@ -125,10 +137,32 @@ class Mutator {
 // For example consider the following stack: [T1, T2, T3], where T1 is the top
 // of the stack and T3 is the bottom of the stack. Applying this mutators stack
 // to a platform view P1 will result in T1(T2(T3(P1))).
+//
+// Up to |kInlineCapacity| mutators are stored in the stack itself, so that
+// pushing, popping and copying the stack, which is done for every platform
+// view in a frame, does not allocate. Deeper stacks are stored on the heap
+// and shared by their copies until one of them is changed.
 class MutatorsStack {
  public:
+  static constexpr size_t kInlineCapacity = 8;
+
+  using const_iterator = const Mutator*;
+  using const_reverse_iterator = std::reverse_iterator<const Mutator*>;
+
   MutatorsStack() = default;
 
+  MutatorsStack(const MutatorsStack& other) { CopyFrom(other); }
+
+  MutatorsStack& operator=(const MutatorsStack& other) {
+    if (this != &other) {
+      Clear();
+      CopyFrom(other);
+    }
+    return *this;
+  }
+
+  ~MutatorsStack() { Clear(); }
+
   void PushClipRect(const SkRect& rect);
   void PushClipRRect(const SkRRect& rrect);
   void PushClipPath(const SkPath& path);
@@ -141,45 +175,33 @@ class MutatorsStack {
 
   // Returns a reverse iterator pointing to the top of the stack, which is the
   // mutator that is furtherest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator Top()
-      const;
+  const_reverse_iterator Top() const { return const_reverse_iterator(Begin()); }
   // Returns a reverse iterator pointing to the bottom of the stack, which is
   // the mutator that is closeset from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator Bottom()
-      const;
+  const_reverse_iterator Bottom() const {
+    return const_reverse_iterator(End());
+  }
 
   // Returns an iterator pointing to the beginning of the mutator vector, which
   // is the mutator that is furtherest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_iterator Begin() const;
+  const_iterator Begin() const {
+    return heap_ ? heap_->data() : inline_mutators();
+  }
 
   // Returns an iterator pointing to the end of the mutator vector, which is the
   // mutator that is closest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_iterator End() const;
+  const_iterator End() const { return Begin() + size(); }
 
-  bool is_empty() const { return vector_.empty(); }
+  size_t size() const { return heap_ ? heap_->size() : inline_size_; }
+
+  bool is_empty() const { return size() == 0; }
 
   bool operator==(const MutatorsStack& other) const {
-    if (vector_.size() != other.vector_.size()) {
-      return false;
-    }
-    for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != *other.vector_[i]) {
-        return false;
-      }
-    }
-    return true;
+    return std::equal(Begin(), End(), other.Begin(), other.End());
   }
 
   bool operator==(const std::vector<Mutator>& other) const {
-    if (vector_.size() != other.size()) {
-      return false;
-    }
-    for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != other[i]) {
-        return false;
-      }
-    }
-    return true;
+    return std::equal(Begin(), End(), other.begin(), other.end());
   }
 
   bool operator!=(const MutatorsStack& other) const {
@@ -191,7 +213,27 @@ class MutatorsStack {
   }
 
  private:
-  std::vector<std::shared_ptr<Mutator>> vector_;
+  template <typename T>
+  void Push(const T& value);
+
+  const Mutator* inline_mutators() const {
+    return reinterpret_cast<const Mutator*>(inline_storage_);
+  }
+  Mutator* inline_mutators() {
+    return reinterpret_cast<Mutator*>(inline_storage_);
+  }
+
+  void CopyFrom(const MutatorsStack& other);
+  void Clear();
+
+  // The first |inline_size_| mutators in here are alive, unless |heap_| is
+  // set.
+  alignas(Mutator) unsigned char inline_storage_[kInlineCapacity *
+                                                 sizeof(Mutator)];
+  size_t inline_size_ = 0;
+  // Holds all the mutators of a stack that grew beyond |kInlineCapacity|. It
+  // is only changed while no other stack refers to it.
+  std::shared_ptr<std::vector<Mutator>> heap_;
 };  // MutatorsStack
 
 class EmbeddedViewParams {
@@ -290,6 +332,11 @@ class ExternalViewEmbedder {
       double device_pixel_ratio,
       fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) = 0;
 
+  // Called after |BeginFrame| with the ID of the Flutter view the frame is
+  // rendered into. Embedders that present every view of a frame separately
+  // use it to tell the frames of one vsync apart.
+  virtual void SetFlutterViewId(int64_t flutter_view_id) {}
+
   virtual void PrerollCompositeEmbeddedView(
       int view_id,
       std::unique_ptr<EmbeddedViewParams> params) = 0;
@@ -340,6 +387,11 @@ class ExternalViewEmbedder {
   // |RasterThreadMerger| instance.
   virtual bool SupportsDynamicThreadMerging();
 
+  // Whether |SubmitFrame| may be called on the raster thread while the
+  // |RasterThreadMerger| instance has not merged the threads. Embedders that
+  // return `true` synchronize with the platform thread themselves.
+  virtual bool SubmitsFramesWithoutThreadMerging();
+
   FML_DISALLOW_COPY_AND_ASSIGN(ExternalViewEmbedder);
 
 };  // ExternalViewEmbedder
@@ -0,0 +1,283 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/diff_context.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/message_loop.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace {
+
+constexpr int kFrameWidth = 1024;
+constexpr int kFrameHeight = 1024;
+constexpr SkScalar kPictureSize = 32;
+
+sk_sp<SkPicture> CreatePicture(SkColor color, int op_count = 8) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas =
+      recorder.beginRecording(SkRect::MakeWH(kPictureSize, kPictureSize));
+  SkPaint paint;
+  paint.setColor(color);
+  paint.setAntiAlias(true);
+  for (int i = 0; i < op_count; i++) {
+    canvas->drawCircle(kPictureSize / 2, kPictureSize / 2,
+                       kPictureSize / 2 - i, paint);
+  }
+  return recorder.finishRecordingAsPicture();
+}
+
+// Builds synthetic layer trees and prerolls and paints them into a raster
+// surface the size of a frame, without a raster cache unless asked for.
+class LayerTreeBenchmark {
+ public:
+  LayerTreeBenchmark()
+      : compositor_context_(fml::kDefaultFrameBudget),
+        surface_(SkSurface::MakeRasterN32Premul(kFrameWidth, kFrameHeight)) {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    unref_queue_ = fml::MakeRefCounted<SkiaUnrefQueue>(
+        fml::MessageLoop::GetCurrent().GetTaskRunner(),
+        fml::TimeDelta::FromSeconds(0));
+  }
+
+  ~LayerTreeBenchmark() {
+    layer_tree_.reset();
+    unref_queue_->Drain();
+  }
+
+  std::shared_ptr<PictureLayer> CreatePictureLayer(sk_sp<SkPicture> picture,
+                                                   const SkPoint& offset) {
+    return std::make_shared<PictureLayer>(
+        offset, SkiaGPUObject<SkPicture>(std::move(picture), unref_queue_),
+        false, false);
+  }
+
+  // A chain of |depth| transform layers above a single picture.
+  std::shared_ptr<Layer> CreateDeepTransforms(int depth) {
+    std::shared_ptr<ContainerLayer> root = std::make_shared<ContainerLayer>();
+    ContainerLayer* parent = root.get();
+    for (int i = 0; i < depth; i++) {
+      SkMatrix matrix = SkMatrix::Translate(1, 1);
+      matrix.preRotate(1);
+      auto transform = std::make_shared<TransformLayer>(matrix);
+      parent->Add(transform);
+      parent = transform.get();
+    }
+    parent->Add(CreatePictureLayer(CreatePicture(SK_ColorBLUE), {0, 0}));
+    return root;
+  }
+
+  // A container with |count| pictures that are laid out in a grid and
+  // overflow the frame once there are more than fit.
+  std::shared_ptr<Layer> CreateWideContainer(int count) {
+    std::shared_ptr<ContainerLayer> root = std::make_shared<ContainerLayer>();
+    const int columns = kFrameWidth / kPictureSize;
+    for (int i = 0; i < count; i++) {
+      root->Add(CreatePictureLayer(
+          CreatePicture(SK_ColorRED + i),
+          SkPoint::Make((i % columns) * kPictureSize,
+                        (i / columns) * kPictureSize)));
+    }
+    return root;
+  }
+
+  // Alternating opacity and clip layers, |depth| of each, above a picture.
+  std::shared_ptr<Layer> CreateOpacityClipStack(int depth) {
+    std::shared_ptr<ContainerLayer> root = std::make_shared<ContainerLayer>();
+    ContainerLayer* parent = root.get();
+    for (int i = 0; i < depth; i++) {
+      auto opacity = std::make_shared<OpacityLayer>(250, SkPoint::Make(1, 1));
+      auto clip = std::make_shared<ClipRectLayer>(
+          SkRect::MakeWH(kFrameWidth - i, kFrameHeight - i), Clip::hardEdge);
+      parent->Add(opacity);
+      opacity->Add(clip);
+      parent = clip.get();
+    }
+    parent->Add(CreatePictureLayer(CreatePicture(SK_ColorGREEN), {0, 0}));
+    return root;
+  }
+
+  void SetRootLayer(std::shared_ptr<Layer> root_layer) {
+    layer_tree_ = std::make_unique<LayerTree>(
+        SkISize::Make(kFrameWidth, kFrameHeight), 1.0f);
+    layer_tree_->set_root_layer(std::move(root_layer));
+  }
+
+  std::unique_ptr<CompositorContext::ScopedFrame> AcquireFrame() {
+    return compositor_context_.AcquireFrame(nullptr, surface_->getCanvas(),
+                                            nullptr, SkMatrix::I(), false,
+                                            true, nullptr);
+  }
+
+  LayerTree& layer_tree() { return *layer_tree_; }
+  SkCanvas* canvas() { return surface_->getCanvas(); }
+
+ private:
+  CompositorContext compositor_context_;
+  sk_sp<SkSurface> surface_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+  std::unique_ptr<LayerTree> layer_tree_;
+};
+
+enum class TreeShape { kDeepTransforms, kWideContainer, kOpacityClipStack };
+
+std::shared_ptr<Layer> CreateTree(LayerTreeBenchmark& benchmark,
+                                  TreeShape shape,
+                                  int size) {
+  switch (shape) {
+    case TreeShape::kDeepTransforms:
+      return benchmark.CreateDeepTransforms(size);
+    case TreeShape::kWideContainer:
+      return benchmark.CreateWideContainer(size);
+    case TreeShape::kOpacityClipStack:
+      return benchmark.CreateOpacityClipStack(size);
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+static void BM_LayerTreePreroll(benchmark::State& state, TreeShape shape) {
+  LayerTreeBenchmark benchmark;
+  benchmark.SetRootLayer(CreateTree(benchmark, shape, state.range(0)));
+  auto frame = benchmark.AcquireFrame();
+  while (state.KeepRunning()) {
+    benchmark.layer_tree().Preroll(*frame, true);
+  }
+}
+
+static void BM_LayerTreePaint(benchmark::State& state, TreeShape shape) {
+  LayerTreeBenchmark benchmark;
+  benchmark.SetRootLayer(CreateTree(benchmark, shape, state.range(0)));
+  auto frame = benchmark.AcquireFrame();
+  benchmark.layer_tree().Preroll(*frame, true);
+  while (state.KeepRunning()) {
+    benchmark.layer_tree().Paint(*frame, true);
+  }
+}
+
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+
+// Diffs two trees of |state.range(0)| pictures that differ in one picture,
+// as after most of a screen was retained from the previous frame.
+static void BM_DiffContextComputeDamage(benchmark::State& state) {
+  LayerTreeBenchmark benchmark;
+  const int count = state.range(0);
+  std::vector<sk_sp<SkPicture>> pictures;
+  for (int i = 0; i < count; i++) {
+    pictures.push_back(CreatePicture(SK_ColorRED + i));
+  }
+  const int columns = kFrameWidth / kPictureSize;
+  auto create_tree = [&](int changed_index) {
+    auto root = std::make_shared<ContainerLayer>();
+    for (int i = 0; i < count; i++) {
+      root->Add(benchmark.CreatePictureLayer(
+          i == changed_index ? CreatePicture(SK_ColorWHITE) : pictures[i],
+          SkPoint::Make((i % columns) * kPictureSize,
+                        (i / columns) * kPictureSize)));
+    }
+    return root;
+  };
+  auto old_root = create_tree(-1);
+  auto new_root = create_tree(count / 2);
+  const SkISize frame_size = SkISize::Make(kFrameWidth, kFrameHeight);
+
+  PaintRegionMap old_paint_region_map;
+  {
+    PaintRegionMap empty_paint_region_map;
+    ContainerLayer empty_root;
+    DiffContext context(frame_size, 1, old_paint_region_map,
+                        empty_paint_region_map);
+    context.PushCullRect(SkRect::Make(frame_size));
+    old_root->Diff(&context, &empty_root);
+  }
+
+  while (state.KeepRunning()) {
+    PaintRegionMap paint_region_map;
+    DiffContext context(frame_size, 1, paint_region_map,
+                        old_paint_region_map);
+    context.PushCullRect(SkRect::Make(frame_size));
+    new_root->Diff(&context, old_root.get());
+    benchmark::DoNotOptimize(context.ComputeDamage(SkIRect::MakeEmpty()));
+  }
+}
+
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
+
+static void BM_RasterCacheHit(benchmark::State& state) {
+  LayerTreeBenchmark benchmark;
+  RasterCache cache(1 /* access_threshold */);
+  sk_sp<SkPicture> picture = CreatePicture(SK_ColorRED);
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  // The picture is cached once it was drawn in one frame.
+  cache.Prepare(nullptr, picture.get(), SkMatrix::I(), srgb.get(), true, false);
+  cache.Draw(*picture, *benchmark.canvas());
+  cache.SweepAfterFrame();
+  if (!cache.Prepare(nullptr, picture.get(), SkMatrix::I(), srgb.get(), true,
+                     false)) {
+    state.SkipWithError("The picture was not cached.");
+    return;
+  }
+  while (state.KeepRunning()) {
+    cache.Draw(*picture, *benchmark.canvas());
+  }
+}
+
+static void BM_RasterCacheMiss(benchmark::State& state) {
+  LayerTreeBenchmark benchmark;
+  RasterCache cache;
+  sk_sp<SkPicture> picture = CreatePicture(SK_ColorRED);
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  while (state.KeepRunning()) {
+    // The picture is accessed for the first time every frame.
+    cache.Prepare(nullptr, picture.get(), SkMatrix::I(), srgb.get(), true,
+                  false);
+    if (!cache.Draw(*picture, *benchmark.canvas())) {
+      picture->playback(benchmark.canvas());
+    }
+    cache.Clear();
+  }
+}
+
+BENCHMARK_CAPTURE(BM_LayerTreePreroll, DeepTransforms,
+                  TreeShape::kDeepTransforms)
+    ->Range(8, 512);
+BENCHMARK_CAPTURE(BM_LayerTreePreroll, WideContainer,
+                  TreeShape::kWideContainer)
+    ->Range(8, 4096);
+BENCHMARK_CAPTURE(BM_LayerTreePreroll, OpacityClipStack,
+                  TreeShape::kOpacityClipStack)
+    ->Range(8, 256);
+
+BENCHMARK_CAPTURE(BM_LayerTreePaint, DeepTransforms,
+                  TreeShape::kDeepTransforms)
+    ->Range(8, 512);
+BENCHMARK_CAPTURE(BM_LayerTreePaint, WideContainer, TreeShape::kWideContainer)
+    ->Range(8, 4096);
+BENCHMARK_CAPTURE(BM_LayerTreePaint, OpacityClipStack,
+                  TreeShape::kOpacityClipStack)
+    ->Range(8, 256);
+
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+BENCHMARK(BM_DiffContextComputeDamage)->Range(8, 4096);
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
+
+BENCHMARK(BM_RasterCacheHit);
+BENCHMARK(BM_RasterCacheMiss);
+
+}  // namespace flutter
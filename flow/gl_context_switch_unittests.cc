@@ -24,5 +24,32 @@ TEST(GLContextSwitchTest, SwitchKeepsContextCurrentWhileInScope) {
   ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), -1);
 }
 
+TEST(GLContextSwitchTest, NestedSwitchToCurrentContextIsSkipped) {
+  {
+    auto context_switch =
+        GLContextSwitch(std::make_unique<TestSwitchableGLContext>(0));
+    ASSERT_TRUE(context_switch.GetResult());
+    {
+      auto nested_context_switch =
+          GLContextSwitch(std::make_unique<TestSwitchableGLContext>(0));
+      ASSERT_TRUE(nested_context_switch.GetResult());
+      ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), 0);
+    }
+    // The nested switch must not have removed the context of the outer one.
+    ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), 0);
+  }
+  ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), -1);
+}
+
+TEST(GLContextSwitchTest, SwitchToOtherContextIsNotSkipped) {
+  TestSwitchableGLContext::SetCurrentContext(1);
+  {
+    auto context_switch =
+        GLContextSwitch(std::make_unique<TestSwitchableGLContext>(0));
+    ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), 0);
+  }
+  ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), -1);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -320,4 +320,54 @@ int64_t CounterValues::GetMinValue() const {
   return min;
 }
 
+FrameStatistics::FrameStatistics() = default;
+
+FrameStatistics::~FrameStatistics() = default;
+
+void FrameStatistics::EndFrame() {
+  sample_hits_ += current_frame_.raster_cache_hits;
+  sample_misses_ += current_frame_.raster_cache_misses;
+  sample_save_layers_ += current_frame_.save_layers;
+  sample_damaged_fraction_ += current_frame_.damaged_fraction;
+  sample_max_frames_in_flight_ =
+      std::max(sample_max_frames_in_flight_, current_frame_.frames_in_flight);
+  sample_dropped_frames_ += current_frame_.dropped_frames;
+
+  if (IsLastFrameOfSample()) {
+    const size_t draws = sample_hits_ + sample_misses_;
+    last_sample_.raster_cache_hit_rate =
+        draws > 0 ? static_cast<double>(sample_hits_) / draws : -1;
+    last_sample_.save_layers_per_frame =
+        static_cast<double>(sample_save_layers_) / kFramesPerSample;
+    last_sample_.damaged_fraction = sample_damaged_fraction_ / kFramesPerSample;
+    last_sample_.max_frames_in_flight = sample_max_frames_in_flight_;
+    last_sample_.dropped_frames = sample_dropped_frames_;
+    last_sample_.raster_cache_bytes = current_frame_.raster_cache_bytes;
+    last_sample_.gpu_resource_bytes = current_frame_.gpu_resource_bytes;
+    last_sample_.gpu_resource_count = current_frame_.gpu_resource_count;
+    last_sample_.pending_unref_objects = current_frame_.pending_unref_objects;
+
+    frames_in_sample_ = 0;
+    sample_count_++;
+    sample_hits_ = 0;
+    sample_misses_ = 0;
+    sample_save_layers_ = 0;
+    sample_damaged_fraction_ = 0;
+    sample_max_frames_in_flight_ = 0;
+    sample_dropped_frames_ = 0;
+  } else {
+    frames_in_sample_++;
+  }
+  current_frame_ = {};
+}
+
+sk_sp<SkTextBlob> FrameStatistics::GetSampleText(
+    const std::function<sk_sp<SkTextBlob>(const Sample&)>& make_text) const {
+  if (!sample_text_ || sample_text_count_ != sample_count_) {
+    sample_text_ = make_text(last_sample_);
+    sample_text_count_ = sample_count_;
+  }
+  return sample_text_;
+}
+
 }  // namespace flutter
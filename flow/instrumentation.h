@@ -5,12 +5,14 @@
 #ifndef FLUTTER_FLOW_INSTRUMENTATION_H_
 #define FLUTTER_FLOW_INSTRUMENTATION_H_
 
+#include <functional>
 #include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
 
 namespace flutter {
 
@@ -96,6 +98,90 @@ class CounterValues {
   FML_DISALLOW_COPY_AND_ASSIGN(CounterValues);
 };
 
+// The statistics of the frames besides their times that the performance
+// overlay can show, e.g. to spot raster cache thrash without a tracer.
+//
+// The values of each frame are recorded into |current_frame| while it is
+// rasterized, and are summarized once every |kFramesPerSample| frames. The
+// values that are expensive to collect only need to be recorded for the
+// frames that end a sample, see |IsLastFrameOfSample|.
+class FrameStatistics {
+ public:
+  static constexpr size_t kFramesPerSample = 30;
+
+  struct Frame {
+    // The draws of cacheable pictures and layers that found an image in the
+    // raster cache, and the ones that did not.
+    size_t raster_cache_hits = 0;
+    size_t raster_cache_misses = 0;
+    size_t save_layers = 0;
+    size_t frames_in_flight = 0;
+    // The frames of the pipeline that were dropped in favor of this one.
+    size_t dropped_frames = 0;
+    // The fraction of the frame that was repainted.
+    double damaged_fraction = 1;
+
+    // Only recorded for the last frame of a sample.
+    size_t raster_cache_bytes = 0;
+    size_t gpu_resource_bytes = 0;
+    int gpu_resource_count = 0;
+    size_t pending_unref_objects = 0;
+  };
+
+  struct Sample {
+    // The fraction of the raster cache draws that were hits, or a negative
+    // value if the raster cache was not drawn from.
+    double raster_cache_hit_rate = -1;
+    double save_layers_per_frame = 0;
+    double damaged_fraction = 1;
+    size_t max_frames_in_flight = 0;
+    size_t dropped_frames = 0;
+    size_t raster_cache_bytes = 0;
+    size_t gpu_resource_bytes = 0;
+    int gpu_resource_count = 0;
+    size_t pending_unref_objects = 0;
+  };
+
+  FrameStatistics();
+
+  ~FrameStatistics();
+
+  Frame& current_frame() { return current_frame_; }
+
+  bool IsLastFrameOfSample() const {
+    return frames_in_sample_ + 1 == kFramesPerSample;
+  }
+
+  void EndFrame();
+
+  // The number of samples that were completed so far.
+  size_t sample_count() const { return sample_count_; }
+
+  const Sample& last_sample() const { return last_sample_; }
+
+  // Returns the text |make_text| makes for the last sample, only calling it
+  // again once another sample was completed.
+  sk_sp<SkTextBlob> GetSampleText(
+      const std::function<sk_sp<SkTextBlob>(const Sample&)>& make_text) const;
+
+ private:
+  Frame current_frame_;
+  size_t frames_in_sample_ = 0;
+  size_t sample_count_ = 0;
+  size_t sample_hits_ = 0;
+  size_t sample_misses_ = 0;
+  size_t sample_save_layers_ = 0;
+  double sample_damaged_fraction_ = 0;
+  size_t sample_max_frames_in_flight_ = 0;
+  size_t sample_dropped_frames_ = 0;
+  Sample last_sample_;
+
+  mutable sk_sp<SkTextBlob> sample_text_;
+  mutable size_t sample_text_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameStatistics);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_INSTRUMENTATION_H_
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include "third_party/skia/include/core/SkSurface.h"
+
 namespace flutter {
 
 BackdropFilterLayer::BackdropFilterLayer(sk_sp<SkImageFilter> filter,
@@ -35,6 +37,12 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
       filter->filterBounds(input_filter_bounds, SkMatrix::I(),
                            SkImageFilter::kReverse_MapDirection);
 
+  // If nothing below this layer changed where the filter reads from, the
+  // backdrop filtered in the previous frame is still valid.
+  backdrop_unchanged_ =
+      !context->IsSubtreeDirty() && !context->IsRegionDamaged(filter_bounds);
+  cached_backdrop_ = backdrop_unchanged_ ? prev->cached_backdrop_ : nullptr;
+
   context->AddReadbackRegion(filter_bounds);
 
   DiffChildren(context, prev);
@@ -46,6 +54,13 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
 
 void BackdropFilterLayer::Preroll(PrerollContext* context,
                                   const SkMatrix& matrix) {
+  // The backdrop can only be read from the surface directly if no ancestor
+  // paints into a saveLayer. Diff runs after Preroll and decides whether the
+  // cached backdrop is still valid, so this has to be reset in every frame.
+  can_cache_backdrop_ = filter_ && !context->inside_save_layer;
+  backdrop_unchanged_ = false;
+  context->subtree_requires_preroll = true;
+
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, true, bool(filter_));
   SkRect child_paint_bounds = SkRect::MakeEmpty();
@@ -60,10 +75,90 @@ void BackdropFilterLayer::Paint(PaintContext& context) const {
 
   SkPaint paint;
   paint.setBlendMode(blend_mode_);
+  if (const CachedBackdrop* backdrop = GetCachedBackdrop(context)) {
+    Layer::AutoSaveLayer save =
+        Layer::AutoSaveLayer::Create(context, paint_bounds(), &paint);
+    {
+      SkAutoCanvasRestore auto_restore(context.leaf_nodes_canvas, true);
+      context.leaf_nodes_canvas->resetMatrix();
+      context.leaf_nodes_canvas->drawImage(
+          backdrop->image, backdrop->origin.x(), backdrop->origin.y(),
+          SkSamplingOptions(), nullptr);
+    }
+    PaintChildren(context);
+    return;
+  }
+
   Layer::AutoSaveLayer save = Layer::AutoSaveLayer::Create(
       context,
       SkCanvas::SaveLayerRec{&paint_bounds(), &paint, filter_.get(), 0});
   PaintChildren(context);
 }
 
+const BackdropFilterLayer::CachedBackdrop*
+BackdropFilterLayer::GetCachedBackdrop(const PaintContext& context) const {
+  // The backdrop is read from the surface of the leaf canvas, which is only
+  // what the backdrop filter would read if no overlay canvases are painted to.
+  if (!backdrop_unchanged_ || !can_cache_backdrop_ ||
+      !context.surface_supports_readback ||
+      (context.view_embedder &&
+       !context.view_embedder->GetCurrentCanvases().empty())) {
+    cached_backdrop_ = nullptr;
+    return nullptr;
+  }
+  SkCanvas* canvas = context.leaf_nodes_canvas;
+  SkSurface* surface = canvas->getSurface();
+  if (!surface) {
+    cached_backdrop_ = nullptr;
+    return nullptr;
+  }
+
+  const SkMatrix& matrix = canvas->getTotalMatrix();
+  const SkIRect device_bounds = matrix.mapRect(paint_bounds()).roundOut();
+  SkIRect input_bounds = filter_->makeWithLocalMatrix(matrix)->filterBounds(
+      device_bounds, SkMatrix::I(), SkImageFilter::kReverse_MapDirection);
+  if (!input_bounds.intersect(SkIRect::MakeSize(canvas->getBaseLayerSize()))) {
+    cached_backdrop_ = nullptr;
+    return nullptr;
+  }
+  if (cached_backdrop_ && cached_backdrop_->matrix == matrix &&
+      cached_backdrop_->input_bounds == input_bounds) {
+    return cached_backdrop_.get();
+  }
+
+  // This is the first frame in which the backdrop is unchanged. Filter it once
+  // and keep the result for the following frames.
+  TRACE_EVENT0("flutter", "BackdropFilterLayer::CacheBackdrop");
+  cached_backdrop_ = nullptr;
+  sk_sp<SkImage> backdrop = surface->makeImageSnapshot(input_bounds);
+  if (!backdrop) {
+    return nullptr;
+  }
+  // Filter the backdrop in the coordinates of the snapshot.
+  SkMatrix snapshot_matrix = matrix;
+  snapshot_matrix.postTranslate(-input_bounds.left(), -input_bounds.top());
+  SkIRect subset;
+  SkIPoint offset;
+  sk_sp<SkImage> filtered = backdrop->makeWithFilter(
+      context.gr_context,
+      filter_->makeWithLocalMatrix(snapshot_matrix).get(),
+      SkIRect::MakeSize(backdrop->dimensions()),
+      device_bounds.makeOffset(-input_bounds.left(), -input_bounds.top()),
+      &subset, &offset);
+  if (filtered && subset != SkIRect::MakeSize(filtered->dimensions())) {
+    filtered = filtered->makeSubset(subset, context.gr_context);
+  }
+  if (!filtered) {
+    return nullptr;
+  }
+
+  cached_backdrop_ = std::make_shared<CachedBackdrop>();
+  cached_backdrop_->matrix = matrix;
+  cached_backdrop_->input_bounds = input_bounds;
+  cached_backdrop_->image = std::move(filtered);
+  cached_backdrop_->origin = SkIPoint::Make(input_bounds.left() + offset.x(),
+                                            input_bounds.top() + offset.y());
+  return cached_backdrop_.get();
+}
+
 }  // namespace flutter
@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 
 #include "flutter/flow/layers/container_layer.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
 
 namespace flutter {
@@ -18,6 +19,11 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  // Whether the last Diff found that nothing painted below this layer changed
+  // where the filter reads from, so that the backdrop filtered in an earlier
+  // frame can be painted again.
+  bool backdrop_unchanged() const { return backdrop_unchanged_; }
+
 #endif  // FLUTTER_ENABLE_DIFF_CONTEXT
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
@@ -25,9 +31,26 @@ class BackdropFilterLayer : public ContainerLayer {
   void Paint(PaintContext& context) const override;
 
  private:
+  // The filtered backdrop, in device coordinates.
+  struct CachedBackdrop {
+    SkMatrix matrix;
+    SkIRect input_bounds;
+    sk_sp<SkImage> image;
+    SkIPoint origin;
+  };
+
+  // Returns the filtered backdrop to paint instead of filtering the backdrop
+  // again, or nullptr if the backdrop has to be filtered.
+  const CachedBackdrop* GetCachedBackdrop(const PaintContext& context) const;
+
   sk_sp<SkImageFilter> filter_;
   SkBlendMode blend_mode_;
 
+  bool can_cache_backdrop_ = false;
+  bool backdrop_unchanged_ = false;
+  // Handed over to the layer that replaces this one in the next frame.
+  mutable std::shared_ptr<CachedBackdrop> cached_backdrop_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
 
@@ -330,6 +330,61 @@ TEST_F(BackdropLayerDiffTest, BackdropLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 190, 190));
 }
 
+TEST_F(BackdropLayerDiffTest, BackdropUnchangedWhenContentBelowIsUnchanged) {
+  auto filter = SkImageFilters::Blur(10, 10, SkTileMode::kClamp, nullptr);
+  // The filter reads from (70, 70, 180, 180).
+  const SkRect clip_rect = SkRect::MakeLTRB(100, 100, 150, 150);
+  const SkPath outside = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  const SkPath inside = SkPath().addRect(SkRect::MakeLTRB(60, 60, 80, 80));
+
+  std::shared_ptr<ClipRectLayer> old_clip;
+  std::shared_ptr<BackdropFilterLayer> old_backdrop;
+  auto add_backdrop = [&](MockLayerTree& tree, const SkPath& child_path) {
+    auto clip = std::make_shared<ClipRectLayer>(clip_rect, Clip::hardEdge);
+    auto backdrop =
+        std::make_shared<BackdropFilterLayer>(filter, SkBlendMode::kSrcOver);
+    if (old_clip) {
+      clip->AssignOldLayer(old_clip.get());
+      backdrop->AssignOldLayer(old_backdrop.get());
+    }
+    backdrop->Add(std::make_shared<MockLayer>(child_path));
+    clip->Add(backdrop);
+    tree.root()->Add(clip);
+    old_clip = clip;
+    old_backdrop = backdrop;
+    return backdrop;
+  };
+
+  MockLayerTree l1(SkISize::Make(200, 200));
+  l1.root()->Add(std::make_shared<MockLayer>(outside));
+  auto backdrop1 = add_backdrop(l1, inside);
+  DiffLayerTree(l1, MockLayerTree(SkISize::Make(200, 200)));
+  EXPECT_FALSE(backdrop1->backdrop_unchanged());
+
+  // Content below and outside of the readback region changed, as did the
+  // child painted on top of the backdrop.
+  MockLayerTree l2(SkISize::Make(200, 200));
+  l2.root()->Add(std::make_shared<MockLayer>(outside.makeOffset(1, 1)));
+  auto backdrop2 = add_backdrop(l2, outside);
+  DiffLayerTree(l2, l1);
+  EXPECT_TRUE(backdrop2->backdrop_unchanged());
+
+  // Content below and inside of the readback region changed.
+  MockLayerTree l3(SkISize::Make(200, 200));
+  l3.root()->Add(std::make_shared<MockLayer>(outside.makeOffset(1, 1)));
+  l3.root()->Add(std::make_shared<MockLayer>(inside));
+  auto backdrop3 = add_backdrop(l3, outside);
+  DiffLayerTree(l3, l2);
+  EXPECT_FALSE(backdrop3->backdrop_unchanged());
+
+  MockLayerTree l4(SkISize::Make(200, 200));
+  l4.root()->Add(std::make_shared<MockLayer>(outside.makeOffset(1, 1)));
+  l4.root()->Add(std::make_shared<MockLayer>(inside));
+  auto backdrop4 = add_backdrop(l4, outside);
+  DiffLayerTree(l4, l3);
+  EXPECT_TRUE(backdrop4->backdrop_unchanged());
+}
+
 #endif
 
 }  // namespace testing
@@ -33,6 +33,8 @@ void ColorFilterLayer::Preroll(PrerollContext* context,
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The filter applies to the children as a whole.
+  set_layer_can_inherit_opacity(false);
 }
 
 void ColorFilterLayer::Paint(PaintContext& context) const {
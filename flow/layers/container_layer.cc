@@ -4,8 +4,12 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <optional>
 
+#include "flutter/fml/synchronization/count_down_latch.h"
+
 namespace flutter {
 
 ContainerLayer::ContainerLayer() {}
@@ -68,17 +72,16 @@ void ContainerLayer::DiffChildren(DiffContext* context,
 
   // old layers that don't match
   for (int i = old_children_top; i <= old_children_bottom; ++i) {
-    auto layer = prev_layers[i];
-    context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
+    context->AddDamage(context->GetOldLayerPaintRegion(prev_layers[i].get()));
   }
 
   for (int i = 0; i < static_cast<int>(layers_.size()); ++i) {
     if (i < new_children_top || i > new_children_bottom) {
       int i_prev =
           i < new_children_top ? i : prev_layers.size() - (layers_.size() - i);
-      auto layer = layers_[i];
-      auto prev_layer = prev_layers[i_prev];
-      auto paint_region = context->GetOldLayerPaintRegion(prev_layer.get());
+      Layer* layer = layers_[i].get();
+      Layer* prev_layer = prev_layers[i_prev].get();
+      auto paint_region = context->GetOldLayerPaintRegion(prev_layer);
       if (layer == prev_layer && !paint_region.has_readback()) {
         // for retained layers, stop processing the subtree and add existing
         // region; We know current subtree is not dirty (every ancestor up to
@@ -93,13 +96,12 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         // retrieve it in next frame diff
         layer->PreservePaintRegion(context);
       } else {
-        layer->Diff(context, prev_layer.get());
+        layer->Diff(context, prev_layer);
       }
     } else {
       DiffContext::AutoSubtreeRestore subtree(context);
       context->MarkSubtreeDirty();
-      auto layer = layers_[i];
-      layer->Diff(context, nullptr);
+      layers_[i]->Diff(context, nullptr);
     }
   }
 }
@@ -116,6 +118,7 @@ void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_layer_can_inherit_opacity(children_can_inherit_opacity());
 }
 
 void ContainerLayer::Paint(PaintContext& context) const {
@@ -138,19 +141,30 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   // Platform views have no children, so context->has_platform_view should
   // always be false.
   FML_DCHECK(!context->has_platform_view);
+
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+  if (context->concurrent_task_runner &&
+      layers_.size() >= kMinChildrenForParallelPreroll) {
+    PrerollChildrenInParallel(context, child_matrix, child_paint_bounds);
+    return;
+  }
+#endif
+
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
+  children_can_inherit_opacity_ = true;
   for (auto& layer : layers_) {
     // Reset context->has_platform_view to false so that layers aren't treated
     // as if they have a platform view based on one being previously found in a
     // sibling tree.
     context->has_platform_view = false;
 
-    layer->Preroll(context, child_matrix);
+    layer->PrerollOrReuse(context, child_matrix);
 
     if (layer->needs_system_composite()) {
       set_needs_system_composite(true);
     }
+    UpdateChildrenCanInheritOpacity(layer.get(), *child_paint_bounds);
     child_paint_bounds->join(layer->paint_bounds());
 
     child_has_platform_view =
@@ -162,6 +176,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
   set_subtree_has_platform_view(child_has_platform_view);
+  UpdateChildrenIndex();
 
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   if (child_layer_exists_below_) {
@@ -172,6 +187,160 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
 #endif
 }
 
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+
+void ContainerLayer::PrerollChildrenInParallel(PrerollContext* context,
+                                               const SkMatrix& child_matrix,
+                                               SkRect* child_paint_bounds) {
+  TRACE_EVENT0("flutter", "ContainerLayer::PrerollChildrenInParallel");
+
+  // What prerolling a child changed in its copy of the PrerollContext.
+  struct ChildResult {
+    bool has_platform_view = false;
+    bool has_texture_layer = false;
+    bool surface_needs_readback = false;
+    bool subtree_requires_preroll = false;
+    std::vector<PrerollContext::DeferredOperation> deferred_operations;
+  };
+
+  // Shared with the posted tasks, which may only start running after this
+  // method returned. They only touch |layers| and |results| after claiming a
+  // batch, and this method waits for every claimed batch to finish.
+  struct State {
+    explicit State(size_t batch_count) : pending_batches(batch_count) {}
+
+    std::atomic<size_t> next_batch{0};
+    fml::CountDownLatch pending_batches;
+  };
+
+  const size_t batch_count =
+      (layers_.size() + kParallelPrerollBatchSize - 1) /
+      kParallelPrerollBatchSize;
+  auto state = std::make_shared<State>(batch_count);
+  std::vector<ChildResult> results(layers_.size());
+
+  auto preroll_batches = [state, batch_count, context, &child_matrix,
+                          layers = &layers_, results = &results]() {
+    while (true) {
+      const size_t batch = state->next_batch.fetch_add(1);
+      if (batch >= batch_count) {
+        return;
+      }
+      const size_t begin = batch * kParallelPrerollBatchSize;
+      const size_t end =
+          std::min(begin + kParallelPrerollBatchSize, layers->size());
+      for (size_t i = begin; i < end; i++) {
+        ChildResult& result = (*results)[i];
+        MutatorsStack mutators_stack = context->mutators_stack;
+        PrerollContext child_context = {
+            context->raster_cache,
+            context->gr_context,
+            context->view_embedder,
+            mutators_stack,
+            context->dst_color_space,
+            context->cull_rect,
+            context->surface_needs_readback,
+            context->raster_time,
+            context->ui_time,
+            context->texture_registry,
+            context->checkerboard_offscreen_layers,
+            context->frame_device_pixel_ratio};
+        child_context.inside_save_layer = context->inside_save_layer;
+        child_context.has_texture_layer = context->has_texture_layer;
+        child_context.deferred_operations = &result.deferred_operations;
+
+        (*layers)[i]->PrerollOrReuse(&child_context, child_matrix);
+
+        result.has_platform_view = child_context.has_platform_view;
+        result.has_texture_layer = child_context.has_texture_layer;
+        result.surface_needs_readback = child_context.surface_needs_readback;
+        result.subtree_requires_preroll =
+            child_context.subtree_requires_preroll;
+      }
+      state->pending_batches.CountDown();
+    }
+  };
+
+  // The calling thread prerolls batches as well, so it never waits for a batch
+  // that no worker has started yet.
+  for (size_t i = 1; i < batch_count; i++) {
+    context->concurrent_task_runner->PostTask(preroll_batches);
+  }
+  preroll_batches();
+  state->pending_batches.Wait();
+
+  // Merge the results in order. The raster cache preparations recorded by a
+  // child are skipped for layers once an earlier sibling contained a texture
+  // layer, as they would have been when prerolling the children in order.
+  PrerollContext merge_context = *context;
+  bool child_has_platform_view = false;
+  children_can_inherit_opacity_ = true;
+  for (size_t i = 0; i < layers_.size(); i++) {
+    const auto& layer = layers_[i];
+    ChildResult& result = results[i];
+
+    merge_context.has_platform_view = false;
+    for (const auto& operation : result.deferred_operations) {
+      operation(&merge_context);
+    }
+
+    if (layer->needs_system_composite()) {
+      set_needs_system_composite(true);
+    }
+    UpdateChildrenCanInheritOpacity(layer.get(), *child_paint_bounds);
+    child_paint_bounds->join(layer->paint_bounds());
+
+    child_has_platform_view =
+        child_has_platform_view || result.has_platform_view;
+    merge_context.has_texture_layer =
+        merge_context.has_texture_layer || result.has_texture_layer;
+    merge_context.surface_needs_readback =
+        merge_context.surface_needs_readback || result.surface_needs_readback;
+    merge_context.subtree_requires_preroll =
+        merge_context.subtree_requires_preroll ||
+        result.subtree_requires_preroll;
+  }
+
+  context->has_platform_view = child_has_platform_view;
+  context->has_texture_layer = merge_context.has_texture_layer;
+  context->surface_needs_readback = merge_context.surface_needs_readback;
+  context->subtree_requires_preroll = merge_context.subtree_requires_preroll;
+  set_subtree_has_platform_view(child_has_platform_view);
+  UpdateChildrenIndex();
+}
+
+#endif  // !defined(LEGACY_FUCHSIA_EMBEDDER)
+
+void ContainerLayer::UpdateChildrenCanInheritOpacity(
+    const Layer* child,
+    const SkRect& previous_children_bounds) {
+  // Children that overlap an earlier sibling would blend with it when painted
+  // with an opacity each, unlike inside a single saveLayer.
+  if (!child->layer_can_inherit_opacity() ||
+      child->paint_bounds().intersects(previous_children_bounds)) {
+    children_can_inherit_opacity_ = false;
+  }
+}
+
+void ContainerLayer::UpdateChildrenIndex() {
+  // Children with a platform view are painted even when they are outside of
+  // the clip, see Layer::needs_painting.
+  if (layers_.size() < kMinChildrenForSpatialIndex ||
+      subtree_has_platform_view()) {
+    children_index_ = nullptr;
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "ContainerLayer::UpdateChildrenIndex");
+  std::vector<SkRect> bounds;
+  bounds.reserve(layers_.size());
+  for (auto& layer : layers_) {
+    bounds.push_back(layer->paint_bounds());
+  }
+  children_index_ = sk_make_sp<RTree>();
+  children_index_->insert(bounds.data(), bounds.size());
+}
+
 void ContainerLayer::PaintChildren(PaintContext& context) const {
   // We can no longer call FML_DCHECK here on the needs_painting(context)
   // condition as that test is only valid for the PaintContext that
@@ -181,6 +350,22 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
 
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
+  if (children_index_ &&
+      static_cast<size_t>(children_index_->getCount()) == layers_.size()) {
+    std::vector<int> visible_children;
+    children_index_->search(context.leaf_nodes_canvas->getLocalClipBounds(),
+                            &visible_children);
+    // The index does not return the children in paint order.
+    std::sort(visible_children.begin(), visible_children.end());
+    for (int index : visible_children) {
+      auto& layer = layers_[index];
+      if (layer->needs_painting(context)) {
+        layer->Paint(context);
+      }
+    }
+    return;
+  }
+
   for (auto& layer : layers_) {
     if (layer->needs_painting(context)) {
       layer->Paint(context);
@@ -194,6 +379,16 @@ void ContainerLayer::TryToPrepareRasterCache(PrerollContext* context,
   if (!context->has_platform_view && !context->has_texture_layer &&
       context->raster_cache &&
       SkRect::Intersects(context->cull_rect, layer->paint_bounds())) {
+    if (context->deferred_operations) {
+      context->deferred_operations->push_back(
+          [layer, matrix](PrerollContext* merge_context) {
+            if (!merge_context->has_texture_layer) {
+              merge_context->raster_cache->Prepare(merge_context, layer,
+                                                   matrix);
+            }
+          });
+      return;
+    }
     context->raster_cache->Prepare(context, layer, matrix);
   }
 }
@@ -8,11 +8,23 @@
 #include <vector>
 
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/rtree.h"
 
 namespace flutter {
 
 class ContainerLayer : public Layer {
  public:
+  // The minimum number of children for PrerollChildren to preroll them
+  // concurrently if the PrerollContext has a concurrent task runner.
+  static constexpr size_t kMinChildrenForParallelPreroll = 16;
+
+  // The number of consecutive children prerolled by a single task.
+  static constexpr size_t kParallelPrerollBatchSize = 4;
+
+  // The minimum number of children for PrerollChildren to index their paint
+  // bounds, so that PaintChildren only visits the children within the clip.
+  static constexpr size_t kMinChildrenForSpatialIndex = 64;
+
   ContainerLayer();
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
@@ -45,6 +57,13 @@ class ContainerLayer : public Layer {
                        SkRect* child_paint_bounds);
   void PaintChildren(PaintContext& context) const;
 
+  // Whether, as of the last PrerollChildren, every child can inherit opacity
+  // and no two children overlap, so that painting each of them with an opacity
+  // gives the same result as painting all of them into a saveLayer with it.
+  bool children_can_inherit_opacity() const {
+    return children_can_inherit_opacity_;
+  }
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateSceneChildren(std::shared_ptr<SceneUpdateContext> context);
 #endif
@@ -65,6 +84,24 @@ class ContainerLayer : public Layer {
 
  private:
   std::vector<std::shared_ptr<Layer>> layers_;
+  bool children_can_inherit_opacity_ = false;
+  // The paint bounds of the children as of the last PrerollChildren, if there
+  // are enough children for the index to pay off.
+  sk_sp<RTree> children_index_;
+
+  void UpdateChildrenCanInheritOpacity(const Layer* child,
+                                       const SkRect& previous_children_bounds);
+
+  void UpdateChildrenIndex();
+
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+  // Prerolls the children in batches on |context->concurrent_task_runner| as
+  // well as on the calling thread, then merges the results in order as if
+  // they had been prerolled one after the other.
+  void PrerollChildrenInParallel(PrerollContext* context,
+                                 const SkMatrix& child_matrix,
+                                 SkRect* child_paint_bounds);
+#endif
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
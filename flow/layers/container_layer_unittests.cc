@@ -4,9 +4,12 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/texture_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 
@@ -269,6 +272,178 @@ TEST_F(ContainerLayerTest, MergedMultipleChildren) {
                                                child_path2, child_paint2}}}));
 }
 
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+
+TEST_F(ContainerLayerTest, ParallelPrerollMatchesSequentialPreroll) {
+  const size_t child_count = ContainerLayer::kMinChildrenForParallelPreroll * 2;
+  const SkMatrix initial_transform = SkMatrix::Translate(-0.5f, -0.5f);
+  const SkMatrix parent_transform = SkMatrix::Scale(2.0f, 2.0f);
+
+  auto layer = std::make_shared<ContainerLayer>();
+  std::vector<std::shared_ptr<MockLayer>> mock_layers;
+  SkRect expected_total_bounds = SkRect::MakeEmpty();
+  for (size_t i = 0; i < child_count; i++) {
+    SkPath child_path;
+    child_path.addRect(i * 10.0f, 0.0f, i * 10.0f + 5.0f, 5.0f);
+    expected_total_bounds.join(child_path.getBounds());
+    auto mock_layer = std::make_shared<MockLayer>(
+        child_path, SkPaint(), /*fake_has_platform_view=*/i == 3,
+        /*fake_needs_system_composite=*/false,
+        /*fake_reads_surface=*/i == child_count - 1);
+    mock_layers.push_back(mock_layer);
+    layer->Add(mock_layer);
+  }
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  preroll_context()->concurrent_task_runner = task_runner.get();
+  preroll_context()->mutators_stack.PushTransform(parent_transform);
+  layer->Preroll(preroll_context(), initial_transform);
+  preroll_context()->mutators_stack.Pop();
+
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+  EXPECT_TRUE(layer->subtree_has_platform_view());
+  EXPECT_EQ(layer->paint_bounds(), expected_total_bounds);
+
+  MutatorsStack expected_mutators;
+  expected_mutators.PushTransform(parent_transform);
+  for (const auto& mock_layer : mock_layers) {
+    EXPECT_EQ(mock_layer->parent_matrix(), initial_transform);
+    EXPECT_EQ(mock_layer->parent_cull_rect(), kGiantRect);
+    EXPECT_EQ(mock_layer->parent_mutators(), expected_mutators);
+    // Siblings are independent.
+    EXPECT_FALSE(mock_layer->parent_has_platform_view());
+  }
+}
+
+TEST_F(ContainerLayerTest, ParallelPrerollPreparesRasterCacheLikeSequential) {
+  const size_t child_count = ContainerLayer::kMinChildrenForParallelPreroll * 2;
+  const size_t texture_layer_index = child_count / 2;
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+
+  auto create_layer = [&]() {
+    auto layer = std::make_shared<ContainerLayer>();
+    for (size_t i = 0; i < child_count; i++) {
+      if (i == texture_layer_index) {
+        layer->Add(std::make_shared<TextureLayer>(
+            SkPoint::Make(0.0f, 0.0f), SkSize::Make(5.0f, 5.0f), 0, false,
+            SkSamplingOptions()));
+        continue;
+      }
+      auto opacity_layer =
+          std::make_shared<OpacityLayer>(128, SkPoint::Make(i * 10.0f, 0.0f));
+      opacity_layer->Add(std::make_shared<MockLayer>(child_path));
+      layer->Add(opacity_layer);
+    }
+    return layer;
+  };
+
+  use_mock_raster_cache();
+  create_layer()->Preroll(preroll_context(), SkMatrix());
+  const size_t sequential_entries =
+      raster_cache()->GetLayerCachedEntriesCount();
+  // Once a texture layer was prerolled, later siblings are not cached.
+  EXPECT_EQ(sequential_entries, texture_layer_index);
+
+  use_mock_raster_cache();
+  preroll_context()->has_texture_layer = false;
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  preroll_context()->concurrent_task_runner = task_runner.get();
+  create_layer()->Preroll(preroll_context(), SkMatrix());
+
+  EXPECT_TRUE(preroll_context()->has_texture_layer);
+  EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), sequential_entries);
+}
+
+TEST_F(ContainerLayerTest, RetainedChildReusesPreroll) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  mock_layer->set_is_retained();
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_mutators(), MutatorsStack());
+
+  // The mutators stack only matters to platform views, so the child is not
+  // prerolled again.
+  preroll_context()->mutators_stack.PushOpacity(128);
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_mutators(), MutatorsStack());
+  EXPECT_EQ(layer->paint_bounds(), child_path.getBounds());
+
+  // A different matrix requires another Preroll.
+  MutatorsStack expected_mutators;
+  expected_mutators.PushOpacity(128);
+  layer->Preroll(preroll_context(), SkMatrix::Translate(1.0f, 0.0f));
+  EXPECT_EQ(mock_layer->parent_mutators(), expected_mutators);
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(1.0f, 0.0f));
+  preroll_context()->mutators_stack.Pop();
+}
+
+TEST_F(ContainerLayerTest, RetainedChildWithPlatformViewIsAlwaysPrerolled) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(
+      child_path, SkPaint(), /*fake_has_platform_view=*/true);
+  mock_layer->set_is_retained();
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+
+  preroll_context()->has_platform_view = false;
+  preroll_context()->mutators_stack.PushOpacity(128);
+  layer->Preroll(preroll_context(), SkMatrix());
+  MutatorsStack expected_mutators;
+  expected_mutators.PushOpacity(128);
+  EXPECT_EQ(mock_layer->parent_mutators(), expected_mutators);
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+  preroll_context()->mutators_stack.Pop();
+}
+
+#endif  // !defined(LEGACY_FUCHSIA_EMBEDDER)
+
+TEST_F(ContainerLayerTest, ManyChildrenPaintsOnlyVisibleChildrenInOrder) {
+  const size_t grid_size = 10;
+  static_assert(grid_size * grid_size >=
+                    ContainerLayer::kMinChildrenForSpatialIndex,
+                "the children must be indexed");
+  const SkRect clip_rect = SkRect::MakeLTRB(32.0f, 32.0f, 58.0f, 48.0f);
+
+  // Lay out the children column by column, so that the paint order differs
+  // from the order of the rows.
+  auto layer = std::make_shared<ContainerLayer>();
+  std::vector<MockCanvas::DrawCall> expected_draw_calls = {
+      MockCanvas::DrawCall{
+          0, MockCanvas::ClipRectData{clip_rect, SkClipOp::kIntersect,
+                                      MockCanvas::kHard_ClipEdgeStyle}}};
+  for (size_t x = 0; x < grid_size; x++) {
+    for (size_t y = 0; y < grid_size; y++) {
+      SkPath child_path;
+      child_path.addRect(x * 10.0f, y * 10.0f, x * 10.0f + 5.0f,
+                         y * 10.0f + 5.0f);
+      SkPaint child_paint(SkColor4f{x / 10.0f, y / 10.0f, 0.0f, 1.0f});
+      layer->Add(std::make_shared<MockLayer>(child_path, child_paint));
+      if (child_path.getBounds().intersects(clip_rect)) {
+        expected_draw_calls.push_back(MockCanvas::DrawCall{
+            0, MockCanvas::DrawPathData{child_path, child_paint}});
+      }
+    }
+  }
+  // The clip and the children in columns 3 to 5 of rows 3 and 4.
+  ASSERT_EQ(expected_draw_calls.size(), 7u);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  paint_context().internal_nodes_canvas->clipRect(clip_rect, false);
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+}
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
 using ContainerLayerDiffTest = DiffContextTest;
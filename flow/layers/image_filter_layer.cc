@@ -9,7 +9,8 @@ namespace flutter {
 ImageFilterLayer::ImageFilterLayer(sk_sp<SkImageFilter> filter)
     : filter_(std::move(filter)),
       transformed_filter_(nullptr),
-      render_count_(1) {}
+      render_count_(1),
+      output_cache_(unique_id()) {}
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
@@ -22,6 +23,10 @@ void ImageFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
       context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(old_layer));
     }
   }
+  // The output filtered in the previous frame can only be reused if the
+  // filter and the transform did not change.
+  const LayerOutputCache* prev_output_cache =
+      context->IsSubtreeDirty() ? nullptr : &prev->output_cache_;
 
   DiffChildren(context, prev);
 
@@ -36,12 +41,24 @@ void ImageFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
                              SkImageFilter::kForward_MapDirection);
     context->AddLayerBounds(inverse.mapRect(SkRect::Make(filter_bounds)));
 
+    // A damaged child affects the filtered output as far as the filter
+    // reaches, e.g. by the radius of a blur.
+    SkRect output_damage = context->GetSubtreeDamage();
+    if (!output_damage.isEmpty()) {
+      output_damage = SkRect::Make(filter->filterBounds(
+          output_damage.roundOut(), SkMatrix::I(),
+          SkImageFilter::kForward_MapDirection));
+    }
+    output_cache_.Diff(context, prev_output_cache, output_damage);
+
     // Technically, there is no readback with ImageFilterLayer, but we can't
     // clip the filter (because it may sample out of clip rect) so if any part
     // of layer is repainted the whole layer needs to be.
     // TODO(knopp) There is a room for optimization here - this doesn't need to
     // be done if we know for sure that we're using raster cache
     context->AddReadbackRegion(filter_bounds);
+  } else {
+    output_cache_.Diff(context, nullptr, SkRect::MakeEmpty());
   }
 
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
@@ -58,6 +75,8 @@ void ImageFilterLayer::Preroll(PrerollContext* context,
   SkRect child_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_bounds);
 
+  output_cache_.Preroll(context);
+
   if (!filter_) {
     set_paint_bounds(child_bounds);
     return;
@@ -82,6 +101,7 @@ void ImageFilterLayer::Preroll(PrerollContext* context,
     // increment the count to measure how many times it has been
     // seen from frame to frame.
     render_count_++;
+    context->subtree_requires_preroll = true;
 
     // Now we will try to pre-render the children into the cache.
     // To apply the filter to pre-rendered children, we must first
@@ -106,21 +126,32 @@ void ImageFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ImageFilterLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
-  if (context.raster_cache) {
-    if (context.raster_cache->Draw(this, *context.leaf_nodes_canvas)) {
-      return;
-    }
-    if (transformed_filter_) {
-      SkPaint paint;
-      paint.setImageFilter(transformed_filter_);
+  if (context.raster_cache &&
+      context.raster_cache->Draw(this, *context.leaf_nodes_canvas)) {
+    return;
+  }
+
+  if (filter_ && output_cache_.Paint(context, paint_bounds(),
+                                     [this](PaintContext& output_context) {
+                                       PaintFiltered(output_context);
+                                     })) {
+    return;
+  }
 
-      if (context.raster_cache->Draw(GetCacheableChild(),
-                                     *context.leaf_nodes_canvas, &paint)) {
-        return;
-      }
+  if (context.raster_cache && transformed_filter_) {
+    SkPaint paint;
+    paint.setImageFilter(transformed_filter_);
+
+    if (context.raster_cache->Draw(GetCacheableChild(),
+                                   *context.leaf_nodes_canvas, &paint)) {
+      return;
     }
   }
 
+  PaintFiltered(context);
+}
+
+void ImageFilterLayer::PaintFiltered(PaintContext& context) const {
   SkPaint paint;
   paint.setImageFilter(filter_);
 
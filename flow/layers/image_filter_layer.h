@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_LAYERS_IMAGE_FILTER_LAYER_H_
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_output_cache.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
 
 namespace flutter {
@@ -18,6 +19,13 @@ class ImageFilterLayer : public MergedContainerLayer {
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  // The part of the filtered output that the last Diff found changed, in
+  // screen coordinates, or nullopt if the output filtered in an earlier frame
+  // can not be reused.
+  std::optional<SkRect> output_damage() const {
+    return output_cache_.damage();
+  }
+
 #endif  // FLUTTER_ENABLE_DIFF_CONTEXT
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
@@ -44,6 +52,10 @@ class ImageFilterLayer : public MergedContainerLayer {
   sk_sp<SkImageFilter> filter_;
   sk_sp<SkImageFilter> transformed_filter_;
   int render_count_;
+  LayerOutputCache output_cache_;
+
+  // Paints the filtered children without the raster cache.
+  void PaintFiltered(PaintContext& context) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageFilterLayer);
 };
@@ -385,6 +385,52 @@ TEST_F(ImageFilterLayerDiffTest, ImageFilterLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(130, 130, 280, 280));
 }
 
+TEST_F(ImageFilterLayerDiffTest, OutputDamageIsFilteredDamageOfChildren) {
+  // The filter reaches 30px.
+  auto filter = SkImageFilters::Blur(10, 10, SkTileMode::kClamp, nullptr);
+  const SkPath still = SkPath().addRect(SkRect::MakeLTRB(100, 100, 110, 110));
+  const SkPath moving = SkPath().addRect(SkRect::MakeLTRB(150, 150, 160, 160));
+
+  std::shared_ptr<ImageFilterLayer> old_filter_layer;
+  auto add_filter_layer = [&](MockLayerTree& tree,
+                              const sk_sp<SkImageFilter>& layer_filter,
+                              const SkPath& moving_path) {
+    auto filter_layer = std::make_shared<ImageFilterLayer>(layer_filter);
+    if (old_filter_layer) {
+      filter_layer->AssignOldLayer(old_filter_layer.get());
+    }
+    filter_layer->Add(std::make_shared<MockLayer>(still));
+    filter_layer->Add(std::make_shared<MockLayer>(moving_path));
+    tree.root()->Add(filter_layer);
+    old_filter_layer = filter_layer;
+    return filter_layer;
+  };
+
+  MockLayerTree l1(SkISize::Make(300, 300));
+  auto filter_layer1 = add_filter_layer(l1, filter, moving);
+  DiffLayerTree(l1, MockLayerTree(SkISize::Make(300, 300)));
+  EXPECT_FALSE(filter_layer1->output_damage().has_value());
+
+  MockLayerTree l2(SkISize::Make(300, 300));
+  auto filter_layer2 = add_filter_layer(l2, filter, moving);
+  DiffLayerTree(l2, l1);
+  EXPECT_EQ(filter_layer2->output_damage(), SkRect::MakeEmpty());
+
+  MockLayerTree l3(SkISize::Make(300, 300));
+  auto filter_layer3 = add_filter_layer(l3, filter, moving.makeOffset(5, 5));
+  DiffLayerTree(l3, l2);
+  EXPECT_EQ(filter_layer3->output_damage(),
+            SkRect::MakeLTRB(120, 120, 195, 195));
+
+  // The whole output changes with the filter.
+  MockLayerTree l4(SkISize::Make(300, 300));
+  auto filter_layer4 = add_filter_layer(
+      l4, SkImageFilters::Blur(5, 5, SkTileMode::kClamp, nullptr),
+      moving.makeOffset(5, 5));
+  DiffLayerTree(l4, l3);
+  EXPECT_FALSE(filter_layer4->output_damage().has_value());
+}
+
 #endif
 
 }  // namespace testing
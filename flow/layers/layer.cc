@@ -14,7 +14,9 @@ Layer::Layer()
       unique_id_(NextUniqueID()),
       original_layer_id_(unique_id_),
       needs_system_composite_(false),
-      subtree_has_platform_view_(false) {}
+      subtree_has_platform_view_(false),
+      layer_can_inherit_opacity_(false),
+      is_retained_(false) {}
 
 Layer::~Layer() = default;
 
@@ -29,6 +31,83 @@ uint64_t Layer::NextUniqueID() {
 
 void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {}
 
+Layer::PrerollMemo::PrerollMemo(const PrerollContext* context,
+                                const SkMatrix& matrix)
+    : matrix(matrix),
+      cull_rect(context->cull_rect),
+      raster_cache(context->raster_cache),
+      evicted_image_count(
+          context->raster_cache ? context->raster_cache->GetEvictedImageCount()
+                                : 0),
+      gr_context(context->gr_context),
+      dst_color_space(context->dst_color_space),
+      frame_device_pixel_ratio(context->frame_device_pixel_ratio),
+      checkerboard_offscreen_layers(context->checkerboard_offscreen_layers),
+      inside_save_layer(context->inside_save_layer),
+      has_texture_layer(context->has_texture_layer),
+      surface_needs_readback(context->surface_needs_readback) {}
+
+bool Layer::PrerollMemo::HasSameInputs(const PrerollMemo& other) const {
+  return matrix == other.matrix && cull_rect == other.cull_rect &&
+         raster_cache == other.raster_cache &&
+         evicted_image_count == other.evicted_image_count &&
+         gr_context == other.gr_context &&
+         dst_color_space == other.dst_color_space &&
+         frame_device_pixel_ratio == other.frame_device_pixel_ratio &&
+         checkerboard_offscreen_layers == other.checkerboard_offscreen_layers &&
+         inside_save_layer == other.inside_save_layer &&
+         has_texture_layer == other.has_texture_layer &&
+         surface_needs_readback == other.surface_needs_readback;
+}
+
+void Layer::PrerollOrReuse(PrerollContext* context, const SkMatrix& matrix) {
+#if defined(LEGACY_FUCHSIA_EMBEDDER)
+  Preroll(context, matrix);
+#else
+  // The raster cache is only used on the raster thread, so the preparations of
+  // a subtree can't be counted while it is prerolled concurrently.
+  if (!is_retained() || context->deferred_operations) {
+    Preroll(context, matrix);
+    return;
+  }
+
+  PrerollMemo memo(context, matrix);
+  if (preroll_memo_ && preroll_memo_->HasSameInputs(memo)) {
+    TRACE_EVENT0("flutter", "Layer::PrerollOrReuse (reused)");
+    context->has_texture_layer = preroll_memo_->result_has_texture_layer;
+    context->surface_needs_readback =
+        preroll_memo_->result_surface_needs_readback;
+    return;
+  }
+
+  const size_t unsettled_preparations =
+      context->raster_cache
+          ? context->raster_cache->GetUnsettledPreparationCount()
+          : 0;
+  const bool requires_preroll = context->subtree_requires_preroll;
+  context->subtree_requires_preroll = false;
+
+  Preroll(context, matrix);
+
+  // Platform views have to be registered with the view embedder in every
+  // frame.
+  const bool reusable =
+      !context->has_platform_view && !context->subtree_requires_preroll &&
+      (!context->raster_cache ||
+       context->raster_cache->GetUnsettledPreparationCount() ==
+           unsettled_preparations);
+  context->subtree_requires_preroll =
+      requires_preroll || context->subtree_requires_preroll;
+  if (reusable) {
+    memo.result_has_texture_layer = context->has_texture_layer;
+    memo.result_surface_needs_readback = context->surface_needs_readback;
+    preroll_memo_ = memo;
+  } else {
+    preroll_memo_.reset();
+  }
+#endif
+}
+
 Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
     PrerollContext* preroll_context,
     bool save_layer_is_active,
@@ -38,7 +117,9 @@ Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
       layer_itself_performs_readback_(layer_itself_performs_readback) {
   if (save_layer_is_active_) {
     prev_surface_needs_readback_ = preroll_context_->surface_needs_readback;
+    prev_inside_save_layer_ = preroll_context_->inside_save_layer;
     preroll_context_->surface_needs_readback = false;
+    preroll_context_->inside_save_layer = true;
   }
 }
 
@@ -54,6 +135,7 @@ Layer::AutoPrerollSaveLayerState::~AutoPrerollSaveLayerState() {
   if (save_layer_is_active_) {
     preroll_context_->surface_needs_readback =
         (prev_surface_needs_readback_ || layer_itself_performs_readback_);
+    preroll_context_->inside_save_layer = prev_inside_save_layer_;
   }
 }
 
@@ -86,12 +168,18 @@ Layer::AutoSaveLayer::AutoSaveLayer(const PaintContext& paint_context,
                                     const SkRect& bounds,
                                     const SkPaint* paint)
     : paint_context_(paint_context), bounds_(bounds) {
+  if (paint_context_.frame_statistics) {
+    paint_context_.frame_statistics->current_frame().save_layers++;
+  }
   paint_context_.internal_nodes_canvas->saveLayer(bounds_, paint);
 }
 
 Layer::AutoSaveLayer::AutoSaveLayer(const PaintContext& paint_context,
                                     const SkCanvas::SaveLayerRec& layer_rec)
     : paint_context_(paint_context), bounds_(*layer_rec.fBounds) {
+  if (paint_context_.frame_statistics) {
+    paint_context_.frame_statistics->current_frame().save_layers++;
+  }
   paint_context_.internal_nodes_canvas->saveLayer(layer_rec);
 }
 
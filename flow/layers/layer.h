@@ -5,7 +5,10 @@
 #ifndef FLUTTER_FLOW_LAYERS_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_LAYER_H_
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/common/graphics/texture.h"
@@ -15,6 +18,7 @@
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/compiler_specific.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/trace_event.h"
@@ -61,6 +65,10 @@ struct PrerollContext {
   const bool checkerboard_offscreen_layers;
   const float frame_device_pixel_ratio;
 
+  // Whether an ancestor paints its children into a saveLayer, so that layers
+  // reading back the surface read from that layer instead.
+  bool inside_save_layer = false;
+
   // These allow us to track properties like elevation, opacity, and the
   // prescence of a platform view during Preroll.
   bool has_platform_view = false;
@@ -72,6 +80,26 @@ struct PrerollContext {
   // These allow us to track properties like elevation, opacity, and the
   // prescence of a texture layer during Preroll.
   bool has_texture_layer = false;
+
+  // Set by layers whose Preroll has to run in every frame even if neither the
+  // layer nor the PrerollContext changed, e.g. because it counts frames. The
+  // retained subtrees containing such a layer are always prerolled, see
+  // Layer::PrerollOrReuse.
+  bool subtree_requires_preroll = false;
+
+  // If set, ContainerLayer::PrerollChildren prerolls large sets of children
+  // concurrently on this task runner.
+  fml::ConcurrentTaskRunner* concurrent_task_runner = nullptr;
+
+  // An operation that has to run on the raster thread, in the order the layers
+  // are prerolled. It is passed the PrerollContext of the container that
+  // prerolled the recording layer concurrently.
+  using DeferredOperation = std::function<void(PrerollContext*)>;
+
+  // Set while a subtree is prerolled off the raster thread. Operations that
+  // use the raster cache or the view embedder are recorded here and run after
+  // all concurrently prerolled children finished.
+  std::vector<DeferredOperation>* deferred_operations = nullptr;
 };
 
 class PictureLayer;
@@ -114,6 +142,24 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context, const SkMatrix& matrix);
 
+  // Calls Preroll, unless the layer is retained and was last prerolled with an
+  // equal |matrix| and |context| by a Preroll whose results still hold. Then
+  // the paint bounds and raster cache decisions of its subtree are unchanged
+  // and only the effect of that Preroll on |context| is replayed.
+  void PrerollOrReuse(PrerollContext* context, const SkMatrix& matrix);
+
+  // Marks the layer as retained by the framework, see
+  // SceneBuilder::addRetained. The subtree of a retained layer never changes.
+  //
+  // Called on the UI thread while the layer may be prerolled on the raster
+  // thread for an earlier frame.
+  void set_is_retained() {
+    is_retained_.store(true, std::memory_order_relaxed);
+  }
+  bool is_retained() const {
+    return is_retained_.load(std::memory_order_relaxed);
+  }
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -138,6 +184,7 @@ class Layer {
     bool layer_itself_performs_readback_;
 
     bool prev_surface_needs_readback_;
+    bool prev_inside_save_layer_;
   };
 
   struct PaintContext {
@@ -161,6 +208,17 @@ class Layer {
     const RasterCache* raster_cache;
     const bool checkerboard_offscreen_layers;
     const float frame_device_pixel_ratio;
+    // The opacity that an ancestor OpacityLayer passes down instead of painting
+    // its children into a saveLayer. Only layers that reported
+    // |layer_can_inherit_opacity| in their Preroll are painted with an opacity
+    // other than 1.
+    SkScalar inherited_opacity = SK_Scalar1;
+    // Whether the pixels of the surface behind |leaf_nodes_canvas| can be read
+    // back while painting.
+    bool surface_supports_readback = false;
+    // The statistics the save layers of the frame are counted in and the
+    // performance overlay shows. Null if the frame is not instrumented.
+    FrameStatistics* frame_statistics = nullptr;
   };
 
   // Calls SkCanvas::saveLayer and restores the layer upon destruction. Also
@@ -207,6 +265,15 @@ class Layer {
     subtree_has_platform_view_ = value;
   }
 
+  // Whether painting the layer with |PaintContext::inherited_opacity| gives
+  // the same result as painting it into a saveLayer with that opacity. This
+  // must be set by the time Preroll() returns, otherwise the layer is assumed
+  // not to support it.
+  bool layer_can_inherit_opacity() const { return layer_can_inherit_opacity_; }
+  void set_layer_can_inherit_opacity(bool value) {
+    layer_can_inherit_opacity_ = value;
+  }
+
   // Returns the paint bounds in the layer's local coordinate system
   // as determined during Preroll().  The bounds should include any
   // transform, clip or distortions performed by the layer itself,
@@ -280,6 +347,32 @@ class Layer {
   uint64_t original_layer_id_;
   bool needs_system_composite_;
   bool subtree_has_platform_view_;
+  bool layer_can_inherit_opacity_;
+  std::atomic<bool> is_retained_;
+
+  // What the last reusable Preroll of a retained layer depended on and what it
+  // changed in the PrerollContext.
+  struct PrerollMemo {
+    SkMatrix matrix;
+    SkRect cull_rect;
+    RasterCache* raster_cache;
+    size_t evicted_image_count;
+    GrDirectContext* gr_context;
+    SkColorSpace* dst_color_space;
+    float frame_device_pixel_ratio;
+    bool checkerboard_offscreen_layers;
+    bool inside_save_layer;
+    bool has_texture_layer;
+    bool surface_needs_readback;
+
+    bool result_has_texture_layer = false;
+    bool result_surface_needs_readback = false;
+
+    PrerollMemo(const PrerollContext* context, const SkMatrix& matrix);
+
+    bool HasSameInputs(const PrerollMemo& other) const;
+  };
+  std::optional<PrerollMemo> preroll_memo_;
 
   static uint64_t NextUniqueID();
 
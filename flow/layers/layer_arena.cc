@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <atomic>
+#include <new>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/memory/allocation_tags.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr size_t RoundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+std::atomic<size_t> live_block_count{0};
+
+}  // anonymous namespace
+
+struct LayerArena::Block {
+  explicit Block(size_t capacity) : capacity(capacity) {}
+
+  // The number of allocations from the block that are alive, plus one while
+  // the block is the current block of an arena.
+  std::atomic<size_t> ref_count{1};
+  const size_t capacity;
+  size_t used = 0;
+
+  char* data() {
+    return reinterpret_cast<char*>(this) + RoundUp(sizeof(Block), kAlignment);
+  }
+};
+
+LayerArena::LayerArena() = default;
+
+LayerArena::~LayerArena() {
+  if (current_) {
+    ReleaseBlock(current_);
+  }
+}
+
+void* LayerArena::Allocate(size_t size) {
+  // Each allocation is preceded by the block it was made from.
+  const size_t needed = kAlignment + RoundUp(size, kAlignment);
+  Block* block = current_;
+  if (!block || block->used + needed > block->capacity) {
+    const size_t block_capacity =
+        kBlockSize - RoundUp(sizeof(Block), kAlignment);
+    if (needed > block_capacity) {
+      // Too large to share a block, so the block is only alive as long as
+      // the allocation is.
+      block = NewBlock(needed);
+      block->ref_count.fetch_sub(1, std::memory_order_relaxed);
+    } else {
+      if (current_) {
+        ReleaseBlock(current_);
+      }
+      block = current_ = NewBlock(block_capacity);
+    }
+  }
+
+  char* header = block->data() + block->used;
+  block->used += needed;
+  block->ref_count.fetch_add(1, std::memory_order_relaxed);
+  *reinterpret_cast<Block**>(header) = block;
+  return header + kAlignment;
+}
+
+void LayerArena::Deallocate(void* pointer) {
+  FML_DCHECK(pointer);
+  char* header = static_cast<char*>(pointer) - kAlignment;
+  ReleaseBlock(*reinterpret_cast<Block**>(header));
+}
+
+size_t LayerArena::GetLiveBlockCount() {
+  return live_block_count.load(std::memory_order_relaxed);
+}
+
+LayerArena::Block* LayerArena::NewBlock(size_t capacity) {
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kLayerTree);
+  void* memory = ::operator new(RoundUp(sizeof(Block), kAlignment) + capacity);
+  live_block_count.fetch_add(1, std::memory_order_relaxed);
+  return new (memory) Block(capacity);
+}
+
+void LayerArena::ReleaseBlock(Block* block) {
+  if (block->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    block->~Block();
+    ::operator delete(block);
+    live_block_count.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// Allocates the layers of a frame's layer tree from large blocks instead of
+// making one heap allocation per layer.
+//
+// Memory is allocated by bumping a pointer into the current block and is not
+// reused. Each block counts the allocations that are alive in it and is
+// freed along with the last of them, so releasing a frame's layer tree frees
+// a few blocks rather than every layer. As layers are allocated in the order
+// the tree is built, the layers of a subtree are in adjacent blocks. A
+// subtree that is retained by a later frame only keeps the blocks it was
+// allocated in alive, while the rest of its frame's blocks are freed.
+//
+// Only one thread may allocate from an arena, but what it allocated may be
+// released on any thread, and may outlive the arena.
+class LayerArena {
+ public:
+  // The size of the blocks that allocations are made from, unless they are
+  // too large to fit into one.
+  static constexpr size_t kBlockSize = 16 * 1024;
+
+  // An allocator for |std::allocate_shared| that allocates from |arena|.
+  template <typename T>
+  class Allocator {
+   public:
+    using value_type = T;
+
+    explicit Allocator(LayerArena* arena) : arena_(arena) {}
+
+    template <typename U>
+    Allocator(const Allocator<U>& other) : arena_(other.arena_) {}
+
+    T* allocate(size_t n) {
+      static_assert(alignof(T) <= kAlignment,
+                    "The arena does not support over-aligned types.");
+      return static_cast<T*>(arena_->Allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t n) { LayerArena::Deallocate(pointer); }
+
+    // Memory is returned to the block it came from, so the memory of any
+    // arena can be deallocated by any allocator.
+    template <typename U>
+    bool operator==(const Allocator<U>& other) const {
+      return true;
+    }
+
+    template <typename U>
+    bool operator!=(const Allocator<U>& other) const {
+      return false;
+    }
+
+   private:
+    template <typename U>
+    friend class Allocator;
+
+    LayerArena* arena_;
+  };
+
+  LayerArena();
+
+  ~LayerArena();
+
+  // Creates a |T| that is allocated, along with its reference count, from
+  // this arena.
+  template <typename T, typename... Args>
+  std::shared_ptr<T> Make(Args&&... args) {
+    return std::allocate_shared<T>(Allocator<T>(this),
+                                   std::forward<Args>(args)...);
+  }
+
+  void* Allocate(size_t size);
+
+  static void Deallocate(void* pointer);
+
+  // The number of blocks allocated by all arenas that are not freed yet.
+  static size_t GetLiveBlockCount();
+
+ private:
+  struct Block;
+
+  static constexpr size_t kAlignment = alignof(std::max_align_t);
+
+  static Block* NewBlock(size_t capacity);
+  static void ReleaseBlock(Block* block);
+
+  // The block that allocations are made from, to which the arena holds a
+  // reference until it is full.
+  Block* current_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerArena);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
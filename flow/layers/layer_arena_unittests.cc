@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <array>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+class Tracked {
+ public:
+  explicit Tracked(int* destroyed_count) : destroyed_count_(destroyed_count) {}
+  ~Tracked() { (*destroyed_count_)++; }
+
+ private:
+  int* destroyed_count_;
+  char padding_[200];
+};
+
+}  // namespace
+
+TEST(LayerArenaTest, SmallObjectsShareABlock) {
+  const size_t initial_blocks = LayerArena::GetLiveBlockCount();
+  int destroyed_count = 0;
+  {
+    LayerArena arena;
+    std::vector<std::shared_ptr<Tracked>> objects;
+    for (int i = 0; i < 10; i++) {
+      objects.push_back(arena.Make<Tracked>(&destroyed_count));
+    }
+    EXPECT_EQ(LayerArena::GetLiveBlockCount(), initial_blocks + 1);
+  }
+  EXPECT_EQ(destroyed_count, 10);
+  EXPECT_EQ(LayerArena::GetLiveBlockCount(), initial_blocks);
+}
+
+TEST(LayerArenaTest, ObjectsOutliveTheArena) {
+  const size_t initial_blocks = LayerArena::GetLiveBlockCount();
+  int destroyed_count = 0;
+  std::shared_ptr<Tracked> object;
+  {
+    LayerArena arena;
+    object = arena.Make<Tracked>(&destroyed_count);
+  }
+  EXPECT_EQ(destroyed_count, 0);
+  EXPECT_EQ(LayerArena::GetLiveBlockCount(), initial_blocks + 1);
+
+  object.reset();
+  EXPECT_EQ(destroyed_count, 1);
+  EXPECT_EQ(LayerArena::GetLiveBlockCount(), initial_blocks);
+}
+
+TEST(LayerArenaTest, RetainedObjectOnlyKeepsItsBlockAlive) {
+  const size_t initial_blocks = LayerArena::GetLiveBlockCount();
+  int destroyed_count = 0;
+  std::shared_ptr<Tracked> retained;
+  {
+    LayerArena arena;
+    std::vector<std::shared_ptr<Tracked>> objects;
+    retained = arena.Make<Tracked>(&destroyed_count);
+    const size_t count = 4 * LayerArena::kBlockSize / sizeof(Tracked);
+    for (size_t i = 0; i < count; i++) {
+      objects.push_back(arena.Make<Tracked>(&destroyed_count));
+    }
+    EXPECT_GT(LayerArena::GetLiveBlockCount(), initial_blocks + 2);
+  }
+  EXPECT_EQ(LayerArena::GetLiveBlockCount(), initial_blocks + 1);
+
+  retained.reset();
+  EXPECT_EQ(LayerArena::GetLiveBlockCount(), initial_blocks);
+}
+
+TEST(LayerArenaTest, LargeObjectGetsItsOwnBlock) {
+  const size_t initial_blocks = LayerArena::GetLiveBlockCount();
+  LayerArena arena;
+  auto small = arena.Make<int>(1);
+  auto large = arena.Make<std::array<char, 2 * LayerArena::kBlockSize>>();
+  EXPECT_EQ(LayerArena::GetLiveBlockCount(), initial_blocks + 2);
+
+  large.reset();
+  EXPECT_EQ(LayerArena::GetLiveBlockCount(), initial_blocks + 1);
+  auto next = arena.Make<int>(2);
+  EXPECT_EQ(LayerArena::GetLiveBlockCount(), initial_blocks + 1);
+  EXPECT_EQ(*small, 1);
+  EXPECT_EQ(*next, 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
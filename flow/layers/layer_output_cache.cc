@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_output_cache.h"
+
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/utils/SkNWayCanvas.h"
+
+namespace flutter {
+
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+
+void LayerOutputCache::Diff(DiffContext* context,
+                            const LayerOutputCache* prev,
+                            const SkRect& output_damage) {
+  // Children that read back the surface would read from the cached output
+  // rather than from what is painted below the layer.
+  diffed_ = prev && !context->CurrentSubtreeRegion().has_readback();
+  if (!diffed_) {
+    output_ = nullptr;
+    damage_ = std::nullopt;
+    return;
+  }
+  output_ = prev->output_;
+  prev_layer_id_ = prev->layer_id_;
+  diff_transform_ = context->GetTransform();
+  damage_ = output_damage;
+}
+
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
+
+void LayerOutputCache::Preroll(const PrerollContext* context) {
+  // Platform views can not be painted into the cache, and textures change
+  // without any damage.
+  can_cache_ = !context->has_platform_view && !context->has_texture_layer;
+}
+
+bool LayerOutputCache::Paint(
+    const Layer::PaintContext& context,
+    const SkRect& paint_bounds,
+    const std::function<void(Layer::PaintContext&)>& paint_output) const {
+  if (!diffed_ || !can_cache_) {
+    output_ = nullptr;
+    return false;
+  }
+  SkCanvas* canvas = context.leaf_nodes_canvas;
+  const SkMatrix& matrix = canvas->getTotalMatrix();
+  SkIRect bounds = matrix.mapRect(paint_bounds).roundOut();
+  if (!bounds.intersect(SkIRect::MakeSize(canvas->getBaseLayerSize()))) {
+    output_ = nullptr;
+    return false;
+  }
+
+  // The output painted by the layer this one replaces can only be reused if
+  // it was painted the same way, with the same context.
+  GrRecordingContext* recording_context = canvas->recordingContext();
+  if (!output_ || output_->matrix != matrix || output_->bounds != bounds ||
+      output_->recording_context != recording_context) {
+    // Nothing is kept until the output is seen again in the next frame, so
+    // that layers that only last a frame don't allocate a surface.
+    output_ = std::make_shared<Output>();
+    output_->matrix = matrix;
+    output_->bounds = bounds;
+    output_->recording_context = recording_context;
+    output_->layer_id = layer_id_;
+    return false;
+  }
+
+  // The part of the output to paint, in the coordinates of the surface.
+  const SkIRect whole = SkIRect::MakeSize(bounds.size());
+  SkIRect dirty = whole;
+  SkMatrix inverse;
+  if (output_->layer_id == layer_id_ && !damage_) {
+    // Painted by this layer before.
+    dirty.setEmpty();
+  } else if (output_->layer_id == prev_layer_id_ && damage_ &&
+             diff_transform_.invert(&inverse)) {
+    // Only what changed since the layer this one replaces was painted has to
+    // be painted again. The screen coordinates of the diff and the device
+    // coordinates only differ by the transformation of the root surface.
+    const SkMatrix screen_to_device = SkMatrix::Concat(matrix, inverse);
+    SkIRect device_damage = screen_to_device.mapRect(*damage_).roundOut();
+    device_damage.offset(-bounds.left(), -bounds.top());
+    if (!dirty.intersect(device_damage)) {
+      dirty.setEmpty();
+    }
+  }
+  output_->layer_id = layer_id_;
+  damage_ = std::nullopt;
+
+  // The surface is only kept while part of its output is reused, which it is
+  // not for a layer whose output changes entirely in every frame.
+  const SkImageInfo info = SkImageInfo::MakeN32Premul(
+      bounds.width(), bounds.height(), canvas->imageInfo().refColorSpace());
+  if (dirty == whole ||
+      (context.raster_cache &&
+       !context.raster_cache->RetainLayerOutput(info.computeMinByteSize()))) {
+    output_->surface = nullptr;
+    return false;
+  }
+  if (!output_->surface) {
+    output_->surface = canvas->makeSurface(info);
+    if (!output_->surface) {
+      return false;
+    }
+    dirty = whole;
+  }
+
+  if (!dirty.isEmpty()) {
+    TRACE_EVENT0("flutter", "LayerOutputCache::PaintDamage");
+    SkCanvas* output_canvas = output_->surface->getCanvas();
+    SkAutoCanvasRestore auto_restore(output_canvas, true);
+    output_canvas->clipIRect(dirty);
+    output_canvas->clear(SK_ColorTRANSPARENT);
+    output_canvas->translate(-bounds.left(), -bounds.top());
+    output_canvas->concat(matrix);
+
+    const SkISize size = output_canvas->getBaseLayerSize();
+    SkNWayCanvas internal_nodes_canvas(size.width(), size.height());
+    internal_nodes_canvas.setMatrix(output_canvas->getTotalMatrix());
+    internal_nodes_canvas.addCanvas(output_canvas);
+    Layer::PaintContext output_context = {
+        /* internal_nodes_canvas= */ &internal_nodes_canvas,
+        /* leaf_nodes_canvas= */ output_canvas,
+        /* gr_context= */ context.gr_context,
+        /* view_embedder= */ nullptr,
+        context.raster_time,
+        context.ui_time,
+        context.texture_registry,
+        context.raster_cache,
+        context.checkerboard_offscreen_layers,
+        context.frame_device_pixel_ratio};
+    output_context.frame_statistics = context.frame_statistics;
+    paint_output(output_context);
+  }
+
+  SkAutoCanvasRestore auto_restore(canvas, true);
+  canvas->resetMatrix();
+  output_->surface->draw(canvas, bounds.left(), bounds.top(),
+                         SkSamplingOptions(), nullptr);
+  return true;
+}
+
+}  // namespace flutter
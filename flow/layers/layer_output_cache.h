@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_OUTPUT_CACHE_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_OUTPUT_CACHE_H_
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "flutter/flow/layers/layer.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+// Keeps the output of a layer that applies an effect to its children as a
+// whole, such as an image filter or a shader mask, across frames.
+//
+// Once the output of a layer was painted the same way in two frames, it is
+// painted into an offscreen surface and drawn from there. In the following
+// frames, only the part of the output that the diff found damaged is painted
+// again, rather than applying the effect to all of the children. The surface
+// is released as soon as all of its output is damaged, and counts towards the
+// budget and the metrics of the raster cache.
+class LayerOutputCache {
+ public:
+  explicit LayerOutputCache(uint64_t layer_id) : layer_id_(layer_id) {}
+
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+
+  // Called by the Diff of the layer once it diffed its children, within the
+  // subtree of the layer. |prev| is the cache of the layer this layer
+  // replaces, or null if there is none or the effect of the layer changed.
+  // |output_damage| is the part of the output that changed since |prev| was
+  // painted, in screen coordinates.
+  void Diff(DiffContext* context,
+            const LayerOutputCache* prev,
+            const SkRect& output_damage);
+
+  // The part of the output that the last Diff found damaged, in screen
+  // coordinates, or nullopt if the output is not cached.
+  std::optional<SkRect> damage() const { return damage_; }
+
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
+
+  // Called by the Preroll of the layer once it prerolled its children.
+  void Preroll(const PrerollContext* context);
+
+  // Draws the output of the layer from the cache, after painting its damaged
+  // part with |paint_output|. Returns false if the layer has to be painted
+  // directly instead.
+  //
+  // |paint_output| paints the layer as its Paint would without the cache.
+  // |paint_bounds| are the paint bounds of the layer.
+  bool Paint(const Layer::PaintContext& context,
+             const SkRect& paint_bounds,
+             const std::function<void(Layer::PaintContext&)>& paint_output)
+      const;
+
+ private:
+  // The output of a layer, in device coordinates.
+  struct Output {
+    SkMatrix matrix;
+    SkIRect bounds;
+    // The context the output was painted with, which the surface belongs to.
+    GrRecordingContext* recording_context = nullptr;
+    // Null until the output is reused.
+    sk_sp<SkSurface> surface;
+    // The id of the layer whose output |surface| holds.
+    uint64_t layer_id = 0;
+  };
+
+  const uint64_t layer_id_;
+  bool can_cache_ = false;
+  bool diffed_ = false;
+  // The id of the layer that |damage_| is relative to.
+  uint64_t prev_layer_id_ = 0;
+  // The transform of the layer in the last Diff.
+  SkMatrix diff_transform_;
+  mutable std::optional<SkRect> damage_;
+  // Handed over to the layer that replaces this one in the next frame.
+  mutable std::shared_ptr<Output> output_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerOutputCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_OUTPUT_CACHE_H_
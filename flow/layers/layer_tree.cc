@@ -4,9 +4,15 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include <atomic>
+#include <vector>
+
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/rtree.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/utils/SkNWayCanvas.h"
 
 namespace flutter {
@@ -56,6 +62,8 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       frame.context().texture_registry(),
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
+  context.concurrent_task_runner =
+      frame.context().concurrent_preroll_task_runner();
 
   root_layer_->Preroll(&context, frame.root_surface_transformation());
   return context.surface_needs_readback;
@@ -91,9 +99,116 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
     return;
   }
 
-  SkISize canvas_size = frame.canvas()->getBaseLayerSize();
+  PaintToCanvas(frame, frame.canvas(), ignore_raster_cache);
+}
+
+bool LayerTree::PaintInTiles(CompositorContext::ScopedFrame& frame,
+                             fml::ConcurrentTaskRunner* task_runner,
+                             bool ignore_raster_cache) const {
+  TRACE_EVENT0("flutter", "LayerTree::PaintInTiles");
+
+  SkCanvas* frame_canvas = frame.canvas();
+  SkPixmap pixmap;
+  if (!root_layer_ || !frame_canvas || !task_runner ||
+      !frame_canvas->peekPixels(&pixmap)) {
+    return false;
+  }
+
+  const SkIRect clip_bounds = frame_canvas->getDeviceClipBounds();
+  if (clip_bounds.isEmpty()) {
+    return true;
+  }
+
+  // Record with the frame canvas matrix so that raster cache lookups match the
+  // ones of a direct paint. The clip is applied when playing back. The R-tree
+  // lets the playback into each tile skip the operations outside of it.
+  sk_sp<SkPicture> picture;
+  sk_sp<RTree> rtree;
+  {
+    TRACE_EVENT0("flutter", "LayerTree::PaintInTiles (Record)");
+    RTreeFactory rtree_factory;
+    SkPictureRecorder recorder;
+    SkCanvas* recording_canvas =
+        recorder.beginRecording(SkRect::Make(clip_bounds), &rtree_factory);
+    recording_canvas->setMatrix(frame_canvas->getTotalMatrix());
+    PaintToCanvas(frame, recording_canvas, ignore_raster_cache);
+    picture = recorder.finishRecordingAsPicture();
+    rtree = rtree_factory.getInstance();
+  }
+  if (!picture) {
+    return false;
+  }
+
+  // Tiles are aligned to the frame rather than to the clip so that the same
+  // region of the frame always falls into the same tile.
+  std::vector<SkIRect> tiles;
+  for (int top = clip_bounds.top() / kPaintTileSize * kPaintTileSize;
+       top < clip_bounds.bottom(); top += kPaintTileSize) {
+    for (int left = clip_bounds.left() / kPaintTileSize * kPaintTileSize;
+         left < clip_bounds.right(); left += kPaintTileSize) {
+      SkIRect tile =
+          SkIRect::MakeXYWH(left, top, kPaintTileSize, kPaintTileSize);
+      if (!tile.intersect(clip_bounds) ||
+          rtree->searchNonOverlappingDrawnRects(SkRect::Make(tile)).empty()) {
+        continue;
+      }
+      tiles.push_back(tile);
+    }
+  }
+  if (tiles.empty()) {
+    return true;
+  }
+
+  if (SkSurface* surface = frame_canvas->getSurface()) {
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+  }
+
+  // Shared with the posted tasks, which may only start running after this
+  // method returned. They only touch |tiles| and the pixels after claiming a
+  // tile, and this method waits for every claimed tile to finish.
+  struct State {
+    explicit State(size_t tile_count) : pending_tiles(tile_count) {}
+
+    std::atomic<size_t> next_tile{0};
+    fml::CountDownLatch pending_tiles;
+  };
+
+  auto state = std::make_shared<State>(tiles.size());
+  auto paint_tiles = [state, picture, tiles = &tiles, &pixmap]() {
+    while (true) {
+      const size_t index = state->next_tile.fetch_add(1);
+      if (index >= tiles->size()) {
+        return;
+      }
+      TRACE_EVENT0("flutter", "LayerTree::PaintInTiles (Tile)");
+      const SkIRect& tile = (*tiles)[index];
+      const SkImageInfo tile_info =
+          pixmap.info().makeWH(tile.width(), tile.height());
+      std::unique_ptr<SkCanvas> tile_canvas = SkCanvas::MakeRasterDirect(
+          tile_info, pixmap.writable_addr(tile.left(), tile.top()),
+          pixmap.rowBytes());
+      if (tile_canvas) {
+        tile_canvas->translate(-tile.left(), -tile.top());
+        tile_canvas->drawPicture(picture);
+      }
+      state->pending_tiles.CountDown();
+    }
+  };
+
+  for (size_t i = 1; i < tiles.size(); i++) {
+    task_runner->PostTask(paint_tiles);
+  }
+  paint_tiles();
+  state->pending_tiles.Wait();
+  return true;
+}
+
+void LayerTree::PaintToCanvas(CompositorContext::ScopedFrame& frame,
+                              SkCanvas* canvas,
+                              bool ignore_raster_cache) const {
+  SkISize canvas_size = canvas->getBaseLayerSize();
   SkNWayCanvas internal_nodes_canvas(canvas_size.width(), canvas_size.height());
-  internal_nodes_canvas.addCanvas(frame.canvas());
+  internal_nodes_canvas.addCanvas(canvas);
   if (frame.view_embedder() != nullptr) {
     auto overlay_canvases = frame.view_embedder()->GetCurrentCanvases();
     for (size_t i = 0; i < overlay_canvases.size(); i++) {
@@ -103,7 +218,7 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
 
   Layer::PaintContext context = {
       static_cast<SkCanvas*>(&internal_nodes_canvas),
-      frame.canvas(),
+      canvas,
       frame.gr_context(),
       frame.view_embedder(),
       frame.context().raster_time(),
@@ -112,6 +227,10 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       ignore_raster_cache ? nullptr : &frame.context().raster_cache(),
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
+  context.surface_supports_readback = frame.surface_supports_readback();
+  if (frame.instrumentation_enabled()) {
+    context.frame_statistics = &frame.context().frame_statistics();
+  }
 
   if (root_layer_->needs_painting(context)) {
     root_layer_->Paint(context);
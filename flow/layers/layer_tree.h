@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <memory>
 
+#include "flutter/common/constants.h"
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/fml/macros.h"
@@ -38,6 +39,24 @@ class LayerTree {
   void Paint(CompositorContext::ScopedFrame& frame,
              bool ignore_raster_cache = false) const;
 
+  // The width and height of the tiles |PaintInTiles| splits the frame into.
+  static constexpr int kPaintTileSize = 256;
+
+  // Paints the tree like |Paint|, but records the paint commands instead of
+  // executing them on the frame canvas and then plays them back into square
+  // tiles of the frame concurrently on |task_runner| and the calling thread.
+  //
+  // Only the tiles that intersect the clip of the frame canvas, such as the
+  // damage of a partial repaint, and the bounds of at least one recorded draw
+  // operation are painted. The others keep their contents.
+  //
+  // This writes to the pixels of the frame canvas directly, so it is only
+  // supported for raster backed canvases without an active save layer.
+  // Returns false without painting anything otherwise.
+  bool PaintInTiles(CompositorContext::ScopedFrame& frame,
+                    fml::ConcurrentTaskRunner* task_runner,
+                    bool ignore_raster_cache = false) const;
+
   sk_sp<SkPicture> Flatten(const SkRect& bounds);
 
   Layer* root_layer() const { return root_layer_.get(); }
@@ -49,6 +68,19 @@ class LayerTree {
   const SkISize& frame_size() const { return frame_size_; }
   float device_pixel_ratio() const { return device_pixel_ratio_; }
 
+  // The view the tree is rendered into.
+  int64_t view_id() const { return view_id_; }
+
+  // Moves the tree to the view with the given ID, along with the size and
+  // pixel ratio of that view.
+  void set_view(int64_t view_id,
+                const SkISize& frame_size,
+                float device_pixel_ratio) {
+    view_id_ = view_id;
+    frame_size_ = frame_size;
+    device_pixel_ratio_ = device_pixel_ratio;
+  }
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
   const PaintRegionMap& paint_region_map() const { return paint_region_map_; }
@@ -86,13 +118,18 @@ class LayerTree {
   }
 
  private:
+  void PaintToCanvas(CompositorContext::ScopedFrame& frame,
+                     SkCanvas* canvas,
+                     bool ignore_raster_cache) const;
+
   std::shared_ptr<Layer> root_layer_;
   fml::TimePoint vsync_start_;
   fml::TimePoint build_start_;
   fml::TimePoint build_finish_;
   fml::TimePoint target_time_;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
-  const float device_pixel_ratio_;  // Logical / Physical pixels ratio.
+  float device_pixel_ratio_;  // Logical / Physical pixels ratio.
+  int64_t view_id_ = kFlutterImplicitViewId;
   uint32_t rasterizer_tracing_threshold_;
   bool checkerboard_raster_cache_images_;
   bool checkerboard_offscreen_layers_;
@@ -7,10 +7,12 @@
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/canvas_test.h"
 #include "flutter/testing/mock_canvas.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 namespace testing {
@@ -203,5 +205,80 @@ TEST_F(LayerTreeTest, NeedsSystemComposite) {
                                                child_path2, child_paint2}}}));
 }
 
+TEST_F(LayerTreeTest, PaintInTilesRequiresRasterCanvas) {
+  const SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(std::make_shared<MockLayer>(child_path));
+  layer_tree().set_root_layer(layer);
+  layer_tree().Preroll(frame());
+
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+  EXPECT_FALSE(layer_tree().PaintInTiles(frame(), task_runner.get()));
+  EXPECT_EQ(mock_canvas().draw_calls(), std::vector<MockCanvas::DrawCall>());
+}
+
+// Paints |layer_tree| into a new raster surface, either directly or in tiles
+// on |task_runner|, with |clip| applied to the frame canvas.
+static sk_sp<SkSurface> PaintToRasterSurface(
+    LayerTree& layer_tree,
+    const SkIRect& clip,
+    fml::ConcurrentTaskRunner* task_runner) {
+  auto surface = SkSurface::MakeRasterN32Premul(
+      layer_tree.frame_size().width(), layer_tree.frame_size().height());
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorWHITE);
+  canvas->clipRect(SkRect::Make(clip));
+
+  CompositorContext compositor_context(fml::kDefaultFrameBudget);
+  const SkMatrix root_transform = SkMatrix::I();
+  auto frame = compositor_context.AcquireFrame(
+      nullptr, canvas, nullptr, root_transform, false, true, nullptr);
+  layer_tree.Preroll(*frame);
+  if (task_runner) {
+    EXPECT_TRUE(layer_tree.PaintInTiles(*frame, task_runner));
+  } else {
+    layer_tree.Paint(*frame);
+  }
+  return surface;
+}
+
+TEST(LayerTreePaintInTilesTest, MatchesDirectPaint) {
+  // Spans several tiles in each direction, most of which stay empty.
+  LayerTree layer_tree(SkISize::Make(640, 600), 1.0f);
+  auto layer = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < 10; i++) {
+    const SkPath child_path =
+        SkPath().addOval(SkRect::MakeXYWH(i * 60.0f, i * 55.5f, 40.0f, 40.0f));
+    const SkPaint child_paint(
+        SkColor4f::FromColor(SkColorSetRGB(20 * i, 255 - 20 * i, 128)));
+    layer->Add(std::make_shared<MockLayer>(child_path, child_paint));
+  }
+  layer_tree.set_root_layer(layer);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+
+  for (const SkIRect& clip :
+       {SkIRect::MakeWH(640, 600), SkIRect::MakeLTRB(10, 13, 50, 71),
+        SkIRect::MakeLTRB(200, 190, 530, 470)}) {
+    sk_sp<SkSurface> expected =
+        PaintToRasterSurface(layer_tree, clip, nullptr);
+    sk_sp<SkSurface> actual =
+        PaintToRasterSurface(layer_tree, clip, task_runner.get());
+
+    SkPixmap expected_pixels;
+    SkPixmap actual_pixels;
+    ASSERT_TRUE(expected->peekPixels(&expected_pixels));
+    ASSERT_TRUE(actual->peekPixels(&actual_pixels));
+    for (int y = 0; y < expected_pixels.height(); y++) {
+      ASSERT_EQ(memcmp(expected_pixels.addr(0, y), actual_pixels.addr(0, y),
+                       expected_pixels.info().minRowBytes()),
+                0)
+          << "Row " << y << " differs";
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -58,6 +58,9 @@ void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
     TryToPrepareRasterCache(context, GetCacheableChild(), child_matrix);
   }
 
+  // An inherited opacity is combined with the own one.
+  set_layer_can_inherit_opacity(true);
+
   // Restore cull_rect
   context->cull_rect = context->cull_rect.makeOffset(offset_.fX, offset_.fY);
 }
@@ -68,6 +71,9 @@ void OpacityLayer::Paint(PaintContext& context) const {
 
   SkPaint paint;
   paint.setAlpha(alpha_);
+  if (context.inherited_opacity < SK_Scalar1) {
+    paint.setAlphaf(paint.getAlphaf() * context.inherited_opacity);
+  }
 
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
   context.internal_nodes_canvas->translate(offset_.fX, offset_.fY);
@@ -83,6 +89,16 @@ void OpacityLayer::Paint(PaintContext& context) const {
     return;
   }
 
+  const SkScalar inherited_opacity = context.inherited_opacity;
+  if (GetChildContainer()->layer_can_inherit_opacity()) {
+    // The children don't overlap and apply the opacity to their own drawing,
+    // which avoids rendering them into an offscreen layer.
+    context.inherited_opacity = paint.getAlphaf();
+    PaintChildren(context);
+    context.inherited_opacity = inherited_opacity;
+    return;
+  }
+
   // Skia may clip the content with saveLayerBounds (although it's not a
   // guaranteed clip). So we have to provide a big enough saveLayerBounds. To do
   // so, we first remove the offset from paint bounds since it's already in the
@@ -98,7 +114,9 @@ void OpacityLayer::Paint(PaintContext& context) const {
 
   Layer::AutoSaveLayer save_layer =
       Layer::AutoSaveLayer::Create(context, saveLayerBounds, &paint);
+  context.inherited_opacity = SK_Scalar1;
   PaintChildren(context);
+  context.inherited_opacity = inherited_opacity;
 }
 
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
@@ -4,6 +4,9 @@
 
 #include "flutter/flow/layers/opacity_layer.h"
 
+#include <algorithm>
+#include <variant>
+
 #include "flutter/flow/layers/clip_rect_layer.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
@@ -395,6 +398,94 @@ TEST_F(OpacityLayerTest, Nested) {
   EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
 }
 
+TEST_F(OpacityLayerTest, CompatibleChildrenInheritOpacity) {
+  const SkPath child1_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPath child2_path =
+      SkPath().addRect(SkRect::MakeXYWH(10.0f, 0.0f, 5.0f, 5.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kGreen);
+  const SkAlpha alpha_half = 255 / 2;
+  auto mock_layer1 = std::make_shared<MockLayer>(child1_path, child_paint);
+  auto mock_layer2 = std::make_shared<MockLayer>(child2_path, child_paint);
+  mock_layer1->set_fake_can_inherit_opacity(true);
+  mock_layer2->set_fake_can_inherit_opacity(true);
+  const SkPoint layer_offset = SkPoint::Make(1.0f, 2.0f);
+  const SkMatrix layer_transform =
+      SkMatrix::Translate(layer_offset.fX, layer_offset.fY);
+  auto layer = std::make_shared<OpacityLayer>(alpha_half, layer_offset);
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(layer->layer_can_inherit_opacity());
+
+  SkPaint expected_child_paint = child_paint;
+  expected_child_paint.setAlpha(alpha_half);
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::ConcatMatrixData{SkM44(layer_transform)}},
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+       MockCanvas::DrawCall{
+           1, MockCanvas::SetMatrixData{SkM44(layer_transform)}},
+#endif
+       MockCanvas::DrawCall{
+           1, MockCanvas::DrawPathData{child1_path, expected_child_paint}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::DrawPathData{child2_path, expected_child_paint}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+}
+
+TEST_F(OpacityLayerTest, OverlappingChildrenUseSaveLayer) {
+  const SkPath child1_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPath child2_path =
+      SkPath().addRect(SkRect::MakeXYWH(2.0f, 2.0f, 5.0f, 5.0f));
+  auto mock_layer1 = std::make_shared<MockLayer>(child1_path);
+  auto mock_layer2 = std::make_shared<MockLayer>(child2_path);
+  mock_layer1->set_fake_can_inherit_opacity(true);
+  mock_layer2->set_fake_can_inherit_opacity(true);
+  auto layer = std::make_shared<OpacityLayer>(255 / 2, SkPoint::Make(0, 0));
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+  const auto& draw_calls = mock_canvas().draw_calls();
+  EXPECT_TRUE(std::any_of(
+      draw_calls.begin(), draw_calls.end(), [](const auto& draw_call) {
+        return std::holds_alternative<MockCanvas::SaveLayerData>(
+            draw_call.data);
+      }));
+}
+
+TEST_F(OpacityLayerTest, NestedOpacityIsCombined) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kGreen);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  mock_layer->set_fake_can_inherit_opacity(true);
+  auto inner = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  auto outer = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  inner->Add(mock_layer);
+  outer->Add(inner);
+
+  outer->Preroll(preroll_context(), SkMatrix());
+  outer->Paint(paint_context());
+
+  int draw_path_count = 0;
+  for (const auto& draw_call : mock_canvas().draw_calls()) {
+    EXPECT_FALSE(std::holds_alternative<MockCanvas::SaveLayerData>(
+        draw_call.data));
+    if (auto* draw_path =
+            std::get_if<MockCanvas::DrawPathData>(&draw_call.data)) {
+      EXPECT_FLOAT_EQ(draw_path->paint.getAlphaf(),
+                      (128 / 255.f) * (128 / 255.f));
+      draw_path_count++;
+    }
+  }
+  EXPECT_EQ(draw_path_count, 1);
+}
+
 TEST_F(OpacityLayerTest, Readback) {
   auto initial_transform = SkMatrix();
   auto layer = std::make_shared<OpacityLayer>(kOpaque_SkAlphaType, SkPoint());
@@ -6,7 +6,9 @@
 
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "third_party/skia/include/core/SkFont.h"
 #include "third_party/skia/include/core/SkTextBlob.h"
@@ -14,6 +16,18 @@
 namespace flutter {
 namespace {
 
+constexpr SkScalar kFontSize = 15;
+constexpr double kMegaByte = 1 << 20;
+
+SkFont MakeFont(const std::string& font_path) {
+  SkFont font;
+  if (font_path != "") {
+    font = SkFont(SkTypeface::MakeFromFile(font_path.c_str()));
+  }
+  font.setSize(kFontSize);
+  return font;
+}
+
 void VisualizeStopWatch(SkCanvas* canvas,
                         const Stopwatch& stopwatch,
                         SkScalar x,
@@ -47,11 +61,7 @@ sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeStatisticsText(
     const Stopwatch& stopwatch,
     const std::string& label_prefix,
     const std::string& font_path) {
-  SkFont font;
-  if (font_path != "") {
-    font = SkFont(SkTypeface::MakeFromFile(font_path.c_str()));
-  }
-  font.setSize(15);
+  SkFont font = MakeFont(font_path);
 
   double max_ms_per_frame = stopwatch.MaxDelta().ToMillisecondsF();
   double average_ms_per_frame = stopwatch.AverageDelta().ToMillisecondsF();
@@ -66,6 +76,47 @@ sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeStatisticsText(
                                   SkTextEncoding::kUTF8);
 }
 
+sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeFrameStatisticsText(
+    const FrameStatistics::Sample& sample,
+    const std::string& font_path) {
+  std::vector<std::string> lines;
+  auto add_line = [&lines](auto&&... parts) {
+    std::stringstream stream;
+    stream.setf(std::ios::fixed | std::ios::showpoint);
+    stream << std::setprecision(1);
+    (stream << ... << parts);
+    lines.push_back(stream.str());
+  };
+
+  if (sample.raster_cache_hit_rate < 0) {
+    add_line("Raster cache  unused, ",
+             sample.raster_cache_bytes / kMegaByte, " MB");
+  } else {
+    add_line("Raster cache  ", sample.raster_cache_hit_rate * 100,
+             "% hits, ", sample.raster_cache_bytes / kMegaByte, " MB");
+  }
+  add_line("GPU resources  ", sample.gpu_resource_count, ", ",
+           sample.gpu_resource_bytes / kMegaByte, " MB");
+  add_line("Unref queue  ", sample.pending_unref_objects, " pending");
+  add_line("Pipeline  ", sample.max_frames_in_flight, " frames in flight, ",
+           sample.dropped_frames, " dropped");
+  add_line("saveLayers  ", sample.save_layers_per_frame, "/frame");
+  add_line("Repainted  ", sample.damaged_fraction * 100, "% of the frame");
+
+  SkFont font = MakeFont(font_path);
+  SkTextBlobBuilder builder;
+  SkScalar y = 0;
+  for (const auto& line : lines) {
+    const int glyph_count =
+        font.countText(line.c_str(), line.size(), SkTextEncoding::kUTF8);
+    const auto& run = builder.allocRun(font, glyph_count, 0, y);
+    font.textToGlyphs(line.c_str(), line.size(), SkTextEncoding::kUTF8,
+                      run.glyphs, glyph_count);
+    y += kFontSize * 1.2;
+  }
+  return builder.make();
+}
+
 PerformanceOverlayLayer::PerformanceOverlayLayer(uint64_t options,
                                                  const char* font_path)
     : options_(options) {
@@ -113,6 +164,19 @@ void PerformanceOverlayLayer::Paint(PaintContext& context) const {
                      width, height - padding,
                      options_ & kVisualizeEngineStatistics,
                      options_ & kDisplayEngineStatistics, "UI", font_path_);
+
+  // The text only changes once per sample of the statistics, so it is cached
+  // by them rather than made again for every frame.
+  if ((options_ & kDisplayFrameStatistics) && context.frame_statistics) {
+    auto text = context.frame_statistics->GetSampleText(
+        [font_path = font_path_](const FrameStatistics::Sample& sample) {
+          return MakeFrameStatisticsText(sample, font_path);
+        });
+    SkPaint paint;
+    paint.setColor(SK_ColorGRAY);
+    context.leaf_nodes_canvas->drawTextBlob(text, x + padding,
+                                            y + padding + kFontSize, paint);
+  }
 }
 
 }  // namespace flutter
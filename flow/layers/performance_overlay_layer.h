@@ -19,6 +19,10 @@ const int kDisplayRasterizerStatistics = 1 << 0;
 const int kVisualizeRasterizerStatistics = 1 << 1;
 const int kDisplayEngineStatistics = 1 << 2;
 const int kVisualizeEngineStatistics = 1 << 3;
+// Shows the raster cache hit rate and bytes, the GPU resource usage, the
+// objects pending in the unref queue, the frames in flight, the save layers
+// per frame and the fraction of the frame that is repainted.
+const int kDisplayFrameStatistics = 1 << 4;
 
 class PerformanceOverlayLayer : public Layer {
  public:
@@ -26,6 +30,10 @@ class PerformanceOverlayLayer : public Layer {
                                               const std::string& label_prefix,
                                               const std::string& font_path);
 
+  static sk_sp<SkTextBlob> MakeFrameStatisticsText(
+      const FrameStatistics::Sample& sample,
+      const std::string& font_path);
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
   bool IsReplacing(DiffContext* context, const Layer* layer) const override {
@@ -176,6 +176,33 @@ TEST_F(PerformanceOverlayLayerTest, SimpleRasterizerStatistics) {
                                             text_position}}}));
 }
 
+TEST_F(PerformanceOverlayLayerTest, FrameStatistics) {
+  const SkRect layer_bounds = SkRect::MakeLTRB(0.0f, 0.0f, 64.0f, 64.0f);
+  auto layer =
+      std::make_shared<PerformanceOverlayLayer>(kDisplayFrameStatistics);
+  layer->set_paint_bounds(layer_bounds);
+  layer->Preroll(preroll_context(), SkMatrix());
+
+  // Nothing to show without statistics.
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(), std::vector<MockCanvas::DrawCall>());
+
+  FrameStatistics statistics;
+  paint_context().frame_statistics = &statistics;
+  layer->Paint(paint_context());
+  auto overlay_text = PerformanceOverlayLayer::MakeFrameStatisticsText(
+      statistics.last_sample(), "");
+  SkPaint text_paint;
+  text_paint.setColor(SK_ColorGRAY);
+  SkPoint text_position = SkPoint::Make(16.0f, 31.0f);
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawTextData{
+                       overlay_text->serialize(SkSerialProcs{}), text_paint,
+                       text_position}}}));
+  paint_context().frame_statistics = nullptr;
+}
+
 TEST(PerformanceOverlayLayerDefault, Gold) {
   TestPerformanceOverlayLayerGold(60);
 }
@@ -72,6 +72,37 @@ void PhysicalShapeLayer::Preroll(PrerollContext* context,
     // children to it so we don't need to join the child paint bounds.
     set_paint_bounds(ComputeShadowBounds(path_.getBounds(), elevation_,
                                          context->frame_device_pixel_ratio));
+    PrepareShadowRasterCache(context, matrix);
+  }
+}
+
+void PhysicalShapeLayer::PrepareShadowRasterCache(PrerollContext* context,
+                                                  const SkMatrix& matrix) {
+  auto* cache = context->raster_cache;
+  if (!cache) {
+    return;
+  }
+  ShadowRasterCacheKey key(path_, shadow_color_, elevation_,
+                           SkColorGetA(color_) != 0xff,
+                           context->frame_device_pixel_ratio, matrix);
+  auto prepare = [cache, key, bounds = paint_bounds()](
+                     GrDirectContext* gr_context,
+                     SkColorSpace* dst_color_space) {
+    cache->PrepareShadow(
+        gr_context, key, bounds, dst_color_space,
+        [&key](SkCanvas* canvas, const SkPoint& device_offset) {
+          DrawShadow(canvas, key.path(), key.color(), key.elevation(),
+                     key.transparent_occluder(), key.dpr(), device_offset);
+        });
+  };
+  if (context->deferred_operations) {
+    context->deferred_operations->push_back(
+        [prepare, gr_context = context->gr_context,
+         dst_color_space = context->dst_color_space](PrerollContext*) {
+          prepare(gr_context, dst_color_space);
+        });
+  } else {
+    prepare(context->gr_context, context->dst_color_space);
   }
 }
 
@@ -80,8 +111,19 @@ void PhysicalShapeLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   if (elevation_ != 0) {
-    DrawShadow(context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
-               SkColorGetA(color_) != 0xff, context.frame_device_pixel_ratio);
+    const bool transparent_occluder = SkColorGetA(color_) != 0xff;
+    // Shadows that were drawn the same way in enough frames are drawn from an
+    // image instead of being tessellated again.
+    if (!context.raster_cache ||
+        !context.raster_cache->DrawShadow(
+            ShadowRasterCacheKey(path_, shadow_color_, elevation_,
+                                 transparent_occluder,
+                                 context.frame_device_pixel_ratio,
+                                 context.leaf_nodes_canvas->getTotalMatrix()),
+            *context.leaf_nodes_canvas)) {
+      DrawShadow(context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
+                 transparent_occluder, context.frame_device_pixel_ratio);
+    }
   }
 
   // Call drawPath without clip if possible for better performance.
@@ -176,7 +218,8 @@ void PhysicalShapeLayer::DrawShadow(SkCanvas* canvas,
                                     SkColor color,
                                     float elevation,
                                     bool transparentOccluder,
-                                    SkScalar dpr) {
+                                    SkScalar dpr,
+                                    const SkPoint& light_offset) {
   const SkScalar kAmbientAlpha = 0.039f;
   const SkScalar kSpotAlpha = 0.25f;
 
@@ -184,8 +227,8 @@ void PhysicalShapeLayer::DrawShadow(SkCanvas* canvas,
                             ? SkShadowFlags::kTransparentOccluder_ShadowFlag
                             : SkShadowFlags::kNone_ShadowFlag;
   const SkRect& bounds = path.getBounds();
-  SkScalar shadow_x = (bounds.left() + bounds.right()) / 2;
-  SkScalar shadow_y = bounds.top() - 600.0f;
+  SkScalar shadow_x = (bounds.left() + bounds.right()) / 2 + light_offset.fX;
+  SkScalar shadow_y = bounds.top() - 600.0f + light_offset.fY;
   SkColor inAmbient = SkColorSetA(color, kAmbientAlpha * SkColorGetA(color));
   SkColor inSpot = SkColorSetA(color, kSpotAlpha * SkColorGetA(color));
   SkColor ambientColor, spotColor;
@@ -20,12 +20,16 @@ class PhysicalShapeLayer : public ContainerLayer {
   static SkRect ComputeShadowBounds(const SkRect& bounds,
                                     float elevation,
                                     float pixel_ratio);
+  // |light_offset| moves the light, which is positioned in device space, to
+  // draw the shadow into a canvas whose device space is offset from the one
+  // the shadow is displayed in.
   static void DrawShadow(SkCanvas* canvas,
                          const SkPath& path,
                          SkColor color,
                          float elevation,
                          bool transparentOccluder,
-                         SkScalar dpr);
+                         SkScalar dpr,
+                         const SkPoint& light_offset = SkPoint::Make(0, 0));
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
@@ -49,6 +53,9 @@ class PhysicalShapeLayer : public ContainerLayer {
   float elevation_ = 0.0f;
   SkPath path_;
   Clip clip_behavior_;
+
+  void PrepareShadowRasterCache(PrerollContext* context,
+                                const SkMatrix& matrix);
 };
 
 }  // namespace flutter
@@ -4,20 +4,227 @@
 
 #include "flutter/flow/layers/picture_layer.h"
 
+#include "flutter/flow/picture_hash.h"
 #include "flutter/fml/logging.h"
-#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+#include "third_party/skia/include/utils/SkPaintFilterCanvas.h"
 
 namespace flutter {
 
+namespace {
+
+// Applies an opacity to the paint of every operation drawn through it.
+class OpacityFilterCanvas : public SkPaintFilterCanvas {
+ public:
+  OpacityFilterCanvas(SkCanvas* canvas, SkScalar opacity)
+      : SkPaintFilterCanvas(canvas), opacity_(opacity) {}
+
+ protected:
+  bool onFilter(SkPaint& paint) const override {
+    paint.setAlphaf(paint.getAlphaf() * opacity_);
+    return true;
+  }
+
+ private:
+  SkScalar opacity_;
+};
+
+// Checks whether the operations drawn into it are a single one that draws
+// every pixel at most once, with a paint that an opacity can be folded into.
+// Such an operation looks the same with the opacity applied to its paint as
+// when drawn into a layer with that opacity.
+//
+// Only the operations overridden here as compatible can pass. Text blobs
+// with overlapping glyphs, vertices, atlases, points, shadows and nested
+// pictures all blend some pixels more than once, and go to the device, which
+// draws nothing, or are rejected explicitly.
+class OpacityCompatibilityCanvas : public SkNoDrawCanvas {
+ public:
+  explicit OpacityCompatibilityCanvas(const SkIRect& bounds)
+      : SkNoDrawCanvas(bounds) {}
+
+  bool IsCompatible() const { return compatible_draws_ == 1 && !rejected_; }
+
+ protected:
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override {
+    rejected_ = true;
+    return kNoLayer_SaveLayerStrategy;
+  }
+
+  void onDrawPaint(const SkPaint& paint) override { Check(&paint); }
+
+  void onDrawRect(const SkRect&, const SkPaint& paint) override {
+    Check(&paint);
+  }
+
+  void onDrawRRect(const SkRRect&, const SkPaint& paint) override {
+    Check(&paint);
+  }
+
+  void onDrawDRRect(const SkRRect&,
+                    const SkRRect&,
+                    const SkPaint& paint) override {
+    Check(&paint);
+  }
+
+  void onDrawOval(const SkRect&, const SkPaint& paint) override {
+    Check(&paint);
+  }
+
+  void onDrawArc(const SkRect&,
+                 SkScalar,
+                 SkScalar,
+                 bool,
+                 const SkPaint& paint) override {
+    Check(&paint);
+  }
+
+  void onDrawPath(const SkPath&, const SkPaint& paint) override {
+    Check(&paint);
+  }
+
+  void onDrawRegion(const SkRegion&, const SkPaint& paint) override {
+    Check(&paint);
+  }
+
+  void onDrawImage2(const SkImage*,
+                    SkScalar,
+                    SkScalar,
+                    const SkSamplingOptions&,
+                    const SkPaint* paint) override {
+    Check(paint);
+  }
+
+  void onDrawImageRect2(const SkImage*,
+                        const SkRect&,
+                        const SkRect&,
+                        const SkSamplingOptions&,
+                        const SkPaint* paint,
+                        SrcRectConstraint) override {
+    Check(paint);
+  }
+
+  void onDrawImageLattice2(const SkImage*,
+                           const Lattice&,
+                           const SkRect&,
+                           SkFilterMode,
+                           const SkPaint* paint) override {
+    Check(paint);
+  }
+
+  void onDrawTextBlob(const SkTextBlob*,
+                      SkScalar,
+                      SkScalar,
+                      const SkPaint&) override {
+    rejected_ = true;
+  }
+
+  void onDrawPicture(const SkPicture*,
+                     const SkMatrix*,
+                     const SkPaint*) override {
+    rejected_ = true;
+  }
+
+  void onDrawDrawable(SkDrawable*, const SkMatrix*) override {
+    rejected_ = true;
+  }
+
+ private:
+  int compatible_draws_ = 0;
+  bool rejected_ = false;
+
+  // Blend modes other than source over, and filters, do not commute with
+  // the opacity.
+  void Check(const SkPaint* paint) {
+    if (paint && (paint->getBlendMode() != SkBlendMode::kSrcOver ||
+                  paint->getColorFilter() || paint->getImageFilter())) {
+      rejected_ = true;
+      return;
+    }
+    compatible_draws_++;
+  }
+};
+
+// Prepares the raster cache entry of |picture|, which is either an SkPicture
+// or a DisplayList, or defers it if the context defers its operations.
+template <typename Picture>
+bool PrepareRasterCache(PrerollContext* context,
+                        RasterCache* cache,
+                        Picture* picture,
+                        const SkMatrix& ctm,
+                        bool is_complex,
+                        bool will_change) {
+  if (context->deferred_operations) {
+    context->deferred_operations->push_back(
+        [cache, gr_context = context->gr_context, picture = sk_ref_sp(picture),
+         ctm, dst_color_space = context->dst_color_space, is_complex,
+         will_change](PrerollContext*) {
+          cache->Prepare(gr_context, picture.get(), ctm, dst_color_space,
+                         is_complex, will_change);
+        });
+    return false;
+  }
+  return cache->Prepare(context->gr_context, picture, ctm,
+                        context->dst_color_space, is_complex, will_change);
+}
+
+}  // anonymous namespace
+
 PictureLayer::PictureLayer(const SkPoint& offset,
                            SkiaGPUObject<SkPicture> picture,
                            bool is_complex,
-                           bool will_change)
+                           bool will_change,
+                           uint64_t content_hash)
     : offset_(offset),
       picture_(std::move(picture)),
       is_complex_(is_complex),
+      will_change_(will_change),
+      content_hash_(content_hash) {}
+
+PictureLayer::PictureLayer(const SkPoint& offset,
+                           SkiaGPUObject<DisplayList> display_list,
+                           bool is_complex,
+                           bool will_change)
+    : offset_(offset),
+      display_list_(std::move(display_list)),
+      is_complex_(is_complex),
       will_change_(will_change) {}
 
+SkRect PictureLayer::ContentBounds() const {
+  return display_list() ? display_list()->bounds() : picture()->cullRect();
+}
+
+int PictureLayer::OpCount() const {
+  return display_list() ? display_list()->op_count()
+                        : picture()->approximateOpCount();
+}
+
+void PictureLayer::Playback(SkCanvas* canvas) const {
+  if (display_list()) {
+    display_list()->RenderTo(canvas);
+  } else {
+    picture()->playback(canvas);
+  }
+}
+
+bool PictureLayer::CanApplyOpacityToOperations() const {
+  if (!can_apply_opacity_to_operations_.has_value()) {
+    // Only a single operation can qualify, so pictures with more are not
+    // played back.
+    bool can_apply = OpCount() == 1;
+    if (can_apply) {
+      OpacityCompatibilityCanvas canvas(ContentBounds().roundOut());
+      Playback(&canvas);
+      can_apply = canvas.IsCompatible();
+    }
+    can_apply_opacity_to_operations_ = can_apply;
+  }
+  return can_apply_opacity_to_operations_.value();
+}
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
 bool PictureLayer::IsReplacing(DiffContext* context, const Layer* layer) const {
@@ -42,13 +249,35 @@ void PictureLayer::Diff(DiffContext* context, const Layer* old_layer) {
 #endif
   }
   context->PushTransform(SkMatrix::Translate(offset_.x(), offset_.y()));
-  context->AddLayerBounds(picture()->cullRect());
+  context->AddLayerBounds(ContentBounds());
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
 bool PictureLayer::Compare(DiffContext::Statistics& statistics,
                            const PictureLayer* l1,
                            const PictureLayer* l2) {
+  if (l1->display_list() || l2->display_list()) {
+    const DisplayList* display_list_1 = l1->display_list();
+    const DisplayList* display_list_2 = l2->display_list();
+    if (display_list_1 == display_list_2) {
+      statistics.AddSameInstancePicture();
+      return true;
+    }
+    if (!display_list_1 || !display_list_2 ||
+        display_list_1->op_count() != display_list_2->op_count() ||
+        display_list_1->bounds() != display_list_2->bounds()) {
+      statistics.AddNewPicture();
+      return false;
+    }
+    statistics.AddDeepComparePicture();
+    if (display_list_1->Equals(*display_list_2)) {
+      statistics.AddDifferentInstanceButEqualPicture();
+      return true;
+    }
+    statistics.AddNewPicture();
+    return false;
+  }
+
   const auto& pic1 = l1->picture_.get();
   const auto& pic2 = l2->picture_.get();
   if (pic1.get() == pic2.get()) {
@@ -62,19 +291,9 @@ bool PictureLayer::Compare(DiffContext::Statistics& statistics,
     return false;
   }
 
-  if (op_cnt_1 > 10) {
-    statistics.AddPictureTooComplexToCompare();
-    return false;
-  }
-
   statistics.AddDeepComparePicture();
 
-  // TODO(knopp) we don't actually need the data; this could be done without
-  // allocations by implementing stream that calculates SHA hash and
-  // comparing those hashes
-  auto d1 = l1->SerializedPicture();
-  auto d2 = l2->SerializedPicture();
-  auto res = d1->equals(d2.get());
+  auto res = l1->ContentHash() == l2->ContentHash();
   if (res) {
     statistics.AddDifferentInstanceButEqualPicture();
   } else {
@@ -83,25 +302,13 @@ bool PictureLayer::Compare(DiffContext::Statistics& statistics,
   return res;
 }
 
-sk_sp<SkData> PictureLayer::SerializedPicture() const {
-  if (!cached_serialized_picture_) {
-    SkSerialProcs procs = {
-        nullptr,
-        nullptr,
-        [](SkImage* i, void* ctx) {
-          auto id = i->uniqueID();
-          return SkData::MakeWithCopy(&id, sizeof(id));
-        },
-        nullptr,
-        [](SkTypeface* tf, void* ctx) {
-          auto id = tf->uniqueID();
-          return SkData::MakeWithCopy(&id, sizeof(id));
-        },
-        nullptr,
-    };
-    cached_serialized_picture_ = picture_.get()->serialize(&procs);
-  }
-  return cached_serialized_picture_;
+uint64_t PictureLayer::ContentHash() const {
+  // Pictures recorded by the framework come with their hash, so it is only
+  // computed here for layers that were created without one.
+  if (content_hash_ == 0) {
+    content_hash_ = ComputePictureContentHash(*picture());
+  }
+  return content_hash_;
 }
 
 #endif  // FLUTTER_ENABLE_DIFF_CONTEXT
@@ -114,6 +321,8 @@ void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 #endif
 
   SkPicture* sk_picture = picture();
+  DisplayList* display_list = this->display_list();
+  bool can_inherit_opacity = CanApplyOpacityToOperations();
 
   if (auto* cache = context->raster_cache) {
     TRACE_EVENT0("flutter", "PictureLayer::RasterCache (Preroll)");
@@ -123,17 +332,25 @@ void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     ctm = RasterCache::GetIntegralTransCTM(ctm);
 #endif
-    cache->Prepare(context->gr_context, sk_picture, ctm,
-                   context->dst_color_space, is_complex_, will_change_);
+    const bool prepared =
+        display_list ? PrepareRasterCache(context, cache, display_list, ctm,
+                                          is_complex_, will_change_)
+                     : PrepareRasterCache(context, cache, sk_picture, ctm,
+                                          is_complex_, will_change_);
+    if (prepared) {
+      // The cached image is drawn with the inherited opacity.
+      can_inherit_opacity = true;
+    }
   }
 
-  SkRect bounds = sk_picture->cullRect().makeOffset(offset_.x(), offset_.y());
+  SkRect bounds = ContentBounds().makeOffset(offset_.x(), offset_.y());
   set_paint_bounds(bounds);
+  set_layer_can_inherit_opacity(can_inherit_opacity);
 }
 
 void PictureLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "PictureLayer::Paint");
-  FML_DCHECK(picture_.get());
+  FML_DCHECK(picture_.get() || display_list_.get());
   FML_DCHECK(needs_painting(context));
 
   SkAutoCanvasRestore save(context.leaf_nodes_canvas, true);
@@ -143,12 +360,64 @@ void PictureLayer::Paint(PaintContext& context) const {
       context.leaf_nodes_canvas->getTotalMatrix()));
 #endif
 
-  if (context.raster_cache &&
-      context.raster_cache->Draw(*picture(), *context.leaf_nodes_canvas)) {
+  SkPaint paint;
+  SkPaint* cache_paint = nullptr;
+  if (context.inherited_opacity < SK_Scalar1) {
+    paint.setAlphaf(context.inherited_opacity);
+    cache_paint = &paint;
+  }
+
+  const bool cache_hit =
+      context.raster_cache &&
+      (display_list() ? context.raster_cache->Draw(
+                            *display_list(), *context.leaf_nodes_canvas,
+                            cache_paint)
+                      : context.raster_cache->Draw(
+                            *picture(), *context.leaf_nodes_canvas,
+                            cache_paint));
+  if (cache_hit) {
     TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
     return;
   }
-  picture()->playback(context.leaf_nodes_canvas);
+
+  // Only drawing into a surface is timed, as recording into a picture, e.g.
+  // when the frame is painted in tiles, says little about the cost of
+  // drawing the picture.
+  const bool record_draw_time =
+      context.raster_cache && context.leaf_nodes_canvas->getSurface();
+  const fml::TimePoint start =
+      record_draw_time ? fml::TimePoint::Now() : fml::TimePoint();
+  DrawPicture(context, paint);
+  if (record_draw_time) {
+    const SkMatrix& matrix = context.leaf_nodes_canvas->getTotalMatrix();
+    const fml::TimeDelta draw_time = fml::TimePoint::Now() - start;
+    if (display_list()) {
+      context.raster_cache->RecordPictureDrawTime(*display_list(), matrix,
+                                                  draw_time);
+    } else {
+      context.raster_cache->RecordPictureDrawTime(*picture(), matrix,
+                                                  draw_time);
+    }
+  }
+}
+
+void PictureLayer::DrawPicture(PaintContext& context,
+                               const SkPaint& paint) const {
+  if (context.inherited_opacity < SK_Scalar1) {
+    if (CanApplyOpacityToOperations()) {
+      OpacityFilterCanvas canvas(context.leaf_nodes_canvas,
+                                 context.inherited_opacity);
+      Playback(&canvas);
+      return;
+    }
+    // Preroll expected the picture to be drawn from the raster cache.
+    SkAutoCanvasRestore save_layer(context.leaf_nodes_canvas, false);
+    context.leaf_nodes_canvas->saveLayer(ContentBounds(), &paint);
+    Playback(context.leaf_nodes_canvas);
+    return;
+  }
+
+  Playback(context.leaf_nodes_canvas);
 }
 
 }  // namespace flutter
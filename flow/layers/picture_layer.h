@@ -6,7 +6,9 @@
 #define FLUTTER_FLOW_LAYERS_PICTURE_LAYER_H_
 
 #include <memory>
+#include <optional>
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/skia_gpu_object.h"
@@ -15,13 +17,27 @@ namespace flutter {
 
 class PictureLayer : public Layer {
  public:
+  // |content_hash| is the ComputePictureContentHash of the picture, or 0 if
+  // it should be computed when the layer is first diffed.
   PictureLayer(const SkPoint& offset,
                SkiaGPUObject<SkPicture> picture,
                bool is_complex,
+               bool will_change,
+               uint64_t content_hash = 0);
+
+  // Draws a display list instead of a picture. Display lists are compared
+  // with DisplayList::Equals when they are diffed, so they need no hash.
+  PictureLayer(const SkPoint& offset,
+               SkiaGPUObject<DisplayList> display_list,
+               bool is_complex,
                bool will_change);
 
+  // The picture of the layer, or nullptr if it draws a display list.
   SkPicture* picture() const { return picture_.get().get(); }
 
+  // The display list of the layer, or nullptr if it draws a picture.
+  DisplayList* display_list() const { return display_list_.get().get(); }
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
   bool IsReplacing(DiffContext* context, const Layer* layer) const override;
@@ -41,13 +57,30 @@ class PictureLayer : public Layer {
   // Even though pictures themselves are not GPU resources, they may reference
   // images that have a reference to a GPU resource.
   SkiaGPUObject<SkPicture> picture_;
+  SkiaGPUObject<DisplayList> display_list_;
   bool is_complex_ = false;
   bool will_change_ = false;
+  mutable uint64_t content_hash_ = 0;
+  mutable std::optional<bool> can_apply_opacity_to_operations_;
+
+  // The cull rect of the picture or the bounds of the display list.
+  SkRect ContentBounds() const;
+
+  // The op count of the picture or the display list.
+  int OpCount() const;
+
+  // Draws the picture or the display list into |canvas|.
+  void Playback(SkCanvas* canvas) const;
+
+  // Whether applying an opacity to the paint of each operation gives the same
+  // result as drawing them into a layer with that opacity.
+  bool CanApplyOpacityToOperations() const;
+
+  void DrawPicture(PaintContext& context, const SkPaint& paint) const;
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
-  sk_sp<SkData> SerializedPicture() const;
-  mutable sk_sp<SkData> cached_serialized_picture_;
+  uint64_t ContentHash() const;
   static bool Compare(DiffContext::Statistics& statistics,
                       const PictureLayer* l1,
                       const PictureLayer* l2);
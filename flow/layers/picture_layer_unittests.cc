@@ -6,11 +6,15 @@
 
 #include "flutter/flow/layers/picture_layer.h"
 
+#include <functional>
+
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/skia_gpu_object_layer_test.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
 #include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
 #include "flutter/flow/raster_cache.h"
@@ -99,6 +103,50 @@ TEST_F(PictureLayerTest, SimplePicture) {
   EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
 }
 
+static bool PictureInheritsOpacity(
+    SkiaGPUObjectLayerTest* test,
+    const std::function<void(SkCanvas* canvas)>& draw) {
+  SkPictureRecorder recorder;
+  draw(recorder.beginRecording(SkRect::MakeWH(100, 100)));
+  auto layer = std::make_shared<PictureLayer>(
+      SkPoint::Make(0, 0),
+      SkiaGPUObject(recorder.finishRecordingAsPicture(), test->unref_queue()),
+      false, false);
+  layer->Preroll(test->preroll_context(), SkMatrix());
+  return layer->layer_can_inherit_opacity();
+}
+
+TEST_F(PictureLayerTest, OnlySimpleOperationsInheritOpacity) {
+  SkPaint paint;
+  EXPECT_TRUE(PictureInheritsOpacity(this, [&paint](SkCanvas* canvas) {
+    canvas->drawRect(SkRect::MakeWH(10, 10), paint);
+  }));
+  EXPECT_FALSE(PictureInheritsOpacity(this, [&paint](SkCanvas* canvas) {
+    canvas->drawRect(SkRect::MakeWH(10, 10), paint);
+    canvas->drawRect(SkRect::MakeXYWH(5, 5, 10, 10), paint);
+  }));
+
+  // Points can overlap each other.
+  EXPECT_FALSE(PictureInheritsOpacity(this, [&paint](SkCanvas* canvas) {
+    const SkPoint points[] = {{10, 10}, {10, 10}};
+    canvas->drawPoints(SkCanvas::kPoints_PointMode, 2, points, paint);
+  }));
+
+  SkPaint src_paint;
+  src_paint.setBlendMode(SkBlendMode::kSrc);
+  EXPECT_FALSE(PictureInheritsOpacity(this, [&src_paint](SkCanvas* canvas) {
+    canvas->drawRect(SkRect::MakeWH(10, 10), src_paint);
+  }));
+
+  SkPaint filter_paint;
+  filter_paint.setColorFilter(
+      SkColorFilters::Blend(SK_ColorRED, SkBlendMode::kDstOver));
+  EXPECT_FALSE(
+      PictureInheritsOpacity(this, [&filter_paint](SkCanvas* canvas) {
+        canvas->drawRect(SkRect::MakeWH(10, 10), filter_paint);
+      }));
+}
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
 using PictureLayerDiffTest = DiffContextTest;
@@ -155,6 +203,34 @@ TEST_F(PictureLayerDiffTest, PictureCompare) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(20, 20, 70, 70));
 }
 
+TEST_F(PictureLayerDiffTest, ComplexPictureCompare) {
+  auto create_picture = [](uint32_t color) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+    for (int i = 0; i < 100; i++) {
+      canvas->drawRect(SkRect::MakeXYWH(i, 0, 1, 100),
+                       SkPaint(SkColor4f::FromBytes_RGBA(color + i)));
+    }
+    return recorder.finishRecordingAsPicture();
+  };
+
+  MockLayerTree tree1;
+  tree1.root()->Add(CreatePictureLayer(create_picture(1)));
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+
+  // Pictures with many operations are compared without being repainted.
+  MockLayerTree tree2;
+  tree2.root()->Add(CreatePictureLayer(create_picture(1)));
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+
+  MockLayerTree tree3;
+  tree3.root()->Add(CreatePictureLayer(create_picture(2)));
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+}
+
 #endif
 
 }  // namespace testing
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/platform_view_layer.h"
 
+#include "flutter/fml/make_copyable.h"
+
 namespace flutter {
 
 PlatformViewLayer::PlatformViewLayer(const SkPoint& offset,
@@ -31,6 +33,17 @@ void PlatformViewLayer::Preroll(PrerollContext* context,
   std::unique_ptr<EmbeddedViewParams> params =
       std::make_unique<EmbeddedViewParams>(matrix, size_,
                                            context->mutators_stack);
+  if (context->deferred_operations) {
+    // The embedder expects its platform views in paint order on the raster
+    // thread.
+    context->deferred_operations->push_back(fml::MakeCopyable(
+        [view_id = view_id_,
+         params = std::move(params)](PrerollContext* merge_context) mutable {
+          merge_context->view_embedder->PrerollCompositeEmbeddedView(
+              view_id, std::move(params));
+        }));
+    return;
+  }
   context->view_embedder->PrerollCompositeEmbeddedView(view_id_,
                                                        std::move(params));
 }
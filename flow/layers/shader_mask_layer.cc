@@ -9,7 +9,10 @@ namespace flutter {
 ShaderMaskLayer::ShaderMaskLayer(sk_sp<SkShader> shader,
                                  const SkRect& mask_rect,
                                  SkBlendMode blend_mode)
-    : shader_(shader), mask_rect_(mask_rect), blend_mode_(blend_mode) {}
+    : shader_(shader),
+      mask_rect_(mask_rect),
+      blend_mode_(blend_mode),
+      output_cache_(unique_id()) {}
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
@@ -23,9 +26,17 @@ void ShaderMaskLayer::Diff(DiffContext* context, const Layer* old_layer) {
       context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(old_layer));
     }
   }
+  // The output masked in the previous frame can only be reused if the mask
+  // and the transform did not change.
+  const LayerOutputCache* prev_output_cache =
+      context->IsSubtreeDirty() ? nullptr : &prev->output_cache_;
 
   DiffChildren(context, prev);
 
+  // The mask applies to every pixel on its own, so the output only changed
+  // where the children did.
+  output_cache_.Diff(context, prev_output_cache, context->GetSubtreeDamage());
+
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
@@ -39,12 +50,25 @@ void ShaderMaskLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The mask applies to the children as a whole.
+  set_layer_can_inherit_opacity(false);
+  output_cache_.Preroll(context);
 }
 
 void ShaderMaskLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ShaderMaskLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
+  if (output_cache_.Paint(context, paint_bounds(),
+                          [this](PaintContext& output_context) {
+                            PaintMasked(output_context);
+                          })) {
+    return;
+  }
+  PaintMasked(context);
+}
+
+void ShaderMaskLayer::PaintMasked(PaintContext& context) const {
   Layer::AutoSaveLayer save =
       Layer::AutoSaveLayer::Create(context, paint_bounds(), nullptr);
   PaintChildren(context);
@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_LAYERS_SHADER_MASK_LAYER_H_
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_output_cache.h"
 #include "third_party/skia/include/core/SkShader.h"
 
 namespace flutter {
@@ -20,6 +21,13 @@ class ShaderMaskLayer : public ContainerLayer {
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  // The part of the masked output that the last Diff found changed, in screen
+  // coordinates, or nullopt if the output masked in an earlier frame can not
+  // be reused.
+  std::optional<SkRect> output_damage() const {
+    return output_cache_.damage();
+  }
+
 #endif  // FLUTTER_ENABLE_DIFF_CONTEXT
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
@@ -30,6 +38,10 @@ class ShaderMaskLayer : public ContainerLayer {
   sk_sp<SkShader> shader_;
   SkRect mask_rect_;
   SkBlendMode blend_mode_;
+  LayerOutputCache output_cache_;
+
+  // Paints the masked children.
+  void PaintMasked(PaintContext& context) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ShaderMaskLayer);
 };
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/shader_mask_layer.h"
 
+#include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
@@ -275,5 +276,58 @@ TEST_F(ShaderMaskLayerTest, Readback) {
   EXPECT_FALSE(preroll_context()->surface_needs_readback);
 }
 
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+
+using ShaderMaskLayerDiffTest = DiffContextTest;
+
+TEST_F(ShaderMaskLayerDiffTest, OutputDamageIsDamageOfChildren) {
+  const SkRect mask_rect = SkRect::MakeLTRB(0, 0, 300, 300);
+  auto shader = SkPerlinNoiseShader::MakeFractalNoise(1.0f, 1.0f, 1, 1.0f);
+  const SkPath still = SkPath().addRect(SkRect::MakeLTRB(100, 100, 110, 110));
+  const SkPath moving = SkPath().addRect(SkRect::MakeLTRB(150, 150, 160, 160));
+
+  std::shared_ptr<ShaderMaskLayer> old_mask_layer;
+  auto add_mask_layer = [&](MockLayerTree& tree,
+                            const sk_sp<SkShader>& layer_shader,
+                            const SkPath& moving_path) {
+    auto mask_layer = std::make_shared<ShaderMaskLayer>(
+        layer_shader, mask_rect, SkBlendMode::kSrc);
+    if (old_mask_layer) {
+      mask_layer->AssignOldLayer(old_mask_layer.get());
+    }
+    mask_layer->Add(std::make_shared<MockLayer>(still));
+    mask_layer->Add(std::make_shared<MockLayer>(moving_path));
+    tree.root()->Add(mask_layer);
+    old_mask_layer = mask_layer;
+    return mask_layer;
+  };
+
+  MockLayerTree l1(SkISize::Make(300, 300));
+  auto mask_layer1 = add_mask_layer(l1, shader, moving);
+  DiffLayerTree(l1, MockLayerTree(SkISize::Make(300, 300)));
+  EXPECT_FALSE(mask_layer1->output_damage().has_value());
+
+  MockLayerTree l2(SkISize::Make(300, 300));
+  auto mask_layer2 = add_mask_layer(l2, shader, moving);
+  DiffLayerTree(l2, l1);
+  EXPECT_EQ(mask_layer2->output_damage(), SkRect::MakeEmpty());
+
+  MockLayerTree l3(SkISize::Make(300, 300));
+  auto mask_layer3 = add_mask_layer(l3, shader, moving.makeOffset(5, 5));
+  DiffLayerTree(l3, l2);
+  EXPECT_EQ(mask_layer3->output_damage(),
+            SkRect::MakeLTRB(150, 150, 165, 165));
+
+  // The whole output changes with the mask.
+  MockLayerTree l4(SkISize::Make(300, 300));
+  auto mask_layer4 = add_mask_layer(
+      l4, SkPerlinNoiseShader::MakeFractalNoise(2.0f, 2.0f, 1, 1.0f),
+      moving.makeOffset(5, 5));
+  DiffLayerTree(l4, l3);
+  EXPECT_FALSE(mask_layer4->output_damage().has_value());
+}
+
+#endif
+
 }  // namespace testing
 }  // namespace flutter
@@ -36,11 +36,11 @@ TEST(MutatorsStack, CopyAndUpdateTheCopy) {
   ASSERT_TRUE(copy.is_empty());
   ASSERT_TRUE(!stack.is_empty());
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rrect);
-  ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::clip_rrect);
+  ASSERT_TRUE(iter->GetRRect() == rrect);
   ++iter;
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rect);
-  ASSERT_TRUE(iter->get()->GetRect() == rect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::clip_rect);
+  ASSERT_TRUE(iter->GetRect() == rect);
 }
 
 TEST(MutatorsStack, PushClipRect) {
@@ -48,8 +48,8 @@ TEST(MutatorsStack, PushClipRect) {
   auto rect = SkRect::MakeEmpty();
   stack.PushClipRect(rect);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rect);
-  ASSERT_TRUE(iter->get()->GetRect() == rect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::clip_rect);
+  ASSERT_TRUE(iter->GetRect() == rect);
 }
 
 TEST(MutatorsStack, PushClipRRect) {
@@ -57,8 +57,8 @@ TEST(MutatorsStack, PushClipRRect) {
   auto rrect = SkRRect::MakeEmpty();
   stack.PushClipRRect(rrect);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rrect);
-  ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::clip_rrect);
+  ASSERT_TRUE(iter->GetRRect() == rrect);
 }
 
 TEST(MutatorsStack, PushClipPath) {
@@ -66,8 +66,8 @@ TEST(MutatorsStack, PushClipPath) {
   SkPath path;
   stack.PushClipPath(path);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == flutter::MutatorType::clip_path);
-  ASSERT_TRUE(iter->get()->GetPath() == path);
+  ASSERT_TRUE(iter->GetType() == flutter::MutatorType::clip_path);
+  ASSERT_TRUE(iter->GetPath() == path);
 }
 
 TEST(MutatorsStack, PushTransform) {
@@ -76,8 +76,8 @@ TEST(MutatorsStack, PushTransform) {
   matrix.setIdentity();
   stack.PushTransform(matrix);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::transform);
-  ASSERT_TRUE(iter->get()->GetMatrix() == matrix);
+  ASSERT_TRUE(iter->GetType() == MutatorType::transform);
+  ASSERT_TRUE(iter->GetMatrix() == matrix);
 }
 
 TEST(MutatorsStack, PushOpacity) {
@@ -85,8 +85,8 @@ TEST(MutatorsStack, PushOpacity) {
   int alpha = 240;
   stack.PushOpacity(alpha);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::opacity);
-  ASSERT_TRUE(iter->get()->GetAlpha() == 240);
+  ASSERT_TRUE(iter->GetType() == MutatorType::opacity);
+  ASSERT_TRUE(iter->GetAlpha() == 240);
 }
 
 TEST(MutatorsStack, Pop) {
@@ -99,6 +99,70 @@ TEST(MutatorsStack, Pop) {
   ASSERT_TRUE(iter == stack.Top());
 }
 
+TEST(MutatorsStack, PushAfterPopOfCopy) {
+  MutatorsStack stack;
+  auto rect = SkRect::MakeWH(10, 10);
+  stack.PushClipRect(rect);
+  MutatorsStack copy = stack;
+  stack.Pop();
+  SkMatrix matrix = SkMatrix::Scale(2, 2);
+  stack.PushTransform(matrix);
+  ASSERT_TRUE(stack.Bottom()->GetType() == MutatorType::transform);
+  ASSERT_TRUE(copy.Bottom()->GetType() == MutatorType::clip_rect);
+  ASSERT_TRUE(copy.Bottom()->GetRect() == rect);
+}
+
+TEST(MutatorsStack, DeepStack) {
+  MutatorsStack stack;
+  const int depth = MutatorsStack::kInlineCapacity * 3;
+  for (int i = 0; i < depth; i++) {
+    stack.PushOpacity(i);
+  }
+  ASSERT_EQ(stack.size(), static_cast<size_t>(depth));
+  int alpha = 0;
+  for (auto iter = stack.Begin(); iter != stack.End(); ++iter) {
+    ASSERT_EQ(iter->GetAlpha(), alpha++);
+  }
+  for (int i = depth - 1; i >= 0; i--) {
+    ASSERT_EQ(stack.Bottom()->GetAlpha(), i);
+    stack.Pop();
+  }
+  ASSERT_TRUE(stack.is_empty());
+}
+
+TEST(MutatorsStack, CopyOfDeepStackIsNotChangedByTheStack) {
+  MutatorsStack stack;
+  const int depth = MutatorsStack::kInlineCapacity + 2;
+  for (int i = 0; i < depth; i++) {
+    stack.PushOpacity(i);
+  }
+  MutatorsStack copy = stack;
+  ASSERT_TRUE(copy == stack);
+  stack.PushOpacity(100);
+  ASSERT_EQ(copy.size(), static_cast<size_t>(depth));
+  ASSERT_EQ(copy.Bottom()->GetAlpha(), depth - 1);
+
+  MutatorsStack second_copy = stack;
+  while (!stack.is_empty()) {
+    stack.Pop();
+  }
+  ASSERT_EQ(second_copy.size(), static_cast<size_t>(depth + 1));
+  ASSERT_EQ(second_copy.Bottom()->GetAlpha(), 100);
+  second_copy.Pop();
+  ASSERT_TRUE(second_copy == copy);
+}
+
+TEST(MutatorsStack, CopyPathMutator) {
+  MutatorsStack stack;
+  SkPath path;
+  path.addCircle(5, 5, 5);
+  stack.PushClipPath(path);
+  MutatorsStack copy = stack;
+  stack.Pop();
+  ASSERT_TRUE(copy.Bottom()->GetType() == MutatorType::clip_path);
+  ASSERT_TRUE(copy.Bottom()->GetPath() == path);
+}
+
 TEST(MutatorsStack, Traversal) {
   MutatorsStack stack;
   SkMatrix matrix;
@@ -113,16 +177,16 @@ TEST(MutatorsStack, Traversal) {
   while (iter != stack.Top()) {
     switch (index) {
       case 0:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rrect);
-        ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+        ASSERT_TRUE(iter->GetType() == MutatorType::clip_rrect);
+        ASSERT_TRUE(iter->GetRRect() == rrect);
         break;
       case 1:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rect);
-        ASSERT_TRUE(iter->get()->GetRect() == rect);
+        ASSERT_TRUE(iter->GetType() == MutatorType::clip_rect);
+        ASSERT_TRUE(iter->GetRect() == rect);
         break;
       case 2:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::transform);
-        ASSERT_TRUE(iter->get()->GetMatrix() == matrix);
+        ASSERT_TRUE(iter->GetType() == MutatorType::transform);
+        ASSERT_TRUE(iter->GetMatrix() == matrix);
         break;
       default:
         break;
@@ -0,0 +1,333 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/persistent_raster_cache.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+namespace {
+
+// Precedes the pixels of every stored entry.
+struct EntryHeader {
+  uint32_t magic;
+  uint32_t compressed;
+  int32_t width;
+  int32_t height;
+};
+
+constexpr uint32_t kEntryMagic = 0x31435246;  // "FRC1"
+
+// The file names of entries are their keys as this many hex digits.
+constexpr size_t kFileNameLength = 16;
+
+// 64-bit FNV-1a, which unlike std::hash is the same in every launch.
+constexpr uint64_t kHashOffsetBasis = 0xcbf29ce484222325ull;
+constexpr uint64_t kHashPrime = 0x100000001b3ull;
+
+void HashBytes(uint64_t& hash, const void* bytes, size_t size) {
+  const uint8_t* data = static_cast<const uint8_t*>(bytes);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= kHashPrime;
+  }
+}
+
+std::string FileName(uint64_t key) {
+  char name[kFileNameLength + 1];
+  snprintf(name, sizeof(name), "%016llx",
+           static_cast<unsigned long long>(key));
+  return name;
+}
+
+std::optional<uint64_t> ParseFileName(const std::string& name) {
+  if (name.size() != kFileNameLength) {
+    return std::nullopt;
+  }
+  char* end = nullptr;
+  const unsigned long long key = std::strtoull(name.c_str(), &end, 16);
+  if (end != name.c_str() + name.size()) {
+    return std::nullopt;
+  }
+  return key;
+}
+
+sk_sp<SkImage> RasterizeOnCpu(const SkPicture& picture,
+                              const SkMatrix& matrix,
+                              SkColorSpace* dst_color_space) {
+  const SkIRect bounds =
+      RasterCache::GetDeviceBounds(picture.cullRect(), matrix);
+  if (bounds.isEmpty()) {
+    return nullptr;
+  }
+  sk_sp<SkSurface> surface = SkSurface::MakeRaster(SkImageInfo::MakeN32Premul(
+      bounds.width(), bounds.height(), sk_ref_sp(dst_color_space)));
+  if (!surface) {
+    return nullptr;
+  }
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->translate(-bounds.left(), -bounds.top());
+  canvas->concat(matrix);
+  canvas->drawPicture(&picture);
+  return surface->makeImageSnapshot();
+}
+
+std::unique_ptr<fml::Mapping> Encode(const SkImage& image, bool compress) {
+  const EntryHeader header = {kEntryMagic, compress, image.width(),
+                              image.height()};
+  sk_sp<SkData> png;
+  SkPixmap pixmap;
+  const void* payload = nullptr;
+  size_t payload_size = 0;
+  if (compress) {
+    png = image.encodeToData(SkEncodedImageFormat::kPNG, 100);
+    if (!png) {
+      return nullptr;
+    }
+    payload = png->data();
+    payload_size = png->size();
+  } else {
+    if (!image.peekPixels(&pixmap) ||
+        pixmap.rowBytes() != pixmap.info().minRowBytes()) {
+      return nullptr;
+    }
+    payload = pixmap.addr();
+    payload_size = pixmap.computeByteSize();
+  }
+  std::vector<uint8_t> data(sizeof(header) + payload_size);
+  memcpy(data.data(), &header, sizeof(header));
+  memcpy(data.data() + sizeof(header), payload, payload_size);
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+sk_sp<SkImage> Decode(const fml::Mapping& mapping,
+                      SkColorSpace* dst_color_space) {
+  EntryHeader header;
+  if (mapping.GetSize() < sizeof(header)) {
+    return nullptr;
+  }
+  memcpy(&header, mapping.GetMapping(), sizeof(header));
+  if (header.magic != kEntryMagic || header.width <= 0 || header.height <= 0) {
+    return nullptr;
+  }
+  const uint8_t* payload = mapping.GetMapping() + sizeof(header);
+  const size_t payload_size = mapping.GetSize() - sizeof(header);
+  sk_sp<SkImage> image;
+  if (header.compressed) {
+    sk_sp<SkImage> encoded =
+        SkImage::MakeFromEncoded(SkData::MakeWithCopy(payload, payload_size));
+    // Decode right away rather than when the image is first drawn.
+    image = encoded ? encoded->makeRasterImage() : nullptr;
+  } else {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(
+        header.width, header.height, sk_ref_sp(dst_color_space));
+    if (payload_size != info.computeMinByteSize()) {
+      return nullptr;
+    }
+    image = SkImage::MakeRasterData(
+        info, SkData::MakeWithCopy(payload, payload_size), info.minRowBytes());
+  }
+  if (!image || image->width() != header.width ||
+      image->height() != header.height) {
+    return nullptr;
+  }
+  return image;
+}
+
+}  // namespace
+
+struct PersistentRasterCache::State {
+  const std::shared_ptr<fml::UniqueFD> directory;
+  const bool compress;
+  const size_t max_bytes;
+
+  mutable std::mutex mutex;
+  // The size of the file of every stored entry. Entries that are being
+  // stored have a size of zero.
+  std::unordered_map<uint64_t, size_t> entries;
+  size_t stored_bytes = 0;
+
+  State(std::shared_ptr<fml::UniqueFD> directory,
+        bool compress,
+        size_t max_bytes)
+      : directory(std::move(directory)),
+        compress(compress),
+        max_bytes(max_bytes) {}
+
+  void LoadIndex();
+
+  void Write(uint64_t key,
+             const SkPicture& picture,
+             const SkMatrix& matrix,
+             SkColorSpace* dst_color_space);
+};
+
+void PersistentRasterCache::State::LoadIndex() {
+  TRACE_EVENT0("flutter", "PersistentRasterCache::LoadIndex");
+  fml::VisitFiles(*directory, [this](const fml::UniqueFD& directory,
+                                     const std::string& filename) {
+    std::optional<uint64_t> key = ParseFileName(filename);
+    if (!key) {
+      return true;
+    }
+    auto mapping = fml::FileMapping::CreateReadOnly(directory, filename);
+    if (mapping && mapping->GetSize() > 0) {
+      entries[*key] = mapping->GetSize();
+      stored_bytes += mapping->GetSize();
+    }
+    return true;
+  });
+}
+
+void PersistentRasterCache::State::Write(uint64_t key,
+                                         const SkPicture& picture,
+                                         const SkMatrix& matrix,
+                                         SkColorSpace* dst_color_space) {
+  TRACE_EVENT0("flutter", "PersistentRasterCache::Write");
+  sk_sp<SkImage> image = RasterizeOnCpu(picture, matrix, dst_color_space);
+  std::unique_ptr<fml::Mapping> mapping =
+      image ? Encode(*image, compress) : nullptr;
+  {
+    std::scoped_lock lock(mutex);
+    if (!mapping || stored_bytes + mapping->GetSize() > max_bytes) {
+      entries.erase(key);
+      return;
+    }
+    entries[key] = mapping->GetSize();
+    stored_bytes += mapping->GetSize();
+  }
+  if (!fml::WriteAtomically(*directory, FileName(key).c_str(), *mapping)) {
+    FML_LOG(ERROR) << "Could not write a persistent raster cache entry.";
+    std::scoped_lock lock(mutex);
+    entries.erase(key);
+    stored_bytes -= mapping->GetSize();
+  }
+}
+
+PersistentRasterCache::PersistentRasterCache(
+    std::shared_ptr<fml::UniqueFD> directory,
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    bool compress,
+    size_t max_bytes)
+    : task_runner_(std::move(task_runner)),
+      state_(std::make_shared<State>(std::move(directory),
+                                     compress,
+                                     max_bytes)) {
+  if (state_->directory && state_->directory->is_valid()) {
+    state_->LoadIndex();
+  }
+}
+
+PersistentRasterCache::~PersistentRasterCache() = default;
+
+std::optional<uint64_t> PersistentRasterCache::ComputeKey(
+    const SkPicture& picture,
+    const SkMatrix& matrix,
+    SkColorSpace* dst_color_space) {
+  TRACE_EVENT0("flutter", "PersistentRasterCache::ComputeKey");
+  bool has_images = false;
+  SkSerialProcs procs;
+  procs.fImageProc = [](SkImage*, void* ctx) -> sk_sp<SkData> {
+    *static_cast<bool*>(ctx) = true;
+    return SkData::MakeEmpty();
+  };
+  procs.fImageCtx = &has_images;
+  sk_sp<SkData> data = picture.serialize(&procs);
+  if (!data || has_images) {
+    return std::nullopt;
+  }
+
+  uint64_t hash = kHashOffsetBasis;
+  HashBytes(hash, data->data(), data->size());
+
+  SkScalar values[9];
+  matrix.get9(values);
+  values[SkMatrix::kMTransX] -= std::floor(values[SkMatrix::kMTransX]);
+  values[SkMatrix::kMTransY] -= std::floor(values[SkMatrix::kMTransY]);
+  HashBytes(hash, values, sizeof(values));
+
+  sk_sp<SkData> color_space =
+      dst_color_space ? dst_color_space->serialize() : nullptr;
+  if (color_space) {
+    HashBytes(hash, color_space->data(), color_space->size());
+  }
+  return hash;
+}
+
+bool PersistentRasterCache::Contains(uint64_t key) const {
+  std::scoped_lock lock(state_->mutex);
+  auto it = state_->entries.find(key);
+  return it != state_->entries.end() && it->second > 0;
+}
+
+sk_sp<SkImage> PersistentRasterCache::Load(
+    uint64_t key,
+    SkColorSpace* dst_color_space) const {
+  if (!Contains(key)) {
+    return nullptr;
+  }
+  TRACE_EVENT0("flutter", "PersistentRasterCache::Load");
+  auto mapping =
+      fml::FileMapping::CreateReadOnly(*state_->directory, FileName(key));
+  sk_sp<SkImage> image = mapping ? Decode(*mapping, dst_color_space) : nullptr;
+  if (!image) {
+    FML_LOG(ERROR) << "Could not load a persistent raster cache entry.";
+  }
+  return image;
+}
+
+void PersistentRasterCache::Store(uint64_t key,
+                                  sk_sp<SkPicture> picture,
+                                  const SkMatrix& matrix,
+                                  sk_sp<SkColorSpace> dst_color_space) {
+  if (!picture || !state_->directory || !state_->directory->is_valid()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(state_->mutex);
+    if (!state_->entries.emplace(key, 0).second) {
+      // Already stored or being stored.
+      return;
+    }
+  }
+  task_runner_->PostTask([state = state_, key, picture = std::move(picture),
+                          matrix,
+                          dst_color_space = std::move(dst_color_space)]() {
+    state->Write(key, *picture, matrix, dst_color_space.get());
+  });
+}
+
+size_t PersistentRasterCache::GetEntryCount() const {
+  std::scoped_lock lock(state_->mutex);
+  size_t count = 0;
+  for (const auto& entry : state_->entries) {
+    count += entry.second > 0 ? 1 : 0;
+  }
+  return count;
+}
+
+size_t PersistentRasterCache::GetStoredBytes() const {
+  std::scoped_lock lock(state_->mutex);
+  return state_->stored_bytes;
+}
+
+}  // namespace flutter
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PERSISTENT_RASTER_CACHE_H_
+#define FLUTTER_FLOW_PERSISTENT_RASTER_CACHE_H_
+
+#include <memory>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Keeps the images the raster cache rasterizes pictures into in a directory,
+/// so that a later launch drawing the same picture at the same scale into the
+/// same color space uploads the stored image instead of rasterizing the
+/// picture. This suits static content like the first frame of an app.
+///
+/// Entries are keyed by a hash of the serialized picture rather than by its
+/// unique id, which is different in every launch. Pictures that draw images
+/// are never stored, as their pixels are not part of the serialized picture.
+///
+class PersistentRasterCache {
+ public:
+  // The subdirectory of the persistent cache directory the shell stores the
+  // entries in.
+  static constexpr char kDirectoryName[] = "io.flutter.raster_cache";
+
+  // The total size of the stored entries, beyond which no more are stored.
+  static constexpr size_t kDefaultMaxBytes = 32 * 1024 * 1024;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a cache of the entries stored in directory.
+  ///
+  /// @param[in]  directory    The directory the entries are stored in.
+  /// @param[in]  task_runner  The task runner entries are rasterized, encoded
+  ///                          and written on. Typically the IO task runner.
+  /// @param[in]  compress     Whether entries are stored as PNG instead of
+  ///                          as raw pixels. They take less space but take
+  ///                          longer to load.
+  /// @param[in]  max_bytes    The total size of the stored entries, beyond
+  ///                          which no more are stored.
+  ///
+  PersistentRasterCache(std::shared_ptr<fml::UniqueFD> directory,
+                        fml::RefPtr<fml::TaskRunner> task_runner,
+                        bool compress,
+                        size_t max_bytes = kDefaultMaxBytes);
+
+  ~PersistentRasterCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the key the image of picture drawn with matrix into
+  ///             dst_color_space is stored under. Only the fractional part of
+  ///             the translation of matrix is part of the key, as the image
+  ///             is the same at every integral offset.
+  ///
+  /// @return     The key, or std::nullopt if the picture can not be stored.
+  ///
+  static std::optional<uint64_t> ComputeKey(const SkPicture& picture,
+                                            const SkMatrix& matrix,
+                                            SkColorSpace* dst_color_space);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether an image is stored under key.
+  ///
+  bool Contains(uint64_t key) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads and decodes the CPU backed image stored under key, if
+  ///             any. This reads from the file system on the calling thread.
+  ///
+  sk_sp<SkImage> Load(uint64_t key, SkColorSpace* dst_color_space) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Rasterizes picture drawn with matrix into a CPU backed image
+  ///             on the task runner and stores it under key, unless an image
+  ///             is already stored under key or the total size would exceed
+  ///             the maximum.
+  ///
+  void Store(uint64_t key,
+             sk_sp<SkPicture> picture,
+             const SkMatrix& matrix,
+             sk_sp<SkColorSpace> dst_color_space);
+
+  size_t GetEntryCount() const;
+
+  size_t GetStoredBytes() const;
+
+ private:
+  struct State;
+
+  const fml::RefPtr<fml::TaskRunner> task_runner_;
+
+  // Shared with the tasks storing entries, which may outlive this object.
+  const std::shared_ptr<State> state_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentRasterCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_PERSISTENT_RASTER_CACHE_H_
@@ -0,0 +1,65 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_hash.h"
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace flutter {
+
+namespace {
+
+// A stream that computes the 64 bit FNV-1a hash of the bytes written to it
+// instead of storing them.
+class HashingWStream : public SkWStream {
+ public:
+  HashingWStream() = default;
+
+  bool write(const void* buffer, size_t size) override {
+    const uint8_t* bytes = static_cast<const uint8_t*>(buffer);
+    for (size_t i = 0; i < size; i++) {
+      hash_ = (hash_ ^ bytes[i]) * 1099511628211u;
+    }
+    bytes_written_ += size;
+    return true;
+  }
+
+  size_t bytesWritten() const override { return bytes_written_; }
+
+  uint64_t hash() const { return hash_; }
+
+ private:
+  uint64_t hash_ = 14695981039346656037u;
+  size_t bytes_written_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(HashingWStream);
+};
+
+}  // anonymous namespace
+
+uint64_t ComputePictureContentHash(const SkPicture& picture) {
+  TRACE_EVENT0("flutter", "ComputePictureContentHash");
+  SkSerialProcs procs;
+  procs.fImageProc = [](SkImage* image, void* ctx) {
+    auto id = image->uniqueID();
+    return SkData::MakeWithCopy(&id, sizeof(id));
+  };
+  procs.fTypefaceProc = [](SkTypeface* typeface, void* ctx) {
+    auto id = typeface->uniqueID();
+    return SkData::MakeWithCopy(&id, sizeof(id));
+  };
+
+  HashingWStream stream;
+  picture.serialize(&stream, &procs);
+  const uint64_t hash = stream.hash();
+  return hash == 0 ? 1 : hash;
+}
+
+}  // namespace flutter
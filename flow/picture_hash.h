@@ -0,0 +1,30 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PICTURE_HASH_H_
+#define FLUTTER_FLOW_PICTURE_HASH_H_
+
+#include <cstdint>
+
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Computes a hash of the operations recorded in |picture|.
+///
+///             Images and typefaces referenced by the picture contribute
+///             their unique IDs rather than their contents, so two pictures
+///             have the same hash if they draw the same operations with the
+///             same image and typeface instances. The operations are streamed
+///             into the hash without being copied.
+///
+/// @return     The hash, which is never 0 so that 0 can represent a hash that
+///             was not computed.
+///
+uint64_t ComputePictureContentHash(const SkPicture& picture);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_PICTURE_HASH_H_
@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_hash.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<SkPicture> RecordRects(int count, SkColor color) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  paint.setColor(color);
+  for (int i = 0; i < count; i++) {
+    canvas->drawRect(SkRect::MakeXYWH(i, i, 10, 10), paint);
+  }
+  return recorder.finishRecordingAsPicture();
+}
+
+sk_sp<SkPicture> RecordImage(const sk_sp<SkImage>& image) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+  canvas->drawImage(image, 0, 0);
+  return recorder.finishRecordingAsPicture();
+}
+
+sk_sp<SkImage> MakeImage() {
+  auto surface = SkSurface::MakeRasterN32Premul(10, 10);
+  surface->getCanvas()->clear(SK_ColorRED);
+  return surface->makeImageSnapshot();
+}
+
+}  // namespace
+
+TEST(PictureHashTest, EqualPicturesHaveEqualHashes) {
+  const uint64_t hash =
+      ComputePictureContentHash(*RecordRects(100, 0xFF00FF00));
+  EXPECT_NE(hash, 0u);
+  EXPECT_EQ(ComputePictureContentHash(*RecordRects(100, 0xFF00FF00)), hash);
+  EXPECT_NE(ComputePictureContentHash(*RecordRects(100, 0xFF0000FF)), hash);
+  EXPECT_NE(ComputePictureContentHash(*RecordRects(99, 0xFF00FF00)), hash);
+}
+
+TEST(PictureHashTest, ImagesAreHashedByInstance) {
+  auto image = MakeImage();
+  EXPECT_EQ(ComputePictureContentHash(*RecordImage(image)),
+            ComputePictureContentHash(*RecordImage(image)));
+  // An image with the same pixels is still a different image.
+  EXPECT_NE(ComputePictureContentHash(*RecordImage(image)),
+            ComputePictureContentHash(*RecordImage(MakeImage())));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,12 +4,17 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 #include <vector>
 
 #include "flutter/common/constants.h"
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/memory/allocation_tags.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -36,19 +41,87 @@ void RasterCacheResult::draw(SkCanvas& canvas, const SkPaint* paint) const {
                    paint);
 }
 
+void RasterCacheResult::draw_scaled(SkCanvas& canvas,
+                                    const SkPaint* paint,
+                                    const SkMatrix& raster_matrix) const {
+  TRACE_EVENT0("flutter", "RasterCacheResult::draw_scaled");
+  SkMatrix inverse;
+  if (!image_ || !raster_matrix.invert(&inverse)) {
+    return;
+  }
+  // The image covers the rounded out device bounds of |logical_rect_|, which
+  // extend past it by less than a pixel at the scale it was rasterized at.
+  const SkRect image_rect = inverse.mapRect(SkRect::Make(
+      RasterCache::GetDeviceBounds(logical_rect_, raster_matrix)));
+  const SkSamplingOptions sampling(
+      SkFilterMode::kLinear,
+      image_->hasMipmaps() ? SkMipmapMode::kLinear : SkMipmapMode::kNone);
+  canvas.drawImageRect(image_, image_rect, sampling, paint);
+}
+
+void RasterCacheResult::BuildMipmaps(GrDirectContext* context) {
+  if (!image_ || image_->hasMipmaps()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "RasterCacheResult::BuildMipmaps");
+  sk_sp<SkImage> image;
+  if (!image_->isTextureBacked()) {
+    image = image_->withDefaultMipmaps();
+  } else if (context) {
+    image = image_->makeTextureImage(context, GrMipmapped::kYes);
+  }
+  if (image) {
+    image_ = std::move(image);
+  }
+}
+
 RasterCache::RasterCache(size_t access_threshold,
                          size_t picture_cache_limit_per_frame)
     : access_threshold_(access_threshold),
       picture_cache_limit_per_frame_(picture_cache_limit_per_frame),
       checkerboard_images_(false) {}
 
-static bool CanRasterizePicture(SkPicture* picture) {
-  if (picture == nullptr) {
-    return false;
-  }
+// What the cache needs to know about the pictures and display lists it
+// rasterizes.
+static uint64_t PictureId(const SkPicture& picture) {
+  return picture.uniqueID();
+}
+
+static uint64_t PictureId(const DisplayList& display_list) {
+  return display_list.unique_id();
+}
 
-  const SkRect cull_rect = picture->cullRect();
+static SkRect PictureBounds(const SkPicture& picture) {
+  return picture.cullRect();
+}
+
+static SkRect PictureBounds(const DisplayList& display_list) {
+  return display_list.bounds();
+}
+
+static int PictureOpCount(const SkPicture& picture) {
+  return picture.approximateOpCount();
+}
+
+static int PictureOpCount(const DisplayList& display_list) {
+  return display_list.op_count();
+}
 
+static std::function<void(SkCanvas*)> PictureDrawFunction(
+    sk_sp<SkPicture> picture) {
+  return [picture = std::move(picture)](SkCanvas* canvas) {
+    canvas->drawPicture(picture);
+  };
+}
+
+static std::function<void(SkCanvas*)> PictureDrawFunction(
+    sk_sp<DisplayList> display_list) {
+  return [display_list = std::move(display_list)](SkCanvas* canvas) {
+    display_list->RenderTo(canvas);
+  };
+}
+
+static bool CanRasterizePicture(const SkRect& cull_rect) {
   if (cull_rect.isEmpty()) {
     // No point in ever rasterizing an empty picture.
     return false;
@@ -62,16 +135,38 @@ static bool CanRasterizePicture(SkPicture* picture) {
   return true;
 }
 
-static bool IsPictureWorthRasterizing(SkPicture* picture,
+// Drawing a cached image is assumed to take this long, plus the time per
+// megabyte of the image below. A picture that was timed is only cached if
+// drawing it directly takes longer, so that larger images, which also take
+// more memory, have to save more time.
+static constexpr fml::TimeDelta kCachedImageDrawTime =
+    fml::TimeDelta::FromMicroseconds(20);
+static constexpr fml::TimeDelta kCachedImageDrawTimePerMegabyte =
+    fml::TimeDelta::FromMicroseconds(20);
+
+static bool IsDrawTimeWorthRasterizing(fml::TimeDelta draw_time,
+                                       const SkIRect& device_bounds) {
+  const int64_t image_bytes =
+      static_cast<int64_t>(device_bounds.width()) * device_bounds.height() * 4;
+  const fml::TimeDelta cached_draw_time =
+      kCachedImageDrawTime +
+      kCachedImageDrawTimePerMegabyte * image_bytes / (1024 * 1024);
+  return draw_time > cached_draw_time;
+}
+
+static bool IsPictureWorthRasterizing(const SkRect& cull_rect,
+                                      int op_count,
                                       bool will_change,
-                                      bool is_complex) {
+                                      bool is_complex,
+                                      const fml::TimeDelta* draw_time,
+                                      const SkMatrix& ctm) {
   if (will_change) {
     // If the picture is going to change in the future, there is no point in
     // doing to extra work to rasterize.
     return false;
   }
 
-  if (!CanRasterizePicture(picture)) {
+  if (!CanRasterizePicture(cull_rect)) {
     // No point in deciding whether the picture is worth rasterizing if it
     // cannot be rasterized at all.
     return false;
@@ -83,13 +178,18 @@ static bool IsPictureWorthRasterizing(SkPicture* picture,
     return true;
   }
 
+  if (draw_time) {
+    // The picture was drawn directly before, so its measured cost decides.
+    return IsDrawTimeWorthRasterizing(
+        *draw_time, RasterCache::GetDeviceBounds(cull_rect, ctm));
+  }
+
   // TODO(abarth): We should find a better heuristic here that lets us avoid
   // wasting memory on trivial layers that are easy to re-rasterize every frame.
-  return picture->approximateOpCount() > 5;
+  return op_count > 5;
 }
 
-/// @note Procedure doesn't copy all closures.
-static std::unique_ptr<RasterCacheResult> Rasterize(
+static sk_sp<SkImage> RasterizeToImage(
     GrDirectContext* context,
     const SkMatrix& ctm,
     SkColorSpace* dst_color_space,
@@ -97,6 +197,7 @@ static std::unique_ptr<RasterCacheResult> Rasterize(
     const SkRect& logical_rect,
     const std::function<void(SkCanvas*)>& draw_function) {
   TRACE_EVENT0("flutter", "RasterCachePopulate");
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kRasterCache);
   SkIRect cache_rect = RasterCache::GetDeviceBounds(logical_rect, ctm);
 
   const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
@@ -121,8 +222,82 @@ static std::unique_ptr<RasterCacheResult> Rasterize(
     DrawCheckerboard(canvas, logical_rect);
   }
 
-  return std::make_unique<RasterCacheResult>(surface->makeImageSnapshot(),
-                                             logical_rect);
+  return surface->makeImageSnapshot();
+}
+
+/// @note Procedure doesn't copy all closures.
+static std::unique_ptr<RasterCacheResult> Rasterize(
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space,
+    bool checkerboard,
+    const SkRect& logical_rect,
+    const std::function<void(SkCanvas*)>& draw_function) {
+  sk_sp<SkImage> image = RasterizeToImage(context, ctm, dst_color_space,
+                                          checkerboard, logical_rect,
+                                          draw_function);
+  if (!image) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(std::move(image), logical_rect);
+}
+
+// Rasterizes the picture |draw_picture| draws within |logical_rect| on a task
+// runner other than the raster task runner.
+//
+// When GPU access is allowed, the picture is rasterized using
+// |resource_context| so that any texture backed images it references can be
+// drawn. The pixels are then read back and uploaded as a cross context image
+// that may be drawn in any context sharing resources with |resource_context|.
+// Otherwise, the picture is rasterized into a CPU backed image that is uploaded
+// when first drawn.
+static std::unique_ptr<RasterCacheResult> RasterizePictureOffRasterThread(
+    const SkRect& logical_rect,
+    const std::function<void(SkCanvas*)>& draw_picture,
+    GrDirectContext* resource_context,
+    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space,
+    bool checkerboard) {
+  sk_sp<SkImage> image;
+  auto rasterize_on_cpu = [&]() {
+    image = RasterizeToImage(nullptr, ctm, dst_color_space, checkerboard,
+                             logical_rect, draw_picture);
+  };
+
+  if (!resource_context || !is_gpu_disabled_sync_switch) {
+    rasterize_on_cpu();
+  } else {
+    is_gpu_disabled_sync_switch->Execute(
+        fml::SyncSwitch::Handlers()
+            .SetIfTrue(rasterize_on_cpu)
+            .SetIfFalse([&]() {
+              sk_sp<SkImage> resource_image =
+                  RasterizeToImage(resource_context, ctm, dst_color_space,
+                                   checkerboard, logical_rect, draw_picture);
+              sk_sp<SkImage> raster_image =
+                  resource_image ? resource_image->makeRasterImage() : nullptr;
+              SkPixmap pixmap;
+              if (!raster_image || !raster_image->peekPixels(&pixmap)) {
+                return;
+              }
+              TRACE_EVENT0("flutter", "RasterCacheUpload");
+              image = SkImage::MakeCrossContextFromPixmap(
+                  resource_context,  // context
+                  pixmap,            // pixmap
+                  false,             // buildMips,
+                  true               // limitToMaxTextureSize
+              );
+              if (!image) {
+                image = std::move(raster_image);
+              }
+            }));
+  }
+
+  if (!image) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(std::move(image), logical_rect);
 }
 
 std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
@@ -136,15 +311,56 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
                    [=](SkCanvas* canvas) { canvas->drawPicture(picture); });
 }
 
+std::unique_ptr<RasterCacheResult> RasterCache::RasterizeDisplayList(
+    DisplayList* display_list,
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space,
+    bool checkerboard) const {
+  return Rasterize(
+      context, ctm, dst_color_space, checkerboard, display_list->bounds(),
+      [=](SkCanvas* canvas) { display_list->RenderTo(canvas); });
+}
+
+std::unique_ptr<RasterCacheResult> RasterCache::RasterizeEntry(
+    SkPicture* picture,
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space) const {
+  return RasterizePicture(picture, context, ctm, dst_color_space,
+                          checkerboard_images_);
+}
+
+std::unique_ptr<RasterCacheResult> RasterCache::RasterizeEntry(
+    DisplayList* display_list,
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space) const {
+  return RasterizeDisplayList(display_list, context, ctm, dst_color_space,
+                              checkerboard_images_);
+}
+
 void RasterCache::Prepare(PrerollContext* context,
                           Layer* layer,
                           const SkMatrix& ctm) {
   LayerRasterCacheKey cache_key(layer->unique_id(), ctm);
   Entry& entry = layer_cache_[cache_key];
   entry.access_count++;
-  entry.used_this_frame = true;
+  MarkUsed(entry);
   if (!entry.image) {
+    // While the scale keeps changing, the layer is drawn from an image at a
+    // nearby scale until it was prepared at the same scale often enough.
+    if (entry.access_count < access_threshold_ &&
+        FindScaledEntry(layer_cache_, cache_key) != layer_cache_.end()) {
+      unsettled_preparation_count_++;
+      return;
+    }
     entry.image = RasterizeLayer(context, layer, ctm, checkerboard_images_);
+    if (!entry.image) {
+      unsettled_preparation_count_++;
+    } else if (scale_mipmaps_) {
+      entry.image->BuildMipmaps(context->gr_context);
+    }
   }
 }
 
@@ -185,14 +401,43 @@ bool RasterCache::Prepare(GrDirectContext* context,
                           SkColorSpace* dst_color_space,
                           bool is_complex,
                           bool will_change) {
+  return PreparePicture(context, picture, transformation_matrix,
+                        dst_color_space, is_complex, will_change);
+}
+
+bool RasterCache::Prepare(GrDirectContext* context,
+                          DisplayList* display_list,
+                          const SkMatrix& transformation_matrix,
+                          SkColorSpace* dst_color_space,
+                          bool is_complex,
+                          bool will_change) {
+  return PreparePicture(context, display_list, transformation_matrix,
+                        dst_color_space, is_complex, will_change);
+}
+
+template <typename Picture>
+bool RasterCache::PreparePicture(GrDirectContext* context,
+                                 Picture* picture,
+                                 const SkMatrix& transformation_matrix,
+                                 SkColorSpace* dst_color_space,
+                                 bool is_complex,
+                                 bool will_change) {
   // Disabling caching when access_threshold is zero is historic behavior.
   if (access_threshold_ == 0) {
     return false;
   }
+  PictureRasterCacheKey cache_key(PictureId(*picture), transformation_matrix);
   if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
-    return false;
+    unsettled_preparation_count_++;
+    return FindScaledEntry(picture_cache_, cache_key) != picture_cache_.end();
   }
-  if (!IsPictureWorthRasterizing(picture, will_change, is_complex)) {
+  auto draw_time = picture_draw_times_.find(cache_key);
+  if (!IsPictureWorthRasterizing(
+          PictureBounds(*picture), PictureOpCount(*picture), will_change,
+          is_complex,
+          draw_time != picture_draw_times_.end() ? &draw_time->second.average
+                                                 : nullptr,
+          transformation_matrix)) {
     // We only deal with pictures that are worthy of rasterization.
     return false;
   }
@@ -206,77 +451,509 @@ bool RasterCache::Prepare(GrDirectContext* context,
     return false;
   }
 
-  PictureRasterCacheKey cache_key(picture->uniqueID(), transformation_matrix);
-
   // Creates an entry, if not present prior.
   Entry& entry = picture_cache_[cache_key];
-  if (entry.access_count < access_threshold_) {
-    // Frame threshold has not yet been reached.
-    return false;
+  if constexpr (std::is_same_v<Picture, SkPicture>) {
+    if (!entry.image && !entry.pending &&
+        LoadPersistentEntry(entry, context, *picture, transformation_matrix,
+                            dst_color_space)) {
+      return true;
+    }
+  }
+  if (!entry.image && entry.access_count < access_threshold_) {
+    // Frame threshold has not yet been reached. While the scale keeps
+    // changing, an image at a nearby scale is drawn meanwhile. A picture that
+    // was cached at another scale before is rasterized at this one right away
+    // once no image is near enough.
+    const bool has_scaled_entry =
+        FindScaledEntry(picture_cache_, cache_key) != picture_cache_.end();
+    if (has_scaled_entry || scale_tolerance_ <= 0 ||
+        !HasImageOfId(picture_cache_, cache_key)) {
+      unsettled_preparation_count_++;
+      return has_scaled_entry;
+    }
+  }
+
+  if (!entry.image && async_task_runner_) {
+    if (!PrepareAsync(entry, PictureBounds(*picture),
+                      PictureDrawFunction(sk_ref_sp(picture)),
+                      transformation_matrix, dst_color_space)) {
+      unsettled_preparation_count_++;
+      return FindScaledEntry(picture_cache_, cache_key) != picture_cache_.end();
+    }
+    if constexpr (std::is_same_v<Picture, SkPicture>) {
+      StorePersistentEntry(entry, picture, transformation_matrix,
+                           dst_color_space);
+    }
+    if (scale_mipmaps_) {
+      entry.image->BuildMipmaps(context);
+    }
+    return true;
   }
 
   if (!entry.image) {
-    entry.image = RasterizePicture(picture, context, transformation_matrix,
-                                   dst_color_space, checkerboard_images_);
+    entry.image = RasterizeEntry(picture, context, transformation_matrix,
+                                 dst_color_space);
+    entry.last_used_frame = frame_count_;
     picture_cached_this_frame_++;
+    if constexpr (std::is_same_v<Picture, SkPicture>) {
+      StorePersistentEntry(entry, picture, transformation_matrix,
+                           dst_color_space);
+    }
+    if (entry.image && scale_mipmaps_) {
+      entry.image->BuildMipmaps(context);
+    }
   }
   return true;
 }
 
-bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
-  PictureRasterCacheKey cache_key(picture.uniqueID(), canvas.getTotalMatrix());
-  auto it = picture_cache_.find(cache_key);
-  if (it == picture_cache_.end()) {
+bool RasterCache::LoadPersistentEntry(Entry& entry,
+                                      GrDirectContext* context,
+                                      const SkPicture& picture,
+                                      const SkMatrix& transformation_matrix,
+                                      SkColorSpace* dst_color_space) {
+  // Checkerboarded images must not be stored, nor be replaced by stored ones.
+  // Pictures drawn in a single frame are not worth serializing for the key,
+  // and the stored image is only looked for once.
+  if (!persistent_cache_ || checkerboard_images_ || entry.access_count == 0 ||
+      entry.persistent_key_computed) {
+    return false;
+  }
+  const std::optional<uint64_t>& key = GetPersistentKey(
+      entry, picture, transformation_matrix, dst_color_space);
+  if (!key) {
     return false;
   }
+  sk_sp<SkImage> image = persistent_cache_->Load(*key, dst_color_space);
+  if (!image) {
+    return false;
+  }
+  if (context) {
+    TRACE_EVENT0("flutter", "RasterCacheUpload");
+    sk_sp<SkImage> texture_image = image->makeTextureImage(context);
+    if (texture_image) {
+      image = std::move(texture_image);
+    }
+  }
+  entry.image =
+      std::make_unique<RasterCacheResult>(std::move(image), picture.cullRect());
+  entry.last_used_frame = frame_count_;
+  picture_cached_this_frame_++;
+  if (scale_mipmaps_) {
+    entry.image->BuildMipmaps(context);
+  }
+  return true;
+}
 
-  Entry& entry = it->second;
-  entry.access_count++;
-  entry.used_this_frame = true;
+void RasterCache::StorePersistentEntry(Entry& entry,
+                                       SkPicture* picture,
+                                       const SkMatrix& transformation_matrix,
+                                       SkColorSpace* dst_color_space) {
+  if (!persistent_cache_ || checkerboard_images_ || !entry.image) {
+    return;
+  }
+  const std::optional<uint64_t>& key = GetPersistentKey(
+      entry, *picture, transformation_matrix, dst_color_space);
+  if (!key) {
+    return;
+  }
+  persistent_cache_->Store(*key, sk_ref_sp(picture), transformation_matrix,
+                           sk_ref_sp(dst_color_space));
+}
 
-  if (entry.image) {
-    entry.image->draw(canvas, nullptr);
+const std::optional<uint64_t>& RasterCache::GetPersistentKey(
+    Entry& entry,
+    const SkPicture& picture,
+    const SkMatrix& transformation_matrix,
+    SkColorSpace* dst_color_space) {
+  if (!entry.persistent_key_computed) {
+    entry.persistent_key_computed = true;
+    entry.persistent_key = PersistentRasterCache::ComputeKey(
+        picture, transformation_matrix, dst_color_space);
+  }
+  return entry.persistent_key;
+}
+
+bool RasterCache::PrepareAsync(Entry& entry,
+                               const SkRect& logical_rect,
+                               std::function<void(SkCanvas*)> draw_picture,
+                               const SkMatrix& transformation_matrix,
+                               SkColorSpace* dst_color_space) {
+  if (entry.pending) {
+    std::unique_ptr<RasterCacheResult> result;
+    {
+      std::scoped_lock lock(entry.pending->mutex);
+      if (!entry.pending->done) {
+        // Still being rasterized. The picture is drawn directly meanwhile.
+        return false;
+      }
+      result = std::move(entry.pending->result);
+    }
+    entry.pending.reset();
+    if (!result) {
+      // The rasterization failed. It is attempted again on the next Prepare.
+      return false;
+    }
+    entry.image = std::move(result);
+    entry.last_used_frame = frame_count_;
     return true;
   }
 
+  TRACE_EVENT0("flutter", "RasterCache::PrepareAsync");
+  auto pending = std::make_shared<PendingRasterization>();
+  entry.pending = pending;
+  picture_cached_this_frame_++;
+
+  async_task_runner_->PostTask(
+      [pending = std::move(pending),                     //
+       logical_rect,                                     //
+       draw_picture = std::move(draw_picture),           //
+       transformation_matrix,                            //
+       dst_color_space = sk_ref_sp(dst_color_space),     //
+       checkerboard = checkerboard_images_,              //
+       resource_context = async_resource_context_,       //
+       sync_switch = async_is_gpu_disabled_sync_switch_  //
+  ]() {
+        std::unique_ptr<RasterCacheResult> result =
+            RasterizePictureOffRasterThread(
+                logical_rect, draw_picture, resource_context.get(), sync_switch,
+                transformation_matrix, dst_color_space.get(), checkerboard);
+
+        std::scoped_lock lock(pending->mutex);
+        pending->result = std::move(result);
+        pending->done = true;
+      });
   return false;
 }
 
-bool RasterCache::Draw(const Layer* layer,
+bool RasterCache::Draw(const SkPicture& picture,
                        SkCanvas& canvas,
                        SkPaint* paint) const {
-  LayerRasterCacheKey cache_key(layer->unique_id(), canvas.getTotalMatrix());
-  auto it = layer_cache_.find(cache_key);
-  if (it == layer_cache_.end()) {
+  return DrawPicture(PictureId(picture), canvas, paint);
+}
+
+bool RasterCache::Draw(const DisplayList& display_list,
+                       SkCanvas& canvas,
+                       SkPaint* paint) const {
+  return DrawPicture(PictureId(display_list), canvas, paint);
+}
+
+bool RasterCache::DrawPicture(uint64_t picture_id,
+                              SkCanvas& canvas,
+                              SkPaint* paint) const {
+  return DrawEntry(picture_cache_,
+                   PictureRasterCacheKey(picture_id, canvas.getTotalMatrix()),
+                   canvas, paint);
+}
+
+bool RasterCache::DrawEntry(PictureRasterCacheKey::Map<Entry>& cache,
+                            const PictureRasterCacheKey& key,
+                            SkCanvas& canvas,
+                            const SkPaint* paint) const {
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    Entry& entry = it->second;
+    entry.access_count++;
+    MarkUsed(entry);
+
+    if (entry.image) {
+      entry.image->draw(canvas, paint);
+      draw_hit_count_++;
+      return true;
+    }
+  }
+
+  auto scaled = FindScaledEntry(cache, key);
+  if (scaled != cache.end()) {
+    MarkUsed(scaled->second);
+    scaled->second.image->draw_scaled(canvas, paint, scaled->first.matrix());
+    draw_hit_count_++;
+    return true;
+  }
+
+  draw_miss_count_++;
+  return false;
+}
+
+// The distance between the scales of two matrices without translation, as
+// the larger log of their ratio in either axis. Returns false for matrices
+// that do not only scale or whose scales differ in sign.
+static bool GetScaleDistance(const SkMatrix& a,
+                             const SkMatrix& b,
+                             float* distance) {
+  if (!a.isScaleTranslate() || !b.isScaleTranslate()) {
+    return false;
+  }
+  const float ratio_x = a.getScaleX() / b.getScaleX();
+  const float ratio_y = a.getScaleY() / b.getScaleY();
+  if (!(ratio_x > 0) || !(ratio_y > 0) || !std::isfinite(ratio_x) ||
+      !std::isfinite(ratio_y)) {
+    return false;
+  }
+  *distance =
+      std::max(std::abs(std::log(ratio_x)), std::abs(std::log(ratio_y)));
+  return true;
+}
+
+PictureRasterCacheKey::Map<RasterCache::Entry>::iterator
+RasterCache::FindScaledEntry(PictureRasterCacheKey::Map<Entry>& cache,
+                             const PictureRasterCacheKey& key) const {
+  if (scale_tolerance_ <= 0) {
+    return cache.end();
+  }
+  // Only the id is hashed, so all the entries of an id share a bucket.
+  const size_t bucket = cache.bucket(key);
+  float closest_distance = std::log1p(scale_tolerance_);
+  const PictureRasterCacheKey* closest = nullptr;
+  for (auto it = cache.begin(bucket); it != cache.end(bucket); ++it) {
+    float distance;
+    if (it->first.id() == key.id() && it->second.image &&
+        GetScaleDistance(it->first.matrix(), key.matrix(), &distance) &&
+        distance <= closest_distance) {
+      closest_distance = distance;
+      closest = &it->first;
+    }
+  }
+  return closest ? cache.find(*closest) : cache.end();
+}
+
+bool RasterCache::HasImageOfId(PictureRasterCacheKey::Map<Entry>& cache,
+                               const PictureRasterCacheKey& key) {
+  const size_t bucket = cache.bucket(key);
+  for (auto it = cache.begin(bucket); it != cache.end(bucket); ++it) {
+    if (it->first.id() == key.id() && it->second.image) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RasterCache::PrepareShadow(
+    GrDirectContext* context,
+    const ShadowRasterCacheKey& key,
+    const SkRect& bounds,
+    SkColorSpace* dst_color_space,
+    const std::function<void(SkCanvas*, const SkPoint&)>& draw_shadow) {
+  if (access_threshold_ == 0) {
+    return false;
+  }
+  if (!MatrixDecomposition(key.matrix()).IsValid()) {
+    return false;
+  }
+
+  Entry& entry = shadow_cache_[key];
+  if (entry.access_count < access_threshold_) {
+    unsettled_preparation_count_++;
+    return false;
+  }
+
+  if (!entry.image) {
+    if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
+      unsettled_preparation_count_++;
+      return false;
+    }
+    const SkMatrix& ctm = key.matrix();
+    entry.image =
+        Rasterize(context, ctm, dst_color_space, checkerboard_images_, bounds,
+                  [&ctm, &draw_shadow](SkCanvas* canvas) {
+                    const SkMatrix& matrix = canvas->getTotalMatrix();
+                    const SkPoint device_offset = SkPoint::Make(
+                        matrix.getTranslateX() - ctm.getTranslateX(),
+                        matrix.getTranslateY() - ctm.getTranslateY());
+                    draw_shadow(canvas, device_offset);
+                  });
+    entry.last_used_frame = frame_count_;
+    picture_cached_this_frame_++;
+    if (!entry.image) {
+      unsettled_preparation_count_++;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RasterCache::DrawShadow(const ShadowRasterCacheKey& key,
+                             SkCanvas& canvas) const {
+  auto it = shadow_cache_.find(key);
+  if (it == shadow_cache_.end()) {
+    draw_miss_count_++;
     return false;
   }
 
   Entry& entry = it->second;
   entry.access_count++;
-  entry.used_this_frame = true;
+  MarkUsed(entry);
 
   if (entry.image) {
-    entry.image->draw(canvas, paint);
+    entry.image->draw(canvas, nullptr);
+    draw_hit_count_++;
     return true;
   }
 
+  draw_miss_count_++;
   return false;
 }
 
+bool RasterCache::Draw(const Layer* layer,
+                       SkCanvas& canvas,
+                       SkPaint* paint) const {
+  return DrawEntry(
+      layer_cache_,
+      LayerRasterCacheKey(layer->unique_id(), canvas.getTotalMatrix()), canvas,
+      paint);
+}
+
+void RasterCache::RecordPictureDrawTime(const SkPicture& picture,
+                                        const SkMatrix& matrix,
+                                        fml::TimeDelta draw_time) const {
+  RecordPictureDrawTime(PictureId(picture), matrix, draw_time);
+}
+
+void RasterCache::RecordPictureDrawTime(const DisplayList& display_list,
+                                        const SkMatrix& matrix,
+                                        fml::TimeDelta draw_time) const {
+  RecordPictureDrawTime(PictureId(display_list), matrix, draw_time);
+}
+
+void RasterCache::RecordPictureDrawTime(uint64_t picture_id,
+                                        const SkMatrix& matrix,
+                                        fml::TimeDelta draw_time) const {
+  auto [it, inserted] = picture_draw_times_.try_emplace(
+      PictureRasterCacheKey(picture_id, matrix));
+  DrawTime& recorded = it->second;
+  // Smooth out the occasional slow frame.
+  recorded.average =
+      inserted ? draw_time
+               : recorded.average + (draw_time - recorded.average) / 4;
+  recorded.used_this_frame = true;
+}
+
 void RasterCache::SweepAfterFrame() {
-  SweepOneCacheAfterFrame(picture_cache_);
-  SweepOneCacheAfterFrame(layer_cache_);
+  retained_layer_output_bytes_ = layer_output_bytes_;
+  layer_output_bytes_ = 0;
+  if (max_cache_bytes_ == 0) {
+    evicted_image_count_ +=
+        SweepOneCacheAfterFrame(picture_cache_, user_count_);
+    evicted_image_count_ += SweepOneCacheAfterFrame(layer_cache_, user_count_);
+    evicted_image_count_ +=
+        SweepOneCacheAfterFrame(shadow_cache_, user_count_);
+  } else {
+    SweepWithinBudgetAfterFrame();
+  }
+  for (auto it = picture_draw_times_.begin();
+       it != picture_draw_times_.end();) {
+    if (SweepUsage(it->second, user_count_)) {
+      it = picture_draw_times_.erase(it);
+    } else {
+      ++it;
+    }
+  }
   picture_cached_this_frame_ = 0;
+  frame_count_++;
+  TraceStatsToTimeline();
+}
+
+void RasterCache::SweepWithinBudgetAfterFrame() {
+  std::vector<EvictionCandidate> candidates;
+  size_t retained_bytes =
+      CollectEvictionCandidates(picture_cache_, user_count_, candidates);
+  retained_bytes +=
+      CollectEvictionCandidates(layer_cache_, user_count_, candidates);
+  retained_bytes +=
+      CollectEvictionCandidates(shadow_cache_, user_count_, candidates);
+
+  // The layer outputs share the budget, but are only released by their
+  // layers.
+  EvictLeastRecentlyUsed(
+      candidates, retained_bytes,
+      max_cache_bytes_ - std::min(max_cache_bytes_,
+                                  retained_layer_output_bytes_));
+}
+
+void RasterCache::EvictLeastRecentlyUsed(
+    std::vector<EvictionCandidate>& candidates,
+    size_t retained_bytes,
+    size_t max_bytes) {
+  if (retained_bytes <= max_bytes) {
+    return;
+  }
+
+  // Evict the least recently used entries first. Among entries that went
+  // unused for the same number of frames, prefer evicting the larger one.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const EvictionCandidate& a, const EvictionCandidate& b) {
+              if (a.last_used_frame != b.last_used_frame) {
+                return a.last_used_frame < b.last_used_frame;
+              }
+              return a.bytes > b.bytes;
+            });
+
+  for (const auto& candidate : candidates) {
+    if (retained_bytes <= max_bytes) {
+      break;
+    }
+    candidate.evict();
+    evicted_image_count_++;
+    retained_bytes -= candidate.bytes;
+  }
+}
+
+void RasterCache::Trim(size_t max_bytes) {
+  std::vector<EvictionCandidate> candidates;
+  size_t retained_bytes = CollectImageEntries(picture_cache_, candidates);
+  retained_bytes += CollectImageEntries(layer_cache_, candidates);
+  retained_bytes += CollectImageEntries(shadow_cache_, candidates);
+  EvictLeastRecentlyUsed(candidates, retained_bytes, max_bytes);
   TraceStatsToTimeline();
 }
 
+RasterCache::WarmState RasterCache::GetWarmState() const {
+  std::vector<std::pair<size_t, PictureRasterCacheKey>> pictures;
+  for (const auto& [key, entry] : picture_cache_) {
+    if (entry.image) {
+      pictures.emplace_back(entry.last_used_frame, key);
+    }
+  }
+  std::stable_sort(
+      pictures.begin(), pictures.end(),
+      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  WarmState state;
+  state.pictures.reserve(pictures.size());
+  for (const auto& picture : pictures) {
+    state.pictures.push_back(picture.second);
+  }
+  state.draw_times.reserve(picture_draw_times_.size());
+  for (const auto& [key, draw_time] : picture_draw_times_) {
+    state.draw_times.emplace_back(key, draw_time.average);
+  }
+  return state;
+}
+
+void RasterCache::RestoreWarmState(const WarmState& state) {
+  for (const auto& [key, average] : state.draw_times) {
+    DrawTime& draw_time = picture_draw_times_[key];
+    draw_time.average = average;
+    draw_time.used_this_frame = true;
+  }
+  for (const auto& key : state.pictures) {
+    Entry& entry = picture_cache_[key];
+    entry.access_count = std::max(entry.access_count, access_threshold_);
+    entry.used_this_frame = true;
+    entry.last_used_frame = frame_count_;
+  }
+}
+
 void RasterCache::Clear() {
+  evicted_image_count_ += GetCachedEntriesCount();
+  picture_draw_times_.clear();
   picture_cache_.clear();
   layer_cache_.clear();
+  shadow_cache_.clear();
 }
 
 size_t RasterCache::GetCachedEntriesCount() const {
-  return layer_cache_.size() + picture_cache_.size();
+  return layer_cache_.size() + picture_cache_.size() + shadow_cache_.size();
 }
 
 size_t RasterCache::GetLayerCachedEntriesCount() const {
@@ -287,6 +964,10 @@ size_t RasterCache::GetPictureCachedEntriesCount() const {
   return picture_cache_.size();
 }
 
+size_t RasterCache::GetShadowCachedEntriesCount() const {
+  return shadow_cache_.size();
+}
+
 void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   if (checkerboard_images_ == checkerboard) {
     return;
@@ -299,6 +980,42 @@ void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   Clear();
 }
 
+void RasterCache::SetMaxCacheBytes(size_t max_bytes) {
+  max_cache_bytes_ = max_bytes;
+}
+
+bool RasterCache::RetainLayerOutput(size_t bytes) const {
+  if (max_cache_bytes_ > 0) {
+    size_t retained_bytes = EstimatePictureCacheByteSize() +
+                            EstimateLayerCacheByteSize() -
+                            retained_layer_output_bytes_ + layer_output_bytes_;
+    if (retained_bytes + bytes > max_cache_bytes_) {
+      return false;
+    }
+  }
+  layer_output_bytes_ += bytes;
+  return true;
+}
+
+void RasterCache::SetScaleTolerance(float tolerance, bool build_mipmaps) {
+  scale_tolerance_ = tolerance;
+  scale_mipmaps_ = build_mipmaps;
+}
+
+void RasterCache::EnableAsyncPictureRasterization(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    fml::WeakPtr<GrDirectContext> resource_context,
+    std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch) {
+  async_task_runner_ = std::move(task_runner);
+  async_resource_context_ = std::move(resource_context);
+  async_is_gpu_disabled_sync_switch_ = std::move(is_gpu_disabled_sync_switch);
+}
+
+void RasterCache::EnablePersistentPictureCache(
+    std::shared_ptr<PersistentRasterCache> persistent_cache) {
+  persistent_cache_ = std::move(persistent_cache);
+}
+
 void RasterCache::TraceStatsToTimeline() const {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER("flutter", "RasterCache", reinterpret_cast<int64_t>(this),
@@ -317,7 +1034,7 @@ size_t RasterCache::EstimateLayerCacheByteSize() const {
       layer_cache_bytes += item.second.image->image_bytes();
     }
   }
-  return layer_cache_bytes;
+  return layer_cache_bytes + retained_layer_output_bytes_;
 }
 
 size_t RasterCache::EstimatePictureCacheByteSize() const {
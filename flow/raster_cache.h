@@ -5,17 +5,29 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "flutter/flow/persistent_raster_cache.h"
 #include "flutter/flow/raster_cache_key.h"
+#include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/synchronization/sync_switch.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
 
+class DisplayList;
+
 class RasterCacheResult {
  public:
   RasterCacheResult(sk_sp<SkImage> image, const SkRect& logical_rect);
@@ -24,6 +36,17 @@ class RasterCacheResult {
 
   virtual void draw(SkCanvas& canvas, const SkPaint* paint) const;
 
+  // Draws the image scaled to the canvas' matrix rather than blitting it at
+  // its own size, for images rasterized with the nearby |raster_matrix|.
+  virtual void draw_scaled(SkCanvas& canvas,
+                           const SkPaint* paint,
+                           const SkMatrix& raster_matrix) const;
+
+  // Attaches mip levels to the image so that it is sampled smoothly when it
+  // is drawn scaled down. |context| is the one texture backed images are
+  // drawn with.
+  void BuildMipmaps(GrDirectContext* context);
+
   virtual SkISize image_dimensions() const {
     return image_ ? image_->dimensions() : SkISize::Make(0, 0);
   };
@@ -75,6 +98,17 @@ class RasterCache {
       SkColorSpace* dst_color_space,
       bool checkerboard) const;
 
+  /**
+   * @brief Rasterize a display list and produce a RasterCacheResult to be
+   * stored in the cache, like RasterizePicture does for pictures.
+   */
+  virtual std::unique_ptr<RasterCacheResult> RasterizeDisplayList(
+      DisplayList* display_list,
+      GrDirectContext* context,
+      const SkMatrix& ctm,
+      SkColorSpace* dst_color_space,
+      bool checkerboard) const;
+
   /**
    * @brief Rasterize an engine Layer and produce a RasterCacheResult
    * to be stored in the cache.
@@ -127,11 +161,16 @@ class RasterCache {
   // Return true if the cache is generated.
   //
   // We may return false and not generate the cache if
-  // 1. The picture is not worth rasterizing
+  // 1. The picture is not worth rasterizing. Unless the picture is hinted to
+  //    be complex or to change, this is decided by the time drawing it
+  //    directly took, if it was recorded with RecordPictureDrawTime, or else
+  //    by its op count.
   // 2. The matrix is singular
   // 3. The picture is accessed too few times
   // 4. There are too many pictures to be cached in the current frame.
   //    (See also kDefaultPictureCacheLimitPerFrame.)
+  // 5. Asynchronous rasterization is enabled and the picture is still being
+  //    rasterized. (See also EnableAsyncPictureRasterization.)
   bool Prepare(GrDirectContext* context,
                SkPicture* picture,
                const SkMatrix& transformation_matrix,
@@ -139,12 +178,64 @@ class RasterCache {
                bool is_complex,
                bool will_change);
 
+  // Like the Prepare of a picture, with the op count of the display list
+  // standing in for that of the picture.
+  bool Prepare(GrDirectContext* context,
+               DisplayList* display_list,
+               const SkMatrix& transformation_matrix,
+               SkColorSpace* dst_color_space,
+               bool is_complex,
+               bool will_change);
+
   void Prepare(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
   // Find the raster cache for the picture and draw it to the canvas.
   //
+  // Additional paint can be given to change how the raster cache is drawn
+  // (e.g., draw the raster cache with some opacity).
+  //
+  // Return true if it's found and drawn.
+  bool Draw(const SkPicture& picture,
+            SkCanvas& canvas,
+            SkPaint* paint = nullptr) const;
+
+  bool Draw(const DisplayList& display_list,
+            SkCanvas& canvas,
+            SkPaint* paint = nullptr) const;
+
+  // Records how long drawing |picture| directly with |matrix| took, which
+  // Prepare compares with the estimated cost of drawing a cached image of it.
+  // Times that are not recorded again during a frame are dropped when it
+  // ends.
+  void RecordPictureDrawTime(const SkPicture& picture,
+                             const SkMatrix& matrix,
+                             fml::TimeDelta draw_time) const;
+
+  void RecordPictureDrawTime(const DisplayList& display_list,
+                             const SkMatrix& matrix,
+                             fml::TimeDelta draw_time) const;
+
+  // Prepares the cached image of the shadow |key| describes, which
+  // |draw_shadow| draws within |bounds|. Like pictures, shadows are only
+  // rasterized once they were drawn in enough frames, and count towards the
+  // limit of caches generated per frame.
+  //
+  // |draw_shadow| is passed the canvas to draw into along with the offset of
+  // the canvas' device space from the one |key| is drawn in. A shadow's light
+  // is positioned in device space, so it has to be moved by the same offset.
+  //
+  // Return true if the cache is generated.
+  bool PrepareShadow(
+      GrDirectContext* context,
+      const ShadowRasterCacheKey& key,
+      const SkRect& bounds,
+      SkColorSpace* dst_color_space,
+      const std::function<void(SkCanvas*, const SkPoint&)>& draw_shadow);
+
+  // Find the raster cache for the shadow and draw it to the canvas.
+  //
   // Return true if it's found and drawn.
-  bool Draw(const SkPicture& picture, SkCanvas& canvas) const;
+  bool DrawShadow(const ShadowRasterCacheKey& key, SkCanvas& canvas) const;
 
   // Find the raster cache for the layer and draw it to the canvas.
   //
@@ -160,14 +251,190 @@ class RasterCache {
 
   void Clear();
 
+  /**
+   * @brief Evict cached images until their total size is at most max_bytes,
+   * e.g. in response to memory pressure.
+   *
+   * The entries that have gone unused the longest are evicted first, as in
+   * the byte-budgeted sweep, but entries used during the current frame may be
+   * evicted as well.
+   */
+  void Trim(size_t max_bytes);
+
+  /**
+   * @brief What a cache knows about the pictures it rasterized, without the
+   * images themselves.
+   *
+   * It is kept while the GPU context is destroyed, e.g. while the application
+   * is in the background, so that the pictures that were cached before are
+   * rasterized again as soon as they are prepared instead of after they
+   * reached the access threshold again.
+   */
+  struct WarmState {
+    // The pictures that held an image, from the most to the least recently
+    // used one.
+    std::vector<PictureRasterCacheKey> pictures;
+    // The average time drawing a picture directly took.
+    std::vector<std::pair<PictureRasterCacheKey, fml::TimeDelta>> draw_times;
+  };
+
+  WarmState GetWarmState() const;
+
+  /**
+   * @brief Let the pictures of state be rasterized on their next Prepare.
+   *
+   * The pictures are still subject to the per-frame limit of rasterized
+   * pictures, and the ones that are not prepared in the next frame are
+   * forgotten again by its sweep.
+   */
+  void RestoreWarmState(const WarmState& state);
+
   void SetCheckboardCacheImages(bool checkerboard);
 
+  /**
+   * @brief Switch the cache to byte-budgeted LRU eviction.
+   *
+   * By default (a budget of zero) every entry that was not used during a frame
+   * is evicted when that frame ends. With a non-zero budget, unused entries
+   * are retained across frames for as long as the total size of all cached
+   * images stays within max_bytes. When the budget is exceeded, the entries
+   * that have gone unused the longest are evicted first (the larger one
+   * winning ties). Entries used during the current frame are never evicted by
+   * the sweep.
+   *
+   * @param max_bytes the maximum number of bytes of cached images to retain
+   *        across frames, as measured by EstimatePictureCacheByteSize and
+   *        EstimateLayerCacheByteSize. Zero restores the per-frame sweep.
+   */
+  void SetMaxCacheBytes(size_t max_bytes);
+
+  size_t GetMaxCacheBytes() const { return max_cache_bytes_; }
+
+  /**
+   * @brief Count the surface of |bytes| that a LayerOutputCache keeps for the
+   * next frame in the budget and in the layer metrics of the cache.
+   *
+   * @return false if the surface does not fit into the budget set with
+   *         SetMaxCacheBytes, in which case it must be released.
+   */
+  bool RetainLayerOutput(size_t bytes) const;
+
+  /**
+   * @brief Let pictures and layers be drawn from an image rasterized at a
+   * nearby scale while there is no image at their current scale.
+   *
+   * Entries are keyed by the full matrix, so every frame of a scale animation
+   * misses the cache. With a tolerance, an image whose scale is within a
+   * factor of (1 + tolerance) of the drawn one in both axes is drawn scaled
+   * instead. Once the scale leaves the band of every image of a picture, the
+   * picture is rasterized at the current scale right away rather than after
+   * the access threshold. An entry is still rasterized at its own scale once
+   * it reached the access threshold, i.e. once the animation settled.
+   *
+   * Only matrices without rotation or skew are matched this way.
+   *
+   * @param tolerance how far the scales may differ, e.g. 0.25 for 25%. Zero
+   *        disables the matching.
+   * @param build_mipmaps whether to attach mip levels to the cached images so
+   *        that they are sampled smoothly when drawn scaled down. They take a
+   *        third more memory.
+   */
+  void SetScaleTolerance(float tolerance, bool build_mipmaps = false);
+
+  float GetScaleTolerance() const { return scale_tolerance_; }
+
+  /**
+   * @brief Let one more compositor context draw its frames with this cache.
+   *
+   * Every compositor context sweeps the cache after each of its own frames,
+   * so with more than one of them a frame no longer ends at every sweep. An
+   * entry is then only considered unused once it went unused for as many
+   * consecutive sweeps as there are users, which keeps the entries of one
+   * user alive across the sweeps of the others.
+   */
+  void AddUser() { user_count_++; }
+
+  void RemoveUser() {
+    FML_DCHECK(user_count_ > 0);
+    user_count_--;
+  }
+
+  size_t GetUserCount() const { return user_count_; }
+
+  /**
+   * @brief Rasterize picture cache candidates on another task runner instead
+   * of during the Preroll of the frame that first finds them worth caching.
+   *
+   * Once a picture reaches the access threshold, it is recorded into a CPU
+   * backed image on |task_runner| and, while GPU access is allowed, uploaded
+   * using |resource_context| so that it can be drawn from the raster thread.
+   * Until that work completes, Prepare returns false and the picture is drawn
+   * directly. The cache entry becomes usable in the first Prepare after the
+   * rasterization finished.
+   *
+   * Layer cache entries are still rasterized synchronously as they need the
+   * PrerollContext of the current frame.
+   *
+   * @param task_runner the task runner to rasterize on. Typically the IO task
+   *        runner. Passing nullptr disables asynchronous rasterization.
+   * @param resource_context the context used to upload the rasterized image.
+   *        It is only dereferenced on |task_runner|. If it is not valid, the
+   *        CPU backed image is cached and uploaded when first drawn.
+   * @param is_gpu_disabled_sync_switch guards the use of |resource_context|.
+   */
+  void EnableAsyncPictureRasterization(
+      fml::RefPtr<fml::TaskRunner> task_runner,
+      fml::WeakPtr<GrDirectContext> resource_context,
+      std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch);
+
+  bool IsAsyncPictureRasterizationEnabled() const {
+    return async_task_runner_ != nullptr;
+  }
+
+  /**
+   * @brief Let pictures be drawn from the images that earlier launches stored
+   * in persistent_cache, and store the images of the pictures this cache
+   * rasterizes in it.
+   *
+   * A picture whose image is stored is loaded on its first Prepare that finds
+   * it worth rasterizing, without waiting for the access threshold. Loads
+   * count towards the limit of pictures cached per frame. Display lists, and
+   * pictures that draw images, are not stored.
+   *
+   * @param persistent_cache the images stored across launches. Passing
+   *        nullptr stops using it.
+   */
+  void EnablePersistentPictureCache(
+      std::shared_ptr<PersistentRasterCache> persistent_cache);
+
+  const std::shared_ptr<PersistentRasterCache>& GetPersistentPictureCache()
+      const {
+    return persistent_cache_;
+  }
+
   size_t GetCachedEntriesCount() const;
 
   size_t GetLayerCachedEntriesCount() const;
 
   size_t GetPictureCachedEntriesCount() const;
 
+  size_t GetShadowCachedEntriesCount() const;
+
+  // The number of preparations so far that may come to a different result if
+  // they are repeated in a later frame, e.g. because the access threshold was
+  // not reached yet or the rasterization is still pending.
+  size_t GetUnsettledPreparationCount() const {
+    return unsettled_preparation_count_;
+  }
+
+  // The number of cached images that were evicted or cleared so far.
+  size_t GetEvictedImageCount() const { return evicted_image_count_; }
+
+  // The number of calls to Draw and DrawShadow so far that found an image to
+  // draw, and the number of the ones that did not.
+  size_t GetDrawHitCount() const { return draw_hit_count_; }
+  size_t GetDrawMissCount() const { return draw_miss_count_; }
+
   /**
    * @brief Estimate how much memory is used by picture raster cache entries in
    * bytes.
@@ -180,7 +447,7 @@ class RasterCache {
 
   /**
    * @brief Estimate how much memory is used by layer raster cache entries in
-   * bytes.
+   * bytes, including the layer outputs retained in the last frame.
    *
    * Only SkImage's memory usage is counted as other objects are often much
    * smaller compared to SkImage. SkImageInfo::computeMinByteSize is used to
@@ -189,34 +456,253 @@ class RasterCache {
   size_t EstimateLayerCacheByteSize() const;
 
  private:
+  // The result of an asynchronous rasterization. This is shared between the
+  // raster thread and the task runner the rasterization was posted to.
+  struct PendingRasterization {
+    std::mutex mutex;
+    bool done = false;
+    std::unique_ptr<RasterCacheResult> result;
+  };
+
   struct Entry {
     bool used_this_frame = false;
+    // The number of consecutive sweeps this entry went unused in.
+    size_t unused_sweeps = 0;
     size_t access_count = 0;
+    // The value of |frame_count_| when this entry was last used.
+    size_t last_used_frame = 0;
     std::unique_ptr<RasterCacheResult> image;
+    // Set while |image| is being rasterized asynchronously.
+    std::shared_ptr<PendingRasterization> pending;
+    // Whether |persistent_key| was computed. It is unset for pictures that
+    // can not be stored in |persistent_cache_|.
+    bool persistent_key_computed = false;
+    std::optional<uint64_t> persistent_key;
+  };
+
+  // The average time drawing a picture directly took.
+  struct DrawTime {
+    fml::TimeDelta average;
+    bool used_this_frame = false;
+    size_t unused_sweeps = 0;
   };
 
+  // An unused entry that may be evicted by the byte-budgeted sweep.
+  struct EvictionCandidate {
+    size_t last_used_frame;
+    size_t bytes;
+    std::function<void()> evict;
+  };
+
+  // Resets the usage of |entry| for the next frame and returns whether it
+  // has now gone unused for |sweeps_to_evict| consecutive sweeps.
+  template <class T>
+  static bool SweepUsage(T& entry, size_t sweeps_to_evict) {
+    entry.unused_sweeps = entry.used_this_frame ? 0 : entry.unused_sweeps + 1;
+    entry.used_this_frame = false;
+    return entry.unused_sweeps >= sweeps_to_evict;
+  }
+
+  // Evicts the entries of |cache| that went unused for |sweeps_to_evict|
+  // sweeps and returns how many of them held an image.
   template <class Cache>
-  static void SweepOneCacheAfterFrame(Cache& cache) {
+  static size_t SweepOneCacheAfterFrame(Cache& cache, size_t sweeps_to_evict) {
     std::vector<typename Cache::iterator> dead;
+    size_t evicted_images = 0;
 
     for (auto it = cache.begin(); it != cache.end(); ++it) {
       Entry& entry = it->second;
-      if (!entry.used_this_frame) {
+      if (SweepUsage(entry, sweeps_to_evict)) {
         dead.push_back(it);
+        if (entry.image) {
+          evicted_images++;
+        }
+      }
+    }
+
+    for (auto it : dead) {
+      cache.erase(it);
+    }
+    return evicted_images;
+  }
+
+  // Resets the per-frame usage of every entry in |cache| and returns the total
+  // size of the images it retains. Entries that were not used this frame but
+  // still hold an image are appended to |candidates|. Entries without an image
+  // only track the access count and are dropped once they went unused for
+  // |sweeps_to_evict| sweeps.
+  template <class Cache>
+  static size_t CollectEvictionCandidates(
+      Cache& cache,
+      size_t sweeps_to_evict,
+      std::vector<EvictionCandidate>& candidates) {
+    std::vector<typename Cache::iterator> dead;
+    size_t retained_bytes = 0;
+
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+      Entry& entry = it->second;
+      size_t bytes = entry.image ? entry.image->image_bytes() : 0;
+      const bool used_this_frame = entry.used_this_frame;
+      const bool stale = SweepUsage(entry, sweeps_to_evict);
+      if (!entry.image) {
+        if (stale) {
+          dead.push_back(it);
+        }
+        continue;
+      }
+      if (!used_this_frame) {
+        candidates.push_back({entry.last_used_frame, bytes,
+                              [&cache, it]() { cache.erase(it); }});
       }
-      entry.used_this_frame = false;
+      retained_bytes += bytes;
     }
 
     for (auto it : dead) {
       cache.erase(it);
     }
+    return retained_bytes;
+  }
+
+  // Appends every entry of |cache| that holds an image to |candidates| and
+  // returns the total size of those images.
+  template <class Cache>
+  static size_t CollectImageEntries(
+      Cache& cache,
+      std::vector<EvictionCandidate>& candidates) {
+    size_t retained_bytes = 0;
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+      const Entry& entry = it->second;
+      if (!entry.image) {
+        continue;
+      }
+      const size_t bytes = entry.image->image_bytes();
+      candidates.push_back({entry.last_used_frame, bytes,
+                            [&cache, it]() { cache.erase(it); }});
+      retained_bytes += bytes;
+    }
+    return retained_bytes;
+  }
+
+  // Evicts |candidates|, least recently used first, until no more than
+  // |max_bytes| of the |retained_bytes| are left.
+  void EvictLeastRecentlyUsed(std::vector<EvictionCandidate>& candidates,
+                              size_t retained_bytes,
+                              size_t max_bytes);
+
+  void SweepWithinBudgetAfterFrame();
+
+  // The Prepare of pictures and display lists, which are both cached by
+  // their unique ids.
+  template <typename Picture>
+  bool PreparePicture(GrDirectContext* context,
+                      Picture* picture,
+                      const SkMatrix& transformation_matrix,
+                      SkColorSpace* dst_color_space,
+                      bool is_complex,
+                      bool will_change);
+
+  std::unique_ptr<RasterCacheResult> RasterizeEntry(
+      SkPicture* picture,
+      GrDirectContext* context,
+      const SkMatrix& ctm,
+      SkColorSpace* dst_color_space) const;
+
+  std::unique_ptr<RasterCacheResult> RasterizeEntry(
+      DisplayList* display_list,
+      GrDirectContext* context,
+      const SkMatrix& ctm,
+      SkColorSpace* dst_color_space) const;
+
+  bool DrawPicture(uint64_t picture_id,
+                   SkCanvas& canvas,
+                   SkPaint* paint) const;
+
+  // Draws the image of |key| in |cache|, or else the one of the closest
+  // entry FindScaledEntry finds.
+  bool DrawEntry(PictureRasterCacheKey::Map<Entry>& cache,
+                 const PictureRasterCacheKey& key,
+                 SkCanvas& canvas,
+                 const SkPaint* paint) const;
+
+  // Finds the entry of the id of |key| with an image whose scale is closest to
+  // the one of |key| within the scale tolerance, or returns the end of
+  // |cache|.
+  PictureRasterCacheKey::Map<Entry>::iterator FindScaledEntry(
+      PictureRasterCacheKey::Map<Entry>& cache,
+      const PictureRasterCacheKey& key) const;
+
+  // Whether any entry of the id of |key| holds an image.
+  static bool HasImageOfId(PictureRasterCacheKey::Map<Entry>& cache,
+                           const PictureRasterCacheKey& key);
+
+  void RecordPictureDrawTime(uint64_t picture_id,
+                             const SkMatrix& matrix,
+                             fml::TimeDelta draw_time) const;
+
+  // Either dispatches |draw_picture|, which draws the picture within
+  // |logical_rect|, to |async_task_runner_| or moves the finished result of
+  // an earlier dispatch into |entry|. Returns true when |entry| holds an
+  // image.
+  bool PrepareAsync(Entry& entry,
+                    const SkRect& logical_rect,
+                    std::function<void(SkCanvas*)> draw_picture,
+                    const SkMatrix& transformation_matrix,
+                    SkColorSpace* dst_color_space);
+
+  // Moves the image of |picture| stored in |persistent_cache_| into |entry|,
+  // if there is one. Returns true when |entry| holds an image. Pictures are
+  // only looked up once they were drawn in an earlier frame, as computing
+  // their key serializes them.
+  bool LoadPersistentEntry(Entry& entry,
+                           GrDirectContext* context,
+                           const SkPicture& picture,
+                           const SkMatrix& transformation_matrix,
+                           SkColorSpace* dst_color_space);
+
+  // Stores the image of |picture| in |persistent_cache_| once |entry| holds
+  // one.
+  void StorePersistentEntry(Entry& entry,
+                            SkPicture* picture,
+                            const SkMatrix& transformation_matrix,
+                            SkColorSpace* dst_color_space);
+
+  // The key of |picture| in |persistent_cache_|, which is computed the first
+  // time it is needed.
+  static const std::optional<uint64_t>& GetPersistentKey(
+      Entry& entry,
+      const SkPicture& picture,
+      const SkMatrix& transformation_matrix,
+      SkColorSpace* dst_color_space);
+
+  void MarkUsed(Entry& entry) const {
+    entry.used_this_frame = true;
+    entry.last_used_frame = frame_count_;
   }
 
   const size_t access_threshold_;
   const size_t picture_cache_limit_per_frame_;
   size_t picture_cached_this_frame_ = 0;
+  size_t max_cache_bytes_ = 0;
+  float scale_tolerance_ = 0;
+  bool scale_mipmaps_ = false;
+  size_t frame_count_ = 0;
+  size_t user_count_ = 1;
+  size_t unsettled_preparation_count_ = 0;
+  size_t evicted_image_count_ = 0;
+  mutable size_t draw_hit_count_ = 0;
+  mutable size_t draw_miss_count_ = 0;
+  // The bytes of the layer outputs retained during the current frame, and
+  // during the last frame that ended.
+  mutable size_t layer_output_bytes_ = 0;
+  size_t retained_layer_output_bytes_ = 0;
+  fml::RefPtr<fml::TaskRunner> async_task_runner_;
+  fml::WeakPtr<GrDirectContext> async_resource_context_;
+  std::shared_ptr<const fml::SyncSwitch> async_is_gpu_disabled_sync_switch_;
+  std::shared_ptr<PersistentRasterCache> persistent_cache_;
   mutable PictureRasterCacheKey::Map<Entry> picture_cache_;
   mutable LayerRasterCacheKey::Map<Entry> layer_cache_;
+  mutable ShadowRasterCacheKey::Map<Entry> shadow_cache_;
+  mutable PictureRasterCacheKey::Map<DrawTime> picture_draw_times_;
   bool checkerboard_images_;
 
   void TraceStatsToTimeline() const;
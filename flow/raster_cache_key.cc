@@ -4,8 +4,44 @@
 
 #include "flutter/flow/raster_cache_key.h"
 
+#include "flutter/fml/hash_combine.h"
+
 namespace flutter {
 
-//
+ShadowRasterCacheKey::ShadowRasterCacheKey(const SkPath& path,
+                                           SkColor color,
+                                           float elevation,
+                                           bool transparent_occluder,
+                                           float dpr,
+                                           const SkMatrix& ctm)
+    : path_(path),
+      color_(color),
+      elevation_(elevation),
+      transparent_occluder_(transparent_occluder),
+      dpr_(dpr),
+      matrix_(ctm) {}
+
+size_t ShadowRasterCacheKey::Hash::operator()(
+    const ShadowRasterCacheKey& key) const {
+  // Only use properties of the path that are cached, so that paths recreated
+  // with the same contents every frame hash to the same bucket.
+  const SkRect& bounds = key.path_.getBounds();
+  return fml::HashCombine(bounds.fLeft, bounds.fTop, bounds.fRight,
+                          bounds.fBottom, key.color_, key.elevation_,
+                          key.matrix_.getTranslateX(),
+                          key.matrix_.getTranslateY());
+}
+
+bool ShadowRasterCacheKey::Equal::operator()(
+    const ShadowRasterCacheKey& lhs,
+    const ShadowRasterCacheKey& rhs) const {
+  // Paths sharing the same generation ID are known to be equal without
+  // comparing their points.
+  return lhs.color_ == rhs.color_ && lhs.elevation_ == rhs.elevation_ &&
+         lhs.transparent_occluder_ == rhs.transparent_occluder_ &&
+         lhs.dpr_ == rhs.dpr_ && lhs.matrix_ == rhs.matrix_ &&
+         (lhs.path_.getGenerationID() == rhs.path_.getGenerationID() ||
+          lhs.path_ == rhs.path_);
+}
 
 }  // namespace flutter
@@ -9,6 +9,8 @@
 
 #include "flutter/flow/matrix_decomposition.h"
 #include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "third_party/skia/include/core/SkPath.h"
 
 namespace flutter {
 
@@ -49,14 +51,58 @@ class RasterCacheKey {
   SkMatrix matrix_;
 };
 
-// The ID is the uint32_t picture uniqueID
-using PictureRasterCacheKey = RasterCacheKey<uint32_t>;
+// The ID is the uint32_t picture uniqueID or the DisplayList unique_id, which
+// starts above the range of picture ids.
+using PictureRasterCacheKey = RasterCacheKey<uint64_t>;
 
 class Layer;
 
 // The ID is the uint64_t layer unique_id
 using LayerRasterCacheKey = RasterCacheKey<uint64_t>;
 
+// Identifies the shadow that PhysicalShapeLayer::DrawShadow draws for a path.
+//
+// Unlike the other keys, the translation of the matrix is kept because the
+// light of a shadow is positioned in device space, so the same path casts a
+// different shadow at a different position on the screen.
+class ShadowRasterCacheKey {
+ public:
+  ShadowRasterCacheKey(const SkPath& path,
+                       SkColor color,
+                       float elevation,
+                       bool transparent_occluder,
+                       float dpr,
+                       const SkMatrix& ctm);
+
+  const SkPath& path() const { return path_; }
+  SkColor color() const { return color_; }
+  float elevation() const { return elevation_; }
+  bool transparent_occluder() const { return transparent_occluder_; }
+  float dpr() const { return dpr_; }
+  const SkMatrix& matrix() const { return matrix_; }
+
+  struct Hash {
+    size_t operator()(const ShadowRasterCacheKey& key) const;
+  };
+
+  struct Equal {
+    bool operator()(const ShadowRasterCacheKey& lhs,
+                    const ShadowRasterCacheKey& rhs) const;
+  };
+
+  template <class Value>
+  using Map = std::unordered_map<ShadowRasterCacheKey, Value, Hash, Equal>;
+
+ private:
+  // Copying a path shares its points, so this is cheap.
+  SkPath path_;
+  SkColor color_;
+  float elevation_;
+  bool transparent_occluder_;
+  float dpr_;
+  SkMatrix matrix_;
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_RASTER_CACHE_KEY_H_
@@ -4,7 +4,11 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkPicture.h"
@@ -24,6 +28,18 @@ sk_sp<SkPicture> GetSamplePicture() {
   return recorder.finishRecordingAsPicture();
 }
 
+sk_sp<SkPicture> GetPictureWithManyOps() {
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(150, 100));
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  for (int i = 0; i < 10; i++) {
+    recorder.getRecordingCanvas()->drawRect(
+        SkRect::MakeXYWH(10 * i, 10, 10, 80), paint);
+  }
+  return recorder.finishRecordingAsPicture();
+}
+
 }  // namespace
 
 TEST(RasterCache, SimpleInitialization) {
@@ -65,6 +81,66 @@ TEST(RasterCache, ThresholdIsRespected) {
   ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
 }
 
+TEST(RasterCache, SlowToDrawPictureIsCachedDespiteFewOps) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  // Without a measured draw time a single op is not worth rasterizing.
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false, false));
+  cache.RecordPictureDrawTime(*picture, matrix,
+                              fml::TimeDelta::FromMilliseconds(1));
+  cache.SweepAfterFrame();
+
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  cache.RecordPictureDrawTime(*picture, matrix,
+                              fml::TimeDelta::FromMilliseconds(1));
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, FastToDrawPictureIsNotCachedDespiteManyOps) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetPictureWithManyOps();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (int i = 0; i < 3; i++) {
+    cache.RecordPictureDrawTime(*picture, matrix,
+                                fml::TimeDelta::FromMicroseconds(1));
+    ASSERT_FALSE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false, false));
+    ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+    cache.SweepAfterFrame();
+  }
+
+  // Once the draw time is no longer recorded, the op count decides again.
+  cache.SweepAfterFrame();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false, false));
+}
+
 TEST(RasterCache, AccessThresholdOfZeroDisablesCaching) {
   size_t threshold = 0;
   flutter::RasterCache cache(threshold);
@@ -132,6 +208,449 @@ TEST(RasterCache, SweepsRemoveUnusedFrames) {
   ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
 }
 
+TEST(RasterCache, SweepsOfOtherUsersDoNotRemoveEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.AddUser();
+  ASSERT_EQ(cache.GetUserCount(), 2u);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                             false));  // 1
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();  // The frame of the other user.
+
+  ASSERT_TRUE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                            false));  // 2
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();  // The frame of the other user.
+
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  // Once both users swept without an access, the entry is evicted.
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();
+
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  cache.RemoveUser();
+  ASSERT_EQ(cache.GetUserCount(), 1u);
+}
+
+TEST(RasterCache, ByteBudgetRetainsUnusedEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxCacheBytes(1024 * 1024);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                             false));  // 1
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                            false));  // 2
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+
+  // Frames without an access no longer evict the entry while it fits in the
+  // budget.
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();
+
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, ByteBudgetEvictsLeastRecentlyUsedFirst) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxCacheBytes(1024 * 1024);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto old_picture = GetSamplePicture();
+  auto new_picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (auto* picture : {old_picture.get(), new_picture.get()}) {
+    ASSERT_FALSE(
+        cache.Prepare(NULL, picture, matrix, srgb.get(), true, false));
+    ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  }
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, old_picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*old_picture, dummy_canvas));
+  // Keep the access count of the second picture alive.
+  ASSERT_FALSE(cache.Draw(*new_picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, new_picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*new_picture, dummy_canvas));
+
+  // Leave room for exactly one of the two entries.
+  cache.SetMaxCacheBytes(cache.EstimatePictureCacheByteSize() / 2);
+  cache.SweepAfterFrame();
+
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+  ASSERT_FALSE(cache.Draw(*old_picture, dummy_canvas));
+  ASSERT_TRUE(cache.Draw(*new_picture, dummy_canvas));
+}
+
+TEST(RasterCache, LayerOutputsShareTheByteBudget) {
+  flutter::RasterCache cache;
+
+  // Without a budget every output is retained.
+  ASSERT_TRUE(cache.RetainLayerOutput(1024 * 1024));
+  ASSERT_EQ(cache.EstimateLayerCacheByteSize(), 0u);
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.EstimateLayerCacheByteSize(), 1024u * 1024u);
+
+  // The outputs retained in the last frame are not counted twice.
+  cache.SetMaxCacheBytes(1536 * 1024);
+  ASSERT_TRUE(cache.RetainLayerOutput(1024 * 1024));
+  ASSERT_FALSE(cache.RetainLayerOutput(1024 * 1024));
+  ASSERT_TRUE(cache.RetainLayerOutput(512 * 1024));
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.EstimateLayerCacheByteSize(), 1536u * 1024u);
+
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.EstimateLayerCacheByteSize(), 0u);
+}
+
+TEST(RasterCache, TrimEvictsLeastRecentlyUsedEntriesFirst) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxCacheBytes(1024 * 1024);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto old_picture = GetSamplePicture();
+  auto new_picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (auto* picture : {old_picture.get(), new_picture.get()}) {
+    ASSERT_FALSE(
+        cache.Prepare(NULL, picture, matrix, srgb.get(), true, false));
+    ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  }
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, old_picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*new_picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, new_picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*new_picture, dummy_canvas));
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 2u);
+
+  cache.Trim(cache.EstimatePictureCacheByteSize() / 2);
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+  ASSERT_FALSE(cache.Draw(*old_picture, dummy_canvas));
+  ASSERT_TRUE(cache.Draw(*new_picture, dummy_canvas));
+
+  // Unlike the sweep, trimming also evicts the entries used this frame.
+  cache.Trim(0);
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, RestoredWarmStateSkipsTheAccessThreshold) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto cached_picture = GetSamplePicture();
+  auto other_picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (int i = 0; i < 3; i++) {
+    cache.Prepare(NULL, cached_picture.get(), matrix, srgb.get(), true, false);
+    cache.Draw(*cached_picture, dummy_canvas);
+    cache.Prepare(NULL, other_picture.get(), matrix, srgb.get(), true, false);
+    cache.SweepAfterFrame();
+  }
+  ASSERT_TRUE(cache.Prepare(NULL, cached_picture.get(), matrix, srgb.get(),
+                            true, false));
+
+  flutter::RasterCache::WarmState state = cache.GetWarmState();
+  ASSERT_EQ(state.pictures.size(), 1u);
+  cache.Clear();
+
+  cache.RestoreWarmState(state);
+  ASSERT_TRUE(cache.Prepare(NULL, cached_picture.get(), matrix, srgb.get(),
+                            true, false));
+  ASSERT_TRUE(cache.Draw(*cached_picture, dummy_canvas));
+  ASSERT_FALSE(cache.Prepare(NULL, other_picture.get(), matrix, srgb.get(),
+                             true, false));
+}
+
+TEST(RasterCache, AsyncRasterizationBecomesUsableOnALaterFrame) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  fml::Thread worker("worker");
+  auto worker_task_runner = worker.GetTaskRunner();
+  cache.EnableAsyncPictureRasterization(worker_task_runner, {}, nullptr);
+  ASSERT_TRUE(cache.IsAsyncPictureRasterizationEnabled());
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                             false));  // 1
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  cache.SweepAfterFrame();
+
+  // The rasterization is dispatched, the picture is drawn directly.
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                             false));  // 2
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  cache.SweepAfterFrame();
+
+  // Tasks on the worker run in order, so the rasterization is done once this
+  // task has run.
+  fml::AutoResetWaitableEvent latch;
+  worker_task_runner->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  ASSERT_TRUE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                            false));  // 3
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_GT(cache.EstimatePictureCacheByteSize(), 0u);
+}
+
+TEST(RasterCache, PersistentRasterCacheKeyIsTheSameForEqualPictures) {
+  auto picture = GetSamplePicture();
+  auto equal_picture = GetSamplePicture();
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  auto key = flutter::PersistentRasterCache::ComputeKey(
+      *picture, SkMatrix::Scale(2, 2), srgb.get());
+  ASSERT_TRUE(key.has_value());
+
+  // Integral translations draw the same image.
+  SkMatrix translated = SkMatrix::Scale(2, 2);
+  translated.postTranslate(10, 20);
+  ASSERT_EQ(flutter::PersistentRasterCache::ComputeKey(*equal_picture,
+                                                       translated, srgb.get()),
+            key);
+
+  ASSERT_NE(flutter::PersistentRasterCache::ComputeKey(
+                *picture, SkMatrix::Scale(3, 3), srgb.get()),
+            key);
+  ASSERT_NE(flutter::PersistentRasterCache::ComputeKey(
+                *picture, SkMatrix::Scale(2, 2), nullptr),
+            key);
+  ASSERT_NE(flutter::PersistentRasterCache::ComputeKey(
+                *GetPictureWithManyOps(), SkMatrix::Scale(2, 2), srgb.get()),
+            key);
+}
+
+TEST(RasterCache, PictureDrawingAnImageHasNoPersistentRasterCacheKey) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(10, 10);
+  bitmap.eraseColor(SK_ColorBLUE);
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(150, 100));
+  recorder.getRecordingCanvas()->drawImage(bitmap.asImage(), 0, 0);
+  auto picture = recorder.finishRecordingAsPicture();
+
+  auto key = flutter::PersistentRasterCache::ComputeKey(*picture,
+                                                        SkMatrix::I(), nullptr);
+  ASSERT_FALSE(key.has_value());
+}
+
+TEST(RasterCache, PersistedPictureIsLoadedBeforeTheAccessThreshold) {
+  for (bool compress : {false, true}) {
+    fml::ScopedTemporaryDirectory temp_dir;
+    auto directory = std::make_shared<fml::UniqueFD>(
+        fml::OpenDirectory(temp_dir.path().c_str(), false,
+                           fml::FilePermission::kReadWrite));
+    fml::Thread worker("worker");
+    auto worker_task_runner = worker.GetTaskRunner();
+
+    SkMatrix matrix = SkMatrix::I();
+    SkCanvas dummy_canvas;
+    sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+    {
+      size_t threshold = 1;
+      flutter::RasterCache cache(threshold);
+      cache.EnablePersistentPictureCache(
+          std::make_shared<flutter::PersistentRasterCache>(
+              directory, worker_task_runner, compress));
+
+      auto picture = GetSamplePicture();
+      ASSERT_FALSE(
+          cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+      ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+      cache.SweepAfterFrame();
+      ASSERT_TRUE(
+          cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+
+      fml::AutoResetWaitableEvent latch;
+      worker_task_runner->PostTask([&latch]() { latch.Signal(); });
+      latch.Wait();
+      ASSERT_EQ(cache.GetPersistentPictureCache()->GetEntryCount(), 1u);
+    }
+
+    // A later launch records the picture anew, with another unique id.
+    size_t threshold = 3;
+    flutter::RasterCache cache(threshold);
+    cache.EnablePersistentPictureCache(
+        std::make_shared<flutter::PersistentRasterCache>(
+            directory, worker_task_runner, compress));
+    ASSERT_EQ(cache.GetPersistentPictureCache()->GetEntryCount(), 1u);
+
+    // The stored image is looked for once the picture was drawn before.
+    auto picture = GetSamplePicture();
+    ASSERT_FALSE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+    ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+    cache.SweepAfterFrame();
+    ASSERT_TRUE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+    ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+
+    // Pictures that were not stored still wait for the access threshold.
+    auto other_picture = GetPictureWithManyOps();
+    ASSERT_FALSE(cache.Prepare(NULL, other_picture.get(), matrix, srgb.get(),
+                               true, false));
+  }
+}
+
+TEST(RasterCache, ImageAtNearbyScaleIsDrawnWithinTolerance) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetScaleTolerance(0.25);
+
+  auto picture = GetSamplePicture();
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  SkCanvas dummy_canvas;
+
+  auto prepare_and_draw = [&](SkScalar scale) {
+    SkMatrix matrix = SkMatrix::Scale(scale, scale);
+    dummy_canvas.setMatrix(matrix);
+    bool prepared =
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false);
+    bool drawn = cache.Draw(*picture, dummy_canvas);
+    cache.SweepAfterFrame();
+    return prepared && drawn;
+  };
+
+  ASSERT_FALSE(prepare_and_draw(1));  // 1
+  ASSERT_TRUE(prepare_and_draw(1));   // 2
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+
+  // The image at a scale of 1 is drawn scaled.
+  ASSERT_TRUE(prepare_and_draw(1.2));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 150u * 100u * 4u);
+
+  // Outside of the tolerance, the picture is rasterized at its scale right
+  // away rather than after the access threshold.
+  ASSERT_TRUE(prepare_and_draw(2));
+  ASSERT_GT(cache.EstimatePictureCacheByteSize(), 150u * 100u * 4u);
+}
+
+TEST(RasterCache, ImageAtNearbyScaleIsNotDrawnWithoutTolerance) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  auto picture = GetSamplePicture();
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  SkCanvas dummy_canvas;
+
+  SkMatrix matrix = SkMatrix::I();
+  cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false);
+  cache.Draw(*picture, dummy_canvas);
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  SkMatrix scaled = SkMatrix::Scale(1.1, 1.1);
+  dummy_canvas.setMatrix(scaled);
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), scaled, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  // Nor is it drawn rotated with a tolerance.
+  cache.SetScaleTolerance(0.25);
+  SkMatrix rotated = SkMatrix::RotateDeg(5);
+  dummy_canvas.setMatrix(rotated);
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), rotated, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, SettledScaleIsRasterizedAtItsOwnScale) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+  cache.SetScaleTolerance(0.25);
+
+  auto picture = GetSamplePicture();
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  SkCanvas dummy_canvas;
+
+  for (int i = 0; i < 3; i++) {
+    cache.Prepare(NULL, picture.get(), SkMatrix::I(), srgb.get(), true, false);
+    cache.Draw(*picture, dummy_canvas);
+    cache.SweepAfterFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 150u * 100u * 4u);
+
+  // While the scale stays the same, its entry reaches the access threshold and
+  // replaces the image at the other scale.
+  SkMatrix scaled = SkMatrix::Scale(1.125, 1.125);
+  dummy_canvas.setMatrix(scaled);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(
+        cache.Prepare(NULL, picture.get(), scaled, srgb.get(), true, false));
+    ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+    cache.SweepAfterFrame();
+  }
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 169u * 113u * 4u);
+}
+
 // Construct a cache result whose device target rectangle rounds out to be one
 // pixel wider than the cached image.  Verify that it can be drawn without
 // triggering any assertions.
@@ -164,5 +683,125 @@ TEST(RasterCache, DeviceRectRoundOut) {
   ASSERT_TRUE(cache.Draw(*picture, canvas));
 }
 
+namespace {
+
+// Draws a flat shadow of |key|'s path offset by |device_offset|.
+void DrawSampleShadow(const ShadowRasterCacheKey& key,
+                      SkCanvas* canvas,
+                      const SkPoint& device_offset) {
+  SkPaint paint;
+  paint.setColor(key.color());
+  canvas->drawPath(key.path().makeOffset(device_offset.fX, device_offset.fY),
+                   paint);
+}
+
+bool PrepareSampleShadow(RasterCache& cache, const ShadowRasterCacheKey& key) {
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  return cache.PrepareShadow(
+      NULL, key, key.path().getBounds().makeOutset(10, 10), srgb.get(),
+      [&key](SkCanvas* canvas, const SkPoint& device_offset) {
+        DrawSampleShadow(key, canvas, device_offset);
+      });
+}
+
+}  // namespace
+
+TEST(RasterCache, ShadowThresholdIsRespected) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::Translate(20, 30);
+  ShadowRasterCacheKey key(SkPath::Rect(SkRect::MakeXYWH(10, 10, 80, 80)),
+                           SK_ColorBLACK, 4, false, 2, matrix);
+  SkCanvas canvas(200, 200, nullptr);
+  canvas.setMatrix(matrix);
+
+  // 1st access.
+  ASSERT_FALSE(PrepareSampleShadow(cache, key));
+  ASSERT_FALSE(cache.DrawShadow(key, canvas));
+  cache.SweepAfterFrame();
+
+  // 2nd access.
+  ASSERT_FALSE(PrepareSampleShadow(cache, key));
+  ASSERT_FALSE(cache.DrawShadow(key, canvas));
+  cache.SweepAfterFrame();
+
+  // Now PrepareShadow should cache it.
+  ASSERT_TRUE(PrepareSampleShadow(cache, key));
+  ASSERT_TRUE(cache.DrawShadow(key, canvas));
+  ASSERT_EQ(cache.GetShadowCachedEntriesCount(), 1u);
+}
+
+TEST(RasterCache, ShadowOfEqualPathIsFoundInCache) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkRect rect = SkRect::MakeXYWH(10, 10, 80, 80);
+  ShadowRasterCacheKey key(SkPath::Rect(rect), SK_ColorBLACK, 4, false, 2,
+                           matrix);
+  SkCanvas canvas(200, 200, nullptr);
+
+  ASSERT_FALSE(PrepareSampleShadow(cache, key));
+  ASSERT_FALSE(cache.DrawShadow(key, canvas));
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(PrepareSampleShadow(cache, key));
+
+  // The framework creates a new path in every frame.
+  ShadowRasterCacheKey equal_key(SkPath::Rect(rect), SK_ColorBLACK, 4, false,
+                                 2, matrix);
+  ASSERT_NE(equal_key.path().getGenerationID(), key.path().getGenerationID());
+  ASSERT_TRUE(cache.DrawShadow(equal_key, canvas));
+
+  ShadowRasterCacheKey other_elevation_key(SkPath::Rect(rect), SK_ColorBLACK,
+                                           8, false, 2, matrix);
+  ASSERT_FALSE(cache.DrawShadow(other_elevation_key, canvas));
+  ShadowRasterCacheKey other_path_key(SkPath::Rect(rect.makeOutset(1, 1)),
+                                      SK_ColorBLACK, 4, false, 2, matrix);
+  ASSERT_FALSE(cache.DrawShadow(other_path_key, canvas));
+}
+
+TEST(RasterCache, ShadowAtOtherTranslationIsNotFoundInCache) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkPath path = SkPath::Rect(SkRect::MakeXYWH(10, 10, 80, 80));
+  ShadowRasterCacheKey key(path, SK_ColorBLACK, 4, false, 2, SkMatrix::I());
+  SkCanvas canvas(200, 200, nullptr);
+
+  ASSERT_FALSE(PrepareSampleShadow(cache, key));
+  ASSERT_FALSE(cache.DrawShadow(key, canvas));
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(PrepareSampleShadow(cache, key));
+  ASSERT_TRUE(cache.DrawShadow(key, canvas));
+
+  // The light is positioned in device space, so a shadow that moved on the
+  // screen looks different.
+  ShadowRasterCacheKey moved_key(path, SK_ColorBLACK, 4, false, 2,
+                                 SkMatrix::Translate(0.5, 0));
+  ASSERT_FALSE(cache.DrawShadow(moved_key, canvas));
+}
+
+TEST(RasterCache, SweepsRemoveUnusedShadows) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  ShadowRasterCacheKey key(SkPath::Rect(SkRect::MakeXYWH(10, 10, 80, 80)),
+                           SK_ColorBLACK, 4, false, 2, SkMatrix::I());
+  SkCanvas canvas(200, 200, nullptr);
+
+  ASSERT_FALSE(PrepareSampleShadow(cache, key));
+  ASSERT_FALSE(cache.DrawShadow(key, canvas));
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(PrepareSampleShadow(cache, key));
+  ASSERT_TRUE(cache.DrawShadow(key, canvas));
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetShadowCachedEntriesCount(), 1u);
+
+  // The shadow was not used during this frame.
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetShadowCachedEntriesCount(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -21,32 +21,113 @@ SkiaUnrefQueue::~SkiaUnrefQueue() {
   FML_DCHECK(objects_.empty());
 }
 
-void SkiaUnrefQueue::Unref(SkRefCnt* object) {
+void SkiaUnrefQueue::Unref(SkRefCnt* object, size_t bytes) {
   std::scoped_lock lock(mutex_);
-  objects_.push_back(object);
+  objects_.push_back({object, bytes});
+  pending_bytes_ += bytes;
   if (!drain_pending_) {
     drain_pending_ = true;
-    task_runner_->PostDelayedTask(
-        [strong = fml::Ref(this)]() { strong->Drain(); }, drain_delay_);
+    // Draining a little later is harmless, so the wakeup may be coalesced.
+    task_runner_->PostDelayedTaskWithLeeway(
+        [strong = fml::Ref(this)]() { strong->DrainBatch(); }, drain_delay_,
+        drain_delay_);
   }
 }
 
 void SkiaUnrefQueue::Drain() {
   TRACE_EVENT0("flutter", "SkiaUnrefQueue::Drain");
-  std::deque<SkRefCnt*> skia_objects;
+  std::deque<PendingObject> skia_objects;
   {
     std::scoped_lock lock(mutex_);
     objects_.swap(skia_objects);
+    pending_bytes_ = 0;
     drain_pending_ = false;
   }
 
-  for (SkRefCnt* skia_object : skia_objects) {
-    skia_object->unref();
+  for (const PendingObject& skia_object : skia_objects) {
+    skia_object.object->unref();
   }
 
   if (context_ && skia_objects.size() > 0) {
     context_->performDeferredCleanup(std::chrono::milliseconds(0));
   }
+  TraceCountersToTimeline();
+}
+
+void SkiaUnrefQueue::NotifyIdle(fml::TimePoint deadline) {
+  {
+    std::scoped_lock lock(mutex_);
+    if (objects_.empty()) {
+      return;
+    }
+  }
+  task_runner_->PostTask([strong = fml::Ref(this), deadline]() {
+    TRACE_EVENT0("flutter", "SkiaUnrefQueue::NotifyIdle");
+    strong->DrainUntil(deadline, false);
+  });
+}
+
+size_t SkiaUnrefQueue::GetPendingCount() {
+  std::scoped_lock lock(mutex_);
+  return objects_.size();
+}
+
+size_t SkiaUnrefQueue::GetPendingBytes() {
+  std::scoped_lock lock(mutex_);
+  return pending_bytes_;
+}
+
+void SkiaUnrefQueue::DrainUntil(fml::TimePoint deadline, bool make_progress) {
+  size_t unreffed_count = 0;
+  while (true) {
+    PendingObject skia_object;
+    {
+      std::scoped_lock lock(mutex_);
+      if (objects_.empty()) {
+        break;
+      }
+      if ((unreffed_count > 0 || !make_progress) &&
+          fml::TimePoint::Now() >= deadline) {
+        break;
+      }
+      skia_object = objects_.front();
+      objects_.pop_front();
+      pending_bytes_ -= skia_object.bytes;
+    }
+    skia_object.object->unref();
+    unreffed_count++;
+  }
+
+  if (context_ && unreffed_count > 0) {
+    context_->performDeferredCleanup(std::chrono::milliseconds(0));
+  }
+  TraceCountersToTimeline();
+}
+
+void SkiaUnrefQueue::DrainBatch() {
+  TRACE_EVENT0("flutter", "SkiaUnrefQueue::DrainBatch");
+  DrainUntil(fml::TimePoint::Now() + kDrainBatchDuration, true);
+
+  std::scoped_lock lock(mutex_);
+  if (objects_.empty()) {
+    drain_pending_ = false;
+    return;
+  }
+  // Let the other tasks of the task runner run before the next batch.
+  task_runner_->PostTask([strong = fml::Ref(this)]() { strong->DrainBatch(); });
+}
+
+void SkiaUnrefQueue::TraceCountersToTimeline() {
+  size_t pending_count;
+  size_t pending_bytes;
+  {
+    std::scoped_lock lock(mutex_);
+    pending_count = objects_.size();
+    pending_bytes = pending_bytes_;
+  }
+  FML_TRACE_COUNTER("flutter", "SkiaUnrefQueue",
+                    reinterpret_cast<int64_t>(this), "PendingCount",
+                    pending_count, "PendingKBytes", pending_bytes / 1024);
 }
 
 }  // namespace flutter
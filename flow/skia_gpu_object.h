@@ -11,6 +11,9 @@
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -18,9 +21,22 @@ namespace flutter {
 
 // A queue that holds Skia objects that must be destructed on the given task
 // runner.
+//
+// The objects are unreffed some time after they were queued, in batches that
+// each take at most |kDrainBatchDuration|, so that freeing many objects at
+// once does not hold up other tasks on the task runner. Objects are also
+// unreffed ahead of time when the engine notifies the queue that it is idle.
 class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
  public:
-  void Unref(SkRefCnt* object);
+  // The longest time a scheduled drain spends unreffing objects before it
+  // yields to the other tasks of the task runner.
+  static constexpr fml::TimeDelta kDrainBatchDuration =
+      fml::TimeDelta::FromMilliseconds(2);
+
+  // Queues |object| to be unreffed on the task runner. |bytes| is the
+  // approximate size of the memory that is freed along with it, which is only
+  // used by |GetPendingBytes|.
+  void Unref(SkRefCnt* object, size_t bytes = 0);
 
   // Usually, the drain is called automatically. However, during IO manager
   // shutdown (when the platform side reference to the OpenGL context is about
@@ -29,11 +45,27 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
   // after this call.
   void Drain();
 
+  // Unrefs the queued objects on the task runner until |deadline|, which is
+  // when the engine expects to be busy again.
+  void NotifyIdle(fml::TimePoint deadline);
+
+  // The number of objects that are queued but not unreffed yet.
+  size_t GetPendingCount();
+
+  // The approximate size of the memory that the queued objects hold.
+  size_t GetPendingBytes();
+
  private:
+  struct PendingObject {
+    SkRefCnt* object;
+    size_t bytes;
+  };
+
   const fml::RefPtr<fml::TaskRunner> task_runner_;
   const fml::TimeDelta drain_delay_;
   std::mutex mutex_;
-  std::deque<SkRefCnt*> objects_;
+  std::deque<PendingObject> objects_;
+  size_t pending_bytes_ = 0;
   bool drain_pending_;
   fml::WeakPtr<GrDirectContext> context_;
 
@@ -46,11 +78,34 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
 
   ~SkiaUnrefQueue();
 
+  // Unrefs queued objects until |deadline|, but at least one if
+  // |make_progress| is set.
+  void DrainUntil(fml::TimePoint deadline, bool make_progress);
+
+  // The scheduled drain, which posts itself again until the queue is empty.
+  void DrainBatch();
+
+  void TraceCountersToTimeline();
+
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(SkiaUnrefQueue);
   FML_FRIEND_MAKE_REF_COUNTED(SkiaUnrefQueue);
   FML_DISALLOW_COPY_AND_ASSIGN(SkiaUnrefQueue);
 };
 
+// The approximate size of the memory held by |object|, for the counters of
+// the unref queue.
+inline size_t GetApproximateByteSize(const SkRefCnt& object) {
+  return 0;
+}
+
+inline size_t GetApproximateByteSize(const SkImage& image) {
+  return image.imageInfo().computeMinByteSize();
+}
+
+inline size_t GetApproximateByteSize(const SkPicture& picture) {
+  return picture.approximateBytesUsed();
+}
+
 /// An object whose deallocation needs to be performed on an specific unref
 /// queue. The template argument U need to have a call operator that returns
 /// that unref queue.
@@ -73,7 +128,8 @@ class SkiaGPUObject {
 
   void reset() {
     if (object_ && queue_) {
-      queue_->Unref(object_.release());
+      const size_t bytes = GetApproximateByteSize(*object_);
+      queue_->Unref(object_.release(), bytes);
     }
     queue_ = nullptr;
     FML_DCHECK(object_ == nullptr);
@@ -84,6 +84,41 @@ TEST_F(SkiaGpuObjectTest, QueueSimple) {
   ASSERT_EQ(dtor_task_queue_id, unref_task_runner()->GetTaskQueueId());
 }
 
+TEST_F(SkiaGpuObjectTest, CountsPendingObjects) {
+  std::shared_ptr<fml::AutoResetWaitableEvent> latch =
+      std::make_shared<fml::AutoResetWaitableEvent>();
+  SkRefCnt* ref_object = new TestSkObject(latch, nullptr);
+
+  delayed_unref_queue()->Unref(ref_object, 1024);
+  EXPECT_EQ(delayed_unref_queue()->GetPendingCount(), 1u);
+  EXPECT_EQ(delayed_unref_queue()->GetPendingBytes(), 1024u);
+
+  // Being idle drains the queue before the delay has passed.
+  delayed_unref_queue()->NotifyIdle(fml::TimePoint::Now() +
+                                    fml::TimeDelta::FromSeconds(1));
+  latch->Wait();
+  EXPECT_EQ(delayed_unref_queue()->GetPendingCount(), 0u);
+  EXPECT_EQ(delayed_unref_queue()->GetPendingBytes(), 0u);
+}
+
+TEST_F(SkiaGpuObjectTest, IdleDrainStopsAtDeadline) {
+  std::shared_ptr<fml::AutoResetWaitableEvent> latch =
+      std::make_shared<fml::AutoResetWaitableEvent>();
+  SkRefCnt* ref_object = new TestSkObject(latch, nullptr);
+
+  delayed_unref_queue()->Unref(ref_object);
+  delayed_unref_queue()->NotifyIdle(fml::TimePoint::Now());
+  fml::AutoResetWaitableEvent idle_done;
+  unref_task_runner()->PostTask([&idle_done]() { idle_done.Signal(); });
+  idle_done.Wait();
+  EXPECT_EQ(delayed_unref_queue()->GetPendingCount(), 1u);
+
+  unref_task_runner()->PostTask(
+      [queue = delayed_unref_queue()]() { queue->Drain(); });
+  latch->Wait();
+  EXPECT_EQ(delayed_unref_queue()->GetPendingCount(), 0u);
+}
+
 TEST_F(SkiaGpuObjectTest, ObjectDestructor) {
   std::shared_ptr<fml::AutoResetWaitableEvent> latch =
       std::make_shared<fml::AutoResetWaitableEvent>();
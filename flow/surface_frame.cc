@@ -4,25 +4,42 @@
 
 #include "flutter/flow/surface_frame.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
 
+static SurfaceFrame::FramebufferInfo MakeFramebufferInfo(
+    bool supports_readback) {
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = supports_readback;
+  return framebuffer_info;
+}
+
 SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
                            bool supports_readback,
                            const SubmitCallback& submit_callback)
-    : surface_(surface),
-      supports_readback_(supports_readback),
-      submit_callback_(submit_callback) {
-  FML_DCHECK(submit_callback_);
-}
+    : SurfaceFrame(std::move(surface),
+                   MakeFramebufferInfo(supports_readback),
+                   submit_callback) {}
 
 SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
                            bool supports_readback,
                            const SubmitCallback& submit_callback,
                            std::unique_ptr<GLContextResult> context_result)
-    : submitted_(false),
-      surface_(surface),
-      supports_readback_(supports_readback),
+    : SurfaceFrame(std::move(surface),
+                   MakeFramebufferInfo(supports_readback),
+                   submit_callback,
+                   std::move(context_result)) {}
+
+SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
+                           FramebufferInfo framebuffer_info,
+                           const SubmitCallback& submit_callback,
+                           std::unique_ptr<GLContextResult> context_result)
+    : surface_(std::move(surface)),
+      framebuffer_info_(std::move(framebuffer_info)),
       submit_callback_(submit_callback),
       context_result_(std::move(context_result)) {
   FML_DCHECK(submit_callback_);
@@ -45,6 +62,34 @@ bool SurfaceFrame::Submit() {
   return submitted_;
 }
 
+void SurfaceFrame::SubmitAndPresentOn(
+    std::unique_ptr<SurfaceFrame> frame,
+    const fml::RefPtr<fml::TaskRunner>& present_task_runner,
+    const fml::closure& on_presented) {
+  FML_DCHECK(frame->framebuffer_info_.max_presents_in_flight > 0);
+  if (frame->submitted_ || frame->submit_callback_ == nullptr) {
+    on_presented();
+    return;
+  }
+  frame->submitted_ = true;
+
+  const fml::TimePoint flush_start = fml::TimePoint::Now();
+  frame->Flush();
+  const fml::TimeDelta flush_duration = fml::TimePoint::Now() - flush_start;
+  if (frame->submit_timings_callback_) {
+    frame->submit_timings_callback_({.flush = flush_duration});
+    frame->submit_timings_callback_ = nullptr;
+  }
+
+  present_task_runner->PostTask(fml::MakeCopyable(
+      [frame = std::move(frame), flush_duration, on_presented]() mutable {
+        TRACE_EVENT0("flutter", "SurfaceFrame::Present");
+        frame->PerformPresent(flush_duration);
+        frame.reset();
+        on_presented();
+      }));
+}
+
 bool SurfaceFrame::IsSubmitted() const {
   return submitted_;
 }
@@ -62,11 +107,62 @@ bool SurfaceFrame::PerformSubmit() {
     return false;
   }
 
-  if (submit_callback_(*this, SkiaCanvas())) {
-    return true;
+  const fml::TimePoint flush_start = fml::TimePoint::Now();
+  Flush();
+  return PerformPresent(fml::TimePoint::Now() - flush_start);
+}
+
+bool SurfaceFrame::PerformPresent(fml::TimeDelta flush_duration) {
+  const fml::TimePoint present_start = fml::TimePoint::Now();
+
+  const bool submitted = submit_callback_(*this, SkiaCanvas());
+
+  if (submit_timings_callback_) {
+    submit_timings_callback_({
+        .flush = flush_duration,
+        .present = fml::TimePoint::Now() - present_start,
+        .buffer_wait = buffer_wait_,
+    });
   }
 
-  return false;
+  return submitted;
+}
+
+namespace {
+
+struct GpuTimeRequest {
+  fml::TimePoint submit_time;
+  SurfaceFrame::GpuTimeCallback callback;
+};
+
+}  // namespace
+
+void SurfaceFrame::Flush() {
+  // Surfaces flush their canvas when presenting a frame. Flushing the frame
+  // here instead separates the time the flush takes from presenting, and lets
+  // the GPU report when it is done. Software surfaces have nothing to flush.
+  GrRecordingContext* recording_context =
+      surface_ ? surface_->recordingContext() : nullptr;
+  GrDirectContext* context =
+      recording_context ? recording_context->asDirectContext() : nullptr;
+  if (context == nullptr) {
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "SurfaceFrame::Flush");
+  GrFlushInfo flush_info;
+  if (gpu_time_callback_) {
+    // Skia calls the finished proc exactly once, even if the flush fails.
+    flush_info.fFinishedContext =
+        new GpuTimeRequest{fml::TimePoint::Now(), gpu_time_callback_};
+    flush_info.fFinishedProc = [](GrGpuFinishedContext finished_context) {
+      std::unique_ptr<GpuTimeRequest> request(
+          static_cast<GpuTimeRequest*>(finished_context));
+      request->callback(fml::TimePoint::Now() - request->submit_time);
+    };
+  }
+  context->flush(flush_info);
+  context->submit();
 }
 
 }  // namespace flutter
@@ -6,9 +6,13 @@
 #define FLUTTER_FLOW_SURFACE_FRAME_H_
 
 #include <memory>
+#include <optional>
 
 #include "flutter/common/graphics/gl_context_switch.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -21,6 +25,57 @@ class SurfaceFrame {
   using SubmitCallback =
       std::function<bool(const SurfaceFrame& surface_frame, SkCanvas* canvas)>;
 
+  // Information about the framebuffer backing the frame.
+  struct FramebufferInfo {
+    // Indicates whether or not the surface supports pixel readback as used in
+    // circumstances such as a BackdropFilter.
+    bool supports_readback = false;
+
+    // Indicates whether the surface can present a frame of which only the
+    // region that changed since the previous frame was repainted.
+    bool supports_partial_repaint = false;
+
+    // The region of the framebuffer that does not hold the contents of the
+    // previously presented frame. This is the damage accumulated by the frames
+    // presented since this framebuffer was last rendered to, and is empty if
+    // the framebuffer holds the previous frame. If unset, the contents of the
+    // framebuffer are unknown and the whole frame is repainted. Only used if
+    // |supports_partial_repaint| is true.
+    std::optional<SkIRect> existing_damage;
+
+    // How many submitted frames may still be presenting on another thread
+    // while the next frame is acquired and drawn, see |SubmitAndPresentOn|.
+    // Zero if the submit callback must run on the thread that drew the frame.
+    size_t max_presents_in_flight = 0;
+  };
+
+  // Information about the frame that the surface may use to present it.
+  struct SubmitInfo {
+    // The region of the frame that changed since the previously presented
+    // frame. If unset, the whole frame must be assumed to have changed.
+    std::optional<SkIRect> frame_damage;
+
+    // The region of the framebuffer that was repainted. This is the frame
+    // damage joined with the existing damage of the framebuffer. If unset, the
+    // whole framebuffer was repainted.
+    std::optional<SkIRect> buffer_damage;
+  };
+
+  // How long the phases of submitting the frame took.
+  struct SubmitTimings {
+    // Flushing the drawing commands of the frame to the GPU.
+    fml::TimeDelta flush;
+    // Presenting the frame, which may include waiting for a buffer.
+    fml::TimeDelta present;
+    // The part of |present| the surface reported waiting for a buffer, see
+    // |AddBufferWait|.
+    fml::TimeDelta buffer_wait;
+  };
+
+  using SubmitTimingsCallback = std::function<void(const SubmitTimings&)>;
+
+  using GpuTimeCallback = std::function<void(fml::TimeDelta gpu_time)>;
+
   SurfaceFrame(sk_sp<SkSurface> surface,
                bool supports_readback,
                const SubmitCallback& submit_callback);
@@ -30,27 +85,79 @@ class SurfaceFrame {
                const SubmitCallback& submit_callback,
                std::unique_ptr<GLContextResult> context_result);
 
+  SurfaceFrame(sk_sp<SkSurface> surface,
+               FramebufferInfo framebuffer_info,
+               const SubmitCallback& submit_callback,
+               std::unique_ptr<GLContextResult> context_result = nullptr);
+
   ~SurfaceFrame();
 
   bool Submit();
 
+  // Flushes |frame| on the calling thread and then runs its submit callback
+  // on |present_task_runner|, followed by |on_presented|. The submit timings
+  // callback is called on the calling thread after the flush, with a zero
+  // present time. Only for frames whose |FramebufferInfo| allows presents in
+  // flight.
+  static void SubmitAndPresentOn(
+      std::unique_ptr<SurfaceFrame> frame,
+      const fml::RefPtr<fml::TaskRunner>& present_task_runner,
+      const fml::closure& on_presented);
+
   bool IsSubmitted() const;
 
   SkCanvas* SkiaCanvas();
 
   sk_sp<SkSurface> SkiaSurface() const;
 
-  bool supports_readback() { return supports_readback_; }
+  bool supports_readback() { return framebuffer_info_.supports_readback; }
+
+  const FramebufferInfo& framebuffer_info() const { return framebuffer_info_; }
+
+  void set_submit_info(const SubmitInfo& submit_info) {
+    submit_info_ = submit_info;
+  }
+
+  const SubmitInfo& submit_info() const { return submit_info_; }
+
+  // |callback| is called when the frame was submitted.
+  void set_submit_timings_callback(SubmitTimingsCallback callback) {
+    submit_timings_callback_ = std::move(callback);
+  }
+
+  // Reports that the surface waited |wait| for a buffer to present the frame
+  // into. This is const so that the submit callback, which is passed the
+  // frame as const, can report the wait.
+  void AddBufferWait(fml::TimeDelta wait) const {
+    buffer_wait_ = buffer_wait_ + wait;
+  }
+
+  // |callback| is called with the time from flushing the frame to the GPU
+  // until the GPU finished executing it. As that is only known once the GPU
+  // is done, it usually is called after the frame was destroyed, on the
+  // thread that a later frame is submitted on. It is not called for frames
+  // that are not drawn by a GPU.
+  void set_gpu_time_callback(GpuTimeCallback callback) {
+    gpu_time_callback_ = std::move(callback);
+  }
 
  private:
   bool submitted_ = false;
   sk_sp<SkSurface> surface_;
-  bool supports_readback_;
+  FramebufferInfo framebuffer_info_;
+  SubmitInfo submit_info_;
   SubmitCallback submit_callback_;
   std::unique_ptr<GLContextResult> context_result_;
+  SubmitTimingsCallback submit_timings_callback_;
+  GpuTimeCallback gpu_time_callback_;
+  mutable fml::TimeDelta buffer_wait_;
 
   bool PerformSubmit();
 
+  bool PerformPresent(fml::TimeDelta flush_duration);
+
+  void Flush();
+
   FML_DISALLOW_COPY_AND_ASSIGN(SurfaceFrame);
 };
 
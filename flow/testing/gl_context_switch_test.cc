@@ -28,6 +28,10 @@ bool TestSwitchableGLContext::RemoveCurrent() {
   return true;
 };
 
+bool TestSwitchableGLContext::IsCurrent() {
+  return current_context.get() != nullptr && *current_context.get() == context_;
+};
+
 int TestSwitchableGLContext::GetContext() {
   return context_;
 };
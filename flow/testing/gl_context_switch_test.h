@@ -28,6 +28,8 @@ class TestSwitchableGLContext : public SwitchableGLContext {
 
   bool RemoveCurrent() override;
 
+  bool IsCurrent() override;
+
   int GetContext();
 
   static int GetCurrentContext();
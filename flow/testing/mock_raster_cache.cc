@@ -4,6 +4,7 @@
 
 #include "flutter/flow/testing/mock_raster_cache.h"
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/layers/layer.h"
 
 namespace flutter {
@@ -25,6 +26,18 @@ std::unique_ptr<RasterCacheResult> MockRasterCache::RasterizePicture(
   return std::make_unique<MockRasterCacheResult>(cache_rect);
 }
 
+std::unique_ptr<RasterCacheResult> MockRasterCache::RasterizeDisplayList(
+    DisplayList* display_list,
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space,
+    bool checkerboard) const {
+  SkIRect cache_rect =
+      RasterCache::GetDeviceBounds(display_list->bounds(), ctm);
+
+  return std::make_unique<MockRasterCacheResult>(cache_rect);
+}
+
 std::unique_ptr<RasterCacheResult> MockRasterCache::RasterizeLayer(
     PrerollContext* context,
     Layer* layer,
@@ -25,6 +25,10 @@ class MockRasterCacheResult : public RasterCacheResult {
 
   void draw(SkCanvas& canvas, const SkPaint* paint = nullptr) const override{};
 
+  void draw_scaled(SkCanvas& canvas,
+                   const SkPaint* paint,
+                   const SkMatrix& raster_matrix) const override{};
+
   SkISize image_dimensions() const override { return device_rect_.size(); };
 
   int64_t image_bytes() const override {
@@ -51,6 +55,13 @@ class MockRasterCache : public RasterCache {
       SkColorSpace* dst_color_space,
       bool checkerboard) const override;
 
+  std::unique_ptr<RasterCacheResult> RasterizeDisplayList(
+      DisplayList* display_list,
+      GrDirectContext* context,
+      const SkMatrix& ctm,
+      SkColorSpace* dst_color_space,
+      bool checkerboard) const override;
+
   std::unique_ptr<RasterCacheResult> RasterizeLayer(
       PrerollContext* context,
       Layer* layer,
@@ -0,0 +1,293 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/async_file.h"
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
+
+#if defined(OS_LINUX)
+#include <stdio.h>
+#include <sys/stat.h>
+
+#include <cerrno>
+
+#include "flutter/fml/platform/linux/io_uring.h"
+#endif
+
+namespace fml {
+
+namespace {
+
+#if defined(OS_LINUX)
+
+constexpr uint32_t kIoUringEntries = 64;
+
+// The contents of a file that are read or written through an io_uring.
+struct Transfer {
+  bool is_read = true;
+  UniqueFD file;
+  uint8_t* bytes = nullptr;
+  size_t size = 0;
+  size_t offset = 0;
+  // Owns |bytes| of a read.
+  std::vector<uint8_t> read_buffer;
+  // Owns |bytes| of a write.
+  std::unique_ptr<Mapping> write_data;
+  std::function<void(std::shared_ptr<Transfer> transfer, bool success)> done;
+};
+
+void FinishTransfer(std::shared_ptr<Transfer> transfer, bool success) {
+  auto done = std::move(transfer->done);
+  done(std::move(transfer), success);
+}
+
+// Transfers the remaining bytes of |transfer|, which may take several
+// operations, and then calls |Transfer::done| on the completion thread.
+void ContinueTransfer(IoUring& io_uring, std::shared_ptr<Transfer> transfer) {
+  if (transfer->offset == transfer->size) {
+    FinishTransfer(std::move(transfer), true);
+    return;
+  }
+  uint8_t* bytes = transfer->bytes + transfer->offset;
+  const size_t remaining = transfer->size - transfer->offset;
+  const uint64_t offset = transfer->offset;
+  const int fd = transfer->file.get();
+  const bool is_read = transfer->is_read;
+  IoUring::Completion on_completed = [&io_uring,
+                                      transfer](int32_t result) mutable {
+    if (result == -EINTR || result == -EAGAIN) {
+      ContinueTransfer(io_uring, std::move(transfer));
+      return;
+    }
+    // Reading nothing means the file was truncated while it was read.
+    if (result <= 0) {
+      FinishTransfer(std::move(transfer), false);
+      return;
+    }
+    transfer->offset += result;
+    ContinueTransfer(io_uring, std::move(transfer));
+  };
+  if (is_read) {
+    io_uring.Read(fd, bytes, remaining, offset, std::move(on_completed));
+  } else {
+    io_uring.Write(fd, bytes, remaining, offset, std::move(on_completed));
+  }
+}
+
+#endif  // defined(OS_LINUX)
+
+}  // namespace
+
+AsyncFileIO& AsyncFileIO::GetForProcess() {
+  static AsyncFileIO* instance = new AsyncFileIO();
+  return *instance;
+}
+
+AsyncFileIO::AsyncFileIO(bool use_io_uring) : file_thread_("io.flutter.file") {
+#if defined(OS_LINUX)
+  if (use_io_uring) {
+    io_uring_ = IoUring::Create(kIoUringEntries);
+  }
+#endif
+}
+
+AsyncFileIO::~AsyncFileIO() {
+  WaitForOperations();
+  io_uring_.reset();
+  file_thread_.Join();
+}
+
+void AsyncFileIO::WaitForOperations() {
+  std::unique_lock lock(operations_mutex_);
+  operation_completed_.wait(lock,
+                            [this]() { return operations_in_flight_ == 0; });
+}
+
+bool AsyncFileIO::UsesIoUring() const {
+  return io_uring_ != nullptr;
+}
+
+fml::RefPtr<fml::TaskRunner> AsyncFileIO::GetTaskRunner() const {
+  return file_thread_.GetTaskRunner();
+}
+
+void AsyncFileIO::BeginOperation() {
+  std::scoped_lock lock(operations_mutex_);
+  operations_in_flight_++;
+}
+
+void AsyncFileIO::EndOperation() {
+  {
+    std::scoped_lock lock(operations_mutex_);
+    operations_in_flight_--;
+  }
+  operation_completed_.notify_all();
+}
+
+void AsyncFileIO::ReadFileToMapping(
+    std::shared_ptr<const UniqueFD> base_directory,
+    std::string path,
+    MappingCallback callback) {
+  BeginOperation();
+  GetTaskRunner()->PostTask([this, base_directory, path = std::move(path),
+                             callback = std::move(callback)]() {
+    TRACE_EVENT0("flutter", "AsyncFileIO::ReadFileToMapping");
+    UniqueFD file =
+        OpenFile(*base_directory, path.c_str(), false, FilePermission::kRead);
+    if (!file.is_valid()) {
+      EndOperation();
+      callback(nullptr);
+      return;
+    }
+
+#if defined(OS_LINUX)
+    struct stat file_stat = {};
+    if (io_uring_ && ::fstat(file.get(), &file_stat) == 0 &&
+        S_ISREG(file_stat.st_mode)) {
+      auto transfer = std::make_shared<Transfer>();
+      transfer->file = std::move(file);
+      transfer->read_buffer.resize(file_stat.st_size);
+      transfer->bytes = transfer->read_buffer.data();
+      transfer->size = transfer->read_buffer.size();
+      transfer->done = [this, callback](std::shared_ptr<Transfer> transfer,
+                                        bool success) {
+        std::unique_ptr<Mapping> mapping;
+        if (success) {
+          mapping =
+              std::make_unique<DataMapping>(std::move(transfer->read_buffer));
+        }
+        transfer.reset();
+        EndOperation();
+        callback(std::move(mapping));
+      };
+      ContinueTransfer(*io_uring_, std::move(transfer));
+      return;
+    }
+#endif  // defined(OS_LINUX)
+
+    std::unique_ptr<Mapping> mapping = std::make_unique<FileMapping>(file);
+    if (!static_cast<FileMapping*>(mapping.get())->IsValid()) {
+      mapping = nullptr;
+    }
+    EndOperation();
+    callback(std::move(mapping));
+  });
+}
+
+void AsyncFileIO::WriteAtomically(
+    std::shared_ptr<const UniqueFD> base_directory,
+    std::string path,
+    std::unique_ptr<Mapping> data,
+    StatusCallback callback) {
+  BeginOperation();
+  GetTaskRunner()->PostTask(MakeCopyable(
+      [this, base_directory, path = std::move(path), data = std::move(data),
+       callback = std::move(callback)]() mutable {
+        TRACE_EVENT0("flutter", "AsyncFileIO::WriteAtomically");
+        if (!data || data->GetMapping() == nullptr) {
+          EndOperation();
+          callback(false);
+          return;
+        }
+
+#if defined(OS_LINUX)
+        if (io_uring_) {
+          // Runs on the file thread only, like the opening of the file.
+          std::string temp_path =
+              path + "." + std::to_string(next_temp_file_++) + ".temp";
+          auto transfer = std::make_shared<Transfer>();
+          transfer->file = OpenFile(*base_directory, temp_path.c_str(), true,
+                                    FilePermission::kReadWrite);
+          if (!transfer->file.is_valid() ||
+              !TruncateFile(transfer->file, data->GetSize())) {
+            EndOperation();
+            callback(false);
+            return;
+          }
+          transfer->is_read = false;
+          transfer->bytes = const_cast<uint8_t*>(data->GetMapping());
+          transfer->size = data->GetSize();
+          transfer->write_data = std::move(data);
+          transfer->done = [this, base_directory, path, temp_path, callback](
+                               std::shared_ptr<Transfer> transfer,
+                               bool success) {
+            if (!success) {
+              transfer.reset();
+              EndOperation();
+              callback(false);
+              return;
+            }
+            const int fd = transfer->file.get();
+            io_uring_->Fsync(fd, [this, base_directory, path, temp_path,
+                                  callback, transfer](int32_t result) {
+              if (result < 0) {
+                EndOperation();
+                callback(false);
+                return;
+              }
+              // The rename is ordered with the other file system work.
+              GetTaskRunner()->PostTask(
+                  [this, base_directory, path, temp_path, callback]() {
+                    const bool renamed =
+                        ::renameat(base_directory->get(), temp_path.c_str(),
+                                   base_directory->get(), path.c_str()) == 0;
+                    EndOperation();
+                    callback(renamed);
+                  });
+            });
+          };
+          ContinueTransfer(*io_uring_, std::move(transfer));
+          return;
+        }
+#endif  // defined(OS_LINUX)
+
+        const bool written =
+            fml::WriteAtomically(*base_directory, path.c_str(), *data);
+        EndOperation();
+        callback(written);
+      }));
+}
+
+void AsyncFileIO::Sync(std::shared_ptr<const UniqueFD> file,
+                       StatusCallback callback) {
+  BeginOperation();
+  GetTaskRunner()->PostTask(
+      [this, file, callback = std::move(callback)]() {
+        TRACE_EVENT0("flutter", "AsyncFileIO::Sync");
+#if defined(OS_LINUX)
+        if (io_uring_ && file->is_valid()) {
+          io_uring_->Fsync(file->get(), [this, file, callback](int32_t result) {
+            EndOperation();
+            callback(result == 0);
+          });
+          return;
+        }
+#endif  // defined(OS_LINUX)
+        const bool synced = SyncFile(*file);
+        EndOperation();
+        callback(synced);
+      });
+}
+
+void AsyncFileIO::ScanDirectory(std::shared_ptr<const UniqueFD> directory,
+                                DirectoryCallback callback) {
+  BeginOperation();
+  GetTaskRunner()->PostTask([this, directory,
+                             callback = std::move(callback)]() {
+    TRACE_EVENT0("flutter", "AsyncFileIO::ScanDirectory");
+    std::vector<std::string> file_names;
+    VisitFiles(*directory, [&file_names](const UniqueFD& directory,
+                                         const std::string& file_name) {
+      file_names.push_back(file_name);
+      return true;
+    });
+    EndOperation();
+    callback(std::move(file_names));
+  });
+}
+
+}  // namespace fml
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_ASYNC_FILE_H_
+#define FLUTTER_FML_ASYNC_FILE_H_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace fml {
+
+class IoUring;
+
+//------------------------------------------------------------------------------
+/// Performs file operations without blocking the calling thread, so that file
+/// system work doesn't occupy the worker or IO threads.
+///
+/// Opening files and other file system metadata work runs in order on a
+/// dedicated file thread. On Linux, the transfer of file contents and syncing
+/// go through an io_uring instead, so the file thread is not blocked while the
+/// storage device works. Everywhere else, and where io_uring is unavailable,
+/// the file thread performs the whole operation.
+///
+/// Callbacks are invoked on the file thread or on the io_uring completion
+/// thread, and should post any further work to their own task runner.
+///
+class AsyncFileIO {
+ public:
+  using MappingCallback = std::function<void(std::unique_ptr<Mapping>)>;
+  using StatusCallback = std::function<void(bool success)>;
+  using DirectoryCallback =
+      std::function<void(std::vector<std::string> file_names)>;
+
+  /// The instance shared by the process. It is created on first use and never
+  /// destroyed.
+  static AsyncFileIO& GetForProcess();
+
+  /// If |use_io_uring| is false, the file thread performs every operation.
+  explicit AsyncFileIO(bool use_io_uring = true);
+
+  /// Waits for the operations in flight to complete.
+  ~AsyncFileIO();
+
+  /// Blocks until the operations requested so far have completed. Their
+  /// callbacks may still be running. Must not be called from a callback.
+  void WaitForOperations();
+
+  /// Whether file contents are transferred through an io_uring.
+  bool UsesIoUring() const;
+
+  /// The task runner of the file thread. Blocking file system work that must
+  /// be ordered with other file system work may be posted to it.
+  fml::RefPtr<fml::TaskRunner> GetTaskRunner() const;
+
+  /// Reads the file at |path| relative to |base_directory| into a mapping, or
+  /// calls |callback| with null if the file can't be read.
+  void ReadFileToMapping(std::shared_ptr<const UniqueFD> base_directory,
+                         std::string path,
+                         MappingCallback callback);
+
+  /// Like |fml::WriteAtomically|: writes |data| to a temporary file, syncs it
+  /// and then renames it to |path| relative to |base_directory|. Of several
+  /// writes to the same path, the one renamed last wins.
+  void WriteAtomically(std::shared_ptr<const UniqueFD> base_directory,
+                       std::string path,
+                       std::unique_ptr<Mapping> data,
+                       StatusCallback callback);
+
+  /// Flushes the contents of |file| to the storage device.
+  void Sync(std::shared_ptr<const UniqueFD> file, StatusCallback callback);
+
+  /// Lists the names of the files and directories in |directory|, not
+  /// recursively.
+  void ScanDirectory(std::shared_ptr<const UniqueFD> directory,
+                     DirectoryCallback callback);
+
+ private:
+  // Declared before the io_uring so that it is joined after the io_uring has
+  // stopped.
+  fml::Thread file_thread_;
+  std::unique_ptr<IoUring> io_uring_;
+
+  std::mutex operations_mutex_;
+  std::condition_variable operation_completed_;
+  size_t operations_in_flight_ = 0;
+  // Distinguishes the temporary files of writes to the same path that are in
+  // flight at once.
+  size_t next_temp_file_ = 0;
+
+  // Counts an operation from its request until right before its callback.
+  void BeginOperation();
+  void EndOperation();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AsyncFileIO);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_ASYNC_FILE_H_
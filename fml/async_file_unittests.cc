@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/async_file.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+// Runs every test with and without io_uring, which is only used where the
+// platform supports it.
+class AsyncFileIOTest : public ::testing::TestWithParam<bool> {
+ public:
+  AsyncFileIOTest()
+      : directory_(std::make_shared<UniqueFD>(
+            Duplicate(temp_directory_.fd().get()))),
+        file_io_(GetParam()) {}
+
+ protected:
+  ScopedTemporaryDirectory temp_directory_;
+  std::shared_ptr<const UniqueFD> directory_;
+  AsyncFileIO file_io_;
+
+  bool Write(const std::string& path, const std::string& contents) {
+    AutoResetWaitableEvent latch;
+    bool written = false;
+    file_io_.WriteAtomically(directory_, path,
+                             std::make_unique<DataMapping>(contents),
+                             [&](bool success) {
+                               written = success;
+                               latch.Signal();
+                             });
+    latch.Wait();
+    return written;
+  }
+
+  std::unique_ptr<Mapping> Read(const std::string& path) {
+    AutoResetWaitableEvent latch;
+    std::unique_ptr<Mapping> result;
+    file_io_.ReadFileToMapping(directory_, path,
+                               [&](std::unique_ptr<Mapping> mapping) {
+                                 result = std::move(mapping);
+                                 latch.Signal();
+                               });
+    latch.Wait();
+    return result;
+  }
+
+  std::vector<std::string> FileNames() {
+    std::vector<std::string> file_names;
+    VisitFiles(*directory_, [&](const UniqueFD& directory,
+                                const std::string& file_name) {
+      file_names.push_back(file_name);
+      return true;
+    });
+    std::sort(file_names.begin(), file_names.end());
+    return file_names;
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(IoUring, AsyncFileIOTest, ::testing::Bool());
+
+TEST_P(AsyncFileIOTest, ReadsWhatWasWritten) {
+  // Larger than a single page, so that it may take several reads.
+  std::string contents(100000, 'a');
+  for (size_t i = 0; i < contents.size(); i++) {
+    contents[i] = static_cast<char>('a' + i % 26);
+  }
+  ASSERT_TRUE(Write("file.txt", contents));
+  ASSERT_EQ(FileNames(), std::vector<std::string>({"file.txt"}));
+
+  std::unique_ptr<Mapping> mapping = Read("file.txt");
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                        mapping->GetSize()),
+            contents);
+
+  ASSERT_TRUE(UnlinkFile(*directory_, "file.txt"));
+}
+
+TEST_P(AsyncFileIOTest, WritesToTheSamePathAtOnce) {
+  std::vector<std::string> contents;
+  for (int i = 0; i < 8; i++) {
+    contents.push_back(std::string(10000, static_cast<char>('a' + i)));
+    file_io_.WriteAtomically(directory_, "file.txt",
+                             std::make_unique<DataMapping>(contents.back()),
+                             [](bool success) { EXPECT_TRUE(success); });
+  }
+  file_io_.WaitForOperations();
+  ASSERT_EQ(FileNames(), std::vector<std::string>({"file.txt"}));
+
+  // Each write is whole, whichever was renamed last.
+  std::unique_ptr<Mapping> mapping = Read("file.txt");
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_NE(std::find(contents.begin(), contents.end(),
+                      std::string(
+                          reinterpret_cast<const char*>(mapping->GetMapping()),
+                          mapping->GetSize())),
+            contents.end());
+
+  ASSERT_TRUE(UnlinkFile(*directory_, "file.txt"));
+}
+
+TEST_P(AsyncFileIOTest, ReadingMissingFileFails) {
+  ASSERT_EQ(Read("missing.txt"), nullptr);
+}
+
+TEST_P(AsyncFileIOTest, ScansDirectory) {
+  ASSERT_TRUE(Write("a.txt", "a"));
+  ASSERT_TRUE(Write("b.txt", "b"));
+
+  AutoResetWaitableEvent latch;
+  std::vector<std::string> file_names;
+  file_io_.ScanDirectory(directory_, [&](std::vector<std::string> names) {
+    file_names = std::move(names);
+    latch.Signal();
+  });
+  latch.Wait();
+  std::sort(file_names.begin(), file_names.end());
+  ASSERT_EQ(file_names, std::vector<std::string>({"a.txt", "b.txt"}));
+
+  ASSERT_TRUE(UnlinkFile(*directory_, "a.txt"));
+  ASSERT_TRUE(UnlinkFile(*directory_, "b.txt"));
+}
+
+TEST_P(AsyncFileIOTest, SyncsFile) {
+  ASSERT_TRUE(Write("file.txt", "contents"));
+  auto file = std::make_shared<UniqueFD>(OpenFile(
+      *directory_, "file.txt", false, FilePermission::kReadWrite));
+  ASSERT_TRUE(file->is_valid());
+
+  AutoResetWaitableEvent latch;
+  bool synced = false;
+  file_io_.Sync(file, [&](bool success) {
+    synced = success;
+    latch.Signal();
+  });
+  latch.Wait();
+  ASSERT_TRUE(synced);
+
+  file.reset();
+  ASSERT_TRUE(UnlinkFile(*directory_, "file.txt"));
+}
+
+TEST(AsyncFileIOShutdownTest, DestructionWaitsForOperations) {
+  ScopedTemporaryDirectory temp_directory;
+  auto directory =
+      std::make_shared<UniqueFD>(Duplicate(temp_directory.fd().get()));
+  size_t completed = 0;
+  {
+    AsyncFileIO file_io;
+    for (int i = 0; i < 200; i++) {
+      file_io.WriteAtomically(directory, "file" + std::to_string(i),
+                              std::make_unique<DataMapping>("contents"),
+                              [&completed](bool success) {
+                                EXPECT_TRUE(success);
+                                completed++;
+                              });
+    }
+  }
+  ASSERT_EQ(completed, 200u);
+  for (int i = 0; i < 200; i++) {
+    ASSERT_TRUE(UnlinkFile(*directory, ("file" + std::to_string(i)).c_str()));
+  }
+}
+
+}  // namespace testing
+}  // namespace fml
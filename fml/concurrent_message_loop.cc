@@ -12,18 +12,27 @@
 namespace fml {
 
 std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
-    size_t worker_count) {
+    size_t worker_count,
+    Scheduling scheduling) {
   return std::shared_ptr<ConcurrentMessageLoop>{
-      new ConcurrentMessageLoop(worker_count)};
+      new ConcurrentMessageLoop(worker_count, scheduling)};
 }
 
-ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
-    : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count,
+                                             Scheduling scheduling)
+    : worker_count_(std::max<size_t>(worker_count, 1ul)),
+      scheduling_(scheduling) {
+  if (scheduling_ == Scheduling::kWorkStealing) {
+    for (size_t i = 0; i < worker_count_; ++i) {
+      worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+    }
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(
           std::string{"io.worker." + std::to_string(i + 1)});
-      WorkerMain();
+      WorkerMain(i);
     });
   }
 
@@ -43,6 +52,10 @@ size_t ConcurrentMessageLoop::GetWorkerCount() const {
   return worker_count_;
 }
 
+ConcurrentMessageLoop::Scheduling ConcurrentMessageLoop::GetScheduling() const {
+  return scheduling_;
+}
+
 std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
@@ -52,6 +65,11 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
+  if (scheduling_ == Scheduling::kWorkStealing) {
+    PostWorkStealingTask(task);
+    return;
+  }
+
   std::unique_lock lock(tasks_mutex_);
 
   // Don't just drop tasks on the floor in case of shutdown.
@@ -74,7 +92,88 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
   tasks_condition_.notify_one();
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
+void ConcurrentMessageLoop::PostWorkStealingTask(const fml::closure& task) {
+  // Don't just drop tasks on the floor in case of shutdown.
+  if (work_stealing_shutdown_.load()) {
+    FML_DLOG(WARNING)
+        << "Tried to post a task to shutdown concurrent message "
+           "loop. The task will be executed on the callers thread.";
+    task();
+    return;
+  }
+
+  // Tasks posted from a worker stay on that worker, which keeps related work
+  // together. Everything else is spread over the workers.
+  const auto current_thread_id = std::this_thread::get_id();
+  size_t worker_index = worker_count_;
+  for (size_t i = 0; i < worker_thread_ids_.size(); ++i) {
+    if (worker_thread_ids_[i] == current_thread_id) {
+      worker_index = i;
+      break;
+    }
+  }
+  if (worker_index == worker_count_) {
+    worker_index = next_worker_queue_.fetch_add(1) % worker_count_;
+  }
+
+  // The task is counted with the queue locked, so that it is counted before
+  // it can be taken, but not before it can be found.
+  WorkerQueue& queue = *worker_queues_[worker_index];
+  {
+    std::scoped_lock lock(queue.mutex);
+    queue.tasks.push_back(task);
+    pending_tasks_.fetch_add(1);
+  }
+
+  // A worker increments |sleeping_workers_| with |tasks_mutex_| held before
+  // it checks |pending_tasks_| and goes to sleep. So either that worker sees
+  // the task just added, or this thread sees the sleeping worker and notifies
+  // it once it is actually waiting (which releases the mutex).
+  if (sleeping_workers_.load() > 0) {
+    {
+      std::scoped_lock lock(tasks_mutex_);
+    }
+    tasks_condition_.notify_one();
+  }
+}
+
+fml::closure ConcurrentMessageLoop::TakeWorkStealingTask(size_t worker_index) {
+  // Prefer the most recently posted task of this worker, its data is most
+  // likely still in the cache.
+  {
+    WorkerQueue& queue = *worker_queues_[worker_index];
+    std::scoped_lock lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      fml::closure task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      pending_tasks_.fetch_sub(1);
+      return task;
+    }
+  }
+
+  // Steal the oldest task of another worker. The queues are only locked to
+  // push or pop a task, so waiting for one is cheaper than skipping it, which
+  // would let the worker find no task while |pending_tasks_| says otherwise.
+  for (size_t i = 1; i < worker_count_; ++i) {
+    WorkerQueue& queue = *worker_queues_[(worker_index + i) % worker_count_];
+    std::scoped_lock lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      fml::closure task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      pending_tasks_.fetch_sub(1);
+      return task;
+    }
+  }
+
+  return nullptr;
+}
+
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  if (scheduling_ == Scheduling::kWorkStealing) {
+    WorkStealingWorkerMain(worker_index);
+    return;
+  }
+
   while (true) {
     std::unique_lock lock(tasks_mutex_);
     tasks_condition_.wait(lock, [&]() {
@@ -117,9 +216,69 @@ void ConcurrentMessageLoop::WorkerMain() {
   }
 }
 
+void ConcurrentMessageLoop::WorkStealingWorkerMain(size_t worker_index) {
+  size_t thread_task_generation = 0;
+  while (true) {
+    // The tasks posted to all workers run before the queued tasks, which
+    // could otherwise hold them up for as long as the queues are not empty.
+    // Only the mutex guards them, which is taken once they were posted.
+    if (thread_task_generation_.load() != thread_task_generation) {
+      std::vector<fml::closure> thread_tasks;
+      {
+        std::scoped_lock lock(tasks_mutex_);
+        thread_task_generation = thread_task_generation_.load();
+        if (HasThreadTasksLocked()) {
+          thread_tasks = GetThreadTasksLocked();
+        }
+      }
+      for (const auto& thread_task : thread_tasks) {
+        thread_task();
+      }
+    }
+
+    fml::closure task = TakeWorkStealingTask(worker_index);
+    if (task) {
+      task();
+      continue;
+    }
+
+    std::unique_lock lock(tasks_mutex_);
+    sleeping_workers_.fetch_add(1);
+    tasks_condition_.wait(lock, [&]() {
+      return pending_tasks_.load() > 0 || shutdown_ || HasThreadTasksLocked();
+    });
+    sleeping_workers_.fetch_sub(1);
+
+    // Shutdown cannot be read with the task mutex unlocked.
+    bool shutdown_now = shutdown_;
+    lock.unlock();
+
+    if (shutdown_now) {
+      // The tasks that were queued before the shutdown still run rather than
+      // being dropped with the queues.
+      TRACE_EVENT0("flutter", "ConcurrentWorkerDrain");
+      while (fml::closure queued_task = TakeWorkStealingTask(worker_index)) {
+        queued_task();
+      }
+      std::vector<fml::closure> thread_tasks;
+      {
+        std::scoped_lock thread_tasks_lock(tasks_mutex_);
+        if (HasThreadTasksLocked()) {
+          thread_tasks = GetThreadTasksLocked();
+        }
+      }
+      for (const auto& thread_task : thread_tasks) {
+        thread_task();
+      }
+      break;
+    }
+  }
+}
+
 void ConcurrentMessageLoop::Terminate() {
   std::scoped_lock lock(tasks_mutex_);
   shutdown_ = true;
+  work_stealing_shutdown_.store(true);
   tasks_condition_.notify_all();
 }
 
@@ -132,6 +291,7 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(fml::closure task) {
   for (const auto& worker_thread_id : worker_thread_ids_) {
     thread_tasks_[worker_thread_id].emplace_back(task);
   }
+  thread_task_generation_.fetch_add(1);
   tasks_condition_.notify_all();
 }
 
@@ -5,10 +5,15 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -21,13 +26,27 @@ class ConcurrentTaskRunner;
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
+  // How tasks posted to the loop are distributed among the workers.
+  enum class Scheduling {
+    // All workers take tasks from a single queue guarded by one mutex.
+    kSharedQueue,
+    // Each worker has its own deque of tasks. Tasks posted from a worker go to
+    // that worker's deque, other tasks are distributed round robin. Idle
+    // workers steal the oldest tasks from the other workers' deques. This
+    // reduces lock contention when many small tasks are posted at once.
+    kWorkStealing,
+  };
+
   static std::shared_ptr<ConcurrentMessageLoop> Create(
-      size_t worker_count = std::thread::hardware_concurrency());
+      size_t worker_count = std::thread::hardware_concurrency(),
+      Scheduling scheduling = Scheduling::kSharedQueue);
 
   ~ConcurrentMessageLoop();
 
   size_t GetWorkerCount() const;
 
+  Scheduling GetScheduling() const;
+
   std::shared_ptr<ConcurrentTaskRunner> GetTaskRunner();
 
   void Terminate();
@@ -37,7 +56,16 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  // The tasks of a single worker when using |Scheduling::kWorkStealing|. The
+  // owning worker takes tasks from the back, other workers steal from the
+  // front.
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<fml::closure> tasks;
+  };
+
   size_t worker_count_ = 0;
+  const Scheduling scheduling_;
   std::vector<std::thread> workers_;
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
@@ -46,12 +74,32 @@ class ConcurrentMessageLoop
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
   bool shutdown_ = false;
 
-  ConcurrentMessageLoop(size_t worker_count);
+  // Only used with |Scheduling::kWorkStealing|. |pending_tasks_| counts the
+  // tasks in all worker queues and |sleeping_workers_| the workers waiting on
+  // |tasks_condition_|, so that posting a task only needs to take
+  // |tasks_mutex_| when a worker has to be woken up. |work_stealing_shutdown_|
+  // mirrors |shutdown_| so that it can be read without the mutex.
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+  std::atomic_size_t pending_tasks_ = 0;
+  std::atomic_size_t sleeping_workers_ = 0;
+  std::atomic_size_t next_worker_queue_ = 0;
+  std::atomic_bool work_stealing_shutdown_ = false;
+  // Incremented whenever tasks are posted to all workers, so that a busy
+  // worker only takes |tasks_mutex_| to look for them when there are new ones.
+  std::atomic_size_t thread_task_generation_ = 0;
+
+  ConcurrentMessageLoop(size_t worker_count, Scheduling scheduling);
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
+
+  void WorkStealingWorkerMain(size_t worker_index);
 
   void PostTask(const fml::closure& task);
 
+  void PostWorkStealingTask(const fml::closure& task);
+
+  fml::closure TakeWorkStealingTask(size_t worker_index);
+
   bool HasThreadTasksLocked() const;
 
   std::vector<fml::closure> GetThreadTasksLocked();
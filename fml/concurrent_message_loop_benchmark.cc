@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+using Scheduling = ConcurrentMessageLoop::Scheduling;
+
+// Posts many small tasks from a thread outside the loop, like a burst of image
+// decodes being kicked off from the UI thread.
+static void BM_ConcurrentLoopPostTasks(benchmark::State& state,  // NOLINT
+                                       Scheduling scheduling) {
+  auto loop = ConcurrentMessageLoop::Create(state.range(0), scheduling);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t num_tasks = 10000;
+
+  while (state.KeepRunning()) {
+    CountDownLatch tasks_done(num_tasks);
+    for (size_t i = 0; i < num_tasks; i++) {
+      task_runner->PostTask([&tasks_done]() { tasks_done.CountDown(); });
+    }
+    tasks_done.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_tasks);
+}
+
+// Every task posted from outside the loop posts further tasks from the worker
+// it runs on, like shader compilation jobs that split up their work.
+static void BM_ConcurrentLoopPostTasksFromWorkers(
+    benchmark::State& state,  // NOLINT
+    Scheduling scheduling) {
+  auto loop = ConcurrentMessageLoop::Create(state.range(0), scheduling);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t num_root_tasks = 100;
+  const size_t num_child_tasks = 100;
+
+  while (state.KeepRunning()) {
+    CountDownLatch tasks_done(num_root_tasks * num_child_tasks);
+    for (size_t i = 0; i < num_root_tasks; i++) {
+      task_runner->PostTask([&tasks_done, task_runner]() {
+        for (size_t j = 0; j < num_child_tasks; j++) {
+          task_runner->PostTask([&tasks_done]() { tasks_done.CountDown(); });
+        }
+      });
+    }
+    tasks_done.Wait();
+  }
+
+  // Workers might still be returning from posting tasks. Make sure they are
+  // done before the loop is collected so that it isn't collected on a worker.
+  CountDownLatch workers_idle(loop->GetWorkerCount());
+  loop->PostTaskToAllWorkers([&workers_idle]() { workers_idle.CountDown(); });
+  workers_idle.Wait();
+
+  state.SetItemsProcessed(state.iterations() * num_root_tasks *
+                          num_child_tasks);
+}
+
+BENCHMARK_CAPTURE(BM_ConcurrentLoopPostTasks,
+                  SharedQueue,
+                  Scheduling::kSharedQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentLoopPostTasks,
+                  WorkStealing,
+                  Scheduling::kWorkStealing)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentLoopPostTasksFromWorkers,
+                  SharedQueue,
+                  Scheduling::kSharedQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentLoopPostTasksFromWorkers,
+                  WorkStealing,
+                  Scheduling::kWorkStealing)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
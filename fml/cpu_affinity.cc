@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace fml {
+
+std::vector<size_t> SelectCpus(const std::vector<int64_t>& max_frequencies,
+                               CpuAffinity affinity) {
+  std::vector<size_t> cpus;
+  if (max_frequencies.empty()) {
+    return cpus;
+  }
+  const auto [min_frequency, max_frequency] =
+      std::minmax_element(max_frequencies.begin(), max_frequencies.end());
+  const bool all_cpus = affinity == CpuAffinity::kAny ||
+                        *min_frequency == *max_frequency;
+  for (size_t i = 0; i < max_frequencies.size(); i++) {
+    const bool is_performance = max_frequencies[i] == *max_frequency;
+    if (all_cpus || (affinity == CpuAffinity::kPerformance) == is_performance) {
+      cpus.push_back(i);
+    }
+  }
+  return cpus;
+}
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+std::optional<std::vector<int64_t>> GetCpuMaxFrequencies() {
+  const long cpu_count = ::sysconf(_SC_NPROCESSORS_CONF);
+  if (cpu_count <= 0) {
+    return std::nullopt;
+  }
+  std::vector<int64_t> max_frequencies;
+  for (long i = 0; i < cpu_count; i++) {
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(i) +
+                       "/cpufreq/cpuinfo_max_freq");
+    int64_t max_frequency = 0;
+    if (!(file >> max_frequency)) {
+      return std::nullopt;
+    }
+    max_frequencies.push_back(max_frequency);
+  }
+  return max_frequencies;
+}
+
+static bool SetCurrentThreadCpus(const std::vector<size_t>& cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (size_t cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  if (CPU_COUNT(&set) == 0) {
+    return false;
+  }
+  if (::sched_setaffinity(0, sizeof(set), &set) != 0) {
+    FML_LOG(ERROR) << "Could not set the CPU affinity of the thread.";
+    return false;
+  }
+  return true;
+}
+
+bool SetCurrentThreadAffinity(CpuAffinity affinity) {
+  if (affinity == CpuAffinity::kAny) {
+    return true;
+  }
+  auto max_frequencies = GetCpuMaxFrequencies();
+  if (!max_frequencies) {
+    return false;
+  }
+  return SetCurrentThreadCpus(SelectCpus(*max_frequencies, affinity));
+}
+
+bool SetCurrentThreadAffinityMask(uint64_t mask) {
+  std::vector<size_t> cpus;
+  for (size_t i = 0; i < 64; i++) {
+    if (mask & (uint64_t{1} << i)) {
+      cpus.push_back(i);
+    }
+  }
+  return SetCurrentThreadCpus(cpus);
+}
+
+#else
+
+std::optional<std::vector<int64_t>> GetCpuMaxFrequencies() {
+  return std::nullopt;
+}
+
+bool SetCurrentThreadAffinity(CpuAffinity affinity) {
+  return affinity == CpuAffinity::kAny;
+}
+
+bool SetCurrentThreadAffinityMask(uint64_t mask) {
+  return false;
+}
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+}  // namespace fml
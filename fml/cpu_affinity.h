@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_CPU_AFFINITY_H_
+#define FLUTTER_FML_CPU_AFFINITY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace fml {
+
+/// The kind of cores a thread should run on, on systems whose cores run at
+/// different speeds, such as the ones with big.LITTLE SoCs.
+enum class CpuAffinity {
+  /// The thread may run on any core.
+  kAny,
+  /// The thread should only run on the fastest cores.
+  kPerformance,
+  /// The thread should only run on the cores that are not the fastest.
+  kEfficiency,
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Picks the cores for an affinity from their maximum frequencies.
+///
+/// @param[in]  max_frequencies  The maximum frequency of each core, indexed by
+///                              core.
+/// @param[in]  affinity         The kind of cores to pick.
+///
+/// @return     The indices of the picked cores. All cores are picked if they
+///             all run at the same speed, or for |CpuAffinity::kAny|.
+///
+std::vector<size_t> SelectCpus(const std::vector<int64_t>& max_frequencies,
+                               CpuAffinity affinity);
+
+//------------------------------------------------------------------------------
+/// @brief      Reads the maximum frequency of each core of the system.
+///
+/// @return     The frequencies, or |std::nullopt| if they are not available
+///             on this platform.
+///
+std::optional<std::vector<int64_t>> GetCpuMaxFrequencies();
+
+//------------------------------------------------------------------------------
+/// @brief      Restricts the current thread to the cores of an affinity.
+///
+/// @return     Whether the affinity was applied. This fails on platforms that
+///             do not support setting the affinity of a thread.
+///
+bool SetCurrentThreadAffinity(CpuAffinity affinity);
+
+//------------------------------------------------------------------------------
+/// @brief      Restricts the current thread to the cores whose bits are set in
+///             the mask, where bit N stands for core N.
+///
+/// @return     Whether the mask was applied. This fails on platforms that do
+///             not support setting the affinity of a thread.
+///
+bool SetCurrentThreadAffinityMask(uint64_t mask);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_CPU_AFFINITY_H_
@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(CpuAffinityTest, SelectsPerformanceCores) {
+  std::vector<int64_t> max_frequencies = {1800, 1800, 2400, 2400, 2800};
+  ASSERT_EQ(SelectCpus(max_frequencies, CpuAffinity::kPerformance),
+            std::vector<size_t>({4}));
+}
+
+TEST(CpuAffinityTest, SelectsEfficiencyCores) {
+  std::vector<int64_t> max_frequencies = {1800, 1800, 2400, 2400, 2800};
+  ASSERT_EQ(SelectCpus(max_frequencies, CpuAffinity::kEfficiency),
+            std::vector<size_t>({0, 1, 2, 3}));
+}
+
+TEST(CpuAffinityTest, SelectsAllCoresForAny) {
+  std::vector<int64_t> max_frequencies = {1800, 2800};
+  ASSERT_EQ(SelectCpus(max_frequencies, CpuAffinity::kAny),
+            std::vector<size_t>({0, 1}));
+}
+
+TEST(CpuAffinityTest, SelectsAllCoresOfTheSameSpeed) {
+  std::vector<int64_t> max_frequencies = {2000, 2000, 2000};
+  ASSERT_EQ(SelectCpus(max_frequencies, CpuAffinity::kEfficiency),
+            std::vector<size_t>({0, 1, 2}));
+  ASSERT_EQ(SelectCpus(max_frequencies, CpuAffinity::kPerformance),
+            std::vector<size_t>({0, 1, 2}));
+}
+
+TEST(CpuAffinityTest, SelectsNoCoresWithoutFrequencies) {
+  ASSERT_TRUE(SelectCpus({}, CpuAffinity::kPerformance).empty());
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -6,16 +6,24 @@
 
 #include "flutter/fml/delayed_task.h"
 
+#include <algorithm>
+
 namespace fml {
 
 DelayedTask::DelayedTask(size_t order,
                          const fml::closure& task,
                          fml::TimePoint target_time,
-                         fml::TaskSourceGrade task_source_grade)
+                         fml::TaskSourceGrade task_source_grade,
+                         fml::TaskPriority priority,
+                         fml::TimePoint deadline,
+                         fml::TimeDelta leeway)
     : order_(order),
       task_(task),
       target_time_(target_time),
-      task_source_grade_(task_source_grade) {}
+      task_source_grade_(task_source_grade),
+      priority_(priority),
+      deadline_(deadline),
+      leeway_(std::max(leeway, fml::TimeDelta::Zero())) {}
 
 DelayedTask::~DelayedTask() = default;
 
@@ -33,6 +41,41 @@ fml::TaskSourceGrade DelayedTask::GetTaskSourceGrade() const {
   return task_source_grade_;
 }
 
+fml::TaskPriority DelayedTask::GetPriority() const {
+  return priority_;
+}
+
+fml::TimePoint DelayedTask::GetDeadline() const {
+  return deadline_;
+}
+
+fml::TimeDelta DelayedTask::GetLeeway() const {
+  return leeway_;
+}
+
+fml::TimePoint DelayedTask::GetLatestTime() const {
+  if (target_time_ > fml::TimePoint::Max() - leeway_) {
+    return fml::TimePoint::Max();
+  }
+  return target_time_ + leeway_;
+}
+
+fml::TaskPriority DelayedTask::GetPriorityAt(fml::TimePoint now) const {
+  return deadline_ <= now ? fml::TaskPriority::kFrameCritical : priority_;
+}
+
+bool DelayedTask::RunsBefore(const DelayedTask& other,
+                             fml::TimePoint now) const {
+  if (target_time_ <= now && other.target_time_ <= now) {
+    const fml::TaskPriority priority = GetPriorityAt(now);
+    const fml::TaskPriority other_priority = other.GetPriorityAt(now);
+    if (priority != other_priority) {
+      return priority < other_priority;
+    }
+  }
+  return other > *this;
+}
+
 bool DelayedTask::operator>(const DelayedTask& other) const {
   if (target_time_ == other.target_time_) {
     return order_ > other.order_;
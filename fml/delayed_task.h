@@ -8,6 +8,7 @@
 #include <queue>
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/task_source_grade.h"
 #include "flutter/fml/time/time_point.h"
 
@@ -18,7 +19,10 @@ class DelayedTask {
   DelayedTask(size_t order,
               const fml::closure& task,
               fml::TimePoint target_time,
-              fml::TaskSourceGrade task_source_grade);
+              fml::TaskSourceGrade task_source_grade,
+              fml::TaskPriority priority = fml::TaskPriority::kNormal,
+              fml::TimePoint deadline = fml::TimePoint::Max(),
+              fml::TimeDelta leeway = fml::TimeDelta::Zero());
 
   DelayedTask(const DelayedTask& other);
 
@@ -30,6 +34,24 @@ class DelayedTask {
 
   fml::TaskSourceGrade GetTaskSourceGrade() const;
 
+  fml::TaskPriority GetPriority() const;
+
+  // Once the deadline has passed, the task runs as if it were
+  // |TaskPriority::kFrameCritical|.
+  fml::TimePoint GetDeadline() const;
+
+  // How much later than its target time the task may run, so that waking up
+  // for it can be coalesced with other wakeups.
+  fml::TimeDelta GetLeeway() const;
+
+  // The target time plus the leeway.
+  fml::TimePoint GetLatestTime() const;
+
+  // Whether the task runs before |other| when the next task to run at |now| is
+  // picked. Tasks that are due run in the order of their priorities, and all
+  // tasks otherwise run in the order of their target times.
+  bool RunsBefore(const DelayedTask& other, fml::TimePoint now) const;
+
   bool operator>(const DelayedTask& other) const;
 
  private:
@@ -37,6 +59,11 @@ class DelayedTask {
   fml::closure task_;
   fml::TimePoint target_time_;
   fml::TaskSourceGrade task_source_grade_;
+  fml::TaskPriority priority_;
+  fml::TimePoint deadline_;
+  fml::TimeDelta leeway_;
+
+  fml::TaskPriority GetPriorityAt(fml::TimePoint now) const;
 };
 
 using DelayedTaskQueue = std::priority_queue<DelayedTask,
@@ -72,6 +72,17 @@ bool IsFile(const std::string& path);
 
 bool TruncateFile(const fml::UniqueFD& file, size_t size);
 
+/// Flushes the contents of the file to the storage device.
+bool SyncFile(const fml::UniqueFD& file);
+
+/// Writes all of the |size| bytes at |data| to |file| starting at |offset|,
+/// growing the file if needed. Unlike writing through a mapping, this works
+/// while other parts of the file are mapped.
+bool WriteFileAt(const fml::UniqueFD& file,
+                 size_t offset,
+                 const uint8_t* data,
+                 size_t size);
+
 bool FileExists(const fml::UniqueFD& base_directory, const char* path);
 
 bool UnlinkDirectory(const char* path);
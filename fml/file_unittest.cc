@@ -104,6 +104,64 @@ TEST(FileTest, CanTruncateAndWrite) {
   fml::UnlinkFile(dir.fd(), "some.txt");
 }
 
+TEST(FileTest, CanWriteAtOffsetWhileMapped) {
+  fml::ScopedTemporaryDirectory dir;
+  auto fd = fml::OpenFile(dir.fd(), "some.txt", true,
+                          fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(fd.is_valid());
+
+  const std::string first = "first";
+  const std::string second = "second";
+  ASSERT_TRUE(fml::WriteFileAt(
+      fd, 0, reinterpret_cast<const uint8_t*>(first.data()), first.size()));
+  {
+    fml::FileMapping mapping(fd);
+    ASSERT_EQ(mapping.GetSize(), first.size());
+    ASSERT_TRUE(fml::WriteFileAt(
+        fd, first.size(), reinterpret_cast<const uint8_t*>(second.data()),
+        second.size()));
+    ASSERT_EQ(0, ::memcmp(mapping.GetMapping(), first.data(), first.size()));
+  }
+
+  {
+    fml::FileMapping mapping(fd);
+    ASSERT_EQ(mapping.GetSize(), first.size() + second.size());
+    ASSERT_EQ(0, ::memcmp(mapping.GetMapping() + first.size(), second.data(),
+                          second.size()));
+  }
+  fd.reset();
+  fml::UnlinkFile(dir.fd(), "some.txt");
+}
+
+TEST(FileTest, CanPrefaultMappingWithAccessHints) {
+  fml::ScopedTemporaryDirectory dir;
+
+  // Spans a few pages, and ends in the middle of one.
+  std::string contents(3 * 4096 + 100, 'x');
+  fml::DataMapping data(contents);
+  ASSERT_TRUE(fml::WriteAtomically(dir.fd(), "some.txt", data));
+
+  {
+    auto fd =
+        fml::OpenFile(dir.fd(), "some.txt", false, fml::FilePermission::kRead);
+    ASSERT_TRUE(fd.is_valid());
+
+    fml::FileMapping mapping(fd);
+    ASSERT_EQ(mapping.GetSize(), contents.size());
+    ASSERT_TRUE(mapping.Advise({fml::FileMapping::AccessHint::kWillNeed}));
+    // Huge pages are not supported everywhere, but mustn't affect the
+    // mapping.
+    mapping.Advise({fml::FileMapping::AccessHint::kHugePages});
+    mapping.Advise({fml::FileMapping::AccessHint::kRandom});
+    mapping.Prefault();
+
+    ASSERT_EQ(0,
+              ::memcmp(mapping.GetMapping(), contents.data(), contents.size()));
+  }
+
+  fml::UnlinkFile(dir.fd(), "some.txt");
+}
+
 TEST(FileTest, CreateDirectoryStructure) {
   fml::ScopedTemporaryDirectory dir;
 
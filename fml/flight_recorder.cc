@@ -0,0 +1,300 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/flight_recorder.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+
+#include "flutter/fml/thread_local.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+constexpr size_t kNameWords = (kFlightRecorderMaxNameLength + 1) / 8;
+static_assert(kNameWords * 8 == kFlightRecorderMaxNameLength + 1,
+              "Names must fill whole words including the terminator.");
+
+// A slot of a ring buffer. The fields are only written by the thread that
+// owns the buffer, and are guarded by a sequence lock so that a reader on
+// another thread can tell whether it read a slot while it was overwritten.
+struct Slot {
+  // Odd while the slot is being written.
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<int64_t> timestamp_micros{0};
+  std::atomic<int64_t> id{0};
+  std::atomic<int32_t> type{0};
+  std::atomic<uint64_t> thread_id{0};
+  std::array<std::atomic<uint64_t>, kNameWords> name = {};
+};
+
+struct ThreadBuffer {
+  // The number of events ever recorded into the buffer.
+  std::atomic<uint64_t> count{0};
+  // Whether a live thread records into the buffer.
+  std::atomic<bool> in_use{false};
+  std::array<Slot, kFlightRecorderEventsPerThread> slots;
+};
+
+std::atomic<bool> gEnabled{false};
+std::atomic<uint64_t> gLastThreadId{0};
+
+// Buffers are never freed, so that the events of threads that have exited
+// can still be dumped. The buffer of a thread that has exited is taken over
+// by the next thread that needs one.
+std::mutex gBuffersMutex;
+std::array<std::atomic<ThreadBuffer*>, kFlightRecorderMaxThreads> gBuffers = {};
+
+class ThreadRegistration {
+ public:
+  ThreadRegistration()
+      : buffer_(AcquireBuffer()), thread_id_(++gLastThreadId) {}
+
+  ~ThreadRegistration() {
+    if (buffer_) {
+      buffer_->in_use.store(false, std::memory_order_release);
+    }
+  }
+
+  ThreadBuffer* buffer() const { return buffer_; }
+  uint64_t thread_id() const { return thread_id_; }
+
+ private:
+  ThreadBuffer* const buffer_;
+  const uint64_t thread_id_;
+
+  static ThreadBuffer* AcquireBuffer() {
+    std::scoped_lock lock(gBuffersMutex);
+    for (auto& entry : gBuffers) {
+      ThreadBuffer* buffer = entry.load(std::memory_order_relaxed);
+      if (!buffer) {
+        buffer = new ThreadBuffer();
+        buffer->in_use.store(true, std::memory_order_relaxed);
+        entry.store(buffer, std::memory_order_release);
+        return buffer;
+      }
+      if (!buffer->in_use.load(std::memory_order_acquire)) {
+        buffer->in_use.store(true, std::memory_order_relaxed);
+        return buffer;
+      }
+    }
+    // All buffers are in use, so this thread is not recorded.
+    return nullptr;
+  }
+};
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadRegistration> tls_registration;
+
+const ThreadRegistration& GetThreadRegistration() {
+  if (!tls_registration.get()) {
+    tls_registration.reset(new ThreadRegistration());
+  }
+  return *tls_registration.get();
+}
+
+bool ReadSlot(const Slot& slot, FlightRecorderEvent* event) {
+  const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+  if (sequence == 0 || sequence % 2 == 1) {
+    return false;
+  }
+  char name[kFlightRecorderMaxNameLength + 1];
+  for (size_t i = 0; i < kNameWords; i++) {
+    const uint64_t word = slot.name[i].load(std::memory_order_relaxed);
+    std::memcpy(name + i * 8, &word, 8);
+  }
+  event->timestamp_micros =
+      slot.timestamp_micros.load(std::memory_order_relaxed);
+  event->id = slot.id.load(std::memory_order_relaxed);
+  event->type = static_cast<Dart_Timeline_Event_Type>(
+      slot.type.load(std::memory_order_relaxed));
+  event->thread_id = slot.thread_id.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+    return false;
+  }
+  name[kFlightRecorderMaxNameLength] = '\0';
+  event->name = name;
+  return true;
+}
+
+const char* GetPhase(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      return "B";
+    case Dart_Timeline_Event_End:
+      return "E";
+    case Dart_Timeline_Event_Instant:
+      return "i";
+    case Dart_Timeline_Event_Duration:
+      return "X";
+    case Dart_Timeline_Event_Async_Begin:
+      return "b";
+    case Dart_Timeline_Event_Async_End:
+      return "e";
+    case Dart_Timeline_Event_Async_Instant:
+      return "n";
+    case Dart_Timeline_Event_Flow_Begin:
+      return "s";
+    case Dart_Timeline_Event_Flow_Step:
+      return "t";
+    case Dart_Timeline_Event_Flow_End:
+      return "f";
+    default:
+      return nullptr;
+  }
+}
+
+bool HasId(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Async_Begin:
+    case Dart_Timeline_Event_Async_End:
+    case Dart_Timeline_Event_Async_Instant:
+    case Dart_Timeline_Event_Flow_Begin:
+    case Dart_Timeline_Event_Flow_Step:
+    case Dart_Timeline_Event_Flow_End:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void WriteJsonString(std::ostream& stream, const std::string& string) {
+  stream << '"';
+  for (char c : string) {
+    if (c == '"' || c == '\\') {
+      stream << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      stream << ' ';
+    } else {
+      stream << c;
+    }
+  }
+  stream << '"';
+}
+
+}  // namespace
+
+void FlightRecorderSetEnabled(bool enabled) {
+  gEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool FlightRecorderIsEnabled() {
+  return gEnabled.load(std::memory_order_relaxed);
+}
+
+void FlightRecorderRecord(const char* name,
+                          int64_t timestamp_micros,
+                          int64_t id,
+                          Dart_Timeline_Event_Type type) {
+  if (!gEnabled.load(std::memory_order_relaxed) || !name ||
+      GetPhase(type) == nullptr) {
+    return;
+  }
+  const ThreadRegistration& registration = GetThreadRegistration();
+  ThreadBuffer* buffer = registration.buffer();
+  if (!buffer) {
+    return;
+  }
+
+  const uint64_t count = buffer->count.load(std::memory_order_relaxed);
+  Slot& slot = buffer->slots[count % kFlightRecorderEventsPerThread];
+  const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  char padded_name[kFlightRecorderMaxNameLength + 1] = {};
+  std::strncpy(padded_name, name, kFlightRecorderMaxNameLength);
+  for (size_t i = 0; i < kNameWords; i++) {
+    uint64_t word;
+    std::memcpy(&word, padded_name + i * 8, 8);
+    slot.name[i].store(word, std::memory_order_relaxed);
+  }
+  slot.timestamp_micros.store(timestamp_micros, std::memory_order_relaxed);
+  slot.id.store(id, std::memory_order_relaxed);
+  slot.type.store(type, std::memory_order_relaxed);
+  slot.thread_id.store(registration.thread_id(), std::memory_order_relaxed);
+
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+  buffer->count.store(count + 1, std::memory_order_release);
+}
+
+std::vector<FlightRecorderEvent> FlightRecorderSnapshot() {
+  std::vector<FlightRecorderEvent> events;
+  for (const auto& entry : gBuffers) {
+    const ThreadBuffer* buffer = entry.load(std::memory_order_acquire);
+    if (!buffer) {
+      continue;
+    }
+    const uint64_t count = buffer->count.load(std::memory_order_acquire);
+    const uint64_t first =
+        count > kFlightRecorderEventsPerThread
+            ? count - kFlightRecorderEventsPerThread
+            : 0;
+    for (uint64_t i = first; i < count; i++) {
+      FlightRecorderEvent event;
+      if (ReadSlot(buffer->slots[i % kFlightRecorderEventsPerThread],
+                   &event)) {
+        events.push_back(std::move(event));
+      }
+    }
+  }
+  std::stable_sort(events.begin(), events.end(),
+                   [](const FlightRecorderEvent& a,
+                      const FlightRecorderEvent& b) {
+                     return a.timestamp_micros < b.timestamp_micros;
+                   });
+  return events;
+}
+
+std::string FlightRecorderEventsToJson(
+    const std::vector<FlightRecorderEvent>& events) {
+  std::ostringstream stream;
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto& event : events) {
+    const char* phase = GetPhase(event.type);
+    if (!phase) {
+      continue;
+    }
+    if (!first) {
+      stream << ',';
+    }
+    first = false;
+    stream << "{\"name\":";
+    WriteJsonString(stream, event.name);
+    stream << ",\"cat\":\"flutter\",\"ph\":\"" << phase
+           << "\",\"ts\":" << event.timestamp_micros
+           << ",\"pid\":0,\"tid\":" << event.thread_id;
+    if (HasId(event.type)) {
+      stream << ",\"id\":" << event.id;
+    }
+    if (event.type == Dart_Timeline_Event_Instant) {
+      stream << ",\"s\":\"t\"";
+    }
+    stream << '}';
+  }
+  stream << "],\"displayTimeUnit\":\"ms\"}";
+  return stream.str();
+}
+
+void FlightRecorderClear() {
+  for (const auto& entry : gBuffers) {
+    ThreadBuffer* buffer = entry.load(std::memory_order_acquire);
+    if (!buffer) {
+      continue;
+    }
+    for (auto& slot : buffer->slots) {
+      slot.sequence.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_FLIGHT_RECORDER_H_
+#define FLUTTER_FML_FLIGHT_RECORDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// The flight recorder keeps the most recent trace events of each thread in
+/// memory, whether or not a tracing session is running, so that they can be
+/// dumped after a janky frame was noticed in the field.
+///
+/// Each thread records into a ring buffer of its own without taking locks.
+/// Only the first |kFlightRecorderMaxThreads| threads that trace at the same
+/// time get a buffer, which caps the memory used by the flight recorder at a
+/// few hundred kilobytes. Arguments of trace events are not recorded, and
+/// names are truncated to |kFlightRecorderMaxNameLength| characters.
+///
+constexpr size_t kFlightRecorderEventsPerThread = 512;
+constexpr size_t kFlightRecorderMaxThreads = 8;
+constexpr size_t kFlightRecorderMaxNameLength = 39;
+
+/// A trace event that was read back from the flight recorder.
+struct FlightRecorderEvent {
+  std::string name;
+  int64_t timestamp_micros;
+  int64_t id;
+  Dart_Timeline_Event_Type type;
+  uint64_t thread_id;
+};
+
+void FlightRecorderSetEnabled(bool enabled);
+
+bool FlightRecorderIsEnabled();
+
+//------------------------------------------------------------------------------
+/// @brief      Records a trace event of the current thread, if the flight
+///             recorder is enabled. Counter and metadata events are ignored.
+///
+void FlightRecorderRecord(const char* name,
+                          int64_t timestamp_micros,
+                          int64_t id,
+                          Dart_Timeline_Event_Type type);
+
+//------------------------------------------------------------------------------
+/// @brief      Copies the events that are recorded at the moment out of the
+///             ring buffers of all threads. Threads may continue to record
+///             while this runs, and the events they overwrite in the meantime
+///             are skipped.
+///
+/// @return     The events ordered by their timestamps.
+///
+std::vector<FlightRecorderEvent> FlightRecorderSnapshot();
+
+//------------------------------------------------------------------------------
+/// @brief      Formats events in the Chrome trace event JSON format, which
+///             Perfetto and chrome://tracing can open.
+///
+std::string FlightRecorderEventsToJson(
+    const std::vector<FlightRecorderEvent>& events);
+
+//------------------------------------------------------------------------------
+/// @brief      Discards the events of all threads. Only for tests, as events
+///             that are being recorded while this runs may still be kept.
+///
+void FlightRecorderClear();
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_FLIGHT_RECORDER_H_
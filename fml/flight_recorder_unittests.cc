@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/flight_recorder.h"
+
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+class FlightRecorderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FlightRecorderSetEnabled(true);
+    FlightRecorderClear();
+  }
+
+  void TearDown() override {
+    FlightRecorderSetEnabled(false);
+    FlightRecorderClear();
+  }
+};
+
+TEST_F(FlightRecorderTest, RecordsEventsInOrder) {
+  FlightRecorderRecord("Second", 20, 0, Dart_Timeline_Event_End);
+  FlightRecorderRecord("First", 10, 0, Dart_Timeline_Event_Begin);
+
+  auto events = FlightRecorderSnapshot();
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[0].name, "First");
+  ASSERT_EQ(events[0].timestamp_micros, 10);
+  ASSERT_EQ(events[0].type, Dart_Timeline_Event_Begin);
+  ASSERT_EQ(events[1].name, "Second");
+  ASSERT_EQ(events[0].thread_id, events[1].thread_id);
+}
+
+TEST_F(FlightRecorderTest, DoesNotRecordWhenDisabled) {
+  FlightRecorderSetEnabled(false);
+  FlightRecorderRecord("Event", 10, 0, Dart_Timeline_Event_Begin);
+  ASSERT_TRUE(FlightRecorderSnapshot().empty());
+}
+
+TEST_F(FlightRecorderTest, KeepsOnlyTheMostRecentEvents) {
+  const size_t count = kFlightRecorderEventsPerThread + 10;
+  for (size_t i = 0; i < count; i++) {
+    FlightRecorderRecord("Event", i, 0, Dart_Timeline_Event_Instant);
+  }
+
+  auto events = FlightRecorderSnapshot();
+  ASSERT_EQ(events.size(), kFlightRecorderEventsPerThread);
+  ASSERT_EQ(events.front().timestamp_micros, 10);
+  ASSERT_EQ(events.back().timestamp_micros, static_cast<int64_t>(count - 1));
+}
+
+TEST_F(FlightRecorderTest, TruncatesLongNames) {
+  const std::string name(kFlightRecorderMaxNameLength + 10, 'a');
+  FlightRecorderRecord(name.c_str(), 10, 0, Dart_Timeline_Event_Instant);
+
+  auto events = FlightRecorderSnapshot();
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_EQ(events[0].name, std::string(kFlightRecorderMaxNameLength, 'a'));
+}
+
+TEST_F(FlightRecorderTest, IgnoresCounters) {
+  FlightRecorderRecord("Counter", 10, 0, Dart_Timeline_Event_Counter);
+  ASSERT_TRUE(FlightRecorderSnapshot().empty());
+}
+
+TEST_F(FlightRecorderTest, RecordsEachThreadSeparately) {
+  FlightRecorderRecord("Main", 10, 0, Dart_Timeline_Event_Instant);
+  std::thread([]() {
+    FlightRecorderRecord("Other", 20, 0, Dart_Timeline_Event_Instant);
+  }).join();
+
+  auto events = FlightRecorderSnapshot();
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[1].name, "Other");
+  ASSERT_NE(events[0].thread_id, events[1].thread_id);
+}
+
+TEST_F(FlightRecorderTest, FormatsChromeTraceJson) {
+  std::vector<FlightRecorderEvent> events = {
+      {"Draw \"frame\"", 10, 0, Dart_Timeline_Event_Begin, 1},
+      {"Frame", 12, 7, Dart_Timeline_Event_Async_Begin, 2},
+  };
+  ASSERT_EQ(FlightRecorderEventsToJson(events),
+            "{\"traceEvents\":["
+            "{\"name\":\"Draw \\\"frame\\\"\",\"cat\":\"flutter\",\"ph\":\"B\","
+            "\"ts\":10,\"pid\":0,\"tid\":1},"
+            "{\"name\":\"Frame\",\"cat\":\"flutter\",\"ph\":\"b\",\"ts\":12,"
+            "\"pid\":0,\"tid\":2,\"id\":7}"
+            "],\"displayTimeUnit\":\"ms\"}");
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
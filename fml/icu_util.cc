@@ -60,6 +60,10 @@ class ICUContext {
     auto file_mapping =
         std::make_unique<FileMapping>(fd, std::move(protection));
 
+    // ICU looks up the few items it needs in a large table of contents, so
+    // reading ahead around them would only make unused data resident.
+    file_mapping->Advise({FileMapping::AccessHint::kRandom});
+
     if (file_mapping->GetSize() != 0) {
       mapping_ = std::move(file_mapping);
       return true;
@@ -117,5 +121,35 @@ void InitializeICUFromMapping(std::unique_ptr<Mapping> mapping) {
   });
 }
 
+std::mutex g_lazy_initializer_mutex;
+std::function<void()> g_lazy_initializer;
+
+void InitializeICULazily(const std::string& icu_data_path) {
+  std::scoped_lock lock(g_lazy_initializer_mutex);
+  if (!g_lazy_initializer) {
+    g_lazy_initializer = [icu_data_path]() { InitializeICU(icu_data_path); };
+  }
+}
+
+void InitializeICUFromMappingLazily(
+    std::function<std::unique_ptr<Mapping>()> mapping_callback) {
+  std::scoped_lock lock(g_lazy_initializer_mutex);
+  if (!g_lazy_initializer) {
+    g_lazy_initializer = [mapping_callback = std::move(mapping_callback)]() {
+      InitializeICUFromMapping(mapping_callback());
+    };
+  }
+}
+
+void EnsureICUInitialized() {
+  // The lock is held while ICU is initialized, so that the other callers wait
+  // for the data to be usable.
+  std::scoped_lock lock(g_lazy_initializer_mutex);
+  if (g_lazy_initializer) {
+    g_lazy_initializer();
+    g_lazy_initializer = nullptr;
+  }
+}
+
 }  // namespace icu
 }  // namespace fml
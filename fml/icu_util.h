@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FML_ICU_UTIL_H_
 #define FLUTTER_FML_ICU_UTIL_H_
 
+#include <functional>
+#include <memory>
 #include <string>
 
 #include "flutter/fml/macros.h"
@@ -17,6 +19,21 @@ void InitializeICU(const std::string& icu_data_path = "");
 
 void InitializeICUFromMapping(std::unique_ptr<Mapping> mapping);
 
+// Same as InitializeICU, but only maps the data and hands it to ICU on the
+// first call to EnsureICUInitialized. Does nothing if ICU was initialized
+// already.
+void InitializeICULazily(const std::string& icu_data_path);
+
+// Same as InitializeICUFromMapping, but only calls |mapping_callback| on the
+// first call to EnsureICUInitialized.
+void InitializeICUFromMappingLazily(
+    std::function<std::unique_ptr<Mapping>()> mapping_callback);
+
+// Finishes a lazy initialization of ICU, which must be done before any ICU
+// service that needs its data is used. Blocks if another thread is already
+// finishing it. Does nothing if ICU is initialized or wasn't set up lazily.
+void EnsureICUInitialized();
+
 }  // namespace icu
 }  // namespace fml
 
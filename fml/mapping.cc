@@ -5,6 +5,8 @@
 #include "flutter/fml/mapping.h"
 
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 
 namespace fml {
@@ -15,6 +17,16 @@ uint8_t* FileMapping::GetMutableMapping() {
   return mutable_mapping_;
 }
 
+void FileMapping::Prefault() const {
+  // No page is smaller than this on the supported platforms, so reading at
+  // this stride touches every page.
+  constexpr size_t kMinPageSize = 4096;
+  const volatile uint8_t* mapping = mapping_;
+  for (size_t offset = 0; offset < size_; offset += kMinPageSize) {
+    static_cast<void>(mapping[offset]);
+  }
+}
+
 std::unique_ptr<FileMapping> FileMapping::CreateReadOnly(
     const std::string& path) {
   return CreateReadOnly(OpenFile(path.c_str(), false, FilePermission::kRead),
@@ -81,6 +93,60 @@ const uint8_t* DataMapping::GetMapping() const {
   return data_.data();
 }
 
+// MallocMapping
+
+MallocMapping::MallocMapping() : data_(nullptr), size_(0) {}
+
+MallocMapping::MallocMapping(uint8_t* data, size_t size)
+    : data_(data), size_(size) {}
+
+MallocMapping::MallocMapping(fml::MallocMapping&& mapping)
+    : data_(mapping.data_), size_(mapping.size_) {
+  mapping.data_ = nullptr;
+  mapping.size_ = 0;
+}
+
+MallocMapping& MallocMapping::operator=(fml::MallocMapping&& mapping) {
+  if (this != &mapping) {
+    free(data_);
+    data_ = mapping.data_;
+    size_ = mapping.size_;
+    mapping.data_ = nullptr;
+    mapping.size_ = 0;
+  }
+  return *this;
+}
+
+MallocMapping::~MallocMapping() {
+  free(data_);
+  data_ = nullptr;
+}
+
+MallocMapping MallocMapping::Copy(const void* begin, size_t length) {
+  auto result =
+      MallocMapping(reinterpret_cast<uint8_t*>(malloc(length)), length);
+  FML_CHECK(result.GetMapping() != nullptr || length == 0);
+  if (length > 0) {
+    memcpy(const_cast<uint8_t*>(result.GetMapping()), begin, length);
+  }
+  return result;
+}
+
+size_t MallocMapping::GetSize() const {
+  return size_;
+}
+
+const uint8_t* MallocMapping::GetMapping() const {
+  return data_;
+}
+
+uint8_t* MallocMapping::Release() {
+  uint8_t* result = data_;
+  data_ = nullptr;
+  size_ = 0;
+  return result;
+}
+
 // NonOwnedMapping
 
 NonOwnedMapping::NonOwnedMapping(const uint8_t* data,
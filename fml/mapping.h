@@ -12,6 +12,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/unique_fd.h"
@@ -40,6 +41,24 @@ class FileMapping final : public Mapping {
     kExecute,
   };
 
+  // Hints about how a mapping is going to be accessed, which the system may
+  // use to read it ahead. They are best effort and don't change what is read
+  // from the mapping.
+  enum class AccessHint {
+    // The whole mapping is going to be accessed soon, so it is read into the
+    // page cache in the background.
+    kWillNeed,
+    // The mapping is going to be accessed in order, so it is read ahead
+    // aggressively and pages behind are dropped early.
+    kSequential,
+    // The mapping is large and accessed a lot, so it is best backed by huge
+    // pages where the system supports that for files.
+    kHugePages,
+    // The mapping is accessed at scattered offsets, so it is not read ahead
+    // and only the pages that are touched become resident.
+    kRandom,
+  };
+
   FileMapping(const fml::UniqueFD& fd,
               std::initializer_list<Protection> protection = {
                   Protection::kRead});
@@ -69,6 +88,15 @@ class FileMapping final : public Mapping {
 
   bool IsValid() const;
 
+  // Passes |hints| on to the system. Returns whether all of them were
+  // accepted, which they may not be on some platforms.
+  bool Advise(std::initializer_list<AccessHint> hints) const;
+
+  // Reads from every page of the mapping, so that later accesses neither page
+  // fault nor wait for the file to be read. Blocks until the whole mapping was
+  // read, so it is meant to be called on a background thread.
+  void Prefault() const;
+
  private:
   bool valid_ = false;
   size_t size_ = 0;
@@ -102,6 +130,57 @@ class DataMapping final : public Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(DataMapping);
 };
 
+/// A mapping that owns a buffer allocated with `malloc` and frees it when
+/// collected. The buffer can be handed off with |Release|, e.g. to Dart
+/// external typed data that frees it in its finalizer.
+class MallocMapping final : public Mapping {
+ public:
+  MallocMapping();
+
+  /// Creates a MallocMapping for a region of memory (without copying it).
+  /// @param data The starting address of the mapping, allocated with `malloc`.
+  /// @param size The size of the mapping in bytes.
+  MallocMapping(uint8_t* data, size_t size);
+
+  MallocMapping(fml::MallocMapping&& mapping);
+
+  MallocMapping& operator=(fml::MallocMapping&& mapping);
+
+  ~MallocMapping() override;
+
+  /// Copies the data from `begin` to `end`.
+  /// It's templated since void* arithmetic isn't allowed and we want support
+  /// for `uint8_t` and `char`.
+  template <typename T>
+  static MallocMapping Copy(const T* begin, const T* end) {
+    FML_DCHECK(end >= begin);
+    size_t length = end - begin;
+    return Copy(begin, length);
+  }
+
+  /// Copies a region of memory into a MallocMapping.
+  /// The function will `abort()` if the malloc fails.
+  /// @param begin The starting address of where we will copy.
+  /// @param length The length of the region to copy in bytes.
+  static MallocMapping Copy(const void* begin, size_t length);
+
+  // |Mapping|
+  size_t GetSize() const override;
+
+  // |Mapping|
+  const uint8_t* GetMapping() const override;
+
+  /// Removes ownership of the data buffer.
+  /// After this is called; the mapping will point to nullptr.
+  [[nodiscard]] uint8_t* Release();
+
+ private:
+  uint8_t* data_;
+  size_t size_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MallocMapping);
+};
+
 class NonOwnedMapping final : public Mapping {
  public:
   using ReleaseProc = std::function<void(const uint8_t* data, size_t size)>;
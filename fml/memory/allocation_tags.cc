@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/allocation_tags.h"
+
+#include <atomic>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+namespace {
+
+constexpr size_t kTagCount = static_cast<size_t>(AllocationTag::kCount);
+
+// The counters of each tag are on their own cache line, so that threads
+// allocating under different tags do not contend on them.
+struct alignas(64) TagCounters {
+  std::atomic<int64_t> live_bytes{0};
+  std::atomic<int64_t> live_allocations{0};
+  std::atomic<uint64_t> total_bytes{0};
+  std::atomic<uint64_t> total_allocations{0};
+};
+
+// Constant initialized, so that the hook can record allocations made by the
+// static initializers that run before this file's.
+TagCounters gTagCounters[kTagCount];
+std::atomic<bool> gEnabled{false};
+
+thread_local AllocationTag tCurrentTag = AllocationTag::kUntagged;
+
+TagCounters& CountersForTag(AllocationTag tag) {
+  return gTagCounters[static_cast<size_t>(tag)];
+}
+
+}  // namespace
+
+bool AllocationTags::IsEnabled() {
+  return gEnabled.load(std::memory_order_relaxed);
+}
+
+AllocationTag AllocationTags::GetCurrentTag() {
+  return tCurrentTag;
+}
+
+const char* AllocationTags::GetName(AllocationTag tag) {
+  switch (tag) {
+    case AllocationTag::kUntagged:
+      return "untagged";
+    case AllocationTag::kLayerTree:
+      return "layerTree";
+    case AllocationTag::kRasterCache:
+      return "rasterCache";
+    case AllocationTag::kText:
+      return "text";
+    case AllocationTag::kImage:
+      return "image";
+    case AllocationTag::kPlatformMessages:
+      return "platformMessages";
+    case AllocationTag::kSemantics:
+      return "semantics";
+    case AllocationTag::kCount:
+      break;
+  }
+  FML_DCHECK(false);
+  return "";
+}
+
+AllocationTagStats AllocationTags::GetStats(AllocationTag tag) {
+  const TagCounters& counters = CountersForTag(tag);
+  AllocationTagStats stats;
+  stats.live_bytes = counters.live_bytes.load(std::memory_order_relaxed);
+  stats.live_allocations =
+      counters.live_allocations.load(std::memory_order_relaxed);
+  stats.total_bytes = counters.total_bytes.load(std::memory_order_relaxed);
+  stats.total_allocations =
+      counters.total_allocations.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void AllocationTags::TraceCounters() {
+#if !FLUTTER_RELEASE
+  if (!IsEnabled()) {
+    return;
+  }
+  auto live_bytes = [](AllocationTag tag) {
+    return CountersForTag(tag).live_bytes.load(std::memory_order_relaxed);
+  };
+  FML_TRACE_COUNTER("flutter", "AllocationTags", 0,  //
+                    "untagged", live_bytes(AllocationTag::kUntagged),
+                    "layerTree", live_bytes(AllocationTag::kLayerTree),
+                    "rasterCache", live_bytes(AllocationTag::kRasterCache),
+                    "text", live_bytes(AllocationTag::kText),  //
+                    "image", live_bytes(AllocationTag::kImage),
+                    "platformMessages",
+                    live_bytes(AllocationTag::kPlatformMessages),
+                    "semantics", live_bytes(AllocationTag::kSemantics));
+#endif  // !FLUTTER_RELEASE
+}
+
+void AllocationTags::SetEnabled() {
+  gEnabled.store(true, std::memory_order_relaxed);
+}
+
+void AllocationTags::RecordAllocation(AllocationTag tag, size_t bytes) {
+  TagCounters& counters = CountersForTag(tag);
+  counters.live_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  counters.live_allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.total_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  counters.total_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocationTags::RecordFree(AllocationTag tag, size_t bytes) {
+  TagCounters& counters = CountersForTag(tag);
+  counters.live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+  counters.live_allocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+ScopedAllocationTag::ScopedAllocationTag(AllocationTag tag)
+    : previous_(tCurrentTag) {
+  tCurrentTag = tag;
+}
+
+ScopedAllocationTag::~ScopedAllocationTag() {
+  tCurrentTag = previous_;
+}
+
+}  // namespace fml
@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_MEMORY_ALLOCATION_TAGS_H_
+#define FLUTTER_FML_MEMORY_ALLOCATION_TAGS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// The engine subsystems the allocations on the native heap are attributed
+/// to. The allocations made on a thread are attributed to the innermost
+/// |ScopedAllocationTag| alive on that thread, or to |kUntagged| if there is
+/// none.
+enum class AllocationTag : uint8_t {
+  kUntagged,
+  kLayerTree,
+  kRasterCache,
+  kText,
+  kImage,
+  kPlatformMessages,
+  kSemantics,
+  kCount,
+};
+
+struct AllocationTagStats {
+  /// The bytes and number of the allocations of the tag that are still alive.
+  int64_t live_bytes = 0;
+  int64_t live_allocations = 0;
+
+  /// The bytes and number of all the allocations of the tag so far. The
+  /// difference between two snapshots is the allocation churn in between.
+  uint64_t total_bytes = 0;
+  uint64_t total_allocations = 0;
+};
+
+/// Per tag accounting of the allocations made with operator new.
+///
+/// The accounting is opt-in: allocations are only recorded if the allocator
+/// hook of the `//flutter/fml:allocation_tags_hook` target is linked in,
+/// which the `flutter_enable_allocation_tags` GN argument does for the shell.
+/// Without the hook, |ScopedAllocationTag| only sets a thread local and all
+/// the stats stay zero.
+class AllocationTags {
+ public:
+  /// Whether the allocator hook is linked in and recording allocations.
+  static bool IsEnabled();
+
+  /// The tag the allocations on the current thread are attributed to.
+  static AllocationTag GetCurrentTag();
+
+  /// The name of the tag in the service protocol and trace counters.
+  static const char* GetName(AllocationTag tag);
+
+  static AllocationTagStats GetStats(AllocationTag tag);
+
+  /// Adds a trace counter of the live bytes of every tag to the timeline. The
+  /// shell calls this once per rasterized frame.
+  static void TraceCounters();
+
+  /// Only for the allocator hook, which must not allocate in these.
+  static void SetEnabled();
+  static void RecordAllocation(AllocationTag tag, size_t bytes);
+  static void RecordFree(AllocationTag tag, size_t bytes);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(AllocationTags);
+};
+
+/// Attributes the allocations made on the current thread to |tag| for the
+/// lifetime of this object. Scopes nest, and restore the previous tag when
+/// they end.
+class ScopedAllocationTag {
+ public:
+  explicit ScopedAllocationTag(AllocationTag tag);
+
+  ~ScopedAllocationTag();
+
+ private:
+  const AllocationTag previous_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedAllocationTag);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_MEMORY_ALLOCATION_TAGS_H_
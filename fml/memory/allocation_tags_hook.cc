@@ -0,0 +1,198 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replaces the global operator new and delete to record every allocation with
+// |fml::AllocationTags|. Each allocation is prefixed by a header holding the
+// size and tag it was recorded with, so that frees are attributed to the tag
+// of the allocation rather than the tag of the freeing thread.
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/memory/allocation_tags.h"
+
+#if defined(OS_WIN)
+#include <malloc.h>
+#endif
+
+namespace {
+
+struct AllocationHeader {
+  size_t size;
+  // The offset of the allocation from the start of the block, which exceeds
+  // the header size only for the over-aligned allocations.
+  uint32_t offset;
+  fml::AllocationTag tag;
+};
+
+constexpr size_t kHeaderSize = alignof(std::max_align_t);
+static_assert(sizeof(AllocationHeader) <= kHeaderSize);
+
+AllocationHeader* HeaderForAllocation(void* ptr) {
+  return reinterpret_cast<AllocationHeader*>(static_cast<char*>(ptr) -
+                                             sizeof(AllocationHeader));
+}
+
+void* Allocate(size_t size, size_t alignment) {
+  const size_t offset = std::max(kHeaderSize, alignment);
+  void* block = nullptr;
+  if (alignment <= kHeaderSize) {
+    block = std::malloc(offset + size);
+  } else {
+#if defined(OS_WIN)
+    block = _aligned_malloc(offset + size, alignment);
+#else
+    if (posix_memalign(&block, alignment, offset + size) != 0) {
+      block = nullptr;
+    }
+#endif
+  }
+  if (!block) {
+    return nullptr;
+  }
+  void* ptr = static_cast<char*>(block) + offset;
+  const fml::AllocationTag tag = fml::AllocationTags::GetCurrentTag();
+  *HeaderForAllocation(ptr) = {size, static_cast<uint32_t>(offset), tag};
+  fml::AllocationTags::RecordAllocation(tag, size);
+  return ptr;
+}
+
+void Free(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+  const AllocationHeader header = *HeaderForAllocation(ptr);
+  fml::AllocationTags::RecordFree(header.tag, header.size);
+  void* block = static_cast<char*>(ptr) - header.offset;
+#if defined(OS_WIN)
+  if (header.offset > kHeaderSize) {
+    _aligned_free(block);
+    return;
+  }
+#endif
+  std::free(block);
+}
+
+// Retries the allocation for as long as there is a new handler to free up
+// memory, like the default operator new does. Returns nullptr when there is
+// none.
+void* AllocateWithNewHandler(size_t size, size_t alignment) noexcept {
+  while (true) {
+    if (void* ptr = Allocate(size, alignment)) {
+      return ptr;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (!handler) {
+      return nullptr;
+    }
+    handler();
+  }
+}
+
+// The engine is built without exceptions, so failing to allocate aborts
+// instead of throwing std::bad_alloc.
+void* AllocateOrAbort(size_t size, size_t alignment) {
+  void* ptr = AllocateWithNewHandler(size, alignment);
+  if (!ptr) {
+    std::abort();
+  }
+  return ptr;
+}
+
+// Marks the accounting as enabled when the hook is linked in.
+struct EnableAllocationTags {
+  EnableAllocationTags() { fml::AllocationTags::SetEnabled(); }
+} gEnableAllocationTags;
+
+}  // namespace
+
+void* operator new(size_t size) {
+  return AllocateOrAbort(size, kHeaderSize);
+}
+
+void* operator new[](size_t size) {
+  return AllocateOrAbort(size, kHeaderSize);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return AllocateWithNewHandler(size, kHeaderSize);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return AllocateWithNewHandler(size, kHeaderSize);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return AllocateOrAbort(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return AllocateOrAbort(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size,
+                   std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return AllocateWithNewHandler(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size,
+                     std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return AllocateWithNewHandler(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept {
+  Free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  Free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  Free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  Free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  Free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  Free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  Free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  Free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  Free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+  Free(ptr);
+}
+
+void operator delete(void* ptr,
+                     std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  Free(ptr);
+}
+
+void operator delete[](void* ptr,
+                       std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  Free(ptr);
+}
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/allocation_tags.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(AllocationTagsTest, ScopesNestAndRestoreTheTag) {
+  EXPECT_EQ(AllocationTags::GetCurrentTag(), AllocationTag::kUntagged);
+  {
+    ScopedAllocationTag layer_tree(AllocationTag::kLayerTree);
+    EXPECT_EQ(AllocationTags::GetCurrentTag(), AllocationTag::kLayerTree);
+    {
+      ScopedAllocationTag raster_cache(AllocationTag::kRasterCache);
+      EXPECT_EQ(AllocationTags::GetCurrentTag(), AllocationTag::kRasterCache);
+    }
+    EXPECT_EQ(AllocationTags::GetCurrentTag(), AllocationTag::kLayerTree);
+  }
+  EXPECT_EQ(AllocationTags::GetCurrentTag(), AllocationTag::kUntagged);
+}
+
+TEST(AllocationTagsTest, TagsAreThreadLocal) {
+  ScopedAllocationTag text(AllocationTag::kText);
+  std::thread thread([]() {
+    EXPECT_EQ(AllocationTags::GetCurrentTag(), AllocationTag::kUntagged);
+  });
+  thread.join();
+  EXPECT_EQ(AllocationTags::GetCurrentTag(), AllocationTag::kText);
+}
+
+TEST(AllocationTagsTest, RecordsLiveAndTotalAllocations) {
+  // The hook is not linked into the tests, so nothing else records any
+  // allocations under this tag.
+  ASSERT_FALSE(AllocationTags::IsEnabled());
+  const AllocationTagStats before =
+      AllocationTags::GetStats(AllocationTag::kSemantics);
+
+  AllocationTags::RecordAllocation(AllocationTag::kSemantics, 100);
+  AllocationTags::RecordAllocation(AllocationTag::kSemantics, 28);
+  AllocationTags::RecordFree(AllocationTag::kSemantics, 100);
+
+  const AllocationTagStats after =
+      AllocationTags::GetStats(AllocationTag::kSemantics);
+  EXPECT_EQ(after.live_bytes - before.live_bytes, 28);
+  EXPECT_EQ(after.live_allocations - before.live_allocations, 1);
+  EXPECT_EQ(after.total_bytes - before.total_bytes, 128u);
+  EXPECT_EQ(after.total_allocations - before.total_allocations, 2u);
+
+  AllocationTags::RecordFree(AllocationTag::kSemantics, 28);
+  EXPECT_EQ(AllocationTags::GetStats(AllocationTag::kSemantics).live_bytes,
+            before.live_bytes);
+}
+
+TEST(AllocationTagsTest, EveryTagHasAName) {
+  for (size_t i = 0; i < static_cast<size_t>(AllocationTag::kCount); i++) {
+    EXPECT_STRNE(AllocationTags::GetName(static_cast<AllocationTag>(i)), "");
+  }
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -55,15 +55,19 @@ MessageLoopImpl::~MessageLoopImpl() {
 }
 
 void MessageLoopImpl::PostTask(const fml::closure& task,
-                               fml::TimePoint target_time) {
-  FML_DCHECK(task != nullptr);
+                               fml::TimePoint target_time,
+                               fml::TaskPriority priority,
+                               fml::TimePoint deadline,
+                               fml::TimeDelta leeway) {
   FML_DCHECK(task != nullptr);
   if (terminated_) {
     // If the message loop has already been terminated, PostTask should destruct
     // |task| synchronously within this function.
     return;
   }
-  task_queue_->RegisterTask(queue_id_, task, target_time);
+  task_queue_->RegisterTask(queue_id_, task, target_time,
+                            fml::TaskSourceGrade::kUnspecified, priority,
+                            deadline, leeway);
 }
 
 void MessageLoopImpl::AddTaskObserver(intptr_t key,
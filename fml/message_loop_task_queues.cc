@@ -6,6 +6,7 @@
 
 #include "flutter/fml/message_loop_task_queues.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -36,7 +37,7 @@ class TaskSourceGradeHolder {
 };
 }  // namespace
 
-// Guarded by creation_mutex_.
+// Only ever accessed by the thread it belongs to, so this doesn't need a lock.
 FML_THREAD_LOCAL ThreadLocalUniquePtr<TaskSourceGradeHolder>
     tls_task_source_grade;
 
@@ -60,7 +61,7 @@ fml::RefPtr<MessageLoopTaskQueues> MessageLoopTaskQueues::GetInstance() {
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock meta_lock(*queue_meta_mutex_);
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
@@ -68,12 +69,14 @@ TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
 }
 
 MessageLoopTaskQueues::MessageLoopTaskQueues()
-    : task_queue_id_counter_(0), order_(0) {}
+    : queue_meta_mutex_(fml::SharedMutex::Create()),
+      task_queue_id_counter_(0),
+      order_(0) {}
 
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock meta_lock(*queue_meta_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   TaskQueueId subsumed = queue_entry->owner_of;
@@ -84,7 +87,8 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  ScopedQueueGroupLock queue_lock(*this, queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   TaskQueueId subsumed = queue_entry->owner_of;
@@ -95,7 +99,6 @@ void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
 }
 
 TaskSourceGrade MessageLoopTaskQueues::GetCurrentTaskSourceGrade() {
-  std::scoped_lock creation(creation_mutex_);
   return tls_task_source_grade.get()->task_source_grade;
 }
 
@@ -103,12 +106,17 @@ void MessageLoopTaskQueues::RegisterTask(
     TaskQueueId queue_id,
     const fml::closure& task,
     fml::TimePoint target_time,
-    fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
+    fml::TaskSourceGrade task_source_grade,
+    fml::TaskPriority priority,
+    fml::TimePoint deadline,
+    fml::TimeDelta leeway) {
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  ScopedQueueGroupLock queue_lock(*this, queue_id);
   size_t order = order_++;
   const auto& queue_entry = queue_entries_.at(queue_id);
-  queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
+  queue_entry->task_source->RegisterTask({order, task, target_time,
+                                          task_source_grade, priority,
+                                          deadline, leeway});
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != _kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
@@ -116,52 +124,88 @@ void MessageLoopTaskQueues::RegisterTask(
 
   // This can happen when the secondary tasks are paused.
   if (HasPendingTasksUnlocked(loop_to_wake)) {
-    WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
+    WakeUpUnlocked(loop_to_wake, GetNextWakeUpRangeUnlocked(loop_to_wake));
   }
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  ScopedQueueGroupLock queue_lock(*this, queue_id);
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  ScopedQueueGroupLock queue_lock(*this, queue_id);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
-  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id);
+  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id, from_time);
 
   if (!HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, fml::TimePoint::Max());
+    WakeUpUnlocked(queue_id, {fml::TimePoint::Max(), fml::TimePoint::Max()});
   } else {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
+    WakeUpUnlocked(queue_id, GetNextWakeUpRangeUnlocked(queue_id));
   }
 
   if (top.task.GetTargetTime() > from_time) {
     return nullptr;
   }
   fml::closure invocation = top.task.GetTask();
+  // |top| refers to the task in its heap, so it's read before being popped.
+  const auto task_source_grade = top.task.GetTaskSourceGrade();
   queue_entries_.at(top.task_queue_id)
-      ->task_source->PopTask(top.task.GetTaskSourceGrade());
-  {
-    std::scoped_lock creation(creation_mutex_);
-    const auto task_source_grade = top.task.GetTaskSourceGrade();
-    tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
-  }
+      ->task_source->PopTask(task_source_grade, top.task.GetPriority());
+  tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
   return invocation;
 }
 
-void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
-                                           fml::TimePoint time) const {
-  if (queue_entries_.at(queue_id)->wakeable) {
-    queue_entries_.at(queue_id)->wakeable->WakeUp(time);
+MessageLoopTaskQueues::ScopedQueueGroupLock::ScopedQueueGroupLock(
+    const MessageLoopTaskQueues& queues,
+    TaskQueueId queue_id) {
+  const auto& entry = queues.queue_entries_.at(queue_id);
+  TaskQueueId other = _kUnmerged;
+  if (entry->subsumed_by != _kUnmerged) {
+    other = entry->subsumed_by;
+  } else if (entry->owner_of != _kUnmerged) {
+    other = entry->owner_of;
+  }
+
+  if (other == _kUnmerged) {
+    first_lock_ = std::unique_lock(entry->mutex);
+    return;
+  }
+
+  // Always lock the queue with the lower id first so that two threads locking
+  // the same pair of merged queues can't deadlock.
+  const auto& other_entry = queues.queue_entries_.at(other);
+  if (queue_id < other) {
+    first_lock_ = std::unique_lock(entry->mutex);
+    second_lock_ = std::unique_lock(other_entry->mutex);
+  } else {
+    first_lock_ = std::unique_lock(other_entry->mutex);
+    second_lock_ = std::unique_lock(entry->mutex);
+  }
+}
+
+void MessageLoopTaskQueues::WakeUpUnlocked(
+    TaskQueueId queue_id,
+    const TaskSource::WakeUpRange& range) const {
+  Wakeable* wakeable = queue_entries_.at(queue_id)->wakeable;
+  if (!wakeable) {
+    return;
+  }
+  if (range.latest <= range.earliest) {
+    wakeable->WakeUp(range.earliest);
+  } else {
+    wakeable->WakeUpWithLeeway(range.earliest, range.latest - range.earliest);
   }
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  ScopedQueueGroupLock queue_lock(*this, queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   if (queue_entry->subsumed_by != _kUnmerged) {
     return 0;
@@ -181,20 +225,25 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock queue_lock(queue_entry->mutex);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
-  queue_entries_.at(queue_id)->task_observers[key] = callback;
+  queue_entry->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_observers.erase(key);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock queue_lock(queue_entry->mutex);
+  queue_entry->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  ScopedQueueGroupLock queue_lock(*this, queue_id);
   std::vector<fml::closure> observers;
 
   if (queue_entries_.at(queue_id)->subsumed_by != _kUnmerged) {
@@ -217,17 +266,18 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
-  FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
-      << "Wakeable can only be set once.";
-  queue_entries_.at(queue_id)->wakeable = wakeable;
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock queue_lock(queue_entry->mutex);
+  FML_CHECK(!queue_entry->wakeable) << "Wakeable can only be set once.";
+  queue_entry->wakeable = wakeable;
 }
 
 bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock meta_lock(*queue_meta_mutex_);
   auto& owner_entry = queue_entries_.at(owner);
   auto& subsumed_entry = queue_entries_.at(subsumed);
 
@@ -249,14 +299,14 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   subsumed_entry->subsumed_by = owner;
 
   if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
+    WakeUpUnlocked(owner, GetNextWakeUpRangeUnlocked(owner));
   }
 
   return true;
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock meta_lock(*queue_meta_mutex_);
   const auto& owner_entry = queue_entries_.at(owner);
   const TaskQueueId subsumed = owner_entry->owner_of;
   if (subsumed == _kUnmerged) {
@@ -267,11 +317,11 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner) {
   owner_entry->owner_of = _kUnmerged;
 
   if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
+    WakeUpUnlocked(owner, GetNextWakeUpRangeUnlocked(owner));
   }
 
   if (HasPendingTasksUnlocked(subsumed)) {
-    WakeUpUnlocked(subsumed, GetNextWakeTimeUnlocked(subsumed));
+    WakeUpUnlocked(subsumed, GetNextWakeUpRangeUnlocked(subsumed));
   }
 
   return true;
@@ -279,28 +329,31 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
   return owner != _kUnmerged && subsumed != _kUnmerged &&
          subsumed == queue_entries_.at(owner)->owner_of;
 }
 
 TaskQueueId MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
   return queue_entries_.at(owner)->owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->PauseSecondary();
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock queue_lock(queue_entry->mutex);
+  queue_entry->task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  ScopedQueueGroupLock queue_lock(*this, queue_id);
   queue_entries_.at(queue_id)->task_source->ResumeSecondary();
   // Schedule a wake as needed.
   if (HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
+    WakeUpUnlocked(queue_id, GetNextWakeUpRangeUnlocked(queue_id));
   }
 }
 
@@ -327,18 +380,37 @@ bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
   }
 }
 
-fml::TimePoint MessageLoopTaskQueues::GetNextWakeTimeUnlocked(
+TaskSource::WakeUpRange MessageLoopTaskQueues::GetNextWakeUpRangeUnlocked(
     TaskQueueId queue_id) const {
-  return PeekNextTaskUnlocked(queue_id).task.GetTargetTime();
+  FML_DCHECK(HasPendingTasksUnlocked(queue_id));
+  const auto& entry = queue_entries_.at(queue_id);
+  TaskSource::WakeUpRange range = {
+      .earliest = fml::TimePoint::Max(),
+      .latest = fml::TimePoint::Max(),
+  };
+  auto add_task_source = [&range](const TaskSource& task_source) {
+    if (task_source.IsEmpty()) {
+      return;
+    }
+    const TaskSource::WakeUpRange source_range = task_source.GetWakeUpRange();
+    range.earliest = std::min(range.earliest, source_range.earliest);
+    range.latest = std::min(range.latest, source_range.latest);
+  };
+  add_task_source(*entry->task_source);
+  if (entry->owner_of != _kUnmerged) {
+    add_task_source(*queue_entries_.at(entry->owner_of)->task_source);
+  }
+  return range;
 }
 
 TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
-    TaskQueueId owner) const {
+    TaskQueueId owner,
+    fml::TimePoint now) const {
   FML_DCHECK(HasPendingTasksUnlocked(owner));
   const auto& entry = queue_entries_.at(owner);
   const TaskQueueId subsumed = entry->owner_of;
   if (subsumed == _kUnmerged) {
-    return entry->task_source->Top();
+    return entry->task_source->Top(now);
   }
 
   TaskSource* owner_tasks = entry->task_source.get();
@@ -349,9 +421,9 @@ TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
   const bool owner_has_task = !owner_tasks->IsEmpty();
   fml::TaskQueueId top_queue_id = owner;
   if (owner_has_task && subsumed_has_task) {
-    const auto owner_task = owner_tasks->Top();
-    const auto subsumed_task = subsumed_tasks->Top();
-    if (owner_task.task > subsumed_task.task) {
+    const auto owner_task = owner_tasks->Top(now);
+    const auto subsumed_task = subsumed_tasks->Top(now);
+    if (subsumed_task.task.RunsBefore(owner_task.task, now)) {
       top_queue_id = subsumed;
     } else {
       top_queue_id = owner;
@@ -361,7 +433,7 @@ TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
   } else {
     top_queue_id = subsumed;
   }
-  return queue_entries_.at(top_queue_id)->task_source->Top();
+  return queue_entries_.at(top_queue_id)->task_source->Top(now);
 }
 
 }  // namespace fml
@@ -6,6 +6,7 @@
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
 #include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -27,6 +28,12 @@ static const TaskQueueId _kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 class TaskQueueEntry {
  public:
   using TaskObservers = std::map<intptr_t, fml::closure>;
+
+  // Guards |wakeable|, |task_observers| and |task_source|. The merge state
+  // below is guarded by the queue meta mutex of |MessageLoopTaskQueues|
+  // instead.
+  mutable std::mutex mutex;
+
   Wakeable* wakeable;
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
@@ -54,6 +61,14 @@ enum class FlushType {
 // This class keeps track of all the tasks and observers that
 // need to be run on it's MessageLoopImpl. This also wakes up the
 // loop at the required times.
+//
+// Locking: |queue_meta_mutex_| guards the set of queues and how they are
+// merged. It is only held exclusively to create, dispose, merge and unmerge
+// queues. All other operations hold it shared and additionally lock the
+// entries of the queues they touch, so that the threads of unrelated queues
+// (for example those of different engines in the same process) don't contend
+// with each other. When two queues are merged, both entries are locked in the
+// order of their ids.
 class MessageLoopTaskQueues
     : public fml::RefCountedThreadSafe<MessageLoopTaskQueues> {
  public:
@@ -73,7 +88,10 @@ class MessageLoopTaskQueues
                     const fml::closure& task,
                     fml::TimePoint target_time,
                     fml::TaskSourceGrade task_source_grade =
-                        fml::TaskSourceGrade::kUnspecified);
+                        fml::TaskSourceGrade::kUnspecified,
+                    fml::TaskPriority priority = fml::TaskPriority::kNormal,
+                    fml::TimePoint deadline = fml::TimePoint::Max(),
+                    fml::TimeDelta leeway = fml::TimeDelta::Zero());
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
@@ -129,22 +147,41 @@ class MessageLoopTaskQueues
  private:
   class MergedQueuesRunner;
 
+  // Locks the entry of a queue and, if it is merged, the entry of the queue it
+  // is merged with. The caller must hold |queue_meta_mutex_|.
+  class ScopedQueueGroupLock {
+   public:
+    ScopedQueueGroupLock(const MessageLoopTaskQueues& queues,
+                         TaskQueueId queue_id);
+
+   private:
+    std::unique_lock<std::mutex> first_lock_;
+    std::unique_lock<std::mutex> second_lock_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedQueueGroupLock);
+  };
+
   MessageLoopTaskQueues();
 
   ~MessageLoopTaskQueues();
 
-  void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
+  void WakeUpUnlocked(TaskQueueId queue_id,
+                      const TaskSource::WakeUpRange& range) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
 
-  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
+  // Returns the task to run at |now|. The earliest task is at the top when
+  // |now| is |fml::TimePoint::Min()|.
+  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner,
+                                           fml::TimePoint now) const;
 
-  fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
+  TaskSource::WakeUpRange GetNextWakeUpRangeUnlocked(
+      TaskQueueId queue_id) const;
 
   static std::mutex creation_mutex_;
   static fml::RefPtr<MessageLoopTaskQueues> instance_;
 
-  mutable std::mutex queue_mutex_;
+  std::unique_ptr<fml::SharedMutex> queue_meta_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
@@ -66,5 +66,76 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Several producers post to each of several queues while one consumer per
+// queue drains it, like multiple engines in one process whose platform, UI
+// and raster threads all post to each other.
+static void BM_MultiProducerMultiQueue(benchmark::State& state) {  // NOLINT
+  const int num_task_queues = state.range(0);
+  const int num_producers_per_queue = state.range(1);
+  const int num_tasks_per_producer = 100;
+  const int num_tasks_per_queue =
+      num_producers_per_queue * num_tasks_per_producer;
+
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  std::vector<TaskQueueId> queue_ids;
+  for (int i = 0; i < num_task_queues; i++) {
+    queue_ids.push_back(task_queue->CreateTaskQueue());
+  }
+
+  while (state.KeepRunning()) {
+    const fml::TimePoint past = fml::TimePoint::Now();
+    std::vector<std::thread> threads;
+    CountDownLatch start(1);
+
+    for (auto queue_id : queue_ids) {
+      for (int i = 0; i < num_producers_per_queue; i++) {
+        threads.emplace_back([queue_id, &task_queue, past, &start]() {
+          start.Wait();
+          for (int j = 0; j < num_tasks_per_producer; j++) {
+            task_queue->RegisterTask(
+                queue_id, [] {}, past);
+          }
+        });
+      }
+      threads.emplace_back([queue_id, num_tasks_per_queue, &task_queue,
+                            &start]() {
+        start.Wait();
+        int num_invocations = 0;
+        while (num_invocations < num_tasks_per_queue) {
+          fml::closure invocation =
+              task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Now());
+          if (invocation) {
+            num_invocations++;
+          } else {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+
+    start.CountDown();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (auto queue_id : queue_ids) {
+    task_queue->Dispose(queue_id);
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_task_queues *
+                          num_tasks_per_queue);
+}
+
+BENCHMARK(BM_MultiProducerMultiQueue)
+    ->ArgNames({"queues", "producers"})
+    ->Args({1, 1})
+    ->Args({1, 4})
+    ->Args({4, 1})
+    ->Args({4, 4})
+    ->Args({12, 1})
+    ->Args({12, 4})
+    ->UseRealTime();
+
 }  // namespace benchmarking
 }  // namespace fml
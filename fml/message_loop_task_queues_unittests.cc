@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <thread>
 
@@ -155,6 +156,32 @@ TEST(MessageLoopTaskQueue, WokenUpWithNewerTime) {
   latch.Wait();
 }
 
+TEST(MessageLoopTaskQueue, WokenUpWithinLeeway) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  fml::TimePoint wake_time;
+  task_queue->SetWakeable(
+      queue_id, new TestWakeable([&wake_time](fml::TimePoint time_point) {
+        wake_time = time_point;
+      }));
+
+  const auto time = fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(1);
+  const auto leeway = fml::TimeDelta::FromMilliseconds(100);
+  task_queue->RegisterTask(
+      queue_id, []() {}, time, fml::TaskSourceGrade::kUnspecified,
+      fml::TaskPriority::kNormal, fml::TimePoint::Max(), leeway);
+  // Without support for leeway the wakeable wakes up as late as allowed.
+  ASSERT_EQ(wake_time, time + leeway);
+
+  // A task that runs at a precise time is not delayed by the leeway.
+  const auto precise_time = time + fml::TimeDelta::FromMilliseconds(10);
+  task_queue->RegisterTask(
+      queue_id, []() {}, precise_time, fml::TaskSourceGrade::kUnspecified,
+      fml::TaskPriority::kUserInput);
+  ASSERT_EQ(wake_time, precise_time);
+}
+
 TEST(MessageLoopTaskQueue, NotifyObserversWhileCreatingQueues) {
   auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
   fml::TaskQueueId queue_id = task_queues->CreateTaskQueue();
@@ -292,5 +319,52 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+TEST(MessageLoopTaskQueue, ConcurrentRegisterAndRunWhileMerging) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto owner = task_queues->CreateTaskQueue();
+  auto subsumed = task_queues->CreateTaskQueue();
+
+  // Two threads post to both queues and drain them while the main thread
+  // keeps merging and unmerging them. No task may be lost or run twice.
+  constexpr size_t kThreadTaskCount = 1000;
+  std::atomic_size_t tasks_run = 0;
+  std::atomic_bool done = false;
+
+  auto thread_main = [&](TaskQueueId queue_id) {
+    for (size_t i = 0; i < kThreadTaskCount; i++) {
+      task_queues->RegisterTask(
+          queue_id, [&tasks_run]() { tasks_run++; }, fml::TimePoint::Now());
+      fml::closure invocation =
+          task_queues->GetNextTaskToRun(queue_id, fml::TimePoint::Now());
+      if (invocation) {
+        invocation();
+      }
+    }
+  };
+
+  std::thread owner_thread(thread_main, owner);
+  std::thread subsumed_thread(thread_main, subsumed);
+  std::thread merge_thread([&]() {
+    while (!done) {
+      task_queues->Merge(owner, subsumed);
+      task_queues->Unmerge(owner);
+    }
+  });
+
+  owner_thread.join();
+  subsumed_thread.join();
+  done = true;
+  merge_thread.join();
+
+  ASSERT_FALSE(task_queues->Owns(owner, subsumed));
+  for (auto queue_id : {owner, subsumed}) {
+    while (fml::closure invocation =
+               task_queues->GetNextTaskToRun(queue_id, fml::TimePoint::Max())) {
+      invocation();
+    }
+  }
+  ASSERT_EQ(tasks_run, 2 * kThreadTaskCount);
+}
+
 }  // namespace testing
 }  // namespace fml
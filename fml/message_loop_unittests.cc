@@ -316,3 +316,63 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsAllTasks) {
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      4u, fml::ConcurrentMessageLoop::Scheduling::kWorkStealing);
+  ASSERT_EQ(loop->GetScheduling(),
+            fml::ConcurrentMessageLoop::Scheduling::kWorkStealing);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 100;
+  fml::CountDownLatch latch(kCount * kCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    // Tasks posted from workers end up in that worker's queue and have to be
+    // stolen by the others.
+    task_runner->PostTask([&latch, task_runner]() {
+      for (size_t j = 0; j < kCount; ++j) {
+        task_runner->PostTask([&latch]() { latch.CountDown(); });
+      }
+    });
+  }
+  latch.Wait();
+
+  // Wait for the workers to return from posting before the loop is collected.
+  fml::CountDownLatch workers_idle(loop->GetWorkerCount());
+  loop->PostTaskToAllWorkers([&workers_idle]() { workers_idle.CountDown(); });
+  workers_idle.Wait();
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsTasksForAllWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      2u, fml::ConcurrentMessageLoop::Scheduling::kWorkStealing);
+  auto task_runner = loop->GetTaskRunner();
+
+  // Keeps the queue of a worker from ever running empty until it is stopped.
+  std::atomic_bool stop = false;
+  std::function<void()> busy_task = [&]() {
+    if (!stop.load()) {
+      task_runner->PostTask(busy_task);
+    }
+  };
+  task_runner->PostTask(busy_task);
+  task_runner->PostTask(busy_task);
+
+  fml::CountDownLatch workers_ran(loop->GetWorkerCount());
+  loop->PostTaskToAllWorkers([&workers_ran]() { workers_ran.CountDown(); });
+  workers_ran.Wait();
+  stop.store(true);
+
+  fml::CountDownLatch workers_idle(loop->GetWorkerCount());
+  loop->PostTaskToAllWorkers([&workers_idle]() { workers_idle.CountDown(); });
+  workers_idle.Wait();
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsTasksAfterShutdown) {
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      2u, fml::ConcurrentMessageLoop::Scheduling::kWorkStealing);
+  auto task_runner = loop->GetTaskRunner();
+  loop->Terminate();
+  bool ran = false;
+  task_runner->PostTask([&ran]() { ran = true; });
+  ASSERT_TRUE(ran);
+}
@@ -0,0 +1,487 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/perfetto_trace_writer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/thread_local.h"
+
+#if defined(OS_WIN)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+// The field numbers of the messages of the Perfetto trace format that are
+// written. See protos/perfetto/trace/ in the Perfetto repository.
+namespace proto {
+// perfetto.protos.Trace
+constexpr uint32_t kTracePacket = 1;
+// perfetto.protos.TracePacket
+constexpr uint32_t kPacketTimestamp = 8;
+constexpr uint32_t kPacketTrustedPacketSequenceId = 10;
+constexpr uint32_t kPacketTrackEvent = 11;
+constexpr uint32_t kPacketSequenceFlags = 13;
+constexpr uint32_t kPacketTrackDescriptor = 60;
+constexpr uint64_t kSequenceIncrementalStateCleared = 1;
+// perfetto.protos.TrackDescriptor
+constexpr uint32_t kTrackUuid = 1;
+constexpr uint32_t kTrackName = 2;
+constexpr uint32_t kTrackProcess = 3;
+constexpr uint32_t kTrackThread = 4;
+constexpr uint32_t kTrackParentUuid = 5;
+constexpr uint32_t kTrackCounter = 8;
+// perfetto.protos.ProcessDescriptor
+constexpr uint32_t kProcessPid = 1;
+constexpr uint32_t kProcessName = 6;
+// perfetto.protos.ThreadDescriptor
+constexpr uint32_t kThreadPid = 1;
+constexpr uint32_t kThreadTid = 2;
+constexpr uint32_t kThreadName = 5;
+// perfetto.protos.TrackEvent
+constexpr uint32_t kEventDebugAnnotations = 4;
+constexpr uint32_t kEventType = 9;
+constexpr uint32_t kEventTrackUuid = 11;
+constexpr uint32_t kEventName = 23;
+constexpr uint32_t kEventDoubleCounterValue = 44;
+constexpr uint32_t kEventFlowIds = 47;
+constexpr uint32_t kEventTerminatingFlowIds = 48;
+constexpr uint64_t kTypeSliceBegin = 1;
+constexpr uint64_t kTypeSliceEnd = 2;
+constexpr uint64_t kTypeInstant = 3;
+constexpr uint64_t kTypeCounter = 4;
+// perfetto.protos.DebugAnnotation
+constexpr uint32_t kAnnotationStringValue = 6;
+constexpr uint32_t kAnnotationName = 10;
+}  // namespace proto
+
+// Appends the fields of a protobuf message to a string.
+class ProtoWriter {
+ public:
+  void Varint(uint32_t field, uint64_t value) {
+    Tag(field, 0);
+    WriteVarint(value);
+  }
+
+  void Fixed64(uint32_t field, uint64_t value) {
+    Tag(field, 1);
+    for (int i = 0; i < 8; i++) {
+      data_.push_back(static_cast<char>(value >> (8 * i)));
+    }
+  }
+
+  void Double(uint32_t field, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    Fixed64(field, bits);
+  }
+
+  void Bytes(uint32_t field, std::string_view value) {
+    Tag(field, 2);
+    WriteVarint(value.size());
+    data_.append(value.data(), value.size());
+  }
+
+  void Message(uint32_t field, const ProtoWriter& message) {
+    Bytes(field, message.data());
+  }
+
+  const std::string& data() const { return data_; }
+
+ private:
+  std::string data_;
+
+  void Tag(uint32_t field, uint32_t wire_type) {
+    WriteVarint((static_cast<uint64_t>(field) << 3) | wire_type);
+  }
+
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      data_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    data_.push_back(static_cast<char>(value));
+  }
+};
+
+constexpr uint64_t kProcessTrackUuid = 1;
+
+uint64_t HashTrack(std::string_view name, uint64_t seed) {
+  // FNV-1a, seeded so that async and counter tracks of the same name differ.
+  uint64_t hash = 0xcbf29ce484222325ull ^ seed;
+  for (char c : name) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+  }
+  // Keep clear of the uuids of the process and thread tracks.
+  return hash | (1ull << 63);
+}
+
+struct ThreadBuffer {
+  // Only contended while the trace is stopped.
+  std::mutex mutex;
+  uint64_t sequence_id = 0;
+  uint64_t thread_id = 0;
+  std::string thread_name;
+  // The packets, each encoded as a |perfetto.protos.Trace| field.
+  std::string packets;
+  // The names of the async and counter tracks the packets refer to.
+  std::map<uint64_t, std::string> async_tracks;
+  std::map<uint64_t, std::string> counter_tracks;
+  size_t dropped_events = 0;
+  // The slices of the thread track whose Begin was recorded, and those whose
+  // Begin was dropped, which are nested within the former, that did not end
+  // yet. The same for the async tracks, by uuid.
+  size_t open_slices = 0;
+  size_t dropped_open_slices = 0;
+  std::map<uint64_t, size_t> open_async_slices;
+};
+
+struct ThreadState {
+  std::string name;
+  uint64_t thread_id = 0;
+  uint64_t session = 0;
+  std::shared_ptr<ThreadBuffer> buffer;
+};
+
+std::atomic<bool> gRecording{false};
+std::atomic<uint64_t> gSession{0};
+std::atomic<uint64_t> gLastThreadId{0};
+size_t gMaxBytesPerThread = kPerfettoDefaultMaxBytesPerThread;
+
+std::mutex gBuffersMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> gBuffers;
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadState> tls_state;
+
+ThreadState& GetThreadState() {
+  if (!tls_state.get()) {
+    tls_state.reset(new ThreadState());
+    tls_state.get()->thread_id = ++gLastThreadId;
+  }
+  return *tls_state.get();
+}
+
+// Gives the current thread a buffer in the trace being recorded, if it does
+// not have one yet.
+ThreadBuffer* GetThreadBuffer() {
+  ThreadState& state = GetThreadState();
+  const uint64_t session = gSession.load(std::memory_order_acquire);
+  if (state.buffer && state.session == session) {
+    return state.buffer.get();
+  }
+  auto buffer = std::make_shared<ThreadBuffer>();
+  buffer->thread_id = state.thread_id;
+  // Sequence id 1 is used for the process track descriptor.
+  buffer->sequence_id = state.thread_id + 1;
+  buffer->thread_name = state.name;
+  {
+    std::scoped_lock lock(gBuffersMutex);
+    if (gSession.load(std::memory_order_relaxed) != session) {
+      // A new trace was started in the meantime.
+      return nullptr;
+    }
+    gBuffers.push_back(buffer);
+  }
+  state.session = session;
+  state.buffer = std::move(buffer);
+  return state.buffer.get();
+}
+
+void WriteTrackEvent(ThreadBuffer* buffer,
+                     int64_t timestamp_micros,
+                     uint64_t type,
+                     uint64_t track_uuid,
+                     const char* name,
+                     const std::function<void(ProtoWriter&)>& add_fields) {
+  ProtoWriter event;
+  event.Varint(proto::kEventType, type);
+  event.Varint(proto::kEventTrackUuid, track_uuid);
+  if (name) {
+    event.Bytes(proto::kEventName, name);
+  }
+  if (add_fields) {
+    add_fields(event);
+  }
+
+  ProtoWriter packet;
+  packet.Varint(proto::kPacketTimestamp,
+                static_cast<uint64_t>(timestamp_micros) * 1000);
+  packet.Varint(proto::kPacketTrustedPacketSequenceId, buffer->sequence_id);
+  packet.Message(proto::kPacketTrackEvent, event);
+
+  ProtoWriter trace;
+  trace.Message(proto::kTracePacket, packet);
+  buffer->packets.append(trace.data());
+}
+
+void AppendTrackDescriptor(ProtoWriter& trace,
+                           uint64_t sequence_id,
+                           uint64_t sequence_flags,
+                           const ProtoWriter& track) {
+  ProtoWriter packet;
+  packet.Varint(proto::kPacketTrustedPacketSequenceId, sequence_id);
+  if (sequence_flags != 0) {
+    packet.Varint(proto::kPacketSequenceFlags, sequence_flags);
+  }
+  packet.Message(proto::kPacketTrackDescriptor, track);
+  trace.Message(proto::kTracePacket, packet);
+}
+
+void AppendChildTrackDescriptor(ProtoWriter& trace,
+                                uint64_t sequence_id,
+                                uint64_t uuid,
+                                const std::string& name,
+                                bool is_counter) {
+  ProtoWriter track;
+  track.Varint(proto::kTrackUuid, uuid);
+  track.Bytes(proto::kTrackName, name);
+  track.Varint(proto::kTrackParentUuid, kProcessTrackUuid);
+  if (is_counter) {
+    track.Message(proto::kTrackCounter, ProtoWriter());
+  }
+  AppendTrackDescriptor(trace, sequence_id, 0, track);
+}
+
+int32_t GetProcessId() {
+#if defined(OS_WIN)
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+}  // namespace
+
+void PerfettoTraceStart(size_t max_bytes_per_thread) {
+  std::scoped_lock lock(gBuffersMutex);
+  gBuffers.clear();
+  gMaxBytesPerThread = max_bytes_per_thread;
+  gSession.fetch_add(1, std::memory_order_acq_rel);
+  gRecording.store(true, std::memory_order_release);
+}
+
+bool PerfettoTraceIsRecording() {
+  return gRecording.load(std::memory_order_relaxed);
+}
+
+std::string PerfettoTraceStop() {
+  if (!gRecording.exchange(false, std::memory_order_acq_rel)) {
+    return "";
+  }
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::scoped_lock lock(gBuffersMutex);
+    buffers.swap(gBuffers);
+  }
+
+  const int32_t pid = GetProcessId();
+  ProtoWriter trace;
+  {
+    ProtoWriter process;
+    process.Varint(proto::kProcessPid, pid);
+    process.Bytes(proto::kProcessName, "flutter");
+    ProtoWriter track;
+    track.Varint(proto::kTrackUuid, kProcessTrackUuid);
+    track.Message(proto::kTrackProcess, process);
+    AppendTrackDescriptor(trace, 1, proto::kSequenceIncrementalStateCleared,
+                          track);
+  }
+
+  size_t dropped_events = 0;
+  for (const auto& buffer : buffers) {
+    std::scoped_lock lock(buffer->mutex);
+    ProtoWriter thread;
+    thread.Varint(proto::kThreadPid, pid);
+    thread.Varint(proto::kThreadTid, buffer->thread_id);
+    if (!buffer->thread_name.empty()) {
+      thread.Bytes(proto::kThreadName, buffer->thread_name);
+    }
+    ProtoWriter track;
+    track.Varint(proto::kTrackUuid, buffer->sequence_id);
+    track.Message(proto::kTrackThread, thread);
+    AppendTrackDescriptor(trace, buffer->sequence_id,
+                          proto::kSequenceIncrementalStateCleared, track);
+    for (const auto& [uuid, name] : buffer->async_tracks) {
+      AppendChildTrackDescriptor(trace, buffer->sequence_id, uuid, name, false);
+    }
+    for (const auto& [uuid, name] : buffer->counter_tracks) {
+      AppendChildTrackDescriptor(trace, buffer->sequence_id, uuid, name, true);
+    }
+    dropped_events += buffer->dropped_events;
+  }
+
+  std::string result = trace.data();
+  for (const auto& buffer : buffers) {
+    std::scoped_lock lock(buffer->mutex);
+    result.append(buffer->packets);
+  }
+  if (dropped_events > 0) {
+    FML_LOG(WARNING) << "Dropped " << dropped_events
+                     << " trace events of threads whose buffer was full.";
+  }
+  return result;
+}
+
+void PerfettoTraceRecord(const char* name,
+                         int64_t timestamp0_micros,
+                         int64_t timestamp1_or_id,
+                         Dart_Timeline_Event_Type type,
+                         intptr_t argument_count,
+                         const char** argument_names,
+                         const char** argument_values) {
+  if (!gRecording.load(std::memory_order_relaxed) || !name) {
+    return;
+  }
+  ThreadBuffer* buffer = GetThreadBuffer();
+  if (!buffer) {
+    return;
+  }
+  std::scoped_lock lock(buffer->mutex);
+  if (buffer->packets.size() >= gMaxBytesPerThread) {
+    // The End of a slice whose Begin was recorded is recorded anyway, so that
+    // the slice does not last until the end of the trace. This only takes as
+    // many events past the limit as slices were open when it was reached.
+    bool ends_recorded_slice = false;
+    if (type == Dart_Timeline_Event_Begin) {
+      buffer->dropped_open_slices++;
+    } else if (type == Dart_Timeline_Event_End) {
+      if (buffer->dropped_open_slices > 0) {
+        buffer->dropped_open_slices--;
+      } else {
+        ends_recorded_slice = buffer->open_slices > 0;
+      }
+    } else if (type == Dart_Timeline_Event_Async_End) {
+      const uint64_t uuid =
+          HashTrack(name, static_cast<uint64_t>(timestamp1_or_id));
+      ends_recorded_slice = buffer->open_async_slices.count(uuid) > 0;
+    }
+    if (!ends_recorded_slice) {
+      buffer->dropped_events++;
+      return;
+    }
+  }
+
+  const uint64_t thread_track = buffer->sequence_id;
+  const uint64_t id = static_cast<uint64_t>(timestamp1_or_id);
+  auto add_annotations = [&](ProtoWriter& event) {
+    for (intptr_t i = 0; i < argument_count; i++) {
+      if (!argument_names[i] || !argument_values[i]) {
+        continue;
+      }
+      ProtoWriter annotation;
+      annotation.Bytes(proto::kAnnotationName, argument_names[i]);
+      annotation.Bytes(proto::kAnnotationStringValue, argument_values[i]);
+      event.Message(proto::kEventDebugAnnotations, annotation);
+    }
+  };
+  auto async_track = [&]() {
+    const uint64_t uuid = HashTrack(name, id);
+    buffer->async_tracks.emplace(uuid, name);
+    return uuid;
+  };
+
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      WriteTrackEvent(buffer, timestamp0_micros, proto::kTypeSliceBegin,
+                      thread_track, name, add_annotations);
+      buffer->open_slices++;
+      break;
+    case Dart_Timeline_Event_End:
+      WriteTrackEvent(buffer, timestamp0_micros, proto::kTypeSliceEnd,
+                      thread_track, nullptr, nullptr);
+      if (buffer->open_slices > 0) {
+        buffer->open_slices--;
+      }
+      break;
+    case Dart_Timeline_Event_Instant:
+      WriteTrackEvent(buffer, timestamp0_micros, proto::kTypeInstant,
+                      thread_track, name, add_annotations);
+      break;
+    case Dart_Timeline_Event_Duration:
+      WriteTrackEvent(buffer, timestamp0_micros, proto::kTypeSliceBegin,
+                      thread_track, name, add_annotations);
+      WriteTrackEvent(buffer, timestamp1_or_id, proto::kTypeSliceEnd,
+                      thread_track, nullptr, nullptr);
+      break;
+    case Dart_Timeline_Event_Async_Begin: {
+      const uint64_t uuid = async_track();
+      WriteTrackEvent(buffer, timestamp0_micros, proto::kTypeSliceBegin, uuid,
+                      name, add_annotations);
+      buffer->open_async_slices[uuid]++;
+      break;
+    }
+    case Dart_Timeline_Event_Async_End: {
+      const uint64_t uuid = async_track();
+      WriteTrackEvent(buffer, timestamp0_micros, proto::kTypeSliceEnd, uuid,
+                      nullptr, nullptr);
+      auto open = buffer->open_async_slices.find(uuid);
+      if (open != buffer->open_async_slices.end() && --open->second == 0) {
+        buffer->open_async_slices.erase(open);
+      }
+      break;
+    }
+    case Dart_Timeline_Event_Async_Instant:
+      WriteTrackEvent(buffer, timestamp0_micros, proto::kTypeInstant,
+                      async_track(), name, add_annotations);
+      break;
+    case Dart_Timeline_Event_Flow_Begin:
+    case Dart_Timeline_Event_Flow_Step:
+      WriteTrackEvent(buffer, timestamp0_micros, proto::kTypeInstant,
+                      thread_track, name, [id](ProtoWriter& event) {
+                        event.Fixed64(proto::kEventFlowIds, id);
+                      });
+      break;
+    case Dart_Timeline_Event_Flow_End:
+      WriteTrackEvent(buffer, timestamp0_micros, proto::kTypeInstant,
+                      thread_track, name, [id](ProtoWriter& event) {
+                        event.Fixed64(proto::kEventTerminatingFlowIds, id);
+                      });
+      break;
+    case Dart_Timeline_Event_Counter:
+      for (intptr_t i = 0; i < argument_count; i++) {
+        if (!argument_names[i] || !argument_values[i]) {
+          continue;
+        }
+        std::string track_name = std::string(name) + " " + argument_names[i];
+        const uint64_t uuid = HashTrack(track_name, 0);
+        buffer->counter_tracks.emplace(uuid, std::move(track_name));
+        const double value = std::strtod(argument_values[i], nullptr);
+        WriteTrackEvent(buffer, timestamp0_micros, proto::kTypeCounter, uuid,
+                        nullptr, [value](ProtoWriter& event) {
+                          event.Double(proto::kEventDoubleCounterValue, value);
+                        });
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void PerfettoTraceSetCurrentThreadName(const std::string& name) {
+  ThreadState& state = GetThreadState();
+  state.name = name;
+  if (state.buffer) {
+    std::scoped_lock lock(state.buffer->mutex);
+    state.buffer->thread_name = name;
+  }
+}
+
+}  // namespace tracing
+}  // namespace fml
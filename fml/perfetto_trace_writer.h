@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PERFETTO_TRACE_WRITER_H_
+#define FLUTTER_FML_PERFETTO_TRACE_WRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// The Perfetto trace writer records the trace events of the engine as
+/// Perfetto track events, without going through the Dart timeline. A trace
+/// can be recorded without a Dart VM service and is written in the protobuf
+/// format that ui.perfetto.dev and the Perfetto trace processor read.
+///
+/// Each thread encodes its events into a buffer of its own, whose lock is
+/// only contended when the trace is stopped. Events are put on a track per
+/// thread, named after the thread, so the platform, UI, raster and IO threads
+/// each get one. Async events get a track per name and id, and every argument
+/// of a counter event gets a counter track, e.g. for the pipeline depth, the
+/// raster cache bytes and the pending objects of the unref queue.
+///
+/// A thread stops recording once its buffer holds
+/// |max_bytes_per_thread| bytes, dropping the events that follow, rather
+/// than overwriting events that could be the start of a slice. Only the ends
+/// of the slices whose start was recorded are still recorded after that.
+///
+constexpr size_t kPerfettoDefaultMaxBytesPerThread = 4 << 20;
+
+//------------------------------------------------------------------------------
+/// @brief      Starts recording a trace, discarding the events recorded for
+///             any previous one.
+///
+void PerfettoTraceStart(
+    size_t max_bytes_per_thread = kPerfettoDefaultMaxBytesPerThread);
+
+bool PerfettoTraceIsRecording();
+
+//------------------------------------------------------------------------------
+/// @brief      Stops recording the trace.
+///
+/// @return     The trace as a serialized `perfetto.protos.Trace` message, or
+///             an empty string if no trace was being recorded.
+///
+std::string PerfettoTraceStop();
+
+//------------------------------------------------------------------------------
+/// @brief      Records a trace event of the current thread, if a trace is
+///             being recorded. The arguments of counter events are the
+///             counter values, and those of other events are added as debug
+///             annotations.
+///
+void PerfettoTraceRecord(const char* name,
+                         int64_t timestamp0_micros,
+                         int64_t timestamp1_or_id,
+                         Dart_Timeline_Event_Type type,
+                         intptr_t argument_count,
+                         const char** argument_names,
+                         const char** argument_values);
+
+//------------------------------------------------------------------------------
+/// @brief      Names the track of the current thread in the traces recorded
+///             from now on. Called by |fml::Thread::SetCurrentThreadName|.
+///
+void PerfettoTraceSetCurrentThreadName(const std::string& name);
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PERFETTO_TRACE_WRITER_H_
@@ -0,0 +1,209 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/perfetto_trace_writer.h"
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+struct Field {
+  uint32_t number = 0;
+  uint64_t value = 0;
+  std::string bytes;
+};
+
+uint64_t ReadVarint(const std::string& data, size_t& offset) {
+  uint64_t value = 0;
+  for (int shift = 0; offset < data.size(); shift += 7) {
+    const uint8_t byte = static_cast<uint8_t>(data[offset++]);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      break;
+    }
+  }
+  return value;
+}
+
+// Decodes the top level fields of a protobuf message.
+std::vector<Field> Decode(const std::string& data) {
+  std::vector<Field> fields;
+  size_t offset = 0;
+  while (offset < data.size()) {
+    const uint64_t tag = ReadVarint(data, offset);
+    Field field;
+    field.number = static_cast<uint32_t>(tag >> 3);
+    switch (tag & 7) {
+      case 0:
+        field.value = ReadVarint(data, offset);
+        break;
+      case 1:
+        for (int i = 0; i < 8; i++) {
+          field.value |= static_cast<uint64_t>(
+                             static_cast<uint8_t>(data[offset + i]))
+                         << (8 * i);
+        }
+        offset += 8;
+        break;
+      case 2: {
+        const size_t size = ReadVarint(data, offset);
+        field.bytes = data.substr(offset, size);
+        offset += size;
+        break;
+      }
+      default:
+        ADD_FAILURE() << "Unexpected wire type " << (tag & 7);
+        return fields;
+    }
+    fields.push_back(std::move(field));
+  }
+  return fields;
+}
+
+const Field* FindField(const std::vector<Field>& fields, uint32_t number) {
+  for (const auto& field : fields) {
+    if (field.number == number) {
+      return &field;
+    }
+  }
+  return nullptr;
+}
+
+// The decoded TrackEvent fields of all the packets of a trace.
+std::vector<std::vector<Field>> TrackEvents(const std::string& trace) {
+  std::vector<std::vector<Field>> events;
+  for (const auto& packet : Decode(trace)) {
+    EXPECT_EQ(packet.number, 1u);
+    auto packet_fields = Decode(packet.bytes);
+    if (auto event = FindField(packet_fields, 11)) {
+      events.push_back(Decode(event->bytes));
+    }
+  }
+  return events;
+}
+
+}  // namespace
+
+class PerfettoTraceWriterTest : public ::testing::Test {
+ protected:
+  void TearDown() override { PerfettoTraceStop(); }
+};
+
+TEST_F(PerfettoTraceWriterTest, StopWithoutStartIsEmpty) {
+  ASSERT_FALSE(PerfettoTraceIsRecording());
+  ASSERT_TRUE(PerfettoTraceStop().empty());
+}
+
+TEST_F(PerfettoTraceWriterTest, DoesNotRecordWhenStopped) {
+  PerfettoTraceRecord("Event", 10, 0, Dart_Timeline_Event_Instant, 0, nullptr,
+                      nullptr);
+  PerfettoTraceStart();
+  ASSERT_TRUE(PerfettoTraceIsRecording());
+  ASSERT_TRUE(TrackEvents(PerfettoTraceStop()).empty());
+}
+
+TEST_F(PerfettoTraceWriterTest, RecordsSlices) {
+  PerfettoTraceStart();
+  PerfettoTraceRecord("Frame", 10, 0, Dart_Timeline_Event_Begin, 0, nullptr,
+                      nullptr);
+  PerfettoTraceRecord("Frame", 20, 0, Dart_Timeline_Event_End, 0, nullptr,
+                      nullptr);
+  PerfettoTraceRecord("Paint", 30, 40, Dart_Timeline_Event_Duration, 0,
+                      nullptr, nullptr);
+
+  auto events = TrackEvents(PerfettoTraceStop());
+  ASSERT_EQ(events.size(), 4u);
+  // TrackEvent.type
+  ASSERT_EQ(FindField(events[0], 9)->value, 1u);
+  ASSERT_EQ(FindField(events[1], 9)->value, 2u);
+  ASSERT_EQ(FindField(events[2], 9)->value, 1u);
+  ASSERT_EQ(FindField(events[3], 9)->value, 2u);
+  // TrackEvent.name
+  ASSERT_EQ(FindField(events[0], 23)->bytes, "Frame");
+  ASSERT_EQ(FindField(events[2], 23)->bytes, "Paint");
+  // All the slices are on the track of the thread.
+  ASSERT_EQ(FindField(events[0], 11)->value, FindField(events[3], 11)->value);
+}
+
+TEST_F(PerfettoTraceWriterTest, RecordsCounterPerArgument) {
+  PerfettoTraceStart();
+  const char* names[] = {"BytesUsed", "Count"};
+  const char* values[] = {"1024", "3"};
+  PerfettoTraceRecord("RasterCache", 10, 0, Dart_Timeline_Event_Counter, 2,
+                      names, values);
+
+  auto events = TrackEvents(PerfettoTraceStop());
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(FindField(events[0], 9)->value, 4u);
+  double value;
+  const uint64_t bits = FindField(events[0], 44)->value;
+  memcpy(&value, &bits, sizeof(value));
+  ASSERT_EQ(value, 1024.0);
+  ASSERT_NE(FindField(events[0], 11)->value, FindField(events[1], 11)->value);
+}
+
+TEST_F(PerfettoTraceWriterTest, RecordsEachThreadOnItsOwnTrack) {
+  PerfettoTraceStart();
+  auto record = [] {
+    PerfettoTraceRecord("Event", 10, 0, Dart_Timeline_Event_Instant, 0,
+                        nullptr, nullptr);
+  };
+  record();
+  std::thread thread(record);
+  thread.join();
+
+  auto events = TrackEvents(PerfettoTraceStop());
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_NE(FindField(events[0], 11)->value, FindField(events[1], 11)->value);
+}
+
+TEST_F(PerfettoTraceWriterTest, DropsEventsWhenTheBufferIsFull) {
+  PerfettoTraceStart(64);
+  for (int i = 0; i < 100; i++) {
+    PerfettoTraceRecord("Event", i, 0, Dart_Timeline_Event_Instant, 0, nullptr,
+                        nullptr);
+  }
+  auto events = TrackEvents(PerfettoTraceStop());
+  ASSERT_GT(events.size(), 0u);
+  ASSERT_LT(events.size(), 100u);
+}
+
+TEST_F(PerfettoTraceWriterTest, RecordsEndsOfRecordedSlicesOnceFull) {
+  PerfettoTraceStart(64);
+  PerfettoTraceRecord("Outer", 0, 0, Dart_Timeline_Event_Begin, 0, nullptr,
+                      nullptr);
+  for (int i = 1; i < 100; i++) {
+    PerfettoTraceRecord("Event", i, 0, Dart_Timeline_Event_Instant, 0, nullptr,
+                        nullptr);
+  }
+  PerfettoTraceRecord("Inner", 100, 0, Dart_Timeline_Event_Begin, 0, nullptr,
+                      nullptr);
+  PerfettoTraceRecord("Inner", 101, 0, Dart_Timeline_Event_End, 0, nullptr,
+                      nullptr);
+  PerfettoTraceRecord("Outer", 102, 0, Dart_Timeline_Event_End, 0, nullptr,
+                      nullptr);
+  PerfettoTraceRecord("Event", 103, 0, Dart_Timeline_Event_End, 0, nullptr,
+                      nullptr);
+
+  auto events = TrackEvents(PerfettoTraceStop());
+  ASSERT_GT(events.size(), 2u);
+  ASSERT_EQ(FindField(events.front(), 9)->value, 1u);
+  ASSERT_EQ(FindField(events.front(), 23)->bytes, "Outer");
+  // Only the End of the outer slice is recorded past the limit.
+  ASSERT_EQ(FindField(events.back(), 9)->value, 2u);
+  ASSERT_EQ(FindField(events[events.size() - 2], 9)->value, 3u);
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
@@ -34,6 +34,10 @@ class MessageLoopDarwin : public MessageLoopImpl {
   // |fml::MessageLoopImpl|
   void WakeUp(fml::TimePoint time_point) override;
 
+  // |fml::MessageLoopImpl|
+  void WakeUpWithLeeway(fml::TimePoint time_point,
+                        fml::TimeDelta leeway) override;
+
   static void OnTimerFire(CFRunLoopTimerRef timer, MessageLoopDarwin* loop);
 
   FML_FRIEND_MAKE_REF_COUNTED(MessageLoopDarwin);
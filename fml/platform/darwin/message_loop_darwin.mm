@@ -62,6 +62,13 @@ void MessageLoopDarwin::Terminate() {
 }
 
 void MessageLoopDarwin::WakeUp(fml::TimePoint time_point) {
+  WakeUpWithLeeway(time_point, fml::TimeDelta::Zero());
+}
+
+void MessageLoopDarwin::WakeUpWithLeeway(fml::TimePoint time_point, fml::TimeDelta leeway) {
+  // The system may fire the timer up to the tolerance late to coalesce it with
+  // other timers, which lets the CPU stay idle longer.
+  CFRunLoopTimerSetTolerance(delayed_wake_timer_, leeway.ToSecondsF());
   // Rearm the timer. The time bases used by CoreFoundation and FXL are
   // different and must be accounted for.
   CFRunLoopTimerSetNextFireDate(
@@ -0,0 +1,260 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/io_uring.h"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+namespace {
+
+int IoUringSetup(uint32_t entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int ring_fd,
+                 unsigned to_submit,
+                 unsigned min_complete,
+                 unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+}
+
+void* MapRing(int ring_fd, size_t size, off_t offset) {
+  void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+  return address == MAP_FAILED ? nullptr : address;
+}
+
+unsigned* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<unsigned*>(static_cast<uint8_t*>(ring) + offset);
+}
+
+// The user data of the request that stops the completion thread.
+constexpr uint64_t kShutdownUserData = 0;
+
+}  // namespace
+
+// The user data of a submitted operation. It lives until the operation
+// completes, as the kernel reads the io vector asynchronously.
+struct IoUring::Request {
+  Completion completion;
+  iovec io_vector = {};
+};
+
+std::unique_ptr<IoUring> IoUring::Create(uint32_t entries) {
+  io_uring_params params = {};
+  const int ring_fd = IoUringSetup(entries, &params);
+  if (ring_fd < 0) {
+    FML_DLOG(INFO) << "io_uring is not available: " << strerror(errno);
+    return nullptr;
+  }
+  std::unique_ptr<IoUring> ring(new IoUring(ring_fd));
+  if (!ring->Map(params)) {
+    return nullptr;
+  }
+  ring->completion_thread_ =
+      std::thread([ring = ring.get()]() { ring->RunCompletions(); });
+  return ring;
+}
+
+IoUring::IoUring(int ring_fd) : ring_fd_(ring_fd) {}
+
+IoUring::~IoUring() {
+  if (completion_thread_.joinable()) {
+    std::unique_lock lock(mutex_);
+    request_completed_.wait(lock, [this]() { return requests_in_flight_ == 0; });
+    SubmitLocked(IORING_OP_NOP, -1, nullptr, 0, 0, nullptr);
+    lock.unlock();
+    completion_thread_.join();
+  }
+  if (sqes_) {
+    ::munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ && cq_ring_ != sq_ring_) {
+    ::munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_) {
+    ::munmap(sq_ring_, sq_ring_size_);
+  }
+  ::close(ring_fd_);
+}
+
+bool IoUring::Map(const io_uring_params& params) {
+  const uint32_t sq_entries = params.sq_entries;
+  const uint32_t cq_entries = params.cq_entries;
+  sq_ring_size_ = params.sq_off.array + sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ring_ = MapRing(ring_fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+  if (!sq_ring_) {
+    return false;
+  }
+  cq_ring_ = single_mmap
+                 ? sq_ring_
+                 : MapRing(ring_fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+  if (!cq_ring_) {
+    return false;
+  }
+  sqes_size_ = sq_entries * sizeof(io_uring_sqe);
+  sqes_ = static_cast<io_uring_sqe*>(
+      MapRing(ring_fd_, sqes_size_, IORING_OFF_SQES));
+  if (!sqes_) {
+    return false;
+  }
+
+  sq_tail_ = RingField(sq_ring_, params.sq_off.tail);
+  sq_ring_mask_ = *RingField(sq_ring_, params.sq_off.ring_mask);
+  sq_array_ = RingField(sq_ring_, params.sq_off.array);
+  cq_head_ = RingField(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingField(cq_ring_, params.cq_off.tail);
+  cq_ring_mask_ = *RingField(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<io_uring_cqe*>(static_cast<uint8_t*>(cq_ring_) +
+                                          params.cq_off.cqes);
+  // Completion queue entries are kept for the shutdown request and for the
+  // follow up operation of a running completion. Entries the kernel did not
+  // take yet stay in the submission queue, which must not overflow either.
+  max_requests_in_flight_ = std::min(sq_entries - 1, cq_entries - 2);
+  return true;
+}
+
+void IoUring::Read(int fd,
+                   void* buffer,
+                   size_t size,
+                   uint64_t offset,
+                   Completion completion) {
+  Submit(IORING_OP_READV, fd, buffer, size, offset, std::move(completion));
+}
+
+void IoUring::Write(int fd,
+                    const void* buffer,
+                    size_t size,
+                    uint64_t offset,
+                    Completion completion) {
+  Submit(IORING_OP_WRITEV, fd, buffer, size, offset, std::move(completion));
+}
+
+void IoUring::Fsync(int fd, Completion completion) {
+  Submit(IORING_OP_FSYNC, fd, nullptr, 0, 0, std::move(completion));
+}
+
+void IoUring::Submit(uint8_t opcode,
+                     int fd,
+                     const void* buffer,
+                     size_t size,
+                     uint64_t offset,
+                     Completion completion) {
+  auto request = new Request{std::move(completion)};
+  std::unique_lock lock(mutex_);
+  // A completion that submits a follow up operation can't wait for itself to
+  // finish. It may exceed the bound by one, for which an entry is reserved.
+  if (std::this_thread::get_id() != completion_thread_.get_id()) {
+    request_completed_.wait(lock, [this]() {
+      return requests_in_flight_ < max_requests_in_flight_;
+    });
+  }
+  requests_in_flight_++;
+  SubmitLocked(opcode, fd, buffer, size, offset, request);
+}
+
+void IoUring::SubmitLocked(uint8_t opcode,
+                           int fd,
+                           const void* buffer,
+                           size_t size,
+                           uint64_t offset,
+                           Request* request) {
+  // The submission queue holds at most the entries the kernel did not take
+  // yet, which are fewer than the requests in flight.
+  const unsigned tail = __atomic_load_n(sq_tail_, __ATOMIC_RELAXED);
+  const unsigned index = tail & sq_ring_mask_;
+  io_uring_sqe& sqe = sqes_[index];
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = opcode;
+  sqe.fd = fd;
+  sqe.off = offset;
+  if (request && buffer) {
+    request->io_vector.iov_base = const_cast<void*>(buffer);
+    request->io_vector.iov_len = size;
+    sqe.addr = reinterpret_cast<uint64_t>(&request->io_vector);
+    sqe.len = 1;
+  }
+  sqe.user_data =
+      request ? reinterpret_cast<uint64_t>(request) : kShutdownUserData;
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  unsubmitted_++;
+
+  // The kernel may take fewer entries than it was offered. The others stay in
+  // the queue and are offered again with the next submission.
+  while (unsubmitted_ > 0) {
+    const int submitted = IoUringEnter(ring_fd_, unsubmitted_, 0, 0);
+    if (submitted < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      FML_LOG(ERROR) << "Could not submit to io_uring: " << strerror(errno);
+      break;
+    }
+    if (submitted == 0) {
+      break;
+    }
+    unsubmitted_ -= static_cast<unsigned>(submitted);
+  }
+}
+
+void IoUring::RunCompletions() {
+  while (true) {
+    unsigned head = __atomic_load_n(cq_head_, __ATOMIC_RELAXED);
+    const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+      if (IoUringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0 &&
+          errno != EINTR) {
+        FML_LOG(ERROR) << "Could not wait for io_uring: " << strerror(errno);
+        return;
+      }
+      continue;
+    }
+
+    bool shutdown = false;
+    for (; head != tail; head++) {
+      const io_uring_cqe& cqe = cqes_[head & cq_ring_mask_];
+      const uint64_t user_data = cqe.user_data;
+      const int32_t result = cqe.res;
+      __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+
+      if (user_data == kShutdownUserData) {
+        shutdown = true;
+        continue;
+      }
+      std::unique_ptr<Request> request(reinterpret_cast<Request*>(user_data));
+      request->completion(result);
+      request.reset();
+      {
+        std::scoped_lock lock(mutex_);
+        requests_in_flight_--;
+      }
+      request_completed_.notify_all();
+    }
+    if (shutdown) {
+      return;
+    }
+  }
+}
+
+}  // namespace fml
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PLATFORM_LINUX_IO_URING_H_
+#define FLUTTER_FML_PLATFORM_LINUX_IO_URING_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "flutter/fml/macros.h"
+
+struct io_uring_cqe;
+struct io_uring_params;
+struct io_uring_sqe;
+
+namespace fml {
+
+/// A Linux io_uring submission and completion queue pair, used through raw
+/// system calls.
+///
+/// Operations may be submitted from any thread. Their completions are
+/// delivered on a thread owned by the ring, with the result of the operation:
+/// the number of bytes transferred, or a negated errno value on failure.
+class IoUring {
+ public:
+  using Completion = std::function<void(int32_t result)>;
+
+  /// Returns null if the kernel does not support io_uring or does not allow
+  /// the process to use it.
+  static std::unique_ptr<IoUring> Create(uint32_t entries);
+
+  /// Waits for the operations in flight to complete.
+  ~IoUring();
+
+  void Read(int fd,
+            void* buffer,
+            size_t size,
+            uint64_t offset,
+            Completion completion);
+
+  void Write(int fd,
+             const void* buffer,
+             size_t size,
+             uint64_t offset,
+             Completion completion);
+
+  void Fsync(int fd, Completion completion);
+
+ private:
+  struct Request;
+
+  const int ring_fd_;
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned* sq_tail_ = nullptr;
+  unsigned sq_ring_mask_ = 0;
+  unsigned* sq_array_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_ring_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  // Submissions are serialized. The operations in flight are bounded by the
+  // size of the completion queue, so that no completion is ever dropped.
+  std::mutex mutex_;
+  std::condition_variable request_completed_;
+  size_t requests_in_flight_ = 0;
+  size_t max_requests_in_flight_ = 0;
+  // The entries queued in the submission queue that the kernel did not take
+  // yet, because io_uring_enter failed or took only some of them.
+  unsigned unsubmitted_ = 0;
+
+  std::thread completion_thread_;
+
+  explicit IoUring(int ring_fd);
+
+  bool Map(const io_uring_params& params);
+
+  void Submit(uint8_t opcode,
+              int fd,
+              const void* buffer,
+              size_t size,
+              uint64_t offset,
+              Completion completion);
+
+  void SubmitLocked(uint8_t opcode,
+                    int fd,
+                    const void* buffer,
+                    size_t size,
+                    uint64_t offset,
+                    Request* request);
+
+  void RunCompletions();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PLATFORM_LINUX_IO_URING_H_
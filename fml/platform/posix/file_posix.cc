@@ -159,6 +159,35 @@ bool TruncateFile(const fml::UniqueFD& file, size_t size) {
   return ::ftruncate(file.get(), size) == 0;
 }
 
+bool SyncFile(const fml::UniqueFD& file) {
+  if (!file.is_valid()) {
+    return false;
+  }
+
+  return FML_HANDLE_EINTR(::fsync(file.get())) == 0;
+}
+
+bool WriteFileAt(const fml::UniqueFD& file,
+                 size_t offset,
+                 const uint8_t* data,
+                 size_t size) {
+  if (!file.is_valid()) {
+    return false;
+  }
+
+  while (size > 0) {
+    const ssize_t written =
+        FML_HANDLE_EINTR(::pwrite(file.get(), data, size, offset));
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    offset += written;
+    size -= written;
+  }
+  return true;
+}
+
 bool UnlinkDirectory(const char* path) {
   return UnlinkDirectory(fml::UniqueFD{AT_FDCWD}, path);
 }
@@ -104,4 +104,34 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::Advise(std::initializer_list<AccessHint> hints) const {
+  if (mapping_ == nullptr) {
+    return false;
+  }
+  bool accepted = true;
+  for (auto hint : hints) {
+    int advice = -1;
+    switch (hint) {
+      case AccessHint::kWillNeed:
+        advice = MADV_WILLNEED;
+        break;
+      case AccessHint::kSequential:
+        advice = MADV_SEQUENTIAL;
+        break;
+      case AccessHint::kHugePages:
+#if defined(MADV_HUGEPAGE)
+        advice = MADV_HUGEPAGE;
+#endif
+        break;
+      case AccessHint::kRandom:
+        advice = MADV_RANDOM;
+        break;
+    }
+    if (advice == -1 || ::madvise(mapping_, size_, advice) != 0) {
+      accepted = false;
+    }
+  }
+  return accepted;
+}
+
 }  // namespace fml
@@ -378,6 +378,40 @@ bool TruncateFile(const fml::UniqueFD& file, size_t size) {
   return true;
 }
 
+bool SyncFile(const fml::UniqueFD& file) {
+  if (!::FlushFileBuffers(file.get())) {
+    FML_DLOG(ERROR) << "Could not flush the file. " << GetLastErrorMessage();
+    return false;
+  }
+  return true;
+}
+
+bool WriteFileAt(const fml::UniqueFD& file,
+                 size_t offset,
+                 const uint8_t* data,
+                 size_t size) {
+  while (size > 0) {
+    ULARGE_INTEGER position;
+    position.QuadPart = offset;
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = position.LowPart;
+    overlapped.OffsetHigh = position.HighPart;
+    const DWORD chunk =
+        size > MAXDWORD ? MAXDWORD : static_cast<DWORD>(size);
+    DWORD written = 0;
+    if (!::WriteFile(file.get(), data, chunk, &written, &overlapped) ||
+        written == 0) {
+      FML_DLOG(ERROR) << "Could not write to the file. "
+                      << GetLastErrorMessage();
+      return false;
+    }
+    data += written;
+    offset += written;
+    size -= written;
+  }
+  return true;
+}
+
 bool FileExists(const fml::UniqueFD& base_directory, const char* path) {
   return GetFileAttributesForUtf8Path(base_directory, path) !=
          INVALID_FILE_ATTRIBUTES;
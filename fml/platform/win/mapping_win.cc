@@ -119,4 +119,30 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::Advise(std::initializer_list<AccessHint> hints) const {
+  if (mapping_ == nullptr) {
+    return false;
+  }
+  bool accepted = true;
+  for (auto hint : hints) {
+    switch (hint) {
+      case AccessHint::kWillNeed: {
+        WIN32_MEMORY_RANGE_ENTRY range = {mapping_, size_};
+        if (!::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0)) {
+          accepted = false;
+        }
+        break;
+      }
+      case AccessHint::kSequential:
+      case AccessHint::kHugePages:
+      case AccessHint::kRandom:
+        // Views of files are neither read ahead on request nor backed by large
+        // pages.
+        accepted = false;
+        break;
+    }
+  }
+  return accepted;
+}
+
 }  // namespace fml
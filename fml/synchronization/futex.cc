@@ -0,0 +1,173 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/futex.h"
+
+#include <algorithm>
+
+#include "flutter/fml/build_config.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#elif defined(OS_FUCHSIA)
+#include <zircon/syscalls.h>
+#elif defined(OS_WIN)
+#include <windows.h>
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace fml {
+
+void CpuRelax() {
+#if defined(_MSC_VER)
+  YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "Futexes operate on plain 32-bit words.");
+
+bool FutexWait(std::atomic<uint32_t>* address,
+               uint32_t expected,
+               std::optional<TimeDelta> timeout) {
+  struct timespec relative_timeout = {};
+  if (timeout) {
+    const int64_t nanos = std::max<int64_t>(timeout->ToNanoseconds(), 0);
+    relative_timeout.tv_sec = nanos / 1000000000;
+    relative_timeout.tv_nsec = nanos % 1000000000;
+  }
+  const long result =
+      syscall(SYS_futex, reinterpret_cast<uint32_t*>(address),
+              FUTEX_WAIT_PRIVATE, expected,
+              timeout ? &relative_timeout : nullptr, nullptr, 0);
+  return result == 0 || errno != ETIMEDOUT;
+}
+
+void FutexWakeOne(std::atomic<uint32_t>* address) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), FUTEX_WAKE_PRIVATE,
+          1, nullptr, nullptr, 0);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* address) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), FUTEX_WAKE_PRIVATE,
+          INT_MAX, nullptr, nullptr, 0);
+}
+
+#elif defined(OS_FUCHSIA)
+
+bool FutexWait(std::atomic<uint32_t>* address,
+               uint32_t expected,
+               std::optional<TimeDelta> timeout) {
+  const zx_time_t deadline =
+      timeout ? zx_deadline_after(timeout->ToNanoseconds()) : ZX_TIME_INFINITE;
+  return zx_futex_wait(reinterpret_cast<const zx_futex_t*>(address),
+                       static_cast<zx_futex_t>(expected), ZX_HANDLE_INVALID,
+                       deadline) != ZX_ERR_TIMED_OUT;
+}
+
+void FutexWakeOne(std::atomic<uint32_t>* address) {
+  zx_futex_wake(reinterpret_cast<const zx_futex_t*>(address), 1);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* address) {
+  zx_futex_wake(reinterpret_cast<const zx_futex_t*>(address), UINT32_MAX);
+}
+
+#elif defined(OS_WIN)
+
+bool FutexWait(std::atomic<uint32_t>* address,
+               uint32_t expected,
+               std::optional<TimeDelta> timeout) {
+  const DWORD millis =
+      timeout ? static_cast<DWORD>(
+                    std::max<int64_t>(timeout->ToMilliseconds(), 0))
+              : INFINITE;
+  if (WaitOnAddress(address, &expected, sizeof(expected), millis)) {
+    return true;
+  }
+  return GetLastError() != ERROR_TIMEOUT;
+}
+
+void FutexWakeOne(std::atomic<uint32_t>* address) {
+  WakeByAddressSingle(address);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* address) {
+  WakeByAddressAll(address);
+}
+
+#else
+
+namespace {
+
+// Waiters on addresses that hash to the same bucket share its condition
+// variable, so every wakeup wakes all of them.
+struct Bucket {
+  std::mutex mutex;
+  std::condition_variable condition;
+};
+
+constexpr size_t kBucketCount = 64;
+
+Bucket& GetBucket(std::atomic<uint32_t>* address) {
+  static Bucket buckets[kBucketCount];
+  // Words are 4-byte aligned, so the lowest bits of their address are zero.
+  return buckets[(reinterpret_cast<uintptr_t>(address) >> 2) % kBucketCount];
+}
+
+}  // namespace
+
+bool FutexWait(std::atomic<uint32_t>* address,
+               uint32_t expected,
+               std::optional<TimeDelta> timeout) {
+  Bucket& bucket = GetBucket(address);
+  std::unique_lock<std::mutex> lock(bucket.mutex);
+  if (address->load() != expected) {
+    return true;
+  }
+  if (!timeout) {
+    bucket.condition.wait(lock);
+    return true;
+  }
+  return bucket.condition.wait_for(
+             lock, std::chrono::nanoseconds(timeout->ToNanoseconds())) ==
+         std::cv_status::no_timeout;
+}
+
+void FutexWakeOne(std::atomic<uint32_t>* address) {
+  FutexWakeAll(address);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* address) {
+  Bucket& bucket = GetBucket(address);
+  {
+    // Taking the lock orders this wakeup after a waiter that saw the old
+    // value has started waiting.
+    std::scoped_lock lock(bucket.mutex);
+  }
+  bucket.condition.notify_all();
+}
+
+#endif
+
+}  // namespace fml
@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_SYNCHRONIZATION_FUTEX_H_
+#define FLUTTER_FML_SYNCHRONIZATION_FUTEX_H_
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+#include "flutter/fml/time/time_delta.h"
+
+namespace fml {
+
+// Blocks the calling thread as long as |*address| equals |expected|, until
+// |FutexWakeOne| or |FutexWakeAll| is called for |address| or |timeout|
+// expires. Returns false if it timed out. The comparison and going to sleep
+// happen atomically with respect to waking, so a wakeup after |*address| was
+// changed is never missed. Wakeups may be spurious, so callers must check
+// |*address| again.
+//
+// This uses futexes on Linux, Android and Fuchsia and |WaitOnAddress| on
+// Windows. Elsewhere, such as on Darwin where the equivalent system calls are
+// private, it falls back to condition variables in a table of buckets that
+// addresses are hashed into.
+bool FutexWait(std::atomic<uint32_t>* address,
+               uint32_t expected,
+               std::optional<TimeDelta> timeout = std::nullopt);
+
+// Wakes at least one of the threads blocked in |FutexWait| on |address|.
+void FutexWakeOne(std::atomic<uint32_t>* address);
+
+// Wakes all threads blocked in |FutexWait| on |address|.
+void FutexWakeAll(std::atomic<uint32_t>* address);
+
+// Hints to the CPU that the calling thread is spinning.
+void CpuRelax();
+
+// Spins for a short while until |condition()| returns true, as waiting that
+// long is cheaper than going to sleep if the condition is about to become
+// true. Returns whether it did.
+template <typename Condition>
+bool SpinUntil(Condition condition) {
+  // About a microsecond on current hardware, which is well below the cost of
+  // the system calls to sleep and to wake up.
+  constexpr int kSpinCount = 100;
+  for (int i = 0; i < kSpinCount; i++) {
+    if (condition()) {
+      return true;
+    }
+    CpuRelax();
+  }
+  return condition();
+}
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_SYNCHRONIZATION_FUTEX_H_
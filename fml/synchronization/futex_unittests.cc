@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/futex.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(FutexTest, WaitReturnsImmediatelyIfValueDiffers) {
+  std::atomic<uint32_t> value = 1;
+  ASSERT_TRUE(FutexWait(&value, 0, TimeDelta::FromSeconds(10)));
+}
+
+TEST(FutexTest, WaitTimesOut) {
+  std::atomic<uint32_t> value = 0;
+  ASSERT_FALSE(FutexWait(&value, 0, TimeDelta::FromMilliseconds(10)));
+}
+
+TEST(FutexTest, WakeAllWakesEveryWaiter) {
+  std::atomic<uint32_t> value = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&value]() {
+      while (value.load() == 0) {
+        FutexWait(&value, 0);
+      }
+    });
+  }
+  value.store(1);
+  FutexWakeAll(&value);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(value.load(), 1u);
+}
+
+TEST(FutexTest, SpinUntilReturnsWhetherConditionHeld) {
+  int calls = 0;
+  ASSERT_TRUE(SpinUntil([&calls]() { return ++calls == 3; }));
+  ASSERT_EQ(calls, 3);
+  ASSERT_FALSE(SpinUntil([]() { return false; }));
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/read_mostly_mutex.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/futex.h"
+
+namespace fml {
+
+ReadMostlyMutex::ReadMostlyMutex() = default;
+
+ReadMostlyMutex::~ReadMostlyMutex() {
+  FML_DCHECK(state_.load() == 0);
+}
+
+void ReadMostlyMutex::LockSharedSlow() {
+  while (true) {
+    // Back out so that the writer does not wait for this reader, and wait for
+    // the writer to be done.
+    uint32_t state = state_.fetch_sub(kReader, std::memory_order_relaxed);
+    if (state == (kWriterActive | kReader)) {
+      WakeWriterOrReaders();
+    }
+    state -= kReader;
+    while (state & kWriterActive) {
+      FutexWait(&state_, state);
+      state = state_.load(std::memory_order_relaxed);
+    }
+    state = state_.fetch_add(kReader, std::memory_order_acquire);
+    if (!(state & kWriterActive)) {
+      return;
+    }
+  }
+}
+
+void ReadMostlyMutex::WakeWriterOrReaders() {
+  // The writer and the readers that wait for it wait on the same word, so
+  // wake all of them. Both are rare.
+  FutexWakeAll(&state_);
+}
+
+void ReadMostlyMutex::Lock() {
+  writer_mutex_.lock();
+  uint32_t state = state_.fetch_or(kWriterActive, std::memory_order_acquire);
+  state |= kWriterActive;
+  // Wait for the readers that were already in their critical sections.
+  while (state != kWriterActive) {
+    FutexWait(&state_, state);
+    state = state_.load(std::memory_order_acquire);
+  }
+}
+
+void ReadMostlyMutex::Unlock() {
+  // Readers that were turned away may still be counted while they back out,
+  // so only the writer bit is cleared.
+  state_.fetch_and(~kWriterActive, std::memory_order_release);
+  WakeWriterOrReaders();
+  writer_mutex_.unlock();
+}
+
+}  // namespace fml
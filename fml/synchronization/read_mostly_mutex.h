@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_SYNCHRONIZATION_READ_MOSTLY_MUTEX_H_
+#define FLUTTER_FML_SYNCHRONIZATION_READ_MOSTLY_MUTEX_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// A reader/writer lock for data that is read far more often than it is
+/// written.
+///
+/// Taking a shared lock does not take a mutex or make a system call. Readers
+/// only announce themselves in an atomic counter, and check that no writer is
+/// active. A writer first marks itself as active, which turns away new
+/// readers, and then waits for the readers that are already in their critical
+/// sections to leave, like a grace period in RCU. Only readers that arrive
+/// while a writer is active block, until the writer is done.
+///
+/// Shared locks are not reentrant: a thread that holds one and takes another
+/// deadlocks if a writer arrives in between.
+class ReadMostlyMutex {
+ public:
+  ReadMostlyMutex();
+
+  ~ReadMostlyMutex();
+
+  void LockShared() {
+    // Readers are counted first so that a writer that marks itself as active
+    // afterwards waits for them.
+    uint32_t state = state_.fetch_add(kReader, std::memory_order_acquire);
+    if (state & kWriterActive) {
+      LockSharedSlow();
+    }
+  }
+
+  void UnlockShared() {
+    uint32_t state = state_.fetch_sub(kReader, std::memory_order_release);
+    if (state == (kWriterActive | kReader)) {
+      WakeWriterOrReaders();
+    }
+  }
+
+  void Lock();
+
+  void Unlock();
+
+  /// RAII wrapper that does a shared acquire of a |ReadMostlyMutex|.
+  class SharedLock {
+   public:
+    explicit SharedLock(ReadMostlyMutex& mutex) : mutex_(mutex) {
+      mutex_.LockShared();
+    }
+
+    ~SharedLock() { mutex_.UnlockShared(); }
+
+   private:
+    ReadMostlyMutex& mutex_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(SharedLock);
+  };
+
+  /// RAII wrapper that does an exclusive acquire of a |ReadMostlyMutex|.
+  class UniqueLock {
+   public:
+    explicit UniqueLock(ReadMostlyMutex& mutex) : mutex_(mutex) {
+      mutex_.Lock();
+    }
+
+    ~UniqueLock() { mutex_.Unlock(); }
+
+   private:
+    ReadMostlyMutex& mutex_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(UniqueLock);
+  };
+
+ private:
+  // The lowest bit of |state_| is set while a writer is active, and the other
+  // bits count the readers, including those that are turned away but have not
+  // backed out yet.
+  static constexpr uint32_t kWriterActive = 1u;
+  static constexpr uint32_t kReader = 2u;
+
+  std::atomic<uint32_t> state_ = 0;
+
+  // Serializes writers, so that only one of them marks itself as active.
+  std::mutex writer_mutex_;
+
+  void LockSharedSlow();
+
+  void WakeWriterOrReaders();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ReadMostlyMutex);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_SYNCHRONIZATION_READ_MOSTLY_MUTEX_H_
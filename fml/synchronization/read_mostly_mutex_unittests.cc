@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/read_mostly_mutex.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(ReadMostlyMutexTest, ReadersShareTheLock) {
+  ReadMostlyMutex mutex;
+  ReadMostlyMutex::SharedLock first(mutex);
+  AutoResetWaitableEvent locked;
+  std::thread thread([&]() {
+    ReadMostlyMutex::SharedLock second(mutex);
+    locked.Signal();
+  });
+  locked.Wait();
+  thread.join();
+}
+
+TEST(ReadMostlyMutexTest, WriterWaitsForReaders) {
+  ReadMostlyMutex mutex;
+  std::atomic<bool> reading = true;
+  std::atomic<bool> wrote = false;
+  mutex.LockShared();
+  std::thread writer([&]() {
+    ReadMostlyMutex::UniqueLock lock(mutex);
+    EXPECT_FALSE(reading.load());
+    wrote = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(wrote.load());
+  reading = false;
+  mutex.UnlockShared();
+  writer.join();
+  EXPECT_TRUE(wrote.load());
+}
+
+TEST(ReadMostlyMutexTest, ReadersAndWritersAreExclusive) {
+  ReadMostlyMutex mutex;
+  // Written only by writers, which keep both halves equal.
+  int first = 0;
+  int second = 0;
+  std::atomic<bool> torn = false;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < 10000; j++) {
+        ReadMostlyMutex::SharedLock lock(mutex);
+        if (first != second) {
+          torn = true;
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 2; i++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < 1000; j++) {
+        ReadMostlyMutex::UniqueLock lock(mutex);
+        first++;
+        second++;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_FALSE(torn.load());
+  EXPECT_EQ(first, 2000);
+  EXPECT_EQ(second, 2000);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -5,15 +5,16 @@
 #ifndef FLUTTER_FML_SYNCHRONIZATION_SEMAPHORE_H_
 #define FLUTTER_FML_SYNCHRONIZATION_SEMAPHORE_H_
 
-#include <memory>
+#include <atomic>
+#include <cstdint>
 
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/macros.h"
 
 namespace fml {
 
-class PlatformSemaphore;
-
+// A counting semaphore that can only be waited on without blocking, so a
+// lock-free counter suffices and no system calls are made.
 class Semaphore {
  public:
   explicit Semaphore(uint32_t count);
@@ -27,7 +28,7 @@ class Semaphore {
   void Signal();
 
  private:
-  std::unique_ptr<PlatformSemaphore> _impl;
+  std::atomic<uint32_t> count_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Semaphore);
 };
@@ -21,7 +21,7 @@ SyncSwitch::Handlers& SyncSwitch::Handlers::SetIfFalse(
 SyncSwitch::SyncSwitch(bool value) : value_(value) {}
 
 void SyncSwitch::Execute(const SyncSwitch::Handlers& handlers) const {
-  std::scoped_lock guard(mutex_);
+  ReadMostlyMutex::SharedLock guard(mutex_);
   if (value_) {
     handlers.true_handler();
   } else {
@@ -30,7 +30,7 @@ void SyncSwitch::Execute(const SyncSwitch::Handlers& handlers) const {
 }
 
 void SyncSwitch::SetSwitch(bool value) {
-  std::scoped_lock guard(mutex_);
+  ReadMostlyMutex::UniqueLock guard(mutex_);
   value_ = value;
 }
 
@@ -7,9 +7,9 @@
 
 #include <forward_list>
 #include <functional>
-#include <mutex>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/read_mostly_mutex.h"
 
 namespace fml {
 
@@ -17,7 +17,8 @@ namespace fml {
 /// execution paths.
 ///
 /// Execution and setting the switch is exclusive, i.e. only one will happen
-/// at a time.
+/// at a time. Executions on different threads may happen at the same time,
+/// and are cheap as they do not take a mutex unless the switch is being set.
 class SyncSwitch {
  public:
   /// Represents the 2 code paths available when calling |SyncSwitch::Execute|.
@@ -40,20 +41,22 @@ class SyncSwitch {
   /// Diverge execution between true and false values of the SyncSwitch.
   ///
   /// This can be called on any thread.  Note that attempting to call
-  /// |SetSwitch| inside of the handlers will result in a self deadlock.
+  /// |SetSwitch| or |Execute| inside of the handlers may result in a self
+  /// deadlock.
   ///
   /// @param[in]  handlers  Called for the correct value of the |SyncSwitch|.
   void Execute(const Handlers& handlers) const;
 
   /// Set the value of the SyncSwitch.
   ///
-  /// This can be called on any thread.
+  /// This can be called on any thread. It waits for the handlers that are
+  /// being executed to return.
   ///
   /// @param[in]  value  New value for the |SyncSwitch|.
   void SetSwitch(bool value);
 
  private:
-  mutable std::mutex mutex_;
+  mutable ReadMostlyMutex mutex_;
   bool value_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SyncSwitch);
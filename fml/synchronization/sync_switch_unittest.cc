@@ -4,6 +4,10 @@
 
 #include "flutter/fml/synchronization/sync_switch.h"
 
+#include <atomic>
+#include <thread>
+
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "gtest/gtest.h"
 
 using fml::SyncSwitch;
@@ -28,3 +32,27 @@ TEST(SyncSwitchTest, NoopIfUndefined) {
   syncSwitch.Execute(SyncSwitch::Handlers());
   EXPECT_FALSE(switchValue);
 }
+
+TEST(SyncSwitchTest, SetSwitchWaitsForHandlers) {
+  SyncSwitch syncSwitch;
+  fml::AutoResetWaitableEvent executing;
+  fml::AutoResetWaitableEvent release;
+  std::thread thread([&] {
+    syncSwitch.Execute(SyncSwitch::Handlers().SetIfFalse([&] {
+      executing.Signal();
+      release.Wait();
+    }));
+  });
+  executing.Wait();
+  std::atomic<bool> switched = false;
+  std::thread setter([&] {
+    syncSwitch.SetSwitch(true);
+    switched = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(switched.load());
+  release.Signal();
+  thread.join();
+  setter.join();
+  EXPECT_TRUE(switched.load());
+}
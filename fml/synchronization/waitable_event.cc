@@ -4,173 +4,151 @@
 
 #include "flutter/fml/synchronization/waitable_event.h"
 
-#include <cerrno>
-#include <ctime>
+#include <optional>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/futex.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 
 namespace fml {
 
-// Waits with a timeout on |condition()|. Returns true on timeout, or false if
-// |condition()| ever returns true. |condition()| should have no side effects
-// (and will always be called with |*mutex| held).
-template <typename ConditionFn>
-bool WaitWithTimeoutImpl(std::unique_lock<std::mutex>* locker,
-                         std::condition_variable* cv,
-                         ConditionFn condition,
-                         TimeDelta timeout) {
-  FML_DCHECK(locker->owns_lock());
-
-  if (condition()) {
-    return false;
-  }
-
-  // We may get spurious wakeups.
-  TimeDelta wait_remaining = timeout;
-  TimePoint start = TimePoint::Now();
-  while (true) {
-    if (std::cv_status::timeout ==
-        cv->wait_for(*locker, std::chrono::nanoseconds(
-                                  wait_remaining.ToNanoseconds()))) {
-      return true;  // Definitely timed out.
-    }
-
-    // We may have been awoken.
-    if (condition()) {
-      return false;
-    }
+namespace {
 
-    // Or the wakeup may have been spurious.
+// Blocks on |state| as long as it is |expected|, with |waiter_count| counting
+// the calling thread as a waiter meanwhile. Returns false if |deadline| passed.
+bool WaitOnState(std::atomic<uint32_t>* state,
+                 std::atomic<uint32_t>* waiter_count,
+                 uint32_t expected,
+                 std::optional<TimePoint> deadline) {
+  std::optional<TimeDelta> timeout;
+  if (deadline) {
     TimePoint now = TimePoint::Now();
-    FML_DCHECK(now >= start);
-    TimeDelta elapsed = now - start;
-    // It's possible that we may have timed out anyway.
-    if (elapsed >= timeout) {
-      return true;
+    if (now >= *deadline) {
+      return false;
     }
-
-    // Otherwise, recalculate the amount that we have left to wait.
-    wait_remaining = timeout - elapsed;
+    timeout = *deadline - now;
   }
+  // Signaling stores the state before it reads the number of waiters, and
+  // this counts the waiter before |FutexWait| compares the state, so either
+  // the signaling thread wakes this one or |FutexWait| returns right away.
+  waiter_count->fetch_add(1);
+  bool woken = FutexWait(state, expected, timeout);
+  waiter_count->fetch_sub(1);
+  return woken;
 }
 
+}  // namespace
+
 // AutoResetWaitableEvent ------------------------------------------------------
 
+bool AutoResetWaitableEvent::TryConsumeSignal() {
+  uint32_t expected = 1;
+  return state_.load(std::memory_order_relaxed) == 1 &&
+         state_.compare_exchange_strong(expected, 0,
+                                        std::memory_order_acquire);
+}
+
 void AutoResetWaitableEvent::Signal() {
-  std::scoped_lock locker(mutex_);
-  signaled_ = true;
-  cv_.notify_one();
+  state_.store(1);
+  if (waiter_count_.load() > 0) {
+    FutexWakeOne(&state_);
+  }
 }
 
 void AutoResetWaitableEvent::Reset() {
-  std::scoped_lock locker(mutex_);
-  signaled_ = false;
+  state_.store(0, std::memory_order_relaxed);
 }
 
 void AutoResetWaitableEvent::Wait() {
-  std::unique_lock<std::mutex> locker(mutex_);
-  while (!signaled_) {
-    cv_.wait(locker);
+  if (SpinUntil([this]() { return TryConsumeSignal(); })) {
+    return;
+  }
+  while (!TryConsumeSignal()) {
+    WaitOnState(&state_, &waiter_count_, 0, std::nullopt);
   }
-  signaled_ = false;
 }
 
 bool AutoResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
-  std::unique_lock<std::mutex> locker(mutex_);
-
-  if (signaled_) {
-    signaled_ = false;
+  if (SpinUntil([this]() { return TryConsumeSignal(); })) {
     return false;
   }
-
-  // We may get spurious wakeups.
-  TimeDelta wait_remaining = timeout;
-  TimePoint start = TimePoint::Now();
-  while (true) {
-    if (std::cv_status::timeout ==
-        cv_.wait_for(
-            locker, std::chrono::nanoseconds(wait_remaining.ToNanoseconds()))) {
-      return true;  // Definitely timed out.
+  const TimePoint deadline = TimePoint::Now() + timeout;
+  while (!TryConsumeSignal()) {
+    // We may get spurious wakeups, so only a passed deadline is a timeout.
+    if (!WaitOnState(&state_, &waiter_count_, 0, deadline)) {
+      return !TryConsumeSignal();
     }
-
-    // We may have been awoken.
-    if (signaled_) {
-      break;
-    }
-
-    // Or the wakeup may have been spurious.
-    TimePoint now = TimePoint::Now();
-    FML_DCHECK(now >= start);
-    TimeDelta elapsed = now - start;
-    // It's possible that we may have timed out anyway.
-    if (elapsed >= timeout) {
-      return true;
-    }
-
-    // Otherwise, recalculate the amount that we have left to wait.
-    wait_remaining = timeout - elapsed;
   }
-
-  signaled_ = false;
   return false;
 }
 
 bool AutoResetWaitableEvent::IsSignaledForTest() {
-  std::scoped_lock locker(mutex_);
-  return signaled_;
+  return state_.load() == 1;
 }
 
 // ManualResetWaitableEvent ----------------------------------------------------
 
+namespace {
+
+constexpr uint32_t kSignaledBit = 1u;
+
+// Whether a thread that started waiting when the state was |start| may stop.
+bool IsSignaledSince(uint32_t start, uint32_t state) {
+  return (state & kSignaledBit) || (state & ~kSignaledBit) != start;
+}
+
+}  // namespace
+
 void ManualResetWaitableEvent::Signal() {
-  std::scoped_lock locker(mutex_);
-  signaled_ = true;
-  signal_id_++;
-  cv_.notify_all();
+  uint32_t state = state_.load(std::memory_order_relaxed);
+  while (!state_.compare_exchange_weak(
+      state, ((state & ~kSignaledBit) + 2) | kSignaledBit)) {
+  }
+  if (waiter_count_.load() > 0) {
+    FutexWakeAll(&state_);
+  }
 }
 
 void ManualResetWaitableEvent::Reset() {
-  std::scoped_lock locker(mutex_);
-  signaled_ = false;
+  state_.fetch_and(~kSignaledBit, std::memory_order_relaxed);
 }
 
 void ManualResetWaitableEvent::Wait() {
-  std::unique_lock<std::mutex> locker(mutex_);
-
-  if (signaled_) {
+  const uint32_t start = state_.load(std::memory_order_acquire) & ~kSignaledBit;
+  auto signaled = [this, start]() {
+    return IsSignaledSince(start, state_.load(std::memory_order_acquire));
+  };
+  if (SpinUntil(signaled)) {
     return;
   }
-
-  auto last_signal_id = signal_id_;
-  do {
-    cv_.wait(locker);
-  } while (signal_id_ == last_signal_id);
+  uint32_t state;
+  while (!IsSignaledSince(start, state = state_.load())) {
+    WaitOnState(&state_, &waiter_count_, state, std::nullopt);
+  }
 }
 
 bool ManualResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
-  std::unique_lock<std::mutex> locker(mutex_);
-
-  auto last_signal_id = signal_id_;
-  // Disable thread-safety analysis for the lambda: We could annotate it with
-  // |FML_EXCLUSIVE_LOCKS_REQUIRED(mutex_)|, but then the analyzer currently
-  // isn't able to figure out that |WaitWithTimeoutImpl()| calls it while
-  // holding |mutex_|.
-  bool rv = WaitWithTimeoutImpl(
-      &locker, &cv_,
-      [this, last_signal_id]() {
-        // Also check |signaled_| in case we're already signaled.
-        return signaled_ || signal_id_ != last_signal_id;
-      },
-      timeout);
-  FML_DCHECK(rv || signaled_ || signal_id_ != last_signal_id);
-  return rv;
+  const uint32_t start = state_.load(std::memory_order_acquire) & ~kSignaledBit;
+  auto signaled = [this, start]() {
+    return IsSignaledSince(start, state_.load(std::memory_order_acquire));
+  };
+  if (SpinUntil(signaled)) {
+    return false;
+  }
+  const TimePoint deadline = TimePoint::Now() + timeout;
+  uint32_t state;
+  while (!IsSignaledSince(start, state = state_.load())) {
+    // We may get spurious wakeups, so only a passed deadline is a timeout.
+    if (!WaitOnState(&state_, &waiter_count_, state, deadline)) {
+      return !signaled();
+    }
+  }
+  return false;
 }
 
 bool ManualResetWaitableEvent::IsSignaledForTest() {
-  std::scoped_lock locker(mutex_);
-  return signaled_;
+  return state_.load() & kSignaledBit;
 }
 
 }  // namespace fml
@@ -10,8 +10,8 @@
 #ifndef FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 #define FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 
-#include <condition_variable>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
@@ -38,7 +38,7 @@ class AutoResetWaitableEvent final {
   //   call to |Signal()|.
   // * A |Signal()|, followed by a |Reset()|, may cause *no* waiting thread to
   //   be unblocked.
-  // * We rely on pthreads's queueing for picking which waiting thread to
+  // * We rely on the system's queueing for picking which waiting thread to
   //   unblock, rather than enforcing FIFO ordering.
   void Signal();
 
@@ -62,11 +62,15 @@ class AutoResetWaitableEvent final {
   bool IsSignaledForTest();
 
  private:
-  std::condition_variable cv_;
-  std::mutex mutex_;
+  // 1 if this event is in the signaled state, 0 otherwise. Waiting threads
+  // spin briefly and then block on this with |FutexWait|.
+  std::atomic<uint32_t> state_ = 0;
 
-  // True if this event is in the signaled state.
-  bool signaled_ = false;
+  // The number of threads that are blocked, or about to block, on |state_|,
+  // so that |Signal()| only makes a system call to wake them if there are any.
+  std::atomic<uint32_t> waiter_count_ = 0;
+
+  bool TryConsumeSignal();
 
   FML_DISALLOW_COPY_AND_ASSIGN(AutoResetWaitableEvent);
 };
@@ -104,20 +108,17 @@ class ManualResetWaitableEvent final {
   bool IsSignaledForTest();
 
  private:
-  std::condition_variable cv_;
-  std::mutex mutex_;
-
-  // True if this event is in the signaled state.
-  bool signaled_ = false;
-
-  // While |std::condition_variable::notify_all()| (|pthread_cond_broadcast()|)
-  // will wake all waiting threads, one has to deal with spurious wake-ups.
-  // Checking |signaled_| isn't sufficient, since another thread may have been
-  // awoken and (manually) reset |signaled_|. This is a counter that is
-  // incremented in |Signal()| before calling
-  // |std::condition_variable::notify_all()|. A waiting thread knows it was
-  // awoken if |signal_id_| is different from when it started waiting.
-  unsigned signal_id_ = 0u;
+  // The lowest bit is set if this event is in the signaled state. The other
+  // bits count the calls to |Signal()|.
+  //
+  // While waking all waiting threads, one has to deal with spurious wake-ups.
+  // Checking the signaled state isn't sufficient, since another thread may
+  // have been awoken and (manually) reset the event. A waiting thread knows it
+  // was awoken if the count is different from when it started waiting.
+  std::atomic<uint32_t> state_ = 0;
+
+  // The number of threads that are blocked, or about to block, on |state_|.
+  std::atomic<uint32_t> waiter_count_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ManualResetWaitableEvent);
 };
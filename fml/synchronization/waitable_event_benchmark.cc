@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/waitable_event.h"
+
+#include <atomic>
+#include <thread>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace fml {
+namespace benchmarking {
+
+// Measures the round trip of signaling a thread that waits on an event and
+// then waiting for it to signal back, as the engine does to hand work between
+// its threads.
+static void BM_AutoResetWaitableEventPingPong(
+    benchmark::State& state) {  // NOLINT
+  AutoResetWaitableEvent ping;
+  AutoResetWaitableEvent pong;
+  std::atomic<bool> done = false;
+  std::thread thread([&]() {
+    while (true) {
+      ping.Wait();
+      if (done) {
+        break;
+      }
+      pong.Signal();
+    }
+  });
+  while (state.KeepRunning()) {
+    ping.Signal();
+    pong.Wait();
+  }
+  done = true;
+  ping.Signal();
+  thread.join();
+}
+
+static void BM_ManualResetWaitableEventSignalAndWait(
+    benchmark::State& state) {  // NOLINT
+  ManualResetWaitableEvent event;
+  while (state.KeepRunning()) {
+    event.Signal();
+    event.Wait();
+    event.Reset();
+  }
+}
+
+BENCHMARK(BM_AutoResetWaitableEventPingPong);
+BENCHMARK(BM_ManualResetWaitableEventSignalAndWait);
+
+}  // namespace benchmarking
+}  // namespace fml
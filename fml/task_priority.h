@@ -0,0 +1,37 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_PRIORITY_H_
+#define FLUTTER_FML_TASK_PRIORITY_H_
+
+#include <cstddef>
+
+namespace fml {
+
+/**
+ * The priority of a task dispatched by `MessageLoopTaskQueues`. Of the tasks
+ * whose target time has been reached, the ones with a higher priority run
+ * first, in the order of their target times. Tasks that are not due yet wait
+ * regardless of their priority.
+ */
+enum class TaskPriority {
+  /// This `TaskPriority` indicates that a frame in progress waits for the
+  /// task, such as beginning a frame on vsync.
+  kFrameCritical,
+  /// This `TaskPriority` indicates that the task handles user input, such as
+  /// dispatching pointer events.
+  kUserInput,
+  /// The default `TaskPriority`.
+  kNormal,
+  /// This `TaskPriority` indicates that the task can wait until no other task
+  /// is due.
+  kIdle,
+};
+
+constexpr size_t kTaskPriorityCount =
+    static_cast<size_t>(TaskPriority::kIdle) + 1;
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_PRIORITY_H_
@@ -35,6 +35,20 @@ void TaskRunner::PostDelayedTask(const fml::closure& task,
   loop_->PostTask(task, fml::TimePoint::Now() + delay);
 }
 
+void TaskRunner::PostTaskWithPriority(const fml::closure& task,
+                                      fml::TimePoint target_time,
+                                      fml::TaskPriority priority,
+                                      fml::TimePoint deadline) {
+  loop_->PostTask(task, target_time, priority, deadline);
+}
+
+void TaskRunner::PostDelayedTaskWithLeeway(const fml::closure& task,
+                                           fml::TimeDelta delay,
+                                           fml::TimeDelta leeway) {
+  loop_->PostTask(task, fml::TimePoint::Now() + delay,
+                  fml::TaskPriority::kNormal, fml::TimePoint::Max(), leeway);
+}
+
 TaskQueueId TaskRunner::GetTaskQueueId() {
   FML_DCHECK(loop_);
   return loop_->GetTaskQueueId();
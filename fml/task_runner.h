@@ -10,6 +10,7 @@
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/message_loop_task_queues.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/time/time_point.h"
 
 namespace fml {
@@ -33,6 +34,22 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
 
   virtual void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay);
 
+  // Posts a task that runs at |target_time|, ahead of the due tasks with a
+  // lower |priority|. The task runs as if it were
+  // |TaskPriority::kFrameCritical| once |deadline| has passed.
+  virtual void PostTaskWithPriority(
+      const fml::closure& task,
+      fml::TimePoint target_time,
+      fml::TaskPriority priority,
+      fml::TimePoint deadline = fml::TimePoint::Max());
+
+  // Posts a task that runs after |delay|, but may run up to |leeway| later so
+  // that the thread can wake up for it along with other tasks. Timers that
+  // don't need to be precise should use this to save power.
+  virtual void PostDelayedTaskWithLeeway(const fml::closure& task,
+                                         fml::TimeDelta delay,
+                                         fml::TimeDelta leeway);
+
   virtual bool RunsTasksOnCurrentThread();
 
   virtual TaskQueueId GetTaskQueueId();
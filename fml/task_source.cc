@@ -6,6 +6,8 @@
 
 #include "flutter/fml/task_source.h"
 
+#include <algorithm>
+
 namespace fml {
 
 TaskSource::TaskSource(TaskQueueId task_queue_id)
@@ -16,40 +18,52 @@ TaskSource::~TaskSource() {
 }
 
 void TaskSource::ShutDown() {
-  primary_task_queue_ = {};
+  primary_task_queues_ = {};
   secondary_task_queue_ = {};
+  primary_latest_times_.clear();
+  secondary_latest_times_.clear();
 }
 
 void TaskSource::RegisterTask(const DelayedTask& task) {
   switch (task.GetTaskSourceGrade()) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.push(task);
+      PrimaryTaskQueue(task.GetPriority()).push(task);
+      primary_latest_times_.insert(task.GetLatestTime());
       break;
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.push(task);
+      PrimaryTaskQueue(task.GetPriority()).push(task);
+      primary_latest_times_.insert(task.GetLatestTime());
       break;
     case TaskSourceGrade::kDartMicroTasks:
       secondary_task_queue_.push(task);
+      secondary_latest_times_.insert(task.GetLatestTime());
       break;
   }
 }
 
-void TaskSource::PopTask(TaskSourceGrade grade) {
+void TaskSource::PopTask(TaskSourceGrade grade, TaskPriority priority) {
   switch (grade) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.pop();
-      break;
-    case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.pop();
+    case TaskSourceGrade::kUnspecified: {
+      fml::DelayedTaskQueue& task_queue = PrimaryTaskQueue(priority);
+      primary_latest_times_.erase(
+          primary_latest_times_.find(task_queue.top().GetLatestTime()));
+      task_queue.pop();
       break;
+    }
     case TaskSourceGrade::kDartMicroTasks:
+      secondary_latest_times_.erase(secondary_latest_times_.find(
+          secondary_task_queue_.top().GetLatestTime()));
       secondary_task_queue_.pop();
       break;
   }
 }
 
 size_t TaskSource::GetNumPendingTasks() const {
-  size_t size = primary_task_queue_.size();
+  size_t size = 0;
+  for (const auto& primary_task_queue : primary_task_queues_) {
+    size += primary_task_queue.size();
+  }
   if (secondary_pause_requests_ == 0) {
     size += secondary_task_queue_.size();
   }
@@ -61,34 +75,55 @@ bool TaskSource::IsEmpty() const {
 }
 
 TaskSource::TopTask TaskSource::Top() const {
+  return Top(fml::TimePoint::Min());
+}
+
+TaskSource::TopTask TaskSource::Top(fml::TimePoint now) const {
   FML_CHECK(!IsEmpty());
-  if (secondary_pause_requests_ > 0 || secondary_task_queue_.empty()) {
-    const auto& primary_top = primary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = primary_top,
-    };
-  } else if (primary_task_queue_.empty()) {
-    const auto& secondary_top = secondary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = secondary_top,
-    };
-  } else {
-    const auto& primary_top = primary_task_queue_.top();
-    const auto& secondary_top = secondary_task_queue_.top();
-    if (primary_top > secondary_top) {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = secondary_top,
-      };
-    } else {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = primary_top,
-      };
+  const DelayedTask* top = nullptr;
+  for (const auto& primary_task_queue : primary_task_queues_) {
+    if (!primary_task_queue.empty() &&
+        (!top || primary_task_queue.top().RunsBefore(*top, now))) {
+      top = &primary_task_queue.top();
     }
   }
+  if (secondary_pause_requests_ == 0 && !secondary_task_queue_.empty() &&
+      (!top || secondary_task_queue_.top().RunsBefore(*top, now))) {
+    top = &secondary_task_queue_.top();
+  }
+  return {
+      .task_queue_id = task_queue_id_,
+      .task = *top,
+  };
+}
+
+TaskSource::WakeUpRange TaskSource::GetWakeUpRange() const {
+  FML_CHECK(!IsEmpty());
+  WakeUpRange range = {
+      .earliest = fml::TimePoint::Max(),
+      .latest = fml::TimePoint::Max(),
+  };
+  auto add_task_queue =
+      [&range](const fml::DelayedTaskQueue& task_queue,
+               const std::multiset<fml::TimePoint>& latest_times) {
+        if (task_queue.empty()) {
+          return;
+        }
+        const DelayedTask& task = task_queue.top();
+        range.earliest = std::min(range.earliest, task.GetTargetTime());
+        range.latest = std::min(range.latest, *latest_times.begin());
+      };
+  for (const auto& primary_task_queue : primary_task_queues_) {
+    add_task_queue(primary_task_queue, primary_latest_times_);
+  }
+  if (secondary_pause_requests_ == 0) {
+    add_task_queue(secondary_task_queue_, secondary_latest_times_);
+  }
+  return range;
+}
+
+fml::DelayedTaskQueue& TaskSource::PrimaryTaskQueue(TaskPriority priority) {
+  return primary_task_queues_[static_cast<size_t>(priority)];
 }
 
 void TaskSource::PauseSecondary() {
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_FML_TASK_SOURCE_H_
 #define FLUTTER_FML_TASK_SOURCE_H_
 
+#include <array>
+#include <set>
+
 #include "flutter/fml/delayed_task.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source_grade.h"
@@ -18,7 +21,8 @@ class MessageLoopTaskQueues;
  * wrapper around a primary and secondary task heap with the difference between
  * them being that the secondary task heap can be paused and resumed by the task
  * dispatcher. `TaskSourceGrade` determines what task heap the task is assigned
- * to.
+ * to. The primary task heap is split by `TaskPriority`, so that the due task
+ * with the highest priority can be found at the top of one of them.
  *
  * Registering Tasks
  * -----------------
@@ -39,6 +43,14 @@ class TaskSource {
     const DelayedTask& task;
   };
 
+  /// When to wake up for the pending tasks. Waking up at any time in the range
+  /// runs the tasks on time within their leeway, and any other tasks that are
+  /// due by then along with them.
+  struct WakeUpRange {
+    fml::TimePoint earliest;
+    fml::TimePoint latest;
+  };
+
   /// Construts a TaskSource with the given `task_queue_id`.
   explicit TaskSource(TaskQueueId task_queue_id);
 
@@ -51,8 +63,10 @@ class TaskSource {
   /// `TaskSourceGrade` of the `DelayedTask`.
   void RegisterTask(const DelayedTask& task);
 
-  /// Pops the task heap corresponding to the `TaskSourceGrade`.
-  void PopTask(TaskSourceGrade grade);
+  /// Pops the task heap corresponding to the `TaskSourceGrade` and, for the
+  /// primary task heap, the `TaskPriority`.
+  void PopTask(TaskSourceGrade grade,
+               TaskPriority priority = TaskPriority::kNormal);
 
   /// Returns the number of pending tasks. Excludes the tasks from the secondary
   /// heap if it's paused.
@@ -65,6 +79,14 @@ class TaskSource {
   /// the secondary heap has been paused or not.
   TopTask Top() const;
 
+  /// Returns the task to run at `now`, which is the due task with the highest
+  /// priority, or the top task based on scheduled time if none is due.
+  TopTask Top(fml::TimePoint now) const;
+
+  /// Returns the range from the earliest target time of the pending tasks to
+  /// the earliest time one of them must run by.
+  WakeUpRange GetWakeUpRange() const;
+
   /// Pause providing tasks from secondary task heap.
   void PauseSecondary();
 
@@ -73,10 +95,17 @@ class TaskSource {
 
  private:
   const fml::TaskQueueId task_queue_id_;
-  fml::DelayedTaskQueue primary_task_queue_;
+  std::array<fml::DelayedTaskQueue, kTaskPriorityCount> primary_task_queues_;
   fml::DelayedTaskQueue secondary_task_queue_;
+  // The latest times of the tasks in the primary and the secondary heaps. A
+  // task with a short leeway may be queued behind one with a long leeway, so
+  // the top of each heap alone does not bound when the tasks must run.
+  std::multiset<fml::TimePoint> primary_latest_times_;
+  std::multiset<fml::TimePoint> secondary_latest_times_;
   int secondary_pause_requests_ = 0;
 
+  fml::DelayedTaskQueue& PrimaryTaskQueue(TaskPriority priority);
+
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskSource);
 };
 
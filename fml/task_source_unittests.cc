@@ -96,5 +96,121 @@ TEST(TaskSourceTests, OrderingMultiTaskHeapsSecondaryPaused) {
   ASSERT_EQ(value, 1);
 }
 
+TEST(TaskSourceTests, DueTaskWithHigherPriorityRunsFirst) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = fml::TimePoint::Now();
+  int value = 0;
+  task_source.RegisterTask({1, [&] { value = 1; }, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal});
+  task_source.RegisterTask({2, [&] { value = 7; },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1),
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kFrameCritical});
+  const auto now = time_stamp + fml::TimeDelta::FromMilliseconds(2);
+
+  auto top_task = task_source.Top(now);
+  top_task.task.GetTask()();
+  task_source.PopTask(top_task.task.GetTaskSourceGrade(),
+                      top_task.task.GetPriority());
+  ASSERT_EQ(value, 7);
+
+  auto second_task = task_source.Top(now);
+  second_task.task.GetTask()();
+  task_source.PopTask(second_task.task.GetTaskSourceGrade(),
+                      second_task.task.GetPriority());
+  ASSERT_EQ(value, 1);
+}
+
+TEST(TaskSourceTests, TaskThatIsNotDueDoesNotRunFirst) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = fml::TimePoint::Now();
+  int value = 0;
+  task_source.RegisterTask({1, [&] { value = 1; }, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kIdle});
+  task_source.RegisterTask({2, [&] { value = 7; },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(5),
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kFrameCritical});
+
+  auto top_task = task_source.Top(time_stamp);
+  top_task.task.GetTask()();
+  ASSERT_EQ(value, 1);
+}
+
+TEST(TaskSourceTests, TaskPastItsDeadlineRunsFirst) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = fml::TimePoint::Now();
+  int value = 0;
+  task_source.RegisterTask({1, [&] { value = 1; }, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kUserInput});
+  task_source.RegisterTask({2, [&] { value = 7; }, time_stamp,
+                            TaskSourceGrade::kUnspecified, TaskPriority::kIdle,
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1)});
+
+  auto top_task = task_source.Top(time_stamp);
+  top_task.task.GetTask()();
+  ASSERT_EQ(value, 1);
+
+  auto promoted_task =
+      task_source.Top(time_stamp + fml::TimeDelta::FromMilliseconds(1));
+  promoted_task.task.GetTask()();
+  ASSERT_EQ(value, 7);
+}
+
+TEST(TaskSourceTests, WakeUpRangeCoversLeeway) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = fml::TimePoint::Now();
+  const auto leeway = fml::TimeDelta::FromMilliseconds(10);
+  task_source.RegisterTask({1, [] {}, time_stamp, TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal, fml::TimePoint::Max(),
+                            leeway});
+  auto range = task_source.GetWakeUpRange();
+  ASSERT_EQ(range.earliest, time_stamp);
+  ASSERT_EQ(range.latest, time_stamp + leeway);
+
+  // A task without leeway in another heap caps the range.
+  const auto precise_time = time_stamp + fml::TimeDelta::FromMilliseconds(4);
+  task_source.RegisterTask({2, [] {}, precise_time,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kUserInput});
+  range = task_source.GetWakeUpRange();
+  ASSERT_EQ(range.earliest, time_stamp);
+  ASSERT_EQ(range.latest, precise_time);
+}
+
+TEST(TaskSourceTests, WakeUpRangeCoversLaterTasksOfTheSameHeap) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = fml::TimePoint::Now();
+  task_source.RegisterTask({1, [] {}, time_stamp, TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal, fml::TimePoint::Max(),
+                            fml::TimeDelta::FromMilliseconds(10)});
+  // Queued behind the first task, but due before the first task's leeway
+  // runs out.
+  const auto precise_time = time_stamp + fml::TimeDelta::FromMilliseconds(4);
+  task_source.RegisterTask({2, [] {}, precise_time,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal});
+  auto range = task_source.GetWakeUpRange();
+  ASSERT_EQ(range.earliest, time_stamp);
+  ASSERT_EQ(range.latest, precise_time);
+
+  task_source.PopTask(TaskSourceGrade::kUnspecified);
+  range = task_source.GetWakeUpRange();
+  ASSERT_EQ(range.earliest, precise_time);
+  ASSERT_EQ(range.latest, precise_time);
+}
+
+TEST(TaskSourceTests, LeewayDoesNotOverflow) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  task_source.RegisterTask({1, [] {}, fml::TimePoint::Max(),
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal, fml::TimePoint::Max(),
+                            fml::TimeDelta::FromSeconds(1)});
+  ASSERT_EQ(task_source.GetWakeUpRange().latest, fml::TimePoint::Max());
+}
+
 }  // namespace testing
 }  // namespace fml
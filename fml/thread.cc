@@ -6,34 +6,110 @@
 
 #include "flutter/fml/thread.h"
 
+#include <algorithm>
+#include <climits>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/perfetto_trace_writer.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 
 #if defined(OS_WIN)
 #include <windows.h>
 #elif defined(OS_FUCHSIA)
 #include <lib/zx/thread.h>
+#include <pthread.h>
 #else
 #include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sys/syscall.h>
 #endif
 
 namespace fml {
 
-Thread::Thread(const std::string& name) : joined_(false) {
+#if defined(OS_WIN)
+
+class Thread::ThreadHandle {
+ public:
+  ThreadHandle(std::function<void()> function, size_t stack_size)
+      : thread_(std::move(function)) {
+    if (stack_size != 0) {
+      FML_DLOG(INFO) << "Setting the stack size of a thread is not supported "
+                        "on this platform.";
+    }
+  }
+
+  void Join() { thread_.join(); }
+
+ private:
+  std::thread thread_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadHandle);
+};
+
+#else
+
+class Thread::ThreadHandle {
+ public:
+  ThreadHandle(std::function<void()> function, size_t stack_size) {
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    if (stack_size != 0) {
+      stack_size = std::max<size_t>(stack_size, PTHREAD_STACK_MIN);
+      if (pthread_attr_setstacksize(&attributes, stack_size) != 0) {
+        FML_LOG(ERROR) << "Could not set the stack size of a thread to "
+                       << stack_size << " bytes.";
+      }
+    }
+    auto* start = new std::function<void()>(std::move(function));
+    FML_CHECK(pthread_create(&thread_, &attributes, &ThreadHandle::Start,
+                             start) == 0);
+    pthread_attr_destroy(&attributes);
+  }
+
+  void Join() { pthread_join(thread_, nullptr); }
+
+ private:
+  pthread_t thread_;
+
+  static void* Start(void* arg) {
+    std::unique_ptr<std::function<void()>> function(
+        static_cast<std::function<void()>*>(arg));
+    (*function)();
+    return nullptr;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadHandle);
+};
+
+#endif  // defined(OS_WIN)
+
+Thread::Thread(const std::string& name) : Thread(ThreadConfig{.name = name}) {}
+
+Thread::Thread(const ThreadConfig& config) : joined_(false) {
   fml::AutoResetWaitableEvent latch;
   fml::RefPtr<fml::TaskRunner> runner;
-  thread_ = std::make_unique<std::thread>([&latch, &runner, name]() -> void {
-    SetCurrentThreadName(name);
-    fml::MessageLoop::EnsureInitializedForCurrentThread();
-    auto& loop = MessageLoop::GetCurrent();
-    runner = loop.GetTaskRunner();
-    latch.Signal();
-    loop.Run();
-  });
+  thread_ = std::make_unique<ThreadHandle>(
+      [&latch, &runner, config]() -> void {
+        ApplyConfigToCurrentThread(config);
+        if (config.on_start) {
+          config.on_start();
+        }
+        fml::MessageLoop::EnsureInitializedForCurrentThread();
+        auto& loop = MessageLoop::GetCurrent();
+        runner = loop.GetTaskRunner();
+        latch.Signal();
+        loop.Run();
+      },
+      config.stack_size);
   latch.Wait();
   task_runner_ = runner;
 }
@@ -52,7 +128,7 @@ void Thread::Join() {
   }
   joined_ = true;
   task_runner_->PostTask([]() { MessageLoop::GetCurrent().Terminate(); });
-  thread_->join();
+  thread_->Join();
 }
 
 #if defined(OS_WIN)
@@ -71,6 +147,7 @@ void Thread::SetCurrentThreadName(const std::string& name) {
   if (name == "") {
     return;
   }
+  tracing::PerfettoTraceSetCurrentThreadName(name);
 #if defined(OS_MACOSX)
   pthread_setname_np(name.c_str());
 #elif defined(OS_LINUX) || defined(OS_ANDROID)
@@ -94,4 +171,94 @@ void Thread::SetCurrentThreadName(const std::string& name) {
 #endif
 }
 
+bool Thread::SetCurrentThreadPriority(ThreadPriority priority) {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  if (priority == ThreadPriority::kRealtime) {
+    // Round-robin, so that realtime threads of the same priority that share
+    // a core still take turns.
+    sched_param param = {};
+    param.sched_priority = sched_get_priority_min(SCHED_RR);
+    if (pthread_setschedparam(pthread_self(), SCHED_RR, &param) == 0) {
+      return true;
+    }
+    FML_LOG(INFO) << "Realtime scheduling is not permitted, falling back to "
+                     "the raster thread priority.";
+    priority = ThreadPriority::kRaster;
+  }
+  // The nice values are the ones Android uses for its own threads. Android
+  // describes -8 as "most important display threads, for compositing the
+  // screen and retrieving input events", so the raster thread is
+  // conservatively set to slightly lower priority than that.
+  const pid_t thread_id = static_cast<pid_t>(::syscall(SYS_gettid));
+  switch (priority) {
+    case ThreadPriority::kBackground:
+      return ::setpriority(PRIO_PROCESS, thread_id, 1) == 0;
+    case ThreadPriority::kNormal:
+      return ::setpriority(PRIO_PROCESS, thread_id, 0) == 0;
+    case ThreadPriority::kDisplay:
+      return ::setpriority(PRIO_PROCESS, thread_id, -1) == 0;
+    case ThreadPriority::kRaster:
+    case ThreadPriority::kRealtime:
+      // Depending on the OEM, it may not be possible to set priority to -5.
+      return ::setpriority(PRIO_PROCESS, thread_id, -5) == 0 ||
+             ::setpriority(PRIO_PROCESS, thread_id, -2) == 0;
+  }
+  return false;
+#elif defined(OS_MACOSX)
+  qos_class_t qos_class = QOS_CLASS_DEFAULT;
+  switch (priority) {
+    case ThreadPriority::kBackground:
+      qos_class = QOS_CLASS_UTILITY;
+      break;
+    case ThreadPriority::kNormal:
+      qos_class = QOS_CLASS_DEFAULT;
+      break;
+    case ThreadPriority::kDisplay:
+    case ThreadPriority::kRaster:
+    case ThreadPriority::kRealtime:
+      qos_class = QOS_CLASS_USER_INTERACTIVE;
+      break;
+  }
+  return pthread_set_qos_class_self_np(qos_class, 0) == 0;
+#elif defined(OS_WIN)
+  int thread_priority = THREAD_PRIORITY_NORMAL;
+  switch (priority) {
+    case ThreadPriority::kBackground:
+      thread_priority = THREAD_PRIORITY_BELOW_NORMAL;
+      break;
+    case ThreadPriority::kNormal:
+      thread_priority = THREAD_PRIORITY_NORMAL;
+      break;
+    case ThreadPriority::kDisplay:
+      thread_priority = THREAD_PRIORITY_ABOVE_NORMAL;
+      break;
+    case ThreadPriority::kRaster:
+      thread_priority = THREAD_PRIORITY_HIGHEST;
+      break;
+    case ThreadPriority::kRealtime:
+      thread_priority = THREAD_PRIORITY_TIME_CRITICAL;
+      break;
+  }
+  return ::SetThreadPriority(::GetCurrentThread(), thread_priority) != 0;
+#else
+  FML_DLOG(INFO) << "Could not set the thread priority on this platform.";
+  return false;
+#endif
+}
+
+void Thread::ApplyConfigToCurrentThread(const ThreadConfig& config) {
+  SetCurrentThreadName(config.name);
+  if (config.priority != ThreadPriority::kNormal &&
+      !SetCurrentThreadPriority(config.priority)) {
+    FML_LOG(ERROR) << "Failed to set the priority of thread '" << config.name
+                   << "'.";
+  }
+  if (config.cpu_mask != 0) {
+    SetCurrentThreadAffinityMask(config.cpu_mask);
+  } else if (!SetCurrentThreadAffinity(config.affinity)) {
+    FML_DLOG(INFO) << "Could not set the CPU affinity of thread '"
+                   << config.name << "'.";
+  }
+}
+
 }  // namespace fml
@@ -6,9 +6,12 @@
 #define FLUTTER_FML_THREAD_H_
 
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <string>
 #include <thread>
 
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 
@@ -16,8 +19,43 @@ namespace fml {
 
 class Thread {
  public:
+  /// The scheduling priority of a thread, from lowest to highest.
+  enum class ThreadPriority {
+    /// For threads whose work is not on the critical path of a frame, such as
+    /// the IO thread.
+    kBackground,
+    /// The priority threads are created with.
+    kNormal,
+    /// For threads that produce frames, such as the UI thread.
+    kDisplay,
+    /// For threads that put frames on screen, such as the raster thread.
+    kRaster,
+    /// Realtime scheduling, where the platform permits it. Falls back to
+    /// |ThreadPriority::kRaster| otherwise.
+    kRealtime,
+  };
+
+  /// How a thread is created and scheduled.
+  struct ThreadConfig {
+    std::string name;
+    ThreadPriority priority = ThreadPriority::kNormal;
+    /// The kind of cores the thread runs on. Ignored if |cpu_mask| is set.
+    CpuAffinity affinity = CpuAffinity::kAny;
+    /// The cores the thread runs on, where bit N stands for core N. The
+    /// thread may run on any core if this is 0.
+    uint64_t cpu_mask = 0;
+    /// The size of the stack of the thread in bytes, or 0 for the default
+    /// size of the platform. Not supported on Windows.
+    size_t stack_size = 0;
+    /// Invoked on the thread once the rest of the configuration is applied,
+    /// before the thread runs any tasks.
+    std::function<void()> on_start;
+  };
+
   explicit Thread(const std::string& name = "");
 
+  explicit Thread(const ThreadConfig& config);
+
   ~Thread();
 
   fml::RefPtr<fml::TaskRunner> GetTaskRunner() const;
@@ -26,8 +64,25 @@ class Thread {
 
   static void SetCurrentThreadName(const std::string& name);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the scheduling priority of the current thread.
+  ///
+  /// @return     Whether the priority, or the fallback for
+  ///             |ThreadPriority::kRealtime|, could be applied.
+  ///
+  static bool SetCurrentThreadPriority(ThreadPriority priority);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Applies the name, priority and affinity of a configuration to
+  ///             the current thread. The stack size can only be set when a
+  ///             thread is created.
+  ///
+  static void ApplyConfigToCurrentThread(const ThreadConfig& config);
+
  private:
-  std::unique_ptr<std::thread> thread_;
+  class ThreadHandle;
+
+  std::unique_ptr<ThreadHandle> thread_;
   fml::RefPtr<fml::TaskRunner> task_runner_;
   std::atomic_bool joined_;
 
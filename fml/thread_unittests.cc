@@ -24,3 +24,42 @@ TEST(Thread, HasARunningMessageLoop) {
   thread.Join();
   ASSERT_TRUE(done);
 }
+
+TEST(Thread, CanStartWithConfig) {
+  fml::Thread::ThreadConfig config;
+  config.name = "io";
+  config.priority = fml::Thread::ThreadPriority::kBackground;
+  config.stack_size = 1024 * 1024;
+  fml::Thread thread(config);
+  bool done = false;
+  thread.GetTaskRunner()->PostTask([&done]() { done = true; });
+  thread.Join();
+  ASSERT_TRUE(done);
+}
+
+TEST(Thread, InvokesOnStartOnTheThreadBeforeTasks) {
+  fml::Thread::ThreadConfig config;
+  std::thread::id start_thread_id;
+  config.on_start = [&start_thread_id]() {
+    start_thread_id = std::this_thread::get_id();
+  };
+  fml::Thread thread(config);
+  std::thread::id task_thread_id;
+  thread.GetTaskRunner()->PostTask([&task_thread_id]() {
+    task_thread_id = std::this_thread::get_id();
+  });
+  thread.Join();
+  ASSERT_NE(start_thread_id, std::thread::id());
+  ASSERT_NE(start_thread_id, std::this_thread::get_id());
+  ASSERT_EQ(start_thread_id, task_thread_id);
+}
+
+TEST(Thread, RealtimePriorityFallsBack) {
+  fml::Thread::ThreadConfig config;
+  config.priority = fml::Thread::ThreadPriority::kRealtime;
+  fml::Thread thread(config);
+  bool done = false;
+  thread.GetTaskRunner()->PostTask([&done]() { done = true; });
+  thread.Join();
+  ASSERT_TRUE(done);
+}
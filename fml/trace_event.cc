@@ -10,7 +10,9 @@
 
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/flight_recorder.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/perfetto_trace_writer.h"
 
 namespace fml {
 namespace tracing {
@@ -28,6 +30,9 @@ inline void FlutterTimelineEvent(const char* label,
                                  intptr_t argument_count,
                                  const char** argument_names,
                                  const char** argument_values) {
+  FlightRecorderRecord(label, timestamp0, timestamp1_or_async_id, type);
+  PerfettoTraceRecord(label, timestamp0, timestamp1_or_async_id, type,
+                      argument_count, argument_names, argument_values);
   if (gTimelineEventHandler && gAllowlist.Query(label)) {
     gTimelineEventHandler(label, timestamp0, timestamp1_or_async_id, type,
                           argument_count, argument_names, argument_values);
@@ -291,6 +296,17 @@ void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
 
 #else  // FLUTTER_TIMELINE_ENABLED
 
+namespace {
+// There is no timeline to trace to, but the flight recorder still is.
+inline void RecordEvent(const char* name,
+                        int64_t id,
+                        Dart_Timeline_Event_Type type) {
+  FlightRecorderRecord(name,
+                       fml::TimePoint::Now().ToEpochDelta().ToMicroseconds(),
+                       id, type);
+}
+}  // namespace
+
 void TraceSetAllowlist(const std::vector<std::string>& allowlist) {}
 
 void TraceSetTimelineEventHandler(TimelineEventHandler handler) {}
@@ -305,30 +321,42 @@ void TraceTimelineEvent(TraceArg category_group,
                         TraceIDArg identifier,
                         Dart_Timeline_Event_Type type,
                         const std::vector<const char*>& c_names,
-                        const std::vector<std::string>& values) {}
+                        const std::vector<std::string>& values) {
+  FlightRecorderRecord(name, timestamp_micros, identifier, type);
+}
 
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         TraceIDArg identifier,
                         Dart_Timeline_Event_Type type,
                         const std::vector<const char*>& c_names,
-                        const std::vector<std::string>& values) {}
+                        const std::vector<std::string>& values) {
+  RecordEvent(name, identifier, type);
+}
 
-void TraceEvent0(TraceArg category_group, TraceArg name) {}
+void TraceEvent0(TraceArg category_group, TraceArg name) {
+  RecordEvent(name, 0, Dart_Timeline_Event_Begin);
+}
 
 void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
-                 TraceArg arg1_val) {}
+                 TraceArg arg1_val) {
+  RecordEvent(name, 0, Dart_Timeline_Event_Begin);
+}
 
 void TraceEvent2(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
-                 TraceArg arg2_val) {}
+                 TraceArg arg2_val) {
+  RecordEvent(name, 0, Dart_Timeline_Event_Begin);
+}
 
-void TraceEventEnd(TraceArg name) {}
+void TraceEventEnd(TraceArg name) {
+  RecordEvent(name, 0, Dart_Timeline_Event_End);
+}
 
 void TraceEventAsyncComplete(TraceArg category_group,
                              TraceArg name,
@@ -337,47 +365,66 @@ void TraceEventAsyncComplete(TraceArg category_group,
 
 void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceArg name,
-                           TraceIDArg id) {}
+                           TraceIDArg id) {
+  RecordEvent(name, id, Dart_Timeline_Event_Async_Begin);
+}
 
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
-                         TraceIDArg id) {}
+                         TraceIDArg id) {
+  RecordEvent(name, id, Dart_Timeline_Event_Async_End);
+}
 
 void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceArg name,
                            TraceIDArg id,
                            TraceArg arg1_name,
-                           TraceArg arg1_val) {}
+                           TraceArg arg1_val) {
+  RecordEvent(name, id, Dart_Timeline_Event_Async_Begin);
+}
 
 void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id,
                          TraceArg arg1_name,
-                         TraceArg arg1_val) {}
+                         TraceArg arg1_val) {
+  RecordEvent(name, id, Dart_Timeline_Event_Async_End);
+}
 
-void TraceEventInstant0(TraceArg category_group, TraceArg name) {}
+void TraceEventInstant0(TraceArg category_group, TraceArg name) {
+  RecordEvent(name, 0, Dart_Timeline_Event_Instant);
+}
 
 void TraceEventInstant1(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
-                        TraceArg arg1_val) {}
+                        TraceArg arg1_val) {
+  RecordEvent(name, 0, Dart_Timeline_Event_Instant);
+}
 
 void TraceEventInstant2(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
                         TraceArg arg1_val,
                         TraceArg arg2_name,
-                        TraceArg arg2_val) {}
+                        TraceArg arg2_val) {
+  RecordEvent(name, 0, Dart_Timeline_Event_Instant);
+}
 
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
-                          TraceIDArg id) {}
+                          TraceIDArg id) {
+  RecordEvent(name, id, Dart_Timeline_Event_Flow_Begin);
+}
 
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
-                         TraceIDArg id) {}
+                         TraceIDArg id) {
+  RecordEvent(name, id, Dart_Timeline_Event_Flow_Step);
+}
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
+  RecordEvent(name, id, Dart_Timeline_Event_Flow_End);
 }
 
 #endif  // FLUTTER_TIMELINE_ENABLED
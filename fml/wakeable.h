@@ -14,6 +14,15 @@ class Wakeable {
   virtual ~Wakeable() {}
 
   virtual void WakeUp(fml::TimePoint time_point) = 0;
+
+  // Wakes up at some time from |time_point| to |time_point| + |leeway|.
+  // Platforms that can coalesce timers override this to let the system pick
+  // the time, otherwise this wakes up as late as allowed so that more tasks
+  // are due by then.
+  virtual void WakeUpWithLeeway(fml::TimePoint time_point,
+                                fml::TimeDelta leeway) {
+    WakeUp(time_point + leeway);
+  }
 };
 
 }  // namespace fml
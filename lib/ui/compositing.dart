@@ -671,7 +671,11 @@ class SceneBuilder extends NativeFieldWrapperClass2 {
   ///  - 0x02: visualizeRasterizerStatistics - graph raster thread frame times
   ///  - 0x04: displayEngineStatistics - show UI thread frame time
   ///  - 0x08: visualizeEngineStatistics - graph UI thread frame times
-  /// Set enabledOptions to 0x0F to enable all the currently defined features.
+  ///  - 0x10: displayFrameStatistics - show the raster cache hit rate and size,
+  ///    the GPU resource usage, the objects pending release, the frames in
+  ///    flight, the number of saveLayers per frame and the fraction of the
+  ///    frame that is repainted, averaged over 30 frames
+  /// Set enabledOptions to 0x1F to enable all the currently defined features.
   ///
   /// The "UI thread" is the thread that includes all the execution of the main
   /// Dart isolate (the isolate that can call [FlutterView.render]). The UI
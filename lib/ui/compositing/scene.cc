@@ -42,10 +42,11 @@ Scene::Scene(std::shared_ptr<flutter::Layer> rootLayer,
              uint32_t rasterizerTracingThreshold,
              bool checkerboardRasterCacheImages,
              bool checkerboardOffscreenLayers) {
-  // Currently only supports a single window.
+  // The tree is sized for the implicit view. It is moved to another view when
+  // it is rendered into that view.
   auto viewport_metrics = UIDartState::Current()
                               ->platform_configuration()
-                              ->get_window(0)
+                              ->get_window(kFlutterImplicitViewId)
                               ->viewport_metrics();
 
   layer_tree_ = std::make_unique<LayerTree>(
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_arena.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/color_filter.h"
@@ -138,10 +139,15 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
   SceneBuilder();
 
   void AddLayer(std::shared_ptr<Layer> layer);
-  void PushLayer(std::shared_ptr<ContainerLayer> layer);
+  void PushLayer(const std::shared_ptr<ContainerLayer>& layer);
   void PopLayer();
 
-  std::vector<std::shared_ptr<ContainerLayer>> layer_stack_;
+  // The layers of the scene are allocated from here, which they may outlive.
+  LayerArena arena_;
+  std::shared_ptr<ContainerLayer> root_layer_;
+  // Owned by |root_layer_|, so that pushing and popping layers does not touch
+  // their reference counts.
+  std::vector<ContainerLayer*> layer_stack_;
   int rasterizer_tracing_threshold_ = 0;
   bool checkerboard_raster_cache_images_ = false;
   bool checkerboard_offscreen_layers_ = false;
@@ -57,6 +57,42 @@ void frameCallback(FrameInfo info) {
 @pragma('vm:entry-point')
 void messageCallback(dynamic data) {}
 
+const int _kDrawnRectCount = 1000;
+
+@pragma('vm:entry-point')
+void drawRects() {
+  final Canvas canvas = Canvas(PictureRecorder());
+  final Paint paint = Paint();
+  for (int i = 0; i < _kDrawnRectCount; i++) {
+    canvas.drawRect(Rect.fromLTWH(i.toDouble(), 0, 10, 10), paint);
+  }
+}
+
+final DrawBatch _batch = DrawBatch();
+
+@pragma('vm:entry-point')
+void drawBatchedRects() {
+  final Canvas canvas = Canvas(PictureRecorder());
+  _batch.clear();
+  for (int i = 0; i < _kDrawnRectCount; i++) {
+    _batch.drawRect(Rect.fromLTWH(i.toDouble(), 0, 10, 10));
+  }
+  canvas.drawBatch(_batch, Paint());
+}
+
+const int _kPathSegmentCount = 1000;
+
+@pragma('vm:entry-point')
+void buildPaths() {
+  final Path path = Path();
+  path.moveTo(0.0, 0.0);
+  for (int i = 0; i < _kPathSegmentCount; i++) {
+    final double x = i.toDouble();
+    path.lineTo(x, 10.0);
+    path.cubicTo(x, 0.0, x + 0.5, 10.0, x + 1.0, 0.0);
+  }
+}
+
 @pragma('vm:entry-point')
 void validateConfiguration() native 'ValidateConfiguration';
 
@@ -11,6 +11,9 @@
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
+
+class TextureUploadQueue;
+
 // Interface for methods that manage access to the resource GrDirectContext and
 // Skia unref queue.  Meant to be implemented by the owner of the resource
 // GrDirectContext, i.e. the shell's IOManager.
@@ -26,6 +29,10 @@ class IOManager {
 
   virtual std::shared_ptr<const fml::SyncSwitch>
   GetIsGpuDisabledSyncSwitch() = 0;
+
+  // The queue that texture uploads to the resource context go through, or
+  // nullptr to upload right away. Only used on the IO thread.
+  virtual TextureUploadQueue* GetTextureUploadQueue() { return nullptr; }
 };
 
 }  // namespace flutter
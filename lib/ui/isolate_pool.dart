@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+
+// @dart = 2.12
+part of dart.ui;
+
+/// The prefix of the names that the pooled isolates register their
+/// [SendPort]s with in the [IsolateNameServer], followed by their index.
+const String _kIsolatePoolPortNamePrefix = 'flutter.isolate_pool.';
+
+/// A pool of background isolates that the engine spawns ahead of time, in the
+/// same isolate group as the root isolate.
+///
+/// Spawning an isolate for every piece of background work, such as decoding a
+/// large JSON response, pays for creating and setting up the isolate each
+/// time. The isolates in this pool are spawned once, when the root isolate
+/// starts, and are then checked out with [checkout] and returned with
+/// [PooledIsolate.release], or used for a single callback with [run].
+///
+/// The number of isolates in the pool is configured by the embedder, and is
+/// zero unless it asks for a pool. Each pooled isolate registers the
+/// [SendPort] it receives work on with the [IsolateNameServer], under the name
+/// `flutter.isolate_pool.<index>`.
+class IsolatePool {
+  // This class is only a namespace, and should not be instantiated or
+  // extended directly.
+  factory IsolatePool._() => throw UnsupportedError('Namespace');
+
+  /// The number of isolates in the pool, or zero if there is no pool.
+  static int get size => _size;
+  static int _size = 0;
+
+  static final List<PooledIsolate> _idle = <PooledIsolate>[];
+  static final List<Completer<PooledIsolate>> _waiting =
+      <Completer<PooledIsolate>>[];
+
+  /// Checks out an isolate of the pool for the exclusive use of the caller
+  /// until it calls [PooledIsolate.release].
+  ///
+  /// The returned future completes once an isolate is idle, which may be when
+  /// one is spawned or returned to the pool.
+  ///
+  /// Throws a [StateError] if there is no pool.
+  static Future<PooledIsolate> checkout() {
+    if (_size == 0) {
+      throw StateError('The engine was not configured with an isolate pool.');
+    }
+    if (_idle.isNotEmpty) {
+      return Future<PooledIsolate>.value(_idle.removeLast());
+    }
+    final Completer<PooledIsolate> completer = Completer<PooledIsolate>();
+    _waiting.add(completer);
+    return completer.future;
+  }
+
+  /// Runs `callback(message)` on an isolate of the pool and returns its
+  /// result, checking the isolate out for as long as it runs.
+  ///
+  /// The callback, the message and the result are passed between isolates of
+  /// the same group, so they may be any objects that [SendPort.send] accepts
+  /// within a group, including closures.
+  static Future<R> run<Q, R>(FutureOr<R> Function(Q message) callback,
+      Q message) async {
+    final PooledIsolate isolate = await checkout();
+    try {
+      return await isolate.run<Q, R>(callback, message);
+    } finally {
+      isolate.release();
+    }
+  }
+
+  static void _addIdle(PooledIsolate isolate) {
+    if (_waiting.isNotEmpty) {
+      _waiting.removeAt(0).complete(isolate);
+    } else {
+      _idle.add(isolate);
+    }
+  }
+}
+
+/// An isolate of the [IsolatePool] that was checked out with
+/// [IsolatePool.checkout].
+class PooledIsolate {
+  PooledIsolate._(this._sendPort);
+
+  final SendPort _sendPort;
+  bool _released = false;
+
+  /// Runs `callback(message)` on this isolate and returns its result.
+  ///
+  /// Errors that the callback throws are rethrown as [RemoteError]s.
+  Future<R> run<Q, R>(FutureOr<R> Function(Q message) callback, Q message) {
+    assert(!_released, 'The isolate was already returned to the pool.');
+    final Completer<R> completer = Completer<R>();
+    final RawReceivePort port = RawReceivePort();
+    port.handler = (Object? response) {
+      port.close();
+      final List<Object?> result = response! as List<Object?>;
+      if (result.length == 1) {
+        completer.complete(result[0] as R);
+      } else {
+        completer.completeError(
+            RemoteError(result[0]! as String, result[1]! as String));
+      }
+    };
+    try {
+      _sendPort.send(<Object?>[callback, message, port.sendPort]);
+    } catch (error, stackTrace) {
+      port.close();
+      completer.completeError(error, stackTrace);
+    }
+    return completer.future;
+  }
+
+  /// Returns this isolate to the pool. It must not be used afterwards.
+  void release() {
+    assert(!_released, 'The isolate was already returned to the pool.');
+    _released = true;
+    IsolatePool._addIdle(PooledIsolate._(_sendPort));
+  }
+}
+
+/// Called by the engine before the main entrypoint of the root isolate runs,
+/// if it was configured with an isolate pool.
+@pragma('vm:entry-point')
+void _startIsolatePool(int size) {
+  IsolatePool._size = size;
+  for (int index = 0; index < size; index++) {
+    final RawReceivePort ready = RawReceivePort();
+    ready.handler = (Object? sendPort) {
+      ready.close();
+      IsolatePool._addIdle(PooledIsolate._(sendPort! as SendPort));
+    };
+    Isolate.spawn<List<Object?>>(
+      _isolatePoolMain,
+      <Object?>['$_kIsolatePoolPortNamePrefix$index', ready.sendPort],
+      debugName: 'IsolatePool $index',
+    ).catchError((Object error) {
+      ready.close();
+      print('Could not spawn a pooled isolate: $error');
+      return Isolate.current;
+    });
+  }
+}
+
+void _isolatePoolMain(List<Object?> arguments) {
+  final String name = arguments[0]! as String;
+  final SendPort ready = arguments[1]! as SendPort;
+  final RawReceivePort port = RawReceivePort(_handleIsolatePoolRequest);
+  IsolateNameServer.removePortNameMapping(name);
+  IsolateNameServer.registerPortWithName(port.sendPort, name);
+  ready.send(port.sendPort);
+}
+
+Future<void> _handleIsolatePoolRequest(Object? message) async {
+  final List<Object?> request = message! as List<Object?>;
+  final Function callback = request[0]! as Function;
+  final SendPort reply = request[2]! as SendPort;
+  try {
+    // ignore: avoid_dynamic_calls
+    final Object? result = await callback(request[1]);
+    reply.send(<Object?>[result]);
+  } catch (error, stackTrace) {
+    reply.send(<Object?>[error.toString(), stackTrace.toString()]);
+  }
+}
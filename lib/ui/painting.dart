@@ -1602,6 +1602,33 @@ enum ImageByteFormat {
   ///  * <https://en.wikipedia.org/wiki/Portable_Network_Graphics>, the Wikipedia page on PNG.
   ///  * <https://tools.ietf.org/rfc/rfc2083.txt>, the PNG standard.
   png,
+
+  /// JPEG format.
+  ///
+  /// A lossy compression format for images, well suited for photographs.
+  /// Transparency is not supported, and transparent pixels are encoded as if
+  /// they were drawn over black.
+  ///
+  /// JPEG images normally use the `.jpg` file extension and the `image/jpeg`
+  /// MIME type.
+  ///
+  /// See also:
+  ///
+  ///  * <https://en.wikipedia.org/wiki/JPEG>, the Wikipedia page on JPEG.
+  jpeg,
+
+  /// WebP format.
+  ///
+  /// A lossy compression format for images that supports transparency, and
+  /// that is usually smaller than JPEG at the same quality.
+  ///
+  /// WebP images normally use the `.webp` file extension and the `image/webp`
+  /// MIME type.
+  ///
+  /// See also:
+  ///
+  ///  * <https://developers.google.com/speed/webp>, the WebP documentation.
+  webp,
 }
 
 /// The format of pixel data given to [decodeImageFromPixels].
@@ -1708,11 +1735,25 @@ class Image {
   /// The [format] argument specifies the format in which the bytes will be
   /// returned.
   ///
+  /// The [quality] argument trades the size of the encoded image for its
+  /// quality or for the time it takes to encode. For [ImageByteFormat.jpeg]
+  /// and [ImageByteFormat.webp] it is from 0 to 100, where higher is better
+  /// and larger, and defaults to 90. For [ImageByteFormat.png] it is the zlib
+  /// compression level from 0 to 9, where higher is smaller and slower, and
+  /// defaults to 6. It is ignored by the raw formats.
+  ///
+  /// The image is encoded on a background thread, so several images can be
+  /// encoded at the same time. Platforms may encode with a hardware encoder.
+  ///
   /// Returns a future that completes with the binary image data or an error
   /// if encoding fails.
-  Future<ByteData?> toByteData({ImageByteFormat format = ImageByteFormat.rawRgba}) {
+  Future<ByteData?> toByteData({
+    ImageByteFormat format = ImageByteFormat.rawRgba,
+    int? quality,
+  }) {
     assert(!_disposed && !_image._disposed);
-    return _image.toByteData(format: format);
+    assert(quality == null || (quality >= 0 && quality <= 100));
+    return _image.toByteData(format: format, quality: quality);
   }
 
   /// If asserts are enabled, returns the [StackTrace]s of each open handle from
@@ -1844,16 +1885,19 @@ class _Image extends NativeFieldWrapperClass2 {
 
   int get height native 'Image_height';
 
-  Future<ByteData?> toByteData({ImageByteFormat format = ImageByteFormat.rawRgba}) {
+  Future<ByteData?> toByteData({
+    ImageByteFormat format = ImageByteFormat.rawRgba,
+    int? quality,
+  }) {
     return _futurize((_Callback<ByteData> callback) {
-      return _toByteData(format.index, (Uint8List? encoded) {
+      return _toByteData(format.index, quality ?? -1, (Uint8List? encoded) {
         callback(encoded!.buffer.asByteData());
       });
     });
   }
 
   /// Returns an error message on failure, null on success.
-  String? _toByteData(int format, _Callback<Uint8List?> callback) native 'Image_toByteData';
+  String? _toByteData(int format, int quality, _Callback<Uint8List?> callback) native 'Image_toByteData';
 
   bool _disposed = false;
   void dispose() {
@@ -2792,6 +2836,20 @@ class PathMetric {
     return _measure.getTangentForOffset(contourIndex, distance);
   }
 
+  /// Computes the positions of the current contour at each of the given
+  /// offsets, and the angles of the path at those points.
+  ///
+  /// This is equivalent to calling [getTangentForOffset] for every distance,
+  /// but is much cheaper when there are many distances, such as when placing
+  /// dashes or markers along a long path.
+  ///
+  /// Returns null if the contour has zero [length].
+  ///
+  /// The distances are clamped to the [length] of the current contour.
+  List<Tangent>? getTangentsForOffsets(List<double> distances) {
+    return _measure.getTangentsForOffsets(contourIndex, distances);
+  }
+
   /// Given a start and end distance, return the intervening segment(s).
   ///
   /// `start` and `end` are clamped to legal values (0..[length])
@@ -2831,6 +2889,25 @@ class _PathMeasure extends NativeFieldWrapperClass2 {
   }
   Float32List _getPosTan(int contourIndex, double distance) native 'PathMeasure_getPosTan';
 
+  List<Tangent>? getTangentsForOffsets(int contourIndex, List<double> distances) {
+    assert(contourIndex <= currentContourIndex, 'Iterator must be advanced before index $contourIndex can be used.');
+    final Float32List posTans = _getPosTans(
+      contourIndex,
+      distances is Float32List ? distances : Float32List.fromList(distances),
+    );
+    // an empty list indicates that Skia returned false
+    if (posTans.isEmpty && distances.isNotEmpty) {
+      return null;
+    }
+    return List<Tangent>.generate(distances.length, (int i) {
+      return Tangent(
+        Offset(posTans[i * 4], posTans[i * 4 + 1]),
+        Offset(posTans[i * 4 + 2], posTans[i * 4 + 3]),
+      );
+    });
+  }
+  Float32List _getPosTans(int contourIndex, Float32List distances) native 'PathMeasure_getPosTans';
+
   Path extractPath(int contourIndex, double start, double end, {bool startWithMoveTo = true}) {
     assert(contourIndex <= currentContourIndex, 'Iterator must be advanced before index $contourIndex can be used.');
     final Path path = Path._();
@@ -4471,6 +4548,26 @@ class Canvas extends NativeFieldWrapperClass2 {
                    int pointMode,
                    Float32List points) native 'Canvas_drawPoints';
 
+  /// Draws all the commands recorded in the given [DrawBatch], in order, with
+  /// the given [Paint].
+  ///
+  /// The commands are replayed with a single call into the engine, which makes
+  /// this cheaper than drawing many small shapes one at a time. Colors and
+  /// stroke widths set on the batch only apply to the commands recorded after
+  /// them, and do not change `paint`.
+  void drawBatch(DrawBatch batch, Paint paint) {
+    assert(batch != null);
+    assert(paint != null);
+    if (batch._length == 0)
+      return;
+    _drawBatch(paint._objects, paint._data,
+               Float32List.sublistView(batch._ops, 0, batch._length));
+  }
+
+  void _drawBatch(List<dynamic>? paintObjects,
+                  ByteData paintData,
+                  Float32List ops) native 'Canvas_drawBatch';
+
   /// Draws the set of [Vertices] onto the canvas.
   ///
   /// All parameters must not be null.
@@ -4865,6 +4962,114 @@ class Canvas extends NativeFieldWrapperClass2 {
                    bool transparentOccluder) native 'Canvas_drawShadow';
 }
 
+/// A list of simple drawing commands that are drawn together with
+/// [Canvas.drawBatch].
+///
+/// Drawing many small shapes, such as the points of a chart or the cells of a
+/// grid, one call at a time pays for a call into the engine for every shape.
+/// A batch records the shapes into a compact list instead, which the engine
+/// draws in one call. A batch can be drawn any number of times, and cleared
+/// with [clear] to record new commands.
+class DrawBatch {
+  /// Creates an empty batch.
+  DrawBatch() {
+    _setCapacity(64);
+  }
+
+  // These values must be kept in sync with DrawBatchOp in canvas.cc.
+  static const int _kRect = 0;
+  static const int _kOval = 1;
+  static const int _kLine = 2;
+  static const int _kCircle = 3;
+  static const int _kColor = 4;
+  static const int _kStrokeWidth = 5;
+
+  late Float32List _ops;
+  late Uint32List _words;
+  int _length = 0;
+
+  /// The number of values recorded in this batch so far, which grows with
+  /// the number and kind of the recorded commands.
+  int get length => _length;
+
+  void _setCapacity(int capacity) {
+    final Float32List ops = Float32List(capacity);
+    if (_length > 0)
+      ops.setRange(0, _length, _ops);
+    _ops = ops;
+    _words = Uint32List.view(ops.buffer);
+  }
+
+  void _reserve(int count) {
+    if (_length + count > _ops.length)
+      _setCapacity(math.max(_ops.length * 2, _length + count));
+  }
+
+  void _add4(int op, double a, double b, double c, double d) {
+    _reserve(5);
+    _ops[_length] = op.toDouble();
+    _ops[_length + 1] = a;
+    _ops[_length + 2] = b;
+    _ops[_length + 3] = c;
+    _ops[_length + 4] = d;
+    _length += 5;
+  }
+
+  /// Records a rectangle.
+  void drawRect(Rect rect) {
+    assert(_rectIsValid(rect));
+    _add4(_kRect, rect.left, rect.top, rect.right, rect.bottom);
+  }
+
+  /// Records an axis-aligned oval that fills the given rectangle.
+  void drawOval(Rect rect) {
+    assert(_rectIsValid(rect));
+    _add4(_kOval, rect.left, rect.top, rect.right, rect.bottom);
+  }
+
+  /// Records a line between the given points.
+  void drawLine(Offset p1, Offset p2) {
+    assert(_offsetIsValid(p1));
+    assert(_offsetIsValid(p2));
+    _add4(_kLine, p1.dx, p1.dy, p2.dx, p2.dy);
+  }
+
+  /// Records a circle centered at `c` with the given radius.
+  void drawCircle(Offset c, double radius) {
+    assert(_offsetIsValid(c));
+    _reserve(4);
+    _ops[_length] = _kCircle.toDouble();
+    _ops[_length + 1] = c.dx;
+    _ops[_length + 2] = c.dy;
+    _ops[_length + 3] = radius;
+    _length += 4;
+  }
+
+  /// Draws the commands recorded after this one with the given color instead
+  /// of the color of the [Paint] the batch is drawn with.
+  void setColor(Color color) {
+    assert(color != null);
+    _reserve(2);
+    _ops[_length] = _kColor.toDouble();
+    _words[_length + 1] = color.value;
+    _length += 2;
+  }
+
+  /// Draws the commands recorded after this one with the given stroke width
+  /// instead of the stroke width of the [Paint] the batch is drawn with.
+  void setStrokeWidth(double width) {
+    _reserve(2);
+    _ops[_length] = _kStrokeWidth.toDouble();
+    _ops[_length + 1] = width;
+    _length += 2;
+  }
+
+  /// Removes all the recorded commands, keeping the memory they used.
+  void clear() {
+    _length = 0;
+  }
+}
+
 /// An object representing a sequence of recorded graphical operations.
 ///
 /// To create a [Picture], use a [PictureRecorder].
@@ -5162,7 +5367,7 @@ class Shadow {
 
 /// A handle to a read-only byte buffer that is managed by the engine.
 class ImmutableBuffer extends NativeFieldWrapperClass2 {
-  ImmutableBuffer._(this.length);
+  ImmutableBuffer._(this._length);
 
   /// Creates a copy of the data from a [Uint8List] suitable for internal use
   /// in the engine.
@@ -5174,8 +5379,45 @@ class ImmutableBuffer extends NativeFieldWrapperClass2 {
   }
   void _init(Uint8List list, _Callback<void> callback) native 'ImmutableBuffer_init';
 
+  /// Creates an [ImmutableBuffer] from an asset of the application, given by
+  /// its key in the asset bundle.
+  ///
+  /// The asset is mapped into memory by the engine and is not copied into the
+  /// Dart heap, unlike loading it as a [Uint8List] and calling
+  /// [fromUint8List]. The returned future completes with an error if the asset
+  /// could not be loaded.
+  static Future<ImmutableBuffer> fromAsset(String assetKey) {
+    final ImmutableBuffer instance = ImmutableBuffer._(0);
+    return _futurize((_Callback<int> callback) {
+      return instance._initFromAsset(assetKey, callback);
+    }).then((int length) => instance._loaded(length, 'asset "$assetKey"'));
+  }
+  String? _initFromAsset(String assetKey, _Callback<int> callback) native 'ImmutableBuffer_initFromAsset';
+
+  /// Creates an [ImmutableBuffer] from the file at the given path.
+  ///
+  /// The file is mapped into memory by the engine and is not copied into the
+  /// Dart heap. The returned future completes with an error if the file could
+  /// not be mapped.
+  static Future<ImmutableBuffer> fromFilePath(String path) {
+    final ImmutableBuffer instance = ImmutableBuffer._(0);
+    return _futurize((_Callback<int> callback) {
+      return instance._initFromFile(path, callback);
+    }).then((int length) => instance._loaded(length, 'file "$path"'));
+  }
+  String? _initFromFile(String path, _Callback<int> callback) native 'ImmutableBuffer_initFromFile';
+
+  ImmutableBuffer _loaded(int length, String description) {
+    if (length == -1) {
+      throw Exception('Could not load the $description.');
+    }
+    _length = length;
+    return this;
+  }
+
   /// The length, in bytes, of the underlying data.
-  final int length;
+  int get length => _length;
+  int _length;
 
   /// Release the resources used by this object. The object is no longer usable
   /// after this method is called.
@@ -5256,7 +5498,28 @@ class ImageDescriptor extends NativeFieldWrapperClass2 {
   ///
   /// If either targetWidth or targetHeight is less than or equal to zero, it
   /// will be treated as if it is null.
-  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight}) async {
+  ///
+  /// If a [subset] is specified, only that region of the image, in pixels and
+  /// rounded out to whole pixels, is decoded and the target dimensions apply
+  /// to it. For formats that support it, such as JPEG, PNG and WebP, only the
+  /// part of the encoded data covering the subset is decoded, at a scale close
+  /// to the target dimensions, instead of the whole image. The subset is
+  /// ignored for animated images.
+  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight, Rect? subset}) async {
+    int subsetLeft = 0;
+    int subsetTop = 0;
+    int sourceWidth = width;
+    int sourceHeight = height;
+    if (subset != null) {
+      subsetLeft = math.max(subset.left.floor(), 0);
+      subsetTop = math.max(subset.top.floor(), 0);
+      sourceWidth = math.min(subset.right.ceil(), width) - subsetLeft;
+      sourceHeight = math.min(subset.bottom.ceil(), height) - subsetTop;
+      if (sourceWidth <= 0 || sourceHeight <= 0) {
+        throw ArgumentError.value(subset, 'subset', 'must overlap the image');
+      }
+    }
+
     if (targetWidth != null && targetWidth <= 0) {
       targetWidth = null;
     }
@@ -5265,23 +5528,27 @@ class ImageDescriptor extends NativeFieldWrapperClass2 {
     }
 
     if (targetWidth == null && targetHeight == null) {
-      targetWidth = width;
-      targetHeight = height;
+      targetWidth = sourceWidth;
+      targetHeight = sourceHeight;
     } else if (targetWidth == null && targetHeight != null) {
-      targetWidth = (targetHeight * (width / height)).round();
+      targetWidth = (targetHeight * (sourceWidth / sourceHeight)).round();
       targetHeight = targetHeight;
     } else if (targetHeight == null && targetWidth != null) {
       targetWidth = targetWidth;
-      targetHeight = targetWidth ~/ (width / height);
+      targetHeight = targetWidth ~/ (sourceWidth / sourceHeight);
     }
     assert(targetWidth != null);
     assert(targetHeight != null);
 
     final Codec codec = Codec._();
-    _instantiateCodec(codec, targetWidth!, targetHeight!);
+    if (subset == null) {
+      _instantiateCodec(codec, targetWidth!, targetHeight!, 0, 0, 0, 0);
+    } else {
+      _instantiateCodec(codec, targetWidth!, targetHeight!, subsetLeft, subsetTop, sourceWidth, sourceHeight);
+    }
     return codec;
   }
-  void _instantiateCodec(Codec outCodec, int targetWidth, int targetHeight) native 'ImageDescriptor_instantiateCodec';
+  void _instantiateCodec(Codec outCodec, int targetWidth, int targetHeight, int subsetLeft, int subsetTop, int subsetWidth, int subsetHeight) native 'ImageDescriptor_instantiateCodec';
 }
 
 /// Generic callback signature, used by [_futurize].
@@ -6,6 +6,7 @@
 #include "flutter/lib/ui/painting/image_filter.h"
 
 #include <cmath>
+#include <cstring>
 
 #include "flutter/flow/layers/physical_shape_layer.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -61,6 +62,7 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
   V(Canvas, drawImageNine)          \
   V(Canvas, drawPicture)            \
   V(Canvas, drawPoints)             \
+  V(Canvas, drawBatch)              \
   V(Canvas, drawVertices)           \
   V(Canvas, drawAtlas)              \
   V(Canvas, drawShadow)
@@ -198,6 +200,7 @@ void Canvas::clipPath(const CanvasPath* path, bool doAntiAlias) {
         ToDart("Canvas.clipPath called with non-genuine Path."));
     return;
   }
+  path->RecordDraw();
   canvas_->clipPath(path->path(), doAntiAlias);
 }
 
@@ -309,6 +312,7 @@ void Canvas::drawPath(const CanvasPath* path,
         ToDart("Canvas.drawPath called with non-genuine Path."));
     return;
   }
+  path->RecordDraw();
   canvas_->drawPath(path->path(), *paint.paint());
 }
 
@@ -396,6 +400,12 @@ void Canvas::drawPicture(Picture* picture) {
         ToDart("Canvas.drawPicture called with non-genuine Picture."));
     return;
   }
+  if (auto display_list = picture->display_list()) {
+    // The operations of the display list are recorded inline, like Skia
+    // does for small pictures.
+    display_list->RenderTo(canvas_);
+    return;
+  }
   canvas_->drawPicture(picture->picture().get());
 }
 
@@ -416,6 +426,96 @@ void Canvas::drawPoints(const Paint& paint,
                       *paint.paint());
 }
 
+namespace {
+
+// The commands recorded by a DrawBatch. These values must be kept in sync with
+// the constants of DrawBatch in painting.dart.
+enum class DrawBatchOp {
+  kRect = 0,
+  kOval = 1,
+  kLine = 2,
+  kCircle = 3,
+  kColor = 4,
+  kStrokeWidth = 5,
+};
+
+// The number of values that follow |op| in a batch, or zero if |op| is not
+// a command.
+size_t DrawBatchArgumentCount(float op) {
+  if (op == static_cast<float>(DrawBatchOp::kRect) ||
+      op == static_cast<float>(DrawBatchOp::kOval) ||
+      op == static_cast<float>(DrawBatchOp::kLine)) {
+    return 4;
+  }
+  if (op == static_cast<float>(DrawBatchOp::kCircle)) {
+    return 3;
+  }
+  if (op == static_cast<float>(DrawBatchOp::kColor) ||
+      op == static_cast<float>(DrawBatchOp::kStrokeWidth)) {
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+
+void Canvas::drawBatch(const Paint& paint,
+                       const PaintData& paint_data,
+                       const tonic::Float32List& ops) {
+  if (!canvas_) {
+    return;
+  }
+
+  // The paint is only copied once the batch changes its color or stroke width.
+  const SkPaint* batch_paint = paint.paint();
+  SkPaint modified_paint;
+  const float* values = ops.data();
+  const size_t count = ops.num_elements();
+  size_t i = 0;
+  while (i < count) {
+    const size_t arguments = DrawBatchArgumentCount(values[i]);
+    if (arguments == 0 || count - i - 1 < arguments) {
+      Dart_ThrowException(
+          ToDart("Canvas.drawBatch called with a malformed batch."));
+      return;
+    }
+    const DrawBatchOp op = static_cast<DrawBatchOp>(values[i]);
+    const float* args = values + i + 1;
+    switch (op) {
+      case DrawBatchOp::kRect:
+        canvas_->drawRect(SkRect::MakeLTRB(args[0], args[1], args[2], args[3]),
+                          *batch_paint);
+        break;
+      case DrawBatchOp::kOval:
+        canvas_->drawOval(SkRect::MakeLTRB(args[0], args[1], args[2], args[3]),
+                          *batch_paint);
+        break;
+      case DrawBatchOp::kLine:
+        canvas_->drawLine(args[0], args[1], args[2], args[3], *batch_paint);
+        break;
+      case DrawBatchOp::kCircle:
+        canvas_->drawCircle(args[0], args[1], args[2], *batch_paint);
+        break;
+      case DrawBatchOp::kColor:
+      case DrawBatchOp::kStrokeWidth:
+        if (batch_paint != &modified_paint) {
+          modified_paint = *batch_paint;
+          batch_paint = &modified_paint;
+        }
+        if (op == DrawBatchOp::kColor) {
+          // The color is stored as the bits of a 32 bit ARGB value.
+          SkColor color;
+          ::memcpy(&color, args, sizeof(color));
+          modified_paint.setColor(color);
+        } else {
+          modified_paint.setStrokeWidth(args[0]);
+        }
+        break;
+    }
+    i += arguments + 1;
+  }
+}
+
 void Canvas::drawVertices(const Vertices* vertices,
                           SkBlendMode blend_mode,
                           const Paint& paint,
@@ -482,6 +582,7 @@ void Canvas::drawShadow(const CanvasPath* path,
                      ->get_window(0)
                      ->viewport_metrics()
                      .device_pixel_ratio;
+  path->RecordDraw();
   flutter::PhysicalShapeLayer::DrawShadow(canvas_, path->path(), color,
                                           elevation, transparentOccluder, dpr);
 }
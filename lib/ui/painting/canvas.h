@@ -148,6 +148,10 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
                   SkCanvas::PointMode point_mode,
                   const tonic::Float32List& points);
 
+  void drawBatch(const Paint& paint,
+                 const PaintData& paint_data,
+                 const tonic::Float32List& ops);
+
   void drawVertices(const Vertices* vertices,
                     SkBlendMode blend_mode,
                     const Paint& paint,
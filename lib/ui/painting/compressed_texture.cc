@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/compressed_texture.h"
+
+#include <cstring>
+
+namespace flutter {
+
+namespace {
+
+// The KTX 1 file format, see
+// https://www.khronos.org/registry/KTX/specs/1.0/ktxspec_v1.html
+constexpr uint8_t kKTXIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31,
+                                        0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+constexpr uint32_t kKTXEndianness = 0x04030201;
+constexpr uint32_t kKTXSwappedEndianness = 0x01020304;
+
+// The fields of the header that follow the identifier.
+enum KTXHeaderField {
+  kEndianness,
+  kGLType,
+  kGLTypeSize,
+  kGLFormat,
+  kGLInternalFormat,
+  kGLBaseInternalFormat,
+  kPixelWidth,
+  kPixelHeight,
+  kPixelDepth,
+  kNumberOfArrayElements,
+  kNumberOfFaces,
+  kNumberOfMipmapLevels,
+  kBytesOfKeyValueData,
+  kHeaderFieldCount,
+};
+
+constexpr size_t kKTXHeaderSize =
+    sizeof(kKTXIdentifier) + kHeaderFieldCount * sizeof(uint32_t);
+
+// The GL internal formats of the compressed textures.
+constexpr uint32_t kGLCompressedRGBS3TCDXT1 = 0x83F0;
+constexpr uint32_t kGLCompressedRGBAS3TCDXT1 = 0x83F1;
+constexpr uint32_t kGLETC1RGB8 = 0x8D64;
+constexpr uint32_t kGLCompressedRGB8ETC2 = 0x9274;
+
+// All of the formats Skia can upload use 8 bytes per 4x4 block.
+constexpr size_t kBlockDimension = 4;
+constexpr size_t kBytesPerBlock = 8;
+
+uint32_t SwapBytes(uint32_t value) {
+  return ((value & 0xFF) << 24) | ((value & 0xFF00) << 8) |
+         ((value >> 8) & 0xFF00) | (value >> 24);
+}
+
+std::optional<SkImage::CompressionType> CompressionTypeForGLFormat(
+    uint32_t internal_format) {
+  switch (internal_format) {
+    // ETC2 decoders decode ETC1 as well, which it is a subset of.
+    case kGLETC1RGB8:
+    case kGLCompressedRGB8ETC2:
+      return SkImage::CompressionType::kETC2_RGB8_UNORM;
+    case kGLCompressedRGBS3TCDXT1:
+      return SkImage::CompressionType::kBC1_RGB8_UNORM;
+    case kGLCompressedRGBAS3TCDXT1:
+      return SkImage::CompressionType::kBC1_RGBA8_UNORM;
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
+
+std::optional<CompressedTexture> ReadKTXTexture(const sk_sp<SkData>& data) {
+  if (!data || data->size() < kKTXHeaderSize ||
+      memcmp(data->data(), kKTXIdentifier, sizeof(kKTXIdentifier)) != 0) {
+    return std::nullopt;
+  }
+
+  const uint8_t* bytes = data->bytes();
+  auto read = [&](size_t offset, bool swap) {
+    uint32_t value;
+    memcpy(&value, bytes + offset, sizeof(value));
+    return swap ? SwapBytes(value) : value;
+  };
+
+  uint32_t header[kHeaderFieldCount];
+  const uint32_t endianness = read(sizeof(kKTXIdentifier), false);
+  if (endianness != kKTXEndianness && endianness != kKTXSwappedEndianness) {
+    return std::nullopt;
+  }
+  const bool swap = endianness == kKTXSwappedEndianness;
+  for (int i = 0; i < kHeaderFieldCount; i++) {
+    header[i] = read(sizeof(kKTXIdentifier) + i * sizeof(uint32_t), swap);
+  }
+
+  // Compressed textures have a GL type of zero. Array, cube map and 3D
+  // textures cannot be drawn as images.
+  auto type = CompressionTypeForGLFormat(header[kGLInternalFormat]);
+  if (!type || header[kGLType] != 0 || header[kPixelWidth] == 0 ||
+      header[kPixelHeight] == 0 || header[kPixelDepth] != 0 ||
+      header[kNumberOfArrayElements] != 0 || header[kNumberOfFaces] != 1) {
+    return std::nullopt;
+  }
+
+  // The base level is first, preceded by its size.
+  const size_t level_offset = kKTXHeaderSize + header[kBytesOfKeyValueData];
+  if (level_offset > data->size() ||
+      data->size() - level_offset < sizeof(uint32_t)) {
+    return std::nullopt;
+  }
+  const size_t level_size = read(level_offset, swap);
+  const size_t blocks_wide =
+      (header[kPixelWidth] + kBlockDimension - 1) / kBlockDimension;
+  const size_t blocks_high =
+      (header[kPixelHeight] + kBlockDimension - 1) / kBlockDimension;
+  const size_t expected_size = blocks_wide * blocks_high * kBytesPerBlock;
+  if (level_size != expected_size ||
+      data->size() - level_offset - sizeof(uint32_t) < level_size) {
+    return std::nullopt;
+  }
+
+  CompressedTexture texture;
+  texture.type = *type;
+  texture.dimensions = SkISize::Make(header[kPixelWidth], header[kPixelHeight]);
+  texture.data = SkData::MakeSubset(data.get(), level_offset + sizeof(uint32_t),
+                                    level_size);
+  return texture;
+}
+
+}  // namespace flutter
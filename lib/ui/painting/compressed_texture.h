@@ -0,0 +1,39 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_COMPRESSED_TEXTURE_H_
+#define FLUTTER_LIB_UI_PAINTING_COMPRESSED_TEXTURE_H_
+
+#include <optional>
+
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+// The pixels of an image in a GPU compressed format, which GPUs that support
+// the format sample from as they are, without decoding them first.
+struct CompressedTexture {
+  SkImage::CompressionType type = SkImage::CompressionType::kNone;
+  SkISize dimensions = SkISize::MakeEmpty();
+  // The blocks of the base level of the texture.
+  sk_sp<SkData> data;
+
+  // Whether the format has an alpha channel.
+  bool has_alpha() const {
+    return type == SkImage::CompressionType::kBC1_RGBA8_UNORM;
+  }
+};
+
+// Reads the base level of the texture in the KTX container |data|. Returns
+// std::nullopt if |data| is not a KTX container, or if it holds a texture that
+// is not a 2D texture in one of the formats Skia can upload: ETC1, ETC2 RGB8
+// and BC1.
+std::optional<CompressedTexture> ReadKTXTexture(const sk_sp<SkData>& data);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_COMPRESSED_TEXTURE_H_
@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/compressed_texture.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "flutter/lib/ui/painting/image_descriptor.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr uint32_t kGLCompressedRGBAS3TCDXT1 = 0x83F1;
+constexpr uint32_t kGLCompressedRGB8ETC2 = 0x9274;
+constexpr uint32_t kGLCompressedRGBAASTC4x4 = 0x93B0;
+
+struct KTXOptions {
+  uint32_t internal_format = kGLCompressedRGB8ETC2;
+  uint32_t width = 8;
+  uint32_t height = 4;
+  uint32_t faces = 1;
+  uint32_t key_value_bytes = 0;
+  bool swap = false;
+  // The number of bytes of the base level to leave out.
+  size_t truncate = 0;
+};
+
+void Append(std::vector<uint8_t>& bytes, uint32_t value, bool swap) {
+  uint8_t buffer[4];
+  memcpy(buffer, &value, sizeof(value));
+  if (swap) {
+    std::swap(buffer[0], buffer[3]);
+    std::swap(buffer[1], buffer[2]);
+  }
+  bytes.insert(bytes.end(), buffer, buffer + sizeof(buffer));
+}
+
+// A KTX container of a single level texture whose blocks are all zero.
+sk_sp<SkData> MakeKTX(const KTXOptions& options) {
+  std::vector<uint8_t> bytes = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31,
+                                0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  const uint32_t level_size =
+      ((options.width + 3) / 4) * ((options.height + 3) / 4) * 8;
+  for (uint32_t value : {
+           0x04030201u,              // endianness
+           0u,                       // glType
+           1u,                       // glTypeSize
+           0u,                       // glFormat
+           options.internal_format,  // glInternalFormat
+           0x1907u,                  // glBaseInternalFormat
+           options.width,            // pixelWidth
+           options.height,           // pixelHeight
+           0u,                       // pixelDepth
+           0u,                       // numberOfArrayElements
+           options.faces,            // numberOfFaces
+           1u,                       // numberOfMipmapLevels
+           options.key_value_bytes,  // bytesOfKeyValueData
+       }) {
+    Append(bytes, value, options.swap);
+  }
+  bytes.insert(bytes.end(), options.key_value_bytes, 0);
+  Append(bytes, level_size, options.swap);
+  bytes.insert(bytes.end(), level_size - options.truncate, 0);
+  return SkData::MakeWithCopy(bytes.data(), bytes.size());
+}
+
+}  // namespace
+
+TEST(CompressedTextureTest, ReadsKTXTextures) {
+  KTXOptions options;
+  options.key_value_bytes = 16;
+  auto texture = ReadKTXTexture(MakeKTX(options));
+  ASSERT_TRUE(texture.has_value());
+  EXPECT_EQ(texture->type, SkImage::CompressionType::kETC2_RGB8_UNORM);
+  EXPECT_EQ(texture->dimensions, SkISize::Make(8, 4));
+  EXPECT_EQ(texture->data->size(), 16u);
+  EXPECT_FALSE(texture->has_alpha());
+}
+
+TEST(CompressedTextureTest, ReadsSwappedKTXTextures) {
+  KTXOptions options;
+  options.swap = true;
+  options.internal_format = kGLCompressedRGBAS3TCDXT1;
+  options.width = 5;
+  options.height = 5;
+  auto texture = ReadKTXTexture(MakeKTX(options));
+  ASSERT_TRUE(texture.has_value());
+  EXPECT_EQ(texture->type, SkImage::CompressionType::kBC1_RGBA8_UNORM);
+  EXPECT_EQ(texture->dimensions, SkISize::Make(5, 5));
+  // Partial blocks round up to whole ones.
+  EXPECT_EQ(texture->data->size(), 32u);
+  EXPECT_TRUE(texture->has_alpha());
+}
+
+TEST(CompressedTextureTest, RejectsUnsupportedData) {
+  const uint8_t png_signature[] = {0x89, 0x50, 0x4E, 0x47,
+                                   0x0D, 0x0A, 0x1A, 0x0A};
+  EXPECT_FALSE(ReadKTXTexture(SkData::MakeWithCopy(png_signature,
+                                                   sizeof(png_signature))));
+
+  KTXOptions astc;
+  astc.internal_format = kGLCompressedRGBAASTC4x4;
+  EXPECT_FALSE(ReadKTXTexture(MakeKTX(astc)));
+
+  KTXOptions cube_map;
+  cube_map.faces = 6;
+  EXPECT_FALSE(ReadKTXTexture(MakeKTX(cube_map)));
+
+  KTXOptions truncated;
+  truncated.truncate = 1;
+  EXPECT_FALSE(ReadKTXTexture(MakeKTX(truncated)));
+}
+
+TEST(CompressedTextureTest, DescriptorDecodesPixelsOnTheCPU) {
+  KTXOptions options;
+  options.internal_format = kGLCompressedRGBAS3TCDXT1;
+  auto data = MakeKTX(options);
+  auto texture = ReadKTXTexture(data);
+  ASSERT_TRUE(texture.has_value());
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(*texture));
+
+  EXPECT_TRUE(descriptor->is_compressed());
+  ASSERT_NE(descriptor->compressed_texture(), nullptr);
+  EXPECT_EQ(descriptor->width(), 8);
+  EXPECT_EQ(descriptor->height(), 4);
+
+  // Blocks of zeros decode to opaque black.
+  auto image = descriptor->image();
+  ASSERT_TRUE(image != nullptr);
+  EXPECT_EQ(image->dimensions(), SkISize::Make(8, 4));
+  SkColor pixel;
+  ASSERT_TRUE(image->readPixels(
+      SkImageInfo::Make(1, 1, kBGRA_8888_SkColorType, kUnpremul_SkAlphaType),
+      &pixel, sizeof(pixel), 7, 3));
+  EXPECT_EQ(pixel, SK_ColorBLACK);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <iterator>
+#include <string_view>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+bool DecodedImageCache::Key::operator==(const Key& other) const {
+  // Equal hashes of different bytes are rare but not impossible, so the bytes
+  // themselves are compared.
+  return data_hash == other.data_hash && target_width == other.target_width &&
+         target_height == other.target_height && subset == other.subset &&
+         (data == other.data || data->equals(other.data.get()));
+}
+
+size_t DecodedImageCache::KeyHash::operator()(const Key& key) const {
+  size_t hash =
+      fml::HashCombine(key.data_hash, key.target_width, key.target_height);
+  if (key.subset.has_value()) {
+    fml::HashCombineSeed(hash, key.subset->left(), key.subset->top(),
+                         key.subset->right(), key.subset->bottom());
+  }
+  return hash;
+}
+
+DecodedImageCache::Key DecodedImageCache::MakeKey(
+    sk_sp<SkData> encoded,
+    uint32_t target_width,
+    uint32_t target_height,
+    std::optional<SkIRect> subset) {
+  TRACE_EVENT0("flutter", "DecodedImageCache::MakeKey");
+  const std::string_view bytes(static_cast<const char*>(encoded->data()),
+                               encoded->size());
+  return {std::hash<std::string_view>{}(bytes), std::move(encoded),
+          target_width, target_height, subset};
+}
+
+DecodedImageCache::DecodedImageCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+DecodedImageCache::~DecodedImageCache() {
+  Purge();
+}
+
+SkiaGPUObject<SkImage> DecodedImageCache::Get(const Key& key) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return {};
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  const Entry& entry = *found->second;
+  return {entry.image, entry.queue};
+}
+
+void DecodedImageCache::Put(const Key& key,
+                            sk_sp<SkImage> image,
+                            fml::RefPtr<SkiaUnrefQueue> queue) {
+  if (!image) {
+    return;
+  }
+  const size_t image_bytes = image->imageInfo().computeMinByteSize();
+  const size_t bytes = image_bytes + key.data->size();
+
+  std::scoped_lock lock(mutex_);
+  if (image_bytes == 0 || bytes > max_bytes_) {
+    return;
+  }
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    EraseLocked(found->second);
+  }
+  entries_.push_front({key, std::move(image), std::move(queue), bytes});
+  index_[key] = entries_.begin();
+  byte_count_ += bytes;
+  EvictLocked(max_bytes_);
+}
+
+void DecodedImageCache::Purge() {
+  std::scoped_lock lock(mutex_);
+  EvictLocked(0);
+}
+
+void DecodedImageCache::PurgeUnreferenced() {
+  std::scoped_lock lock(mutex_);
+  for (auto entry = entries_.begin(); entry != entries_.end();) {
+    auto next = std::next(entry);
+    if (entry->image->unique()) {
+      EraseLocked(entry);
+    }
+    entry = next;
+  }
+  TraceStatsToTimelineLocked();
+}
+
+void DecodedImageCache::SetMaxBytes(size_t max_bytes) {
+  std::scoped_lock lock(mutex_);
+  max_bytes_ = max_bytes;
+  EvictLocked(max_bytes_);
+}
+
+size_t DecodedImageCache::GetMaxBytes() const {
+  std::scoped_lock lock(mutex_);
+  return max_bytes_;
+}
+
+size_t DecodedImageCache::GetByteCount() const {
+  std::scoped_lock lock(mutex_);
+  return byte_count_;
+}
+
+size_t DecodedImageCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+void DecodedImageCache::EraseLocked(EntryList::iterator entry) {
+  byte_count_ -= entry->bytes;
+  if (entry->queue) {
+    // Texture backed images must be released on the thread of their context.
+    entry->queue->Unref(entry->image.release());
+  }
+  index_.erase(entry->key);
+  entries_.erase(entry);
+}
+
+void DecodedImageCache::EvictLocked(size_t max_bytes) {
+  while (byte_count_ > max_bytes) {
+    EraseLocked(std::prev(entries_.end()));
+  }
+  TraceStatsToTimelineLocked();
+}
+
+void DecodedImageCache::TraceStatsToTimelineLocked() const {
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "DecodedImageCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Entries", entries_.size(), "Bytes", byte_count_);
+#endif  // !FLUTTER_RELEASE
+}
+
+}  // namespace flutter
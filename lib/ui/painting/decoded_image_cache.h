@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A byte budgeted cache of decoded images, shared by the image
+///             decoders of a shell so that decoding the same encoded image at
+///             the same size more than once returns the image that was already
+///             decoded.
+///
+///             Entries are keyed by the encoded bytes together with the target
+///             dimensions and subset they were decoded with. The encoded bytes
+///             are retained by the entry and compared on every lookup, so they
+///             count against the budget along with the decoded image. Once the
+///             total size of the entries exceeds the budget, the least recently
+///             used entries are evicted. Images that are still
+///             referenced elsewhere stay alive after their eviction but are no
+///             longer shared.
+///
+///             The images are released through the unref queue they were
+///             created with, so the cache must be purged before that queue is
+///             drained for the last time.
+///
+///             All methods are thread safe.
+///
+class DecodedImageCache {
+ public:
+  struct Key {
+    size_t data_hash;
+    sk_sp<SkData> data;
+    uint32_t target_width;
+    uint32_t target_height;
+    std::optional<SkIRect> subset;
+
+    bool operator==(const Key& other) const;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The key of the image decoded from |encoded|.
+  ///
+  static Key MakeKey(sk_sp<SkData> encoded,
+                     uint32_t target_width,
+                     uint32_t target_height,
+                     std::optional<SkIRect> subset);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a cache that retains up to |max_bytes| of images. A
+  ///             budget of 0 disables the cache.
+  ///
+  explicit DecodedImageCache(size_t max_bytes);
+
+  ~DecodedImageCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Looks up the image with the given key and marks it as the most
+  ///             recently used one.
+  ///
+  /// @return     A new reference to the cached image, or an empty object if
+  ///             there is none.
+  ///
+  SkiaGPUObject<SkImage> Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an image to the cache, replacing any image with the same
+  ///             key. Images larger than the whole budget are not cached.
+  ///
+  /// @param[in]  queue  The queue used to release the image, if any.
+  ///
+  void Put(const Key& key,
+           sk_sp<SkImage> image,
+           fml::RefPtr<SkiaUnrefQueue> queue);
+
+  /// Evicts all entries, e.g. in response to a low memory warning.
+  void Purge();
+
+  /// Evicts the entries whose images are not referenced outside of the cache,
+  /// keeping only the images that are in use, e.g. on screen.
+  void PurgeUnreferenced();
+
+  /// Changes the budget, evicting entries if the cache no longer fits.
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t GetMaxBytes() const;
+
+  /// The total size of the cached images and their encoded data.
+  size_t GetByteCount() const;
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    sk_sp<SkImage> image;
+    fml::RefPtr<SkiaUnrefQueue> queue;
+    size_t bytes;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  mutable std::mutex mutex_;
+  size_t max_bytes_;
+  size_t byte_count_ = 0;
+  // Ordered from the most to the least recently used entry.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+
+  void EraseLocked(EntryList::iterator entry);
+
+  void EvictLocked(size_t max_bytes);
+
+  void TraceStatsToTimelineLocked() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DecodedImageCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
@@ -0,0 +1,167 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <future>
+#include <vector>
+
+#include "flutter/testing/thread_test.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+class DecodedImageCacheTest : public ThreadTest {
+ public:
+  DecodedImageCacheTest() : unref_task_runner_(CreateNewThread()) {
+    std::promise<fml::RefPtr<SkiaUnrefQueue>> queue;
+    unref_task_runner_->PostTask([this, &queue]() {
+      queue.set_value(fml::MakeRefCounted<SkiaUnrefQueue>(
+          unref_task_runner_, fml::TimeDelta::FromSeconds(0)));
+    });
+    unref_queue_ = queue.get_future().get();
+  }
+
+  fml::RefPtr<SkiaUnrefQueue> unref_queue() { return unref_queue_; }
+
+  // The key of an image decoded from |size| bytes of encoded data.
+  static DecodedImageCache::Key MakeKey(size_t size,
+                                        uint32_t target_width = 0,
+                                        uint32_t target_height = 0) {
+    std::vector<uint8_t> bytes(size, 0x42);
+    return DecodedImageCache::MakeKey(
+        SkData::MakeWithCopy(bytes.data(), bytes.size()), target_width,
+        target_height, std::nullopt);
+  }
+
+  // A 4 bytes per pixel image taking up |width| x |height| x 4 bytes.
+  static sk_sp<SkImage> MakeImage(int width, int height) {
+    const auto info = SkImageInfo::MakeN32Premul(width, height);
+    return SkImage::MakeRasterData(
+        info, SkData::MakeZeroInitialized(info.computeMinByteSize()),
+        info.minRowBytes());
+  }
+
+ private:
+  fml::RefPtr<fml::TaskRunner> unref_task_runner_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+};
+
+TEST_F(DecodedImageCacheTest, KeysDistinguishContentsAndTargetSize) {
+  EXPECT_EQ(MakeKey(16), MakeKey(16));
+  EXPECT_FALSE(MakeKey(16) == MakeKey(17));
+  EXPECT_FALSE(MakeKey(16) == MakeKey(16, 10, 10));
+
+  auto data = SkData::MakeWithCString("encoded");
+  auto key = DecodedImageCache::MakeKey(data, 0, 0, std::nullopt);
+  auto subset_key =
+      DecodedImageCache::MakeKey(data, 0, 0, SkIRect::MakeWH(2, 2));
+  EXPECT_FALSE(key == subset_key);
+  EXPECT_EQ(subset_key,
+            DecodedImageCache::MakeKey(data, 0, 0, SkIRect::MakeWH(2, 2)));
+}
+
+TEST_F(DecodedImageCacheTest, KeysCompareBytesWhenHashesCollide) {
+  auto key = DecodedImageCache::MakeKey(SkData::MakeWithCString("encoded"), 0,
+                                        0, std::nullopt);
+  auto colliding_key = DecodedImageCache::MakeKey(
+      SkData::MakeWithCString("ENCODED"), 0, 0, std::nullopt);
+  colliding_key.data_hash = key.data_hash;
+  EXPECT_FALSE(key == colliding_key);
+
+  DecodedImageCache cache(1024);
+  cache.Put(key, MakeImage(4, 4), unref_queue());
+  EXPECT_EQ(cache.Get(colliding_key).get(), nullptr);
+  EXPECT_NE(cache.Get(key).get(), nullptr);
+}
+
+TEST_F(DecodedImageCacheTest, ReturnsCachedImage) {
+  DecodedImageCache cache(1024);
+  auto image = MakeImage(4, 4);
+  EXPECT_EQ(cache.Get(MakeKey(16)).get(), nullptr);
+
+  cache.Put(MakeKey(16), image, unref_queue());
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  // The image and the encoded data it was decoded from.
+  EXPECT_EQ(cache.GetByteCount(), 64u + 16u);
+  EXPECT_EQ(cache.Get(MakeKey(16)).get(), image);
+  EXPECT_EQ(cache.Get(MakeKey(16, 2, 2)).get(), nullptr);
+}
+
+TEST_F(DecodedImageCacheTest, EvictsLeastRecentlyUsedImage) {
+  DecodedImageCache cache((64 + 3) * 2);
+  cache.Put(MakeKey(1), MakeImage(4, 4), unref_queue());
+  cache.Put(MakeKey(2), MakeImage(4, 4), unref_queue());
+
+  // Using the first image makes the second one the least recently used.
+  EXPECT_NE(cache.Get(MakeKey(1)).get(), nullptr);
+  cache.Put(MakeKey(3), MakeImage(4, 4), unref_queue());
+
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_EQ(cache.GetByteCount(), 64u + 1u + 64u + 3u);
+  EXPECT_NE(cache.Get(MakeKey(1)).get(), nullptr);
+  EXPECT_EQ(cache.Get(MakeKey(2)).get(), nullptr);
+  EXPECT_NE(cache.Get(MakeKey(3)).get(), nullptr);
+}
+
+TEST_F(DecodedImageCacheTest, DoesNotCacheImagesLargerThanBudget) {
+  DecodedImageCache cache(64);
+  cache.Put(MakeKey(1), MakeImage(8, 8), unref_queue());
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+
+  DecodedImageCache disabled_cache(0);
+  disabled_cache.Put(MakeKey(1), MakeImage(1, 1), unref_queue());
+  EXPECT_EQ(disabled_cache.GetEntryCount(), 0u);
+}
+
+TEST_F(DecodedImageCacheTest, ReplacesImageWithSameKey) {
+  DecodedImageCache cache(1024);
+  cache.Put(MakeKey(1), MakeImage(4, 4), unref_queue());
+  auto image = MakeImage(2, 2);
+  cache.Put(MakeKey(1), image, unref_queue());
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_EQ(cache.GetByteCount(), 16u + 1u);
+  EXPECT_EQ(cache.Get(MakeKey(1)).get(), image);
+}
+
+TEST_F(DecodedImageCacheTest, PurgesAndShrinks) {
+  DecodedImageCache cache(1024);
+  cache.Put(MakeKey(1), MakeImage(4, 4), unref_queue());
+  cache.Put(MakeKey(2), MakeImage(4, 4), unref_queue());
+
+  cache.SetMaxBytes(64 + 2);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_NE(cache.Get(MakeKey(2)).get(), nullptr);
+
+  cache.Purge();
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+  EXPECT_EQ(cache.GetByteCount(), 0u);
+  EXPECT_EQ(cache.GetMaxBytes(), 64u + 2u);
+}
+
+TEST_F(DecodedImageCacheTest, PurgeUnreferencedKeepsImagesInUse) {
+  DecodedImageCache cache(1024);
+  auto image_in_use = MakeImage(4, 4);
+  cache.Put(MakeKey(1), image_in_use, unref_queue());
+  cache.Put(MakeKey(2), MakeImage(4, 4), unref_queue());
+
+  cache.PurgeUnreferenced();
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_EQ(cache.GetByteCount(), 64u + 1u);
+  EXPECT_EQ(cache.Get(MakeKey(1)).get(), image_in_use);
+  EXPECT_EQ(cache.Get(MakeKey(2)).get(), nullptr);
+}
+
+TEST_F(DecodedImageCacheTest, EvictedImagesStayAliveWhileReferenced) {
+  DecodedImageCache cache(1024);
+  cache.Put(MakeKey(1), MakeImage(4, 4), unref_queue());
+  auto image = cache.Get(MakeKey(1));
+  cache.Purge();
+  ASSERT_NE(image.get(), nullptr);
+  EXPECT_EQ(image.get()->width(), 4);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -14,7 +14,7 @@ using tonic::ToDart;
 namespace flutter {
 
 EngineLayer::EngineLayer(std::shared_ptr<flutter::ContainerLayer> layer)
-    : layer_(layer) {}
+    : layer_(std::move(layer)) {}
 
 EngineLayer::~EngineLayer() = default;
 
@@ -26,18 +26,20 @@ class EngineLayer : public RefCountedDartWrappable<EngineLayer> {
 
   static fml::RefPtr<EngineLayer> MakeRetained(
       std::shared_ptr<flutter::ContainerLayer> layer) {
-    return fml::MakeRefCounted<EngineLayer>(layer);
+    return fml::MakeRefCounted<EngineLayer>(std::move(layer));
   }
 
   static void MakeRetained(Dart_Handle dart_handle,
                            std::shared_ptr<flutter::ContainerLayer> layer) {
-    auto engine_layer = fml::MakeRefCounted<EngineLayer>(layer);
+    auto engine_layer = fml::MakeRefCounted<EngineLayer>(std::move(layer));
     engine_layer->AssociateWithDartWrapper(dart_handle);
   }
 
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
-  std::shared_ptr<flutter::ContainerLayer> Layer() const { return layer_; }
+  const std::shared_ptr<flutter::ContainerLayer>& Layer() const {
+    return layer_;
+  }
 
  private:
   explicit EngineLayer(std::shared_ptr<flutter::ContainerLayer> layer);
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/gradient.h"
 
+#include "flutter/lib/ui/painting/gradient_cache.h"
+
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -38,6 +40,22 @@ fml::RefPtr<CanvasGradient> CanvasGradient::Create() {
   return fml::MakeRefCounted<CanvasGradient>();
 }
 
+namespace {
+
+// Adds the parameters that all gradients share to |key|.
+void AddColorsAndTileMode(GradientCache::Key& key,
+                          const tonic::Int32List& colors,
+                          const tonic::Float32List& color_stops,
+                          SkTileMode tile_mode,
+                          const tonic::Float64List& matrix4) {
+  key.Add(colors.data(), colors.num_elements());
+  key.Add(color_stops.data(), color_stops.num_elements());
+  key.Add(static_cast<uint32_t>(tile_mode));
+  key.Add(matrix4.data(), matrix4.num_elements());
+}
+
+}  // namespace
+
 void CanvasGradient::initLinear(const tonic::Float32List& end_points,
                                 const tonic::Int32List& colors,
                                 const tonic::Float32List& color_stops,
@@ -58,10 +76,17 @@ void CanvasGradient::initLinear(const tonic::Float32List& end_points,
     sk_matrix = ToSkMatrix(matrix4);
   }
 
-  sk_shader_ = UIDartState::CreateGPUObject(SkGradientShader::MakeLinear(
-      reinterpret_cast<const SkPoint*>(end_points.data()),
-      reinterpret_cast<const SkColor*>(colors.data()), color_stops.data(),
-      colors.num_elements(), tile_mode, 0, has_matrix ? &sk_matrix : nullptr));
+  GradientCache::Key key(GradientCache::Type::kLinear);
+  key.Add(end_points.data(), end_points.num_elements());
+  AddColorsAndTileMode(key, colors, color_stops, tile_mode, matrix4);
+  sk_shader_ = UIDartState::CreateGPUObject(
+      GradientCache::GetInstance().GetOrCreate(key, [&]() {
+        return SkGradientShader::MakeLinear(
+            reinterpret_cast<const SkPoint*>(end_points.data()),
+            reinterpret_cast<const SkColor*>(colors.data()),
+            color_stops.data(), colors.num_elements(), tile_mode, 0,
+            has_matrix ? &sk_matrix : nullptr);
+      }));
 }
 
 void CanvasGradient::initRadial(double center_x,
@@ -83,10 +108,19 @@ void CanvasGradient::initRadial(double center_x,
     sk_matrix = ToSkMatrix(matrix4);
   }
 
-  sk_shader_ = UIDartState::CreateGPUObject(SkGradientShader::MakeRadial(
-      SkPoint::Make(center_x, center_y), radius,
-      reinterpret_cast<const SkColor*>(colors.data()), color_stops.data(),
-      colors.num_elements(), tile_mode, 0, has_matrix ? &sk_matrix : nullptr));
+  GradientCache::Key key(GradientCache::Type::kRadial);
+  key.Add(center_x);
+  key.Add(center_y);
+  key.Add(radius);
+  AddColorsAndTileMode(key, colors, color_stops, tile_mode, matrix4);
+  sk_shader_ = UIDartState::CreateGPUObject(
+      GradientCache::GetInstance().GetOrCreate(key, [&]() {
+        return SkGradientShader::MakeRadial(
+            SkPoint::Make(center_x, center_y), radius,
+            reinterpret_cast<const SkColor*>(colors.data()),
+            color_stops.data(), colors.num_elements(), tile_mode, 0,
+            has_matrix ? &sk_matrix : nullptr);
+      }));
 }
 
 void CanvasGradient::initSweep(double center_x,
@@ -109,11 +143,21 @@ void CanvasGradient::initSweep(double center_x,
     sk_matrix = ToSkMatrix(matrix4);
   }
 
-  sk_shader_ = UIDartState::CreateGPUObject(SkGradientShader::MakeSweep(
-      center_x, center_y, reinterpret_cast<const SkColor*>(colors.data()),
-      color_stops.data(), colors.num_elements(), tile_mode,
-      start_angle * 180.0 / M_PI, end_angle * 180.0 / M_PI, 0,
-      has_matrix ? &sk_matrix : nullptr));
+  GradientCache::Key key(GradientCache::Type::kSweep);
+  key.Add(center_x);
+  key.Add(center_y);
+  key.Add(start_angle);
+  key.Add(end_angle);
+  AddColorsAndTileMode(key, colors, color_stops, tile_mode, matrix4);
+  sk_shader_ = UIDartState::CreateGPUObject(
+      GradientCache::GetInstance().GetOrCreate(key, [&]() {
+        return SkGradientShader::MakeSweep(
+            center_x, center_y,
+            reinterpret_cast<const SkColor*>(colors.data()),
+            color_stops.data(), colors.num_elements(), tile_mode,
+            start_angle * 180.0 / M_PI, end_angle * 180.0 / M_PI, 0,
+            has_matrix ? &sk_matrix : nullptr);
+      }));
 }
 
 void CanvasGradient::initTwoPointConical(double start_x,
@@ -138,13 +182,23 @@ void CanvasGradient::initTwoPointConical(double start_x,
     sk_matrix = ToSkMatrix(matrix4);
   }
 
-  sk_shader_ =
-      UIDartState::CreateGPUObject(SkGradientShader::MakeTwoPointConical(
-          SkPoint::Make(start_x, start_y), start_radius,
-          SkPoint::Make(end_x, end_y), end_radius,
-          reinterpret_cast<const SkColor*>(colors.data()), color_stops.data(),
-          colors.num_elements(), tile_mode, 0,
-          has_matrix ? &sk_matrix : nullptr));
+  GradientCache::Key key(GradientCache::Type::kTwoPointConical);
+  key.Add(start_x);
+  key.Add(start_y);
+  key.Add(start_radius);
+  key.Add(end_x);
+  key.Add(end_y);
+  key.Add(end_radius);
+  AddColorsAndTileMode(key, colors, color_stops, tile_mode, matrix4);
+  sk_shader_ = UIDartState::CreateGPUObject(
+      GradientCache::GetInstance().GetOrCreate(key, [&]() {
+        return SkGradientShader::MakeTwoPointConical(
+            SkPoint::Make(start_x, start_y), start_radius,
+            SkPoint::Make(end_x, end_y), end_radius,
+            reinterpret_cast<const SkColor*>(colors.data()),
+            color_stops.data(), colors.num_elements(), tile_mode, 0,
+            has_matrix ? &sk_matrix : nullptr);
+      }));
 }
 
 CanvasGradient::CanvasGradient() = default;
@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/gradient_cache.h"
+
+#include <cstring>
+
+namespace flutter {
+
+namespace {
+
+// Marks a list that is absent, which is distinct from any list count.
+constexpr uint32_t kNoList = 0xFFFFFFFF;
+
+}  // namespace
+
+GradientCache::Key::Key(Type type) {
+  words_.push_back(static_cast<uint32_t>(type));
+}
+
+void GradientCache::Key::Add(uint32_t value) {
+  words_.push_back(value);
+}
+
+void GradientCache::Key::Add(float value) {
+  uint32_t bits;
+  ::memcpy(&bits, &value, sizeof(bits));
+  words_.push_back(bits);
+}
+
+void GradientCache::Key::Add(double value) {
+  uint32_t bits[2];
+  ::memcpy(bits, &value, sizeof(bits));
+  words_.push_back(bits[0]);
+  words_.push_back(bits[1]);
+}
+
+void GradientCache::Key::Add(const float* values, size_t count) {
+  if (!values) {
+    words_.push_back(kNoList);
+    return;
+  }
+  words_.push_back(static_cast<uint32_t>(count));
+  for (size_t i = 0; i < count; i++) {
+    Add(values[i]);
+  }
+}
+
+void GradientCache::Key::Add(const int32_t* values, size_t count) {
+  if (!values) {
+    words_.push_back(kNoList);
+    return;
+  }
+  words_.push_back(static_cast<uint32_t>(count));
+  for (size_t i = 0; i < count; i++) {
+    words_.push_back(static_cast<uint32_t>(values[i]));
+  }
+}
+
+void GradientCache::Key::Add(const double* values, size_t count) {
+  if (!values) {
+    words_.push_back(kNoList);
+    return;
+  }
+  words_.push_back(static_cast<uint32_t>(count));
+  for (size_t i = 0; i < count; i++) {
+    Add(values[i]);
+  }
+}
+
+GradientCache& GradientCache::GetInstance() {
+  static auto* cache = new GradientCache(kDefaultCapacity);
+  return *cache;
+}
+
+GradientCache::GradientCache(size_t capacity) : capacity_(capacity) {}
+
+GradientCache::~GradientCache() = default;
+
+sk_sp<SkShader> GradientCache::GetOrCreate(
+    const Key& key,
+    const std::function<sk_sp<SkShader>()>& create) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return found->second->shader;
+  }
+
+  sk_sp<SkShader> shader = create();
+  if (!shader || capacity_ == 0) {
+    return shader;
+  }
+  entries_.push_front({key, shader});
+  index_[key] = entries_.begin();
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  return shader;
+}
+
+void GradientCache::Purge() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+}
+
+size_t GradientCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace flutter
@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_GRADIENT_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_GRADIENT_CACHE_H_
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/core/SkShader.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache that interns the shaders of gradients, so that creating
+///             a gradient with the same parameters as a recent one returns the
+///             same `SkShader`.
+///
+///             Frameworks usually rebuild their gradients every frame. Sharing
+///             the shader lets Skia reuse what it derived from it, such as its
+///             color tables, and makes the pictures that draw it with the same
+///             parameters reference the same shader.
+///
+///             Entries are keyed by all of the parameters of a gradient, in the
+///             form of their bits. Once the cache holds more than its capacity,
+///             the least recently used entries are evicted.
+///
+///             Gradient shaders do not reference GPU resources, so they can be
+///             released on any thread. All methods are thread safe.
+///
+class GradientCache {
+ public:
+  /// The kinds of gradients, which are the first value of every key.
+  enum class Type : uint32_t {
+    kLinear,
+    kRadial,
+    kSweep,
+    kTwoPointConical,
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The parameters of a gradient, appended one at a time.
+  ///
+  class Key {
+   public:
+    explicit Key(Type type);
+
+    void Add(uint32_t value);
+
+    void Add(float value);
+
+    void Add(double value);
+
+    /// Adds the number of |values| followed by the values, or a marker if
+    /// there are none, so that keys with and without the list differ.
+    void Add(const float* values, size_t count);
+
+    void Add(const int32_t* values, size_t count);
+
+    void Add(const double* values, size_t count);
+
+    bool operator<(const Key& other) const { return words_ < other.words_; }
+
+   private:
+    std::vector<uint32_t> words_;
+  };
+
+  /// The number of gradients that the shared cache retains.
+  static constexpr size_t kDefaultCapacity = 64;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache that the gradients of dart:ui share.
+  ///
+  static GradientCache& GetInstance();
+
+  explicit GradientCache(size_t capacity);
+
+  ~GradientCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the shader of the gradient with the given key, and
+  ///             creates it with |create| and caches it if there is none.
+  ///             Null shaders are not cached.
+  ///
+  sk_sp<SkShader> GetOrCreate(const Key& key,
+                              const std::function<sk_sp<SkShader>()>& create);
+
+  /// Evicts all entries, e.g. in response to a low memory warning.
+  void Purge();
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct Entry {
+    Key key;
+    sk_sp<SkShader> shader;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  // Ordered from the most to the least recently used entry.
+  EntryList entries_;
+  std::map<Key, EntryList::iterator> index_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GradientCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_GRADIENT_CACHE_H_
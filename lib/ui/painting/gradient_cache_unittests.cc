@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/gradient_cache.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "third_party/skia/include/effects/SkGradientShader.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// The key of a linear gradient from (0, 0) to (|end_x|, 0) between two
+// colors.
+GradientCache::Key MakeLinearKey(float end_x,
+                                 const float* stops = nullptr,
+                                 size_t stop_count = 0) {
+  const float end_points[] = {0, 0, end_x, 0};
+  const int32_t colors[] = {static_cast<int32_t>(SK_ColorRED),
+                            static_cast<int32_t>(SK_ColorBLUE)};
+  GradientCache::Key key(GradientCache::Type::kLinear);
+  key.Add(end_points, 4);
+  key.Add(colors, 2);
+  key.Add(stops, stop_count);
+  return key;
+}
+
+sk_sp<SkShader> MakeLinearShader(float end_x) {
+  const SkPoint end_points[] = {{0, 0}, {end_x, 0}};
+  const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+  return SkGradientShader::MakeLinear(end_points, colors, nullptr, 2,
+                                      SkTileMode::kClamp);
+}
+
+}  // namespace
+
+TEST(GradientCacheTest, ReturnsTheSameShaderForTheSameParameters) {
+  GradientCache cache(GradientCache::kDefaultCapacity);
+  int created = 0;
+  auto create = [&]() {
+    created++;
+    return MakeLinearShader(10);
+  };
+
+  sk_sp<SkShader> first = cache.GetOrCreate(MakeLinearKey(10), create);
+  sk_sp<SkShader> second = cache.GetOrCreate(MakeLinearKey(10), create);
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(created, 1);
+
+  sk_sp<SkShader> other = cache.GetOrCreate(MakeLinearKey(20), [&]() {
+    created++;
+    return MakeLinearShader(20);
+  });
+  EXPECT_NE(first.get(), other.get());
+  EXPECT_EQ(created, 2);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+}
+
+TEST(GradientCacheTest, DistinguishesMissingAndEmptyLists) {
+  GradientCache cache(GradientCache::kDefaultCapacity);
+  const float stops[] = {0};
+  cache.GetOrCreate(MakeLinearKey(10), [] { return MakeLinearShader(10); });
+  cache.GetOrCreate(MakeLinearKey(10, stops, 0),
+                    [] { return MakeLinearShader(10); });
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+}
+
+TEST(GradientCacheTest, EvictsTheLeastRecentlyUsedShader) {
+  GradientCache cache(2);
+  sk_sp<SkShader> first =
+      cache.GetOrCreate(MakeLinearKey(1), [] { return MakeLinearShader(1); });
+  cache.GetOrCreate(MakeLinearKey(2), [] { return MakeLinearShader(2); });
+  // Using the first shader again makes the second one the least recently used.
+  cache.GetOrCreate(MakeLinearKey(1), [] { return nullptr; });
+  cache.GetOrCreate(MakeLinearKey(3), [] { return MakeLinearShader(3); });
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+
+  EXPECT_EQ(
+      cache.GetOrCreate(MakeLinearKey(1), [] { return nullptr; }).get(),
+      first.get());
+  EXPECT_FALSE(cache.GetOrCreate(MakeLinearKey(2), [] { return nullptr; }));
+
+  cache.Purge();
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
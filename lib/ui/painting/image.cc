@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/image.h"
 
+#include <atomic>
+
 #include "flutter/lib/ui/painting/image_encoding.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
@@ -35,12 +37,33 @@ void CanvasImage::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
+namespace {
+
+std::atomic<size_t> live_image_bytes = 0;
+
+}  // namespace
+
 CanvasImage::CanvasImage() = default;
 
-CanvasImage::~CanvasImage() = default;
+CanvasImage::~CanvasImage() {
+  live_image_bytes.fetch_sub(accounted_bytes_, std::memory_order_relaxed);
+}
+
+size_t CanvasImage::GetLiveBytes() {
+  return live_image_bytes.load(std::memory_order_relaxed);
+}
+
+void CanvasImage::UpdateAccountedBytes() {
+  const size_t bytes = image_.get() ? GetAllocationSize() : 0;
+  live_image_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  live_image_bytes.fetch_sub(accounted_bytes_, std::memory_order_relaxed);
+  accounted_bytes_ = bytes;
+}
 
-Dart_Handle CanvasImage::toByteData(int format, Dart_Handle callback) {
-  return EncodeImage(this, format, callback);
+Dart_Handle CanvasImage::toByteData(int format,
+                                    int quality,
+                                    Dart_Handle callback) {
+  return EncodeImage(this, format, quality, callback);
 }
 
 void CanvasImage::dispose() {
@@ -49,15 +72,23 @@ void CanvasImage::dispose() {
     hint_freed_delegate->HintFreed(GetAllocationSize());
   }
   image_.reset();
+  UpdateAccountedBytes();
   ClearDartWrapper();
 }
 
 size_t CanvasImage::GetAllocationSize() const {
   if (auto image = image_.get()) {
-    const auto& info = image->imageInfo();
-    const auto kMipmapOverhead = 4.0 / 3.0;
-    const size_t image_byte_size = info.computeMinByteSize() * kMipmapOverhead;
-    return image_byte_size + sizeof(this);
+    // The texture size accounts for the mip levels and the row alignment of
+    // the texture, and is 0 for textures of an external format.
+    size_t image_byte_size = image->textureSize();
+    if (image_byte_size == 0) {
+      image_byte_size = image->imageInfo().computeMinByteSize();
+      if (image->hasMipmaps()) {
+        const auto kMipmapOverhead = 4.0 / 3.0;
+        image_byte_size *= kMipmapOverhead;
+      }
+    }
+    return image_byte_size + sizeof(CanvasImage);
   } else {
     return sizeof(CanvasImage);
   }
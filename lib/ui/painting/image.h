@@ -30,23 +30,32 @@ class CanvasImage final : public RefCountedDartWrappable<CanvasImage> {
 
   int height() { return image_.get()->height(); }
 
-  Dart_Handle toByteData(int format, Dart_Handle callback);
+  Dart_Handle toByteData(int format, int quality, Dart_Handle callback);
 
   void dispose();
 
   sk_sp<SkImage> image() const { return image_.get(); }
   void set_image(flutter::SkiaGPUObject<SkImage> image) {
     image_ = std::move(image);
+    UpdateAccountedBytes();
   }
 
   size_t GetAllocationSize() const override;
 
+  // The total allocation size of the images that are alive and not disposed.
+  static size_t GetLiveBytes();
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
   CanvasImage();
 
+  // Replaces the bytes this image added to |GetLiveBytes| with its current
+  // allocation size.
+  void UpdateAccountedBytes();
+
   flutter::SkiaGPUObject<SkImage> image_;
+  size_t accounted_bytes_ = 0;
 };
 
 }  // namespace flutter
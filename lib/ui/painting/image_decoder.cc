@@ -7,7 +7,13 @@
 #include <algorithm>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/allocation_tags.h"
+#include "flutter/lib/ui/painting/texture_upload_queue.h"
+#include "third_party/skia/include/codec/SkAndroidCodec.h"
 #include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkImageGenerator.h"
+#include "third_party/skia/include/core/SkYUVAPixmaps.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
 
@@ -160,6 +166,243 @@ sk_sp<SkImage> ImageFromCompressedData(ImageDescriptor* descriptor,
   return ResizeRasterImage(std::move(image), resized_dimensions, flow);
 }
 
+namespace {
+
+// Generates an image from YUV planes that were decoded ahead of time. GPU
+// contexts that support YUV to RGB conversion upload the planes and convert
+// them when the image is drawn. Others, including the raster backend, decode
+// the pixels from the encoded data again.
+class YUVPlanesImageGenerator final : public SkImageGenerator {
+ public:
+  YUVPlanesImageGenerator(const SkImageInfo& info,
+                          sk_sp<SkData> data,
+                          SkYUVAPixmaps planes)
+      : SkImageGenerator(info),
+        data_(std::move(data)),
+        planes_(std::move(planes)) {}
+
+  ~YUVPlanesImageGenerator() override = default;
+
+ protected:
+  // |SkImageGenerator|
+  sk_sp<SkData> onRefEncodedData() override { return data_; }
+
+  // |SkImageGenerator|
+  bool onGetPixels(const SkImageInfo& info,
+                   void* pixels,
+                   size_t row_bytes,
+                   const Options& options) override {
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data_);
+    if (!codec) {
+      return false;
+    }
+    const SkCodec::Result result = codec->getPixels(info, pixels, row_bytes);
+    return result == SkCodec::kSuccess || result == SkCodec::kIncompleteInput;
+  }
+
+  // |SkImageGenerator|
+  bool onQueryYUVAInfo(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* yuva_pixmap_info) const override {
+    *yuva_pixmap_info = planes_.pixmapsInfo();
+    return yuva_pixmap_info->isSupported(supported_data_types);
+  }
+
+  // |SkImageGenerator|
+  bool onGetYUVAPlanes(const SkYUVAPixmaps& planes) override {
+    for (int i = 0; i < planes_.numPlanes(); i++) {
+      if (!planes_.plane(i).readPixels(planes.plane(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  const sk_sp<SkData> data_;
+  const SkYUVAPixmaps planes_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(YUVPlanesImageGenerator);
+};
+
+}  // namespace
+
+sk_sp<SkImage> YUVImageFromCompressedData(ImageDescriptor* descriptor,
+                                          uint32_t target_width,
+                                          uint32_t target_height,
+                                          const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  if (descriptor->should_resize(target_width, target_height)) {
+    return nullptr;
+  }
+
+  // The planes are in the encoded orientation of the image, and reorienting
+  // them on the CPU would cost what decoding into them saves.
+  std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(descriptor->data());
+  if (!codec || codec->getOrigin() != kTopLeft_SkEncodedOrigin) {
+    return nullptr;
+  }
+
+  // 8 bit planes can be sampled by all of the GPU backends, which are not
+  // known here as the planes are uploaded by the raster thread.
+  SkYUVAPixmapInfo::SupportedDataTypes supported_data_types;
+  for (int channels = 1; channels <= 4; channels++) {
+    supported_data_types.enableDataType(SkYUVAPixmapInfo::DataType::kUnorm8,
+                                        channels);
+  }
+  SkYUVAPixmapInfo yuva_pixmap_info;
+  if (!codec->queryYUVAInfo(supported_data_types, &yuva_pixmap_info)) {
+    return nullptr;
+  }
+
+  SkYUVAPixmaps planes = SkYUVAPixmaps::Allocate(yuva_pixmap_info);
+  if (!planes.isValid()) {
+    FML_LOG(ERROR) << "Failed to allocate memory for YUV planes of size "
+                   << yuva_pixmap_info.computeTotalBytes() << "B";
+    return nullptr;
+  }
+  if (codec->getYUVAPlanes(planes) != SkCodec::kSuccess) {
+    FML_DLOG(ERROR) << "Could not decode the YUV planes of the image, falling "
+                       "back to decoding its pixels.";
+    return nullptr;
+  }
+
+  return SkImage::MakeFromGenerator(std::make_unique<YUVPlanesImageGenerator>(
+      descriptor->image_info(), descriptor->data(), std::move(planes)));
+}
+
+// The dimensions to decode |subset| to. A target dimension of zero keeps the
+// one of the subset.
+static SkISize SubsetTargetDimensions(const SkIRect& subset,
+                                      uint32_t target_width,
+                                      uint32_t target_height) {
+  return SkISize::Make(target_width ? target_width : subset.width(),
+                       target_height ? target_height : subset.height());
+}
+
+static sk_sp<SkImage> CropAndResizeRasterImage(
+    sk_sp<SkImage> image,
+    const SkIRect& crop,
+    const SkISize& resized_dimensions,
+    const fml::tracing::TraceFlow& flow) {
+  auto cropped = image->makeSubset(crop);
+  if (!cropped) {
+    FML_LOG(ERROR) << "Could not crop image to the requested subset.";
+    return nullptr;
+  }
+  return ResizeRasterImage(std::move(cropped), resized_dimensions, flow);
+}
+
+static sk_sp<SkImage> ImageSubsetFromDecompressedData(
+    ImageDescriptor* descriptor,
+    const SkIRect& subset,
+    uint32_t target_width,
+    uint32_t target_height,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+  auto image = SkImage::MakeRasterData(
+      descriptor->image_info(), descriptor->data(), descriptor->row_bytes());
+
+  if (!image) {
+    FML_LOG(ERROR) << "Could not create image from decompressed bytes.";
+    return nullptr;
+  }
+
+  return CropAndResizeRasterImage(
+      std::move(image), subset,
+      SubsetTargetDimensions(subset, target_width, target_height), flow);
+}
+
+sk_sp<SkImage> ImageSubsetFromCompressedData(
+    ImageDescriptor* descriptor,
+    const SkIRect& subset,
+    uint32_t target_width,
+    uint32_t target_height,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  if (subset.isEmpty() ||
+      !SkIRect::MakeSize(descriptor->image_info().dimensions())
+           .contains(subset)) {
+    FML_LOG(ERROR) << "The requested subset is outside of the image.";
+    return nullptr;
+  }
+
+  // Only decode the rows and columns of the subset, and only at the scale
+  // needed, if the codec supports it. The subset is specified in the EXIF
+  // oriented coordinates of the image, so this is limited to images that do
+  // not need to be reoriented.
+  std::unique_ptr<SkAndroidCodec> codec =
+      SkAndroidCodec::MakeFromData(descriptor->data());
+  SkIRect decode_subset = subset;
+  if (codec && codec->codec()->getOrigin() == kTopLeft_SkEncodedOrigin &&
+      codec->getSupportedSubset(&decode_subset) &&
+      decode_subset.contains(subset)) {
+    int sample_size = 1;
+    if (target_width && target_height) {
+      sample_size = std::max(
+          1, std::min(subset.width() / static_cast<int>(target_width),
+                      subset.height() / static_cast<int>(target_height)));
+    }
+    const SkISize decode_dimensions =
+        codec->getSampledSubsetDimensions(sample_size, decode_subset);
+    const SkImageInfo decode_info =
+        descriptor->image_info().makeDimensions(decode_dimensions);
+
+    SkBitmap bitmap;
+    if (decode_dimensions.isEmpty() || !bitmap.tryAllocPixels(decode_info)) {
+      FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                     << decode_info.computeMinByteSize() << "B";
+      return nullptr;
+    }
+
+    SkAndroidCodec::AndroidOptions options;
+    options.fSampleSize = sample_size;
+    options.fSubset = &decode_subset;
+    const SkCodec::Result result = codec->getAndroidPixels(
+        decode_info, bitmap.getPixels(), bitmap.rowBytes(), &options);
+    if (result == SkCodec::kSuccess || result == SkCodec::kIncompleteInput) {
+      bitmap.setImmutable();
+      auto decoded_image = SkImage::MakeFromBitmap(bitmap);
+      if (!decoded_image) {
+        FML_LOG(ERROR) << "Could not create an image from a decoded subset.";
+        return nullptr;
+      }
+      // The codec may have decoded a slightly larger subset than requested.
+      const float scale_x = static_cast<float>(decode_dimensions.width()) /
+                            decode_subset.width();
+      const float scale_y = static_cast<float>(decode_dimensions.height()) /
+                            decode_subset.height();
+      SkIRect crop =
+          SkRect::MakeXYWH((subset.left() - decode_subset.left()) * scale_x,
+                           (subset.top() - decode_subset.top()) * scale_y,
+                           subset.width() * scale_x, subset.height() * scale_y)
+              .round();
+      if (!crop.intersect(SkIRect::MakeSize(decode_dimensions))) {
+        FML_LOG(ERROR) << "The decoded subset is empty.";
+        return nullptr;
+      }
+      return CropAndResizeRasterImage(
+          std::move(decoded_image), crop,
+          SubsetTargetDimensions(subset, target_width, target_height), flow);
+    }
+    FML_DLOG(ERROR) << "Could not decode the subset of the image, falling "
+                       "back to decoding the whole image.";
+  }
+
+  auto image = descriptor->image();
+  if (!image) {
+    return nullptr;
+  }
+  return CropAndResizeRasterImage(
+      std::move(image), subset,
+      SubsetTargetDimensions(subset, target_width, target_height), flow);
+}
+
 static SkiaGPUObject<SkImage> UploadRasterImage(
     sk_sp<SkImage> image,
     fml::WeakPtr<IOManager> io_manager,
@@ -216,10 +459,52 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   return result;
 }
 
+static SkiaGPUObject<SkImage> UploadCompressedTexture(
+    const CompressedTexture& texture,
+    fml::WeakPtr<IOManager> io_manager,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  auto context = io_manager->GetResourceContext();
+  if (!context || !io_manager->GetSkiaUnrefQueue() ||
+      !context->compressedBackendFormat(texture.type).isValid()) {
+    return {};
+  }
+
+  SkiaGPUObject<SkImage> result;
+  io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse(
+          [&result, &texture, &context,
+           queue = io_manager->GetSkiaUnrefQueue()] {
+            sk_sp<SkImage> texture_image = SkImage::MakeTextureFromCompressed(
+                context.get(),                // context
+                texture.data,                 // data
+                texture.dimensions.width(),   // width
+                texture.dimensions.height(),  // height
+                texture.type,                 // type
+                GrMipmapped::kNo              // mipMapped
+            );
+            if (texture_image) {
+              result = {std::move(texture_image), queue};
+            }
+          }));
+  return result;
+}
+
 void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
                           uint32_t target_width,
                           uint32_t target_height,
                           const ImageResult& callback) {
+  Decode(std::move(descriptor_ref_ptr), target_width, target_height,
+         std::nullopt, callback);
+}
+
+void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
+                          uint32_t target_width,
+                          uint32_t target_height,
+                          std::optional<SkIRect> subset,
+                          const ImageResult& callback) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   fml::tracing::TraceFlow flow(__FUNCTION__);
 
@@ -263,29 +548,99 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
     return;
   }
 
+  // Only images decoded from compressed data are cached, as decompressed data
+  // is cheap to upload and does not identify the image without its info.
+  std::shared_ptr<DecodedImageCache> cache =
+      raw_descriptor->is_compressed() ? decoded_image_cache_ : nullptr;
+  std::shared_ptr<ImageDecoderBackend> backend =
+      raw_descriptor->is_compressed() && !subset.has_value() &&
+              !raw_descriptor->compressed_texture()
+          ? backend_
+          : nullptr;
+  // GPU compressed textures are uploaded as they are, unless they have to be
+  // resized or cropped.
+  const CompressedTexture* compressed_texture =
+      !subset.has_value() &&
+              !raw_descriptor->should_resize(target_width, target_height)
+          ? raw_descriptor->compressed_texture()
+          : nullptr;
+
   concurrent_task_runner_->PostTask(
-      fml::MakeCopyable([raw_descriptor,                          //
-                         io_manager = io_manager_,                //
-                         io_runner = runners_.GetIOTaskRunner(),  //
-                         result,                                  //
-                         target_width = target_width,             //
-                         target_height = target_height,           //
-                         flow = std::move(flow)                   //
+      fml::MakeCopyable([raw_descriptor,                                  //
+                         io_manager = io_manager_,                        //
+                         io_runner = runners_.GetIOTaskRunner(),          //
+                         result,                                          //
+                         target_width = target_width,                     //
+                         target_height = target_height,                   //
+                         subset = subset,                                 //
+                         cache = std::move(cache),                        //
+                         backend = std::move(backend),                    //
+                         decodes_to_yuv_planes = decodes_to_yuv_planes_,  //
+                         compressed_texture,                              //
+                         flow = std::move(flow)                           //
   ]() mutable {
+        fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kImage);
+
+        // Step 0: Share the image that was already decoded from the same data.
+        // On Worker.
+
+        std::optional<DecodedImageCache::Key> cache_key;
+        if (cache) {
+          cache_key = DecodedImageCache::MakeKey(
+              raw_descriptor->data(), target_width, target_height, subset);
+          auto cached = cache->Get(*cache_key);
+          if (cached.get()) {
+            flow.Step("DecodedImageCacheHit");
+            result(std::move(cached), std::move(flow));
+            return;
+          }
+        }
+
         // Step 1: Decompress the image.
         // On Worker.
 
-        auto decompressed = raw_descriptor->is_compressed()
-                                ? ImageFromCompressedData(raw_descriptor,  //
-                                                          target_width,    //
-                                                          target_height,   //
-                                                          flow)
-                                : ImageFromDecompressedData(raw_descriptor,  //
-                                                            target_width,    //
-                                                            target_height,   //
-                                                            flow);
-
-        if (!decompressed) {
+        sk_sp<SkImage> decompressed;
+        if (subset.has_value()) {
+          decompressed =
+              raw_descriptor->is_compressed()
+                  ? ImageSubsetFromCompressedData(raw_descriptor,  //
+                                                  *subset,         //
+                                                  target_width,    //
+                                                  target_height,   //
+                                                  flow)
+                  : ImageSubsetFromDecompressedData(raw_descriptor,  //
+                                                    *subset,         //
+                                                    target_width,    //
+                                                    target_height,   //
+                                                    flow);
+        } else if (!compressed_texture) {
+          if (backend) {
+            decompressed = backend->Decode(raw_descriptor,  //
+                                           target_width,    //
+                                           target_height,   //
+                                           flow);
+          }
+          if (!decompressed && decodes_to_yuv_planes &&
+              raw_descriptor->is_compressed()) {
+            decompressed = YUVImageFromCompressedData(raw_descriptor,  //
+                                                      target_width,    //
+                                                      target_height,   //
+                                                      flow);
+          }
+          if (!decompressed) {
+            decompressed = raw_descriptor->is_compressed()
+                               ? ImageFromCompressedData(raw_descriptor,  //
+                                                         target_width,    //
+                                                         target_height,   //
+                                                         flow)
+                               : ImageFromDecompressedData(raw_descriptor,  //
+                                                           target_width,    //
+                                                           target_height,   //
+                                                           flow);
+          }
+        }
+
+        if (!decompressed && !compressed_texture) {
           FML_DLOG(ERROR) << "Could not decompress image.";
           result({}, std::move(flow));
           return;
@@ -294,19 +649,73 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
         // Step 2: Update the image to the GPU.
         // On IO Thread.
 
-        io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
-                                               flow =
-                                                   std::move(flow)]() mutable {
+        // The bytes uploaded to the GPU, that the upload queue budgets.
+        size_t upload_bytes = 0;
+        if (compressed_texture) {
+          upload_bytes = compressed_texture->data->size();
+        } else if (!decompressed->isTextureBacked() &&
+                   !decompressed->isLazyGenerated()) {
+          upload_bytes = decompressed->imageInfo().computeMinByteSize();
+        }
+
+        auto upload = fml::MakeCopyable([io_manager, decompressed, result,
+                                         cache = std::move(cache), cache_key,
+                                         raw_descriptor, compressed_texture,
+                                         target_width, target_height,
+                                         flow = std::move(flow)]() mutable {
+          fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kImage);
           if (!io_manager) {
             FML_DLOG(ERROR) << "Could not acquire IO manager.";
             result({}, std::move(flow));
             return;
           }
 
+          if (compressed_texture) {
+            auto uploaded =
+                UploadCompressedTexture(*compressed_texture, io_manager, flow);
+            if (uploaded.get()) {
+              if (cache) {
+                cache->Put(*cache_key, uploaded.get(),
+                           io_manager->GetSkiaUnrefQueue());
+              }
+              result(std::move(uploaded), std::move(flow));
+              return;
+            }
+            // The GPU cannot sample the format of the texture, or there is no
+            // GPU. Decode its pixels like the ones of any other image.
+            decompressed = ImageFromCompressedData(raw_descriptor,  //
+                                                   target_width,    //
+                                                   target_height,   //
+                                                   flow);
+            if (!decompressed) {
+              FML_DLOG(ERROR) << "Could not decompress image.";
+              result({}, std::move(flow));
+              return;
+            }
+          }
+
           // If the IO manager does not have a resource context, the caller
           // might not have set one or a software backend could be in use.
           // Either way, just return the image as-is.
           if (!io_manager->GetResourceContext()) {
+            if (cache) {
+              cache->Put(*cache_key, decompressed,
+                         io_manager->GetSkiaUnrefQueue());
+            }
+            result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
+                   std::move(flow));
+            return;
+          }
+
+          // Images decoded by a backend into platform buffers can already be
+          // drawn without an upload, and YUV planes are uploaded by the raster
+          // thread when they are first drawn.
+          if (decompressed->isTextureBacked() ||
+              decompressed->isLazyGenerated()) {
+            if (cache) {
+              cache->Put(*cache_key, decompressed,
+                         io_manager->GetSkiaUnrefQueue());
+            }
             result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
                    std::move(flow));
             return;
@@ -321,12 +730,55 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
             return;
           }
 
+          if (cache) {
+            cache->Put(*cache_key, uploaded.get(),
+                       io_manager->GetSkiaUnrefQueue());
+          }
+
           // Finally, all done.
           result(std::move(uploaded), std::move(flow));
-        }));
+        });
+
+        io_runner->PostTask([io_manager, upload_bytes,
+                             upload = std::move(upload)]() {
+          TextureUploadQueue* queue =
+              io_manager ? io_manager->GetTextureUploadQueue() : nullptr;
+          if (queue) {
+            queue->Enqueue(upload_bytes, upload);
+          } else {
+            upload();
+          }
+        });
       }));
 }
 
+void ImageDecoder::SetDecodedImageCache(
+    std::shared_ptr<DecodedImageCache> cache) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  decoded_image_cache_ = std::move(cache);
+}
+
+void ImageDecoder::SetBackend(std::shared_ptr<ImageDecoderBackend> backend) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  backend_ = std::move(backend);
+}
+
+void ImageDecoder::SetDecodesToYUVPlanes(bool decodes_to_yuv_planes) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  decodes_to_yuv_planes_ = decodes_to_yuv_planes;
+}
+
+void ImageDecoder::SetEncoderBackend(
+    std::shared_ptr<ImageEncoderBackend> backend) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  encoder_backend_ = std::move(backend);
+}
+
+std::shared_ptr<ImageEncoderBackend> ImageDecoder::GetEncoderBackend() const {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  return encoder_backend_;
+}
+
 fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
@@ -15,15 +15,39 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
+#include "flutter/lib/ui/painting/image_encoding.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
 
+// A platform specific decoder that image decoders try before the Skia software
+// codecs, e.g. to use the hardware decoders of the platform. Backends are
+// called concurrently from multiple worker threads and must be thread safe.
+class ImageDecoderBackend {
+ public:
+  virtual ~ImageDecoderBackend() = default;
+
+  // Decodes the compressed image of |descriptor| at the target dimensions, or
+  // at its own dimensions if they are zero. Called on a worker thread.
+  //
+  // The result may be backed by a platform buffer that Skia can sample from
+  // without a copy, in which case it must be a texture backed or lazily
+  // generated image and is not uploaded again on the IO thread. Raster images
+  // are uploaded like the ones decoded by Skia. Returns nullptr to fall back to
+  // the Skia codecs, e.g. for formats the hardware decoders cannot handle.
+  virtual sk_sp<SkImage> Decode(ImageDescriptor* descriptor,
+                                uint32_t target_width,
+                                uint32_t target_height,
+                                const fml::tracing::TraceFlow& flow) = 0;
+};
+
 // An object that coordinates image decompression and texture upload across
 // multiple threads/components in the shell. This object must be created,
 // accessed and collected on the UI thread (typically the engine or its runtime
@@ -50,12 +74,50 @@ class ImageDecoder {
               uint32_t target_height,
               const ImageResult& result);
 
+  // Like |Decode|, but only decodes the given |subset| of the image if there is
+  // one. The target dimensions then apply to the subset, defaulting to its
+  // dimensions if they are zero. For the codecs that support it, only the part
+  // of the encoded image covering the subset is decoded.
+  void Decode(fml::RefPtr<ImageDescriptor> descriptor,
+              uint32_t target_width,
+              uint32_t target_height,
+              std::optional<SkIRect> subset,
+              const ImageResult& result);
+
+  // Shares the images decoded from compressed data through |cache|, so that
+  // decoding the same data at the same size again returns the cached image
+  // instead of decoding it again. Passing nullptr stops using a cache.
+  void SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache);
+
+  // Tries |backend| before the Skia codecs when decoding whole images from
+  // compressed data. Passing nullptr only uses the Skia codecs.
+  void SetBackend(std::shared_ptr<ImageDecoderBackend> backend);
+
+  // Decodes whole images from compressed data into their YUV planes when the
+  // codec supports it and no resize is needed. The result is a lazily
+  // generated image, which Skia uploads plane by plane and converts to RGB on
+  // the GPU when it is first drawn, instead of an RGBA texture uploaded on the
+  // IO thread.
+  void SetDecodesToYUVPlanes(bool decodes_to_yuv_planes);
+
+  // Tries |backend| before the Skia encoders when encoding images with
+  // |Image.toByteData|. The encoder backend lives here as this is the image
+  // state of the engine that dart:ui can reach. Passing nullptr only uses the
+  // Skia encoders.
+  void SetEncoderBackend(std::shared_ptr<ImageEncoderBackend> backend);
+
+  std::shared_ptr<ImageEncoderBackend> GetEncoderBackend() const;
+
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
  private:
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  std::shared_ptr<DecodedImageCache> decoded_image_cache_;
+  std::shared_ptr<ImageDecoderBackend> backend_;
+  std::shared_ptr<ImageEncoderBackend> encoder_backend_;
+  bool decodes_to_yuv_planes_ = false;
   fml::WeakPtrFactory<ImageDecoder> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoder);
@@ -66,6 +128,22 @@ sk_sp<SkImage> ImageFromCompressedData(ImageDescriptor* descriptor,
                                        uint32_t target_height,
                                        const fml::tracing::TraceFlow& flow);
 
+// Decodes the compressed image of |descriptor| into its YUV planes, and returns
+// a lazily generated image that draws them. Returns nullptr if the codec cannot
+// decode the image into planes, or if a resize or reorientation is needed,
+// which the planes do not support.
+sk_sp<SkImage> YUVImageFromCompressedData(ImageDescriptor* descriptor,
+                                          uint32_t target_width,
+                                          uint32_t target_height,
+                                          const fml::tracing::TraceFlow& flow);
+
+sk_sp<SkImage> ImageSubsetFromCompressedData(
+    ImageDescriptor* descriptor,
+    const SkIRect& subset,
+    uint32_t target_width,
+    uint32_t target_height,
+    const fml::tracing::TraceFlow& flow);
+
 }  // namespace flutter
 
 #endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
@@ -0,0 +1,246 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
+#include "flutter/lib/ui/painting/test_io_manager.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColor.h"
+
+#include <vector>
+
+namespace flutter {
+namespace testing {
+
+static void PostTaskSync(const fml::RefPtr<fml::TaskRunner>& task_runner,
+                         const fml::closure& task) {
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(task_runner, [&latch, &task]() {
+    task();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+// Owns the threads, the worker pool, the IO manager and the image decoder the
+// benchmarks decode on, like the shell does for a running engine.
+class ImageDecoderBenchmarkHarness {
+ public:
+  ImageDecoderBenchmarkHarness()
+      : thread_host_("image_decoder_benchmarks",
+                     ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                         ThreadHost::Type::IO | ThreadHost::Type::UI),
+        task_runners_("image_decoder_benchmarks",
+                      thread_host_.platform_thread->GetTaskRunner(),
+                      thread_host_.raster_thread->GetTaskRunner(),
+                      thread_host_.ui_thread->GetTaskRunner(),
+                      thread_host_.io_thread->GetTaskRunner()),
+        loop_(fml::ConcurrentMessageLoop::Create()) {
+    PostTaskSync(task_runners_.GetIOTaskRunner(), [&]() {
+      io_manager_ =
+          std::make_unique<TestIOManager>(task_runners_.GetIOTaskRunner());
+    });
+    PostTaskSync(task_runners_.GetUITaskRunner(), [&]() {
+      decoder_ = std::make_unique<ImageDecoder>(
+          task_runners_, loop_->GetTaskRunner(),
+          io_manager_->GetWeakIOManager());
+    });
+  }
+
+  ~ImageDecoderBenchmarkHarness() {
+    PostTaskSync(task_runners_.GetUITaskRunner(), [&]() { decoder_.reset(); });
+    PostTaskSync(task_runners_.GetIOTaskRunner(),
+                 [&]() { io_manager_.reset(); });
+  }
+
+  size_t GetWorkerCount() const { return loop_->GetWorkerCount(); }
+
+  // Decodes all the |descriptors| concurrently at the target dimensions, or at
+  // their own dimensions if zero, and waits for the images to be uploaded.
+  // Returns the total number of bytes of the decoded images, all of which are
+  // alive at the same time, or zero if any of them failed to decode.
+  size_t DecodeAll(const std::vector<fml::RefPtr<ImageDescriptor>>& descriptors,
+                   uint32_t target_width,
+                   uint32_t target_height) {
+    fml::AutoResetWaitableEvent latch;
+    size_t pending = descriptors.size();
+    size_t decoded_bytes = 0;
+    bool failed = false;
+    std::vector<SkiaGPUObject<SkImage>> images;
+    task_runners_.GetUITaskRunner()->PostTask([&]() {
+      for (const auto& descriptor : descriptors) {
+        decoder_->Decode(
+            descriptor,
+            target_width == 0 ? descriptor->width() : target_width,
+            target_height == 0 ? descriptor->height() : target_height,
+            [&](SkiaGPUObject<SkImage> image) {
+              if (image.get()) {
+                decoded_bytes += image.get()->imageInfo().computeMinByteSize();
+                images.push_back(std::move(image));
+              } else {
+                failed = true;
+              }
+              if (--pending == 0) {
+                // The images are collected on the UI thread as they would be
+                // by the Dart objects wrapping them.
+                images.clear();
+                latch.Signal();
+              }
+            });
+      }
+    });
+    latch.Wait();
+    return failed ? 0 : decoded_bytes;
+  }
+
+ private:
+  ThreadHost thread_host_;
+  TaskRunners task_runners_;
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop_;
+  std::unique_ptr<TestIOManager> io_manager_;
+  std::unique_ptr<ImageDecoder> decoder_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoderBenchmarkHarness);
+};
+
+static sk_sp<SkData> OpenFixtureAsSkData(const char* name) {
+  auto mapping = OpenFixtureAsMapping(name);
+  if (!mapping) {
+    return nullptr;
+  }
+  return SkData::MakeWithCopy(mapping->GetMapping(), mapping->GetSize());
+}
+
+// Encodes a square gradient with some noise, so that the encoders cannot
+// compress it away and decoding it costs about as much as decoding a photo of
+// the same size.
+static sk_sp<SkData> EncodeSyntheticImage(int side,
+                                          SkEncodedImageFormat format) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(side, side, /*isOpaque=*/true);
+  uint32_t seed = 1;
+  for (int y = 0; y < side; y++) {
+    for (int x = 0; x < side; x++) {
+      seed = seed * 1664525u + 1013904223u;
+      uint8_t noise = (seed >> 24) & 0x3F;
+      *bitmap.getAddr32(x, y) = SkPreMultiplyARGB(
+          0xFF, (x * 0xFF / side) ^ noise, (y * 0xFF / side) ^ noise, noise);
+    }
+  }
+  return SkImage::MakeFromBitmap(bitmap)->encodeToData(format, 90);
+}
+
+// Creates the descriptor the way |ImageDescriptor::initEncoded| does when an
+// image codec is instantiated from Dart.
+static fml::RefPtr<ImageDescriptor> CreateDescriptor(sk_sp<SkData> data) {
+  std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+  FML_CHECK(codec);
+  return fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                              std::move(codec));
+}
+
+static void RunDecodeBenchmark(benchmark::State& state,
+                               const sk_sp<SkData>& data,
+                               size_t concurrent_decodes,
+                               uint32_t target_width,
+                               uint32_t target_height) {
+  FML_CHECK(data);
+  ImageDecoderBenchmarkHarness harness;
+  size_t decoded_bytes = 0;
+  while (state.KeepRunning()) {
+    std::vector<fml::RefPtr<ImageDescriptor>> descriptors;
+    for (size_t i = 0; i < concurrent_decodes; i++) {
+      descriptors.push_back(CreateDescriptor(data));
+    }
+    decoded_bytes = harness.DecodeAll(descriptors, target_width, target_height);
+    if (decoded_bytes == 0) {
+      state.SkipWithError("Could not decode the image.");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * concurrent_decodes *
+                          data->size());
+  state.SetItemsProcessed(state.iterations() * concurrent_decodes);
+  // The decoded images of an iteration are all alive at the same time, which
+  // makes them the peak memory used by the textures the decodes result in.
+  state.counters["PeakDecodedBytes"] = decoded_bytes;
+  state.counters["Workers"] = harness.GetWorkerCount();
+}
+
+// Decodes and uploads one of the fixtures at its own size, for every format
+// the engine decodes with the Skia codecs.
+static void BM_ImageDecodeFixture(benchmark::State& state,
+                                  const char* fixture) {
+  RunDecodeBenchmark(state, OpenFixtureAsSkData(fixture), 1, 0, 0);
+}
+
+// Decodes and uploads a synthetic square image of |state.range(0)| pixels a
+// side, to see how decode latency scales with the image size per format.
+static void BM_ImageDecodeSize(benchmark::State& state,
+                               SkEncodedImageFormat format) {
+  RunDecodeBenchmark(state, EncodeSyntheticImage(state.range(0), format), 1, 0,
+                     0);
+}
+
+// Decodes a 3024x4032 photo at a |state.range(0)|th of its size, as requested
+// with the target dimensions of |ImageDescriptor.instantiateCodec|. The JPEG
+// codec can scale while decoding, so this compares the cost of the downscaled
+// decodes to the full size one.
+static void BM_ImageDecodeDownscaled(benchmark::State& state) {
+  auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  FML_CHECK(data);
+  auto descriptor = CreateDescriptor(data);
+  RunDecodeBenchmark(state, data, 1, descriptor->width() / state.range(0),
+                     descriptor->height() / state.range(0));
+}
+
+// Decodes |state.range(0)| images at once, to measure the throughput of the
+// worker pool and the serialization of the uploads on the IO thread.
+static void BM_ImageDecodeConcurrent(benchmark::State& state) {
+  RunDecodeBenchmark(state,
+                     EncodeSyntheticImage(1024, SkEncodedImageFormat::kJPEG),
+                     state.range(0), 0, 0);
+}
+
+BENCHMARK_CAPTURE(BM_ImageDecodeFixture, JPEG, "DashInNooglerHat.jpg")
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageDecodeFixture, PNG, "Horizontal.png")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecodeFixture, GIF, "hello_loop_2.gif")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecodeFixture, WebP, "hello_loop_2.webp")
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_ImageDecodeSize, JPEG, SkEncodedImageFormat::kJPEG)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecodeSize, PNG, SkEncodedImageFormat::kPNG)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecodeSize, WebP, SkEncodedImageFormat::kWEBP)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ImageDecodeDownscaled)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_ImageDecodeConcurrent)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace testing
+}  // namespace flutter
@@ -8,90 +8,19 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
+#include "flutter/lib/ui/painting/test_io_manager.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/fixture_test.h"
 #include "flutter/testing/test_dart_native_resolver.h"
-#include "flutter/testing/test_gl_surface.h"
 #include "flutter/testing/testing.h"
 #include "third_party/skia/include/codec/SkCodec.h"
 
 namespace flutter {
 namespace testing {
 
-class TestIOManager final : public IOManager {
- public:
-  explicit TestIOManager(fml::RefPtr<fml::TaskRunner> task_runner,
-                         bool has_gpu_context = true)
-      : gl_surface_(SkISize::Make(1, 1)),
-        gl_context_(has_gpu_context ? gl_surface_.CreateGrContext() : nullptr),
-        weak_gl_context_factory_(
-            has_gpu_context
-                ? std::make_unique<fml::WeakPtrFactory<GrDirectContext>>(
-                      gl_context_.get())
-                : nullptr),
-        unref_queue_(fml::MakeRefCounted<SkiaUnrefQueue>(
-            task_runner,
-            fml::TimeDelta::FromNanoseconds(0))),
-        runner_(task_runner),
-        is_gpu_disabled_sync_switch_(std::make_shared<fml::SyncSwitch>()),
-        weak_factory_(this) {
-    FML_CHECK(task_runner->RunsTasksOnCurrentThread())
-        << "The IO manager must be initialized its primary task runner. The "
-           "test harness may not be set up correctly/safely.";
-    weak_prototype_ = weak_factory_.GetWeakPtr();
-  }
-
-  ~TestIOManager() override {
-    fml::AutoResetWaitableEvent latch;
-    fml::TaskRunner::RunNowOrPostTask(runner_,
-                                      [&latch, queue = unref_queue_]() {
-                                        queue->Drain();
-                                        latch.Signal();
-                                      });
-    latch.Wait();
-  }
-
-  // |IOManager|
-  fml::WeakPtr<IOManager> GetWeakIOManager() const override {
-    return weak_prototype_;
-  }
-
-  // |IOManager|
-  fml::WeakPtr<GrDirectContext> GetResourceContext() const override {
-    return weak_gl_context_factory_ ? weak_gl_context_factory_->GetWeakPtr()
-                                    : fml::WeakPtr<GrDirectContext>{};
-  }
-
-  // |IOManager|
-  fml::RefPtr<flutter::SkiaUnrefQueue> GetSkiaUnrefQueue() const override {
-    return unref_queue_;
-  }
-
-  // |IOManager|
-  std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch() override {
-    did_access_is_gpu_disabled_sync_switch_ = true;
-    return is_gpu_disabled_sync_switch_;
-  }
-
-  bool did_access_is_gpu_disabled_sync_switch_ = false;
-
- private:
-  TestGLSurface gl_surface_;
-  sk_sp<GrDirectContext> gl_context_;
-  std::unique_ptr<fml::WeakPtrFactory<GrDirectContext>>
-      weak_gl_context_factory_;
-  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
-  fml::WeakPtr<TestIOManager> weak_prototype_;
-  fml::RefPtr<fml::TaskRunner> runner_;
-  std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
-  fml::WeakPtrFactory<TestIOManager> weak_factory_;
-
-  FML_DISALLOW_COPY_AND_ASSIGN(TestIOManager);
-};
-
 static sk_sp<SkData> OpenFixtureAsSkData(const char* name) {
   auto fixtures_directory =
       fml::OpenDirectory(GetFixturesPath(), false, fml::FilePermission::kRead);
@@ -343,6 +272,100 @@ TEST_F(ImageDecoderFixtureTest, CanDecodeWithoutAGPUContext) {
   latch.Wait();
 }
 
+class TestImageDecoderBackend final : public ImageDecoderBackend {
+ public:
+  explicit TestImageDecoderBackend(bool can_decode) : can_decode_(can_decode) {}
+
+  // |ImageDecoderBackend|
+  sk_sp<SkImage> Decode(ImageDescriptor* descriptor,
+                        uint32_t target_width,
+                        uint32_t target_height,
+                        const fml::tracing::TraceFlow& flow) override {
+    decode_count_++;
+    if (!can_decode_) {
+      return nullptr;
+    }
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(target_width, target_height);
+    bitmap.eraseColor(SK_ColorRED);
+    bitmap.setImmutable();
+    decoded_image_ = SkImage::MakeFromBitmap(bitmap);
+    return decoded_image_;
+  }
+
+  int decode_count() const { return decode_count_; }
+
+  sk_sp<SkImage> decoded_image() const { return decoded_image_; }
+
+ private:
+  const bool can_decode_;
+  int decode_count_ = 0;
+  sk_sp<SkImage> decoded_image_;
+};
+
+TEST_F(ImageDecoderFixtureTest, TriesBackendBeforeSkiaCodecs) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+
+  std::unique_ptr<IOManager> io_manager;
+  runners.GetIOTaskRunner()->PostTask([&]() {
+    io_manager =
+        std::make_unique<TestIOManager>(runners.GetIOTaskRunner(), false);
+    latch.Signal();
+  });
+  latch.Wait();
+
+  std::unique_ptr<ImageDecoder> image_decoder;
+  sk_sp<SkImage> decoded_image;
+  auto decode = [&](std::shared_ptr<ImageDecoderBackend> backend) {
+    runners.GetUITaskRunner()->PostTask([&]() {
+      image_decoder = std::make_unique<ImageDecoder>(
+          runners, loop->GetTaskRunner(), io_manager->GetWeakIOManager());
+      image_decoder->SetBackend(backend);
+
+      auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+      ASSERT_TRUE(data);
+      auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+          data, SkCodec::MakeFromData(data));
+
+      image_decoder->Decode(descriptor, 10, 20,
+                            [&](SkiaGPUObject<SkImage> image) {
+                              decoded_image = image.get();
+                              image_decoder.reset();
+                              latch.Signal();
+                            });
+    });
+    latch.Wait();
+    return decoded_image;
+  };
+
+  auto backend = std::make_shared<TestImageDecoderBackend>(true);
+  auto image = decode(backend);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image, backend->decoded_image());
+  EXPECT_EQ(backend->decode_count(), 1);
+
+  // The Skia codecs are used when the backend cannot decode the image.
+  auto failing_backend = std::make_shared<TestImageDecoderBackend>(false);
+  image = decode(failing_backend);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->dimensions(), SkISize::Make(10, 20));
+  EXPECT_EQ(failing_backend->decode_count(), 1);
+
+  runners.GetIOTaskRunner()->PostTask([&]() {
+    io_manager.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 TEST_F(ImageDecoderFixtureTest, CanDecodeWithResizes) {
   const auto image_dimensions =
       SkImage::MakeFromEncoded(OpenFixtureAsSkData("DashInNooglerHat.jpg"))
@@ -592,6 +615,85 @@ TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   assert_image(decode(300, 100));
 }
 
+TEST(ImageDecoderTest, CanDecodeToYUVPlanes) {
+  auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  auto codec = SkCodec::MakeFromData(data);
+  ASSERT_TRUE(codec);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(codec));
+
+  auto image = YUVImageFromCompressedData(
+      descriptor.get(), descriptor->width(), descriptor->height(),
+      fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(image != nullptr);
+  EXPECT_TRUE(image->isLazyGenerated());
+  EXPECT_EQ(image->dimensions(), descriptor->image_info().dimensions());
+
+  // Without a GPU context, the pixels are decoded from the encoded data.
+  auto raster_image = image->makeRasterImage();
+  ASSERT_TRUE(raster_image != nullptr);
+  auto expected = SkImage::MakeFromEncoded(data)->makeRasterImage();
+  SkPixmap raster_pixmap, expected_pixmap;
+  ASSERT_TRUE(raster_image->peekPixels(&raster_pixmap));
+  ASSERT_TRUE(expected->peekPixels(&expected_pixmap));
+  ASSERT_EQ(raster_pixmap.computeByteSize(), expected_pixmap.computeByteSize());
+  EXPECT_EQ(memcmp(raster_pixmap.addr(), expected_pixmap.addr(),
+                   raster_pixmap.computeByteSize()),
+            0);
+}
+
+TEST(ImageDecoderTest, DoesNotDecodeToYUVPlanesWhenUnsupported) {
+  auto decode = [](const char* fixture, int divisor) {
+    auto data = OpenFixtureAsSkData(fixture);
+    auto codec = SkCodec::MakeFromData(data);
+    auto descriptor =
+        fml::MakeRefCounted<ImageDescriptor>(data, std::move(codec));
+    return YUVImageFromCompressedData(descriptor.get(),
+                                      descriptor->width() / divisor,
+                                      descriptor->height() / divisor,
+                                      fml::tracing::TraceFlow(""));
+  };
+
+  // The planes cannot be resized.
+  EXPECT_EQ(decode("DashInNooglerHat.jpg", 2), nullptr);
+  // Nor reoriented according to the EXIF data.
+  EXPECT_EQ(decode("Horizontal.jpg", 1), nullptr);
+  // PNGs have no YUV planes.
+  EXPECT_EQ(decode("Horizontal.png", 1), nullptr);
+}
+
+TEST(ImageDecoderTest, CanDecodeSubsets) {
+  for (const char* fixture : {"DashInNooglerHat.jpg", "Horizontal.jpg"}) {
+    auto data = OpenFixtureAsSkData(fixture);
+    auto codec = SkCodec::MakeFromData(data);
+    ASSERT_TRUE(codec);
+    auto descriptor =
+        fml::MakeRefCounted<ImageDescriptor>(data, std::move(codec));
+
+    auto decode = [descriptor](const SkIRect& subset, uint32_t target_width,
+                               uint32_t target_height) {
+      return ImageSubsetFromCompressedData(descriptor.get(), subset,
+                                           target_width, target_height,
+                                           fml::tracing::TraceFlow(""));
+    };
+
+    const SkIRect subset = SkIRect::MakeXYWH(100, 50, 160, 120);
+    auto image = decode(subset, 0, 0);
+    ASSERT_TRUE(image != nullptr) << fixture;
+    EXPECT_EQ(image->dimensions(), SkISize::Make(160, 120)) << fixture;
+
+    image = decode(subset, 40, 30);
+    ASSERT_TRUE(image != nullptr) << fixture;
+    EXPECT_EQ(image->dimensions(), SkISize::Make(40, 30)) << fixture;
+
+    const SkISize dimensions = descriptor->image_info().dimensions();
+    EXPECT_EQ(decode(SkIRect::MakeXYWH(dimensions.width() - 10, 0, 20, 20),
+                     0, 0),
+              nullptr)
+        << fixture;
+  }
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecCanBeCollectedBeforeIOTasksFinish) {
   // This test verifies that the MultiFrameCodec safely shares state between
@@ -54,6 +54,12 @@ const SkImageInfo ImageDescriptor::CreateImageInfo() const {
   if (platform_image_generator_) {
     return platform_image_generator_->getInfo();
   }
+  if (compressed_texture_) {
+    return SkImageInfo::MakeN32(compressed_texture_->dimensions,
+                                compressed_texture_->has_alpha()
+                                    ? kPremul_SkAlphaType
+                                    : kOpaque_SkAlphaType);
+  }
   return SkImageInfo::MakeUnknown();
 }
 
@@ -85,6 +91,15 @@ ImageDescriptor::ImageDescriptor(sk_sp<SkData> buffer,
       image_info_(CreateImageInfo()),
       row_bytes_(std::nullopt) {}
 
+ImageDescriptor::ImageDescriptor(sk_sp<SkData> buffer,
+                                 CompressedTexture compressed_texture)
+    : buffer_(std::move(buffer)),
+      generator_(nullptr),
+      platform_image_generator_(nullptr),
+      compressed_texture_(std::move(compressed_texture)),
+      image_info_(CreateImageInfo()),
+      row_bytes_(std::nullopt) {}
+
 void ImageDescriptor::initEncoded(Dart_NativeArguments args) {
   Dart_Handle callback_handle = Dart_GetNativeArgument(args, 2);
   if (!Dart_IsClosure(callback_handle)) {
@@ -104,11 +119,19 @@ void ImageDescriptor::initEncoded(Dart_NativeArguments args) {
   }
 
   // This call will succeed if Skia has a built-in codec for this.
-  // If it fails, we will check if the platform knows how to decode this image.
+  // If it fails, we will check if this is a GPU compressed texture, and then if
+  // the platform knows how to decode this image.
   std::unique_ptr<SkCodec> codec =
       SkCodec::MakeFromData(immutable_buffer->data());
   fml::RefPtr<ImageDescriptor> descriptor;
-  if (!codec) {
+  if (codec) {
+    descriptor = fml::MakeRefCounted<ImageDescriptor>(immutable_buffer->data(),
+                                                      std::move(codec));
+  } else if (auto compressed_texture =
+                 ReadKTXTexture(immutable_buffer->data())) {
+    descriptor = fml::MakeRefCounted<ImageDescriptor>(
+        immutable_buffer->data(), std::move(*compressed_texture));
+  } else {
     std::unique_ptr<SkImageGenerator> generator =
         PLATFORM_IMAGE_GENERATOR(immutable_buffer->data());
     if (!generator) {
@@ -119,9 +142,6 @@ void ImageDescriptor::initEncoded(Dart_NativeArguments args) {
     }
     descriptor = fml::MakeRefCounted<ImageDescriptor>(immutable_buffer->data(),
                                                       std::move(generator));
-  } else {
-    descriptor = fml::MakeRefCounted<ImageDescriptor>(immutable_buffer->data(),
-                                                      std::move(codec));
   }
 
   FML_DCHECK(descriptor);
@@ -156,12 +176,21 @@ void ImageDescriptor::initRaw(Dart_Handle descriptor_handle,
 
 void ImageDescriptor::instantiateCodec(Dart_Handle codec_handle,
                                        int target_width,
-                                       int target_height) {
+                                       int target_height,
+                                       int subset_left,
+                                       int subset_top,
+                                       int subset_width,
+                                       int subset_height) {
+  std::optional<SkIRect> subset;
+  if (subset_width > 0 && subset_height > 0) {
+    subset = SkIRect::MakeXYWH(subset_left, subset_top, subset_width,
+                               subset_height);
+  }
   fml::RefPtr<Codec> ui_codec;
   if (!generator_ || generator_->getFrameCount() == 1) {
     ui_codec = fml::MakeRefCounted<SingleFrameCodec>(
         static_cast<fml::RefPtr<ImageDescriptor>>(this), target_width,
-        target_height);
+        target_height, subset);
   } else {
     ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_);
   }
@@ -190,6 +219,12 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
     return generator_->getPixels(pixmap.info(), pixmap.writable_addr(),
                                  pixmap.rowBytes());
   }
+  if (compressed_texture_) {
+    sk_sp<SkImage> image = SkImage::MakeRasterFromCompressed(
+        compressed_texture_->data, compressed_texture_->dimensions.width(),
+        compressed_texture_->dimensions.height(), compressed_texture_->type);
+    return image && image->readPixels(pixmap, 0, 0);
+  }
   FML_DCHECK(platform_image_generator_);
   return platform_image_generator_->getPixels(pixmap);
 }
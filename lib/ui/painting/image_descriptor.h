@@ -11,6 +11,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/painting/compressed_texture.h"
 #include "flutter/lib/ui/painting/immutable_buffer.h"
 #include "third_party/skia/include/codec/SkCodec.h"
 #include "third_party/skia/include/core/SkImageGenerator.h"
@@ -54,7 +55,17 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
                       PixelFormat pixel_format);
 
   /// Associates a flutter::Codec object with the dart.ui Codec handle.
-  void instantiateCodec(Dart_Handle codec, int target_width, int target_height);
+  ///
+  /// If |subset_width| and |subset_height| are positive, single frame images
+  /// only decode that subset of the image, and the target dimensions apply to
+  /// the subset.
+  void instantiateCodec(Dart_Handle codec,
+                        int target_width,
+                        int target_height,
+                        int subset_left,
+                        int subset_top,
+                        int subset_width,
+                        int subset_height);
 
   /// The width of this image, EXIF oriented if applicable.
   int width() const { return image_info_.width(); }
@@ -85,7 +96,16 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   sk_sp<SkImage> image() const;
 
   /// Whether this descriptor represents compressed (encoded) data or not.
-  bool is_compressed() const { return generator_ || platform_image_generator_; }
+  bool is_compressed() const {
+    return generator_ || platform_image_generator_ ||
+           compressed_texture_.has_value();
+  }
+
+  /// The GPU compressed texture this image was read from, if any. Its pixels
+  /// are decoded on the CPU for the GPUs that do not support its format.
+  const CompressedTexture* compressed_texture() const {
+    return compressed_texture_ ? &compressed_texture_.value() : nullptr;
+  }
 
   /// The orientation corrected image info for this image.
   const SkImageInfo& image_info() const { return image_info_; }
@@ -122,10 +142,12 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ImageDescriptor(sk_sp<SkData> buffer, std::unique_ptr<SkCodec> codec);
   ImageDescriptor(sk_sp<SkData> buffer,
                   std::unique_ptr<SkImageGenerator> generator);
+  ImageDescriptor(sk_sp<SkData> buffer, CompressedTexture compressed_texture);
 
   sk_sp<SkData> buffer_;
   std::shared_ptr<SkCodecImageGenerator> generator_;
   std::unique_ptr<SkImageGenerator> platform_image_generator_;
+  std::optional<CompressedTexture> compressed_texture_;
   const SkImageInfo image_info_;
   std::optional<size_t> row_bytes_;
 
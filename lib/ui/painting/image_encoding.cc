@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_encoding.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -12,11 +13,16 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/encode/SkJpegEncoder.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
+#include "third_party/skia/include/encode/SkWebpEncoder.h"
 #include "third_party/tonic/dart_persistent_value.h"
 #include "third_party/tonic/logging/dart_invoke.h"
 #include "third_party/tonic/typed_data/typed_list.h"
@@ -33,8 +39,17 @@ enum ImageByteFormat {
   kRawRGBA,
   kRawUnmodified,
   kPNG,
+  kJPEG,
+  kWEBP,
 };
 
+// The zlib level that PNG images are encoded with by default, which is the
+// one Skia uses.
+constexpr int kDefaultPNGLevel = 6;
+
+// The quality that the lossy formats are encoded with by default.
+constexpr int kDefaultLossyQuality = 90;
+
 void FinalizeSkData(void* isolate_callback_data, void* peer) {
   SkData* buffer = reinterpret_cast<SkData*>(peer);
   buffer->unref();
@@ -129,24 +144,33 @@ void ConvertImageToRaster(sk_sp<SkImage> image,
   // Cross-context images do not support makeRasterImage. Convert these images
   // by drawing them into a surface.  This must be done on the raster thread
   // to prevent concurrent usage of the image on both the IO and raster threads.
+  // The pixels are read back asynchronously, so that the raster thread keeps
+  // drawing frames while they are transferred from the GPU.
   raster_task_runner->PostTask([image, encode_task = std::move(encode_task),
                                 resource_context, snapshot_delegate,
-                                io_task_runner]() {
-    sk_sp<SkImage> raster_image =
-        snapshot_delegate->ConvertToRasterImage(image);
-
-    io_task_runner->PostTask([image, encode_task = std::move(encode_task),
-                              raster_image = std::move(raster_image),
-                              resource_context]() mutable {
-      if (!raster_image) {
-        // The rasterizer was unable to render the cross-context image
-        // (presumably because it does not have a GrContext).  In that case,
-        // convert the image on the IO thread using the resource context.
-        raster_image =
-            ConvertToRasterUsingResourceContext(image, resource_context);
-      }
-      encode_task(raster_image);
-    });
+                                io_task_runner]() mutable {
+    auto on_raster_image = [image, encode_task = std::move(encode_task),
+                            resource_context,
+                            io_task_runner](sk_sp<SkImage> raster_image) {
+      io_task_runner->PostTask([image, encode_task = std::move(encode_task),
+                                raster_image = std::move(raster_image),
+                                resource_context]() mutable {
+        if (!raster_image) {
+          // The rasterizer was unable to render the cross-context image
+          // (presumably because it does not have a GrContext).  In that case,
+          // convert the image on the IO thread using the resource context.
+          raster_image =
+              ConvertToRasterUsingResourceContext(image, resource_context);
+        }
+        encode_task(raster_image);
+      });
+    };
+    if (!snapshot_delegate) {
+      on_raster_image(nullptr);
+      return;
+    }
+    snapshot_delegate->ConvertToRasterImageAsync(image,
+                                                 std::move(on_raster_image));
   });
 }
 
@@ -186,7 +210,52 @@ sk_sp<SkData> CopyImageByteData(sk_sp<SkImage> raster_image,
   return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
 }
 
-sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image, ImageByteFormat format) {
+// Encodes |raster_image| to a compressed format with |backend| if it can,
+// and with the Skia encoders otherwise.
+sk_sp<SkData> CompressImage(sk_sp<SkImage> raster_image,
+                            SkEncodedImageFormat format,
+                            int quality,
+                            ImageEncoderBackend* backend) {
+  SkPixmap pixmap;
+  if (!raster_image->peekPixels(&pixmap)) {
+    FML_LOG(ERROR) << "Could not read the pixels of the raster image.";
+    return nullptr;
+  }
+
+  if (backend) {
+    if (sk_sp<SkData> encoded = backend->Encode(pixmap, format, quality)) {
+      return encoded;
+    }
+  }
+
+  SkDynamicMemoryWStream stream;
+  bool encoded = false;
+  switch (format) {
+    case SkEncodedImageFormat::kPNG: {
+      SkPngEncoder::Options options;
+      options.fZLibLevel = quality;
+      encoded = SkPngEncoder::Encode(&stream, pixmap, options);
+    } break;
+    case SkEncodedImageFormat::kJPEG: {
+      SkJpegEncoder::Options options;
+      options.fQuality = quality;
+      encoded = SkJpegEncoder::Encode(&stream, pixmap, options);
+    } break;
+    case SkEncodedImageFormat::kWEBP: {
+      SkWebpEncoder::Options options;
+      options.fQuality = quality;
+      encoded = SkWebpEncoder::Encode(&stream, pixmap, options);
+    } break;
+    default:
+      break;
+  }
+  return encoded ? stream.detachAsData() : nullptr;
+}
+
+sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image,
+                          ImageByteFormat format,
+                          int quality,
+                          ImageEncoderBackend* backend) {
   TRACE_EVENT0("flutter", __FUNCTION__);
 
   if (!raster_image) {
@@ -195,8 +264,9 @@ sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image, ImageByteFormat format) {
 
   switch (format) {
     case kPNG: {
-      auto png_image =
-          raster_image->encodeToData(SkEncodedImageFormat::kPNG, 0);
+      auto png_image = CompressImage(
+          raster_image, SkEncodedImageFormat::kPNG,
+          quality < 0 ? kDefaultPNGLevel : std::min(quality, 9), backend);
 
       if (png_image == nullptr) {
         FML_LOG(ERROR) << "Could not convert raster image to PNG.";
@@ -204,6 +274,21 @@ sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image, ImageByteFormat format) {
       };
       return png_image;
     } break;
+    case kJPEG:
+    case kWEBP: {
+      auto encoded_image = CompressImage(
+          raster_image,
+          format == kJPEG ? SkEncodedImageFormat::kJPEG
+                          : SkEncodedImageFormat::kWEBP,
+          quality < 0 ? kDefaultLossyQuality : std::min(quality, 100), backend);
+
+      if (encoded_image == nullptr) {
+        FML_LOG(ERROR) << "Could not convert raster image to "
+                       << (format == kJPEG ? "JPEG." : "WebP.");
+        return nullptr;
+      };
+      return encoded_image;
+    } break;
     case kRawRGBA: {
       return CopyImageByteData(raster_image, kRGBA_8888_SkColorType);
     } break;
@@ -220,9 +305,12 @@ void EncodeImageAndInvokeDataCallback(
     sk_sp<SkImage> image,
     std::unique_ptr<DartPersistentValue> callback,
     ImageByteFormat format,
+    int quality,
+    std::shared_ptr<ImageEncoderBackend> backend,
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
     fml::RefPtr<fml::TaskRunner> raster_task_runner,
     fml::RefPtr<fml::TaskRunner> io_task_runner,
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     GrDirectContext* resource_context,
     fml::WeakPtr<SnapshotDelegate> snapshot_delegate) {
   auto callback_task = fml::MakeCopyable(
@@ -230,13 +318,25 @@ void EncodeImageAndInvokeDataCallback(
         InvokeDataCallback(std::move(callback), std::move(encoded));
       });
 
+  // The images are encoded on the worker threads when there are some, so that
+  // encoding several images at once does not serialize them on the IO thread.
   auto encode_task = [callback_task = std::move(callback_task), format,
-                      ui_task_runner](sk_sp<SkImage> raster_image) {
-    sk_sp<SkData> encoded = EncodeImage(std::move(raster_image), format);
-    ui_task_runner->PostTask([callback_task = std::move(callback_task),
-                              encoded = std::move(encoded)]() mutable {
-      callback_task(std::move(encoded));
-    });
+                      quality, backend, ui_task_runner,
+                      concurrent_task_runner](sk_sp<SkImage> raster_image) {
+    auto encode = [callback_task, format, quality, backend, ui_task_runner,
+                   raster_image = std::move(raster_image)]() mutable {
+      sk_sp<SkData> encoded = EncodeImage(std::move(raster_image), format,
+                                          quality, backend.get());
+      ui_task_runner->PostTask([callback_task = std::move(callback_task),
+                                encoded = std::move(encoded)]() mutable {
+        callback_task(std::move(encoded));
+      });
+    };
+    if (concurrent_task_runner) {
+      concurrent_task_runner->PostTask(std::move(encode));
+    } else {
+      encode();
+    }
   };
 
   ConvertImageToRaster(std::move(image), encode_task, raster_task_runner,
@@ -247,6 +347,7 @@ void EncodeImageAndInvokeDataCallback(
 
 Dart_Handle EncodeImage(CanvasImage* canvas_image,
                         int format,
+                        int quality,
                         Dart_Handle callback_handle) {
   if (!canvas_image) {
     return ToDart("encode called with non-genuine Image.");
@@ -261,20 +362,27 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
   auto callback = std::make_unique<DartPersistentValue>(
       tonic::DartState::Current(), callback_handle);
 
-  const auto& task_runners = UIDartState::Current()->GetTaskRunners();
+  UIDartState* dart_state = UIDartState::Current();
+  const auto& task_runners = dart_state->GetTaskRunners();
+  fml::WeakPtr<ImageDecoder> image_decoder = dart_state->GetImageDecoder();
+  std::shared_ptr<ImageEncoderBackend> backend =
+      image_decoder ? image_decoder->GetEncoderBackend() : nullptr;
 
   task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
       [callback = std::move(callback), image = canvas_image->image(),
-       image_format, ui_task_runner = task_runners.GetUITaskRunner(),
+       image_format, quality, backend = std::move(backend),
+       ui_task_runner = task_runners.GetUITaskRunner(),
        raster_task_runner = task_runners.GetRasterTaskRunner(),
        io_task_runner = task_runners.GetIOTaskRunner(),
-       io_manager = UIDartState::Current()->GetIOManager(),
-       snapshot_delegate =
-           UIDartState::Current()->GetSnapshotDelegate()]() mutable {
+       concurrent_task_runner = dart_state->GetConcurrentTaskRunner(),
+       io_manager = dart_state->GetIOManager(),
+       snapshot_delegate = dart_state->GetSnapshotDelegate()]() mutable {
         EncodeImageAndInvokeDataCallback(
-            std::move(image), std::move(callback), image_format,
-            std::move(ui_task_runner), std::move(raster_task_runner),
-            std::move(io_task_runner), io_manager->GetResourceContext().get(),
+            std::move(image), std::move(callback), image_format, quality,
+            std::move(backend), std::move(ui_task_runner),
+            std::move(raster_task_runner), std::move(io_task_runner),
+            std::move(concurrent_task_runner),
+            io_manager->GetResourceContext().get(),
             std::move(snapshot_delegate));
       }));
 
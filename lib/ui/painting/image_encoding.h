@@ -5,14 +5,37 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_H_
 
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkEncodedImageFormat.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/tonic/dart_library_natives.h"
 
 namespace flutter {
 
 class CanvasImage;
 
+// A platform specific encoder that |EncodeImage| tries before the Skia
+// encoders, e.g. to use the hardware encoders of the platform. Backends are
+// called concurrently from multiple worker threads and must be thread safe.
+class ImageEncoderBackend {
+ public:
+  virtual ~ImageEncoderBackend() = default;
+
+  // Encodes the pixels of |pixmap| to |format|. The |quality| is from 0 to 100
+  // for the lossy formats, and the zlib level from 0 to 9 for PNG.
+  // Called on a worker thread. Returns nullptr to fall back to the Skia
+  // encoders, e.g. for formats the hardware encoders cannot handle.
+  virtual sk_sp<SkData> Encode(const SkPixmap& pixmap,
+                               SkEncodedImageFormat format,
+                               int quality) = 0;
+};
+
+// Encodes |canvas_image| to |format| at |quality|, or at the default quality
+// of the format if it is negative, and invokes |callback_handle| with the
+// bytes. The image is encoded on a worker thread.
 Dart_Handle EncodeImage(CanvasImage* canvas_image,
                         int format,
+                        int quality,
                         Dart_Handle callback_handle);
 
 }  // namespace flutter
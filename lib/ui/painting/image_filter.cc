@@ -73,7 +73,7 @@ void ImageFilter::initImage(CanvasImage* image) {
 }
 
 void ImageFilter::initPicture(Picture* picture) {
-  filter_ = SkImageFilters::Picture(picture->picture());
+  filter_ = SkImageFilters::Picture(picture->ToSkPicture());
 }
 
 void ImageFilter::initBlur(double sigma_x,
@@ -6,10 +6,14 @@
 
 #include <cstring>
 
+#include "flutter/assets/asset_manager.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/lib/ui/window/platform_configuration.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
+#include "third_party/tonic/dart_persistent_value.h"
 
 #if OS_ANDROID
 #include <sys/mman.h>
@@ -28,8 +32,12 @@ FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 ImmutableBuffer::~ImmutableBuffer() {}
 
 void ImmutableBuffer::RegisterNatives(tonic::DartLibraryNatives* natives) {
-  natives->Register({{"ImmutableBuffer_init", ImmutableBuffer::init, 3, true},
-                     FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+  natives->Register(
+      {{"ImmutableBuffer_init", ImmutableBuffer::init, 3, true},
+       {"ImmutableBuffer_initFromAsset", ImmutableBuffer::initFromAsset, 3,
+        true},
+       {"ImmutableBuffer_initFromFile", ImmutableBuffer::initFromFile, 3, true},
+       FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
 void ImmutableBuffer::init(Dart_NativeArguments args) {
@@ -49,6 +57,104 @@ void ImmutableBuffer::init(Dart_NativeArguments args) {
   tonic::DartInvoke(callback_handle, {Dart_TypeVoid()});
 }
 
+void ImmutableBuffer::initFromAsset(Dart_NativeArguments args) {
+  PlatformConfiguration* platform_configuration =
+      UIDartState::Current()->platform_configuration();
+  std::shared_ptr<AssetManager> asset_manager =
+      platform_configuration
+          ? platform_configuration->client()->GetAssetManager()
+          : nullptr;
+  if (!asset_manager) {
+    Dart_SetReturnValue(args, tonic::ToDart("No asset manager is available"));
+    return;
+  }
+  // The asset is loaded on the IO thread, with the resolvers of the time of
+  // the call in case the asset manager changes in the meantime.
+  InitWithMapping(args, [resolvers = asset_manager->GetResolvers()](
+                            const std::string& asset_name) {
+    return AssetManager::FindAsMapping(resolvers, asset_name);
+  });
+}
+
+void ImmutableBuffer::initFromFile(Dart_NativeArguments args) {
+  InitWithMapping(args, [](const std::string& path)
+                            -> std::unique_ptr<fml::Mapping> {
+    return fml::FileMapping::CreateReadOnly(path);
+  });
+}
+
+void ImmutableBuffer::InitWithMapping(
+    Dart_NativeArguments args,
+    std::function<std::unique_ptr<fml::Mapping>(const std::string&)> load) {
+  Dart_Handle callback_handle = Dart_GetNativeArgument(args, 2);
+  if (!Dart_IsClosure(callback_handle)) {
+    Dart_SetReturnValue(args, tonic::ToDart("Callback must be a function"));
+    return;
+  }
+
+  Dart_Handle name_handle = Dart_GetNativeArgument(args, 1);
+  if (!Dart_IsString(name_handle)) {
+    Dart_SetReturnValue(args, tonic::ToDart("The name must be a string"));
+    return;
+  }
+  std::string name = tonic::StdStringFromDart(name_handle);
+
+  auto* dart_state = UIDartState::Current();
+  auto buffer_handle = std::make_unique<tonic::DartPersistentValue>(
+      dart_state, Dart_GetNativeArgument(args, 0));
+  auto callback = std::make_unique<tonic::DartPersistentValue>(
+      dart_state, callback_handle);
+  const auto& task_runners = dart_state->GetTaskRunners();
+
+  // Assets may need to be read or decompressed before they can be mapped, so
+  // they are loaded on the IO thread. The Dart objects are only touched on the
+  // UI thread, where the persistent handles are also released.
+  task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [name = std::move(name), load = std::move(load),
+       buffer_handle = std::move(buffer_handle),
+       callback = std::move(callback),
+       ui_task_runner = task_runners.GetUITaskRunner()]() mutable {
+        std::unique_ptr<fml::Mapping> mapping = load(name);
+        if (!mapping) {
+          FML_LOG(ERROR) << "Could not load " << name
+                         << " into an ImmutableBuffer.";
+        }
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [mapping = std::move(mapping),
+             buffer_handle = std::move(buffer_handle),
+             callback = std::move(callback)]() mutable {
+              std::shared_ptr<tonic::DartState> dart_state =
+                  callback->dart_state().lock();
+              if (!dart_state) {
+                return;
+              }
+              tonic::DartState::Scope scope(dart_state);
+              if (!mapping) {
+                tonic::DartInvoke(callback->value(), {tonic::ToDart(-1)});
+                return;
+              }
+              const size_t length = mapping->GetSize();
+              auto buffer = fml::MakeRefCounted<ImmutableBuffer>(
+                  MakeSkDataWithMapping(std::move(mapping)));
+              buffer->AssociateWithDartWrapper(buffer_handle->value());
+              tonic::DartInvoke(callback->value(), {tonic::ToDart(length)});
+            }));
+      }));
+}
+
+sk_sp<SkData> ImmutableBuffer::MakeSkDataWithMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+  if (mapping->GetSize() == 0 || mapping->GetMapping() == nullptr) {
+    return SkData::MakeEmpty();
+  }
+  const uint8_t* bytes = mapping->GetMapping();
+  const size_t length = mapping->GetSize();
+  SkData::ReleaseProc proc = [](const void* ptr, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  return SkData::MakeWithProc(bytes, length, proc, mapping.release());
+}
+
 size_t ImmutableBuffer::GetAllocationSize() const {
   return sizeof(ImmutableBuffer) + data_->size();
 }
@@ -6,8 +6,12 @@
 #define FLUTTER_LIB_UI_PAINTNIG_IMMUTABLE_BUFER_H_
 
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -39,6 +43,26 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
   /// when the copy has completed.
   static void init(Dart_NativeArguments args);
 
+  /// Initializes a new ImmutableData from an asset of the asset manager of the
+  /// engine, without copying it.
+  ///
+  /// The zero indexed argument is the caller that will be registered as the
+  /// Dart peer of the native ImmutableBuffer object.
+  ///
+  /// The first indexed argument is a String with the key of the asset.
+  ///
+  /// The second indexed argument is expected to be a callback that is invoked
+  /// with the length of the asset once it was loaded on the IO thread, or with
+  /// -1 if it could not be loaded.
+  static void initFromAsset(Dart_NativeArguments args);
+
+  /// Initializes a new ImmutableData from a file that is mapped into memory,
+  /// without copying it.
+  ///
+  /// The arguments are the same as the ones of |initFromAsset|, but the first
+  /// indexed argument is the path of the file.
+  static void initFromFile(Dart_NativeArguments args);
+
   /// The length of the data in bytes.
   size_t length() const {
     FML_DCHECK(data_);
@@ -69,6 +93,16 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
 
   static sk_sp<SkData> MakeSkDataWithCopy(const void* data, size_t length);
 
+  // Wraps |mapping| in an SkData that keeps it alive, without a copy.
+  static sk_sp<SkData> MakeSkDataWithMapping(
+      std::unique_ptr<fml::Mapping> mapping);
+
+  // Loads a mapping with |load| on the IO thread and associates the Dart
+  // wrapper of the arguments with a buffer of it on the UI thread.
+  static void InitWithMapping(
+      Dart_NativeArguments args,
+      std::function<std::unique_ptr<fml::Mapping>(const std::string&)> load);
+
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(ImmutableBuffer);
   FML_DISALLOW_COPY_AND_ASSIGN(ImmutableBuffer);
@@ -5,6 +5,8 @@
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/allocation_tags.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -12,6 +14,12 @@
 
 namespace flutter {
 
+// The number of frames decoded ahead of the calls to getNextFrame, and the
+// number of bytes they may take up. Animations with frames larger than the
+// byte budget are only decoded when the next frame is requested.
+static constexpr size_t kMaxPrefetchedFrames = 3;
+static constexpr size_t kMaxPrefetchedFrameBytes = 16 * 1024 * 1024;
+
 MultiFrameCodec::MultiFrameCodec(
     std::shared_ptr<SkCodecImageGenerator> generator)
     : state_(new State(std::move(generator))) {}
@@ -22,6 +30,9 @@ MultiFrameCodec::State::State(std::shared_ptr<SkCodecImageGenerator> generator)
     : generator_(std::move(generator)),
       frameCount_(generator_->getFrameCount()),
       repetitionCount_(generator_->getRepetitionCount()),
+      frameBytes_(generator_->getInfo()
+                      .makeColorType(kN32_SkColorType)
+                      .computeMinByteSize()),
       nextFrameIndex_(0) {}
 
 static void InvokeNextFrameCallback(
@@ -84,13 +95,13 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
   bitmap.allocPixels(info);
 
   SkCodec::Options options;
-  options.fFrameIndex = nextFrameIndex_;
+  options.fFrameIndex = nextDecodeIndex_;
   SkCodec::FrameInfo frameInfo{0};
-  generator_->getFrameInfo(nextFrameIndex_, &frameInfo);
+  generator_->getFrameInfo(nextDecodeIndex_, &frameInfo);
   const int requiredFrameIndex = frameInfo.fRequiredFrame;
   if (requiredFrameIndex != SkCodec::kNoFrame) {
     if (lastRequiredFrame_ == nullptr) {
-      FML_LOG(ERROR) << "Frame " << nextFrameIndex_ << " depends on frame "
+      FML_LOG(ERROR) << "Frame " << nextDecodeIndex_ << " depends on frame "
                      << requiredFrameIndex
                      << " and no required frames are cached.";
       return nullptr;
@@ -109,14 +120,14 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
 
   if (!generator_->getPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
                              &options)) {
-    FML_LOG(ERROR) << "Could not getPixels for frame " << nextFrameIndex_;
+    FML_LOG(ERROR) << "Could not getPixels for frame " << nextDecodeIndex_;
     return nullptr;
   }
 
   // Hold onto this if we need it to decode future frames.
   if (frameInfo.fDisposalMethod == SkCodecAnimation::DisposalMethod::kKeep) {
     lastRequiredFrame_ = std::make_unique<SkBitmap>(bitmap);
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = nextDecodeIndex_;
   }
 
   if (resourceContext) {
@@ -132,22 +143,45 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
   }
 }
 
+MultiFrameCodec::State::DecodedFrame MultiFrameCodec::State::DecodeNextFrame(
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeNextFrame");
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kImage);
+  DecodedFrame frame;
+  frame.index = nextDecodeIndex_;
+  sk_sp<SkImage> skImage = GetNextFrameImage(resourceContext);
+  if (skImage) {
+    frame.image = {std::move(skImage), std::move(unref_queue)};
+    SkCodec::FrameInfo skFrameInfo{0};
+    generator_->getFrameInfo(nextDecodeIndex_, &skFrameInfo);
+    frame.duration = skFrameInfo.fDuration;
+  }
+  nextDecodeIndex_ = (nextDecodeIndex_ + 1) % frameCount_;
+  return frame;
+}
+
 void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     std::unique_ptr<DartPersistentValue> callback,
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
     fml::WeakPtr<GrDirectContext> resourceContext,
     fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
     size_t trace_id) {
+  DecodedFrame frame;
+  if (prefetchedFrames_.empty()) {
+    frame = DecodeNextFrame(std::move(resourceContext), std::move(unref_queue));
+  } else {
+    frame = std::move(prefetchedFrames_.front());
+    prefetchedFrames_.pop_front();
+  }
+  FML_DCHECK(frame.index == nextFrameIndex_);
+
   fml::RefPtr<CanvasImage> image = nullptr;
-  int duration = 0;
-  sk_sp<SkImage> skImage = GetNextFrameImage(resourceContext);
-  if (skImage) {
+  if (frame.image.get()) {
     image = CanvasImage::Create();
-    image->set_image({skImage, std::move(unref_queue)});
-    SkCodec::FrameInfo skFrameInfo{0};
-    generator_->getFrameInfo(nextFrameIndex_, &skFrameInfo);
-    duration = skFrameInfo.fDuration;
+    image->set_image(std::move(frame.image));
   }
+  const int duration = frame.duration;
   nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   ui_task_runner->PostTask(fml::MakeCopyable([callback = std::move(callback),
@@ -158,6 +192,40 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
   }));
 }
 
+bool MultiFrameCodec::State::ShouldPrefetch() const {
+  if (prefetchPending_ || prefetchedFrames_.size() >= kMaxPrefetchedFrames ||
+      (prefetchedFrames_.size() + 1) * frameBytes_ > kMaxPrefetchedFrameBytes) {
+    return false;
+  }
+  // Animations played only once don't need the frames of the next loop.
+  return repetitionCount_ != 0 || nextDecodeIndex_ != 0;
+}
+
+void MultiFrameCodec::State::SchedulePrefetch(
+    std::shared_ptr<State> state,
+    fml::RefPtr<fml::TaskRunner> io_task_runner,
+    fml::WeakPtr<IOManager> io_manager) {
+  if (!state->ShouldPrefetch()) {
+    return;
+  }
+  state->prefetchPending_ = true;
+  io_task_runner->PostTask([weak_state = std::weak_ptr<State>(state),
+                            io_task_runner, io_manager]() {
+    auto state = weak_state.lock();
+    if (!state) {
+      return;
+    }
+    state->prefetchPending_ = false;
+    if (!io_manager || !state->ShouldPrefetch()) {
+      return;
+    }
+    DecodedFrame frame = state->DecodeNextFrame(
+        io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue());
+    state->prefetchedFrames_.push_back(std::move(frame));
+    SchedulePrefetch(std::move(state), std::move(io_task_runner), io_manager);
+  });
+}
+
 Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   static size_t trace_counter = 1;
   const size_t trace_id = trace_counter++;
@@ -175,6 +243,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
+       io_task_runner = task_runners.GetIOTaskRunner(),
        io_manager = dart_state->GetIOManager()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
@@ -186,6 +255,10 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
             std::move(callback), std::move(ui_task_runner),
             io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
             trace_id);
+        // Decode the next frames while the animation shows this one, so that
+        // they are ready by the time they are requested.
+        State::SchedulePrefetch(std::move(state), std::move(io_task_runner),
+                                std::move(io_manager));
       }));
 
   return Dart_Null();
@@ -5,7 +5,11 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 
+#include <deque>
+
+#include "flutter/flow/skia_gpu_object.h"
 #include "flutter/fml/macros.h"
+#include "flutter/lib/ui/io_manager.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "third_party/skia/src/codec/SkCodecImageGenerator.h"
 
@@ -39,29 +43,59 @@ class MultiFrameCodec : public Codec {
   struct State {
     State(std::shared_ptr<SkCodecImageGenerator> generator);
 
+    struct DecodedFrame {
+      int index = 0;
+      SkiaGPUObject<SkImage> image;
+      int duration = 0;
+    };
+
     const std::shared_ptr<SkCodecImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
+    // The size of a decoded frame.
+    const size_t frameBytes_;
 
     // The non-const members and functions below here are only read or written
     // to on the IO thread. They are not safe to access or write on the UI
     // thread.
     int nextFrameIndex_;
+    // The index of the next frame to decode. Frames are decoded in order, so
+    // this is nextFrameIndex_ plus the number of prefetched frames.
+    int nextDecodeIndex_ = 0;
     // The last decoded frame that's required to decode any subsequent frames.
     std::unique_ptr<SkBitmap> lastRequiredFrame_;
 
     // The index of the last decoded required frame.
     int lastRequiredFrameIndex_ = -1;
 
+    // The frames decoded ahead of the calls to getNextFrame, starting with the
+    // one at nextFrameIndex_. Bounded by both a number of frames and a number
+    // of bytes.
+    std::deque<DecodedFrame> prefetchedFrames_;
+    bool prefetchPending_ = false;
+
     sk_sp<SkImage> GetNextFrameImage(
         fml::WeakPtr<GrDirectContext> resourceContext);
 
+    DecodedFrame DecodeNextFrame(
+        fml::WeakPtr<GrDirectContext> resourceContext,
+        fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue);
+
     void GetNextFrameAndInvokeCallback(
         std::unique_ptr<DartPersistentValue> callback,
         fml::RefPtr<fml::TaskRunner> ui_task_runner,
         fml::WeakPtr<GrDirectContext> resourceContext,
         fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
         size_t trace_id);
+
+    bool ShouldPrefetch() const;
+
+    // Decodes the frames after the ones already decoded on the IO task runner,
+    // one frame per task so that other IO work can run in between, until the
+    // prefetched frames fill their budget.
+    static void SchedulePrefetch(std::shared_ptr<State> state,
+                                 fml::RefPtr<fml::TaskRunner> io_task_runner,
+                                 fml::WeakPtr<IOManager> io_manager);
   };
 
   // Shared across the UI and IO task runners.
@@ -7,6 +7,7 @@
 #include <cmath>
 
 #include "flutter/lib/ui/painting/matrix.h"
+#include "flutter/lib/ui/painting/path_measure.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
@@ -77,12 +78,13 @@ CanvasPath::CanvasPath()
 CanvasPath::~CanvasPath() = default;
 
 void CanvasPath::resetVolatility() {
-  if (!tracked_path_->tracking_volatility) {
-    mutable_path().setIsVolatile(true);
-    tracked_path_->frame_count = 0;
-    tracked_path_->tracking_volatility = true;
-    path_tracker_->Insert(tracked_path_);
+  if (tracked_path_->tracking_volatility) {
+    path_tracker_->MarkChanged(*tracked_path_);
+    return;
   }
+  mutable_path().setIsVolatile(true);
+  tracked_path_->tracking_volatility = true;
+  path_tracker_->Insert(tracked_path_);
 }
 
 void CanvasPath::ReleaseDartWrappableReference() const {
@@ -355,6 +357,16 @@ void CanvasPath::clone(Dart_Handle path_handle) {
 // This is doomed to be called too early, since Paths are mutable.
 // However, it can help for some of the clone/shift/transform type methods
 // where the resultant path will initially have a meaningful size.
+std::shared_ptr<ContourMeasures> CanvasPath::GetContourMeasures(
+    bool force_closed) const {
+  std::shared_ptr<ContourMeasures>& measures =
+      contour_measures_[force_closed ? 1 : 0];
+  if (!measures || measures->generation_id() != path().getGenerationID()) {
+    measures = std::make_shared<ContourMeasures>(path(), force_closed);
+  }
+  return measures;
+}
+
 size_t CanvasPath::GetAllocationSize() const {
   return sizeof(CanvasPath) + path().approximateBytesUsed();
 }
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PATH_H_
 #define FLUTTER_LIB_UI_PAINTING_PATH_H_
 
+#include <memory>
+
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/rrect.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
@@ -18,6 +20,8 @@ class DartLibraryNatives;
 
 namespace flutter {
 
+class ContourMeasures;
+
 class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(CanvasPath);
@@ -111,6 +115,15 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
 
   const SkPath& path() const { return tracked_path_->path; }
 
+  // Must be called whenever the path is drawn or clipped to, for the stats of
+  // the volatile path tracker.
+  void RecordDraw() const { path_tracker_->OnDraw(*tracked_path_); }
+
+  // Returns the measures of the contours of the path. The same measures are
+  // returned until the path is mutated, so that measuring a path again, as
+  // animations along a path do every frame, does not measure it again.
+  std::shared_ptr<ContourMeasures> GetContourMeasures(bool force_closed) const;
+
   size_t GetAllocationSize() const override;
 
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
@@ -122,6 +135,8 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
 
   std::shared_ptr<VolatilePathTracker> path_tracker_;
   std::shared_ptr<VolatilePathTracker::TrackedPath> tracked_path_;
+  // Indexed by whether the contours are force closed.
+  mutable std::shared_ptr<ContourMeasures> contour_measures_[2];
 
   // Must be called whenever the path is created or mutated.
   void resetVolatility();
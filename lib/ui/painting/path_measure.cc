@@ -30,6 +30,7 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, PathMeasure);
   V(PathMeasure, setPath)    \
   V(PathMeasure, getLength)  \
   V(PathMeasure, getPosTan)  \
+  V(PathMeasure, getPosTans) \
   V(PathMeasure, getSegment) \
   V(PathMeasure, isClosed)   \
   V(PathMeasure, nextContour)
@@ -42,17 +43,31 @@ void CanvasPathMeasure::RegisterNatives(tonic::DartLibraryNatives* natives) {
        FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
+ContourMeasures::ContourMeasures(const SkPath& path, bool force_closed)
+    : generation_id_(path.getGenerationID()), iter_(path, force_closed, 1) {}
+
+const sk_sp<SkContourMeasure>& ContourMeasures::Get(size_t index) {
+  while (!done_ && index >= measures_.size()) {
+    sk_sp<SkContourMeasure> measure = iter_.next();
+    if (measure) {
+      measures_.push_back(std::move(measure));
+    } else {
+      done_ = true;
+    }
+  }
+  static const sk_sp<SkContourMeasure> kNoMeasure;
+  return index < measures_.size() ? measures_[index] : kNoMeasure;
+}
+
 fml::RefPtr<CanvasPathMeasure> CanvasPathMeasure::Create(const CanvasPath* path,
                                                          bool forceClosed) {
   fml::RefPtr<CanvasPathMeasure> pathMeasure =
       fml::MakeRefCounted<CanvasPathMeasure>();
   if (path) {
-    const SkPath skPath = path->path();
-    SkScalar resScale = 1;
-    pathMeasure->path_measure_ =
-        std::make_unique<SkContourMeasureIter>(skPath, forceClosed, resScale);
+    pathMeasure->contours_ = path->GetContourMeasures(forceClosed);
   } else {
-    pathMeasure->path_measure_ = std::make_unique<SkContourMeasureIter>();
+    pathMeasure->contours_ =
+        std::make_shared<ContourMeasures>(SkPath(), forceClosed);
   }
   return pathMeasure;
 }
@@ -62,14 +77,22 @@ CanvasPathMeasure::CanvasPathMeasure() {}
 CanvasPathMeasure::~CanvasPathMeasure() {}
 
 void CanvasPathMeasure::setPath(const CanvasPath* path, bool isClosed) {
-  const SkPath& skPath = path->path();
-  path_measure_->reset(skPath, isClosed);
+  contours_ = path->GetContourMeasures(isClosed);
+  contour_count_ = 0;
+}
+
+const SkContourMeasure* CanvasPathMeasure::GetMeasure(int contour_index) const {
+  if (contour_index < 0 ||
+      static_cast<size_t>(contour_index) >= contour_count_) {
+    return nullptr;
+  }
+  return contours_->Get(contour_index).get();
 }
 
 float CanvasPathMeasure::getLength(int contour_index) {
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) < measures_.size()) {
-    return measures_[contour_index]->length();
+  const SkContourMeasure* measure = GetMeasure(contour_index);
+  if (measure) {
+    return measure->length();
   }
   return -1;
 }
@@ -78,14 +101,14 @@ tonic::Float32List CanvasPathMeasure::getPosTan(int contour_index,
                                                 float distance) {
   tonic::Float32List posTan(Dart_NewTypedData(Dart_TypedData_kFloat32, 5));
   posTan[0] = 0;  // dart code will check for this for failure
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) >= measures_.size()) {
+  const SkContourMeasure* measure = GetMeasure(contour_index);
+  if (!measure) {
     return posTan;
   }
 
   SkPoint pos;
   SkVector tan;
-  bool success = measures_[contour_index]->getPosTan(distance, &pos, &tan);
+  bool success = measure->getPosTan(distance, &pos, &tan);
 
   if (success) {
     posTan[0] = 1;  // dart code will check for this for success
@@ -98,18 +121,51 @@ tonic::Float32List CanvasPathMeasure::getPosTan(int contour_index,
   return posTan;
 }
 
+tonic::Float32List CanvasPathMeasure::getPosTans(
+    int contour_index,
+    tonic::Float32List& distances) {
+  // 4 floats for each distance: the position and the tangent. An empty list
+  // indicates failure to the dart code.
+  std::vector<float> pos_tans;
+  const SkContourMeasure* measure = GetMeasure(contour_index);
+  if (measure) {
+    pos_tans.resize(distances.num_elements() * 4);
+    for (intptr_t i = 0; i < distances.num_elements(); i++) {
+      SkPoint pos;
+      SkVector tan;
+      if (!measure->getPosTan(distances[i], &pos, &tan)) {
+        pos_tans.clear();
+        break;
+      }
+      pos_tans[i * 4] = pos.x();
+      pos_tans[i * 4 + 1] = pos.y();
+      pos_tans[i * 4 + 2] = tan.x();
+      pos_tans[i * 4 + 3] = tan.y();
+    }
+  }
+  distances.Release();
+
+  tonic::Float32List result(
+      Dart_NewTypedData(Dart_TypedData_kFloat32, pos_tans.size()));
+  for (size_t i = 0; i < pos_tans.size(); i++) {
+    result[i] = pos_tans[i];
+  }
+  return result;
+}
+
 void CanvasPathMeasure::getSegment(Dart_Handle path_handle,
                                    int contour_index,
                                    float start_d,
                                    float stop_d,
                                    bool start_with_move_to) {
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) >= measures_.size()) {
+  const SkContourMeasure* measure = GetMeasure(contour_index);
+  if (!measure) {
     CanvasPath::Create(path_handle);
+    return;
   }
   SkPath dst;
-  bool success = measures_[contour_index]->getSegment(start_d, stop_d, &dst,
-                                                      start_with_move_to);
+  bool success =
+      measure->getSegment(start_d, stop_d, &dst, start_with_move_to);
   if (!success) {
     CanvasPath::Create(path_handle);
   } else {
@@ -118,17 +174,16 @@ void CanvasPathMeasure::getSegment(Dart_Handle path_handle,
 }
 
 bool CanvasPathMeasure::isClosed(int contour_index) {
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) < measures_.size()) {
-    return measures_[contour_index]->isClosed();
+  const SkContourMeasure* measure = GetMeasure(contour_index);
+  if (measure) {
+    return measure->isClosed();
   }
   return false;
 }
 
 bool CanvasPathMeasure::nextContour() {
-  auto measure = path_measure_->next();
-  if (measure) {
-    measures_.push_back(std::move(measure));
+  if (contours_->Get(contour_count_)) {
+    contour_count_++;
     return true;
   }
   return false;
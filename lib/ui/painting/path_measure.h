@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PATH_MEASURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PATH_MEASURE_H_
 
+#include <memory>
 #include <vector>
 
 #include "flutter/lib/ui/dart_wrapper.h"
@@ -22,6 +23,29 @@ class DartLibraryNatives;
 
 namespace flutter {
 
+// The measures of the contours of a path. Contours are measured lazily, as
+// the path measures sharing them advance through the contours, and each is
+// measured only once.
+class ContourMeasures {
+ public:
+  ContourMeasures(const SkPath& path, bool force_closed);
+
+  // The generation id of the path the contours were measured from.
+  uint32_t generation_id() const { return generation_id_; }
+
+  // Returns the measure of the contour at index, measuring the contours up to
+  // it first if needed, or null if the path has fewer contours.
+  const sk_sp<SkContourMeasure>& Get(size_t index);
+
+ private:
+  const uint32_t generation_id_;
+  SkContourMeasureIter iter_;
+  bool done_ = false;
+  std::vector<sk_sp<SkContourMeasure>> measures_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ContourMeasures);
+};
+
 class CanvasPathMeasure : public RefCountedDartWrappable<CanvasPathMeasure> {
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(CanvasPathMeasure);
@@ -34,6 +58,8 @@ class CanvasPathMeasure : public RefCountedDartWrappable<CanvasPathMeasure> {
   void setPath(const CanvasPath* path, bool isClosed);
   float getLength(int contour_index);
   tonic::Float32List getPosTan(int contour_index, float distance);
+  tonic::Float32List getPosTans(int contour_index,
+                                tonic::Float32List& distances);
   void getSegment(Dart_Handle path_handle,
                   int contour_index,
                   float start_d,
@@ -44,13 +70,17 @@ class CanvasPathMeasure : public RefCountedDartWrappable<CanvasPathMeasure> {
 
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
-  const SkContourMeasureIter& pathMeasure() const { return *path_measure_; }
-
  private:
   CanvasPathMeasure();
 
-  std::unique_ptr<SkContourMeasureIter> path_measure_;
-  std::vector<sk_sp<SkContourMeasure>> measures_;
+  // Returns the measure of the contour at contour_index if the measure was
+  // advanced to it, or null.
+  const SkContourMeasure* GetMeasure(int contour_index) const;
+
+  // Shared with the other measures of the same path.
+  std::shared_ptr<ContourMeasures> contours_;
+  // The number of contours nextContour advanced through.
+  size_t contour_count_ = 0;
 };
 
 }  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/picture.h"
 
+#include <atomic>
 #include <memory>
 
 #include "flutter/fml/make_copyable.h"
@@ -30,36 +31,87 @@ DART_BIND_ALL(Picture, FOR_EACH_BINDING)
 
 fml::RefPtr<Picture> Picture::Create(
     Dart_Handle dart_handle,
-    flutter::SkiaGPUObject<SkPicture> picture) {
-  auto canvas_picture = fml::MakeRefCounted<Picture>(std::move(picture));
+    flutter::SkiaGPUObject<SkPicture> picture,
+    uint64_t content_hash) {
+  auto canvas_picture =
+      fml::MakeRefCounted<Picture>(std::move(picture), content_hash);
 
   canvas_picture->AssociateWithDartWrapper(dart_handle);
   return canvas_picture;
 }
 
-Picture::Picture(flutter::SkiaGPUObject<SkPicture> picture)
-    : picture_(std::move(picture)) {}
+fml::RefPtr<Picture> Picture::Create(
+    Dart_Handle dart_handle,
+    flutter::SkiaGPUObject<DisplayList> display_list) {
+  auto canvas_picture = fml::MakeRefCounted<Picture>(std::move(display_list));
+
+  canvas_picture->AssociateWithDartWrapper(dart_handle);
+  return canvas_picture;
+}
+
+namespace {
+
+std::atomic<size_t> live_picture_bytes = 0;
+
+}  // namespace
+
+Picture::Picture(flutter::SkiaGPUObject<SkPicture> picture,
+                 uint64_t content_hash)
+    : picture_(std::move(picture)), content_hash_(content_hash) {
+  accounted_bytes_ = GetAllocationSize();
+  live_picture_bytes.fetch_add(accounted_bytes_, std::memory_order_relaxed);
+}
 
-Picture::~Picture() = default;
+Picture::Picture(flutter::SkiaGPUObject<DisplayList> display_list)
+    : display_list_(std::move(display_list)) {
+  accounted_bytes_ = GetAllocationSize();
+  live_picture_bytes.fetch_add(accounted_bytes_, std::memory_order_relaxed);
+}
+
+Picture::~Picture() {
+  ReleaseAccountedBytes();
+}
+
+size_t Picture::GetLiveBytes() {
+  return live_picture_bytes.load(std::memory_order_relaxed);
+}
+
+void Picture::ReleaseAccountedBytes() {
+  live_picture_bytes.fetch_sub(accounted_bytes_, std::memory_order_relaxed);
+  accounted_bytes_ = 0;
+}
+
+sk_sp<SkPicture> Picture::ToSkPicture() const {
+  if (auto display_list = display_list_.get()) {
+    return display_list->ToSkPicture();
+  }
+  return picture_.get();
+}
 
 Dart_Handle Picture::toImage(uint32_t width,
                              uint32_t height,
                              Dart_Handle raw_image_callback) {
-  if (!picture_.get()) {
+  sk_sp<SkPicture> picture = ToSkPicture();
+  if (!picture) {
     return tonic::ToDart("Picture is null");
   }
 
-  return RasterizeToImage(picture_.get(), width, height, raw_image_callback);
+  return RasterizeToImage(std::move(picture), width, height,
+                          raw_image_callback);
 }
 
 void Picture::dispose() {
+  ReleaseAccountedBytes();
   picture_.reset();
+  display_list_.reset();
   ClearDartWrapper();
 }
 
 size_t Picture::GetAllocationSize() const {
   if (auto picture = picture_.get()) {
     return picture->approximateBytesUsed() + sizeof(Picture);
+  } else if (auto display_list = display_list_.get()) {
+    return display_list->bytes() + sizeof(Picture);
   } else {
     return sizeof(Picture);
   }
@@ -123,12 +175,13 @@ Dart_Handle Picture::RasterizeToImage(sk_sp<SkPicture> picture,
   fml::TaskRunner::RunNowOrPostTask(
       raster_task_runner,
       [ui_task_runner, snapshot_delegate, picture, picture_bounds, ui_task] {
-        sk_sp<SkImage> raster_image =
-            snapshot_delegate->MakeRasterSnapshot(picture, picture_bounds);
-
-        fml::TaskRunner::RunNowOrPostTask(
-            ui_task_runner,
-            [ui_task, raster_image]() { ui_task(raster_image); });
+        snapshot_delegate->MakeRasterSnapshotAsync(
+            picture, picture_bounds,
+            [ui_task_runner, ui_task](sk_sp<SkImage> raster_image) {
+              fml::TaskRunner::RunNowOrPostTask(
+                  ui_task_runner,
+                  [ui_task, raster_image]() { ui_task(raster_image); });
+            });
       });
 
   return Dart_Null();
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/skia_gpu_object.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -25,10 +26,28 @@ class Picture : public RefCountedDartWrappable<Picture> {
  public:
   ~Picture() override;
   static fml::RefPtr<Picture> Create(Dart_Handle dart_handle,
-                                     flutter::SkiaGPUObject<SkPicture> picture);
+                                     flutter::SkiaGPUObject<SkPicture> picture,
+                                     uint64_t content_hash);
 
+  static fml::RefPtr<Picture> Create(
+      Dart_Handle dart_handle,
+      flutter::SkiaGPUObject<DisplayList> display_list);
+
+  // The recorded picture, or nullptr if the picture was recorded into a
+  // display list.
   sk_sp<SkPicture> picture() const { return picture_.get(); }
 
+  // The recorded display list, or nullptr if the picture was recorded into
+  // an SkPicture.
+  sk_sp<DisplayList> display_list() const { return display_list_.get(); }
+
+  // The recording as an SkPicture, for the APIs that need one. A display
+  // list is converted every time this is called.
+  sk_sp<SkPicture> ToSkPicture() const;
+
+  // The ComputePictureContentHash of the picture, or 0 if it was not computed.
+  uint64_t content_hash() const { return content_hash_; }
+
   Dart_Handle toImage(uint32_t width,
                       uint32_t height,
                       Dart_Handle raw_image_callback);
@@ -37,6 +56,10 @@ class Picture : public RefCountedDartWrappable<Picture> {
 
   size_t GetAllocationSize() const override;
 
+  // The total allocation size of the pictures that are alive and not
+  // disposed, as of their creation.
+  static size_t GetLiveBytes();
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
   static Dart_Handle RasterizeToImage(sk_sp<SkPicture> picture,
@@ -45,9 +68,17 @@ class Picture : public RefCountedDartWrappable<Picture> {
                                       Dart_Handle raw_image_callback);
 
  private:
-  Picture(flutter::SkiaGPUObject<SkPicture> picture);
+  Picture(flutter::SkiaGPUObject<SkPicture> picture, uint64_t content_hash);
+
+  explicit Picture(flutter::SkiaGPUObject<DisplayList> display_list);
+
+  void ReleaseAccountedBytes();
 
   flutter::SkiaGPUObject<SkPicture> picture_;
+  flutter::SkiaGPUObject<DisplayList> display_list_;
+  uint64_t content_hash_ = 0;
+  // The bytes this picture added to |GetLiveBytes|.
+  size_t accounted_bytes_ = 0;
 };
 
 }  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/picture_recorder.h"
 
+#include "flutter/flow/picture_hash.h"
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -39,6 +40,11 @@ PictureRecorder::PictureRecorder() {}
 PictureRecorder::~PictureRecorder() {}
 
 SkCanvas* PictureRecorder::BeginRecording(SkRect bounds) {
+  if (UIDartState::Current()->enable_display_list()) {
+    display_list_recorder_ =
+        std::make_unique<DisplayListCanvasRecorder>(bounds);
+    return display_list_recorder_.get();
+  }
   return picture_recorder_.beginRecording(bounds, &rtree_factory_);
 }
 
@@ -47,9 +53,30 @@ fml::RefPtr<Picture> PictureRecorder::endRecording(Dart_Handle dart_picture) {
     return nullptr;
   }
 
+  if (display_list_recorder_) {
+    fml::RefPtr<Picture> picture = Picture::Create(
+        dart_picture,
+        UIDartState::CreateGPUObject(display_list_recorder_->Build()));
+
+    canvas_->Invalidate();
+    canvas_ = nullptr;
+    display_list_recorder_ = nullptr;
+    ClearDartWrapper();
+    return picture;
+  }
+
+  sk_sp<SkPicture> sk_picture = picture_recorder_.finishRecordingAsPicture();
+  uint64_t content_hash = 0;
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+  // Hashing the picture once here lets the raster thread compare it with the
+  // picture of the previous frame without serializing either of them.
+  if (sk_picture) {
+    content_hash = ComputePictureContentHash(*sk_picture);
+  }
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
   fml::RefPtr<Picture> picture = Picture::Create(
-      dart_picture, UIDartState::CreateGPUObject(
-                        picture_recorder_.finishRecordingAsPicture()));
+      dart_picture, UIDartState::CreateGPUObject(std::move(sk_picture)),
+      content_hash);
 
   canvas_->Invalidate();
   canvas_ = nullptr;
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_TEST_IO_MANAGER_H_
+#define FLUTTER_LIB_UI_PAINTING_TEST_IO_MANAGER_H_
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/io_manager.h"
+#include "flutter/testing/test_gl_surface.h"
+
+namespace flutter {
+namespace testing {
+
+// An IO manager backed by an offscreen GL surface, for the tests and
+// benchmarks of the image decoder. Must be created and collected on the IO
+// task runner.
+class TestIOManager final : public IOManager {
+ public:
+  explicit TestIOManager(fml::RefPtr<fml::TaskRunner> task_runner,
+                         bool has_gpu_context = true)
+      : gl_surface_(SkISize::Make(1, 1)),
+        gl_context_(has_gpu_context ? gl_surface_.CreateGrContext() : nullptr),
+        weak_gl_context_factory_(
+            has_gpu_context
+                ? std::make_unique<fml::WeakPtrFactory<GrDirectContext>>(
+                      gl_context_.get())
+                : nullptr),
+        unref_queue_(fml::MakeRefCounted<SkiaUnrefQueue>(
+            task_runner,
+            fml::TimeDelta::FromNanoseconds(0))),
+        runner_(task_runner),
+        is_gpu_disabled_sync_switch_(std::make_shared<fml::SyncSwitch>()),
+        weak_factory_(this) {
+    FML_CHECK(task_runner->RunsTasksOnCurrentThread())
+        << "The IO manager must be initialized its primary task runner. The "
+           "test harness may not be set up correctly/safely.";
+    weak_prototype_ = weak_factory_.GetWeakPtr();
+  }
+
+  ~TestIOManager() override {
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(runner_,
+                                      [&latch, queue = unref_queue_]() {
+                                        queue->Drain();
+                                        latch.Signal();
+                                      });
+    latch.Wait();
+  }
+
+  // |IOManager|
+  fml::WeakPtr<IOManager> GetWeakIOManager() const override {
+    return weak_prototype_;
+  }
+
+  // |IOManager|
+  fml::WeakPtr<GrDirectContext> GetResourceContext() const override {
+    return weak_gl_context_factory_ ? weak_gl_context_factory_->GetWeakPtr()
+                                    : fml::WeakPtr<GrDirectContext>{};
+  }
+
+  // |IOManager|
+  fml::RefPtr<flutter::SkiaUnrefQueue> GetSkiaUnrefQueue() const override {
+    return unref_queue_;
+  }
+
+  // |IOManager|
+  std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch() override {
+    did_access_is_gpu_disabled_sync_switch_ = true;
+    return is_gpu_disabled_sync_switch_;
+  }
+
+  bool did_access_is_gpu_disabled_sync_switch_ = false;
+
+ private:
+  TestGLSurface gl_surface_;
+  sk_sp<GrDirectContext> gl_context_;
+  std::unique_ptr<fml::WeakPtrFactory<GrDirectContext>>
+      weak_gl_context_factory_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+  fml::WeakPtr<TestIOManager> weak_prototype_;
+  fml::RefPtr<fml::TaskRunner> runner_;
+  std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
+  fml::WeakPtrFactory<TestIOManager> weak_factory_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TestIOManager);
+};
+
+}  // namespace testing
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_TEST_IO_MANAGER_H_
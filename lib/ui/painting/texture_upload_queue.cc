@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/texture_upload_queue.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+TextureUploadQueue::TextureUploadQueue(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    size_t budget_bytes,
+    fml::TimeDelta interval)
+    : task_runner_(std::move(task_runner)),
+      budget_bytes_(budget_bytes),
+      interval_(interval),
+      weak_factory_(this) {}
+
+TextureUploadQueue::~TextureUploadQueue() {
+  while (!pending_.empty()) {
+    fml::closure upload = std::move(pending_.front().upload);
+    pending_.pop_front();
+    upload();
+  }
+}
+
+void TextureUploadQueue::Enqueue(size_t bytes, fml::closure upload) {
+  FML_DCHECK(task_runner_->RunsTasksOnCurrentThread());
+  pending_.push_back({bytes, std::move(upload)});
+  if (drain_scheduled_) {
+    return;
+  }
+  drain_scheduled_ = true;
+  task_runner_->PostTask([weak = weak_factory_.GetWeakPtr()]() {
+    if (weak) {
+      weak->Drain();
+    }
+  });
+}
+
+void TextureUploadQueue::Drain() {
+  TRACE_EVENT0("flutter", "TextureUploadQueue::Drain");
+  drain_scheduled_ = false;
+
+  const fml::TimePoint now = fml::TimePoint::Now();
+  if (now - interval_start_ >= interval_) {
+    interval_start_ = now;
+    interval_bytes_ = 0;
+  }
+
+  while (!pending_.empty()) {
+    const size_t bytes = pending_.front().bytes;
+    if (budget_bytes_ > 0 && interval_bytes_ > 0 &&
+        interval_bytes_ + bytes > budget_bytes_) {
+      break;
+    }
+    interval_bytes_ += bytes;
+    fml::closure upload = std::move(pending_.front().upload);
+    pending_.pop_front();
+    upload();
+  }
+
+  FML_TRACE_COUNTER("flutter", "TextureUploadQueue",
+                    reinterpret_cast<int64_t>(this), "PendingUploads",
+                    pending_.size());
+
+  if (!pending_.empty()) {
+    drain_scheduled_ = true;
+    task_runner_->PostTaskForTime(
+        [weak = weak_factory_.GetWeakPtr()]() {
+          if (weak) {
+            weak->Drain();
+          }
+        },
+        interval_start_ + interval_);
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_TEXTURE_UPLOAD_QUEUE_H_
+#define FLUTTER_LIB_UI_PAINTING_TEXTURE_UPLOAD_QUEUE_H_
+
+#include <deque>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Spreads the texture uploads of the image decoders over time so that bursts
+/// of large uploads, like a screen full of photos, do not contend with the GPU
+/// work of the raster thread.
+///
+/// Uploads queued before the queue gets to run are performed together in one
+/// IO task. At most the budget of bytes is uploaded per interval, and the
+/// remaining uploads wait for the next interval. An upload larger than the
+/// whole budget is performed on its own at the start of an interval.
+///
+/// The queue must be created, used and collected on the IO thread. Uploads
+/// still pending when it is collected are performed then, so that their
+/// results are always delivered.
+///
+class TextureUploadQueue {
+ public:
+  // The interval the budget applies to, about one frame.
+  static constexpr fml::TimeDelta kDefaultInterval =
+      fml::TimeDelta::FromMilliseconds(16);
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  task_runner    The task runner of the IO thread.
+  /// @param[in]  budget_bytes   The number of bytes uploaded per interval, or
+  ///                            0 to perform all the queued uploads at once.
+  /// @param[in]  interval       The interval the budget applies to.
+  ///
+  TextureUploadQueue(fml::RefPtr<fml::TaskRunner> task_runner,
+                     size_t budget_bytes,
+                     fml::TimeDelta interval = kDefaultInterval);
+
+  ~TextureUploadQueue();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Queues |upload|, which uploads |bytes| to the GPU. Uploads
+  ///             are performed in the order they are queued.
+  ///
+  void Enqueue(size_t bytes, fml::closure upload);
+
+  size_t pending_count() const { return pending_.size(); }
+
+ private:
+  struct PendingUpload {
+    size_t bytes;
+    fml::closure upload;
+  };
+
+  fml::RefPtr<fml::TaskRunner> task_runner_;
+  const size_t budget_bytes_;
+  const fml::TimeDelta interval_;
+  std::deque<PendingUpload> pending_;
+  fml::TimePoint interval_start_;
+  size_t interval_bytes_ = 0;
+  bool drain_scheduled_ = false;
+  fml::WeakPtrFactory<TextureUploadQueue> weak_factory_;
+
+  // Performs the pending uploads that fit in the budget of the current
+  // interval, and schedules the rest for the next one.
+  void Drain();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TextureUploadQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_TEXTURE_UPLOAD_QUEUE_H_
@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/texture_upload_queue.h"
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/thread_test.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+using TextureUploadQueueTest = ThreadTest;
+
+TEST_F(TextureUploadQueueTest, PerformsQueuedUploadsTogetherInOrder) {
+  auto task_runner = CreateNewThread();
+  fml::AutoResetWaitableEvent latch;
+  std::vector<int> uploads;
+  std::unique_ptr<TextureUploadQueue> queue;
+
+  task_runner->PostTask([&]() {
+    queue = std::make_unique<TextureUploadQueue>(task_runner, 0);
+    for (int i = 0; i < 3; i++) {
+      queue->Enqueue(1024 * 1024, [&uploads, i]() { uploads.push_back(i); });
+    }
+    // Nothing is uploaded until the queue gets to run.
+    EXPECT_TRUE(uploads.empty());
+    EXPECT_EQ(queue->pending_count(), 3u);
+    task_runner->PostTask([&]() {
+      EXPECT_EQ(uploads, std::vector<int>({0, 1, 2}));
+      EXPECT_EQ(queue->pending_count(), 0u);
+      queue.reset();
+      latch.Signal();
+    });
+  });
+  latch.Wait();
+}
+
+TEST_F(TextureUploadQueueTest, DefersUploadsBeyondTheBudget) {
+  auto task_runner = CreateNewThread();
+  fml::AutoResetWaitableEvent latch;
+  std::vector<fml::TimePoint> upload_times;
+  std::unique_ptr<TextureUploadQueue> queue;
+  const fml::TimeDelta interval = fml::TimeDelta::FromMilliseconds(50);
+
+  task_runner->PostTask([&]() {
+    queue = std::make_unique<TextureUploadQueue>(task_runner, 100, interval);
+    auto upload = [&]() {
+      upload_times.push_back(fml::TimePoint::Now());
+      if (upload_times.size() == 3) {
+        latch.Signal();
+      }
+    };
+    // The first two uploads fit in one interval, the third one does not.
+    queue->Enqueue(60, upload);
+    queue->Enqueue(40, upload);
+    queue->Enqueue(60, upload);
+  });
+  latch.Wait();
+  task_runner->PostTask([&]() {
+    queue.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+
+  ASSERT_EQ(upload_times.size(), 3u);
+  EXPECT_LT(upload_times[1] - upload_times[0], interval);
+  EXPECT_GE(upload_times[2] - upload_times[0], interval);
+}
+
+TEST_F(TextureUploadQueueTest, PerformsUploadsLargerThanTheBudgetAlone) {
+  auto task_runner = CreateNewThread();
+  fml::AutoResetWaitableEvent latch;
+  int upload_count = 0;
+  std::unique_ptr<TextureUploadQueue> queue;
+
+  task_runner->PostTask([&]() {
+    queue = std::make_unique<TextureUploadQueue>(
+        task_runner, 100, fml::TimeDelta::FromMilliseconds(1));
+    auto upload = [&]() {
+      if (++upload_count == 2) {
+        latch.Signal();
+      }
+    };
+    queue->Enqueue(1000, upload);
+    queue->Enqueue(1000, upload);
+  });
+  latch.Wait();
+  task_runner->PostTask([&]() {
+    queue.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+  EXPECT_EQ(upload_count, 2);
+}
+
+TEST_F(TextureUploadQueueTest, PerformsPendingUploadsWhenCollected) {
+  auto task_runner = CreateNewThread();
+  fml::AutoResetWaitableEvent latch;
+  int upload_count = 0;
+
+  task_runner->PostTask([&]() {
+    auto queue = std::make_unique<TextureUploadQueue>(task_runner, 0);
+    queue->Enqueue(1, [&]() { upload_count++; });
+    queue->Enqueue(1, [&]() { upload_count++; });
+    queue.reset();
+    EXPECT_EQ(upload_count, 2);
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/vertices.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -14,17 +15,24 @@ namespace flutter {
 
 namespace {
 
-void DecodePoints(const tonic::Float32List& coords, SkPoint* points) {
-  for (int i = 0; i < coords.num_elements(); i += 2) {
-    points[i / 2] = SkPoint::Make(coords[i], coords[i + 1]);
-  }
+// The typed lists point straight into the Dart heap for as long as they are
+// alive, so their contents are copied once, straight into the storage of the
+// SkVertices that the builder allocates.
+static_assert(sizeof(SkPoint) == sizeof(float) * 2,
+              "SkPoint doesn't use floats.");
+static_assert(sizeof(SkColor) == sizeof(int32_t),
+              "SkColor doesn't use 32 bit ints.");
+
+void DecodePoints(const tonic::Float32List& coords,
+                  SkPoint* points,
+                  int point_count) {
+  ::memcpy(points, coords.data(), point_count * sizeof(SkPoint));
 }
 
-template <typename T>
-void DecodeInts(const tonic::Int32List& ints, T* out) {
-  for (int i = 0; i < ints.num_elements(); i++) {
-    out[i] = ints[i];
-  }
+void DecodeColors(const tonic::Int32List& ints,
+                  SkColor* colors,
+                  int color_count) {
+  ::memcpy(colors, ints.data(), color_count * sizeof(SkColor));
 }
 
 }  // namespace
@@ -58,7 +66,8 @@ bool Vertices::init(Dart_Handle vertices_handle,
     builderFlags |= SkVertices::kHasColors_BuilderFlag;
   }
 
-  SkVertices::Builder builder(vertex_mode, positions.num_elements() / 2,
+  const int vertex_count = positions.num_elements() / 2;
+  SkVertices::Builder builder(vertex_mode, vertex_count,
                               indices.num_elements(), builderFlags);
 
   if (!builder.isValid()) {
@@ -68,23 +77,30 @@ bool Vertices::init(Dart_Handle vertices_handle,
   // positions are required for SkVertices::Builder
   FML_DCHECK(positions.data());
   if (positions.data()) {
-    DecodePoints(positions, builder.positions());
+    DecodePoints(positions, builder.positions(), vertex_count);
   }
 
   if (texture_coordinates.data()) {
     // SkVertices::Builder assumes equal numbers of elements
     FML_DCHECK(positions.num_elements() == texture_coordinates.num_elements());
-    DecodePoints(texture_coordinates, builder.texCoords());
+    DecodePoints(texture_coordinates, builder.texCoords(),
+                 std::min(vertex_count,
+                          static_cast<int>(texture_coordinates.num_elements() /
+                                           2)));
   }
   if (colors.data()) {
     // SkVertices::Builder assumes equal numbers of elements
     FML_DCHECK(positions.num_elements() / 2 == colors.num_elements());
-    DecodeInts<SkColor>(colors, builder.colors());
+    DecodeColors(colors, builder.colors(),
+                 std::min(vertex_count,
+                          static_cast<int>(colors.num_elements())));
   }
 
   if (indices.data()) {
-    std::copy(indices.data(), indices.data() + indices.num_elements(),
-              builder.indices());
+    static_assert(sizeof(uint16_t) == sizeof(*builder.indices()),
+                  "SkVertices indices are not 16 bit.");
+    ::memcpy(builder.indices(), indices.data(),
+             indices.num_elements() * sizeof(uint16_t));
   }
 
   auto vertices = fml::MakeRefCounted<Vertices>();
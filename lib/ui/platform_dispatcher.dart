@@ -564,6 +564,55 @@ class PlatformDispatcher {
   ///    scheduling of frames.
   void scheduleFrame() native 'PlatformConfiguration_scheduleFrame';
 
+  /// Asks for frames to be shown at a rate within `range` until the returned
+  /// request is cancelled with [FrameRateRequest.cancel].
+  ///
+  /// Animations that do not need the full refresh rate of the display, such
+  /// as a slowly spinning progress indicator, can ask for a lower rate to save
+  /// power, while animations that follow the user's finger, such as
+  /// scrolling, can ask for the highest rate. While several requests are
+  /// active, frames are shown at a rate that satisfies the most demanding of
+  /// them, see [frameRateRange]. Without active requests, the platform chooses
+  /// the rate.
+  ///
+  /// Only displays with adaptive refresh rates, such as ProMotion displays on
+  /// iOS, honor the requested rates. Elsewhere, requests have no effect.
+  FrameRateRequest requestFrameRateRange(FrameRateRange range) {
+    final FrameRateRequest request = FrameRateRequest._(range);
+    _frameRateRequests.add(request);
+    _updateFrameRateRange();
+    return request;
+  }
+
+  /// The range of frame rates that satisfies all active requests made with
+  /// [requestFrameRateRange], or [FrameRateRange.unspecified] if there are
+  /// none.
+  FrameRateRange get frameRateRange => _frameRateRange;
+  FrameRateRange _frameRateRange = FrameRateRange.unspecified;
+
+  final List<FrameRateRequest> _frameRateRequests = <FrameRateRequest>[];
+
+  void _cancelFrameRateRequest(FrameRateRequest request) {
+    if (_frameRateRequests.remove(request)) {
+      _updateFrameRateRange();
+    }
+  }
+
+  void _updateFrameRateRange() {
+    FrameRateRange range = FrameRateRange.unspecified;
+    for (final FrameRateRequest request in _frameRateRequests) {
+      range = range._union(request.range);
+    }
+    if (range == _frameRateRange) {
+      return;
+    }
+    _frameRateRange = range;
+    _setFrameRateRange(range.minimum, range.maximum, range.preferred);
+  }
+
+  void _setFrameRateRange(double minimum, double maximum, double preferred)
+      native 'PlatformConfiguration_setFrameRateRange';
+
   /// Additional accessibility features that may be enabled by the platform.
   AccessibilityFeatures get accessibilityFeatures => configuration.accessibilityFeatures;
 
@@ -1097,6 +1146,89 @@ class ViewConfiguration {
   }
 }
 
+/// A range of frame rates, in frames per second, that an animation asks to be
+/// shown at with [PlatformDispatcher.requestFrameRateRange].
+class FrameRateRange {
+  /// Creates a range of frame rates from `minimum` to `maximum`, with the
+  /// `preferred` rate to show frames at if the display supports it.
+  ///
+  /// A `preferred` rate of zero prefers the `maximum` rate.
+  const FrameRateRange({
+    this.minimum = 0.0,
+    required this.maximum,
+    this.preferred = 0.0,
+  }) : assert(minimum >= 0.0),
+       assert(maximum >= minimum),
+       assert(preferred == 0.0 || (preferred >= minimum && preferred <= maximum));
+
+  /// A range that leaves the frame rate to the platform.
+  static const FrameRateRange unspecified = FrameRateRange(maximum: 0.0);
+
+  /// The lowest acceptable frame rate.
+  final double minimum;
+
+  /// The highest useful frame rate, or zero for [unspecified].
+  final double maximum;
+
+  /// The frame rate to show frames at if possible, or zero to prefer
+  /// [maximum].
+  final double preferred;
+
+  /// Whether this range leaves the frame rate to the platform.
+  bool get isUnspecified => maximum == 0.0;
+
+  // The smallest range that satisfies both this range and `other`.
+  FrameRateRange _union(FrameRateRange other) {
+    if (isUnspecified) {
+      return other;
+    }
+    if (other.isUnspecified) {
+      return this;
+    }
+    final double maximum = math.max(this.maximum, other.maximum);
+    return FrameRateRange(
+      minimum: math.max(minimum, other.minimum),
+      maximum: maximum,
+      preferred: math.max(
+        preferred == 0.0 ? this.maximum : preferred,
+        other.preferred == 0.0 ? other.maximum : other.preferred,
+      ),
+    );
+  }
+
+  @override
+  bool operator ==(Object other) {
+    if (other.runtimeType != runtimeType)
+      return false;
+    return other is FrameRateRange
+        && other.minimum == minimum
+        && other.maximum == maximum
+        && other.preferred == preferred;
+  }
+
+  @override
+  int get hashCode => hashValues(minimum, maximum, preferred);
+
+  @override
+  String toString() => 'FrameRateRange(minimum: $minimum, maximum: $maximum, preferred: $preferred)';
+}
+
+/// An active request for a range of frame rates that was made with
+/// [PlatformDispatcher.requestFrameRateRange].
+class FrameRateRequest {
+  FrameRateRequest._(this.range);
+
+  /// The range of frame rates that was requested.
+  final FrameRateRange range;
+
+  /// Withdraws this request, for example when its animation stops.
+  ///
+  /// Cancelling a request more than once has no effect.
+  void cancel() {
+    PlatformDispatcher.instance._cancelFrameRateRequest(this);
+  }
+}
+
 /// Various important time points in the lifetime of a frame.
 ///
 /// [FrameTiming] records a timestamp of each phase for performance analysis.
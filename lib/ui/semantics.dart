@@ -758,69 +758,57 @@ class SemanticsUpdateBuilder extends NativeFieldWrapperClass2 {
       scrollChildren == 0 || scrollChildren == null || (scrollChildren > 0 && childrenInHitTestOrder != null),
       'If a node has scrollChildren, it must have childrenInHitTestOrder',
     );
-    _updateNode(
-      id,
-      flags,
-      actions,
-      maxValueLength,
-      currentValueLength,
-      textSelectionBase,
-      textSelectionExtent,
-      platformViewId,
-      scrollChildren,
-      scrollIndex,
-      scrollPosition,
-      scrollExtentMax,
-      scrollExtentMin,
-      rect.left,
-      rect.top,
-      rect.right,
-      rect.bottom,
-      elevation,
-      thickness,
-      label,
-      hint,
-      value,
-      increasedValue,
-      decreasedValue,
-      textDirection != null ? textDirection.index + 1 : 0,
-      transform,
-      childrenInTraversalOrder,
-      childrenInHitTestOrder,
-      additionalActions,
-    );
+    if (transform.length != 16)
+      throw ArgumentError('"transform" must have 16 entries.');
+    _nodeInts
+      ..add(id)
+      ..add(flags)
+      ..add(actions)
+      ..add(maxValueLength)
+      ..add(currentValueLength)
+      ..add(textSelectionBase)
+      ..add(textSelectionExtent)
+      ..add(platformViewId)
+      ..add(scrollChildren)
+      ..add(scrollIndex)
+      ..add(textDirection != null ? textDirection.index + 1 : 0)
+      ..add(childrenInTraversalOrder.length)
+      ..addAll(childrenInTraversalOrder)
+      ..add(childrenInHitTestOrder.length)
+      ..addAll(childrenInHitTestOrder)
+      ..add(additionalActions.length)
+      ..addAll(additionalActions);
+    _nodeDoubles
+      ..add(scrollPosition)
+      ..add(scrollExtentMax)
+      ..add(scrollExtentMin)
+      ..add(rect.left)
+      ..add(rect.top)
+      ..add(rect.right)
+      ..add(rect.bottom)
+      ..add(elevation)
+      ..add(thickness)
+      ..addAll(transform);
+    _nodeStrings
+      ..add(label)
+      ..add(hint)
+      ..add(value)
+      ..add(increasedValue)
+      ..add(decreasedValue);
   }
-  void _updateNode(
-    int id,
-    int flags,
-    int actions,
-    int maxValueLength,
-    int currentValueLength,
-    int textSelectionBase,
-    int textSelectionExtent,
-    int platformViewId,
-    int scrollChildren,
-    int scrollIndex,
-    double scrollPosition,
-    double scrollExtentMax,
-    double scrollExtentMin,
-    double left,
-    double top,
-    double right,
-    double bottom,
-    double elevation,
-    double thickness,
-    String label,
-    String hint,
-    String value,
-    String increasedValue,
-    String decreasedValue,
-    int textDirection,
-    Float64List transform,
-    Int32List childrenInTraversalOrder,
-    Int32List childrenInHitTestOrder,
-    Int32List additionalActions,
-  ) native 'SemanticsUpdateBuilder_updateNode';
+
+  // The nodes recorded by [updateNode] are encoded into these lists, and sent
+  // to the engine in a single call when the update is built. The layout must
+  // be kept in sync with SemanticsUpdateBuilder::updateNodes in the engine.
+  final List<int> _nodeInts = <int>[];
+  final List<double> _nodeDoubles = <double>[];
+  final List<String> _nodeStrings = <String>[];
+
+  void _updateNodes(
+    List<String> strings,
+    Int32List ints,
+    Float64List doubles,
+  ) native 'SemanticsUpdateBuilder_updateNodes';
 
   /// Update the custom semantics action associated with the given `id`.
   ///
@@ -854,6 +842,13 @@ class SemanticsUpdateBuilder extends NativeFieldWrapperClass2 {
   /// The returned object can be passed to [PlatformDispatcher.updateSemantics]
   /// to actually update the semantics retained by the system.
   SemanticsUpdate build() {
+    if (_nodeStrings.isNotEmpty) {
+      _updateNodes(_nodeStrings, Int32List.fromList(_nodeInts),
+          Float64List.fromList(_nodeDoubles));
+      _nodeInts.clear();
+      _nodeDoubles.clear();
+      _nodeStrings.clear();
+    }
     final SemanticsUpdate semanticsUpdate = SemanticsUpdate._();
     _build(semanticsUpdate);
     return semanticsUpdate;
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/semantics/semantics_node.h"
 
+#include <cmath>
 #include <cstring>
 
 namespace flutter {
@@ -28,4 +29,31 @@ bool SemanticsNode::IsPlatformViewNode() const {
   return platformViewId > kMinPlatformViewId;
 }
 
+static bool DoublesAreEqual(double a, double b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+bool SemanticsNode::operator==(const SemanticsNode& other) const {
+  return id == other.id && flags == other.flags && actions == other.actions &&
+         maxValueLength == other.maxValueLength &&
+         currentValueLength == other.currentValueLength &&
+         textSelectionBase == other.textSelectionBase &&
+         textSelectionExtent == other.textSelectionExtent &&
+         platformViewId == other.platformViewId &&
+         scrollChildren == other.scrollChildren &&
+         scrollIndex == other.scrollIndex &&
+         DoublesAreEqual(scrollPosition, other.scrollPosition) &&
+         DoublesAreEqual(scrollExtentMax, other.scrollExtentMax) &&
+         DoublesAreEqual(scrollExtentMin, other.scrollExtentMin) &&
+         elevation == other.elevation && thickness == other.thickness &&
+         label == other.label && hint == other.hint && value == other.value &&
+         increasedValue == other.increasedValue &&
+         decreasedValue == other.decreasedValue &&
+         textDirection == other.textDirection && rect == other.rect &&
+         transform == other.transform &&
+         childrenInTraversalOrder == other.childrenInTraversalOrder &&
+         childrenInHitTestOrder == other.childrenInHitTestOrder &&
+         customAccessibilityActions == other.customAccessibilityActions;
+}
+
 }  // namespace flutter
@@ -99,6 +99,14 @@ struct SemanticsNode {
   // Whether this node is for embedded platform views.
   bool IsPlatformViewNode() const;
 
+  // Whether every field of this node equals that of |other|. Unlike the
+  // comparison of doubles, the unset scroll positions and extents, which are
+  // NaN, are considered equal.
+  bool operator==(const SemanticsNode& other) const;
+  bool operator!=(const SemanticsNode& other) const {
+    return !(*this == other);
+  }
+
   int32_t id = 0;
   int32_t flags = 0;
   int32_t actions = 0;
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/semantics/semantics_update_builder.h"
 
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/memory/allocation_tags.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkScalar.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -21,7 +23,7 @@ static void SemanticsUpdateBuilder_constructor(Dart_NativeArguments args) {
 IMPLEMENT_WRAPPERTYPEINFO(ui, SemanticsUpdateBuilder);
 
 #define FOR_EACH_BINDING(V)                     \
-  V(SemanticsUpdateBuilder, updateNode)         \
+  V(SemanticsUpdateBuilder, updateNodes)        \
   V(SemanticsUpdateBuilder, updateCustomAction) \
   V(SemanticsUpdateBuilder, build)
 
@@ -38,87 +40,121 @@ SemanticsUpdateBuilder::SemanticsUpdateBuilder() = default;
 
 SemanticsUpdateBuilder::~SemanticsUpdateBuilder() = default;
 
-void SemanticsUpdateBuilder::updateNode(
-    int id,
-    int flags,
-    int actions,
-    int maxValueLength,
-    int currentValueLength,
-    int textSelectionBase,
-    int textSelectionExtent,
-    int platformViewId,
-    int scrollChildren,
-    int scrollIndex,
-    double scrollPosition,
-    double scrollExtentMax,
-    double scrollExtentMin,
-    double left,
-    double top,
-    double right,
-    double bottom,
-    double elevation,
-    double thickness,
-    std::string label,
-    std::string hint,
-    std::string value,
-    std::string increasedValue,
-    std::string decreasedValue,
-    int textDirection,
-    const tonic::Float64List& transform,
-    const tonic::Int32List& childrenInTraversalOrder,
-    const tonic::Int32List& childrenInHitTestOrder,
-    const tonic::Int32List& localContextActions) {
-  FML_CHECK(transform.data() && SkScalarsAreFinite(*transform.data(), 9))
-      << "Semantics update transform was not set or not finite.";
-  FML_CHECK(scrollChildren == 0 ||
-            (scrollChildren > 0 && childrenInHitTestOrder.data()))
-      << "Semantics update contained scrollChildren but did not have "
-         "childrenInHitTestOrder";
-  SemanticsNode node;
-  node.id = id;
-  node.flags = flags;
-  node.actions = actions;
-  node.maxValueLength = maxValueLength;
-  node.currentValueLength = currentValueLength;
-  node.textSelectionBase = textSelectionBase;
-  node.textSelectionExtent = textSelectionExtent;
-  node.platformViewId = platformViewId;
-  node.scrollChildren = scrollChildren;
-  node.scrollIndex = scrollIndex;
-  node.scrollPosition = scrollPosition;
-  node.scrollExtentMax = scrollExtentMax;
-  node.scrollExtentMin = scrollExtentMin;
-  node.rect = SkRect::MakeLTRB(left, top, right, bottom);
-  node.elevation = elevation;
-  node.thickness = thickness;
-  node.label = label;
-  node.hint = hint;
-  node.value = value;
-  node.increasedValue = increasedValue;
-  node.decreasedValue = decreasedValue;
-  node.textDirection = textDirection;
-  SkScalar scalarTransform[16];
-  for (int i = 0; i < 16; ++i) {
-    scalarTransform[i] = transform.data()[i];
+namespace {
+
+// The number of values of each node in the lists that updateNodes decodes,
+// which must be kept in sync with SemanticsUpdateBuilder in semantics.dart.
+// The ints of a node are followed by the lengths and elements of its child and
+// action lists.
+constexpr size_t kIntsPerNode = 11;
+constexpr size_t kDoublesPerNode = 25;
+constexpr size_t kStringsPerNode = 5;
+
+class ListReader {
+ public:
+  ListReader(const int32_t* data, size_t size) : data_(data), size_(size) {}
+
+  bool ReadList(std::vector<int32_t>& list) {
+    if (position_ >= size_) {
+      return false;
+    }
+    const size_t length = data_[position_++];
+    if (length > size_ - position_) {
+      return false;
+    }
+    list.assign(data_ + position_, data_ + position_ + length);
+    position_ += length;
+    return true;
+  }
+
+  const int32_t* Read(size_t count) {
+    if (count > size_ - position_) {
+      return nullptr;
+    }
+    const int32_t* values = data_ + position_;
+    position_ += count;
+    return values;
+  }
+
+  bool IsEmpty() const { return position_ == size_; }
+
+ private:
+  const int32_t* data_;
+  size_t size_;
+  size_t position_ = 0;
+};
+
+}  // namespace
+
+void SemanticsUpdateBuilder::updateNodes(std::vector<std::string> strings,
+                                         const tonic::Int32List& ints,
+                                         const tonic::Float64List& doubles) {
+  TRACE_EVENT0("flutter", "SemanticsUpdateBuilder::updateNodes");
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kSemantics);
+  FML_CHECK(doubles.num_elements() % kDoublesPerNode == 0 &&
+            strings.size() % kStringsPerNode == 0 &&
+            doubles.num_elements() / kDoublesPerNode ==
+                strings.size() / kStringsPerNode)
+      << "Semantics update nodes were malformed.";
+  const size_t count = strings.size() / kStringsPerNode;
+  ListReader reader(ints.data(), ints.num_elements());
+  nodes_.reserve(nodes_.size() + count);
+  for (size_t i = 0; i < count; i++) {
+    const int32_t* node_ints = reader.Read(kIntsPerNode);
+    const double* node_doubles = doubles.data() + i * kDoublesPerNode;
+    std::string* node_strings = strings.data() + i * kStringsPerNode;
+    FML_CHECK(node_ints) << "Semantics update nodes were malformed.";
+
+    SemanticsNode node;
+    node.id = node_ints[0];
+    node.flags = node_ints[1];
+    node.actions = node_ints[2];
+    node.maxValueLength = node_ints[3];
+    node.currentValueLength = node_ints[4];
+    node.textSelectionBase = node_ints[5];
+    node.textSelectionExtent = node_ints[6];
+    node.platformViewId = node_ints[7];
+    node.scrollChildren = node_ints[8];
+    node.scrollIndex = node_ints[9];
+    node.textDirection = node_ints[10];
+    node.scrollPosition = node_doubles[0];
+    node.scrollExtentMax = node_doubles[1];
+    node.scrollExtentMin = node_doubles[2];
+    node.rect = SkRect::MakeLTRB(node_doubles[3], node_doubles[4],
+                                 node_doubles[5], node_doubles[6]);
+    node.elevation = node_doubles[7];
+    node.thickness = node_doubles[8];
+    SkScalar scalarTransform[16];
+    for (int j = 0; j < 16; ++j) {
+      scalarTransform[j] = node_doubles[9 + j];
+    }
+    FML_CHECK(SkScalarsAreFinite(scalarTransform, 16))
+        << "Semantics update transform was not set or not finite.";
+    node.transform = SkM44::ColMajor(scalarTransform);
+    node.label = std::move(node_strings[0]);
+    node.hint = std::move(node_strings[1]);
+    node.value = std::move(node_strings[2]);
+    node.increasedValue = std::move(node_strings[3]);
+    node.decreasedValue = std::move(node_strings[4]);
+    FML_CHECK(reader.ReadList(node.childrenInTraversalOrder) &&
+              reader.ReadList(node.childrenInHitTestOrder) &&
+              reader.ReadList(node.customAccessibilityActions))
+        << "Semantics update nodes were malformed.";
+    FML_CHECK(node.scrollChildren == 0 ||
+              (node.scrollChildren > 0 && !node.childrenInHitTestOrder.empty()))
+        << "Semantics update contained scrollChildren but did not have "
+           "childrenInHitTestOrder";
+    const int32_t id = node.id;
+    nodes_[id] = std::move(node);
   }
-  node.transform = SkM44::ColMajor(scalarTransform);
-  node.childrenInTraversalOrder =
-      std::vector<int32_t>(childrenInTraversalOrder.data(),
-                           childrenInTraversalOrder.data() +
-                               childrenInTraversalOrder.num_elements());
-  node.childrenInHitTestOrder = std::vector<int32_t>(
-      childrenInHitTestOrder.data(),
-      childrenInHitTestOrder.data() + childrenInHitTestOrder.num_elements());
-  node.customAccessibilityActions = std::vector<int32_t>(
-      localContextActions.data(),
-      localContextActions.data() + localContextActions.num_elements());
-  nodes_[id] = node;
+  FML_CHECK(reader.IsEmpty()) << "Semantics update nodes were malformed.";
 }
 
 void SemanticsUpdateBuilder::updateCustomAction(int id,
                                                 std::string label,
                                                 std::string hint,
                                                 int overrideId) {
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kSemantics);
   CustomAccessibilityAction action;
   action.id = id;
   action.overrideId = overrideId;
@@ -128,6 +164,7 @@ void SemanticsUpdateBuilder::updateCustomAction(int id,
 }
 
 void SemanticsUpdateBuilder::build(Dart_Handle semantics_update_handle) {
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kSemantics);
   SemanticsUpdate::create(semantics_update_handle, std::move(nodes_),
                           std::move(actions_));
 }
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_UPDATE_BUILDER_H_
 #define FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_UPDATE_BUILDER_H_
 
+#include <string>
+#include <vector>
+
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/semantics/semantics_update.h"
 #include "third_party/tonic/typed_data/typed_list.h"
@@ -23,35 +26,12 @@ class SemanticsUpdateBuilder
 
   ~SemanticsUpdateBuilder() override;
 
-  void updateNode(int id,
-                  int flags,
-                  int actions,
-                  int maxValueLength,
-                  int currentValueLength,
-                  int textSelectionBase,
-                  int textSelectionExtent,
-                  int platformViewId,
-                  int scrollChildren,
-                  int scrollIndex,
-                  double scrollPosition,
-                  double scrollExtentMax,
-                  double scrollExtentMin,
-                  double left,
-                  double top,
-                  double right,
-                  double bottom,
-                  double elevation,
-                  double thickness,
-                  std::string label,
-                  std::string hint,
-                  std::string value,
-                  std::string increasedValue,
-                  std::string decreasedValue,
-                  int textDirection,
-                  const tonic::Float64List& transform,
-                  const tonic::Int32List& childrenInTraversalOrder,
-                  const tonic::Int32List& childrenInHitTestOrder,
-                  const tonic::Int32List& customAccessibilityActions);
+  // Decodes the nodes that SemanticsUpdateBuilder.updateNode recorded in
+  // semantics.dart. The strings come first, as the typed lists cannot be read
+  // once the VM is entered again.
+  void updateNodes(std::vector<std::string> strings,
+                   const tonic::Int32List& ints,
+                   const tonic::Float64List& doubles);
 
   void updateCustomAction(int id,
                           std::string label,
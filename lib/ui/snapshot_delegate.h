@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 #define FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 
+#include <functional>
+
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
@@ -15,7 +17,25 @@ class SnapshotDelegate {
   virtual sk_sp<SkImage> MakeRasterSnapshot(sk_sp<SkPicture> picture,
                                             SkISize picture_size) = 0;
 
+  // Like |MakeRasterSnapshot|, but invokes |callback| with the snapshot once
+  // it is ready, which may be after other snapshots were batched with it and
+  // after the pending frames were drawn.
+  virtual void MakeRasterSnapshotAsync(
+      sk_sp<SkPicture> picture,
+      SkISize picture_size,
+      std::function<void(sk_sp<SkImage>)> callback) {
+    callback(MakeRasterSnapshot(std::move(picture), picture_size));
+  }
+
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) = 0;
+
+  // Like |ConvertToRasterImage|, but invokes |callback| with the raster image
+  // once its pixels were read back, without waiting for the GPU in between.
+  virtual void ConvertToRasterImageAsync(
+      sk_sp<SkImage> image,
+      std::function<void(sk_sp<SkImage>)> callback) {
+    callback(ConvertToRasterImage(std::move(image)));
+  }
 };
 
 }  // namespace flutter
@@ -3175,6 +3175,28 @@ class Paragraph extends NativeFieldWrapperClass2 {
   void layout(ParagraphConstraints constraints) => _layout(constraints.width);
   void _layout(double width) native 'Paragraph_layout';
 
+  /// Like [layout], but defers the work that is only needed to [paint] the
+  /// paragraph until it is first painted.
+  ///
+  /// All the metrics, boxes and positions are the same as after [layout]. Use
+  /// this for paragraphs that are measured more often than they are painted,
+  /// such as text measured to size its parent.
+  void layoutMetricsOnly(ParagraphConstraints constraints) =>
+      _layoutMetricsOnly(constraints.width);
+  void _layoutMetricsOnly(double width) native 'Paragraph_layoutMetricsOnly';
+
+  /// Shapes the text of the paragraph on a background thread so that a
+  /// subsequent [layout] spends less time on the UI thread.
+  ///
+  /// The returned future completes once the shaping results are cached. Calling
+  /// [layout] before that is allowed and simply does the remaining work itself.
+  /// This is a hint: engines that cannot shape ahead of time complete the
+  /// future right away.
+  Future<void> prepareLayout() {
+    return _futurize(_prepareLayout);
+  }
+  String? _prepareLayout(_Callback<void> callback) native 'Paragraph_prepareLayout';
+
   List<TextBox> _decodeTextBoxes(Float32List encoded) {
     final int count = encoded.length ~/ 5;
     final List<TextBox> boxes = <TextBox>[];
@@ -3292,6 +3314,23 @@ class Paragraph extends NativeFieldWrapperClass2 {
   Float64List _computeLineMetrics() native 'Paragraph_computeLineMetrics';
 }
 
+typedef _EncodedStyleCallback<R> = R Function(
+  Int32List encoded,
+  List<dynamic> fontFamilies,
+  double? fontSize,
+  double? letterSpacing,
+  double? wordSpacing,
+  double? height,
+  double? decorationThickness,
+  String locale,
+  List<dynamic>? backgroundObjects,
+  ByteData? backgroundData,
+  List<dynamic>? foregroundObjects,
+  ByteData? foregroundData,
+  ByteData shadowsData,
+  ByteData? fontFeaturesData,
+);
+
 /// Builds a [Paragraph] containing text with the given styling information.
 ///
 /// To set the paragraph's alignment, truncation, and ellipsizing behavior, pass
@@ -3369,6 +3408,10 @@ class ParagraphBuilder extends NativeFieldWrapperClass2 {
   ///
   /// See [pop] for details.
   void pushStyle(TextStyle style) {
+    _encodeStyle<void>(style, _pushStyle);
+  }
+
+  R _encodeStyle<R>(TextStyle style, _EncodedStyleCallback<R> callback) {
     final List<String> fullFontFamilies = <String>[];
     fullFontFamilies.add(style._fontFamily);
     if (style._fontFamilyFallback != null)
@@ -3394,7 +3437,7 @@ class ParagraphBuilder extends NativeFieldWrapperClass2 {
       }
     }
 
-    _pushStyle(
+    return callback(
       encoded,
       fullFontFamilies,
       style._fontSize,
@@ -3429,6 +3472,23 @@ class ParagraphBuilder extends NativeFieldWrapperClass2 {
     ByteData? fontFeaturesData,
   ) native 'ParagraphBuilder_pushStyle';
 
+  int _defineStyle(
+    Int32List encoded,
+    List<dynamic> fontFamilies,
+    double? fontSize,
+    double? letterSpacing,
+    double? wordSpacing,
+    double? height,
+    double? decorationThickness,
+    String locale,
+    List<dynamic>? backgroundObjects,
+    ByteData? backgroundData,
+    List<dynamic>? foregroundObjects,
+    ByteData? foregroundData,
+    ByteData shadowsData,
+    ByteData? fontFeaturesData,
+  ) native 'ParagraphBuilder_defineStyle';
+
   static String _encodeLocale(Locale? locale) => locale?.toString() ?? '';
 
   /// Ends the effect of the most recent call to [pushStyle].
@@ -3449,6 +3509,56 @@ class ParagraphBuilder extends NativeFieldWrapperClass2 {
   }
   String? _addText(String text) native 'ParagraphBuilder_addText';
 
+  /// The style of the [addStyledText] runs that end the effect of the most
+  /// recently pushed style, like [pop].
+  static const int popStyle = -1;
+
+  /// Adds the given text to the paragraph, styled by a tree of styles, in a
+  /// single call.
+  ///
+  /// This is equivalent to a sequence of [pushStyle], [addText] and [pop]
+  /// calls, but it is much cheaper for text with many styled spans, such as
+  /// syntax highlighted code, as each of those calls has a cost of its own.
+  ///
+  /// The `runs` are pairs of integers: an index into `styles` or [popStyle],
+  /// followed by an offset into `text`. Each run pushes the style with the
+  /// given index, or pops the most recent style it pushed, and then adds the
+  /// text from the end of the previous run up to its offset. The text after
+  /// the last run is added last, and the styles that the runs pushed and did
+  /// not pop are then popped.
+  ///
+  /// For example, to style "a bold word" with a bold style for "bold":
+  ///
+  /// ```dart
+  /// builder.addStyledText('a bold word', <TextStyle>[bold], <int>[
+  ///   0, 6, // Push bold, and add "a bold".
+  ///   ParagraphBuilder.popStyle, 11, // Pop bold, and add " word".
+  /// ]);
+  /// ```
+  ///
+  /// Throws an [ArgumentError] if the runs are invalid, in which case nothing
+  /// is added.
+  void addStyledText(String text, List<TextStyle> styles, List<int> runs) {
+    if (runs.length.isOdd)
+      throw ArgumentError('"runs" must be pairs of a style and an offset.');
+    final List<int> definedStyles = <int>[
+      for (final TextStyle style in styles)
+        _encodeStyle<int>(style, _defineStyle),
+    ];
+    final Int32List encodedRuns = Int32List(runs.length);
+    for (int i = 0; i < runs.length; i += 2) {
+      final int style = runs[i];
+      if (style != popStyle && (style < 0 || style >= styles.length))
+        throw ArgumentError('"runs" refer to style $style, which is not in "styles".');
+      encodedRuns[i] = style == popStyle ? popStyle : definedStyles[style];
+      encodedRuns[i + 1] = runs[i + 1];
+    }
+    final String? error = _addStyledText(text, encodedRuns);
+    if (error != null)
+      throw ArgumentError(error);
+  }
+  String? _addStyledText(String text, Int32List runs) native 'ParagraphBuilder_addStyledText';
+
   /// Adds an inline placeholder space to the paragraph.
   ///
   /// The paragraph will contain a rectangular space with no text of the dimensions
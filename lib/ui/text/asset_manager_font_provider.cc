@@ -4,7 +4,12 @@
 
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 
+#include <algorithm>
+#include <sstream>
+#include <string_view>
+
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/core/SkString.h"
@@ -18,11 +23,95 @@ void MappingReleaseProc(const void* ptr, void* context) {
   delete reinterpret_cast<fml::Mapping*>(context);
 }
 
+// Font files start with a table directory that holds a checksum of every
+// table. Together with the size, it identifies the contents of a font without
+// touching the rest of the mapping.
+constexpr size_t kIdentifyingPrefixSize = 4096;
+
+std::string GetTypefaceKey(const std::string& asset_name,
+                           const fml::Mapping& mapping) {
+  std::string_view prefix(
+      reinterpret_cast<const char*>(mapping.GetMapping()),
+      std::min(mapping.GetSize(), kIdentifyingPrefixSize));
+  std::ostringstream key;
+  key << asset_name << ':' << mapping.GetSize() << ':'
+      << std::hash<std::string_view>{}(prefix);
+  return key.str();
+}
+
+sk_sp<SkTypeface> MakeTypefaceFromMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+  TRACE_EVENT0("flutter", "MakeTypefaceFromMapping");
+  fml::Mapping* mapping_ptr = mapping.release();
+  sk_sp<SkData> data =
+      SkData::MakeWithProc(mapping_ptr->GetMapping(), mapping_ptr->GetSize(),
+                           MappingReleaseProc, mapping_ptr);
+  std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(data);
+
+  // Ownership of the stream is transferred.
+  return SkTypeface::MakeFromStream(std::move(stream));
+}
+
 }  // anonymous namespace
 
+AssetFontTypefaceCache::AssetFontTypefaceCache() = default;
+
+AssetFontTypefaceCache::~AssetFontTypefaceCache() {
+  for (const auto& entry : typefaces_) {
+    entry.second->weak_unref();
+  }
+}
+
+sk_sp<SkTypeface> AssetFontTypefaceCache::GetOrCreate(
+    const std::string& asset_name,
+    std::unique_ptr<fml::Mapping> mapping) {
+  if (mapping == nullptr || mapping->GetMapping() == nullptr) {
+    return nullptr;
+  }
+  const std::string key = GetTypefaceKey(asset_name, *mapping);
+
+  std::scoped_lock lock(mutex_);
+  auto found = typefaces_.find(key);
+  if (found != typefaces_.end()) {
+    if (found->second->try_ref()) {
+      return sk_sp<SkTypeface>(found->second);
+    }
+    found->second->weak_unref();
+    typefaces_.erase(found);
+  }
+
+  sk_sp<SkTypeface> typeface = MakeTypefaceFromMapping(std::move(mapping));
+  if (!typeface) {
+    return nullptr;
+  }
+  RemoveExpiredLocked();
+  typeface->weak_ref();
+  typefaces_[key] = typeface.get();
+  return typeface;
+}
+
+size_t AssetFontTypefaceCache::GetTypefaceCount() {
+  std::scoped_lock lock(mutex_);
+  RemoveExpiredLocked();
+  return typefaces_.size();
+}
+
+void AssetFontTypefaceCache::RemoveExpiredLocked() {
+  for (auto it = typefaces_.begin(); it != typefaces_.end();) {
+    if (it->second->weak_expired()) {
+      it->second->weak_unref();
+      it = typefaces_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 AssetManagerFontProvider::AssetManagerFontProvider(
-    std::shared_ptr<AssetManager> asset_manager)
-    : asset_manager_(asset_manager) {}
+    std::shared_ptr<AssetManager> asset_manager,
+    std::shared_ptr<AssetFontTypefaceCache> typeface_cache)
+    : asset_manager_(asset_manager),
+      typeface_cache_(std::move(typeface_cache)) {}
 
 AssetManagerFontProvider::~AssetManagerFontProvider() = default;
 
@@ -57,7 +146,8 @@ void AssetManagerFontProvider::RegisterAsset(std::string family_name,
     family_names_.push_back(family_name);
     auto value = std::make_pair(
         canonical_name,
-        sk_make_sp<AssetManagerFontStyleSet>(asset_manager_, family_name));
+        sk_make_sp<AssetManagerFontStyleSet>(asset_manager_, family_name,
+                                             typeface_cache_));
     family_it = registered_families_.emplace(value).first;
   }
 
@@ -66,8 +156,11 @@ void AssetManagerFontProvider::RegisterAsset(std::string family_name,
 
 AssetManagerFontStyleSet::AssetManagerFontStyleSet(
     std::shared_ptr<AssetManager> asset_manager,
-    std::string family_name)
-    : asset_manager_(asset_manager), family_name_(family_name) {}
+    std::string family_name,
+    std::shared_ptr<AssetFontTypefaceCache> typeface_cache)
+    : asset_manager_(asset_manager),
+      family_name_(family_name),
+      typeface_cache_(std::move(typeface_cache)) {}
 
 AssetManagerFontStyleSet::~AssetManagerFontStyleSet() = default;
 
@@ -108,14 +201,12 @@ SkTypeface* AssetManagerFontStyleSet::createTypeface(int i) {
       return nullptr;
     }
 
-    fml::Mapping* asset_mapping_ptr = asset_mapping.release();
-    sk_sp<SkData> asset_data = SkData::MakeWithProc(
-        asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
-        MappingReleaseProc, asset_mapping_ptr);
-    std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
-
-    // Ownership of the stream is transferred.
-    asset.typeface = SkTypeface::MakeFromStream(std::move(stream));
+    if (typeface_cache_) {
+      asset.typeface =
+          typeface_cache_->GetOrCreate(asset.asset, std::move(asset_mapping));
+    } else {
+      asset.typeface = MakeTypefaceFromMapping(std::move(asset_mapping));
+    }
     if (!asset.typeface) {
       FML_DLOG(ERROR) << "Unable to load font asset for family: "
                       << family_name_;
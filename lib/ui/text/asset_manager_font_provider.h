@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -18,10 +19,55 @@
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      The typefaces created from font assets, shared by the font
+///             providers of a font collection.
+///
+///             Engines spawned from the same engine share their font
+///             collection and register the same font assets again. With this
+///             cache they also share the typefaces, and with them the mapping
+///             of the font file, instead of loading every font once per engine.
+///
+///             Typefaces are only weakly referenced, so a typeface that is no
+///             longer used by any engine is still released. All methods are
+///             thread safe.
+///
+class AssetFontTypefaceCache {
+ public:
+  AssetFontTypefaceCache();
+
+  ~AssetFontTypefaceCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the typeface previously created for the same asset
+  ///             contents, or creates one from |mapping|.
+  ///
+  ///             The typeface refers to the mapping instead of copying it.
+  ///
+  /// @return     The typeface, or nullptr if the asset is not a valid font.
+  ///
+  sk_sp<SkTypeface> GetOrCreate(const std::string& asset_name,
+                                std::unique_ptr<fml::Mapping> mapping);
+
+  /// The number of typefaces that are still alive.
+  size_t GetTypefaceCount();
+
+ private:
+  std::mutex mutex_;
+  // Each value holds a weak reference to its typeface.
+  std::unordered_map<std::string, SkTypeface*> typefaces_;
+
+  void RemoveExpiredLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AssetFontTypefaceCache);
+};
+
 class AssetManagerFontStyleSet : public SkFontStyleSet {
  public:
-  AssetManagerFontStyleSet(std::shared_ptr<AssetManager> asset_manager,
-                           std::string family_name);
+  AssetManagerFontStyleSet(
+      std::shared_ptr<AssetManager> asset_manager,
+      std::string family_name,
+      std::shared_ptr<AssetFontTypefaceCache> typeface_cache = nullptr);
 
   ~AssetManagerFontStyleSet() override;
 
@@ -42,6 +88,7 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
  private:
   std::shared_ptr<AssetManager> asset_manager_;
   std::string family_name_;
+  std::shared_ptr<AssetFontTypefaceCache> typeface_cache_;
 
   struct TypefaceAsset {
     TypefaceAsset(std::string a);
@@ -60,7 +107,9 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
 
 class AssetManagerFontProvider : public txt::FontAssetProvider {
  public:
-  AssetManagerFontProvider(std::shared_ptr<AssetManager> asset_manager);
+  AssetManagerFontProvider(
+      std::shared_ptr<AssetManager> asset_manager,
+      std::shared_ptr<AssetFontTypefaceCache> typeface_cache = nullptr);
 
   ~AssetManagerFontProvider() override;
 
@@ -77,6 +126,7 @@ class AssetManagerFontProvider : public txt::FontAssetProvider {
 
  private:
   std::shared_ptr<AssetManager> asset_manager_;
+  std::shared_ptr<AssetFontTypefaceCache> typeface_cache_;
   std::unordered_map<std::string, sk_sp<AssetManagerFontStyleSet>>
       registered_families_;
   std::vector<std::string> family_names_;
@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/text/asset_manager_font_provider.h"
+
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/runtime/test_font_data.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+class AssetManagerFontProviderTest : public ::testing::Test {
+ public:
+  AssetManagerFontProviderTest() {
+    std::unique_ptr<SkStreamAsset> font = std::move(GetTestFontData()[0]);
+    std::vector<uint8_t> bytes(font->getLength());
+    font->read(bytes.data(), bytes.size());
+    FML_CHECK(fml::WriteAtomically(assets_dir_.fd(), "font.ttf",
+                                   fml::DataMapping(std::move(bytes))));
+  }
+
+  std::shared_ptr<AssetManager> CreateAssetManager() {
+    auto asset_manager = std::make_shared<AssetManager>();
+    asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+        fml::OpenDirectory(assets_dir_.path().c_str(), false,
+                           fml::FilePermission::kRead),
+        false));
+    return asset_manager;
+  }
+
+  // Creates the first typeface of a font family backed by the test font, as
+  // an engine registering the font assets would.
+  sk_sp<SkTypeface> CreateTypeface(
+      std::shared_ptr<AssetFontTypefaceCache> typeface_cache) {
+    AssetManagerFontProvider provider(CreateAssetManager(),
+                                      std::move(typeface_cache));
+    provider.RegisterAsset("TestFamily", "font.ttf");
+    sk_sp<SkFontStyleSet> style_set(provider.MatchFamily("TestFamily"));
+    if (!style_set) {
+      return nullptr;
+    }
+    return sk_sp<SkTypeface>(style_set->createTypeface(0));
+  }
+
+ private:
+  fml::ScopedTemporaryDirectory assets_dir_;
+};
+
+TEST_F(AssetManagerFontProviderTest, SharesTypefacesThroughCache) {
+  auto typeface_cache = std::make_shared<AssetFontTypefaceCache>();
+  sk_sp<SkTypeface> first = CreateTypeface(typeface_cache);
+  sk_sp<SkTypeface> second = CreateTypeface(typeface_cache);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(typeface_cache->GetTypefaceCount(), 1u);
+}
+
+TEST_F(AssetManagerFontProviderTest, CreatesTypefacesWithoutCache) {
+  sk_sp<SkTypeface> first = CreateTypeface(nullptr);
+  sk_sp<SkTypeface> second = CreateTypeface(nullptr);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_NE(first.get(), second.get());
+}
+
+TEST_F(AssetManagerFontProviderTest, CacheDoesNotKeepUnusedTypefacesAlive) {
+  auto typeface_cache = std::make_shared<AssetFontTypefaceCache>();
+  ASSERT_NE(CreateTypeface(typeface_cache), nullptr);
+  EXPECT_EQ(typeface_cache->GetTypefaceCount(), 0u);
+
+  sk_sp<SkTypeface> typeface = CreateTypeface(typeface_cache);
+  ASSERT_NE(typeface, nullptr);
+  EXPECT_EQ(typeface_cache->GetTypefaceCount(), 1u);
+}
+
+TEST_F(AssetManagerFontProviderTest, CacheRejectsInvalidFonts) {
+  AssetFontTypefaceCache typeface_cache;
+  EXPECT_EQ(typeface_cache.GetOrCreate(
+                "not_a_font.ttf",
+                std::make_unique<fml::DataMapping>("not a font")),
+            nullptr);
+  EXPECT_EQ(typeface_cache.GetOrCreate("missing.ttf", nullptr), nullptr);
+  EXPECT_EQ(typeface_cache.GetTypefaceCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
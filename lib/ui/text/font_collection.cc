@@ -48,9 +48,11 @@ void _LoadFontFromList(Dart_NativeArguments args) {
 }  // namespace
 
 FontCollection::FontCollection()
-    : collection_(std::make_shared<txt::FontCollection>()) {
+    : collection_(std::make_shared<txt::FontCollection>()),
+      asset_typeface_cache_(std::make_shared<AssetFontTypefaceCache>()) {
   dynamic_font_manager_ = sk_make_sp<txt::DynamicFontManager>();
   collection_->SetDynamicFontManager(dynamic_font_manager_);
+  collection_->SetFallbackFontCache(GetFallbackFontCache());
 }
 
 FontCollection::~FontCollection() {
@@ -68,6 +70,13 @@ std::shared_ptr<txt::FontCollection> FontCollection::GetFontCollection() const {
   return collection_;
 }
 
+const std::shared_ptr<txt::FallbackFontCache>&
+FontCollection::GetFallbackFontCache() {
+  static const std::shared_ptr<txt::FallbackFontCache> cache =
+      std::make_shared<txt::FallbackFontCache>();
+  return cache;
+}
+
 void FontCollection::SetupDefaultFontManager() {
   collection_->SetupDefaultFontManager();
 }
@@ -99,7 +108,8 @@ void FontCollection::RegisterFonts(
   }
 
   auto font_provider =
-      std::make_unique<AssetManagerFontProvider>(asset_manager);
+      std::make_unique<AssetManagerFontProvider>(asset_manager,
+                                                 asset_typeface_cache_);
 
   for (const auto& family : document.GetArray()) {
     auto family_name = family.FindMember("family");
@@ -11,6 +11,7 @@
 #include "flutter/assets/asset_manager.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "txt/fallback_font_cache.h"
 #include "txt/font_collection.h"
 
 namespace tonic {
@@ -19,6 +20,8 @@ class DartLibraryNatives;
 
 namespace flutter {
 
+class AssetFontTypefaceCache;
+
 class FontCollection {
  public:
   FontCollection();
@@ -29,6 +32,10 @@ class FontCollection {
 
   std::shared_ptr<txt::FontCollection> GetFontCollection() const;
 
+  // The cache of resolved fallback fonts shared by all font collections of the
+  // process.
+  static const std::shared_ptr<txt::FallbackFontCache>& GetFallbackFontCache();
+
   void SetupDefaultFontManager();
 
   void RegisterFonts(std::shared_ptr<AssetManager> asset_manager);
@@ -42,6 +49,9 @@ class FontCollection {
  private:
   std::shared_ptr<txt::FontCollection> collection_;
   sk_sp<txt::DynamicFontManager> dynamic_font_manager_;
+  // Shares the typefaces of font assets that are registered again, e.g. by an
+  // engine spawned from the one that registered them first.
+  std::shared_ptr<AssetFontTypefaceCache> asset_typeface_cache_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
@@ -7,11 +7,16 @@
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/allocation_tags.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/dart_persistent_value.h"
+#include "third_party/tonic/logging/dart_invoke.h"
 
 using tonic::ToDart;
 
@@ -29,6 +34,8 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
   V(Paragraph, ideographicBaseline)     \
   V(Paragraph, didExceedMaxLines)       \
   V(Paragraph, layout)                  \
+  V(Paragraph, layoutMetricsOnly)       \
+  V(Paragraph, prepareLayout)           \
   V(Paragraph, paint)                   \
   V(Paragraph, getWordBoundary)         \
   V(Paragraph, getLineBoundary)         \
@@ -84,9 +91,55 @@ bool Paragraph::didExceedMaxLines() {
 }
 
 void Paragraph::layout(double width) {
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kText);
   m_paragraph->Layout(width);
 }
 
+void Paragraph::layoutMetricsOnly(double width) {
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kText);
+  m_paragraph->LayoutMetricsOnly(width);
+}
+
+Dart_Handle Paragraph::prepareLayout(Dart_Handle callback) {
+  if (Dart_IsNull(callback) || !Dart_IsClosure(callback)) {
+    return tonic::ToDart("Callback was invalid");
+  }
+
+  auto* dart_state = UIDartState::Current();
+  auto persistent_callback =
+      std::make_unique<tonic::DartPersistentValue>(dart_state, callback);
+  auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
+
+  auto ui_task = fml::MakeCopyable(
+      [callback = std::move(persistent_callback)]() mutable {
+        auto dart_state = callback->dart_state().lock();
+        if (!dart_state) {
+          // The root isolate could have died in the meantime.
+          return;
+        }
+        tonic::DartState::Scope scope(dart_state);
+        tonic::DartInvoke(callback->Get(), {Dart_TypeVoid()});
+
+        // The callback is associated with the Dart isolate and must be deleted
+        // on the UI thread.
+        callback.reset();
+      });
+
+  auto warm_up_task = m_paragraph->CreateWarmUpTask();
+  auto concurrent_task_runner = dart_state->GetConcurrentTaskRunner();
+  if (!warm_up_task || !concurrent_task_runner) {
+    ui_task_runner->PostTask(ui_task);
+    return Dart_Null();
+  }
+
+  concurrent_task_runner->PostTask(
+      [warm_up_task = std::move(warm_up_task), ui_task_runner, ui_task]() {
+        warm_up_task();
+        ui_task_runner->PostTask(ui_task);
+      });
+  return Dart_Null();
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   SkCanvas* sk_canvas = canvas->canvas();
   if (!sk_canvas) {
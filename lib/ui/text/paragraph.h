@@ -41,6 +41,8 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
   bool didExceedMaxLines();
 
   void layout(double width);
+  void layoutMetricsOnly(double width);
+  Dart_Handle prepareLayout(Dart_Handle callback);
   void paint(Canvas* canvas, double x, double y);
 
   tonic::Float32List getRectsForRange(unsigned start,
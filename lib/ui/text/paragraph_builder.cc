@@ -8,7 +8,9 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/icu_util.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/memory/allocation_tags.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -144,8 +146,10 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, ParagraphBuilder);
 
 #define FOR_EACH_BINDING(V)           \
   V(ParagraphBuilder, pushStyle)      \
+  V(ParagraphBuilder, defineStyle)    \
   V(ParagraphBuilder, pop)            \
   V(ParagraphBuilder, addText)        \
+  V(ParagraphBuilder, addStyledText)  \
   V(ParagraphBuilder, addPlaceholder) \
   V(ParagraphBuilder, build)
 
@@ -243,6 +247,9 @@ ParagraphBuilder::ParagraphBuilder(
     double height,
     const std::u16string& ellipsis,
     const std::string& locale) {
+  // Line breaking and shaping need the ICU data.
+  fml::icu::EnsureICUInitialized();
+
   int32_t mask = encoded[0];
   txt::ParagraphStyle style;
 
@@ -365,31 +372,43 @@ void decodeFontFeatures(Dart_Handle font_features_data,
   }
 }
 
-void ParagraphBuilder::pushStyle(tonic::Int32List& encoded,
-                                 const std::vector<std::string>& fontFamilies,
-                                 double fontSize,
-                                 double letterSpacing,
-                                 double wordSpacing,
-                                 double height,
-                                 double decorationThickness,
-                                 const std::string& locale,
-                                 Dart_Handle background_objects,
-                                 Dart_Handle background_data,
-                                 Dart_Handle foreground_objects,
-                                 Dart_Handle foreground_data,
-                                 Dart_Handle shadows_data,
-                                 Dart_Handle font_features_data) {
-  FML_DCHECK(encoded.num_elements() == 9);
+namespace {
 
-  int32_t mask = encoded[0];
+bool IsWellFormedUTF16(const std::u16string& text) {
+  // Use ICU to validate the UTF-16 input.  Calling u_strToUTF8 with a null
+  // output buffer will return U_BUFFER_OVERFLOW_ERROR if the input is well
+  // formed.
+  const UChar* text_ptr = reinterpret_cast<const UChar*>(text.data());
+  UErrorCode error_code = U_ZERO_ERROR;
+  u_strToUTF8(nullptr, 0, nullptr, text_ptr, text.size(), &error_code);
+  return error_code == U_BUFFER_OVERFLOW_ERROR;
+}
 
-  // Set to use the properties of the previous style if the property is not
-  // explicitly given.
-  txt::TextStyle style = m_paragraphBuilder->PeekStyle();
+}  // namespace
+
+ParagraphBuilder::StyleOverride ParagraphBuilder::DecodeStyle(
+    tonic::Int32List& encoded,
+    const std::vector<std::string>& fontFamilies,
+    double fontSize,
+    double letterSpacing,
+    double wordSpacing,
+    double height,
+    double decorationThickness,
+    const std::string& locale,
+    Dart_Handle background_objects,
+    Dart_Handle background_data,
+    Dart_Handle foreground_objects,
+    Dart_Handle foreground_data,
+    Dart_Handle shadows_data,
+    Dart_Handle font_features_data) {
+  FML_DCHECK(encoded.num_elements() == 9);
+
+  StyleOverride result;
+  const int32_t mask = encoded[0];
+  result.mask = mask;
+  txt::TextStyle& style = result.style;
 
   style.half_leading = mask & tsLeadingDistributionMask;
-  // Only change the style property from the previous value if a new explicitly
-  // set value is available
   if (mask & tsColorMask) {
     style.color = encoded[tsColorIndex];
   }
@@ -417,28 +436,25 @@ void ParagraphBuilder::pushStyle(tonic::Int32List& encoded,
     // property wasn't wired up either.
   }
 
-  if (mask & (tsFontWeightMask | tsFontStyleMask | tsFontSizeMask |
-              tsLetterSpacingMask | tsWordSpacingMask)) {
-    if (mask & tsFontWeightMask) {
-      style.font_weight =
-          static_cast<txt::FontWeight>(encoded[tsFontWeightIndex]);
-    }
+  if (mask & tsFontWeightMask) {
+    style.font_weight =
+        static_cast<txt::FontWeight>(encoded[tsFontWeightIndex]);
+  }
 
-    if (mask & tsFontStyleMask) {
-      style.font_style = static_cast<txt::FontStyle>(encoded[tsFontStyleIndex]);
-    }
+  if (mask & tsFontStyleMask) {
+    style.font_style = static_cast<txt::FontStyle>(encoded[tsFontStyleIndex]);
+  }
 
-    if (mask & tsFontSizeMask) {
-      style.font_size = fontSize;
-    }
+  if (mask & tsFontSizeMask) {
+    style.font_size = fontSize;
+  }
 
-    if (mask & tsLetterSpacingMask) {
-      style.letter_spacing = letterSpacing;
-    }
+  if (mask & tsLetterSpacingMask) {
+    style.letter_spacing = letterSpacing;
+  }
 
-    if (mask & tsWordSpacingMask) {
-      style.word_spacing = wordSpacing;
-    }
+  if (mask & tsWordSpacingMask) {
+    style.word_spacing = wordSpacing;
   }
 
   if (mask & tsHeightMask) {
@@ -471,9 +487,6 @@ void ParagraphBuilder::pushStyle(tonic::Int32List& encoded,
   }
 
   if (mask & tsFontFamilyMask) {
-    // The child style's font families override the parent's font families.
-    // If the child's fonts are not available, then the font collection will
-    // use the system fallback fonts (not the parent's fonts).
     style.font_families = fontFamilies;
   }
 
@@ -481,7 +494,184 @@ void ParagraphBuilder::pushStyle(tonic::Int32List& encoded,
     decodeFontFeatures(font_features_data, style.font_features);
   }
 
-  m_paragraphBuilder->PushStyle(style);
+  return result;
+}
+
+txt::TextStyle ParagraphBuilder::ApplyStyle(
+    const StyleOverride& style_override,
+    const txt::TextStyle& parent) {
+  // Set to use the properties of the previous style if the property is not
+  // explicitly given.
+  txt::TextStyle style = parent;
+  const int32_t mask = style_override.mask;
+  const txt::TextStyle& given = style_override.style;
+
+  style.half_leading = given.half_leading;
+  // Only change the style property from the previous value if a new explicitly
+  // set value is available
+  if (mask & tsColorMask) {
+    style.color = given.color;
+  }
+  if (mask & tsTextDecorationMask) {
+    style.decoration = given.decoration;
+  }
+  if (mask & tsTextDecorationColorMask) {
+    style.decoration_color = given.decoration_color;
+  }
+  if (mask & tsTextDecorationStyleMask) {
+    style.decoration_style = given.decoration_style;
+  }
+  if (mask & tsTextDecorationThicknessMask) {
+    style.decoration_thickness_multiplier =
+        given.decoration_thickness_multiplier;
+  }
+  if (mask & tsFontWeightMask) {
+    style.font_weight = given.font_weight;
+  }
+  if (mask & tsFontStyleMask) {
+    style.font_style = given.font_style;
+  }
+  if (mask & tsFontSizeMask) {
+    style.font_size = given.font_size;
+  }
+  if (mask & tsLetterSpacingMask) {
+    style.letter_spacing = given.letter_spacing;
+  }
+  if (mask & tsWordSpacingMask) {
+    style.word_spacing = given.word_spacing;
+  }
+  if (mask & tsHeightMask) {
+    style.height = given.height;
+    style.has_height_override = true;
+  }
+  if (mask & tsLocaleMask) {
+    style.locale = given.locale;
+  }
+  if ((mask & tsBackgroundMask) && given.has_background) {
+    style.has_background = true;
+    style.background = given.background;
+  }
+  if ((mask & tsForegroundMask) && given.has_foreground) {
+    style.has_foreground = true;
+    style.foreground = given.foreground;
+  }
+  if (mask & tsTextShadowsMask) {
+    style.text_shadows = given.text_shadows;
+  }
+  if (mask & tsFontFamilyMask) {
+    // The child style's font families override the parent's font families.
+    // If the child's fonts are not available, then the font collection will
+    // use the system fallback fonts (not the parent's fonts).
+    style.font_families = given.font_families;
+  }
+  if (mask & tsFontFeaturesMask) {
+    // The child style's font features are added to the parent's.
+    for (const auto& feature : given.font_features.GetFontFeatures()) {
+      style.font_features.SetFeature(feature.first, feature.second);
+    }
+  }
+  return style;
+}
+
+void ParagraphBuilder::pushStyle(tonic::Int32List& encoded,
+                                 const std::vector<std::string>& fontFamilies,
+                                 double fontSize,
+                                 double letterSpacing,
+                                 double wordSpacing,
+                                 double height,
+                                 double decorationThickness,
+                                 const std::string& locale,
+                                 Dart_Handle background_objects,
+                                 Dart_Handle background_data,
+                                 Dart_Handle foreground_objects,
+                                 Dart_Handle foreground_data,
+                                 Dart_Handle shadows_data,
+                                 Dart_Handle font_features_data) {
+  StyleOverride style = DecodeStyle(
+      encoded, fontFamilies, fontSize, letterSpacing, wordSpacing, height,
+      decorationThickness, locale, background_objects, background_data,
+      foreground_objects, foreground_data, shadows_data, font_features_data);
+  m_paragraphBuilder->PushStyle(
+      ApplyStyle(style, m_paragraphBuilder->PeekStyle()));
+}
+
+int ParagraphBuilder::defineStyle(tonic::Int32List& encoded,
+                                  const std::vector<std::string>& fontFamilies,
+                                  double fontSize,
+                                  double letterSpacing,
+                                  double wordSpacing,
+                                  double height,
+                                  double decorationThickness,
+                                  const std::string& locale,
+                                  Dart_Handle background_objects,
+                                  Dart_Handle background_data,
+                                  Dart_Handle foreground_objects,
+                                  Dart_Handle foreground_data,
+                                  Dart_Handle shadows_data,
+                                  Dart_Handle font_features_data) {
+  defined_styles_.push_back(DecodeStyle(
+      encoded, fontFamilies, fontSize, letterSpacing, wordSpacing, height,
+      decorationThickness, locale, background_objects, background_data,
+      foreground_objects, foreground_data, shadows_data, font_features_data));
+  return static_cast<int>(defined_styles_.size()) - 1;
+}
+
+Dart_Handle ParagraphBuilder::addStyledText(const std::u16string& text,
+                                            tonic::Int32List& runs) {
+  if (runs.num_elements() % 2 != 0) {
+    return tonic::ToDart("runs must be pairs of a style and an end offset");
+  }
+
+  // Check all of the runs before adding any of them, so that invalid runs
+  // leave the builder as it was.
+  const int32_t text_length = text.size();
+  int32_t offset = 0;
+  int32_t depth = 0;
+  for (intptr_t i = 0; i < runs.num_elements(); i += 2) {
+    const int32_t style = runs[i];
+    const int32_t end = runs[i + 1];
+    if (style == kPopStyle) {
+      if (depth == 0) {
+        return tonic::ToDart("runs pop a style they did not push");
+      }
+      depth--;
+    } else if (style < 0 ||
+               static_cast<size_t>(style) >= defined_styles_.size()) {
+      return tonic::ToDart("runs refer to a style that was not defined");
+    } else {
+      depth++;
+    }
+    if (end < offset || end > text_length) {
+      return tonic::ToDart("run end offsets must increase within the text");
+    }
+    offset = end;
+  }
+  if (!IsWellFormedUTF16(text)) {
+    return tonic::ToDart("string is not well-formed UTF-16");
+  }
+
+  offset = 0;
+  for (intptr_t i = 0; i < runs.num_elements(); i += 2) {
+    const int32_t style = runs[i];
+    const int32_t end = runs[i + 1];
+    if (style == kPopStyle) {
+      m_paragraphBuilder->Pop();
+    } else {
+      m_paragraphBuilder->PushStyle(ApplyStyle(
+          defined_styles_[style], m_paragraphBuilder->PeekStyle()));
+    }
+    if (end > offset) {
+      m_paragraphBuilder->AddText(text.substr(offset, end - offset));
+      offset = end;
+    }
+  }
+  if (offset < text_length) {
+    m_paragraphBuilder->AddText(text.substr(offset));
+  }
+  for (; depth > 0; depth--) {
+    m_paragraphBuilder->Pop();
+  }
+  return Dart_Null();
 }
 
 void ParagraphBuilder::pop() {
@@ -493,16 +683,11 @@ Dart_Handle ParagraphBuilder::addText(const std::u16string& text) {
     return Dart_Null();
   }
 
-  // Use ICU to validate the UTF-16 input.  Calling u_strToUTF8 with a null
-  // output buffer will return U_BUFFER_OVERFLOW_ERROR if the input is well
-  // formed.
-  const UChar* text_ptr = reinterpret_cast<const UChar*>(text.data());
-  UErrorCode error_code = U_ZERO_ERROR;
-  u_strToUTF8(nullptr, 0, nullptr, text_ptr, text.size(), &error_code);
-  if (error_code != U_BUFFER_OVERFLOW_ERROR) {
+  if (!IsWellFormedUTF16(text)) {
     return tonic::ToDart("string is not well-formed UTF-16");
   }
 
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kText);
   m_paragraphBuilder->AddText(text);
 
   return Dart_Null();
@@ -523,6 +708,7 @@ Dart_Handle ParagraphBuilder::addPlaceholder(double width,
 }
 
 void ParagraphBuilder::build(Dart_Handle paragraph_handle) {
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kText);
   Paragraph::Create(paragraph_handle, m_paragraphBuilder->Build());
 }
 
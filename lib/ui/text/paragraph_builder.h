@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_TEXT_PARAGRAPH_BUILDER_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/paint.h"
@@ -53,10 +54,38 @@ class ParagraphBuilder : public RefCountedDartWrappable<ParagraphBuilder> {
                  Dart_Handle shadows_data,
                  Dart_Handle font_features_data);
 
+  // Decodes a style with the same arguments as |pushStyle| and adds it to the
+  // styles that |addStyledText| can push, returning its index.
+  int defineStyle(tonic::Int32List& encoded,
+                  const std::vector<std::string>& fontFamilies,
+                  double fontSize,
+                  double letterSpacing,
+                  double wordSpacing,
+                  double height,
+                  double decorationThickness,
+                  const std::string& locale,
+                  Dart_Handle background_objects,
+                  Dart_Handle background_data,
+                  Dart_Handle foreground_objects,
+                  Dart_Handle foreground_data,
+                  Dart_Handle shadows_data,
+                  Dart_Handle font_features_data);
+
   void pop();
 
   Dart_Handle addText(const std::u16string& text);
 
+  // The style index of the runs of |addStyledText| that pop a style.
+  static constexpr int32_t kPopStyle = -1;
+
+  // Adds |text| styled by a tree of styles in one call. |runs| are pairs of a
+  // style and an end offset in |text|. A run pushes the defined style with its
+  // index, or pops the last style it pushed if the index is |kPopStyle|, and
+  // then adds the text up to its end offset. The text after the last run is
+  // added last, and the styles that are still pushed are then popped.
+  Dart_Handle addStyledText(const std::u16string& text,
+                            tonic::Int32List& runs);
+
   // Pushes the information required to leave an open space, where Flutter may
   // draw a custom placeholder into.
   //
@@ -83,7 +112,33 @@ class ParagraphBuilder : public RefCountedDartWrappable<ParagraphBuilder> {
                             const std::u16string& ellipsis,
                             const std::string& locale);
 
+  // The properties of a style that are given in its mask, which override the
+  // ones of the style it is pushed on.
+  struct StyleOverride {
+    int32_t mask = 0;
+    txt::TextStyle style;
+  };
+
+  static StyleOverride DecodeStyle(tonic::Int32List& encoded,
+                                   const std::vector<std::string>& fontFamilies,
+                                   double fontSize,
+                                   double letterSpacing,
+                                   double wordSpacing,
+                                   double height,
+                                   double decorationThickness,
+                                   const std::string& locale,
+                                   Dart_Handle background_objects,
+                                   Dart_Handle background_data,
+                                   Dart_Handle foreground_objects,
+                                   Dart_Handle foreground_data,
+                                   Dart_Handle shadows_data,
+                                   Dart_Handle font_features_data);
+
+  static txt::TextStyle ApplyStyle(const StyleOverride& style_override,
+                                   const txt::TextStyle& parent);
+
   std::unique_ptr<txt::ParagraphBuilder> m_paragraphBuilder;
+  std::vector<StyleOverride> defined_styles_;
 };
 
 }  // namespace flutter
@@ -112,9 +112,57 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
   }
 }
 
+// Repeatedly invokes |entrypoint| from the root library of the fixture.
+static void RunEntrypointBenchmark(benchmark::State& state,
+                                   const char* entrypoint) {
+  ThreadHost thread_host("test",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetDefaultKernelFilePath(), {});
+
+  while (state.KeepRunning()) {
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      Dart_Handle result =
+          Dart_Invoke(Dart_RootLibrary(),
+                      Dart_NewStringFromCString(entrypoint), 0, nullptr);
+      return !Dart_IsError(result);
+    });
+    FML_CHECK(successful);
+  }
+}
+
+// Records a thousand rectangles from Dart, with one call into the engine per
+// rectangle or with a single call for a batch of all of them.
+static void BM_CanvasDrawRects(benchmark::State& state,
+                               const char* entrypoint) {
+  RunEntrypointBenchmark(state, entrypoint);
+}
+
+// Builds paths from Dart with a thousand native calls taking only doubles, to
+// measure the cost of marshalling primitive native arguments.
+static void BM_PathNativeCalls(benchmark::State& state) {
+  RunEntrypointBenchmark(state, "buildPaths");
+}
+
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
 BENCHMARK(BM_PathVolatilityTracker)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_CAPTURE(BM_CanvasDrawRects, Individual, "drawRects")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_CanvasDrawRects, Batched, "drawBatchedRects")
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_PathNativeCalls)->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
@@ -33,6 +33,7 @@ UIDartState::UIDartState(
     fml::WeakPtr<IOManager> io_manager,
     fml::RefPtr<SkiaUnrefQueue> skia_unref_queue,
     fml::WeakPtr<ImageDecoder> image_decoder,
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     std::string advisory_script_uri,
     std::string advisory_script_entrypoint,
     std::string logger_prefix,
@@ -41,7 +42,8 @@ UIDartState::UIDartState(
     std::shared_ptr<IsolateNameServer> isolate_name_server,
     bool is_root_isolate,
     std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
-    bool enable_skparagraph)
+    bool enable_skparagraph,
+    bool enable_display_list)
     : task_runners_(std::move(task_runners)),
       add_callback_(std::move(add_callback)),
       remove_callback_(std::move(remove_callback)),
@@ -50,6 +52,7 @@ UIDartState::UIDartState(
       io_manager_(std::move(io_manager)),
       skia_unref_queue_(std::move(skia_unref_queue)),
       image_decoder_(std::move(image_decoder)),
+      concurrent_task_runner_(std::move(concurrent_task_runner)),
       volatile_path_tracker_(std::move(volatile_path_tracker)),
       advisory_script_uri_(std::move(advisory_script_uri)),
       advisory_script_entrypoint_(std::move(advisory_script_entrypoint)),
@@ -58,7 +61,8 @@ UIDartState::UIDartState(
       unhandled_exception_callback_(unhandled_exception_callback),
       log_message_callback_(log_message_callback),
       isolate_name_server_(std::move(isolate_name_server)),
-      enable_skparagraph_(enable_skparagraph) {
+      enable_skparagraph_(enable_skparagraph),
+      enable_display_list_(enable_display_list) {
   AddOrRemoveTaskObserver(true /* add */);
 }
 
@@ -175,6 +179,11 @@ fml::WeakPtr<ImageDecoder> UIDartState::GetImageDecoder() const {
   return image_decoder_;
 }
 
+std::shared_ptr<fml::ConcurrentTaskRunner>
+UIDartState::GetConcurrentTaskRunner() const {
+  return concurrent_task_runner_;
+}
+
 std::shared_ptr<IsolateNameServer> UIDartState::GetIsolateNameServer() const {
   return isolate_name_server_;
 }
@@ -230,4 +239,8 @@ bool UIDartState::enable_skparagraph() const {
   return enable_skparagraph_;
 }
 
+bool UIDartState::enable_display_list() const {
+  return enable_display_list_;
+}
+
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/volatile_path_tracker.h"
 
+#include <algorithm>
+
 namespace flutter {
 
 VolatilePathTracker::VolatilePathTracker(
@@ -19,7 +21,23 @@ void VolatilePathTracker::Insert(std::shared_ptr<TrackedPath> path) {
     path->path.setIsVolatile(false);
     return;
   }
-  paths_.insert(path);
+  if (path->non_volatile_frame != 0) {
+    stats_.paths_made_volatile_again++;
+    // Back off if the path did not stay non-volatile for at least as long as
+    // it had to be volatile, and recover otherwise.
+    const uint64_t non_volatile_frames = frame_ - path->non_volatile_frame;
+    if (non_volatile_frames <
+        static_cast<uint64_t>(path->frames_of_volatility)) {
+      path->frames_of_volatility =
+          std::min(path->frames_of_volatility * 2, kMaxFramesOfVolatility);
+    } else {
+      path->frames_of_volatility =
+          std::max(path->frames_of_volatility / 2, kFramesOfVolatility);
+    }
+  }
+  path->changed_frame = frame_;
+  stats_.tracked_paths++;
+  Schedule(std::move(path));
 }
 
 void VolatilePathTracker::Erase(std::shared_ptr<TrackedPath> path) {
@@ -28,7 +46,7 @@ void VolatilePathTracker::Erase(std::shared_ptr<TrackedPath> path) {
   }
   FML_DCHECK(path);
   if (ui_task_runner_->RunsTasksOnCurrentThread()) {
-    paths_.erase(path);
+    path->erased = true;
     return;
   }
 
@@ -42,26 +60,49 @@ void VolatilePathTracker::OnFrame() {
   if (!enabled_) {
     return;
   }
-  std::string total_count = std::to_string(paths_.size());
+  frame_++;
+  std::string total_count = std::to_string(stats_.tracked_paths);
   TRACE_EVENT1("flutter", "VolatilePathTracker::OnFrame", "total_count",
                total_count.c_str());
 
   Drain();
 
-  std::set<std::shared_ptr<TrackedPath>> surviving_paths_;
-  for (const std::shared_ptr<TrackedPath>& path : paths_) {
-    path->frame_count++;
-    if (path->frame_count >= kFramesOfVolatility) {
-      path->path.setIsVolatile(false);
-      path->tracking_volatility = false;
-    } else {
-      surviving_paths_.insert(path);
+  auto due = schedule_.find(frame_);
+  if (due != schedule_.end()) {
+    std::vector<std::shared_ptr<TrackedPath>> paths = std::move(due->second);
+    schedule_.erase(due);
+    for (std::shared_ptr<TrackedPath>& path : paths) {
+      if (path->erased) {
+        stats_.tracked_paths--;
+      } else if (frame_ - path->changed_frame <
+                 static_cast<uint64_t>(path->frames_of_volatility)) {
+        Schedule(std::move(path));
+      } else {
+        path->path.setIsVolatile(false);
+        path->tracking_volatility = false;
+        path->non_volatile_frame = frame_;
+        stats_.tracked_paths--;
+        stats_.paths_made_non_volatile++;
+      }
     }
   }
-  paths_.swap(surviving_paths_);
-  std::string post_removal_count = std::to_string(paths_.size());
+
+  std::string post_removal_count = std::to_string(stats_.tracked_paths);
   TRACE_EVENT_INSTANT1("flutter", "VolatilePathTracker::OnFrame",
                        "remaining_count", post_removal_count.c_str());
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "VolatilePathTracker",
+                    reinterpret_cast<int64_t>(this), "TrackedPaths",
+                    stats_.tracked_paths, "NonVolatileDraws",
+                    stats_.non_volatile_draws, "VolatileDraws",
+                    stats_.volatile_draws, "VolatileAgain",
+                    stats_.paths_made_volatile_again);
+#endif  // !FLUTTER_RELEASE
+}
+
+void VolatilePathTracker::Schedule(std::shared_ptr<TrackedPath> path) {
+  const uint64_t frame = path->changed_frame + path->frames_of_volatility;
+  schedule_[frame].push_back(std::move(path));
 }
 
 void VolatilePathTracker::Drain() {
@@ -77,7 +118,7 @@ void VolatilePathTracker::Drain() {
     TRACE_EVENT_INSTANT1("flutter", "VolatilePathTracker::Drain", "count",
                          count.c_str());
     for (auto& path : paths_to_remove) {
-      paths_.erase(path);
+      path->erased = true;
     }
   }
 }
@@ -6,8 +6,9 @@
 #define FLUTTER_LIB_VOLATILE_PATH_TRACKER_H_
 
 #include <deque>
+#include <map>
 #include <mutex>
-#include <set>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
@@ -19,10 +20,19 @@ namespace flutter {
 /// A cache for paths drawn from dart:ui.
 ///
 /// Whenever a flutter::CanvasPath is created, it must Insert an entry into
-/// this cache. Whenever a frame is drawn, the shell must call OnFrame. The
+/// this cache, and whenever it changes while it is tracked, it must call
+/// MarkChanged. Whenever a frame is drawn, the shell must call OnFrame. The
 /// cache will flip the volatility bit on the SkPath and remove it from the
-/// cache. If the Dart object is released, Erase must be called to avoid
-/// tracking a path that is no longer referenced in Dart code.
+/// cache once the path has not changed for a number of frames. If the Dart
+/// object is released, Erase must be called to avoid tracking a path that is
+/// no longer referenced in Dart code.
+///
+/// Paths are scheduled for the frame they may become non-volatile in, so that
+/// OnFrame only visits the paths that are due, rather than every tracked
+/// path. A path that changes again soon after it became non-volatile has to
+/// stay unchanged for twice as many frames the next time, up to
+/// |kMaxFramesOfVolatility|, so that paths that change intermittently do not
+/// keep filling the GPU path cache with entries that are never reused.
 ///
 /// Enabling this cache may cause difficult to predict minor pixel differences
 /// when paths are rendered. If deterministic rendering is needed, e.g. for a
@@ -30,48 +40,103 @@ namespace flutter {
 /// automatically set the volatility of the path to false.
 class VolatilePathTracker {
  public:
+  static constexpr int kFramesOfVolatility = 2;
+  static constexpr int kMaxFramesOfVolatility = 64;
+
   /// The fields of this struct must only accessed on the UI task runner.
   struct TrackedPath {
     bool tracking_volatility = false;
-    int frame_count = 0;
+    // Whether the path was erased from the tracker while it was tracked.
+    bool erased = false;
+    // The frame the path was last changed in.
+    uint64_t changed_frame = 0;
+    // The frame the path last became non-volatile in, or zero if it never
+    // did.
+    uint64_t non_volatile_frame = 0;
+    // The number of frames the path must not change for to become
+    // non-volatile.
+    int frames_of_volatility = kFramesOfVolatility;
     SkPath path;
   };
 
+  /// Counters of the tracked paths and of how they were drawn.
+  struct Stats {
+    // The number of paths that are currently tracked.
+    size_t tracked_paths = 0;
+    // The number of times a path became non-volatile.
+    size_t paths_made_non_volatile = 0;
+    // The number of times a non-volatile path changed and became volatile
+    // again, evicting its entry from the GPU path cache.
+    size_t paths_made_volatile_again = 0;
+    // The number of draws of non-volatile paths, which may be served from the
+    // GPU path cache.
+    size_t non_volatile_draws = 0;
+    // The number of draws of volatile paths.
+    size_t volatile_draws = 0;
+  };
+
   VolatilePathTracker(fml::RefPtr<fml::TaskRunner> ui_task_runner,
                       bool enabled);
 
-  static constexpr int kFramesOfVolatility = 2;
-
   // Starts tracking a path.
   // Must be called from the UI task runner.
   //
   // Callers should only insert paths that are currently volatile.
   void Insert(std::shared_ptr<TrackedPath> path);
 
+  // Records that a path that is tracked changed, which postpones the frame it
+  // becomes non-volatile in.
+  // Must be called from the UI task runner.
+  void MarkChanged(TrackedPath& path) {
+    FML_DCHECK(path.tracking_volatility);
+    path.changed_frame = frame_;
+  }
+
   // Removes a path from tracking.
   //
   // May be called from any thread.
   void Erase(std::shared_ptr<TrackedPath> path);
 
+  // Records that a path was drawn or clipped to, for the |Stats|.
+  // Must be called from the UI task runner.
+  void OnDraw(const TrackedPath& path) {
+    if (path.path.isVolatile()) {
+      stats_.volatile_draws++;
+    } else {
+      stats_.non_volatile_draws++;
+    }
+  }
+
   // Called by the shell at the end of a frame after notifying Dart about idle
   // time.
   //
   // This method will flip the volatility bit to false for any paths that have
-  // survived the |kFramesOfVolatility|.
+  // not changed for their number of frames of volatility.
   //
   // Must be called from the UI task runner.
   void OnFrame();
 
   bool enabled() const { return enabled_; }
 
+  // Must be called from the UI task runner.
+  const Stats& GetStats() const { return stats_; }
+
  private:
   fml::RefPtr<fml::TaskRunner> ui_task_runner_;
   std::atomic_bool needs_drain_ = false;
   std::mutex paths_to_remove_mutex_;
   std::deque<std::shared_ptr<TrackedPath>> paths_to_remove_;
-  std::set<std::shared_ptr<TrackedPath>> paths_;
+  // The tracked paths by the frame they may become non-volatile in. Paths
+  // that changed since they were scheduled are scheduled again when their
+  // frame comes.
+  std::map<uint64_t, std::vector<std::shared_ptr<TrackedPath>>> schedule_;
+  // The number of frames so far, starting at one so that zero can mean never.
+  uint64_t frame_ = 1;
+  Stats stats_;
   bool enabled_ = true;
 
+  void Schedule(std::shared_ptr<TrackedPath> path);
+
   void Drain();
 
   FML_DISALLOW_COPY_AND_ASSIGN(VolatilePathTracker);
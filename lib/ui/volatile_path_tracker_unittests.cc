@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/volatile_path_tracker.h"
+
+#include <memory>
+
+#include "flutter/fml/message_loop.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::shared_ptr<VolatilePathTracker> CreateTracker() {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  return std::make_shared<VolatilePathTracker>(
+      fml::MessageLoop::GetCurrent().GetTaskRunner(), true);
+}
+
+// Inserts a path the way flutter::CanvasPath does when it is created or
+// changed while it is not tracked.
+std::shared_ptr<VolatilePathTracker::TrackedPath> Insert(
+    VolatilePathTracker& tracker,
+    std::shared_ptr<VolatilePathTracker::TrackedPath> path = nullptr) {
+  if (!path) {
+    path = std::make_shared<VolatilePathTracker::TrackedPath>();
+  }
+  path->path.setIsVolatile(true);
+  path->tracking_volatility = true;
+  tracker.Insert(path);
+  return path;
+}
+
+}  // namespace
+
+TEST(VolatilePathTrackerTest, ChangedPathsStayVolatile) {
+  auto tracker = CreateTracker();
+  auto path = Insert(*tracker);
+  auto unchanged_path = Insert(*tracker);
+  EXPECT_EQ(tracker->GetStats().tracked_paths, 2u);
+
+  for (int i = 0; i < VolatilePathTracker::kFramesOfVolatility * 3; i++) {
+    tracker->OnFrame();
+    EXPECT_TRUE(path->path.isVolatile());
+    tracker->MarkChanged(*path);
+  }
+  EXPECT_FALSE(unchanged_path->path.isVolatile());
+  EXPECT_EQ(tracker->GetStats().tracked_paths, 1u);
+
+  for (int i = 0; i < VolatilePathTracker::kFramesOfVolatility; i++) {
+    EXPECT_TRUE(path->path.isVolatile());
+    tracker->OnFrame();
+  }
+  EXPECT_FALSE(path->path.isVolatile());
+  EXPECT_EQ(tracker->GetStats().tracked_paths, 0u);
+  EXPECT_EQ(tracker->GetStats().paths_made_non_volatile, 2u);
+}
+
+TEST(VolatilePathTrackerTest, IntermittentlyChangedPathsBackOff) {
+  auto tracker = CreateTracker();
+  auto path = Insert(*tracker);
+  for (int i = 0; i < VolatilePathTracker::kFramesOfVolatility; i++) {
+    tracker->OnFrame();
+  }
+  ASSERT_FALSE(path->path.isVolatile());
+
+  // The path changes right after it became non-volatile, so it has to stay
+  // unchanged for longer before it becomes non-volatile again.
+  Insert(*tracker, path);
+  EXPECT_EQ(path->frames_of_volatility,
+            VolatilePathTracker::kFramesOfVolatility * 2);
+  EXPECT_EQ(tracker->GetStats().paths_made_volatile_again, 1u);
+  for (int i = 0; i < VolatilePathTracker::kFramesOfVolatility * 2; i++) {
+    EXPECT_TRUE(path->path.isVolatile());
+    tracker->OnFrame();
+  }
+  EXPECT_FALSE(path->path.isVolatile());
+
+  // Once it stays non-volatile for long enough, it recovers.
+  for (int i = 0; i < VolatilePathTracker::kFramesOfVolatility * 2; i++) {
+    tracker->OnFrame();
+  }
+  Insert(*tracker, path);
+  EXPECT_EQ(path->frames_of_volatility,
+            VolatilePathTracker::kFramesOfVolatility);
+}
+
+TEST(VolatilePathTrackerTest, CountsDrawsByVolatility) {
+  auto tracker = CreateTracker();
+  auto path = Insert(*tracker);
+  tracker->OnDraw(*path);
+  for (int i = 0; i < VolatilePathTracker::kFramesOfVolatility; i++) {
+    tracker->OnFrame();
+  }
+  tracker->OnDraw(*path);
+  tracker->OnDraw(*path);
+  EXPECT_EQ(tracker->GetStats().volatile_draws, 1u);
+  EXPECT_EQ(tracker->GetStats().non_volatile_draws, 2u);
+}
+
+TEST(VolatilePathTrackerTest, ErasedPathsAreNotTracked) {
+  auto tracker = CreateTracker();
+  auto path = Insert(*tracker);
+  tracker->Erase(path);
+  for (int i = 0; i < VolatilePathTracker::kFramesOfVolatility; i++) {
+    tracker->OnFrame();
+  }
+  EXPECT_TRUE(path->path.isVolatile());
+  EXPECT_EQ(tracker->GetStats().tracked_paths, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
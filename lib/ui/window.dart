@@ -253,8 +253,11 @@ abstract class FlutterView {
   ///   scheduling of frames.
   /// * [RendererBinding], the Flutter framework class which manages layout and
   ///   painting.
-  void render(Scene scene) => _render(scene, this);
-  void _render(Scene scene, FlutterView view) native 'PlatformConfiguration_render';
+  void render(Scene scene) => _render(scene, _viewId);
+  void _render(Scene scene, int viewId) native 'PlatformConfiguration_render';
+
+  // The engine ID of the view the scene is rendered into.
+  int get _viewId => 0;
 }
 
 /// A top-level platform window displaying a Flutter layer tree drawn from a
@@ -279,6 +282,9 @@ class FlutterWindow extends FlutterView {
   /// The opaque ID for this view.
   final Object _windowId;
 
+  @override
+  int get _viewId => _windowId as int;
+
   @override
   final PlatformDispatcher platformDispatcher;
 
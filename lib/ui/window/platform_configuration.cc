@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/window/platform_configuration.h"
 
+#include <cstdlib>
 #include <cstring>
 
 #include "flutter/lib/ui/compositing/scene.h"
@@ -16,6 +17,7 @@
 #include "third_party/tonic/dart_library_natives.h"
 #include "third_party/tonic/dart_microtask_queue.h"
 #include "third_party/tonic/logging/dart_invoke.h"
+#include "third_party/tonic/scopes/dart_api_scope.h"
 #include "third_party/tonic/typed_data/dart_byte_data.h"
 
 namespace flutter {
@@ -44,7 +46,14 @@ void Render(Dart_NativeArguments args) {
     Dart_ThrowException(exception);
     return;
   }
-  UIDartState::Current()->platform_configuration()->client()->Render(scene);
+  int64_t view_id =
+      tonic::DartConverter<int64_t>::FromArguments(args, 2, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+  UIDartState::Current()->platform_configuration()->client()->Render(scene,
+                                                                     view_id);
 }
 
 void UpdateSemantics(Dart_NativeArguments args) {
@@ -82,6 +91,23 @@ void SetNeedsReportTimings(Dart_NativeArguments args) {
       ->SetNeedsReportTimings(value);
 }
 
+void SetFrameRateRange(Dart_NativeArguments args) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  Dart_Handle exception = nullptr;
+  double minimum =
+      tonic::DartConverter<double>::FromArguments(args, 1, exception);
+  double maximum =
+      tonic::DartConverter<double>::FromArguments(args, 2, exception);
+  double preferred =
+      tonic::DartConverter<double>::FromArguments(args, 3, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+  UIDartState::Current()->platform_configuration()->client()->SetFrameRateRange(
+      minimum, maximum, preferred);
+}
+
 void ReportUnhandledException(Dart_NativeArguments args) {
   UIDartState::ThrowIfUIOperationsProhibited();
 
@@ -130,7 +156,8 @@ Dart_Handle SendPlatformMessage(Dart_Handle window,
     const uint8_t* buffer = static_cast<const uint8_t*>(data.data());
     dart_state->platform_configuration()->client()->HandlePlatformMessage(
         fml::MakeRefCounted<PlatformMessage>(
-            name, std::vector<uint8_t>(buffer, buffer + data.length_in_bytes()),
+            name,
+            fml::MallocMapping::Copy(buffer, buffer + data.length_in_bytes()),
             response));
   }
 
@@ -194,6 +221,22 @@ Dart_Handle ToByteData(const std::vector<uint8_t>& buffer) {
   return tonic::DartByteData::Create(buffer.data(), buffer.size());
 }
 
+void FreeByteData(void* isolate_callback_data, void* peer) {
+  free(peer);
+}
+
+// Small payloads are copied into the Dart heap like in |DartByteData::Create|.
+// Larger ones are handed to Dart as external typed data without a copy and
+// freed by its finalizer.
+Dart_Handle ToByteData(fml::MallocMapping buffer) {
+  const size_t size = buffer.GetSize();
+  if (size < tonic::DartByteData::kExternalSizeThreshold) {
+    return tonic::DartByteData::Create(buffer.GetMapping(), size);
+  }
+  uint8_t* data = buffer.Release();
+  return tonic::DartByteData::CreateExternal(data, size, data, FreeByteData);
+}
+
 }  // namespace
 
 PlatformConfigurationClient::~PlatformConfigurationClient() {}
@@ -232,8 +275,19 @@ void PlatformConfiguration::DidCreateIsolate() {
                   Dart_GetField(library, tonic::ToDart("_drawFrame")));
   report_timings_.Set(tonic::DartState::Current(),
                       Dart_GetField(library, tonic::ToDart("_reportTimings")));
-  windows_.insert(std::make_pair(0, std::unique_ptr<Window>(new Window{
-                                        0, ViewportMetrics{1.0, 0.0, 0.0}})));
+  windows_.insert(std::make_pair(
+      kFlutterImplicitViewId,
+      std::unique_ptr<Window>(new Window{kFlutterImplicitViewId,
+                                         ViewportMetrics{1.0, 0.0, 0.0}})));
+}
+
+void PlatformConfiguration::UpdateWindowMetrics(
+    const ViewportMetrics& metrics) {
+  auto& window = windows_[metrics.view_id];
+  if (!window) {
+    window = std::make_unique<Window>(metrics.view_id, metrics);
+  }
+  window->UpdateWindowMetrics(metrics);
 }
 
 void PlatformConfiguration::UpdateLocales(
@@ -315,8 +369,31 @@ void PlatformConfiguration::DispatchPlatformMessage(
     return;
   }
   tonic::DartState::Scope scope(dart_state);
+  InvokeDispatchPlatformMessage(std::move(message));
+}
+
+void PlatformConfiguration::DispatchPlatformMessages(
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  std::shared_ptr<tonic::DartState> dart_state =
+      dispatch_platform_message_.dart_state().lock();
+  if (!dart_state) {
+    FML_DLOG(WARNING) << "Dropping " << messages.size()
+                      << " platform messages for lack of DartState.";
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+  for (auto& message : messages) {
+    // Release the handles created for each message as soon as it has been
+    // delivered so that large batches don't grow the outer scope.
+    tonic::DartApiScope api_scope;
+    InvokeDispatchPlatformMessage(std::move(message));
+  }
+}
+
+void PlatformConfiguration::InvokeDispatchPlatformMessage(
+    fml::RefPtr<PlatformMessage> message) {
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? ToByteData(message->releaseData()) : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -494,6 +571,7 @@ void PlatformConfiguration::RegisterNatives(
        ReportUnhandledException, 2, true},
       {"PlatformConfiguration_setNeedsReportTimings", SetNeedsReportTimings, 2,
        true},
+      {"PlatformConfiguration_setFrameRateRange", SetFrameRateRange, 4, true},
       {"PlatformConfiguration_getPersistentIsolateData",
        GetPersistentIsolateData, 1, true},
       {"PlatformConfiguration_computePlatformResolvedLocale",
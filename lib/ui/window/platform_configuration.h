@@ -19,6 +19,7 @@
 #include "third_party/tonic/dart_persistent_value.h"
 
 namespace flutter {
+class AssetManager;
 class FontCollection;
 class PlatformMessage;
 class Scene;
@@ -66,7 +67,10 @@ class PlatformConfigurationClient {
   /// @brief      Updates the client's rendering on the GPU with the newly
   ///             provided Scene.
   ///
-  virtual void Render(Scene* scene) = 0;
+  /// @param[in]  scene    The scene to render.
+  /// @param[in]  view_id  The ID of the view the scene is rendered into.
+  ///
+  virtual void Render(Scene* scene, int64_t view_id) = 0;
 
   //--------------------------------------------------------------------------
   /// @brief      Receives a updated semantics tree from the Framework.
@@ -98,6 +102,14 @@ class PlatformConfigurationClient {
   ///             creation.
   virtual FontCollection& GetFontCollection() = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Returns the asset manager of the engine, which
+  ///             `ImmutableBuffer.fromAsset` loads assets from.
+  ///
+  /// @return     The asset manager, or nullptr if there is none.
+  ///
+  virtual std::shared_ptr<AssetManager> GetAssetManager() = 0;
+
   //--------------------------------------------------------------------------
   /// @brief      Notifies this client of the name of the root isolate and its
   ///             port when that isolate is launched, restarted (in the
@@ -141,6 +153,21 @@ class PlatformConfigurationClient {
   ///
   virtual void SetNeedsReportTimings(bool value) = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Notifies this client of the range of frame rates that the
+  ///             animations of the application ask to be shown at, which is
+  ///             the counterpart of `PlatformDispatcher.requestFrameRateRange`
+  ///             in `platform_dispatcher.dart`.
+  ///
+  /// @param[in]  minimum    The lowest acceptable frame rate.
+  /// @param[in]  maximum    The highest useful frame rate, or 0 if the
+  ///                        application has no opinion on the frame rate.
+  /// @param[in]  preferred  The frame rate to show frames at if possible.
+  ///
+  virtual void SetFrameRateRange(double minimum,
+                                 double maximum,
+                                 double preferred) = 0;
+
   //--------------------------------------------------------------------------
   /// @brief      The embedder can specify data that the isolate can request
   ///             synchronously on launch. This accessor fetches that data.
@@ -311,6 +338,17 @@ class PlatformConfiguration final {
   ///
   void DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the PlatformConfiguration that the client has sent
+  ///             it a batch of messages. The messages are delivered to the
+  ///             framework in order after entering the isolate once.
+  ///
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application.
+  ///
+  void DispatchPlatformMessages(
+      std::vector<fml::RefPtr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the framework that the embedder encountered an
   ///             accessibility related action on the specified node. This call
@@ -408,9 +446,21 @@ class PlatformConfiguration final {
   ///
   /// @param[in] window_id The id of the window to find and return.
   ///
-  /// @return     a pointer to the Window.
+  /// @return     a pointer to the Window, or nullptr if there is no window
+  ///             with that ID.
   ///
-  Window* get_window(int window_id) { return windows_[window_id].get(); }
+  Window* get_window(int64_t window_id) {
+    auto found = windows_.find(window_id);
+    return found == windows_.end() ? nullptr : found->second.get();
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Updates the metrics of the window with the view ID of the
+  ///             metrics, and adds that window if it does not exist yet.
+  ///
+  /// @param[in] metrics The new metrics of the window.
+  ///
+  void UpdateWindowMetrics(const ViewportMetrics& metrics);
 
   //----------------------------------------------------------------------------
   /// @brief      Responds to a previous platform message to the engine from the
@@ -471,6 +521,10 @@ class PlatformConfiguration final {
   // ID starts at 1 because an ID of 0 indicates that no response is expected.
   uint64_t next_key_response_id_ = 1;
   std::unordered_map<uint64_t, KeyDataResponse> pending_key_responses_;
+
+  // Delivers the message to the framework. Must be called within a scope of
+  // the isolate.
+  void InvokeDispatchPlatformMessage(fml::RefPtr<PlatformMessage> message);
 };
 
 }  // namespace flutter
@@ -27,13 +27,17 @@ class DummyPlatformConfigurationClient : public PlatformConfigurationClient {
   }
   std::string DefaultRouteName() override { return "TestRoute"; }
   void ScheduleFrame() override {}
-  void Render(Scene* scene) override {}
+  void Render(Scene* scene, int64_t view_id) override {}
   void UpdateSemantics(SemanticsUpdate* update) override {}
   void HandlePlatformMessage(fml::RefPtr<PlatformMessage> message) override {}
   FontCollection& GetFontCollection() override { return font_collection_; }
+  std::shared_ptr<AssetManager> GetAssetManager() override { return nullptr; }
   void UpdateIsolateDescription(const std::string isolate_name,
                                 int64_t isolate_port) override {}
   void SetNeedsReportTimings(bool value) override {}
+  void SetFrameRateRange(double minimum,
+                         double maximum,
+                         double preferred) override {}
   std::shared_ptr<const fml::Mapping> GetPersistentIsolateData() override {
     return isolate_data_;
   }
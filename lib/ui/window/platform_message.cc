@@ -4,17 +4,28 @@
 
 #include "flutter/lib/ui/window/platform_message.h"
 
+#include <atomic>
 #include <utility>
 
 namespace flutter {
 
+namespace {
+
+std::atomic<size_t> live_platform_message_bytes = 0;
+
+}  // namespace
+
 PlatformMessage::PlatformMessage(std::string channel,
-                                 std::vector<uint8_t> data,
+                                 fml::MallocMapping data,
                                  fml::RefPtr<PlatformMessageResponse> response)
     : channel_(std::move(channel)),
       data_(std::move(data)),
       hasData_(true),
-      response_(std::move(response)) {}
+      response_(std::move(response)),
+      accounted_bytes_(data_.GetSize()) {
+  live_platform_message_bytes.fetch_add(accounted_bytes_,
+                                        std::memory_order_relaxed);
+}
 PlatformMessage::PlatformMessage(std::string channel,
                                  fml::RefPtr<PlatformMessageResponse> response)
     : channel_(std::move(channel)),
@@ -22,6 +33,21 @@ PlatformMessage::PlatformMessage(std::string channel,
       hasData_(false),
       response_(std::move(response)) {}
 
-PlatformMessage::~PlatformMessage() = default;
+PlatformMessage::~PlatformMessage() {
+  live_platform_message_bytes.fetch_sub(accounted_bytes_,
+                                        std::memory_order_relaxed);
+}
+
+fml::MallocMapping PlatformMessage::releaseData() {
+  live_platform_message_bytes.fetch_sub(accounted_bytes_,
+                                        std::memory_order_relaxed);
+  accounted_bytes_ = 0;
+  hasData_ = false;
+  return std::move(data_);
+}
+
+size_t PlatformMessage::GetLiveBytes() {
+  return live_platform_message_bytes.load(std::memory_order_relaxed);
+}
 
 }  // namespace flutter
@@ -6,8 +6,8 @@
 #define FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_H_
 
 #include <string>
-#include <vector>
 
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
@@ -20,25 +20,35 @@ class PlatformMessage : public fml::RefCountedThreadSafe<PlatformMessage> {
 
  public:
   const std::string& channel() const { return channel_; }
-  const std::vector<uint8_t>& data() const { return data_; }
+  const fml::MallocMapping& data() const { return data_; }
   bool hasData() { return hasData_; }
 
+  // Takes the payload out of the message without copying it, e.g. to hand it
+  // to Dart. The message has no data afterwards.
+  fml::MallocMapping releaseData();
+
+  // The total size of the payloads of the platform messages that are alive
+  // and still hold their data.
+  static size_t GetLiveBytes();
+
   const fml::RefPtr<PlatformMessageResponse>& response() const {
     return response_;
   }
 
  private:
   PlatformMessage(std::string channel,
-                  std::vector<uint8_t> data,
+                  fml::MallocMapping data,
                   fml::RefPtr<PlatformMessageResponse> response);
   PlatformMessage(std::string channel,
                   fml::RefPtr<PlatformMessageResponse> response);
   ~PlatformMessage();
 
   std::string channel_;
-  std::vector<uint8_t> data_;
+  fml::MallocMapping data_;
   bool hasData_;
   fml::RefPtr<PlatformMessageResponse> response_;
+  // The bytes this message added to |GetLiveBytes|.
+  size_t accounted_bytes_ = 0;
 };
 
 }  // namespace flutter
@@ -70,11 +70,13 @@ bool operator==(const ViewportMetrics& a, const ViewportMetrics& b) {
          a.physical_system_gesture_inset_bottom ==
              b.physical_system_gesture_inset_bottom &&
          a.physical_system_gesture_inset_left ==
-             b.physical_system_gesture_inset_left;
+             b.physical_system_gesture_inset_left &&
+         a.view_id == b.view_id;
 }
 
 std::ostream& operator<<(std::ostream& os, const ViewportMetrics& a) {
-  os << "DPR: " << a.device_pixel_ratio << " "
+  os << "View: " << a.view_id << " "
+     << "DPR: " << a.device_pixel_ratio << " "
      << "Size: [" << a.physical_width << "W " << a.physical_height << "H] "
      << "Padding: [" << a.physical_padding_top << "T "
      << a.physical_padding_right << "R " << a.physical_padding_bottom << "B "
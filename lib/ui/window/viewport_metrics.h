@@ -5,8 +5,11 @@
 #ifndef FLUTTER_LIB_UI_WINDOW_VIEWPORT_METRICS_H_
 #define FLUTTER_LIB_UI_WINDOW_VIEWPORT_METRICS_H_
 
+#include <cstdint>
 #include <ostream>
 
+#include "flutter/common/constants.h"
+
 namespace flutter {
 
 struct ViewportMetrics {
@@ -45,6 +48,8 @@ struct ViewportMetrics {
   double physical_system_gesture_inset_right = 0;
   double physical_system_gesture_inset_bottom = 0;
   double physical_system_gesture_inset_left = 0;
+  // The view these metrics describe.
+  int64_t view_id = kFlutterImplicitViewId;
 };
 
 bool operator==(const ViewportMetrics& a, const ViewportMetrics& b);
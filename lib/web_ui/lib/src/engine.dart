@@ -154,6 +154,7 @@ part 'engine/clipboard.dart';
 part 'engine/color_filter.dart';
 part 'engine/dom_canvas.dart';
 part 'engine/dom_renderer.dart';
+part 'engine/draw_batch.dart';
 part 'engine/engine_canvas.dart';
 part 'engine/frame_reference.dart';
 part 'engine/html/backdrop_filter.dart';
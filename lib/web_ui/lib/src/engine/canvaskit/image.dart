@@ -278,11 +278,13 @@ class CkImage implements ui.Image, StackTraceDebugger {
   @override
   Future<ByteData> toByteData({
     ui.ImageByteFormat format = ui.ImageByteFormat.rawRgba,
+    int? quality,
   }) {
     assert(_debugCheckIsNotDisposed());
     ByteData? data = _encodeImage(
       skImage: skImage,
       format: format,
+      quality: quality,
       alphaType: canvasKit.AlphaType.Premul,
       colorType: canvasKit.ColorType.RGBA_8888,
       colorSpace: SkColorSpaceSRGB,
@@ -297,6 +299,7 @@ class CkImage implements ui.Image, StackTraceDebugger {
   static ByteData? _encodeImage({
     required SkImage skImage,
     required ui.ImageByteFormat format,
+    required int? quality,
     required SkAlphaType alphaType,
     required SkColorType colorType,
     required ColorSpace colorSpace,
@@ -312,6 +315,10 @@ class CkImage implements ui.Image, StackTraceDebugger {
         height: skImage.height(),
       );
       bytes = skImage.readPixels(0, 0, imageInfo);
+    } else if (format == ui.ImageByteFormat.jpeg) {
+      bytes = skImage.encodeToBytes(canvasKit.ImageFormat.JPEG, quality ?? 90);
+    } else if (format == ui.ImageByteFormat.webp) {
+      bytes = skImage.encodeToBytes(canvasKit.ImageFormat.WEBP, quality ?? 90);
     } else {
       bytes = skImage.encodeToBytes(); //defaults to PNG 100%
     }
@@ -110,6 +110,13 @@ class CkContourMeasure extends ManagedSkiaObject<SkContourMeasure> implements ui
     );
   }
 
+  @override
+  List<ui.Tangent> getTangentsForOffsets(List<double> distances) {
+    return <ui.Tangent>[
+      for (final double distance in distances) getTangentForOffset(distance),
+    ];
+  }
+
   @override
   bool get isClosed {
     return skiaObject.isClosed();
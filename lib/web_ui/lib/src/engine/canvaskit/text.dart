@@ -571,6 +571,13 @@ class CkParagraph extends ManagedSkiaObject<SkParagraph>
     return ui.TextRange(start: skRange.start, end: skRange.end);
   }
 
+  @override
+  Future<void> prepareLayout() => Future<void>.value();
+
+  @override
+  void layoutMetricsOnly(ui.ParagraphConstraints constraints) =>
+      layout(constraints);
+
   @override
   void layout(ui.ParagraphConstraints constraints) {
     _lastLayoutConstraints = constraints;
@@ -893,6 +900,12 @@ class CkParagraphBuilder implements ui.ParagraphBuilder {
     _paragraphBuilder.addText(text);
   }
 
+  @override
+  void addStyledText(
+      String text, List<ui.TextStyle> styles, List<int> runs) {
+    addStyledTextWithBuilder(this, text, styles, runs);
+  }
+
   @override
   CkParagraph build() {
     final builtParagraph = _buildCkParagraph();
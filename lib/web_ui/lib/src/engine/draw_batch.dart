@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+part of engine;
+
+/// The web implementation of [ui.DrawBatch].
+///
+/// There is no call into native code to amortize on the web, so the batch
+/// only records its commands and replays them as individual draw calls.
+class EngineDrawBatch implements ui.DrawBatch {
+  static const int _kRect = 0;
+  static const int _kOval = 1;
+  static const int _kLine = 2;
+  static const int _kCircle = 3;
+  static const int _kColor = 4;
+  static const int _kStrokeWidth = 5;
+
+  final List<double> _ops = <double>[];
+
+  @override
+  int get length => _ops.length;
+
+  @override
+  void drawRect(ui.Rect rect) {
+    _ops.addAll(<double>[
+        _kRect.toDouble(), rect.left, rect.top, rect.right, rect.bottom]);
+  }
+
+  @override
+  void drawOval(ui.Rect rect) {
+    _ops.addAll(<double>[
+        _kOval.toDouble(), rect.left, rect.top, rect.right, rect.bottom]);
+  }
+
+  @override
+  void drawLine(ui.Offset p1, ui.Offset p2) {
+    _ops.addAll(<double>[_kLine.toDouble(), p1.dx, p1.dy, p2.dx, p2.dy]);
+  }
+
+  @override
+  void drawCircle(ui.Offset c, double radius) {
+    _ops.addAll(<double>[_kCircle.toDouble(), c.dx, c.dy, radius]);
+  }
+
+  @override
+  void setColor(ui.Color color) {
+    _ops.addAll(<double>[_kColor.toDouble(), color.value.toDouble()]);
+  }
+
+  @override
+  void setStrokeWidth(double width) {
+    _ops.addAll(<double>[_kStrokeWidth.toDouble(), width]);
+  }
+
+  @override
+  void clear() {
+    _ops.clear();
+  }
+
+  /// Draws the recorded commands into `canvas` with `paint`, which is
+  /// restored to its color and stroke width afterwards.
+  void replay(ui.Canvas canvas, ui.Paint paint) {
+    final ui.Color color = paint.color;
+    final double strokeWidth = paint.strokeWidth;
+    try {
+      int i = 0;
+      while (i < _ops.length) {
+        final int op = _ops[i].toInt();
+        switch (op) {
+          case _kRect:
+          case _kOval:
+            final ui.Rect rect = ui.Rect.fromLTRB(
+                _ops[i + 1], _ops[i + 2], _ops[i + 3], _ops[i + 4]);
+            if (op == _kRect) {
+              canvas.drawRect(rect, paint);
+            } else {
+              canvas.drawOval(rect, paint);
+            }
+            i += 5;
+            break;
+          case _kLine:
+            canvas.drawLine(ui.Offset(_ops[i + 1], _ops[i + 2]),
+                ui.Offset(_ops[i + 3], _ops[i + 4]), paint);
+            i += 5;
+            break;
+          case _kCircle:
+            canvas.drawCircle(
+                ui.Offset(_ops[i + 1], _ops[i + 2]), _ops[i + 3], paint);
+            i += 4;
+            break;
+          case _kColor:
+            paint.color = ui.Color(_ops[i + 1].toInt());
+            i += 2;
+            break;
+          case _kStrokeWidth:
+            paint.strokeWidth = _ops[i + 1];
+            i += 2;
+            break;
+        }
+      }
+    } finally {
+      paint.color = color;
+      paint.strokeWidth = strokeWidth;
+    }
+  }
+}
@@ -417,6 +417,13 @@ class SurfaceCanvas implements ui.Canvas {
     _canvas.drawRawPoints(pointMode, points, paint as SurfacePaint);
   }
 
+  @override
+  void drawBatch(ui.DrawBatch batch, ui.Paint paint) {
+    assert(batch != null); // ignore: unnecessary_null_comparison
+    assert(paint != null); // ignore: unnecessary_null_comparison
+    (batch as EngineDrawBatch).replay(this, paint);
+  }
+
   @override
   void drawVertices(
       ui.Vertices vertices, ui.BlendMode blendMode, ui.Paint paint) {
@@ -583,6 +583,19 @@ class SurfacePathMetric implements ui.PathMetric {
     return _measure.getTangentForOffset(contourIndex, distance);
   }
 
+  @override
+  List<ui.Tangent>? getTangentsForOffsets(List<double> distances) {
+    final List<ui.Tangent> tangents = <ui.Tangent>[];
+    for (final double distance in distances) {
+      final ui.Tangent? tangent = getTangentForOffset(distance);
+      if (tangent == null) {
+        return null;
+      }
+      tangents.add(tangent);
+    }
+    return tangents;
+  }
+
   /// Given a start and end distance, return the intervening segment(s).
   ///
   /// `start` and `end` are pinned to legal values (0..[length])
@@ -160,7 +160,10 @@ class HtmlImage implements ui.Image {
   final int height;
 
   @override
-  Future<ByteData?> toByteData({ui.ImageByteFormat format = ui.ImageByteFormat.rawRgba}) {
+  Future<ByteData?> toByteData({
+    ui.ImageByteFormat format = ui.ImageByteFormat.rawRgba,
+    int? quality,
+  }) {
     if (format == ui.ImageByteFormat.rawRgba) {
       final html.CanvasElement canvas = html.CanvasElement()
         ..width = width
@@ -69,6 +69,13 @@ class CanvasParagraph implements EngineParagraph {
   late final TextLayoutService _layoutService = TextLayoutService(this);
   late final TextPaintService _paintService = TextPaintService(this);
 
+  @override
+  Future<void> prepareLayout() => Future<void>.value();
+
+  @override
+  void layoutMetricsOnly(ui.ParagraphConstraints constraints) =>
+      layout(constraints);
+
   @override
   void layout(ui.ParagraphConstraints constraints) {
     // When constraint width has a decimal place, we floor it to avoid getting
@@ -696,6 +703,12 @@ class CanvasParagraphBuilder implements ui.ParagraphBuilder {
     _spans.add(FlatTextSpan(style: style, start: start, end: end));
   }
 
+  @override
+  void addStyledText(
+      String text, List<ui.TextStyle> styles, List<int> runs) {
+    addStyledTextWithBuilder(this, text, styles, runs);
+  }
+
   @override
   CanvasParagraph build() {
     return CanvasParagraph(
@@ -343,6 +343,13 @@ class DomParagraph implements EngineParagraph {
   /// directly into a canvas without css text alignment styling.
   double _alignOffset = 0.0;
 
+  @override
+  Future<void> prepareLayout() => Future<void>.value();
+
+  @override
+  void layoutMetricsOnly(ui.ParagraphConstraints constraints) =>
+      layout(constraints);
+
   @override
   void layout(ui.ParagraphConstraints constraints) {
     // When constraint width has a decimal place, we floor it to avoid getting
@@ -1270,6 +1277,60 @@ class EngineStrutStyle implements ui.StrutStyle {
       );
 }
 
+/// Adds styled text to [builder] with [ui.ParagraphBuilder.pushStyle],
+/// [ui.ParagraphBuilder.addText] and [ui.ParagraphBuilder.pop], as described
+/// by [ui.ParagraphBuilder.addStyledText].
+///
+/// The runs are checked before anything is added.
+void addStyledTextWithBuilder(ui.ParagraphBuilder builder, String text,
+    List<ui.TextStyle> styles, List<int> runs) {
+  if (runs.length.isOdd) {
+    throw ArgumentError('"runs" must be pairs of a style and an offset.');
+  }
+  int depth = 0;
+  int offset = 0;
+  for (int i = 0; i < runs.length; i += 2) {
+    final int style = runs[i];
+    if (style == ui.ParagraphBuilder.popStyle) {
+      if (depth == 0) {
+        throw ArgumentError('"runs" pop more styles than they push.');
+      }
+      depth--;
+    } else if (style < 0 || style >= styles.length) {
+      throw ArgumentError('"runs" refer to style $style, which is not in "styles".');
+    } else {
+      depth++;
+    }
+    final int end = runs[i + 1];
+    if (end < offset || end > text.length) {
+      throw ArgumentError('"runs" end at $end, which is out of order or past the end of "text".');
+    }
+    offset = end;
+  }
+
+  offset = 0;
+  for (int i = 0; i < runs.length; i += 2) {
+    final int style = runs[i];
+    if (style == ui.ParagraphBuilder.popStyle) {
+      builder.pop();
+    } else {
+      builder.pushStyle(styles[style]);
+    }
+    final int end = runs[i + 1];
+    if (end > offset) {
+      builder.addText(text.substring(offset, end));
+    }
+    offset = end;
+  }
+  if (offset < text.length) {
+    builder.addText(text.substring(offset));
+  }
+  // [depth] is the number of styles that the runs left pushed.
+  for (; depth > 0; depth--) {
+    builder.pop();
+  }
+}
+
 /// The web implementation of [ui.ParagraphBuilder].
 class DomParagraphBuilder implements ui.ParagraphBuilder {
   /// Marks a call to the [pop] method in the [_ops] list.
@@ -1360,6 +1421,12 @@ class DomParagraphBuilder implements ui.ParagraphBuilder {
     _ops.add(text);
   }
 
+  @override
+  void addStyledText(
+      String text, List<ui.TextStyle> styles, List<int> runs) {
+    addStyledTextWithBuilder(this, text, styles, runs);
+  }
+
   /// Applies the given paragraph style and returns a [Paragraph] containing the
   /// added text and associated styling.
   ///
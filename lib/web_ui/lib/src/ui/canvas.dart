@@ -119,6 +119,7 @@ abstract class Canvas {
   void drawParagraph(Paragraph paragraph, Offset offset);
   void drawPoints(PointMode pointMode, List<Offset> points, Paint paint);
   void drawRawPoints(PointMode pointMode, Float32List points, Paint paint);
+  void drawBatch(DrawBatch batch, Paint paint);
 
   void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint);
   void drawAtlas(
@@ -147,6 +148,18 @@ abstract class Canvas {
   );
 }
 
+abstract class DrawBatch {
+  factory DrawBatch() => engine.EngineDrawBatch();
+  int get length;
+  void drawRect(Rect rect);
+  void drawOval(Rect rect);
+  void drawLine(Offset p1, Offset p2);
+  void drawCircle(Offset c, double radius);
+  void setColor(Color color);
+  void setStrokeWidth(double width);
+  void clear();
+}
+
 abstract class Picture {
   Future<Image> toImage(int width, int height);
   void dispose();
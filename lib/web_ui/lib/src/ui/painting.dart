@@ -331,7 +331,10 @@ abstract class Gradient extends Shader {
 abstract class Image {
   int get width;
   int get height;
-  Future<ByteData?> toByteData({ImageByteFormat format = ImageByteFormat.rawRgba});
+  Future<ByteData?> toByteData({
+    ImageByteFormat format = ImageByteFormat.rawRgba,
+    int? quality,
+  });
   void dispose();
   bool get debugDisposed;
 
@@ -420,6 +423,8 @@ enum ImageByteFormat {
   rawRgba,
   rawUnmodified,
   png,
+  jpeg,
+  webp,
 }
 
 enum PixelFormat {
@@ -706,6 +711,17 @@ class ImmutableBuffer {
     return instance;
   }
 
+  static Future<ImmutableBuffer> fromAsset(String assetKey) async {
+    final ByteData data = await webOnlyAssetManager.load(assetKey);
+    return fromUint8List(data.buffer.asUint8List(
+        data.offsetInBytes, data.lengthInBytes));
+  }
+
+  static Future<ImmutableBuffer> fromFilePath(String path) {
+    throw UnsupportedError(
+        'ImmutableBuffer.fromFilePath is not supported on the web.');
+  }
+
   Uint8List? _list;
   final int length;
   void dispose() => _list = null;
@@ -752,10 +768,13 @@ class ImageDescriptor {
   int get bytesPerPixel =>
       throw UnsupportedError('ImageDescriptor.bytesPerPixel is not supported on web.');
   void dispose() => _data = null;
-  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight}) async {
+  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight, Rect? subset}) async {
     if (_data == null) {
       throw StateError('Object is disposed');
     }
+    if (subset != null) {
+      _throw('instantiateCodec(subset)');
+    }
     if (_width == null) {
       return await instantiateImageCodec(
         _data!,
@@ -21,6 +21,7 @@ abstract class PathMetric {
   double get length;
   int get contourIndex;
   Tangent? getTangentForOffset(double distance);
+  List<Tangent>? getTangentsForOffsets(List<double> distances);
   Path extractPath(double start, double end, {bool startWithMoveTo = true});
   bool get isClosed;
 }
@@ -57,6 +57,33 @@ abstract class PlatformDispatcher {
 
   void scheduleFrame();
 
+  // Browsers choose the frame rate, so requests only update [frameRateRange].
+  FrameRateRequest requestFrameRateRange(FrameRateRange range) {
+    final FrameRateRequest request = FrameRateRequest._(range);
+    _frameRateRequests.add(request);
+    _updateFrameRateRange();
+    return request;
+  }
+
+  FrameRateRange get frameRateRange => _frameRateRange;
+  FrameRateRange _frameRateRange = FrameRateRange.unspecified;
+
+  final List<FrameRateRequest> _frameRateRequests = <FrameRateRequest>[];
+
+  void _cancelFrameRateRequest(FrameRateRequest request) {
+    if (_frameRateRequests.remove(request)) {
+      _updateFrameRateRange();
+    }
+  }
+
+  void _updateFrameRateRange() {
+    FrameRateRange range = FrameRateRange.unspecified;
+    for (final FrameRateRequest request in _frameRateRequests) {
+      range = range._union(request.range);
+    }
+    _frameRateRange = range;
+  }
+
   void render(Scene scene, [FlutterView view]);
 
   AccessibilityFeatures get accessibilityFeatures;
@@ -189,6 +216,69 @@ class ViewConfiguration {
   }
 }
 
+class FrameRateRange {
+  const FrameRateRange({
+    this.minimum = 0.0,
+    required this.maximum,
+    this.preferred = 0.0,
+  }) : assert(minimum >= 0.0),
+       assert(maximum >= minimum),
+       assert(preferred == 0.0 || (preferred >= minimum && preferred <= maximum));
+
+  static const FrameRateRange unspecified = FrameRateRange(maximum: 0.0);
+
+  final double minimum;
+  final double maximum;
+  final double preferred;
+
+  bool get isUnspecified => maximum == 0.0;
+
+  FrameRateRange _union(FrameRateRange other) {
+    if (isUnspecified) {
+      return other;
+    }
+    if (other.isUnspecified) {
+      return this;
+    }
+    return FrameRateRange(
+      minimum: math.max(minimum, other.minimum),
+      maximum: math.max(maximum, other.maximum),
+      preferred: math.max(
+        preferred == 0.0 ? maximum : preferred,
+        other.preferred == 0.0 ? other.maximum : other.preferred,
+      ),
+    );
+  }
+
+  @override
+  bool operator ==(Object other) {
+    if (other.runtimeType != runtimeType) {
+      return false;
+    }
+    return other is FrameRateRange &&
+        other.minimum == minimum &&
+        other.maximum == maximum &&
+        other.preferred == preferred;
+  }
+
+  @override
+  int get hashCode => hashValues(minimum, maximum, preferred);
+
+  @override
+  String toString() =>
+      'FrameRateRange(minimum: $minimum, maximum: $maximum, preferred: $preferred)';
+}
+
+class FrameRateRequest {
+  FrameRateRequest._(this.range);
+
+  final FrameRateRange range;
+
+  void cancel() {
+    PlatformDispatcher.instance._cancelFrameRateRequest(this);
+  }
+}
+
 enum FramePhase {
   vsyncStart,
   buildStart,
@@ -589,6 +589,8 @@ abstract class Paragraph {
   double get ideographicBaseline;
   bool get didExceedMaxLines;
   void layout(ParagraphConstraints constraints);
+  void layoutMetricsOnly(ParagraphConstraints constraints);
+  Future<void> prepareLayout();
   List<TextBox> getBoxesForRange(int start, int end,
       {BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight,
       BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight});
@@ -609,9 +611,11 @@ abstract class ParagraphBuilder {
       return engine.DomParagraphBuilder(style as engine.EngineParagraphStyle);
     }
   }
+  static const int popStyle = -1;
   void pushStyle(TextStyle style);
   void pop();
   void addText(String text);
+  void addStyledText(String text, List<TextStyle> styles, List<int> runs);
   Paragraph build();
   int get placeholderCount;
   List<double> get placeholderScales;
@@ -240,4 +240,33 @@ class IsolateNameServer {
   }
 }
 
+class IsolatePool {
+  // This class is only a namespace, and should not be instantiated or
+  // extended directly.
+  factory IsolatePool._() => throw UnsupportedError('Namespace');
+
+  static int get size => 0;
+
+  static Future<PooledIsolate> checkout() {
+    throw UnsupportedError('Isolates are not supported on the web.');
+  }
+
+  static Future<R> run<Q, R>(
+      FutureOr<R> Function(Q message) callback, Q message) {
+    throw UnsupportedError('Isolates are not supported on the web.');
+  }
+}
+
+class PooledIsolate {
+  PooledIsolate._();
+
+  Future<R> run<Q, R>(FutureOr<R> Function(Q message) callback, Q message) {
+    throw UnsupportedError('Isolates are not supported on the web.');
+  }
+
+  void release() {
+    throw UnsupportedError('Isolates are not supported on the web.');
+  }
+}
+
 SingletonFlutterWindow get window => engine.window;
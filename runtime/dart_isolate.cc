@@ -7,6 +7,7 @@
 #include <cstdlib>
 #include <tuple>
 
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/posix_wrappers.h"
 #include "flutter/fml/trace_event.h"
@@ -18,6 +19,7 @@
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/runtime/isolate_configuration.h"
+#include "flutter/runtime/snapshot_container.h"
 #include "fml/message_loop_task_queues.h"
 #include "fml/task_source.h"
 #include "fml/time/time_point.h"
@@ -101,6 +103,18 @@ std::weak_ptr<DartIsolate> DartIsolate::SpawnIsolate(
       GetVolatilePathTracker(), this);
 }
 
+// Asks dart:ui to spawn the pool of background isolates. The isolates are
+// spawned asynchronously once the root isolate runs its message loop.
+static bool StartIsolatePool(size_t size) {
+  Dart_Handle ui_library = Dart_LookupLibrary(tonic::ToDart("dart:ui"));
+  if (tonic::LogIfError(ui_library)) {
+    return false;
+  }
+  return !tonic::LogIfError(tonic::DartInvokeField(
+      ui_library, "_startIsolatePool",
+      {tonic::ToDart(static_cast<int64_t>(size))}));
+}
+
 std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     const Settings& settings,
     fml::RefPtr<const DartSnapshot> isolate_snapshot,
@@ -188,6 +202,13 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     settings.root_isolate_create_callback(*isolate.get());
   }
 
+  if (settings.isolate_pool_size > 0) {
+    tonic::DartState::Scope scope(isolate.get());
+    if (!StartIsolatePool(settings.isolate_pool_size)) {
+      FML_LOG(ERROR) << "Could not start the isolate pool.";
+    }
+  }
+
   if (!isolate->RunFromLibrary(dart_entrypoint_library,       //
                                dart_entrypoint,               //
                                settings.dart_entrypoint_args  //
@@ -338,6 +359,7 @@ DartIsolate::DartIsolate(
                   std::move(io_manager),
                   std::move(unref_queue),
                   std::move(image_decoder),
+                  DartVMRef::GetRunningVM()->GetConcurrentWorkerTaskRunner(),
                   advisory_script_uri,
                   advisory_script_entrypoint,
                   settings.log_tag,
@@ -346,7 +368,8 @@ DartIsolate::DartIsolate(
                   DartVMRef::GetIsolateNameServer(),
                   is_root_isolate,
                   std::move(volatile_path_tracker),
-                  settings.enable_skparagraph),
+                  settings.enable_skparagraph,
+                  settings.enable_display_list),
       may_insecurely_connect_to_all_domains_(
           settings.may_insecurely_connect_to_all_domains),
       domain_network_policy_(settings.domain_network_policy) {
@@ -422,6 +445,35 @@ bool DartIsolate::LoadLoadingUnit(
     intptr_t loading_unit_id,
     std::unique_ptr<const fml::Mapping> snapshot_data,
     std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  if (snapshot_data && SnapshotContainer::IsContainer(*snapshot_data) &&
+      (!snapshot_instructions || snapshot_instructions->GetSize() == 0)) {
+    SnapshotContainer::Decode(
+        std::move(snapshot_data), GetConcurrentTaskRunner(),
+        [weak_isolate = GetWeakIsolatePtr(),
+         ui_task_runner = GetTaskRunners().GetUITaskRunner(),
+         loading_unit_id](std::unique_ptr<const fml::Mapping> data,
+                          std::unique_ptr<const fml::Mapping> instructions) {
+          ui_task_runner->PostTask(fml::MakeCopyable(
+              [weak_isolate, loading_unit_id, data = std::move(data),
+               instructions = std::move(instructions)]() mutable {
+                auto isolate = weak_isolate.lock();
+                if (!isolate) {
+                  return;
+                }
+                if (!data) {
+                  isolate->LoadLoadingUnitError(
+                      loading_unit_id,
+                      "Could not decode the snapshot container.",
+                      /*transient*/ false);
+                  return;
+                }
+                isolate->LoadLoadingUnit(loading_unit_id, std::move(data),
+                                         std::move(instructions));
+              }));
+        });
+    return true;
+  }
+
   tonic::DartState::Scope scope(this);
 
   fml::RefPtr<DartSnapshot> dart_snapshot =
@@ -846,6 +898,15 @@ Dart_Isolate DartIsolate::DartCreateAndStartServiceIsolate(
     return nullptr;
   }
 
+  if (settings.lazy_observatory_startup) {
+    // The VM asks for the service isolate on one of its own threads, so
+    // waiting here holds back neither the VM nor the other isolates.
+    TRACE_EVENT0("flutter", "DartServiceIsolate::WaitForStartupRequest");
+    if (!DartServiceIsolate::WaitForStartupRequest()) {
+      return nullptr;
+    }
+  }
+
   TaskRunners null_task_runners("io.flutter." DART_VM_SERVICE_ISOLATE_NAME,
                                 nullptr, nullptr, nullptr, nullptr);
 
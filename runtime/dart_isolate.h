@@ -419,6 +419,18 @@ class DartIsolate : public UIDartState {
   ///
   fml::RefPtr<fml::TaskRunner> GetMessageHandlingTaskRunner() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Completes the deferred load of a loading unit with its
+  ///             snapshot.
+  ///
+  ///             If `snapshot_data` is a `SnapshotContainer` and there are no
+  ///             `snapshot_instructions`, the container is decoded on the
+  ///             concurrent task runner first, and the load is completed on
+  ///             the UI task runner once it is decoded.
+  ///
+  /// @return     Whether the load was completed, or the container decoding
+  ///             started.
+  ///
   bool LoadLoadingUnit(
       intptr_t loading_unit_id,
       std::unique_ptr<const fml::Mapping> snapshot_data,
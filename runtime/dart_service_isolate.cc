@@ -54,6 +54,14 @@ std::mutex DartServiceIsolate::callbacks_mutex_;
 std::set<std::unique_ptr<DartServiceIsolate::ObservatoryServerStateCallback>>
     DartServiceIsolate::callbacks_;
 
+std::mutex DartServiceIsolate::startup_request_mutex_;
+
+std::condition_variable DartServiceIsolate::startup_request_cv_;
+
+bool DartServiceIsolate::startup_requested_ = false;
+
+bool DartServiceIsolate::startup_request_cancelled_ = false;
+
 void DartServiceIsolate::NotifyServerState(Dart_NativeArguments args) {
   Dart_Handle exception = nullptr;
   std::string uri =
@@ -205,4 +213,31 @@ bool DartServiceIsolate::Startup(std::string server_ip,
   return true;
 }
 
+void DartServiceIsolate::RequestStartup() {
+  {
+    std::scoped_lock lock(startup_request_mutex_);
+    startup_requested_ = true;
+  }
+  startup_request_cv_.notify_all();
+}
+
+bool DartServiceIsolate::WaitForStartupRequest() {
+  std::unique_lock lock(startup_request_mutex_);
+  startup_request_cv_.wait(lock, []() {
+    return startup_requested_ || startup_request_cancelled_;
+  });
+  return !startup_request_cancelled_;
+}
+
+void DartServiceIsolate::SetStartupRequestCancelled(bool cancelled) {
+  {
+    std::scoped_lock lock(startup_request_mutex_);
+    startup_request_cancelled_ = cancelled;
+    if (cancelled) {
+      startup_requested_ = false;
+    }
+  }
+  startup_request_cv_.notify_all();
+}
+
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_RUNTIME_DART_SERVICE_ISOLATE_H_
 #define FLUTTER_RUNTIME_DART_SERVICE_ISOLATE_H_
 
+#include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <set>
@@ -95,6 +96,37 @@ class DartServiceIsolate {
   ///
   static bool RemoveServerStatusCallback(CallbackHandle handle);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Lets the service isolate of a VM whose settings ask for a lazy
+  ///             observatory startup start. Requests made before the VM asks
+  ///             for the service isolate apply as soon as it does, and are
+  ///             forgotten when the VM shuts down.
+  ///
+  ///             This method is thread safe.
+  ///
+  static void RequestStartup();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Blocks the calling thread until either `RequestStartup` is
+  ///             called or the VM shuts down.
+  ///
+  ///             This method is thread safe.
+  ///
+  /// @return     If the service isolate must be started.
+  ///
+  static bool WaitForStartupRequest();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes pending and future calls to `WaitForStartupRequest`
+  ///             return false, which the VM needs before it shuts down, or
+  ///             undoes that for the next VM.
+  ///
+  ///             This method is thread safe.
+  ///
+  /// @param[in]  cancelled  If the waits for a startup request are cancelled.
+  ///
+  static void SetStartupRequestCancelled(bool cancelled);
+
  private:
   // Native entries.
   static void NotifyServerState(Dart_NativeArguments args);
@@ -102,6 +134,11 @@ class DartServiceIsolate {
 
   static std::mutex callbacks_mutex_;
   static std::set<std::unique_ptr<ObservatoryServerStateCallback>> callbacks_;
+
+  static std::mutex startup_request_mutex_;
+  static std::condition_variable startup_request_cv_;
+  static bool startup_requested_;
+  static bool startup_request_cancelled_;
 };
 
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/runtime/dart_service_isolate.h"
 
+#include <thread>
+
 #include "flutter/testing/testing.h"
 
 namespace flutter {
@@ -15,4 +17,27 @@ TEST(DartServiceIsolateTest, CanAddAndRemoveHandles) {
   ASSERT_TRUE(DartServiceIsolate::RemoveServerStatusCallback(handle));
 }
 
+TEST(DartServiceIsolateTest, StartupWaitsForRequestOrCancellation) {
+  DartServiceIsolate::SetStartupRequestCancelled(false);
+  bool started = false;
+  std::thread waiter(
+      [&started]() { started = DartServiceIsolate::WaitForStartupRequest(); });
+  DartServiceIsolate::RequestStartup();
+  waiter.join();
+  ASSERT_TRUE(started);
+  // The request applies to later waits as well.
+  ASSERT_TRUE(DartServiceIsolate::WaitForStartupRequest());
+
+  // Shutting the VM down lets the waits go and forgets the request.
+  DartServiceIsolate::SetStartupRequestCancelled(true);
+  ASSERT_FALSE(DartServiceIsolate::WaitForStartupRequest());
+  DartServiceIsolate::SetStartupRequestCancelled(false);
+  std::thread cancelled_waiter(
+      [&started]() { started = DartServiceIsolate::WaitForStartupRequest(); });
+  DartServiceIsolate::SetStartupRequestCancelled(true);
+  cancelled_waiter.join();
+  ASSERT_FALSE(started);
+  DartServiceIsolate::SetStartupRequestCancelled(false);
+}
+
 }  // namespace flutter
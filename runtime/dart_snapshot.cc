@@ -5,6 +5,7 @@
 #include "flutter/runtime/dart_snapshot.h"
 
 #include <sstream>
+#include <thread>
 
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
@@ -29,14 +30,36 @@ const char* DartSnapshot::kIsolateInstructionsSymbol =
 
 #if !DART_SNAPSHOT_STATIC_LINK
 
-static std::unique_ptr<const fml::Mapping> GetFileMapping(
-    const std::string& path,
+// Asks the system to read the whole snapshot ahead and faults it in on a
+// background thread, which keeps the mapping alive until it is done. The
+// isolate then starts running from memory instead of paging the snapshot in
+// while the first frames are produced.
+static void PrefaultInBackground(
+    std::shared_ptr<const fml::FileMapping> mapping,
     bool executable) {
   if (executable) {
-    return fml::FileMapping::CreateReadExecute(path);
-  } else {
-    return fml::FileMapping::CreateReadOnly(path);
+    // Instructions are hot and jumped around in, so they benefit the most
+    // from fewer TLB misses. This must come before they are faulted in.
+    mapping->Advise({fml::FileMapping::AccessHint::kHugePages});
+  }
+  mapping->Advise({fml::FileMapping::AccessHint::kWillNeed});
+  std::thread([mapping = std::move(mapping)]() {
+    TRACE_EVENT0("flutter", "DartSnapshot::Prefault");
+    mapping->Prefault();
+  }).detach();
+}
+
+static std::shared_ptr<const fml::Mapping> GetFileMapping(
+    const std::string& path,
+    bool executable,
+    bool prefault) {
+  std::shared_ptr<const fml::FileMapping> mapping =
+      executable ? fml::FileMapping::CreateReadExecute(path)
+                 : fml::FileMapping::CreateReadOnly(path);
+  if (mapping && prefault) {
+    PrefaultInBackground(mapping, executable);
   }
+  return mapping;
 }
 
 // The first party embedders don't yet use the stable embedder API and depend on
@@ -55,7 +78,8 @@ static std::shared_ptr<const fml::Mapping> SearchMapping(
     const std::string& file_path,
     const std::vector<std::string>& native_library_path,
     const char* native_library_symbol_name,
-    bool is_executable) {
+    bool is_executable,
+    bool prefault) {
   // Ask the embedder. There is no fallback as we expect the embedders (via
   // their embedding APIs) to just specify the mappings directly.
   if (embedder_mapping_callback) {
@@ -64,7 +88,8 @@ static std::shared_ptr<const fml::Mapping> SearchMapping(
 
   // Attempt to open file at path specified.
   if (file_path.size() > 0) {
-    if (auto file_mapping = GetFileMapping(file_path, is_executable)) {
+    if (auto file_mapping =
+            GetFileMapping(file_path, is_executable, prefault)) {
       return file_mapping;
     }
   }
@@ -104,7 +129,8 @@ static std::shared_ptr<const fml::Mapping> ResolveVMData(
       settings.vm_snapshot_data_path,     // file_path
       settings.application_library_path,  // native_library_path
       DartSnapshot::kVMDataSymbol,        // native_library_symbol_name
-      false                               // is_executable
+      false,                              // is_executable
+      settings.prefault_snapshots         // prefault
   );
 #endif  // DART_SNAPSHOT_STATIC_LINK
 }
@@ -119,7 +145,8 @@ static std::shared_ptr<const fml::Mapping> ResolveVMInstructions(
       settings.vm_snapshot_instr_path,      // file_path
       settings.application_library_path,    // native_library_path
       DartSnapshot::kVMInstructionsSymbol,  // native_library_symbol_name
-      true                                  // is_executable
+      true,                                 // is_executable
+      settings.prefault_snapshots           // prefault
   );
 #endif  // DART_SNAPSHOT_STATIC_LINK
 }
@@ -134,7 +161,8 @@ static std::shared_ptr<const fml::Mapping> ResolveIsolateData(
       settings.isolate_snapshot_data_path,  // file_path
       settings.application_library_path,    // native_library_path
       DartSnapshot::kIsolateDataSymbol,     // native_library_symbol_name
-      false                                 // is_executable
+      false,                                // is_executable
+      settings.prefault_snapshots           // prefault
   );
 #endif  // DART_SNAPSHOT_STATIC_LINK
 }
@@ -150,7 +178,8 @@ static std::shared_ptr<const fml::Mapping> ResolveIsolateInstructions(
       settings.isolate_snapshot_instr_path,      // file_path
       settings.application_library_path,         // native_library_path
       DartSnapshot::kIsolateInstructionsSymbol,  // native_library_symbol_name
-      true                                       // is_executable
+      true,                                      // is_executable
+      settings.prefault_snapshots                // prefault
   );
 #endif  // DART_SNAPSHOT_STATIC_LINK
 }
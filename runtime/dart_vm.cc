@@ -273,9 +273,12 @@ DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
                std::shared_ptr<IsolateNameServer> isolate_name_server)
     : settings_(vm_data->GetSettings()),
       concurrent_message_loop_(fml::ConcurrentMessageLoop::Create()),
+      // Speculative Skia work may only keep half of the workers busy, so that
+      // work a frame waits on always finds one.
       skia_concurrent_executor_(
           [runner = concurrent_message_loop_->GetTaskRunner()](
-              fml::closure work) { runner->PostTask(work); }),
+              fml::closure work) { runner->PostTask(work); },
+          concurrent_message_loop_->GetWorkerCount() / 2),
       vm_data_(vm_data),
       isolate_name_server_(std::move(isolate_name_server)),
       service_protocol_(std::make_shared<ServiceProtocol>()) {
@@ -418,6 +421,7 @@ DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
 
   {
     TRACE_EVENT0("flutter", "Dart_Initialize");
+    DartServiceIsolate::SetStartupRequestCancelled(false);
     Dart_InitializeParams params = {};
     params.version = DART_INITIALIZE_PARAMS_CURRENT_VERSION;
     params.vm_snapshot_data = vm_data_->GetVMSnapshot().GetDataMapping();
@@ -483,6 +487,10 @@ DartVM::~DartVM() {
     Dart_ExitIsolate();
   }
 
+  // The VM waits for a pending startup of the service isolate as it shuts
+  // down.
+  DartServiceIsolate::SetStartupRequestCancelled(true);
+
   DartVMInitializer::Cleanup();
 
   dart::bin::CleanupDartIo();
@@ -6,11 +6,14 @@
 
 #include <mutex>
 
+#include "flutter/fml/synchronization/read_mostly_mutex.h"
+
 namespace flutter {
 
 // We need to explicitly put the constructor and destructor of the DartVM in the
 // critical section. All accesses (not just const members) to the global VM
-// object weak pointer are behind this mutex.
+// object weak pointer are behind this mutex, except for |GetRunningVM| which
+// reads it behind |gVMDependentsMutex| as it is also only written behind that.
 static std::mutex gVMMutex;
 static std::weak_ptr<DartVM> gVM;
 static std::shared_ptr<DartVM>* gVMLeak;
@@ -18,9 +21,10 @@ static std::shared_ptr<DartVM>* gVMLeak;
 // We are going to be modifying more than just the control blocks of the
 // following weak pointers (in the |Create| case where an old VM could not be
 // reused). Ideally, we would use |std::atomic<std::weak_ptr<T>>| specialization
-// but that is only available since C++20. We don't expect contention on these
-// locks so we just use one mutex for all.
-static std::mutex gVMDependentsMutex;
+// but that is only available since C++20. These are read every time an isolate
+// is created, and only written when a VM is, so one read-mostly mutex that
+// readers don't contend on is used for all.
+static fml::ReadMostlyMutex gVMDependentsMutex;
 static std::weak_ptr<const DartVMData> gVMData;
 static std::weak_ptr<ServiceProtocol> gVMServiceProtocol;
 static std::weak_ptr<IsolateNameServer> gVMIsolateNameServer;
@@ -64,7 +68,7 @@ DartVMRef DartVMRef::Create(Settings settings,
     return DartVMRef{std::move(vm)};
   }
 
-  std::scoped_lock dependents_lock(gVMDependentsMutex);
+  fml::ReadMostlyMutex::UniqueLock dependents_lock(gVMDependentsMutex);
 
   gVMData.reset();
   gVMServiceProtocol.reset();
@@ -103,22 +107,22 @@ bool DartVMRef::IsInstanceRunning() {
 }
 
 std::shared_ptr<const DartVMData> DartVMRef::GetVMData() {
-  std::scoped_lock lock(gVMDependentsMutex);
+  fml::ReadMostlyMutex::SharedLock lock(gVMDependentsMutex);
   return gVMData.lock();
 }
 
 std::shared_ptr<ServiceProtocol> DartVMRef::GetServiceProtocol() {
-  std::scoped_lock lock(gVMDependentsMutex);
+  fml::ReadMostlyMutex::SharedLock lock(gVMDependentsMutex);
   return gVMServiceProtocol.lock();
 }
 
 std::shared_ptr<IsolateNameServer> DartVMRef::GetIsolateNameServer() {
-  std::scoped_lock lock(gVMDependentsMutex);
+  fml::ReadMostlyMutex::SharedLock lock(gVMDependentsMutex);
   return gVMIsolateNameServer.lock();
 }
 
 DartVM* DartVMRef::GetRunningVM() {
-  std::scoped_lock lock(gVMMutex);
+  fml::ReadMostlyMutex::SharedLock lock(gVMDependentsMutex);
   auto vm = gVM.lock().get();
   FML_CHECK(vm) << "Caller assumed VM would be running when it wasn't";
   return vm;
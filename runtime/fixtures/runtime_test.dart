@@ -71,6 +71,18 @@ void testCanLaunchSecondaryIsolate() {
   Isolate.spawn(secondaryIsolateMain, 'Hello from root isolate.', onExit: onExit.sendPort);
 }
 
+int doubleInPooledIsolate(int value) => value * 2;
+
+@pragma('vm:entry-point')
+void testIsolatePoolRunsCallbacks() async {
+  final PooledIsolate isolate = await IsolatePool.checkout();
+  final int checkedOut = await isolate.run(doubleInPooledIsolate, 21);
+  isolate.release();
+  final int pooled = await IsolatePool.run(doubleInPooledIsolate, 4);
+  notifyResult(IsolatePool.size == 2 && checkedOut == 42 && pooled == 8 &&
+      IsolateNameServer.lookupPortByName('flutter.isolate_pool.0') != null);
+}
+
 @pragma('vm:entry-point')
 void testCanRecieveArguments(List<String> args) {
   notifyResult(args.length == 1 && args[0] == 'arg1');
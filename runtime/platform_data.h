@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/lib/ui/window/viewport_metrics.h"
@@ -31,6 +32,8 @@ struct PlatformData {
   ~PlatformData();
 
   ViewportMetrics viewport_metrics;
+  // The metrics of the views other than the implicit view, by view ID.
+  std::unordered_map<int64_t, ViewportMetrics> additional_view_metrics;
   std::string language_code;
   std::string country_code;
   std::string script_code;
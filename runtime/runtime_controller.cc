@@ -4,7 +4,9 @@
 
 #include "flutter/runtime/runtime_controller.h"
 
+#include "flutter/common/constants.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -13,6 +15,7 @@
 #include "flutter/lib/ui/window/window.h"
 #include "flutter/runtime/isolate_configuration.h"
 #include "flutter/runtime/runtime_delegate.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
 #include "third_party/tonic/dart_message_handler.h"
 
 namespace flutter {
@@ -120,6 +123,12 @@ std::unique_ptr<RuntimeController> RuntimeController::Clone() const {
 }
 
 bool RuntimeController::FlushRuntimeStateToIsolate() {
+  for (const auto& [view_id, metrics] :
+       platform_data_.additional_view_metrics) {
+    if (!SetViewportMetrics(metrics)) {
+      return false;
+    }
+  }
   return SetViewportMetrics(platform_data_.viewport_metrics) &&
          SetLocales(platform_data_.locale_data) &&
          SetSemanticsEnabled(platform_data_.semantics_enabled) &&
@@ -130,10 +139,14 @@ bool RuntimeController::FlushRuntimeStateToIsolate() {
 }
 
 bool RuntimeController::SetViewportMetrics(const ViewportMetrics& metrics) {
-  platform_data_.viewport_metrics = metrics;
+  if (metrics.view_id == kFlutterImplicitViewId) {
+    platform_data_.viewport_metrics = metrics;
+  } else {
+    platform_data_.additional_view_metrics[metrics.view_id] = metrics;
+  }
 
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
-    platform_configuration->get_window(0)->UpdateWindowMetrics(metrics);
+    platform_configuration->UpdateWindowMetrics(metrics);
     return true;
   }
 
@@ -230,6 +243,13 @@ bool RuntimeController::NotifyIdle(int64_t deadline, size_t freed_hint) {
   Dart_HintFreed(freed_hint);
   Dart_NotifyIdle(deadline);
 
+  if (unref_queue_) {
+    // The deadline is measured against the Dart timeline clock.
+    unref_queue_->NotifyIdle(
+        fml::TimePoint::Now() +
+        fml::TimeDelta::FromMicroseconds(deadline - Dart_TimelineGetMicros()));
+  }
+
   // Idle notifications being in isolate scope are part of the contract.
   if (idle_notification_callback_) {
     TRACE_EVENT0("flutter", "EmbedderIdleNotification");
@@ -250,12 +270,25 @@ bool RuntimeController::DispatchPlatformMessage(
   return false;
 }
 
+bool RuntimeController::DispatchPlatformMessages(
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    TRACE_EVENT1("flutter", "RuntimeController::DispatchPlatformMessages",
+                 "mode", "basic");
+    platform_configuration->DispatchPlatformMessages(std::move(messages));
+    return true;
+  }
+
+  return false;
+}
+
 bool RuntimeController::DispatchPointerDataPacket(
     const PointerDataPacket& packet) {
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
     TRACE_EVENT1("flutter", "RuntimeController::DispatchPointerDataPacket",
                  "mode", "basic");
-    platform_configuration->get_window(0)->DispatchPointerDataPacket(packet);
+    platform_configuration->get_window(kFlutterImplicitViewId)
+        ->DispatchPointerDataPacket(packet);
     return true;
   }
 
@@ -269,8 +302,8 @@ bool RuntimeController::DispatchKeyDataPacket(const KeyDataPacket& packet,
                  "basic");
     uint64_t response_id =
         platform_configuration->RegisterKeyDataResponse(std::move(callback));
-    platform_configuration->get_window(0)->DispatchKeyDataPacket(packet,
-                                                                 response_id);
+    platform_configuration->get_window(kFlutterImplicitViewId)
+        ->DispatchKeyDataPacket(packet, response_id);
     return true;
   }
   return false;
@@ -307,8 +340,27 @@ void RuntimeController::ScheduleFrame() {
 }
 
 // |PlatformConfigurationClient|
-void RuntimeController::Render(Scene* scene) {
-  client_.Render(scene->takeLayerTree());
+void RuntimeController::Render(Scene* scene, int64_t view_id) {
+  auto layer_tree = scene->takeLayerTree();
+  if (!layer_tree) {
+    return;
+  }
+  if (view_id != kFlutterImplicitViewId) {
+    auto* platform_configuration = GetPlatformConfigurationIfAvailable();
+    Window* window = platform_configuration
+                         ? platform_configuration->get_window(view_id)
+                         : nullptr;
+    if (!window) {
+      FML_LOG(ERROR) << "Could not render into the unknown view " << view_id
+                     << ".";
+      return;
+    }
+    const ViewportMetrics& metrics = window->viewport_metrics();
+    layer_tree->set_view(
+        view_id, SkISize::Make(metrics.physical_width, metrics.physical_height),
+        static_cast<float>(metrics.device_pixel_ratio));
+  }
+  client_.Render(std::move(layer_tree));
 }
 
 // |PlatformConfigurationClient|
@@ -329,6 +381,11 @@ FontCollection& RuntimeController::GetFontCollection() {
   return client_.GetFontCollection();
 }
 
+// |PlatformConfigurationClient|
+std::shared_ptr<AssetManager> RuntimeController::GetAssetManager() {
+  return client_.GetAssetManager();
+}
+
 // |PlatformConfigurationClient|
 void RuntimeController::UpdateIsolateDescription(const std::string isolate_name,
                                                  int64_t isolate_port) {
@@ -340,6 +397,13 @@ void RuntimeController::SetNeedsReportTimings(bool value) {
   client_.SetNeedsReportTimings(value);
 }
 
+// |PlatformConfigurationClient|
+void RuntimeController::SetFrameRateRange(double minimum,
+                                          double maximum,
+                                          double preferred) {
+  client_.SetFrameRateRange(minimum, maximum, preferred);
+}
+
 // |PlatformConfigurationClient|
 std::shared_ptr<const fml::Mapping>
 RuntimeController::GetPersistentIsolateData() {
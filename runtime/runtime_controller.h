@@ -378,6 +378,9 @@ class RuntimeController : public PlatformConfigurationClient {
   ///   the instigating allocation was made in the Dart VM or rather gracelessly
   ///   if the allocation is made by some native component.
   ///
+  /// The Skia objects waiting in the unref queue are also released until the
+  /// deadline.
+  ///
   /// @see        `Dart_TimelineGetMicros`
   ///
   /// @bug        The `deadline` argument must be converted to `std::chrono`
@@ -391,7 +394,7 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   /// @return     If the idle notification was forwarded to the running isolate.
   ///
-  bool NotifyIdle(int64_t deadline, size_t freed_hint);
+  virtual bool NotifyIdle(int64_t deadline, size_t freed_hint);
 
   //----------------------------------------------------------------------------
   /// @brief      Returns if the root isolate is running. The isolate must be
@@ -413,6 +416,18 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   virtual bool DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Dispatch a batch of platform messages to the running root
+  ///             isolate, in order and within a single Dart API scope.
+  ///
+  /// @param[in]  messages  The messages to dispatch to the isolate.
+  ///
+  /// @return     If the messages were dispatched to the running root isolate.
+  ///             This may fail is an isolate is not running.
+  ///
+  virtual bool DispatchPlatformMessages(
+      std::vector<fml::RefPtr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Dispatch the specified pointer data message to the running
   ///             root isolate.
@@ -649,7 +664,7 @@ class RuntimeController : public PlatformConfigurationClient {
   void ScheduleFrame() override;
 
   // |PlatformConfigurationClient|
-  void Render(Scene* scene) override;
+  void Render(Scene* scene, int64_t view_id) override;
 
   // |PlatformConfigurationClient|
   void UpdateSemantics(SemanticsUpdate* update) override;
@@ -660,6 +675,9 @@ class RuntimeController : public PlatformConfigurationClient {
   // |PlatformConfigurationClient|
   FontCollection& GetFontCollection() override;
 
+  // |PlatformConfigurationClient|
+  std::shared_ptr<AssetManager> GetAssetManager() override;
+
   // |PlatformConfigurationClient|
   void UpdateIsolateDescription(const std::string isolate_name,
                                 int64_t isolate_port) override;
@@ -667,6 +685,11 @@ class RuntimeController : public PlatformConfigurationClient {
   // |PlatformConfigurationClient|
   void SetNeedsReportTimings(bool value) override;
 
+  // |PlatformConfigurationClient|
+  void SetFrameRateRange(double minimum,
+                         double maximum,
+                         double preferred) override;
+
   // |PlatformConfigurationClient|
   std::shared_ptr<const fml::Mapping> GetPersistentIsolateData() override;
 
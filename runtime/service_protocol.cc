@@ -37,6 +37,15 @@ const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
+const std::string_view ServiceProtocol::kGetFlightRecorderTraceExtensionName =
+    "_flutter.getFlightRecorderTrace";
+const std::string_view
+    ServiceProtocol::kGetFrameTimingStatisticsExtensionName =
+        "_flutter.getFrameTimingStatistics";
+const std::string_view ServiceProtocol::kGetMemoryUsageExtensionName =
+    "_flutter.getMemoryUsage";
+const std::string_view ServiceProtocol::kGetStartupTimingsExtensionName =
+    "_flutter.getStartupTimings";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -56,6 +65,10 @@ ServiceProtocol::ServiceProtocol()
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
+          kGetFlightRecorderTraceExtensionName,
+          kGetFrameTimingStatisticsExtensionName,
+          kGetMemoryUsageExtensionName,
+          kGetStartupTimingsExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
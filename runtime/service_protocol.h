@@ -29,6 +29,10 @@ class ServiceProtocol {
   static const std::string_view kGetDisplayRefreshRateExtensionName;
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
+  static const std::string_view kGetFlightRecorderTraceExtensionName;
+  static const std::string_view kGetFrameTimingStatisticsExtensionName;
+  static const std::string_view kGetMemoryUsageExtensionName;
+  static const std::string_view kGetStartupTimingsExtensionName;
 
   class Handler {
    public:
@@ -4,12 +4,91 @@
 
 #include "flutter/runtime/skia_concurrent_executor.h"
 
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <mutex>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
-SkiaConcurrentExecutor::SkiaConcurrentExecutor(const OnWorkCallback& on_work)
-    : on_work_(on_work) {}
+namespace {
+
+thread_local SkiaConcurrentExecutor::Priority tCurrentPriority =
+    SkiaConcurrentExecutor::Priority::kNormal;
+
+}  // namespace
+
+SkiaConcurrentExecutor::ScopedPriority::ScopedPriority(Priority priority)
+    : previous_(tCurrentPriority) {
+  tCurrentPriority = priority;
+}
+
+SkiaConcurrentExecutor::ScopedPriority::~ScopedPriority() {
+  tCurrentPriority = previous_;
+}
+
+SkiaConcurrentExecutor::Priority SkiaConcurrentExecutor::GetCurrentPriority() {
+  return tCurrentPriority;
+}
+
+struct SkiaConcurrentExecutor::PendingWork {
+  explicit PendingWork(size_t speculative_worker_limit)
+      : speculative_worker_limit(
+            std::max<size_t>(speculative_worker_limit, 1)) {}
+
+  const size_t speculative_worker_limit;
+  std::mutex mutex;
+  std::array<std::deque<fml::closure>, static_cast<size_t>(Priority::kCount)>
+      queues;
+  size_t running_speculative_work = 0;
+
+  // Runs the most urgent work that may be started, and keeps going while
+  // there is some. Scheduled once per added work, so a task may find nothing
+  // left to do.
+  void Run() {
+    std::unique_lock lock(mutex);
+    while (true) {
+      fml::closure work;
+      bool speculative = false;
+      for (size_t i = 0; i < queues.size(); i++) {
+        if (queues[i].empty()) {
+          continue;
+        }
+        speculative = i == static_cast<size_t>(Priority::kSpeculative);
+        // Left for a worker that finishes speculative work to pick up.
+        if (speculative &&
+            running_speculative_work >= speculative_worker_limit) {
+          break;
+        }
+        work = std::move(queues[i].front());
+        queues[i].pop_front();
+        break;
+      }
+      if (!work) {
+        return;
+      }
+      if (speculative) {
+        running_speculative_work++;
+      }
+      lock.unlock();
+      {
+        TRACE_EVENT0("flutter", "SkiaExecutor");
+        work();
+      }
+      lock.lock();
+      if (speculative) {
+        running_speculative_work--;
+      }
+    }
+  }
+};
+
+SkiaConcurrentExecutor::SkiaConcurrentExecutor(const OnWorkCallback& on_work,
+                                               size_t speculative_worker_limit)
+    : on_work_(on_work),
+      pending_(std::make_shared<PendingWork>(speculative_worker_limit)) {}
 
 SkiaConcurrentExecutor::~SkiaConcurrentExecutor() = default;
 
@@ -17,10 +96,12 @@ void SkiaConcurrentExecutor::add(fml::closure work) {
   if (!work) {
     return;
   }
-  on_work_([work]() {
-    TRACE_EVENT0("flutter", "SkiaExecutor");
-    work();
-  });
+  {
+    std::scoped_lock lock(pending_->mutex);
+    pending_->queues[static_cast<size_t>(tCurrentPriority)].push_back(
+        std::move(work));
+  }
+  on_work_([pending = pending_]() { pending->Run(); });
 }
 
 }  // namespace flutter
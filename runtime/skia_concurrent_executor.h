@@ -5,6 +5,9 @@
 #ifndef FLUTTER_RUNTIME_SKIA_CONCURRENT_EXECUTOR_H_
 #define FLUTTER_RUNTIME_SKIA_CONCURRENT_EXECUTOR_H_
 
+#include <limits>
+#include <memory>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkExecutor.h"
@@ -24,8 +27,52 @@ namespace flutter {
 ///             worker pool is held next to the process global Dart VM instance.
 ///             The Skia executor is wired up there as well.
 ///
+///             Skia does not say how urgent its work is, so the work added
+///             on a thread gets the priority of the innermost
+///             |ScopedPriority| alive on that thread. Work of a higher
+///             priority is started before pending work of a lower one, and
+///             speculative work is kept from occupying more than a limited
+///             number of workers at once.
+///
 class SkiaConcurrentExecutor : public SkExecutor {
  public:
+  //----------------------------------------------------------------------------
+  /// The classes of work of the executor, from the most to the least urgent.
+  ///
+  enum class Priority {
+    /// Work the frame being rasterized waits on, like a shader or a path mask
+    /// it needs.
+    kFrameCritical,
+    /// Work added outside of any |ScopedPriority|.
+    kNormal,
+    /// Work done ahead of time in case it is needed later, like precompiling
+    /// SkSL from the persistent cache.
+    kSpeculative,
+    kCount,
+  };
+
+  //----------------------------------------------------------------------------
+  /// Gives the work Skia adds on the current thread the priority for the
+  /// lifetime of this object. Scopes nest, and restore the previous priority
+  /// when they end.
+  ///
+  class ScopedPriority {
+   public:
+    explicit ScopedPriority(Priority priority);
+
+    ~ScopedPriority();
+
+   private:
+    const Priority previous_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedPriority);
+  };
+
+  //----------------------------------------------------------------------------
+  /// @return     The priority of the work added on the current thread.
+  ///
+  static Priority GetCurrentPriority();
+
   //----------------------------------------------------------------------------
   /// The callback invoked by the executor to schedule the given task onto an
   /// engine managed background thread.
@@ -35,9 +82,13 @@ class SkiaConcurrentExecutor : public SkExecutor {
   //----------------------------------------------------------------------------
   /// @brief      Create a new instance of the executor.
   ///
-  /// @param[in]  on_work  The work callback.
+  /// @param[in]  on_work                   The work callback.
+  /// @param[in]  speculative_worker_limit  The most workers that may run
+  ///                                       speculative work at the same time.
   ///
-  SkiaConcurrentExecutor(const OnWorkCallback& on_work);
+  SkiaConcurrentExecutor(const OnWorkCallback& on_work,
+                         size_t speculative_worker_limit =
+                             std::numeric_limits<size_t>::max());
 
   // |SkExecutor|
   ~SkiaConcurrentExecutor() override;
@@ -46,7 +97,12 @@ class SkiaConcurrentExecutor : public SkExecutor {
   void add(fml::closure work) override;
 
  private:
+  // The work added but not started yet. It is shared with the tasks
+  // scheduled with |on_work_|, which may outlive the executor.
+  struct PendingWork;
+
   OnWorkCallback on_work_;
+  std::shared_ptr<PendingWork> pending_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SkiaConcurrentExecutor);
 };
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/skia_concurrent_executor.h"
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(SkiaConcurrentExecutorTest, RunsMoreUrgentWorkFirst) {
+  std::vector<fml::closure> tasks;
+  SkiaConcurrentExecutor executor(
+      [&tasks](fml::closure work) { tasks.push_back(std::move(work)); });
+  std::vector<int> order;
+  {
+    SkiaConcurrentExecutor::ScopedPriority priority(
+        SkiaConcurrentExecutor::Priority::kSpeculative);
+    executor.add([&order]() { order.push_back(3); });
+    {
+      SkiaConcurrentExecutor::ScopedPriority nested(
+          SkiaConcurrentExecutor::Priority::kFrameCritical);
+      executor.add([&order]() { order.push_back(1); });
+    }
+    ASSERT_EQ(SkiaConcurrentExecutor::GetCurrentPriority(),
+              SkiaConcurrentExecutor::Priority::kSpeculative);
+  }
+  executor.add([&order]() { order.push_back(2); });
+  ASSERT_EQ(tasks.size(), 3u);
+
+  tasks[0]();
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+  // The other tasks find the work already done.
+  tasks[1]();
+  tasks[2]();
+  EXPECT_EQ(order.size(), 3u);
+}
+
+TEST(SkiaConcurrentExecutorTest, LimitsWorkersRunningSpeculativeWork) {
+  std::vector<fml::closure> tasks;
+  SkiaConcurrentExecutor executor(
+      [&tasks](fml::closure work) { tasks.push_back(std::move(work)); },
+      /*speculative_worker_limit=*/1);
+  std::vector<int> order;
+  SkiaConcurrentExecutor::ScopedPriority priority(
+      SkiaConcurrentExecutor::Priority::kSpeculative);
+  executor.add([&order, &tasks]() {
+    order.push_back(1);
+    // Another worker may not start speculative work while this one runs.
+    tasks[1]();
+    EXPECT_EQ(order, (std::vector<int>{1}));
+  });
+  executor.add([&order]() { order.push_back(2); });
+  ASSERT_EQ(tasks.size(), 2u);
+
+  tasks[0]();
+  EXPECT_EQ(order, (std::vector<int>{1, 2}));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,325 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_container.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+#if defined(OS_WIN)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace flutter {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x43534c46;  // "FLSC"
+constexpr uint32_t kVersion = 1;
+
+enum Section : uint32_t {
+  kDataSection = 0,
+  kInstructionsSection = 1,
+  kSectionCount = 2,
+};
+
+// The containers are read and written with the layout of these structs,
+// which is the same on all supported targets, as they are little endian.
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t frame_count;
+  uint32_t reserved;
+  uint64_t section_sizes[kSectionCount];
+};
+
+struct Frame {
+  uint32_t section;
+  uint32_t codec;
+  uint64_t decoded_offset;
+  uint64_t decoded_size;
+  uint64_t encoded_offset;
+  uint64_t encoded_size;
+};
+
+static_assert(sizeof(Header) == 32, "The header must not be padded.");
+static_assert(sizeof(Frame) == 40, "Frames must not be padded.");
+
+// Whole pages of memory that a section is decoded into.
+class SectionMapping final : public fml::Mapping {
+ public:
+  explicit SectionMapping(size_t size) : size_(size) {
+    if (size_ == 0) {
+      return;
+    }
+#if defined(OS_WIN)
+    data_ = static_cast<uint8_t*>(::VirtualAlloc(
+        nullptr, size_, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+#else
+    void* mapping = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    data_ = mapping == MAP_FAILED ? nullptr : static_cast<uint8_t*>(mapping);
+#endif
+  }
+
+  ~SectionMapping() override {
+    if (!data_) {
+      return;
+    }
+#if defined(OS_WIN)
+    ::VirtualFree(data_, 0, MEM_RELEASE);
+#else
+    ::munmap(data_, size_);
+#endif
+  }
+
+  bool IsValid() const { return size_ == 0 || data_ != nullptr; }
+
+  uint8_t* GetMutableMapping() { return data_; }
+
+  // Makes the section read only, and executable if |executable| is true.
+  bool Protect(bool executable) {
+    if (!data_) {
+      return true;
+    }
+#if defined(OS_WIN)
+    DWORD old_protection;
+    return ::VirtualProtect(data_, size_,
+                            executable ? PAGE_EXECUTE_READ : PAGE_READONLY,
+                            &old_protection);
+#else
+    return ::mprotect(data_, size_,
+                      PROT_READ | (executable ? PROT_EXEC : 0)) == 0;
+#endif
+  }
+
+  // |fml::Mapping|
+  size_t GetSize() const override { return size_; }
+
+  // |fml::Mapping|
+  const uint8_t* GetMapping() const override { return data_; }
+
+ private:
+  const size_t size_;
+  uint8_t* data_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SectionMapping);
+};
+
+bool DecodeStoredFrame(const uint8_t* encoded,
+                       size_t encoded_size,
+                       uint8_t* decoded,
+                       size_t decoded_size) {
+  if (encoded_size != decoded_size) {
+    return false;
+  }
+  if (decoded_size > 0) {
+    ::memcpy(decoded, encoded, decoded_size);
+  }
+  return true;
+}
+
+std::mutex& GetCodecsMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<uint32_t, SnapshotContainer::FrameDecoder>& GetCodecs() {
+  static auto* codecs =
+      new std::unordered_map<uint32_t, SnapshotContainer::FrameDecoder>();
+  return *codecs;
+}
+
+SnapshotContainer::FrameDecoder GetFrameDecoder(uint32_t codec) {
+  if (codec == SnapshotContainer::kStoredCodec) {
+    return DecodeStoredFrame;
+  }
+  std::scoped_lock lock(GetCodecsMutex());
+  auto found = GetCodecs().find(codec);
+  return found == GetCodecs().end() ? nullptr : found->second;
+}
+
+// Reads the header and frame table of |container| and checks that every frame
+// lies within the container and its section.
+bool ReadFrames(const fml::Mapping& container,
+                Header& header,
+                std::vector<Frame>& frames) {
+  if (!SnapshotContainer::IsContainer(container)) {
+    return false;
+  }
+  const uint8_t* bytes = container.GetMapping();
+  const size_t size = container.GetSize();
+  ::memcpy(&header, bytes, sizeof(Header));
+  if (header.version != kVersion || header.frame_count == 0 ||
+      header.frame_count > (size - sizeof(Header)) / sizeof(Frame)) {
+    return false;
+  }
+  for (uint64_t section_size : header.section_sizes) {
+    if (section_size > std::numeric_limits<size_t>::max()) {
+      return false;
+    }
+  }
+
+  frames.resize(header.frame_count);
+  ::memcpy(frames.data(), bytes + sizeof(Header),
+           header.frame_count * sizeof(Frame));
+  for (const Frame& frame : frames) {
+    if (frame.section >= kSectionCount) {
+      return false;
+    }
+    const uint64_t section_size = header.section_sizes[frame.section];
+    if (frame.decoded_offset > section_size ||
+        frame.decoded_size > section_size - frame.decoded_offset ||
+        frame.encoded_offset > size ||
+        frame.encoded_size > size - frame.encoded_offset) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct DecodeState {
+  std::shared_ptr<const fml::Mapping> container;
+  std::unique_ptr<SectionMapping> sections[kSectionCount];
+  std::atomic<size_t> remaining_frames;
+  std::atomic<bool> failed = false;
+  SnapshotContainer::DecodeCallback callback;
+};
+
+void DecodeFrame(DecodeState& state, const Frame& frame) {
+  TRACE_EVENT0("flutter", "SnapshotContainer::DecodeFrame");
+  SnapshotContainer::FrameDecoder decoder = GetFrameDecoder(frame.codec);
+  if (!decoder) {
+    FML_LOG(ERROR) << "No decoder is registered for the snapshot codec "
+                   << frame.codec << ".";
+    state.failed = true;
+    return;
+  }
+  uint8_t* section = state.sections[frame.section]->GetMutableMapping();
+  if (!decoder(state.container->GetMapping() + frame.encoded_offset,
+               frame.encoded_size, section + frame.decoded_offset,
+               frame.decoded_size)) {
+    state.failed = true;
+  }
+}
+
+void FinishDecode(DecodeState& state) {
+  if (state.failed || !state.sections[kDataSection]->Protect(false) ||
+      !state.sections[kInstructionsSection]->Protect(true)) {
+    FML_LOG(ERROR) << "Could not decode the snapshot container.";
+    state.callback(nullptr, nullptr);
+    return;
+  }
+  state.callback(std::move(state.sections[kDataSection]),
+                 std::move(state.sections[kInstructionsSection]));
+}
+
+}  // namespace
+
+void SnapshotContainer::RegisterCodec(uint32_t codec, FrameDecoder decoder) {
+  if (codec == kStoredCodec) {
+    return;
+  }
+  std::scoped_lock lock(GetCodecsMutex());
+  GetCodecs()[codec] = std::move(decoder);
+}
+
+bool SnapshotContainer::IsContainer(const fml::Mapping& mapping) {
+  if (mapping.GetMapping() == nullptr || mapping.GetSize() < sizeof(Header)) {
+    return false;
+  }
+  uint32_t magic;
+  ::memcpy(&magic, mapping.GetMapping(), sizeof(magic));
+  return magic == kMagic;
+}
+
+std::unique_ptr<fml::Mapping> SnapshotContainer::CreateStored(
+    const fml::Mapping& data,
+    const fml::Mapping& instructions,
+    size_t frame_size) {
+  const fml::Mapping* sections[kSectionCount] = {&data, &instructions};
+  std::vector<Frame> frames;
+  for (uint32_t section = 0; section < kSectionCount; section++) {
+    const size_t section_size = sections[section]->GetSize();
+    const size_t step = frame_size == 0 ? section_size : frame_size;
+    for (size_t offset = 0; offset < section_size; offset += step) {
+      const size_t size = std::min(step, section_size - offset);
+      frames.push_back({section, kStoredCodec, offset, size, 0, size});
+    }
+  }
+
+  Header header = {};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.frame_count = frames.size();
+  header.section_sizes[kDataSection] = data.GetSize();
+  header.section_sizes[kInstructionsSection] = instructions.GetSize();
+
+  std::vector<uint8_t> bytes(sizeof(Header) + frames.size() * sizeof(Frame));
+  for (Frame& frame : frames) {
+    frame.encoded_offset = bytes.size();
+    const uint8_t* decoded =
+        sections[frame.section]->GetMapping() + frame.decoded_offset;
+    bytes.insert(bytes.end(), decoded, decoded + frame.decoded_size);
+  }
+  ::memcpy(bytes.data(), &header, sizeof(Header));
+  ::memcpy(bytes.data() + sizeof(Header), frames.data(),
+           frames.size() * sizeof(Frame));
+  return std::make_unique<fml::DataMapping>(std::move(bytes));
+}
+
+void SnapshotContainer::Decode(
+    std::shared_ptr<const fml::Mapping> container,
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner,
+    DecodeCallback callback) {
+  TRACE_EVENT0("flutter", "SnapshotContainer::Decode");
+  Header header;
+  std::vector<Frame> frames;
+  if (!container || !ReadFrames(*container, header, frames)) {
+    FML_LOG(ERROR) << "The snapshot container is malformed.";
+    callback(nullptr, nullptr);
+    return;
+  }
+
+  auto state = std::make_shared<DecodeState>();
+  state->container = std::move(container);
+  for (uint32_t section = 0; section < kSectionCount; section++) {
+    state->sections[section] =
+        std::make_unique<SectionMapping>(header.section_sizes[section]);
+    if (!state->sections[section]->IsValid()) {
+      FML_LOG(ERROR) << "Could not allocate the snapshot container sections.";
+      callback(nullptr, nullptr);
+      return;
+    }
+  }
+  state->remaining_frames = frames.size();
+  state->callback = std::move(callback);
+
+  for (const Frame& frame : frames) {
+    auto decode = [state, frame]() {
+      DecodeFrame(*state, frame);
+      if (state->remaining_frames.fetch_sub(1) == 1) {
+        FinishDecode(*state);
+      }
+    };
+    if (task_runner) {
+      task_runner->PostTask(decode);
+    } else {
+      decode();
+    }
+  }
+}
+
+}  // namespace flutter
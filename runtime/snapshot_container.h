@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_SNAPSHOT_CONTAINER_H_
+#define FLUTTER_RUNTIME_SNAPSHOT_CONTAINER_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A container for the data and instructions of an AOT snapshot
+///             that are split into independently encoded frames.
+///
+///             A container starts with a header, followed by a table that
+///             describes every frame: the section it belongs to, the codec it
+///             was encoded with, and where it lives in the container and in
+///             its decoded section. Decoding a container decodes all of its
+///             frames in parallel into memory that is allocated a page at a
+///             time, and then makes the instructions section executable.
+///
+///             Frames are stored as they are with `kStoredCodec`. Other codecs
+///             can be registered with `RegisterCodec` by embedders that ship a
+///             decompressor.
+///
+///             All values in the container are little endian.
+///
+class SnapshotContainer {
+ public:
+  /// The codec of frames that are stored without being encoded.
+  static constexpr uint32_t kStoredCodec = 0;
+
+  //----------------------------------------------------------------------------
+  /// Decodes a frame of `encoded_size` bytes at `encoded` into the
+  /// `decoded_size` bytes at `decoded`, and returns whether that succeeded.
+  /// Called on the task runner the container is decoded on.
+  ///
+  using FrameDecoder = std::function<bool(const uint8_t* encoded,
+                                          size_t encoded_size,
+                                          uint8_t* decoded,
+                                          size_t decoded_size)>;
+
+  //----------------------------------------------------------------------------
+  /// Called with the decoded data and instructions of a container, or with
+  /// null mappings if it could not be decoded.
+  ///
+  using DecodeCallback =
+      std::function<void(std::unique_ptr<const fml::Mapping> data,
+                         std::unique_ptr<const fml::Mapping> instructions)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Registers the decoder of the frames encoded with `codec`,
+  ///             replacing any decoder registered for it before.
+  ///             `kStoredCodec` cannot be replaced.
+  ///
+  static void RegisterCodec(uint32_t codec, FrameDecoder decoder);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether `mapping` starts with the header of a container.
+  ///
+  static bool IsContainer(const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a container with the given data and instructions,
+  ///             split into frames of up to `frame_size` bytes that are
+  ///             stored with `kStoredCodec`.
+  ///
+  static std::unique_ptr<fml::Mapping> CreateStored(
+      const fml::Mapping& data,
+      const fml::Mapping& instructions,
+      size_t frame_size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Decodes the frames of `container` in parallel on
+  ///             `task_runner`, or on the calling thread if it is null.
+  ///
+  /// @param[in]  container    The container to decode. It is kept alive until
+  ///                          it is decoded.
+  /// @param[in]  task_runner  The task runner to decode the frames on.
+  /// @param[in]  callback     Called on the thread that decoded the last
+  ///                          frame, once all of them are decoded.
+  ///
+  static void Decode(std::shared_ptr<const fml::Mapping> container,
+                     std::shared_ptr<fml::ConcurrentTaskRunner> task_runner,
+                     DecodeCallback callback);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(SnapshotContainer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_SNAPSHOT_CONTAINER_H_
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_container.h"
+
+#include <cstring>
+#include <string>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+}  // namespace
+
+TEST(SnapshotContainerTest, DecodesStoredFramesInParallel) {
+  fml::DataMapping data(std::string(10000, 'd'));
+  fml::DataMapping instructions(std::string("instructions"));
+  std::shared_ptr<const fml::Mapping> container =
+      SnapshotContainer::CreateStored(data, instructions, 1024);
+  ASSERT_TRUE(SnapshotContainer::IsContainer(*container));
+  ASSERT_FALSE(SnapshotContainer::IsContainer(data));
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  fml::AutoResetWaitableEvent latch;
+  std::unique_ptr<const fml::Mapping> decoded_data;
+  std::unique_ptr<const fml::Mapping> decoded_instructions;
+  SnapshotContainer::Decode(
+      container, loop->GetTaskRunner(),
+      [&](std::unique_ptr<const fml::Mapping> data,
+          std::unique_ptr<const fml::Mapping> instructions) {
+        decoded_data = std::move(data);
+        decoded_instructions = std::move(instructions);
+        latch.Signal();
+      });
+  latch.Wait();
+
+  ASSERT_TRUE(decoded_data);
+  ASSERT_TRUE(decoded_instructions);
+  EXPECT_EQ(ToString(*decoded_data), ToString(data));
+  EXPECT_EQ(ToString(*decoded_instructions), ToString(instructions));
+}
+
+TEST(SnapshotContainerTest, DecodesFramesWithRegisteredCodecs) {
+  constexpr uint32_t kInvertCodec = 42;
+  SnapshotContainer::RegisterCodec(
+      kInvertCodec, [](const uint8_t* encoded, size_t encoded_size,
+                       uint8_t* decoded, size_t decoded_size) {
+        for (size_t i = 0; i < decoded_size; i++) {
+          decoded[i] = ~encoded[i];
+        }
+        return encoded_size == decoded_size;
+      });
+
+  fml::DataMapping data(std::string("data"));
+  fml::DataMapping instructions{std::string()};
+  auto container = SnapshotContainer::CreateStored(data, instructions, 0);
+  // Rewrite the only frame to the inverting codec. The codec of the first
+  // frame follows the 32 byte header and the section of that frame.
+  std::vector<uint8_t> bytes(container->GetMapping(),
+                             container->GetMapping() + container->GetSize());
+  ::memcpy(bytes.data() + 36, &kInvertCodec, sizeof(kInvertCodec));
+  for (size_t i = bytes.size() - data.GetSize(); i < bytes.size(); i++) {
+    bytes[i] = ~bytes[i];
+  }
+
+  std::unique_ptr<const fml::Mapping> decoded_data;
+  SnapshotContainer::Decode(
+      std::make_shared<fml::DataMapping>(std::move(bytes)), nullptr,
+      [&](std::unique_ptr<const fml::Mapping> data,
+          std::unique_ptr<const fml::Mapping> instructions) {
+        decoded_data = std::move(data);
+      });
+
+  ASSERT_TRUE(decoded_data);
+  EXPECT_EQ(ToString(*decoded_data), "data");
+}
+
+TEST(SnapshotContainerTest, RejectsMalformedContainers) {
+  fml::DataMapping data(std::string("data"));
+  fml::DataMapping instructions(std::string("instructions"));
+  auto container = SnapshotContainer::CreateStored(data, instructions, 0);
+
+  // Truncated frames lie outside the container.
+  auto truncated = std::make_shared<fml::DataMapping>(std::vector<uint8_t>(
+      container->GetMapping(),
+      container->GetMapping() + container->GetSize() - 1));
+  ASSERT_TRUE(SnapshotContainer::IsContainer(*truncated));
+
+  bool called = false;
+  SnapshotContainer::Decode(
+      truncated, nullptr,
+      [&](std::unique_ptr<const fml::Mapping> data,
+          std::unique_ptr<const fml::Mapping> instructions) {
+        called = true;
+        EXPECT_FALSE(data);
+        EXPECT_FALSE(instructions);
+      });
+  ASSERT_TRUE(called);
+}
+
+}  // namespace testing
+}  // namespace flutter
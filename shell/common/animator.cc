@@ -4,6 +4,9 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
+
+#include "flutter/common/constants.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
@@ -17,11 +20,20 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// The vsyncs of displays do not all come at the exact interval of the idle
+// frame rate. A frame is only skipped if less than this fraction of the idle
+// frame interval passed since the last one, so that at 60Hz an idle frame rate
+// of 30 fps produces a frame on every other vsync.
+constexpr double kIdleFrameIntervalTolerance = 0.75;
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
                    TaskRunners task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   std::shared_ptr<PipelineDepthTuner> pipeline_depth_tuner,
+                   std::shared_ptr<IdleFrameRateTuner> idle_frame_rate_tuner,
+                   std::shared_ptr<BeginFrameDelayTuner> begin_frame_delay_tuner)
     : delegate_(delegate),
       task_runners_(std::move(task_runners)),
       waiter_(std::move(waiter)),
@@ -30,17 +42,21 @@ Animator::Animator(Delegate& delegate,
       last_frame_target_time_(),
       dart_frame_deadline_(0),
 #if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(fml::MakeRefCounted<LayerTreePipeline>(2)),
+      layer_tree_pipeline_(
+          fml::MakeRefCounted<FramePipeline>(kMaxLayerTreePipelineDepth)),
 #else   // SHELL_ENABLE_METAL
       // TODO(dnfield): We should remove this logic and set the pipeline depth
       // back to 2 in this case. See
       // https://github.com/flutter/engine/pull/9132 for discussion.
-      layer_tree_pipeline_(fml::MakeRefCounted<LayerTreePipeline>(
+      layer_tree_pipeline_(fml::MakeRefCounted<FramePipeline>(
           task_runners.GetPlatformTaskRunner() ==
                   task_runners.GetRasterTaskRunner()
               ? 1
-              : 2)),
+              : kMaxLayerTreePipelineDepth)),
 #endif  // SHELL_ENABLE_METAL
+      pipeline_depth_tuner_(std::move(pipeline_depth_tuner)),
+      idle_frame_rate_tuner_(std::move(idle_frame_rate_tuner)),
+      begin_frame_delay_tuner_(std::move(begin_frame_delay_tuner)),
       pending_frame_semaphore_(1),
       frame_number_(1),
       paused_(false),
@@ -57,6 +73,11 @@ void Animator::Stop() {
   paused_ = true;
 }
 
+void Animator::SetFrameRateRange(const FrameRateRange& range) {
+  TRACE_EVENT0("flutter", "Animator::SetFrameRateRange");
+  waiter_->SetFrameRateRange(range);
+}
+
 void Animator::Start() {
   if (!paused_) {
     return;
@@ -113,6 +134,14 @@ void Animator::BeginFrame(fml::TimePoint vsync_start_time,
   pending_frame_semaphore_.Signal();
 
   if (!producer_continuation_) {
+    if (pipeline_depth_tuner_) {
+      const uint32_t depth = pipeline_depth_tuner_->GetRecommendedDepth();
+      if (depth != layer_tree_pipeline_->GetEffectiveDepth()) {
+        TRACE_EVENT1("flutter", "Animator::SetPipelineDepth", "depth",
+                     std::to_string(depth).c_str());
+        layer_tree_pipeline_->SetEffectiveDepth(depth);
+      }
+    }
     // We may already have a valid pipeline continuation in case a previous
     // begin frame did not result in an Animation::Render. Simply reuse that
     // instead of asking the pipeline for a fresh continuation.
@@ -141,8 +170,11 @@ void Animator::BeginFrame(fml::TimePoint vsync_start_time,
   {
     TRACE_EVENT2("flutter", "Framework Workload", "mode", "basic", "frame",
                  FrameParity());
+    frame_in_progress_ = true;
     delegate_.OnAnimatorBeginFrame(frame_target_time);
+    frame_in_progress_ = false;
   }
+  EndFrame();
 
   if (!frame_scheduled_) {
     // Under certain workloads (such as our parent view resizing us, which is
@@ -174,18 +206,46 @@ void Animator::BeginFrame(fml::TimePoint vsync_start_time,
 }
 
 void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
-  if (dimension_change_pending_ &&
-      layer_tree->frame_size() != last_layer_tree_size_) {
-    dimension_change_pending_ = false;
+  if (layer_tree->view_id() == kFlutterImplicitViewId) {
+    if (dimension_change_pending_ &&
+        layer_tree->frame_size() != last_layer_tree_size_) {
+      dimension_change_pending_ = false;
+    }
+    last_layer_tree_size_ = layer_tree->frame_size();
   }
-  last_layer_tree_size_ = layer_tree->frame_size();
 
   // Note the frame time for instrumentation.
   layer_tree->RecordBuildTime(last_vsync_start_time_, last_frame_begin_time_,
                               last_frame_target_time_);
 
+  // A view that is rendered again replaces its previous layer tree.
+  auto previous = std::find_if(
+      pending_layer_trees_.begin(), pending_layer_trees_.end(),
+      [&](const auto& pending) {
+        return pending->view_id() == layer_tree->view_id();
+      });
+  if (previous != pending_layer_trees_.end()) {
+    *previous = std::move(layer_tree);
+  } else {
+    pending_layer_trees_.push_back(std::move(layer_tree));
+  }
+
+  if (!frame_in_progress_) {
+    EndFrame();
+  }
+}
+
+void Animator::EndFrame() {
+  if (pending_layer_trees_.empty()) {
+    return;
+  }
+
+  auto frame_item = std::make_unique<FrameItem>();
+  frame_item->layer_trees = std::move(pending_layer_trees_);
+  pending_layer_trees_.clear();
+
   // Commit the pending continuation.
-  bool result = producer_continuation_.Complete(std::move(layer_tree));
+  bool result = producer_continuation_.Complete(std::move(frame_item));
   if (!result) {
     FML_DLOG(INFO) << "No pending continuation to commit";
   }
@@ -241,8 +301,11 @@ void Animator::AwaitVSync() {
         if (self) {
           if (self->CanReuseLastLayerTree()) {
             self->DrawLastLayerTree();
+          } else if (self->ShouldSkipVsync(frame_target_time)) {
+            TRACE_EVENT0("flutter", "Animator::SkipIdleVsync");
+            self->AwaitVSync();
           } else {
-            self->BeginFrame(vsync_start_time, frame_target_time);
+            self->ScheduleBeginFrame(vsync_start_time, frame_target_time);
           }
         }
       });
@@ -250,11 +313,53 @@ void Animator::AwaitVSync() {
   delegate_.OnAnimatorNotifyIdle(dart_frame_deadline_);
 }
 
+bool Animator::ShouldSkipVsync(fml::TimePoint frame_target_time) const {
+  if (!idle_frame_rate_tuner_ || dimension_change_pending_) {
+    return false;
+  }
+  const double max_frame_rate =
+      idle_frame_rate_tuner_->GetRecommendedMaxFrameRate();
+  if (max_frame_rate <= 0) {
+    return false;
+  }
+  const fml::TimeDelta min_frame_interval = fml::TimeDelta::FromSecondsF(
+      kIdleFrameIntervalTolerance / max_frame_rate);
+  return frame_target_time - last_frame_target_time_ < min_frame_interval;
+}
+
+void Animator::ScheduleBeginFrame(fml::TimePoint vsync_start_time,
+                                  fml::TimePoint frame_target_time) {
+  // A pending resize has to be shown as soon as possible.
+  if (!begin_frame_delay_tuner_ || dimension_change_pending_) {
+    BeginFrame(vsync_start_time, frame_target_time);
+    return;
+  }
+  const fml::TimePoint begin_time =
+      vsync_start_time + begin_frame_delay_tuner_->GetRecommendedDelay();
+  if (begin_time <= fml::TimePoint::Now()) {
+    BeginFrame(vsync_start_time, frame_target_time);
+    return;
+  }
+  TRACE_EVENT0("flutter", "Animator::DelayBeginFrame");
+  task_runners_.GetUITaskRunner()->PostTaskForTime(
+      [self = weak_factory_.GetWeakPtr(), vsync_start_time,
+       frame_target_time]() {
+        if (self) {
+          self->BeginFrame(vsync_start_time, frame_target_time);
+        }
+      },
+      begin_time);
+}
+
 void Animator::ScheduleSecondaryVsyncCallback(uintptr_t id,
                                               const fml::closure& callback) {
   waiter_->ScheduleSecondaryCallback(id, callback);
 }
 
+fml::TimePoint Animator::GetLastVsyncTargetTime() const {
+  return waiter_->GetLastFrameTargetTime();
+}
+
 void Animator::ScheduleMaybeClearTraceFlowIds() {
   waiter_->ScheduleSecondaryCallback(
       reinterpret_cast<uintptr_t>(this), [self = weak_factory_.GetWeakPtr()] {
@@ -12,7 +12,10 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/begin_frame_delay_tuner.h"
+#include "flutter/shell/common/idle_frame_rate_tuner.h"
 #include "flutter/shell/common/pipeline.h"
+#include "flutter/shell/common/pipeline_depth_tuner.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
 
@@ -34,21 +37,41 @@ class Animator final {
 
     virtual void OnAnimatorNotifyIdle(int64_t deadline) = 0;
 
-    virtual void OnAnimatorDraw(
-        fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
-        fml::TimePoint frame_target_time) = 0;
+    virtual void OnAnimatorDraw(fml::RefPtr<FramePipeline> pipeline,
+                                fml::TimePoint frame_target_time) = 0;
 
     virtual void OnAnimatorDrawLastLayerTree() = 0;
   };
 
-  Animator(Delegate& delegate,
-           TaskRunners task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+  // The depth of the layer tree pipeline unless the platform and raster task
+  // runners are the same.
+  static constexpr uint32_t kMaxLayerTreePipelineDepth = 2;
+
+  // If |pipeline_depth_tuner| is set, the effective depth of the layer tree
+  // pipeline follows its recommendation at the start of every frame. If
+  // |idle_frame_rate_tuner| is set, vsyncs are skipped to produce frames no
+  // faster than the frame rate it recommends. If |begin_frame_delay_tuner| is
+  // set, frames begin the delay it recommends after their vsync.
+  Animator(
+      Delegate& delegate,
+      TaskRunners task_runners,
+      std::unique_ptr<VsyncWaiter> waiter,
+      std::shared_ptr<PipelineDepthTuner> pipeline_depth_tuner = nullptr,
+      std::shared_ptr<IdleFrameRateTuner> idle_frame_rate_tuner = nullptr,
+      std::shared_ptr<BeginFrameDelayTuner> begin_frame_delay_tuner = nullptr);
 
   ~Animator();
 
   void RequestFrame(bool regenerate_layer_tree = true);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Commits the layer tree of a view to the pipeline.
+  ///
+  ///           The layer trees rendered while a frame is in progress are
+  ///           committed together at the end of that frame, so that the
+  ///           rasterizer draws every view of the frame at once. Layer trees
+  ///           rendered outside of a frame are committed right away.
+  ///
   void Render(std::unique_ptr<flutter::LayerTree> layer_tree);
 
   //--------------------------------------------------------------------------
@@ -69,6 +92,18 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    The target time of the frame of the last vsync, including the
+  ///           vsyncs that only ran secondary callbacks.
+  ///
+  fml::TimePoint GetLastVsyncTargetTime() const;
+
+  //--------------------------------------------------------------------------
+  /// @brief    Asks the vsync waiter to deliver vsync at a rate within
+  ///           `range`, see `VsyncWaiter::SetFrameRateRange`.
+  ///
+  void SetFrameRateRange(const FrameRateRange& range);
+
   void Start();
 
   void Stop();
@@ -81,16 +116,26 @@ class Animator final {
   void EnqueueTraceFlowId(uint64_t trace_flow_id);
 
  private:
-  using LayerTreePipeline = Pipeline<flutter::LayerTree>;
-
   void BeginFrame(fml::TimePoint frame_start_time,
                   fml::TimePoint frame_target_time);
 
+  // Commits the layer trees rendered since the last commit, if any.
+  void EndFrame();
+
   bool CanReuseLastLayerTree();
   void DrawLastLayerTree();
 
   void AwaitVSync();
 
+  // Whether the frame of the vsync with |frame_target_time| should be skipped
+  // to keep to the frame rate recommended by |idle_frame_rate_tuner_|.
+  bool ShouldSkipVsync(fml::TimePoint frame_target_time) const;
+
+  // Begins the frame of the vsync at |vsync_start_time| right away, or posts
+  // it for the delay recommended by |begin_frame_delay_tuner_|.
+  void ScheduleBeginFrame(fml::TimePoint vsync_start_time,
+                          fml::TimePoint frame_target_time);
+
   const char* FrameParity();
 
   // Clear |trace_flow_ids_| if |frame_scheduled_| is false.
@@ -104,9 +149,14 @@ class Animator final {
   fml::TimePoint last_vsync_start_time_;
   fml::TimePoint last_frame_target_time_;
   int64_t dart_frame_deadline_;
-  fml::RefPtr<LayerTreePipeline> layer_tree_pipeline_;
+  fml::RefPtr<FramePipeline> layer_tree_pipeline_;
+  std::shared_ptr<PipelineDepthTuner> pipeline_depth_tuner_;
+  std::shared_ptr<IdleFrameRateTuner> idle_frame_rate_tuner_;
+  std::shared_ptr<BeginFrameDelayTuner> begin_frame_delay_tuner_;
   fml::Semaphore pending_frame_semaphore_;
-  LayerTreePipeline::ProducerContinuation producer_continuation_;
+  FramePipeline::ProducerContinuation producer_continuation_;
+  std::vector<std::unique_ptr<flutter::LayerTree>> pending_layer_trees_;
+  bool frame_in_progress_ = false;
   int64_t frame_number_;
   bool paused_;
   bool regenerate_layer_tree_;
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/begin_frame_delay_tuner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace flutter {
+
+namespace {
+
+// The weight of the latest frame in the moving averages of the frame time and
+// its deviation.
+constexpr double kAverageWeight = 0.1;
+
+// The number of frames to observe before frames are delayed at all.
+constexpr size_t kWarmUpFrameCount = 30;
+
+// The number of average deviations added to the average frame time, so that
+// most frames finish within the predicted time.
+constexpr double kDeviationFactor = 3;
+
+// The fraction of the frame budget that is always left between the predicted
+// end of a frame and its target time.
+constexpr double kSafetyMarginFraction = 0.25;
+
+}  // namespace
+
+BeginFrameDelayTuner::BeginFrameDelayTuner() : recommended_delay_micros_(0) {}
+
+BeginFrameDelayTuner::~BeginFrameDelayTuner() = default;
+
+void BeginFrameDelayTuner::AddFrameTiming(const FrameTiming& timing,
+                                          fml::Milliseconds frame_budget) {
+  const fml::TimeDelta budget =
+      fml::TimeDelta::FromMillisecondsF(frame_budget.count());
+
+  // A frame that took longer than a frame budget since its vsync was late, so
+  // it is not delayed again until the frame times settled.
+  if (timing.Get(FrameTiming::kRasterFinish) -
+          timing.Get(FrameTiming::kVsyncStart) >
+      budget) {
+    frame_count_ = 0;
+    recommended_delay_micros_ = 0;
+    return;
+  }
+
+  // The time from the start of the build to the end of rasterization includes
+  // the time the frame waited for the raster thread.
+  const fml::TimeDelta frame_time = timing.Get(FrameTiming::kRasterFinish) -
+                                    timing.Get(FrameTiming::kBuildStart);
+  if (frame_count_ == 0) {
+    average_frame_time_ = frame_time;
+    average_deviation_ = fml::TimeDelta::Zero();
+  } else {
+    const double deviation =
+        std::abs((frame_time - average_frame_time_).ToNanosecondsF());
+    average_frame_time_ = fml::TimeDelta::FromNanoseconds(
+        average_frame_time_.ToNanosecondsF() * (1.0 - kAverageWeight) +
+        frame_time.ToNanosecondsF() * kAverageWeight);
+    average_deviation_ = fml::TimeDelta::FromNanoseconds(
+        average_deviation_.ToNanosecondsF() * (1.0 - kAverageWeight) +
+        deviation * kAverageWeight);
+  }
+  frame_count_++;
+
+  if (frame_count_ < kWarmUpFrameCount) {
+    return;
+  }
+
+  const fml::TimeDelta predicted_frame_time =
+      average_frame_time_ + fml::TimeDelta::FromNanoseconds(
+                                average_deviation_.ToNanosecondsF() *
+                                kDeviationFactor);
+  const fml::TimeDelta safety_margin = fml::TimeDelta::FromNanoseconds(
+      budget.ToNanosecondsF() * kSafetyMarginFraction);
+  const fml::TimeDelta delay = budget - predicted_frame_time - safety_margin;
+  recommended_delay_micros_ = std::max<int64_t>(delay.ToMicroseconds(), 0);
+}
+
+fml::TimeDelta BeginFrameDelayTuner::GetRecommendedDelay() const {
+  return fml::TimeDelta::FromMicroseconds(recommended_delay_micros_);
+}
+
+}  // namespace flutter
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_BEGIN_FRAME_DELAY_TUNER_H_
+#define FLUTTER_SHELL_COMMON_BEGIN_FRAME_DELAY_TUNER_H_
+
+#include <atomic>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Picks how long after a vsync the animator should begin the frame, based on
+/// the observed build and raster times of recent frames.
+///
+/// Beginning a frame right at vsync leaves the finished frame waiting for its
+/// target vsync when building and rasterizing are short. Delaying the start
+/// so that the frame is predicted to finish just before its target time, with
+/// a safety margin, lets the frame pick up later input and shortens the time
+/// from input to display.
+///
+/// The prediction is the moving average of the time from the start of the
+/// build to the end of rasterization, plus a multiple of its moving average
+/// deviation. A frame that misses its budget drops the delay right away.
+///
+/// Frame timings are reported on the raster thread, the recommended delay may
+/// be read from any thread.
+///
+class BeginFrameDelayTuner {
+ public:
+  BeginFrameDelayTuner();
+
+  ~BeginFrameDelayTuner();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timing of a rasterized frame and updates the
+  ///             recommended delay.
+  ///
+  /// @param[in]  timing        The timing of the frame.
+  /// @param[in]  frame_budget  The time available for a single frame at the
+  ///                           current refresh rate.
+  ///
+  void AddFrameTiming(const FrameTiming& timing, fml::Milliseconds frame_budget);
+
+  //----------------------------------------------------------------------------
+  /// @brief      How long after the vsync the next frame should begin. This is
+  ///             zero until enough frames have been observed.
+  ///
+  fml::TimeDelta GetRecommendedDelay() const;
+
+ private:
+  std::atomic<int64_t> recommended_delay_micros_;
+
+  // Only accessed on the raster thread.
+  fml::TimeDelta average_frame_time_;
+  fml::TimeDelta average_deviation_;
+  size_t frame_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BeginFrameDelayTuner);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_BEGIN_FRAME_DELAY_TUNER_H_
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/begin_frame_delay_tuner.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::Milliseconds kFrameBudget{16};
+
+FrameTiming CreateFrameTiming(int64_t build_ms, int64_t raster_ms) {
+  FrameTiming timing;
+  fml::TimePoint start = fml::TimePoint::Now();
+  timing.Set(FrameTiming::kVsyncStart, start);
+  timing.Set(FrameTiming::kBuildStart, start);
+  fml::TimePoint build_finish =
+      timing.Set(FrameTiming::kBuildFinish,
+                 start + fml::TimeDelta::FromMilliseconds(build_ms));
+  timing.Set(FrameTiming::kRasterStart, build_finish);
+  timing.Set(FrameTiming::kRasterFinish,
+             build_finish + fml::TimeDelta::FromMilliseconds(raster_ms));
+  return timing;
+}
+
+void AddFrames(BeginFrameDelayTuner& tuner,
+               size_t count,
+               int64_t build_ms,
+               int64_t raster_ms) {
+  for (size_t i = 0; i < count; i++) {
+    tuner.AddFrameTiming(CreateFrameTiming(build_ms, raster_ms), kFrameBudget);
+  }
+}
+
+}  // namespace
+
+TEST(BeginFrameDelayTunerTest, StartsWithoutDelay) {
+  BeginFrameDelayTuner tuner;
+  ASSERT_EQ(tuner.GetRecommendedDelay(), fml::TimeDelta::Zero());
+  AddFrames(tuner, 10, 2, 2);
+  ASSERT_EQ(tuner.GetRecommendedDelay(), fml::TimeDelta::Zero());
+}
+
+TEST(BeginFrameDelayTunerTest, DelaysShortFramesToFinishBeforeTheMargin) {
+  BeginFrameDelayTuner tuner;
+  AddFrames(tuner, 100, 2, 2);
+  // 16ms budget, 4ms frames and a 4ms safety margin.
+  ASSERT_EQ(tuner.GetRecommendedDelay(), fml::TimeDelta::FromMilliseconds(8));
+}
+
+TEST(BeginFrameDelayTunerTest, DoesNotDelayFramesThatFillTheBudget) {
+  BeginFrameDelayTuner tuner;
+  AddFrames(tuner, 100, 7, 7);
+  ASSERT_EQ(tuner.GetRecommendedDelay(), fml::TimeDelta::Zero());
+}
+
+TEST(BeginFrameDelayTunerTest, DropsDelayOnLateFrame) {
+  BeginFrameDelayTuner tuner;
+  AddFrames(tuner, 100, 2, 2);
+  ASSERT_GT(tuner.GetRecommendedDelay(), fml::TimeDelta::Zero());
+  AddFrames(tuner, 1, 10, 10);
+  ASSERT_EQ(tuner.GetRecommendedDelay(), fml::TimeDelta::Zero());
+  AddFrames(tuner, 10, 2, 2);
+  ASSERT_EQ(tuner.GetRecommendedDelay(), fml::TimeDelta::Zero());
+}
+
+}  // namespace testing
+}  // namespace flutter
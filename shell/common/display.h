@@ -29,6 +29,21 @@ class Display {
   Display(DisplayId display_id, double refresh_rate)
       : display_id_(display_id), refresh_rate_(refresh_rate) {}
 
+  //------------------------------------------------------------------------------
+  /// @brief Construct a new Display object for a display that can run at any
+  /// refresh rate between |min_refresh_rate| and |max_refresh_rate|, such as
+  /// an adaptive sync monitor. |refresh_rate| is the rate the display runs at
+  /// when the content has no preference.
+  ///
+  Display(std::optional<DisplayId> display_id,
+          double refresh_rate,
+          double min_refresh_rate,
+          double max_refresh_rate)
+      : display_id_(display_id),
+        refresh_rate_(refresh_rate),
+        min_refresh_rate_(min_refresh_rate),
+        max_refresh_rate_(max_refresh_rate) {}
+
   //------------------------------------------------------------------------------
   /// @brief Construct a new Display object when there is only a single display.
   /// When there are multiple displays, every display must have a display id.
@@ -42,12 +57,27 @@ class Display {
   // Return `kUnknownDisplayRefreshRate` if the refresh rate is unknown.
   double GetRefreshRate() const { return refresh_rate_; }
 
+  /// The range of refresh rates the display can switch between from one frame
+  /// to the next. Both are the refresh rate for fixed rate displays.
+  double GetMinRefreshRate() const {
+    return SupportsVariableRefreshRate() ? min_refresh_rate_ : refresh_rate_;
+  }
+  double GetMaxRefreshRate() const {
+    return SupportsVariableRefreshRate() ? max_refresh_rate_ : refresh_rate_;
+  }
+
+  bool SupportsVariableRefreshRate() const {
+    return min_refresh_rate_ > 0 && min_refresh_rate_ < max_refresh_rate_;
+  }
+
   /// Returns the `DisplayId` of the display.
   std::optional<DisplayId> GetDisplayId() const { return display_id_; }
 
  private:
   std::optional<DisplayId> display_id_;
   double refresh_rate_;
+  double min_refresh_rate_ = 0;
+  double max_refresh_rate_ = 0;
 };
 
 }  // namespace flutter
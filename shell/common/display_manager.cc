@@ -22,6 +22,44 @@ double DisplayManager::GetMainDisplayRefreshRate() const {
   }
 }
 
+std::optional<Display> DisplayManager::GetDisplay(DisplayId display_id) const {
+  std::scoped_lock lock(displays_mutex_);
+  if (const Display* display = FindDisplayLocked(display_id)) {
+    return *display;
+  }
+  return std::nullopt;
+}
+
+std::optional<Display> DisplayManager::GetViewDisplay(int64_t view_id) const {
+  std::scoped_lock lock(displays_mutex_);
+  if (displays_.empty()) {
+    return std::nullopt;
+  }
+  auto found = view_displays_.find(view_id);
+  if (found != view_displays_.end()) {
+    if (const Display* display = FindDisplayLocked(found->second)) {
+      return *display;
+    }
+  }
+  return displays_[0];
+}
+
+void DisplayManager::SetViewDisplay(int64_t view_id, DisplayId display_id) {
+  std::scoped_lock lock(displays_mutex_);
+  view_displays_[view_id] = display_id;
+}
+
+const Display* DisplayManager::FindDisplayLocked(DisplayId display_id) const {
+  for (const auto& display : displays_) {
+    // A single display without an id is the display of every view.
+    if (!display.GetDisplayId().has_value() ||
+        display.GetDisplayId().value() == display_id) {
+      return &display;
+    }
+  }
+  return nullptr;
+}
+
 void DisplayManager::HandleDisplayUpdates(DisplayUpdateType update_type,
                                           std::vector<Display> displays) {
   std::scoped_lock lock(displays_mutex_);
@@ -31,6 +69,9 @@ void DisplayManager::HandleDisplayUpdates(DisplayUpdateType update_type,
       FML_CHECK(displays_.empty());
       displays_ = displays;
       return;
+    case DisplayUpdateType::kConfigurationChanged:
+      displays_ = displays;
+      return;
     default:
       FML_CHECK(false) << "Unknown DisplayUpdateType.";
   }
@@ -6,6 +6,8 @@
 #define FLUTTER_SHELL_COMMON_DISPLAY_MANAGER_H_
 
 #include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/shell/common/display.h"
@@ -20,7 +22,11 @@ enum class DisplayUpdateType {
   ///    1. The frame buffer hardware is connected.
   ///    2. The display is drawable, e.g. it isn't being mirrored from another
   ///       connected display or sleeping.
-  kStartup
+  kStartup,
+  /// The active `flutter::Display`s after the configuration of one of them
+  /// changed, such as when the display switched to another refresh rate.
+  /// Replaces the displays that were reported before.
+  kConfigurationChanged,
 };
 
 /// Manages lifecycle of the connected displays. This class is thread-safe.
@@ -30,22 +36,37 @@ class DisplayManager {
 
   ~DisplayManager();
 
-  /// Returns the display refresh rate of the main display. In cases where there
-  /// is only one display connected, it will return that. We do not yet support
-  /// cases where there are multiple displays.
+  /// Returns the display refresh rate of the main display, which is the first
+  /// display that was reported. In cases where there is only one display
+  /// connected, it will return that.
   ///
   /// When there are no registered displays, it returns
   /// `kUnknownDisplayRefreshRate`.
   double GetMainDisplayRefreshRate() const;
 
+  /// Returns the display with the given id, or nullopt if there is none.
+  std::optional<Display> GetDisplay(DisplayId display_id) const;
+
+  /// Returns the display that the view is on, which is the main display for
+  /// views that were not placed on a display with `SetViewDisplay` or whose
+  /// display was disconnected. Returns nullopt if there are no displays.
+  std::optional<Display> GetViewDisplay(int64_t view_id) const;
+
+  /// Records that the view moved to the display with the given id, e.g.
+  /// because its window was dragged onto another monitor.
+  void SetViewDisplay(int64_t view_id, DisplayId display_id);
+
   /// Handles the display updates.
   void HandleDisplayUpdates(DisplayUpdateType update_type,
                             std::vector<Display> displays);
 
  private:
-  /// Guards `displays_` vector.
+  /// Guards `displays_` vector and `view_displays_`.
   mutable std::mutex displays_mutex_;
   std::vector<Display> displays_;
+  std::unordered_map<int64_t, DisplayId> view_displays_;
+
+  const Display* FindDisplayLocked(DisplayId display_id) const;
 
   /// Checks that the provided display configuration is valid. Currently this
   /// ensures that all the displays have an id in the case there are multiple
@@ -4,11 +4,15 @@
 
 #include "flutter/shell/common/engine.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "flutter/common/constants.h"
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/common/settings.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/file.h"
@@ -17,6 +21,7 @@
 #include "flutter/fml/trace_event.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/lib/snapshot/snapshot.h"
+#include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/platform_view.h"
@@ -34,6 +39,7 @@ static constexpr char kNavigationChannel[] = "flutter/navigation";
 static constexpr char kLocalizationChannel[] = "flutter/localization";
 static constexpr char kSettingsChannel[] = "flutter/settings";
 static constexpr char kIsolateChannel[] = "flutter/isolate";
+static constexpr int32_t kRootSemanticsNodeId = 0;
 
 Engine::Engine(
     Delegate& delegate,
@@ -54,8 +60,19 @@ Engine::Engine(
       font_collection_(font_collection),
       image_decoder_(task_runners, image_decoder_task_runner, io_manager),
       task_runners_(std::move(task_runners)),
+      image_gc_threshold_bytes_(settings_.image_gc_threshold_bytes),
+      idle_task_queue_(fml::MakeRefCounted<IdleTaskQueue>()),
+      glyph_prewarmer_(idle_task_queue_,
+                       image_decoder_task_runner,
+                       font_collection_->GetFontCollection()),
       weak_factory_(this) {
-  pointer_data_dispatcher_ = dispatcher_maker(*this);
+  if (settings_.resample_pointer_events) {
+    pointer_data_dispatcher_ =
+        std::make_unique<ResamplingPointerDataDispatcher>(*this);
+  } else {
+    pointer_data_dispatcher_ = dispatcher_maker(*this);
+  }
+  image_decoder_.SetDecodesToYUVPlanes(settings_.enable_yuv_image_decoding);
 }
 
 Engine::Engine(Delegate& delegate,
@@ -139,6 +156,20 @@ void Engine::SetupDefaultFontManager() {
   font_collection_->SetupDefaultFontManager();
 }
 
+void Engine::SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache) {
+  image_decoder_.SetDecodedImageCache(std::move(cache));
+}
+
+void Engine::SetImageDecoderBackend(
+    std::shared_ptr<ImageDecoderBackend> backend) {
+  image_decoder_.SetBackend(std::move(backend));
+}
+
+void Engine::SetImageEncoderBackend(
+    std::shared_ptr<ImageEncoderBackend> backend) {
+  image_decoder_.SetEncoderBackend(std::move(backend));
+}
+
 std::shared_ptr<AssetManager> Engine::GetAssetManager() {
   return asset_manager_;
 }
@@ -187,6 +218,9 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
   last_entry_point_library_ = configuration.GetEntrypointLibrary();
 
   UpdateAssetManager(configuration.GetAssetManager());
+  if (asset_manager_) {
+    glyph_prewarmer_.PrewarmFromAssets(*asset_manager_);
+  }
 
   if (runtime_controller_->IsRootIsolateRunning()) {
     return RunStatus::FailureAlreadyRunning;
@@ -206,8 +240,8 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
     fml::RefPtr<PlatformMessage> service_id_message =
         fml::MakeRefCounted<flutter::PlatformMessage>(
             kIsolateChannel,
-            std::vector<uint8_t>(service_id.value().begin(),
-                                 service_id.value().end()),
+            fml::MallocMapping::Copy(service_id.value().c_str(),
+                                     service_id.value().length()),
             nullptr);
     HandlePlatformMessage(service_id_message);
   }
@@ -233,8 +267,36 @@ void Engine::NotifyIdle(int64_t deadline) {
   auto trace_event = std::to_string(deadline - Dart_TimelineGetMicros());
   TRACE_EVENT1("flutter", "Engine::NotifyIdle", "deadline_now_delta",
                trace_event.c_str());
-  runtime_controller_->NotifyIdle(deadline, hint_freed_bytes_since_last_idle_);
+  size_t freed_hint = hint_freed_bytes_since_last_idle_;
+  if (const size_t budget = settings_.image_gc_threshold_bytes) {
+    const size_t image_bytes = CanvasImage::GetLiveBytes();
+    if (image_bytes > image_gc_threshold_bytes_) {
+      TRACE_EVENT1("flutter", "ImageGCThresholdExceeded", "image_bytes",
+                   std::to_string(image_bytes).c_str());
+      freed_hint += image_bytes;
+      image_gc_threshold_bytes_ = image_bytes + budget;
+    } else {
+      // Follow the images that were collected since.
+      image_gc_threshold_bytes_ =
+          std::max(budget, std::min(image_gc_threshold_bytes_,
+                                    image_bytes + budget));
+    }
+  }
+  runtime_controller_->NotifyIdle(deadline, freed_hint);
   hint_freed_bytes_since_last_idle_ = 0;
+
+  // The deadline is measured against the Dart timeline clock.
+  idle_task_queue_->RunUntil(
+      fml::TimePoint::Now() +
+      fml::TimeDelta::FromMicroseconds(deadline - Dart_TimelineGetMicros()));
+}
+
+fml::RefPtr<IdleTaskQueue> Engine::GetIdleTaskQueue() const {
+  return idle_task_queue_;
+}
+
+void Engine::PrewarmGlyphs(std::vector<GlyphPrewarmer::Run> runs) {
+  glyph_prewarmer_.Prewarm(std::move(runs));
 }
 
 std::optional<uint32_t> Engine::GetUIIsolateReturnCode() {
@@ -269,11 +331,20 @@ void Engine::OnOutputSurfaceDestroyed() {
 }
 
 void Engine::SetViewportMetrics(const ViewportMetrics& metrics) {
+  if (metrics.view_id != kFlutterImplicitViewId) {
+    runtime_controller_->SetViewportMetrics(metrics);
+    if (animator_ && have_surface_) {
+      ScheduleFrame();
+    }
+    return;
+  }
+
   bool dimensions_changed =
       viewport_metrics_.physical_height != metrics.physical_height ||
       viewport_metrics_.physical_width != metrics.physical_width ||
       viewport_metrics_.device_pixel_ratio != metrics.device_pixel_ratio;
   viewport_metrics_ = metrics;
+  glyph_prewarmer_.SetDevicePixelRatio(metrics.device_pixel_ratio);
   runtime_controller_->SetViewportMetrics(viewport_metrics_);
   if (animator_) {
     if (dimensions_changed) {
@@ -286,25 +357,11 @@ void Engine::SetViewportMetrics(const ViewportMetrics& metrics) {
 }
 
 void Engine::DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message) {
-  std::string channel = message->channel();
-  if (channel == kLifecycleChannel) {
-    if (HandleLifecyclePlatformMessage(message.get())) {
-      return;
-    }
-  } else if (channel == kLocalizationChannel) {
-    if (HandleLocalizationPlatformMessage(message.get())) {
-      return;
-    }
-  } else if (channel == kSettingsChannel) {
-    HandleSettingsPlatformMessage(message.get());
-    return;
-  } else if (!runtime_controller_->IsRootIsolateRunning() &&
-             channel == kNavigationChannel) {
-    // If there's no runtime_, we may still need to set the initial route.
-    HandleNavigationPlatformMessage(std::move(message));
+  if (HandleEngineChannelMessage(message)) {
     return;
   }
 
+  std::string channel = message->channel();
   if (runtime_controller_->IsRootIsolateRunning() &&
       runtime_controller_->DispatchPlatformMessage(std::move(message))) {
     return;
@@ -313,13 +370,59 @@ void Engine::DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message) {
   FML_DLOG(WARNING) << "Dropping platform message on channel: " << channel;
 }
 
+void Engine::DispatchPlatformMessages(
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  TRACE_EVENT0("flutter", "Engine::DispatchPlatformMessages");
+  std::vector<fml::RefPtr<PlatformMessage>> isolate_messages;
+  isolate_messages.reserve(messages.size());
+  for (auto& message : messages) {
+    if (!HandleEngineChannelMessage(message)) {
+      isolate_messages.push_back(std::move(message));
+    }
+  }
+  if (isolate_messages.empty()) {
+    return;
+  }
+
+  const size_t count = isolate_messages.size();
+  if (runtime_controller_->IsRootIsolateRunning() &&
+      runtime_controller_->DispatchPlatformMessages(
+          std::move(isolate_messages))) {
+    return;
+  }
+
+  FML_DLOG(WARNING) << "Dropping " << count << " platform messages.";
+}
+
+bool Engine::HandleEngineChannelMessage(
+    const fml::RefPtr<PlatformMessage>& message) {
+  const std::string& channel = message->channel();
+  if (channel == kLifecycleChannel) {
+    return HandleLifecyclePlatformMessage(message.get());
+  } else if (channel == kLocalizationChannel) {
+    return HandleLocalizationPlatformMessage(message.get());
+  } else if (channel == kSettingsChannel) {
+    HandleSettingsPlatformMessage(message.get());
+    return true;
+  } else if (!runtime_controller_->IsRootIsolateRunning() &&
+             channel == kNavigationChannel) {
+    // If there's no runtime_, we may still need to set the initial route.
+    HandleNavigationPlatformMessage(message);
+    return true;
+  }
+  return false;
+}
+
 bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
-  std::string state(reinterpret_cast<const char*>(data.data()), data.size());
+  std::string state(reinterpret_cast<const char*>(data.GetMapping()),
+                    data.GetSize());
   if (state == "AppLifecycleState.paused" ||
       state == "AppLifecycleState.detached") {
     activity_running_ = false;
     StopAnimator();
+    // The app may be killed without further notice from here on.
+    SaveFallbackFontCache();
   } else if (state == "AppLifecycleState.resumed" ||
              state == "AppLifecycleState.inactive") {
     activity_running_ = true;
@@ -337,12 +440,25 @@ bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
   return false;
 }
 
+void Engine::SaveFallbackFontCache() {
+  if (!settings_.persist_fallback_font_cache || PersistentCache::gIsReadOnly) {
+    return;
+  }
+  task_runners_.GetIOTaskRunner()->PostTask([] {
+    auto directory = PersistentCache::GetCacheForProcess()->GetCacheDirectory();
+    if (directory) {
+      FontCollection::GetFallbackFontCache()->Save(*directory);
+    }
+  });
+}
+
 bool Engine::HandleNavigationPlatformMessage(
     fml::RefPtr<PlatformMessage> message) {
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject()) {
     return false;
   }
@@ -360,7 +476,8 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject()) {
     return false;
   }
@@ -400,7 +517,8 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
 
 void Engine::HandleSettingsPlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
-  std::string jsonData(reinterpret_cast<const char*>(data.data()), data.size());
+  std::string jsonData(reinterpret_cast<const char*>(data.GetMapping()),
+                       data.GetSize());
   if (runtime_controller_->SetUserSettingsData(std::move(jsonData)) &&
       have_surface_) {
     ScheduleFrame();
@@ -430,6 +548,8 @@ void Engine::DispatchSemanticsAction(int id,
 }
 
 void Engine::SetSemanticsEnabled(bool enabled) {
+  // The framework sends the whole tree again once semantics are enabled.
+  semantics_nodes_.clear();
   runtime_controller_->SetSemanticsEnabled(enabled);
 }
 
@@ -474,9 +594,60 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
 
 void Engine::UpdateSemantics(SemanticsNodeUpdates update,
                              CustomAccessibilityActionUpdates actions) {
+  TRACE_EVENT0("flutter", "Engine::UpdateSemantics");
+  // The framework sends every node it marked dirty, many of which end up the
+  // same as before. The platform views only need the nodes that changed.
+  bool children_changed = false;
+  for (auto it = update.begin(); it != update.end();) {
+    auto last = semantics_nodes_.find(it->first);
+    if (last != semantics_nodes_.end() && last->second == it->second) {
+      it = update.erase(it);
+      continue;
+    }
+    if (last == semantics_nodes_.end() ||
+        last->second.childrenInTraversalOrder !=
+            it->second.childrenInTraversalOrder ||
+        last->second.childrenInHitTestOrder !=
+            it->second.childrenInHitTestOrder) {
+      children_changed = true;
+    }
+    semantics_nodes_[it->first] = it->second;
+    ++it;
+  }
+  if (children_changed) {
+    RemoveDetachedSemanticsNodes();
+  }
+  if (update.empty() && actions.empty()) {
+    return;
+  }
   delegate_.OnEngineUpdateSemantics(std::move(update), std::move(actions));
 }
 
+void Engine::RemoveDetachedSemanticsNodes() {
+  std::unordered_set<int32_t> reachable;
+  std::vector<int32_t> pending = {kRootSemanticsNodeId};
+  while (!pending.empty()) {
+    const int32_t id = pending.back();
+    pending.pop_back();
+    auto node = semantics_nodes_.find(id);
+    if (node == semantics_nodes_.end() || !reachable.insert(id).second) {
+      continue;
+    }
+    const std::vector<int32_t>& traversal =
+        node->second.childrenInTraversalOrder;
+    const std::vector<int32_t>& hit_test = node->second.childrenInHitTestOrder;
+    pending.insert(pending.end(), traversal.begin(), traversal.end());
+    pending.insert(pending.end(), hit_test.begin(), hit_test.end());
+  }
+  for (auto it = semantics_nodes_.begin(); it != semantics_nodes_.end();) {
+    if (reachable.count(it->first) == 0) {
+      it = semantics_nodes_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void Engine::HandlePlatformMessage(fml::RefPtr<PlatformMessage> message) {
   if (message->channel() == kAssetChannel) {
     HandleAssetPlatformMessage(std::move(message));
@@ -503,6 +674,15 @@ void Engine::SetNeedsReportTimings(bool needs_reporting) {
   delegate_.SetNeedsReportTimings(needs_reporting);
 }
 
+void Engine::SetFrameRateRange(double minimum,
+                               double maximum,
+                               double preferred) {
+  const FrameRateRange range = {
+      .minimum = minimum, .maximum = maximum, .preferred = preferred};
+  animator_->SetFrameRateRange(range);
+  delegate_.OnEngineSetFrameRateRange(range);
+}
+
 FontCollection& Engine::GetFontCollection() {
   return *font_collection_;
 }
@@ -520,14 +700,37 @@ void Engine::ScheduleSecondaryVsyncCallback(uintptr_t id,
   animator_->ScheduleSecondaryVsyncCallback(id, callback);
 }
 
+fml::TimePoint Engine::GetLastVsyncTargetTime() {
+  return animator_->GetLastVsyncTargetTime();
+}
+
 void Engine::HandleAssetPlatformMessage(fml::RefPtr<PlatformMessage> message) {
   fml::RefPtr<PlatformMessageResponse> response = message->response();
   if (!response) {
     return;
   }
   const auto& data = message->data();
-  std::string asset_name(reinterpret_cast<const char*>(data.data()),
-                         data.size());
+  std::string asset_name(reinterpret_cast<const char*>(data.GetMapping()),
+                         data.GetSize());
+
+  if (asset_manager_ && settings_.load_assets_asynchronously) {
+    asset_manager_->GetAsMappingsAsync(
+        {std::move(asset_name)},
+        runtime_controller_->GetDartVM()->GetConcurrentWorkerTaskRunner(),
+        task_runners_.GetUITaskRunner(),
+        [response](std::vector<std::shared_ptr<fml::Mapping>> mappings) {
+          std::shared_ptr<fml::Mapping> mapping = std::move(mappings[0]);
+          if (!mapping) {
+            response->CompleteEmpty();
+            return;
+          }
+          // The mapping may be shared with other requests for the asset.
+          response->Complete(std::make_unique<fml::NonOwnedMapping>(
+              mapping->GetMapping(), mapping->GetSize(),
+              [mapping](const uint8_t* data, size_t size) {}));
+        });
+    return;
+  }
 
   if (asset_manager_) {
     std::unique_ptr<fml::Mapping> asset_mapping =
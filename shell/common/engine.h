@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/common/task_runners.h"
@@ -27,6 +28,8 @@
 #include "flutter/runtime/runtime_delegate.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
+#include "flutter/shell/common/glyph_prewarmer.h"
+#include "flutter/shell/common/idle_task_queue.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -245,6 +248,16 @@ class Engine final : public RuntimeDelegate,
     ///
     virtual void SetNeedsReportTimings(bool needs_reporting) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the shell of the range of frame rates that the
+    ///             animations of the application ask to be shown at, so that
+    ///             frame budgets match the rate that frames are shown at.
+    ///             The animator is notified by the engine.
+    ///
+    /// @param[in]  range  The range of frame rates.
+    ///
+    virtual void OnEngineSetFrameRateRange(const FrameRateRange& range) = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Directly invokes platform-specific APIs to compute the
     ///             locale the platform would have natively resolved to.
@@ -434,6 +447,36 @@ class Engine final : public RuntimeDelegate,
   ///
   void SetupDefaultFontManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Shares the images decoded by the image decoder of this engine
+  ///             through the given cache, typically the one owned by the IO
+  ///             manager of the shell.
+  ///
+  /// @param[in]  cache  The cache of decoded images, or nullptr to not cache
+  ///                    decoded images.
+  ///
+  void SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the image decoder of this engine try the given backend
+  ///             before the Skia codecs, typically the one created by the
+  ///             platform view of the shell.
+  ///
+  /// @param[in]  backend  The image decoder backend, or nullptr to only use
+  ///                      the Skia codecs.
+  ///
+  void SetImageDecoderBackend(std::shared_ptr<ImageDecoderBackend> backend);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes `Image.toByteData` try the given backend before the
+  ///             Skia encoders, typically the one created by the platform view
+  ///             of the shell.
+  ///
+  /// @param[in]  backend  The image encoder backend, or nullptr to only use
+  ///                      the Skia encoders.
+  ///
+  void SetImageEncoderBackend(std::shared_ptr<ImageEncoderBackend> backend);
+
   //----------------------------------------------------------------------------
   /// @brief      Updates the asset manager referenced by the root isolate of a
   ///             Flutter application. This happens implicitly in the call to
@@ -534,6 +577,9 @@ class Engine final : public RuntimeDelegate,
   ///             collection, just gives the Dart VM more hints about opportune
   ///             moments to perform collections.
   ///
+  ///             After the Dart VM, the tasks posted to the idle task queue
+  ///             run in what is left of the idle period.
+  ///
   //  TODO(chinmaygarde): This should just use fml::TimePoint instead of having
   //  to remember that the unit is microseconds (which is no used anywhere else
   //  in the engine).
@@ -708,6 +754,20 @@ class Engine final : public RuntimeDelegate,
   ///
   void DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the embedder has sent it a batch of
+  ///             messages. Messages on channels handled by the engine itself
+  ///             are processed as they would be by `DispatchPlatformMessage`.
+  ///             All other messages are delivered to the root isolate in order
+  ///             and in a single scope, which amortizes the cost of entering
+  ///             the isolate for each message.
+  ///
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application.
+  ///
+  void DispatchPlatformMessages(
+      std::vector<fml::RefPtr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder has sent it a pointer
   ///             data packet. A pointer data packet may contain multiple
@@ -797,8 +857,10 @@ class Engine final : public RuntimeDelegate,
   // |RuntimeDelegate|
   FontCollection& GetFontCollection() override;
 
+  // |RuntimeDelegate|
+  //
   // Return the asset manager associated with the current engine, or nullptr.
-  std::shared_ptr<AssetManager> GetAssetManager();
+  std::shared_ptr<AssetManager> GetAssetManager() override;
 
   // |PointerDataDispatcher::Delegate|
   void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
@@ -808,12 +870,35 @@ class Engine final : public RuntimeDelegate,
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback) override;
 
+  // |PointerDataDispatcher::Delegate|
+  fml::TimePoint GetLastVsyncTargetTime() override;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the last Entrypoint that was used in the RunConfiguration
   ///             when |Engine::Run| was called.
   ///
   const std::string& GetLastEntrypoint() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The queue of maintenance work that runs when the engine is
+  ///             notified that it is idle. See |Engine::NotifyIdle|.
+  ///
+  /// @return     The idle task queue, which tasks may be posted to from any
+  ///             thread.
+  ///
+  fml::RefPtr<IdleTaskQueue> GetIdleTaskQueue() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Rasterizes the glyphs of runs of text into Skia's glyph cache
+  ///             in the idle time of the UI thread, so that frames first
+  ///             showing that text do not rasterize them on the raster
+  ///             thread. This adds to the runs read from the
+  ///             |GlyphPrewarmer::kAssetName| asset when the engine runs.
+  ///
+  /// @param[in]  runs  The fonts, sizes and characters to prewarm.
+  ///
+  void PrewarmGlyphs(std::vector<GlyphPrewarmer::Run> runs);
+
   //----------------------------------------------------------------------------
   /// @brief      Get the last Entrypoint Library that was used in the
   ///             RunConfiguration when |Engine::Run| was called.
@@ -917,6 +1002,14 @@ class Engine final : public RuntimeDelegate,
   ImageDecoder image_decoder_;
   TaskRunners task_runners_;
   size_t hint_freed_bytes_since_last_idle_ = 0;
+  // The bytes of live images above which the next idle notification hints the
+  // VM to collect garbage. See |Settings::image_gc_threshold_bytes|.
+  size_t image_gc_threshold_bytes_ = 0;
+  fml::RefPtr<IdleTaskQueue> idle_task_queue_;
+  GlyphPrewarmer glyph_prewarmer_;
+  // The semantics nodes that were last sent to the platform view, which are
+  // left out of the updates that do not change them.
+  SemanticsNodeUpdates semantics_nodes_;
   fml::WeakPtrFactory<Engine> weak_factory_;
 
   // |RuntimeDelegate|
@@ -948,12 +1041,27 @@ class Engine final : public RuntimeDelegate,
 
   void SetNeedsReportTimings(bool value) override;
 
+  // |RuntimeDelegate|
+  void SetFrameRateRange(double minimum,
+                         double maximum,
+                         double preferred) override;
+
+  // Removes the nodes that are no longer reachable from the root node from
+  // |semantics_nodes_|.
+  void RemoveDetachedSemanticsNodes();
+
   void StopAnimator();
 
   void StartAnimatorIfPossible();
 
+  // Handles messages on the channels the engine listens to. Returns true if
+  // the message must not be forwarded to the root isolate.
+  bool HandleEngineChannelMessage(const fml::RefPtr<PlatformMessage>& message);
+
   bool HandleLifecyclePlatformMessage(PlatformMessage* message);
 
+  void SaveFallbackFontCache();
+
   bool HandleNavigationPlatformMessage(fml::RefPtr<PlatformMessage> message);
 
   bool HandleLocalizationPlatformMessage(PlatformMessage* message);
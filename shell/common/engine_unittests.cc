@@ -6,6 +6,7 @@
 
 #include <cstring>
 
+#include "flutter/lib/ui/painting/image.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/fixture_test.h"
@@ -14,6 +15,8 @@
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 ///\note Deprecated MOCK_METHOD macros used until this issue is resolved:
 // https://github.com/google/googletest/issues/2490
@@ -30,6 +33,7 @@ class MockDelegate : public Engine::Delegate {
   MOCK_METHOD0(OnRootIsolateCreated, void());
   MOCK_METHOD2(UpdateIsolateDescription, void(const std::string, int64_t));
   MOCK_METHOD1(SetNeedsReportTimings, void(bool));
+  MOCK_METHOD1(OnEngineSetFrameRateRange, void(const FrameRateRange&));
   MOCK_METHOD1(ComputePlatformResolvedLocale,
                std::unique_ptr<std::vector<std::string>>(
                    const std::vector<std::string>&));
@@ -51,9 +55,11 @@ class MockRuntimeDelegate : public RuntimeDelegate {
                void(SemanticsNodeUpdates, CustomAccessibilityActionUpdates));
   MOCK_METHOD1(HandlePlatformMessage, void(fml::RefPtr<PlatformMessage>));
   MOCK_METHOD0(GetFontCollection, FontCollection&());
+  MOCK_METHOD0(GetAssetManager, std::shared_ptr<AssetManager>());
   MOCK_METHOD0(OnRootIsolateCreated, void());
   MOCK_METHOD2(UpdateIsolateDescription, void(const std::string, int64_t));
   MOCK_METHOD1(SetNeedsReportTimings, void(bool));
+  MOCK_METHOD3(SetFrameRateRange, void(double, double, double));
   MOCK_METHOD1(ComputePlatformResolvedLocale,
                std::unique_ptr<std::vector<std::string>>(
                    const std::vector<std::string>&));
@@ -66,9 +72,12 @@ class MockRuntimeController : public RuntimeController {
       : RuntimeController(client, p_task_runners) {}
   MOCK_METHOD0(IsRootIsolateRunning, bool());
   MOCK_METHOD1(DispatchPlatformMessage, bool(fml::RefPtr<PlatformMessage>));
+  MOCK_METHOD1(DispatchPlatformMessages,
+               bool(std::vector<fml::RefPtr<PlatformMessage>>));
   MOCK_METHOD3(LoadDartDeferredLibraryError,
                void(intptr_t, const std::string, bool));
   MOCK_CONST_METHOD0(GetDartVM, DartVM*());
+  MOCK_METHOD2(NotifyIdle, bool(int64_t, size_t));
 };
 
 fml::RefPtr<PlatformMessage> MakePlatformMessage(
@@ -93,7 +102,8 @@ fml::RefPtr<PlatformMessage> MakePlatformMessage(
   const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer.GetString());
 
   fml::RefPtr<PlatformMessage> message = fml::MakeRefCounted<PlatformMessage>(
-      channel, std::vector<uint8_t>(data, data + buffer.GetSize()), response);
+      channel, fml::MallocMapping::Copy(data, data + buffer.GetSize()),
+      response);
   return message;
 }
 
@@ -246,6 +256,79 @@ TEST_F(EngineTest, DispatchPlatformMessageInitialRouteIgnored) {
   });
 }
 
+TEST_F(EngineTest, DispatchPlatformMessagesHandlesInitialRoute) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(false));
+    EXPECT_CALL(*mock_runtime_controller,
+                DispatchPlatformMessages(::testing::_))
+        .Times(0);
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+
+    std::map<std::string, std::string> values{
+        {"method", "setInitialRoute"},
+        {"args", "test_initial_route"},
+    };
+    std::vector<fml::RefPtr<PlatformMessage>> messages;
+    messages.push_back(MakePlatformMessage(
+        "flutter/navigation", values, fml::MakeRefCounted<MockResponse>()));
+    engine->DispatchPlatformMessages(std::move(messages));
+    EXPECT_EQ(engine->InitialRoute(), "test_initial_route");
+  });
+}
+
+TEST_F(EngineTest, DispatchPlatformMessagesForwardsBatchInOneCall) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(true));
+    EXPECT_CALL(*mock_runtime_controller, DispatchPlatformMessage(::testing::_))
+        .Times(0);
+    EXPECT_CALL(*mock_runtime_controller,
+                DispatchPlatformMessages(::testing::SizeIs(3)))
+        .WillOnce(::testing::Return(true));
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+
+    std::map<std::string, std::string> values{
+        {"method", "setInitialRoute"},
+        {"args", "test_initial_route"},
+    };
+    fml::RefPtr<PlatformMessageResponse> response =
+        fml::MakeRefCounted<MockResponse>();
+    std::vector<fml::RefPtr<PlatformMessage>> messages;
+    messages.push_back(fml::MakeRefCounted<PlatformMessage>("foo", response));
+    messages.push_back(
+        MakePlatformMessage("flutter/navigation", values, response));
+    messages.push_back(fml::MakeRefCounted<PlatformMessage>("bar", response));
+    engine->DispatchPlatformMessages(std::move(messages));
+    // The initial route is only handled by the engine before the isolate runs.
+    EXPECT_EQ(engine->InitialRoute(), "");
+  });
+}
+
 TEST_F(EngineTest, SpawnSharesFontLibrary) {
   PostUITaskSync([this] {
     MockRuntimeDelegate client;
@@ -299,4 +382,106 @@ TEST_F(EngineTest, PassesLoadDartDeferredLibraryErrorToRuntime) {
   });
 }
 
+TEST_F(EngineTest, UpdateSemanticsLeavesOutUnchangedNodes) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+    RuntimeDelegate& runtime_delegate = *engine;
+
+    SemanticsNodeUpdates tree;
+    tree[0].id = 0;
+    tree[0].childrenInTraversalOrder = {1, 2};
+    tree[1].id = 1;
+    tree[1].label = "one";
+    tree[2].id = 2;
+    tree[2].label = "two";
+
+    SemanticsNodeUpdates received;
+    EXPECT_CALL(delegate_, OnEngineUpdateSemantics(::testing::_, ::testing::_))
+        .Times(4)
+        .WillRepeatedly(::testing::SaveArg<0>(&received));
+    runtime_delegate.UpdateSemantics(tree, {});
+    EXPECT_EQ(received.size(), 3u);
+
+    // Only the changed node is sent.
+    SemanticsNodeUpdates update = tree;
+    update[2].label = "changed";
+    runtime_delegate.UpdateSemantics(update, {});
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received.begin()->first, 2);
+
+    // Nothing is sent if no node changed.
+    runtime_delegate.UpdateSemantics(update, {});
+
+    // A node that was detached and attached again is sent again, as the
+    // platform views forget about detached nodes.
+    SemanticsNodeUpdates detach;
+    detach[0] = tree[0];
+    detach[0].childrenInTraversalOrder = {1};
+    runtime_delegate.UpdateSemantics(detach, {});
+    SemanticsNodeUpdates attach;
+    attach[0] = tree[0];
+    attach[2] = update[2];
+    runtime_delegate.UpdateSemantics(attach, {});
+    EXPECT_EQ(received.size(), 2u);
+  });
+}
+
+TEST_F(EngineTest, HintsGarbageCollectionWhenImagesExceedThreshold) {
+  const size_t base_image_bytes = CanvasImage::GetLiveBytes();
+  settings_.image_gc_threshold_bytes = base_image_bytes + 20000;
+  PostUITaskSync([this, base_image_bytes] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    std::vector<size_t> freed_hints;
+    EXPECT_CALL(*mock_runtime_controller,
+                NotifyIdle(::testing::_, ::testing::_))
+        .WillRepeatedly([&freed_hints](int64_t deadline, size_t freed_hint) {
+          freed_hints.push_back(freed_hint);
+          return true;
+        });
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+
+    engine->NotifyIdle(Dart_TimelineGetMicros());
+
+    // A 100x100 raster image holds 40000 bytes.
+    auto image = CanvasImage::Create();
+    image->set_image(
+        {SkSurface::MakeRasterN32Premul(100, 100)->makeImageSnapshot(),
+         nullptr});
+    const size_t image_bytes = CanvasImage::GetLiveBytes();
+    ASSERT_GE(image_bytes, base_image_bytes + 40000);
+    engine->NotifyIdle(Dart_TimelineGetMicros());
+    // The threshold moved up, so the image that is still alive doesn't cause
+    // another hint.
+    engine->NotifyIdle(Dart_TimelineGetMicros());
+
+    ASSERT_EQ(freed_hints.size(), 3u);
+    EXPECT_EQ(freed_hints[0], 0u);
+    EXPECT_EQ(freed_hints[1], image_bytes);
+    EXPECT_EQ(freed_hints[2], 0u);
+  });
+}
+
 }  // namespace flutter
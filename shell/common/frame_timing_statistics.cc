@@ -0,0 +1,140 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_timing_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace flutter {
+
+namespace {
+
+FrameTimePercentiles GetPercentiles(const DurationHistogram& histogram) {
+  return {
+      .p50 = histogram.GetPercentile(50),
+      .p90 = histogram.GetPercentile(90),
+      .p99 = histogram.GetPercentile(99),
+      .max = histogram.GetMax(),
+  };
+}
+
+}  // namespace
+
+DurationHistogram::DurationHistogram() {
+  Reset();
+}
+
+void DurationHistogram::Add(fml::TimeDelta duration) {
+  duration = std::max(duration, fml::TimeDelta::Zero());
+  buckets_[GetBucketIndex(duration)]++;
+  count_++;
+  max_ = std::max(max_, duration);
+}
+
+void DurationHistogram::Reset() {
+  buckets_.fill(0);
+  count_ = 0;
+  max_ = fml::TimeDelta::Zero();
+}
+
+fml::TimeDelta DurationHistogram::GetPercentile(double percentile) const {
+  if (count_ == 0) {
+    return fml::TimeDelta::Zero();
+  }
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  // The number of samples at or below the percentile, at least one.
+  const uint64_t rank = std::max<uint64_t>(
+      static_cast<uint64_t>(std::ceil(count_ * percentile / 100.0)), 1u);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return std::min(GetBucketUpperBound(i), max_);
+    }
+  }
+  return max_;
+}
+
+size_t DurationHistogram::GetBucketIndex(fml::TimeDelta duration) {
+  const int64_t micros = duration.ToMicroseconds();
+  if (micros <= kFirstBucketMicros) {
+    return 0;
+  }
+  const double index =
+      std::ceil(std::log(static_cast<double>(micros) / kFirstBucketMicros) /
+                std::log(kBucketGrowth));
+  return std::min(static_cast<size_t>(index), kBucketCount - 1);
+}
+
+fml::TimeDelta DurationHistogram::GetBucketUpperBound(size_t index) {
+  if (index >= kBucketCount - 1) {
+    return fml::TimeDelta::Max();
+  }
+  return fml::TimeDelta::FromMicroseconds(static_cast<int64_t>(
+      std::floor(kFirstBucketMicros * std::pow(kBucketGrowth, index))));
+}
+
+FrameTimingStatistics::FrameTimingStatistics() = default;
+
+FrameTimingStatistics::~FrameTimingStatistics() = default;
+
+void FrameTimingStatistics::AddFrameTiming(const FrameTiming& timing,
+                                           fml::Milliseconds frame_budget) {
+  const fml::TimeDelta vsync_overhead = timing.Get(FrameTiming::kBuildStart) -
+                                        timing.Get(FrameTiming::kVsyncStart);
+  const fml::TimeDelta build_time = timing.Get(FrameTiming::kBuildFinish) -
+                                    timing.Get(FrameTiming::kBuildStart);
+  const fml::TimeDelta raster_time = timing.Get(FrameTiming::kRasterFinish) -
+                                     timing.Get(FrameTiming::kRasterStart);
+  const fml::TimeDelta budget =
+      fml::TimeDelta::FromMillisecondsF(frame_budget.count());
+
+  std::scoped_lock lock(mutex_);
+  vsync_overhead_.Add(vsync_overhead);
+  build_.Add(build_time);
+  raster_.Add(raster_time);
+  const fml::TimeDelta gpu_time = timing.Get(FrameTiming::kGpu);
+  if (gpu_time > fml::TimeDelta::Zero()) {
+    gpu_.Add(gpu_time);
+  }
+  if (build_time > budget) {
+    janky_build_frame_count_++;
+  }
+  if (raster_time > budget) {
+    janky_raster_frame_count_++;
+  }
+}
+
+FrameTimingStatisticsSnapshot FrameTimingStatistics::GetSnapshot(bool reset) {
+  std::scoped_lock lock(mutex_);
+  FrameTimingStatisticsSnapshot snapshot;
+  snapshot.frame_count = build_.GetCount();
+  snapshot.janky_build_frame_count = janky_build_frame_count_;
+  snapshot.janky_raster_frame_count = janky_raster_frame_count_;
+  snapshot.vsync_overhead = GetPercentiles(vsync_overhead_);
+  snapshot.build = GetPercentiles(build_);
+  snapshot.raster = GetPercentiles(raster_);
+  snapshot.gpu = GetPercentiles(gpu_);
+  if (reset) {
+    ResetLocked();
+  }
+  return snapshot;
+}
+
+void FrameTimingStatistics::Reset() {
+  std::scoped_lock lock(mutex_);
+  ResetLocked();
+}
+
+void FrameTimingStatistics::ResetLocked() {
+  vsync_overhead_.Reset();
+  build_.Reset();
+  raster_.Reset();
+  gpu_.Reset();
+  janky_build_frame_count_ = 0;
+  janky_raster_frame_count_ = 0;
+}
+
+}  // namespace flutter
@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_TIMING_STATISTICS_H_
+#define FLUTTER_SHELL_COMMON_FRAME_TIMING_STATISTICS_H_
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A histogram of durations in logarithmic buckets, so that percentiles can be
+/// estimated in constant memory no matter how many samples were added.
+///
+/// Percentiles are reported as the upper bound of the bucket they fall in,
+/// which is at most |kBucketGrowth| times the exact value, but never more than
+/// the largest sample.
+///
+class DurationHistogram {
+ public:
+  // The upper bound of the first bucket. Shorter durations all fall in it.
+  static constexpr int64_t kFirstBucketMicros = 100;
+  // The ratio between the upper bounds of adjacent buckets.
+  static constexpr double kBucketGrowth = 1.1;
+  // With the above this covers durations up to about 20 seconds. The last
+  // bucket holds everything longer.
+  static constexpr size_t kBucketCount = 128;
+
+  DurationHistogram();
+
+  void Add(fml::TimeDelta duration);
+
+  void Reset();
+
+  uint64_t GetCount() const { return count_; }
+
+  fml::TimeDelta GetMax() const { return max_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Estimates the duration that |percentile| percent of the
+  ///             samples did not exceed.
+  ///
+  /// @param[in]  percentile  A value in [0, 100].
+  ///
+  /// @return     The estimate, or zero without any samples.
+  ///
+  fml::TimeDelta GetPercentile(double percentile) const;
+
+  static size_t GetBucketIndex(fml::TimeDelta duration);
+
+  static fml::TimeDelta GetBucketUpperBound(size_t index);
+
+ private:
+  std::array<uint64_t, kBucketCount> buckets_;
+  uint64_t count_ = 0;
+  fml::TimeDelta max_;
+};
+
+//------------------------------------------------------------------------------
+/// The distribution of one phase of the frames seen by
+/// |FrameTimingStatistics|.
+///
+struct FrameTimePercentiles {
+  fml::TimeDelta p50;
+  fml::TimeDelta p90;
+  fml::TimeDelta p99;
+  fml::TimeDelta max;
+};
+
+struct FrameTimingStatisticsSnapshot {
+  uint64_t frame_count = 0;
+  // Frames whose build or raster phase alone took longer than the frame
+  // budget.
+  uint64_t janky_build_frame_count = 0;
+  uint64_t janky_raster_frame_count = 0;
+  // The time from the vsync to the start of the build.
+  FrameTimePercentiles vsync_overhead;
+  FrameTimePercentiles build;
+  FrameTimePercentiles raster;
+  // The GPU time, see |FrameTiming::kGpu|, of the frames for which it is
+  // known.
+  FrameTimePercentiles gpu;
+};
+
+//------------------------------------------------------------------------------
+/// Collects the distribution of the build, raster, GPU and vsync overhead
+/// times of rasterized frames, for tools and embedders that want to monitor
+/// performance without receiving every |FrameTiming| in Dart.
+///
+/// Frame timings are reported on the raster thread. Snapshots may be taken on
+/// any thread. The statistics cover all frames since the collector was
+/// created or last reset, so periodic readers reset them along with taking a
+/// snapshot to get a rolling window.
+///
+class FrameTimingStatistics {
+ public:
+  FrameTimingStatistics();
+
+  ~FrameTimingStatistics();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timing of a rasterized frame.
+  ///
+  /// @param[in]  timing        The timing of the frame.
+  /// @param[in]  frame_budget  The time available for a single frame at the
+  ///                           current refresh rate.
+  ///
+  void AddFrameTiming(const FrameTiming& timing,
+                      fml::Milliseconds frame_budget);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the statistics of the frames recorded so far.
+  ///
+  /// @param[in]  reset  Whether to start collecting from scratch afterwards.
+  ///
+  FrameTimingStatisticsSnapshot GetSnapshot(bool reset = false);
+
+  void Reset();
+
+ private:
+  std::mutex mutex_;
+  DurationHistogram vsync_overhead_;
+  DurationHistogram build_;
+  DurationHistogram raster_;
+  DurationHistogram gpu_;
+  uint64_t janky_build_frame_count_ = 0;
+  uint64_t janky_raster_frame_count_ = 0;
+
+  void ResetLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingStatistics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_TIMING_STATISTICS_H_
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_timing_statistics.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::Milliseconds kFrameBudget{16};
+
+FrameTiming CreateFrameTiming(int64_t vsync_overhead_ms,
+                              int64_t build_ms,
+                              int64_t raster_ms) {
+  FrameTiming timing;
+  fml::TimePoint start = fml::TimePoint::Now();
+  timing.Set(FrameTiming::kVsyncStart, start);
+  fml::TimePoint build_start =
+      timing.Set(FrameTiming::kBuildStart,
+                 start + fml::TimeDelta::FromMilliseconds(vsync_overhead_ms));
+  fml::TimePoint build_finish =
+      timing.Set(FrameTiming::kBuildFinish,
+                 build_start + fml::TimeDelta::FromMilliseconds(build_ms));
+  timing.Set(FrameTiming::kRasterStart, build_finish);
+  timing.Set(FrameTiming::kRasterFinish,
+             build_finish + fml::TimeDelta::FromMilliseconds(raster_ms));
+  return timing;
+}
+
+// Whether |estimate| is within one bucket above |exact|.
+bool IsEstimateOf(fml::TimeDelta estimate, int64_t exact_ms) {
+  const double exact = exact_ms * 1000.0;
+  const double micros = estimate.ToMicroseconds();
+  return micros >= exact && micros <= exact * DurationHistogram::kBucketGrowth;
+}
+
+}  // namespace
+
+TEST(DurationHistogramTest, EmptyHistogramReportsZero) {
+  DurationHistogram histogram;
+  ASSERT_EQ(histogram.GetCount(), 0u);
+  ASSERT_EQ(histogram.GetPercentile(50), fml::TimeDelta::Zero());
+  ASSERT_EQ(histogram.GetMax(), fml::TimeDelta::Zero());
+}
+
+TEST(DurationHistogramTest, BucketsContainTheirDurations) {
+  for (int64_t micros : {0, 1, 100, 101, 999, 16667, 1000000}) {
+    fml::TimeDelta duration = fml::TimeDelta::FromMicroseconds(micros);
+    size_t index = DurationHistogram::GetBucketIndex(duration);
+    ASSERT_LE(duration, DurationHistogram::GetBucketUpperBound(index));
+    if (index > 0) {
+      ASSERT_GT(duration, DurationHistogram::GetBucketUpperBound(index - 1));
+    }
+  }
+  ASSERT_EQ(DurationHistogram::GetBucketIndex(fml::TimeDelta::Max()),
+            DurationHistogram::kBucketCount - 1);
+}
+
+TEST(DurationHistogramTest, EstimatesPercentiles) {
+  DurationHistogram histogram;
+  for (int64_t ms = 1; ms <= 100; ms++) {
+    histogram.Add(fml::TimeDelta::FromMilliseconds(ms));
+  }
+  ASSERT_EQ(histogram.GetCount(), 100u);
+  ASSERT_TRUE(IsEstimateOf(histogram.GetPercentile(50), 50));
+  ASSERT_TRUE(IsEstimateOf(histogram.GetPercentile(90), 90));
+  ASSERT_TRUE(IsEstimateOf(histogram.GetPercentile(99), 99));
+  ASSERT_EQ(histogram.GetPercentile(100),
+            fml::TimeDelta::FromMilliseconds(100));
+  ASSERT_EQ(histogram.GetMax(), fml::TimeDelta::FromMilliseconds(100));
+}
+
+TEST(DurationHistogramTest, PercentilesDoNotExceedMax) {
+  DurationHistogram histogram;
+  histogram.Add(fml::TimeDelta::FromMicroseconds(1050));
+  ASSERT_EQ(histogram.GetPercentile(50),
+            fml::TimeDelta::FromMicroseconds(1050));
+}
+
+TEST(FrameTimingStatisticsTest, ReportsPhasesSeparately) {
+  FrameTimingStatistics statistics;
+  for (int i = 0; i < 10; i++) {
+    statistics.AddFrameTiming(CreateFrameTiming(1, 4, 8), kFrameBudget);
+  }
+  FrameTimingStatisticsSnapshot snapshot = statistics.GetSnapshot();
+  ASSERT_EQ(snapshot.frame_count, 10u);
+  ASSERT_EQ(snapshot.vsync_overhead.max, fml::TimeDelta::FromMilliseconds(1));
+  ASSERT_EQ(snapshot.build.p50, fml::TimeDelta::FromMilliseconds(4));
+  ASSERT_EQ(snapshot.raster.p99, fml::TimeDelta::FromMilliseconds(8));
+  ASSERT_EQ(snapshot.janky_build_frame_count, 0u);
+  ASSERT_EQ(snapshot.janky_raster_frame_count, 0u);
+}
+
+TEST(FrameTimingStatisticsTest, OnlyReportsKnownGpuTimes) {
+  FrameTimingStatistics statistics;
+  statistics.AddFrameTiming(CreateFrameTiming(0, 4, 4), kFrameBudget);
+  ASSERT_EQ(statistics.GetSnapshot().gpu.max, fml::TimeDelta::Zero());
+  FrameTiming timing = CreateFrameTiming(0, 4, 4);
+  timing.Set(FrameTiming::kGpu, fml::TimeDelta::FromMilliseconds(6));
+  statistics.AddFrameTiming(timing, kFrameBudget);
+  FrameTimingStatisticsSnapshot snapshot = statistics.GetSnapshot();
+  ASSERT_EQ(snapshot.gpu.p50, fml::TimeDelta::FromMilliseconds(6));
+  ASSERT_EQ(snapshot.frame_count, 2u);
+}
+
+TEST(FrameTimingStatisticsTest, CountsJankyFrames) {
+  FrameTimingStatistics statistics;
+  statistics.AddFrameTiming(CreateFrameTiming(0, 20, 4), kFrameBudget);
+  statistics.AddFrameTiming(CreateFrameTiming(0, 4, 20), kFrameBudget);
+  statistics.AddFrameTiming(CreateFrameTiming(0, 20, 20), kFrameBudget);
+  statistics.AddFrameTiming(CreateFrameTiming(0, 4, 4), kFrameBudget);
+  FrameTimingStatisticsSnapshot snapshot = statistics.GetSnapshot();
+  ASSERT_EQ(snapshot.frame_count, 4u);
+  ASSERT_EQ(snapshot.janky_build_frame_count, 2u);
+  ASSERT_EQ(snapshot.janky_raster_frame_count, 2u);
+}
+
+TEST(FrameTimingStatisticsTest, SnapshotCanReset) {
+  FrameTimingStatistics statistics;
+  statistics.AddFrameTiming(CreateFrameTiming(0, 20, 4), kFrameBudget);
+  ASSERT_EQ(statistics.GetSnapshot(true).frame_count, 1u);
+  FrameTimingStatisticsSnapshot snapshot = statistics.GetSnapshot();
+  ASSERT_EQ(snapshot.frame_count, 0u);
+  ASSERT_EQ(snapshot.janky_build_frame_count, 0u);
+  ASSERT_EQ(snapshot.build.max, fml::TimeDelta::Zero());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,283 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/glyph_prewarmer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "minikin/FontCollection.h"
+#include "third_party/icu/source/common/unicode/unistr.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkGraphics.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "txt/font_skia.h"
+
+namespace flutter {
+
+// The glyphs are drawn on top of each other into a surface that holds one
+// glyph, up to this size in each dimension.
+static constexpr int kMaxSurfaceDimension = 1024;
+
+static std::vector<std::string> Split(
+    const std::string& string,
+    char separator,
+    size_t max_fields = std::numeric_limits<size_t>::max()) {
+  std::vector<std::string> fields;
+  size_t start = 0;
+  while (fields.size() + 1 < max_fields) {
+    const size_t end = string.find(separator, start);
+    if (end == std::string::npos) {
+      break;
+    }
+    fields.push_back(string.substr(start, end - start));
+    start = end + 1;
+  }
+  fields.push_back(string.substr(start));
+  return fields;
+}
+
+std::vector<GlyphPrewarmer::Run> GlyphPrewarmer::ParseRuns(
+    const fml::Mapping& mapping) {
+  const std::string contents(
+      reinterpret_cast<const char*>(mapping.GetMapping()), mapping.GetSize());
+  std::vector<Run> runs;
+  for (std::string line : Split(contents, '\n')) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    const std::vector<std::string> fields = Split(line, '\t', 4);
+    if (fields.size() != 4 || fields[3].empty()) {
+      FML_LOG(ERROR) << "Skipping malformed glyph prewarm run: " << line;
+      continue;
+    }
+    Run run;
+    for (const std::string& family : Split(fields[0], ',')) {
+      if (!family.empty()) {
+        run.font_families.push_back(family);
+      }
+    }
+    char* end = nullptr;
+    run.font_size = std::strtod(fields[1].c_str(), &end);
+    const bool size_valid = *end == '\0' && run.font_size > 0;
+    run.font_weight = std::strtol(fields[2].c_str(), &end, 10);
+    const bool weight_valid =
+        *end == '\0' && run.font_weight >= 100 && run.font_weight <= 900;
+    if (!size_valid || !weight_valid) {
+      FML_LOG(ERROR) << "Skipping malformed glyph prewarm run: " << line;
+      continue;
+    }
+    run.text = fields[3];
+    runs.push_back(std::move(run));
+  }
+  return runs;
+}
+
+std::vector<GlyphPrewarmer::Strike> GlyphPrewarmer::ResolveStrikes(
+    txt::FontCollection& collection,
+    const Run& run) {
+  TRACE_EVENT0("flutter", "GlyphPrewarmer::ResolveStrikes");
+  std::vector<Strike> strikes;
+  if (run.text.empty() || !(run.font_size > 0)) {
+    return strikes;
+  }
+  std::shared_ptr<minikin::FontCollection> minikin_collection =
+      collection.GetMinikinFontCollectionForFamilies(run.font_families, "");
+  if (!minikin_collection) {
+    return strikes;
+  }
+
+  const icu::UnicodeString text = icu::UnicodeString::fromUTF8(run.text);
+  const uint16_t* chars = reinterpret_cast<const uint16_t*>(text.getBuffer());
+  const minikin::FontStyle style(std::clamp(run.font_weight / 100, 1, 9),
+                                 run.italic);
+  std::vector<minikin::FontCollection::Run> items;
+  minikin_collection->itemize(chars, text.length(), style, &items);
+
+  for (const auto& item : items) {
+    const sk_sp<SkTypeface>& typeface =
+        static_cast<txt::FontSkia*>(item.fakedFont.font)->GetSkTypeface();
+    if (!typeface || item.end <= item.start) {
+      continue;
+    }
+    const bool fake_bold = item.fakedFont.fakery.isFakeBold();
+    const bool fake_italic = item.fakedFont.fakery.isFakeItalic();
+    auto strike = std::find_if(
+        strikes.begin(), strikes.end(), [&](const Strike& other) {
+          return other.typeface == typeface && other.fake_bold == fake_bold &&
+                 other.fake_italic == fake_italic;
+        });
+    if (strike == strikes.end()) {
+      strikes.push_back({typeface, static_cast<float>(run.font_size),
+                         fake_bold, fake_italic});
+      strike = strikes.end() - 1;
+    }
+
+    const int count = item.end - item.start;
+    const SkFont font(typeface, run.font_size);
+    std::vector<SkGlyphID> glyphs(count);
+    glyphs.resize(font.textToGlyphs(chars + item.start,
+                                    count * sizeof(uint16_t),
+                                    SkTextEncoding::kUTF16, glyphs.data(),
+                                    count));
+    strike->glyphs.insert(strike->glyphs.end(), glyphs.begin(), glyphs.end());
+  }
+
+  for (Strike& strike : strikes) {
+    std::vector<SkGlyphID>& glyphs = strike.glyphs;
+    std::sort(glyphs.begin(), glyphs.end());
+    glyphs.erase(std::unique(glyphs.begin(), glyphs.end()), glyphs.end());
+    // The missing glyph.
+    glyphs.erase(std::remove(glyphs.begin(), glyphs.end(), 0), glyphs.end());
+  }
+  strikes.erase(std::remove_if(strikes.begin(), strikes.end(),
+                               [](const Strike& strike) {
+                                 return strike.glyphs.empty();
+                               }),
+                strikes.end());
+  return strikes;
+}
+
+void GlyphPrewarmer::RasterizeStrike(const Strike& strike,
+                                     float device_pixel_ratio) {
+  TRACE_EVENT0("flutter", "GlyphPrewarmer::RasterizeStrike");
+  if (!strike.typeface || strike.glyphs.empty()) {
+    return;
+  }
+  // The same font settings as txt::ParagraphTxt, as they are part of the key
+  // of the glyph cache.
+  SkFont font(strike.typeface, strike.font_size);
+  font.setEdging(SkFont::Edging::kAntiAlias);
+  font.setSubpixel(true);
+  font.setHinting(SkFontHinting::kSlight);
+  font.setEmbolden(strike.fake_bold);
+  font.setSkewX(strike.fake_italic ? -SK_Scalar1 / 4 : 0);
+
+  const int dimension =
+      std::clamp(static_cast<int>(std::ceil(strike.font_size *
+                                            device_pixel_ratio * 2)),
+                 1, kMaxSurfaceDimension);
+  sk_sp<SkSurface> surface =
+      SkSurface::MakeRasterN32Premul(dimension, dimension);
+  if (!surface) {
+    return;
+  }
+  const std::vector<SkPoint> positions(
+      strike.glyphs.size(), SkPoint::Make(0, strike.font_size));
+  sk_sp<SkTextBlob> blob = SkTextBlob::MakeFromPosText(
+      strike.glyphs.data(), strike.glyphs.size() * sizeof(SkGlyphID),
+      positions.data(), font, SkTextEncoding::kGlyphID);
+  if (!blob) {
+    return;
+  }
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->scale(device_pixel_ratio, device_pixel_ratio);
+  canvas->drawTextBlob(blob, 0, 0, SkPaint());
+}
+
+GlyphPrewarmer::GlyphPrewarmer(
+    fml::RefPtr<IdleTaskQueue> idle_task_queue,
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    std::shared_ptr<txt::FontCollection> font_collection)
+    : idle_task_queue_(std::move(idle_task_queue)),
+      worker_task_runner_(std::move(worker_task_runner)),
+      font_collection_(std::move(font_collection)),
+      weak_factory_(this) {}
+
+GlyphPrewarmer::~GlyphPrewarmer() = default;
+
+void GlyphPrewarmer::SetDevicePixelRatio(float device_pixel_ratio) {
+  if (device_pixel_ratio > 0) {
+    device_pixel_ratio_ = device_pixel_ratio;
+  }
+}
+
+void GlyphPrewarmer::PrewarmFromAssets(const AssetManager& asset_manager) {
+  if (prewarmed_from_assets_) {
+    return;
+  }
+  prewarmed_from_assets_ = true;
+  std::unique_ptr<fml::Mapping> mapping =
+      asset_manager.GetAsMapping(kAssetName);
+  if (!mapping) {
+    return;
+  }
+  std::vector<Run> runs = ParseRuns(*mapping);
+  FML_LOG(INFO) << "Glyph prewarming got " << runs.size() << " runs.";
+  Prewarm(std::move(runs));
+}
+
+void GlyphPrewarmer::Prewarm(std::vector<Run> runs) {
+  if (runs.empty() || !font_collection_ || !worker_task_runner_) {
+    return;
+  }
+  for (Run& run : runs) {
+    pending_runs_.push_back(std::move(run));
+  }
+  PostIdleTask();
+}
+
+void GlyphPrewarmer::PostIdleTask() {
+  if (idle_task_posted_) {
+    return;
+  }
+  idle_task_posted_ = true;
+  idle_task_queue_->PostTask(
+      [weak = weak_factory_.GetWeakPtr()](fml::TimePoint deadline) {
+        if (weak) {
+          weak->ResolvePendingRuns(deadline);
+        }
+      });
+}
+
+void GlyphPrewarmer::ResolvePendingRuns(fml::TimePoint deadline) {
+  idle_task_posted_ = false;
+  const size_t budget = SkGraphics::GetFontCacheLimit() / 2;
+  while (!pending_runs_.empty()) {
+    Run run = std::move(pending_runs_.front());
+    pending_runs_.pop_front();
+    std::vector<Strike> strikes = ResolveStrikes(*font_collection_, run);
+
+    // An A8 glyph image takes about a byte per pixel of the em square.
+    const float pixels = run.font_size * device_pixel_ratio_;
+    const size_t glyph_bytes =
+        std::max<size_t>(1, static_cast<size_t>(pixels * pixels));
+    for (Strike& strike : strikes) {
+      const size_t count = std::min(
+          strike.glyphs.size(),
+          (budget - std::min(budget, rasterized_bytes_)) / glyph_bytes);
+      strike.glyphs.resize(count);
+      rasterized_bytes_ += count * glyph_bytes;
+    }
+    worker_task_runner_->PostTask(
+        [strikes = std::move(strikes),
+         device_pixel_ratio = device_pixel_ratio_]() {
+          for (const Strike& strike : strikes) {
+            RasterizeStrike(strike, device_pixel_ratio);
+          }
+        });
+
+    if (rasterized_bytes_ >= budget) {
+      FML_LOG(INFO) << "Glyph prewarming stopped at the glyph cache limit.";
+      pending_runs_.clear();
+    }
+    if (fml::TimePoint::Now() >= deadline) {
+      break;
+    }
+  }
+  if (!pending_runs_.empty()) {
+    PostIdleTask();
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_GLYPH_PREWARMER_H_
+#define FLUTTER_SHELL_COMMON_GLYPH_PREWARMER_H_
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/asset_manager.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/shell/common/idle_task_queue.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+#include "txt/font_collection.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Rasterizes the glyphs of a declared set of characters, fonts and sizes
+/// into Skia's glyph cache ahead of time. Without this, the first frame that
+/// shows text in a new font or size rasterizes its glyphs on the raster
+/// thread, which is most visible for screens of CJK text. The raster thread
+/// then only uploads the cached glyph images into its atlas.
+///
+/// The runs to prewarm are read from the |kAssetName| asset when the engine
+/// runs, and may be added at any later time with |Prewarm|. Their typefaces
+/// are resolved through the font collection of the engine in the idle time of
+/// the UI thread, the same way paragraph layout resolves them, including font
+/// fallback. The glyphs are then rasterized on a worker thread.
+///
+/// Must be used on the UI thread.
+///
+class GlyphPrewarmer {
+ public:
+  // The asset listing the runs to prewarm when the engine runs. Every line
+  // that is not empty or a comment starting with '#' is a run of four tab
+  // separated fields: the comma separated font families, the font size, the
+  // font weight and the characters.
+  static constexpr char kAssetName[] = "glyph_prewarm.txt";
+
+  struct Run {
+    std::vector<std::string> font_families;
+    double font_size = 14;
+    int font_weight = 400;
+    bool italic = false;
+    // The characters to prewarm, in UTF-8.
+    std::string text;
+  };
+
+  // The glyphs of a typeface to rasterize at a size.
+  struct Strike {
+    sk_sp<SkTypeface> typeface;
+    float font_size = 0;
+    bool fake_bold = false;
+    bool fake_italic = false;
+    std::vector<SkGlyphID> glyphs;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parses the runs listed in a |kAssetName| asset. Malformed
+  ///             lines are skipped.
+  ///
+  static std::vector<Run> ParseRuns(const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resolves the typefaces the characters of run are drawn with
+  ///             and maps the characters to their glyphs, one strike per
+  ///             typeface. Characters are mapped one by one, so glyphs that
+  ///             only shaping produces, such as ligatures, are not included.
+  ///
+  static std::vector<Strike> ResolveStrikes(txt::FontCollection& collection,
+                                            const Run& run);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Rasterizes the glyphs of strike scaled by device_pixel_ratio
+  ///             into Skia's glyph cache, with the font settings paragraphs
+  ///             draw with. May be called from any thread.
+  ///
+  static void RasterizeStrike(const Strike& strike, float device_pixel_ratio);
+
+  GlyphPrewarmer(fml::RefPtr<IdleTaskQueue> idle_task_queue,
+                 std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+                 std::shared_ptr<txt::FontCollection> font_collection);
+
+  ~GlyphPrewarmer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the device pixel ratio the glyphs are rasterized at.
+  ///
+  void SetDevicePixelRatio(float device_pixel_ratio);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Prewarms the runs listed in the |kAssetName| asset, if any.
+  ///             Only the first call has an effect.
+  ///
+  void PrewarmFromAssets(const AssetManager& asset_manager);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Prewarms runs in later idle periods of the UI thread.
+  ///
+  void Prewarm(std::vector<Run> runs);
+
+  size_t GetPendingRunCount() const { return pending_runs_.size(); }
+
+ private:
+  const fml::RefPtr<IdleTaskQueue> idle_task_queue_;
+  const std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  const std::shared_ptr<txt::FontCollection> font_collection_;
+  float device_pixel_ratio_ = 1;
+  bool prewarmed_from_assets_ = false;
+  bool idle_task_posted_ = false;
+  std::deque<Run> pending_runs_;
+  // The estimated size of the glyph images rasterized so far. Prewarming
+  // stops before it would evict glyphs that were prewarmed earlier from
+  // Skia's glyph cache.
+  size_t rasterized_bytes_ = 0;
+  fml::WeakPtrFactory<GlyphPrewarmer> weak_factory_;
+
+  void PostIdleTask();
+
+  void ResolvePendingRuns(fml::TimePoint deadline);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GlyphPrewarmer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_GLYPH_PREWARMER_H_
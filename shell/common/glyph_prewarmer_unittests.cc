@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/glyph_prewarmer.h"
+
+#include <string>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/lib/ui/text/font_collection.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static std::vector<GlyphPrewarmer::Run> ParseRuns(const std::string& text) {
+  fml::DataMapping mapping(text);
+  return GlyphPrewarmer::ParseRuns(mapping);
+}
+
+static std::shared_ptr<txt::FontCollection> CreateTestFontCollection() {
+  FontCollection font_collection;
+  font_collection.RegisterTestFonts();
+  return font_collection.GetFontCollection();
+}
+
+TEST(GlyphPrewarmerTest, ParsesRuns) {
+  auto runs = ParseRuns(
+      "# family\tsize\tweight\tcharacters\n"
+      "Roboto,Noto Sans SC\t16\t400\tHello 世界\r\n"
+      "\n"
+      "Roboto\t14.5\t700\ta\tb\n");
+  ASSERT_EQ(runs.size(), 2u);
+  ASSERT_EQ(runs[0].font_families,
+            std::vector<std::string>({"Roboto", "Noto Sans SC"}));
+  ASSERT_EQ(runs[0].font_size, 16);
+  ASSERT_EQ(runs[0].font_weight, 400);
+  ASSERT_EQ(runs[0].text, "Hello 世界");
+  ASSERT_EQ(runs[1].font_size, 14.5);
+  ASSERT_EQ(runs[1].font_weight, 700);
+  // Only the first three tabs separate fields.
+  ASSERT_EQ(runs[1].text, "a\tb");
+}
+
+TEST(GlyphPrewarmerTest, SkipsMalformedRuns) {
+  auto runs = ParseRuns(
+      "Roboto\t16\t400\n"
+      "Roboto\tlarge\t400\tabc\n"
+      "Roboto\t-1\t400\tabc\n"
+      "Roboto\t16\t1000\tabc\n"
+      "Roboto\t16\t400\t\n");
+  ASSERT_TRUE(runs.empty());
+}
+
+TEST(GlyphPrewarmerTest, ResolvesOneStrikePerTypeface) {
+  auto collection = CreateTestFontCollection();
+  GlyphPrewarmer::Run run;
+  run.font_families = {"Ahem"};
+  run.font_size = 20;
+  run.text = "ABBA";
+  auto strikes = GlyphPrewarmer::ResolveStrikes(*collection, run);
+  ASSERT_EQ(strikes.size(), 1u);
+  ASSERT_TRUE(strikes[0].typeface);
+  ASSERT_EQ(strikes[0].font_size, 20);
+  // Repeated characters are rasterized once.
+  ASSERT_EQ(strikes[0].glyphs.size(), 2u);
+
+  // Rasterizing must not need a GPU context.
+  GlyphPrewarmer::RasterizeStrike(strikes[0], 2);
+}
+
+TEST(GlyphPrewarmerTest, PrewarmsRunsInIdleTime) {
+  auto idle_task_queue = fml::MakeRefCounted<IdleTaskQueue>();
+  auto worker = fml::ConcurrentMessageLoop::Create(1);
+  GlyphPrewarmer prewarmer(idle_task_queue, worker->GetTaskRunner(),
+                           CreateTestFontCollection());
+
+  GlyphPrewarmer::Run run;
+  run.font_families = {"Ahem"};
+  run.text = "Flutter";
+  prewarmer.Prewarm({run, run});
+  ASSERT_EQ(prewarmer.GetPendingRunCount(), 2u);
+  ASSERT_EQ(idle_task_queue->GetPendingCount(), 1u);
+
+  idle_task_queue->RunUntil(fml::TimePoint::Now() +
+                            fml::TimeDelta::FromSeconds(10));
+  ASSERT_EQ(prewarmer.GetPendingRunCount(), 0u);
+  ASSERT_EQ(idle_task_queue->GetPendingCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/gpu_memory_budget_tuner.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/build_config.h"
+
+#if defined(OS_WIN)
+#include <windows.h>
+#elif defined(OS_FUCHSIA)
+#include <zircon/syscalls.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace flutter {
+
+static constexpr uint64_t kGigabyte = 1024 * 1024 * 1024;
+
+// Assumed when the memory of the device is not known.
+static constexpr uint64_t kDefaultMemoryBytes = 2 * kGigabyte;
+
+// No device needs more than this for both caches.
+static constexpr size_t kMaxTotalBytes = 1024 * 1024 * 1024;
+
+// A cache runs into its budget while it holds this much of it.
+static constexpr double kFullFraction = 0.9;
+
+// Budgets that differ by less than this fraction are not worth resizing the
+// caches for.
+static constexpr double kMinChange = 0.1;
+
+std::optional<uint64_t> GpuMemoryBudgetTuner::GetPhysicalMemoryBytes() {
+#if defined(OS_WIN)
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if (!::GlobalMemoryStatusEx(&status)) {
+    return std::nullopt;
+  }
+  return status.ullTotalPhys;
+#elif defined(OS_FUCHSIA)
+  return zx_system_get_physmem();
+#else
+  const long pages = ::sysconf(_SC_PHYS_PAGES);
+  const long page_size = ::sysconf(_SC_PAGESIZE);
+  if (pages <= 0 || page_size <= 0) {
+    return std::nullopt;
+  }
+  return static_cast<uint64_t>(pages) * static_cast<uint64_t>(page_size);
+#endif
+}
+
+size_t GpuMemoryBudgetTuner::ComputeTotalBudget(uint64_t memory_bytes) {
+  // Devices with little memory have less of it to spare for caches.
+  double share = 1.0 / 8;
+  if (memory_bytes < 3 * kGigabyte / 2) {
+    share = 1.0 / 16;
+  } else if (memory_bytes < 4 * kGigabyte) {
+    share = 1.0 / 12;
+  } else if (memory_bytes < 8 * kGigabyte) {
+    share = 1.0 / 10;
+  }
+  return static_cast<size_t>(std::min<double>(memory_bytes * share,
+                                              kMaxTotalBytes));
+}
+
+GpuMemoryBudgetTuner::GpuMemoryBudgetTuner(uint64_t memory_bytes,
+                                           uint64_t limit_bytes)
+    : total_bytes_(std::min<uint64_t>(
+          ComputeTotalBudget(memory_bytes > 0 ? memory_bytes
+                                              : kDefaultMemoryBytes),
+          limit_bytes > 0 ? limit_bytes / 2 : kMaxTotalBytes)) {}
+
+GpuMemoryBudgetTuner::~GpuMemoryBudgetTuner() = default;
+
+static bool DiffersSignificantly(size_t a, size_t b) {
+  return std::abs(static_cast<double>(a) - static_cast<double>(b)) >
+         kMinChange * std::max(a, b);
+}
+
+std::optional<GpuMemoryBudgetTuner::Budget> GpuMemoryBudgetTuner::AddFrame(
+    const SkISize& frame_size,
+    const Usage& usage) {
+  if (frame_size != frame_size_) {
+    frame_size_ = frame_size;
+    // The formula Android uses for the resource cache of a frame size.
+    // https://android.googlesource.com/platform/frameworks/base/+/master/libs/hwui/renderthread/CacheManager.cpp#41
+    const double frame_bytes =
+        static_cast<double>(frame_size.width()) * frame_size.height() * 12 * 4;
+    resource_cache_share_ =
+        std::clamp(frame_bytes / std::max<size_t>(total_bytes_, 1),
+                   kMinResourceCacheShare, kMaxResourceCacheShare);
+    window_frames_ = 0;
+  }
+
+  if (window_frames_ == 0) {
+    resource_cache_full_frames_ = 0;
+    raster_cache_full_frames_ = 0;
+    window_start_evicted_images_ = usage.raster_cache_evicted_images;
+  }
+  window_frames_++;
+  if (usage.resource_cache_limit_bytes > 0 &&
+      usage.resource_cache_bytes >=
+          kFullFraction * usage.resource_cache_limit_bytes) {
+    resource_cache_full_frames_++;
+  }
+  if (budget_ && budget_->raster_cache_bytes > 0 &&
+      usage.raster_cache_bytes >=
+          kFullFraction * budget_->raster_cache_bytes) {
+    raster_cache_full_frames_++;
+  }
+  if (window_frames_ >= kWindowFrames) {
+    EndWindow(usage);
+  }
+
+  const Budget budget = ComputeBudget();
+  if (budget_ &&
+      !DiffersSignificantly(budget.resource_cache_bytes,
+                            budget_->resource_cache_bytes) &&
+      !DiffersSignificantly(budget.raster_cache_bytes,
+                            budget_->raster_cache_bytes)) {
+    return std::nullopt;
+  }
+  budget_ = budget;
+  return budget;
+}
+
+void GpuMemoryBudgetTuner::EndWindow(const Usage& usage) {
+  // A cache churns if it ran into its budget in most frames of the window.
+  // Skia purges its resource cache silently, the raster cache has to have
+  // evicted images as well.
+  const bool resource_cache_churned =
+      resource_cache_full_frames_ * 2 > window_frames_;
+  const bool raster_cache_churned =
+      raster_cache_full_frames_ * 2 > window_frames_ &&
+      usage.raster_cache_evicted_images > window_start_evicted_images_;
+  if (resource_cache_churned && !raster_cache_churned) {
+    resource_cache_share_ += kShareStep;
+  } else if (raster_cache_churned && !resource_cache_churned) {
+    resource_cache_share_ -= kShareStep;
+  }
+  resource_cache_share_ = std::clamp(
+      resource_cache_share_, kMinResourceCacheShare, kMaxResourceCacheShare);
+  window_frames_ = 0;
+}
+
+GpuMemoryBudgetTuner::Budget GpuMemoryBudgetTuner::ComputeBudget() const {
+  Budget budget;
+  budget.resource_cache_bytes =
+      static_cast<size_t>(total_bytes_ * resource_cache_share_);
+  budget.raster_cache_bytes = total_bytes_ - budget.resource_cache_bytes;
+  return budget;
+}
+
+}  // namespace flutter
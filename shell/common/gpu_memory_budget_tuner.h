@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_GPU_MEMORY_BUDGET_TUNER_H_
+#define FLUTTER_SHELL_COMMON_GPU_MEMORY_BUDGET_TUNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Sizes the budgets of Skia's resource cache and of the raster cache
+/// together.
+///
+/// The total budget of both caches is a share of the memory of the device,
+/// a smaller one on devices with less memory, within the limit the platform
+/// reports. How it is split between the caches starts out from what the frame
+/// size calls for in Skia's resource cache, by the formula Android uses, and
+/// then follows how much either cache churns: every |kWindowFrames| frames,
+/// the cache that kept running into its budget while the other one did not
+/// gets a larger share.
+///
+/// Must be used on the raster thread.
+///
+class GpuMemoryBudgetTuner {
+ public:
+  struct Budget {
+    size_t resource_cache_bytes = 0;
+    size_t raster_cache_bytes = 0;
+  };
+
+  // What the caches held after a frame.
+  struct Usage {
+    size_t resource_cache_bytes = 0;
+    size_t resource_cache_limit_bytes = 0;
+    size_t raster_cache_bytes = 0;
+    // The number of images the raster cache evicted so far.
+    size_t raster_cache_evicted_images = 0;
+  };
+
+  // The number of frames over which the churn of the caches is measured.
+  static constexpr size_t kWindowFrames = 120;
+
+  // The bounds of the share of the total budget Skia's resource cache gets.
+  static constexpr double kMinResourceCacheShare = 0.25;
+  static constexpr double kMaxResourceCacheShare = 0.85;
+
+  // How much the share moves after a window in which one cache churned.
+  static constexpr double kShareStep = 0.05;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The physical memory of the device, if it can be queried on
+  ///             this platform.
+  ///
+  static std::optional<uint64_t> GetPhysicalMemoryBytes();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The total budget of both caches on a device with
+  ///             memory_bytes of memory.
+  ///
+  static size_t ComputeTotalBudget(uint64_t memory_bytes);
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  memory_bytes  The physical memory of the device, or 0 if it
+  ///                           is not known.
+  /// @param[in]  limit_bytes   The memory the platform allows the application
+  ///                           to use, or 0 if there is no such limit. The
+  ///                           caches get at most half of it.
+  ///
+  GpuMemoryBudgetTuner(uint64_t memory_bytes, uint64_t limit_bytes);
+
+  ~GpuMemoryBudgetTuner();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the usage of the caches after a frame was drawn.
+  ///
+  /// @return     The budget to apply, if it changed enough since the last one
+  ///             returned to be worth resizing the caches for.
+  ///
+  std::optional<Budget> AddFrame(const SkISize& frame_size, const Usage& usage);
+
+  size_t GetTotalBytes() const { return total_bytes_; }
+
+  double GetResourceCacheShare() const { return resource_cache_share_; }
+
+ private:
+  const size_t total_bytes_;
+  SkISize frame_size_ = SkISize::MakeEmpty();
+  double resource_cache_share_ = 0.5;
+  std::optional<Budget> budget_;
+
+  // The churn of the current window.
+  size_t window_frames_ = 0;
+  size_t resource_cache_full_frames_ = 0;
+  size_t raster_cache_full_frames_ = 0;
+  size_t window_start_evicted_images_ = 0;
+
+  Budget ComputeBudget() const;
+
+  void EndWindow(const Usage& usage);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GpuMemoryBudgetTuner);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_GPU_MEMORY_BUDGET_TUNER_H_
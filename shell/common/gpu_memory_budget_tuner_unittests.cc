@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/gpu_memory_budget_tuner.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr uint64_t kMegabyte = 1024 * 1024;
+constexpr uint64_t kGigabyte = 1024 * kMegabyte;
+
+// A frame that calls for half of the total budget of a 1 GB device in Skia's
+// resource cache.
+const SkISize kFrameSize = SkISize::Make(1024, 683);
+
+void AddFrames(GpuMemoryBudgetTuner& tuner,
+               size_t count,
+               GpuMemoryBudgetTuner::Usage& usage,
+               size_t evicted_images_per_frame) {
+  for (size_t i = 0; i < count; i++) {
+    usage.raster_cache_evicted_images += evicted_images_per_frame;
+    tuner.AddFrame(kFrameSize, usage);
+  }
+}
+
+}  // namespace
+
+TEST(GpuMemoryBudgetTunerTest, TotalBudgetFollowsDeviceMemory) {
+  ASSERT_EQ(GpuMemoryBudgetTuner::ComputeTotalBudget(kGigabyte),
+            64 * kMegabyte);
+  size_t previous = 0;
+  for (uint64_t memory : {kGigabyte, 2 * kGigabyte, 4 * kGigabyte,
+                          6 * kGigabyte, 16 * kGigabyte}) {
+    const size_t total = GpuMemoryBudgetTuner::ComputeTotalBudget(memory);
+    ASSERT_GT(total, previous);
+    previous = total;
+  }
+  ASSERT_EQ(GpuMemoryBudgetTuner::ComputeTotalBudget(64 * kGigabyte),
+            GpuMemoryBudgetTuner::ComputeTotalBudget(16 * kGigabyte));
+}
+
+TEST(GpuMemoryBudgetTunerTest, StaysWithinPlatformLimit) {
+  GpuMemoryBudgetTuner tuner(16 * kGigabyte, 200 * kMegabyte);
+  ASSERT_EQ(tuner.GetTotalBytes(), 100 * kMegabyte);
+}
+
+TEST(GpuMemoryBudgetTunerTest, SplitsTotalBudgetByFrameSize) {
+  GpuMemoryBudgetTuner tuner(kGigabyte, 0);
+  auto budget = tuner.AddFrame(kFrameSize, {});
+  ASSERT_TRUE(budget.has_value());
+  ASSERT_NEAR(tuner.GetResourceCacheShare(), 0.5, 0.01);
+  ASSERT_EQ(budget->resource_cache_bytes + budget->raster_cache_bytes,
+            tuner.GetTotalBytes());
+
+  // The budget is only returned again once it changes.
+  ASSERT_FALSE(tuner.AddFrame(kFrameSize, {}).has_value());
+
+  // Small frames leave most of the budget to the raster cache.
+  budget = tuner.AddFrame(SkISize::Make(100, 100), {});
+  ASSERT_TRUE(budget.has_value());
+  ASSERT_EQ(tuner.GetResourceCacheShare(),
+            GpuMemoryBudgetTuner::kMinResourceCacheShare);
+  ASSERT_GT(budget->raster_cache_bytes, budget->resource_cache_bytes);
+}
+
+TEST(GpuMemoryBudgetTunerTest, GrowsResourceCacheWhenItChurns) {
+  GpuMemoryBudgetTuner tuner(kGigabyte, 0);
+  const auto initial = tuner.AddFrame(kFrameSize, {});
+  const double initial_share = tuner.GetResourceCacheShare();
+
+  GpuMemoryBudgetTuner::Usage usage;
+  usage.resource_cache_bytes = initial->resource_cache_bytes;
+  usage.resource_cache_limit_bytes = initial->resource_cache_bytes;
+  AddFrames(tuner, GpuMemoryBudgetTuner::kWindowFrames, usage, 0);
+  ASSERT_NEAR(tuner.GetResourceCacheShare(),
+              initial_share + GpuMemoryBudgetTuner::kShareStep, 1e-9);
+}
+
+TEST(GpuMemoryBudgetTunerTest, GrowsRasterCacheWhenItChurns) {
+  GpuMemoryBudgetTuner tuner(kGigabyte, 0);
+  const auto initial = tuner.AddFrame(kFrameSize, {});
+  const double initial_share = tuner.GetResourceCacheShare();
+
+  GpuMemoryBudgetTuner::Usage usage;
+  usage.raster_cache_bytes = initial->raster_cache_bytes;
+  AddFrames(tuner, GpuMemoryBudgetTuner::kWindowFrames, usage, 1);
+  ASSERT_NEAR(tuner.GetResourceCacheShare(),
+              initial_share - GpuMemoryBudgetTuner::kShareStep, 1e-9);
+}
+
+TEST(GpuMemoryBudgetTunerTest, KeepsSplitWhenBothOrNeitherChurn) {
+  GpuMemoryBudgetTuner tuner(kGigabyte, 0);
+  const auto initial = tuner.AddFrame(kFrameSize, {});
+  const double initial_share = tuner.GetResourceCacheShare();
+
+  GpuMemoryBudgetTuner::Usage usage;
+  AddFrames(tuner, GpuMemoryBudgetTuner::kWindowFrames, usage, 0);
+  ASSERT_EQ(tuner.GetResourceCacheShare(), initial_share);
+
+  usage.resource_cache_bytes = initial->resource_cache_bytes;
+  usage.resource_cache_limit_bytes = initial->resource_cache_bytes;
+  usage.raster_cache_bytes = initial->raster_cache_bytes;
+  AddFrames(tuner, GpuMemoryBudgetTuner::kWindowFrames, usage, 1);
+  ASSERT_EQ(tuner.GetResourceCacheShare(), initial_share);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_frame_rate_tuner.h"
+
+namespace flutter {
+
+namespace {
+
+// Frames that change less than this fraction of the screen count as idle. This
+// covers a cursor or a spinner, but not scrolling or page transitions.
+constexpr double kLowDamageFraction = 0.02;
+
+// The number of consecutive idle frames before the frame rate is lowered, so
+// that short pauses in larger animations keep the full rate.
+constexpr size_t kLowDamageFrameCount = 30;
+
+}  // namespace
+
+IdleFrameRateTuner::IdleFrameRateTuner(double idle_frame_rate)
+    : idle_frame_rate_(idle_frame_rate), recommended_max_frame_rate_(0) {}
+
+IdleFrameRateTuner::~IdleFrameRateTuner() = default;
+
+void IdleFrameRateTuner::AddFrameDamage(double damaged_fraction) {
+  if (damaged_fraction > kLowDamageFraction) {
+    low_damage_frame_count_ = 0;
+    recommended_max_frame_rate_ = 0;
+    return;
+  }
+
+  low_damage_frame_count_++;
+  if (low_damage_frame_count_ >= kLowDamageFrameCount) {
+    recommended_max_frame_rate_ = idle_frame_rate_;
+  }
+}
+
+double IdleFrameRateTuner::GetRecommendedMaxFrameRate() const {
+  return recommended_max_frame_rate_;
+}
+
+}  // namespace flutter
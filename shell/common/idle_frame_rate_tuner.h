@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_FRAME_RATE_TUNER_H_
+#define FLUTTER_SHELL_COMMON_IDLE_FRAME_RATE_TUNER_H_
+
+#include <atomic>
+#include <cstddef>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Lowers the rate frames are produced at while only a small part of the
+/// screen changes from one frame to the next, such as for a blinking cursor or
+/// a progress spinner.
+///
+/// The rasterizer reports how much of every frame changed since the previous
+/// one, as found by diffing their layer trees. Once enough consecutive frames
+/// changed less than a small fraction of the screen, the animator skips vsyncs
+/// to produce frames at the idle frame rate only. The first frame that changes
+/// more than that goes back to the full rate of the display.
+///
+/// Frame damage is reported on the raster thread, the recommended frame rate
+/// may be read from any thread.
+///
+class IdleFrameRateTuner {
+ public:
+  explicit IdleFrameRateTuner(double idle_frame_rate);
+
+  ~IdleFrameRateTuner();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records how much of a rasterized frame changed and updates
+  ///             the recommended frame rate.
+  ///
+  /// @param[in]  damaged_fraction  The area of the frame that changed since
+  ///                               the previous frame, as a fraction of the
+  ///                               area of the frame. 1 if it is not known.
+  ///
+  void AddFrameDamage(double damaged_fraction);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The highest rate that frames should be produced at, or 0 if
+  ///             they should be produced at the rate of the display.
+  ///
+  double GetRecommendedMaxFrameRate() const;
+
+ private:
+  const double idle_frame_rate_;
+  std::atomic<double> recommended_max_frame_rate_;
+
+  // Only accessed on the raster thread.
+  size_t low_damage_frame_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleFrameRateTuner);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_FRAME_RATE_TUNER_H_
@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_frame_rate_tuner.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+void AddFrames(IdleFrameRateTuner& tuner,
+               size_t count,
+               double damaged_fraction) {
+  for (size_t i = 0; i < count; i++) {
+    tuner.AddFrameDamage(damaged_fraction);
+  }
+}
+
+}  // namespace
+
+TEST(IdleFrameRateTunerTest, StartsAtFullRate) {
+  IdleFrameRateTuner tuner(30);
+  ASSERT_EQ(tuner.GetRecommendedMaxFrameRate(), 0);
+}
+
+TEST(IdleFrameRateTunerTest, LowersRateWhenLittleChanges) {
+  IdleFrameRateTuner tuner(30);
+  AddFrames(tuner, 10, 0.001);
+  ASSERT_EQ(tuner.GetRecommendedMaxFrameRate(), 0);
+  AddFrames(tuner, 100, 0.001);
+  ASSERT_EQ(tuner.GetRecommendedMaxFrameRate(), 30);
+}
+
+TEST(IdleFrameRateTunerTest, KeepsFullRateWhenMuchChanges) {
+  IdleFrameRateTuner tuner(30);
+  AddFrames(tuner, 100, 0.5);
+  ASSERT_EQ(tuner.GetRecommendedMaxFrameRate(), 0);
+}
+
+TEST(IdleFrameRateTunerTest, GoesBackToFullRateOnLargeDamage) {
+  IdleFrameRateTuner tuner(30);
+  AddFrames(tuner, 100, 0);
+  ASSERT_EQ(tuner.GetRecommendedMaxFrameRate(), 30);
+  tuner.AddFrameDamage(1);
+  ASSERT_EQ(tuner.GetRecommendedMaxFrameRate(), 0);
+  // A short pause of a larger animation keeps the full rate.
+  AddFrames(tuner, 5, 0);
+  ASSERT_EQ(tuner.GetRecommendedMaxFrameRate(), 0);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_queue.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+IdleTaskQueue::IdleTaskQueue() = default;
+
+IdleTaskQueue::~IdleTaskQueue() = default;
+
+void IdleTaskQueue::PostTask(IdleTask task) {
+  if (!task) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  tasks_.push_back(std::move(task));
+}
+
+size_t IdleTaskQueue::RunUntil(fml::TimePoint deadline) {
+  size_t run_count = 0;
+  size_t pending_count = GetPendingCount();
+  if (pending_count == 0) {
+    return run_count;
+  }
+
+  TRACE_EVENT0("flutter", "IdleTaskQueue::RunUntil");
+  // Only the tasks that were pending when the idle period began run in it, so
+  // that a task that posts itself again does not run until the deadline.
+  while (run_count < pending_count && fml::TimePoint::Now() < deadline) {
+    IdleTask task;
+    {
+      std::scoped_lock lock(mutex_);
+      if (tasks_.empty()) {
+        break;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task(deadline);
+    run_count++;
+  }
+  return run_count;
+}
+
+size_t IdleTaskQueue::GetPendingCount() const {
+  std::scoped_lock lock(mutex_);
+  return tasks_.size();
+}
+
+}  // namespace flutter
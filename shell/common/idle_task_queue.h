@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
+#define FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
+
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A queue of maintenance work, such as trimming caches, that only runs in
+/// the time the UI thread has left over after producing a frame.
+///
+/// The engine runs the queue whenever it notifies the Dart VM that it is
+/// idle, until the deadline of that idle period. Tasks run one at a time in
+/// the order they were posted, and the tasks that do not fit in an idle
+/// period run in the next one. A task is given the deadline so that it can
+/// split up longer work and post the rest as another idle task.
+///
+/// Tasks may be posted from any thread, they always run on the UI thread.
+///
+class IdleTaskQueue : public fml::RefCountedThreadSafe<IdleTaskQueue> {
+ public:
+  using IdleTask = std::function<void(fml::TimePoint deadline)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Posts a task to run in a later idle period.
+  ///
+  void PostTask(IdleTask task);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the pending tasks until the deadline has passed. Tasks
+  ///             posted while this runs wait for the next idle period.
+  ///
+  /// @param[in]  deadline  The end of the idle period.
+  ///
+  /// @return     The number of tasks that ran.
+  ///
+  size_t RunUntil(fml::TimePoint deadline);
+
+  size_t GetPendingCount() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::deque<IdleTask> tasks_;
+
+  IdleTaskQueue();
+
+  ~IdleTaskQueue();
+
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(IdleTaskQueue);
+  FML_FRIEND_MAKE_REF_COUNTED(IdleTaskQueue);
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleTaskQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
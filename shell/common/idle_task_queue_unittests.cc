@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_queue.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(IdleTaskQueueTest, RunsTasksInOrder) {
+  auto queue = fml::MakeRefCounted<IdleTaskQueue>();
+  std::vector<int> order;
+  queue->PostTask([&](fml::TimePoint) { order.push_back(1); });
+  queue->PostTask([&](fml::TimePoint) { order.push_back(2); });
+  ASSERT_EQ(queue->GetPendingCount(), 2u);
+
+  auto deadline = fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+  ASSERT_EQ(queue->RunUntil(deadline), 2u);
+  ASSERT_EQ(order, std::vector<int>({1, 2}));
+  ASSERT_EQ(queue->GetPendingCount(), 0u);
+}
+
+TEST(IdleTaskQueueTest, PassesDeadlineToTasks) {
+  auto queue = fml::MakeRefCounted<IdleTaskQueue>();
+  fml::TimePoint task_deadline;
+  queue->PostTask([&](fml::TimePoint deadline) { task_deadline = deadline; });
+
+  auto deadline = fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+  queue->RunUntil(deadline);
+  ASSERT_EQ(task_deadline, deadline);
+}
+
+TEST(IdleTaskQueueTest, StopsAtDeadline) {
+  auto queue = fml::MakeRefCounted<IdleTaskQueue>();
+  auto deadline = fml::TimePoint::Now() + fml::TimeDelta::FromMilliseconds(1);
+  queue->PostTask([](fml::TimePoint deadline) {
+    while (fml::TimePoint::Now() < deadline) {
+    }
+  });
+  int run_count = 0;
+  queue->PostTask([&](fml::TimePoint) { run_count++; });
+
+  ASSERT_EQ(queue->RunUntil(deadline), 1u);
+  ASSERT_EQ(run_count, 0);
+  ASSERT_EQ(queue->GetPendingCount(), 1u);
+
+  // The remaining task runs in the next idle period.
+  queue->RunUntil(fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10));
+  ASSERT_EQ(run_count, 1);
+}
+
+TEST(IdleTaskQueueTest, TaskPostedWhileRunningWaitsForNextIdlePeriod) {
+  auto queue = fml::MakeRefCounted<IdleTaskQueue>();
+  int run_count = 0;
+  std::function<void(fml::TimePoint)> repost = [&](fml::TimePoint) {
+    run_count++;
+    queue->PostTask(repost);
+  };
+  queue->PostTask(repost);
+
+  auto deadline = fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+  ASSERT_EQ(queue->RunUntil(deadline), 1u);
+  ASSERT_EQ(run_count, 1);
+  ASSERT_EQ(queue->GetPendingCount(), 1u);
+}
+
+TEST(IdleTaskQueueTest, RunsNothingAfterDeadline) {
+  auto queue = fml::MakeRefCounted<IdleTaskQueue>();
+  int run_count = 0;
+  queue->PostTask([&](fml::TimePoint) { run_count++; });
+
+  ASSERT_EQ(queue->RunUntil(fml::TimePoint::Now()), 0u);
+  ASSERT_EQ(run_count, 0);
+  ASSERT_EQ(queue->GetPendingCount(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
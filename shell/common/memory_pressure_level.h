@@ -0,0 +1,29 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_LEVEL_H_
+#define FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_LEVEL_H_
+
+namespace flutter {
+
+/// How urgently the platform asks the engine to release memory. Each level
+/// has its own policy, see `Shell::NotifyMemoryPressure`.
+///
+/// The values are shared with the embedder API and the Android embedding and
+/// must not change.
+enum class MemoryPressureLevel {
+  /// The system is running low on memory while the application is in use.
+  /// Caches are trimmed but enough is kept to avoid re-rendering stalls.
+  kModerate = 0,
+  /// The system is about to kill processes to reclaim memory. Everything that
+  /// can be recreated is released.
+  kCritical = 1,
+  /// The application is no longer visible, so its rendering caches are of no
+  /// use until it comes back.
+  kBackground = 2,
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_LEVEL_H_
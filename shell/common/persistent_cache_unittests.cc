@@ -11,6 +11,7 @@
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/physical_shape_layer.h"
 #include "flutter/flow/layers/picture_layer.h"
+#include "flutter/fml/async_file.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/log_settings.h"
@@ -26,11 +27,19 @@ namespace testing {
 
 using PersistentCacheTest = ShellTest;
 
+// Waits for the IO thread, then for the file thread and for the file writes,
+// which perform the cache writes the IO thread may have requested.
 static void WaitForIO(Shell* shell) {
   std::promise<bool> io_task_finished;
   shell->GetTaskRunners().GetIOTaskRunner()->PostTask(
       [&io_task_finished]() { io_task_finished.set_value(true); });
   io_task_finished.get_future().wait();
+
+  std::promise<bool> file_task_finished;
+  fml::AsyncFileIO::GetForProcess().GetTaskRunner()->PostTask(
+      [&file_task_finished]() { file_task_finished.set_value(true); });
+  file_task_finished.get_future().wait();
+  fml::AsyncFileIO::GetForProcess().WaitForOperations();
 }
 
 static void WaitForRaster(Shell* shell) {
@@ -267,6 +276,45 @@ TEST_F(PersistentCacheTest, CanLoadSkSLsFromAsset) {
   fml::UnlinkFile(asset_dir.fd(), PersistentCache::kAssetFileName);
 }
 
+TEST_F(PersistentCacheTest, CanAddAndExportSkSLBundles) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  ResetAssetManager();
+
+  // See CanLoadSkSLsFromAsset for the encoding of the keys and the SkSLs.
+  const std::string kTestJson =
+      "{\"data\": {\"IE\": \"eA==\", \"II\": \"eQ==\"}}";
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  EXPECT_FALSE(persistent_cache->AddSkSLBundle(
+      std::make_shared<fml::DataMapping>(std::string("{\"data\": 42}"))));
+  ASSERT_TRUE(persistent_cache->AddSkSLBundle(
+      std::make_shared<fml::DataMapping>(kTestJson)));
+  CheckTwoSkSLsAreLoaded();
+
+  // The exported bundle holds the same SkSLs and can be added again.
+  const std::string exported = persistent_cache->ExportSkSLBundle();
+  PersistentCache::ResetCacheForProcess();
+  persistent_cache = PersistentCache::GetCacheForProcess();
+  ASSERT_TRUE(persistent_cache->LoadSkSLs().empty());
+  ASSERT_TRUE(persistent_cache->AddSkSLBundle(
+      std::make_shared<fml::DataMapping>(exported)));
+  auto shaders = persistent_cache->LoadSkSLs();
+  ASSERT_EQ(shaders.size(), 2u);
+  if (shaders[0].first->bytes()[0] == 'B') {
+    std::swap(shaders[0], shaders[1]);
+  }
+  CheckTextSkData(shaders[0].first, "A");
+  CheckTextSkData(shaders[1].first, "B");
+  CheckTextSkData(shaders[0].second, "x");
+  CheckTextSkData(shaders[1].second, "y");
+
+  // Cleanup
+  PersistentCache::ResetCacheForProcess();
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
 TEST_F(PersistentCacheTest, CanRemoveOldPersistentCache) {
   fml::ScopedTemporaryDirectory base_dir;
   ASSERT_TRUE(base_dir.fd().is_valid());
@@ -351,10 +399,7 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
 
   // Store the cache and verify it's valid.
   StorePersistentCache(persistent_cache, *shader_key, *shader_value);
-  std::promise<bool> io_flushed;
-  shell->GetTaskRunners().GetIOTaskRunner()->PostTask(
-      [&io_flushed]() { io_flushed.set_value(true); });
-  io_flushed.get_future().get();  // Wait for the IO thread to flush the file.
+  WaitForIO(shell.get());  // Wait for the file thread to flush the file.
   ASSERT_GT(persistent_cache->LoadSkSLs().size(), 0u);
 
   // Cleanup
@@ -362,5 +407,300 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(PersistentCacheTest, StoresEntriesInOneArchive) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(false);
+
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  sk_sp<SkData> key1 = SkData::MakeWithCString("key1");
+  sk_sp<SkData> key2 = SkData::MakeWithCString("key2");
+  sk_sp<SkData> value1 = SkData::MakeWithCString("value1");
+  sk_sp<SkData> value2 = SkData::MakeWithCString("value2");
+  ASSERT_EQ(persistent_cache->load(*key1), nullptr);
+
+  // Without any worker task runner the entries are stored synchronously.
+  StorePersistentCache(persistent_cache, *key1, *value1);
+  StorePersistentCache(persistent_cache, *key2, *value2);
+
+  sk_sp<SkData> loaded1 = persistent_cache->load(*key1);
+  sk_sp<SkData> loaded2 = persistent_cache->load(*key2);
+  ASSERT_NE(loaded1, nullptr);
+  ASSERT_NE(loaded2, nullptr);
+  EXPECT_TRUE(loaded1->equals(value1.get()));
+  EXPECT_TRUE(loaded2->equals(value2.get()));
+
+  std::vector<std::string> file_names;
+  fml::VisitFilesRecursively(
+      base_dir.fd(), [&file_names](const fml::UniqueFD& directory,
+                                   const std::string& filename) {
+        if (!fml::IsDirectory(directory, filename.c_str())) {
+          file_names.push_back(filename);
+        }
+        return true;
+      });
+  EXPECT_EQ(file_names,
+            std::vector<std::string>{PersistentCacheArchive::kFileName});
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, StoredMetalBinaryArchiveTakesPrecedenceOverAsset) {
+  fml::ScopedTemporaryDirectory base_dir;
+  fml::ScopedTemporaryDirectory asset_dir;
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  PersistentCache::SetAssetManager(nullptr);
+  ASSERT_EQ(persistent_cache->LoadMetalBinaryArchive(), nullptr);
+
+  fml::DataMapping asset(std::string("asset"));
+  ASSERT_TRUE(fml::WriteAtomically(
+      asset_dir.fd(), PersistentCache::kMetalBinaryArchiveAssetName, asset));
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::OpenDirectory(asset_dir.path().c_str(), false,
+                         fml::FilePermission::kRead),
+      false));
+  PersistentCache::SetAssetManager(asset_manager);
+
+  auto loaded = persistent_cache->LoadMetalBinaryArchive();
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(loaded->GetMapping()),
+                        loaded->GetSize()),
+            "asset");
+
+  // The archive gathered at runtime replaces the packaged one.
+  fml::DataMapping stored(std::string("stored"));
+  ASSERT_TRUE(persistent_cache->StoreMetalBinaryArchive(stored));
+  loaded = persistent_cache->LoadMetalBinaryArchive();
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(loaded->GetMapping()),
+                        loaded->GetSize()),
+            "stored");
+
+  // Cleanup
+  PersistentCache::SetAssetManager(nullptr);
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  fml::RemoveFilesInDirectory(asset_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, LoadsSkSLsInOrderOfFirstUse) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(true);
+
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  std::vector<sk_sp<SkData>> keys = {SkData::MakeWithCString("c"),
+                                     SkData::MakeWithCString("a"),
+                                     SkData::MakeWithCString("b")};
+  sk_sp<SkData> sksl = SkData::MakeWithCString("sksl");
+  for (const auto& key : keys) {
+    StorePersistentCache(persistent_cache, *key, *sksl);
+  }
+  // Storing a key again does not change its position.
+  StorePersistentCache(persistent_cache, *keys[0], *sksl);
+
+  auto sksls = persistent_cache->LoadSkSLs();
+  ASSERT_EQ(sksls.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    EXPECT_TRUE(sksls[i].first->equals(keys[i].get()));
+  }
+
+  // Nothing is visited without a context.
+  size_t next_index = 0;
+  EXPECT_EQ(persistent_cache->PrecompileSkSLs(nullptr, sksls, &next_index),
+            0u);
+  EXPECT_EQ(next_index, 0u);
+
+  // Cleanup
+  PersistentCache::SetCacheSkSL(false);
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, LoadsSkSLsUsedInMoreLaunchesFirst) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(true);
+
+  // Without any worker task runner the cache writes synchronously.
+  sk_sp<SkData> key1 = SkData::MakeWithCString("key1");
+  sk_sp<SkData> key2 = SkData::MakeWithCString("key2");
+  sk_sp<SkData> sksl = SkData::MakeWithCString("sksl");
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  StorePersistentCache(persistent_cache, *key1, *sksl);
+  StorePersistentCache(persistent_cache, *key2, *sksl);
+  persistent_cache->StoreShaderUsage();
+
+  // Next launch.
+  PersistentCache::ResetCacheForProcess();
+  persistent_cache = PersistentCache::GetCacheForProcess();
+  StorePersistentCache(persistent_cache, *key2, *sksl);
+  persistent_cache->StoreShaderUsage();
+
+  PersistentCache::ResetCacheForProcess();
+  persistent_cache = PersistentCache::GetCacheForProcess();
+  auto sksls = persistent_cache->LoadSkSLs();
+  ASSERT_EQ(sksls.size(), 2u);
+  EXPECT_TRUE(sksls[0].first->equals(key2.get()));
+  EXPECT_TRUE(sksls[1].first->equals(key1.get()));
+
+  // Cleanup
+  PersistentCache::SetCacheSkSL(false);
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, PrunesEntriesNotUsedForMaxUnusedLaunches) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(false);
+
+  sk_sp<SkData> key1 = SkData::MakeWithCString("key1");
+  sk_sp<SkData> key2 = SkData::MakeWithCString("key2");
+  sk_sp<SkData> value = SkData::MakeWithCString("value");
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  StorePersistentCache(persistent_cache, *key1, *value);
+  StorePersistentCache(persistent_cache, *key2, *value);
+  persistent_cache->StoreShaderUsage();
+
+  // Only the first entry is used in the next two launches. A launch that uses
+  // no entry is not counted.
+  for (int i = 0; i < 2; i++) {
+    PersistentCache::ResetCacheForProcess();
+    persistent_cache = PersistentCache::GetCacheForProcess();
+    ASSERT_NE(persistent_cache->load(*key1), nullptr);
+    persistent_cache->StoreShaderUsage();
+    PersistentCache::ResetCacheForProcess();
+    PersistentCache::GetCacheForProcess()->StoreShaderUsage();
+  }
+
+  // The second entry was last used three launches ago. Loading it would
+  // count as a use, so the archive is checked directly.
+  PersistentCache::ResetCacheForProcess();
+  persistent_cache = PersistentCache::GetCacheForProcess();
+  persistent_cache->SetMaxUnusedLaunches(3);
+  persistent_cache->PruneUnusedShaders();
+  auto archive =
+      PersistentCacheArchive::Open(*persistent_cache->GetCacheDirectory());
+  ASSERT_NE(archive, nullptr);
+  EXPECT_EQ(archive->GetEntryCount(), 2u);
+
+  persistent_cache->SetMaxUnusedLaunches(2);
+  persistent_cache->PruneUnusedShaders();
+  archive =
+      PersistentCacheArchive::Open(*persistent_cache->GetCacheDirectory());
+  ASSERT_NE(archive, nullptr);
+  EXPECT_EQ(archive->GetEntryCount(), 1u);
+  EXPECT_EQ(persistent_cache->load(*key2), nullptr);
+  EXPECT_NE(persistent_cache->load(*key1), nullptr);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, DoesNotPrecompileSkSLsNotUsedForHalfMaxLaunches) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(true);
+
+  sk_sp<SkData> key1 = SkData::MakeWithCString("key1");
+  sk_sp<SkData> key2 = SkData::MakeWithCString("key2");
+  sk_sp<SkData> sksl = SkData::MakeWithCString("sksl");
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  StorePersistentCache(persistent_cache, *key1, *sksl);
+  StorePersistentCache(persistent_cache, *key2, *sksl);
+  persistent_cache->StoreShaderUsage();
+
+  // Only the first SkSL is used in the next two launches.
+  for (int i = 0; i < 2; i++) {
+    PersistentCache::ResetCacheForProcess();
+    persistent_cache = PersistentCache::GetCacheForProcess();
+    ASSERT_NE(persistent_cache->load(*key1), nullptr);
+    persistent_cache->StoreShaderUsage();
+  }
+
+  PersistentCache::ResetCacheForProcess();
+  persistent_cache = PersistentCache::GetCacheForProcess();
+  ASSERT_EQ(persistent_cache->LoadSkSLsToPrecompile().size(), 2u);
+  // The second SkSL was last used three launches ago.
+  persistent_cache->SetMaxUnusedLaunches(6);
+  auto sksls = persistent_cache->LoadSkSLsToPrecompile();
+  ASSERT_EQ(sksls.size(), 2u);
+  persistent_cache->SetMaxUnusedLaunches(4);
+  sksls = persistent_cache->LoadSkSLsToPrecompile();
+  ASSERT_EQ(sksls.size(), 1u);
+  EXPECT_TRUE(sksls[0].first->equals(key1.get()));
+  // All of them can still be exported.
+  EXPECT_EQ(persistent_cache->LoadSkSLs().size(), 2u);
+
+  // Cleanup
+  PersistentCache::SetCacheSkSL(false);
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, ArchiveOverwritesIncompleteRecord) {
+  fml::ScopedTemporaryDirectory dir;
+  sk_sp<SkData> key1 = SkData::MakeWithCString("key1");
+  sk_sp<SkData> key2 = SkData::MakeWithCString("key2");
+  fml::DataMapping value1(std::string("value1"));
+  fml::DataMapping value2(std::string("value2"));
+  ASSERT_EQ(PersistentCacheArchive::Open(dir.fd()), nullptr);
+  auto writer = PersistentCacheArchive::OpenForAppend(dir.fd());
+  ASSERT_NE(writer, nullptr);
+  ASSERT_TRUE(writer->Append(*key1, value1));
+  writer.reset();
+
+  // Simulate a record that was only partially written.
+  {
+    auto file = fml::OpenFile(dir.fd(), PersistentCacheArchive::kFileName,
+                              false, fml::FilePermission::kReadWrite);
+    fml::FileMapping mapping(file);
+    ASSERT_TRUE(fml::TruncateFile(file, mapping.GetSize() + 7));
+  }
+  auto archive = PersistentCacheArchive::Open(dir.fd());
+  ASSERT_NE(archive, nullptr);
+  EXPECT_EQ(archive->GetEntryCount(), 1u);
+
+  // The incomplete record is cut off, and appended records are found without
+  // opening the archive again.
+  writer = PersistentCacheArchive::OpenForAppend(dir.fd());
+  ASSERT_NE(writer, nullptr);
+  EXPECT_EQ(writer->GetEntryCount(), 1u);
+  ASSERT_TRUE(writer->Append(*key2, value2));
+  EXPECT_EQ(writer->GetEntryCount(), 2u);
+  EXPECT_NE(writer->Find(*key2), nullptr);
+  writer.reset();
+
+  archive = PersistentCacheArchive::Open(dir.fd());
+  ASSERT_NE(archive, nullptr);
+  auto entries = archive->GetEntries();
+  ASSERT_EQ(entries.size(), 2u);
+  EXPECT_TRUE(entries[0].first->equals(key1.get()));
+  EXPECT_TRUE(entries[1].first->equals(key2.get()));
+  sk_sp<SkData> loaded2 = archive->Find(*key2);
+  ASSERT_NE(loaded2, nullptr);
+  EXPECT_EQ(std::string(static_cast<const char*>(loaded2->data()),
+                        loaded2->size()),
+            "value2");
+
+  // The entries outlive the archive they were loaded from.
+  archive.reset();
+  EXPECT_EQ(loaded2->size(), value2.GetSize());
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(dir.fd());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,13 +5,16 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
-#include <deque>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
-#include <mutex>
+#include <optional>
+#include <vector>
 
+#include "flutter/flow/layers/layer_tree.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
-#include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -26,6 +29,11 @@ size_t GetNextPipelineTraceID();
 
 /// A thread-safe queue of resources for a single consumer and a single
 /// producer.
+///
+/// Resources are handed from the producer to the consumer through a lock-free
+/// ring buffer with one slot per unit of depth. Slots are reserved by
+/// |Produce| before the producer prepares a resource, so a committed resource
+/// always finds a free slot and neither side ever waits on the other.
 template <class R>
 class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
  public:
@@ -91,17 +99,37 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
   };
 
   explicit Pipeline(uint32_t depth)
-      : depth_(depth), empty_(depth), available_(0), inflight_(0) {}
+      : depth_(depth),
+        effective_depth_(depth),
+        inflight_(0),
+        slots_(depth),
+        head_(0),
+        tail_(0) {}
 
   ~Pipeline() = default;
 
-  bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
+  bool IsValid() const { return depth_ > 0; }
+
+  /// Limits the number of resources in flight to fewer than the depth the
+  /// pipeline was created with. A lower depth trades throughput for latency.
+  /// The value is clamped to [1, depth]. Resources already in flight are not
+  /// affected, the limit applies to subsequent calls to |Produce| and
+  /// |ProduceIfEmpty|.
+  void SetEffectiveDepth(uint32_t effective_depth) {
+    effective_depth_ = std::min(std::max(effective_depth, 1u), depth_);
+  }
+
+  uint32_t GetEffectiveDepth() const { return effective_depth_; }
+
+  // The number of resources that were produced and not consumed yet.
+  size_t GetInflightCount() const {
+    return inflight_.load(std::memory_order_relaxed);
+  }
 
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (!TryReserveSlot()) {
       return {};
     }
-    ++inflight_;
     FML_TRACE_COUNTER("flutter", "Pipeline Depth",
                       reinterpret_cast<int64_t>(this),      //
                       "frames in flight", inflight_.load()  //
@@ -117,11 +145,13 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
   // is empty.
   // Prefer using |Produce|. ProducerContinuation returned by this method
   // doesn't guarantee that the frame will be rendered.
+  // This method and the returned continuation must only be used on the
+  // consumer thread, the resource is consumed before any resource committed by
+  // the producer afterwards.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (!TryReserveSlot()) {
       return {};
     }
-    ++inflight_;
     FML_TRACE_COUNTER("flutter", "Pipeline Depth",
                       reinterpret_cast<int64_t>(this),      //
                       "frames in flight", inflight_.load()  //
@@ -141,19 +171,23 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
       return PipelineConsumeResult::NoneAvailable;
     }
 
-    if (!available_.TryWait()) {
-      return PipelineConsumeResult::NoneAvailable;
-    }
-
     ResourcePtr resource;
     size_t trace_id = 0;
-    size_t items_count = 0;
-
-    {
-      std::scoped_lock lock(queue_mutex_);
-      std::tie(resource, trace_id) = std::move(queue_.front());
-      queue_.pop_front();
-      items_count = queue_.size();
+    bool more_available = false;
+
+    if (front_.has_value()) {
+      std::tie(resource, trace_id) = std::move(*front_);
+      front_.reset();
+      more_available = !IsRingEmpty();
+    } else {
+      const size_t head = head_.load(std::memory_order_relaxed);
+      const size_t tail = tail_.load(std::memory_order_acquire);
+      if (head == tail) {
+        return PipelineConsumeResult::NoneAvailable;
+      }
+      std::tie(resource, trace_id) = std::move(slots_[head % depth_]);
+      head_.store(head + 1, std::memory_order_release);
+      more_available = head + 1 != tail_.load(std::memory_order_acquire);
     }
 
     {
@@ -161,55 +195,114 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
       consumer(std::move(resource));
     }
 
-    empty_.Signal();
-    --inflight_;
+    // Releases the slot. The moved-from ring slot may only be reused by the
+    // producer after it observes the decrement.
+    inflight_.fetch_sub(1, std::memory_order_acq_rel);
 
     TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
     TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", trace_id);
 
-    return items_count > 0 ? PipelineConsumeResult::MoreAvailable
-                           : PipelineConsumeResult::Done;
+    return more_available ? PipelineConsumeResult::MoreAvailable
+                          : PipelineConsumeResult::Done;
+  }
+
+  /// Like |Consume|, but first drops every committed resource except the
+  /// newest one, handing each dropped resource to |on_dropped| in order. A
+  /// resource committed by |ProduceIfEmpty| is never dropped, as it is
+  /// consumed before the others anyway.
+  [[nodiscard]] PipelineConsumeResult ConsumeLatest(
+      const Consumer& consumer,
+      const Consumer& on_dropped) {
+    if (consumer == nullptr) {
+      return PipelineConsumeResult::NoneAvailable;
+    }
+
+    if (!front_.has_value()) {
+      while (true) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head + 1 >= tail_.load(std::memory_order_acquire)) {
+          break;
+        }
+        auto [resource, trace_id] = std::move(slots_[head % depth_]);
+        head_.store(head + 1, std::memory_order_release);
+        {
+          TRACE_EVENT0("flutter", "PipelineDrop");
+          if (on_dropped) {
+            on_dropped(std::move(resource));
+          }
+        }
+        inflight_.fetch_sub(1, std::memory_order_acq_rel);
+        TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
+        TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", trace_id);
+      }
+    }
+
+    return Consume(consumer);
   }
 
  private:
+  using Slot = std::pair<ResourcePtr, size_t>;
+
   const uint32_t depth_;
-  fml::Semaphore empty_;
-  fml::Semaphore available_;
+  std::atomic<uint32_t> effective_depth_;
+  // The number of reserved slots, including the ones whose resource is still
+  // being prepared. Never exceeds |depth_|, so the ring cannot overflow.
   std::atomic<int> inflight_;
-  std::mutex queue_mutex_;
-  std::deque<std::pair<ResourcePtr, size_t>> queue_;
+  std::vector<Slot> slots_;
+  // The index of the next slot to consume. Written by the consumer only.
+  std::atomic<size_t> head_;
+  // The index of the next slot to commit to. Written by the producer only.
+  std::atomic<size_t> tail_;
+  // A resource committed by |ProduceIfEmpty|. Only accessed on the consumer
+  // thread.
+  std::optional<Slot> front_;
+
+  bool TryReserveSlot() {
+    const int limit = static_cast<int>(effective_depth_.load());
+    int inflight = inflight_.load(std::memory_order_relaxed);
+    do {
+      if (inflight >= limit) {
+        return false;
+      }
+    } while (!inflight_.compare_exchange_weak(inflight, inflight + 1,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed));
+    return true;
+  }
 
-  bool ProducerCommit(ResourcePtr resource, size_t trace_id) {
-    {
-      std::scoped_lock lock(queue_mutex_);
-      queue_.emplace_back(std::move(resource), trace_id);
-    }
+  bool IsRingEmpty() const {
+    return head_.load(std::memory_order_relaxed) ==
+           tail_.load(std::memory_order_acquire);
+  }
 
-    // Ensure the queue mutex is not held as that would be a pessimization.
-    available_.Signal();
+  bool ProducerCommit(ResourcePtr resource, size_t trace_id) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    slots_[tail % depth_] = {std::move(resource), trace_id};
+    tail_.store(tail + 1, std::memory_order_release);
     return true;
   }
 
   bool ProducerCommitIfEmpty(ResourcePtr resource, size_t trace_id) {
-    {
-      std::scoped_lock lock(queue_mutex_);
-      if (!queue_.empty()) {
-        // Bail if the queue is not empty, opens up spaces to produce other
-        // frames.
-        empty_.Signal();
-        return false;
-      }
-      queue_.emplace_back(std::move(resource), trace_id);
+    if (front_.has_value() || !IsRingEmpty()) {
+      // Bail if the queue is not empty, opens up spaces to produce other
+      // frames.
+      inflight_.fetch_sub(1, std::memory_order_acq_rel);
+      return false;
     }
-
-    // Ensure the queue mutex is not held as that would be a pessimization.
-    available_.Signal();
+    front_.emplace(std::move(resource), trace_id);
     return true;
   }
 
   FML_DISALLOW_COPY_AND_ASSIGN(Pipeline);
 };
 
+/// The layer trees of all the views that were rendered in one frame.
+struct FrameItem {
+  std::vector<std::unique_ptr<LayerTree>> layer_trees;
+};
+
+using FramePipeline = Pipeline<FrameItem>;
+
 }  // namespace flutter
 
 #endif  // FLUTTER_SHELL_COMMON_PIPELINE_H_
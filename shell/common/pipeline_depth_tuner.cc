@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline_depth_tuner.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+namespace {
+
+// The weight of the latest frame in the moving averages of the build and
+// raster times.
+constexpr double kAverageWeight = 0.2;
+
+// The number of frames to observe before the depth is changed at all.
+constexpr size_t kWarmUpFrameCount = 10;
+
+// Switching to the low latency depth requires building and rasterizing to fit
+// in this fraction of the frame budget, which leaves room for variance.
+constexpr double kLowLatencyBudgetFraction = 0.8;
+
+// The number of consecutive frames that have to fit in the budget before the
+// depth is lowered. Raising it again happens on the first frame that doesn't
+// fit, since that frame is already late.
+constexpr size_t kLowLatencyFrameCount = 30;
+
+fml::TimeDelta Average(fml::TimeDelta average,
+                       fml::TimeDelta sample,
+                       size_t sample_count) {
+  if (sample_count == 0) {
+    return sample;
+  }
+  return fml::TimeDelta::FromNanoseconds(
+      average.ToNanosecondsF() * (1.0 - kAverageWeight) +
+      sample.ToNanosecondsF() * kAverageWeight);
+}
+
+}  // namespace
+
+PipelineDepthTuner::PipelineDepthTuner(uint32_t max_depth)
+    : max_depth_(std::max<uint32_t>(max_depth, 1u)),
+      recommended_depth_(max_depth_) {}
+
+PipelineDepthTuner::~PipelineDepthTuner() = default;
+
+void PipelineDepthTuner::AddFrameTiming(const FrameTiming& timing,
+                                        fml::Milliseconds frame_budget) {
+  const fml::TimeDelta build_time = timing.Get(FrameTiming::kBuildFinish) -
+                                    timing.Get(FrameTiming::kBuildStart);
+  const fml::TimeDelta raster_time = timing.Get(FrameTiming::kRasterFinish) -
+                                     timing.Get(FrameTiming::kRasterStart);
+  average_build_time_ = Average(average_build_time_, build_time, frame_count_);
+  average_raster_time_ =
+      Average(average_raster_time_, raster_time, frame_count_);
+  frame_count_++;
+
+  if (frame_count_ < kWarmUpFrameCount) {
+    return;
+  }
+
+  // Both the latest frame and the averages have to fit so that a single slow
+  // frame, as well as a slow trend, goes back to the deeper pipeline.
+  const fml::TimeDelta low_latency_budget = fml::TimeDelta::FromMillisecondsF(
+      frame_budget.count() * kLowLatencyBudgetFraction);
+  const bool fits_in_budget =
+      build_time + raster_time <= low_latency_budget &&
+      average_build_time_ + average_raster_time_ <= low_latency_budget;
+
+  if (!fits_in_budget) {
+    frames_within_budget_ = 0;
+    recommended_depth_ = max_depth_;
+    return;
+  }
+
+  frames_within_budget_++;
+  if (frames_within_budget_ >= kLowLatencyFrameCount) {
+    recommended_depth_ = 1;
+  }
+}
+
+uint32_t PipelineDepthTuner::GetRecommendedDepth() const {
+  return recommended_depth_;
+}
+
+}  // namespace flutter
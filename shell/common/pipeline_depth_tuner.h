@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_TUNER_H_
+#define FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_TUNER_H_
+
+#include <atomic>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Picks the depth of the layer tree pipeline based on the observed build and
+/// raster times of recent frames.
+///
+/// With a depth of 1 the UI thread only starts building a frame once the
+/// previous one has been rasterized, which minimizes input-to-photon latency.
+/// That only works without dropping frames if building and rasterizing a frame
+/// together fit in the frame budget. Otherwise a depth of 2 lets the UI thread
+/// build the next frame while the raster thread is still busy with the
+/// current one, which favors throughput.
+///
+/// Frame timings are reported on the raster thread, the recommended depth may
+/// be read from any thread.
+///
+class PipelineDepthTuner {
+ public:
+  explicit PipelineDepthTuner(uint32_t max_depth);
+
+  ~PipelineDepthTuner();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timing of a rasterized frame and updates the
+  ///             recommended depth.
+  ///
+  /// @param[in]  timing        The timing of the frame.
+  /// @param[in]  frame_budget  The time available for a single frame at the
+  ///                           current refresh rate.
+  ///
+  void AddFrameTiming(const FrameTiming& timing, fml::Milliseconds frame_budget);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The pipeline depth that should be used for the next frame.
+  ///             This is the maximum depth until enough frames have been
+  ///             observed.
+  ///
+  uint32_t GetRecommendedDepth() const;
+
+ private:
+  const uint32_t max_depth_;
+  std::atomic<uint32_t> recommended_depth_;
+
+  // Only accessed on the raster thread.
+  fml::TimeDelta average_build_time_;
+  fml::TimeDelta average_raster_time_;
+  size_t frame_count_ = 0;
+  size_t frames_within_budget_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineDepthTuner);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_TUNER_H_
@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline_depth_tuner.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::Milliseconds kFrameBudget{16};
+
+FrameTiming CreateFrameTiming(int64_t build_ms, int64_t raster_ms) {
+  FrameTiming timing;
+  fml::TimePoint start = fml::TimePoint::Now();
+  timing.Set(FrameTiming::kVsyncStart, start);
+  timing.Set(FrameTiming::kBuildStart, start);
+  fml::TimePoint build_finish =
+      timing.Set(FrameTiming::kBuildFinish,
+                 start + fml::TimeDelta::FromMilliseconds(build_ms));
+  timing.Set(FrameTiming::kRasterStart, build_finish);
+  timing.Set(FrameTiming::kRasterFinish,
+             build_finish + fml::TimeDelta::FromMilliseconds(raster_ms));
+  return timing;
+}
+
+void AddFrames(PipelineDepthTuner& tuner,
+               size_t count,
+               int64_t build_ms,
+               int64_t raster_ms) {
+  for (size_t i = 0; i < count; i++) {
+    tuner.AddFrameTiming(CreateFrameTiming(build_ms, raster_ms), kFrameBudget);
+  }
+}
+
+}  // namespace
+
+TEST(PipelineDepthTunerTest, StartsAtMaxDepth) {
+  PipelineDepthTuner tuner(2);
+  ASSERT_EQ(tuner.GetRecommendedDepth(), 2u);
+}
+
+TEST(PipelineDepthTunerTest, LowersDepthWhenFramesFitInBudget) {
+  PipelineDepthTuner tuner(2);
+  AddFrames(tuner, 10, 2, 3);
+  ASSERT_EQ(tuner.GetRecommendedDepth(), 2u);
+  AddFrames(tuner, 100, 2, 3);
+  ASSERT_EQ(tuner.GetRecommendedDepth(), 1u);
+}
+
+TEST(PipelineDepthTunerTest, KeepsMaxDepthWhenFramesDoNotFitInBudget) {
+  PipelineDepthTuner tuner(2);
+  // Each phase fits in the budget on its own, but not both together.
+  AddFrames(tuner, 100, 8, 8);
+  ASSERT_EQ(tuner.GetRecommendedDepth(), 2u);
+}
+
+TEST(PipelineDepthTunerTest, RaisesDepthOnSlowFrame) {
+  PipelineDepthTuner tuner(2);
+  AddFrames(tuner, 100, 2, 3);
+  ASSERT_EQ(tuner.GetRecommendedDepth(), 1u);
+
+  AddFrames(tuner, 1, 10, 10);
+  ASSERT_EQ(tuner.GetRecommendedDepth(), 2u);
+
+  // The average recovers quickly, but the depth is only lowered again after
+  // another run of frames that fit.
+  AddFrames(tuner, 5, 2, 3);
+  ASSERT_EQ(tuner.GetRecommendedDepth(), 2u);
+  AddFrames(tuner, 100, 2, 3);
+  ASSERT_EQ(tuner.GetRecommendedDepth(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -9,6 +9,8 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -76,6 +78,37 @@ TEST(PipelineTest, PushingMoreThanDepthCompletesFirstSubmission) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, EffectiveDepthLimitsProducedContinuations) {
+  fml::RefPtr<IntPipeline> pipeline = fml::MakeRefCounted<IntPipeline>(2);
+  pipeline->SetEffectiveDepth(1);
+  ASSERT_EQ(pipeline->GetEffectiveDepth(), 1u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_FALSE(continuation_2);
+
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+  PipelineConsumeResult consume_result =
+      pipeline->Consume([](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+
+  Continuation continuation_3 = pipeline->Produce();
+  ASSERT_TRUE(continuation_3);
+
+  pipeline->SetEffectiveDepth(2);
+  Continuation continuation_4 = pipeline->Produce();
+  ASSERT_TRUE(continuation_4);
+}
+
+TEST(PipelineTest, EffectiveDepthIsClamped) {
+  fml::RefPtr<IntPipeline> pipeline = fml::MakeRefCounted<IntPipeline>(2);
+  pipeline->SetEffectiveDepth(0);
+  ASSERT_EQ(pipeline->GetEffectiveDepth(), 1u);
+  pipeline->SetEffectiveDepth(3);
+  ASSERT_EQ(pipeline->GetEffectiveDepth(), 2u);
+}
+
 TEST(PipelineTest, PushingMultiProcessesInOrder) {
   const int depth = 2;
   fml::RefPtr<IntPipeline> pipeline = fml::MakeRefCounted<IntPipeline>(depth);
@@ -131,5 +164,101 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, ProduceIfEmptyIsConsumedBeforeLaterResources) {
+  const int depth = 2;
+  fml::RefPtr<IntPipeline> pipeline = fml::MakeRefCounted<IntPipeline>(depth);
+
+  Continuation continuation_1 = pipeline->ProduceIfEmpty();
+  bool result = continuation_1.Complete(std::make_unique<int>(1));
+  ASSERT_EQ(result, true);
+
+  Continuation continuation_2 = pipeline->Produce();
+  result = continuation_2.Complete(std::make_unique<int>(2));
+  ASSERT_EQ(result, true);
+
+  PipelineConsumeResult consume_result_1 = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); });
+  ASSERT_EQ(consume_result_1, PipelineConsumeResult::MoreAvailable);
+
+  PipelineConsumeResult consume_result_2 = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 2); });
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
+}
+
+TEST(PipelineTest, ConcurrentProduceAndConsumePreservesOrder) {
+  const int depth = 2;
+  const int count = 10000;
+  fml::RefPtr<IntPipeline> pipeline = fml::MakeRefCounted<IntPipeline>(depth);
+
+  std::thread producer([&pipeline]() {
+    for (int i = 0; i < count;) {
+      Continuation continuation = pipeline->Produce();
+      if (!continuation) {
+        std::this_thread::yield();
+        continue;
+      }
+      ASSERT_TRUE(continuation.Complete(std::make_unique<int>(i++)));
+    }
+  });
+
+  int expected = 0;
+  while (expected < count) {
+    PipelineConsumeResult consume_result =
+        pipeline->Consume([&expected](std::unique_ptr<int> v) {
+          ASSERT_EQ(*v, expected);
+          expected++;
+        });
+    if (consume_result == PipelineConsumeResult::NoneAvailable) {
+      std::this_thread::yield();
+    }
+  }
+
+  producer.join();
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) { FAIL(); }),
+            PipelineConsumeResult::NoneAvailable);
+}
+
+TEST(PipelineTest, ConsumeLatestDropsOlderResources) {
+  const int depth = 3;
+  fml::RefPtr<IntPipeline> pipeline = fml::MakeRefCounted<IntPipeline>(depth);
+
+  for (int i = 1; i <= depth; i++) {
+    Continuation continuation = pipeline->Produce();
+    ASSERT_TRUE(continuation.Complete(std::make_unique<int>(i)));
+  }
+
+  std::vector<int> dropped;
+  PipelineConsumeResult consume_result = pipeline->ConsumeLatest(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 3); },
+      [&dropped](std::unique_ptr<int> v) { dropped.push_back(*v); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+  ASSERT_EQ(dropped, std::vector<int>({1, 2}));
+  ASSERT_EQ(pipeline->GetInflightCount(), 0u);
+
+  // The dropped slots can be produced into again.
+  for (int i = 4; i < 4 + depth; i++) {
+    Continuation continuation = pipeline->Produce();
+    ASSERT_TRUE(continuation.Complete(std::make_unique<int>(i)));
+  }
+  PipelineConsumeResult consume_result_2 = pipeline->ConsumeLatest(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 6); }, nullptr);
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
+}
+
+TEST(PipelineTest, ConsumeLatestKeepsResourceProducedIfEmpty) {
+  const int depth = 2;
+  fml::RefPtr<IntPipeline> pipeline = fml::MakeRefCounted<IntPipeline>(depth);
+
+  Continuation continuation_1 = pipeline->ProduceIfEmpty();
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)));
+
+  PipelineConsumeResult consume_result = pipeline->ConsumeLatest(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); },
+      [](std::unique_ptr<int> v) { FAIL(); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -36,6 +36,11 @@ void PlatformView::DispatchPlatformMessage(
   delegate_.OnPlatformViewDispatchPlatformMessage(std::move(message));
 }
 
+void PlatformView::DispatchPlatformMessages(
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  delegate_.OnPlatformViewDispatchPlatformMessages(std::move(messages));
+}
+
 void PlatformView::DispatchPointerDataPacket(
     std::unique_ptr<PointerDataPacket> packet) {
   delegate_.OnPlatformViewDispatchPointerDataPacket(
@@ -108,6 +113,16 @@ PointerDataDispatcherMaker PlatformView::GetDispatcherMaker() {
   };
 }
 
+std::shared_ptr<ImageDecoderBackend>
+PlatformView::CreateImageDecoderBackend() {
+  return nullptr;
+}
+
+std::shared_ptr<ImageEncoderBackend>
+PlatformView::CreateImageEncoderBackend() {
+  return nullptr;
+}
+
 fml::WeakPtr<PlatformView> PlatformView::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
@@ -115,6 +130,8 @@ fml::WeakPtr<PlatformView> PlatformView::GetWeakPtr() const {
 void PlatformView::UpdateSemantics(SemanticsNodeUpdates update,
                                    CustomAccessibilityActionUpdates actions) {}
 
+void PlatformView::SetFrameRateRange(const FrameRateRange& range) {}
+
 void PlatformView::HandlePlatformMessage(fml::RefPtr<PlatformMessage> message) {
   if (auto response = message->response())
     response->CompleteEmpty();
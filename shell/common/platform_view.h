@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "flow/embedded_views.h"
 #include "flutter/common/graphics/texture.h"
@@ -15,6 +16,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/window/key_data_packet.h"
@@ -116,6 +118,18 @@ class PlatformView {
     virtual void OnPlatformViewDispatchPlatformMessage(
         fml::RefPtr<PlatformMessage> message) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate that the platform has dispatched a
+    ///             batch of platform messages from the embedder to the Flutter
+    ///             application. The messages must be forwarded to the running
+    ///             isolate in order and together on the UI thread.
+    ///
+    /// @param[in]  messages  The platform messages to dispatch to the running
+    ///                       root isolate.
+    ///
+    virtual void OnPlatformViewDispatchPlatformMessages(
+        std::vector<fml::RefPtr<PlatformMessage>> messages) = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Notifies the delegate that the platform view has encountered
     ///             a pointer event. This pointer event needs to be forwarded to
@@ -381,6 +395,21 @@ class PlatformView {
   ///
   void DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to dispatch a batch of platform messages to
+  ///             a running root isolate hosted by the engine. This behaves like
+  ///             calling `DispatchPlatformMessage` for each message in order,
+  ///             but the messages are delivered in a single task on the UI
+  ///             task runner instead of one task per message.
+  ///
+  /// @see        DispatchPlatformMessage()
+  ///
+  /// @param[in]  messages  The platform messages to deliver to the root
+  ///                       isolate.
+  ///
+  void DispatchPlatformMessages(
+      std::vector<fml::RefPtr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Overridden by embedders to perform actions in response to
   ///             platform messages sent from the framework to the embedder.
@@ -459,6 +488,18 @@ class PlatformView {
   virtual void UpdateSemantics(SemanticsNodeUpdates updates,
                                CustomAccessibilityActionUpdates actions);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the shell to tell the embedder the range of frame
+  ///             rates the framework asks its frames to be shown at, so that
+  ///             platforms with variable refresh rate displays can switch the
+  ///             display to a matching rate. Called on the platform thread.
+  ///             The default implementation of this method does nothing.
+  ///
+  /// @param[in]  range  The requested range, which is unspecified when the
+  ///                    framework no longer has a preference.
+  ///
+  virtual void SetFrameRateRange(const FrameRateRange& range);
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to specify the updated viewport metrics. In
   ///             response to this call, on the raster thread, the rasterizer
@@ -537,6 +578,29 @@ class PlatformView {
   ///             on platforms.
   virtual PointerDataDispatcherMaker GetDispatcherMaker();
 
+  //--------------------------------------------------------------------------
+  /// @brief      Returns a platform-specific image decoder backend that the
+  ///             image decoder of the `Engine` tries before the Skia software
+  ///             codecs, e.g. to decode with the hardware decoders of the
+  ///             platform. The backend is called on the worker threads of the
+  ///             image decoder.
+  ///
+  /// @return     The image decoder backend, or `nullptr` to only decode images
+  ///             with the Skia codecs, which is the default.
+  ///
+  virtual std::shared_ptr<ImageDecoderBackend> CreateImageDecoderBackend();
+
+  //--------------------------------------------------------------------------
+  /// @brief      Returns a platform-specific image encoder backend that
+  ///             `Image.toByteData` tries before the Skia encoders, e.g. to
+  ///             encode with the hardware encoders of the platform. The
+  ///             backend is called on the worker threads of the engine.
+  ///
+  /// @return     The image encoder backend, or `nullptr` to only encode images
+  ///             with the Skia encoders, which is the default.
+  ///
+  virtual std::shared_ptr<ImageEncoderBackend> CreateImageEncoderBackend();
+
   //----------------------------------------------------------------------------
   /// @brief      Returns a weak pointer to the platform view. Since the
   ///             platform view may only be created, accessed and destroyed
@@ -4,6 +4,9 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -68,4 +71,143 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+ResamplingPointerDataDispatcher::ResamplingPointerDataDispatcher(
+    Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+ResamplingPointerDataDispatcher::~ResamplingPointerDataDispatcher() = default;
+
+void ResamplingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "ResamplingPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  const std::vector<uint8_t>& bytes = packet->data();
+  const size_t count = bytes.size() / sizeof(PointerData);
+  if (count == 0) {
+    return;
+  }
+  const bool was_empty = pending_data_.empty();
+  const size_t offset = pending_data_.size();
+  pending_data_.resize(offset + count);
+  ::memcpy(pending_data_.data() + offset, bytes.data(),
+           count * sizeof(PointerData));
+  if (!was_empty) {
+    return;
+  }
+  pending_trace_flow_id_ = trace_flow_id;
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->DispatchPendingData();
+        }
+      });
+}
+
+void ResamplingPointerDataDispatcher::DispatchPendingData() {
+  TRACE_EVENT0("flutter",
+               "ResamplingPointerDataDispatcher::DispatchPendingData");
+  // The index in |coalesced| of the move of each pointer that its following
+  // moves are coalesced into.
+  std::unordered_map<int64_t, size_t> last_moves;
+  std::vector<PointerData> coalesced;
+  coalesced.reserve(pending_data_.size());
+  for (const PointerData& data : pending_data_) {
+    const bool is_move = data.signal_kind == PointerData::SignalKind::kNone &&
+                         (data.change == PointerData::Change::kMove ||
+                          data.change == PointerData::Change::kHover);
+    if (!is_move) {
+      samples_.erase(data.device);
+      resampled_offsets_.erase(data.device);
+      last_moves.erase(data.device);
+      coalesced.push_back(data);
+      continue;
+    }
+
+    PointerSamples& samples = samples_[data.device];
+    if (samples.count > 0 && samples.last.change != data.change) {
+      samples.count = 0;
+    }
+    samples.previous = samples.last;
+    samples.last = data;
+    samples.count = std::min<size_t>(samples.count + 1, 2);
+
+    auto last_move = last_moves.find(data.device);
+    if (last_move != last_moves.end() &&
+        coalesced[last_move->second].change == data.change) {
+      PointerData& move = coalesced[last_move->second];
+      const double delta_x = move.physical_delta_x + data.physical_delta_x;
+      const double delta_y = move.physical_delta_y + data.physical_delta_y;
+      move = data;
+      move.physical_delta_x = delta_x;
+      move.physical_delta_y = delta_y;
+    } else {
+      last_moves[data.device] = coalesced.size();
+      coalesced.push_back(data);
+      auto offset = resampled_offsets_.find(data.device);
+      if (offset != resampled_offsets_.end()) {
+        coalesced.back().physical_delta_x -= offset->second.x;
+        coalesced.back().physical_delta_y -= offset->second.y;
+        resampled_offsets_.erase(offset);
+      }
+    }
+  }
+  pending_data_.clear();
+
+  // The moves in |last_moves| are the last events of their pointers. Those
+  // are the only ones that are resampled, as the events that follow the other
+  // moves are dispatched at their actual positions.
+  const fml::TimePoint target_time = delegate_.GetLastVsyncTargetTime();
+  for (const auto& [device, index] : last_moves) {
+    const Offset offset = Resample(coalesced[index], target_time);
+    if (offset.x != 0 || offset.y != 0) {
+      resampled_offsets_[device] = offset;
+    }
+  }
+
+  auto packet = std::make_unique<PointerDataPacket>(coalesced.size());
+  for (size_t i = 0; i < coalesced.size(); i++) {
+    packet->SetPointerData(i, coalesced[i]);
+  }
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               pending_trace_flow_id_);
+}
+
+ResamplingPointerDataDispatcher::Offset
+ResamplingPointerDataDispatcher::Resample(
+    PointerData& data,
+    fml::TimePoint target_time) const {
+  auto found = samples_.find(data.device);
+  if (found == samples_.end() || found->second.count < 2) {
+    return {};
+  }
+  const PointerData& previous = found->second.previous;
+  const PointerData& last = found->second.last;
+  const int64_t interval = last.time_stamp - previous.time_stamp;
+  const int64_t target = target_time.ToEpochDelta().ToMicroseconds();
+  const int64_t max_prediction = kMaxPrediction.ToMicroseconds();
+  // The time stamps of some platforms are not on the clock of the vsync, in
+  // which case they are too far from the target time to be resampled.
+  if (interval <= 0 || target <= previous.time_stamp ||
+      target - last.time_stamp > max_prediction * 4) {
+    return {};
+  }
+  const int64_t time_stamp =
+      std::min<int64_t>(target, last.time_stamp + max_prediction);
+  const double t =
+      static_cast<double>(time_stamp - previous.time_stamp) / interval;
+  const double x =
+      previous.physical_x + (last.physical_x - previous.physical_x) * t;
+  const double y =
+      previous.physical_y + (last.physical_y - previous.physical_y) * t;
+  const Offset offset = {x - data.physical_x, y - data.physical_y};
+  data.physical_delta_x += offset.x;
+  data.physical_delta_y += offset.y;
+  data.physical_x = x;
+  data.physical_y = y;
+  data.time_stamp = time_stamp;
+  return offset;
+}
+
 }  // namespace flutter
@@ -5,6 +5,9 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include <unordered_map>
+#include <vector>
+
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -64,6 +67,12 @@ class PointerDataDispatcher {
     virtual void ScheduleSecondaryVsyncCallback(
         uintptr_t id,
         const fml::closure& callback) = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief    The time by which the frame of the last vsync is meant to be
+    ///           displayed. Read from a secondary vsync callback, this is the
+    ///           target time of the frame that the callback runs for.
+    virtual fml::TimePoint GetLastVsyncTargetTime() = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -164,6 +173,65 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that holds the pointer data it receives until the next vsync,
+/// and then dispatches all of it in one packet in which the moves of each
+/// pointer are coalesced.
+///
+/// The consecutive moves, or hovers, of a pointer are replaced by the last of
+/// them, which carries the deltas of all of them. Downs, ups, scrolls and the
+/// other events are kept, in order. The last move of each pointer is then
+/// resampled to the target time of the frame: it is interpolated between its
+/// last two samples if the target time falls between them, or predicted from
+/// their velocity, by at most `kMaxPrediction`, if the target time is past the
+/// last sample.
+///
+/// The full history of every pointer is dispatched when this dispatcher is
+/// not used, which is the default. See `Settings::resample_pointer_events`.
+class ResamplingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  /// How far past the last sample of a pointer its position is predicted.
+  static constexpr fml::TimeDelta kMaxPrediction =
+      fml::TimeDelta::FromMilliseconds(8);
+
+  explicit ResamplingPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~ResamplingPointerDataDispatcher();
+
+ private:
+  // The last two moves of a pointer, which its velocity is computed from.
+  struct PointerSamples {
+    PointerData previous = {};
+    PointerData last = {};
+    size_t count = 0;
+  };
+
+  struct Offset {
+    double x = 0;
+    double y = 0;
+  };
+
+  std::vector<PointerData> pending_data_;
+  uint64_t pending_trace_flow_id_ = 0;
+  std::unordered_map<int64_t, PointerSamples> samples_;
+  // How far each resampled pointer was moved from its last sample, which the
+  // delta of its next move is corrected by.
+  std::unordered_map<int64_t, Offset> resampled_offsets_;
+
+  fml::WeakPtrFactory<ResamplingPointerDataDispatcher> weak_factory_;
+
+  void DispatchPendingData();
+
+  // Moves |data| to |target_time|, and returns how far it was moved.
+  Offset Resample(PointerData& data, fml::TimePoint target_time) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResamplingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
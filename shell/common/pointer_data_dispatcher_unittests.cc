@@ -0,0 +1,148 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    const std::vector<uint8_t>& bytes = packet->data();
+    dispatched.resize(bytes.size() / sizeof(PointerData));
+    ::memcpy(dispatched.data(), bytes.data(), bytes.size());
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  fml::TimePoint GetLastVsyncTargetTime() override { return target_time; }
+
+  // Runs the scheduled vsync callback for a frame that targets |time|, in
+  // microseconds.
+  void FireVsync(int64_t time) {
+    target_time =
+        fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromMicroseconds(time));
+    ASSERT_TRUE(vsync_callback);
+    fml::closure callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    callback();
+  }
+
+  std::vector<PointerData> dispatched;
+  fml::closure vsync_callback;
+  fml::TimePoint target_time;
+};
+
+PointerData CreatePointerData(PointerData::Change change,
+                              int64_t time_stamp,
+                              double x,
+                              double delta_x) {
+  PointerData data;
+  data.Clear();
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.time_stamp = time_stamp;
+  data.physical_x = x;
+  data.physical_delta_x = delta_x;
+  return data;
+}
+
+std::unique_ptr<PointerDataPacket> CreatePacket(
+    const std::vector<PointerData>& data) {
+  auto packet = std::make_unique<PointerDataPacket>(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    packet->SetPointerData(i, data[i]);
+  }
+  return packet;
+}
+
+}  // namespace
+
+TEST(ResamplingPointerDataDispatcherTest, CoalescesMovesBetweenOtherEvents) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+  using Change = PointerData::Change;
+  dispatcher.DispatchPacket(
+      CreatePacket({CreatePointerData(Change::kDown, 0, 0, 0),
+                    CreatePointerData(Change::kMove, 1000, 1, 1)}),
+      0);
+  dispatcher.DispatchPacket(
+      CreatePacket({CreatePointerData(Change::kMove, 2000, 2, 1),
+                    CreatePointerData(Change::kMove, 3000, 3, 1),
+                    CreatePointerData(Change::kUp, 4000, 3, 0)}),
+      0);
+  EXPECT_TRUE(delegate.dispatched.empty());
+
+  delegate.FireVsync(5000);
+  ASSERT_EQ(delegate.dispatched.size(), 3u);
+  EXPECT_EQ(delegate.dispatched[0].change, Change::kDown);
+  EXPECT_EQ(delegate.dispatched[1].change, Change::kMove);
+  EXPECT_EQ(delegate.dispatched[1].time_stamp, 3000);
+  EXPECT_EQ(delegate.dispatched[1].physical_x, 3);
+  EXPECT_EQ(delegate.dispatched[1].physical_delta_x, 3);
+  EXPECT_EQ(delegate.dispatched[2].change, Change::kUp);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, ResamplesTheLastMoveToTheFrame) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+  using Change = PointerData::Change;
+
+  // The target time is between the last two samples.
+  dispatcher.DispatchPacket(
+      CreatePacket({CreatePointerData(Change::kHover, 10000, 10, 10),
+                    CreatePointerData(Change::kHover, 20000, 20, 10)}),
+      0);
+  delegate.FireVsync(15000);
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  EXPECT_EQ(delegate.dispatched[0].time_stamp, 15000);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[0].physical_x, 15);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[0].physical_delta_x, 15);
+
+  // The target time is past the last sample, so its position is predicted.
+  // The delta is relative to the position that was dispatched last.
+  dispatcher.DispatchPacket(
+      CreatePacket({CreatePointerData(Change::kHover, 30000, 30, 10)}), 0);
+  delegate.FireVsync(34000);
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  EXPECT_EQ(delegate.dispatched[0].time_stamp, 34000);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[0].physical_x, 34);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[0].physical_delta_x, 19);
+
+  // The prediction is limited.
+  dispatcher.DispatchPacket(
+      CreatePacket({CreatePointerData(Change::kHover, 40000, 40, 10)}), 0);
+  delegate.FireVsync(60000);
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  EXPECT_EQ(delegate.dispatched[0].time_stamp, 48000);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[0].physical_x, 48);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[0].physical_delta_x, 14);
+
+  // Time stamps too far from the target time are not resampled.
+  dispatcher.DispatchPacket(
+      CreatePacket({CreatePointerData(Change::kHover, 50000, 50, 10)}), 0);
+  delegate.FireVsync(1000000);
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  EXPECT_EQ(delegate.dispatched[0].time_stamp, 50000);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[0].physical_x, 50);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[0].physical_delta_x, 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
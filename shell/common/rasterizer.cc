@@ -5,11 +5,16 @@
 #include "flutter/shell/common/rasterizer.h"
 
 #include <algorithm>
+#include <iterator>
+#include <map>
 #include <utility>
 
+#include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/fml/memory/allocation_tags.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/runtime/skia_concurrent_executor.h"
 #include "flutter/shell/common/serialization_callbacks.h"
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
 #include "third_party/skia/include/core/SkImageEncoder.h"
@@ -37,6 +42,9 @@ namespace flutter {
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+// The most snapshots that wait to be drawn before they are drawn right away.
+static constexpr size_t kMaxPendingSnapshots = 8;
+
 Rasterizer::Rasterizer(Delegate& delegate)
     : delegate_(delegate),
       compositor_context_(std::make_unique<flutter::CompositorContext>(
@@ -59,7 +67,22 @@ Rasterizer::Rasterizer(
 }
 #endif
 
-Rasterizer::~Rasterizer() = default;
+Rasterizer::~Rasterizer() {
+  // The frames still presenting may use the surface.
+  WaitForPresentsInFlight(0);
+  for (size_t i = 0; i < additional_view_ids_.size(); i++) {
+    compositor_context_->raster_cache().RemoveUser();
+  }
+  // The callbacks of the snapshots that were never drawn own state that must
+  // be released on the threads that requested them.
+  for (PendingSnapshot& snapshot : pending_snapshots_) {
+    snapshot.callback(nullptr);
+  }
+  for (const std::shared_ptr<AsyncReadback>& readback : async_readbacks_) {
+    readback->callback(nullptr);
+  }
+  FailPendingScreenshots();
+}
 
 fml::TaskRunnerAffineWeakPtr<Rasterizer> Rasterizer::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
@@ -77,6 +100,9 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
                              user_override_resource_cache_bytes_);
   }
   compositor_context_->OnGrContextCreated();
+  compositor_context_->raster_cache().RestoreWarmState(
+      raster_cache_warm_state_);
+  raster_cache_warm_state_ = {};
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
       !raster_thread_merger_) {
@@ -98,8 +124,31 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
 }
 
 void Rasterizer::Teardown() {
+  WaitForPresentsInFlight(0);
+  // No frame is drawn until the next surface, which may never come.
+  FailPendingScreenshots();
+  raster_cache_warm_state_ = compositor_context_->raster_cache().GetWarmState();
   compositor_context_->OnGrContextDestroyed();
+  if (surface_) {
+    if (auto context = surface_->GetContext()) {
+      // Contexts that are shared between surfaces, as on iOS, would otherwise
+      // keep the GPU memory of the resources of this surface while it is gone.
+      context->performDeferredCleanup(std::chrono::milliseconds(0));
+      // Save the pipelines the driver compiled for this surface, so that the
+      // next launch does not compile them again. This does nothing for
+      // backends other than Vulkan. The SkSL cache only holds SkSLs, which
+      // it precompiles on launch.
+      if (!PersistentCache::cache_sksl()) {
+        context->storeVkPipelineCacheData();
+      }
+    }
+    // The app may be killed while it has no surface.
+    PersistentCache::GetCacheForProcess()->StoreShaderUsage();
+  }
   surface_.reset();
+  // The readbacks cannot finish without the surface, and are drawn again
+  // without it.
+  PollAsyncReadbacks();
   last_layer_tree_.reset();
 
   if (raster_thread_merger_.get() != nullptr &&
@@ -122,19 +171,35 @@ void Rasterizer::DisableThreadMergerIfNeeded() {
   }
 }
 
-void Rasterizer::NotifyLowMemoryWarning() const {
+void Rasterizer::NotifyMemoryPressure(MemoryPressureLevel level) {
+  auto& raster_cache = compositor_context_->raster_cache();
+  if (level == MemoryPressureLevel::kModerate) {
+    size_t budget = raster_cache.GetMaxCacheBytes();
+    if (budget == 0) {
+      budget = raster_cache.EstimatePictureCacheByteSize() +
+               raster_cache.EstimateLayerCacheByteSize();
+    }
+    raster_cache.Trim(budget / 2);
+  } else {
+    raster_cache.Clear();
+  }
+
   if (!surface_) {
     FML_DLOG(INFO)
-        << "Rasterizer::NotifyLowMemoryWarning called with no surface.";
+        << "Rasterizer::NotifyMemoryPressure called with no surface.";
     return;
   }
   auto context = surface_->GetContext();
   if (!context) {
     FML_DLOG(INFO)
-        << "Rasterizer::NotifyLowMemoryWarning called with no GrContext.";
+        << "Rasterizer::NotifyMemoryPressure called with no GrContext.";
     return;
   }
-  context->performDeferredCleanup(std::chrono::milliseconds(0));
+  if (level == MemoryPressureLevel::kModerate) {
+    context->purgeUnlockedResources(true /* scratchResourcesOnly */);
+  } else {
+    context->performDeferredCleanup(std::chrono::milliseconds(0));
+  }
 }
 
 flutter::TextureRegistry* Rasterizer::GetTextureRegistry() {
@@ -146,13 +211,29 @@ flutter::LayerTree* Rasterizer::GetLastLayerTree() {
 }
 
 void Rasterizer::DrawLastLayerTree() {
+  // This is drawn for frames that were only scheduled for new texture frames,
+  // which have to be marked even if there is nothing to draw.
+  MarkTexturesWithNewFrames();
   if (!last_layer_tree_ || !surface_) {
     return;
   }
   DrawToSurface(*last_layer_tree_);
 }
 
-void Rasterizer::Draw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
+void Rasterizer::MarkTexturesWithNewFrames() {
+  // However often the platform notified about new frames of a texture since
+  // the last frame, the texture is marked once.
+  delegate_.TakeTexturesWithNewFrames(&textures_with_new_frames_);
+  auto& texture_registry = compositor_context_->texture_registry();
+  for (int64_t texture_id : textures_with_new_frames_) {
+    auto texture = texture_registry.GetTexture(texture_id);
+    if (texture) {
+      texture->MarkNewFrameAvailable();
+    }
+  }
+}
+
+void Rasterizer::Draw(fml::RefPtr<FramePipeline> pipeline,
                       LayerTreeDiscardCallback discardCallback) {
   TRACE_EVENT0("flutter", "GPURasterizer::Draw");
   if (raster_thread_merger_ &&
@@ -164,17 +245,59 @@ void Rasterizer::Draw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
                  .GetRasterTaskRunner()
                  ->RunsTasksOnCurrentThread());
 
-  RasterStatus raster_status = RasterStatus::kFailed;
-  Pipeline<flutter::LayerTree>::Consumer consumer =
-      [&](std::unique_ptr<LayerTree> layer_tree) {
-        if (discardCallback(*layer_tree.get())) {
-          raster_status = RasterStatus::kDiscarded;
-        } else {
-          raster_status = DoDraw(std::move(layer_tree));
-        }
-      };
+  // The textures are taken even if the frame is discarded or fails to draw,
+  // so that the platform schedules another frame for their next new frames.
+  MarkTexturesWithNewFrames();
+
+  compositor_context_->frame_statistics().current_frame().frames_in_flight =
+      pipeline->GetInflightCount();
 
-  PipelineConsumeResult consume_result = pipeline->Consume(consumer);
+  // The newest layer tree of each view in the frames that were dropped, see
+  // |SetDropStaleFrames|. A view may not be part of the frame that is drawn
+  // instead, in which case its update would otherwise be lost.
+  std::map<int64_t, std::unique_ptr<LayerTree>> dropped_layer_trees;
+
+  RasterStatus raster_status = RasterStatus::kFailed;
+  FramePipeline::Consumer consumer = [&](std::unique_ptr<FrameItem> item) {
+    auto& layer_trees = item->layer_trees;
+    for (auto& [view_id, dropped_layer_tree] : dropped_layer_trees) {
+      const bool has_view = std::any_of(
+          layer_trees.begin(), layer_trees.end(),
+          [view_id = view_id](const std::unique_ptr<LayerTree>& layer_tree) {
+            return layer_tree && layer_tree->view_id() == view_id;
+          });
+      if (!has_view) {
+        layer_trees.push_back(std::move(dropped_layer_tree));
+      }
+    }
+    dropped_layer_trees.clear();
+    layer_trees.erase(std::remove_if(layer_trees.begin(), layer_trees.end(),
+                                     [&](const auto& layer_tree) {
+                                       return !layer_tree ||
+                                              discardCallback(*layer_tree);
+                                     }),
+                      layer_trees.end());
+    if (layer_trees.empty()) {
+      raster_status = RasterStatus::kDiscarded;
+    } else {
+      raster_status = DoDraw(std::move(item));
+    }
+  };
+
+  // Frames older than the newest one are dropped without being drawn when
+  // the rasterizer fell behind, see |SetDropStaleFrames|.
+  FramePipeline::Consumer on_dropped = [&](std::unique_ptr<FrameItem> item) {
+    compositor_context_->frame_statistics().current_frame().dropped_frames++;
+    for (auto& layer_tree : item->layer_trees) {
+      if (layer_tree) {
+        const int64_t view_id = layer_tree->view_id();
+        dropped_layer_trees[view_id] = std::move(layer_tree);
+      }
+    }
+  };
+  PipelineConsumeResult consume_result =
+      drop_stale_frames_ ? pipeline->ConsumeLatest(consumer, on_dropped)
+                         : pipeline->Consume(consumer);
   // if the raster status is to resubmit the frame, we push the frame to the
   // front of the queue and also change the consume status to more available.
 
@@ -183,7 +306,7 @@ void Rasterizer::Draw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
   if (should_resubmit_frame) {
     auto front_continuation = pipeline->ProduceIfEmpty();
     bool result =
-        front_continuation.Complete(std::move(resubmitted_layer_tree_));
+        front_continuation.Complete(std::move(resubmitted_frame_item_));
     if (result) {
       consume_result = PipelineConsumeResult::MoreAvailable;
     }
@@ -331,35 +454,296 @@ sk_sp<SkImage> Rasterizer::ConvertToRasterImage(sk_sp<SkImage> image) {
                               });
 }
 
-RasterStatus Rasterizer::DoDraw(
-    std::unique_ptr<flutter::LayerTree> layer_tree) {
+struct Rasterizer::AsyncReadback {
+  SkImageInfo info;
+  std::function<void(sk_sp<SkImage>)> callback;
+  // Makes the image synchronously if the readback fails.
+  std::function<sk_sp<SkImage>()> fallback;
+  bool done = false;
+  sk_sp<SkData> pixels;
+  size_t row_bytes = 0;
+};
+
+void Rasterizer::ConvertToRasterImageAsync(
+    sk_sp<SkImage> image,
+    std::function<void(sk_sp<SkImage>)> callback) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+
+  if (surface_ == nullptr || surface_->GetContext() == nullptr ||
+      image == nullptr) {
+    callback(nullptr);
+    return;
+  }
+
+  std::shared_ptr<AsyncReadback> readback;
+  delegate_.GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse([&] {
+        auto context_switch = surface_->MakeRenderContextCurrent();
+        if (!context_switch->GetResult()) {
+          return;
+        }
+
+        // Images the GPU cannot render at their own size are scaled down by
+        // the synchronous path.
+        GrDirectContext* context = surface_->GetContext();
+        const SkImageInfo info = SkImageInfo::MakeN32Premul(
+            image->dimensions(), SkColorSpace::MakeSRGB());
+        if (std::max(info.width(), info.height()) >
+            context->maxRenderTargetSize()) {
+          return;
+        }
+        sk_sp<SkSurface> surface =
+            SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+        if (surface == nullptr || surface->getCanvas() == nullptr) {
+          return;
+        }
+        surface->getCanvas()->drawImage(image, 0, 0);
+        readback = ReadPixelsAsync(*surface, info, std::move(callback),
+                                   [this, image]() {
+                                     return ConvertToRasterImage(image);
+                                   });
+        context->submit();
+      }));
+
+  if (!readback) {
+    callback(ConvertToRasterImage(std::move(image)));
+    return;
+  }
+  AddAsyncReadback(std::move(readback));
+}
+
+std::shared_ptr<Rasterizer::AsyncReadback> Rasterizer::ReadPixelsAsync(
+    SkSurface& surface,
+    const SkImageInfo& info,
+    std::function<void(sk_sp<SkImage>)> callback,
+    std::function<sk_sp<SkImage>()> fallback) {
+  auto readback = std::make_shared<AsyncReadback>();
+  readback->info = info;
+  readback->callback = std::move(callback);
+  readback->fallback = std::move(fallback);
+  // Skia owns the context until it invokes the callback, which it also does
+  // if the readback fails or the GPU context is abandoned.
+  auto* pending = new std::shared_ptr<AsyncReadback>(readback);
+  surface.asyncRescaleAndReadPixels(
+      info, SkIRect::MakeSize(info.dimensions()), SkImage::RescaleGamma::kSrc,
+      SkImage::RescaleMode::kNearest,
+      [](void* context,
+         std::unique_ptr<const SkImage::AsyncReadResult> result) {
+        auto* pending = static_cast<std::shared_ptr<AsyncReadback>*>(context);
+        AsyncReadback& readback = **pending;
+        readback.done = true;
+        if (result && result->count() == 1) {
+          readback.row_bytes = result->rowBytes(0);
+          readback.pixels = SkData::MakeWithCopy(
+              result->data(0), readback.row_bytes * readback.info.height());
+        }
+        delete pending;
+      },
+      pending);
+  return readback;
+}
+
+void Rasterizer::MakeRasterSnapshotAsync(
+    sk_sp<SkPicture> picture,
+    SkISize picture_size,
+    std::function<void(sk_sp<SkImage>)> callback) {
+  FML_DCHECK(delegate_.GetTaskRunners()
+                 .GetRasterTaskRunner()
+                 ->RunsTasksOnCurrentThread());
+  pending_snapshots_.push_back(
+      {std::move(picture), picture_size, std::move(callback)});
+
+  // Bound the memory of the pictures that wait to be drawn.
+  if (pending_snapshots_.size() >= kMaxPendingSnapshots) {
+    DrawPendingSnapshots();
+    return;
+  }
+
+  // Draw the snapshots once the raster tasks that are already posted, such as
+  // the draw of the next frame, ran, so that snapshots requested together
+  // are submitted together and do not delay frames.
+  if (!pending_snapshots_scheduled_) {
+    pending_snapshots_scheduled_ = true;
+    delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTask(
+        [weak = weak_factory_.GetWeakPtr()]() {
+          if (weak) {
+            weak->DrawPendingSnapshots();
+          }
+        });
+  }
+}
+
+void Rasterizer::DrawPendingSnapshots() {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  pending_snapshots_scheduled_ = false;
+  std::vector<PendingSnapshot> snapshots;
+  snapshots.swap(pending_snapshots_);
+  if (snapshots.empty()) {
+    return;
+  }
+
+  std::vector<std::shared_ptr<AsyncReadback>> readbacks;
+  if (surface_ != nullptr && surface_->GetContext() != nullptr) {
+    delegate_.GetIsGpuDisabledSyncSwitch()->Execute(
+        fml::SyncSwitch::Handlers().SetIfFalse([&] {
+          auto context_switch = surface_->MakeRenderContextCurrent();
+          if (!context_switch->GetResult()) {
+            return;
+          }
+
+          GrDirectContext* context = surface_->GetContext();
+          for (PendingSnapshot& snapshot : snapshots) {
+            // Snapshots the GPU cannot render at their own size are scaled
+            // down by the synchronous path.
+            const SkImageInfo info = SkImageInfo::MakeN32Premul(
+                snapshot.size, SkColorSpace::MakeSRGB());
+            if (std::max(info.width(), info.height()) >
+                context->maxRenderTargetSize()) {
+              continue;
+            }
+            sk_sp<SkSurface> surface =
+                SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+            if (surface == nullptr || surface->getCanvas() == nullptr) {
+              continue;
+            }
+            surface->getCanvas()->drawPicture(snapshot.picture);
+            readbacks.push_back(ReadPixelsAsync(
+                *surface, info, std::move(snapshot.callback),
+                [this, picture = snapshot.picture, size = snapshot.size]() {
+                  return MakeRasterSnapshot(picture, size);
+                }));
+            snapshot.callback = nullptr;
+          }
+          context->submit();
+        }));
+  }
+
+  for (PendingSnapshot& snapshot : snapshots) {
+    if (snapshot.callback) {
+      snapshot.callback(MakeRasterSnapshot(std::move(snapshot.picture),
+                                           snapshot.size));
+    }
+  }
+  for (std::shared_ptr<AsyncReadback>& readback : readbacks) {
+    AddAsyncReadback(std::move(readback));
+  }
+}
+
+void Rasterizer::AddAsyncReadback(std::shared_ptr<AsyncReadback> readback) {
+  async_readbacks_.push_back(std::move(readback));
+  ScheduleAsyncReadbacksPoll();
+}
+
+void Rasterizer::ScheduleAsyncReadbacksPoll() {
+  if (async_readbacks_.empty() || async_readbacks_poll_scheduled_) {
+    return;
+  }
+  // The readbacks are checked after every frame. This only finishes them while
+  // no frames are drawn, and so waits as long as a frame does.
+  async_readbacks_poll_scheduled_ = true;
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostDelayedTask(
+      [weak = weak_factory_.GetWeakPtr()]() {
+        if (weak) {
+          weak->async_readbacks_poll_scheduled_ = false;
+          weak->PollAsyncReadbacks();
+        }
+      },
+      fml::TimeDelta::FromMillisecondsF(delegate_.GetFrameBudget().count()));
+}
+
+void Rasterizer::PollAsyncReadbacks() {
+  if (async_readbacks_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", __FUNCTION__);
+
+  // A readback whose surface or context is gone never finishes, and is made
+  // synchronously instead.
+  bool context_lost = true;
+  if (surface_ != nullptr && surface_->GetContext() != nullptr) {
+    auto context_switch = surface_->MakeRenderContextCurrent();
+    if (context_switch->GetResult() &&
+        !surface_->GetContext()->abandoned()) {
+      surface_->GetContext()->checkAsyncWorkCompletion();
+      context_lost = false;
+    }
+  }
+
+  std::vector<std::shared_ptr<AsyncReadback>> readbacks;
+  readbacks.swap(async_readbacks_);
+  for (std::shared_ptr<AsyncReadback>& readback : readbacks) {
+    if (!readback->done && !context_lost) {
+      async_readbacks_.push_back(std::move(readback));
+      continue;
+    }
+    sk_sp<SkImage> raster_image;
+    if (readback->pixels) {
+      raster_image = SkImage::MakeRasterData(readback->info, readback->pixels,
+                                             readback->row_bytes);
+    }
+    if (!raster_image && readback->fallback) {
+      raster_image = readback->fallback();
+    }
+    readback->callback(std::move(raster_image));
+  }
+  ScheduleAsyncReadbacksPoll();
+}
+
+RasterStatus Rasterizer::DoDraw(std::unique_ptr<FrameItem> frame_item) {
   FML_DCHECK(delegate_.GetTaskRunners()
                  .GetRasterTaskRunner()
                  ->RunsTasksOnCurrentThread());
 
-  if (!layer_tree || !surface_) {
+  if (!frame_item || frame_item->layer_trees.empty() || !surface_) {
     return RasterStatus::kFailed;
   }
 
+  // All the layer trees of a frame were built for the same vsync.
+  auto& layer_trees = frame_item->layer_trees;
+  const flutter::LayerTree& first_layer_tree = *layer_trees.front();
   FrameTiming timing;
 #if !defined(OS_FUCHSIA)
-  const fml::TimePoint frame_target_time = layer_tree->target_time();
+  const fml::TimePoint frame_target_time = first_layer_tree.target_time();
 #endif
-  timing.Set(FrameTiming::kVsyncStart, layer_tree->vsync_start());
-  timing.Set(FrameTiming::kBuildStart, layer_tree->build_start());
-  timing.Set(FrameTiming::kBuildFinish, layer_tree->build_finish());
+  timing.Set(FrameTiming::kVsyncStart, first_layer_tree.vsync_start());
+  timing.Set(FrameTiming::kBuildStart, first_layer_tree.build_start());
+  timing.Set(FrameTiming::kBuildFinish, first_layer_tree.build_finish());
   timing.Set(FrameTiming::kRasterStart, fml::TimePoint::Now());
 
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
   persistent_cache->ResetStoredNewShaders();
 
-  RasterStatus raster_status = DrawToSurface(*layer_tree);
-  if (raster_status == RasterStatus::kSuccess) {
-    last_layer_tree_ = std::move(layer_tree);
-  } else if (raster_status == RasterStatus::kResubmit ||
-             raster_status == RasterStatus::kSkipAndRetry) {
-    resubmitted_layer_tree_ = std::move(layer_tree);
-    return raster_status;
+  RasterStatus raster_status = RasterStatus::kSuccess;
+  for (auto it = layer_trees.begin(); it != layer_trees.end(); ++it) {
+    auto& layer_tree = *it;
+    const int64_t view_id = layer_tree->view_id();
+    if (view_id != kFlutterImplicitViewId) {
+      // The surface of the rasterizer belongs to the implicit view. The other
+      // views can only be presented by the external view embedder.
+      if (!external_view_embedder_) {
+        FML_DLOG(ERROR) << "Dropping the frame of view " << view_id
+                        << " as there is no external view embedder.";
+        continue;
+      }
+      if (additional_view_ids_.insert(view_id).second) {
+        compositor_context_->raster_cache().AddUser();
+      }
+    }
+
+    RasterStatus view_raster_status = DrawToSurface(*layer_tree, &timing);
+    if (view_raster_status == RasterStatus::kResubmit ||
+        view_raster_status == RasterStatus::kSkipAndRetry) {
+      // Retry this view and the views after it.
+      resubmitted_frame_item_ = std::make_unique<FrameItem>();
+      std::move(it, layer_trees.end(),
+                std::back_inserter(resubmitted_frame_item_->layer_trees));
+      return view_raster_status;
+    }
+    if (view_raster_status != RasterStatus::kSuccess) {
+      raster_status = view_raster_status;
+    } else if (view_id == kFlutterImplicitViewId) {
+      last_layer_tree_ = std::move(layer_tree);
+    }
   }
 
   if (persistent_cache->IsDumpingSkp() &&
@@ -432,9 +816,13 @@ RasterStatus Rasterizer::DoDraw(
   return raster_status;
 }
 
-RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
+RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree,
+                                       FrameTiming* frame_timing) {
   TRACE_EVENT0("flutter", "Rasterizer::DrawToSurface");
   FML_DCHECK(surface_);
+  fml::ScopedAllocationTag allocation_tag(fml::AllocationTag::kLayerTree);
+  SkiaConcurrentExecutor::ScopedPriority skia_priority(
+      SkiaConcurrentExecutor::Priority::kFrameCritical);
 
   // There is no way for the compositor to know how long the layer tree
   // construction took. Fortunately, the layer tree does. Grab that time
@@ -446,17 +834,50 @@ RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
     external_view_embedder_->BeginFrame(
         layer_tree.frame_size(), surface_->GetContext(),
         layer_tree.device_pixel_ratio(), raster_thread_merger_);
+    external_view_embedder_->SetFlutterViewId(layer_tree.view_id());
     embedder_root_canvas = external_view_embedder_->GetRootCanvas();
   }
 
-  // On Android, the external view embedder deletes surfaces in `BeginFrame`.
-  //
-  // Deleting a surface also clears the GL context. Therefore, acquire the
-  // frame after calling `BeginFrame` as this operation resets the GL context.
-  auto frame = surface_->AcquireFrame(layer_tree.frame_size());
+  // The surface of the rasterizer belongs to the implicit view. The other
+  // views are drawn into the root canvas of the external view embedder, which
+  // presents them itself, so the surface is neither acquired nor submitted for
+  // them and they get a frame without a surface instead.
+  std::unique_ptr<SurfaceFrame> frame;
+  if (layer_tree.view_id() == kFlutterImplicitViewId) {
+    // On Android, the external view embedder deletes surfaces in `BeginFrame`.
+    //
+    // Deleting a surface also clears the GL context. Therefore, acquire the
+    // frame after calling `BeginFrame` as this operation resets the GL
+    // context.
+    frame = surface_->AcquireFrame(layer_tree.frame_size());
+  } else if (embedder_root_canvas) {
+    frame = std::make_unique<SurfaceFrame>(
+        nullptr, SurfaceFrame::FramebufferInfo{},
+        [](const SurfaceFrame& surface_frame, SkCanvas* canvas) {
+          return true;
+        });
+  } else if (external_view_embedder_) {
+    FML_DLOG(ERROR) << "No root canvas to draw view " << layer_tree.view_id()
+                    << " into.";
+    external_view_embedder_->CancelFrame();
+  }
   if (frame == nullptr) {
     return RasterStatus::kFailed;
   }
+  last_submit_timings_ = {};
+  frame->set_submit_timings_callback(
+      [weak = weak_factory_.GetWeakPtr()](
+          const SurfaceFrame::SubmitTimings& submit_timings) {
+        if (weak) {
+          weak->last_submit_timings_ = submit_timings;
+        }
+      });
+  frame->set_gpu_time_callback(
+      [weak = weak_factory_.GetWeakPtr()](fml::TimeDelta gpu_time) {
+        if (weak) {
+          weak->last_gpu_time_ = gpu_time;
+        }
+      });
 
   // If the external view embedder has specified an optional root surface, the
   // root surface transformation is set by the embedder instead of
@@ -477,8 +898,45 @@ RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
       raster_thread_merger_           // thread merger
   );
 
+  // The buffers of the surface that are still presenting can't be drawn into,
+  // but the frame can be acquired and the layer tree prerolled while they are.
+  if (compositor_frame && max_presents_in_flight_ > 0 &&
+      layer_tree.view_id() == kFlutterImplicitViewId) {
+    compositor_frame->set_before_paint_callback([this]() {
+      WaitForPresentsInFlight(max_presents_in_flight_ - 1);
+    });
+  }
+
+  // Only the region of the frame that changed since the previous frame needs
+  // to be repainted if the surface preserves the contents of its framebuffers.
+  // The previous layer tree is only kept for the implicit view. The external
+  // view embedder draws into backing stores that start out cleared every
+  // frame, so with one the whole frame is repainted.
+  //
+  // The same diff measures the damage for the idle frame rate tuner. Only the
+  // new frames of the pipeline are measured, redrawing the last layer tree
+  // always draws it.
+  const bool partial_repaint =
+      frame->framebuffer_info().supports_partial_repaint &&
+      !external_view_embedder_ && root_surface_transformation.isIdentity() &&
+      layer_tree.view_id() == kFlutterImplicitViewId;
+  const bool measure_damage = idle_frame_rate_tuner_ && frame_timing &&
+                              layer_tree.view_id() == kFlutterImplicitViewId;
+  std::unique_ptr<FrameDamage> damage;
+  if (partial_repaint || measure_damage) {
+    damage = std::make_unique<FrameDamage>();
+    if (partial_repaint && frame->framebuffer_info().existing_damage) {
+      damage->SetPreviousLayerTree(last_layer_tree_.get());
+      damage->AddAdditionalDamage(*frame->framebuffer_info().existing_damage);
+    } else if (measure_damage) {
+      damage->SetPreviousLayerTree(last_layer_tree_.get());
+      damage->SetClipToDamage(false);
+    }
+  }
+
   if (compositor_frame) {
-    RasterStatus raster_status = compositor_frame->Raster(layer_tree, false);
+    RasterStatus raster_status =
+        compositor_frame->Raster(layer_tree, false, damage.get());
     if (raster_status == RasterStatus::kFailed ||
         raster_status == RasterStatus::kSkipAndRetry) {
       return raster_status;
@@ -494,18 +952,95 @@ RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
              "https://github.com/flutter/flutter/issues/73620.";
       fml::KillProcess();
     }
+    if (damage && measure_damage) {
+      const SkISize frame_size = layer_tree.frame_size();
+      std::optional<SkIRect> frame_damage = damage->GetFrameDamage();
+      idle_frame_rate_tuner_->AddFrameDamage(
+          frame_damage && !frame_size.isEmpty()
+              ? static_cast<double>(frame_damage->width()) *
+                    frame_damage->height() / frame_size.area()
+              : 1);
+    }
+    if (damage && partial_repaint) {
+      SurfaceFrame::SubmitInfo submit_info;
+      submit_info.frame_damage = damage->GetFrameDamage();
+      submit_info.buffer_damage = damage->GetBufferDamage();
+      frame->set_submit_info(submit_info);
+      const SkISize frame_size = layer_tree.frame_size();
+      if (submit_info.buffer_damage && !frame_size.isEmpty()) {
+        const SkIRect& repainted = *submit_info.buffer_damage;
+        FrameStatistics::Frame& statistics =
+            compositor_context_->frame_statistics().current_frame();
+        statistics.damaged_fraction =
+            static_cast<double>(repainted.width()) * repainted.height() /
+            frame_size.area();
+      }
+    }
+
+    // The readback of the screenshots is recorded before the frame is
+    // submitted, while the surface still holds the frame, and is waited for
+    // after.
+    std::shared_ptr<AsyncReadback> screenshot_readback;
+    if (!pending_screenshots_.empty() &&
+        layer_tree.view_id() == kFlutterImplicitViewId) {
+      const bool frame_is_on_surface =
+          !embedder_root_canvas && root_surface_transformation.isIdentity() &&
+          frame->supports_readback();
+      sk_sp<SkSurface> frame_surface =
+          frame_is_on_surface ? frame->SkiaSurface() : nullptr;
+      screenshot_readback =
+          ReadPendingScreenshots(layer_tree, frame_surface.get());
+    }
+
     if (external_view_embedder_ &&
-        (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
+        (!raster_thread_merger_ || raster_thread_merger_->IsMerged() ||
+         external_view_embedder_->SubmitsFramesWithoutThreadMerging())) {
       FML_DCHECK(!frame->IsSubmitted());
       external_view_embedder_->SubmitFrame(
           surface_->GetContext(), std::move(frame),
           delegate_.GetIsGpuDisabledSyncSwitch());
+    } else if (present_thread_ &&
+               frame->framebuffer_info().max_presents_in_flight > 0) {
+      max_presents_in_flight_ =
+          frame->framebuffer_info().max_presents_in_flight;
+      {
+        std::scoped_lock lock(presents_in_flight_->mutex);
+        presents_in_flight_->count++;
+      }
+      SurfaceFrame::SubmitAndPresentOn(
+          std::move(frame), present_thread_->GetTaskRunner(),
+          [presents_in_flight = presents_in_flight_]() {
+            std::scoped_lock lock(presents_in_flight->mutex);
+            presents_in_flight->count--;
+            presents_in_flight->presented.notify_all();
+          });
     } else {
       frame->Submit();
     }
 
+    if (frame_timing) {
+      frame_timing->Set(FrameTiming::kPreroll,
+                        compositor_frame->preroll_duration());
+      frame_timing->Set(FrameTiming::kPaint,
+                        compositor_frame->paint_duration());
+      frame_timing->Set(FrameTiming::kFlush, last_submit_timings_.flush);
+      frame_timing->Set(FrameTiming::kPresent, last_submit_timings_.present);
+      frame_timing->Set(FrameTiming::kBufferWait,
+                        last_submit_timings_.buffer_wait);
+      frame_timing->Set(FrameTiming::kGpu, last_gpu_time_);
+    }
+
+    if (screenshot_readback) {
+      AddAsyncReadback(std::move(screenshot_readback));
+    }
+    PollAsyncReadbacks();
+
     FireNextFrameCallbackIfPresent();
 
+    if (layer_tree.view_id() == kFlutterImplicitViewId) {
+      UpdateGpuMemoryBudget(layer_tree.frame_size());
+    }
+
     if (surface_->GetContext()) {
       TRACE_EVENT0("flutter", "PerformDeferredSkiaCleanup");
       surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
@@ -517,7 +1052,7 @@ RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
   return RasterStatus::kFailed;
 }
 
-static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
+static sk_sp<SkPicture> RecordLayerTree(
     flutter::LayerTree* tree,
     flutter::CompositorContext& compositor_context) {
   FML_DCHECK(tree != nullptr);
@@ -533,7 +1068,14 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
   auto frame = compositor_context.ACQUIRE_FRAME(
       nullptr, recorder.getRecordingCanvas(), nullptr,
       root_surface_transformation, false, true, nullptr);
-  frame->Raster(*tree, true);
+  frame->Raster(*tree, true, nullptr);
+  return recorder.finishRecordingAsPicture();
+}
+
+static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
+    flutter::LayerTree* tree,
+    flutter::CompositorContext& compositor_context) {
+  sk_sp<SkPicture> picture = RecordLayerTree(tree, compositor_context);
 
 #if defined(OS_FUCHSIA)
   SkSerialProcs procs = {0};
@@ -544,7 +1086,42 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
   procs.fTypefaceProc = SerializeTypefaceWithData;
 #endif
 
-  return recorder.finishRecordingAsPicture()->serialize(&procs);
+  return picture->serialize(&procs);
+}
+
+static sk_sp<SkData> EncodeScreenshotImage(const sk_sp<SkImage>& cpu_image,
+                                           bool compressed) {
+  // If the caller want the pixels to be compressed, there is a Skia utility to
+  // compress to PNG. Use that.
+  if (compressed) {
+    return cpu_image->encodeToData();
+  }
+
+  // Copy it into a bitmap and return the same.
+  SkPixmap pixmap;
+  if (!cpu_image->peekPixels(&pixmap)) {
+    FML_LOG(ERROR) << "Screenshot: unable to obtain bitmap pixels";
+    return nullptr;
+  }
+  return SkData::MakeWithCopy(pixmap.addr32(), pixmap.computeByteSize());
+}
+
+static Rasterizer::Screenshot MakeScreenshot(sk_sp<SkData> data,
+                                             SkISize frame_size,
+                                             bool base64_encode) {
+  if (data == nullptr) {
+    FML_LOG(ERROR) << "Screenshot data was null.";
+    return {};
+  }
+
+  if (base64_encode) {
+    size_t b64_size = SkBase64::Encode(data->data(), data->size(), nullptr);
+    auto b64_data = SkData::MakeUninitialized(b64_size);
+    SkBase64::Encode(data->data(), data->size(), b64_data->writable_data());
+    return Rasterizer::Screenshot{b64_data, frame_size};
+  }
+
+  return Rasterizer::Screenshot{data, frame_size};
 }
 
 static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
@@ -601,7 +1178,7 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
       surface_context, canvas, nullptr, root_surface_transformation, false,
       true, nullptr);
   canvas->clear(SK_ColorTRANSPARENT);
-  frame->Raster(*tree, true);
+  frame->Raster(*tree, true, nullptr);
   canvas->flush();
 
   // Prepare an image from the surface, this image may potentially be on th GPU.
@@ -618,19 +1195,7 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
     return nullptr;
   }
 
-  // If the caller want the pixels to be compressed, there is a Skia utility to
-  // compress to PNG. Use that.
-  if (compressed) {
-    return cpu_snapshot->encodeToData();
-  }
-
-  // Copy it into a bitmap and return the same.
-  SkPixmap pixmap;
-  if (!cpu_snapshot->peekPixels(&pixmap)) {
-    FML_LOG(ERROR) << "Screenshot: unable to obtain bitmap pixels";
-    return nullptr;
-  }
-  return SkData::MakeWithCopy(pixmap.addr32(), pixmap.computeByteSize());
+  return EncodeScreenshotImage(cpu_snapshot, compressed);
 }
 
 Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
@@ -661,19 +1226,95 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
       break;
   }
 
-  if (data == nullptr) {
-    FML_LOG(ERROR) << "Screenshot data was null.";
-    return {};
+  return MakeScreenshot(std::move(data), layer_tree->frame_size(),
+                        base64_encode);
+}
+
+void Rasterizer::ScreenshotNextFrameAsync(
+    ScreenshotType type,
+    bool base64_encode,
+    std::function<void(Screenshot)> callback) {
+  FML_DCHECK(delegate_.GetTaskRunners()
+                 .GetRasterTaskRunner()
+                 ->RunsTasksOnCurrentThread());
+  if (type == ScreenshotType::SkiaPicture) {
+    // Pictures are recorded without a readback from the GPU.
+    callback(ScreenshotLastLayerTree(type, base64_encode));
+    return;
+  }
+  pending_screenshots_.push_back({type, base64_encode, std::move(callback)});
+}
+
+void Rasterizer::FailPendingScreenshots() {
+  std::vector<PendingScreenshot> screenshots;
+  screenshots.swap(pending_screenshots_);
+  for (const PendingScreenshot& screenshot : screenshots) {
+    screenshot.callback({});
   }
+}
 
-  if (base64_encode) {
-    size_t b64_size = SkBase64::Encode(data->data(), data->size(), nullptr);
-    auto b64_data = SkData::MakeUninitialized(b64_size);
-    SkBase64::Encode(data->data(), data->size(), b64_data->writable_data());
-    return Rasterizer::Screenshot{b64_data, layer_tree->frame_size()};
+std::shared_ptr<Rasterizer::AsyncReadback> Rasterizer::ReadPendingScreenshots(
+    const flutter::LayerTree& layer_tree,
+    SkSurface* frame_surface) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  auto screenshots = std::make_shared<std::vector<PendingScreenshot>>();
+  screenshots->swap(pending_screenshots_);
+  const SkISize frame_size = layer_tree.frame_size();
+
+  // The screenshots are encoded on the IO thread, so that neither compressing
+  // nor base 64 encoding them holds up the frames that follow.
+  fml::RefPtr<fml::TaskRunner> io_task_runner =
+      delegate_.GetTaskRunners().GetIOTaskRunner();
+  auto deliver = [io_task_runner, screenshots,
+                  frame_size](sk_sp<SkImage> cpu_image) {
+    io_task_runner->PostTask([screenshots, frame_size,
+                              cpu_image = std::move(cpu_image)]() {
+      for (const PendingScreenshot& screenshot : *screenshots) {
+        if (!cpu_image) {
+          FML_LOG(ERROR) << "Screenshot: unable to read back the frame";
+          screenshot.callback({});
+          continue;
+        }
+        screenshot.callback(MakeScreenshot(
+            EncodeScreenshotImage(
+                cpu_image,
+                screenshot.type == ScreenshotType::CompressedImage),
+            frame_size, screenshot.base64_encode));
+      }
+    });
+  };
+
+  // The frame that was just drawn is read back when it covers the whole layer
+  // tree. It does not when an external view embedder composites the frame,
+  // in which case the last layer tree is drawn again once this frame is done.
+  if (frame_surface == nullptr || frame_surface->width() < frame_size.width() ||
+      frame_surface->height() < frame_size.height()) {
+    delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTask(
+        [weak = weak_factory_.GetWeakPtr(), deliver, frame_size]() {
+          if (!weak || !weak->GetLastLayerTree()) {
+            deliver(nullptr);
+            return;
+          }
+          weak->MakeRasterSnapshotAsync(
+              RecordLayerTree(weak->GetLastLayerTree(),
+                              *weak->compositor_context_),
+              frame_size, deliver);
+        });
+    return nullptr;
   }
 
-  return Rasterizer::Screenshot{data, layer_tree->frame_size()};
+  const SkImageInfo info =
+      SkImageInfo::MakeN32Premul(frame_size, SkColorSpace::MakeSRGB());
+  // A failed readback draws the last layer tree again instead.
+  return ReadPixelsAsync(
+      *frame_surface, info, std::move(deliver), [this, frame_size]() {
+        if (!GetLastLayerTree()) {
+          return sk_sp<SkImage>();
+        }
+        return MakeRasterSnapshot(
+            RecordLayerTree(GetLastLayerTree(), *compositor_context_),
+            frame_size);
+      });
 }
 
 void Rasterizer::SetNextFrameCallback(const fml::closure& callback) {
@@ -685,6 +1326,69 @@ void Rasterizer::SetExternalViewEmbedder(
   external_view_embedder_ = view_embedder;
 }
 
+void Rasterizer::SetIdleFrameRateTuner(
+    std::shared_ptr<IdleFrameRateTuner> tuner) {
+  idle_frame_rate_tuner_ = std::move(tuner);
+}
+
+void Rasterizer::SetGpuMemoryBudgetTuner(
+    std::unique_ptr<GpuMemoryBudgetTuner> tuner) {
+  gpu_memory_budget_tuner_ = std::move(tuner);
+}
+
+void Rasterizer::UpdateGpuMemoryBudget(const SkISize& frame_size) {
+  GrDirectContext* context = surface_ ? surface_->GetContext() : nullptr;
+  if (!gpu_memory_budget_tuner_ || !context) {
+    return;
+  }
+  RasterCache& raster_cache = compositor_context_->raster_cache();
+  GpuMemoryBudgetTuner::Usage usage;
+  context->getResourceCacheUsage(nullptr, &usage.resource_cache_bytes);
+  context->getResourceCacheLimits(nullptr, &usage.resource_cache_limit_bytes);
+  usage.raster_cache_bytes = raster_cache.EstimatePictureCacheByteSize() +
+                             raster_cache.EstimateLayerCacheByteSize();
+  usage.raster_cache_evicted_images = raster_cache.GetEvictedImageCount();
+
+  std::optional<GpuMemoryBudgetTuner::Budget> budget =
+      gpu_memory_budget_tuner_->AddFrame(frame_size, usage);
+  if (!budget) {
+    return;
+  }
+  TRACE_EVENT2("flutter", "Rasterizer::UpdateGpuMemoryBudget",
+               "resource_cache_bytes",
+               std::to_string(budget->resource_cache_bytes).c_str(),
+               "raster_cache_bytes",
+               std::to_string(budget->raster_cache_bytes).c_str());
+  SetResourceCacheMaxBytes(budget->resource_cache_bytes, false);
+  raster_cache.SetMaxCacheBytes(budget->raster_cache_bytes);
+}
+
+void Rasterizer::SetDropStaleFrames(bool drop_stale_frames) {
+  drop_stale_frames_ = drop_stale_frames;
+}
+
+void Rasterizer::EnableThreadedPresent() {
+  if (present_thread_) {
+    return;
+  }
+  present_thread_ = std::make_unique<fml::Thread>("io.flutter.present");
+  presents_in_flight_ = std::make_shared<PresentsInFlight>();
+}
+
+void Rasterizer::WaitForPresentsInFlight(size_t max_count) {
+  if (!presents_in_flight_) {
+    return;
+  }
+  std::unique_lock lock(presents_in_flight_->mutex);
+  if (presents_in_flight_->count <= max_count) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Rasterizer::WaitForPresentsInFlight");
+  presents_in_flight_->presented.wait(lock, [this, max_count]() {
+    return presents_in_flight_->count <= max_count;
+  });
+}
+
 void Rasterizer::FireNextFrameCallbackIfPresent() {
   if (!next_frame_callback_) {
     return;
@@ -730,6 +1434,29 @@ std::optional<size_t> Rasterizer::GetResourceCacheMaxBytes() const {
   return std::nullopt;
 }
 
+size_t Rasterizer::PrecompileKnownSkSLs() {
+  if (!surface_) {
+    return 0;
+  }
+  SkiaConcurrentExecutor::ScopedPriority skia_priority(
+      SkiaConcurrentExecutor::Priority::kSpeculative);
+  return PersistentCache::GetCacheForProcess()->PrecompileKnownSkSLs(
+      surface_->GetContext());
+}
+
+std::optional<size_t> Rasterizer::GetResourceCacheUsageBytes() const {
+  if (!surface_) {
+    return std::nullopt;
+  }
+  GrDirectContext* context = surface_->GetContext();
+  if (context) {
+    size_t bytes;
+    context->getResourceCacheUsage(nullptr, &bytes);
+    return bytes;
+  }
+  return std::nullopt;
+}
+
 Rasterizer::Screenshot::Screenshot() {}
 
 Rasterizer::Screenshot::Screenshot(sk_sp<SkData> p_data, SkISize p_size)
@@ -5,8 +5,12 @@
 #ifndef SHELL_COMMON_RASTERIZER_H_
 #define SHELL_COMMON_RASTERIZER_H_
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_set>
+#include <vector>
 
 #include "flow/embedded_views.h"
 #include "flutter/common/settings.h"
@@ -19,9 +23,13 @@
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/memory_pressure_level.h"
+#include "flutter/shell/common/gpu_memory_budget_tuner.h"
+#include "flutter/shell/common/idle_frame_rate_tuner.h"
 #include "flutter/shell/common/pipeline.h"
 
 namespace flutter {
@@ -89,6 +97,11 @@ class Rasterizer final : public SnapshotDelegate {
     /// is critical that GPU operations are not processed.
     virtual std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch()
         const = 0;
+
+    /// Replaces the contents of |textures| with the identifiers of the
+    /// textures that have a new frame available since the last call. Called
+    /// on the raster thread for every frame, whether or not it is drawn.
+    virtual void TakeTexturesWithNewFrames(std::vector<int64_t>* textures) = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -135,6 +148,10 @@ class Rasterizer final : public SnapshotDelegate {
   ///             (if this is not the first time the surface has been set up) is
   ///             user error.
   ///
+  ///             The pictures that were in the raster cache when the previous
+  ///             surface was torn down are rasterized again as soon as they
+  ///             are drawn.
+  ///
   /// @see        `Rasterizer::Teardown`
   ///
   /// @param[in]  surface  The on-screen render surface.
@@ -147,15 +164,27 @@ class Rasterizer final : public SnapshotDelegate {
   ///             till the next call to `Rasterizer::Setup` with a new render
   ///             surface. Calling a teardown without a setup is user error.
   ///
+  ///             The raster cache is cleared and the GPU resources that Skia
+  ///             holds on to are freed, as the context may outlive the
+  ///             surface. Only the warm state of the raster cache is kept, so
+  ///             that the next `Rasterizer::Setup` can restore it cheaply.
+  ///
   void Teardown();
 
   //----------------------------------------------------------------------------
-  /// @brief      Notifies the rasterizer that there is a low memory situation
-  ///             and it must purge as many unnecessary resources as possible.
-  ///             Currently, the Skia context associated with onscreen rendering
-  ///             is told to free GPU resources.
+  /// @brief      Notifies the rasterizer that there is memory pressure and it
+  ///             must purge unnecessary resources.
+  ///
+  ///             Under moderate pressure the raster cache is trimmed to half of
+  ///             its budget, or of its size if it has none, and Skia only
+  ///             releases its scratch resources. Under critical pressure, or
+  ///             when in the background, the raster cache is cleared and the
+  ///             Skia context associated with onscreen rendering is told to
+  ///             free all GPU resources it can.
   ///
-  void NotifyLowMemoryWarning() const;
+  /// @param[in]  level  The level of the memory pressure.
+  ///
+  void NotifyMemoryPressure(MemoryPressureLevel level);
 
   //----------------------------------------------------------------------------
   /// @brief      Gets a weak pointer to the rasterizer. The rasterizer may only
@@ -215,6 +244,12 @@ class Rasterizer final : public SnapshotDelegate {
   ///             the raster thread frame workload for that pipeline item to
   ///             render a frame on the on-screen surface.
   ///
+  ///             A pipeline item holds the layer trees of every view that was
+  ///             rendered in the frame. The layer tree of the implicit view is
+  ///             drawn on the on-screen surface. The layer trees of the other
+  ///             views are only drawn when there is an external view embedder,
+  ///             which presents them to the platform.
+  ///
   ///             Why does the draw call take a layer tree pipeline and not the
   ///             layer tree directly?
   ///
@@ -241,7 +276,7 @@ class Rasterizer final : public SnapshotDelegate {
   /// @param[in]  discardCallback if specified and returns true, the layer tree
   ///                             is discarded instead of being rendered
   ///
-  void Draw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
+  void Draw(fml::RefPtr<FramePipeline> pipeline,
             LayerTreeDiscardCallback discardCallback = NoDiscard);
 
   //----------------------------------------------------------------------------
@@ -335,6 +370,27 @@ class Rasterizer final : public SnapshotDelegate {
   ///
   Screenshot ScreenshotLastLayerTree(ScreenshotType type, bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Screenshots the next frame drawn to the surface without
+  ///             waiting for the GPU. The pixels of the frame are copied to
+  ///             the CPU once the GPU got to them, and the screenshot is
+  ///             encoded and delivered on the IO thread a frame or two later.
+  ///             Frames drawn to the surface are read back as they are, frames
+  ///             composited by an external view embedder are drawn again.
+  ///             Skia pictures are recorded right away.
+  ///
+  /// @param[in]  type           The type of the screenshot to gather.
+  /// @param[in]  base64_encode  Whether Base 64 encoding must be applied to the
+  ///                            data after a screenshot has been captured.
+  /// @param[in]  callback       Invoked with the screenshot, which is empty
+  ///                            if it could not be captured, or if the
+  ///                            rasterizer is torn down before the next
+  ///                            frame.
+  ///
+  void ScreenshotNextFrameAsync(ScreenshotType type,
+                                bool base64_encode,
+                                std::function<void(Screenshot)> callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Sets a callback that will be executed when the next layer tree
   ///             in rendered to the on-screen surface. This is used by
@@ -361,6 +417,45 @@ class Rasterizer final : public SnapshotDelegate {
   void SetExternalViewEmbedder(
       const std::shared_ptr<ExternalViewEmbedder>& view_embedder);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the tuner that is told how much of every frame of the
+  ///             implicit view changed, as found by the diff that partial
+  ///             repaint uses. This is done on shell initialization.
+  ///
+  void SetIdleFrameRateTuner(std::shared_ptr<IdleFrameRateTuner> tuner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the tuner that sizes the budgets of Skia's resource
+  ///             cache and of the raster cache after every frame of the
+  ///             implicit view. A resource cache size set by the user still
+  ///             takes precedence. This is done on shell initialization.
+  ///
+  void SetGpuMemoryBudgetTuner(std::unique_ptr<GpuMemoryBudgetTuner> tuner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether |Draw| skips to the newest frame of the pipeline,
+  ///             dropping the older ones without drawing them, when it fell
+  ///             behind the producer. This trades smoothness for latency. The
+  ///             layer trees of the newest frame are still subject to the
+  ///             discard callback, and the dropped frames are counted in the
+  ///             frame statistics of the compositor context. This is set on
+  ///             shell initialization.
+  ///
+  /// @param[in]  drop_stale_frames  Whether to drop stale frames.
+  ///
+  void SetDropStaleFrames(bool drop_stale_frames);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Presents the frames of surfaces that allow presents in
+  ///             flight on a dedicated thread, so that the next frame can be
+  ///             acquired and prerolled while the previous one is presenting.
+  ///             Painting waits until fewer than
+  ///             |SurfaceFrame::FramebufferInfo::max_presents_in_flight|
+  ///             frames are presenting. Only software surfaces allow presents
+  ///             in flight. This is done on shell initialization.
+  ///
+  void EnableThreadedPresent();
+
   //----------------------------------------------------------------------------
   /// @brief      Returns a pointer to the compositor context used by this
   ///             rasterizer. This pointer will never be `nullptr`.
@@ -410,6 +505,28 @@ class Rasterizer final : public SnapshotDelegate {
   ///
   std::optional<size_t> GetResourceCacheMaxBytes() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes currently held in Skia's resource cache,
+  ///             if a surface is present.
+  ///
+  /// @see        `GetResourceCacheMaxBytes`
+  ///
+  /// @return     The usage of Skia's resource cache, if available.
+  ///
+  std::optional<size_t> GetResourceCacheUsageBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Precompiles the SkSLs known to the persistent cache in the
+  ///             context of the surface, so that the first frames using them
+  ///             do not compile them.
+  ///
+  /// @see        `PersistentCache::PrecompileKnownSkSLs`
+  ///
+  /// @return     The number of SkSLs precompiled, which is 0 if there is no
+  ///             surface or the surface has no context.
+  ///
+  size_t PrecompileKnownSkSLs();
+
   //----------------------------------------------------------------------------
   /// @brief      Enables the thread merger if the external view embedder
   ///             supports dynamic thread merging.
@@ -449,25 +566,125 @@ class Rasterizer final : public SnapshotDelegate {
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
   // This is the last successfully rasterized layer tree.
   std::unique_ptr<flutter::LayerTree> last_layer_tree_;
-  // Set when we need attempt to rasterize the layer tree again. This layer_tree
-  // has not successfully rasterized. This can happen due to the change in the
-  // thread configuration. This will be inserted to the front of the pipeline.
-  std::unique_ptr<flutter::LayerTree> resubmitted_layer_tree_;
+  // Set when we need attempt to rasterize the layer trees again. These layer
+  // trees have not successfully rasterized. This can happen due to the change
+  // in the thread configuration. This will be inserted to the front of the
+  // pipeline.
+  std::unique_ptr<FrameItem> resubmitted_frame_item_;
+  // The views other than the implicit view that were drawn. Each of them is a
+  // user of the raster cache, so that drawing one view does not evict the
+  // entries of the others.
+  std::unordered_set<int64_t> additional_view_ids_;
   fml::closure next_frame_callback_;
   bool user_override_resource_cache_bytes_;
   std::optional<size_t> max_cache_bytes_;
+  // What the raster cache knew before the last teardown, restored on setup.
+  RasterCache::WarmState raster_cache_warm_state_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
+  std::shared_ptr<IdleFrameRateTuner> idle_frame_rate_tuner_;
+  std::unique_ptr<GpuMemoryBudgetTuner> gpu_memory_budget_tuner_;
   bool shared_engine_block_thread_merging_ = false;
+  // How long submitting the latest frame took.
+  SurfaceFrame::SubmitTimings last_submit_timings_;
+  // The GPU time of the latest frame the GPU finished executing.
+  fml::TimeDelta last_gpu_time_;
+  // See |SetDropStaleFrames|.
+  bool drop_stale_frames_ = false;
+  // The thread of |EnableThreadedPresent| and the frames handed to it that
+  // have not finished presenting. The count is shared with the present tasks.
+  struct PresentsInFlight {
+    std::mutex mutex;
+    std::condition_variable presented;
+    size_t count = 0;
+  };
+  std::unique_ptr<fml::Thread> present_thread_;
+  std::shared_ptr<PresentsInFlight> presents_in_flight_;
+  // The bound of the surface of the last frame presented on |present_thread_|.
+  size_t max_presents_in_flight_ = 0;
+  // The snapshots requested with |MakeRasterSnapshotAsync| that were not
+  // drawn yet.
+  struct PendingSnapshot {
+    sk_sp<SkPicture> picture;
+    SkISize size;
+    std::function<void(sk_sp<SkImage>)> callback;
+  };
+  std::vector<PendingSnapshot> pending_snapshots_;
+  bool pending_snapshots_scheduled_ = false;
+  // Reused for the textures taken from the delegate for every frame.
+  std::vector<int64_t> textures_with_new_frames_;
+  // The screenshots requested with |ScreenshotNextFrameAsync| that are read
+  // back from the next frame.
+  struct PendingScreenshot {
+    ScreenshotType type;
+    bool base64_encode;
+    std::function<void(Screenshot)> callback;
+  };
+  std::vector<PendingScreenshot> pending_screenshots_;
+  // The state of a pending readback from the GPU.
+  struct AsyncReadback;
+  // The readbacks that wait for the GPU.
+  std::vector<std::shared_ptr<AsyncReadback>> async_readbacks_;
+  bool async_readbacks_poll_scheduled_ = false;
 
   // |SnapshotDelegate|
   sk_sp<SkImage> MakeRasterSnapshot(sk_sp<SkPicture> picture,
                                     SkISize picture_size) override;
 
+  // |SnapshotDelegate|
+  void MakeRasterSnapshotAsync(
+      sk_sp<SkPicture> picture,
+      SkISize picture_size,
+      std::function<void(sk_sp<SkImage>)> callback) override;
+
   // |SnapshotDelegate|
   sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
+  // |SnapshotDelegate|
+  void ConvertToRasterImageAsync(
+      sk_sp<SkImage> image,
+      std::function<void(sk_sp<SkImage>)> callback) override;
+
+  // Starts reading back the pixels of |surface|, which the GPU does once the
+  // context of the surface is next submitted. |fallback| makes the image
+  // synchronously if the readback fails or the context is lost.
+  static std::shared_ptr<AsyncReadback> ReadPixelsAsync(
+      SkSurface& surface,
+      const SkImageInfo& info,
+      std::function<void(sk_sp<SkImage>)> callback,
+      std::function<sk_sp<SkImage>()> fallback);
+
+  // Blocks until at most |max_count| frames are presenting on
+  // |present_thread_|.
+  void WaitForPresentsInFlight(size_t max_count);
+
+  // Draws the pending snapshots, submits them to the GPU at once and reads
+  // them back asynchronously.
+  void DrawPendingSnapshots();
+
+  void MarkTexturesWithNewFrames();
+
+  // Invokes the callbacks of the pending screenshots with empty screenshots.
+  void FailPendingScreenshots();
+
+  // Starts reading back the frame of |layer_tree| from |frame_surface| for the
+  // pending screenshots. If |frame_surface| is null the layer tree is drawn
+  // again instead, and no readback is returned.
+  std::shared_ptr<AsyncReadback> ReadPendingScreenshots(
+      const flutter::LayerTree& layer_tree,
+      SkSurface* frame_surface);
+
+  // Adds |readback| to the readbacks that are checked after every frame.
+  void AddAsyncReadback(std::shared_ptr<AsyncReadback> readback);
+
+  // Checks the pending readbacks a frame from now, in case no frame is drawn
+  // by then.
+  void ScheduleAsyncReadbacksPoll();
+
+  // Invokes the callbacks of the pending readbacks the GPU finished.
+  void PollAsyncReadbacks();
+
   sk_sp<SkData> ScreenshotLayerTreeAsImage(
       flutter::LayerTree* tree,
       flutter::CompositorContext& compositor_context,
@@ -478,12 +695,18 @@ class Rasterizer final : public SnapshotDelegate {
       SkISize size,
       std::function<void(SkCanvas*)> draw_callback);
 
-  RasterStatus DoDraw(std::unique_ptr<flutter::LayerTree> layer_tree);
+  RasterStatus DoDraw(std::unique_ptr<FrameItem> frame_item);
 
-  RasterStatus DrawToSurface(flutter::LayerTree& layer_tree);
+  // Fills in the raster phases of |frame_timing| if it is set.
+  RasterStatus DrawToSurface(flutter::LayerTree& layer_tree,
+                             FrameTiming* frame_timing = nullptr);
 
   void FireNextFrameCallbackIfPresent();
 
+  // Resizes the caches to the budget of |gpu_memory_budget_tuner_| after a
+  // frame of frame_size was drawn.
+  void UpdateGpuMemoryBudget(const SkISize& frame_size);
+
   static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
 
   FML_DISALLOW_COPY_AND_ASSIGN(Rasterizer);
@@ -25,6 +25,8 @@ class MockDelegate : public Rasterizer::Delegate {
   MOCK_CONST_METHOD0(GetTaskRunners, const TaskRunners&());
   MOCK_CONST_METHOD0(GetIsGpuDisabledSyncSwitch,
                      std::shared_ptr<const fml::SyncSwitch>());
+  MOCK_METHOD1(TakeTexturesWithNewFrames,
+               void(std::vector<int64_t>* textures));
 };
 
 class MockSurface : public Surface {
@@ -48,6 +50,7 @@ class MockExternalViewEmbedder : public ExternalViewEmbedder {
                     GrDirectContext* context,
                     double device_pixel_ratio,
                     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger));
+  MOCK_METHOD1(SetFlutterViewId, void(int64_t flutter_view_id));
   MOCK_METHOD2(PrerollCompositeEmbeddedView,
                void(int view_id, std::unique_ptr<EmbeddedViewParams> params));
   MOCK_METHOD1(PostPrerollAction,
@@ -90,7 +93,7 @@ TEST(RasterizerTest, drawEmptyPipeline) {
   rasterizer->Setup(std::move(surface));
   fml::AutoResetWaitableEvent latch;
   thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
-    auto pipeline = fml::AdoptRef(new Pipeline<LayerTree>(/*depth=*/10));
+    auto pipeline = fml::AdoptRef(new FramePipeline(/*depth=*/10));
     rasterizer->Draw(pipeline, nullptr);
     latch.Signal();
   });
@@ -142,10 +145,12 @@ TEST(RasterizerTest,
   rasterizer->Setup(std::move(surface));
   fml::AutoResetWaitableEvent latch;
   thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
-    auto pipeline = fml::AdoptRef(new Pipeline<LayerTree>(/*depth=*/10));
+    auto pipeline = fml::AdoptRef(new FramePipeline(/*depth=*/10));
     auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
                                                   /*device_pixel_ratio=*/2.0f);
-    bool result = pipeline->Produce().Complete(std::move(layer_tree));
+    auto frame_item = std::make_unique<FrameItem>();
+    frame_item->layer_trees.push_back(std::move(layer_tree));
+    bool result = pipeline->Produce().Complete(std::move(frame_item));
     EXPECT_TRUE(result);
     auto no_discard = [](LayerTree&) { return false; };
     rasterizer->Draw(pipeline, no_discard);
@@ -196,10 +201,12 @@ TEST(
   rasterizer->Setup(std::move(surface));
   fml::AutoResetWaitableEvent latch;
   thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
-    auto pipeline = fml::AdoptRef(new Pipeline<LayerTree>(/*depth=*/10));
+    auto pipeline = fml::AdoptRef(new FramePipeline(/*depth=*/10));
     auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
                                                   /*device_pixel_ratio=*/2.0f);
-    bool result = pipeline->Produce().Complete(std::move(layer_tree));
+    auto frame_item = std::make_unique<FrameItem>();
+    frame_item->layer_trees.push_back(std::move(layer_tree));
+    bool result = pipeline->Produce().Complete(std::move(frame_item));
     EXPECT_TRUE(result);
     auto no_discard = [](LayerTree&) { return false; };
     rasterizer->Draw(pipeline, no_discard);
@@ -255,15 +262,176 @@ TEST(
 
   rasterizer->Setup(std::move(surface));
 
-  auto pipeline = fml::AdoptRef(new Pipeline<LayerTree>(/*depth=*/10));
+  auto pipeline = fml::AdoptRef(new FramePipeline(/*depth=*/10));
   auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
                                                 /*device_pixel_ratio=*/2.0f);
-  bool result = pipeline->Produce().Complete(std::move(layer_tree));
+  auto frame_item = std::make_unique<FrameItem>();
+  frame_item->layer_trees.push_back(std::move(layer_tree));
+  bool result = pipeline->Produce().Complete(std::move(frame_item));
   EXPECT_TRUE(result);
   auto no_discard = [](LayerTree&) { return false; };
   rasterizer->Draw(pipeline, no_discard);
 }
 
+TEST(RasterizerTest, drawWithExternalViewEmbedderDrawsEveryViewOfTheFrame) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  TaskRunners task_runners("test",
+                           fml::MessageLoop::GetCurrent().GetTaskRunner(),
+                           fml::MessageLoop::GetCurrent().GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(1);
+
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<MockSurface>();
+
+  std::shared_ptr<MockExternalViewEmbedder> external_view_embedder =
+      std::make_shared<MockExternalViewEmbedder>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+
+  const SkISize view_size = SkISize::Make(10, 20);
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::make_unique<SurfaceFrame>(
+          /*surface=*/nullptr, /*supports_readback=*/true,
+          /*submit_callback=*/
+          [](const SurfaceFrame&, SkCanvas*) { return true; }))));
+  // The surface belongs to the implicit view, the other view is only drawn
+  // into the root canvas of the external view embedder.
+  EXPECT_CALL(*surface, AcquireFrame(view_size)).Times(0);
+  SkCanvas view_root_canvas;
+  EXPECT_CALL(*external_view_embedder, GetRootCanvas)
+      .WillOnce(Return(nullptr))
+      .WillOnce(Return(&view_root_canvas));
+  EXPECT_CALL(*external_view_embedder, SupportsDynamicThreadMerging)
+      .WillRepeatedly(Return(true));
+
+  EXPECT_CALL(*external_view_embedder,
+              BeginFrame(/*frame_size=*/SkISize(), /*context=*/nullptr,
+                         /*device_pixel_ratio=*/2.0,
+                         /*raster_thread_merger=*/_))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder,
+              BeginFrame(/*frame_size=*/view_size, /*context=*/nullptr,
+                         /*device_pixel_ratio=*/1.0,
+                         /*raster_thread_merger=*/_))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder,
+              SetFlutterViewId(kFlutterImplicitViewId))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder, SetFlutterViewId(1)).Times(1);
+  EXPECT_CALL(*external_view_embedder, SubmitFrame).Times(2);
+  EXPECT_CALL(*external_view_embedder, EndFrame(/*should_resubmit_frame=*/false,
+                                                /*raster_thread_merger=*/_))
+      .Times(1);
+
+  rasterizer->Setup(std::move(surface));
+
+  auto pipeline = fml::AdoptRef(new FramePipeline(/*depth=*/10));
+  auto frame_item = std::make_unique<FrameItem>();
+  frame_item->layer_trees.push_back(std::make_unique<LayerTree>(
+      /*frame_size=*/SkISize(), /*device_pixel_ratio=*/2.0f));
+  auto view_layer_tree = std::make_unique<LayerTree>(
+      /*frame_size=*/SkISize(), /*device_pixel_ratio=*/2.0f);
+  view_layer_tree->set_view(/*view_id=*/1, view_size,
+                            /*device_pixel_ratio=*/1.0f);
+  frame_item->layer_trees.push_back(std::move(view_layer_tree));
+  bool result = pipeline->Produce().Complete(std::move(frame_item));
+  EXPECT_TRUE(result);
+  auto no_discard = [](LayerTree&) { return false; };
+  rasterizer->Draw(pipeline, no_discard);
+}
+
+TEST(RasterizerTest, dropStaleFramesKeepsTheNewestLayerTreeOfEachView) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  TaskRunners task_runners("test",
+                           fml::MessageLoop::GetCurrent().GetTaskRunner(),
+                           fml::MessageLoop::GetCurrent().GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(1);
+
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  rasterizer->SetDropStaleFrames(true);
+  auto surface = std::make_unique<MockSurface>();
+
+  std::shared_ptr<MockExternalViewEmbedder> external_view_embedder =
+      std::make_shared<MockExternalViewEmbedder>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+
+  const SkISize view_size = SkISize::Make(10, 20);
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::make_unique<SurfaceFrame>(
+          /*surface=*/nullptr, /*supports_readback=*/true,
+          /*submit_callback=*/
+          [](const SurfaceFrame&, SkCanvas*) { return true; }))));
+  SkCanvas view_root_canvas;
+  EXPECT_CALL(*external_view_embedder, GetRootCanvas)
+      .WillOnce(Return(nullptr))
+      .WillOnce(Return(&view_root_canvas));
+  EXPECT_CALL(*external_view_embedder, SupportsDynamicThreadMerging)
+      .WillRepeatedly(Return(true));
+
+  // The implicit view of the newest frame, and the view that only the dropped
+  // frame had.
+  EXPECT_CALL(*external_view_embedder,
+              BeginFrame(/*frame_size=*/SkISize(), /*context=*/nullptr,
+                         /*device_pixel_ratio=*/3.0,
+                         /*raster_thread_merger=*/_))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder,
+              BeginFrame(/*frame_size=*/view_size, /*context=*/nullptr,
+                         /*device_pixel_ratio=*/1.0,
+                         /*raster_thread_merger=*/_))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder,
+              SetFlutterViewId(kFlutterImplicitViewId))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder, SetFlutterViewId(1)).Times(1);
+  EXPECT_CALL(*external_view_embedder, SubmitFrame).Times(2);
+  EXPECT_CALL(*external_view_embedder, EndFrame(/*should_resubmit_frame=*/false,
+                                                /*raster_thread_merger=*/_))
+      .Times(1);
+
+  rasterizer->Setup(std::move(surface));
+
+  auto pipeline = fml::AdoptRef(new FramePipeline(/*depth=*/10));
+  auto stale_frame_item = std::make_unique<FrameItem>();
+  stale_frame_item->layer_trees.push_back(std::make_unique<LayerTree>(
+      /*frame_size=*/SkISize(), /*device_pixel_ratio=*/2.0f));
+  auto view_layer_tree = std::make_unique<LayerTree>(
+      /*frame_size=*/SkISize(), /*device_pixel_ratio=*/2.0f);
+  view_layer_tree->set_view(/*view_id=*/1, view_size,
+                            /*device_pixel_ratio=*/1.0f);
+  stale_frame_item->layer_trees.push_back(std::move(view_layer_tree));
+  EXPECT_TRUE(pipeline->Produce().Complete(std::move(stale_frame_item)));
+
+  auto frame_item = std::make_unique<FrameItem>();
+  frame_item->layer_trees.push_back(std::make_unique<LayerTree>(
+      /*frame_size=*/SkISize(), /*device_pixel_ratio=*/3.0f));
+  EXPECT_TRUE(pipeline->Produce().Complete(std::move(frame_item)));
+
+  auto no_discard = [](LayerTree&) { return false; };
+  rasterizer->Draw(pipeline, no_discard);
+}
+
 TEST(RasterizerTest, externalViewEmbedderDoesntEndFrameWhenNoSurfaceIsSet) {
   std::string test_name =
       ::testing::UnitTest::GetInstance()->current_test_info()->name();
@@ -292,11 +460,69 @@ TEST(RasterizerTest, externalViewEmbedderDoesntEndFrameWhenNoSurfaceIsSet) {
 
   fml::AutoResetWaitableEvent latch;
   thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
-    auto pipeline = fml::AdoptRef(new Pipeline<LayerTree>(/*depth=*/10));
+    auto pipeline = fml::AdoptRef(new FramePipeline(/*depth=*/10));
     auto no_discard = [](LayerTree&) { return false; };
     rasterizer->Draw(pipeline, no_discard);
     latch.Signal();
   });
   latch.Wait();
 }
+
+TEST(RasterizerTest, threadedPresentSubmitsFrameOffTheRasterThread) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  rasterizer->EnableThreadedPresent();
+  auto surface = std::make_unique<MockSurface>();
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.max_presents_in_flight = 1;
+  fml::AutoResetWaitableEvent presented;
+  bool presented_on_raster_thread = true;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, framebuffer_info,
+      /*submit_callback=*/[&](const SurfaceFrame&, SkCanvas*) {
+        presented_on_raster_thread =
+            task_runners.GetRasterTaskRunner()->RunsTasksOnCurrentThread();
+        presented.Signal();
+        return true;
+      });
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = fml::AdoptRef(new FramePipeline(/*depth=*/10));
+    auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    auto frame_item = std::make_unique<FrameItem>();
+    frame_item->layer_trees.push_back(std::move(layer_tree));
+    bool result = pipeline->Produce().Complete(std::move(frame_item));
+    EXPECT_TRUE(result);
+    auto no_discard = [](LayerTree&) { return false; };
+    rasterizer->Draw(pipeline, no_discard);
+    latch.Signal();
+  });
+  latch.Wait();
+  presented.Wait();
+  EXPECT_FALSE(presented_on_raster_thread);
+
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
 }  // namespace flutter
@@ -5,26 +5,40 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 #include "flutter/shell/common/shell.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/layers/layer_arena.h"
+#include "flutter/flow/persistent_raster_cache.h"
+#include "flutter/fml/async_file.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/flight_recorder.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/allocation_tags.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/perfetto_trace_writer.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/fml/unique_fd.h"
+#include "flutter/lib/ui/painting/gradient_cache.h"
+#include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/picture.h"
+#include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/third_party/txt/src/minikin/Layout.h"
+#include "flutter/third_party/txt/src/txt/platform.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -38,6 +52,8 @@ constexpr char kSkiaChannel[] = "flutter/skia";
 constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
+constexpr char kFlightRecorderDumpFileName[] = "flutter_flight_recorder.json";
+constexpr char kJankyFrameSkpFileName[] = "flutter_flight_recorder.skp";
 
 namespace {
 
@@ -78,6 +94,29 @@ void Tokenize(const std::string& input,
   }
 }
 
+// Writes the Perfetto trace recorded since the first shell was created to
+// |path|. The trace is only recorded once per process, so the first shell to
+// be destroyed writes it.
+void WritePerfettoTrace(const std::string& path) {
+  if (!fml::tracing::PerfettoTraceIsRecording()) {
+    return;
+  }
+  std::string trace = fml::tracing::PerfettoTraceStop();
+  const std::string absolute_path = fml::paths::AbsolutePath(path);
+  const std::string directory = fml::paths::GetDirectoryName(absolute_path);
+  fml::UniqueFD directory_fd = fml::OpenDirectory(
+      directory.c_str(), false, fml::FilePermission::kReadWrite);
+  const std::string file_name = absolute_path.substr(directory.size() + 1);
+  fml::NonOwnedMapping mapping(reinterpret_cast<const uint8_t*>(trace.data()),
+                               trace.size());
+  if (!directory_fd.is_valid() ||
+      !fml::WriteAtomically(directory_fd, file_name.c_str(), mapping)) {
+    FML_LOG(ERROR) << "Could not write the trace to " << absolute_path;
+    return;
+  }
+  FML_LOG(INFO) << "Wrote the trace to " << absolute_path;
+}
+
 // Though there can be multiple shells, some settings apply to all components in
 // the process. These have to be set up before the shell or any of its
 // sub-components can be initialized. In a perfect world, this would be empty.
@@ -112,6 +151,12 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(prefixes);
     }
 
+    fml::tracing::FlightRecorderSetEnabled(settings.enable_flight_recorder);
+
+    if (!settings.trace_to_file.empty()) {
+      fml::tracing::PerfettoTraceStart();
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -120,9 +165,17 @@ void PerformInitializationTasks(Settings& settings) {
 
     if (settings.icu_initialization_required) {
       if (settings.icu_data_path.size() != 0) {
-        fml::icu::InitializeICU(settings.icu_data_path);
+        if (settings.lazy_icu_initialization) {
+          fml::icu::InitializeICULazily(settings.icu_data_path);
+        } else {
+          fml::icu::InitializeICU(settings.icu_data_path);
+        }
       } else if (settings.icu_mapper) {
-        fml::icu::InitializeICUFromMapping(settings.icu_mapper());
+        if (settings.lazy_icu_initialization) {
+          fml::icu::InitializeICUFromMappingLazily(settings.icu_mapper);
+        } else {
+          fml::icu::InitializeICUFromMapping(settings.icu_mapper());
+        }
       } else {
         FML_DLOG(WARNING) << "Skipping ICU initialization in the shell.";
       }
@@ -130,6 +183,10 @@ void PerformInitializationTasks(Settings& settings) {
   });
 
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+
+  if (settings.text_layout_cache_max_bytes >= 0) {
+    minikin::Layout::setCacheMaxBytes(settings.text_layout_cache_max_bytes);
+  }
 }
 
 }  // namespace
@@ -149,24 +206,34 @@ std::unique_ptr<Shell> Shell::Create(
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
   // arguments are ignored.
+  const fml::TimePoint snapshot_mapping_start = fml::TimePoint::Now();
   auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
   auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+  const fml::TimePoint vm_creation_start = fml::TimePoint::Now();
   auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
   FML_CHECK(vm) << "Must be able to initialize the VM.";
+  const fml::TimePoint vm_creation_end = fml::TimePoint::Now();
 
   // If the settings did not specify an `isolate_snapshot`, fall back to the
   // one the VM was launched with.
   if (!isolate_snapshot) {
     isolate_snapshot = vm->GetVMData()->GetIsolateSnapshot();
   }
-  return CreateWithSnapshot(std::move(platform_data),            //
-                            std::move(task_runners),             //
-                            std::move(settings),                 //
-                            std::move(vm),                       //
-                            std::move(isolate_snapshot),         //
-                            std::move(on_create_platform_view),  //
-                            std::move(on_create_rasterizer),     //
-                            CreateEngine, is_gpu_disabled);
+  auto shell = CreateWithSnapshot(std::move(platform_data),            //
+                                  std::move(task_runners),             //
+                                  std::move(settings),                 //
+                                  std::move(vm),                       //
+                                  std::move(isolate_snapshot),         //
+                                  std::move(on_create_platform_view),  //
+                                  std::move(on_create_rasterizer),     //
+                                  CreateEngine, is_gpu_disabled);
+  if (shell) {
+    std::scoped_lock lock(shell->startup_timings_mutex_);
+    shell->startup_timings_.snapshot_mapping =
+        vm_creation_start - snapshot_mapping_start;
+    shell->startup_timings_.vm_creation = vm_creation_end - vm_creation_start;
+  }
+  return shell;
 }
 
 std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
@@ -184,12 +251,40 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     return nullptr;
   }
 
+  const fml::TimePoint startup_start = fml::TimePoint::Now();
+  const bool parallel_startup = settings.enable_parallel_shell_startup;
+
   auto shell = std::unique_ptr<Shell>(
       new Shell(std::move(vm), task_runners, settings,
                 std::make_shared<VolatilePathTracker>(
                     task_runners.GetUITaskRunner(),
                     !settings.skia_deterministic_rendering_on_cpu),
                 is_gpu_disabled));
+  shell->startup_start_ = startup_start;
+
+  // Each step writes its own duration, and they are all read after the
+  // futures of the steps were waited on.
+  StartupTimings startup_timings;
+  startup_timings.parallel = parallel_startup;
+
+  // Creating the default font manager does not depend on any of the other
+  // subsystems, but it is usually the longest task on the UI thread before
+  // the root isolate can be launched. Get it out of the way on a worker
+  // thread while the other subsystems are set up.
+  if (parallel_startup) {
+    using FontManagerResult = std::pair<sk_sp<SkFontMgr>, fml::TimeDelta>;
+    auto font_manager_promise =
+        std::make_shared<std::promise<FontManagerResult>>();
+    shell->default_font_manager_future_ = font_manager_promise->get_future();
+    shell->GetDartVM()->GetConcurrentWorkerTaskRunner()->PostTask(
+        [font_manager_promise]() {
+          TRACE_EVENT0("flutter", "ShellSetupDefaultFontManager");
+          const fml::TimePoint start = fml::TimePoint::Now();
+          sk_sp<SkFontMgr> font_manager = txt::GetDefaultFontManager();
+          font_manager_promise->set_value(
+              {std::move(font_manager), fml::TimePoint::Now() - start});
+        });
+  }
 
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
@@ -199,28 +294,38 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   fml::TaskRunner::RunNowOrPostTask(
       task_runners.GetRasterTaskRunner(), [&rasterizer_promise,  //
                                            &snapshot_delegate_promise,
+                                           &startup_timings,      //
                                            on_create_rasterizer,  //
                                            shell = shell.get()    //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        const fml::TimePoint start = fml::TimePoint::Now();
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
+        RasterCache& raster_cache =
+            rasterizer->compositor_context()->raster_cache();
+        raster_cache.SetMaxCacheBytes(
+            shell->GetSettings().raster_cache_max_bytes);
+        if (shell->GetSettings().adaptive_gpu_memory_budget) {
+          rasterizer->SetGpuMemoryBudgetTuner(
+              std::make_unique<GpuMemoryBudgetTuner>(
+                  GpuMemoryBudgetTuner::GetPhysicalMemoryBytes().value_or(0),
+                  shell->GetSettings().gpu_memory_limit_bytes));
+        }
+        raster_cache.SetScaleTolerance(
+            shell->GetSettings().raster_cache_scale_tolerance,
+            shell->GetSettings().raster_cache_scale_mipmaps);
+        startup_timings.gpu_subsystem = fml::TimePoint::Now() - start;
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
   // Create the platform view on the platform thread (this thread).
+  const fml::TimePoint platform_view_start = fml::TimePoint::Now();
   auto platform_view = on_create_platform_view(*shell.get());
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
 
-  // Ask the platform view for the vsync waiter. This will be used by the engine
-  // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
-  if (!vsync_waiter) {
-    return nullptr;
-  }
-
   // Create the IO manager on the IO thread. The IO manager must be initialized
   // first because it has state that the other subsystems depend on. It must
   // first be booted and the necessary references obtained to initialize the
@@ -231,7 +336,13 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   auto weak_io_manager_future = weak_io_manager_promise.get_future();
   std::promise<fml::RefPtr<SkiaUnrefQueue>> unref_queue_promise;
   auto unref_queue_future = unref_queue_promise.get_future();
+  std::promise<std::shared_ptr<DecodedImageCache>> decoded_image_cache_promise;
+  auto decoded_image_cache_future = decoded_image_cache_promise.get_future();
   auto io_task_runner = shell->GetTaskRunners().GetIOTaskRunner();
+  const size_t decoded_image_cache_max_bytes =
+      shell->GetSettings().decoded_image_cache_max_bytes;
+  const size_t texture_upload_budget_bytes =
+      shell->GetSettings().texture_upload_budget_bytes;
 
   // TODO(gw280): The WeakPtr here asserts that we are derefing it on the
   // same thread as it was created on. We are currently on the IO thread
@@ -239,27 +350,62 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // constructed on the platform thread.
   //
   // https://github.com/flutter/flutter/issues/42948
-  fml::TaskRunner::RunNowOrPostTask(
-      io_task_runner,
-      [&io_manager_promise,                                               //
-       &weak_io_manager_promise,                                          //
-       &unref_queue_promise,                                              //
-       platform_view = platform_view->GetWeakPtr(),                       //
-       io_task_runner,                                                    //
-       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
-  ]() {
-        TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
-        auto io_manager = std::make_unique<ShellIOManager>(
-            platform_view.getUnsafe()->CreateResourceContext(),
-            is_backgrounded_sync_switch, io_task_runner);
-        weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
-        unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
-        io_manager_promise.set_value(std::move(io_manager));
-      });
+  auto setup_io_subsystem = [&]() {
+    fml::TaskRunner::RunNowOrPostTask(
+        io_task_runner,
+        [&io_manager_promise,                                               //
+         &weak_io_manager_promise,                                          //
+         &unref_queue_promise,                                              //
+         &decoded_image_cache_promise,                                      //
+         &startup_timings,                                                  //
+         platform_view = platform_view->GetWeakPtr(),                       //
+         io_task_runner,                                                    //
+         decoded_image_cache_max_bytes,                                     //
+         texture_upload_budget_bytes,                                       //
+         is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
+    ]() {
+          TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+          const fml::TimePoint start = fml::TimePoint::Now();
+          auto io_manager = std::make_unique<ShellIOManager>(
+              platform_view.getUnsafe()->CreateResourceContext(),
+              is_backgrounded_sync_switch, io_task_runner,
+              decoded_image_cache_max_bytes, texture_upload_budget_bytes);
+          startup_timings.io_subsystem = fml::TimePoint::Now() - start;
+          weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
+          unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
+          decoded_image_cache_promise.set_value(
+              io_manager->GetDecodedImageCache());
+          io_manager_promise.set_value(std::move(io_manager));
+        });
+  };
+
+  // The IO subsystem does not depend on the vsync waiter, so when starting up
+  // in parallel it does not wait for it.
+  if (parallel_startup) {
+    setup_io_subsystem();
+  }
+
+  // Ask the platform view for the vsync waiter. This will be used by the engine
+  // to create the animator.
+  auto vsync_waiter = platform_view->CreateVSyncWaiter();
+  if (!vsync_waiter) {
+    if (parallel_startup) {
+      // The IO subsystem refers to the promises on this stack.
+      io_manager_future.wait();
+    }
+    return nullptr;
+  }
+  startup_timings.platform_view = fml::TimePoint::Now() - platform_view_start;
+
+  if (!parallel_startup) {
+    setup_io_subsystem();
+  }
 
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  auto image_decoder_backend = platform_view->CreateImageDecoderBackend();
+  auto image_encoder_backend = platform_view->CreateImageEncoderBackend();
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -275,16 +421,23 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &weak_io_manager_future,                         //
                          &snapshot_delegate_future,                       //
                          &unref_queue_future,                             //
+                         &decoded_image_cache_future,                     //
+                         &image_decoder_backend,                          //
+                         &image_encoder_backend,                          //
+                         &startup_timings,                                //
                          &on_create_engine]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
+        const fml::TimePoint start = fml::TimePoint::Now();
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->pipeline_depth_tuner_, shell->idle_frame_rate_tuner_,
+            shell->begin_frame_delay_tuner_);
 
-        engine_promise.set_value(
+        auto engine =
             on_create_engine(*shell,                          //
                              dispatcher_maker,                //
                              *shell->GetDartVM(),             //
@@ -296,17 +449,37 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                              weak_io_manager_future.get(),    //
                              unref_queue_future.get(),        //
                              snapshot_delegate_future.get(),  //
-                             shell->volatile_path_tracker_));
+                             shell->volatile_path_tracker_);
+        if (engine) {
+          engine->SetDecodedImageCache(decoded_image_cache_future.get());
+          engine->SetImageDecoderBackend(std::move(image_decoder_backend));
+          engine->SetImageEncoderBackend(std::move(image_encoder_backend));
+        }
+        startup_timings.ui_subsystem = fml::TimePoint::Now() - start;
+        engine_promise.set_value(std::move(engine));
       }));
 
+  auto engine = engine_future.get();
+  auto rasterizer = rasterizer_future.get();
+  auto io_manager = io_manager_future.get();
+  {
+    std::scoped_lock lock(shell->startup_timings_mutex_);
+    shell->startup_timings_ = startup_timings;
+  }
+
   if (!shell->Setup(std::move(platform_view),  //
-                    engine_future.get(),       //
-                    rasterizer_future.get(),   //
-                    io_manager_future.get())   //
+                    std::move(engine),         //
+                    std::move(rasterizer),     //
+                    std::move(io_manager))     //
   ) {
     return nullptr;
   }
 
+  {
+    std::scoped_lock lock(shell->startup_timings_mutex_);
+    shell->startup_timings_.total = fml::TimePoint::Now() - startup_start;
+  }
+
   return shell;
 }
 
@@ -331,6 +504,14 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
     return nullptr;
   }
 
+  if (settings.icu_initialization_required &&
+      settings.lazy_icu_initialization) {
+    // No text is laid out before the engine runs, so the data is handed to
+    // ICU in the background while the shell is set up.
+    vm->GetConcurrentWorkerTaskRunner()->PostTask(
+        []() { fml::icu::EnsureICUInitialized(); });
+  }
+
   fml::AutoResetWaitableEvent latch;
   std::unique_ptr<Shell> shell;
   fml::TaskRunner::RunNowOrPostTask(
@@ -380,6 +561,20 @@ Shell::Shell(DartVMRef vm,
 
   display_manager_ = std::make_unique<DisplayManager>();
 
+  if (settings_.enable_adaptive_pipeline_depth) {
+    pipeline_depth_tuner_ = std::make_shared<PipelineDepthTuner>(
+        Animator::kMaxLayerTreePipelineDepth);
+  }
+
+  if (settings_.enable_just_in_time_begin_frame) {
+    begin_frame_delay_tuner_ = std::make_shared<BeginFrameDelayTuner>();
+  }
+
+  if (settings_.idle_frame_rate > 0) {
+    idle_frame_rate_tuner_ =
+        std::make_shared<IdleFrameRateTuner>(settings_.idle_frame_rate);
+  }
+
   // Generate a WeakPtrFactory for use with the raster thread. This does not
   // need to wait on a latch because it can only ever be used from the raster
   // thread from this class, so we have ordering guarantees.
@@ -427,11 +622,31 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFlightRecorderTraceExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFlightRecorderTrace, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameTimingStatisticsExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameTimingStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetMemoryUsageExtensionName] = {
+      task_runners_.GetRasterTaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetMemoryUsage, this,
+                std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetStartupTimingsExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetStartupTimings, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
+  PersistentCache::GetCacheForProcess()->StoreShaderUsage();
   PersistentCache::GetCacheForProcess()->RemoveWorkerTaskRunner(
-      task_runners_.GetIOTaskRunner());
+      fml::AsyncFileIO::GetForProcess().GetTaskRunner());
 
   vm_->GetServiceProtocol()->RemoveHandler(this);
 
@@ -480,6 +695,10 @@ Shell::~Shell() {
         platform_latch.Signal();
       }));
   platform_latch.Wait();
+
+  if (!settings_.trace_to_file.empty()) {
+    WritePerfettoTrace(settings_.trace_to_file);
+  }
 }
 
 std::unique_ptr<Shell> Shell::Spawn(
@@ -516,42 +735,79 @@ std::unique_ptr<Shell> Shell::Spawn(
           .SetIfFalse([&] { result = shell_maker(false); })
           .SetIfTrue([&] { result = shell_maker(true); }));
   result->shared_resource_context_ = io_manager_->GetSharedResourceContext();
+
+  const bool share_caches = GetSettings().share_spawned_engine_caches;
+  if (share_caches) {
+    // The spawned engine already uploads its images with the IO manager of
+    // this shell, so it can use the decoded images cached by it too. This is
+    // posted before the engine is run so that no image is decoded before.
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = result->engine_->GetWeakPtr(),
+         decoded_image_cache = io_manager_->GetDecodedImageCache()]() {
+          if (engine) {
+            engine->SetDecodedImageCache(decoded_image_cache);
+          }
+        });
+  }
   result->RunEngine(std::move(run_configuration));
 
   task_runners_.GetRasterTaskRunner()->PostTask(
       [rasterizer = rasterizer_->GetWeakPtr(),
-       spawn_rasterizer = result->rasterizer_->GetWeakPtr()]() {
+       spawn_rasterizer = result->rasterizer_->GetWeakPtr(), share_caches]() {
         if (rasterizer) {
           rasterizer->BlockThreadMerging();
         }
         if (spawn_rasterizer) {
           spawn_rasterizer->BlockThreadMerging();
         }
+        if (share_caches && rasterizer && spawn_rasterizer) {
+          // Both rasterizers draw on this thread with the same GPU context.
+          spawn_rasterizer->compositor_context()->ShareRasterCache(
+              *rasterizer->compositor_context());
+        }
       });
 
   return result;
 }
 
 void Shell::NotifyLowMemoryWarning() const {
+  NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+}
+
+void Shell::NotifyMemoryPressure(MemoryPressureLevel level) const {
   auto trace_id = fml::tracing::TraceNonce();
-  TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyLowMemoryWarning",
+  TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyMemoryPressure",
                            trace_id);
-  // This does not require a current isolate but does require a running VM.
-  // Since a valid shell will not be returned to the embedder without a valid
-  // DartVMRef, we can be certain that this is a safe spot to assume a VM is
-  // running.
-  ::Dart_NotifyLowMemory();
+  if (level != MemoryPressureLevel::kModerate) {
+    // This does not require a current isolate but does require a running VM.
+    // Since a valid shell will not be returned to the embedder without a
+    // valid DartVMRef, we can be certain that this is a safe spot to assume a
+    // VM is running.
+    ::Dart_NotifyLowMemory();
+    GradientCache::GetInstance().Purge();
+  }
 
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
+      [rasterizer = rasterizer_->GetWeakPtr(), level, trace_id = trace_id]() {
         if (rasterizer) {
-          rasterizer->NotifyLowMemoryWarning();
+          rasterizer->NotifyMemoryPressure(level);
         }
-        TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyLowMemoryWarning",
+        TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyMemoryPressure",
                                trace_id);
       });
   // The IO Manager uses resource cache limits of 0, so it is not necessary
-  // to purge them.
+  // to purge them. The decoded images it keeps alive are released though.
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [io_manager = io_manager_->GetWeakPtr(), level]() {
+        if (!io_manager || !io_manager->GetDecodedImageCache()) {
+          return;
+        }
+        if (level == MemoryPressureLevel::kModerate) {
+          io_manager->GetDecodedImageCache()->PurgeUnreferenced();
+        } else {
+          io_manager->GetDecodedImageCache()->Purge();
+        }
+      });
 }
 
 void Shell::RunEngine(RunConfiguration run_configuration) {
@@ -572,20 +828,34 @@ void Shell::RunEngine(
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  if (skp_shader_warmup_) {
+    skp_shader_warmup_->Start(run_configuration.GetAssetManager(),
+                              vm_->GetConcurrentWorkerTaskRunner());
+  }
+
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
       fml::MakeCopyable(
           [run_configuration = std::move(run_configuration),
-           weak_engine = weak_engine_, result]() mutable {
+           weak_engine = weak_engine_, result, shell = this]() mutable {
             if (!weak_engine) {
               FML_LOG(ERROR)
                   << "Could not launch engine with configuration - no engine.";
               result(Engine::RunStatus::Failure);
               return;
             }
+            const fml::TimePoint start = fml::TimePoint::Now();
             auto run_result = weak_engine->Run(std::move(run_configuration));
             if (run_result == flutter::Engine::RunStatus::Failure) {
               FML_LOG(ERROR) << "Could not launch engine with configuration.";
+            } else {
+              // The shell owns the engine, so it is still alive here.
+              std::scoped_lock lock(shell->startup_timings_mutex_);
+              if (shell->startup_timings_.isolate_launch.ToMicroseconds() ==
+                  0) {
+                shell->startup_timings_.isolate_launch =
+                    fml::TimePoint::Now() - start;
+              }
             }
             result(run_result);
           }));
@@ -647,6 +917,42 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   auto view_embedder = platform_view_->CreateExternalViewEmbedder();
   rasterizer_->SetExternalViewEmbedder(view_embedder);
 
+  rasterizer_->compositor_context()->SetSkiaUnrefQueue(
+      io_manager_->GetSkiaUnrefQueue());
+
+  if (settings_.warmup_skps) {
+    skp_shader_warmup_ = std::make_unique<SkpShaderWarmup>(
+        task_runners_.GetIOTaskRunner(), io_manager_->GetWeakIOManager());
+  }
+
+  if (idle_frame_rate_tuner_) {
+    rasterizer_->SetIdleFrameRateTuner(idle_frame_rate_tuner_);
+  }
+
+  if (settings_.enable_async_raster_cache) {
+    RasterCache& raster_cache =
+        rasterizer_->compositor_context()->raster_cache();
+    raster_cache.EnableAsyncPictureRasterization(
+        task_runners_.GetIOTaskRunner(), io_manager_->GetResourceContext(),
+        io_manager_->GetIsGpuDisabledSyncSwitch());
+  }
+
+  if (settings_.enable_parallel_preroll) {
+    rasterizer_->compositor_context()->SetConcurrentPrerollTaskRunner(
+        vm_->GetConcurrentWorkerTaskRunner());
+  }
+
+  if (settings_.enable_tiled_software_paint) {
+    rasterizer_->compositor_context()->SetConcurrentPaintTaskRunner(
+        vm_->GetConcurrentWorkerTaskRunner());
+  }
+
+  rasterizer_->SetDropStaleFrames(settings_.drop_stale_frames);
+
+  if (settings_.enable_threaded_present) {
+    rasterizer_->EnableThreadedPresent();
+  }
+
   // The weak ptr must be generated in the platform thread which owns the unique
   // ptr.
   weak_engine_ = engine_->GetWeakPtr();
@@ -654,17 +960,41 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
   // Setup the time-consuming default font manager right after engine created.
-  fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
-                                    [engine = weak_engine_] {
-                                      if (engine) {
-                                        engine->SetupDefaultFontManager();
-                                      }
-                                    });
+  // When starting up in parallel, it was created on a worker thread and is
+  // usually ready by now. Either way, the task runs before the root isolate is
+  // launched, which may lay out text right away.
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      fml::MakeCopyable(
+          [engine = weak_engine_, shell = this,
+           font_manager_future =
+               std::move(default_font_manager_future_)]() mutable {
+            fml::TimeDelta duration;
+            if (font_manager_future.valid()) {
+              auto [font_manager, creation_time] = font_manager_future.get();
+              duration = creation_time;
+              if (engine) {
+                engine->GetFontCollection()
+                    .GetFontCollection()
+                    ->SetDefaultFontManager(std::move(font_manager));
+              }
+            } else if (engine) {
+              const fml::TimePoint start = fml::TimePoint::Now();
+              engine->SetupDefaultFontManager();
+              duration = fml::TimePoint::Now() - start;
+            }
+            // The shell waits for the tasks on the UI thread when it is
+            // destroyed, so it outlives this task.
+            std::scoped_lock lock(shell->startup_timings_mutex_);
+            shell->startup_timings_.font_manager = duration;
+          }));
 
   is_setup_ = true;
 
+  // The cache is written on the file thread, so that its writes don't hold up
+  // the uploads on the IO thread.
   PersistentCache::GetCacheForProcess()->AddWorkerTaskRunner(
-      task_runners_.GetIOTaskRunner());
+      fml::AsyncFileIO::GetForProcess().GetTaskRunner());
 
   PersistentCache::GetCacheForProcess()->SetIsDumpingSkp(
       settings_.dump_skp_on_shader_compilation);
@@ -673,6 +1003,44 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
     PersistentCache::GetCacheForProcess()->Purge();
   }
 
+  if (settings_.persistent_cache_max_unused_launches > 0) {
+    PersistentCache::GetCacheForProcess()->SetMaxUnusedLaunches(
+        settings_.persistent_cache_max_unused_launches);
+    PersistentCache::GetCacheForProcess()->PruneUnusedShaders();
+  }
+
+  if (settings_.persist_fallback_font_cache) {
+    // The cache is shared by all shells, so it is only restored once.
+    static std::once_flag load_fallback_font_cache;
+    std::call_once(load_fallback_font_cache, [] {
+      auto directory =
+          PersistentCache::GetCacheForProcess()->GetCacheDirectory();
+      if (directory) {
+        FontCollection::GetFallbackFontCache()->Load(*directory);
+      }
+    });
+  }
+
+  if (settings_.enable_persistent_raster_cache) {
+    auto directory =
+        PersistentCache::GetCacheForProcess()->GetCacheDirectory();
+    if (directory && directory->is_valid()) {
+      auto raster_cache_directory =
+          std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+              *directory, PersistentRasterCache::kDirectoryName, true,
+              fml::FilePermission::kReadWrite));
+      // Like the shader cache, the images are rasterized and written on the
+      // file thread.
+      rasterizer_->compositor_context()
+          ->raster_cache()
+          .EnablePersistentPictureCache(
+              std::make_shared<PersistentRasterCache>(
+                  std::move(raster_cache_directory),
+                  fml::AsyncFileIO::GetForProcess().GetTaskRunner(),
+                  settings_.compress_persistent_raster_cache));
+    }
+  }
+
   return true;
 }
 
@@ -923,15 +1291,32 @@ void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
     return;
   }
 
-  // This is the formula Android uses.
-  // https://android.googlesource.com/platform/frameworks/base/+/master/libs/hwui/renderthread/CacheManager.cpp#41
-  size_t max_bytes = metrics.physical_width * metrics.physical_height * 12 * 4;
-  task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), max_bytes] {
-        if (rasterizer) {
-          rasterizer->SetResourceCacheMaxBytes(max_bytes, false);
-        }
-      });
+  if (metrics.view_id != kFlutterImplicitViewId) {
+    // The other views share the resources and frame size expectations of the
+    // implicit view and only need to reach the framework.
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = engine_->GetWeakPtr(), metrics]() {
+          if (engine) {
+            engine->SetViewportMetrics(metrics);
+          }
+        });
+    return;
+  }
+
+  // The adaptive GPU memory budget sizes the resource cache once it sees the
+  // frames of the new size instead.
+  if (!settings_.adaptive_gpu_memory_budget) {
+    // This is the formula Android uses.
+    // https://android.googlesource.com/platform/frameworks/base/+/master/libs/hwui/renderthread/CacheManager.cpp#41
+    size_t max_bytes =
+        metrics.physical_width * metrics.physical_height * 12 * 4;
+    task_runners_.GetRasterTaskRunner()->PostTask(
+        [rasterizer = rasterizer_->GetWeakPtr(), max_bytes] {
+          if (rasterizer) {
+            rasterizer->SetResourceCacheMaxBytes(max_bytes, false);
+          }
+        });
+  }
 
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), metrics]() {
@@ -955,12 +1340,35 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
 
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), message = std::move(message)] {
+        fml::ScopedAllocationTag allocation_tag(
+            fml::AllocationTag::kPlatformMessages);
         if (engine) {
           engine->DispatchPlatformMessage(std::move(message));
         }
       });
 }
 
+// |PlatformView::Delegate|
+void Shell::OnPlatformViewDispatchPlatformMessages(
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  if (messages.empty()) {
+    return;
+  }
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(),
+       messages = std::move(messages)]() mutable {
+        fml::ScopedAllocationTag allocation_tag(
+            fml::AllocationTag::kPlatformMessages);
+        if (engine) {
+          engine->DispatchPlatformMessages(std::move(messages));
+        }
+      });
+}
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewDispatchPointerDataPacket(
     std::unique_ptr<PointerDataPacket> packet) {
@@ -968,13 +1376,14 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
-  task_runners_.GetUITaskRunner()->PostTask(
+  task_runners_.GetUITaskRunner()->PostTaskWithPriority(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
         if (engine) {
           engine->DispatchPointerDataPacket(std::move(packet), flow_id);
         }
-      }));
+      }),
+      fml::TimePoint::Now(), fml::TaskPriority::kUserInput);
   next_pointer_flow_id_++;
 }
 
@@ -986,6 +1395,9 @@ void Shell::OnPlatformViewDispatchKeyDataPacket(
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  // Unlike pointer data, key data keeps the normal priority. The embedders
+  // send every key event both as key data and on the flutter/keyevent channel,
+  // and the framework relies on receiving the two in the order they were sent.
   task_runners_.GetUITaskRunner()->PostTask(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          callback = std::move(callback)]() mutable {
@@ -1072,23 +1484,20 @@ void Shell::OnPlatformViewMarkTextureFrameAvailable(int64_t texture_id) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
-  // Tell the rasterizer that one of its textures has a new frame available.
-  task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), texture_id]() {
-        auto* registry = rasterizer->GetTextureRegistry();
-
-        if (!registry) {
-          return;
-        }
-
-        auto texture = registry->GetTexture(texture_id);
-
-        if (!texture) {
-          return;
-        }
-
-        texture->MarkNewFrameAvailable();
-      });
+  // The rasterizer marks the texture for the next frame, so a frame only has
+  // to be scheduled if none is pending yet.
+  {
+    std::scoped_lock lock(textures_with_new_frames_mutex_);
+    if (std::find(textures_with_new_frames_.begin(),
+                  textures_with_new_frames_.end(),
+                  texture_id) == textures_with_new_frames_.end()) {
+      textures_with_new_frames_.push_back(texture_id);
+    }
+    if (texture_frame_scheduled_) {
+      return;
+    }
+    texture_frame_scheduled_ = true;
+  }
 
   // Schedule a new frame without having to rebuild the layer tree.
   task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()]() {
@@ -1121,6 +1530,18 @@ void Shell::OnAnimatorBeginFrame(fml::TimePoint frame_target_time) {
     std::scoped_lock time_recorder_lock(time_recorder_mutex_);
     latest_frame_target_time_.emplace(frame_target_time);
   }
+  if (!first_begin_frame_recorded_) {
+    first_begin_frame_recorded_ = true;
+    std::scoped_lock lock(startup_timings_mutex_);
+    startup_timings_.first_begin_frame = fml::TimePoint::Now() - startup_start_;
+  }
+  {
+    // The frame scheduled for new texture frames, if any, may render nothing
+    // and never reach the rasterizer, so the next texture frame schedules
+    // another one.
+    std::scoped_lock lock(textures_with_new_frames_mutex_);
+    texture_frame_scheduled_ = false;
+  }
   if (engine_) {
     engine_->BeginFrame(frame_target_time);
   }
@@ -1138,7 +1559,7 @@ void Shell::OnAnimatorNotifyIdle(int64_t deadline) {
 }
 
 // |Animator::Delegate|
-void Shell::OnAnimatorDraw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
+void Shell::OnAnimatorDraw(fml::RefPtr<FramePipeline> pipeline,
                            fml::TimePoint frame_target_time) {
   FML_DCHECK(is_setup_);
 
@@ -1153,6 +1574,9 @@ void Shell::OnAnimatorDraw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
   }
 
   auto discard_callback = [this](flutter::LayerTree& tree) {
+    if (tree.view_id() != kFlutterImplicitViewId) {
+      return false;
+    }
     std::scoped_lock<std::mutex> lock(resize_mutex_);
     return !expected_frame_size_.isEmpty() &&
            tree.frame_size() != expected_frame_size_;
@@ -1195,6 +1619,8 @@ void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
   task_runners_.GetPlatformTaskRunner()->PostTask(
       [view = platform_view_->GetWeakPtr(), update = std::move(update),
        actions = std::move(actions)] {
+        fml::ScopedAllocationTag allocation_tag(
+            fml::AllocationTag::kSemantics);
         if (view) {
           view->UpdateSemantics(std::move(update), std::move(actions));
         }
@@ -1214,6 +1640,8 @@ void Shell::OnEngineHandlePlatformMessage(
 
   task_runners_.GetPlatformTaskRunner()->PostTask(
       [view = platform_view_->GetWeakPtr(), message = std::move(message)]() {
+        fml::ScopedAllocationTag allocation_tag(
+            fml::AllocationTag::kPlatformMessages);
         if (view) {
           view->HandlePlatformMessage(std::move(message));
         }
@@ -1224,7 +1652,8 @@ void Shell::HandleEngineSkiaMessage(fml::RefPtr<PlatformMessage> message) {
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject())
     return;
   auto root = document.GetObject();
@@ -1299,6 +1728,20 @@ void Shell::SetNeedsReportTimings(bool value) {
   needs_report_timings_ = value;
 }
 
+// |Engine::Delegate|
+void Shell::OnEngineSetFrameRateRange(const FrameRateRange& range) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  max_requested_frame_rate_ = range.IsUnspecified() ? 0 : range.maximum;
+
+  task_runners_.GetPlatformTaskRunner()->PostTask(
+      [view = platform_view_->GetWeakPtr(), range]() {
+        if (view) {
+          view->SetFrameRateRange(range);
+        }
+      });
+}
+
 // |Engine::Delegate|
 std::unique_ptr<std::vector<std::string>> Shell::ComputePlatformResolvedLocale(
     const std::vector<std::string>& supported_locale_data) {
@@ -1341,6 +1784,15 @@ void Shell::ReportTimings() {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
 
+  if (!unreported_frame_timings_.empty()) {
+    auto frame_timings = std::move(unreported_frame_timings_);
+    unreported_frame_timings_ = {};
+    settings_.frame_timings_report_callback(frame_timings);
+  }
+
+  if (unreported_timings_.empty()) {
+    return;
+  }
   auto timings = std::move(unreported_timings_);
   unreported_timings_ = {};
   task_runners_.GetUITaskRunner()->PostTask([timings, engine = weak_engine_] {
@@ -1354,7 +1806,8 @@ size_t Shell::UnreportedFramesCount() const {
   // Check that this is running on the raster thread to avoid race conditions.
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
   FML_DCHECK(unreported_timings_.size() % FrameTiming::kCount == 0);
-  return unreported_timings_.size() / FrameTiming::kCount;
+  return std::max(unreported_timings_.size() / FrameTiming::kCount,
+                  unreported_frame_timings_.size());
 }
 
 void Shell::OnFrameRasterized(const FrameTiming& timing) {
@@ -1367,13 +1820,43 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
-  if (!needs_report_timings_) {
+  if (pipeline_depth_tuner_) {
+    pipeline_depth_tuner_->AddFrameTiming(timing, GetFrameBudget());
+  }
+
+  if (begin_frame_delay_tuner_) {
+    begin_frame_delay_tuner_->AddFrameTiming(timing, GetFrameBudget());
+  }
+
+  frame_timing_statistics_.AddFrameTiming(timing, GetFrameBudget());
+
+  fml::AllocationTags::TraceCounters();
+
+  if (!first_frame_rasterized_recorded_) {
+    first_frame_rasterized_recorded_ = true;
+    if (skp_shader_warmup_) {
+      skp_shader_warmup_->OnFirstFrameRasterized();
+    }
+    std::scoped_lock lock(startup_timings_mutex_);
+    startup_timings_.first_frame_rasterized =
+        fml::TimePoint::Now() - startup_start_;
+  }
+
+  DumpFlightRecorderIfJanky(timing);
+
+  const bool needs_report_timings = needs_report_timings_;
+  if (!needs_report_timings && !settings_.frame_timings_report_callback) {
     return;
   }
 
-  for (auto phase : FrameTiming::kPhases) {
-    unreported_timings_.push_back(
-        timing.Get(phase).ToEpochDelta().ToMicroseconds());
+  if (needs_report_timings) {
+    for (auto phase : FrameTiming::kPhases) {
+      unreported_timings_.push_back(
+          timing.Get(phase).ToEpochDelta().ToMicroseconds());
+    }
+  }
+  if (settings_.frame_timings_report_callback) {
+    unreported_frame_timings_.push_back(timing);
   }
 
   // In tests using iPhone 6S with profile mode, sending a batch of 1 frame or a
@@ -1400,9 +1883,10 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
 
     // Also make sure that frame times get reported with a max latency of 1
     // second. Otherwise, the timings of last few frames of an animation may
-    // never be reported until the next animation starts.
+    // never be reported until the next animation starts. The latency doesn't
+    // need to be precise, so the wakeup may be coalesced with others.
     frame_timings_report_scheduled_ = true;
-    task_runners_.GetRasterTaskRunner()->PostDelayedTask(
+    task_runners_.GetRasterTaskRunner()->PostDelayedTaskWithLeeway(
         [self = weak_factory_gpu_->GetWeakPtr()]() {
           if (!self) {
             return;
@@ -1412,12 +1896,30 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
             self->ReportTimings();
           }
         },
-        fml::TimeDelta::FromMilliseconds(kBatchTimeInMilliseconds));
+        fml::TimeDelta::FromMilliseconds(kBatchTimeInMilliseconds),
+        fml::TimeDelta::FromMilliseconds(kBatchTimeInMilliseconds / 10));
   }
 }
 
 fml::Milliseconds Shell::GetFrameBudget() {
-  double display_refresh_rate = display_manager_->GetMainDisplayRefreshRate();
+  const std::optional<Display> display =
+      display_manager_->GetViewDisplay(kFlutterImplicitViewId);
+  double display_refresh_rate =
+      display ? display->GetRefreshRate() : kUnknownDisplayRefreshRate;
+  const double max_requested_frame_rate = max_requested_frame_rate_;
+  if (max_requested_frame_rate > 0) {
+    if (display && display->SupportsVariableRefreshRate()) {
+      // Variable refresh rate displays follow the rate the application asked
+      // for, within the range they support.
+      display_refresh_rate =
+          std::clamp(max_requested_frame_rate, display->GetMinRefreshRate(),
+                     display->GetMaxRefreshRate());
+    } else if (display_refresh_rate <= 0 ||
+               max_requested_frame_rate < display_refresh_rate) {
+      // Frames are shown no faster than the application asked for.
+      display_refresh_rate = max_requested_frame_rate;
+    }
+  }
   if (display_refresh_rate > 0) {
     return fml::RefreshRateToFrameBudget(display_refresh_rate);
   } else {
@@ -1432,6 +1934,15 @@ fml::TimePoint Shell::GetLatestFrameTargetTime() const {
   return latest_frame_target_time_.value();
 }
 
+// |Rasterizer::Delegate|
+void Shell::TakeTexturesWithNewFrames(std::vector<int64_t>* textures) {
+  textures->clear();
+  std::scoped_lock lock(textures_with_new_frames_mutex_);
+  // Swapping hands the cleared vector back, so neither side reallocates.
+  textures->swap(textures_with_new_frames_);
+  texture_frame_scheduled_ = false;
+}
+
 // |ServiceProtocol::Handler|
 fml::RefPtr<fml::TaskRunner> Shell::GetServiceProtocolHandlerTaskRunner(
     std::string_view method) const {
@@ -1680,6 +2191,234 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetFlightRecorderTrace(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  response->SetObject();
+  response->AddMember("type", "FlightRecorderTrace", response->GetAllocator());
+  response->AddMember("enabled", fml::tracing::FlightRecorderIsEnabled(),
+                      response->GetAllocator());
+  std::string trace = fml::tracing::FlightRecorderEventsToJson(
+      fml::tracing::FlightRecorderSnapshot());
+  rapidjson::Value trace_value(trace.c_str(), response->GetAllocator());
+  response->AddMember("trace", trace_value, response->GetAllocator());
+  return true;
+}
+
+static void AddFrameTimePercentiles(const char* name,
+                                    const FrameTimePercentiles& percentiles,
+                                    rapidjson::Document* response) {
+  auto& allocator = response->GetAllocator();
+  rapidjson::Value value(rapidjson::kObjectType);
+  value.AddMember<int64_t>("p50Micros", percentiles.p50.ToMicroseconds(),
+                           allocator);
+  value.AddMember<int64_t>("p90Micros", percentiles.p90.ToMicroseconds(),
+                           allocator);
+  value.AddMember<int64_t>("p99Micros", percentiles.p99.ToMicroseconds(),
+                           allocator);
+  value.AddMember<int64_t>("maxMicros", percentiles.max.ToMicroseconds(),
+                           allocator);
+  response->AddMember(rapidjson::StringRef(name), value, allocator);
+}
+
+bool Shell::OnServiceProtocolGetFrameTimingStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto reset = params.find("reset");
+  FrameTimingStatisticsSnapshot statistics = GetFrameTimingStatistics(
+      reset != params.end() && reset->second == "true");
+  response->SetObject();
+  auto& allocator = response->GetAllocator();
+  response->AddMember("type", "FrameTimingStatistics", allocator);
+  response->AddMember<uint64_t>("frameCount", statistics.frame_count,
+                                allocator);
+  response->AddMember<uint64_t>("jankyBuildFrameCount",
+                                statistics.janky_build_frame_count, allocator);
+  response->AddMember<uint64_t>("jankyRasterFrameCount",
+                                statistics.janky_raster_frame_count, allocator);
+  AddFrameTimePercentiles("vsyncOverhead", statistics.vsync_overhead,
+                          response);
+  AddFrameTimePercentiles("build", statistics.build, response);
+  AddFrameTimePercentiles("raster", statistics.raster, response);
+  AddFrameTimePercentiles("gpu", statistics.gpu, response);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const auto& raster_cache = rasterizer_->compositor_context()->raster_cache();
+  const uint64_t raster_cache_layer_bytes =
+      raster_cache.EstimateLayerCacheByteSize();
+  const uint64_t raster_cache_picture_bytes =
+      raster_cache.EstimatePictureCacheByteSize();
+  const uint64_t gpu_resource_cache_bytes =
+      rasterizer_->GetResourceCacheUsageBytes().value_or(0);
+  const uint64_t decoded_image_cache_bytes =
+      io_manager_ && io_manager_->GetDecodedImageCache()
+          ? io_manager_->GetDecodedImageCache()->GetByteCount()
+          : 0;
+  const uint64_t text_layout_cache_bytes =
+      minikin::Layout::getCacheStats().byteCount;
+  const uint64_t picture_bytes = Picture::GetLiveBytes();
+  const uint64_t image_bytes = CanvasImage::GetLiveBytes();
+  const uint64_t platform_message_bytes = PlatformMessage::GetLiveBytes();
+  const uint64_t layer_arena_bytes =
+      LayerArena::GetLiveBlockCount() * LayerArena::kBlockSize;
+
+  response->SetObject();
+  auto& allocator = response->GetAllocator();
+  response->AddMember("type", "MemoryUsage", allocator);
+  response->AddMember<uint64_t>("rasterCacheLayerBytes",
+                                raster_cache_layer_bytes, allocator);
+  response->AddMember<uint64_t>("rasterCachePictureBytes",
+                                raster_cache_picture_bytes, allocator);
+  response->AddMember<uint64_t>("gpuResourceCacheBytes",
+                                gpu_resource_cache_bytes, allocator);
+  response->AddMember<uint64_t>("decodedImageCacheBytes",
+                                decoded_image_cache_bytes, allocator);
+  response->AddMember<uint64_t>("textLayoutCacheBytes",
+                                text_layout_cache_bytes, allocator);
+  response->AddMember<uint64_t>("pictureBytes", picture_bytes, allocator);
+  response->AddMember<uint64_t>("imageBytes", image_bytes, allocator);
+  response->AddMember<uint64_t>("platformMessageBytes", platform_message_bytes,
+                                allocator);
+  response->AddMember<uint64_t>("layerArenaBytes", layer_arena_bytes,
+                                allocator);
+  response->AddMember<uint64_t>(
+      "totalBytes",
+      raster_cache_layer_bytes + raster_cache_picture_bytes +
+          gpu_resource_cache_bytes + decoded_image_cache_bytes +
+          text_layout_cache_bytes + picture_bytes + image_bytes +
+          platform_message_bytes + layer_arena_bytes,
+      allocator);
+
+  // Only present when the shell is built with flutter_enable_allocation_tags.
+  if (fml::AllocationTags::IsEnabled()) {
+    rapidjson::Value allocation_tags(rapidjson::kObjectType);
+    for (size_t i = 0; i < static_cast<size_t>(fml::AllocationTag::kCount);
+         i++) {
+      const auto tag = static_cast<fml::AllocationTag>(i);
+      const fml::AllocationTagStats stats = fml::AllocationTags::GetStats(tag);
+      rapidjson::Value tag_stats(rapidjson::kObjectType);
+      tag_stats.AddMember<int64_t>("liveBytes", stats.live_bytes, allocator);
+      tag_stats.AddMember<int64_t>("liveAllocations", stats.live_allocations,
+                                   allocator);
+      tag_stats.AddMember<uint64_t>("totalBytes", stats.total_bytes,
+                                    allocator);
+      tag_stats.AddMember<uint64_t>("totalAllocations",
+                                    stats.total_allocations, allocator);
+      allocation_tags.AddMember(
+          rapidjson::StringRef(fml::AllocationTags::GetName(tag)), tag_stats,
+          allocator);
+    }
+    response->AddMember("allocationTags", allocation_tags, allocator);
+  }
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetStartupTimings(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  const StartupTimings timings = GetStartupTimings();
+  response->SetObject();
+  auto& allocator = response->GetAllocator();
+  response->AddMember("type", "StartupTimings", allocator);
+  response->AddMember("parallel", timings.parallel, allocator);
+  const std::pair<const char*, fml::TimeDelta> durations[] = {
+      {"snapshotMappingMicros", timings.snapshot_mapping},
+      {"vmCreationMicros", timings.vm_creation},
+      {"gpuSubsystemMicros", timings.gpu_subsystem},
+      {"platformViewMicros", timings.platform_view},
+      {"ioSubsystemMicros", timings.io_subsystem},
+      {"uiSubsystemMicros", timings.ui_subsystem},
+      {"fontManagerMicros", timings.font_manager},
+      {"totalMicros", timings.total},
+      {"isolateLaunchMicros", timings.isolate_launch},
+      {"firstBeginFrameMicros", timings.first_begin_frame},
+      {"firstFrameRasterizedMicros", timings.first_frame_rasterized},
+  };
+  for (const auto& [name, duration] : durations) {
+    response->AddMember<int64_t>(rapidjson::StringRef(name),
+                                 duration.ToMicroseconds(), allocator);
+  }
+  return true;
+}
+
+Shell::StartupTimings Shell::GetStartupTimings() const {
+  std::scoped_lock lock(startup_timings_mutex_);
+  return startup_timings_;
+}
+
+FrameTimingStatisticsSnapshot Shell::GetFrameTimingStatistics(bool reset) {
+  return frame_timing_statistics_.GetSnapshot(reset);
+}
+
+void Shell::DumpFlightRecorderIfJanky(const FrameTiming& timing) {
+  // Limits how much a persistently janky app writes to the file system.
+  constexpr fml::TimeDelta kMinDumpInterval = fml::TimeDelta::FromSeconds(30);
+
+  if (!fml::tracing::FlightRecorderIsEnabled() ||
+      settings_.flight_recorder_jank_threshold <= 0) {
+    return;
+  }
+  const fml::TimeDelta frame_time = timing.Get(FrameTiming::kRasterFinish) -
+                                    timing.Get(FrameTiming::kVsyncStart);
+  const fml::TimeDelta jank_time = fml::TimeDelta::FromMillisecondsF(
+      GetFrameBudget().count() * settings_.flight_recorder_jank_threshold);
+  const fml::TimePoint now = fml::TimePoint::Now();
+  if (frame_time <= jank_time ||
+      (last_flight_recorder_dump_time_ != fml::TimePoint() &&
+       now - last_flight_recorder_dump_time_ < kMinDumpInterval)) {
+    return;
+  }
+  last_flight_recorder_dump_time_ = now;
+
+  // Copy the events out right away, before the janky frame is overwritten,
+  // but leave formatting and writing them to the IO thread.
+  TRACE_EVENT0("flutter", "Shell::DumpFlightRecorder");
+
+  // The layer tree of the janky frame is only kept until the next frame, so
+  // it has to be serialized right away.
+  sk_sp<SkData> skp;
+  if (settings_.dump_skp_on_jank) {
+    skp = rasterizer_->ScreenshotLastLayerTree(
+                         Rasterizer::ScreenshotType::SkiaPicture, false)
+              .data;
+  }
+
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [events = fml::tracing::FlightRecorderSnapshot(), skp = std::move(skp),
+       frame_time_ms = frame_time.ToMillisecondsF()]() {
+        fml::UniqueFD caches_directory = fml::paths::GetCachesDirectory();
+        if (!caches_directory.is_valid()) {
+          return;
+        }
+        fml::DataMapping mapping(
+            fml::tracing::FlightRecorderEventsToJson(events));
+        if (fml::WriteAtomically(caches_directory, kFlightRecorderDumpFileName,
+                                 mapping)) {
+          FML_LOG(INFO) << "A frame took " << frame_time_ms
+                        << "ms. Dumped the recent trace events to "
+                        << kFlightRecorderDumpFileName
+                        << " in the caches directory.";
+        }
+        if (skp) {
+          fml::NonOwnedMapping skp_mapping(skp->bytes(), skp->size());
+          if (fml::WriteAtomically(caches_directory, kJankyFrameSkpFileName,
+                                   skp_mapping)) {
+            FML_LOG(INFO) << "Dumped the SKP of the frame to "
+                          << kJankyFrameSkpFileName
+                          << " in the caches directory.";
+          }
+        }
+      });
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1753,6 +2492,32 @@ Rasterizer::Screenshot Shell::Screenshot(
   return screenshot;
 }
 
+void Shell::ScreenshotNextFrameAsync(
+    Rasterizer::ScreenshotType type,
+    bool base64_encode,
+    std::function<void(Rasterizer::Screenshot)> callback) {
+  TRACE_EVENT0("flutter", "Shell::ScreenshotNextFrameAsync");
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [rasterizer = GetRasterizer(), type, base64_encode,
+       callback = std::move(callback)]() mutable {
+        if (!rasterizer) {
+          callback({});
+          return;
+        }
+        rasterizer->ScreenshotNextFrameAsync(type, base64_encode,
+                                             std::move(callback));
+      });
+  // Make sure that there is a next frame, without rebuilding the layer tree
+  // if the application does not change it anyway.
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = weak_engine_]() {
+        if (engine) {
+          engine->ScheduleFrame(/*regenerate_layer_tree=*/false);
+        }
+      });
+}
+
 fml::Status Shell::WaitForFirstFrame(fml::TimeDelta timeout) {
   FML_DCHECK(is_setup_);
   if (task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread() ||
@@ -1805,8 +2570,8 @@ bool Shell::ReloadSystemFonts() {
   std::string message = buffer.GetString();
   fml::RefPtr<PlatformMessage> fontsChangeMessage =
       fml::MakeRefCounted<flutter::PlatformMessage>(
-          kSystemChannel, std::vector<uint8_t>(message.begin(), message.end()),
-          nullptr);
+          kSystemChannel,
+          fml::MallocMapping::Copy(message.c_str(), message.length()), nullptr);
 
   OnPlatformViewDispatchPlatformMessage(fontsChangeMessage);
   return true;
@@ -1846,4 +2611,8 @@ void Shell::OnDisplayUpdates(DisplayUpdateType update_type,
   display_manager_->HandleDisplayUpdates(update_type, displays);
 }
 
+void Shell::SetViewDisplay(int64_t view_id, DisplayId display_id) {
+  display_manager_->SetViewDisplay(view_id, display_id);
+}
+
 }  // namespace flutter
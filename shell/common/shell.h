@@ -6,6 +6,7 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <future>
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
@@ -33,11 +34,18 @@
 #include "flutter/runtime/platform_data.h"
 #include "flutter/runtime/service_protocol.h"
 #include "flutter/shell/common/animator.h"
+#include "flutter/shell/common/begin_frame_delay_tuner.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_timing_statistics.h"
+#include "flutter/shell/common/memory_pressure_level.h"
+#include "flutter/shell/common/idle_frame_rate_tuner.h"
+#include "flutter/shell/common/pipeline_depth_tuner.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/shell_io_manager.h"
+#include "flutter/shell/common/skp_shader_warmup.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
 
 namespace flutter {
 
@@ -267,10 +275,29 @@ class Shell final : public PlatformView::Delegate,
 
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify that there is a low memory
-  ///             warning. The shell will attempt to purge caches. Current, only
-  ///             the rasterizer cache is purged.
+  ///             warning. This is the same as notifying critical memory
+  ///             pressure.
+  ///
+  /// @see        `NotifyMemoryPressure`
+  ///
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to notify that there is memory pressure.
+  ///             The shell purges caches according to the level:
+  ///
+  ///             - Moderate: the raster cache is trimmed to half its budget,
+  ///               Skia releases its scratch resources and the decoded image
+  ///               cache only keeps the images that are still in use.
+  ///             - Critical: all of these caches are purged and the Dart VM is
+  ///               told to collect garbage.
+  ///             - Background: the same as critical, as none of the caches
+  ///               are needed until the application is visible again.
+  ///
+  /// @param[in]  level  The level of the memory pressure.
+  ///
+  void NotifyMemoryPressure(MemoryPressureLevel level) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to check if all shell subcomponents are
   ///             initialized. It is the embedder's responsibility to make this
@@ -297,6 +324,25 @@ class Shell final : public PlatformView::Delegate,
   Rasterizer::Screenshot Screenshot(Rasterizer::ScreenshotType type,
                                     bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Captures a screenshot of the next frame without blocking the
+  ///             calling thread or the raster thread on the readback of its
+  ///             pixels. If no new frame is on its way, the last layer tree is
+  ///             drawn again. Suited to taking screenshots continuously, e.g.
+  ///             to stream the screen.
+  ///
+  /// @see        `Rasterizer::ScreenshotNextFrameAsync`
+  ///
+  /// @param[in]  type           The type of screenshot to capture.
+  /// @param[in]  base64_encode  If the screenshot data should be base64
+  ///                            encoded.
+  /// @param[in]  callback       Invoked with the screenshot on the IO thread.
+  ///
+  void ScreenshotNextFrameAsync(
+      Rasterizer::ScreenshotType type,
+      bool base64_encode,
+      std::function<void(Rasterizer::Screenshot)> callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Pauses the calling thread until the first frame is presented.
   ///
@@ -363,11 +409,69 @@ class Shell final : public PlatformView::Delegate,
   void OnDisplayUpdates(DisplayUpdateType update_type,
                         std::vector<Display> displays);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the display manager that the view moved to another
+  ///             display. Frames are paced at the refresh rate of the display
+  ///             of the implicit view.
+  ///
+  void SetViewDisplay(int64_t view_id, DisplayId display_id);
+
   //----------------------------------------------------------------------------
   /// @brief Queries the `DisplayManager` for the main display refresh rate.
   ///
   double GetMainDisplayRefreshRate();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The percentiles of the build, raster and vsync overhead times
+  ///             of the frames rasterized since the shell was created or the
+  ///             statistics were last reset. Can be called on any thread.
+  ///
+  /// @param[in]  reset  Whether to start collecting from scratch afterwards.
+  ///
+  FrameTimingStatisticsSnapshot GetFrameTimingStatistics(bool reset = false);
+
+  /// How long each step of bringing up the shell took. The subsystems are set
+  /// up on their own threads, so some of the steps overlap.
+  struct StartupTimings {
+    /// Whether |Settings::enable_parallel_shell_startup| was set.
+    bool parallel = false;
+    /// Mapping the VM and isolate snapshots from the settings.
+    fml::TimeDelta snapshot_mapping;
+    /// Creating or referencing the Dart VM. Close to zero if the VM was
+    /// already running for another shell.
+    fml::TimeDelta vm_creation;
+    /// Creating the rasterizer and its GPU context on the raster thread.
+    fml::TimeDelta gpu_subsystem;
+    /// Creating the platform view and vsync waiter on the platform thread.
+    fml::TimeDelta platform_view;
+    /// Creating the IO manager and its resource context on the IO thread.
+    fml::TimeDelta io_subsystem;
+    /// Creating the engine on the UI thread, which includes waiting for the
+    /// IO and GPU subsystems.
+    fml::TimeDelta ui_subsystem;
+    /// Creating the default font manager. Zero until it is done, which may be
+    /// after the shell was created.
+    fml::TimeDelta font_manager;
+    /// From the start of the shell creation on the platform thread until the
+    /// shell was set up.
+    fml::TimeDelta total;
+    /// Launching the root isolate when the engine was first run. Zero until
+    /// then.
+    fml::TimeDelta isolate_launch;
+    /// From the start of the shell creation until the first frame was begun
+    /// on the UI thread. Zero until then.
+    fml::TimeDelta first_begin_frame;
+    /// From the start of the shell creation until the first frame was
+    /// rasterized. Zero until then.
+    fml::TimeDelta first_frame_rasterized;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The durations of the steps of bringing up this shell. Can be
+  ///             called on any thread.
+  ///
+  StartupTimings GetStartupTimings() const;
+
  private:
   using ServiceProtocolHandler =
       std::function<bool(const ServiceProtocol::Handler::ServiceProtocolMap&,
@@ -410,8 +514,13 @@ class Shell final : public PlatformView::Delegate,
   // atomic.
   std::atomic<bool> needs_report_timings_{false};
 
+  // The highest frame rate that the application asked for with
+  // |OnEngineSetFrameRateRange|, or 0 if it has no opinion. Caps the frame
+  // budget, which is read on the raster thread.
+  std::atomic<double> max_requested_frame_rate_{0};
+
   // Whether there's a task scheduled to report the timings to Dart through
-  // ui.Window.onReportTimings.
+  // ui.Window.onReportTimings and to |Settings::frame_timings_report_callback|.
   bool frame_timings_report_scheduled_ = false;
 
   // Vector of FrameTiming::kCount * n timestamps for n frames whose timings
@@ -419,6 +528,54 @@ class Shell final : public PlatformView::Delegate,
   // here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // The timings not reported to |Settings::frame_timings_report_callback| yet.
+  // Only filled if that callback is set.
+  std::vector<FrameTiming> unreported_frame_timings_;
+
+  // Fed with frame timings on the raster thread and read by the animator on
+  // the UI thread. Only set if |Settings::enable_adaptive_pipeline_depth|.
+  std::shared_ptr<PipelineDepthTuner> pipeline_depth_tuner_;
+
+  // Fed with frame timings on the raster thread and read by the animator on
+  // the UI thread. Only set if |Settings::enable_just_in_time_begin_frame|.
+  std::shared_ptr<BeginFrameDelayTuner> begin_frame_delay_tuner_;
+
+  // Fed with frame damage on the raster thread and read by the animator on
+  // the UI thread. Only set if |Settings::idle_frame_rate| is positive.
+  std::shared_ptr<IdleFrameRateTuner> idle_frame_rate_tuner_;
+
+  // Fed with frame timings on the raster thread.
+  FrameTimingStatistics frame_timing_statistics_;
+
+  // Started on the platform thread when the engine is first run and told
+  // about the first frame on the raster thread. Only set if
+  // |Settings::warmup_skps|.
+  std::unique_ptr<SkpShaderWarmup> skp_shader_warmup_;
+
+  // Written on the platform thread during setup and then by the task that
+  // sets up the default font manager on the UI thread.
+  mutable std::mutex startup_timings_mutex_;
+  StartupTimings startup_timings_;
+  // When the shell creation started on the platform thread. Written before
+  // any of the subsystems are set up.
+  fml::TimePoint startup_start_;
+  // Only accessed on the UI thread.
+  bool first_begin_frame_recorded_ = false;
+  // Only accessed on the raster thread.
+  bool first_frame_rasterized_recorded_ = false;
+
+  // The default font manager and how long it took to create it on a worker
+  // thread while the rest of the shell was brought up. Only valid between the
+  // creation and the setup of the shell if
+  // |Settings::enable_parallel_shell_startup|.
+  std::future<std::pair<sk_sp<SkFontMgr>, fml::TimeDelta>>
+      default_font_manager_future_;
+
+  // When the flight recorder, and the SKP of the frame if
+  // |Settings::dump_skp_on_jank|, was last dumped after a janky frame. Only
+  // accessed on the raster thread.
+  fml::TimePoint last_flight_recorder_dump_time_;
+
   /// Manages the displays. This class is thread safe, can be accessed from any
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -430,6 +587,15 @@ class Shell final : public PlatformView::Delegate,
   // used to discard wrong size layer tree produced during interactive resizing
   SkISize expected_frame_size_ = SkISize::MakeEmpty();
 
+  // The textures that have a new frame available since the rasterizer last
+  // took them for a frame. They are added on the platform thread and taken on
+  // the raster thread.
+  std::mutex textures_with_new_frames_mutex_;
+  std::vector<int64_t> textures_with_new_frames_;
+  // Whether a frame was scheduled for the textures that has neither begun nor
+  // taken them yet. Guarded by textures_with_new_frames_mutex_.
+  bool texture_frame_scheduled_ = false;
+
   // How many frames have been timed since last report.
   size_t UnreportedFramesCount() const;
 
@@ -483,6 +649,10 @@ class Shell final : public PlatformView::Delegate,
   void OnPlatformViewDispatchPlatformMessage(
       fml::RefPtr<PlatformMessage> message) override;
 
+  // |PlatformView::Delegate|
+  void OnPlatformViewDispatchPlatformMessages(
+      std::vector<fml::RefPtr<PlatformMessage>> messages) override;
+
   // |PlatformView::Delegate|
   void OnPlatformViewDispatchPointerDataPacket(
       std::unique_ptr<PointerDataPacket> packet) override;
@@ -539,7 +709,7 @@ class Shell final : public PlatformView::Delegate,
   void OnAnimatorNotifyIdle(int64_t deadline) override;
 
   // |Animator::Delegate|
-  void OnAnimatorDraw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
+  void OnAnimatorDraw(fml::RefPtr<FramePipeline> pipeline,
                       fml::TimePoint frame_target_time) override;
 
   // |Animator::Delegate|
@@ -569,6 +739,9 @@ class Shell final : public PlatformView::Delegate,
   // |Engine::Delegate|
   void SetNeedsReportTimings(bool value) override;
 
+  // |Engine::Delegate|
+  void OnEngineSetFrameRateRange(const FrameRateRange& range) override;
+
   // |Engine::Delegate|
   std::unique_ptr<std::vector<std::string>> ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) override;
@@ -585,6 +758,9 @@ class Shell final : public PlatformView::Delegate,
   // |Rasterizer::Delegate|
   fml::TimePoint GetLatestFrameTargetTime() const override;
 
+  // |Rasterizer::Delegate|
+  void TakeTexturesWithNewFrames(std::vector<int64_t>* textures) override;
+
   // |ServiceProtocol::Handler|
   fml::RefPtr<fml::TaskRunner> GetServiceProtocolHandlerTaskRunner(
       std::string_view method) const override;
@@ -641,6 +817,41 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Returns the trace events in the flight recorder, in the Chrome trace event
+  // JSON format.
+  bool OnServiceProtocolGetFlightRecorderTrace(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the percentiles of the frame phase durations and the number of
+  // janky frames, and resets them if the "reset" parameter is "true".
+  bool OnServiceProtocolGetFrameTimingStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  bool OnServiceProtocolGetMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the durations of the steps of bringing up this shell, see
+  // |StartupTimings|.
+  bool OnServiceProtocolGetStartupTimings(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Writes the trace events in the flight recorder to the caches directory if
+  // |timing| is of a janky frame, at most once every few seconds. Also writes
+  // an SKP of the frame if |Settings::dump_skp_on_jank|. Must be called right
+  // after the frame is rasterized, while it is the last layer tree.
+  void DumpFlightRecorderIfJanky(const FrameTiming& timing);
+
   // Creates an asset bundle from the original settings asset path or
   // directory.
   std::unique_ptr<DirectoryAssetBundle> RestoreOriginalAssetResolver();
@@ -54,7 +54,9 @@ sk_sp<GrDirectContext> ShellIOManager::CreateCompatibleResourceLoadingContext(
 ShellIOManager::ShellIOManager(
     sk_sp<GrDirectContext> resource_context,
     std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
-    fml::RefPtr<fml::TaskRunner> unref_queue_task_runner)
+    fml::RefPtr<fml::TaskRunner> unref_queue_task_runner,
+    size_t decoded_image_cache_max_bytes,
+    size_t texture_upload_budget_bytes)
     : resource_context_(std::move(resource_context)),
       resource_context_weak_factory_(
           resource_context_
@@ -62,10 +64,18 @@ ShellIOManager::ShellIOManager(
                     resource_context_.get())
               : nullptr),
       unref_queue_(fml::MakeRefCounted<flutter::SkiaUnrefQueue>(
-          std::move(unref_queue_task_runner),
+          unref_queue_task_runner,
           fml::TimeDelta::FromMilliseconds(8),
           GetResourceContext())),
+      decoded_image_cache_(
+          decoded_image_cache_max_bytes > 0
+              ? std::make_shared<DecodedImageCache>(
+                    decoded_image_cache_max_bytes)
+              : nullptr),
       is_gpu_disabled_sync_switch_(is_gpu_disabled_sync_switch),
+      texture_upload_queue_(std::make_unique<TextureUploadQueue>(
+          std::move(unref_queue_task_runner),
+          texture_upload_budget_bytes)),
       weak_factory_(this) {
   if (!resource_context_) {
 #ifndef OS_FUCHSIA
@@ -77,6 +87,12 @@ ShellIOManager::ShellIOManager(
 }
 
 ShellIOManager::~ShellIOManager() {
+  // Image decoders may still reference the cache, but its images must be
+  // queued for release before the queue is drained.
+  if (decoded_image_cache_) {
+    decoded_image_cache_->Purge();
+  }
+
   // Last chance to drain the IO queue as the platform side reference to the
   // underlying OpenGL context may be going away.
   is_gpu_disabled_sync_switch_->Execute(
@@ -130,4 +146,9 @@ ShellIOManager::GetIsGpuDisabledSyncSwitch() {
   return is_gpu_disabled_sync_switch_;
 }
 
+// |IOManager|
+TextureUploadQueue* ShellIOManager::GetTextureUploadQueue() {
+  return texture_upload_queue_.get();
+}
+
 }  // namespace flutter
@@ -11,6 +11,8 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+#include "flutter/lib/ui/painting/texture_upload_queue.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
@@ -27,7 +29,9 @@ class ShellIOManager final : public IOManager {
   ShellIOManager(
       sk_sp<GrDirectContext> resource_context,
       std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
-      fml::RefPtr<fml::TaskRunner> unref_queue_task_runner);
+      fml::RefPtr<fml::TaskRunner> unref_queue_task_runner,
+      size_t decoded_image_cache_max_bytes,
+      size_t texture_upload_budget_bytes = 0);
 
   ~ShellIOManager() override;
 
@@ -56,10 +60,20 @@ class ShellIOManager final : public IOManager {
   // |IOManager|
   std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch() override;
 
+  // |IOManager|
+  TextureUploadQueue* GetTextureUploadQueue() override;
+
   sk_sp<GrDirectContext> GetSharedResourceContext() const {
     return resource_context_;
   };
 
+  // The cache of decoded images shared by the image decoders using this IO
+  // manager, or null if its budget is 0. Its images are released through the
+  // unref queue of this IO manager, so they are purged when it is collected.
+  std::shared_ptr<DecodedImageCache> GetDecodedImageCache() const {
+    return decoded_image_cache_;
+  }
+
  private:
   // Resource context management.
   sk_sp<GrDirectContext> resource_context_;
@@ -69,8 +83,14 @@ class ShellIOManager final : public IOManager {
   // Unref queue management.
   fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue_;
 
+  std::shared_ptr<DecodedImageCache> decoded_image_cache_;
+
   std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch_;
 
+  // Collected after the weak pointers to this IO manager are invalidated, so
+  // the uploads it still performs then deliver empty results.
+  std::unique_ptr<TextureUploadQueue> texture_upload_queue_;
+
   fml::WeakPtrFactory<ShellIOManager> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ShellIOManager);
@@ -259,6 +259,12 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kRunInView:
             shell->OnServiceProtocolRunInView(params, response);
             break;
+          case ServiceProtocolEnum::kGetMemoryUsage:
+            shell->OnServiceProtocolGetMemoryUsage(params, response);
+            break;
+          case ServiceProtocolEnum::kGetStartupTimings:
+            shell->OnServiceProtocolGetStartupTimings(params, response);
+            break;
         }
         finished.set_value(true);
       });
@@ -101,6 +101,8 @@ class ShellTest : public FixtureTest {
     kEstimateRasterCacheMemory,
     kSetAssetBundlePath,
     kRunInView,
+    kGetMemoryUsage,
+    kGetStartupTimings,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
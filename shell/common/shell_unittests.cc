@@ -5,6 +5,7 @@
 #define FML_USED_ON_EMBEDDER
 
 #include <algorithm>
+#include <atomic>
 #include <ctime>
 #include <functional>
 #include <future>
@@ -22,6 +23,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -59,6 +61,9 @@ class MockPlatformViewDelegate : public PlatformView::Delegate {
   MOCK_METHOD1(OnPlatformViewDispatchPlatformMessage,
                void(fml::RefPtr<PlatformMessage> message));
 
+  MOCK_METHOD1(OnPlatformViewDispatchPlatformMessages,
+               void(std::vector<fml::RefPtr<PlatformMessage>> messages));
+
   MOCK_METHOD1(OnPlatformViewDispatchPointerDataPacket,
                void(std::unique_ptr<PointerDataPacket> packet));
 
@@ -259,6 +264,65 @@ TEST_F(ShellTest, InitializeWithDifferentThreads) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, DisplayConfigurationChangesUpdateTheRefreshRate) {
+  Settings settings = CreateSettingsForFixture();
+  ThreadHost thread_host("io.flutter.test." + GetCurrentTestName() + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  auto shell = CreateShell(std::move(settings), task_runners);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  shell->OnDisplayUpdates(DisplayUpdateType::kStartup, {Display(60)});
+  EXPECT_EQ(shell->GetMainDisplayRefreshRate(), 60);
+
+  // The display switched to a higher refresh rate after start-up.
+  shell->OnDisplayUpdates(DisplayUpdateType::kConfigurationChanged,
+                          {Display(120)});
+  EXPECT_EQ(shell->GetMainDisplayRefreshRate(), 120);
+
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
+TEST_F(ShellTest, FrameBudgetFollowsTheDisplayOfTheView) {
+  Settings settings = CreateSettingsForFixture();
+  ThreadHost thread_host("io.flutter.test." + GetCurrentTestName() + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  auto shell = CreateShell(std::move(settings), task_runners);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  Rasterizer::Delegate& delegate = *shell;
+  Engine::Delegate& engine_delegate = *shell;
+
+  shell->OnDisplayUpdates(DisplayUpdateType::kStartup,
+                          {Display(1, 60), Display(2, 144, 48, 144)});
+  // Views are on the main display until they are placed on another one.
+  EXPECT_EQ(delegate.GetFrameBudget(), fml::RefreshRateToFrameBudget(60));
+
+  shell->SetViewDisplay(kFlutterImplicitViewId, 2);
+  EXPECT_EQ(delegate.GetFrameBudget(), fml::RefreshRateToFrameBudget(144));
+
+  // The variable refresh rate display follows the requested frame rate.
+  PostSync(task_runners.GetUITaskRunner(), [&engine_delegate]() {
+    engine_delegate.OnEngineSetFrameRateRange({.minimum = 0, .maximum = 90});
+  });
+  EXPECT_EQ(delegate.GetFrameBudget(), fml::RefreshRateToFrameBudget(90));
+
+  // The view falls back to the main display when its display goes away.
+  shell->OnDisplayUpdates(DisplayUpdateType::kConfigurationChanged,
+                          {Display(1, 60)});
+  EXPECT_EQ(delegate.GetFrameBudget(), fml::RefreshRateToFrameBudget(60));
+
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
 TEST_F(ShellTest, InitializeWithSingleThread) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
@@ -274,6 +338,32 @@ TEST_F(ShellTest, InitializeWithSingleThread) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, InitializeWithParallelStartup) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  Settings settings = CreateSettingsForFixture();
+  settings.enable_parallel_shell_startup = true;
+  ThreadHost thread_host("io.flutter.test." + GetCurrentTestName() + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  auto shell = CreateShell(std::move(settings), task_runners);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  // The default font manager is handed to the engine on the UI thread.
+  PostSync(task_runners.GetUITaskRunner(), [] {});
+  Shell::StartupTimings timings = shell->GetStartupTimings();
+  EXPECT_TRUE(timings.parallel);
+  EXPECT_GT(timings.total.ToNanoseconds(), 0);
+  EXPECT_GE(timings.total, timings.platform_view);
+  EXPECT_GE(timings.total, timings.ui_subsystem);
+
+  DestroyShell(std::move(shell), std::move(task_runners));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, InitializeWithSingleThreadWhichIsTheCallingThread) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
@@ -452,6 +542,17 @@ TEST_F(ShellTest, DisallowedDartVMFlag) {
   ASSERT_DEATH(flutter::SettingsFromCommandLine(command_line), expected);
 }
 
+TEST_F(ShellTest, DumpSkpOnJankIsOptIn) {
+  fml::CommandLine default_command_line("", {}, std::vector<std::string>());
+  EXPECT_FALSE(
+      flutter::SettingsFromCommandLine(default_command_line).dump_skp_on_jank);
+
+  const std::vector<fml::CommandLine::Option> options = {
+      fml::CommandLine::Option("dump-skp-on-jank", "")};
+  fml::CommandLine command_line("", options, std::vector<std::string>());
+  EXPECT_TRUE(flutter::SettingsFromCommandLine(command_line).dump_skp_on_jank);
+}
+
 TEST_F(ShellTest, AllowedDartVMFlag) {
   std::vector<const char*> flags = {
       "--enable-isolate-groups",
@@ -639,6 +740,38 @@ TEST_F(ShellTest, FrameRasterizedCallbackIsCalled) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, FrameTimingsReportCallbackIsCalledWithoutDart) {
+  fml::TimePoint start = fml::TimePoint::Now();
+
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent timingsLatch;
+  std::vector<FrameTiming> timings;
+  settings.frame_timings_report_callback =
+      [&timings, &timingsLatch](const std::vector<FrameTiming>& t) {
+        timings = t;
+        timingsLatch.Signal();
+      };
+
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  // The entrypoint does not set onReportTimings.
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+
+  // The timings of the first frame are reported right away.
+  timingsLatch.Wait();
+  fml::TimePoint finish = fml::TimePoint::Now();
+  ASSERT_EQ(timings.size(), 1u);
+  CheckFrameTimings(timings, start, finish);
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, ExternalEmbedderNoThreadMerger) {
   auto settings = CreateSettingsForFixture();
   fml::AutoResetWaitableEvent end_frame_latch;
@@ -1489,7 +1622,8 @@ TEST_F(ShellTest, SetResourceCacheSize) {
                                 "method": "Skia.setResourceCacheMaxBytes",
                                 "args": 10000
                               })json";
-  std::vector<uint8_t> data(request_json.begin(), request_json.end());
+  auto data =
+      fml::MallocMapping::Copy(request_json.c_str(), request_json.length());
   auto platform_message = fml::MakeRefCounted<PlatformMessage>(
       "flutter/skia", std::move(data), nullptr);
   SendEnginePlatformMessage(shell.get(), std::move(platform_message));
@@ -1682,6 +1816,122 @@ TEST_F(ShellTest, TextureFrameMarkedAvailableAndUnregister) {
   DestroyShell(std::move(shell), std::move(task_runners));
 }
 
+TEST_F(ShellTest, TexturesFrameMarkedAvailableOnceBeforeTheNextFrame) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  std::shared_ptr<fml::AutoResetWaitableEvent> latch =
+      std::make_shared<fml::AutoResetWaitableEvent>();
+
+  std::shared_ptr<MockTexture> mockTexture =
+      std::make_shared<MockTexture>(0, latch);
+  std::shared_ptr<fml::AutoResetWaitableEvent> otherLatch =
+      std::make_shared<fml::AutoResetWaitableEvent>();
+  std::shared_ptr<MockTexture> otherMockTexture =
+      std::make_shared<MockTexture>(1, otherLatch);
+
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(), [&]() {
+        shell->GetPlatformView()->RegisterTexture(mockTexture);
+        shell->GetPlatformView()->RegisterTexture(otherMockTexture);
+        shell->GetPlatformView()->MarkTextureFrameAvailable(0);
+        shell->GetPlatformView()->MarkTextureFrameAvailable(1);
+        shell->GetPlatformView()->MarkTextureFrameAvailable(0);
+        shell->GetPlatformView()->MarkTextureFrameAvailable(1);
+      });
+  latch->Wait();
+  otherLatch->Wait();
+
+  // The marks before the frame are coalesced, and each texture is marked.
+  fml::AutoResetWaitableEvent frame_latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(), [&]() {
+        EXPECT_EQ(mockTexture->frames_available(), 1);
+        EXPECT_EQ(otherMockTexture->frames_available(), 1);
+        frame_latch.Signal();
+      });
+  frame_latch.Wait();
+
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(), [&]() {
+        shell->GetPlatformView()->UnregisterTexture(0);
+        shell->GetPlatformView()->UnregisterTexture(1);
+      });
+  latch->Wait();
+  otherLatch->Wait();
+
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
+TEST_F(ShellTest, TextureFrameAvailableAfterDroppedFrameSchedulesFrame) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  // The frame begins without rendering anything, so it is dropped.
+  configuration.SetEntrypoint("onBeginFrameMain");
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  // Frames that began before the texture had a new frame are ignored.
+  std::atomic<bool> texture_frame_available(false);
+  fml::AutoResetWaitableEvent begin_frame_latch;
+  AddNativeCallback(
+      "NativeOnBeginFrame",
+      CREATE_NATIVE_ENTRY([&](auto args) {
+        if (texture_frame_available) {
+          begin_frame_latch.Signal();
+        }
+      }));
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  std::shared_ptr<fml::AutoResetWaitableEvent> latch =
+      std::make_shared<fml::AutoResetWaitableEvent>();
+
+  std::shared_ptr<MockTexture> mockTexture =
+      std::make_shared<MockTexture>(0, latch);
+
+  // The new texture frame is coalesced with the frame the new metrics
+  // schedule.
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetPlatformTaskRunner(), [&]() {
+        shell->GetPlatformView()->RegisterTexture(mockTexture);
+        shell->GetPlatformView()->SetViewportMetrics({1.0, 400, 200});
+        shell->GetPlatformView()->MarkTextureFrameAvailable(0);
+        texture_frame_available = true;
+      });
+  begin_frame_latch.Wait();
+
+  // The next new texture frame schedules a frame that marks the texture,
+  // rather than waiting for the dropped one forever.
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetPlatformTaskRunner(),
+      [&]() { shell->GetPlatformView()->MarkTextureFrameAvailable(0); });
+  latch->Wait();
+
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(),
+      [&]() { shell->GetPlatformView()->UnregisterTexture(0); });
+  latch->Wait();
+
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
 TEST_F(ShellTest, IsolateCanAccessPersistentIsolateData) {
   const std::string message = "dummy isolate launch data.";
 
@@ -1802,6 +2052,60 @@ TEST_F(ShellTest, Screenshot) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, ScreenshotNextFrameAsync) {
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent firstFrameLatch;
+  settings.frame_rasterized_callback =
+      [&firstFrameLatch](const FrameTiming& t) { firstFrameLatch.Signal(); };
+
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  LayerTreeBuilder builder = [&](std::shared_ptr<ContainerLayer> root) {
+    SkPictureRecorder recorder;
+    SkCanvas* recording_canvas =
+        recorder.beginRecording(SkRect::MakeXYWH(0, 0, 80, 80));
+    recording_canvas->drawRect(SkRect::MakeXYWH(0, 0, 80, 80),
+                               SkPaint(SkColor4f::FromColor(SK_ColorRED)));
+    auto sk_picture = recorder.finishRecordingAsPicture();
+    fml::RefPtr<SkiaUnrefQueue> queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+        this->GetCurrentTaskRunner(), fml::TimeDelta::Zero());
+    auto picture_layer = std::make_shared<PictureLayer>(
+        SkPoint::Make(10, 10),
+        flutter::SkiaGPUObject<SkPicture>({sk_picture, queue}), false, false);
+    root->Add(picture_layer);
+  };
+
+  PumpOneFrame(shell.get(), 100, 100, builder);
+  firstFrameLatch.Wait();
+
+  // The screenshot is taken of the last layer tree drawn again, as the
+  // application does not produce another frame.
+  std::promise<Rasterizer::Screenshot> screenshot_promise;
+  shell->ScreenshotNextFrameAsync(
+      Rasterizer::ScreenshotType::UncompressedImage, false,
+      [&screenshot_promise, &shell](Rasterizer::Screenshot screenshot) {
+        EXPECT_TRUE(shell->GetTaskRunners()
+                        .GetIOTaskRunner()
+                        ->RunsTasksOnCurrentThread());
+        screenshot_promise.set_value(std::move(screenshot));
+      });
+
+  Rasterizer::Screenshot screenshot = screenshot_promise.get_future().get();
+  ASSERT_NE(screenshot.data, nullptr);
+  ASSERT_EQ(screenshot.frame_size, SkISize::Make(100, 100));
+  ASSERT_EQ(screenshot.data->size(), 100u * 100u * 4u);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, CanConvertToAndFromMappings) {
   const size_t buffer_size = 2 << 20;
 
@@ -2034,6 +2338,48 @@ TEST_F(ShellTest, RasterizerMakeRasterSnapshot) {
   DestroyShell(std::move(shell), std::move(task_runners));
 }
 
+TEST_F(ShellTest, RasterizerMakeRasterSnapshotAsyncBatchesSnapshots) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  PumpOneFrame(shell.get());
+
+  // More snapshots than wait to be drawn at once, so that some are drawn right
+  // away and the others once the raster thread gets to them.
+  constexpr int kSnapshotCount = 20;
+  fml::CountDownLatch latch(kSnapshotCount);
+  std::atomic<int> image_count = 0;
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(), [&]() {
+        SnapshotDelegate* delegate =
+            reinterpret_cast<Rasterizer*>(shell->GetRasterizer().get());
+        for (int i = 0; i < kSnapshotCount; i++) {
+          delegate->MakeRasterSnapshotAsync(
+              SkPicture::MakePlaceholder({0, 0, 50, 50}),
+              SkISize::Make(50, 50), [&](sk_sp<SkImage> image) {
+                if (image && image->width() == 50 &&
+                    !image->isTextureBacked()) {
+                  image_count++;
+                }
+                latch.CountDown();
+              });
+        }
+      });
+  latch.Wait();
+  EXPECT_EQ(image_count, kSnapshotCount);
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
 static sk_sp<SkPicture> MakeSizedPicture(int width, int height) {
   SkPictureRecorder recorder;
   SkCanvas* recording_canvas =
@@ -2120,6 +2466,65 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetMemoryUsageWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetMemoryUsage,
+                    shell->GetTaskRunners().GetRasterTaskRunner(),
+                    empty_params, &document);
+
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_EQ(std::string(document["type"].GetString()), "MemoryUsage");
+  uint64_t total_bytes = 0;
+  for (const char* key :
+       {"rasterCacheLayerBytes", "rasterCachePictureBytes",
+        "gpuResourceCacheBytes", "decodedImageCacheBytes",
+        "textLayoutCacheBytes", "pictureBytes", "imageBytes",
+        "platformMessageBytes", "layerArenaBytes"}) {
+    ASSERT_TRUE(document.HasMember(key)) << key;
+    total_bytes += document[key].GetUint64();
+  }
+  ASSERT_EQ(document["totalBytes"].GetUint64(), total_bytes);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetStartupTimingsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetStartupTimings,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &document);
+
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_EQ(std::string(document["type"].GetString()), "StartupTimings");
+  for (const char* key :
+       {"snapshotMappingMicros", "vmCreationMicros", "gpuSubsystemMicros",
+        "platformViewMicros", "ioSubsystemMicros", "uiSubsystemMicros",
+        "fontManagerMicros", "totalMicros", "isolateLaunchMicros",
+        "firstBeginFrameMicros", "firstFrameRasterizedMicros"}) {
+    ASSERT_TRUE(document.HasMember(key)) << key;
+    ASSERT_GE(document[key].GetInt64(), 0) << key;
+  }
+  ASSERT_GT(document["totalMicros"].GetInt64(), 0);
+  ASSERT_EQ(shell->GetStartupTimings().isolate_launch.ToMicroseconds(),
+            document["isolateLaunchMicros"].GetInt64());
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, DiscardLayerTreeOnResize) {
   auto settings = CreateSettingsForFixture();
 
@@ -2402,6 +2807,85 @@ TEST_F(ShellTest, AssetManagerMulti) {
   }
 }
 
+TEST_F(ShellTest, AssetManagerLoadsAsynchronously) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kRead);
+
+  for (auto filename : {"asset0", "asset1"}) {
+    bool success = fml::WriteAtomically(asset_dir_fd, filename,
+                                        fml::DataMapping(filename));
+    ASSERT_TRUE(success);
+  }
+
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(
+      std::make_unique<DirectoryAssetBundle>(std::move(asset_dir_fd), false));
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  fml::Thread callback_thread("callback");
+  auto callback_task_runner = callback_thread.GetTaskRunner();
+  fml::AutoResetWaitableEvent latch;
+  std::vector<std::shared_ptr<fml::Mapping>> mappings;
+  // Requesting the same asset twice may share one load.
+  asset_manager->GetAsMappingsAsync(
+      {"asset0", "missing", "asset1", "asset0"}, loop->GetTaskRunner(),
+      callback_task_runner,
+      [&](std::vector<std::shared_ptr<fml::Mapping>> result) {
+        EXPECT_TRUE(callback_task_runner->RunsTasksOnCurrentThread());
+        mappings = std::move(result);
+        latch.Signal();
+      });
+  latch.Wait();
+
+  ASSERT_EQ(mappings.size(), 4u);
+  ASSERT_TRUE(mappings[0]);
+  ASSERT_FALSE(mappings[1]);
+  ASSERT_TRUE(mappings[2]);
+  ASSERT_TRUE(mappings[3]);
+  auto contents = [](const fml::Mapping& mapping) {
+    return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                       mapping.GetSize());
+  };
+  EXPECT_EQ(contents(*mappings[0]), "asset0");
+  EXPECT_EQ(contents(*mappings[2]), "asset1");
+  EXPECT_EQ(contents(*mappings[3]), "asset0");
+}
+
+TEST_F(ShellTest, AssetManagerLoadsWithTheResolversOfTheRequest) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kRead);
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, "asset0",
+                                   fml::DataMapping("asset0")));
+
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(
+      std::make_unique<DirectoryAssetBundle>(std::move(asset_dir_fd), false));
+
+  // Hold the only worker until the resolvers were taken away.
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  fml::AutoResetWaitableEvent resolvers_taken;
+  loop->GetTaskRunner()->PostTask([&]() { resolvers_taken.Wait(); });
+
+  fml::Thread callback_thread("callback");
+  fml::AutoResetWaitableEvent latch;
+  std::vector<std::shared_ptr<fml::Mapping>> mappings;
+  asset_manager->GetAsMappingsAsync(
+      {"asset0"}, loop->GetTaskRunner(), callback_thread.GetTaskRunner(),
+      [&](std::vector<std::shared_ptr<fml::Mapping>> result) {
+        mappings = std::move(result);
+        latch.Signal();
+      });
+  asset_manager->TakeResolvers();
+  resolvers_taken.Signal();
+  latch.Wait();
+
+  ASSERT_EQ(mappings.size(), 1u);
+  ASSERT_TRUE(mappings[0]);
+  ASSERT_FALSE(asset_manager->GetAsMapping("asset0"));
+}
+
 #if defined(OS_FUCHSIA)
 TEST_F(ShellTest, AssetManagerMultiSubdir) {
   std::string subdir_path = "subdir";
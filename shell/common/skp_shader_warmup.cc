@@ -0,0 +1,160 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/skp_shader_warmup.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+#include "flutter/fml/trace_event.h"
+#include "flutter/shell/common/serialization_callbacks.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+// The warmup surface is as large as the picture it draws, up to this size in
+// each dimension. Content outside of the surface is culled by Skia and would
+// not get its shaders compiled.
+static constexpr int kMaxSurfaceDimension = 2048;
+
+struct SkpShaderWarmup::State {
+  const fml::RefPtr<fml::TaskRunner> io_task_runner;
+  const fml::WeakPtr<IOManager> io_manager;
+
+  std::mutex mutex;
+  bool started = false;
+  bool first_frame_rasterized = false;
+  // The pictures that wait for the first frame to be rasterized.
+  std::vector<sk_sp<SkPicture>> deferred_pictures;
+
+  State(fml::RefPtr<fml::TaskRunner> io_task_runner,
+        fml::WeakPtr<IOManager> io_manager)
+      : io_task_runner(std::move(io_task_runner)),
+        io_manager(std::move(io_manager)) {}
+
+  void PostDrawPictures(std::vector<sk_sp<SkPicture>> pictures);
+};
+
+static std::vector<sk_sp<SkPicture>> DeserializePictures(
+    std::vector<std::unique_ptr<fml::Mapping>> mappings) {
+  std::vector<sk_sp<SkPicture>> pictures;
+  for (const auto& mapping : mappings) {
+    std::unique_ptr<SkMemoryStream> stream =
+        SkMemoryStream::MakeDirect(mapping->GetMapping(), mapping->GetSize());
+    SkDeserialProcs procs = {0};
+    procs.fImageProc = DeserializeImageWithoutData;
+    procs.fTypefaceProc = DeserializeTypefaceWithoutData;
+    sk_sp<SkPicture> picture = SkPicture::MakeFromStream(stream.get(), &procs);
+    if (!picture) {
+      FML_LOG(ERROR) << "Failed to deserialize a shader warmup SKP.";
+      continue;
+    }
+    pictures.push_back(std::move(picture));
+  }
+  return pictures;
+}
+
+SkpShaderWarmup::Pictures SkpShaderWarmup::LoadPictures(
+    const AssetManager& asset_manager) {
+  TRACE_EVENT0("flutter", "SkpShaderWarmup::LoadPictures");
+  const std::string prefix = kFirstRoutePrefix;
+  Pictures pictures;
+  pictures.first_route = DeserializePictures(
+      asset_manager.GetAsMappings(prefix + ".*\\.skp$", kAssetDirectory));
+  pictures.other = DeserializePictures(asset_manager.GetAsMappings(
+      "(?!" + prefix + ").*\\.skp$", kAssetDirectory));
+  FML_LOG(INFO) << "Shader warmup got " << pictures.first_route.size()
+                << " SKPs of the first route and " << pictures.other.size()
+                << " other SKPs.";
+  return pictures;
+}
+
+static void DrawPicture(const fml::WeakPtr<IOManager>& io_manager,
+                        const sk_sp<SkPicture>& picture) {
+  TRACE_EVENT0("flutter", "SkpShaderWarmup::DrawPicture");
+  if (!io_manager) {
+    return;
+  }
+  fml::WeakPtr<GrDirectContext> context = io_manager->GetResourceContext();
+  if (!context) {
+    return;
+  }
+  io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse([&context, &picture] {
+        const SkIRect bounds = picture->cullRect().roundOut();
+        const auto image_info = SkImageInfo::MakeN32Premul(
+            std::clamp(bounds.width(), 1, kMaxSurfaceDimension),
+            std::clamp(bounds.height(), 1, kMaxSurfaceDimension));
+        auto surface = SkSurface::MakeRenderTarget(
+            context.get(), SkBudgeted::kNo, image_info);
+        if (!surface) {
+          FML_LOG(ERROR) << "Could not create the shader warmup surface.";
+          return;
+        }
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->translate(-bounds.left(), -bounds.top());
+        canvas->drawPicture(picture);
+        surface->flushAndSubmit();
+      }));
+}
+
+void SkpShaderWarmup::State::PostDrawPictures(
+    std::vector<sk_sp<SkPicture>> pictures) {
+  // One task per picture lets the image uploads of the app run in between.
+  for (auto& picture : pictures) {
+    io_task_runner->PostTask(
+        [io_manager = io_manager, picture = std::move(picture)]() {
+          DrawPicture(io_manager, picture);
+        });
+  }
+}
+
+SkpShaderWarmup::SkpShaderWarmup(fml::RefPtr<fml::TaskRunner> io_task_runner,
+                                 fml::WeakPtr<IOManager> io_manager)
+    : state_(std::make_shared<State>(std::move(io_task_runner),
+                                     std::move(io_manager))) {}
+
+SkpShaderWarmup::~SkpShaderWarmup() = default;
+
+void SkpShaderWarmup::Start(
+    std::shared_ptr<AssetManager> asset_manager,
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner) {
+  if (!asset_manager || !worker_task_runner) {
+    return;
+  }
+  {
+    std::scoped_lock lock(state_->mutex);
+    if (state_->started) {
+      return;
+    }
+    state_->started = true;
+  }
+  worker_task_runner->PostTask([state = state_,
+                                asset_manager = std::move(asset_manager)]() {
+    Pictures pictures = LoadPictures(*asset_manager);
+    state->PostDrawPictures(std::move(pictures.first_route));
+    std::scoped_lock lock(state->mutex);
+    if (state->first_frame_rasterized) {
+      state->PostDrawPictures(std::move(pictures.other));
+    } else {
+      state->deferred_pictures = std::move(pictures.other);
+    }
+  });
+}
+
+void SkpShaderWarmup::OnFirstFrameRasterized() {
+  std::scoped_lock lock(state_->mutex);
+  if (state_->first_frame_rasterized) {
+    return;
+  }
+  state_->first_frame_rasterized = true;
+  state_->PostDrawPictures(std::move(state_->deferred_pictures));
+  state_->deferred_pictures.clear();
+}
+
+}  // namespace flutter
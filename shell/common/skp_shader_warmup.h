@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SKP_SHADER_WARMUP_H_
+#define FLUTTER_SHELL_COMMON_SKP_SHADER_WARMUP_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/assets/asset_manager.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/lib/ui/io_manager.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Compiles the shaders needed by the SKPs packaged with the application in
+/// the |kAssetDirectory| asset directory by drawing them into an offscreen
+/// surface of the resource context on the IO thread. Skia stores the compiled
+/// shaders in the |PersistentCache|, so the raster thread loads them instead
+/// of compiling them when the app first draws the same content. This replaces
+/// warming up shaders from Dart on the UI thread.
+///
+/// The SKPs whose name starts with |kFirstRoutePrefix| are meant to be
+/// recorded from the first route of the app. They are drawn as soon as they
+/// are loaded, so that they are likely warm before the first frame. The other
+/// SKPs are only drawn after the first frame was rasterized, so that they do
+/// not hold up the image uploads of the first frame.
+///
+class SkpShaderWarmup {
+ public:
+  static constexpr char kAssetDirectory[] = "shaders";
+  static constexpr char kFirstRoutePrefix[] = "first_route";
+
+  struct Pictures {
+    std::vector<sk_sp<SkPicture>> first_route;
+    std::vector<sk_sp<SkPicture>> other;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Loads and deserializes the SKPs of the |kAssetDirectory|
+  ///             asset directory. The images and typefaces in the SKPs are
+  ///             replaced by placeholders of the same size.
+  ///
+  static Pictures LoadPictures(const AssetManager& asset_manager);
+
+  SkpShaderWarmup(fml::RefPtr<fml::TaskRunner> io_task_runner,
+                  fml::WeakPtr<IOManager> io_manager);
+
+  ~SkpShaderWarmup();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Loads the SKPs on the worker task runner and then draws
+  ///             them on the IO task runner, one SKP per task. Only the first
+  ///             call has an effect.
+  ///
+  void Start(std::shared_ptr<AssetManager> asset_manager,
+             std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Lets the SKPs not recorded from the first route be drawn. May
+  ///             be called from any thread.
+  ///
+  void OnFirstFrameRasterized();
+
+ private:
+  struct State;
+
+  // Shared with the loading and drawing tasks, which may outlive this object.
+  const std::shared_ptr<State> state_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SkpShaderWarmup);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SKP_SHADER_WARMUP_H_
@@ -16,9 +16,11 @@
 #include "flutter/fml/unique_fd.h"
 #include "flutter/shell/common/serialization_callbacks.h"
 #include "flutter/shell/common/shell_test.h"
+#include "flutter/shell/common/skp_shader_warmup.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/version/version.h"
 #include "flutter/testing/testing.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
@@ -299,3 +301,46 @@ TEST_F(SkpWarmupTest, DISABLED_Text) {
 }  // namespace flutter
 
 #endif  // defined(OS_FUCHSIA)
+
+namespace flutter {
+namespace testing {
+
+static void WriteSkp(const fml::UniqueFD& directory,
+                     const std::string& name,
+                     SkScalar width) {
+  SkPictureRecorder recorder;
+  auto canvas = recorder.beginRecording(width, 10);
+  canvas->drawRect(SkRect::MakeWH(width, 10), SkPaint());
+  sk_sp<SkData> data = recorder.finishRecordingAsPicture()->serialize();
+  fml::DataMapping mapping(std::vector<uint8_t>{
+      data->bytes(), data->bytes() + data->size()});
+  ASSERT_TRUE(fml::WriteAtomically(directory, name.c_str(), mapping));
+}
+
+TEST(SkpShaderWarmupTest, LoadsFirstRouteSkpsSeparately) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD shaders_dir = fml::OpenDirectory(
+      asset_dir.fd(), SkpShaderWarmup::kAssetDirectory, true,
+      fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(shaders_dir.is_valid());
+  WriteSkp(shaders_dir, "a_settings.skp", 10);
+  WriteSkp(shaders_dir, "first_route_home.skp", 20);
+  WriteSkp(shaders_dir, "not_an_skp.txt", 30);
+
+  AssetManager asset_manager;
+  asset_manager.PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::OpenDirectory(asset_dir.path().c_str(), false,
+                         fml::FilePermission::kRead),
+      false));
+  auto pictures = SkpShaderWarmup::LoadPictures(asset_manager);
+  ASSERT_EQ(pictures.first_route.size(), 1u);
+  EXPECT_EQ(pictures.first_route[0]->cullRect().width(), 20);
+  ASSERT_EQ(pictures.other.size(), 1u);
+  EXPECT_EQ(pictures.other[0]->cullRect().width(), 10);
+
+  fml::RemoveDirectoryRecursively(asset_dir.fd(),
+                                  SkpShaderWarmup::kAssetDirectory);
+}
+
+}  // namespace testing
+}  // namespace flutter
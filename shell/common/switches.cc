@@ -226,6 +226,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_observatory_publication = !command_line.HasOption(
       FlagForSwitch(Switch::DisableObservatoryPublication));
 
+  settings.lazy_observatory_startup =
+      command_line.HasOption(FlagForSwitch(Switch::LazyObservatoryStartup));
+
   // Set Observatory Host
   if (command_line.HasOption(FlagForSwitch(Switch::DeviceObservatoryHost))) {
     command_line.GetOptionValue(FlagForSwitch(Switch::DeviceObservatoryHost),
@@ -304,6 +307,12 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_systrace =
       command_line.HasOption(FlagForSwitch(Switch::TraceSystrace));
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::TraceToFile),
+                              &settings.trace_to_file);
+
+  settings.enable_flight_recorder =
+      !command_line.HasOption(FlagForSwitch(Switch::DisableFlightRecorder));
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -352,6 +361,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         {snapshot_asset_path, isolate_snapshot_instr_filename});
   }
 
+  settings.prefault_snapshots =
+      command_line.HasOption(FlagForSwitch(Switch::PrefaultSnapshots));
+
   command_line.GetOptionValue(FlagForSwitch(Switch::CacheDirPath),
                               &settings.temp_directory_path);
 
@@ -373,6 +385,8 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
       };
 #endif
     }
+    settings.lazy_icu_initialization =
+        command_line.HasOption(FlagForSwitch(Switch::LazyICUInitialization));
   }
 
   settings.use_test_fonts =
@@ -381,6 +395,12 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_skparagraph =
       command_line.HasOption(FlagForSwitch(Switch::EnableSkParagraph));
 
+  settings.enable_display_list =
+      command_line.HasOption(FlagForSwitch(Switch::EnableDisplayList));
+
+  settings.enable_yuv_image_decoding =
+      command_line.HasOption(FlagForSwitch(Switch::EnableYUVImageDecoding));
+
   std::string all_dart_flags;
   if (command_line.GetOptionValue(FlagForSwitch(Switch::DartFlags),
                                   &all_dart_flags)) {
@@ -403,18 +423,161 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.dump_skp_on_shader_compilation =
       command_line.HasOption(FlagForSwitch(Switch::DumpSkpOnShaderCompilation));
 
+  settings.warmup_skps =
+      command_line.HasOption(FlagForSwitch(Switch::WarmupSkps));
+
+  settings.dump_skp_on_jank =
+      command_line.HasOption(FlagForSwitch(Switch::DumpSkpOnJank));
+
   settings.cache_sksl =
       command_line.HasOption(FlagForSwitch(Switch::CacheSkSL));
 
   settings.purge_persistent_cache =
       command_line.HasOption(FlagForSwitch(Switch::PurgePersistentCache));
 
+  GetSwitchValue(command_line, Switch::PersistentCacheMaxUnusedLaunches,
+                 &settings.persistent_cache_max_unused_launches);
+
+  settings.persist_fallback_font_cache =
+      command_line.HasOption(FlagForSwitch(Switch::PersistFallbackFontCache));
+
   if (command_line.HasOption(FlagForSwitch(Switch::OldGenHeapSize))) {
     std::string old_gen_heap_size;
     command_line.GetOptionValue(FlagForSwitch(Switch::OldGenHeapSize),
                                 &old_gen_heap_size);
     settings.old_gen_heap_size = std::stoi(old_gen_heap_size);
   }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::IsolatePoolSize))) {
+    std::string isolate_pool_size;
+    command_line.GetOptionValue(FlagForSwitch(Switch::IsolatePoolSize),
+                                &isolate_pool_size);
+    settings.isolate_pool_size = std::stoul(isolate_pool_size);
+  }
+
+  settings.enable_async_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAsyncRasterCache));
+
+  settings.enable_persistent_raster_cache = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePersistentRasterCache));
+
+  settings.compress_persistent_raster_cache = command_line.HasOption(
+      FlagForSwitch(Switch::CompressPersistentRasterCache));
+
+  settings.acquire_metal_drawable_at_present = command_line.HasOption(
+      FlagForSwitch(Switch::AcquireMetalDrawableAtPresent));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::MetalMaximumDrawableCount))) {
+    std::string metal_maximum_drawable_count;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::MetalMaximumDrawableCount),
+        &metal_maximum_drawable_count);
+    settings.metal_maximum_drawable_count =
+        std::stoul(metal_maximum_drawable_count);
+  }
+
+  settings.enable_platform_view_transactions = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePlatformViewTransactions));
+
+  settings.enable_adaptive_pipeline_depth = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptivePipelineDepth));
+
+  settings.enable_just_in_time_begin_frame = command_line.HasOption(
+      FlagForSwitch(Switch::EnableJustInTimeBeginFrame));
+
+  std::string idle_frame_rate;
+  if (command_line.GetOptionValue(FlagForSwitch(Switch::IdleFrameRate),
+                                  &idle_frame_rate)) {
+    settings.idle_frame_rate = std::stod(idle_frame_rate);
+  }
+
+  settings.enable_parallel_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableParallelPreroll));
+
+  settings.enable_tiled_software_paint =
+      command_line.HasOption(FlagForSwitch(Switch::EnableTiledSoftwarePaint));
+
+  settings.enable_threaded_present =
+      command_line.HasOption(FlagForSwitch(Switch::EnableThreadedPresent));
+
+  settings.drop_stale_frames =
+      command_line.HasOption(FlagForSwitch(Switch::DropStaleFrames));
+
+  settings.enable_parallel_shell_startup = command_line.HasOption(
+      FlagForSwitch(Switch::EnableParallelShellStartup));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::RasterCacheMaxBytes))) {
+    std::string raster_cache_max_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheMaxBytes),
+                                &raster_cache_max_bytes);
+    settings.raster_cache_max_bytes = std::stoull(raster_cache_max_bytes);
+  }
+
+  settings.adaptive_gpu_memory_budget = command_line.HasOption(
+      FlagForSwitch(Switch::AdaptiveGpuMemoryBudget));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::GpuMemoryLimitBytes))) {
+    std::string gpu_memory_limit_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::GpuMemoryLimitBytes),
+                                &gpu_memory_limit_bytes);
+    settings.gpu_memory_limit_bytes = std::stoull(gpu_memory_limit_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::RasterCacheScaleTolerance))) {
+    std::string raster_cache_scale_tolerance;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::RasterCacheScaleTolerance),
+        &raster_cache_scale_tolerance);
+    settings.raster_cache_scale_tolerance =
+        std::stod(raster_cache_scale_tolerance);
+  }
+
+  settings.raster_cache_scale_mipmaps =
+      command_line.HasOption(FlagForSwitch(Switch::RasterCacheScaleMipmaps));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::DecodedImageCacheMaxBytes))) {
+    std::string decoded_image_cache_max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::DecodedImageCacheMaxBytes),
+        &decoded_image_cache_max_bytes);
+    settings.decoded_image_cache_max_bytes =
+        std::stoull(decoded_image_cache_max_bytes);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::TextureUploadBudgetBytes))) {
+    std::string texture_upload_budget_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::TextureUploadBudgetBytes),
+                                &texture_upload_budget_bytes);
+    settings.texture_upload_budget_bytes =
+        std::stoull(texture_upload_budget_bytes);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::ImageGCThresholdBytes))) {
+    std::string image_gc_threshold_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::ImageGCThresholdBytes),
+                                &image_gc_threshold_bytes);
+    settings.image_gc_threshold_bytes = std::stoull(image_gc_threshold_bytes);
+  }
+
+  settings.share_spawned_engine_caches = command_line.HasOption(
+      FlagForSwitch(Switch::ShareSpawnedEngineCaches));
+
+  settings.load_assets_asynchronously = command_line.HasOption(
+      FlagForSwitch(Switch::LoadAssetsAsynchronously));
+
+  settings.resample_pointer_events =
+      command_line.HasOption(FlagForSwitch(Switch::ResamplePointerEvents));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::TextLayoutCacheMaxBytes))) {
+    std::string text_layout_cache_max_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::TextLayoutCacheMaxBytes),
+                                &text_layout_cache_max_bytes);
+    settings.text_layout_cache_max_bytes =
+        std::stoll(text_layout_cache_max_bytes);
+  }
   return settings;
 }
 
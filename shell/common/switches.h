@@ -49,6 +49,10 @@ DEF_SWITCH(IsolateSnapshotInstructions,
            "isolate-snapshot-instr",
            "The isolate instructions snapshot that will be memory mapped as "
            "read and executable. SnapshotAssetPath must be present.")
+DEF_SWITCH(PrefaultSnapshots,
+           "prefault-snapshots",
+           "Read the snapshot files into memory on a background thread as soon "
+           "as they are mapped, instead of paging them in as they are used.")
 DEF_SWITCH(CacheDirPath,
            "cache-dir-path",
            "Path to the cache directory. "
@@ -62,6 +66,10 @@ DEF_SWITCH(ICUSymbolPrefix,
 DEF_SWITCH(ICUNativeLibPath,
            "icu-native-lib-path",
            "Path to the library file that exports the ICU data.")
+DEF_SWITCH(LazyICUInitialization,
+           "lazy-icu-initialization",
+           "Initialize ICU off the startup path of the shell, and at the "
+           "latest when the first paragraph is built.")
 DEF_SWITCH(DartFlags,
            "dart-flags",
            "Flags passed directly to the Dart VM without being interpreted "
@@ -82,6 +90,10 @@ DEF_SWITCH(DisableObservatory,
 DEF_SWITCH(DisableObservatoryPublication,
            "disable-observatory-publication",
            "Disable mDNS Dart Observatory publication.")
+DEF_SWITCH(LazyObservatoryStartup,
+           "lazy-observatory-startup",
+           "Only start the Dart Observatory when the embedder asks for it, "
+           "instead of as the Dart VM starts.")
 DEF_SWITCH(IPv6,
            "ipv6",
            "Bind to the IPv6 localhost address for the Dart Observatory. "
@@ -145,6 +157,18 @@ DEF_SWITCH(DumpSkpOnShaderCompilation,
            "Automatically dump the skp that triggers new shader compilations. "
            "This is useful for writing custom ShaderWarmUp to reduce jank. "
            "By default, this is not enabled to reduce the overhead. ")
+DEF_SWITCH(WarmupSkps,
+           "warmup-skps",
+           "Draw the SKPs packaged with the app in the shaders asset directory "
+           "into an offscreen surface of the IO thread at launch, so that the "
+           "shaders they need are compiled before the app draws them. SKPs "
+           "named first_route*.skp are drawn first, the other ones after the "
+           "first frame.")
+DEF_SWITCH(DumpSkpOnJank,
+           "dump-skp-on-jank",
+           "Dump the skp of a frame that is janky enough to dump the flight "
+           "recorder to the caches directory, next to the trace events. By "
+           "default, this is not enabled to reduce the overhead.")
 DEF_SWITCH(CacheSkSL,
            "cache-sksl",
            "Only cache the shader in SkSL instead of binary or GLSL. This "
@@ -155,12 +179,33 @@ DEF_SWITCH(PurgePersistentCache,
            "purge-persistent-cache",
            "Remove all existing persistent cache. This is mainly for debugging "
            "purposes such as reproducing the shader compilation jank.")
+DEF_SWITCH(PersistentCacheMaxUnusedLaunches,
+           "persistent-cache-max-unused-launches",
+           "Remove the persistent shader cache entries that were not used "
+           "during more than this many launches of the app, e.g. because an "
+           "update of the app no longer draws them. By default, no entries "
+           "are removed.")
+DEF_SWITCH(PersistFallbackFontCache,
+           "persist-fallback-font-cache",
+           "Save the fallback fonts resolved for the code points shown by the "
+           "app in the persistent cache directory, so that the next launch "
+           "does not have to ask the platform for them again.")
 DEF_SWITCH(
     TraceSystrace,
     "trace-systrace",
     "Trace to the system tracer (instead of the timeline) on platforms where "
     "such a tracer is available. Currently only supported on Android and "
     "Fuchsia.")
+DEF_SWITCH(TraceToFile,
+           "trace-to-file",
+           "Record the trace events of the engine without the Dart VM service "
+           "and write them to the given file as a Perfetto trace when the "
+           "shell is destroyed. The trace can be opened in ui.perfetto.dev.")
+DEF_SWITCH(DisableFlightRecorder,
+           "disable-flight-recorder",
+           "Do not keep the most recent trace events in memory to dump them "
+           "when a frame is janky or when asked to through the service "
+           "protocol.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -202,9 +247,143 @@ DEF_SWITCH(
 DEF_SWITCH(OldGenHeapSize,
            "old-gen-heap-size",
            "The size limit in megabytes for the Dart VM old gen heap space.")
+DEF_SWITCH(IsolatePoolSize,
+           "isolate-pool-size",
+           "The number of background isolates that are spawned ahead of time "
+           "for Dart code to check out through IsolatePool in dart:ui.")
+DEF_SWITCH(RasterCacheMaxBytes,
+           "raster-cache-max-bytes",
+           "The number of bytes of raster cache images that may be retained "
+           "across frames. Unused entries are evicted least recently used "
+           "first once the budget is exceeded. By default, entries not drawn "
+           "in a frame are evicted at the end of that frame.")
+DEF_SWITCH(AdaptiveGpuMemoryBudget,
+           "adaptive-gpu-memory-budget",
+           "Size the budgets of Skia's resource cache and of the raster cache "
+           "together from the memory of the device, the frame size and how "
+           "much either cache churns. Overrides --raster-cache-max-bytes.")
+DEF_SWITCH(GpuMemoryLimitBytes,
+           "gpu-memory-limit-bytes",
+           "The memory the platform allows the application to use, that the "
+           "adaptive GPU memory budget stays within.")
+DEF_SWITCH(RasterCacheScaleTolerance,
+           "raster-cache-scale-tolerance",
+           "How far the scale a picture or layer is drawn at may differ from "
+           "the one of a raster cache image, e.g. 0.25 for 25%, for it to be "
+           "drawn from that image while no image at its own scale is ready. "
+           "By default, images are only drawn at their own scale.")
+DEF_SWITCH(RasterCacheScaleMipmaps,
+           "raster-cache-scale-mipmaps",
+           "Build mip levels for raster cache images so that they are sampled "
+           "smoothly when drawn scaled down under the scale tolerance.")
+DEF_SWITCH(EnableAsyncRasterCache,
+           "enable-async-raster-cache",
+           "Rasterize pictures that are worth caching on the IO thread instead "
+           "of during the frame on the raster thread. The pictures are drawn "
+           "directly until their raster cache entry is ready.")
+DEF_SWITCH(EnablePersistentRasterCache,
+           "enable-persistent-raster-cache",
+           "Store the images the raster cache rasterizes pictures into in the "
+           "persistent cache directory, so that later launches upload them "
+           "instead of rasterizing the same pictures again.")
+DEF_SWITCH(CompressPersistentRasterCache,
+           "compress-persistent-raster-cache",
+           "Compress the images stored across launches by the raster cache. "
+           "They take less space but take longer to load.")
+DEF_SWITCH(AcquireMetalDrawableAtPresent,
+           "acquire-metal-drawable-at-present",
+           "Render each frame of a Metal surface into an intermediate texture "
+           "and only acquire the next drawable of its CAMetalLayer when "
+           "presenting the frame, instead of before rendering it.")
+DEF_SWITCH(MetalMaximumDrawableCount,
+           "metal-maximum-drawable-count",
+           "The maximum number of drawables of the CAMetalLayers of Metal "
+           "surfaces, either 2 or 3. By default, the layer's own default is "
+           "kept.")
+DEF_SWITCH(EnablePlatformViewTransactions,
+           "enable-platform-view-transactions",
+           "Composite Android platform views on the raster thread and post "
+           "their mutations to the platform thread once per frame, instead of "
+           "merging the raster and platform threads while platform views are "
+           "displayed.")
+DEF_SWITCH(EnableAdaptivePipelineDepth,
+           "enable-adaptive-pipeline-depth",
+           "Adjust the number of frames in flight between the UI and raster "
+           "threads based on their observed frame times. Favors latency while "
+           "a frame fits in the frame budget and throughput otherwise.")
+DEF_SWITCH(EnableJustInTimeBeginFrame,
+           "enable-just-in-time-begin-frame",
+           "Begin frames after their vsync, late enough that they are "
+           "predicted to finish just before their target time based on the "
+           "observed frame times. Lowers the latency from input to display.")
+DEF_SWITCH(IdleFrameRate,
+           "idle-frame-rate",
+           "Lower the frame rate to this many frames per second while only "
+           "a small part of the screen changes, such as for a blinking cursor, "
+           "and skip drawing frames that did not change. Saves power on "
+           "displays that are always on.")
+DEF_SWITCH(EnableParallelPreroll,
+           "enable-parallel-preroll",
+           "Preroll layers with many children concurrently on the worker "
+           "threads instead of only on the raster thread.")
+DEF_SWITCH(EnableTiledSoftwarePaint,
+           "enable-tiled-software-paint",
+           "When rendering in software, record each frame first and then paint "
+           "it in tiles concurrently on the worker threads.")
+DEF_SWITCH(EnableThreadedPresent,
+           "enable-threaded-present",
+           "Present frames on a dedicated thread while the raster thread "
+           "prerolls the next frame. Only software rendering supports it.")
+DEF_SWITCH(DropStaleFrames,
+           "drop-stale-frames",
+           "When the raster thread falls behind, draw only the newest frame "
+           "and drop the frames produced before it.")
+DEF_SWITCH(EnableParallelShellStartup,
+           "enable-parallel-shell-startup",
+           "Bring up the independent parts of the shell, such as the default "
+           "font manager, in parallel on different threads.")
+DEF_SWITCH(DecodedImageCacheMaxBytes,
+           "decoded-image-cache-max-bytes",
+           "The number of bytes of decoded images that are retained so that "
+           "the same encoded image decoded at the same size is shared instead "
+           "of decoded again. By default, decoded images are not cached.")
+DEF_SWITCH(TextureUploadBudgetBytes,
+           "texture-upload-budget-bytes",
+           "The number of bytes of decoded images uploaded to the GPU per "
+           "frame interval. Further uploads wait for the next interval. By "
+           "default, images are uploaded as soon as they are decoded.")
+DEF_SWITCH(ImageGCThresholdBytes,
+           "image-gc-threshold-bytes",
+           "The number of bytes of live images above which the Dart VM is "
+           "hinted to collect garbage when the UI thread is idle.")
+DEF_SWITCH(ShareSpawnedEngineCaches,
+           "share-spawned-engine-caches",
+           "Let the shells spawned from a shell share its caches of decoded "
+           "images and raster cache entries.")
+DEF_SWITCH(LoadAssetsAsynchronously,
+           "load-assets-asynchronously",
+           "Read the assets requested over the asset channel on worker "
+           "threads instead of the UI thread.")
+DEF_SWITCH(TextLayoutCacheMaxBytes,
+           "text-layout-cache-max-bytes",
+           "The number of bytes of shaped words that are retained by the "
+           "text layout cache shared by every engine in the process.")
+DEF_SWITCH(ResamplePointerEvents,
+           "resample-pointer-events",
+           "Coalesce the pointer moves between frames into one move per "
+           "pointer that is resampled to the target time of the frame.")
 DEF_SWITCH(EnableSkParagraph,
            "enable-skparagraph",
            "Selects the SkParagraph implementation of the text layout engine.")
+DEF_SWITCH(EnableDisplayList,
+           "enable-display-list",
+           "Records pictures into engine display lists instead of SkPictures, "
+           "which are cheaper to record, compare and cull on playback.")
+DEF_SWITCH(EnableYUVImageDecoding,
+           "enable-yuv-image-decoding",
+           "Decodes the images that support it into their YUV planes, which "
+           "are converted to RGB by the GPU when they are first drawn. This "
+           "halves the memory and upload size of JPEGs.")
 
 DEF_SWITCHES_END
 
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/thread_host.h"
 
+#include <utility>
+
 namespace flutter {
 
 ThreadHost::ThreadHost() = default;
@@ -11,25 +13,42 @@ ThreadHost::ThreadHost() = default;
 ThreadHost::ThreadHost(ThreadHost&&) = default;
 
 ThreadHost::ThreadHost(std::string name_prefix_arg, uint64_t mask)
-    : name_prefix(name_prefix_arg) {
+    : ThreadHost(std::move(name_prefix_arg), mask, {}) {}
+
+ThreadHost::ThreadHost(std::string name_prefix_arg,
+                       uint64_t mask,
+                       const ThreadConfigs& configs)
+    : name_prefix(std::move(name_prefix_arg)) {
+  auto create_thread = [&](Type type, const std::string& suffix) {
+    fml::Thread::ThreadConfig config;
+    auto found = configs.find(type);
+    if (found != configs.end()) {
+      config = found->second;
+    }
+    if (config.name.empty()) {
+      config.name = name_prefix + suffix;
+    }
+    return std::make_unique<fml::Thread>(config);
+  };
+
   if (mask & ThreadHost::Type::Platform) {
-    platform_thread = std::make_unique<fml::Thread>(name_prefix + ".platform");
+    platform_thread = create_thread(ThreadHost::Type::Platform, ".platform");
   }
 
   if (mask & ThreadHost::Type::UI) {
-    ui_thread = std::make_unique<fml::Thread>(name_prefix + ".ui");
+    ui_thread = create_thread(ThreadHost::Type::UI, ".ui");
   }
 
   if (mask & ThreadHost::Type::RASTER) {
-    raster_thread = std::make_unique<fml::Thread>(name_prefix + ".raster");
+    raster_thread = create_thread(ThreadHost::Type::RASTER, ".raster");
   }
 
   if (mask & ThreadHost::Type::IO) {
-    io_thread = std::make_unique<fml::Thread>(name_prefix + ".io");
+    io_thread = create_thread(ThreadHost::Type::IO, ".io");
   }
 
   if (mask & ThreadHost::Type::Profiler) {
-    profiler_thread = std::make_unique<fml::Thread>(name_prefix + ".profiler");
+    profiler_thread = create_thread(ThreadHost::Type::Profiler, ".profiler");
   }
 }
 
@@ -5,7 +5,9 @@
 #ifndef FLUTTER_SHELL_COMMON_THREAD_HOST_H_
 #define FLUTTER_SHELL_COMMON_THREAD_HOST_H_
 
+#include <map>
 #include <memory>
+#include <string>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/thread.h"
@@ -22,6 +24,11 @@ struct ThreadHost {
     Profiler = 1 << 4,
   };
 
+  /// The configurations of the threads to create, by type. The threads
+  /// without a configuration, or without a name in it, are named after the
+  /// name prefix and their type.
+  using ThreadConfigs = std::map<Type, fml::Thread::ThreadConfig>;
+
   std::string name_prefix;
   std::unique_ptr<fml::Thread> platform_thread;
   std::unique_ptr<fml::Thread> ui_thread;
@@ -37,6 +44,10 @@ struct ThreadHost {
 
   ThreadHost(std::string name_prefix, uint64_t type_mask);
 
+  ThreadHost(std::string name_prefix,
+             uint64_t type_mask,
+             const ThreadConfigs& configs);
+
   ~ThreadHost();
 };
 
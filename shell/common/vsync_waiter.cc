@@ -98,6 +98,7 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
 
   {
     std::scoped_lock lock(callback_mutex_);
+    last_frame_target_time_ = frame_target_time;
     callback = std::move(callback_);
     for (auto& pair : secondary_callbacks_) {
       secondary_callbacks.push_back(std::move(pair.second));
@@ -127,7 +128,7 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
 
     TRACE_FLOW_BEGIN("flutter", kVsyncFlowName, flow_identifier);
 
-    task_runners_.GetUITaskRunner()->PostTaskForTime(
+    task_runners_.GetUITaskRunner()->PostTaskWithPriority(
         [this, callback, flow_identifier, frame_start_time, frame_target_time,
          pause_secondary_tasks]() {
           FML_TRACE_EVENT("flutter", kVsyncTraceName, "StartTime",
@@ -138,7 +139,7 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
             ResumeDartMicroTasks();
           }
         },
-        frame_start_time);
+        frame_start_time, fml::TaskPriority::kFrameCritical);
   }
 
   for (auto& secondary_callback : secondary_callbacks) {
@@ -147,6 +148,11 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
   }
 }
 
+fml::TimePoint VsyncWaiter::GetLastFrameTargetTime() {
+  std::scoped_lock lock(callback_mutex_);
+  return last_frame_target_time_;
+}
+
 void VsyncWaiter::PauseDartMicroTasks() {
   auto ui_task_queue_id = task_runners_.GetUITaskRunner()->GetTaskQueueId();
   auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
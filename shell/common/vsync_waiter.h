@@ -15,6 +15,29 @@
 
 namespace flutter {
 
+/// A range of frame rates, in frames per second, that the content on screen
+/// asks to be shown at.
+struct FrameRateRange {
+  /// The lowest acceptable frame rate.
+  double minimum = 0;
+  /// The highest useful frame rate, or 0 if the content has no opinion on the
+  /// frame rate, in which case frames are shown at the rate of the display.
+  double maximum = 0;
+  /// The frame rate to show frames at if the display supports it.
+  double preferred = 0;
+
+  bool IsUnspecified() const { return maximum <= 0; }
+
+  bool operator==(const FrameRateRange& other) const {
+    return minimum == other.minimum && maximum == other.maximum &&
+           preferred == other.preferred;
+  }
+
+  bool operator!=(const FrameRateRange& other) const {
+    return !(*this == other);
+  }
+};
+
 /// Abstract Base Class that represents a platform specific mechanism for
 /// getting callbacks when a vsync event happens.
 class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
@@ -32,6 +55,15 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// |Animator::ScheduleMaybeClearTraceFlowIds|.
   void ScheduleSecondaryCallback(uintptr_t id, const fml::closure& callback);
 
+  /// The time by which the frame of the last vsync was meant to be displayed,
+  /// which secondary callbacks can use as the target time of their frame.
+  fml::TimePoint GetLastFrameTargetTime();
+
+  /// Asks for vsync to be delivered at a rate within |range| from the next
+  /// vsync on, on displays that run at variable refresh rates. Called on the UI
+  /// thread. The default implementation ignores the range.
+  virtual void SetFrameRateRange(const FrameRateRange& range) {}
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -56,6 +88,7 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   std::mutex callback_mutex_;
   Callback callback_;
   std::unordered_map<uintptr_t, fml::closure> secondary_callbacks_;
+  fml::TimePoint last_frame_target_time_;
 
   void PauseDartMicroTasks();
   void ResumeDartMicroTasks();
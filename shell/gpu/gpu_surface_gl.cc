@@ -252,15 +252,24 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGL::AcquireFrame(const SkISize& size) {
   SurfaceFrame::SubmitCallback submit_callback =
       [weak = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
                                           SkCanvas* canvas) {
-        return weak ? weak->PresentSurface(canvas) : false;
+        return weak ? weak->PresentSurface(surface_frame, canvas) : false;
       };
 
-  return std::make_unique<SurfaceFrame>(
-      surface, delegate_->SurfaceSupportsReadback(), submit_callback,
-      std::move(context_switch));
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = delegate_->SurfaceSupportsReadback();
+  if (delegate_->GLContextSupportsPartialRepaint()) {
+    framebuffer_info.supports_partial_repaint = true;
+    framebuffer_info.existing_damage =
+        delegate_->GLContextFBOExistingDamage(fbo_id_);
+  }
+
+  return std::make_unique<SurfaceFrame>(surface, std::move(framebuffer_info),
+                                        submit_callback,
+                                        std::move(context_switch));
 }
 
-bool GPUSurfaceGL::PresentSurface(SkCanvas* canvas) {
+bool GPUSurfaceGL::PresentSurface(const SurfaceFrame& surface_frame,
+                                  SkCanvas* canvas) {
   if (delegate_ == nullptr || canvas == nullptr || context_ == nullptr) {
     return false;
   }
@@ -270,7 +279,12 @@ bool GPUSurfaceGL::PresentSurface(SkCanvas* canvas) {
     onscreen_surface_->getCanvas()->flush();
   }
 
-  if (!delegate_->GLContextPresent(fbo_id_)) {
+  GLPresentInfo present_info = {
+      fbo_id_,                                    // fbo_id
+      surface_frame.submit_info().frame_damage,   // frame_damage
+      surface_frame.submit_info().buffer_damage,  // buffer_damage
+  };
+  if (!delegate_->GLContextPresentWithInfo(present_info)) {
     return false;
   }
 
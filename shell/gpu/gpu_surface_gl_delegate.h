@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_GL_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_GL_DELEGATE_H_
 
+#include <optional>
+
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
@@ -20,6 +22,20 @@ struct GLFrameInfo {
   uint32_t height;
 };
 
+// A structure to represent the information which is passed to the embedder
+// when presenting the main framebuffer.
+struct GLPresentInfo {
+  uint32_t fbo_id;
+
+  // The region of the frame that changed since the previously presented frame.
+  // Unset if the whole frame must be assumed to have changed.
+  std::optional<SkIRect> frame_damage;
+
+  // The region of the framebuffer that was repainted. Unset if the whole
+  // framebuffer was repainted.
+  std::optional<SkIRect> buffer_damage;
+};
+
 class GPUSurfaceGLDelegate {
  public:
   ~GPUSurfaceGLDelegate();
@@ -35,9 +51,28 @@ class GPUSurfaceGLDelegate {
   // context and not any of the contexts dedicated for IO.
   virtual bool GLContextPresent(uint32_t fbo_id) = 0;
 
+  // Called to present the main GL surface along with the regions of it that
+  // changed. Delegates that support partial repaint should override this. The
+  // default implementation calls |GLContextPresent|.
+  virtual bool GLContextPresentWithInfo(const GLPresentInfo& present_info);
+
   // The ID of the main window bound framebuffer. Typically FBO0.
   virtual intptr_t GLContextFBO(GLFrameInfo frame_info) const = 0;
 
+  // Indicates whether the main window bound framebuffer preserves its contents
+  // between frames so that only the region of a frame that changed needs to be
+  // repainted. If this returns true, |GLContextFBOExistingDamage| is queried
+  // for every frame.
+  virtual bool GLContextSupportsPartialRepaint() const;
+
+  // The region of the framebuffer with the given ID that does not hold the
+  // contents of the previously presented frame. This is empty if the
+  // framebuffer holds the previous frame (i.e. has a buffer age of 1). Returns
+  // nullopt if the contents of the framebuffer are unknown, in which case the
+  // whole frame is repainted.
+  virtual std::optional<SkIRect> GLContextFBOExistingDamage(
+      intptr_t fbo_id) const;
+
   // The rendering subsystem assumes that the ID of the main window bound
   // framebuffer remains constant throughout. If this assumption in incorrect,
   // embedders are required to return true from this method. In such cases,
@@ -5,9 +5,15 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_METAL_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_METAL_H_
 
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_metal_delegate.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/mtl/GrMtlTypes.h"
 
@@ -31,12 +37,26 @@ class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetal : public Surface {
   GrMTLHandle next_drawable_ = nullptr;
   sk_sp<GrDirectContext> context_;
   GrDirectContext* precompiled_sksl_context_ = nullptr;
+  // The known SkSLs that have not been precompiled in
+  // |precompiled_sksl_context_| yet, starting at |next_sksl_index_|.
+  std::vector<PersistentCache::SkSLCache> pending_sksls_;
+  size_t next_sksl_index_ = 0;
   // TODO(38466): Refactor GPU surface APIs take into account the fact that an
   // external view embedder may want to render to the root surface. This is a
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   bool render_to_surface_;
 
+  // The region of each texture (by texture id) that does not hold the contents
+  // of the last presented frame. Only tracked when the delegate reports that
+  // its textures retain their contents.
+  std::map<int64_t, SkIRect> texture_damage_;
+  SkISize texture_damage_size_ = SkISize::MakeEmpty();
+
+  // The texture frames are rendered into when the delegate acquires drawables
+  // at present. It is copied into the drawable when the frame is presented.
+  sk_sp<SkSurface> intermediate_surface_;
+
   // |Surface|
   std::unique_ptr<SurfaceFrame> AcquireFrame(const SkISize& size) override;
 
@@ -55,6 +75,16 @@ class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetal : public Surface {
   std::unique_ptr<SurfaceFrame> AcquireFrameFromMTLTexture(
       const SkISize& frame_info);
 
+  std::unique_ptr<SurfaceFrame> AcquireFrameForDrawableAtPresent(
+      GPUCAMetalLayerHandle layer,
+      const SkISize& frame_info);
+
+  std::optional<SkIRect> ExistingDamageForTexture(int64_t texture_id,
+                                                  const SkISize& frame_size);
+
+  void RecordPresentedTexture(int64_t texture_id,
+                              const std::optional<SkIRect>& frame_damage);
+
   void ReleaseUnusedDrawableIfNecessary();
 
   void PrecompileKnownSkSLsIfNecessary();
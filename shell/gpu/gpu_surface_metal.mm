@@ -5,6 +5,7 @@
 #include "flutter/shell/gpu/gpu_surface_metal.h"
 
 #import <Metal/Metal.h>
+#import <QuartzCore/CAMetalLayer.h>
 
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/make_copyable.h"
@@ -36,14 +37,33 @@ bool GPUSurfaceMetal::IsValid() {
   return context_ != nullptr;
 }
 
+// The time spent precompiling known SkSLs before each frame. The SkSLs are precompiled in the order
+// they were first used, so the ones needed by the first frames are ready first, without delaying
+// the first frame until every known SkSL was precompiled.
+static constexpr fml::TimeDelta kSkSLPrecompilationBudgetPerFrame =
+    fml::TimeDelta::FromMilliseconds(8);
+
 void GPUSurfaceMetal::PrecompileKnownSkSLsIfNecessary() {
   auto* current_context = GetContext();
-  if (current_context == precompiled_sksl_context_) {
+  auto* persistent_cache = flutter::PersistentCache::GetCacheForProcess();
+  if (current_context != precompiled_sksl_context_) {
+    precompiled_sksl_context_ = current_context;
+    pending_sksls_ = persistent_cache->LoadSkSLsToPrecompile();
+    next_sksl_index_ = 0;
+    // A trace must be present even if no precompilations have been completed.
+    FML_TRACE_EVENT("flutter", "PersistentCache::PrecompileKnownSkSLs", "count",
+                    pending_sksls_.size());
+  }
+  if (next_sksl_index_ >= pending_sksls_.size()) {
     // Known SkSLs have already been prepared in this context.
     return;
   }
-  precompiled_sksl_context_ = current_context;
-  flutter::PersistentCache::GetCacheForProcess()->PrecompileKnownSkSLs(precompiled_sksl_context_);
+  persistent_cache->PrecompileSkSLs(precompiled_sksl_context_, pending_sksls_, &next_sksl_index_,
+                                    fml::TimePoint::Now() + kSkSLPrecompilationBudgetPerFrame);
+  if (next_sksl_index_ >= pending_sksls_.size()) {
+    pending_sksls_.clear();
+    next_sksl_index_ = 0;
+  }
 }
 
 // |Surface|
@@ -86,6 +106,12 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromCAMetalLayer(
   }
 
   ReleaseUnusedDrawableIfNecessary();
+
+  if (delegate_->AcquiresDrawableAtPresent()) {
+    return AcquireFrameForDrawableAtPresent(layer, frame_info);
+  }
+  intermediate_surface_ = nullptr;
+
   sk_sp<SkSurface> surface =
       SkSurface::MakeFromCAMetalLayer(context_.get(),            // context
                                       layer,                     // layer
@@ -123,6 +149,74 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromCAMetalLayer(
   return std::make_unique<SurfaceFrame>(std::move(surface), true, submit_callback);
 }
 
+std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameForDrawableAtPresent(
+    GPUCAMetalLayerHandle layer,
+    const SkISize& frame_info) {
+  if (!intermediate_surface_ || intermediate_surface_->width() != frame_info.width() ||
+      intermediate_surface_->height() != frame_info.height()) {
+    const SkImageInfo image_info =
+        SkImageInfo::Make(frame_info, kBGRA_8888_SkColorType, kPremul_SkAlphaType);
+    intermediate_surface_ = SkSurface::MakeRenderTarget(
+        context_.get(), SkBudgeted::kNo, image_info, 1, kTopLeft_GrSurfaceOrigin, nullptr);
+  }
+
+  if (!intermediate_surface_) {
+    FML_LOG(ERROR) << "Could not create the intermediate SkSurface for the CAMetalLayer.";
+    return nullptr;
+  }
+
+  auto submit_callback = [this, layer, surface = intermediate_surface_](
+                             const SurfaceFrame& surface_frame, SkCanvas* canvas) -> bool {
+    TRACE_EVENT0("flutter", "GPUSurfaceMetal::Submit");
+    if (canvas == nullptr) {
+      FML_DLOG(ERROR) << "Canvas not available.";
+      return false;
+    }
+
+    // Submit the frame to the GPU before waiting for a drawable to copy it into.
+    canvas->flush();
+
+    @autoreleasepool {
+      CAMetalLayer* metal_layer = reinterpret_cast<CAMetalLayer*>(layer);
+      const fml::TimePoint wait_start = fml::TimePoint::Now();
+      id<CAMetalDrawable> drawable = nil;
+      {
+        TRACE_EVENT0("flutter", "GPUSurfaceMetal::AcquireDrawable");
+        drawable = [metal_layer nextDrawable];
+      }
+      surface_frame.AddBufferWait(fml::TimePoint::Now() - wait_start);
+      if (!drawable) {
+        FML_DLOG(ERROR) << "Unable to obtain a metal drawable.";
+        return false;
+      }
+
+      GrMtlTextureInfo info;
+      info.fTexture.reset([drawable.texture retain]);
+      GrBackendRenderTarget render_target(surface->width(), surface->height(), 1, info);
+      sk_sp<SkSurface> drawable_surface = SkSurface::MakeFromBackendRenderTarget(
+          context_.get(), render_target, kTopLeft_GrSurfaceOrigin, kBGRA_8888_SkColorType,
+          nullptr, nullptr);
+      if (!drawable_surface) {
+        FML_DLOG(ERROR) << "Could not create the SkSurface from the metal drawable.";
+        return false;
+      }
+
+      {
+        TRACE_EVENT0("flutter", "GPUSurfaceMetal::CopyToDrawable");
+        SkPaint paint;
+        paint.setBlendMode(SkBlendMode::kSrc);
+        drawable_surface->getCanvas()->drawImage(surface->makeImageSnapshot(), 0, 0,
+                                                 SkSamplingOptions(), &paint);
+        drawable_surface->flushAndSubmit();
+      }
+
+      return delegate_->PresentDrawable(drawable);
+    }
+  };
+
+  return std::make_unique<SurfaceFrame>(intermediate_surface_, true, submit_callback);
+}
+
 std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromMTLTexture(
     const SkISize& frame_info) {
   GPUMTLTextureInfo texture = delegate_->GetMTLTexture(frame_info);
@@ -146,7 +240,9 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromMTLTexture(
     return nullptr;
   }
 
-  auto submit_callback = [texture = texture, delegate = delegate_](
+  const bool supports_partial_repaint = delegate_->TexturesRetainContents();
+
+  auto submit_callback = [this, texture = texture, supports_partial_repaint](
                              const SurfaceFrame& surface_frame, SkCanvas* canvas) -> bool {
     TRACE_EVENT0("flutter", "GPUSurfaceMetal::PresentTexture");
     if (canvas == nullptr) {
@@ -156,10 +252,47 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromMTLTexture(
 
     canvas->flush();
 
-    return delegate->PresentTexture(texture);
+    if (supports_partial_repaint) {
+      RecordPresentedTexture(texture.texture_id, surface_frame.submit_info().frame_damage);
+    }
+
+    return delegate_->PresentTexture(texture);
   };
 
-  return std::make_unique<SurfaceFrame>(std::move(surface), true, submit_callback);
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  if (supports_partial_repaint) {
+    framebuffer_info.supports_partial_repaint = true;
+    framebuffer_info.existing_damage = ExistingDamageForTexture(texture.texture_id, frame_info);
+  }
+
+  return std::make_unique<SurfaceFrame>(std::move(surface), std::move(framebuffer_info),
+                                        submit_callback);
+}
+
+std::optional<SkIRect> GPUSurfaceMetal::ExistingDamageForTexture(int64_t texture_id,
+                                                                 const SkISize& frame_size) {
+  if (frame_size != texture_damage_size_) {
+    // The contents of all textures are stale after a resize.
+    texture_damage_.clear();
+    texture_damage_size_ = frame_size;
+  }
+  auto found = texture_damage_.find(texture_id);
+  if (found == texture_damage_.end()) {
+    // The engine has not rendered into this texture at this size yet.
+    return std::nullopt;
+  }
+  return found->second;
+}
+
+void GPUSurfaceMetal::RecordPresentedTexture(int64_t texture_id,
+                                             const std::optional<SkIRect>& frame_damage) {
+  // Every other texture now lags behind the presented one by the frame damage.
+  SkIRect damage = frame_damage.value_or(SkIRect::MakeSize(texture_damage_size_));
+  for (auto& entry : texture_damage_) {
+    entry.second.join(damage);
+  }
+  texture_damage_[texture_id] = SkIRect::MakeEmpty();
 }
 
 // |Surface|
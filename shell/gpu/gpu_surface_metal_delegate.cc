@@ -12,6 +12,14 @@ GPUSurfaceMetalDelegate::GPUSurfaceMetalDelegate(
 
 GPUSurfaceMetalDelegate::~GPUSurfaceMetalDelegate() = default;
 
+bool GPUSurfaceMetalDelegate::TexturesRetainContents() const {
+  return false;
+}
+
+bool GPUSurfaceMetalDelegate::AcquiresDrawableAtPresent() const {
+  return false;
+}
+
 MTLRenderTargetType GPUSurfaceMetalDelegate::GetRenderTargetType() {
   return render_target_type_;
 }
@@ -89,6 +89,29 @@ class GPUSurfaceMetalDelegate {
   ///
   virtual bool PresentTexture(GPUMTLTextureInfo texture) const = 0;
 
+  //------------------------------------------------------------------------------
+  /// @brief Whether the textures given by `GetMTLTexture` keep their contents
+  /// between frames and a `texture_id` always refers to the same texture. If
+  /// so, only the region of a frame that changed since a texture was last
+  /// presented is repainted. This is only called when the specified render
+  /// target type is `kMTLTexture`.
+  ///
+  /// @see |GPUSurfaceMetalDelegate::GetMTLTexture|
+  ///
+  virtual bool TexturesRetainContents() const;
+
+  //------------------------------------------------------------------------------
+  /// @brief Whether frames are rendered into an intermediate texture and the
+  /// drawable of the CAMetalLayer given by `GetCAMetalLayer` is only acquired
+  /// when presenting a frame, before it is copied into the drawable. The GPU
+  /// work of a frame is then submitted without waiting for a drawable first.
+  /// This is only called when the specified render target type is
+  /// `kCAMetalLayer`.
+  ///
+  /// @see |GPUSurfaceMetalDelegate::GetCAMetalLayer|
+  ///
+  virtual bool AcquiresDrawableAtPresent() const;
+
   MTLRenderTargetType GetRenderTargetType();
 
  private:
@@ -53,23 +53,70 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
-  SkCanvas* canvas = backing_store->getCanvas();
-  canvas->resetMatrix();
-
-  SurfaceFrame::SubmitCallback on_submit =
-      [self = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
-                                          SkCanvas* canvas) -> bool {
-    // If the surface itself went away, there is nothing more to do.
-    if (!self || !self->IsValid() || canvas == nullptr) {
-      return false;
-    }
+  //
+  // A reused backing store may still be presenting on the present thread of
+  // the rasterizer, which waits for it before painting but not before
+  // acquiring the frame. Its canvas is reset after it presented instead.
+  const bool threaded_present =
+      delegate_->BackingStoreSupportsThreadedPresent();
+  if (!threaded_present) {
+    backing_store->getCanvas()->resetMatrix();
+  }
 
-    canvas->flush();
+  SurfaceFrame::SubmitCallback on_submit;
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  if (threaded_present) {
+    // The callback may run on the present thread of the rasterizer, which
+    // waits for it before the delegate goes away, so the weak pointer that
+    // is only valid on the raster thread is not needed.
+    on_submit = [delegate = delegate_](const SurfaceFrame& surface_frame,
+                                       SkCanvas* canvas) -> bool {
+      if (canvas == nullptr) {
+        return false;
+      }
+
+      canvas->flush();
+
+      SoftwarePresentInfo present_info = {
+          surface_frame.submit_info().frame_damage,   // frame_damage
+          surface_frame.submit_info().buffer_damage,  // buffer_damage
+      };
+      const bool presented = delegate->PresentBackingStoreWithInfo(
+          surface_frame.SkiaSurface(), present_info);
+      canvas->resetMatrix();
+      return presented;
+    };
+    // Backing stores are reused across frames, so only one may be presenting
+    // while the next frame is prepared.
+    framebuffer_info.max_presents_in_flight = 1;
+  } else {
+    on_submit = [self = weak_factory_.GetWeakPtr()](
+                    const SurfaceFrame& surface_frame,
+                    SkCanvas* canvas) -> bool {
+      // If the surface itself went away, there is nothing more to do.
+      if (!self || !self->IsValid() || canvas == nullptr) {
+        return false;
+      }
+
+      canvas->flush();
+
+      SoftwarePresentInfo present_info = {
+          surface_frame.submit_info().frame_damage,   // frame_damage
+          surface_frame.submit_info().buffer_damage,  // buffer_damage
+      };
+      return self->delegate_->PresentBackingStoreWithInfo(
+          surface_frame.SkiaSurface(), present_info);
+    };
+  }
 
-    return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
-  };
+  framebuffer_info.supports_readback = true;
+  if (delegate_->BackingStoreSupportsPartialRepaint()) {
+    framebuffer_info.supports_partial_repaint = true;
+    framebuffer_info.existing_damage = delegate_->BackingStoreExistingDamage();
+  }
 
-  return std::make_unique<SurfaceFrame>(backing_store, true, on_submit);
+  return std::make_unique<SurfaceFrame>(
+      backing_store, std::move(framebuffer_info), on_submit);
 }
 
 // |Surface|
@@ -8,4 +8,23 @@ namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+bool GPUSurfaceSoftwareDelegate::PresentBackingStoreWithInfo(
+    sk_sp<SkSurface> backing_store,
+    const SoftwarePresentInfo& present_info) {
+  return PresentBackingStore(std::move(backing_store));
+}
+
+bool GPUSurfaceSoftwareDelegate::BackingStoreSupportsPartialRepaint() const {
+  return false;
+}
+
+std::optional<SkIRect> GPUSurfaceSoftwareDelegate::BackingStoreExistingDamage()
+    const {
+  return std::nullopt;
+}
+
+bool GPUSurfaceSoftwareDelegate::BackingStoreSupportsThreadedPresent() const {
+  return false;
+}
+
 }  // namespace flutter
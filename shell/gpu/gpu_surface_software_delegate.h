@@ -5,12 +5,28 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 
+#include <optional>
+
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      The information passed to the platform when presenting a
+///             software backing store.
+///
+struct SoftwarePresentInfo {
+  /// The region of the frame that changed since the previously presented
+  /// frame. Unset if the whole frame must be assumed to have changed.
+  std::optional<SkIRect> frame_damage;
+
+  /// The region of the backing store that was repainted. Unset if the whole
+  /// backing store was repainted.
+  std::optional<SkIRect> buffer_damage;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      Interface implemented by all platform surfaces that can present
 ///             a software backing store to the "screen". The GPU surface
@@ -48,6 +64,49 @@ class GPUSurfaceSoftwareDelegate {
   ///             the screen.
   ///
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called to present the backing store along with the regions of
+  ///             it that changed. Delegates that support partial repaint
+  ///             should override this. The default implementation calls
+  ///             |PresentBackingStore|.
+  ///
+  /// @param[in]  backing_store  The software backing store to present.
+  /// @param[in]  present_info   The regions of the frame and the backing
+  ///                            store that changed.
+  ///
+  /// @return     Returns if the platform could present the backing store onto
+  ///             the screen.
+  ///
+  virtual bool PresentBackingStoreWithInfo(
+      sk_sp<SkSurface> backing_store,
+      const SoftwarePresentInfo& present_info);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the backing stores returned by |AcquireBackingStore|
+  ///             keep their contents between frames, so that only the region
+  ///             of a frame that changed needs to be repainted. If this
+  ///             returns true, |BackingStoreExistingDamage| is queried for
+  ///             every frame.
+  ///
+  virtual bool BackingStoreSupportsPartialRepaint() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The region of the most recently acquired backing store that
+  ///             does not hold the contents of the previously presented frame.
+  ///
+  /// @return     The stale region, or nullopt if the contents of the backing
+  ///             store are unknown and the whole frame must be repainted.
+  ///
+  virtual std::optional<SkIRect> BackingStoreExistingDamage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether |PresentBackingStoreWithInfo| may be called on a
+  ///             thread other than the raster thread, while the raster thread
+  ///             prepares the next frame. The next backing store is only
+  ///             acquired once the previous one has been presented.
+  ///
+  virtual bool BackingStoreSupportsThreadedPresent() const;
 };
 
 }  // namespace flutter
@@ -5,6 +5,9 @@
 #include "flutter/shell/gpu/gpu_surface_vulkan.h"
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
 
 namespace flutter {
 
@@ -22,17 +25,28 @@ GPUSurfaceVulkan::GPUSurfaceVulkan(
     GPUSurfaceVulkanDelegate* delegate,
     std::unique_ptr<vulkan::VulkanNativeSurface> native_surface,
     bool render_to_surface)
-    : window_(context,
-              delegate->vk(),
-              std::move(native_surface),
-              render_to_surface),
+    : delegate_(delegate),
+      window_(std::make_unique<vulkan::VulkanWindow>(
+          context,
+          delegate->vk(),
+          std::move(native_surface),
+          render_to_surface,
+          delegate->GetSwapchainConfig())),
+      render_to_surface_(render_to_surface),
+      weak_factory_(this) {}
+
+GPUSurfaceVulkan::GPUSurfaceVulkan(GPUSurfaceVulkanDelegate* delegate,
+                                   const sk_sp<GrDirectContext>& context,
+                                   bool render_to_surface)
+    : delegate_(delegate),
+      skia_context_(context),
       render_to_surface_(render_to_surface),
       weak_factory_(this) {}
 
 GPUSurfaceVulkan::~GPUSurfaceVulkan() = default;
 
 bool GPUSurfaceVulkan::IsValid() {
-  return window_.IsValid();
+  return window_ ? window_->IsValid() : skia_context_ != nullptr;
 }
 
 std::unique_ptr<SurfaceFrame> GPUSurfaceVulkan::AcquireFrame(
@@ -46,7 +60,11 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkan::AcquireFrame(
         });
   }
 
-  auto surface = window_.AcquireSurface();
+  if (!window_) {
+    return AcquireFrameFromImage(size);
+  }
+
+  auto surface = window_->AcquireSurface();
 
   if (surface == nullptr) {
     return nullptr;
@@ -61,7 +79,60 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkan::AcquireFrame(
     if (canvas == nullptr || !weak_this) {
       return false;
     }
-    return weak_this->window_.SwapBuffers();
+    return weak_this->window_->SwapBuffers();
+  };
+  return std::make_unique<SurfaceFrame>(std::move(surface), true,
+                                        std::move(callback));
+}
+
+std::unique_ptr<SurfaceFrame> GPUSurfaceVulkan::AcquireFrameFromImage(
+    const SkISize& size) {
+  GPUVulkanImage image = delegate_->AcquireImage(size);
+  if (image.image == VK_NULL_HANDLE) {
+    FML_LOG(ERROR) << "Invalid VkImage given by the embedder.";
+    return nullptr;
+  }
+
+  SkColorType color_type;
+  switch (image.format) {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+      color_type = kRGBA_8888_SkColorType;
+      break;
+    case VK_FORMAT_B8G8R8A8_UNORM:
+      color_type = kBGRA_8888_SkColorType;
+      break;
+    default:
+      FML_LOG(ERROR) << "Unsupported VkFormat " << image.format
+                     << " given by the embedder.";
+      return nullptr;
+  }
+
+  GrVkImageInfo image_info;
+  image_info.fImage = image.image;
+  image_info.fImageTiling = VK_IMAGE_TILING_OPTIMAL;
+  image_info.fImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  image_info.fFormat = image.format;
+  image_info.fLevelCount = 1;
+  GrBackendTexture backend_texture(size.width(), size.height(), image_info);
+
+  sk_sp<SkSurface> surface = SkSurface::MakeFromBackendTexture(
+      skia_context_.get(), backend_texture, kTopLeft_GrSurfaceOrigin, 1,
+      color_type, nullptr, nullptr);
+  if (!surface) {
+    FML_LOG(ERROR) << "Could not create the SkSurface from the VkImage.";
+    return nullptr;
+  }
+
+  SurfaceFrame::SubmitCallback callback =
+      [weak_this = weak_factory_.GetWeakPtr(), image](
+          const SurfaceFrame&, SkCanvas* canvas) -> bool {
+    TRACE_EVENT0("flutter", "GPUSurfaceVulkan::PresentImage");
+    if (canvas == nullptr || !weak_this) {
+      return false;
+    }
+    // Submits all the work rendering into the image to the queue.
+    canvas->flush();
+    return weak_this->delegate_->PresentImage(image);
   };
   return std::make_unique<SurfaceFrame>(std::move(surface), true,
                                         std::move(callback));
@@ -76,7 +147,7 @@ SkMatrix GPUSurfaceVulkan::GetRootTransformation() const {
 }
 
 GrDirectContext* GPUSurfaceVulkan::GetContext() {
-  return window_.GetSkiaGrContext();
+  return window_ ? window_->GetSkiaGrContext() : skia_context_.get();
 }
 
 }  // namespace flutter
@@ -36,6 +36,15 @@ class GPUSurfaceVulkan : public Surface {
                    std::unique_ptr<vulkan::VulkanNativeSurface> native_surface,
                    bool render_to_surface);
 
+  //------------------------------------------------------------------------------
+  /// @brief      Create a GPUSurfaceVulkan that renders into the images
+  ///             acquired from the delegate with `context`, instead of into a
+  ///             window of its own.
+  ///
+  GPUSurfaceVulkan(GPUSurfaceVulkanDelegate* delegate,
+                   const sk_sp<GrDirectContext>& context,
+                   bool render_to_surface);
+
   ~GPUSurfaceVulkan() override;
 
   // |Surface|
@@ -51,9 +60,16 @@ class GPUSurfaceVulkan : public Surface {
   GrDirectContext* GetContext() override;
 
  private:
-  vulkan::VulkanWindow window_;
+  GPUSurfaceVulkanDelegate* delegate_;
+  // The window frames are rendered into, or null if they are rendered into
+  // the images of the delegate.
+  std::unique_ptr<vulkan::VulkanWindow> window_;
+  // The context frames are rendered with if there is no window.
+  sk_sp<GrDirectContext> skia_context_;
   const bool render_to_surface_;
 
+  std::unique_ptr<SurfaceFrame> AcquireFrameFromImage(const SkISize& size);
+
   fml::WeakPtrFactory<GPUSurfaceVulkan> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceVulkan);
@@ -8,4 +8,16 @@ namespace flutter {
 
 GPUSurfaceVulkanDelegate::~GPUSurfaceVulkanDelegate() = default;
 
+GPUVulkanImage GPUSurfaceVulkanDelegate::AcquireImage(const SkISize& size) {
+  return {};
+}
+
+bool GPUSurfaceVulkanDelegate::PresentImage(const GPUVulkanImage& image) {
+  return false;
+}
+
+vulkan::VulkanSwapchainConfig GPUSurfaceVulkanDelegate::GetSwapchainConfig() {
+  return {};
+}
+
 }  // namespace flutter
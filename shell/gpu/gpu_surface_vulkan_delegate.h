@@ -7,15 +7,38 @@
 
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/vulkan/vulkan_proc_table.h"
+#include "flutter/vulkan/vulkan_swapchain.h"
+#include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
 
+// An image that is owned by the platform and rendered into by the GPU
+// surface.
+struct GPUVulkanImage {
+  VkImage image = VK_NULL_HANDLE;
+  VkFormat format = VK_FORMAT_UNDEFINED;
+};
+
 class GPUSurfaceVulkanDelegate {
  public:
-  ~GPUSurfaceVulkanDelegate();
+  virtual ~GPUSurfaceVulkanDelegate();
 
   // Obtain a reference to the Vulkan implementation's proc table.
   virtual fml::RefPtr<vulkan::VulkanProcTable> vk() = 0;
+
+  // Returns the image to render the next frame of `size` into. Only called on
+  // surfaces that render into images of the platform rather than a window.
+  virtual GPUVulkanImage AcquireImage(const SkISize& size);
+
+  // Presents an image returned by `AcquireImage` once all the work rendering
+  // into it was submitted. Only called on surfaces that render into images of
+  // the platform rather than a window.
+  virtual bool PresentImage(const GPUVulkanImage& image);
+
+  // Returns how the swapchain of the window surface presents its frames, such
+  // as a lower latency present mode. Only called on surfaces that render into
+  // a window. Defaults to FIFO with one frame in flight per image.
+  virtual vulkan::VulkanSwapchainConfig GetSwapchainConfig();
 };
 
 }  // namespace flutter
@@ -0,0 +1,268 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_hardware_buffer_texture_gl.h"
+
+#include <GLES/glext.h>
+#include <dlfcn.h>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+namespace {
+
+// The functions of the NDK and of EGL extensions that import hardware
+// buffers. The NDK functions only exist from API 26 on, below the minimum API
+// level of the engine, so they are looked up at runtime.
+struct HardwareBufferProcs {
+  AHardwareBuffer* (*from_hardware_buffer)(JNIEnv*, jobject) = nullptr;
+  void (*acquire)(AHardwareBuffer*) = nullptr;
+  void (*release)(AHardwareBuffer*) = nullptr;
+  void (*describe)(const AHardwareBuffer*, AHardwareBuffer_Desc*) = nullptr;
+  PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC get_native_client_buffer = nullptr;
+  PFNEGLCREATEIMAGEKHRPROC create_image = nullptr;
+  PFNEGLDESTROYIMAGEKHRPROC destroy_image = nullptr;
+  PFNGLEGLIMAGETARGETTEXTURE2DOESPROC image_target_texture = nullptr;
+  PFNEGLCREATESYNCKHRPROC create_sync = nullptr;
+  PFNEGLDESTROYSYNCKHRPROC destroy_sync = nullptr;
+  PFNEGLCLIENTWAITSYNCKHRPROC client_wait_sync = nullptr;
+
+  bool IsValid() const {
+    return from_hardware_buffer && acquire && release && describe &&
+           get_native_client_buffer && create_image && destroy_image &&
+           image_target_texture && create_sync && destroy_sync &&
+           client_wait_sync;
+  }
+};
+
+template <typename T>
+void LookUp(void* library, const char* name, T& proc) {
+  proc = reinterpret_cast<T>(::dlsym(library, name));
+}
+
+template <typename T>
+void LookUpEGL(const char* name, T& proc) {
+  proc = reinterpret_cast<T>(::eglGetProcAddress(name));
+}
+
+const HardwareBufferProcs& GetProcs() {
+  static const HardwareBufferProcs procs = [] {
+    HardwareBufferProcs procs;
+    if (void* library = ::dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL)) {
+      LookUp(library, "AHardwareBuffer_fromHardwareBuffer",
+             procs.from_hardware_buffer);
+      LookUp(library, "AHardwareBuffer_acquire", procs.acquire);
+      LookUp(library, "AHardwareBuffer_release", procs.release);
+      LookUp(library, "AHardwareBuffer_describe", procs.describe);
+    }
+    LookUpEGL("eglGetNativeClientBufferANDROID",
+              procs.get_native_client_buffer);
+    LookUpEGL("eglCreateImageKHR", procs.create_image);
+    LookUpEGL("eglDestroyImageKHR", procs.destroy_image);
+    LookUpEGL("glEGLImageTargetTexture2DOES", procs.image_target_texture);
+    LookUpEGL("eglCreateSyncKHR", procs.create_sync);
+    LookUpEGL("eglDestroySyncKHR", procs.destroy_sync);
+    LookUpEGL("eglClientWaitSyncKHR", procs.client_wait_sync);
+    return procs;
+  }();
+  return procs;
+}
+
+}  // namespace
+
+bool AndroidHardwareBufferTextureGL::IsSupported() {
+  return GetProcs().IsValid();
+}
+
+AndroidHardwareBufferTextureGL::AndroidHardwareBufferTextureGL(
+    int64_t id,
+    ReleaseCallback release_callback)
+    : Texture(id), release_callback_(std::move(release_callback)) {}
+
+AndroidHardwareBufferTextureGL::~AndroidHardwareBufferTextureGL() {
+  ReleaseAllBuffers(false);
+  if (texture_name_ != 0) {
+    glDeleteTextures(1, &texture_name_);
+  }
+}
+
+bool AndroidHardwareBufferTextureGL::PushBuffer(JNIEnv* env,
+                                                jobject hardware_buffer,
+                                                int64_t token) {
+  const HardwareBufferProcs& procs = GetProcs();
+  if (!procs.IsValid()) {
+    return false;
+  }
+  AHardwareBuffer* buffer = procs.from_hardware_buffer(env, hardware_buffer);
+  if (buffer == nullptr) {
+    return false;
+  }
+  procs.acquire(buffer);
+
+  std::optional<Buffer> replaced;
+  {
+    std::scoped_lock lock(pending_buffer_mutex_);
+    replaced.swap(pending_buffer_);
+    pending_buffer_ = Buffer{buffer, token};
+  }
+  // The replaced buffer was never imported, so nothing reads it.
+  if (replaced) {
+    ReleaseBuffer(*replaced);
+  }
+  return true;
+}
+
+void AndroidHardwareBufferTextureGL::Paint(SkCanvas& canvas,
+                                           const SkRect& bounds,
+                                           bool freeze,
+                                           GrDirectContext* context,
+                                           const SkSamplingOptions& sampling) {
+  if (!freeze) {
+    UpdateCurrentBuffer(context);
+  }
+  ReleaseRetiredBuffers();
+  if (!current_buffer_) {
+    return;
+  }
+
+  GrGLTextureInfo texture_info = {GL_TEXTURE_EXTERNAL_OES, texture_name_,
+                                  GL_RGBA8_OES};
+  GrBackendTexture backend_texture(size_.width(), size_.height(),
+                                   GrMipMapped::kNo, texture_info);
+  sk_sp<SkImage> image = SkImage::MakeFromTexture(
+      context, backend_texture, kTopLeft_GrSurfaceOrigin,
+      kRGBA_8888_SkColorType, kPremul_SkAlphaType, nullptr);
+  if (image) {
+    canvas.drawImageRect(image, bounds, sampling);
+  }
+}
+
+void AndroidHardwareBufferTextureGL::UpdateCurrentBuffer(
+    GrDirectContext* context) {
+  std::optional<Buffer> pending;
+  {
+    std::scoped_lock lock(pending_buffer_mutex_);
+    pending.swap(pending_buffer_);
+  }
+  if (!pending) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "AndroidHardwareBufferTextureGL::Import");
+
+  const HardwareBufferProcs& procs = GetProcs();
+  display_ = ::eglGetCurrentDisplay();
+  const EGLint attributes[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+  pending->image = procs.create_image(
+      display_, EGL_NO_CONTEXT, EGL_NATIVE_BUFFER_ANDROID,
+      procs.get_native_client_buffer(pending->hardware_buffer), attributes);
+  if (pending->image == EGL_NO_IMAGE_KHR) {
+    FML_LOG(ERROR) << "Could not import a hardware buffer into an EGLImage.";
+    ReleaseBuffer(*pending);
+    return;
+  }
+
+  if (texture_name_ == 0) {
+    glGenTextures(1, &texture_name_);
+  }
+  glBindTexture(GL_TEXTURE_EXTERNAL_OES, texture_name_);
+  procs.image_target_texture(GL_TEXTURE_EXTERNAL_OES, pending->image);
+  context->resetContext(kTextureBinding_GrGLBackendState);
+
+  AHardwareBuffer_Desc description;
+  procs.describe(pending->hardware_buffer, &description);
+  size_ = SkISize::Make(description.width, description.height);
+
+  if (current_buffer_) {
+    // The frames that read the current buffer were already submitted, so a
+    // fence that is created now is signaled once they are done.
+    current_buffer_->fence =
+        procs.create_sync(display_, EGL_SYNC_FENCE_KHR, nullptr);
+    retired_buffers_.push_back(*current_buffer_);
+  }
+  current_buffer_ = pending;
+}
+
+void AndroidHardwareBufferTextureGL::ReleaseRetiredBuffers() {
+  const HardwareBufferProcs& procs = GetProcs();
+  while (!retired_buffers_.empty()) {
+    Buffer& buffer = retired_buffers_.front();
+    const bool wait = retired_buffers_.size() > kMaxRetiredBuffers;
+    if (buffer.fence != EGL_NO_SYNC_KHR) {
+      const EGLint result = procs.client_wait_sync(
+          display_, buffer.fence, wait ? EGL_SYNC_FLUSH_COMMANDS_BIT_KHR : 0,
+          wait ? EGL_FOREVER_KHR : 0);
+      if (result == EGL_TIMEOUT_EXPIRED_KHR) {
+        return;
+      }
+    }
+    ReleaseBuffer(buffer);
+    retired_buffers_.pop_front();
+  }
+}
+
+void AndroidHardwareBufferTextureGL::ReleaseAllBuffers(bool wait) {
+  const HardwareBufferProcs& procs = GetProcs();
+  if (current_buffer_) {
+    retired_buffers_.push_back(*current_buffer_);
+    current_buffer_.reset();
+  }
+  for (Buffer& buffer : retired_buffers_) {
+    if (wait && buffer.fence != EGL_NO_SYNC_KHR) {
+      procs.client_wait_sync(display_, buffer.fence,
+                             EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, EGL_FOREVER_KHR);
+    }
+    ReleaseBuffer(buffer);
+  }
+  retired_buffers_.clear();
+
+  std::optional<Buffer> pending;
+  {
+    std::scoped_lock lock(pending_buffer_mutex_);
+    pending.swap(pending_buffer_);
+  }
+  if (pending) {
+    ReleaseBuffer(*pending);
+  }
+}
+
+void AndroidHardwareBufferTextureGL::ReleaseBuffer(Buffer& buffer) {
+  const HardwareBufferProcs& procs = GetProcs();
+  if (buffer.fence != EGL_NO_SYNC_KHR) {
+    procs.destroy_sync(display_, buffer.fence);
+  }
+  if (buffer.image != EGL_NO_IMAGE_KHR) {
+    procs.destroy_image(display_, buffer.image);
+  }
+  procs.release(buffer.hardware_buffer);
+  release_callback_(buffer.token);
+  buffer = Buffer{};
+}
+
+void AndroidHardwareBufferTextureGL::OnGrContextCreated() {
+  texture_name_ = 0;
+}
+
+void AndroidHardwareBufferTextureGL::OnGrContextDestroyed() {
+  // The context is still current, but its textures are about to go away with
+  // it. The texture shows nothing until the next buffer is pushed.
+  ReleaseAllBuffers(true);
+  if (texture_name_ != 0) {
+    glDeleteTextures(1, &texture_name_);
+    texture_name_ = 0;
+  }
+}
+
+void AndroidHardwareBufferTextureGL::MarkNewFrameAvailable() {
+  // The buffers are pushed along with the notification.
+}
+
+void AndroidHardwareBufferTextureGL::OnTextureUnregistered() {}
+
+}  // namespace flutter
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_HARDWARE_BUFFER_TEXTURE_GL_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_HARDWARE_BUFFER_TEXTURE_GL_H_
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES/gl.h>
+#include <android/hardware_buffer.h>
+#include <jni.h>
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include "flutter/common/graphics/texture.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An external texture that shows the `AHardwareBuffer`s that are
+///             pushed to it, such as the images of an `ImageReader` or the
+///             output buffers of a `MediaCodec`.
+///
+///             Each buffer is imported as an `EGLImage` once, when it is first
+///             painted, and sampled without copies and without calling into
+///             Java on the raster thread. A buffer that is replaced by a newer
+///             one is released once a fence shows that the GPU finished the
+///             frames that read it, and at most |kMaxRetiredBuffers| buffers
+///             wait for their fences, so that producers with a small queue of
+///             buffers do not starve.
+///
+///             The `AHardwareBuffer` functions are resolved at runtime, as
+///             they are only available from API 26 on.
+///
+class AndroidHardwareBufferTextureGL : public flutter::Texture {
+ public:
+  //----------------------------------------------------------------------------
+  /// Called with the token a buffer was pushed with, once the texture no
+  /// longer reads it. Called on the raster thread, or on the thread the buffer
+  /// was pushed on if it was replaced before it was painted.
+  ///
+  using ReleaseCallback = std::function<void(int64_t token)>;
+
+  static constexpr size_t kMaxRetiredBuffers = 2;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the platform provides the functions that are needed
+  ///             to import hardware buffers into GL textures.
+  ///
+  static bool IsSupported();
+
+  AndroidHardwareBufferTextureGL(int64_t id, ReleaseCallback release_callback);
+
+  ~AndroidHardwareBufferTextureGL() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Shows the `android.hardware.HardwareBuffer` `hardware_buffer`
+  ///             from the next frame on, and keeps a reference to it until
+  ///             the release callback is invoked with `token`.
+  ///
+  ///             May be called on any thread that is attached to the JVM.
+  ///
+  /// @return     Whether the buffer was pushed. The release callback is not
+  ///             invoked for buffers that were not.
+  ///
+  bool PushBuffer(JNIEnv* env, jobject hardware_buffer, int64_t token);
+
+  // |flutter::Texture|
+  void Paint(SkCanvas& canvas,
+             const SkRect& bounds,
+             bool freeze,
+             GrDirectContext* context,
+             const SkSamplingOptions& sampling) override;
+
+  // |flutter::Texture|
+  void OnGrContextCreated() override;
+
+  // |flutter::Texture|
+  void OnGrContextDestroyed() override;
+
+  // |flutter::Texture|
+  void MarkNewFrameAvailable() override;
+
+  // |flutter::Texture|
+  void OnTextureUnregistered() override;
+
+ private:
+  struct Buffer {
+    AHardwareBuffer* hardware_buffer = nullptr;
+    int64_t token = 0;
+    EGLImageKHR image = EGL_NO_IMAGE_KHR;
+    // Signaled once the GPU finished the frames that read the buffer.
+    EGLSyncKHR fence = EGL_NO_SYNC_KHR;
+  };
+
+  const ReleaseCallback release_callback_;
+
+  std::mutex pending_buffer_mutex_;
+  std::optional<Buffer> pending_buffer_;
+
+  // Only accessed on the raster thread.
+  EGLDisplay display_ = EGL_NO_DISPLAY;
+  std::optional<Buffer> current_buffer_;
+  std::deque<Buffer> retired_buffers_;
+  GLuint texture_name_ = 0;
+  SkISize size_ = SkISize::MakeEmpty();
+
+  // Imports the pending buffer, if there is one, and retires the current one.
+  void UpdateCurrentBuffer(GrDirectContext* context);
+
+  // Releases the retired buffers whose fences are signaled, and waits for the
+  // oldest ones while there are more than |kMaxRetiredBuffers|.
+  void ReleaseRetiredBuffers();
+
+  // Releases the pending, current and retired buffers, waiting for the GPU to
+  // finish reading them if |wait| is true.
+  void ReleaseAllBuffers(bool wait);
+
+  void ReleaseBuffer(Buffer& buffer);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidHardwareBufferTextureGL);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_HARDWARE_BUFFER_TEXTURE_GL_H_
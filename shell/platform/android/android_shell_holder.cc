@@ -7,7 +7,6 @@
 #include "flutter/shell/platform/android/android_shell_holder.h"
 
 #include <pthread.h>
-#include <sys/resource.h>
 #include <sys/time.h>
 #include <memory>
 #include <optional>
@@ -44,11 +43,24 @@ AndroidShellHolder::AndroidShellHolder(
 
   thread_host_ = std::make_shared<ThreadHost>();
   if (is_background_view) {
-    *thread_host_ = {thread_label, ThreadHost::Type::UI};
+    // The single thread of a background view does all of the work, none of
+    // which is put on screen.
+    ThreadHost::ThreadConfigs configs;
+    configs[ThreadHost::Type::UI].priority =
+        fml::Thread::ThreadPriority::kBackground;
+    *thread_host_ = {thread_label, ThreadHost::Type::UI, configs};
   } else {
-    *thread_host_ = {thread_label, ThreadHost::Type::UI |
-                                       ThreadHost::Type::RASTER |
-                                       ThreadHost::Type::IO};
+    ThreadHost::ThreadConfigs configs;
+    configs[ThreadHost::Type::UI].priority =
+        fml::Thread::ThreadPriority::kDisplay;
+    configs[ThreadHost::Type::RASTER].priority =
+        fml::Thread::ThreadPriority::kRaster;
+    configs[ThreadHost::Type::IO].priority =
+        fml::Thread::ThreadPriority::kBackground;
+    *thread_host_ = {thread_label,
+                     ThreadHost::Type::UI | ThreadHost::Type::RASTER |
+                         ThreadHost::Type::IO,
+                     configs};
   }
 
   fml::WeakPtr<PlatformViewAndroid> weak_platform_view;
@@ -66,6 +78,13 @@ AndroidShellHolder::AndroidShellHolder(
         weak_platform_view = platform_view_android->GetWeakPtr();
         auto display = Display(jni_facade->GetDisplayRefreshRate());
         shell.OnDisplayUpdates(DisplayUpdateType::kStartup, {display});
+        platform_view_android->SetDisplayRefreshRateCallback(
+            [&shell](double refresh_rate) {
+              shell.OnDisplayUpdates(DisplayUpdateType::kConfigurationChanged,
+                                     {Display(refresh_rate)});
+            });
+        platform_view_android->SetUsesPlatformViewTransactions(
+            shell.GetSettings().enable_platform_view_transactions);
         return platform_view_android;
       };
 
@@ -98,28 +117,6 @@ AndroidShellHolder::AndroidShellHolder(
                                     ui_runner,        // ui
                                     io_runner         // io
   );
-  task_runners.GetRasterTaskRunner()->PostTask([]() {
-    // Android describes -8 as "most important display threads, for
-    // compositing the screen and retrieving input events". Conservatively
-    // set the raster thread to slightly lower priority than it.
-    if (::setpriority(PRIO_PROCESS, gettid(), -5) != 0) {
-      // Defensive fallback. Depending on the OEM, it may not be possible
-      // to set priority to -5.
-      if (::setpriority(PRIO_PROCESS, gettid(), -2) != 0) {
-        FML_LOG(ERROR) << "Failed to set raster task runner priority";
-      }
-    }
-  });
-  task_runners.GetUITaskRunner()->PostTask([]() {
-    if (::setpriority(PRIO_PROCESS, gettid(), -1) != 0) {
-      FML_LOG(ERROR) << "Failed to set UI task runner priority";
-    }
-  });
-  task_runners.GetIOTaskRunner()->PostTask([]() {
-    if (::setpriority(PRIO_PROCESS, gettid(), 1) != 0) {
-      FML_LOG(ERROR) << "Failed to set IO task runner priority";
-    }
-  });
 
   shell_ =
       Shell::Create(GetDefaultPlatformData(),  // window data
@@ -131,7 +128,8 @@ AndroidShellHolder::AndroidShellHolder(
 
   if (shell_) {
     shell_->GetDartVM()->GetConcurrentMessageLoop()->PostTaskToAllWorkers([]() {
-      if (::setpriority(PRIO_PROCESS, gettid(), 1) != 0) {
+      if (!fml::Thread::SetCurrentThreadPriority(
+              fml::Thread::ThreadPriority::kBackground)) {
         FML_LOG(ERROR) << "Failed to set Workers task runner priority";
       }
     });
@@ -213,6 +211,13 @@ std::unique_ptr<AndroidShellHolder> AndroidShellHolder::Spawn(
         weak_platform_view = platform_view_android->GetWeakPtr();
         auto display = Display(jni_facade->GetDisplayRefreshRate());
         shell.OnDisplayUpdates(DisplayUpdateType::kStartup, {display});
+        platform_view_android->SetDisplayRefreshRateCallback(
+            [&shell](double refresh_rate) {
+              shell.OnDisplayUpdates(DisplayUpdateType::kConfigurationChanged,
+                                     {Display(refresh_rate)});
+            });
+        platform_view_android->SetUsesPlatformViewTransactions(
+            shell.GetSettings().enable_platform_view_transactions);
         return platform_view_android;
       };
 
@@ -271,6 +276,11 @@ void AndroidShellHolder::NotifyLowMemoryWarning() {
   shell_->NotifyLowMemoryWarning();
 }
 
+void AndroidShellHolder::NotifyMemoryPressure(MemoryPressureLevel level) {
+  FML_DCHECK(shell_);
+  shell_->NotifyMemoryPressure(level);
+}
+
 std::optional<RunConfiguration> AndroidShellHolder::BuildRunConfiguration(
     std::shared_ptr<flutter::AssetManager> asset_manager,
     const std::string& entrypoint,
@@ -113,6 +113,11 @@ bool AndroidSurfaceSoftware::PresentBackingStore(
     return false;
   }
 
+  std::scoped_lock lock(native_window_mutex_);
+  if (!native_window_ || !native_window_->IsValid()) {
+    return false;
+  }
+
   ANativeWindow_Buffer native_buffer;
   if (ANativeWindow_lock(native_window_->handle(), &native_buffer, nullptr)) {
     return false;
@@ -144,6 +149,10 @@ bool AndroidSurfaceSoftware::PresentBackingStore(
   return true;
 }
 
+bool AndroidSurfaceSoftware::BackingStoreSupportsThreadedPresent() const {
+  return true;
+}
+
 void AndroidSurfaceSoftware::TeardownOnScreenContext() {}
 
 bool AndroidSurfaceSoftware::OnScreenSurfaceResize(const SkISize& size) {
@@ -152,6 +161,7 @@ bool AndroidSurfaceSoftware::OnScreenSurfaceResize(const SkISize& size) {
 
 bool AndroidSurfaceSoftware::SetNativeWindow(
     fml::RefPtr<AndroidNativeWindow> window) {
+  std::scoped_lock lock(native_window_mutex_);
   native_window_ = std::move(window);
   if (!(native_window_ && native_window_->IsValid()))
     return false;
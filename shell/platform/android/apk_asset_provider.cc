@@ -4,12 +4,15 @@
 
 #include "flutter/shell/platform/android/apk_asset_provider.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include <algorithm>
 #include <sstream>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
@@ -54,12 +57,116 @@ class APKAssetMapping : public fml::Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(APKAssetMapping);
 };
 
+// An asset that is stored uncompressed in an APK, mapped straight from the
+// APK file.
+class APKStoredAssetMapping : public fml::Mapping {
+ public:
+  APKStoredAssetMapping(int fd, off64_t offset, size_t length)
+      : length_(length) {
+    // The offset of a mapping must be a multiple of the page size.
+    static const off64_t page_size = sysconf(_SC_PAGESIZE);
+    const off64_t page_offset = offset % page_size;
+    mapping_size_ = length + page_offset;
+    void* mapping = mmap64(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd,
+                           offset - page_offset);
+    if (mapping == MAP_FAILED) {
+      return;
+    }
+    mapping_ = static_cast<uint8_t*>(mapping);
+    data_ = mapping_ + page_offset;
+  }
+
+  ~APKStoredAssetMapping() override {
+    if (mapping_) {
+      munmap(mapping_, mapping_size_);
+    }
+  }
+
+  bool IsValid() const { return data_ != nullptr; }
+
+  size_t GetSize() const override { return length_; }
+
+  const uint8_t* GetMapping() const override { return data_; }
+
+ private:
+  const size_t length_;
+  size_t mapping_size_ = 0;
+  uint8_t* mapping_ = nullptr;
+  const uint8_t* data_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(APKStoredAssetMapping);
+};
+
+std::optional<APKAssetProvider::StoredAsset>
+APKAssetProvider::LookUpStoredAsset(const std::string& path) const {
+  // Opening an asset without a mode does not read or decompress it yet.
+  AAsset* asset =
+      AAssetManager_open(assetManager_, path.c_str(), AASSET_MODE_UNKNOWN);
+  if (!asset) {
+    return std::nullopt;
+  }
+  off64_t offset = 0;
+  off64_t length = 0;
+  // This fails for compressed assets.
+  fml::UniqueFD fd(AAsset_openFileDescriptor64(asset, &offset, &length));
+  AAsset_close(asset);
+  if (!fd.is_valid()) {
+    return std::nullopt;
+  }
+
+  struct stat64 apk_stat;
+  if (fstat64(fd.get(), &apk_stat) != 0) {
+    return std::nullopt;
+  }
+  for (const auto& apk_file : apk_files_) {
+    if (apk_file.device == apk_stat.st_dev &&
+        apk_file.inode == apk_stat.st_ino) {
+      return StoredAsset{apk_file.fd, offset, length};
+    }
+  }
+  auto apk_fd = std::make_shared<fml::UniqueFD>(std::move(fd));
+  apk_files_.push_back({apk_stat.st_dev, apk_stat.st_ino, apk_fd});
+  return StoredAsset{std::move(apk_fd), offset, length};
+}
+
+std::unique_ptr<fml::Mapping> APKAssetProvider::MapStoredAsset(
+    const std::string& path) const {
+  std::optional<StoredAsset> stored_asset;
+  {
+    std::scoped_lock lock(index_mutex_);
+    auto found = index_.find(path);
+    if (found == index_.end()) {
+      found = index_.emplace(path, LookUpStoredAsset(path)).first;
+    }
+    stored_asset = found->second;
+  }
+  if (!stored_asset || stored_asset->length == 0) {
+    return nullptr;
+  }
+
+  TRACE_EVENT0("flutter", "APKAssetProvider::MapStoredAsset");
+  auto mapping = std::make_unique<APKStoredAssetMapping>(
+      stored_asset->apk_fd->get(), stored_asset->offset, stored_asset->length);
+  if (!mapping->IsValid()) {
+    return nullptr;
+  }
+  return mapping;
+}
+
 std::unique_ptr<fml::Mapping> APKAssetProvider::GetAsMapping(
     const std::string& asset_name) const {
   std::stringstream ss;
   ss << directory_.c_str() << "/" << asset_name;
+  const std::string path = ss.str();
+
+  // Stored assets are mapped from the APK. Compressed ones are decompressed
+  // by the asset manager.
+  if (auto mapping = MapStoredAsset(path)) {
+    return mapping;
+  }
+
   AAsset* asset =
-      AAssetManager_open(assetManager_, ss.str().c_str(), AASSET_MODE_BUFFER);
+      AAssetManager_open(assetManager_, path.c_str(), AASSET_MODE_BUFFER);
   if (!asset) {
     return nullptr;
   }
@@ -7,10 +7,18 @@
 
 #include <android/asset_manager_jni.h>
 #include <jni.h>
+#include <sys/types.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/platform/android/scoped_java_ref.h"
+#include "flutter/fml/unique_fd.h"
 
 namespace flutter {
 
@@ -22,10 +30,37 @@ class APKAssetProvider final : public AssetResolver {
   ~APKAssetProvider() override;
 
  private:
+  // Where an asset that is stored uncompressed lives in its APK.
+  struct StoredAsset {
+    std::shared_ptr<fml::UniqueFD> apk_fd;
+    off64_t offset;
+    off64_t length;
+  };
+
+  // An APK file that stored assets were found in.
+  struct APKFile {
+    dev_t device;
+    ino_t inode;
+    std::shared_ptr<fml::UniqueFD> fd;
+  };
+
   fml::jni::ScopedJavaGlobalRef<jobject> java_asset_manager_;
   AAssetManager* assetManager_;
   const std::string directory_;
 
+  // Every asset that was looked up, mapped to where it is stored in its APK,
+  // or to nothing if it is compressed or missing. Stored assets are mapped
+  // straight from the APK file the next time, without going through the
+  // asset manager.
+  mutable std::mutex index_mutex_;
+  mutable std::unordered_map<std::string, std::optional<StoredAsset>> index_;
+  // One descriptor per APK file, shared by the assets stored in it.
+  mutable std::vector<APKFile> apk_files_;
+
+  std::optional<StoredAsset> LookUpStoredAsset(const std::string& path) const;
+
+  std::unique_ptr<fml::Mapping> MapStoredAsset(const std::string& path) const;
+
   // |flutter::AssetResolver|
   bool IsValid() const override;
 
@@ -12,12 +12,14 @@ namespace flutter {
 AndroidExternalViewEmbedder::AndroidExternalViewEmbedder(
     const AndroidContext& android_context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-    std::shared_ptr<AndroidSurfaceFactory> surface_factory)
+    std::shared_ptr<AndroidSurfaceFactory> surface_factory,
+    fml::RefPtr<fml::TaskRunner> platform_task_runner)
     : ExternalViewEmbedder(),
       android_context_(android_context),
       jni_facade_(jni_facade),
       surface_factory_(surface_factory),
-      surface_pool_(std::make_unique<SurfacePool>()) {}
+      surface_pool_(std::make_unique<SurfacePool>()),
+      platform_task_runner_(std::move(platform_task_runner)) {}
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView(
@@ -88,10 +90,7 @@ void AndroidExternalViewEmbedder::SubmitFrame(
   std::unordered_map<int64_t, sk_sp<SkPicture>> pictures;
   SkCanvas* background_canvas = frame->SkiaCanvas();
   auto current_frame_view_count = composition_order_.size();
-
-  // Restore the clip context after exiting this method since it's changed
-  // below.
-  SkAutoCanvasRestore save(background_canvas, /*doSave=*/true);
+  size_t overlay_count = 0;
 
   for (size_t i = 0; i < current_frame_view_count; i++) {
     int64_t view_id = composition_order_[i];
@@ -138,13 +137,42 @@ void AndroidExternalViewEmbedder::SubmitFrame(
         // 5}.
         intersection_rect.set(intersection_rect.roundOut());
         overlay_layers.at(view_id).push_back(intersection_rect);
-        // Clip the background canvas, so it doesn't contain any of the pixels
-        // drawn on the overlay layer.
-        background_canvas->clipRect(intersection_rect, SkClipOp::kDifference);
+        overlay_count++;
       }
     }
+  }
+
+  // Overlay surfaces can only be created on the platform thread. If the pool
+  // runs out of them while the frame is composited on the raster thread, the
+  // overlays are drawn on the background for this frame, and the surfaces are
+  // created on the platform thread at the end of the frame.
+  surface_pool_->RecordDemand(overlay_count);
+  if (!frame_on_platform_thread_ &&
+      overlay_count > surface_pool_->GetUnusedLayers().size()) {
+    for (auto& overlay_layer : overlay_layers) {
+      overlay_layer.second.clear();
+    }
+  }
+
+  // Restore the clip context after exiting this method since it's changed
+  // below.
+  SkAutoCanvasRestore save(background_canvas, /*doSave=*/true);
+
+  for (int64_t view_id : composition_order_) {
+    for (const SkRect& overlay_rect : overlay_layers.at(view_id)) {
+      // Clip the background canvas, so it doesn't contain any of the pixels
+      // drawn on the overlay layer.
+      background_canvas->clipRect(overlay_rect, SkClipOp::kDifference);
+    }
     background_canvas->drawPicture(pictures.at(view_id));
   }
+
+  // Don't replace the contents of the surfaces before the platform thread has
+  // displayed the ones of the previous frame.
+  if (transaction_applied_ && !frame_on_platform_thread_) {
+    TRACE_EVENT0("flutter", "AndroidExternalViewEmbedder::WaitForTransaction");
+    transaction_applied_->WaitWithTimeout(kTransactionFenceTimeout);
+  }
   // Submit the background canvas frame before switching the GL context to
   // the overlay surfaces.
   //
@@ -160,16 +188,21 @@ void AndroidExternalViewEmbedder::SubmitFrame(
     const EmbeddedViewParams& params = view_params_.at(view_id);
     // Display the platform view. If it's already displayed, then it's
     // just positioned and sized.
-    jni_facade_->FlutterViewOnDisplayPlatformView(
-        view_id,             //
-        view_rect.x(),       //
-        view_rect.y(),       //
-        view_rect.width(),   //
-        view_rect.height(),  //
-        params.sizePoints().width() * device_pixel_ratio_,
-        params.sizePoints().height() * device_pixel_ratio_,
-        params.mutatorsStack()  //
-    );
+    int view_width = params.sizePoints().width() * device_pixel_ratio_;
+    int view_height = params.sizePoints().height() * device_pixel_ratio_;
+    CallOnPlatformThread([jni_facade = jni_facade_, view_id, view_rect,
+                          view_width, view_height,
+                          mutators_stack = params.mutatorsStack()]() {
+      jni_facade->FlutterViewOnDisplayPlatformView(view_id,             //
+                                                   view_rect.x(),       //
+                                                   view_rect.y(),       //
+                                                   view_rect.width(),   //
+                                                   view_rect.height(),  //
+                                                   view_width,          //
+                                                   view_height,         //
+                                                   mutators_stack       //
+      );
+    });
     for (const SkRect& overlay_rect : overlay_layers.at(view_id)) {
       std::unique_ptr<SurfaceFrame> frame =
           CreateSurfaceIfNeeded(context,               //
@@ -197,12 +230,14 @@ AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
       layer->surface->AcquireFrame(frame_size_);
   // Display the overlay surface. If it's already displayed, then it's
   // just positioned and sized.
-  jni_facade_->FlutterViewDisplayOverlaySurface(layer->id,     //
-                                                rect.x(),      //
-                                                rect.y(),      //
-                                                rect.width(),  //
-                                                rect.height()  //
-  );
+  CallOnPlatformThread([jni_facade = jni_facade_, id = layer->id, rect]() {
+    jni_facade->FlutterViewDisplayOverlaySurface(id,            //
+                                                 rect.x(),      //
+                                                 rect.y(),      //
+                                                 rect.width(),  //
+                                                 rect.height()  //
+    );
+  });
   SkCanvas* overlay_canvas = frame->SkiaCanvas();
   overlay_canvas->clear(SK_ColorTRANSPARENT);
   // Offset the picture since its absolute position on the scene is determined
@@ -218,6 +253,9 @@ PostPrerollResult AndroidExternalViewEmbedder::PostPrerollAction(
   if (!FrameHasPlatformLayers()) {
     return PostPrerollResult::kSuccess;
   }
+  if (UsesTransactions() && !FrameNeedsPlatformThread()) {
+    return PostPrerollResult::kSuccess;
+  }
   if (!raster_thread_merger->IsMerged()) {
     // The raster thread merger may be disabled if the rasterizer is being
     // created or teared down.
@@ -227,11 +265,15 @@ PostPrerollResult AndroidExternalViewEmbedder::PostPrerollAction(
     //
     // Eventually, the frame is submitted once this method returns `kSuccess`.
     // At that point, the raster tasks are handled on the platform thread.
-    raster_thread_merger->MergeWithLease(kDefaultMergedLeaseDuration);
+    raster_thread_merger->MergeWithLease(UsesTransactions()
+                                             ? kTransactionMergedLeaseDuration
+                                             : kDefaultMergedLeaseDuration);
     CancelFrame();
     return PostPrerollResult::kSkipAndRetryFrame;
   }
-  raster_thread_merger->ExtendLeaseTo(kDefaultMergedLeaseDuration);
+  if (!UsesTransactions()) {
+    raster_thread_merger->ExtendLeaseTo(kDefaultMergedLeaseDuration);
+  }
   // Surface switch requires to resubmit the frame.
   // TODO(egarciad): https://github.com/flutter/flutter/issues/65652
   if (previous_frame_view_count_ == 0) {
@@ -244,6 +286,26 @@ bool AndroidExternalViewEmbedder::FrameHasPlatformLayers() {
   return composition_order_.size() > 0;
 }
 
+bool AndroidExternalViewEmbedder::UsesTransactions() const {
+  return platform_task_runner_ != nullptr;
+}
+
+bool AndroidExternalViewEmbedder::FrameNeedsPlatformThread() const {
+  // The first frame with platform views switches the surface of the Flutter
+  // view, and the pool destroys the overlay surfaces that no longer have the
+  // size of the frame.
+  return previous_frame_view_count_ == 0 ||
+         surface_pool_->NeedsToDestroyLayers();
+}
+
+void AndroidExternalViewEmbedder::CallOnPlatformThread(fml::closure jni_call) {
+  if (frame_on_platform_thread_) {
+    jni_call();
+  } else if (UsesTransactions()) {
+    transaction_.push_back(std::move(jni_call));
+  }
+}
+
 // |ExternalViewEmbedder|
 SkCanvas* AndroidExternalViewEmbedder::GetRootCanvas() {
   // On Android, the root surface is created from the on-screen render target.
@@ -255,6 +317,7 @@ void AndroidExternalViewEmbedder::Reset() {
 
   composition_order_.clear();
   picture_recorders_.clear();
+  transaction_.clear();
 }
 
 // |ExternalViewEmbedder|
@@ -264,17 +327,18 @@ void AndroidExternalViewEmbedder::BeginFrame(
     double device_pixel_ratio,
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) {
   Reset();
+  frame_on_platform_thread_ = raster_thread_merger->IsOnPlatformThread();
 
-  // The surface size changed. Therefore, destroy existing surfaces as
-  // the existing surfaces in the pool can't be recycled.
-  if (frame_size_ != frame_size && raster_thread_merger->IsOnPlatformThread()) {
+  // The surface size changed to one the surfaces in the pool weren't created
+  // for. Therefore, destroy existing surfaces as they can't be recycled.
+  surface_pool_->SetFrameSize(frame_size);
+  if (frame_on_platform_thread_ && surface_pool_->NeedsToDestroyLayers()) {
     surface_pool_->DestroyLayers(jni_facade_);
   }
-  surface_pool_->SetFrameSize(frame_size);
   // JNI method must be called on the platform thread.
-  if (raster_thread_merger->IsOnPlatformThread()) {
-    jni_facade_->FlutterViewBeginFrame();
-  }
+  CallOnPlatformThread([jni_facade = jni_facade_]() {
+    jni_facade->FlutterViewBeginFrame();
+  });
 
   frame_size_ = frame_size;
   device_pixel_ratio_ = device_pixel_ratio;
@@ -291,9 +355,41 @@ void AndroidExternalViewEmbedder::EndFrame(
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) {
   surface_pool_->RecycleLayers();
   // JNI method must be called on the platform thread.
-  if (raster_thread_merger->IsOnPlatformThread()) {
+  if (frame_on_platform_thread_) {
     jni_facade_->FlutterViewEndFrame();
+    // Create the overlay surfaces that the recent frames needed before the
+    // next frames need them.
+    surface_pool_->PreallocateLayers(jni_facade_, surface_factory_);
+    return;
+  }
+  if (UsesTransactions()) {
+    surface_pool_->PreallocateLayersAsync(platform_task_runner_, jni_facade_,
+                                          surface_factory_);
   }
+  if (transaction_.empty()) {
+    return;
+  }
+  // A frame without platform views only needs to be handed to the platform
+  // thread if the previous one had some, so it can remove them.
+  if (!FrameHasPlatformLayers() && previous_frame_view_count_ == 0) {
+    transaction_.clear();
+    return;
+  }
+  transaction_.push_back([jni_facade = jni_facade_]() {
+    jni_facade->FlutterViewEndFrame();
+  });
+  auto transaction_applied = std::make_shared<fml::ManualResetWaitableEvent>();
+  platform_task_runner_->PostTask(
+      [transaction = std::move(transaction_), transaction_applied]() {
+        TRACE_EVENT0("flutter",
+                     "AndroidExternalViewEmbedder::ApplyTransaction");
+        for (const auto& jni_call : transaction) {
+          jni_call();
+        }
+        transaction_applied->Signal();
+      });
+  transaction_.clear();
+  transaction_applied_ = std::move(transaction_applied);
 }
 
 // |ExternalViewEmbedder|
@@ -301,4 +397,9 @@ bool AndroidExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return true;
 }
 
+// |ExternalViewEmbedder|
+bool AndroidExternalViewEmbedder::SubmitsFramesWithoutThreadMerging() {
+  return UsesTransactions();
+}
+
 }  // namespace flutter
@@ -9,6 +9,8 @@
 
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/rtree.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
@@ -27,12 +29,23 @@ namespace flutter {
 /// that render above (by Z order) the Android view corresponding to
 /// |flutter::PlatformViewLayer|.
 ///
+/// By default, the raster and platform threads are merged for as long as
+/// platform views are displayed, since the Java methods must be called on the
+/// platform thread. If a |platform_task_runner| is provided, the frames are
+/// instead rasterized on the raster thread, and the Java calls of each frame
+/// are posted to the platform thread as a single transaction. The threads are
+/// then only merged for the frames that set up the views and surfaces, which
+/// can only be done on the platform thread: the first frame with platform
+/// views, and the frames that destroy the overlay surfaces after a resize.
+/// Missing overlay surfaces are created in tasks posted to the platform thread.
+///
 class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
  public:
   AndroidExternalViewEmbedder(
       const AndroidContext& android_context,
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-      std::shared_ptr<AndroidSurfaceFactory> surface_factory);
+      std::shared_ptr<AndroidSurfaceFactory> surface_factory,
+      fml::RefPtr<fml::TaskRunner> platform_task_runner = nullptr);
 
   // |ExternalViewEmbedder|
   void PrerollCompositeEmbeddedView(
@@ -75,6 +88,9 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
 
   bool SupportsDynamicThreadMerging() override;
 
+  // |ExternalViewEmbedder|
+  bool SubmitsFramesWithoutThreadMerging() override;
+
   // Gets the rect based on the device pixel ratio of a platform view displayed
   // on the screen.
   SkRect GetViewRect(int view_id) const;
@@ -89,6 +105,17 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // where the platform view might be momentarily off the screen.
   static const int kDefaultMergedLeaseDuration = 10;
 
+  // The number of frames the threads stay merged for when a frame composited
+  // with transactions needs to set up views or surfaces.
+  static const int kTransactionMergedLeaseDuration = 1;
+
+  // How long the raster thread waits for the platform thread to apply the
+  // transaction of the previous frame before it submits the next one. The
+  // wait is bounded since the platform thread may itself be waiting for the
+  // raster thread.
+  static constexpr fml::TimeDelta kTransactionFenceTimeout =
+      fml::TimeDelta::FromMilliseconds(16);
+
   // Provides metadata to the Android surfaces.
   const AndroidContext& android_context_;
 
@@ -128,6 +155,32 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // The number of platform views in the previous frame.
   int64_t previous_frame_view_count_;
 
+  // The task runner the transactions are posted to, or null if the threads are
+  // merged while platform views are displayed.
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+
+  // Whether the current frame is composited on the platform thread, in which
+  // case the Java methods are called right away.
+  bool frame_on_platform_thread_ = false;
+
+  // The Java calls of the current frame that are posted to the platform thread
+  // at the end of the frame.
+  std::vector<fml::closure> transaction_;
+
+  // Signaled once the platform thread has applied the last posted transaction.
+  std::shared_ptr<fml::ManualResetWaitableEvent> transaction_applied_;
+
+  // Whether the frame calls the Java methods through transactions.
+  bool UsesTransactions() const;
+
+  // Whether the current frame needs the platform thread to set up the views or
+  // surfaces.
+  bool FrameNeedsPlatformThread() const;
+
+  // Calls |jni_call| now if the frame is composited on the platform thread, or
+  // else adds it to the transaction of the frame.
+  void CallOnPlatformThread(fml::closure jni_call);
+
   // Resets the state.
   void Reset();
 
@@ -571,11 +571,18 @@ TEST(AndroidExternalViewEmbedder, DestroyOverlayLayersOnSizeChange) {
     embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
   }
 
-  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurfaces());
+  // Change the frame size. The surfaces of the previous frame size are kept.
+  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurfaces()).Times(0);
   EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
-  // Change the frame size.
   embedder->BeginFrame(SkISize::Make(30, 40), nullptr, 1.0,
                        raster_thread_merger);
+  embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
+
+  // Change the frame size again. The surfaces are of neither size anymore.
+  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurfaces());
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+  embedder->BeginFrame(SkISize::Make(50, 60), nullptr, 1.0,
+                       raster_thread_merger);
 }
 
 TEST(AndroidExternalViewEmbedder, DoesNotDestroyOverlayLayersOnSizeChange) {
@@ -662,6 +669,86 @@ TEST(AndroidExternalViewEmbedder, DoesNotDestroyOverlayLayersOnSizeChange) {
                        GetThreadMergerFromRasterThread());
 }
 
+TEST(AndroidExternalViewEmbedder, TransactionsMergeForFirstFrameWithViews) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  fml::Thread platform_thread("platform");
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, platform_thread.GetTaskRunner());
+  ASSERT_TRUE(embedder->SubmitsFramesWithoutThreadMerging());
+
+  auto raster_thread_merger = GetThreadMergerFromRasterThread();
+  ASSERT_FALSE(raster_thread_merger->IsMerged());
+
+  embedder->BeginFrame(SkISize::Make(10, 20), nullptr, 1.0,
+                       raster_thread_merger);
+  embedder->PrerollCompositeEmbeddedView(
+      0, std::make_unique<EmbeddedViewParams>());
+
+  // The first frame with platform views switches the surface of the Flutter
+  // view, which can only be done on the platform thread.
+  auto postpreroll_result = embedder->PostPrerollAction(raster_thread_merger);
+  ASSERT_EQ(PostPrerollResult::kSkipAndRetryFrame, postpreroll_result);
+  ASSERT_TRUE(raster_thread_merger->IsMerged());
+
+  embedder->EndFrame(/*should_resubmit_frame=*/true, raster_thread_merger);
+  raster_thread_merger->UnMergeNow();
+}
+
+TEST(AndroidExternalViewEmbedder, TransactionsPostJNICallsToPlatformThread) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  fml::Thread platform_thread("platform");
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, platform_thread.GetTaskRunner());
+
+  auto raster_thread_merger = GetThreadMergerFromRasterThread();
+
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame()).Times(2);
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame()).Times(2);
+
+  for (int frame = 0; frame < 2; frame++) {
+    embedder->BeginFrame(SkISize::Make(10, 20), nullptr, 1.0,
+                         raster_thread_merger);
+    embedder->PrerollCompositeEmbeddedView(
+        0, std::make_unique<EmbeddedViewParams>());
+    if (frame > 0) {
+      // Once the platform views are set up, the frames stay on the raster
+      // thread.
+      auto postpreroll_result =
+          embedder->PostPrerollAction(raster_thread_merger);
+      ASSERT_EQ(PostPrerollResult::kSuccess, postpreroll_result);
+      ASSERT_FALSE(raster_thread_merger->IsMerged());
+    }
+    embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
+  }
+
+  fml::AutoResetWaitableEvent latch;
+  platform_thread.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+}
+
+TEST(AndroidExternalViewEmbedder, TransactionsSkipFramesWithoutViews) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  fml::Thread platform_thread("platform");
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, platform_thread.GetTaskRunner());
+
+  auto raster_thread_merger = GetThreadMergerFromRasterThread();
+
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame()).Times(0);
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame()).Times(0);
+
+  embedder->BeginFrame(SkISize::Make(10, 20), nullptr, 1.0,
+                       raster_thread_merger);
+  embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
+
+  fml::AutoResetWaitableEvent latch;
+  platform_thread.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+}
+
 TEST(AndroidExternalViewEmbedder, SupportsDynamicThreadMerging) {
   auto jni_mock = std::make_shared<JNIMock>();
   auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
@@ -4,6 +4,10 @@
 
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
+
 namespace flutter {
 
 OverlayLayer::OverlayLayer(int id,
@@ -15,7 +19,8 @@ OverlayLayer::OverlayLayer(int id,
 
 OverlayLayer::~OverlayLayer() = default;
 
-SurfacePool::SurfacePool() = default;
+SurfacePool::SurfacePool()
+    : pending_layers_(std::make_shared<PendingLayers>()) {}
 
 SurfacePool::~SurfacePool() = default;
 
@@ -24,42 +29,31 @@ std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
     const AndroidContext& android_context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
     std::shared_ptr<AndroidSurfaceFactory> surface_factory) {
-  // Destroy current layers in the pool if the frame size has changed.
-  if (requested_frame_size_ != current_frame_size_) {
+  // Destroy current layers in the pool if the frame size has changed to a
+  // size they weren't created for.
+  if (NeedsToDestroyLayers()) {
     DestroyLayers(jni_facade);
   }
+  AdoptPendingLayers();
 
   intptr_t gr_context_key = reinterpret_cast<intptr_t>(gr_context);
+  std::shared_ptr<OverlayLayer> layer;
+  size_t index = 0;
+  for (const auto& candidate : layers_) {
+    if (candidate->frame_size == requested_frame_size_ &&
+        index++ == used_layer_count_) {
+      layer = candidate;
+      break;
+    }
+  }
   // Allocate a new surface if there isn't one available.
-  if (available_layer_index_ >= layers_.size()) {
-    std::unique_ptr<AndroidSurface> android_surface =
-        surface_factory->CreateSurface();
-
-    FML_CHECK(android_surface && android_surface->IsValid())
-        << "Could not create an OpenGL, Vulkan or Software surface to set up "
-           "rendering.";
-
-    std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata =
-        jni_facade->FlutterViewCreateOverlaySurface();
-
-    FML_CHECK(java_metadata->window);
-    android_surface->SetNativeWindow(java_metadata->window);
-
-    std::unique_ptr<Surface> surface =
-        android_surface->CreateGPUSurface(gr_context);
-
-    std::shared_ptr<OverlayLayer> layer =
-        std::make_shared<OverlayLayer>(java_metadata->id,           //
-                                       std::move(android_surface),  //
-                                       std::move(surface)           //
-        );
-    layer->gr_context_key = gr_context_key;
+  if (!layer) {
+    layer = CreateLayer(requested_frame_size_, jni_facade, surface_factory);
     layers_.push_back(layer);
   }
-  std::shared_ptr<OverlayLayer> layer = layers_[available_layer_index_];
   // Since the surfaces are recycled, it's possible that the GrContext is
   // different.
-  if (gr_context_key != layer->gr_context_key) {
+  if (!layer->surface || gr_context_key != layer->gr_context_key) {
     layer->gr_context_key = gr_context_key;
     // The overlay already exists, but the GrContext was changed so we need to
     // recreate the rendering surface with the new GrContext.
@@ -67,34 +61,186 @@ std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
         layer->android_surface->CreateGPUSurface(gr_context);
     layer->surface = std::move(surface);
   }
-  available_layer_index_++;
-  current_frame_size_ = requested_frame_size_;
+  used_layer_count_++;
   return layer;
 }
 
+std::shared_ptr<OverlayLayer> SurfacePool::CreateLayer(
+    SkISize frame_size,
+    const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade,
+    const std::shared_ptr<AndroidSurfaceFactory>& surface_factory) {
+  TRACE_EVENT0("flutter", "SurfacePool::CreateLayer");
+  std::unique_ptr<AndroidSurface> android_surface =
+      surface_factory->CreateSurface();
+
+  FML_CHECK(android_surface && android_surface->IsValid())
+      << "Could not create an OpenGL, Vulkan or Software surface to set up "
+         "rendering.";
+
+  std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata =
+      jni_facade->FlutterViewCreateOverlaySurface();
+
+  FML_CHECK(java_metadata->window);
+  android_surface->SetNativeWindow(java_metadata->window);
+
+  std::shared_ptr<OverlayLayer> layer =
+      std::make_shared<OverlayLayer>(java_metadata->id,           //
+                                     std::move(android_surface),  //
+                                     nullptr                      //
+      );
+  layer->gr_context_key = 0;
+  layer->frame_size = frame_size;
+  return layer;
+}
+
+void SurfacePool::RecordDemand(size_t layer_count) {
+  frame_demand_ = std::max(frame_demand_, layer_count);
+}
+
 void SurfacePool::RecycleLayers() {
-  available_layer_index_ = 0;
+  AdoptPendingLayers();
+  demand_history_[demand_history_index_] =
+      std::max(frame_demand_, used_layer_count_);
+  demand_history_index_ = (demand_history_index_ + 1) % kDemandHistorySize;
+  FML_TRACE_COUNTER("flutter", "SurfacePool", reinterpret_cast<int64_t>(this),
+                    "Layers", layers_.size(), "UsedLayers", used_layer_count_,
+                    "PeakDemand", GetPeakDemand());
+  frame_demand_ = 0;
+  used_layer_count_ = 0;
 }
 
 void SurfacePool::DestroyLayers(
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade) {
-  if (layers_.size() > 0) {
-    jni_facade->FlutterViewDestroyOverlaySurfaces();
+  {
+    // The Java overlays of the layers that haven't been adopted yet are
+    // destroyed too.
+    std::scoped_lock lock(pending_layers_->mutex);
+    if (layers_.size() > 0 || pending_layers_->layers.size() > 0) {
+      jni_facade->FlutterViewDestroyOverlaySurfaces();
+    }
+    pending_layers_->layers.clear();
   }
   layers_.clear();
-  available_layer_index_ = 0;
+  used_layer_count_ = 0;
+}
+
+bool SurfacePool::NeedsToDestroyLayers() const {
+  return std::any_of(layers_.begin(), layers_.end(), [&](const auto& layer) {
+    return !IsKeptFrameSize(layer->frame_size);
+  });
+}
+
+bool SurfacePool::IsKeptFrameSize(SkISize frame_size) const {
+  return frame_size == requested_frame_size_ ||
+         frame_size == previous_frame_size_;
 }
 
 std::vector<std::shared_ptr<OverlayLayer>> SurfacePool::GetUnusedLayers() {
+  AdoptPendingLayers();
   std::vector<std::shared_ptr<OverlayLayer>> results;
-  for (size_t i = available_layer_index_; i < layers_.size(); i++) {
-    results.push_back(layers_[i]);
+  size_t index = 0;
+  for (const auto& layer : layers_) {
+    if (layer->frame_size == requested_frame_size_ &&
+        index++ >= used_layer_count_) {
+      results.push_back(layer);
+    }
   }
   return results;
 }
 
 void SurfacePool::SetFrameSize(SkISize frame_size) {
-  requested_frame_size_ = frame_size;
+  if (frame_size != requested_frame_size_) {
+    previous_frame_size_ = requested_frame_size_;
+    requested_frame_size_ = frame_size;
+  }
+}
+
+size_t SurfacePool::GetMissingLayerCount() const {
+  if (NeedsToDestroyLayers()) {
+    return GetPeakDemand();
+  }
+  size_t available = CountLayersOfSize(requested_frame_size_);
+  {
+    std::scoped_lock lock(pending_layers_->mutex);
+    for (const auto& layer : pending_layers_->layers) {
+      available += layer->frame_size == requested_frame_size_;
+    }
+    available += pending_layers_->requested_count;
+  }
+  const size_t peak_demand = GetPeakDemand();
+  return peak_demand > available ? peak_demand - available : 0;
+}
+
+void SurfacePool::PreallocateLayers(
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+    std::shared_ptr<AndroidSurfaceFactory> surface_factory) {
+  if (NeedsToDestroyLayers()) {
+    DestroyLayers(jni_facade);
+  }
+  size_t missing_layer_count = GetMissingLayerCount();
+  if (missing_layer_count == 0) {
+    return;
+  }
+  TRACE_EVENT1("flutter", "SurfacePool::PreallocateLayers", "count",
+               std::to_string(missing_layer_count).c_str());
+  for (size_t i = 0; i < missing_layer_count; i++) {
+    layers_.push_back(
+        CreateLayer(requested_frame_size_, jni_facade, surface_factory));
+  }
+}
+
+void SurfacePool::PreallocateLayersAsync(
+    fml::RefPtr<fml::TaskRunner> platform_task_runner,
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+    std::shared_ptr<AndroidSurfaceFactory> surface_factory) {
+  // Destroying the layers of another size requires the platform thread to
+  // wait for the frame, which |PreallocateLayers| does.
+  if (NeedsToDestroyLayers()) {
+    return;
+  }
+  size_t missing_layer_count = GetMissingLayerCount();
+  if (missing_layer_count == 0) {
+    return;
+  }
+  {
+    std::scoped_lock lock(pending_layers_->mutex);
+    pending_layers_->requested_count += missing_layer_count;
+  }
+  platform_task_runner->PostTask([pending_layers = pending_layers_,
+                                  frame_size = requested_frame_size_,
+                                  missing_layer_count, jni_facade,
+                                  surface_factory]() {
+    TRACE_EVENT1("flutter", "SurfacePool::PreallocateLayersAsync", "count",
+                 std::to_string(missing_layer_count).c_str());
+    for (size_t i = 0; i < missing_layer_count; i++) {
+      auto layer = CreateLayer(frame_size, jni_facade, surface_factory);
+      std::scoped_lock lock(pending_layers->mutex);
+      pending_layers->layers.push_back(std::move(layer));
+      pending_layers->requested_count--;
+    }
+  });
+}
+
+size_t SurfacePool::CountLayersOfSize(SkISize frame_size) const {
+  return std::count_if(
+      layers_.begin(), layers_.end(),
+      [&](const auto& layer) { return layer->frame_size == frame_size; });
+}
+
+size_t SurfacePool::GetPeakDemand() const {
+  return *std::max_element(demand_history_.begin(), demand_history_.end());
+}
+
+void SurfacePool::AdoptPendingLayers() {
+  std::scoped_lock lock(pending_layers_->mutex);
+  for (auto& layer : pending_layers_->layers) {
+    // The layers created for a size the pool no longer uses stay in the Java
+    // view hierarchy until the layers are destroyed, but are never displayed.
+    if (IsKeptFrameSize(layer->frame_size)) {
+      layers_.push_back(std::move(layer));
+    }
+  }
+  pending_layers_->layers.clear();
 }
 
 }  // namespace flutter
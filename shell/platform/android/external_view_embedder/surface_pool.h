@@ -5,7 +5,11 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_SURFACE_POOL_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_SURFACE_POOL_H_
 
+#include <array>
+#include <mutex>
+
 #include "flutter/flow/surface.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
 
@@ -30,9 +34,13 @@ struct OverlayLayer {
   // A GPU surface.
   const std::unique_ptr<AndroidSurface> android_surface;
 
-  // A GPU surface. This may change when the overlay is recycled.
+  // A GPU surface. This may change when the overlay is recycled, and is null
+  // until the layer is first used if it was created ahead of need.
   std::unique_ptr<Surface> surface;
 
+  // The frame size the overlay was created for.
+  SkISize frame_size;
+
   // The `GrContext` that is currently used by the overlay surfaces.
   // We track this to know when the GrContext for the Flutter app has changed
   // so we can update the overlay with the new context.
@@ -41,7 +49,8 @@ struct OverlayLayer {
   intptr_t gr_context_key;
 };
 
-// This class isn't thread safe.
+// This class isn't thread safe, except for the layers created by
+// |PreallocateLayersAsync|, which are handed over through a lock.
 class SurfacePool {
  public:
   SurfacePool();
@@ -50,51 +59,111 @@ class SurfacePool {
 
   // Gets a layer from the pool if available, or allocates a new one.
   // Finally, it marks the layer as used. That is, it increments
-  // `available_layer_index_`.
+  // `used_layer_count_`.
   std::shared_ptr<OverlayLayer> GetLayer(
       GrDirectContext* gr_context,
       const AndroidContext& android_context,
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
       std::shared_ptr<AndroidSurfaceFactory> surface_factory);
 
-  // Gets the layers in the pool that aren't currently used.
-  // This method doesn't mark the layers as unused.
+  // Whether |GetLayer| has to destroy the layers in the pool, because some of
+  // them have neither the frame size set by |SetFrameSize| nor the one before
+  // it.
+  bool NeedsToDestroyLayers() const;
+
+  // Gets the layers of the current frame size in the pool that aren't
+  // currently used, including the ones |PreallocateLayersAsync| created since
+  // the last call. This method doesn't mark the layers as unused.
   std::vector<std::shared_ptr<OverlayLayer>> GetUnusedLayers();
 
-  // Marks the layers in the pool as available for reuse.
+  // Records that the current frame needs |layer_count| layers, including the
+  // ones it couldn't get from the pool.
+  void RecordDemand(size_t layer_count);
+
+  // Marks the layers in the pool as available for reuse, and records the
+  // demand of the frame.
   void RecycleLayers();
 
   // Destroys all the layers in the pool.
   void DestroyLayers(std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
 
   // Sets the frame size used by the layers in the pool.
-  // If the current layers in the pool have a different frame size,
-  // then they are deallocated as soon as |GetLayer| is called.
+  // The layers of the previous frame size are kept, so that alternating
+  // between two sizes reuses them. If the layers in the pool have yet another
+  // frame size, then they are deallocated as soon as |GetLayer| is called.
   void SetFrameSize(SkISize frame_size);
 
- private:
-  // The index of the entry in the layers_ vector that determines the beginning
-  // of the unused layers. For example, consider the following vector:
-  //  _____
-  //  | 0 |
-  //  |---|
-  //  | 1 | <-- `available_layer_index_`
-  //  |---|
-  //  | 2 |
-  //  |---|
-  //
-  //  This indicates that entries starting from 1 can be reused meanwhile the
-  //  entry at position 0 cannot be reused.
-  size_t available_layer_index_ = 0;
+  // The number of layers of the current frame size that the pool lacks to
+  // meet the peak demand of the recent frames.
+  size_t GetMissingLayerCount() const;
 
-  // The layers in the pool.
-  std::vector<std::shared_ptr<OverlayLayer>> layers_;
+  // Creates the layers the pool lacks to meet the recent peak demand. Must be
+  // called on the platform thread. The GPU surfaces of the layers are created
+  // the first time they are used.
+  void PreallocateLayers(
+      std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+      std::shared_ptr<AndroidSurfaceFactory> surface_factory);
 
-  // The frame size of the layers in the pool.
-  SkISize current_frame_size_;
+  // Like |PreallocateLayers|, but creates the layers in a task posted to
+  // |platform_task_runner|. They are added to the pool by the first call to
+  // |GetLayer|, |GetUnusedLayers| or |RecycleLayers| after they are created.
+  void PreallocateLayersAsync(
+      fml::RefPtr<fml::TaskRunner> platform_task_runner,
+      std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+      std::shared_ptr<AndroidSurfaceFactory> surface_factory);
+
+ private:
+  // The number of frames the peak demand is taken over.
+  static constexpr size_t kDemandHistorySize = 60;
+
+  // The layers created by |PreallocateLayersAsync| that have not been added to
+  // the pool yet.
+  struct PendingLayers {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<OverlayLayer>> layers;
+    // The number of layers being created by posted tasks.
+    size_t requested_count = 0;
+  };
+
+  // The number of layers of the current frame size handed out by |GetLayer|
+  // since the last |RecycleLayers|.
+  size_t used_layer_count_ = 0;
+
+  // The layers in the pool, of at most two frame sizes.
+  std::vector<std::shared_ptr<OverlayLayer>> layers_;
 
   // The frame size to be used by future layers.
   SkISize requested_frame_size_;
+
+  // The frame size before the last change, whose layers are kept.
+  SkISize previous_frame_size_;
+
+  // The number of layers each of the recent frames needed.
+  std::array<size_t, kDemandHistorySize> demand_history_ = {};
+  size_t demand_history_index_ = 0;
+
+  // The demand recorded for the current frame.
+  size_t frame_demand_ = 0;
+
+  const std::shared_ptr<PendingLayers> pending_layers_;
+
+  // Creates a layer for |frame_size|, without its GPU surface.
+  static std::shared_ptr<OverlayLayer> CreateLayer(
+      SkISize frame_size,
+      const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade,
+      const std::shared_ptr<AndroidSurfaceFactory>& surface_factory);
+
+  // Whether the layers of |frame_size| are kept in the pool.
+  bool IsKeptFrameSize(SkISize frame_size) const;
+
+  // The number of layers in the pool that have the frame size |frame_size|.
+  size_t CountLayersOfSize(SkISize frame_size) const;
+
+  // The peak demand of the recent frames.
+  size_t GetPeakDemand() const;
+
+  // Moves the layers created by |PreallocateLayersAsync| into the pool.
+  void AdoptPendingLayers();
 };
 
 }  // namespace flutter
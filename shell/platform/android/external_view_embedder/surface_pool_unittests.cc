@@ -6,6 +6,8 @@
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/shell/platform/android/jni/jni_mock.h"
 #include "flutter/shell/platform/android/surface/android_surface_mock.h"
 #include "gmock/gmock.h"
@@ -248,17 +250,120 @@ TEST(SurfacePool, DestroyLayers__frameSizeChanged) {
 
   pool->GetLayer(gr_context.get(), *android_context, jni_mock, surface_factory);
 
+  // The layers of the previous frame size are kept.
   pool->SetFrameSize(SkISize::Make(20, 20));
-  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurfaces()).Times(1);
+  ASSERT_FALSE(pool->NeedsToDestroyLayers());
   EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
       .Times(1)
       .WillOnce(Return(
           ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
               1, window))));
   pool->GetLayer(gr_context.get(), *android_context, jni_mock, surface_factory);
+  pool->RecycleLayers();
+
+  // Going back to the previous frame size reuses its layer.
+  pool->SetFrameSize(SkISize::Make(10, 10));
+  ASSERT_FALSE(pool->NeedsToDestroyLayers());
+  auto layer = pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                              surface_factory);
+  ASSERT_EQ(0, layer->id);
+  pool->RecycleLayers();
+
+  // A third frame size destroys the layers of the others.
+  pool->SetFrameSize(SkISize::Make(30, 30));
+  ASSERT_TRUE(pool->NeedsToDestroyLayers());
+  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurfaces()).Times(1);
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .Times(1)
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              2, window))));
+  pool->GetLayer(gr_context.get(), *android_context, jni_mock, surface_factory);
 
   ASSERT_TRUE(pool->GetUnusedLayers().empty());
 }
 
+TEST(SurfacePool, PreallocateLayers__PeakDemand) {
+  auto pool = std::make_unique<SurfacePool>();
+  auto jni_mock = std::make_shared<JNIMock>();
+
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+
+  auto surface_factory = std::make_shared<TestAndroidSurfaceFactory>(
+      [&android_context, window]() {
+        auto android_surface_mock =
+            std::make_unique<AndroidSurfaceMock>(android_context);
+        // The GPU surfaces are only created when the layers are used.
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface).Times(0);
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+        return android_surface_mock;
+      });
+
+  // Nothing is created before there is demand.
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface()).Times(0);
+  pool->PreallocateLayers(jni_mock, surface_factory);
+  ASSERT_EQ(0UL, pool->GetMissingLayerCount());
+
+  // A frame that needed two overlays, but didn't get any.
+  pool->RecordDemand(2);
+  pool->RecycleLayers();
+  ASSERT_EQ(2UL, pool->GetMissingLayerCount());
+
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .Times(2)
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              0, window))))
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              1, window))));
+  pool->PreallocateLayers(jni_mock, surface_factory);
+  ASSERT_EQ(0UL, pool->GetMissingLayerCount());
+  ASSERT_EQ(2UL, pool->GetUnusedLayers().size());
+}
+
+TEST(SurfacePool, PreallocateLayersAsync) {
+  auto pool = std::make_unique<SurfacePool>();
+  auto jni_mock = std::make_shared<JNIMock>();
+
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+
+  auto surface_factory = std::make_shared<TestAndroidSurfaceFactory>(
+      [&android_context, window]() {
+        auto android_surface_mock =
+            std::make_unique<AndroidSurfaceMock>(android_context);
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+        return android_surface_mock;
+      });
+
+  pool->RecordDemand(1);
+  pool->RecycleLayers();
+
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              0, window))));
+  fml::Thread platform_thread("platform");
+  pool->PreallocateLayersAsync(platform_thread.GetTaskRunner(), jni_mock,
+                               surface_factory);
+  // The layer being created counts towards the demand.
+  ASSERT_EQ(0UL, pool->GetMissingLayerCount());
+
+  fml::AutoResetWaitableEvent latch;
+  platform_thread.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  auto unused_layers = pool->GetUnusedLayers();
+  ASSERT_EQ(1UL, unused_layers.size());
+  ASSERT_EQ(0, unused_layers[0]->id);
+}
+
 }  // namespace testing
 }  // namespace flutter
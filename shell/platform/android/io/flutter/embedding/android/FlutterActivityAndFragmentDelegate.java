@@ -4,7 +4,10 @@
 
 package io.flutter.embedding.android;
 
+import static android.content.ComponentCallbacks2.TRIM_MEMORY_COMPLETE;
+import static android.content.ComponentCallbacks2.TRIM_MEMORY_RUNNING_CRITICAL;
 import static android.content.ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW;
+import static android.content.ComponentCallbacks2.TRIM_MEMORY_UI_HIDDEN;
 import static io.flutter.embedding.android.FlutterActivityLaunchConfigs.DEFAULT_INITIAL_ROUTE;
 
 import android.app.Activity;
@@ -24,6 +27,7 @@ import io.flutter.FlutterInjector;
 import io.flutter.Log;
 import io.flutter.embedding.engine.FlutterEngine;
 import io.flutter.embedding.engine.FlutterEngineCache;
+import io.flutter.embedding.engine.FlutterJNI;
 import io.flutter.embedding.engine.FlutterShellArgs;
 import io.flutter.embedding.engine.dart.DartExecutor;
 import io.flutter.embedding.engine.renderer.FlutterUiDisplayListener;
@@ -704,14 +708,13 @@ import java.util.Arrays;
    * <p>A {@code Fragment} host must have its containing {@code Activity} forward this call so that
    * the {@code Fragment} can then invoke this method.
    *
-   * <p>This method sends a "memory pressure warning" message to Flutter over the "system channel".
+   * <p>The trim level is mapped to the memory pressure level the engine frees resources for. This
+   * method also sends a "memory pressure warning" message to Flutter over the "system channel".
    */
   void onTrimMemory(int level) {
     ensureAlive();
     if (flutterEngine != null) {
-      // This is always an indication that the Dart VM should collect memory
-      // and free any unneeded resources.
-      flutterEngine.getDartExecutor().notifyLowMemoryWarning();
+      flutterEngine.getDartExecutor().notifyMemoryPressure(getMemoryPressureLevel(level));
       // Use a trim level delivered while the application is running so the
       // framework has a chance to react to the notification.
       if (level == TRIM_MEMORY_RUNNING_LOW) {
@@ -723,6 +726,24 @@ import java.util.Arrays;
     }
   }
 
+  /**
+   * Returns the engine memory pressure level, one of the {@code FlutterJNI.MEMORY_PRESSURE_LEVEL_*}
+   * constants, for a trim level given to {@link Activity#onTrimMemory(int)}.
+   */
+  private static int getMemoryPressureLevel(int trimLevel) {
+    if (trimLevel >= TRIM_MEMORY_COMPLETE) {
+      // The process is next in line to be killed.
+      return FlutterJNI.MEMORY_PRESSURE_LEVEL_CRITICAL;
+    }
+    if (trimLevel >= TRIM_MEMORY_UI_HIDDEN) {
+      return FlutterJNI.MEMORY_PRESSURE_LEVEL_BACKGROUND;
+    }
+    if (trimLevel >= TRIM_MEMORY_RUNNING_CRITICAL) {
+      return FlutterJNI.MEMORY_PRESSURE_LEVEL_CRITICAL;
+    }
+    return FlutterJNI.MEMORY_PRESSURE_LEVEL_MODERATE;
+  }
+
   /**
    * Invoke this from {@link Activity#onLowMemory()}.
    *
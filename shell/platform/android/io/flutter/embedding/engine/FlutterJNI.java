@@ -8,6 +8,7 @@ import android.content.Context;
 import android.content.res.AssetManager;
 import android.graphics.Bitmap;
 import android.graphics.SurfaceTexture;
+import android.hardware.HardwareBuffer;
 import android.os.Build;
 import android.os.Looper;
 import android.view.Surface;
@@ -15,6 +16,7 @@ import android.view.SurfaceHolder;
 import androidx.annotation.Keep;
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
+import androidx.annotation.RequiresApi;
 import androidx.annotation.UiThread;
 import androidx.annotation.VisibleForTesting;
 import io.flutter.Log;
@@ -23,6 +25,7 @@ import io.flutter.embedding.engine.dart.PlatformMessageHandler;
 import io.flutter.embedding.engine.deferredcomponents.DeferredComponentManager;
 import io.flutter.embedding.engine.mutatorsstack.FlutterMutatorsStack;
 import io.flutter.embedding.engine.renderer.FlutterUiDisplayListener;
+import io.flutter.embedding.engine.renderer.HardwareBufferTextureWrapper;
 import io.flutter.embedding.engine.renderer.RenderSurface;
 import io.flutter.embedding.engine.renderer.SurfaceTextureWrapper;
 import io.flutter.plugin.common.StandardMessageCodec;
@@ -717,6 +720,46 @@ public class FlutterJNI {
   private native void nativeRegisterTexture(
       long nativeShellHolderId, long textureId, @NonNull SurfaceTextureWrapper textureWrapper);
 
+  /**
+   * Registers a texture that shows the {@link HardwareBuffer}s pushed with {@link
+   * #pushHardwareBuffer(long, HardwareBuffer, long)}.
+   *
+   * @return Whether the renderer can import hardware buffers and the texture was registered.
+   */
+  @UiThread
+  public boolean registerHardwareBufferTexture(
+      long textureId, @NonNull HardwareBufferTextureWrapper textureWrapper) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    return nativeRegisterHardwareBufferTexture(nativeShellHolderId, textureId, textureWrapper);
+  }
+
+  private native boolean nativeRegisterHardwareBufferTexture(
+      long nativeShellHolderId,
+      long textureId,
+      @NonNull HardwareBufferTextureWrapper textureWrapper);
+
+  /**
+   * Shows {@code buffer} in the texture registered with {@link
+   * #registerHardwareBufferTexture(long, HardwareBufferTextureWrapper)} from the next frame on.
+   *
+   * <p>If the buffer is taken, the engine calls {@link
+   * HardwareBufferTextureWrapper#onBufferReleased(long)} with {@code token} once it no longer reads
+   * it.
+   *
+   * @return Whether the engine took the buffer.
+   */
+  @UiThread
+  @RequiresApi(26)
+  public boolean pushHardwareBuffer(long textureId, @NonNull HardwareBuffer buffer, long token) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    return nativePushHardwareBuffer(nativeShellHolderId, textureId, buffer, token);
+  }
+
+  private native boolean nativePushHardwareBuffer(
+      long nativeShellHolderId, long textureId, @NonNull HardwareBuffer buffer, long token);
+
   /**
    * Call this method to inform Flutter that a texture previously registered with {@link
    * #registerTexture(long, SurfaceTexture)} has a new frame available.
@@ -810,22 +853,48 @@ public class FlutterJNI {
   }
 
   // Called by native.
+  //
+  // The message is a direct buffer over memory that is owned by native code, which must be released
+  // with cleanupMessageData(messageData) once the message was handled.
   // TODO(mattcarroll): determine if message is nonull or nullable
   @SuppressWarnings("unused")
   @VisibleForTesting
   public void handlePlatformMessage(
-      @NonNull final String channel, byte[] message, final int replyId) {
+      @NonNull final String channel,
+      ByteBuffer message,
+      final int replyId,
+      final long messageData) {
     if (platformMessageHandler != null) {
-      platformMessageHandler.handleMessageFromDart(channel, message, replyId);
+      platformMessageHandler.handleMessageFromDart(channel, message, replyId, messageData);
+    } else {
+      cleanupMessageData(messageData);
     }
     // TODO(mattcarroll): log dropped messages when in debug mode
     // (https://github.com/flutter/flutter/issues/25391)
   }
 
+  /**
+   * Releases the native memory of a message that was passed to {@link
+   * PlatformMessageHandler#handleMessageFromDart(String, ByteBuffer, int, long)}, after which the
+   * {@code ByteBuffer} of the message must no longer be accessed.
+   */
+  public void cleanupMessageData(long messageData) {
+    // This does not rely on being attached like other methods, as the memory is not owned by the
+    // engine.
+    if (messageData != 0) {
+      nativeCleanupMessageData(messageData);
+    }
+  }
+
+  private static native void nativeCleanupMessageData(long messageData);
+
   // Called by native to respond to a platform message that we sent.
+  //
+  // The reply is a direct buffer over memory that is owned by native code, and is only valid until
+  // this method returns.
   // TODO(mattcarroll): determine if reply is nonull or nullable
   @SuppressWarnings("unused")
-  private void handlePlatformMessageResponse(int replyId, byte[] reply) {
+  private void handlePlatformMessageResponse(int replyId, ByteBuffer reply) {
     if (platformMessageHandler != null) {
       platformMessageHandler.handlePlatformMessageResponse(replyId, reply);
     }
@@ -1224,6 +1293,40 @@ public class FlutterJNI {
 
   private native void nativeNotifyLowMemoryWarning(long nativeShellHolderId);
 
+  /**
+   * The system is running low on memory while the application is in use. The engine trims its
+   * caches but keeps enough of them to keep rendering without stalls.
+   */
+  public static final int MEMORY_PRESSURE_LEVEL_MODERATE = 0;
+
+  /**
+   * The system is about to kill processes to reclaim memory. The engine releases everything that
+   * it can recreate and has the Dart VM collect garbage.
+   */
+  public static final int MEMORY_PRESSURE_LEVEL_CRITICAL = 1;
+
+  /**
+   * The application is no longer visible. The engine releases its rendering caches and has the
+   * Dart VM collect garbage.
+   */
+  public static final int MEMORY_PRESSURE_LEVEL_BACKGROUND = 2;
+
+  /**
+   * Notifies the engine of memory pressure of the given level, which is one of the {@code
+   * MEMORY_PRESSURE_LEVEL_*} constants.
+   *
+   * <p>Unlike {@link #notifyLowMemoryWarning()}, which is the same as critical pressure, this lets
+   * the engine keep the resources that it still needs under moderate pressure.
+   */
+  @UiThread
+  public void notifyMemoryPressure(int level) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativeNotifyMemoryPressure(nativeShellHolderId, level);
+  }
+
+  private native void nativeNotifyMemoryPressure(long nativeShellHolderId, int level);
+
   private void ensureRunningOnMainThread() {
     if (Looper.myLooper() != mainLooper) {
       throw new RuntimeException(
@@ -254,6 +254,19 @@ public class DartExecutor implements BinaryMessenger {
     }
   }
 
+  /**
+   * Notify the engine of memory pressure of the given level, one of the {@code
+   * FlutterJNI.MEMORY_PRESSURE_LEVEL_*} constants, so that it frees resources accordingly.
+   *
+   * <p>This does not notify a Flutter application about memory pressure. For that, use the {@link
+   * SystemChannel#sendMemoryPressureWarning}.
+   */
+  public void notifyMemoryPressure(int level) {
+    if (flutterJNI.isAttached()) {
+      flutterJNI.notifyMemoryPressure(level);
+    }
+  }
+
   /**
    * Configuration options that specify which Dart entrypoint function is executed and where to find
    * that entrypoint and other assets required for Dart execution.
@@ -75,34 +75,42 @@ class DartMessenger implements BinaryMessenger, PlatformMessageHandler {
 
   @Override
   public void handleMessageFromDart(
-      @NonNull final String channel, @Nullable byte[] message, final int replyId) {
+      @NonNull final String channel,
+      @Nullable ByteBuffer message,
+      final int replyId,
+      long messageData) {
     Log.v(TAG, "Received message from Dart over channel '" + channel + "'");
     BinaryMessenger.BinaryMessageHandler handler = messageHandlers.get(channel);
-    if (handler != null) {
-      try {
-        Log.v(TAG, "Deferring to registered handler to process message.");
-        final ByteBuffer buffer = (message == null ? null : ByteBuffer.wrap(message));
-        handler.onMessage(buffer, new Reply(flutterJNI, replyId));
-      } catch (Exception ex) {
-        Log.e(TAG, "Uncaught exception in binary message listener", ex);
+    try {
+      if (handler != null) {
+        try {
+          Log.v(TAG, "Deferring to registered handler to process message.");
+          handler.onMessage(message, new Reply(flutterJNI, replyId));
+        } catch (Exception ex) {
+          Log.e(TAG, "Uncaught exception in binary message listener", ex);
+          flutterJNI.invokePlatformMessageEmptyResponseCallback(replyId);
+        } catch (Error err) {
+          handleError(err);
+        }
+      } else {
+        Log.v(
+            TAG, "No registered handler for message. Responding to Dart with empty reply message.");
         flutterJNI.invokePlatformMessageEmptyResponseCallback(replyId);
-      } catch (Error err) {
-        handleError(err);
       }
-    } else {
-      Log.v(TAG, "No registered handler for message. Responding to Dart with empty reply message.");
-      flutterJNI.invokePlatformMessageEmptyResponseCallback(replyId);
+    } finally {
+      // The message is only valid while its handler runs, so that it is never copied.
+      flutterJNI.cleanupMessageData(messageData);
     }
   }
 
   @Override
-  public void handlePlatformMessageResponse(int replyId, @Nullable byte[] reply) {
+  public void handlePlatformMessageResponse(int replyId, @Nullable ByteBuffer reply) {
     Log.v(TAG, "Received message reply from Dart.");
     BinaryMessenger.BinaryReply callback = pendingReplies.remove(replyId);
     if (callback != null) {
       try {
         Log.v(TAG, "Invoking registered callback for reply from Dart.");
-        callback.reply(reply == null ? null : ByteBuffer.wrap(reply));
+        callback.reply(reply);
       } catch (Exception ex) {
         Log.e(TAG, "Uncaught exception in binary message reply handler", ex);
       } catch (Error err) {
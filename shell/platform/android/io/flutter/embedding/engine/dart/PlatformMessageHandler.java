@@ -6,11 +6,28 @@ package io.flutter.embedding.engine.dart;
 
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
+import java.nio.ByteBuffer;
 
 /** Handler that receives messages from Dart code. */
 public interface PlatformMessageHandler {
+  /**
+   * Handles a message from Dart.
+   *
+   * <p>The {@code message} is a direct buffer over native memory that is not copied into the Java
+   * heap. The handler must release it with {@link
+   * io.flutter.embedding.engine.FlutterJNI#cleanupMessageData(long)} once it no longer reads it.
+   */
   void handleMessageFromDart(
-      @NonNull final String channel, @Nullable byte[] message, final int replyId);
+      @NonNull final String channel,
+      @Nullable ByteBuffer message,
+      final int replyId,
+      long messageData);
 
-  void handlePlatformMessageResponse(int replyId, @Nullable byte[] reply);
+  /**
+   * Handles the reply of Dart to a message that was sent to it.
+   *
+   * <p>The {@code reply} is a direct buffer over native memory that is only valid until this method
+   * returns.
+   */
+  void handlePlatformMessageResponse(int replyId, @Nullable ByteBuffer reply);
 }
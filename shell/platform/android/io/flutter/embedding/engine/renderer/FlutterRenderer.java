@@ -7,11 +7,13 @@ package io.flutter.embedding.engine.renderer;
 import android.annotation.TargetApi;
 import android.graphics.Bitmap;
 import android.graphics.SurfaceTexture;
+import android.hardware.HardwareBuffer;
 import android.os.Build;
 import android.os.Handler;
 import android.view.Surface;
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
+import androidx.annotation.RequiresApi;
 import io.flutter.Log;
 import io.flutter.embedding.engine.FlutterJNI;
 import io.flutter.view.TextureRegistry;
@@ -169,6 +171,72 @@ public class FlutterRenderer implements TextureRegistry {
       released = true;
     }
   }
+
+  /**
+   * Creates and returns a new texture that shows the {@link HardwareBuffer}s that are pushed to
+   * it.
+   */
+  @Override
+  @RequiresApi(26)
+  @NonNull
+  public HardwareBufferTextureEntry createHardwareBufferTexture() {
+    Log.v(TAG, "Creating a HardwareBuffer texture.");
+    final HardwareBufferTextureRegistryEntry entry =
+        new HardwareBufferTextureRegistryEntry(nextTextureId.getAndIncrement());
+    if (!flutterJNI.registerHardwareBufferTexture(entry.id(), entry.textureWrapper())) {
+      throw new UnsupportedOperationException(
+          "The renderer cannot import HardwareBuffers into textures.");
+    }
+    Log.v(TAG, "New HardwareBuffer texture ID: " + entry.id());
+    return entry;
+  }
+
+  @RequiresApi(26)
+  final class HardwareBufferTextureRegistryEntry
+      implements TextureRegistry.HardwareBufferTextureEntry {
+    private final long id;
+    @NonNull private final HardwareBufferTextureWrapper textureWrapper;
+    private boolean released;
+
+    HardwareBufferTextureRegistryEntry(long id) {
+      this.id = id;
+      this.textureWrapper = new HardwareBufferTextureWrapper();
+    }
+
+    @NonNull
+    public HardwareBufferTextureWrapper textureWrapper() {
+      return textureWrapper;
+    }
+
+    @Override
+    public long id() {
+      return id;
+    }
+
+    @Override
+    public void pushHardwareBuffer(@NonNull HardwareBuffer buffer, @Nullable Runnable onReleased) {
+      final long token = textureWrapper.addPendingRelease(onReleased);
+      if (released
+          || !flutterJNI.isAttached()
+          || !flutterJNI.pushHardwareBuffer(id, buffer, token)) {
+        // The engine did not take the buffer, so the producer may reuse it right away.
+        final Runnable callback = textureWrapper.removePendingRelease(token);
+        if (callback != null) {
+          callback.run();
+        }
+      }
+    }
+
+    @Override
+    public void release() {
+      if (released) {
+        return;
+      }
+      Log.v(TAG, "Releasing a HardwareBuffer texture (" + id + ").");
+      unregisterTexture(id);
+      released = true;
+    }
+  }
   // ------ END TextureRegistry IMPLEMENTATION ----
 
   /**
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+package io.flutter.embedding.engine.renderer;
+
+import androidx.annotation.Keep;
+import androidx.annotation.NonNull;
+import androidx.annotation.Nullable;
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * Tracks the {@link android.hardware.HardwareBuffer}s that were pushed to a hardware buffer
+ * texture and are still read by the engine.
+ *
+ * <p>Each pushed buffer is identified by a token. The engine calls {@link #onBufferReleased(long)}
+ * on the platform thread once it no longer reads the buffer with that token, which runs the
+ * callback that the buffer was pushed with.
+ */
+@Keep
+public class HardwareBufferTextureWrapper {
+  @NonNull private final Map<Long, Runnable> pendingReleases = new HashMap<>();
+  private long nextToken = 1;
+
+  /**
+   * Returns the token of a buffer that is about to be pushed, and remembers to run {@code
+   * onReleased} once the engine releases it.
+   */
+  public long addPendingRelease(@Nullable Runnable onReleased) {
+    final long token = nextToken++;
+    if (onReleased != null) {
+      pendingReleases.put(token, onReleased);
+    }
+    return token;
+  }
+
+  /** Forgets the callback of a buffer with {@code token} that the engine did not take. */
+  @Nullable
+  public Runnable removePendingRelease(long token) {
+    return pendingReleases.remove(token);
+  }
+
+  // Called by native.
+  @SuppressWarnings("unused")
+  public void onBufferReleased(long token) {
+    final Runnable onReleased = pendingReleases.remove(token);
+    if (onReleased != null) {
+      onReleased.run();
+    }
+  }
+}
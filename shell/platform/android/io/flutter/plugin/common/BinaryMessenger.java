@@ -78,7 +78,9 @@ public interface BinaryMessenger {
      * <p>Any uncaught exception thrown by this method will be caught by the messenger
      * implementation and logged, and a null reply message will be sent back to Flutter.
      *
-     * @param message the message {@link ByteBuffer} payload, possibly null.
+     * @param message the message {@link ByteBuffer} payload, possibly null. This is a direct
+     *     buffer over memory that is owned by the engine, and is only valid until this method
+     *     returns. Handlers that read the message later must copy it first.
      * @param reply A {@link BinaryReply} used for submitting a reply back to Flutter.
      */
     @UiThread
@@ -95,7 +97,7 @@ public interface BinaryMessenger {
      *
      * @param reply the reply payload, a direct-allocated {@link ByteBuffer} or null. Senders of
      *     outgoing replies must place the reply bytes between position zero and current position.
-     *     Reply receivers can read from the buffer directly.
+     *     Reply receivers can read from the buffer directly, but only until this method returns.
      */
     @UiThread
     void reply(@Nullable ByteBuffer reply);
@@ -882,6 +882,13 @@ public class FlutterView extends SurfaceView
     return entry;
   }
 
+  @Override
+  @NonNull
+  public TextureRegistry.HardwareBufferTextureEntry createHardwareBufferTexture() {
+    throw new UnsupportedOperationException(
+        "Hardware buffer textures are only supported by FlutterRenderer.");
+  }
+
   final class SurfaceTextureRegistryEntry implements TextureRegistry.SurfaceTextureEntry {
     private final long id;
     private final SurfaceTextureWrapper textureWrapper;
@@ -5,6 +5,10 @@
 package io.flutter.view;
 
 import android.graphics.SurfaceTexture;
+import android.hardware.HardwareBuffer;
+import androidx.annotation.NonNull;
+import androidx.annotation.Nullable;
+import androidx.annotation.RequiresApi;
 
 // TODO(mattcarroll): re-evalute docs in this class and add nullability annotations.
 /**
@@ -20,6 +24,20 @@ public interface TextureRegistry {
    */
   SurfaceTextureEntry createSurfaceTexture();
 
+  /**
+   * Creates and registers a texture that shows the {@link HardwareBuffer}s that are pushed to it,
+   * such as the images of an {@code ImageReader}.
+   *
+   * <p>Unlike a {@link SurfaceTexture}, the buffers are imported by the engine without copies and
+   * without calling into Java on the raster thread.
+   *
+   * @return A HardwareBufferTextureEntry.
+   * @throws UnsupportedOperationException if the renderer cannot import hardware buffers.
+   */
+  @RequiresApi(26)
+  @NonNull
+  HardwareBufferTextureEntry createHardwareBufferTexture();
+
   /** A registry entry for a managed SurfaceTexture. */
   interface SurfaceTextureEntry {
     /** @return The managed SurfaceTexture. */
@@ -31,4 +49,23 @@ public interface TextureRegistry {
     /** Deregisters and releases this SurfaceTexture. */
     void release();
   }
+
+  /** A registry entry for a texture that shows pushed HardwareBuffers. */
+  @RequiresApi(26)
+  interface HardwareBufferTextureEntry {
+    /** @return The identity of this texture. */
+    long id();
+
+    /**
+     * Shows {@code buffer} from the next frame on, replacing the buffer that was pushed before.
+     *
+     * <p>The engine keeps a reference to the buffer until it runs {@code onReleased} on the main
+     * thread, after which the producer may write to the buffer again. Must be called on the main
+     * thread.
+     */
+    void pushHardwareBuffer(@NonNull HardwareBuffer buffer, @Nullable Runnable onReleased);
+
+    /** Deregisters this texture and releases the buffers it holds. */
+    void release();
+  }
 }
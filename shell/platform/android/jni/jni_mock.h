@@ -61,6 +61,11 @@ class JNIMock final : public PlatformViewAndroidJNI {
               (JavaWeakGlobalRef surface_texture),
               (override));
 
+  MOCK_METHOD(void,
+              HardwareBufferTextureOnBufferReleased,
+              (JavaWeakGlobalRef texture_wrapper, int64_t token),
+              (override));
+
   MOCK_METHOD(void,
               FlutterViewOnDisplayPlatformView,
               (int view_id,
@@ -110,6 +110,16 @@ class PlatformViewAndroidJNI {
   virtual void SurfaceTextureDetachFromGLContext(
       JavaWeakGlobalRef surface_texture) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the wrapper of a hardware buffer texture that the
+  ///             buffer that was pushed with `token` is no longer read.
+  ///
+  /// @note       Must be called from the platform thread.
+  ///
+  virtual void HardwareBufferTextureOnBufferReleased(
+      JavaWeakGlobalRef texture_wrapper,
+      int64_t token) = 0;
+
   //----------------------------------------------------------------------------
   /// @brief      Positions and sizes a platform view if using hybrid
   ///             composition.
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/android/platform_view_android.h"
 
+#include <dlfcn.h>
+
 #include <memory>
 #include <utility>
 
@@ -12,6 +14,7 @@
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 #include "flutter/shell/platform/android/android_context_gl.h"
 #include "flutter/shell/platform/android/android_external_texture_gl.h"
+#include "flutter/shell/platform/android/android_hardware_buffer_texture_gl.h"
 #include "flutter/shell/platform/android/android_surface_gl.h"
 #include "flutter/shell/platform/android/android_surface_software.h"
 #include "flutter/shell/platform/android/external_view_embedder/external_view_embedder.h"
@@ -28,6 +31,26 @@
 
 namespace flutter {
 
+namespace {
+
+// ANativeWindow_setFrameRate is only available in API 30 and above.
+using SetFrameRateProc = int32_t (*)(ANativeWindow* window,
+                                     float frame_rate,
+                                     int8_t compatibility);
+
+SetFrameRateProc GetSetFrameRateProc() {
+  static const SetFrameRateProc proc = []() -> SetFrameRateProc {
+    if (void* library = ::dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL)) {
+      return reinterpret_cast<SetFrameRateProc>(
+          ::dlsym(library, "ANativeWindow_setFrameRate"));
+    }
+    return nullptr;
+  }();
+  return proc;
+}
+
+}  // namespace
+
 AndroidSurfaceFactoryImpl::AndroidSurfaceFactoryImpl(
     const std::shared_ptr<AndroidContext>& context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade)
@@ -111,6 +134,9 @@ PlatformViewAndroid::~PlatformViewAndroid() = default;
 
 void PlatformViewAndroid::NotifyCreated(
     fml::RefPtr<AndroidNativeWindow> native_window) {
+  native_window_ = native_window;
+  ApplyFrameRateRange();
+
   if (android_surface_) {
     InstallFirstFrameCallback();
 
@@ -130,6 +156,9 @@ void PlatformViewAndroid::NotifyCreated(
 
 void PlatformViewAndroid::NotifySurfaceWindowChanged(
     fml::RefPtr<AndroidNativeWindow> native_window) {
+  native_window_ = native_window;
+  ApplyFrameRateRange();
+
   if (android_surface_) {
     fml::AutoResetWaitableEvent latch;
     fml::TaskRunner::RunNowOrPostTask(
@@ -146,6 +175,7 @@ void PlatformViewAndroid::NotifySurfaceWindowChanged(
 
 void PlatformViewAndroid::NotifyDestroyed() {
   PlatformView::NotifyDestroyed();
+  native_window_ = nullptr;
 
   if (android_surface_) {
     fml::AutoResetWaitableEvent latch;
@@ -180,8 +210,8 @@ void PlatformViewAndroid::DispatchPlatformMessage(JNIEnv* env,
                                                   jint response_id) {
   uint8_t* message_data =
       static_cast<uint8_t*>(env->GetDirectBufferAddress(java_message_data));
-  std::vector<uint8_t> message =
-      std::vector<uint8_t>(message_data, message_data + java_message_position);
+  fml::MallocMapping message =
+      fml::MallocMapping::Copy(message_data, java_message_position);
 
   fml::RefPtr<flutter::PlatformMessageResponse> response;
   if (response_id) {
@@ -287,6 +317,31 @@ void PlatformViewAndroid::UpdateSemantics(
   platform_view_android_delegate_.UpdateSemantics(update, actions);
 }
 
+// |PlatformView|
+void PlatformViewAndroid::SetFrameRateRange(const FrameRateRange& range) {
+  frame_rate_range_ = range;
+  ApplyFrameRateRange();
+}
+
+void PlatformViewAndroid::ApplyFrameRateRange() {
+  SetFrameRateProc set_frame_rate = GetSetFrameRateProc();
+  if (!set_frame_rate || !native_window_ || !native_window_->IsValid()) {
+    return;
+  }
+  // A frame rate of 0 lets the system pick the refresh rate again. The
+  // default compatibility asks for the display to run at a multiple of the
+  // frame rate, which suits frames that are paced by vsync.
+  float frame_rate = 0;
+  if (!frame_rate_range_.IsUnspecified()) {
+    frame_rate = frame_rate_range_.preferred > 0
+                     ? frame_rate_range_.preferred
+                     : frame_rate_range_.maximum;
+  }
+  constexpr int8_t kFrameRateCompatibilityDefault = 0;
+  set_frame_rate(native_window_->handle(), frame_rate,
+                 kFrameRateCompatibilityDefault);
+}
+
 void PlatformViewAndroid::RegisterExternalTexture(
     int64_t texture_id,
     const fml::jni::JavaObjectWeakGlobalRef& surface_texture) {
@@ -294,9 +349,55 @@ void PlatformViewAndroid::RegisterExternalTexture(
       texture_id, surface_texture, std::move(jni_facade_)));
 }
 
+bool PlatformViewAndroid::RegisterHardwareBufferTexture(
+    int64_t texture_id,
+    const fml::jni::JavaObjectWeakGlobalRef& texture_wrapper) {
+  if (android_context_->RenderingApi() != AndroidRenderingAPI::kOpenGLES ||
+      !AndroidHardwareBufferTextureGL::IsSupported()) {
+    return false;
+  }
+  auto release_callback = [jni_facade = jni_facade_, texture_wrapper,
+                           platform_task_runner =
+                               task_runners_.GetPlatformTaskRunner()](
+                              int64_t token) {
+    fml::TaskRunner::RunNowOrPostTask(
+        platform_task_runner, [jni_facade, texture_wrapper, token]() {
+          jni_facade->HardwareBufferTextureOnBufferReleased(texture_wrapper,
+                                                            token);
+        });
+  };
+  auto texture = std::make_shared<AndroidHardwareBufferTextureGL>(
+      texture_id, std::move(release_callback));
+  hardware_buffer_textures_[texture_id] = texture;
+  RegisterTexture(std::move(texture));
+  return true;
+}
+
+bool PlatformViewAndroid::PushHardwareBuffer(JNIEnv* env,
+                                             int64_t texture_id,
+                                             jobject hardware_buffer,
+                                             int64_t token) {
+  auto found = hardware_buffer_textures_.find(texture_id);
+  if (found == hardware_buffer_textures_.end()) {
+    return false;
+  }
+  std::shared_ptr<AndroidHardwareBufferTextureGL> texture =
+      found->second.lock();
+  if (!texture) {
+    hardware_buffer_textures_.erase(found);
+    return false;
+  }
+  if (!texture->PushBuffer(env, hardware_buffer, token)) {
+    return false;
+  }
+  MarkTextureFrameAvailable(texture_id);
+  return true;
+}
+
 // |PlatformView|
 std::unique_ptr<VsyncWaiter> PlatformViewAndroid::CreateVSyncWaiter() {
-  return std::make_unique<VsyncWaiterAndroid>(task_runners_);
+  return std::make_unique<VsyncWaiterAndroid>(task_runners_,
+                                              display_refresh_rate_callback_);
 }
 
 // |PlatformView|
@@ -312,7 +413,9 @@ std::unique_ptr<Surface> PlatformViewAndroid::CreateRenderingSurface() {
 std::shared_ptr<ExternalViewEmbedder>
 PlatformViewAndroid::CreateExternalViewEmbedder() {
   return std::make_shared<AndroidExternalViewEmbedder>(
-      *android_context_, jni_facade_, surface_factory_);
+      *android_context_, jni_facade_, surface_factory_,
+      uses_platform_view_transactions_ ? task_runners_.GetPlatformTaskRunner()
+                                       : nullptr);
 }
 
 // |PlatformView|
@@ -20,6 +20,7 @@
 #include "flutter/shell/platform/android/platform_view_android_delegate/platform_view_android_delegate.h"
 #include "flutter/shell/platform/android/surface/android_native_window.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
+#include "flutter/shell/platform/android/vsync_waiter_android.h"
 
 namespace flutter {
 
@@ -37,6 +38,8 @@ class AndroidSurfaceFactoryImpl : public AndroidSurfaceFactory {
   std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
 };
 
+class AndroidHardwareBufferTextureGL;
+
 class PlatformViewAndroid final : public PlatformView {
  public:
   static bool Register(JNIEnv* env);
@@ -98,6 +101,30 @@ class PlatformViewAndroid final : public PlatformView {
       int64_t texture_id,
       const fml::jni::JavaObjectWeakGlobalRef& surface_texture);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Registers a texture that shows the hardware buffers that are
+  ///             pushed to it with |PushHardwareBuffer|.
+  ///
+  /// @return     Whether such textures are supported, which requires API 26
+  ///             and OpenGL ES rendering.
+  ///
+  bool RegisterHardwareBufferTexture(
+      int64_t texture_id,
+      const fml::jni::JavaObjectWeakGlobalRef& texture_wrapper);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Shows `hardware_buffer` in the texture `texture_id` from the
+  ///             next frame on. Once the texture no longer reads it, the
+  ///             `onBufferReleased` method of the texture wrapper is called
+  ///             with `token` on the platform thread.
+  ///
+  /// @return     Whether the texture took the buffer.
+  ///
+  bool PushHardwareBuffer(JNIEnv* env,
+                          int64_t texture_id,
+                          jobject hardware_buffer,
+                          int64_t token);
+
   // |PlatformView|
   void LoadDartDeferredLibrary(
       intptr_t loading_unit_id,
@@ -117,6 +144,28 @@ class PlatformViewAndroid final : public PlatformView {
     return android_context_;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the callback that the vsync waiter reports the refresh
+  ///             rate of the display to when it changes. Must be set before
+  ///             the shell creates the vsync waiter.
+  ///
+  void SetDisplayRefreshRateCallback(
+      VsyncWaiterAndroid::RefreshRateCallback callback) {
+    display_refresh_rate_callback_ = std::move(callback);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets whether the external view embedder posts the platform
+  ///             view mutations of each frame to the platform thread instead
+  ///             of merging the raster and platform threads. Must be set
+  ///             before the shell creates the external view embedder.
+  ///
+  /// @see        Settings::enable_platform_view_transactions
+  ///
+  void SetUsesPlatformViewTransactions(bool uses_platform_view_transactions) {
+    uses_platform_view_transactions_ = uses_platform_view_transactions;
+  }
+
  private:
   const std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
   std::shared_ptr<AndroidContext> android_context_;
@@ -129,6 +178,16 @@ class PlatformViewAndroid final : public PlatformView {
   int next_response_id_ = 1;
   std::unordered_map<int, fml::RefPtr<flutter::PlatformMessageResponse>>
       pending_responses_;
+  VsyncWaiterAndroid::RefreshRateCallback display_refresh_rate_callback_;
+  bool uses_platform_view_transactions_ = false;
+  // The window of the surface, and the frame rate range last requested by the
+  // framework, which is applied to every new window of the surface.
+  fml::RefPtr<AndroidNativeWindow> native_window_;
+  FrameRateRange frame_rate_range_;
+  // The textures registered with |RegisterHardwareBufferTexture|, which are
+  // owned by the texture registry of the raster thread.
+  std::unordered_map<int64_t, std::weak_ptr<AndroidHardwareBufferTextureGL>>
+      hardware_buffer_textures_;
 
   // |PlatformView|
   void UpdateSemantics(
@@ -139,6 +198,9 @@ class PlatformViewAndroid final : public PlatformView {
   void HandlePlatformMessage(
       fml::RefPtr<flutter::PlatformMessage> message) override;
 
+  // |PlatformView|
+  void SetFrameRateRange(const FrameRateRange& range) override;
+
   // |PlatformView|
   void OnPreEngineRestart() const override;
 
@@ -157,6 +219,10 @@ class PlatformViewAndroid final : public PlatformView {
   // |PlatformView|
   void ReleaseResourceContext() const override;
 
+  // Asks the display to run at |frame_rate_range_| while the surface is
+  // shown, on Android R and above.
+  void ApplyFrameRateRange();
+
   // |PlatformView|
   std::unique_ptr<std::vector<std::string>> ComputePlatformResolvedLocales(
       const std::vector<std::string>& supported_locale_data) override;
@@ -24,6 +24,7 @@
 #include "flutter/fml/size.h"
 #include "flutter/lib/ui/plugins/callback_cache.h"
 #include "flutter/runtime/dart_service_isolate.h"
+#include "flutter/runtime/snapshot_container.h"
 #include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/platform/android/android_external_texture_gl.h"
 #include "flutter/shell/platform/android/android_shell_holder.h"
@@ -60,6 +61,9 @@ static fml::jni::ScopedJavaGlobalRef<jclass>* g_flutter_jni_class = nullptr;
 
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_texture_wrapper_class = nullptr;
 
+static fml::jni::ScopedJavaGlobalRef<jclass>*
+    g_hardware_buffer_texture_wrapper_class = nullptr;
+
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_java_long_class = nullptr;
 
 // Called By Native
@@ -111,6 +115,8 @@ static jmethodID g_get_transform_matrix_method = nullptr;
 
 static jmethodID g_detach_from_gl_context_method = nullptr;
 
+static jmethodID g_on_buffer_released_method = nullptr;
+
 static jmethodID g_compute_platform_resolved_locale_method = nullptr;
 
 static jmethodID g_request_dart_deferred_library_method = nullptr;
@@ -403,6 +409,14 @@ static void DispatchPlatformMessage(JNIEnv* env,
   );
 }
 
+static void CleanupMessageData(JNIEnv* env,
+                               jobject jcaller,
+                               jlong message_data) {
+  // Called by the Java side once it handled a message for which
+  // |FlutterViewHandlePlatformMessage| released the data.
+  free(reinterpret_cast<void*>(message_data));
+}
+
 static void DispatchEmptyPlatformMessage(JNIEnv* env,
                                          jobject jcaller,
                                          jlong shell_holder,
@@ -471,6 +485,28 @@ static void RegisterTexture(JNIEnv* env,
   );
 }
 
+static jboolean RegisterHardwareBufferTexture(JNIEnv* env,
+                                              jobject jcaller,
+                                              jlong shell_holder,
+                                              jlong texture_id,
+                                              jobject texture_wrapper) {
+  return ANDROID_SHELL_HOLDER->GetPlatformView()->RegisterHardwareBufferTexture(
+      static_cast<int64_t>(texture_id),                        //
+      fml::jni::JavaObjectWeakGlobalRef(env, texture_wrapper)  //
+  );
+}
+
+static jboolean PushHardwareBuffer(JNIEnv* env,
+                                   jobject jcaller,
+                                   jlong shell_holder,
+                                   jlong texture_id,
+                                   jobject hardware_buffer,
+                                   jlong token) {
+  return ANDROID_SHELL_HOLDER->GetPlatformView()->PushHardwareBuffer(
+      env, static_cast<int64_t>(texture_id), hardware_buffer,
+      static_cast<int64_t>(token));
+}
+
 static void MarkTextureFrameAvailable(JNIEnv* env,
                                       jobject jcaller,
                                       jlong shell_holder,
@@ -517,6 +553,23 @@ static void NotifyLowMemoryWarning(JNIEnv* env,
   ANDROID_SHELL_HOLDER->NotifyLowMemoryWarning();
 }
 
+static void NotifyMemoryPressure(JNIEnv* env,
+                                 jobject obj,
+                                 jlong shell_holder,
+                                 jint level) {
+  switch (level) {
+    case static_cast<jint>(MemoryPressureLevel::kModerate):
+    case static_cast<jint>(MemoryPressureLevel::kCritical):
+    case static_cast<jint>(MemoryPressureLevel::kBackground):
+      ANDROID_SHELL_HOLDER->NotifyMemoryPressure(
+          static_cast<MemoryPressureLevel>(level));
+      break;
+    default:
+      FML_LOG(ERROR) << "Unknown memory pressure level: " << level;
+      break;
+  }
+}
+
 static jboolean FlutterTextUtilsIsEmoji(JNIEnv* env,
                                         jobject obj,
                                         jint codePoint) {
@@ -573,6 +626,19 @@ static void LoadDartDeferredLibrary(JNIEnv* env,
   std::vector<std::string> search_paths =
       fml::jni::StringArrayToVector(env, jSearchPaths);
 
+  // Loading units may also be shipped as snapshot containers, which are
+  // decoded by the isolate instead of being loaded by the dynamic linker.
+  for (auto path = search_paths.rbegin(); path != search_paths.rend();
+       ++path) {
+    std::unique_ptr<fml::FileMapping> mapping =
+        fml::FileMapping::CreateReadOnly(*path);
+    if (mapping && SnapshotContainer::IsContainer(*mapping)) {
+      ANDROID_SHELL_HOLDER->GetPlatformView()->LoadDartDeferredLibrary(
+          loading_unit_id, std::move(mapping), nullptr);
+      return;
+    }
+  }
+
   // Use dlopen here to directly check if handle is nullptr before creating a
   // NativeLibrary.
   void* handle = nullptr;
@@ -647,6 +713,11 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(JLjava/lang/String;I)V",
           .fnPtr = reinterpret_cast<void*>(&DispatchEmptyPlatformMessage),
       },
+      {
+          .name = "nativeCleanupMessageData",
+          .signature = "(J)V",
+          .fnPtr = reinterpret_cast<void*>(&CleanupMessageData),
+      },
       {
           .name = "nativeDispatchPlatformMessage",
           .signature = "(JLjava/lang/String;Ljava/nio/ByteBuffer;II)V",
@@ -669,6 +740,11 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(J)V",
           .fnPtr = reinterpret_cast<void*>(&NotifyLowMemoryWarning),
       },
+      {
+          .name = "nativeNotifyMemoryPressure",
+          .signature = "(JI)V",
+          .fnPtr = reinterpret_cast<void*>(&NotifyMemoryPressure),
+      },
 
       // Start of methods from FlutterView
       {
@@ -732,6 +808,17 @@ bool RegisterApi(JNIEnv* env) {
                        "SurfaceTextureWrapper;)V",
           .fnPtr = reinterpret_cast<void*>(&RegisterTexture),
       },
+      {
+          .name = "nativeRegisterHardwareBufferTexture",
+          .signature = "(JJLio/flutter/embedding/engine/renderer/"
+                       "HardwareBufferTextureWrapper;)Z",
+          .fnPtr = reinterpret_cast<void*>(&RegisterHardwareBufferTexture),
+      },
+      {
+          .name = "nativePushHardwareBuffer",
+          .signature = "(JJLandroid/hardware/HardwareBuffer;J)Z",
+          .fnPtr = reinterpret_cast<void*>(&PushHardwareBuffer),
+      },
       {
           .name = "nativeMarkTextureFrameAvailable",
           .signature = "(JJ)V",
@@ -828,7 +915,7 @@ bool RegisterApi(JNIEnv* env) {
 
   g_handle_platform_message_method =
       env->GetMethodID(g_flutter_jni_class->obj(), "handlePlatformMessage",
-                       "(Ljava/lang/String;[BI)V");
+                       "(Ljava/lang/String;Ljava/nio/ByteBuffer;IJ)V");
 
   if (g_handle_platform_message_method == nullptr) {
     FML_LOG(ERROR) << "Could not locate handlePlatformMessage method";
@@ -836,7 +923,8 @@ bool RegisterApi(JNIEnv* env) {
   }
 
   g_handle_platform_message_response_method = env->GetMethodID(
-      g_flutter_jni_class->obj(), "handlePlatformMessageResponse", "(I[B)V");
+      g_flutter_jni_class->obj(), "handlePlatformMessageResponse",
+      "(ILjava/nio/ByteBuffer;)V");
 
   if (g_handle_platform_message_response_method == nullptr) {
     FML_LOG(ERROR) << "Could not locate handlePlatformMessageResponse method";
@@ -1060,6 +1148,24 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
     return false;
   }
 
+  g_hardware_buffer_texture_wrapper_class =
+      new fml::jni::ScopedJavaGlobalRef<jclass>(
+          env, env->FindClass("io/flutter/embedding/engine/renderer/"
+                              "HardwareBufferTextureWrapper"));
+  if (g_hardware_buffer_texture_wrapper_class->is_null()) {
+    FML_LOG(ERROR) << "Could not locate HardwareBufferTextureWrapper class";
+    return false;
+  }
+
+  g_on_buffer_released_method =
+      env->GetMethodID(g_hardware_buffer_texture_wrapper_class->obj(),
+                       "onBufferReleased", "(J)V");
+
+  if (g_on_buffer_released_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate onBufferReleased method";
+    return false;
+  }
+
   g_compute_platform_resolved_locale_method = env->GetMethodID(
       g_flutter_jni_class->obj(), "computePlatformResolvedLocale",
       "([Ljava/lang/String;)[Ljava/lang/String;");
@@ -1107,16 +1213,20 @@ void PlatformViewAndroidJNIImpl::FlutterViewHandlePlatformMessage(
       fml::jni::StringToJavaString(env, message->channel());
 
   if (message->hasData()) {
-    fml::jni::ScopedJavaLocalRef<jbyteArray> message_array(
-        env, env->NewByteArray(message->data().size()));
-    env->SetByteArrayRegion(
-        message_array.obj(), 0, message->data().size(),
-        reinterpret_cast<const jbyte*>(message->data().data()));
+    // The Java side reads the message data in place, and releases it with
+    // |CleanupMessageData| once it handled the message.
+    fml::MallocMapping mapping = message->releaseData();
+    size_t size = mapping.GetSize();
+    uint8_t* data = mapping.Release();
+    fml::jni::ScopedJavaLocalRef<jobject> message_buffer(
+        env, env->NewDirectByteBuffer(data, size));
     env->CallVoidMethod(java_object.obj(), g_handle_platform_message_method,
-                        java_channel.obj(), message_array.obj(), responseId);
+                        java_channel.obj(), message_buffer.obj(), responseId,
+                        reinterpret_cast<jlong>(data));
   } else {
     env->CallVoidMethod(java_object.obj(), g_handle_platform_message_method,
-                        java_channel.obj(), nullptr, responseId);
+                        java_channel.obj(), nullptr, responseId,
+                        static_cast<jlong>(0));
   }
 
   FML_CHECK(CheckException(env));
@@ -1140,15 +1250,15 @@ void PlatformViewAndroidJNIImpl::FlutterViewHandlePlatformMessageResponse(
                         g_handle_platform_message_response_method, responseId,
                         nullptr);
   } else {
-    // Convert the vector to a Java byte array.
-    fml::jni::ScopedJavaLocalRef<jbyteArray> data_array(
-        env, env->NewByteArray(data->GetSize()));
-    env->SetByteArrayRegion(data_array.obj(), 0, data->GetSize(),
-                            reinterpret_cast<const jbyte*>(data->GetMapping()));
+    // The response is read in place by the Java side, which must not keep
+    // the buffer after the call returns.
+    fml::jni::ScopedJavaLocalRef<jobject> data_buffer(
+        env, env->NewDirectByteBuffer(const_cast<uint8_t*>(data->GetMapping()),
+                                      data->GetSize()));
 
     env->CallVoidMethod(java_object.obj(),
                         g_handle_platform_message_response_method, responseId,
-                        data_array.obj());
+                        data_buffer.obj());
   }
 
   FML_CHECK(CheckException(env));
@@ -1316,6 +1426,23 @@ void PlatformViewAndroidJNIImpl::SurfaceTextureDetachFromGLContext(
   FML_CHECK(CheckException(env));
 }
 
+void PlatformViewAndroidJNIImpl::HardwareBufferTextureOnBufferReleased(
+    JavaWeakGlobalRef texture_wrapper,
+    int64_t token) {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  fml::jni::ScopedJavaLocalRef<jobject> texture_wrapper_local_ref =
+      texture_wrapper.get(env);
+  if (texture_wrapper_local_ref.is_null()) {
+    return;
+  }
+
+  env->CallVoidMethod(texture_wrapper_local_ref.obj(),
+                      g_on_buffer_released_method, static_cast<jlong>(token));
+
+  FML_CHECK(CheckException(env));
+}
+
 void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
     int view_id,
     int x,
@@ -1334,12 +1461,11 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
   jobject mutatorsStack = env->NewObject(g_mutators_stack_class->obj(),
                                          g_mutators_stack_init_method);
 
-  std::vector<std::shared_ptr<Mutator>>::const_iterator iter =
-      mutators_stack.Begin();
+  MutatorsStack::const_iterator iter = mutators_stack.Begin();
   while (iter != mutators_stack.End()) {
-    switch ((*iter)->GetType()) {
+    switch (iter->GetType()) {
       case transform: {
-        const SkMatrix& matrix = (*iter)->GetMatrix();
+        const SkMatrix& matrix = iter->GetMatrix();
         SkScalar matrix_array[9];
         matrix.get9(matrix_array);
         fml::jni::ScopedJavaLocalRef<jfloatArray> transformMatrix(
@@ -1352,7 +1478,7 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
         break;
       }
       case clip_rect: {
-        const SkRect& rect = (*iter)->GetRect();
+        const SkRect& rect = iter->GetRect();
         env->CallVoidMethod(
             mutatorsStack, g_mutators_stack_push_cliprect_method,
             static_cast<int>(rect.left()), static_cast<int>(rect.top()),
@@ -1360,7 +1486,7 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
         break;
       }
       case clip_rrect: {
-        const SkRRect& rrect = (*iter)->GetRRect();
+        const SkRRect& rrect = iter->GetRRect();
         const SkRect& rect = rrect.rect();
         const SkVector& upper_left = rrect.radii(SkRRect::kUpperLeft_Corner);
         const SkVector& upper_right = rrect.radii(SkRRect::kUpperRight_Corner);
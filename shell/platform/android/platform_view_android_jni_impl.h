@@ -50,6 +50,9 @@ class PlatformViewAndroidJNIImpl final : public PlatformViewAndroidJNI {
   void SurfaceTextureDetachFromGLContext(
       JavaWeakGlobalRef surface_texture) override;
 
+  void HardwareBufferTextureOnBufferReleased(JavaWeakGlobalRef texture_wrapper,
+                                             int64_t token) override;
+
   void FlutterViewOnDisplayPlatformView(int view_id,
                                         int x,
                                         int y,
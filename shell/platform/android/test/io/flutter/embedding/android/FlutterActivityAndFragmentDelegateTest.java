@@ -22,6 +22,7 @@ import io.flutter.FlutterInjector;
 import io.flutter.embedding.android.FlutterActivityAndFragmentDelegate.Host;
 import io.flutter.embedding.engine.FlutterEngine;
 import io.flutter.embedding.engine.FlutterEngineCache;
+import io.flutter.embedding.engine.FlutterJNI;
 import io.flutter.embedding.engine.FlutterShellArgs;
 import io.flutter.embedding.engine.dart.DartExecutor;
 import io.flutter.embedding.engine.loader.FlutterLoader;
@@ -613,8 +614,14 @@ public class FlutterActivityAndFragmentDelegateTest {
     delegate.onTrimMemory(TRIM_MEMORY_MODERATE);
     delegate.onTrimMemory(TRIM_MEMORY_UI_HIDDEN);
 
-    // Verify that the call was forwarded to the engine.
-    verify(mockFlutterEngine.getDartExecutor(), times(7)).notifyLowMemoryWarning();
+    // Verify that the call was forwarded to the engine with the matching memory pressure level.
+    verify(mockFlutterEngine.getDartExecutor(), times(2))
+        .notifyMemoryPressure(FlutterJNI.MEMORY_PRESSURE_LEVEL_MODERATE);
+    verify(mockFlutterEngine.getDartExecutor(), times(2))
+        .notifyMemoryPressure(FlutterJNI.MEMORY_PRESSURE_LEVEL_CRITICAL);
+    verify(mockFlutterEngine.getDartExecutor(), times(3))
+        .notifyMemoryPressure(FlutterJNI.MEMORY_PRESSURE_LEVEL_BACKGROUND);
+    verify(mockFlutterEngine.getDartExecutor(), never()).notifyLowMemoryWarning();
     verify(mockFlutterEngine.getSystemChannel(), times(1)).sendMemoryPressureWarning();
   }
 
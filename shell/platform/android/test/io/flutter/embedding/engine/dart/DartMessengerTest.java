@@ -3,13 +3,17 @@ package io.flutter.embedding.engine.dart;
 import static junit.framework.TestCase.assertNotNull;
 import static junit.framework.TestCase.assertTrue;
 import static org.mockito.Matchers.any;
+import static org.mockito.Mockito.inOrder;
 import static org.mockito.Mockito.mock;
+import static org.mockito.Mockito.times;
+import static org.mockito.Mockito.verify;
 
 import io.flutter.embedding.engine.FlutterJNI;
 import io.flutter.plugin.common.BinaryMessenger.BinaryMessageHandler;
 import java.nio.ByteBuffer;
 import org.junit.Test;
 import org.junit.runner.RunWith;
+import org.mockito.InOrder;
 import org.mockito.Mockito;
 import org.robolectric.RobolectricTestRunner;
 import org.robolectric.annotation.Config;
@@ -46,9 +50,27 @@ public class DartMessengerTest {
         .onMessage(any(ByteBuffer.class), any(DartMessenger.Reply.class));
 
     messenger.setMessageHandler("test", throwingHandler);
-    messenger.handleMessageFromDart("test", new byte[] {}, 0);
+    messenger.handleMessageFromDart("test", ByteBuffer.allocateDirect(0), 0, 0);
     assertNotNull(reportingHandler.latestException);
     assertTrue(reportingHandler.latestException instanceof AssertionError);
     currentThread.setUncaughtExceptionHandler(savedHandler);
   }
+
+  @Test
+  public void cleansUpMessageDataAfterTheHandlerRan() {
+    final FlutterJNI fakeFlutterJni = mock(FlutterJNI.class);
+    final DartMessenger messenger = new DartMessenger(fakeFlutterJni);
+    final BinaryMessageHandler handler = mock(BinaryMessageHandler.class);
+    messenger.setMessageHandler("test", handler);
+
+    final ByteBuffer message = ByteBuffer.allocateDirect(4);
+    messenger.handleMessageFromDart("test", message, 1, 42);
+    final InOrder order = inOrder(handler, fakeFlutterJni);
+    order.verify(handler).onMessage(Mockito.eq(message), any(DartMessenger.Reply.class));
+    order.verify(fakeFlutterJni).cleanupMessageData(42);
+
+    // Messages without a handler are released as well.
+    messenger.handleMessageFromDart("unhandled", message, 2, 43);
+    verify(fakeFlutterJni, times(1)).cleanupMessageData(43);
+  }
 }
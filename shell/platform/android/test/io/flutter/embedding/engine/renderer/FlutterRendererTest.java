@@ -1,10 +1,15 @@
 package io.flutter.embedding.engine.renderer;
 
+import static junit.framework.TestCase.assertEquals;
+import static org.mockito.Matchers.any;
+import static org.mockito.Matchers.anyLong;
 import static org.mockito.Matchers.eq;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.times;
 import static org.mockito.Mockito.verify;
+import static org.mockito.Mockito.when;
 
+import android.hardware.HardwareBuffer;
 import android.view.Surface;
 import io.flutter.embedding.engine.FlutterJNI;
 import org.junit.Before;
@@ -12,6 +17,7 @@ import org.junit.Test;
 import org.junit.runner.RunWith;
 import org.robolectric.RobolectricTestRunner;
 import org.robolectric.annotation.Config;
+import java.util.concurrent.atomic.AtomicInteger;
 
 @Config(manifest = Config.NONE)
 @RunWith(RobolectricTestRunner.class)
@@ -116,4 +122,36 @@ public class FlutterRendererTest {
     // Verify behavior under test.
     verify(fakeFlutterJNI, times(0)).markTextureFrameAvailable(eq(entry.id()));
   }
+
+  @Test
+  @Config(sdk = 26)
+  public void itReleasesHardwareBuffersThatAreNotTaken() {
+    // Setup the test.
+    when(fakeFlutterJNI.isAttached()).thenReturn(true);
+    when(fakeFlutterJNI.registerHardwareBufferTexture(
+            anyLong(), any(HardwareBufferTextureWrapper.class)))
+        .thenReturn(true);
+    FlutterRenderer flutterRenderer = new FlutterRenderer(fakeFlutterJNI);
+    FlutterRenderer.HardwareBufferTextureRegistryEntry entry =
+        (FlutterRenderer.HardwareBufferTextureRegistryEntry)
+            flutterRenderer.createHardwareBufferTexture();
+    HardwareBuffer buffer = mock(HardwareBuffer.class);
+    AtomicInteger releases = new AtomicInteger(0);
+
+    // Execute the behavior under test.
+    when(fakeFlutterJNI.pushHardwareBuffer(eq(entry.id()), eq(buffer), anyLong()))
+        .thenReturn(false);
+    entry.pushHardwareBuffer(buffer, releases::incrementAndGet);
+
+    // Verify the behavior under test.
+    assertEquals(1, releases.get());
+
+    // Buffers that are taken are released once the engine reports it.
+    when(fakeFlutterJNI.pushHardwareBuffer(eq(entry.id()), eq(buffer), anyLong()))
+        .thenReturn(true);
+    entry.pushHardwareBuffer(buffer, releases::incrementAndGet);
+    assertEquals(1, releases.get());
+    entry.textureWrapper().onBufferReleased(2);
+    assertEquals(2, releases.get());
+  }
 }
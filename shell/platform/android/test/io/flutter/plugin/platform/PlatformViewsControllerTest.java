@@ -630,12 +630,10 @@ public class PlatformViewsControllerTest {
     assertFalse(shouldProxying);
   }
 
-  private static byte[] encodeMethodCall(MethodCall call) {
+  private static ByteBuffer encodeMethodCall(MethodCall call) {
     final ByteBuffer buffer = StandardMethodCodec.INSTANCE.encodeMethodCall(call);
     buffer.rewind();
-    final byte[] dest = new byte[buffer.remaining()];
-    buffer.get(dest);
-    return dest;
+    return buffer;
   }
 
   private static void createPlatformView(
@@ -652,7 +650,10 @@ public class PlatformViewsControllerTest {
         new MethodCall("create", platformViewCreateArguments);
 
     jni.handlePlatformMessage(
-        "flutter/platform_views", encodeMethodCall(platformCreateMethodCall), /*replyId=*/ 0);
+        "flutter/platform_views",
+        encodeMethodCall(platformCreateMethodCall),
+        /*replyId=*/ 0,
+        /*messageData=*/ 0);
   }
 
   private static void disposePlatformView(
@@ -666,7 +667,10 @@ public class PlatformViewsControllerTest {
         new MethodCall("dispose", platformViewDisposeArguments);
 
     jni.handlePlatformMessage(
-        "flutter/platform_views", encodeMethodCall(platformDisposeMethodCall), /*replyId=*/ 0);
+        "flutter/platform_views",
+        encodeMethodCall(platformDisposeMethodCall),
+        /*replyId=*/ 0,
+        /*messageData=*/ 0);
   }
 
   private static FlutterView attach(
@@ -724,6 +728,9 @@ public class PlatformViewsControllerTest {
     public void dispatchPlatformMessage(
         String channel, ByteBuffer message, int position, int responseId) {}
 
+    @Implementation
+    public void cleanupMessageData(long messageData) {}
+
     @Implementation
     public void onSurfaceCreated(Surface surface) {}
 
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/android/vsync_waiter_android.h"
 
+#include <dlfcn.h>
+
 #include <cmath>
 #include <utility>
 
@@ -19,16 +21,161 @@ namespace flutter {
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_vsync_waiter_class = nullptr;
 static jmethodID g_async_wait_for_vsync_method_ = nullptr;
 
-VsyncWaiterAndroid::VsyncWaiterAndroid(flutter::TaskRunners task_runners)
-    : VsyncWaiter(std::move(task_runners)) {}
+namespace {
+
+// The NDK choreographer types, which are declared here as the headers of the
+// NDK the engine is built with do not declare all of them.
+struct AChoreographer;
+struct AChoreographerFrameCallbackData;
+
+using FrameCallback64 = void (*)(int64_t frame_time_nanos, void* data);
+using VsyncCallback = void (*)(const AChoreographerFrameCallbackData* data,
+                               void* user_data);
+using RefreshRateCallback = void (*)(int64_t vsync_period_nanos, void* data);
+
+struct ChoreographerProcs {
+  // From API 29 and 30 on.
+  AChoreographer* (*get_instance)() = nullptr;
+  void (*post_frame_callback_64)(AChoreographer*,
+                                 FrameCallback64,
+                                 void*) = nullptr;
+  void (*register_refresh_rate_callback)(AChoreographer*,
+                                         RefreshRateCallback,
+                                         void*) = nullptr;
+
+  // From API 33 on.
+  int (*post_vsync_callback)(AChoreographer*, VsyncCallback, void*) = nullptr;
+  int64_t (*get_frame_time_nanos)(const AChoreographerFrameCallbackData*) =
+      nullptr;
+  size_t (*get_preferred_frame_timeline_index)(
+      const AChoreographerFrameCallbackData*) = nullptr;
+  int64_t (*get_frame_timeline_deadline_nanos)(
+      const AChoreographerFrameCallbackData*,
+      size_t) = nullptr;
+
+  bool IsValid() const {
+    return get_instance && post_frame_callback_64 &&
+           register_refresh_rate_callback;
+  }
+
+  bool HasFrameTimelines() const {
+    return post_vsync_callback && get_frame_time_nanos &&
+           get_preferred_frame_timeline_index &&
+           get_frame_timeline_deadline_nanos;
+  }
+};
+
+template <typename T>
+void LookUp(void* library, const char* name, T& proc) {
+  proc = reinterpret_cast<T>(::dlsym(library, name));
+}
+
+const ChoreographerProcs& GetProcs() {
+  static const ChoreographerProcs procs = [] {
+    ChoreographerProcs procs;
+    if (void* library = ::dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL)) {
+      LookUp(library, "AChoreographer_getInstance", procs.get_instance);
+      LookUp(library, "AChoreographer_postFrameCallback64",
+             procs.post_frame_callback_64);
+      LookUp(library, "AChoreographer_registerRefreshRateCallback",
+             procs.register_refresh_rate_callback);
+      LookUp(library, "AChoreographer_postVsyncCallback",
+             procs.post_vsync_callback);
+      LookUp(library, "AChoreographerFrameCallbackData_getFrameTimeNanos",
+             procs.get_frame_time_nanos);
+      LookUp(library,
+             "AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex",
+             procs.get_preferred_frame_timeline_index);
+      LookUp(library,
+             "AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos",
+             procs.get_frame_timeline_deadline_nanos);
+    }
+    return procs;
+  }();
+  return procs;
+}
+
+// The choreographer of the current thread, which is created for the looper of
+// the thread the first time it is asked for, along with the refresh rate
+// callback that tracks its vsync period. The callback is also invoked once
+// after it is registered, with the current period.
+struct ThreadChoreographer {
+  AChoreographer* choreographer = nullptr;
+  int64_t vsync_period_nanos = 1000000000 / 60;
+};
+
+void OnRefreshRateChanged(int64_t vsync_period_nanos, void* data) {
+  static_cast<ThreadChoreographer*>(data)->vsync_period_nanos =
+      vsync_period_nanos;
+}
+
+ThreadChoreographer* GetThreadChoreographer() {
+  // Leaked, as the refresh rate callback refers to it for as long as the
+  // looper of the thread lives.
+  thread_local ThreadChoreographer* thread_choreographer = [] {
+    const ChoreographerProcs& procs = GetProcs();
+    AChoreographer* choreographer = procs.get_instance();
+    if (!choreographer) {
+      // The thread does not have a looper.
+      return static_cast<ThreadChoreographer*>(nullptr);
+    }
+    auto* result = new ThreadChoreographer{.choreographer = choreographer};
+    procs.register_refresh_rate_callback(choreographer, &OnRefreshRateChanged,
+                                         result);
+    return result;
+  }();
+  return thread_choreographer;
+}
+
+}  // namespace
+
+VsyncWaiterAndroid::VsyncWaiterAndroid(
+    flutter::TaskRunners task_runners,
+    RefreshRateCallback on_refresh_rate_changed)
+    : VsyncWaiter(std::move(task_runners)),
+      on_refresh_rate_changed_(std::move(on_refresh_rate_changed)) {}
 
 VsyncWaiterAndroid::~VsyncWaiterAndroid() = default;
 
+// static
+bool VsyncWaiterAndroid::UsesNativeChoreographer() {
+  return GetProcs().IsValid();
+}
+
+namespace {
+
+void OnFrameCallback64(int64_t frame_time_nanos, void* data) {
+  VsyncWaiterAndroid::OnNativeChoreographerFrame(frame_time_nanos, data);
+}
+
+void OnVsyncCallbackData(const AChoreographerFrameCallbackData* callback_data,
+                         void* data) {
+  VsyncWaiterAndroid::OnNativeChoreographerVsync(callback_data, data);
+}
+
+}  // namespace
+
 // |VsyncWaiter|
 void VsyncWaiterAndroid::AwaitVSync() {
   auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
   jlong java_baton = reinterpret_cast<jlong>(weak_this);
 
+  if (UsesNativeChoreographer()) {
+    // |AwaitVSync| is called on the UI thread, whose looper the choreographer
+    // calls back on.
+    if (ThreadChoreographer* thread_choreographer = GetThreadChoreographer()) {
+      const ChoreographerProcs& procs = GetProcs();
+      if (procs.HasFrameTimelines() &&
+          procs.post_vsync_callback(thread_choreographer->choreographer,
+                                    &OnVsyncCallbackData, weak_this) == 0) {
+        return;
+      }
+      procs.post_frame_callback_64(thread_choreographer->choreographer,
+                                   &OnFrameCallback64, weak_this);
+      return;
+    }
+  }
+
   task_runners_.GetPlatformTaskRunner()->PostTask([java_baton]() {
     JNIEnv* env = fml::jni::AttachCurrentThread();
     env->CallStaticVoidMethod(g_vsync_waiter_class->obj(),     //
@@ -51,23 +198,81 @@ void VsyncWaiterAndroid::OnNativeVsync(JNIEnv* env,
   auto target_time = fml::TimePoint::FromEpochDelta(
       fml::TimeDelta::FromNanoseconds(frameTargetTimeNanos));
 
-  ConsumePendingCallback(java_baton, frame_time, target_time);
+  // The Java choreographer targets one refresh period after the vsync, with
+  // the current refresh rate of the display.
+  ConsumePendingCallback(java_baton, frame_time, target_time,
+                         frameTargetTimeNanos - frameTimeNanos);
+}
+
+// static
+void VsyncWaiterAndroid::OnNativeChoreographerFrame(int64_t frame_time_nanos,
+                                                    void* data) {
+  TRACE_EVENT0("flutter", "VSYNC");
+
+  ThreadChoreographer* thread_choreographer = GetThreadChoreographer();
+  FML_DCHECK(thread_choreographer);
+  auto frame_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(frame_time_nanos));
+  auto target_time =
+      frame_time + fml::TimeDelta::FromNanoseconds(
+                       thread_choreographer->vsync_period_nanos);
+
+  ConsumePendingCallback(reinterpret_cast<jlong>(data), frame_time,
+                         target_time, thread_choreographer->vsync_period_nanos);
+}
+
+// static
+void VsyncWaiterAndroid::OnNativeChoreographerVsync(const void* callback_data,
+                                                    void* data) {
+  TRACE_EVENT0("flutter", "VSYNC");
+
+  const ChoreographerProcs& procs = GetProcs();
+  auto* frame_callback_data =
+      static_cast<const AChoreographerFrameCallbackData*>(callback_data);
+  const size_t timeline =
+      procs.get_preferred_frame_timeline_index(frame_callback_data);
+  auto frame_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(
+          procs.get_frame_time_nanos(frame_callback_data)));
+  // The deadline is the latest time that the frame can be handed to the
+  // compositor to be presented with the preferred timeline.
+  auto target_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(procs.get_frame_timeline_deadline_nanos(
+          frame_callback_data, timeline)));
+
+  ThreadChoreographer* thread_choreographer = GetThreadChoreographer();
+  FML_DCHECK(thread_choreographer);
+  ConsumePendingCallback(reinterpret_cast<jlong>(data), frame_time,
+                         target_time, thread_choreographer->vsync_period_nanos);
 }
 
 // static
 void VsyncWaiterAndroid::ConsumePendingCallback(
     jlong java_baton,
     fml::TimePoint frame_start_time,
-    fml::TimePoint frame_target_time) {
+    fml::TimePoint frame_target_time,
+    int64_t vsync_period_nanos) {
   auto* weak_this = reinterpret_cast<std::weak_ptr<VsyncWaiter>*>(java_baton);
   auto shared_this = weak_this->lock();
   delete weak_this;
 
   if (shared_this) {
+    // The batons are only created by |VsyncWaiterAndroid::AwaitVSync|.
+    static_cast<VsyncWaiterAndroid*>(shared_this.get())
+        ->UpdateVsyncPeriod(vsync_period_nanos);
     shared_this->FireCallback(frame_start_time, frame_target_time);
   }
 }
 
+void VsyncWaiterAndroid::UpdateVsyncPeriod(int64_t vsync_period_nanos) {
+  if (!on_refresh_rate_changed_ || vsync_period_nanos <= 0 ||
+      vsync_period_nanos_.exchange(vsync_period_nanos) == vsync_period_nanos) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "VsyncWaiterAndroid::UpdateVsyncPeriod");
+  on_refresh_rate_changed_(1e9 / vsync_period_nanos);
+}
+
 // static
 bool VsyncWaiterAndroid::Register(JNIEnv* env) {
   static const JNINativeMethod methods[] = {{
@@ -7,6 +7,8 @@
 
 #include <jni.h>
 
+#include <atomic>
+#include <functional>
 #include <memory>
 
 #include "flutter/fml/macros.h"
@@ -14,15 +16,46 @@
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      Waits for vsync with the `AChoreographer` of the UI thread where
+///             the NDK provides it, from API 30 on, and with the Java
+///             `Choreographer` of the platform thread otherwise.
+///
+///             The native choreographer calls back on the UI thread without
+///             going through JNI. From API 33 on, the target time of a frame
+///             is the deadline of the frame timeline that the platform
+///             prefers, rather than a refresh period after the vsync.
+///
+///             The waiter reports the refresh rate of the display whenever
+///             the vsync period changes, so that frame budgets track the
+///             refresh rate switches of the display from the next frame on.
+///
 class VsyncWaiterAndroid final : public VsyncWaiter {
  public:
+  //----------------------------------------------------------------------------
+  /// Called with the refresh rate of the display, in frames per second, when
+  /// the vsync period changes. Called on the thread that vsync is delivered
+  /// on, before the frame callback is fired.
+  ///
+  using RefreshRateCallback = std::function<void(double refresh_rate)>;
+
   static bool Register(JNIEnv* env);
 
-  VsyncWaiterAndroid(flutter::TaskRunners task_runners);
+  //----------------------------------------------------------------------------
+  /// @brief      Whether vsync is awaited with the native `AChoreographer`.
+  ///
+  static bool UsesNativeChoreographer();
+
+  VsyncWaiterAndroid(flutter::TaskRunners task_runners,
+                     RefreshRateCallback on_refresh_rate_changed = nullptr);
 
   ~VsyncWaiterAndroid() override;
 
  private:
+  const RefreshRateCallback on_refresh_rate_changed_;
+  // The vsync period that was last reported to |on_refresh_rate_changed_|.
+  std::atomic<int64_t> vsync_period_nanos_ = 0;
+
   // |VsyncWaiter|
   void AwaitVSync() override;
 
@@ -32,9 +65,19 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
                             jlong frameTargetTimeNanos,
                             jlong java_baton);
 
+  // Called on the UI thread by the native choreographer.
+  static void OnNativeChoreographerFrame(int64_t frame_time_nanos, void* data);
+
+  // Called on the UI thread by the native choreographer, from API 33 on.
+  static void OnNativeChoreographerVsync(const void* callback_data,
+                                         void* data);
+
   static void ConsumePendingCallback(jlong java_baton,
                                      fml::TimePoint frame_start_time,
-                                     fml::TimePoint frame_target_time);
+                                     fml::TimePoint frame_target_time,
+                                     int64_t vsync_period_nanos);
+
+  void UpdateVsyncPeriod(int64_t vsync_period_nanos);
 
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterAndroid);
 };
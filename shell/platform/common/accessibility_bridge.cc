@@ -5,6 +5,7 @@
 #include "accessibility_bridge.h"
 
 #include <functional>
+#include <unordered_set>
 #include <utility>
 
 #include "flutter/third_party/accessibility/ax/ax_tree_update.h"
@@ -54,19 +55,60 @@ void AccessibilityBridge::CommitUpdates() {
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(std::move(target), sub_tree_list);
+    results.push_back(std::move(sub_tree_list));
+  }
+
+  // The parent of every node listed as a child in this update. Nodes that are
+  // not listed keep the parent they were committed with.
+  std::unordered_map<int32_t, int32_t> parent_ids;
+  for (const std::vector<SemanticsNode>& sub_tree_list : results) {
+    for (const SemanticsNode& node : sub_tree_list) {
+      for (int32_t child : node.children_in_traversal_order) {
+        parent_ids[child] = node.id;
+      }
+    }
   }
 
+  // Nodes whose semantics did not change since the last commit are left out
+  // of the ui::AXTreeUpdate so that the tree does not re-process them and the
+  // event generator does not have to diff them. A node that moved to a new
+  // parent is always sent, and so is every descendant of it in this update:
+  // ui::AXTree destroys a reparented subtree and recreates it from the update.
+  std::unordered_set<int32_t> reparented_ids;
   for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
+    for (SemanticsNode& node : results[i - 1]) {
+      int32_t id = node.id;
+      const auto committed = committed_semantics_nodes_.find(id);
+      int32_t parent_id = ui::AXNode::kInvalidAXID;
+      if (const auto parent = parent_ids.find(id); parent != parent_ids.end()) {
+        parent_id = parent->second;
+      } else if (committed != committed_semantics_nodes_.end()) {
+        parent_id = committed->second.parent_id;
+      }
+      if (committed != committed_semantics_nodes_.end() &&
+          (committed->second.parent_id != parent_id ||
+           reparented_ids.count(parent_id) > 0)) {
+        reparented_ids.insert(id);
+      }
+      if (reparented_ids.count(id) == 0 &&
+          !HasSemanticsNodeChanged(node, parent_id)) {
+        SetTreeData(node, update);
+        continue;
+      }
       ConvertFluterUpdate(node, update);
+      committed_semantics_nodes_[id] = {std::move(node), parent_id};
     }
   }
 
+  if (update.nodes.empty() && update.tree_data == tree_.data()) {
+    pending_semantics_custom_action_updates_.clear();
+    return;
+  }
+
   tree_.Unserialize(update);
   pending_semantics_node_updates_.clear();
   pending_semantics_custom_action_updates_.clear();
@@ -97,7 +139,19 @@ AccessibilityBridge::GetFlutterPlatformNodeDelegateFromID(
     return iter->second;
   }
 
-  return std::weak_ptr<FlutterPlatformNodeDelegate>();
+  // Platform node delegates are created lazily the first time a node is
+  // queried, so that nodes the platform never asks about do not pay for a
+  // native accessibility object.
+  ui::AXNode* node = tree_.GetFromId(id);
+  if (!node) {
+    return std::weak_ptr<FlutterPlatformNodeDelegate>();
+  }
+  std::shared_ptr<FlutterPlatformNodeDelegate> platform_node_delegate =
+      delegate_->CreateFlutterPlatformNodeDelegate();
+  platform_node_delegate->Init(
+      std::const_pointer_cast<AccessibilityBridge>(shared_from_this()), node);
+  id_wrapper_map_[id] = platform_node_delegate;
+  return platform_node_delegate;
 }
 
 const ui::AXTreeData& AccessibilityBridge::GetAXTreeData() const {
@@ -127,19 +181,15 @@ void AccessibilityBridge::OnRoleChanged(ui::AXTree* tree,
 
 void AccessibilityBridge::OnNodeCreated(ui::AXTree* tree, ui::AXNode* node) {
   BASE_DCHECK(node);
-  id_wrapper_map_[node->id()] = delegate_->CreateFlutterPlatformNodeDelegate();
-  id_wrapper_map_[node->id()]->Init(
-      std::static_pointer_cast<FlutterPlatformNodeDelegate::OwnerBridge>(
-          shared_from_this()),
-      node);
+  // The platform node delegate is created on first use, see
+  // GetFlutterPlatformNodeDelegateFromID.
 }
 
 void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
                                         AccessibilityNodeId node_id) {
   BASE_DCHECK(node_id != ui::AXNode::kInvalidAXID);
-  if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
-    id_wrapper_map_.erase(node_id);
-  }
+  id_wrapper_map_.erase(node_id);
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -164,15 +214,69 @@ void AccessibilityBridge::OnAtomicUpdateFinished(
 // Private method.
 void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
+  std::vector<int32_t> children = target.children_in_traversal_order;
+  result.push_back(std::move(target));
+  for (int32_t child : children) {
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(std::move(node), result);
+    }
+  }
+}
+
+bool AccessibilityBridge::HasSemanticsNodeChanged(const SemanticsNode& node,
+                                                  int32_t parent_id) const {
+  if (!tree_.GetFromId(node.id)) {
+    return true;
+  }
+  const auto iter = committed_semantics_nodes_.find(node.id);
+  if (iter == committed_semantics_nodes_.end()) {
+    return true;
+  }
+  // Custom action labels are resolved from the pending custom action updates,
+  // so a node referencing an updated custom action has to be re-converted.
+  for (int32_t action_id : node.custom_accessibility_actions) {
+    if (pending_semantics_custom_action_updates_.find(action_id) !=
+        pending_semantics_custom_action_updates_.end()) {
+      return true;
     }
   }
+  if (iter->second.parent_id != parent_id) {
+    return true;
+  }
+  const SemanticsNode& old = iter->second.node;
+  return old.flags != node.flags || old.actions != node.actions ||
+         old.text_selection_base != node.text_selection_base ||
+         old.text_selection_extent != node.text_selection_extent ||
+         old.scroll_child_count != node.scroll_child_count ||
+         old.scroll_index != node.scroll_index ||
+         old.scroll_position != node.scroll_position ||
+         old.scroll_extent_max != node.scroll_extent_max ||
+         old.scroll_extent_min != node.scroll_extent_min ||
+         old.elevation != node.elevation || old.thickness != node.thickness ||
+         old.label != node.label || old.hint != node.hint ||
+         old.value != node.value ||
+         old.increased_value != node.increased_value ||
+         old.decreased_value != node.decreased_value ||
+         old.text_direction != node.text_direction ||
+         old.rect.left != node.rect.left || old.rect.top != node.rect.top ||
+         old.rect.right != node.rect.right ||
+         old.rect.bottom != node.rect.bottom ||
+         old.transform.scaleX != node.transform.scaleX ||
+         old.transform.skewX != node.transform.skewX ||
+         old.transform.transX != node.transform.transX ||
+         old.transform.skewY != node.transform.skewY ||
+         old.transform.scaleY != node.transform.scaleY ||
+         old.transform.transY != node.transform.transY ||
+         old.transform.pers0 != node.transform.pers0 ||
+         old.transform.pers1 != node.transform.pers1 ||
+         old.transform.pers2 != node.transform.pers2 ||
+         old.children_in_traversal_order !=
+             node.children_in_traversal_order ||
+         old.custom_accessibility_actions !=
+             node.custom_accessibility_actions;
 }
 
 void AccessibilityBridge::ConvertFluterUpdate(const SemanticsNode& node,
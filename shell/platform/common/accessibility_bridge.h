@@ -142,7 +142,8 @@ class AccessibilityBridge
   /// @brief      Get the flutter platform node delegate with the given id from
   ///             this accessibility bridge. Returns expired weak_ptr if the
   ///             delegate associated with the id does not exist or has been
-  ///             removed from the accessibility tree.
+  ///             removed from the accessibility tree. The delegate is created
+  ///             the first time a node is queried.
   ///
   /// @param[in]  id           The id of the flutter accessibility node you want
   ///                          to retrieve.
@@ -198,19 +199,33 @@ class AccessibilityBridge
     std::string hint;
   } SemanticsCustomAction;
 
-  std::unordered_map<AccessibilityNodeId,
-                     std::shared_ptr<FlutterPlatformNodeDelegate>>
+  // A committed SemanticsNode along with the id of the node that listed it as
+  // a child, or ui::AXNode::kInvalidAXID for the root.
+  typedef struct {
+    SemanticsNode node;
+    int32_t parent_id;
+  } CommittedSemanticsNode;
+
+  // Populated lazily by GetFlutterPlatformNodeDelegateFromID.
+  mutable std::unordered_map<AccessibilityNodeId,
+                             std::shared_ptr<FlutterPlatformNodeDelegate>>
       id_wrapper_map_;
   ui::AXTree tree_;
   ui::AXEventGenerator event_generator_;
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
+  // The last committed semantics and parent of every node in |tree_|, used to
+  // leave unchanged nodes out of the next ui::AXTreeUpdate.
+  std::unordered_map<int32_t, CommittedSemanticsNode>
+      committed_semantics_nodes_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
   std::unique_ptr<AccessibilityBridgeDelegate> delegate_;
 
   void InitAXTree(const ui::AXTreeUpdate& initial_state);
   void GetSubTreeList(SemanticsNode target, std::vector<SemanticsNode>& result);
+  bool HasSemanticsNodeChanged(const SemanticsNode& node,
+                               int32_t parent_id) const;
   void ConvertFluterUpdate(const SemanticsNode& node,
                            ui::AXTreeUpdate& tree_update);
   void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
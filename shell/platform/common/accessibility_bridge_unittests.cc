@@ -200,5 +200,111 @@ TEST(AccessibilityBridgeTest, canHandleSelectionChangeCorrectly) {
             ui::AXEventGenerator::Event::OTHER_ATTRIBUTE_CHANGED);
 }
 
+TEST(AccessibilityBridgeTest, skipsUnchangedNodes) {
+  TestAccessibilityBridgeDelegate* delegate =
+      new TestAccessibilityBridgeDelegate();
+  std::unique_ptr<TestAccessibilityBridgeDelegate> ptr(delegate);
+  std::shared_ptr<AccessibilityBridge> bridge =
+      std::make_shared<AccessibilityBridge>(std::move(ptr));
+  FlutterSemanticsNode root = {};
+  root.id = 0;
+  root.flags = static_cast<FlutterSemanticsFlag>(0);
+  root.actions = static_cast<FlutterSemanticsAction>(0);
+  root.text_selection_base = -1;
+  root.text_selection_extent = -1;
+  root.label = "root";
+  root.hint = "";
+  root.value = "";
+  root.increased_value = "";
+  root.decreased_value = "";
+  root.child_count = 0;
+  root.custom_accessibility_actions_count = 0;
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+
+  bridge->CommitUpdates();
+  delegate->accessibilitiy_events.clear();
+
+  // Resending the same semantics must not generate any event.
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->CommitUpdates();
+  EXPECT_EQ(delegate->accessibilitiy_events.size(), size_t{0});
+
+  auto root_node = bridge->GetFlutterPlatformNodeDelegateFromID(0).lock();
+  EXPECT_EQ(root_node->GetName(), "root");
+
+  // A label change is still applied.
+  root.label = "new root";
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->CommitUpdates();
+  EXPECT_EQ(root_node->GetName(), "new root");
+  EXPECT_FALSE(delegate->accessibilitiy_events.empty());
+}
+
+TEST(AccessibilityBridgeTest, sendsUnchangedNodesThatMovedToANewParent) {
+  std::shared_ptr<AccessibilityBridge> bridge =
+      std::make_shared<AccessibilityBridge>(
+          std::make_unique<TestAccessibilityBridgeDelegate>());
+  auto make_node = [](int32_t id, const char* label) {
+    FlutterSemanticsNode node = {};
+    node.id = id;
+    node.flags = static_cast<FlutterSemanticsFlag>(0);
+    node.actions = static_cast<FlutterSemanticsAction>(0);
+    node.text_selection_base = -1;
+    node.text_selection_extent = -1;
+    node.label = label;
+    node.hint = "";
+    node.value = "";
+    node.increased_value = "";
+    node.decreased_value = "";
+    node.child_count = 0;
+    node.custom_accessibility_actions_count = 0;
+    return node;
+  };
+  // 0 -> {1 -> {3 -> {4}}, 2}
+  int32_t root_children[] = {1, 2};
+  int32_t moved_children[] = {3};
+  int32_t leaf_children[] = {4};
+  FlutterSemanticsNode root = make_node(0, "root");
+  root.child_count = 2;
+  root.children_in_traversal_order = root_children;
+  FlutterSemanticsNode old_parent = make_node(1, "old parent");
+  old_parent.child_count = 1;
+  old_parent.children_in_traversal_order = moved_children;
+  FlutterSemanticsNode new_parent = make_node(2, "new parent");
+  FlutterSemanticsNode moved = make_node(3, "moved");
+  moved.child_count = 1;
+  moved.children_in_traversal_order = leaf_children;
+  FlutterSemanticsNode leaf = make_node(4, "leaf");
+  for (const FlutterSemanticsNode* node :
+       {&root, &old_parent, &new_parent, &moved, &leaf}) {
+    bridge->AddFlutterSemanticsNodeUpdate(node);
+  }
+  bridge->CommitUpdates();
+
+  // 0 -> {1, 2 -> {3 -> {4}}}, where 3 and 4 are otherwise unchanged.
+  old_parent.child_count = 0;
+  old_parent.children_in_traversal_order = nullptr;
+  new_parent.child_count = 1;
+  new_parent.children_in_traversal_order = moved_children;
+  for (const FlutterSemanticsNode* node :
+       {&root, &old_parent, &new_parent, &moved, &leaf}) {
+    bridge->AddFlutterSemanticsNodeUpdate(node);
+  }
+  bridge->CommitUpdates();
+
+  auto old_parent_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  auto new_parent_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  auto moved_node = bridge->GetFlutterPlatformNodeDelegateFromID(3).lock();
+  auto leaf_node = bridge->GetFlutterPlatformNodeDelegateFromID(4).lock();
+  ASSERT_TRUE(moved_node);
+  ASSERT_TRUE(leaf_node);
+  EXPECT_EQ(old_parent_node->GetChildCount(), 0);
+  EXPECT_EQ(new_parent_node->GetChildCount(), 1);
+  EXPECT_EQ(new_parent_node->GetData().child_ids[0], 3);
+  EXPECT_EQ(moved_node->GetChildCount(), 1);
+  EXPECT_EQ(moved_node->GetName(), "moved");
+  EXPECT_EQ(leaf_node->GetName(), "leaf");
+}
+
 }  // namespace testing
 }  // namespace flutter
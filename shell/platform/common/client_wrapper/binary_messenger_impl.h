@@ -8,7 +8,9 @@
 #include <flutter_messenger.h>
 
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "include/flutter/binary_messenger.h"
 
@@ -36,10 +38,38 @@ class BinaryMessengerImpl : public BinaryMessenger {
   void SetMessageHandler(const std::string& channel,
                          BinaryMessageHandler handler) override;
 
+  // |flutter::BinaryMessenger|
+  TaskQueue* CreateTaskQueue() override;
+
+  // |flutter::BinaryMessenger|
+  void SetMessageHandlerOnTaskQueue(const std::string& channel,
+                                    BinaryMessageHandler handler,
+                                    TaskQueue* task_queue) override;
+
  private:
+  // Wrapper around a FlutterDesktopTaskQueueRef.
+  class TaskQueueImpl : public TaskQueue {
+   public:
+    explicit TaskQueueImpl(FlutterDesktopTaskQueueRef task_queue)
+        : task_queue_(task_queue) {}
+
+    FlutterDesktopTaskQueueRef task_queue() const { return task_queue_; }
+
+   private:
+    FlutterDesktopTaskQueueRef task_queue_;
+  };
+
+  // Registers |handler| for |channel|, on |task_queue| if it is not null.
+  void SetHandler(const std::string& channel,
+                  BinaryMessageHandler handler,
+                  FlutterDesktopTaskQueueRef task_queue);
+
   // Handle for interacting with the C API.
   FlutterDesktopMessengerRef messenger_;
 
+  // The task queues created by this messenger.
+  std::vector<std::unique_ptr<TaskQueueImpl>> task_queues_;
+
   // A map from channel names to the BinaryMessageHandler that should be called
   // for incoming messages on that channel.
   std::map<std::string, BinaryMessageHandler> handlers_;
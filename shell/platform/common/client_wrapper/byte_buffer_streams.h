@@ -52,6 +52,11 @@ class ByteBufferStreamReader : public ByteStreamReader {
     }
   }
 
+  // |ByteStreamReader|
+  size_t RemainingBytes() const override {
+    return location_ < size_ ? size_ - location_ : 0;
+  }
+
  private:
   // The buffer to read from.
   const uint8_t* bytes_;
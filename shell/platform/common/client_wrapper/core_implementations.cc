@@ -97,18 +97,53 @@ void BinaryMessengerImpl::Send(const std::string& channel,
 
 void BinaryMessengerImpl::SetMessageHandler(const std::string& channel,
                                             BinaryMessageHandler handler) {
-  if (!handler) {
-    handlers_.erase(channel);
+  SetHandler(channel, std::move(handler), nullptr);
+}
+
+TaskQueue* BinaryMessengerImpl::CreateTaskQueue() {
+  FlutterDesktopTaskQueueRef task_queue =
+      FlutterDesktopMessengerCreateTaskQueue(messenger_);
+  if (!task_queue) {
+    return nullptr;
+  }
+  task_queues_.push_back(std::make_unique<TaskQueueImpl>(task_queue));
+  return task_queues_.back().get();
+}
+
+void BinaryMessengerImpl::SetMessageHandlerOnTaskQueue(
+    const std::string& channel,
+    BinaryMessageHandler handler,
+    TaskQueue* task_queue) {
+  SetHandler(channel, std::move(handler),
+             task_queue ? static_cast<TaskQueueImpl*>(task_queue)->task_queue()
+                        : nullptr);
+}
+
+void BinaryMessengerImpl::SetHandler(const std::string& channel,
+                                     BinaryMessageHandler handler,
+                                     FlutterDesktopTaskQueueRef task_queue) {
+  // Unregister any previous handler before replacing it, as it may be running
+  // on a task queue until this returns.
+  if (!handler || handlers_.count(channel) > 0) {
     FlutterDesktopMessengerSetCallback(messenger_, channel.c_str(), nullptr,
                                        nullptr);
+  }
+  if (!handler) {
+    handlers_.erase(channel);
     return;
   }
   // Save the handler, to keep it alive.
   handlers_[channel] = std::move(handler);
   BinaryMessageHandler* message_handler = &handlers_[channel];
   // Set an adaptor callback that will invoke the handler.
-  FlutterDesktopMessengerSetCallback(messenger_, channel.c_str(),
-                                     ForwardToHandler, message_handler);
+  if (task_queue) {
+    FlutterDesktopMessengerSetCallbackOnTaskQueue(
+        messenger_, channel.c_str(), ForwardToHandler, message_handler,
+        task_queue);
+  } else {
+    FlutterDesktopMessengerSetCallback(messenger_, channel.c_str(),
+                                       ForwardToHandler, message_handler);
+  }
 }
 
 // ========== engine_method_result.h ==========
@@ -169,6 +204,24 @@ int64_t TextureRegistrarImpl::RegisterTexture(TextureVariant* texture) {
       return buffer;
     };
 
+    int64_t texture_id = FlutterDesktopTextureRegistrarRegisterExternalTexture(
+        texture_registrar_ref_, &info);
+    return texture_id;
+  } else if (auto gpu_surface_texture =
+                 std::get_if<GpuSurfaceTexture>(texture)) {
+    FlutterDesktopTextureInfo info = {};
+    info.type = kFlutterDesktopGpuSurfaceTexture;
+    info.gpu_surface_config.struct_size =
+        sizeof(FlutterDesktopGpuSurfaceTextureConfig);
+    info.gpu_surface_config.type = gpu_surface_texture->surface_type();
+    info.gpu_surface_config.user_data = gpu_surface_texture;
+    info.gpu_surface_config.callback =
+        [](size_t width, size_t height,
+           void* user_data) -> const FlutterDesktopGpuSurfaceDescriptor* {
+      auto texture = static_cast<GpuSurfaceTexture*>(user_data);
+      return texture->ObtainDescriptor(width, height);
+    };
+
     int64_t texture_id = FlutterDesktopTextureRegistrarRegisterExternalTexture(
         texture_registrar_ref_, &info);
     return texture_id;
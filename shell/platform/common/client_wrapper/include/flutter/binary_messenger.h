@@ -23,6 +23,14 @@ typedef std::function<
     void(const uint8_t* message, size_t message_size, BinaryReply reply)>
     BinaryMessageHandler;
 
+// A queue on which message handlers run in the order of their messages on a
+// background thread, instead of the platform thread. Created by
+// BinaryMessenger::CreateTaskQueue, and valid as long as the messenger.
+class TaskQueue {
+ public:
+  virtual ~TaskQueue() = default;
+};
+
 // A protocol for a class that handles communication of binary data on named
 // channels to and from the Flutter engine.
 class BinaryMessenger {
@@ -45,6 +53,25 @@ class BinaryMessenger {
   // existing handler.
   virtual void SetMessageHandler(const std::string& channel,
                                  BinaryMessageHandler handler) = 0;
+
+  // Creates a task queue for handlers that would otherwise block the platform
+  // thread, such as ones doing disk or database I/O.
+  //
+  // Returns null if the messenger does not support task queues, in which case
+  // handlers set on a null task queue run on the platform thread.
+  virtual TaskQueue* CreateTaskQueue() { return nullptr; }
+
+  // Registers a message handler like SetMessageHandler, but which is called on
+  // |task_queue| instead of the platform thread. The handler may reply from
+  // any thread, while messages must still be sent from the platform thread.
+  //
+  // The handler is no longer called once this or SetMessageHandler returns for
+  // the same channel, even if it was running.
+  virtual void SetMessageHandlerOnTaskQueue(const std::string& channel,
+                                            BinaryMessageHandler handler,
+                                            TaskQueue* task_queue) {
+    SetMessageHandler(channel, std::move(handler));
+  }
 };
 
 }  // namespace flutter
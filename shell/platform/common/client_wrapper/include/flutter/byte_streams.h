@@ -7,6 +7,8 @@
 
 // Interfaces for interacting with a stream of bytes, for use in codecs.
 
+#include <limits>
+
 namespace flutter {
 
 // An interface for a class that reads from a byte stream.
@@ -26,6 +28,12 @@ class ByteStreamReader {
   // the start of the stream, unless it is already aligned.
   virtual void ReadAlignment(uint8_t alignment) = 0;
 
+  // Returns the number of bytes left to read from the stream, or the maximum
+  // size_t if the stream does not know it.
+  virtual size_t RemainingBytes() const {
+    return std::numeric_limits<size_t>::max();
+  }
+
   // Reads and returns the next 32-bit integer from the stream.
   int32_t ReadInt32() {
     int32_t value = 0;
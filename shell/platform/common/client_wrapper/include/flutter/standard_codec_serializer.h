@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_SERIALIZER_H_
 #define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_SERIALIZER_H_
 
+#include <functional>
+
 #include "byte_streams.h"
 #include "encodable_value.h"
 
@@ -36,6 +38,58 @@ class StandardCodecSerializer {
   virtual void WriteValue(const EncodableValue& value,
                           ByteStreamWriter* stream) const;
 
+  // Streaming API.
+  //
+  // The methods below read and write the encoding one piece at a time, so that
+  // large collections can be written from, or read into, caller-owned data
+  // without building an intermediate EncodableValue tree. They can be freely
+  // mixed with ReadValue and WriteValue, e.g. to write a list header followed
+  // by each of its elements.
+
+  // Writes the header of a list of |length| elements to |stream|. The header
+  // must be followed by exactly |length| values.
+  void WriteListHeader(size_t length, ByteStreamWriter* stream) const;
+
+  // Writes the header of a map of |length| entries to |stream|. The header
+  // must be followed by exactly |length| pairs of key and value.
+  void WriteMapHeader(size_t length, ByteStreamWriter* stream) const;
+
+  // Writes the |count| elements at |data| to |stream| as a fixed-type list,
+  // without copying them into an EncodableValue first. |T| must be one of
+  // uint8_t, int32_t, int64_t or double.
+  template <typename T>
+  void WriteTypedList(const T* data,
+                      size_t count,
+                      ByteStreamWriter* stream) const;
+
+  // Reads the header of a list from |stream|, storing the number of elements
+  // that follow it in |length|.
+  //
+  // Returns false if the next value is not a list, in which case its type byte
+  // has been consumed and the stream should no longer be used.
+  bool ReadListHeader(ByteStreamReader* stream, size_t* length) const;
+
+  // Reads the header of a map from |stream|, storing the number of key and
+  // value pairs that follow it in |length|.
+  //
+  // Returns false if the next value is not a map, in which case its type byte
+  // has been consumed and the stream should no longer be used.
+  bool ReadMapHeader(ByteStreamReader* stream, size_t* length) const;
+
+  // Reads a fixed-type list of |T| from |stream|, passing its elements to
+  // |visitor| in consecutive chunks instead of materializing the whole list.
+  // The chunk is only valid for the duration of the call. |T| must be one of
+  // uint8_t, int32_t, int64_t or double.
+  //
+  // Returns false if the next value is not a list of |T|, or if its length
+  // exceeds the bytes left in the stream, in which case its header has been
+  // consumed and the stream should no longer be used.
+  template <typename T>
+  bool ReadTypedList(
+      ByteStreamReader* stream,
+      const std::function<void(const T* elements, size_t count)>& visitor)
+      const;
+
  protected:
   // Codecs require long-lived serializers, so clients should always use
   // GetInstance().
@@ -65,10 +119,13 @@ class StandardCodecSerializer {
   template <typename T>
   EncodableValue ReadVector(ByteStreamReader* stream) const;
 
-  // Writes |vector| to |stream| as a fixed-type list. |T| must correspond to
-  // one of the supported list value types of EncodableValue.
+  // Writes the |count| elements at |data| to |stream| as the contents of a
+  // fixed-type list. |T| must correspond to one of the supported list value
+  // types of EncodableValue.
   template <typename T>
-  void WriteVector(const std::vector<T> vector, ByteStreamWriter* stream) const;
+  void WriteVector(const T* data,
+                   size_t count,
+                   ByteStreamWriter* stream) const;
 };
 
 }  // namespace flutter
@@ -7,11 +7,13 @@
 // together to simplify use of the client wrapper, since the common case is
 // that any client that needs one of these files needs all three.
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <iostream>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "byte_buffer_streams.h"
@@ -75,6 +77,33 @@ EncodedType EncodedTypeForValue(const EncodableValue& value) {
   return EncodedType::kNull;
 }
 
+// Returns the encoded type of a fixed-type list whose values are of type T.
+template <typename T>
+EncodedType EncodedTypeForList();
+
+template <>
+EncodedType EncodedTypeForList<uint8_t>() {
+  return EncodedType::kUInt8List;
+}
+
+template <>
+EncodedType EncodedTypeForList<int32_t>() {
+  return EncodedType::kInt32List;
+}
+
+template <>
+EncodedType EncodedTypeForList<int64_t>() {
+  return EncodedType::kInt64List;
+}
+
+template <>
+EncodedType EncodedTypeForList<double>() {
+  return EncodedType::kFloat64List;
+}
+
+// The number of elements ReadTypedList passes to its visitor at a time.
+constexpr size_t kTypedListChunkSize = 4096;
+
 }  // namespace
 
 StandardCodecSerializer::StandardCodecSerializer() = default;
@@ -121,18 +150,26 @@ void StandardCodecSerializer::WriteValue(const EncodableValue& value,
       }
       break;
     }
-    case 6:
-      WriteVector(std::get<std::vector<uint8_t>>(value), stream);
+    case 6: {
+      const auto& vector = std::get<std::vector<uint8_t>>(value);
+      WriteVector(vector.data(), vector.size(), stream);
       break;
-    case 7:
-      WriteVector(std::get<std::vector<int32_t>>(value), stream);
+    }
+    case 7: {
+      const auto& vector = std::get<std::vector<int32_t>>(value);
+      WriteVector(vector.data(), vector.size(), stream);
       break;
-    case 8:
-      WriteVector(std::get<std::vector<int64_t>>(value), stream);
+    }
+    case 8: {
+      const auto& vector = std::get<std::vector<int64_t>>(value);
+      WriteVector(vector.data(), vector.size(), stream);
       break;
-    case 9:
-      WriteVector(std::get<std::vector<double>>(value), stream);
+    }
+    case 9: {
+      const auto& vector = std::get<std::vector<double>>(value);
+      WriteVector(vector.data(), vector.size(), stream);
       break;
+    }
     case 10: {
       const auto& list = std::get<EncodableList>(value);
       WriteSize(list.size(), stream);
@@ -181,7 +218,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       std::string string_value;
       string_value.resize(size);
       stream->ReadBytes(reinterpret_cast<uint8_t*>(&string_value[0]), size);
-      return EncodableValue(string_value);
+      return EncodableValue(std::move(string_value));
     }
     case EncodedType::kUInt8List:
       return ReadVector<uint8_t>(stream);
@@ -198,7 +235,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       for (size_t i = 0; i < length; ++i) {
         list_value.push_back(ReadValue(stream));
       }
-      return EncodableValue(list_value);
+      return EncodableValue(std::move(list_value));
     }
     case EncodedType::kMap: {
       size_t length = ReadSize(stream);
@@ -208,7 +245,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
         EncodableValue value = ReadValue(stream);
         map_value.emplace(std::move(key), std::move(value));
       }
-      return EncodableValue(map_value);
+      return EncodableValue(std::move(map_value));
     }
   }
   std::cerr << "Unknown type in StandardCodecSerializer::ReadValueOfType: "
@@ -258,13 +295,13 @@ EncodableValue StandardCodecSerializer::ReadVector(
   }
   stream->ReadBytes(reinterpret_cast<uint8_t*>(vector.data()),
                     count * type_size);
-  return EncodableValue(vector);
+  return EncodableValue(std::move(vector));
 }
 
 template <typename T>
-void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
+void StandardCodecSerializer::WriteVector(const T* data,
+                                          size_t count,
                                           ByteStreamWriter* stream) const {
-  size_t count = vector.size();
   WriteSize(count, stream);
   if (count == 0) {
     return;
@@ -273,10 +310,109 @@ void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
   if (type_size > 1) {
     stream->WriteAlignment(type_size);
   }
-  stream->WriteBytes(reinterpret_cast<const uint8_t*>(vector.data()),
-                     count * type_size);
+  stream->WriteBytes(reinterpret_cast<const uint8_t*>(data), count * type_size);
+}
+
+void StandardCodecSerializer::WriteListHeader(size_t length,
+                                              ByteStreamWriter* stream) const {
+  stream->WriteByte(static_cast<uint8_t>(EncodedType::kList));
+  WriteSize(length, stream);
+}
+
+void StandardCodecSerializer::WriteMapHeader(size_t length,
+                                             ByteStreamWriter* stream) const {
+  stream->WriteByte(static_cast<uint8_t>(EncodedType::kMap));
+  WriteSize(length, stream);
+}
+
+template <typename T>
+void StandardCodecSerializer::WriteTypedList(const T* data,
+                                             size_t count,
+                                             ByteStreamWriter* stream) const {
+  stream->WriteByte(static_cast<uint8_t>(EncodedTypeForList<T>()));
+  WriteVector(data, count, stream);
+}
+
+bool StandardCodecSerializer::ReadListHeader(ByteStreamReader* stream,
+                                             size_t* length) const {
+  if (stream->ReadByte() != static_cast<uint8_t>(EncodedType::kList)) {
+    return false;
+  }
+  *length = ReadSize(stream);
+  return true;
+}
+
+bool StandardCodecSerializer::ReadMapHeader(ByteStreamReader* stream,
+                                            size_t* length) const {
+  if (stream->ReadByte() != static_cast<uint8_t>(EncodedType::kMap)) {
+    return false;
+  }
+  *length = ReadSize(stream);
+  return true;
+}
+
+template <typename T>
+bool StandardCodecSerializer::ReadTypedList(
+    ByteStreamReader* stream,
+    const std::function<void(const T* elements, size_t count)>& visitor)
+    const {
+  if (stream->ReadByte() != static_cast<uint8_t>(EncodedTypeForList<T>())) {
+    return false;
+  }
+  size_t remaining = ReadSize(stream);
+  if (remaining == 0) {
+    return true;
+  }
+  uint8_t type_size = static_cast<uint8_t>(sizeof(T));
+  if (type_size > 1) {
+    stream->ReadAlignment(type_size);
+  }
+  // The length comes from the message, so it is checked against what is left
+  // in the stream before anything is read.
+  if (remaining > stream->RemainingBytes() / type_size) {
+    return false;
+  }
+  std::vector<T> chunk(std::min(remaining, kTypedListChunkSize));
+  while (remaining > 0) {
+    size_t count = std::min(remaining, chunk.size());
+    stream->ReadBytes(reinterpret_cast<uint8_t*>(chunk.data()),
+                      count * type_size);
+    visitor(chunk.data(), count);
+    remaining -= count;
+  }
+  return true;
 }
 
+template void StandardCodecSerializer::WriteTypedList<uint8_t>(
+    const uint8_t* data,
+    size_t count,
+    ByteStreamWriter* stream) const;
+template void StandardCodecSerializer::WriteTypedList<int32_t>(
+    const int32_t* data,
+    size_t count,
+    ByteStreamWriter* stream) const;
+template void StandardCodecSerializer::WriteTypedList<int64_t>(
+    const int64_t* data,
+    size_t count,
+    ByteStreamWriter* stream) const;
+template void StandardCodecSerializer::WriteTypedList<double>(
+    const double* data,
+    size_t count,
+    ByteStreamWriter* stream) const;
+
+template bool StandardCodecSerializer::ReadTypedList<uint8_t>(
+    ByteStreamReader* stream,
+    const std::function<void(const uint8_t*, size_t)>& visitor) const;
+template bool StandardCodecSerializer::ReadTypedList<int32_t>(
+    ByteStreamReader* stream,
+    const std::function<void(const int32_t*, size_t)>& visitor) const;
+template bool StandardCodecSerializer::ReadTypedList<int64_t>(
+    ByteStreamReader* stream,
+    const std::function<void(const int64_t*, size_t)>& visitor) const;
+template bool StandardCodecSerializer::ReadTypedList<double>(
+    ByteStreamReader* stream,
+    const std::function<void(const double*, size_t)>& visitor) const;
+
 // ===== standard_message_codec.h =====
 
 // static
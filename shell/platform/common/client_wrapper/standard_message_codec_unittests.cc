@@ -7,6 +7,7 @@
 #include <map>
 #include <vector>
 
+#include "flutter/shell/platform/common/client_wrapper/byte_buffer_streams.h"
 #include "flutter/shell/platform/common/client_wrapper/testing/test_codec_extensions.h"
 #include "gtest/gtest.h"
 
@@ -219,4 +220,89 @@ TEST(StandardMessageCodec, CanEncodeAndDecodeVariableLengthCustomType) {
                     some_data_comparator);
 }
 
+TEST(StandardMessageCodec, StreamingWritesMatchEncodableValues) {
+  const StandardCodecSerializer& serializer =
+      StandardCodecSerializer::GetInstance();
+  const std::vector<int32_t> ints = {1, 2, 3};
+  const std::vector<double> doubles = {0.5, 1.5};
+
+  std::vector<uint8_t> streamed;
+  ByteBufferStreamWriter writer(&streamed);
+  serializer.WriteListHeader(2, &writer);
+  serializer.WriteMapHeader(1, &writer);
+  serializer.WriteValue(EncodableValue("ints"), &writer);
+  serializer.WriteTypedList(ints.data(), ints.size(), &writer);
+  serializer.WriteTypedList(doubles.data(), doubles.size(), &writer);
+
+  EncodableValue value(EncodableList{
+      EncodableValue(EncodableMap{
+          {EncodableValue("ints"), EncodableValue(ints)},
+      }),
+      EncodableValue(doubles),
+  });
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+  EXPECT_EQ(streamed, *encoded);
+}
+
+TEST(StandardMessageCodec, StreamingReadsVisitTypedListsInChunks) {
+  std::vector<int64_t> rows(10000);
+  for (size_t i = 0; i < rows.size(); ++i) {
+    rows[i] = static_cast<int64_t>(i) * 3;
+  }
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(
+      EncodableValue(EncodableList{EncodableValue(rows), EncodableValue(7)}));
+  ASSERT_TRUE(encoded);
+
+  const StandardCodecSerializer& serializer =
+      StandardCodecSerializer::GetInstance();
+  ByteBufferStreamReader reader(encoded->data(), encoded->size());
+  size_t length = 0;
+  ASSERT_TRUE(serializer.ReadListHeader(&reader, &length));
+  EXPECT_EQ(length, 2u);
+
+  std::vector<int64_t> visited;
+  size_t chunks = 0;
+  ASSERT_TRUE(serializer.ReadTypedList<int64_t>(
+      &reader, [&visited, &chunks](const int64_t* elements, size_t count) {
+        visited.insert(visited.end(), elements, elements + count);
+        ++chunks;
+      }));
+  EXPECT_EQ(visited, rows);
+  EXPECT_GT(chunks, 1u);
+  EXPECT_EQ(serializer.ReadValue(&reader), EncodableValue(7));
+}
+
+TEST(StandardMessageCodec, StreamingReadsRejectOtherTypes) {
+  const StandardCodecSerializer& serializer =
+      StandardCodecSerializer::GetInstance();
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(
+      EncodableValue(std::vector<int32_t>{1, 2}));
+  ASSERT_TRUE(encoded);
+
+  size_t length = 0;
+  ByteBufferStreamReader list_reader(encoded->data(), encoded->size());
+  EXPECT_FALSE(serializer.ReadListHeader(&list_reader, &length));
+  ByteBufferStreamReader map_reader(encoded->data(), encoded->size());
+  EXPECT_FALSE(serializer.ReadMapHeader(&map_reader, &length));
+  ByteBufferStreamReader typed_reader(encoded->data(), encoded->size());
+  EXPECT_FALSE(serializer.ReadTypedList<double>(
+      &typed_reader, [](const double* elements, size_t count) {}));
+}
+
+TEST(StandardMessageCodec, StreamingReadsRejectTruncatedTypedLists) {
+  const StandardCodecSerializer& serializer =
+      StandardCodecSerializer::GetInstance();
+  auto encoded = StandardMessageCodec::GetInstance().EncodeMessage(
+      EncodableValue(std::vector<int32_t>{1, 2, 3}));
+  ASSERT_TRUE(encoded);
+
+  ByteBufferStreamReader reader(encoded->data(), encoded->size() - 1);
+  bool visited = false;
+  EXPECT_FALSE(serializer.ReadTypedList<int32_t>(
+      &reader,
+      [&visited](const int32_t* elements, size_t count) { visited = true; }));
+  EXPECT_FALSE(visited);
+}
+
 }  // namespace flutter
@@ -93,6 +93,28 @@ void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
   }
 }
 
+FlutterDesktopTaskQueueRef FlutterDesktopMessengerCreateTaskQueue(
+    FlutterDesktopMessengerRef messenger) {
+  FlutterDesktopTaskQueueRef result = nullptr;
+  if (s_stub_implementation) {
+    result = s_stub_implementation->MessengerCreateTaskQueue();
+  }
+  return result;
+}
+
+void FlutterDesktopMessengerSetCallbackOnTaskQueue(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageCallback callback,
+    void* user_data,
+    FlutterDesktopTaskQueueRef task_queue) {
+  if (s_stub_implementation) {
+    s_stub_implementation->MessengerSetCallbackOnTaskQueue(channel, callback,
+                                                           user_data,
+                                                           task_queue);
+  }
+}
+
 FlutterDesktopTextureRegistrarRef FlutterDesktopRegistrarGetTextureRegistrar(
     FlutterDesktopPluginRegistrarRef registrar) {
   return reinterpret_cast<FlutterDesktopTextureRegistrarRef>(1);
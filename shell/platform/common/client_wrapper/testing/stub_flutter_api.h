@@ -65,6 +65,18 @@ class StubFlutterApi {
                                     FlutterDesktopMessageCallback callback,
                                     void* user_data) {}
 
+  // Called for FlutterDesktopMessengerCreateTaskQueue.
+  virtual FlutterDesktopTaskQueueRef MessengerCreateTaskQueue() {
+    return nullptr;
+  }
+
+  // Called for FlutterDesktopMessengerSetCallbackOnTaskQueue.
+  virtual void MessengerSetCallbackOnTaskQueue(
+      const char* channel,
+      FlutterDesktopMessageCallback callback,
+      void* user_data,
+      FlutterDesktopTaskQueueRef task_queue) {}
+
   // Called for FlutterDesktopRegisterExternalTexture.
   virtual int64_t TextureRegistrarRegisterExternalTexture(
       const FlutterDesktopTextureInfo* info) {
@@ -4,13 +4,87 @@
 
 #include "flutter/shell/platform/common/incoming_message_dispatcher.h"
 
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
 namespace flutter {
 
+class IncomingMessageDispatcher::TaskQueue {
+ public:
+  TaskQueue() : thread_([this] { Run(); }) {}
+
+  ~TaskQueue() { Stop(); }
+
+  // Prevent copying.
+  TaskQueue(TaskQueue const&) = delete;
+  TaskQueue& operator=(TaskQueue const&) = delete;
+
+  // Queues |task| to run on the thread of this queue. Returns false if the
+  // queue was stopped.
+  bool PostTask(std::function<void(void)> task) {
+    {
+      std::scoped_lock lock(tasks_mutex_);
+      if (stopping_) {
+        return false;
+      }
+      tasks_.push_back(std::move(task));
+    }
+    tasks_condition_.notify_one();
+    return true;
+  }
+
+  // Runs the pending tasks and joins the thread of this queue.
+  void Stop() {
+    {
+      std::scoped_lock lock(tasks_mutex_);
+      stopping_ = true;
+    }
+    tasks_condition_.notify_one();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  // Held while a handler runs on this queue. It is recursive so that the
+  // handlers can register handlers for the channels of this queue.
+  std::recursive_mutex& handler_mutex() { return handler_mutex_; }
+
+ private:
+  void Run() {
+    while (true) {
+      std::function<void(void)> task;
+      {
+        std::unique_lock lock(tasks_mutex_);
+        tasks_condition_.wait(lock,
+                              [this] { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex tasks_mutex_;
+  std::condition_variable tasks_condition_;
+  std::deque<std::function<void(void)>> tasks_;
+  bool stopping_ = false;
+  std::recursive_mutex handler_mutex_;
+
+  // Started last, as it uses the members above.
+  std::thread thread_;
+};
+
 IncomingMessageDispatcher::IncomingMessageDispatcher(
     FlutterDesktopMessengerRef messenger)
     : messenger_(messenger) {}
 
-IncomingMessageDispatcher::~IncomingMessageDispatcher() = default;
+IncomingMessageDispatcher::~IncomingMessageDispatcher() {
+  StopTaskQueues();
+}
 
 /// @note Procedure doesn't copy all closures.
 void IncomingMessageDispatcher::HandleMessage(
@@ -20,34 +94,114 @@ void IncomingMessageDispatcher::HandleMessage(
   std::string channel(message.channel);
 
   // Find the handler for the channel; if there isn't one, report the failure.
-  if (callbacks_.find(channel) == callbacks_.end()) {
+  CallbackInfo callback_info = {};
+  {
+    std::scoped_lock lock(callbacks_mutex_);
+    auto found = callbacks_.find(channel);
+    if (found != callbacks_.end()) {
+      callback_info = found->second;
+    }
+  }
+  if (!callback_info.callback) {
     FlutterDesktopMessengerSendResponse(messenger_, message.response_handle,
                                         nullptr, 0);
     return;
   }
-  auto& callback_info = callbacks_[channel];
-  FlutterDesktopMessageCallback message_callback = callback_info.first;
+
+  if (TaskQueue* task_queue = callback_info.task_queue) {
+    // The message data is only valid for the duration of this call.
+    auto data = std::make_shared<std::vector<uint8_t>>(
+        message.message, message.message + message.message_size);
+    const FlutterDesktopMessageResponseHandle* response_handle =
+        message.response_handle;
+    bool posted = task_queue->PostTask(
+        [this, channel, data, response_handle, task_queue] {
+          FlutterDesktopMessage queued_message = {
+              sizeof(FlutterDesktopMessage),
+              channel.c_str(),
+              data->data(),
+              data->size(),
+              response_handle,
+          };
+          HandleMessageOnTaskQueue(channel, queued_message, task_queue);
+        });
+    if (!posted) {
+      FlutterDesktopMessengerSendResponse(messenger_, response_handle, nullptr,
+                                          0);
+    }
+    return;
+  }
 
   // Process the call, handling input blocking if requested.
   bool block_input = input_blocking_channels_.count(channel) > 0;
   if (block_input) {
     input_block_cb();
   }
-  message_callback(messenger_, &message, callback_info.second);
+  callback_info.callback(messenger_, &message, callback_info.user_data);
   if (block_input) {
     input_unblock_cb();
   }
 }
 
+void IncomingMessageDispatcher::HandleMessageOnTaskQueue(
+    const std::string& channel,
+    const FlutterDesktopMessage& message,
+    TaskQueue* task_queue) {
+  std::scoped_lock handler_lock(task_queue->handler_mutex());
+  CallbackInfo callback_info = {};
+  {
+    std::scoped_lock lock(callbacks_mutex_);
+    auto found = callbacks_.find(channel);
+    if (found != callbacks_.end()) {
+      callback_info = found->second;
+    }
+  }
+  // The handler was replaced or unregistered after the message was queued.
+  if (!callback_info.callback || callback_info.task_queue != task_queue) {
+    FlutterDesktopMessengerSendResponse(messenger_, message.response_handle,
+                                        nullptr, 0);
+    return;
+  }
+  callback_info.callback(messenger_, &message, callback_info.user_data);
+}
+
 void IncomingMessageDispatcher::SetMessageCallback(
     const std::string& channel,
     FlutterDesktopMessageCallback callback,
-    void* user_data) {
+    void* user_data,
+    TaskQueue* task_queue) {
+  TaskQueue* previous_task_queue = nullptr;
+  {
+    std::scoped_lock lock(callbacks_mutex_);
+    auto found = callbacks_.find(channel);
+    if (found != callbacks_.end()) {
+      previous_task_queue = found->second.task_queue;
+    }
+  }
+  // Wait for the previous handler to return if it is running on its queue.
+  std::unique_lock<std::recursive_mutex> handler_lock;
+  if (previous_task_queue) {
+    handler_lock = std::unique_lock(previous_task_queue->handler_mutex());
+  }
+
+  std::scoped_lock lock(callbacks_mutex_);
   if (!callback) {
     callbacks_.erase(channel);
     return;
   }
-  callbacks_[channel] = std::make_pair(callback, user_data);
+  callbacks_[channel] = {callback, user_data, task_queue};
+}
+
+IncomingMessageDispatcher::TaskQueue*
+IncomingMessageDispatcher::CreateTaskQueue() {
+  task_queues_.push_back(std::make_unique<TaskQueue>());
+  return task_queues_.back().get();
+}
+
+void IncomingMessageDispatcher::StopTaskQueues() {
+  for (auto& task_queue : task_queues_) {
+    task_queue->Stop();
+  }
 }
 
 void IncomingMessageDispatcher::EnableInputBlockingForChannel(
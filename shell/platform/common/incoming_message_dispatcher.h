@@ -7,9 +7,12 @@
 
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "flutter/shell/platform/common/public/flutter_messenger.h"
 
@@ -19,6 +22,10 @@ namespace flutter {
 // Flutter engine, and dispatching incoming messages to those handlers.
 class IncomingMessageDispatcher {
  public:
+  // A queue with its own background thread, on which the handlers of the
+  // channels bound to it run in the order of their messages.
+  class TaskQueue;
+
   // Creates a new IncomingMessageDispatcher. |messenger| must remain valid as
   // long as this object exists.
   explicit IncomingMessageDispatcher(FlutterDesktopMessengerRef messenger);
@@ -35,6 +42,9 @@ class IncomingMessageDispatcher {
   // If input blocking has been enabled on that channel, wraps the call to the
   // handler with calls to the given callbacks to block and then unblock input.
   //
+  // If the handler of that channel is bound to a task queue, the message is
+  // copied and the handler is called on that queue instead.
+  //
   // If no handler is registered for the message's channel, sends a
   // NotImplemented response to the engine.
   void HandleMessage(
@@ -46,11 +56,28 @@ class IncomingMessageDispatcher {
   // side on the specified channel. |callback| will be called with the message
   // and |user_data| any time a message arrives on that channel.
   //
+  // If |task_queue| is not null, |callback| is called on that queue instead of
+  // the platform thread.
+  //
   // Replaces any existing callback. Pass a null callback to unregister the
-  // existing callback.
+  // existing callback. If the existing callback was bound to a task queue, this
+  // waits for it to return if it is running, so its user data can be freed
+  // once this returns.
   void SetMessageCallback(const std::string& channel,
                           FlutterDesktopMessageCallback callback,
-                          void* user_data);
+                          void* user_data,
+                          TaskQueue* task_queue = nullptr);
+
+  // Creates a task queue that channel handlers can be bound to. The queue is
+  // owned by this object. Must be called on the platform thread.
+  TaskQueue* CreateTaskQueue();
+
+  // Handles the messages pending on the task queues and stops their threads.
+  // Messages for channels bound to task queues are no longer handled after.
+  //
+  // This must be called before the engine shuts down, so that the handlers
+  // can still respond to their messages.
+  void StopTaskQueues();
 
   // Enables input blocking on the given channel name.
   //
@@ -59,14 +86,30 @@ class IncomingMessageDispatcher {
   void EnableInputBlockingForChannel(const std::string& channel);
 
  private:
+  struct CallbackInfo {
+    FlutterDesktopMessageCallback callback;
+    void* user_data;
+    TaskQueue* task_queue;
+  };
+
+  // Calls the handler of |channel| with |message| on |task_queue|, provided
+  // that it is still bound to that queue.
+  void HandleMessageOnTaskQueue(const std::string& channel,
+                                const FlutterDesktopMessage& message,
+                                TaskQueue* task_queue);
+
   // Handle for interacting with the C messaging API.
   FlutterDesktopMessengerRef messenger_;
 
+  // Guards |callbacks_|, which is read from the task queues.
+  std::mutex callbacks_mutex_;
+
   // A map from channel names to the FlutterDesktopMessageCallback that should
   // be called for incoming messages on that channel, along with the void* user
-  // data to pass to it.
-  std::map<std::string, std::pair<FlutterDesktopMessageCallback, void*>>
-      callbacks_;
+  // data to pass to it and the task queue to call it on, if any.
+  std::map<std::string, CallbackInfo> callbacks_;
+
+  std::vector<std::unique_ptr<TaskQueue>> task_queues_;
 
   // Channel names for which input blocking should be enabled during the call to
   // that channel's handler.
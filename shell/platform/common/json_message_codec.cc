@@ -8,8 +8,6 @@
 #include <string>
 
 #include "rapidjson/error/en.h"
-#include "rapidjson/stringbuffer.h"
-#include "rapidjson/writer.h"
 
 namespace flutter {
 
@@ -19,15 +17,26 @@ const JsonMessageCodec& JsonMessageCodec::GetInstance() {
   return sInstance;
 }
 
+// static
+std::unique_ptr<std::vector<uint8_t>> JsonMessageCodec::EncodeMessageWithWriter(
+    const std::function<void(JsonMessageWriter& writer)>& write) {
+  auto buffer = std::make_unique<std::vector<uint8_t>>();
+  JsonByteBufferStream stream(buffer.get());
+  JsonMessageWriter writer(stream);
+  write(writer);
+  return buffer;
+}
+
+// static
+void JsonMessageCodec::LogParseError(const rapidjson::ParseResult& result) {
+  std::cerr << "Unable to parse JSON message:" << std::endl
+            << rapidjson::GetParseError_En(result.Code()) << std::endl;
+}
+
 std::unique_ptr<std::vector<uint8_t>> JsonMessageCodec::EncodeMessageInternal(
     const rapidjson::Document& message) const {
-  // TODO: Look into alternate writers that would avoid the buffer copy.
-  rapidjson::StringBuffer buffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-  message.Accept(writer);
-  const char* buffer_start = buffer.GetString();
-  return std::make_unique<std::vector<uint8_t>>(
-      buffer_start, buffer_start + buffer.GetSize());
+  return EncodeMessageWithWriter(
+      [&message](JsonMessageWriter& writer) { message.Accept(writer); });
 }
 
 std::unique_ptr<rapidjson::Document> JsonMessageCodec::DecodeMessageInternal(
@@ -40,8 +49,7 @@ std::unique_ptr<rapidjson::Document> JsonMessageCodec::DecodeMessageInternal(
   bool parsing_successful =
       result == rapidjson::ParseErrorCode::kParseErrorNone;
   if (!parsing_successful) {
-    std::cerr << "Unable to parse JSON message:" << std::endl
-              << rapidjson::GetParseError_En(result.Code()) << std::endl;
+    LogParseError(result);
     return nullptr;
   }
   return json_message;
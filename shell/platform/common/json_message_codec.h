@@ -6,11 +6,37 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_JSON_MESSAGE_CODEC_H_
 
 #include <rapidjson/document.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/writer.h>
+
+#include <functional>
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/message_codec.h"
 
 namespace flutter {
 
+// A rapidjson output stream that appends to a byte buffer, so that a message
+// can be serialized directly into the buffer sent to the engine.
+class JsonByteBufferStream {
+ public:
+  typedef char Ch;
+
+  // Creates a stream writing to |buffer|, which must outlive this object.
+  explicit JsonByteBufferStream(std::vector<uint8_t>* buffer)
+      : buffer_(buffer) {}
+
+  void Put(Ch c) { buffer_->push_back(static_cast<uint8_t>(c)); }
+
+  void Flush() {}
+
+ private:
+  std::vector<uint8_t>* buffer_;
+};
+
+// A rapidjson writer that serializes straight into a message buffer.
+typedef rapidjson::Writer<JsonByteBufferStream> JsonMessageWriter;
+
 // A message encoding/decoding mechanism for communications to/from the
 // Flutter engine via JSON channels.
 class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
@@ -24,6 +50,32 @@ class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
   JsonMessageCodec(JsonMessageCodec const&) = delete;
   JsonMessageCodec& operator=(JsonMessageCodec const&) = delete;
 
+  // Parses |binary_message| by streaming its events to a rapidjson SAX
+  // |handler|, without building a document first. This allows large messages,
+  // such as long arrays, to be processed incrementally.
+  //
+  // Returns false if the message is not valid JSON, or if |handler| stopped
+  // the parse by returning false from one of its events.
+  template <typename Handler>
+  static bool DecodeMessageWithHandler(const uint8_t* binary_message,
+                                       const size_t message_size,
+                                       Handler& handler) {
+    rapidjson::MemoryStream stream(
+        reinterpret_cast<const char*>(binary_message), message_size);
+    rapidjson::Reader reader;
+    rapidjson::ParseResult result = reader.Parse(stream, handler);
+    if (result.IsError()) {
+      LogParseError(result);
+      return false;
+    }
+    return true;
+  }
+
+  // Encodes a message by calling |write| with a writer that serializes into
+  // the returned buffer, without building a document first.
+  static std::unique_ptr<std::vector<uint8_t>> EncodeMessageWithWriter(
+      const std::function<void(JsonMessageWriter& writer)>& write);
+
  protected:
   // Instances should be obtained via GetInstance.
   JsonMessageCodec() = default;
@@ -36,6 +88,10 @@ class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
   // |flutter::MessageCodec|
   std::unique_ptr<std::vector<uint8_t>> EncodeMessageInternal(
       const rapidjson::Document& message) const override;
+
+ private:
+  // Logs the error of a failed parse.
+  static void LogParseError(const rapidjson::ParseResult& result);
 };
 
 }  // namespace flutter
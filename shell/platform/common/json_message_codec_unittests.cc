@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -14,6 +15,29 @@ namespace flutter {
 
 namespace {
 
+// A SAX handler that sums the integers of a message, and counts its arrays.
+class SumHandler
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, SumHandler> {
+ public:
+  bool Default() { return false; }
+  bool Int(int i) {
+    sum += i;
+    return true;
+  }
+  bool Uint(unsigned i) {
+    sum += i;
+    return true;
+  }
+  bool StartArray() {
+    ++arrays;
+    return true;
+  }
+  bool EndArray(rapidjson::SizeType element_count) { return true; }
+
+  int64_t sum = 0;
+  int arrays = 0;
+};
+
 // Validates round-trip encoding and decoding of |value|.
 static void CheckEncodeDecode(const rapidjson::Document& value) {
   const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
@@ -43,4 +67,40 @@ TEST(JsonMessageCodec, EncodeDecode) {
   CheckEncodeDecode(array);
 }
 
+// Tests that a message can be decoded by streaming it to a SAX handler.
+TEST(JsonMessageCodec, DecodeWithHandler) {
+  std::string json = "[1, 2, [3, -4], 5]";
+  SumHandler handler;
+  EXPECT_TRUE(JsonMessageCodec::DecodeMessageWithHandler(
+      reinterpret_cast<const uint8_t*>(json.data()), json.size(), handler));
+  EXPECT_EQ(handler.sum, 7);
+  EXPECT_EQ(handler.arrays, 2);
+}
+
+// Tests that decoding fails when the handler rejects an event.
+TEST(JsonMessageCodec, DecodeWithHandlerStops) {
+  std::string json = "[1, \"two\", 3]";
+  SumHandler handler;
+  EXPECT_FALSE(JsonMessageCodec::DecodeMessageWithHandler(
+      reinterpret_cast<const uint8_t*>(json.data()), json.size(), handler));
+  EXPECT_EQ(handler.sum, 1);
+}
+
+// Tests that a message written with the streaming writer decodes correctly.
+TEST(JsonMessageCodec, EncodeWithWriter) {
+  auto encoded =
+      JsonMessageCodec::EncodeMessageWithWriter([](JsonMessageWriter& writer) {
+        writer.StartObject();
+        writer.Key("a");
+        writer.StartArray();
+        writer.Int(1);
+        writer.String("b");
+        writer.EndArray();
+        writer.EndObject();
+      });
+  ASSERT_TRUE(encoded);
+  EXPECT_EQ(std::string(encoded->begin(), encoded->end()),
+            "{\"a\":[1,\"b\"]}");
+}
+
 }  // namespace flutter
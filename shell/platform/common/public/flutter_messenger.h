@@ -17,6 +17,10 @@ extern "C" {
 // Opaque reference to a Flutter engine messenger.
 typedef struct FlutterDesktopMessenger* FlutterDesktopMessengerRef;
 
+// Opaque reference to a queue on which message callbacks run on a background
+// thread.
+typedef struct FlutterDesktopTaskQueue* FlutterDesktopTaskQueueRef;
+
 // Opaque handle for tracking responses to messages.
 typedef struct _FlutterPlatformMessageResponseHandle
     FlutterDesktopMessageResponseHandle;
@@ -67,6 +71,8 @@ FLUTTER_EXPORT bool FlutterDesktopMessengerSendWithReply(
 
 // Sends a reply to a FlutterDesktopMessage for the given response handle.
 //
+// This may be called from any thread, as long as the engine is running.
+//
 // Once this has been called, |handle| is invalid and must not be used again.
 FLUTTER_EXPORT void FlutterDesktopMessengerSendResponse(
     FlutterDesktopMessengerRef messenger,
@@ -87,6 +93,31 @@ FLUTTER_EXPORT void FlutterDesktopMessengerSetCallback(
     FlutterDesktopMessageCallback callback,
     void* user_data);
 
+// Creates a queue with its own background thread, on which the callbacks of
+// the channels registered with FlutterDesktopMessengerSetCallbackOnTaskQueue
+// run in the order of their messages. This keeps slow callbacks, such as ones
+// doing disk or database I/O, from blocking the platform thread.
+//
+// The queue is owned by the messenger and is valid until the engine is
+// destroyed. Messages still pending on the queue when the engine shuts down
+// are handled before the engine goes away.
+FLUTTER_EXPORT FlutterDesktopTaskQueueRef
+FlutterDesktopMessengerCreateTaskQueue(FlutterDesktopMessengerRef messenger);
+
+// Registers a callback function for incoming binary messages from the Flutter
+// side on the specified channel, like FlutterDesktopMessengerSetCallback, but
+// which is called on |task_queue| instead of the platform thread.
+//
+// Once the callback of the channel is replaced or unregistered, it is no longer
+// called, and this does not return while the previous callback is running, so
+// the previous |user_data| can be freed right after.
+FLUTTER_EXPORT void FlutterDesktopMessengerSetCallbackOnTaskQueue(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageCallback callback,
+    void* user_data,
+    FlutterDesktopTaskQueueRef task_queue);
+
 #if defined(__cplusplus)
 }  // extern "C"
 #endif
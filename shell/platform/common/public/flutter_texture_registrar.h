@@ -23,9 +23,22 @@ typedef struct FlutterDesktopTextureRegistrar*
 // Additional types may be added in the future.
 typedef enum {
   // A Pixel buffer-based texture.
-  kFlutterDesktopPixelBufferTexture
+  kFlutterDesktopPixelBufferTexture,
+  // A platform-specific GPU surface-backed texture.
+  kFlutterDesktopGpuSurfaceTexture
 } FlutterDesktopTextureType;
 
+// Supported GPU surface types.
+typedef enum {
+  // Uninitialized.
+  kFlutterDesktopGpuSurfaceTypeNone,
+  // A DXGI shared texture handle (Windows only), as returned by
+  // |IDXGIResource::GetSharedHandle|.
+  kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle,
+  // A |ID3D11Texture2D| (Windows only).
+  kFlutterDesktopGpuSurfaceTypeD3d11Texture2D
+} FlutterDesktopGpuSurfaceType;
+
 // An image buffer object.
 typedef struct {
   // The pixel data buffer.
@@ -58,10 +71,71 @@ typedef struct {
   void* user_data;
 } FlutterDesktopPixelBufferTextureConfig;
 
+// A GPU surface descriptor.
+typedef struct {
+  // The size of this struct. Must be
+  // sizeof(FlutterDesktopGpuSurfaceDescriptor).
+  size_t struct_size;
+  // The surface handle. The expected type depends on the
+  // |FlutterDesktopGpuSurfaceType|.
+  //
+  // Provide a |ID3D11Texture2D*| when using
+  // |kFlutterDesktopGpuSurfaceTypeD3d11Texture2D| or a |HANDLE| when using
+  // |kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle|. Textures must have been
+  // created on the same device as the renderer of Flutter, so use a shared
+  // handle for textures of other devices.
+  //
+  // The referenced resource needs to stay valid until it has been opened by
+  // Flutter. Consider incrementing the resource's reference count in the
+  // |FlutterDesktopGpuSurfaceTextureCallback| and registering a
+  // |release_callback| for decrementing the reference count once it has been
+  // opened.
+  //
+  // Surfaces that were created with a keyed mutex are acquired with key 0 for
+  // as long as Flutter samples them, and released with key 0 afterwards. The
+  // producer must release them with key 0 once a frame was written.
+  void* handle;
+  // The physical width.
+  size_t width;
+  // The physical height.
+  size_t height;
+  // An optional callback that gets invoked when the |handle| has been opened
+  // and the surface can be reused by the producer.
+  void (*release_callback)(void* release_context);
+  // Opaque data passed to |release_callback|.
+  void* release_context;
+} FlutterDesktopGpuSurfaceDescriptor;
+
+// The GPU surface callback definition provided to the Flutter engine to
+// obtain the surface. It is invoked with the intended surface size specified
+// by |width| and |height| and the |user_data| held by
+// FlutterDesktopGpuSurfaceTextureConfig.
+//
+// As this is usually called from the render thread, the callee must take
+// care of proper synchronization.
+typedef const FlutterDesktopGpuSurfaceDescriptor* (
+    *FlutterDesktopGpuSurfaceTextureCallback)(size_t width,
+                                              size_t height,
+                                              void* user_data);
+
+// An object used to configure GPU-surface textures.
+typedef struct {
+  // The size of this struct. Must be
+  // sizeof(FlutterDesktopGpuSurfaceTextureConfig).
+  size_t struct_size;
+  // The type of the GPU surface.
+  FlutterDesktopGpuSurfaceType type;
+  // The callback used by the engine to obtain the surface descriptor.
+  FlutterDesktopGpuSurfaceTextureCallback callback;
+  // Opaque data that will get passed to the provided |callback|.
+  void* user_data;
+} FlutterDesktopGpuSurfaceTextureConfig;
+
 typedef struct {
   FlutterDesktopTextureType type;
   union {
     FlutterDesktopPixelBufferTextureConfig pixel_buffer_config;
+    FlutterDesktopGpuSurfaceTextureConfig gpu_surface_config;
   };
 } FlutterDesktopTextureInfo;
 
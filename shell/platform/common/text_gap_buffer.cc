@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_gap_buffer.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+namespace {
+
+// The minimum number of code units added to the gap when it fills up.
+constexpr size_t kMinGapGrowth = 64;
+
+}  // namespace
+
+TextGapBuffer::TextGapBuffer() = default;
+
+TextGapBuffer::TextGapBuffer(const std::u16string& text) {
+  Assign(text);
+}
+
+TextGapBuffer::~TextGapBuffer() = default;
+
+void TextGapBuffer::Assign(const std::u16string& text) {
+  buffer_ = text;
+  gap_start_ = gap_end_ = buffer_.length();
+}
+
+void TextGapBuffer::Replace(size_t position,
+                            size_t count,
+                            const std::u16string& text) {
+  FML_DCHECK(position + count <= length());
+  MoveGap(position);
+  // Deleted text becomes part of the gap.
+  gap_end_ += count;
+  if (text.length() > gap_length()) {
+    GrowGap(text.length());
+  }
+  std::copy(text.begin(), text.end(), buffer_.begin() + gap_start_);
+  gap_start_ += text.length();
+}
+
+std::u16string TextGapBuffer::Substring(size_t position, size_t count) const {
+  size_t end = std::min(position + count, length());
+  if (position >= end) {
+    return std::u16string();
+  }
+  std::u16string result;
+  result.reserve(end - position);
+  if (position < gap_start_) {
+    result.append(buffer_, position, std::min(end, gap_start_) - position);
+  }
+  if (end > gap_start_) {
+    size_t start = std::max(position, gap_start_);
+    result.append(buffer_, start + gap_length(), end - start);
+  }
+  return result;
+}
+
+size_t TextGapBuffer::Utf8Length(size_t count) const {
+  FML_DCHECK(count <= length());
+  size_t utf8_length = 0;
+  for (size_t i = 0; i < count; i++) {
+    char16_t code_unit = at(i);
+    if (code_unit < 0x80) {
+      utf8_length += 1;
+    } else if (code_unit < 0x800) {
+      utf8_length += 2;
+    } else if ((code_unit & 0xFC00) == 0xD800 && i + 1 < count &&
+               (at(i + 1) & 0xFC00) == 0xDC00) {
+      // A surrogate pair encodes a single four-byte code point.
+      utf8_length += 4;
+      i++;
+    } else {
+      utf8_length += 3;
+    }
+  }
+  return utf8_length;
+}
+
+void TextGapBuffer::MoveGap(size_t position) {
+  FML_DCHECK(position <= length());
+  if (position < gap_start_) {
+    // Shift the text between |position| and the gap to after the gap.
+    size_t count = gap_start_ - position;
+    std::copy_backward(buffer_.begin() + position,
+                       buffer_.begin() + gap_start_,
+                       buffer_.begin() + gap_end_);
+    gap_start_ -= count;
+    gap_end_ -= count;
+  } else if (position > gap_start_) {
+    // Shift the text between the gap and |position| to before the gap.
+    size_t count = position - gap_start_;
+    std::copy(buffer_.begin() + gap_end_, buffer_.begin() + gap_end_ + count,
+              buffer_.begin() + gap_start_);
+    gap_start_ += count;
+    gap_end_ += count;
+  }
+}
+
+void TextGapBuffer::GrowGap(size_t min_length) {
+  // Grow proportionally to the text, so that appending is amortized O(1).
+  size_t growth = std::max({min_length - gap_length(), kMinGapGrowth,
+                            buffer_.length() / 2});
+  buffer_.insert(gap_end_, growth, u'\0');
+  gap_end_ += growth;
+}
+
+}  // namespace flutter
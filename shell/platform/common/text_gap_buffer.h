@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_TEXT_GAP_BUFFER_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_TEXT_GAP_BUFFER_H_
+
+#include <string>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+// UTF-16 text stored with a gap at the last edit position.
+//
+// Edits move the gap to their position and then grow or shrink it, so that
+// successive edits near the same position, such as typing or deleting
+// characters at the cursor, cost time proportional to the distance from the
+// previous edit rather than to the length of the text.
+class TextGapBuffer {
+ public:
+  TextGapBuffer();
+  explicit TextGapBuffer(const std::u16string& text);
+  virtual ~TextGapBuffer();
+
+  TextGapBuffer(const TextGapBuffer&) = default;
+  TextGapBuffer& operator=(const TextGapBuffer&) = default;
+
+  // The number of UTF-16 code units in the text.
+  size_t length() const { return buffer_.length() - gap_length(); }
+
+  // Whether the text is empty.
+  bool empty() const { return length() == 0; }
+
+  // Returns the code unit at |position|, which must be less than |length()|.
+  char16_t at(size_t position) const {
+    FML_DCHECK(position < length());
+    return position < gap_start_ ? buffer_[position]
+                                 : buffer_[position + gap_length()];
+  }
+
+  // Replaces the text.
+  void Assign(const std::u16string& text);
+
+  // Replaces the |count| code units at |position| with |text|.
+  //
+  // |position| and |position| + |count| must not exceed |length()|.
+  void Replace(size_t position, size_t count, const std::u16string& text);
+
+  // Inserts |text| at |position|.
+  void Insert(size_t position, const std::u16string& text) {
+    Replace(position, 0, text);
+  }
+
+  // Erases the |count| code units at |position|.
+  void Erase(size_t position, size_t count) {
+    Replace(position, count, std::u16string());
+  }
+
+  // Returns up to |count| code units starting at |position|.
+  std::u16string Substring(size_t position, size_t count) const;
+
+  // Returns the whole text.
+  std::u16string ToString() const { return Substring(0, length()); }
+
+  // Returns the number of bytes needed to encode the first |count| code units
+  // as UTF-8, without converting them.
+  size_t Utf8Length(size_t count) const;
+
+ private:
+  size_t gap_length() const { return gap_end_ - gap_start_; }
+
+  // Moves the gap so that it starts at |position|.
+  void MoveGap(size_t position);
+
+  // Grows the gap so that it holds at least |min_length| code units.
+  void GrowGap(size_t min_length);
+
+  // The text before the gap, the gap, then the text after it.
+  std::u16string buffer_;
+  size_t gap_start_ = 0;
+  size_t gap_end_ = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_TEXT_GAP_BUFFER_H_
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_gap_buffer.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+TEST(TextGapBuffer, EmptyBuffer) {
+  TextGapBuffer buffer;
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.length(), size_t(0));
+  EXPECT_EQ(buffer.ToString(), u"");
+}
+
+TEST(TextGapBuffer, AssignText) {
+  TextGapBuffer buffer(u"ABCDE");
+  EXPECT_EQ(buffer.length(), size_t(5));
+  EXPECT_EQ(buffer.at(0), u'A');
+  EXPECT_EQ(buffer.at(4), u'E');
+  buffer.Assign(u"XY");
+  EXPECT_EQ(buffer.ToString(), u"XY");
+}
+
+TEST(TextGapBuffer, InsertAtPositions) {
+  TextGapBuffer buffer(u"ACE");
+  buffer.Insert(1, u"B");
+  buffer.Insert(3, u"D");
+  buffer.Insert(0, u"_");
+  buffer.Insert(6, u"F");
+  EXPECT_EQ(buffer.ToString(), u"_ABCDEF");
+  EXPECT_EQ(buffer.length(), size_t(7));
+}
+
+TEST(TextGapBuffer, EraseAtPositions) {
+  TextGapBuffer buffer(u"ABCDEFG");
+  buffer.Erase(5, 2);
+  buffer.Erase(0, 1);
+  buffer.Erase(1, 2);
+  EXPECT_EQ(buffer.ToString(), u"BE");
+}
+
+TEST(TextGapBuffer, ReplaceRange) {
+  TextGapBuffer buffer(u"ABCDE");
+  buffer.Replace(1, 3, u"xyzzy");
+  EXPECT_EQ(buffer.ToString(), u"AxyzzyE");
+  buffer.Replace(6, 1, u"");
+  EXPECT_EQ(buffer.ToString(), u"Axyzzy");
+}
+
+TEST(TextGapBuffer, RepeatedTypingGrowsBuffer) {
+  TextGapBuffer buffer(u"[]");
+  std::u16string expected = u"[";
+  for (int i = 0; i < 1000; i++) {
+    char16_t c = static_cast<char16_t>(u'a' + i % 26);
+    buffer.Insert(i + 1, std::u16string(1, c));
+    expected.push_back(c);
+  }
+  expected.push_back(u']');
+  EXPECT_EQ(buffer.ToString(), expected);
+}
+
+TEST(TextGapBuffer, SubstringAcrossGap) {
+  TextGapBuffer buffer(u"ABCDEF");
+  // Moves the gap to position 3.
+  buffer.Insert(3, u"");
+  buffer.Erase(3, 0);
+  buffer.Insert(3, u"-");
+  EXPECT_EQ(buffer.Substring(1, 5), u"BC-DE");
+  EXPECT_EQ(buffer.Substring(0, 3), u"ABC");
+  EXPECT_EQ(buffer.Substring(4, 100), u"DEF");
+  EXPECT_EQ(buffer.Substring(7, 1), u"");
+}
+
+TEST(TextGapBuffer, Utf8Length) {
+  // One, two, three and four (surrogate pair) byte characters.
+  TextGapBuffer buffer(u"aé☃\U0001F604");
+  EXPECT_EQ(buffer.Utf8Length(0), size_t(0));
+  EXPECT_EQ(buffer.Utf8Length(1), size_t(1));
+  EXPECT_EQ(buffer.Utf8Length(2), size_t(3));
+  EXPECT_EQ(buffer.Utf8Length(3), size_t(6));
+  EXPECT_EQ(buffer.Utf8Length(5), size_t(10));
+}
+
+}  // namespace flutter
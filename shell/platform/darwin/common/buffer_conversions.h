@@ -19,6 +19,11 @@ NSData* GetNSDataFromVector(const std::vector<uint8_t>& buffer);
 
 std::unique_ptr<fml::Mapping> GetMappingFromNSData(NSData* data);
 
+fml::MallocMapping CopyNSDataToMapping(NSData* data);
+
+// Wraps the buffer without copying it. The NSData frees it once collected.
+NSData* ConvertMappingToNSData(fml::MallocMapping buffer);
+
 NSData* GetNSDataFromMapping(std::unique_ptr<fml::Mapping> mapping);
 
 }  // namespace flutter
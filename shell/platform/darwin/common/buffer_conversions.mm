@@ -19,6 +19,16 @@ std::unique_ptr<fml::Mapping> GetMappingFromNSData(NSData* data) {
   return std::make_unique<fml::DataMapping>(GetVectorFromNSData(data));
 }
 
+fml::MallocMapping CopyNSDataToMapping(NSData* data) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data.bytes);
+  return fml::MallocMapping::Copy(bytes, data.length);
+}
+
+NSData* ConvertMappingToNSData(fml::MallocMapping buffer) {
+  size_t size = buffer.GetSize();
+  return [NSData dataWithBytesNoCopy:buffer.Release() length:size freeWhenDone:YES];
+}
+
 NSData* GetNSDataFromMapping(std::unique_ptr<fml::Mapping> mapping) {
   return [NSData dataWithBytes:mapping->GetMapping() length:mapping->GetSize()];
 }
@@ -71,6 +71,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property(nonatomic, readonly) CVMetalTextureCacheRef textureCache;
 
+/**
+ * Stores the binary archive that the Metal pipelines built by `mainContext` and `resourceContext`
+ * are added to with the persistent cache, so that later runs load the pipelines instead of
+ * compiling them again. This happens when the application moves to the background or terminates,
+ * and when this context is deallocated. Binary archives require iOS 14 or macOS 11.
+ */
+- (void)storeBinaryArchive;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -4,10 +4,19 @@
 
 #import "flutter/shell/platform/darwin/graphics/FlutterDarwinContextMetal.h"
 
+#if TARGET_OS_IPHONE
+#import <UIKit/UIKit.h>
+#else
+#import <AppKit/AppKit.h>
+#endif
+
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterMacros.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
+#include "third_party/skia/include/gpu/mtl/GrMtlBackendContext.h"
 
 FLUTTER_ASSERT_ARC
 
@@ -21,7 +30,57 @@ static GrContextOptions CreateMetalGrContextOptions() {
   return options;
 }
 
-@implementation FlutterDarwinContextMetal
+// A new file for a binary archive to be loaded from or serialized to. Binary archives can only be
+// read from and written to files, while the persistent cache deals in mappings.
+static NSURL* CreateTemporaryBinaryArchiveURL() {
+  NSString* name = [NSString stringWithFormat:@"%s.%@",
+                                              flutter::PersistentCache::kMetalBinaryArchiveFileName,
+                                              [NSUUID UUID].UUIDString];
+  return [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:name]];
+}
+
+// Creates the binary archive Skia adds the pipelines it builds to and looks them up in, starting
+// with the pipelines of previous runs or the ones packaged with the application. |url| is set to
+// the file the archive was loaded from, which must be kept while the archive is in use.
+static id<MTLBinaryArchive> CreateBinaryArchive(id<MTLDevice> device, NSURL** url)
+    API_AVAILABLE(ios(14.0), macos(11.0)) {
+  TRACE_EVENT0("flutter", "CreateMetalBinaryArchive");
+  MTLBinaryArchiveDescriptor* descriptor = [[MTLBinaryArchiveDescriptor alloc] init];
+  std::unique_ptr<fml::Mapping> mapping =
+      flutter::PersistentCache::GetCacheForProcess()->LoadMetalBinaryArchive();
+  if (mapping) {
+    NSData* data = [NSData dataWithBytesNoCopy:const_cast<uint8_t*>(mapping->GetMapping())
+                                        length:mapping->GetSize()
+                                  freeWhenDone:NO];
+    NSURL* archive_url = CreateTemporaryBinaryArchiveURL();
+    if ([data writeToURL:archive_url atomically:NO]) {
+      descriptor.url = archive_url;
+      *url = archive_url;
+    }
+  }
+
+  NSError* error = nil;
+  id<MTLBinaryArchive> archive = [device newBinaryArchiveWithDescriptor:descriptor error:&error];
+  if (!archive && descriptor.url) {
+    // The archive may have been built for another GPU or OS version. Start over with an empty one.
+    FML_LOG(WARNING) << "Could not load the Metal binary archive: "
+                     << error.localizedDescription.UTF8String;
+    descriptor.url = nil;
+    archive = [device newBinaryArchiveWithDescriptor:descriptor error:&error];
+  }
+  if (!archive) {
+    FML_LOG(ERROR) << "Could not create a Metal binary archive: "
+                   << error.localizedDescription.UTF8String;
+  }
+  return archive;
+}
+
+@implementation FlutterDarwinContextMetal {
+  // The id<MTLBinaryArchive>, typed id as binary archives require iOS 14 or macOS 11.
+  id _binaryArchive;
+  NSURL* _binaryArchiveURL;
+  id _storeBinaryArchiveObserver;
+}
 
 - (instancetype)initWithDefaultMTLDevice {
   id<MTLDevice> device = MTLCreateSystemDefaultDevice();
@@ -48,6 +107,12 @@ static GrContextOptions CreateMetalGrContextOptions() {
 
     [_commandQueue setLabel:@"Flutter Main Queue"];
 
+    if (@available(iOS 14.0, macOS 11.0, *)) {
+      NSURL* url = nil;
+      _binaryArchive = CreateBinaryArchive(_device, &url);
+      _binaryArchiveURL = url;
+    }
+
     CVReturn cvReturn = CVMetalTextureCacheCreate(kCFAllocatorDefault,  // allocator
                                                   nil,      // cache attributes (nil default)
                                                   _device,  // metal device
@@ -71,15 +136,61 @@ static GrContextOptions CreateMetalGrContextOptions() {
     }
 
     _resourceContext->setResourceCacheLimits(0u, 0u);
+
+    if (_binaryArchive) {
+      __weak FlutterDarwinContextMetal* weakSelf = self;
+#if TARGET_OS_IPHONE
+      NSNotificationName name = UIApplicationDidEnterBackgroundNotification;
+#else
+      NSNotificationName name = NSApplicationWillTerminateNotification;
+#endif
+      _storeBinaryArchiveObserver =
+          [[NSNotificationCenter defaultCenter] addObserverForName:name
+                                                            object:nil
+                                                             queue:nil
+                                                        usingBlock:^(NSNotification* note) {
+                                                          [weakSelf storeBinaryArchive];
+                                                        }];
+    }
   }
   return self;
 }
 
 - (sk_sp<GrDirectContext>)createGrContext {
-  auto contextOptions = CreateMetalGrContextOptions();
   id<MTLDevice> device = _device;
   id<MTLCommandQueue> commandQueue = _commandQueue;
-  return [FlutterDarwinContextMetal createGrContext:device commandQueue:commandQueue];
+  if (!_binaryArchive) {
+    return [FlutterDarwinContextMetal createGrContext:device commandQueue:commandQueue];
+  }
+  auto contextOptions = CreateMetalGrContextOptions();
+  GrMtlBackendContext backendContext = {};
+  backendContext.fDevice.retain((__bridge GrMTLHandle)device);
+  backendContext.fQueue.retain((__bridge GrMTLHandle)commandQueue);
+  backendContext.fBinaryArchive.retain((__bridge GrMTLHandle)_binaryArchive);
+  return GrDirectContext::MakeMetal(backendContext, contextOptions);
+}
+
+- (void)storeBinaryArchive {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    id<MTLBinaryArchive> archive = _binaryArchive;
+    if (!archive || flutter::PersistentCache::gIsReadOnly) {
+      return;
+    }
+    TRACE_EVENT0("flutter", "FlutterDarwinContextMetal::storeBinaryArchive");
+    NSURL* url = CreateTemporaryBinaryArchiveURL();
+    NSError* error = nil;
+    if (![archive serializeToURL:url error:&error]) {
+      FML_LOG(ERROR) << "Could not serialize the Metal binary archive: "
+                     << error.localizedDescription.UTF8String;
+      return;
+    }
+    NSData* data = [NSData dataWithContentsOfURL:url];
+    if (data) {
+      fml::NonOwnedMapping mapping(static_cast<const uint8_t*>(data.bytes), data.length);
+      flutter::PersistentCache::GetCacheForProcess()->StoreMetalBinaryArchive(mapping);
+    }
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+  }
 }
 
 + (sk_sp<GrDirectContext>)createGrContext:(id<MTLDevice>)device
@@ -92,6 +203,13 @@ static GrContextOptions CreateMetalGrContextOptions() {
 }
 
 - (void)dealloc {
+  if (_storeBinaryArchiveObserver) {
+    [[NSNotificationCenter defaultCenter] removeObserver:_storeBinaryArchiveObserver];
+  }
+  [self storeBinaryArchive];
+  if (_binaryArchiveURL) {
+    [[NSFileManager defaultManager] removeItemAtURL:_binaryArchiveURL error:nil];
+  }
   if (_textureCache) {
     CFRelease(_textureCache);
   }
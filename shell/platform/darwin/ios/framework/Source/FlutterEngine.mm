@@ -283,7 +283,7 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
                                                       }];
   } else {
     self.flutterViewControllerWillDeallocObserver = nil;
-    [self notifyLowMemory];
+    [self notifyMemoryPressure:flutter::MemoryPressureLevel::kBackground];
   }
 }
 
@@ -594,7 +594,8 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
       [self](flutter::Shell& shell) {
         [self recreatePlatformViewController];
         return std::make_unique<flutter::PlatformViewIOS>(
-            shell, self->_renderingApi, self->_platformViewsController, shell.GetTaskRunners());
+            shell, self->_renderingApi, self->_platformViewsController, shell.GetTaskRunners(),
+            flutter::IOSSurfaceOptions::FromSettings(shell.GetSettings()));
       };
 
   flutter::Shell::CreateCallback<flutter::Rasterizer> on_create_rasterizer =
@@ -669,8 +670,12 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
 }
 
 - (void)notifyLowMemory {
+  [self notifyMemoryPressure:flutter::MemoryPressureLevel::kCritical];
+}
+
+- (void)notifyMemoryPressure:(flutter::MemoryPressureLevel)level {
   if (_shell) {
-    _shell->NotifyLowMemoryWarning();
+    _shell->NotifyMemoryPressure(level);
   }
   [_systemChannel sendMessage:@{@"type" : @"memoryPressure"}];
 }
@@ -807,7 +812,7 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
   fml::RefPtr<flutter::PlatformMessage> platformMessage =
       (message == nil) ? fml::MakeRefCounted<flutter::PlatformMessage>(channel.UTF8String, response)
                        : fml::MakeRefCounted<flutter::PlatformMessage>(
-                             channel.UTF8String, flutter::GetVectorFromNSData(message), response);
+                             channel.UTF8String, flutter::CopyNSDataToMapping(message), response);
 
   _shell->GetPlatformView()->DispatchPlatformMessage(platformMessage);
 }
@@ -890,7 +895,7 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
 
 - (void)applicationDidEnterBackground:(NSNotification*)notification {
   [self setIsGpuDisabled:YES];
-  [self notifyLowMemory];
+  [self notifyMemoryPressure:flutter::MemoryPressureLevel::kBackground];
 }
 
 - (void)onMemoryWarning:(NSNotification*)notification {
@@ -987,7 +992,8 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
       [result, context](flutter::Shell& shell) {
         [result recreatePlatformViewController];
         return std::make_unique<flutter::PlatformViewIOS>(
-            shell, context, result->_platformViewsController, shell.GetTaskRunners());
+            shell, context, result->_platformViewsController, shell.GetTaskRunners(),
+            flutter::IOSSurfaceOptions::FromSettings(shell.GetSettings()));
       };
 
   flutter::Shell::CreateCallback<flutter::Rasterizer> on_create_rasterizer =
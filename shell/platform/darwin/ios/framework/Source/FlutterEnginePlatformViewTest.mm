@@ -23,6 +23,8 @@ class MockDelegate : public PlatformView::Delegate {
   void OnPlatformViewSetNextFrameCallback(const fml::closure& closure) override {}
   void OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) override {}
   void OnPlatformViewDispatchPlatformMessage(fml::RefPtr<PlatformMessage> message) override {}
+  void OnPlatformViewDispatchPlatformMessages(
+      std::vector<fml::RefPtr<PlatformMessage>> messages) override {}
   void OnPlatformViewDispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet) override {
   }
   void OnPlatformViewDispatchKeyDataPacket(std::unique_ptr<KeyDataPacket> packet,
@@ -81,11 +83,12 @@ class MockDelegate : public PlatformView::Delegate {
   XCTAssertNotNil(engine);
   id mockEngine = OCMPartialMock(engine);
   OCMStub([mockEngine notifyLowMemory]);
+  OCMStub([mockEngine notifyMemoryPressure:flutter::MemoryPressureLevel::kBackground]);
   OCMStub([mockEngine iosPlatformView]).andReturn(platform_view.get());
 
   [engine setViewController:nil];
-  OCMVerify([mockEngine notifyLowMemory]);
-  OCMReject([mockEngine notifyLowMemory]);
+  OCMVerify([mockEngine notifyMemoryPressure:flutter::MemoryPressureLevel::kBackground]);
+  OCMReject([mockEngine notifyMemoryPressure:flutter::MemoryPressureLevel::kBackground]);
 
   XCTNSNotificationExpectation* memoryExpectation = [[XCTNSNotificationExpectation alloc]
       initWithName:UIApplicationDidReceiveMemoryWarningNotification];
@@ -103,7 +106,7 @@ class MockDelegate : public PlatformView::Delegate {
                     object:nil];
   [self waitForExpectations:@[ backgroundExpectation ] timeout:5.0];
 
-  OCMVerify([mockEngine notifyLowMemory]);
+  OCMVerify([mockEngine notifyMemoryPressure:flutter::MemoryPressureLevel::kBackground]);
   [mockEngine stopMocking];
 }
 
@@ -50,6 +50,7 @@ extern NSString* const FlutterEngineWillDealloc;
        initialRoute:(NSString*)initialRoute;
 - (void)attachView;
 - (void)notifyLowMemory;
+- (void)notifyMemoryPressure:(flutter::MemoryPressureLevel)level;
 - (flutter::PlatformViewIOS*)iosPlatformView;
 
 - (void)waitForFirstFrame:(NSTimeInterval)timeout callback:(void (^)(BOOL didTimeout))callback;
@@ -329,10 +329,10 @@ std::vector<SkCanvas*> FlutterPlatformViewsController::GetCurrentCanvases() {
 }
 
 int FlutterPlatformViewsController::CountClips(const MutatorsStack& mutators_stack) {
-  std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator iter = mutators_stack.Bottom();
+  MutatorsStack::const_reverse_iterator iter = mutators_stack.Bottom();
   int clipCount = 0;
   while (iter != mutators_stack.Top()) {
-    if ((*iter)->IsClipType()) {
+    if (iter->IsClipType()) {
       clipCount++;
     }
     ++iter;
@@ -365,23 +365,23 @@ void FlutterPlatformViewsController::ApplyMutators(const MutatorsStack& mutators
 
   auto iter = mutators_stack.Begin();
   while (iter != mutators_stack.End()) {
-    switch ((*iter)->GetType()) {
+    switch (iter->GetType()) {
       case transform: {
-        CATransform3D transform = GetCATransform3DFromSkMatrix((*iter)->GetMatrix());
+        CATransform3D transform = GetCATransform3DFromSkMatrix(iter->GetMatrix());
         finalTransform = CATransform3DConcat(transform, finalTransform);
         break;
       }
       case clip_rect:
-        [maskView clipRect:(*iter)->GetRect() matrix:finalTransform];
+        [maskView clipRect:iter->GetRect() matrix:finalTransform];
         break;
       case clip_rrect:
-        [maskView clipRRect:(*iter)->GetRRect() matrix:finalTransform];
+        [maskView clipRRect:iter->GetRRect() matrix:finalTransform];
         break;
       case clip_path:
-        [maskView clipPath:(*iter)->GetPath() matrix:finalTransform];
+        [maskView clipPath:iter->GetPath() matrix:finalTransform];
         break;
       case opacity:
-        embedded_view.alpha = (*iter)->GetAlphaFloat() * embedded_view.alpha;
+        embedded_view.alpha = iter->GetAlphaFloat() * embedded_view.alpha;
         break;
     }
     ++iter;
@@ -683,7 +683,7 @@ static void sendFakeTouchEvent(FlutterEngine* engine,
     [self surfaceUpdated:NO];
     [[_engine.get() lifecycleChannel] sendMessage:@"AppLifecycleState.paused"];
     [self flushOngoingTouches];
-    [_engine.get() notifyLowMemory];
+    [_engine.get() notifyMemoryPressure:flutter::MemoryPressureLevel::kBackground];
   }
 
   [super viewDidDisappear:animated];
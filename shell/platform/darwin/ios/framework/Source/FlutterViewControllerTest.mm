@@ -9,6 +9,7 @@
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterMacros.h"
 #import "flutter/shell/platform/darwin/ios/framework/Headers/FlutterViewController.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterViewController_Internal.h"
+#include "flutter/shell/common/memory_pressure_level.h"
 
 FLUTTER_ASSERT_ARC
 
@@ -21,6 +22,7 @@ class PointerDataPacket {};
 @property(nonatomic, strong) FlutterBasicMessageChannel* lifecycleChannel;
 @property(nonatomic, weak) FlutterViewController* viewController;
 @property(nonatomic, assign) BOOL didCallNotifyLowMemory;
+@property(nonatomic, assign) BOOL didCallNotifyBackgroundMemoryPressure;
 @end
 
 @implementation FlutterEnginePartialMock
@@ -30,6 +32,12 @@ class PointerDataPacket {};
 - (void)notifyLowMemory {
   _didCallNotifyLowMemory = YES;
 }
+
+- (void)notifyMemoryPressure:(flutter::MemoryPressureLevel)level {
+  if (level == flutter::MemoryPressureLevel::kBackground) {
+    _didCallNotifyBackgroundMemoryPressure = YES;
+  }
+}
 @end
 
 @interface FlutterEngine ()
@@ -41,6 +49,7 @@ class PointerDataPacket {};
 
 @interface FlutterEngine (TestLowMemory)
 - (void)notifyLowMemory;
+- (void)notifyMemoryPressure:(flutter::MemoryPressureLevel)level;
 @end
 
 extern NSNotificationName const FlutterViewControllerWillDealloc;
@@ -559,7 +568,7 @@ typedef enum UIAccessibilityContrast : NSInteger {
   OCMStub([viewControllerMock surfaceUpdated:NO]);
   [viewController beginAppearanceTransition:NO animated:NO];
   [viewController endAppearanceTransition];
-  XCTAssertTrue(mockEngine.didCallNotifyLowMemory);
+  XCTAssertTrue(mockEngine.didCallNotifyBackgroundMemoryPressure);
   [viewControllerMock stopMocking];
 }
 
@@ -22,7 +22,7 @@ void PlatformMessageRouter::HandlePlatformMessage(
     FlutterBinaryMessageHandler handler = it->second;
     NSData* data = nil;
     if (message->hasData()) {
-      data = GetNSDataFromVector(message->data());
+      data = ConvertMappingToNSData(message->releaseData());
     }
     handler(data, ^(NSData* reply) {
       if (completer) {
@@ -32,6 +32,12 @@
 
 - (void)await;
 
+// Asks the display link to fire at a rate within the range on displays with
+// adaptive refresh rates, such as ProMotion displays. Frame rates above 60 Hz
+// on iPhones also need `CADisableMinimumFrameDurationOnPhone` in the
+// Info.plist of the application.
+- (void)setFrameRateRange:(const flutter::FrameRateRange&)range;
+
 - (void)invalidate;
 
 @end
@@ -50,6 +56,9 @@ class VsyncWaiterIOS final : public VsyncWaiter {
   // |VsyncWaiter|
   void AwaitVSync() override;
 
+  // |VsyncWaiter|
+  void SetFrameRateRange(const FrameRateRange& range) override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterIOS);
 };
 
@@ -36,6 +36,10 @@ void VsyncWaiterIOS::AwaitVSync() {
   [client_.get() await];
 }
 
+void VsyncWaiterIOS::SetFrameRateRange(const FrameRateRange& range) {
+  [client_.get() setFrameRateRange:range];
+}
+
 }  // namespace flutter
 
 @implementation VSyncClient {
@@ -68,12 +72,37 @@ void VsyncWaiterIOS::AwaitVSync() {
   display_link_.get().paused = NO;
 }
 
+- (void)setFrameRateRange:(const flutter::FrameRateRange&)range {
+  CADisplayLink* display_link = display_link_.get();
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 150000
+  if (@available(iOS 15.0, *)) {
+    display_link.preferredFrameRateRange =
+        range.IsUnspecified() ? CAFrameRateRangeDefault
+                              : CAFrameRateRangeMake(range.minimum, range.maximum,
+                                                     range.preferred);
+    return;
+  }
+#endif  // __IPHONE_OS_VERSION_MAX_ALLOWED
+  if (@available(iOS 10.0, *)) {
+    // Zero asks for the maximum refresh rate of the display.
+    double preferred = range.preferred > 0 ? range.preferred : range.maximum;
+    display_link.preferredFramesPerSecond = range.IsUnspecified() ? 0 : round(preferred);
+  }
+}
+
 - (void)onDisplayLink:(CADisplayLink*)link {
   TRACE_EVENT0("flutter", "VSYNC");
 
   CFTimeInterval delay = CACurrentMediaTime() - link.timestamp;
   fml::TimePoint frame_start_time = fml::TimePoint::Now() - fml::TimeDelta::FromSecondsF(delay);
-  fml::TimePoint frame_target_time = frame_start_time + fml::TimeDelta::FromSecondsF(link.duration);
+  // The target timestamp accounts for the frame rate that the display link was asked to fire at,
+  // which may be lower than the refresh rate of the display.
+  CFTimeInterval frame_interval = link.duration;
+  if (@available(iOS 10.0, *)) {
+    frame_interval = link.targetTimestamp - link.timestamp;
+  }
+  fml::TimePoint frame_target_time =
+      frame_start_time + fml::TimeDelta::FromSecondsF(frame_interval);
 
   display_link_.get().paused = YES;
 
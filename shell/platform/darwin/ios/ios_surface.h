@@ -9,6 +9,7 @@
 
 #include <memory>
 
+#include "flutter/common/settings.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
@@ -22,10 +23,21 @@ namespace flutter {
 // mechanism which is still in a release preview.
 bool IsIosEmbeddedViewsPreviewEnabled();
 
+// How the surfaces of a platform view present their frames.
+struct IOSSurfaceOptions {
+  static IOSSurfaceOptions FromSettings(const Settings& settings);
+
+  // See |Settings::acquire_metal_drawable_at_present|.
+  bool acquire_metal_drawable_at_present = false;
+  // See |Settings::metal_maximum_drawable_count|.
+  size_t metal_maximum_drawable_count = 0;
+};
+
 class IOSSurface {
  public:
   static std::unique_ptr<IOSSurface> Create(std::shared_ptr<IOSContext> context,
-                                            fml::scoped_nsobject<CALayer> layer);
+                                            fml::scoped_nsobject<CALayer> layer,
+                                            const IOSSurfaceOptions& options = {});
 
   std::shared_ptr<IOSContext> GetContext() const;
 
@@ -15,8 +15,16 @@
 
 namespace flutter {
 
+IOSSurfaceOptions IOSSurfaceOptions::FromSettings(const Settings& settings) {
+  return {
+      .acquire_metal_drawable_at_present = settings.acquire_metal_drawable_at_present,
+      .metal_maximum_drawable_count = settings.metal_maximum_drawable_count,
+  };
+}
+
 std::unique_ptr<IOSSurface> IOSSurface::Create(std::shared_ptr<IOSContext> context,
-                                               fml::scoped_nsobject<CALayer> layer) {
+                                               fml::scoped_nsobject<CALayer> layer,
+                                               const IOSSurfaceOptions& options) {
   FML_DCHECK(layer);
   FML_DCHECK(context);
 
@@ -34,7 +42,8 @@ std::unique_ptr<IOSSurface> IOSSurface::Create(std::shared_ptr<IOSContext> conte
       return std::make_unique<IOSSurfaceMetal>(
           fml::scoped_nsobject<CAMetalLayer>(
               reinterpret_cast<CAMetalLayer*>([layer.get() retain])),  // Metal layer
-          std::move(context)                                           // context
+          std::move(context),                                          // context
+          options                                                      // options
       );
     }
   }
@@ -17,7 +17,9 @@ namespace flutter {
 class SK_API_AVAILABLE_CA_METAL_LAYER IOSSurfaceMetal final : public IOSSurface,
                                                               public GPUSurfaceMetalDelegate {
  public:
-  IOSSurfaceMetal(fml::scoped_nsobject<CAMetalLayer> layer, std::shared_ptr<IOSContext> context);
+  IOSSurfaceMetal(fml::scoped_nsobject<CAMetalLayer> layer,
+                  std::shared_ptr<IOSContext> context,
+                  const IOSSurfaceOptions& options = {});
 
   // |IOSSurface|
   ~IOSSurfaceMetal();
@@ -27,6 +29,7 @@ class SK_API_AVAILABLE_CA_METAL_LAYER IOSSurfaceMetal final : public IOSSurface,
   id<MTLDevice> device_;
   id<MTLCommandQueue> command_queue_;
   bool is_valid_ = false;
+  const IOSSurfaceOptions options_;
 
   // |IOSSurface|
   bool IsValid() const override;
@@ -43,6 +46,9 @@ class SK_API_AVAILABLE_CA_METAL_LAYER IOSSurfaceMetal final : public IOSSurface,
   // |GPUSurfaceMetalDelegate|
   bool PresentDrawable(GrMTLHandle drawable) const override;
 
+  // |GPUSurfaceMetalDelegate|
+  bool AcquiresDrawableAtPresent() const override;
+
   // |GPUSurfaceMetalDelegate|
   GPUMTLTextureInfo GetMTLTexture(const SkISize& frame_info) const override;
 
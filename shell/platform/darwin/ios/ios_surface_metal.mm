@@ -15,10 +15,12 @@ static IOSContextMetal* CastToMetalContext(const std::shared_ptr<IOSContext>& co
 }
 
 IOSSurfaceMetal::IOSSurfaceMetal(fml::scoped_nsobject<CAMetalLayer> layer,
-                                 std::shared_ptr<IOSContext> context)
+                                 std::shared_ptr<IOSContext> context,
+                                 const IOSSurfaceOptions& options)
     : IOSSurface(std::move(context)),
       GPUSurfaceMetalDelegate(MTLRenderTargetType::kCAMetalLayer),
-      layer_(std::move(layer)) {
+      layer_(std::move(layer)),
+      options_(options) {
   is_valid_ = layer_;
   auto metal_context = CastToMetalContext(GetContext());
   auto darwin_context = metal_context->GetDarwinContext().get();
@@ -67,9 +69,24 @@ GPUCAMetalLayerHandle IOSSurfaceMetal::GetCAMetalLayer(const SkISize& frame_info
   // the raster thread, there is no such transaction.
   layer.presentsWithTransaction = [[NSThread currentThread] isMainThread];
 
+  // A layer may only have 2 or 3 drawables.
+  const size_t maximum_drawable_count = options_.metal_maximum_drawable_count;
+  if (maximum_drawable_count == 2 || maximum_drawable_count == 3) {
+    if (@available(iOS 11.2, *)) {
+      if (layer.maximumDrawableCount != maximum_drawable_count) {
+        layer.maximumDrawableCount = maximum_drawable_count;
+      }
+    }
+  }
+
   return layer;
 }
 
+// |GPUSurfaceMetalDelegate|
+bool IOSSurfaceMetal::AcquiresDrawableAtPresent() const {
+  return options_.acquire_metal_drawable_at_present;
+}
+
 // |GPUSurfaceMetalDelegate|
 bool IOSSurfaceMetal::PresentDrawable(GrMTLHandle drawable) const {
   if (drawable == nullptr) {
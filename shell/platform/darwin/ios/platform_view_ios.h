@@ -43,13 +43,15 @@ class PlatformViewIOS final : public PlatformView {
   PlatformViewIOS(PlatformView::Delegate& delegate,
                   const std::shared_ptr<IOSContext>& context,
                   const std::shared_ptr<FlutterPlatformViewsController>& platform_views_controller,
-                  flutter::TaskRunners task_runners);
+                  flutter::TaskRunners task_runners,
+                  const IOSSurfaceOptions& surface_options = {});
 
   explicit PlatformViewIOS(
       PlatformView::Delegate& delegate,
       IOSRenderingAPI rendering_api,
       const std::shared_ptr<FlutterPlatformViewsController>& platform_views_controller,
-      flutter::TaskRunners task_runners);
+      flutter::TaskRunners task_runners,
+      const IOSSurfaceOptions& surface_options = {});
 
   ~PlatformViewIOS() override;
 
@@ -135,6 +137,7 @@ class PlatformViewIOS final : public PlatformView {
   std::mutex ios_surface_mutex_;
   std::unique_ptr<IOSSurface> ios_surface_;
   std::shared_ptr<IOSContext> ios_context_;
+  const IOSSurfaceOptions surface_options_;
   const std::shared_ptr<FlutterPlatformViewsController>& platform_views_controller_;
   PlatformMessageRouter platform_message_router_;
   AccessibilityBridgePtr accessibility_bridge_;
@@ -49,9 +49,11 @@ PlatformViewIOS::PlatformViewIOS(
     PlatformView::Delegate& delegate,
     const std::shared_ptr<IOSContext>& context,
     const std::shared_ptr<FlutterPlatformViewsController>& platform_views_controller,
-    flutter::TaskRunners task_runners)
+    flutter::TaskRunners task_runners,
+    const IOSSurfaceOptions& surface_options)
     : PlatformView(delegate, std::move(task_runners)),
       ios_context_(context),
+      surface_options_(surface_options),
       platform_views_controller_(platform_views_controller),
       accessibility_bridge_([this](bool enabled) { PlatformView::SetSemanticsEnabled(enabled); }) {}
 
@@ -59,11 +61,13 @@ PlatformViewIOS::PlatformViewIOS(
     PlatformView::Delegate& delegate,
     IOSRenderingAPI rendering_api,
     const std::shared_ptr<FlutterPlatformViewsController>& platform_views_controller,
-    flutter::TaskRunners task_runners)
+    flutter::TaskRunners task_runners,
+    const IOSSurfaceOptions& surface_options)
     : PlatformViewIOS(delegate,
                       IOSContext::Create(rendering_api),
                       platform_views_controller,
-                      task_runners) {}
+                      task_runners,
+                      surface_options) {}
 
 PlatformViewIOS::~PlatformViewIOS() = default;
 
@@ -118,7 +122,7 @@ void PlatformViewIOS::attachView() {
          "before attaching to PlatformViewIOS.";
   auto flutter_view = static_cast<FlutterView*>(owner_controller_.get().view);
   auto ca_layer = fml::scoped_nsobject<CALayer>{[[flutter_view layer] retain]};
-  ios_surface_ = IOSSurface::Create(ios_context_, ca_layer);
+  ios_surface_ = IOSSurface::Create(ios_context_, ca_layer, surface_options_);
   FML_DCHECK(ios_surface_ != nullptr);
 
   if (accessibility_bridge_) {
@@ -59,6 +59,12 @@ static FlutterLocale FlutterLocaleFromNSLocale(NSLocale* locale) {
  */
 - (void)loadAOTData:(NSString*)assetsDir;
 
+/**
+ * Forwards the memory pressure warnings of the system to the running engine, as moderate or
+ * critical memory pressure.
+ */
+- (void)startObservingMemoryPressure;
+
 @end
 
 #pragma mark -
@@ -142,6 +148,9 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
 
   // FlutterCompositor is copied and used in embedder.cc.
   FlutterCompositor _compositor;
+
+  // Forwards the memory pressure of the system to the engine while it runs.
+  dispatch_source_t _memoryPressureSource;
 }
 
 - (instancetype)initWithName:(NSString*)labelPrefix project:(FlutterDartProject*)project {
@@ -173,6 +182,14 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
                          selector:@selector(sendUserLocales)
                              name:NSCurrentLocaleDidChangeNotification
                            object:nil];
+  [notificationCenter addObserver:self
+                         selector:@selector(onScreenParametersChanged:)
+                             name:NSApplicationDidChangeScreenParametersNotification
+                           object:nil];
+  [notificationCenter addObserver:self
+                         selector:@selector(onWindowDidChangeScreen:)
+                             name:NSWindowDidChangeScreenNotification
+                           object:nil];
 
   return self;
 }
@@ -274,10 +291,34 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
 
   [self sendUserLocales];
   [self updateWindowMetrics];
-  [self updateDisplayConfig];
+  [self updateDisplayConfig:kFlutterEngineDisplaysUpdateTypeStartup];
+  [self startObservingMemoryPressure];
   return YES;
 }
 
+- (void)startObservingMemoryPressure {
+  dispatch_source_t source =
+      dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+                             DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                             dispatch_get_main_queue());
+  __weak FlutterEngine* weakSelf = self;
+  __weak dispatch_source_t weakSource = source;
+  dispatch_source_set_event_handler(source, ^{
+    FlutterEngine* strongSelf = weakSelf;
+    dispatch_source_t strongSource = weakSource;
+    if (!strongSelf || !strongSource || strongSelf->_engine == nullptr) {
+      return;
+    }
+    FlutterMemoryPressureLevel level =
+        (dispatch_source_get_data(strongSource) & DISPATCH_MEMORYPRESSURE_CRITICAL)
+            ? kFlutterMemoryPressureLevelCritical
+            : kFlutterMemoryPressureLevelModerate;
+    strongSelf->_embedderAPI.NotifyMemoryPressure(strongSelf->_engine, level);
+  });
+  dispatch_resume(source);
+  _memoryPressureSource = source;
+}
+
 - (void)loadAOTData:(NSString*)assetsDir {
   if (!_embedderAPI.RunsAOTCompiledDartCode()) {
     return;
@@ -383,29 +424,56 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
   return _engine != nullptr;
 }
 
-- (void)updateDisplayConfig {
+- (void)updateDisplayConfig:(FlutterEngineDisplaysUpdateType)updateType {
   if (!_engine) {
     return;
   }
 
-  CVDisplayLinkRef displayLinkRef;
-  CGDirectDisplayID mainDisplayID = CGMainDisplayID();
-  CVDisplayLinkCreateWithCGDisplay(mainDisplayID, &displayLinkRef);
-  CVTime nominal = CVDisplayLinkGetNominalOutputVideoRefreshPeriod(displayLinkRef);
-  if (!(nominal.flags & kCVTimeIsIndefinite)) {
-    double refreshRate = static_cast<double>(nominal.timeScale) / nominal.timeValue;
+  // The first screen is the one with the menu bar, which the engine treats as
+  // the main display.
+  std::vector<FlutterEngineDisplay> displays;
+  for (NSScreen* screen in [NSScreen screens]) {
+    CGDirectDisplayID displayID = [screen.deviceDescription[@"NSScreenNumber"] unsignedIntValue];
+    CVDisplayLinkRef displayLinkRef;
+    if (CVDisplayLinkCreateWithCGDisplay(displayID, &displayLinkRef) != kCVReturnSuccess) {
+      continue;
+    }
+    CVTime nominal = CVDisplayLinkGetNominalOutputVideoRefreshPeriod(displayLinkRef);
+    CVDisplayLinkRelease(displayLinkRef);
+    if (nominal.flags & kCVTimeIsIndefinite) {
+      continue;
+    }
 
-    FlutterEngineDisplay display;
+    FlutterEngineDisplay display = {};
     display.struct_size = sizeof(display);
-    display.display_id = mainDisplayID;
-    display.refresh_rate = round(refreshRate);
+    display.display_id = displayID;
+    display.refresh_rate = round(static_cast<double>(nominal.timeScale) / nominal.timeValue);
+    if (@available(macOS 12.0, *)) {
+      // ProMotion and adaptive sync displays report the range of intervals
+      // they can present frames at.
+      if (screen.minimumRefreshInterval > 0 &&
+          screen.minimumRefreshInterval < screen.maximumRefreshInterval) {
+        display.min_refresh_rate = round(1.0 / screen.maximumRefreshInterval);
+        display.max_refresh_rate = round(1.0 / screen.minimumRefreshInterval);
+      }
+    }
+    displays.push_back(display);
+  }
 
-    std::vector<FlutterEngineDisplay> displays = {display};
-    _embedderAPI.NotifyDisplayUpdate(_engine, kFlutterEngineDisplaysUpdateTypeStartup,
-                                     displays.data(), displays.size());
+  if (!displays.empty()) {
+    _embedderAPI.NotifyDisplayUpdate(_engine, updateType, displays.data(), displays.size());
   }
+}
 
-  CVDisplayLinkRelease(displayLinkRef);
+- (void)onScreenParametersChanged:(NSNotification*)notification {
+  [self updateDisplayConfig:kFlutterEngineDisplaysUpdateTypeConfigurationChanged];
+  [self updateWindowMetrics];
+}
+
+- (void)onWindowDidChangeScreen:(NSNotification*)notification {
+  if (notification.object == _viewController.view.window) {
+    [self updateWindowMetrics];
+  }
 }
 
 - (FlutterEngineProcTable&)embedderAPI {
@@ -425,7 +493,7 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
   CGSize scaledSize = scaledBounds.size;
   double pixelRatio = view.bounds.size.width == 0 ? 1 : scaledSize.width / view.bounds.size.width;
 
-  const FlutterWindowMetricsEvent windowMetricsEvent = {
+  FlutterWindowMetricsEvent windowMetricsEvent = {
       .struct_size = sizeof(windowMetricsEvent),
       .width = static_cast<size_t>(scaledSize.width),
       .height = static_cast<size_t>(scaledSize.height),
@@ -433,6 +501,12 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
       .left = static_cast<size_t>(scaledBounds.origin.x),
       .top = static_cast<size_t>(scaledBounds.origin.y),
   };
+  NSScreen* screen = view.window.screen;
+  if (screen) {
+    windowMetricsEvent.has_display_id = true;
+    windowMetricsEvent.display_id =
+        [screen.deviceDescription[@"NSScreenNumber"] unsignedIntValue];
+  }
   _embedderAPI.SendWindowMetricsEvent(_engine, &windowMetricsEvent);
 }
 
@@ -533,6 +607,11 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
     return;
   }
 
+  if (_memoryPressureSource) {
+    dispatch_source_cancel(_memoryPressureSource);
+    _memoryPressureSource = nil;
+  }
+
   if (_viewController && _viewController.flutterView) {
     [_viewController.flutterView shutdown];
   }
@@ -42,7 +42,7 @@ bool FlutterGLCompositor::CreateBackingStore(const FlutterBackingStoreConfig* co
   } else {
     FlutterFrameBufferProvider* fb_provider =
         [[FlutterFrameBufferProvider alloc] initWithOpenGLContext:open_gl_context_];
-    FlutterIOSurfaceHolder* io_surface_holder = [FlutterIOSurfaceHolder alloc];
+    FlutterIOSurfaceHolder* io_surface_holder = [[FlutterIOSurfaceHolder alloc] init];
 
     GLuint fbo = [fb_provider glFrameBufferId];
     GLuint texture = [fb_provider glTextureId];
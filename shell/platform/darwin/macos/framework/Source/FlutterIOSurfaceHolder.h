@@ -16,8 +16,9 @@
 - (void)bindSurfaceToTexture:(GLuint)texture fbo:(GLuint)fbo size:(CGSize)size;
 
 /**
- * Releases the current IOSurface if one exists
- * and creates a new IOSurface with the specified size.
+ * Returns the current IOSurface to the FlutterIOSurfacePool if one exists
+ * and acquires an IOSurface with the specified size from it. This is a no-op
+ * if the current IOSurface is already of the specified size.
  */
 - (void)recreateIOSurfaceWithSize:(CGSize)size;
 
@@ -6,6 +6,8 @@
 
 #import <OpenGL/gl.h>
 
+#import "flutter/shell/platform/darwin/macos/framework/Source/FlutterIOSurfacePool.h"
+
 @interface FlutterIOSurfaceHolder () {
   IOSurfaceRef _ioSurface;
 }
@@ -33,24 +35,19 @@
 
 - (void)recreateIOSurfaceWithSize:(CGSize)size {
   if (_ioSurface) {
-    CFRelease(_ioSurface);
+    if (IOSurfaceGetWidth(_ioSurface) == size_t(size.width) &&
+        IOSurfaceGetHeight(_ioSurface) == size_t(size.height)) {
+      return;
+    }
+    [self recycleIOSurface];
   }
+  _ioSurface = [[FlutterIOSurfacePool sharedPool] acquireSurfaceWithSize:size];
+}
 
-  unsigned pixelFormat = 'BGRA';
-  unsigned bytesPerElement = 4;
-
-  size_t bytesPerRow = IOSurfaceAlignProperty(kIOSurfaceBytesPerRow, size.width * bytesPerElement);
-  size_t totalBytes = IOSurfaceAlignProperty(kIOSurfaceAllocSize, size.height * bytesPerRow);
-  NSDictionary* options = @{
-    (id)kIOSurfaceWidth : @(size.width),
-    (id)kIOSurfaceHeight : @(size.height),
-    (id)kIOSurfacePixelFormat : @(pixelFormat),
-    (id)kIOSurfaceBytesPerElement : @(bytesPerElement),
-    (id)kIOSurfaceBytesPerRow : @(bytesPerRow),
-    (id)kIOSurfaceAllocSize : @(totalBytes),
-  };
-
-  _ioSurface = IOSurfaceCreate((CFDictionaryRef)options);
+- (void)recycleIOSurface {
+  [[FlutterIOSurfacePool sharedPool] recycleSurface:_ioSurface];
+  CFRelease(_ioSurface);
+  _ioSurface = nullptr;
 }
 
 - (const IOSurfaceRef&)ioSurface {
@@ -59,7 +56,7 @@
 
 - (void)dealloc {
   if (_ioSurface) {
-    CFRelease(_ioSurface);
+    [self recycleIOSurface];
   }
 }
 
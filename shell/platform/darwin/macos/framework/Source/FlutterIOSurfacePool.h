@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Cocoa/Cocoa.h>
+#import <IOSurface/IOSurface.h>
+
+/**
+ * FlutterIOSurfacePool keeps the IOSurfaces that are no longer rendered to, so that surfaces of the
+ * same size can be handed out again instead of being allocated anew. IOSurfaces are keyed by their
+ * pixel size; a surface that is still in use, for example as the contents of a CALayer the window
+ * server is compositing, is not handed out until it is released.
+ */
+@interface FlutterIOSurfacePool : NSObject
+
+/**
+ * The pool that FlutterIOSurfaceHolder acquires its IOSurfaces from.
+ */
++ (nonnull FlutterIOSurfacePool*)sharedPool;
+
+/**
+ * Initializes a pool that keeps at most `capacity` recycled IOSurfaces, dropping the least recently
+ * recycled ones first.
+ */
+- (nonnull instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/**
+ * Returns a BGRA IOSurface of `size`, which is one of the recycled ones if there is such a surface
+ * that is not in use, or else a newly allocated one. The caller owns the returned reference.
+ */
+- (nullable IOSurfaceRef)acquireSurfaceWithSize:(CGSize)size CF_RETURNS_RETAINED;
+
+/**
+ * Returns `surface` to the pool. The pool keeps its own reference to it.
+ */
+- (void)recycleSurface:(nonnull IOSurfaceRef)surface;
+
+/**
+ * The number of recycled IOSurfaces in the pool.
+ */
+@property(nonatomic, readonly) NSUInteger count;
+
+@end
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "flutter/shell/platform/darwin/macos/framework/Source/FlutterIOSurfacePool.h"
+
+namespace {
+
+// Enough for the two buffers of the FlutterView and a few overlays, when the sizes of all of them
+// change at once.
+constexpr NSUInteger kSharedPoolCapacity = 8;
+
+IOSurfaceRef CreateIOSurface(CGSize size) {
+  unsigned pixelFormat = 'BGRA';
+  unsigned bytesPerElement = 4;
+
+  size_t bytesPerRow = IOSurfaceAlignProperty(kIOSurfaceBytesPerRow, size.width * bytesPerElement);
+  size_t totalBytes = IOSurfaceAlignProperty(kIOSurfaceAllocSize, size.height * bytesPerRow);
+  NSDictionary* options = @{
+    (id)kIOSurfaceWidth : @(size.width),
+    (id)kIOSurfaceHeight : @(size.height),
+    (id)kIOSurfacePixelFormat : @(pixelFormat),
+    (id)kIOSurfaceBytesPerElement : @(bytesPerElement),
+    (id)kIOSurfaceBytesPerRow : @(bytesPerRow),
+    (id)kIOSurfaceAllocSize : @(totalBytes),
+  };
+
+  return IOSurfaceCreate((CFDictionaryRef)options);
+}
+
+}  // namespace
+
+@implementation FlutterIOSurfacePool {
+  NSUInteger _capacity;
+  // The recycled IOSurfaces, least recently recycled first.
+  NSMutableArray* _surfaces;
+}
+
++ (FlutterIOSurfacePool*)sharedPool {
+  static FlutterIOSurfacePool* sharedPool;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    sharedPool = [[FlutterIOSurfacePool alloc] initWithCapacity:kSharedPoolCapacity];
+  });
+  return sharedPool;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+  self = [super init];
+  if (self) {
+    _capacity = capacity;
+    _surfaces = [NSMutableArray arrayWithCapacity:capacity];
+  }
+  return self;
+}
+
+- (IOSurfaceRef)acquireSurfaceWithSize:(CGSize)size {
+  const size_t width = size.width;
+  const size_t height = size.height;
+  @synchronized(self) {
+    // The most recently recycled surfaces are the most likely to be of the size asked for.
+    for (NSUInteger i = _surfaces.count; i > 0; --i) {
+      IOSurfaceRef surface = (__bridge IOSurfaceRef)_surfaces[i - 1];
+      if (IOSurfaceGetWidth(surface) == width && IOSurfaceGetHeight(surface) == height &&
+          !IOSurfaceIsInUse(surface)) {
+        CFRetain(surface);
+        [_surfaces removeObjectAtIndex:i - 1];
+        return surface;
+      }
+    }
+  }
+  return CreateIOSurface(size);
+}
+
+- (void)recycleSurface:(IOSurfaceRef)surface {
+  @synchronized(self) {
+    if (_capacity == 0) {
+      return;
+    }
+    if (_surfaces.count == _capacity) {
+      [_surfaces removeObjectAtIndex:0];
+    }
+    [_surfaces addObject:(__bridge id)surface];
+  }
+}
+
+- (NSUInteger)count {
+  @synchronized(self) {
+    return _surfaces.count;
+  }
+}
+
+@end
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Cocoa/Cocoa.h>
+
+#import "flutter/shell/platform/darwin/macos/framework/Source/FlutterIOSurfacePool.h"
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+
+namespace flutter::testing {
+
+TEST(FlutterIOSurfacePool, AcquireReturnsSurfaceOfSize) {
+  FlutterIOSurfacePool* pool = [[FlutterIOSurfacePool alloc] initWithCapacity:2];
+  IOSurfaceRef surface = [pool acquireSurfaceWithSize:CGSizeMake(100, 50)];
+  ASSERT_NE(surface, nullptr);
+  EXPECT_EQ(IOSurfaceGetWidth(surface), 100u);
+  EXPECT_EQ(IOSurfaceGetHeight(surface), 50u);
+  CFRelease(surface);
+}
+
+TEST(FlutterIOSurfacePool, ReusesRecycledSurfaceOfSameSize) {
+  FlutterIOSurfacePool* pool = [[FlutterIOSurfacePool alloc] initWithCapacity:2];
+  IOSurfaceRef surface = [pool acquireSurfaceWithSize:CGSizeMake(100, 50)];
+  [pool recycleSurface:surface];
+  CFRelease(surface);
+  EXPECT_EQ(pool.count, 1u);
+
+  IOSurfaceRef reused = [pool acquireSurfaceWithSize:CGSizeMake(100, 50)];
+  EXPECT_EQ(reused, surface);
+  EXPECT_EQ(pool.count, 0u);
+  CFRelease(reused);
+}
+
+TEST(FlutterIOSurfacePool, DoesNotReuseSurfaceOfOtherSize) {
+  FlutterIOSurfacePool* pool = [[FlutterIOSurfacePool alloc] initWithCapacity:2];
+  IOSurfaceRef surface = [pool acquireSurfaceWithSize:CGSizeMake(100, 50)];
+  [pool recycleSurface:surface];
+
+  IOSurfaceRef other = [pool acquireSurfaceWithSize:CGSizeMake(50, 100)];
+  EXPECT_NE(other, surface);
+  EXPECT_EQ(IOSurfaceGetWidth(other), 50u);
+  EXPECT_EQ(pool.count, 1u);
+  CFRelease(other);
+  CFRelease(surface);
+}
+
+TEST(FlutterIOSurfacePool, DropsLeastRecentlyRecycledSurfaceWhenFull) {
+  FlutterIOSurfacePool* pool = [[FlutterIOSurfacePool alloc] initWithCapacity:2];
+  IOSurfaceRef first = [pool acquireSurfaceWithSize:CGSizeMake(10, 10)];
+  IOSurfaceRef second = [pool acquireSurfaceWithSize:CGSizeMake(20, 20)];
+  IOSurfaceRef third = [pool acquireSurfaceWithSize:CGSizeMake(30, 30)];
+  [pool recycleSurface:first];
+  [pool recycleSurface:second];
+  [pool recycleSurface:third];
+  EXPECT_EQ(pool.count, 2u);
+
+  IOSurfaceRef acquired = [pool acquireSurfaceWithSize:CGSizeMake(10, 10)];
+  EXPECT_NE(acquired, first);
+  EXPECT_EQ(pool.count, 2u);
+  CFRelease(acquired);
+  CFRelease(first);
+  CFRelease(second);
+  CFRelease(third);
+}
+
+}  // namespace flutter::testing
@@ -5,9 +5,12 @@
 #define FML_USED_ON_EMBEDDER
 #define RAPIDJSON_HAS_STDSTRING 1
 
+#include <cstddef>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -41,9 +44,11 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -66,6 +71,12 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/shell/platform/embedder/embedder_surface_metal.h"
 #endif
 
+#ifdef SHELL_ENABLE_VULKAN
+#include "flutter/shell/platform/embedder/embedder_surface_vulkan.h"
+#include "third_party/skia/include/gpu/vk/GrVkTypes.h"
+#endif
+
+const FlutterViewId kFlutterImplicitViewId = flutter::kFlutterImplicitViewId;
 const int32_t kFlutterSemanticsNodeIdBatchEnd = -1;
 const int32_t kFlutterSemanticsCustomActionIdBatchEnd = -1;
 
@@ -118,8 +129,11 @@ static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
 
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
-  if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
-      nullptr) {
+  const bool has_framebuffer_callbacks =
+      SAFE_EXISTS(software_config, acquire_framebuffer_callback) &&
+      SAFE_EXISTS(software_config, present_framebuffer_callback);
+  if (!SAFE_EXISTS(software_config, surface_present_callback) &&
+      !has_framebuffer_callbacks) {
     return false;
   }
 
@@ -144,6 +158,26 @@ static bool IsMetalRendererConfigValid(const FlutterRendererConfig* config) {
   return device && command_queue && present && get_texture;
 }
 
+static bool IsVulkanRendererConfigValid(const FlutterRendererConfig* config) {
+  if (config->type != kVulkan) {
+    return false;
+  }
+
+  const FlutterVulkanRendererConfig* vulkan_config = &config->vulkan;
+
+  if (!SAFE_EXISTS(vulkan_config, instance) ||
+      !SAFE_EXISTS(vulkan_config, physical_device) ||
+      !SAFE_EXISTS(vulkan_config, device) ||
+      !SAFE_EXISTS(vulkan_config, queue) ||
+      !SAFE_EXISTS(vulkan_config, get_instance_proc_address_callback) ||
+      !SAFE_EXISTS(vulkan_config, get_next_image_callback) ||
+      !SAFE_EXISTS(vulkan_config, present_image_callback)) {
+    return false;
+  }
+
+  return true;
+}
+
 static bool IsRendererValid(const FlutterRendererConfig* config) {
   if (config == nullptr) {
     return false;
@@ -156,6 +190,8 @@ static bool IsRendererValid(const FlutterRendererConfig* config) {
       return IsSoftwareRendererConfigValid(config);
     case kMetal:
       return IsMetalRendererConfigValid(config);
+    case kVulkan:
+      return IsVulkanRendererConfigValid(config);
     default:
       return false;
   }
@@ -176,6 +212,22 @@ static void* DefaultGLProcResolver(const char* name) {
 }
 #endif  // OS_LINUX || OS_WIN
 
+static FlutterRect SkIRectToFlutterRect(const SkIRect& rect) {
+  FlutterRect flutter_rect = {
+      static_cast<double>(rect.left()),    //
+      static_cast<double>(rect.top()),     //
+      static_cast<double>(rect.right()),   //
+      static_cast<double>(rect.bottom()),  //
+  };
+  return flutter_rect;
+}
+
+static SkIRect FlutterRectToSkIRect(const FlutterRect& flutter_rect) {
+  return SkRect::MakeLTRB(flutter_rect.left, flutter_rect.top,
+                          flutter_rect.right, flutter_rect.bottom)
+      .roundOut();
+}
+
 static flutter::Shell::CreateCallback<flutter::PlatformView>
 InferOpenGLPlatformViewCreationCallback(
     const FlutterRendererConfig* config,
@@ -195,15 +247,31 @@ InferOpenGLPlatformViewCreationCallback(
   auto gl_clear_current = [ptr = config->open_gl.clear_current,
                            user_data]() -> bool { return ptr(user_data); };
 
-  auto gl_present = [present = config->open_gl.present,
-                     present_with_info = config->open_gl.present_with_info,
-                     user_data](uint32_t fbo_id) -> bool {
+  auto gl_present =
+      [present = config->open_gl.present,
+       present_with_info = config->open_gl.present_with_info,
+       user_data](const flutter::GLPresentInfo& gl_present_info) -> bool {
     if (present) {
       return present(user_data);
     } else {
+      // The rects have to outlive the call, so they live on the stack here.
+      FlutterRect frame_rect = {};
+      FlutterRect buffer_rect = {};
       FlutterPresentInfo present_info = {};
       present_info.struct_size = sizeof(FlutterPresentInfo);
-      present_info.fbo_id = fbo_id;
+      present_info.fbo_id = gl_present_info.fbo_id;
+      present_info.frame_damage.struct_size = sizeof(FlutterDamage);
+      present_info.buffer_damage.struct_size = sizeof(FlutterDamage);
+      if (gl_present_info.frame_damage.has_value()) {
+        frame_rect = SkIRectToFlutterRect(*gl_present_info.frame_damage);
+        present_info.frame_damage.num_rects = 1;
+        present_info.frame_damage.damage = &frame_rect;
+      }
+      if (gl_present_info.buffer_damage.has_value()) {
+        buffer_rect = SkIRectToFlutterRect(*gl_present_info.buffer_damage);
+        present_info.buffer_damage.num_rects = 1;
+        present_info.buffer_damage.damage = &buffer_rect;
+      }
       return present_with_info(user_data, &present_info);
     }
   };
@@ -257,6 +325,28 @@ InferOpenGLPlatformViewCreationCallback(
     }
   }
 
+  std::function<std::optional<SkIRect>(intptr_t)>
+      gl_populate_existing_damage = nullptr;
+  if (SAFE_ACCESS(open_gl_config, populate_existing_damage, nullptr) !=
+      nullptr) {
+    gl_populate_existing_damage =
+        [ptr = config->open_gl.populate_existing_damage,
+         user_data](intptr_t fbo_id) -> std::optional<SkIRect> {
+      FlutterDamage existing_damage = {};
+      existing_damage.struct_size = sizeof(FlutterDamage);
+      ptr(user_data, fbo_id, &existing_damage);
+      if (existing_damage.damage == nullptr) {
+        // The contents of the fbo are unknown.
+        return std::nullopt;
+      }
+      SkIRect damage = SkIRect::MakeEmpty();
+      for (size_t i = 0; i < existing_damage.num_rects; i++) {
+        damage.join(FlutterRectToSkIRect(existing_damage.damage[i]));
+      }
+      return damage;
+    };
+  }
+
   flutter::GPUSurfaceGLDelegate::GLProcResolver gl_proc_resolver = nullptr;
   if (SAFE_ACCESS(open_gl_config, gl_proc_resolver, nullptr) != nullptr) {
     gl_proc_resolver = [ptr = config->open_gl.gl_proc_resolver,
@@ -272,6 +362,9 @@ InferOpenGLPlatformViewCreationCallback(
   bool fbo_reset_after_present =
       SAFE_ACCESS(open_gl_config, fbo_reset_after_present, false);
 
+  bool skip_redundant_make_current =
+      SAFE_ACCESS(open_gl_config, skip_redundant_make_current, false);
+
   flutter::EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table = {
       gl_make_current,                     // gl_make_current_callback
       gl_clear_current,                    // gl_clear_current_callback
@@ -280,18 +373,21 @@ InferOpenGLPlatformViewCreationCallback(
       gl_make_resource_current_callback,   // gl_make_resource_current_callback
       gl_surface_transformation_callback,  // gl_surface_transformation_callback
       gl_proc_resolver,                    // gl_proc_resolver
+      gl_populate_existing_damage,         // gl_populate_existing_damage
   };
 
   return fml::MakeCopyable(
-      [gl_dispatch_table, fbo_reset_after_present, platform_dispatch_table,
+      [gl_dispatch_table, fbo_reset_after_present, skip_redundant_make_current,
+       platform_dispatch_table,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
         return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                    // delegate
-            shell.GetTaskRunners(),   // task runners
-            gl_dispatch_table,        // embedder GL dispatch table
-            fbo_reset_after_present,  // fbo reset after present
-            platform_dispatch_table,  // embedder platform dispatch table
+            shell,                        // delegate
+            shell.GetTaskRunners(),       // task runners
+            gl_dispatch_table,            // embedder GL dispatch table
+            fbo_reset_after_present,      // fbo reset after present
+            skip_redundant_make_current,  // skip redundant make current
+            platform_dispatch_table,      // embedder platform dispatch table
             std::move(external_view_embedder)  // external view embedder
         );
       });
@@ -342,6 +438,9 @@ InferMetalPlatformViewCreationCallback(
       .get_texture = metal_get_texture,
   };
 
+  bool textures_retain_contents =
+      SAFE_ACCESS(&config->metal, textures_retain_contents, false);
+
   std::shared_ptr<flutter::EmbedderExternalViewEmbedder> view_embedder =
       std::move(external_view_embedder);
 
@@ -350,7 +449,104 @@ InferMetalPlatformViewCreationCallback(
           const_cast<flutter::GPUMTLDeviceHandle>(config->metal.device),
           const_cast<flutter::GPUMTLCommandQueueHandle>(
               config->metal.present_command_queue),
-          metal_dispatch_table, view_embedder);
+          metal_dispatch_table, textures_retain_contents, view_embedder);
+
+  return fml::MakeCopyable(
+      [embedder_surface = std::move(embedder_surface), platform_dispatch_table,
+       external_view_embedder = view_embedder](flutter::Shell& shell) mutable {
+        return std::make_unique<flutter::PlatformViewEmbedder>(
+            shell,                             // delegate
+            shell.GetTaskRunners(),            // task runners
+            std::move(embedder_surface),       // embedder surface
+            platform_dispatch_table,           // platform dispatch table
+            std::move(external_view_embedder)  // external view embedder
+        );
+      });
+#else
+  return nullptr;
+#endif
+}
+
+static flutter::Shell::CreateCallback<flutter::PlatformView>
+InferVulkanPlatformViewCreationCallback(
+    const FlutterRendererConfig* config,
+    void* user_data,
+    flutter::PlatformViewEmbedder::PlatformDispatchTable
+        platform_dispatch_table,
+    std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
+        external_view_embedder) {
+  if (config->type != kVulkan) {
+    return nullptr;
+  }
+
+#ifdef SHELL_ENABLE_VULKAN
+  const FlutterVulkanRendererConfig* vulkan_config = &config->vulkan;
+
+  auto vulkan_get_instance_proc_address =
+      [ptr = vulkan_config->get_instance_proc_address_callback, user_data](
+          VkInstance instance, const char* name) -> PFN_vkVoidFunction {
+    return reinterpret_cast<PFN_vkVoidFunction>(
+        ptr(user_data, instance, name));
+  };
+
+  auto vulkan_get_next_image =
+      [ptr = vulkan_config->get_next_image_callback,
+       user_data](const SkISize& frame_size) -> flutter::GPUVulkanImage {
+    FlutterFrameInfo frame_info = {};
+    frame_info.struct_size = sizeof(FlutterFrameInfo);
+    frame_info.size = {static_cast<uint32_t>(frame_size.width()),
+                       static_cast<uint32_t>(frame_size.height())};
+
+    FlutterVulkanImage vulkan_image = ptr(user_data, &frame_info);
+    flutter::GPUVulkanImage image;
+    image.image = reinterpret_cast<VkImage>(vulkan_image.image);
+    image.format = static_cast<VkFormat>(vulkan_image.format);
+    return image;
+  };
+
+  auto vulkan_present_image =
+      [ptr = vulkan_config->present_image_callback,
+       user_data](const flutter::GPUVulkanImage& image) -> bool {
+    FlutterVulkanImage vulkan_image = {};
+    vulkan_image.struct_size = sizeof(FlutterVulkanImage);
+    vulkan_image.image =
+        reinterpret_cast<FlutterVulkanImageHandle>(image.image);
+    vulkan_image.format = image.format;
+    return ptr(user_data, &vulkan_image);
+  };
+
+  flutter::EmbedderSurfaceVulkan::VulkanDispatchTable vulkan_dispatch_table = {
+      .get_instance_proc_address = vulkan_get_instance_proc_address,
+      .get_next_image = vulkan_get_next_image,
+      .present_image = vulkan_present_image,
+  };
+
+  std::vector<std::string> instance_extensions;
+  for (size_t i = 0;
+       i < SAFE_ACCESS(vulkan_config, enabled_instance_extension_count, 0);
+       i++) {
+    instance_extensions.push_back(
+        vulkan_config->enabled_instance_extensions[i]);
+  }
+  std::vector<std::string> device_extensions;
+  for (size_t i = 0;
+       i < SAFE_ACCESS(vulkan_config, enabled_device_extension_count, 0); i++) {
+    device_extensions.push_back(vulkan_config->enabled_device_extensions[i]);
+  }
+
+  std::shared_ptr<flutter::EmbedderExternalViewEmbedder> view_embedder =
+      std::move(external_view_embedder);
+
+  std::unique_ptr<flutter::EmbedderSurfaceVulkan> embedder_surface =
+      std::make_unique<flutter::EmbedderSurfaceVulkan>(
+          SAFE_ACCESS(vulkan_config, version, VK_MAKE_VERSION(1, 0, 0)),
+          static_cast<VkInstance>(vulkan_config->instance),
+          static_cast<VkPhysicalDevice>(vulkan_config->physical_device),
+          static_cast<VkDevice>(vulkan_config->device),
+          SAFE_ACCESS(vulkan_config, queue_family_index, 0),
+          static_cast<VkQueue>(vulkan_config->queue),
+          std::move(instance_extensions), std::move(device_extensions),
+          vulkan_dispatch_table, view_embedder);
 
   return fml::MakeCopyable(
       [embedder_surface = std::move(embedder_surface), platform_dispatch_table,
@@ -380,15 +576,105 @@ InferSoftwarePlatformViewCreationCallback(
     return nullptr;
   }
 
-  auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
-  };
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
+
+  std::function<bool(const void*, size_t, size_t)>
+      software_present_backing_store = nullptr;
+  if (SAFE_EXISTS(software_config, surface_present_callback)) {
+    software_present_backing_store =
+        [ptr = software_config->surface_present_callback, user_data](
+            const void* allocation, size_t row_bytes, size_t height) -> bool {
+      return ptr(user_data, allocation, row_bytes, height);
+    };
+  }
+
+  std::function<bool(const SkISize&,
+                     flutter::EmbedderSurfaceSoftware::SoftwareFramebuffer&)>
+      software_acquire_framebuffer = nullptr;
+  std::function<bool(void*, const flutter::SoftwarePresentInfo&)>
+      software_present_framebuffer = nullptr;
+  if (SAFE_EXISTS(software_config, acquire_framebuffer_callback) &&
+      SAFE_EXISTS(software_config, present_framebuffer_callback)) {
+    software_acquire_framebuffer =
+        [ptr = software_config->acquire_framebuffer_callback, user_data](
+            const SkISize& size,
+            flutter::EmbedderSurfaceSoftware::SoftwareFramebuffer& framebuffer)
+        -> bool {
+      FlutterFrameInfo frame_info = {};
+      frame_info.struct_size = sizeof(FlutterFrameInfo);
+      frame_info.size = {static_cast<uint32_t>(size.width()),
+                         static_cast<uint32_t>(size.height())};
+      FlutterSoftwareFramebuffer embedder_framebuffer = {};
+      embedder_framebuffer.struct_size = sizeof(FlutterSoftwareFramebuffer);
+      embedder_framebuffer.existing_damage.struct_size = sizeof(FlutterDamage);
+      if (!ptr(user_data, &frame_info, &embedder_framebuffer)) {
+        return false;
+      }
+
+      switch (embedder_framebuffer.pixel_format) {
+        case kFlutterSoftwarePixelFormatNative32:
+          framebuffer.color_type = kN32_SkColorType;
+          break;
+        case kFlutterSoftwarePixelFormatRGBA8888:
+          framebuffer.color_type = kRGBA_8888_SkColorType;
+          break;
+        case kFlutterSoftwarePixelFormatBGRA8888:
+          framebuffer.color_type = kBGRA_8888_SkColorType;
+          break;
+        case kFlutterSoftwarePixelFormatRGB565:
+          framebuffer.color_type = kRGB_565_SkColorType;
+          break;
+        default:
+          FML_LOG(ERROR) << "Unknown software framebuffer pixel format.";
+          return false;
+      }
+      framebuffer.allocation = embedder_framebuffer.allocation;
+      framebuffer.row_bytes = embedder_framebuffer.row_bytes;
+      framebuffer.user_data = embedder_framebuffer.user_data;
+
+      const FlutterDamage& existing_damage =
+          embedder_framebuffer.existing_damage;
+      if (existing_damage.damage != nullptr) {
+        SkIRect damage = SkIRect::MakeEmpty();
+        for (size_t i = 0; i < existing_damage.num_rects; i++) {
+          damage.join(FlutterRectToSkIRect(existing_damage.damage[i]));
+        }
+        framebuffer.existing_damage = damage;
+      }
+      return true;
+    };
+    software_present_framebuffer =
+        [ptr = software_config->present_framebuffer_callback, user_data](
+            void* framebuffer_user_data,
+            const flutter::SoftwarePresentInfo& software_present_info) -> bool {
+      // The rects have to outlive the call, so they live on the stack here.
+      FlutterRect frame_rect = {};
+      FlutterRect buffer_rect = {};
+      FlutterSoftwarePresentInfo present_info = {};
+      present_info.struct_size = sizeof(FlutterSoftwarePresentInfo);
+      present_info.framebuffer_user_data = framebuffer_user_data;
+      present_info.frame_damage.struct_size = sizeof(FlutterDamage);
+      present_info.buffer_damage.struct_size = sizeof(FlutterDamage);
+      if (software_present_info.frame_damage.has_value()) {
+        frame_rect = SkIRectToFlutterRect(*software_present_info.frame_damage);
+        present_info.frame_damage.num_rects = 1;
+        present_info.frame_damage.damage = &frame_rect;
+      }
+      if (software_present_info.buffer_damage.has_value()) {
+        buffer_rect =
+            SkIRectToFlutterRect(*software_present_info.buffer_damage);
+        present_info.buffer_damage.num_rects = 1;
+        present_info.buffer_damage.damage = &buffer_rect;
+      }
+      return ptr(user_data, &present_info);
+    };
+  }
 
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
-          software_present_backing_store,  // required
+          software_present_backing_store,  // optional
+          software_acquire_framebuffer,    // optional
+          software_present_framebuffer,    // optional
       };
 
   return fml::MakeCopyable(
@@ -430,6 +716,10 @@ InferPlatformViewCreationCallback(
       return InferMetalPlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
           std::move(external_view_embedder));
+    case kVulkan:
+      return InferVulkanPlatformViewCreationCallback(
+          config, user_data, platform_dispatch_table,
+          std::move(external_view_embedder));
     default:
       return nullptr;
   }
@@ -610,6 +900,67 @@ static sk_sp<SkSurface> MakeSkSurfaceFromBackingStore(
 #endif
 }
 
+static sk_sp<SkSurface> MakeSkSurfaceFromBackingStore(
+    GrDirectContext* context,
+    const FlutterBackingStoreConfig& config,
+    const FlutterVulkanBackingStore* vulkan) {
+#ifdef SHELL_ENABLE_VULKAN
+  if (!vulkan->image || !vulkan->image->image) {
+    FML_LOG(ERROR) << "Embedder supplied null Vulkan image.";
+    return nullptr;
+  }
+
+  SkColorType color_type;
+  switch (vulkan->image->format) {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+      color_type = kRGBA_8888_SkColorType;
+      break;
+    case VK_FORMAT_B8G8R8A8_UNORM:
+      color_type = kBGRA_8888_SkColorType;
+      break;
+    default:
+      FML_LOG(ERROR) << "Embedder supplied Vulkan image of unsupported format "
+                     << vulkan->image->format << ".";
+      return nullptr;
+  }
+
+  GrVkImageInfo image_info;
+  image_info.fImage = reinterpret_cast<VkImage>(vulkan->image->image);
+  image_info.fImageTiling = VK_IMAGE_TILING_OPTIMAL;
+  image_info.fImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  image_info.fFormat = static_cast<VkFormat>(vulkan->image->format);
+  image_info.fLevelCount = 1;
+  GrBackendTexture backend_texture(config.size.width,   //
+                                   config.size.height,  //
+                                   image_info           //
+  );
+
+  SkSurfaceProps surface_properties(0, kUnknown_SkPixelGeometry);
+
+  auto surface = SkSurface::MakeFromBackendTexture(
+      context,                   // context
+      backend_texture,           // back-end texture
+      kTopLeft_GrSurfaceOrigin,  // surface origin
+      1,                         // sample count
+      color_type,                // color type
+      nullptr,                   // color space
+      &surface_properties,       // surface properties
+      static_cast<SkSurface::TextureReleaseProc>(
+          vulkan->destruction_callback),  // release proc
+      vulkan->user_data                   // release context
+  );
+
+  if (!surface) {
+    FML_LOG(ERROR) << "Could not wrap embedder supplied Vulkan render image.";
+    return nullptr;
+  }
+
+  return surface;
+#else
+  return nullptr;
+#endif
+}
+
 static std::unique_ptr<flutter::EmbedderRenderTarget>
 CreateEmbedderRenderTarget(const FlutterCompositor* compositor,
                            const FlutterBackingStoreConfig& config,
@@ -671,6 +1022,10 @@ CreateEmbedderRenderTarget(const FlutterCompositor* compositor,
       render_surface =
           MakeSkSurfaceFromBackingStore(context, config, &backing_store.metal);
       break;
+    case kFlutterBackingStoreTypeVulkan:
+      render_surface =
+          MakeSkSurfaceFromBackingStore(context, config, &backing_store.vulkan);
+      break;
   };
 
   if (!render_surface) {
@@ -696,11 +1051,16 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       SAFE_ACCESS(compositor, collect_backing_store_callback, nullptr);
   auto c_present_callback =
       SAFE_ACCESS(compositor, present_layers_callback, nullptr);
+  auto c_present_view_callback =
+      SAFE_ACCESS(compositor, present_view_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  size_t backing_store_cache_frames =
+      SAFE_ACCESS(compositor, backing_store_cache_frames, 1);
 
   // Make sure the required callbacks are present
-  if (!c_create_callback || !c_collect_callback || !c_present_callback) {
+  if (!c_create_callback || !c_collect_callback ||
+      (!c_present_callback && !c_present_view_callback)) {
     FML_LOG(ERROR) << "Required compositor callbacks absent.";
     return {nullptr, true};
   }
@@ -714,18 +1074,38 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
                                               context);
           };
 
-  flutter::EmbedderExternalViewEmbedder::PresentCallback present_callback =
-      [c_present_callback,
-       user_data = compositor->user_data](const auto& layers) {
-        TRACE_EVENT0("flutter", "FlutterCompositorPresentLayers");
-        return c_present_callback(
-            const_cast<const FlutterLayer**>(layers.data()), layers.size(),
-            user_data);
-      };
+  flutter::EmbedderExternalViewEmbedder::PresentCallback present_callback;
+  if (c_present_view_callback) {
+    present_callback = [c_present_view_callback,
+                        user_data = compositor->user_data](
+                           FlutterViewId view_id, const auto& layers) {
+      TRACE_EVENT0("flutter", "FlutterCompositorPresentView");
+      FlutterPresentViewInfo info = {};
+      info.struct_size = sizeof(FlutterPresentViewInfo);
+      info.view_id = view_id;
+      info.layers = const_cast<const FlutterLayer**>(layers.data());
+      info.layers_count = layers.size();
+      info.user_data = user_data;
+      return c_present_view_callback(&info);
+    };
+  } else {
+    present_callback = [c_present_callback, user_data = compositor->user_data](
+                           FlutterViewId view_id, const auto& layers) {
+      if (view_id != kFlutterImplicitViewId) {
+        FML_LOG(ERROR) << "The compositor must specify a present view callback "
+                          "to present views other than the implicit view.";
+        return false;
+      }
+      TRACE_EVENT0("flutter", "FlutterCompositorPresentLayers");
+      return c_present_callback(
+          const_cast<const FlutterLayer**>(layers.data()), layers.size(),
+          user_data);
+    };
+  }
 
   return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              avoid_backing_store_cache, create_render_target_callback,
-              present_callback),
+              avoid_backing_store_cache, backing_store_cache_frames,
+              create_render_target_callback, present_callback),
           false};
 }
 
@@ -872,6 +1252,31 @@ void PopulateSnapshotMappingCallbacks(
 #endif  // !OS_FUCHSIA && (FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG)
 }
 
+static FlutterFrameTiming ToEmbedderFrameTiming(
+    const flutter::FrameTiming& timing) {
+  auto time_point = [&timing](flutter::FrameTiming::Phase phase) {
+    return static_cast<uint64_t>(
+        timing.Get(phase).ToEpochDelta().ToNanoseconds());
+  };
+  auto duration = [&timing](flutter::FrameTiming::RasterPhase phase) {
+    return static_cast<uint64_t>(timing.Get(phase).ToNanoseconds());
+  };
+  FlutterFrameTiming embedder_timing = {};
+  embedder_timing.struct_size = sizeof(FlutterFrameTiming);
+  embedder_timing.vsync_start = time_point(flutter::FrameTiming::kVsyncStart);
+  embedder_timing.build_start = time_point(flutter::FrameTiming::kBuildStart);
+  embedder_timing.build_finish = time_point(flutter::FrameTiming::kBuildFinish);
+  embedder_timing.raster_start = time_point(flutter::FrameTiming::kRasterStart);
+  embedder_timing.raster_finish =
+      time_point(flutter::FrameTiming::kRasterFinish);
+  embedder_timing.preroll_duration = duration(flutter::FrameTiming::kPreroll);
+  embedder_timing.paint_duration = duration(flutter::FrameTiming::kPaint);
+  embedder_timing.flush_duration = duration(flutter::FrameTiming::kFlush);
+  embedder_timing.present_duration = duration(flutter::FrameTiming::kPresent);
+  embedder_timing.gpu_duration = duration(flutter::FrameTiming::kGpu);
+  return embedder_timing;
+}
+
 FlutterEngineResult FlutterEngineRun(size_t version,
                                      const FlutterRendererConfig* config,
                                      const FlutterProjectArgs* args,
@@ -1015,6 +1420,22 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
   }
 
+  if (SAFE_ACCESS(args, frame_timings_callback, nullptr) != nullptr) {
+    FlutterFrameTimingsCallback callback =
+        SAFE_ACCESS(args, frame_timings_callback, nullptr);
+    settings.frame_timings_report_callback =
+        [callback,
+         user_data](const std::vector<flutter::FrameTiming>& timings) {
+          std::vector<FlutterFrameTiming> embedder_timings;
+          embedder_timings.reserve(timings.size());
+          for (const auto& timing : timings) {
+            embedder_timings.push_back(ToEmbedderFrameTiming(timing));
+          }
+          callback(embedder_timings.data(), embedder_timings.size(),
+                   user_data);
+        };
+  }
+
   flutter::PlatformViewEmbedder::UpdateSemanticsNodesCallback
       update_semantics_nodes_callback = nullptr;
   if (SAFE_ACCESS(args, update_semantics_node_callback, nullptr) != nullptr) {
@@ -1110,8 +1531,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
           const FlutterPlatformMessage incoming_message = {
               sizeof(FlutterPlatformMessage),  // struct_size
               message->channel().c_str(),      // channel
-              message->data().data(),          // message
-              message->data().size(),          // message_size
+              message->data().GetMapping(),    // message
+              message->data().GetSize(),       // message_size
               handle,                          // response_handle
           };
           handle->message = std::move(message);
@@ -1174,6 +1595,22 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
         };
   }
 
+  flutter::PlatformViewEmbedder::FrameRateRangeCallback
+      frame_rate_range_callback = nullptr;
+  if (SAFE_ACCESS(args, frame_rate_range_callback, nullptr) != nullptr) {
+    frame_rate_range_callback =
+        [ptr = args->frame_rate_range_callback,
+         user_data](const flutter::FrameRateRange& range) {
+          FlutterFrameRateRange embedder_range = {
+              .struct_size = sizeof(FlutterFrameRateRange),
+              .minimum = range.minimum,
+              .maximum = range.maximum,
+              .preferred = range.preferred,
+          };
+          ptr(&embedder_range, user_data);
+        };
+  }
+
   auto external_view_embedder_result =
       InferExternalViewEmbedderFromArgs(SAFE_ACCESS(args, compositor, nullptr));
   if (external_view_embedder_result.second) {
@@ -1188,6 +1625,7 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
           platform_message_response_callback,         //
           vsync_callback,                             //
           compute_platform_resolved_locale_callback,  //
+          frame_rate_range_callback,                  //
       };
 
   auto on_create_platform_view = InferPlatformViewCreationCallback(
@@ -1258,7 +1696,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
 
   auto thread_host =
       flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-          SAFE_ACCESS(args, custom_task_runners, nullptr));
+          SAFE_ACCESS(args, custom_task_runners, nullptr),
+          SAFE_ACCESS(args, thread_configs, nullptr));
 
   if (!thread_host || !thread_host->IsValid()) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments,
@@ -1394,6 +1833,8 @@ FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
   metrics.physical_width = SAFE_ACCESS(flutter_metrics, width, 0.0);
   metrics.physical_height = SAFE_ACCESS(flutter_metrics, height, 0.0);
   metrics.device_pixel_ratio = SAFE_ACCESS(flutter_metrics, pixel_ratio, 1.0);
+  metrics.view_id =
+      SAFE_ACCESS(flutter_metrics, view_id, kFlutterImplicitViewId);
 
   if (metrics.device_pixel_ratio <= 0.0) {
     return LOG_EMBEDDER_ERROR(
@@ -1401,8 +1842,14 @@ FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
         "Device pixel ratio was invalid. It must be greater than zero.");
   }
 
-  return reinterpret_cast<flutter::EmbedderEngine*>(engine)->SetViewportMetrics(
-             std::move(metrics))
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (SAFE_ACCESS(flutter_metrics, has_display_id, false) &&
+      embedder_engine->IsValid()) {
+    embedder_engine->GetShell().SetViewDisplay(
+        metrics.view_id, SAFE_ACCESS(flutter_metrics, display_id, 0));
+  }
+
+  return embedder_engine->SetViewportMetrics(std::move(metrics))
              ? kSuccess
              : LOG_EMBEDDER_ERROR(kInvalidArguments,
                                   "Viewport metrics were invalid.");
@@ -1603,13 +2050,9 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
                                   "running Flutter application.");
 }
 
-FlutterEngineResult FlutterEngineSendPlatformMessage(
-    FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    const FlutterPlatformMessage* flutter_message) {
-  if (engine == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
-  }
-
+static FlutterEngineResult CreatePlatformMessage(
+    const FlutterPlatformMessage* flutter_message,
+    fml::RefPtr<flutter::PlatformMessage>* message_out) {
   if (flutter_message == nullptr) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid message argument.");
   }
@@ -1636,15 +2079,28 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     response = response_handle->message->response();
   }
 
-  fml::RefPtr<flutter::PlatformMessage> message;
   if (message_size == 0) {
-    message = fml::MakeRefCounted<flutter::PlatformMessage>(
+    *message_out = fml::MakeRefCounted<flutter::PlatformMessage>(
         flutter_message->channel, response);
   } else {
-    message = fml::MakeRefCounted<flutter::PlatformMessage>(
+    *message_out = fml::MakeRefCounted<flutter::PlatformMessage>(
         flutter_message->channel,
-        std::vector<uint8_t>(message_data, message_data + message_size),
-        response);
+        fml::MallocMapping::Copy(message_data, message_size), response);
+  }
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  fml::RefPtr<flutter::PlatformMessage> message;
+  FlutterEngineResult result = CreatePlatformMessage(flutter_message, &message);
+  if (result != kSuccess) {
+    return result;
   }
 
   return reinterpret_cast<flutter::EmbedderEngine*>(engine)
@@ -1655,6 +2111,45 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
                                   "Flutter application.");
 }
 
+FlutterEngineResult FlutterEngineSendPlatformMessages(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_messages,
+    size_t messages_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (messages_count == 0) {
+    return kSuccess;
+  }
+
+  if (flutter_messages == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid messages argument.");
+  }
+
+  // Nothing is sent unless every message in the batch is valid.
+  std::vector<fml::RefPtr<flutter::PlatformMessage>> messages;
+  messages.reserve(messages_count);
+  const FlutterPlatformMessage* current = flutter_messages;
+  for (size_t i = 0; i < messages_count; ++i) {
+    fml::RefPtr<flutter::PlatformMessage> message;
+    FlutterEngineResult result = CreatePlatformMessage(current, &message);
+    if (result != kSuccess) {
+      return result;
+    }
+    messages.push_back(std::move(message));
+    current = reinterpret_cast<const FlutterPlatformMessage*>(
+        reinterpret_cast<const uint8_t*>(current) + current->struct_size);
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                 ->SendPlatformMessages(std::move(messages))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not send the messages to the running "
+                                  "Flutter application.");
+}
+
 FlutterEngineResult FlutterPlatformMessageCreateResponseHandle(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterDataCallback data_callback,
@@ -1731,6 +2226,72 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* release_user_data) {
+  fml::NonOwnedMapping::ReleaseProc release_proc;
+  if (release_callback != nullptr) {
+    release_proc = [release_callback, release_user_data](const uint8_t* data,
+                                                         size_t size) {
+      release_callback(release_user_data);
+    };
+  }
+  auto mapping =
+      std::make_unique<fml::NonOwnedMapping>(data, data_length, release_proc);
+
+  if (data_length != 0 && data == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Data size was non zero but the pointer to the data was null.");
+  }
+
+  auto response = handle->message->response();
+
+  if (response) {
+    if (data_length == 0) {
+      response->CompleteEmpty();
+    } else {
+      response->Complete(std::move(mapping));
+    }
+  }
+
+  delete handle;
+
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterPlatformMessageTakeData(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    uint8_t** data_out) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (handle == nullptr || !handle->message || data_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid arguments.");
+  }
+
+  if (!handle->message->hasData()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The platform message has no data to take.");
+  }
+
+  *data_out = handle->message->releaseData().Release();
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterPlatformMessageReleaseData(uint8_t* data) {
+  // The data was allocated by the engine, so it must be freed by the engine
+  // rather than by an allocator of the embedder.
+  free(data);
+  return kSuccess;
+}
+
 FlutterEngineResult __FlutterEngineFlushPendingTasksNow() {
   fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
   return kSuccess;
@@ -1794,6 +2355,33 @@ FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineMarkExternalTexturesFrameAvailable(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const int64_t* texture_identifiers,
+    size_t texture_identifiers_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+  if (texture_identifiers == nullptr && texture_identifiers_count > 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid texture identifiers.");
+  }
+  for (size_t i = 0; i < texture_identifiers_count; i++) {
+    if (texture_identifiers[i] == 0) {
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "Invalid texture identifier.");
+    }
+  }
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->MarkTexturesFrameAvailable(texture_identifiers,
+                                        texture_identifiers_count)) {
+    return LOG_EMBEDDER_ERROR(
+        kInternalInconsistency,
+        "Could not mark the texture frames as being available.");
+  }
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineUpdateSemanticsEnabled(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     bool enabled) {
@@ -1959,9 +2547,9 @@ static bool DispatchJSONPlatformMessage(FLUTTER_API_SYMBOL(FlutterEngine)
   }
 
   auto platform_message = fml::MakeRefCounted<flutter::PlatformMessage>(
-      channel_name.c_str(),                                       // channel
-      std::vector<uint8_t>{message, message + buffer.GetSize()},  // message
-      nullptr                                                     // response
+      channel_name.c_str(),                                  // channel
+      fml::MallocMapping::Copy(message, buffer.GetSize()),  // message
+      nullptr                                                // response
   );
 
   return reinterpret_cast<flutter::EmbedderEngine*>(engine)
@@ -2158,12 +2746,35 @@ FlutterEngineResult FlutterEnginePostDartObject(
 
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) raw_engine) {
+  return FlutterEngineNotifyMemoryPressure(raw_engine,
+                                           kFlutterMemoryPressureLevelCritical);
+}
+
+FlutterEngineResult FlutterEngineNotifyMemoryPressure(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterMemoryPressureLevel level) {
   auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
   if (engine == nullptr || !engine->IsValid()) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
   }
 
-  engine->GetShell().NotifyLowMemoryWarning();
+  switch (level) {
+    case kFlutterMemoryPressureLevelModerate:
+      engine->GetShell().NotifyMemoryPressure(
+          flutter::MemoryPressureLevel::kModerate);
+      break;
+    case kFlutterMemoryPressureLevelCritical:
+      engine->GetShell().NotifyMemoryPressure(
+          flutter::MemoryPressureLevel::kCritical);
+      break;
+    case kFlutterMemoryPressureLevelBackground:
+      engine->GetShell().NotifyMemoryPressure(
+          flutter::MemoryPressureLevel::kBackground);
+      break;
+    default:
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "Invalid memory pressure level specified.");
+  }
 
   rapidjson::Document document;
   auto& allocator = document.GetAllocator();
@@ -2176,7 +2787,8 @@ FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
              ? kSuccess
              : LOG_EMBEDDER_ERROR(
                    kInternalInconsistency,
-                   "Could not dispatch the low memory notification message.");
+                   "Could not dispatch the memory pressure notification "
+                   "message.");
 }
 
 FlutterEngineResult FlutterEnginePostCallbackOnAllNativeThreads(
@@ -2204,14 +2816,36 @@ FlutterEngineResult FlutterEnginePostCallbackOnAllNativeThreads(
 }
 
 namespace {
+// The displays are laid out with the size of the struct the embedder was
+// compiled with, which is smaller than sizeof(FlutterEngineDisplay) for
+// embedders compiled before fields were added to it.
+static const FlutterEngineDisplay* DisplayAt(
+    const FlutterEngineDisplay* displays,
+    size_t index) {
+  return reinterpret_cast<const FlutterEngineDisplay*>(
+      reinterpret_cast<const uint8_t*>(displays) +
+      index * displays->struct_size);
+}
+
 static bool ValidDisplayConfiguration(const FlutterEngineDisplay* displays,
                                       size_t display_count) {
+  if (display_count == 0) {
+    return true;
+  }
+  // Every version of the struct has the fields up to the refresh rate.
+  const size_t min_struct_size =
+      offsetof(FlutterEngineDisplay, min_refresh_rate);
+  if (displays == nullptr || displays->struct_size < min_struct_size) {
+    return false;
+  }
   std::set<FlutterEngineDisplayId> display_ids;
   for (size_t i = 0; i < display_count; i++) {
-    if (displays[i].single_display && display_count != 1) {
+    const FlutterEngineDisplay* display = DisplayAt(displays, i);
+    if (display->struct_size != displays->struct_size ||
+        (display->single_display && display_count != 1)) {
       return false;
     }
-    display_ids.insert(displays[i].display_id);
+    display_ids.insert(display->display_id);
   }
 
   return display_ids.size() == display_count;
@@ -2235,27 +2869,158 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
 
   auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
 
+  flutter::DisplayUpdateType display_update_type;
   switch (update_type) {
-    case kFlutterEngineDisplaysUpdateTypeStartup: {
-      std::vector<flutter::Display> displays;
-      for (size_t i = 0; i < display_count; i++) {
-        flutter::Display display =
-            flutter::Display(embedder_displays[i].refresh_rate);
-        if (!embedder_displays[i].single_display) {
-          display = flutter::Display(embedder_displays[i].display_id,
-                                     embedder_displays[i].refresh_rate);
-        }
-        displays.push_back(display);
-      }
-      engine->GetShell().OnDisplayUpdates(flutter::DisplayUpdateType::kStartup,
-                                          displays);
-      return kSuccess;
-    }
+    case kFlutterEngineDisplaysUpdateTypeStartup:
+      display_update_type = flutter::DisplayUpdateType::kStartup;
+      break;
+    case kFlutterEngineDisplaysUpdateTypeConfigurationChanged:
+      display_update_type = flutter::DisplayUpdateType::kConfigurationChanged;
+      break;
     default:
       return LOG_EMBEDDER_ERROR(
           kInvalidArguments,
           "Invalid FlutterEngineDisplaysUpdateType type specified.");
   }
+
+  std::vector<flutter::Display> displays;
+  for (size_t i = 0; i < display_count; i++) {
+    const FlutterEngineDisplay* embedder_display =
+        DisplayAt(embedder_displays, i);
+    std::optional<flutter::DisplayId> display_id;
+    if (!embedder_display->single_display) {
+      display_id = embedder_display->display_id;
+    }
+    displays.push_back(flutter::Display(
+        display_id, embedder_display->refresh_rate,
+        SAFE_ACCESS(embedder_display, min_refresh_rate, 0.0),
+        SAFE_ACCESS(embedder_display, max_refresh_rate, 0.0)));
+  }
+  engine->GetShell().OnDisplayUpdates(display_update_type, displays);
+  return kSuccess;
+}
+
+static FlutterFrameTimePercentiles ToEmbedderPercentiles(
+    const flutter::FrameTimePercentiles& percentiles) {
+  return {
+      .p50 = static_cast<uint64_t>(percentiles.p50.ToNanoseconds()),
+      .p90 = static_cast<uint64_t>(percentiles.p90.ToNanoseconds()),
+      .p99 = static_cast<uint64_t>(percentiles.p99.ToNanoseconds()),
+      .max = static_cast<uint64_t>(percentiles.max.ToNanoseconds()),
+  };
+}
+
+FlutterEngineResult FlutterEngineGetFrameTimingStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    bool reset,
+    FlutterFrameTimingStatistics* statistics) {
+  if (raw_engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (statistics == nullptr ||
+      statistics->struct_size < sizeof(FlutterFrameTimingStatistics)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid frame timing statistics specified.");
+  }
+
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (!engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine is not running.");
+  }
+
+  const flutter::FrameTimingStatisticsSnapshot snapshot =
+      engine->GetShell().GetFrameTimingStatistics(reset);
+  statistics->frame_count = snapshot.frame_count;
+  statistics->janky_build_frame_count = snapshot.janky_build_frame_count;
+  statistics->janky_raster_frame_count = snapshot.janky_raster_frame_count;
+  statistics->vsync_overhead = ToEmbedderPercentiles(snapshot.vsync_overhead);
+  statistics->build = ToEmbedderPercentiles(snapshot.build);
+  statistics->raster = ToEmbedderPercentiles(snapshot.raster);
+  statistics->gpu = ToEmbedderPercentiles(snapshot.gpu);
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineAddShaderBundle(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    const uint8_t* bundle,
+    size_t bundle_size) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (bundle == nullptr || bundle_size == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid shader bundle specified.");
+  }
+
+  auto mapping = std::make_shared<fml::DataMapping>(
+      std::vector<uint8_t>(bundle, bundle + bundle_size));
+  if (!flutter::PersistentCache::GetCacheForProcess()->AddSkSLBundle(
+          std::move(mapping))) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The shader bundle could not be parsed.");
+  }
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEnginePrecompileShaders(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterShaderPrecompileCallback callback,
+    void* user_data) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  flutter::Shell& shell = engine->GetShell();
+  shell.GetTaskRunners().GetRasterTaskRunner()->PostTask(
+      [rasterizer = shell.GetRasterizer(), callback, user_data]() {
+        const size_t count =
+            rasterizer ? rasterizer->PrecompileKnownSkSLs() : 0;
+        if (callback) {
+          callback(count, user_data);
+        }
+      });
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineExportShaderBundle(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterShaderBundleCallback callback,
+    void* user_data) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid shader bundle callback specified.");
+  }
+
+  // Loading the shaders reads the cache directory, which is done on the IO
+  // thread like for the service protocol.
+  engine->GetTaskRunners().GetIOTaskRunner()->PostTask([callback,
+                                                        user_data]() {
+    const std::string bundle =
+        flutter::PersistentCache::GetCacheForProcess()->ExportSkSLBundle();
+    callback(reinterpret_cast<const uint8_t*>(bundle.data()), bundle.size(),
+             user_data);
+  });
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineStartObservatory(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  flutter::DartServiceIsolate::RequestStartup();
+  return kSuccess;
 }
 
 FlutterEngineResult FlutterEngineGetProcAddresses(
@@ -2308,6 +3073,19 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(PostCallbackOnAllNativeThreads,
            FlutterEnginePostCallbackOnAllNativeThreads);
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
+  SET_PROC(SendPlatformMessages, FlutterEngineSendPlatformMessages);
+  SET_PROC(GetFrameTimingStatistics, FlutterEngineGetFrameTimingStatistics);
+  SET_PROC(NotifyMemoryPressure, FlutterEngineNotifyMemoryPressure);
+  SET_PROC(AddShaderBundle, FlutterEngineAddShaderBundle);
+  SET_PROC(PrecompileShaders, FlutterEnginePrecompileShaders);
+  SET_PROC(ExportShaderBundle, FlutterEngineExportShaderBundle);
+  SET_PROC(StartObservatory, FlutterEngineStartObservatory);
+  SET_PROC(MarkExternalTexturesFrameAvailable,
+           FlutterEngineMarkExternalTexturesFrameAvailable);
+  SET_PROC(SendPlatformMessageResponseNoCopy,
+           FlutterEngineSendPlatformMessageResponseNoCopy);
+  SET_PROC(PlatformMessageTakeData, FlutterPlatformMessageTakeData);
+  SET_PROC(PlatformMessageReleaseData, FlutterPlatformMessageReleaseData);
 #undef SET_PROC
 
   return kSuccess;
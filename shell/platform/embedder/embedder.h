@@ -76,6 +76,10 @@ typedef enum {
   /// iOS version >= 10.0 (device), 13.0 (simulator)
   /// macOS version >= 10.14
   kMetal,
+  /// Vulkan is supported on platforms with a Vulkan 1.0 (or newer) driver. The
+  /// embedder creates the instance and the device and presents the images
+  /// Flutter renders into.
+  kVulkan,
 } FlutterRendererType;
 
 /// Additional accessibility features that may be enabled by the platform.
@@ -363,6 +367,20 @@ typedef uint32_t (*UIntFrameInfoCallback)(
     void* /* user data */,
     const FlutterFrameInfo* /* frame info */);
 
+/// A structure to represent a damaged region of a surface. The rectangles are
+/// in the coordinate space of the surface with the origin at the top left
+/// corner. Embedders using EGL (whose damage rectangles have their origin at
+/// the bottom left corner) must flip the y coordinates before passing them to
+/// `eglSetDamageRegionKHR` or `eglSwapBuffersWithDamageKHR`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterDamage).
+  size_t struct_size;
+  /// The number of rectangles within the damage array.
+  size_t num_rects;
+  /// The actual damage region(s) in question.
+  FlutterRect* damage;
+} FlutterDamage;
+
 /// This information is passed to the embedder when a surface is presented.
 ///
 /// See: \ref FlutterOpenGLRendererConfig.present_with_info.
@@ -371,6 +389,13 @@ typedef struct {
   size_t struct_size;
   /// Id of the fbo backing the surface that was presented.
   uint32_t fbo_id;
+  /// The region of the frame that changed since the previously presented
+  /// frame. This is what should be passed to `eglSwapBuffersWithDamageKHR`.
+  /// Empty (`num_rects` is 0) if the whole frame changed.
+  FlutterDamage frame_damage;
+  /// The region of the fbo that was repainted by the engine. Empty (`num_rects`
+  /// is 0) if the whole fbo was repainted.
+  FlutterDamage buffer_damage;
 } FlutterPresentInfo;
 
 /// Callback for when a surface is presented.
@@ -378,6 +403,14 @@ typedef bool (*BoolPresentInfoCallback)(
     void* /* user data */,
     const FlutterPresentInfo* /* present info */);
 
+/// Callback for when the engine asks the embedder for the region of a frame
+/// buffer object that does not hold the contents of the previously presented
+/// frame.
+typedef void (*FlutterFrameBufferWithDamageCallback)(
+    void* /* user data */,
+    const intptr_t /* fbo id */,
+    FlutterDamage* /* existing damage */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterOpenGLRendererConfig).
   size_t struct_size;
@@ -436,6 +469,25 @@ typedef struct {
   /// `FlutterPresentInfo` struct that the embedder can use to release any
   /// resources. The return value indicates success of the present call.
   BoolPresentInfoCallback present_with_info;
+  /// This is an optional callback that enables partial repaint. If specified,
+  /// the engine calls it before rendering each frame so that the embedder can
+  /// report the region of the fbo whose contents are not those of the
+  /// previously presented frame (typically derived from `EGL_BUFFER_AGE_EXT`).
+  /// The engine then only repaints that region plus the region of the frame
+  /// that changed. The embedder must populate `existing_damage` with an
+  /// array of rectangles that remains valid until the next call to this
+  /// callback. Setting `num_rects` to 0 indicates that the fbo holds the
+  /// previous frame. Leaving `damage` null indicates that the contents of the
+  /// fbo are unknown, in which case the whole frame is repainted.
+  FlutterFrameBufferWithDamageCallback populate_existing_damage;
+  /// By default, the engine calls `make_current` every time it needs the
+  /// context, even if it already made it current on the calling thread and
+  /// did not clear it since. Setting this to true lets the engine skip those
+  /// redundant `make_current` calls. The embedder must then not change the
+  /// current context of the threads the engine renders on other than through
+  /// `make_current` and `clear_current`, including from within other engine
+  /// callbacks such as the compositor and external texture callbacks.
+  bool skip_redundant_make_current;
 } FlutterOpenGLRendererConfig;
 
 /// Alias for id<MTLDevice>.
@@ -534,8 +586,179 @@ typedef struct {
   /// that external texture details can be supplied to the engine for subsequent
   /// composition.
   FlutterMetalTextureFrameCallback external_texture_frame_callback;
+  /// Set this to true if the textures returned by `get_next_drawable_callback`
+  /// keep their contents between frames and the same `texture_id` always
+  /// refers to the same texture. The engine then tracks what it rendered into
+  /// each texture and only repaints the region of a frame that changed since
+  /// that texture was last presented. Textures must not be recycled under a
+  /// different id or modified by the embedder while this is enabled.
+  bool textures_retain_contents;
 } FlutterMetalRendererConfig;
 
+/// Alias for VkInstance.
+typedef void* FlutterVulkanInstanceHandle;
+
+/// Alias for VkPhysicalDevice.
+typedef void* FlutterVulkanPhysicalDeviceHandle;
+
+/// Alias for VkDevice.
+typedef void* FlutterVulkanDeviceHandle;
+
+/// Alias for VkQueue.
+typedef void* FlutterVulkanQueueHandle;
+
+/// Alias for VkImage.
+typedef uint64_t FlutterVulkanImageHandle;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterVulkanImage).
+  size_t struct_size;
+  /// Handle to the VkImage that is owned by the embedder. The engine will
+  /// render the frame into this image. The image must have been created with
+  /// `VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT`, a single mip level and a single
+  /// sample, and must not be used by the embedder until it is presented.
+  FlutterVulkanImageHandle image;
+  /// The VkFormat of the image, `VK_FORMAT_R8G8B8A8_UNORM` or
+  /// `VK_FORMAT_B8G8R8A8_UNORM`.
+  uint32_t format;
+} FlutterVulkanImage;
+
+/// Callback to look up a Vulkan function for an instance, usually a call to
+/// `vkGetInstanceProcAddr`. The instance is null for the global functions.
+typedef void* (*FlutterVulkanInstanceProcAddressCallback)(
+    void* /* user data */,
+    FlutterVulkanInstanceHandle /* instance */,
+    const char* /* name */);
+
+/// Callback for when a Vulkan image to render the next frame into is
+/// requested.
+typedef FlutterVulkanImage (*FlutterVulkanImageCallback)(
+    void* /* user data */,
+    const FlutterFrameInfo* /* frame info */);
+
+/// Callback for when a Vulkan image is presented. The image is one returned by
+/// the `FlutterVulkanImageCallback` callback. All the work of the engine that
+/// renders into the image was submitted to the queue of the
+/// `FlutterVulkanRendererConfig` before this is called, so presenting on the
+/// same queue is ordered after it.
+typedef bool (*FlutterVulkanPresentCallback)(
+    void* /* user data */,
+    const FlutterVulkanImage* /* image */);
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterVulkanRendererConfig).
+  size_t struct_size;
+  /// The Vulkan API version the instance was created for, as made by
+  /// `VK_MAKE_VERSION`.
+  uint32_t version;
+  /// The instance the device was created with. It must stay valid until the
+  /// engine is shut down.
+  FlutterVulkanInstanceHandle instance;
+  /// The physical device the device was created for.
+  FlutterVulkanPhysicalDeviceHandle physical_device;
+  /// The device the engine renders with. The engine does not wait for the
+  /// device to be idle or destroy it.
+  FlutterVulkanDeviceHandle device;
+  /// The index of the queue family of `queue`. The family must support
+  /// graphics.
+  uint32_t queue_family_index;
+  /// The queue the engine submits its work to. The engine only uses it on the
+  /// raster thread, so the embedder must not use it concurrently without
+  /// synchronizing with the engine, for instance in the present callback.
+  FlutterVulkanQueueHandle queue;
+  /// The number of instance extensions in `enabled_instance_extensions`.
+  size_t enabled_instance_extension_count;
+  /// The names of the extensions the instance was created with.
+  const char** enabled_instance_extensions;
+  /// The number of device extensions in `enabled_device_extensions`.
+  size_t enabled_device_extension_count;
+  /// The names of the extensions the device was created with.
+  const char** enabled_device_extensions;
+  /// The callback the engine looks up all Vulkan functions with. Device
+  /// functions are looked up with `vkGetDeviceProcAddr` returned by it.
+  FlutterVulkanInstanceProcAddressCallback get_instance_proc_address_callback;
+  /// The callback that gets invoked when the engine requests the embedder for
+  /// an image to render the next frame into.
+  FlutterVulkanImageCallback get_next_image_callback;
+  /// The callback that gets invoked when the engine has rendered a frame into
+  /// an image, for the embedder to present it to the user.
+  FlutterVulkanPresentCallback present_image_callback;
+} FlutterVulkanRendererConfig;
+
+/// The pixel formats of the framebuffers an embedder can provide to the
+/// software renderer.
+typedef enum {
+  /// The native 32-bit format of the platform. This is the format of the
+  /// buffers handed to `surface_present_callback`.
+  kFlutterSoftwarePixelFormatNative32,
+  /// 32 bits per pixel, with 8-bit red, green, blue and alpha components in
+  /// byte order.
+  kFlutterSoftwarePixelFormatRGBA8888,
+  /// 32 bits per pixel, with 8-bit blue, green, red and alpha components in
+  /// byte order.
+  kFlutterSoftwarePixelFormatBGRA8888,
+  /// 16 bits per pixel in native endianness, with 5-bit red, 6-bit green and
+  /// 5-bit blue components from the most to the least significant bit. The
+  /// frame is opaque.
+  kFlutterSoftwarePixelFormatRGB565,
+} FlutterSoftwarePixelFormat;
+
+/// An embedder owned buffer the software renderer renders a frame into.
+///
+/// See: \ref FlutterSoftwareRendererConfig.acquire_framebuffer_callback.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSoftwareFramebuffer).
+  size_t struct_size;
+  /// The first byte of the top row of the buffer. The buffer must hold at least
+  /// `row_bytes * height` bytes, where height is that of the requested frame.
+  void* allocation;
+  /// The number of bytes between the starts of consecutive rows, which may be
+  /// more than the width of the frame times the size of a pixel.
+  size_t row_bytes;
+  /// The format of the pixels in the buffer.
+  FlutterSoftwarePixelFormat pixel_format;
+  /// The region of the buffer that does not hold the contents of the
+  /// previously presented frame. The engine only repaints the changed region
+  /// of the frame joined with this region. Leave `damage` null if the contents
+  /// of the buffer are unknown, in which case the whole frame is repainted.
+  /// The rectangles are copied by the engine before the acquire callback
+  /// returns.
+  FlutterDamage existing_damage;
+  /// A baton passed back to the embedder when the buffer is presented. It is
+  /// not interpreted by the engine in any way.
+  void* user_data;
+} FlutterSoftwareFramebuffer;
+
+/// Callback for when the software renderer asks the embedder for a buffer to
+/// render the next frame into.
+typedef bool (*FlutterSoftwareFramebufferAcquireCallback)(
+    void* /* user data */,
+    const FlutterFrameInfo* /* frame info */,
+    FlutterSoftwareFramebuffer* /* framebuffer out */);
+
+/// This information is passed to the embedder when a software framebuffer is
+/// presented.
+///
+/// See: \ref FlutterSoftwareRendererConfig.present_framebuffer_callback.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSoftwarePresentInfo).
+  size_t struct_size;
+  /// The `FlutterSoftwareFramebuffer.user_data` of the presented buffer.
+  void* framebuffer_user_data;
+  /// The region of the frame that changed since the previously presented
+  /// frame. Empty (`num_rects` is 0) if the whole frame changed.
+  FlutterDamage frame_damage;
+  /// The region of the buffer that was repainted by the engine. Empty
+  /// (`num_rects` is 0) if the whole buffer was repainted.
+  FlutterDamage buffer_damage;
+} FlutterSoftwarePresentInfo;
+
+/// Callback for when a software framebuffer has been rendered into and must be
+/// presented to the user.
+typedef bool (*FlutterSoftwareFramebufferPresentCallback)(
+    void* /* user data */,
+    const FlutterSoftwarePresentInfo* /* present info */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterSoftwareRendererConfig).
   size_t struct_size;
@@ -543,7 +766,19 @@ typedef struct {
   /// to the user. The pixel format of the buffer is the native 32-bit RGBA
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
+  ///
+  /// Either this or both `acquire_framebuffer_callback` and
+  /// `present_framebuffer_callback` must be specified.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// The callback invoked when the engine needs a buffer to render a frame
+  /// into. The engine renders straight into the returned buffer, which saves
+  /// the embedder copying every frame into its own framebuffer (for instance
+  /// a Linux fbdev device, a DRM dumb buffer or shared memory). The buffer
+  /// must stay valid until it is passed to `present_framebuffer_callback`.
+  FlutterSoftwareFramebufferAcquireCallback acquire_framebuffer_callback;
+  /// The callback invoked when a buffer returned by
+  /// `acquire_framebuffer_callback` holds a frame to present to the user.
+  FlutterSoftwareFramebufferPresentCallback present_framebuffer_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -552,9 +787,19 @@ typedef struct {
     FlutterOpenGLRendererConfig open_gl;
     FlutterSoftwareRendererConfig software;
     FlutterMetalRendererConfig metal;
+    FlutterVulkanRendererConfig vulkan;
   };
 } FlutterRendererConfig;
 
+/// The identifier of a view rendered by the engine. Views are added by sending
+/// window metrics for a new identifier.
+typedef int64_t FlutterViewId;
+
+/// The view that every engine renders into. It is the only view of embedders
+/// that do not specify a view when sending window metrics.
+FLUTTER_EXPORT
+extern const FlutterViewId kFlutterImplicitViewId;
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterWindowMetricsEvent).
   size_t struct_size;
@@ -568,6 +813,17 @@ typedef struct {
   size_t left;
   /// Vertical physical location of the top of the window on the screen.
   size_t top;
+  /// The view the metrics describe. Views other than `kFlutterImplicitViewId`
+  /// are only rendered when the engine is configured with a
+  /// `FlutterCompositor` that specifies a `present_view_callback`.
+  FlutterViewId view_id;
+  /// Whether `display_id` is set.
+  bool has_display_id;
+  /// The display the view is on, as reported to
+  /// `FlutterEngineNotifyDisplayUpdate`. The frame budget of the view follows
+  /// the refresh rate of this display, which defaults to the first display
+  /// reported.
+  uint64_t display_id;
 } FlutterWindowMetricsEvent;
 
 /// The phase of the pointer event.
@@ -906,6 +1162,22 @@ typedef struct {
   size_t identifier;
 } FlutterTaskRunnerDescription;
 
+/// The threads the engine creates for itself.
+typedef enum {
+  /// The thread the root isolate runs on, which builds the frames.
+  kFlutterEngineThreadTypeUI,
+  /// The thread that rasterizes the frames. It is only created if the embedder
+  /// does not specify `FlutterCustomTaskRunners.render_task_runner`.
+  kFlutterEngineThreadTypeRaster,
+  /// The thread that loads and decodes resources such as images.
+  kFlutterEngineThreadTypeIO,
+} FlutterEngineThreadType;
+
+/// Callback invoked on a thread the engine created, when that thread starts.
+typedef void (*FlutterThreadStartCallback)(
+    FlutterEngineThreadType /* thread type */,
+    void* /* user data */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterCustomTaskRunners).
   size_t struct_size;
@@ -919,8 +1191,69 @@ typedef struct {
   /// and platform task runners. This makes the Flutter engine use the same
   /// thread for both task runners.
   const FlutterTaskRunnerDescription* render_task_runner;
+  /// Invoked on each thread the engine creates, with the type of that thread,
+  /// before the thread runs any tasks and after the engine applied its
+  /// `FlutterEngineThreadConfigs`. Embedders may use this to set the
+  /// scheduling policy, cgroup or CPU affinity of the thread. Optional. Both
+  /// task runners may be left unspecified to only install this callback.
+  FlutterThreadStartCallback thread_start_callback;
+  /// The baton passed to `thread_start_callback`.
+  void* thread_start_callback_user_data;
 } FlutterCustomTaskRunners;
 
+/// The scheduling priority of an engine managed thread, from lowest to highest.
+typedef enum {
+  /// For threads whose work is not on the critical path of a frame.
+  kFlutterThreadPriorityBackground,
+  /// The priority threads are created with.
+  kFlutterThreadPriorityNormal,
+  /// For threads that produce frames.
+  kFlutterThreadPriorityDisplay,
+  /// For threads that put frames on screen.
+  kFlutterThreadPriorityRaster,
+  /// Realtime scheduling (`SCHED_RR`), where the platform permits it. Falls
+  /// back to `kFlutterThreadPriorityRaster` otherwise.
+  kFlutterThreadPriorityRealtime,
+} FlutterThreadPriority;
+
+/// The kind of cores an engine managed thread runs on, on systems whose cores
+/// run at different speeds.
+typedef enum {
+  /// The thread may run on any core.
+  kFlutterCpuAffinityAny,
+  /// The thread only runs on the fastest cores.
+  kFlutterCpuAffinityPerformance,
+  /// The thread only runs on the cores that are not the fastest.
+  kFlutterCpuAffinityEfficiency,
+} FlutterCpuAffinity;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterThreadConfig).
+  size_t struct_size;
+  FlutterThreadPriority priority;
+  /// The kind of cores the thread runs on. Ignored if `cpu_mask` is set.
+  FlutterCpuAffinity affinity;
+  /// The cores the thread runs on, where bit N stands for core N. The thread
+  /// may run on any core if this is 0.
+  uint64_t cpu_mask;
+  /// The size of the stack of the thread in bytes, or 0 for the default size
+  /// of the platform.
+  size_t stack_size;
+} FlutterThreadConfig;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineThreadConfigs).
+  size_t struct_size;
+  /// The configuration of the UI thread, or NULL for the default one.
+  const FlutterThreadConfig* ui_thread_config;
+  /// The configuration of the raster thread, or NULL for the default one. This
+  /// is ignored if the embedder specifies a render task runner in
+  /// `FlutterCustomTaskRunners`.
+  const FlutterThreadConfig* raster_thread_config;
+  /// The configuration of the IO thread, or NULL for the default one.
+  const FlutterThreadConfig* io_thread_config;
+} FlutterEngineThreadConfigs;
+
 typedef struct {
   /// The type of the OpenGL backing store. Currently, it can either be a
   /// texture or a framebuffer.
@@ -962,6 +1295,23 @@ typedef struct {
   };
 } FlutterMetalBackingStore;
 
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterVulkanBackingStore).
+  size_t struct_size;
+  /// The image Flutter renders the layer into. Ownership is not transferred to
+  /// Flutter, the image must stay valid until the destruction callback is
+  /// invoked. All the work rendering into the image is submitted to the queue
+  /// of the `FlutterVulkanRendererConfig` before the layer is presented.
+  const FlutterVulkanImage* image;
+  /// A baton that is not interpreted by the engine in any way. It will be given
+  /// back to the embedder in the destruction callback below. Embedder resources
+  /// may be associated with this baton.
+  void* user_data;
+  /// The callback invoked by the engine when it no longer needs this backing
+  /// store.
+  VoidCallback destruction_callback;
+} FlutterVulkanBackingStore;
+
 typedef enum {
   /// Indicates that the Flutter application requested that an opacity be
   /// applied to the platform view.
@@ -1021,6 +1371,8 @@ typedef enum {
   kFlutterBackingStoreTypeSoftware,
   /// Specifies a Metal backing store. This is backed by a Metal texture.
   kFlutterBackingStoreTypeMetal,
+  /// Specifies a Vulkan backing store. This is backed by a Vulkan VkImage.
+  kFlutterBackingStoreTypeVulkan,
 } FlutterBackingStoreType;
 
 typedef struct {
@@ -1042,6 +1394,8 @@ typedef struct {
     FlutterSoftwareBackingStore software;
     // The description of the Metal backing store.
     FlutterMetalBackingStore metal;
+    // The description of the Vulkan backing store.
+    FlutterVulkanBackingStore vulkan;
   };
 } FlutterBackingStore;
 
@@ -1079,6 +1433,19 @@ typedef struct {
   FlutterPoint offset;
   /// The size of the layer (in physical pixels).
   FlutterSize size;
+  /// Whether this layer is the same as the layer at the same position in the
+  /// previously presented frame of the view, apart from the contents rendered
+  /// into its backing store. That is, both frames have the same number of
+  /// layers, and this layer has the same type, offset and size and either
+  /// presents the same backing store or the same platform view with the same
+  /// mutations. If this is set for all layers, the embedder may keep
+  /// its composition of the previous frame and only update the contents of the
+  /// backing stores.
+  ///
+  /// On ABI stability: Embedders that may be used with engines older than the
+  /// version whose headers they were compiled with must only read this field
+  /// if `FlutterLayer.struct_size` covers it.
+  bool unchanged_since_last_frame;
 } FlutterLayer;
 
 typedef bool (*FlutterBackingStoreCreateCallback)(
@@ -1094,6 +1461,21 @@ typedef bool (*FlutterLayersPresentCallback)(const FlutterLayer** layers,
                                              size_t layers_count,
                                              void* user_data);
 
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterPresentViewInfo).
+  size_t struct_size;
+  /// The view the layers are presented in.
+  FlutterViewId view_id;
+  /// The layers of the view, in composition order.
+  const FlutterLayer** layers;
+  /// The number of layers.
+  size_t layers_count;
+  /// The `FlutterCompositor.user_data`.
+  void* user_data;
+} FlutterPresentViewInfo;
+
+typedef bool (*FlutterPresentViewCallback)(const FlutterPresentViewInfo* info);
+
 typedef struct {
   /// This size of this struct. Must be sizeof(FlutterCompositor).
   size_t struct_size;
@@ -1114,10 +1496,26 @@ typedef struct {
   /// embedder may collect any resources associated with the backing store.
   FlutterBackingStoreCollectCallback collect_backing_store_callback;
   /// Callback invoked by the engine to composite the contents of each layer
-  /// onto the screen.
+  /// onto the screen. Either this or `present_view_callback` must be
+  /// specified. Only the layers of `kFlutterImplicitViewId` are presented to
+  /// this callback.
   FlutterLayersPresentCallback present_layers_callback;
   /// Avoid caching backing stores provided by this compositor.
   bool avoid_backing_store_cache;
+  /// The number of frames a backing store may go unused before it is handed
+  /// back to `FlutterCompositor.collect_backing_store_callback`. Cached
+  /// backing stores are reused for any layer of the same size, so holding
+  /// them for a few frames avoids creating and collecting backing stores
+  /// while the number of layers changes, for example when scrolling through
+  /// platform views. A value of 0 is treated as 1, which only reuses backing
+  /// stores that were used in the previous frame. Ignored if
+  /// `FlutterCompositor.avoid_backing_store_cache` is set.
+  size_t backing_store_cache_frames;
+  /// Callback invoked by the engine to composite the contents of each layer of
+  /// a view onto the screen. It is invoked once for every view that was
+  /// rendered in a frame, in the same order as the views were rendered. It
+  /// takes precedence over `present_layers_callback`.
+  FlutterPresentViewCallback present_view_callback;
 } FlutterCompositor;
 
 typedef struct {
@@ -1176,8 +1574,103 @@ typedef struct {
   /// This represents the refresh period in frames per second. This value may be
   /// zero if the device is not running or unavailable or unknown.
   double refresh_rate;
+
+  /// The lowest and highest refresh rates in frames per second that a
+  /// variable refresh rate display can switch to. Both are zero if the display
+  /// has a fixed refresh rate of `refresh_rate`.
+  double min_refresh_rate;
+  double max_refresh_rate;
 } FlutterEngineDisplay;
 
+/// The range of frame rates, in frames per second, that the framework asks
+/// its frames to be shown at, passed to the `frame_rate_range_callback` of
+/// `FlutterProjectArgs`. The range is all zero when the framework no longer
+/// has a preference, in which case the display can return to its default
+/// refresh rate.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameRateRange).
+  size_t struct_size;
+  double minimum;
+  double maximum;
+  double preferred;
+} FlutterFrameRateRange;
+
+typedef void (*FlutterFrameRateRangeCallback)(
+    const FlutterFrameRateRange* /* frame rate range */,
+    void* /* user data */);
+
+/// The distribution of the durations of one phase of the frames rasterized by
+/// the engine. All durations are in nanoseconds.
+typedef struct {
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  uint64_t max;
+} FlutterFrameTimePercentiles;
+
+/// Filled in by `FlutterEngineGetFrameTimingStatistics`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimingStatistics).
+  size_t struct_size;
+  /// The number of frames the statistics cover.
+  uint64_t frame_count;
+  /// The number of frames whose build phase alone took longer than the frame
+  /// budget of the display.
+  uint64_t janky_build_frame_count;
+  /// The number of frames whose raster phase alone took longer than the frame
+  /// budget of the display.
+  uint64_t janky_raster_frame_count;
+  /// The time from the vsync to the start of building the frame on the UI
+  /// thread.
+  FlutterFrameTimePercentiles vsync_overhead;
+  /// The time taken to build the frame on the UI thread.
+  FlutterFrameTimePercentiles build;
+  /// The time taken to rasterize the frame on the raster thread.
+  FlutterFrameTimePercentiles raster;
+  /// The time from flushing the frame to the GPU until the GPU finished it,
+  /// of the frames for which it is known. This is all zero if the renderer
+  /// does not report it, such as for software rendering.
+  FlutterFrameTimePercentiles gpu;
+} FlutterFrameTimingStatistics;
+
+/// The timings of one frame rasterized by the engine, passed to the
+/// `frame_timings_callback` of `FlutterProjectArgs`. The time points are in
+/// nanoseconds on the clock of `FlutterEngineGetCurrentTime` and the durations
+/// are in nanoseconds.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTiming).
+  size_t struct_size;
+  /// The time of the vsync that started the frame.
+  uint64_t vsync_start;
+  /// The time the UI thread started building the frame.
+  uint64_t build_start;
+  /// The time the UI thread finished building the frame.
+  uint64_t build_finish;
+  /// The time the raster thread started rasterizing the frame.
+  uint64_t raster_start;
+  /// The time the raster thread finished rasterizing the frame.
+  uint64_t raster_finish;
+  /// The time taken to preroll the layer tree of the frame.
+  uint64_t preroll_duration;
+  /// The time taken to paint the layer tree of the frame.
+  uint64_t paint_duration;
+  /// The time taken to flush the drawing commands of the frame to the GPU.
+  uint64_t flush_duration;
+  /// The time taken to present the frame.
+  uint64_t present_duration;
+  /// The GPU time of the latest frame that finished on the GPU by the time
+  /// this frame was rasterized, which is usually not this frame itself. Zero if
+  /// the renderer does not report it, such as for software rendering.
+  uint64_t gpu_duration;
+} FlutterFrameTiming;
+
+/// Callback for the timings of rasterized frames. The timings are only valid
+/// for the duration of the callback.
+typedef void (*FlutterFrameTimingsCallback)(
+    const FlutterFrameTiming* /* timings */,
+    size_t /* timings count */,
+    void* /* user data */);
+
 /// The update type parameter that is passed to
 /// `FlutterEngineNotifyDisplayUpdate`.
 typedef enum {
@@ -1187,6 +1680,10 @@ typedef enum {
   ///    2. The display is drawable, e.g. it isn't being mirrored from another
   ///    connected display or sleeping.
   kFlutterEngineDisplaysUpdateTypeStartup,
+  /// All the active `FlutterEngineDisplay`s, after a display was connected or
+  /// disconnected or the refresh rate of one changed. The list replaces the
+  /// displays previously reported.
+  kFlutterEngineDisplaysUpdateTypeConfigurationChanged,
   kFlutterEngineDisplaysUpdateTypeCount,
 } FlutterEngineDisplaysUpdateType;
 
@@ -1288,6 +1785,20 @@ typedef enum {
 typedef void (*FlutterNativeThreadCallback)(FlutterNativeThreadType type,
                                             void* user_data);
 
+/// How urgently the embedder asks the engine to release memory in
+/// `FlutterEngineNotifyMemoryPressure`.
+typedef enum {
+  /// The system is running low on memory while the application is in use. The
+  /// engine trims its caches but keeps enough to avoid re-rendering stalls.
+  kFlutterMemoryPressureLevelModerate,
+  /// The system is about to reclaim memory by killing processes. The engine
+  /// releases everything that it can recreate and collects Dart garbage.
+  kFlutterMemoryPressureLevelCritical,
+  /// The application is no longer visible. The engine releases its rendering
+  /// caches, as it does not need them until the application is visible again.
+  kFlutterMemoryPressureLevelBackground,
+} FlutterMemoryPressureLevel;
+
 /// AOT data source type.
 typedef enum {
   kFlutterEngineAOTDataSourceTypeElfPath
@@ -1431,6 +1942,9 @@ typedef struct {
   /// Flutter application (such as compiled shader programs used by Skia).
   /// This is optional.  The string must be NULL terminated.
   ///
+  /// The cache is shared by all the engines of the process, so only the path
+  /// of the first engine that is run applies.
+  ///
   // This is different from the cache-path-dir argument defined in switches.h,
   // which is used in `flutter::Settings` as `temp_directory_path`.
   const char* persistent_cache_path;
@@ -1551,8 +2065,38 @@ typedef struct {
   // or component name to embedder's logger. This string will be passed to to
   // callbacks on `log_message_callback`. Defaults to "flutter" if unspecified.
   const char* log_tag;
+
+  /// The priorities, CPU affinities and stack sizes of the threads that the
+  /// engine creates and manages. May be NULL, in which case the threads are
+  /// created with the defaults of the platform.
+  const FlutterEngineThreadConfigs* thread_configs;
+
+  /// An optional callback that is invoked with the timings of the frames
+  /// rasterized by the engine, without any involvement of the Dart code. The
+  /// timings are batched like the ones reported to
+  /// `PlatformDispatcher.onReportTimings`: the first frame is reported right
+  /// away and the subsequent ones at most every second (100ms in debug and
+  /// profile modes) or every 100 frames. This callback is invoked on the
+  /// raster thread and must not block.
+  FlutterFrameTimingsCallback frame_timings_callback;
+
+  /// An optional callback that is invoked on the platform thread when the
+  /// range of frame rates the framework asks for changes. Embedders of
+  /// variable refresh rate displays can use it to switch the display the view
+  /// is on to a rate in the range.
+  FlutterFrameRateRangeCallback frame_rate_range_callback;
 } FlutterProjectArgs;
 
+/// Callback for when the engine has precompiled the shaders it knows of.
+typedef void (*FlutterShaderPrecompileCallback)(
+    size_t /* precompiled shader count */,
+    void* /* user data */);
+
+/// Callback for when the engine has exported its shaders to a bundle.
+typedef void (*FlutterShaderBundleCallback)(const uint8_t* /* bundle */,
+                                            size_t /* bundle size */,
+                                            void* /* user data */);
+
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
 
 //------------------------------------------------------------------------------
@@ -1738,6 +2282,31 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a batch of platform messages to the running Flutter
+///             application. This is equivalent to calling
+///             `FlutterEngineSendPlatformMessage` for each message in order,
+///             but the whole batch is delivered to the root isolate in a single
+///             task on the UI task runner. Embedders that send many small
+///             messages at a high rate should prefer this call.
+///
+///             The messages are copied before this call returns. If any message
+///             in the batch is invalid, none of them are sent.
+///
+/// @param[in]  engine          A running engine instance.
+/// @param[in]  messages        The messages to send. The next message is
+///                             located `struct_size` bytes after the current
+///                             one.
+/// @param[in]  messages_count  The number of messages to send.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessages(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* messages,
+    size_t messages_count);
+
 //------------------------------------------------------------------------------
 /// @brief     Creates a platform message response handle that allows the
 ///            embedder to set a native callback for a response to a message.
@@ -1811,6 +2380,75 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
     const uint8_t* data,
     size_t data_length);
 
+//------------------------------------------------------------------------------
+/// @brief      Send a response from the native side to a platform message from
+///             the Dart Flutter application without copying the response
+///             data. The data must stay valid until the engine calls
+///             `release_callback`, which may happen on any thread.
+///
+/// @see        FlutterEngineSendPlatformMessageResponse()
+///
+/// @param[in]  engine             The running engine instance.
+/// @param[in]  handle             The platform message response handle.
+/// @param[in]  data               The data to associate with the platform
+///                                message response.
+/// @param[in]  data_length        The length of the platform message response
+///                                data.
+/// @param[in]  release_callback   Called when the engine no longer uses the
+///                                data. It is also called if the call fails,
+///                                and when there is no data.
+/// @param[in]  release_user_data  The user data baton passed to
+///                                `release_callback`.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* release_user_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Takes the ownership of the data of a platform message from the
+///             Dart Flutter application, so that it can be used without
+///             copying it after the response to the message was sent. The
+///             data is the one `FlutterPlatformMessage::message` points to
+///             and must be released with
+///             `FlutterPlatformMessageReleaseData`.
+///
+/// @see        FlutterPlatformMessageReleaseData()
+///
+/// @param[in]  engine    A running engine instance.
+/// @param[in]  handle    The response handle of the platform message, before
+///                       the response was sent.
+/// @param[out] data_out  The data of the platform message.
+///
+/// @return     The result of the call. Fails if the message has no data or if
+///             its data was already taken.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterPlatformMessageTakeData(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    uint8_t** data_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Releases the data of a platform message taken with
+///             `FlutterPlatformMessageTakeData`. May be called on any thread,
+///             also after the engine it was taken from was shut down.
+///
+/// @see        FlutterPlatformMessageTakeData()
+///
+/// @param[in]  data    The data to release.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterPlatformMessageReleaseData(uint8_t* data);
+
 //------------------------------------------------------------------------------
 /// @brief      This API is only meant to be used by platforms that need to
 ///             flush tasks on a message loop not controlled by the Flutter
@@ -1886,6 +2524,30 @@ FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     int64_t texture_identifier);
 
+//------------------------------------------------------------------------------
+/// @brief      Mark that new texture frames are available for a number of
+///             textures. This is equivalent to calling
+///             `FlutterEngineMarkExternalTextureFrameAvailable` for each of
+///             them, but cheaper for embedders that update many textures at
+///             once. Independent of this, all textures marked before the next
+///             frame is drawn only schedule one frame.
+///
+/// @see        FlutterEngineMarkExternalTextureFrameAvailable()
+///
+/// @param[in]  engine               A running engine instance.
+/// @param[in]  texture_identifiers  The identifiers of the textures whose
+///                                  frames have been updated.
+/// @param[in]  texture_identifiers_count
+///                                  The number of texture identifiers.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineMarkExternalTexturesFrameAvailable(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const int64_t* texture_identifiers,
+    size_t texture_identifiers_count);
+
 //------------------------------------------------------------------------------
 /// @brief      Enable or disable accessibility semantics.
 ///
@@ -2157,6 +2819,29 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 
+//------------------------------------------------------------------------------
+/// @brief      Posts a memory pressure notification of the given level to a
+///             running engine instance. Unlike
+///             `FlutterEngineNotifyLowMemoryWarning`, which is the same as a
+///             notification of critical pressure, this lets the engine keep
+///             the resources that it needs to keep rendering without stalls
+///             under moderate pressure.
+///
+///             As with `FlutterEngineNotifyLowMemoryWarning`, the resources
+///             may not have been collected by the time this call returns and
+///             Flutter applications are notified as well.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  level      The level of the memory pressure.
+///
+/// @return     If the memory pressure notification was sent to the running
+///             engine instance.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineNotifyMemoryPressure(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterMemoryPressureLevel level);
+
 //------------------------------------------------------------------------------
 /// @brief      Schedule a callback to be run on all engine managed threads.
 ///             The engine will attempt to service this callback the next time
@@ -2201,7 +2886,9 @@ FlutterEngineResult FlutterEnginePostCallbackOnAllNativeThreads(
 ///           instance.
 ///
 /// @param[in] update_type      The type of update pushed to the engine.
-/// @param[in] displays         The displays affected by this update.
+/// @param[in] displays         The displays affected by this update. The
+///                             displays are `displays->struct_size` bytes
+///                             apart.
 /// @param[in] display_count    Size of the displays array, must be at least 1.
 ///
 /// @return the result of the call made to the engine.
@@ -2213,6 +2900,115 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
     const FlutterEngineDisplay* displays,
     size_t display_count);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the percentiles of the build, raster and vsync overhead
+///             times of the frames rasterized since the engine was started or
+///             since the statistics were last reset, along with the number of
+///             janky frames. This lets embedders monitor frame performance
+///             without a per-frame callback. May be called on any thread.
+///
+///             Percentiles are estimated from a histogram and may be up to 10%
+///             larger than the exact value, but never larger than the maximum.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[in]  reset       Whether to start collecting from scratch after the
+///                         statistics were read, so that periodic callers get
+///                         the statistics of the frames since their last call.
+/// @param[out] statistics  The statistics, whose struct_size must be set.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameTimingStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    bool reset,
+    FlutterFrameTimingStatistics* statistics);
+
+//------------------------------------------------------------------------------
+/// @brief      Adds a bundle of SkSL shaders to the ones the engine knows of,
+///             for instance one shipped with the application that was
+///             exported by `FlutterEngineExportShaderBundle` on the target
+///             device. The bundle is in the JSON format of the
+///             `io.flutter.shaders.json` asset produced by
+///             `flutter build --bundle-sksl-path`. Precompile the shaders with
+///             `FlutterEnginePrecompileShaders`.
+///
+///             The shaders are shared by all the engines of the process.
+///
+/// @param[in]  engine       A running engine instance.
+/// @param[in]  bundle       The bundle. It is copied by the engine.
+/// @param[in]  bundle_size  The size of the bundle in bytes.
+///
+/// @return     The result of the call. `kInvalidArguments` if the bundle could
+///             not be parsed.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineAddShaderBundle(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const uint8_t* bundle,
+    size_t bundle_size);
+
+//------------------------------------------------------------------------------
+/// @brief      Precompiles the SkSL shaders the engine knows of in the context
+///             of its surface, so that the first frames that use them do not
+///             stall on shader compilation. These are the shaders gathered
+///             during previous runs, the ones of the `io.flutter.shaders.json`
+///             asset and the ones added by `FlutterEngineAddShaderBundle`.
+///
+///             The shaders are precompiled on the raster thread, so this is
+///             best called before the first frame is rendered. They must be
+///             precompiled again if the surface is recreated.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  callback   An optional callback invoked on the raster thread
+///                        with the number of precompiled shaders.
+/// @param[in]  user_data  A baton passed to the callback.
+///
+/// @return     If the precompilation was scheduled.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEnginePrecompileShaders(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterShaderPrecompileCallback callback,
+    void* user_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Exports the SkSL shaders the engine knows of to a bundle that
+///             can be shipped with the next build of the application and
+///             passed to `FlutterEngineAddShaderBundle`. Shaders are only
+///             gathered at runtime if the engine runs with the `--cache-sksl`
+///             switch.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  callback   The callback invoked on the IO thread with the
+///                        bundle. The bundle is only valid for the duration
+///                        of the callback.
+/// @param[in]  user_data  A baton passed to the callback.
+///
+/// @return     If the export was scheduled.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineExportShaderBundle(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterShaderBundleCallback callback,
+    void* user_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Starts the Dart VM service of an engine that was launched with
+///             the `--lazy-observatory-startup` switch, for example when a
+///             developer asks to connect to it. The service isolate starts
+///             asynchronously and its URI is reported like when it starts
+///             with the VM. Does nothing if the service has started already or
+///             the engine runs in release mode.
+///
+/// @param[in]  engine     A running engine instance.
+///
+/// @return     If the startup of the service was requested.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineStartObservatory(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -2254,6 +3050,10 @@ typedef FlutterEngineResult (*FlutterEngineSendKeyEventFnPtr)(
 typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
+typedef FlutterEngineResult (*FlutterEngineSendPlatformMessagesFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* messages,
+    size_t messages_count);
 typedef FlutterEngineResult (
     *FlutterEnginePlatformMessageCreateResponseHandleFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -2329,6 +3129,46 @@ typedef FlutterEngineResult (*FlutterEngineNotifyDisplayUpdateFnPtr)(
     FlutterEngineDisplaysUpdateType update_type,
     const FlutterEngineDisplay* displays,
     size_t display_count);
+typedef FlutterEngineResult (*FlutterEngineGetFrameTimingStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    bool reset,
+    FlutterFrameTimingStatistics* statistics);
+typedef FlutterEngineResult (*FlutterEngineAddShaderBundleFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const uint8_t* bundle,
+    size_t bundle_size);
+typedef FlutterEngineResult (*FlutterEnginePrecompileShadersFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterShaderPrecompileCallback callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineExportShaderBundleFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterShaderBundleCallback callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineNotifyMemoryPressureFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterMemoryPressureLevel level);
+typedef FlutterEngineResult (*FlutterEngineStartObservatoryFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine);
+typedef FlutterEngineResult (
+    *FlutterEngineMarkExternalTexturesFrameAvailableFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const int64_t* texture_identifiers,
+    size_t texture_identifiers_count);
+typedef FlutterEngineResult (
+    *FlutterEngineSendPlatformMessageResponseNoCopyFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* release_user_data);
+typedef FlutterEngineResult (*FlutterPlatformMessageTakeDataFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    uint8_t** data_out);
+typedef FlutterEngineResult (*FlutterPlatformMessageReleaseDataFnPtr)(
+    uint8_t* data);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2373,6 +3213,19 @@ typedef struct {
   FlutterEnginePostCallbackOnAllNativeThreadsFnPtr
       PostCallbackOnAllNativeThreads;
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
+  FlutterEngineSendPlatformMessagesFnPtr SendPlatformMessages;
+  FlutterEngineGetFrameTimingStatisticsFnPtr GetFrameTimingStatistics;
+  FlutterEngineNotifyMemoryPressureFnPtr NotifyMemoryPressure;
+  FlutterEngineAddShaderBundleFnPtr AddShaderBundle;
+  FlutterEnginePrecompileShadersFnPtr PrecompileShaders;
+  FlutterEngineExportShaderBundleFnPtr ExportShaderBundle;
+  FlutterEngineStartObservatoryFnPtr StartObservatory;
+  FlutterEngineMarkExternalTexturesFrameAvailableFnPtr
+      MarkExternalTexturesFrameAvailable;
+  FlutterEngineSendPlatformMessageResponseNoCopyFnPtr
+      SendPlatformMessageResponseNoCopy;
+  FlutterPlatformMessageTakeDataFnPtr PlatformMessageTakeData;
+  FlutterPlatformMessageReleaseDataFnPtr PlatformMessageReleaseData;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
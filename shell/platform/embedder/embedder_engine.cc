@@ -158,6 +158,21 @@ bool EmbedderEngine::SendPlatformMessage(
   return true;
 }
 
+bool EmbedderEngine::SendPlatformMessages(
+    std::vector<fml::RefPtr<flutter::PlatformMessage>> messages) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  auto platform_view = shell_->GetPlatformView();
+  if (!platform_view) {
+    return false;
+  }
+
+  platform_view->DispatchPlatformMessages(std::move(messages));
+  return true;
+}
+
 bool EmbedderEngine::RegisterTexture(int64_t texture) {
   if (!IsValid()) {
     return false;
@@ -183,6 +198,18 @@ bool EmbedderEngine::MarkTextureFrameAvailable(int64_t texture) {
   return true;
 }
 
+bool EmbedderEngine::MarkTexturesFrameAvailable(const int64_t* textures,
+                                                size_t count) {
+  if (!IsValid()) {
+    return false;
+  }
+  auto platform_view = shell_->GetPlatformView();
+  for (size_t i = 0; i < count; i++) {
+    platform_view->MarkTextureFrameAvailable(textures[i]);
+  }
+  return true;
+}
+
 bool EmbedderEngine::SetSemanticsEnabled(bool enabled) {
   if (!IsValid()) {
     return false;
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/shell.h"
@@ -70,12 +71,17 @@ class EmbedderEngine {
 
   bool SendPlatformMessage(fml::RefPtr<flutter::PlatformMessage> message);
 
+  bool SendPlatformMessages(
+      std::vector<fml::RefPtr<flutter::PlatformMessage>> messages);
+
   bool RegisterTexture(int64_t texture);
 
   bool UnregisterTexture(int64_t texture);
 
   bool MarkTextureFrameAvailable(int64_t texture);
 
+  bool MarkTexturesFrameAvailable(const int64_t* textures, size_t count);
+
   bool SetSemanticsEnabled(bool enabled);
 
   bool SetAccessibilityFeatures(int32_t flags);
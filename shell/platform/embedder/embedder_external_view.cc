@@ -4,7 +4,6 @@
 
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
 #include "flutter/fml/trace_event.h"
-#include "flutter/shell/common/canvas_spy.h"
 
 namespace flutter {
 
@@ -30,20 +29,13 @@ EmbedderExternalView::EmbedderExternalView(
       surface_transformation_(surface_transformation),
       view_identifier_(view_identifier),
       embedded_view_params_(std::move(params)),
-      recorder_(std::make_unique<SkPictureRecorder>()),
-      canvas_spy_(std::make_unique<CanvasSpy>(
-          recorder_->beginRecording(frame_size.width(), frame_size.height()))) {
-}
+      recorder_(std::make_unique<DisplayListCanvasRecorder>(
+          SkRect::Make(frame_size))) {}
 
 EmbedderExternalView::~EmbedderExternalView() = default;
 
-EmbedderExternalView::RenderTargetDescriptor
-EmbedderExternalView::CreateRenderTargetDescriptor() const {
-  return {view_identifier_, render_surface_size_};
-}
-
 SkCanvas* EmbedderExternalView::GetCanvas() const {
-  return canvas_spy_->GetSpyingCanvas();
+  return recorder_.get();
 }
 
 SkISize EmbedderExternalView::GetRenderSurfaceSize() const {
@@ -59,7 +51,7 @@ bool EmbedderExternalView::HasPlatformView() const {
 }
 
 bool EmbedderExternalView::HasEngineRenderedContents() const {
-  return canvas_spy_->DidDrawIntoCanvas();
+  return recorder_->did_draw();
 }
 
 EmbedderExternalView::ViewIdentifier EmbedderExternalView::GetViewIdentifier()
@@ -78,10 +70,7 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
       << "Unnecessarily asked to render into a render target when there was "
          "nothing to render.";
 
-  auto picture = recorder_->finishRecordingAsPicture();
-  if (!picture) {
-    return false;
-  }
+  auto display_list = recorder_->Build();
 
   auto surface = render_target.GetRenderSurface();
   if (!surface) {
@@ -98,7 +87,11 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
 
   canvas->setMatrix(surface_transformation_);
   canvas->clear(SK_ColorTRANSPARENT);
-  canvas->drawPicture(picture);
+  // Operations outside of what the view drew into, like the parts of a
+  // full screen clip an overlay only partly covers, are skipped. The bounds
+  // are rounded out so that the pixels the draws only partly cover are kept.
+  canvas->clipRect(SkRect::Make(recorder_->draw_bounds().roundOut()));
+  display_list->RenderTo(canvas);
   canvas->flush();
 
   return true;
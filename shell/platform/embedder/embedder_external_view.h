@@ -9,12 +9,11 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
-#include "flutter/shell/common/canvas_spy.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
-#include "third_party/skia/include/core/SkPictureRecorder.h"
 
 namespace flutter {
 
@@ -46,33 +45,6 @@ class EmbedderExternalView {
     };
   };
 
-  struct RenderTargetDescriptor {
-    ViewIdentifier view_identifier;
-    SkISize surface_size;
-
-    RenderTargetDescriptor(ViewIdentifier p_view_identifier,
-                           SkISize p_surface_size)
-        : view_identifier(p_view_identifier), surface_size(p_surface_size) {}
-
-    struct Hash {
-      constexpr std::size_t operator()(
-          const RenderTargetDescriptor& desc) const {
-        return fml::HashCombine(desc.surface_size.width(),
-                                desc.surface_size.height(),
-                                ViewIdentifier::Hash{}(desc.view_identifier));
-      }
-    };
-
-    struct Equal {
-      bool operator()(const RenderTargetDescriptor& lhs,
-                      const RenderTargetDescriptor& rhs) const {
-        return lhs.surface_size == rhs.surface_size &&
-               ViewIdentifier::Equal{}(lhs.view_identifier,
-                                       rhs.view_identifier);
-      }
-    };
-  };
-
   using ViewIdentifierSet = std::unordered_set<ViewIdentifier,
                                                ViewIdentifier::Hash,
                                                ViewIdentifier::Equal>;
@@ -102,8 +74,6 @@ class EmbedderExternalView {
 
   const EmbeddedViewParams* GetEmbeddedViewParams() const;
 
-  RenderTargetDescriptor CreateRenderTargetDescriptor() const;
-
   SkCanvas* GetCanvas() const;
 
   SkISize GetRenderSurfaceSize() const;
@@ -115,8 +85,7 @@ class EmbedderExternalView {
   const SkMatrix surface_transformation_;
   ViewIdentifier view_identifier_;
   std::unique_ptr<EmbeddedViewParams> embedded_view_params_;
-  std::unique_ptr<SkPictureRecorder> recorder_;
-  std::unique_ptr<CanvasSpy> canvas_spy_;
+  std::unique_ptr<DisplayListCanvasRecorder> recorder_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalView);
 };
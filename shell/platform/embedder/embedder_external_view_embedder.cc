@@ -6,6 +6,7 @@
 
 #include <algorithm>
 
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/platform/embedder/embedder_layers.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
@@ -14,9 +15,11 @@ namespace flutter {
 
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
+    size_t backing_store_cache_frames,
     const CreateRenderTargetCallback& create_render_target_callback,
     const PresentCallback& present_callback)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
+      backing_store_cache_frames_(backing_store_cache_frames),
       create_render_target_callback_(create_render_target_callback),
       present_callback_(present_callback) {
   FML_DCHECK(create_render_target_callback_);
@@ -41,6 +44,25 @@ SkMatrix EmbedderExternalViewEmbedder::GetSurfaceTransformation() const {
 void EmbedderExternalViewEmbedder::Reset() {
   pending_views_.clear();
   composition_order_.clear();
+  pending_flutter_view_id_ = kFlutterImplicitViewId;
+}
+
+EmbedderRenderTargetCache&
+EmbedderExternalViewEmbedder::GetRenderTargetCache() {
+  auto& cache = render_target_caches_[pending_flutter_view_id_];
+  if (!cache) {
+    cache =
+        std::make_unique<EmbedderRenderTargetCache>(backing_store_cache_frames_);
+  }
+  return *cache;
+}
+
+EmbedderLayers& EmbedderExternalViewEmbedder::GetPresentedLayers() {
+  auto& layers = presented_layers_[pending_flutter_view_id_];
+  if (!layers) {
+    layers = std::make_unique<EmbedderLayers>();
+  }
+  return *layers;
 }
 
 // |ExternalViewEmbedder|
@@ -68,6 +90,11 @@ void EmbedderExternalViewEmbedder::BeginFrame(
   composition_order_.push_back(kRootViewIdentifier);
 }
 
+// |ExternalViewEmbedder|
+void EmbedderExternalViewEmbedder::SetFlutterViewId(int64_t flutter_view_id) {
+  pending_flutter_view_id_ = flutter_view_id;
+}
+
 // |ExternalViewEmbedder|
 void EmbedderExternalViewEmbedder::PrerollCompositeEmbeddedView(
     int view_id,
@@ -137,8 +164,9 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
     GrDirectContext* context,
     std::unique_ptr<SurfaceFrame> frame,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch) {
+  auto& render_target_cache = GetRenderTargetCache();
   auto [matched_render_targets, pending_keys] =
-      render_target_cache_.GetExistingTargetsInCache(pending_views_);
+      render_target_cache.GetExistingTargetsInCache(pending_views_);
 
   // This is where unused render targets will be collected. Control may flow to
   // the embedder. Here, the embedder has the opportunity to trample on the
@@ -153,7 +181,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache_.ClearAllRenderTargetsInCache();
+      render_target_cache.EvictUnusedRenderTargets();
 
   for (const auto& pending_key : pending_keys) {
     const auto& external_view = pending_views_.at(pending_key);
@@ -224,9 +252,9 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   {
-    EmbedderLayers presented_layers(pending_frame_size_,
-                                    pending_device_pixel_ratio_,
-                                    pending_surface_transformation_);
+    auto& presented_layers = GetPresentedLayers();
+    presented_layers.Reset(pending_frame_size_, pending_device_pixel_ratio_,
+                           pending_surface_transformation_);
     // In composition order, submit backing stores and platform views to the
     // embedder.
     for (const auto& view_id : composition_order_) {
@@ -254,7 +282,10 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
     // Flush the layer description down to the embedder for presentation.
     //
     // @warning: Embedder may trample on our OpenGL context here.
-    presented_layers.InvokePresentCallback(present_callback_);
+    presented_layers.InvokePresentCallback(
+        [&](const std::vector<const FlutterLayer*>& layers) {
+          return present_callback_(pending_flutter_view_id_, layers);
+        });
   }
 
   // See why this is necessary in the comment where this collection in realized.
@@ -262,15 +293,26 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // @warning: Embedder may trample on our OpenGL context here.
   deferred_cleanup_render_targets.clear();
 
-  // Hold all rendered layers in the render target cache for one frame to
-  // see if they may be reused next frame.
+  // Hold all rendered layers in the render target cache to see if they may be
+  // reused in one of the next frames.
   for (auto& render_target : matched_render_targets) {
     if (!avoid_backing_store_cache_) {
-      render_target_cache_.CacheRenderTarget(render_target.first,
+      render_target_cache.CacheRenderTarget(render_target.first,
                                              std::move(render_target.second));
     }
   }
 
+#if !FLUTTER_RELEASE
+  const auto& stats = render_target_cache.GetStats();
+  FML_TRACE_COUNTER("flutter", "EmbedderRenderTargetCache",
+                    reinterpret_cast<int64_t>(&render_target_cache),
+                    "CachedTargets",
+                    render_target_cache.GetCachedTargetsCount(),
+                    "ReusedTargets", stats.reused_targets, "MissedTargets",
+                    stats.missed_targets, "EvictedTargets",
+                    stats.evicted_targets);
+#endif  // !FLUTTER_RELEASE
+
   frame->Submit();
 }
 
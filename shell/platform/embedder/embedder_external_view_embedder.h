@@ -8,10 +8,12 @@
 #include <map>
 #include <unordered_map>
 
+#include "flutter/common/constants.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
+#include "flutter/shell/platform/embedder/embedder_layers.h"
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
 namespace flutter {
@@ -33,7 +35,8 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
           GrDirectContext* context,
           const FlutterBackingStoreConfig& config)>;
   using PresentCallback =
-      std::function<bool(const std::vector<const FlutterLayer*>& layers)>;
+      std::function<bool(int64_t flutter_view_id,
+                         const std::vector<const FlutterLayer*>& layers)>;
   using SurfaceTransformationCallback = std::function<SkMatrix(void)>;
 
   //----------------------------------------------------------------------------
@@ -45,16 +48,21 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                      engine composited layer. The result
   ///                                      will not cached.
   ///
+  /// @param[in]  backing_store_cache_frames
+  ///                                     The number of frames an unused
+  ///                                     render target is cached before it is
+  ///                                     collected.
   /// @param[in]  create_render_target_callback
   ///                                     The render target callback used to
   ///                                     request the render target for a layer.
   /// @param[in]  present_callback        The callback used to forward a
   ///                                     collection of layers (backed by
-  ///                                     fulfilled render targets) to the
-  ///                                     embedder for presentation.
+  ///                                     fulfilled render targets) of a view
+  ///                                     to the embedder for presentation.
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
+      size_t backing_store_cache_frames,
       const CreateRenderTargetCallback& create_render_target_callback,
       const PresentCallback& present_callback);
 
@@ -85,6 +93,9 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
       double device_pixel_ratio,
       fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) override;
 
+  // |ExternalViewEmbedder|
+  void SetFlutterViewId(int64_t flutter_view_id) override;
+
   // |ExternalViewEmbedder|
   void PrerollCompositeEmbeddedView(
       int view_id,
@@ -107,6 +118,7 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
 
  private:
   const bool avoid_backing_store_cache_;
+  const size_t backing_store_cache_frames_;
   const CreateRenderTargetCallback create_render_target_callback_;
   const PresentCallback present_callback_;
   SurfaceTransformationCallback surface_transformation_callback_;
@@ -115,12 +127,23 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   SkMatrix pending_surface_transformation_;
   EmbedderExternalView::PendingViews pending_views_;
   std::vector<EmbedderExternalView::ViewIdentifier> composition_order_;
-  EmbedderRenderTargetCache render_target_cache_;
+  int64_t pending_flutter_view_id_ = kFlutterImplicitViewId;
+  // The views of different sizes would evict each others render targets, so
+  // every view has a cache of its own.
+  std::unordered_map<int64_t, std::unique_ptr<EmbedderRenderTargetCache>>
+      render_target_caches_;
+  // The layers presented for every view, which are reused by its next frame.
+  std::unordered_map<int64_t, std::unique_ptr<EmbedderLayers>>
+      presented_layers_;
 
   void Reset();
 
   SkMatrix GetSurfaceTransformation() const;
 
+  EmbedderRenderTargetCache& GetRenderTargetCache();
+
+  EmbedderLayers& GetPresentedLayers();
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalViewEmbedder);
 };
 
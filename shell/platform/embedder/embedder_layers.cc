@@ -5,18 +5,27 @@
 #include "flutter/shell/platform/embedder/embedder_layers.h"
 
 #include <algorithm>
+#include <utility>
 
 namespace flutter {
 
-EmbedderLayers::EmbedderLayers(SkISize frame_size,
-                               double device_pixel_ratio,
-                               SkMatrix root_surface_transformation)
-    : frame_size_(frame_size),
-      device_pixel_ratio_(device_pixel_ratio),
-      root_surface_transformation_(root_surface_transformation) {}
+EmbedderLayers::EmbedderLayers() = default;
 
 EmbedderLayers::~EmbedderLayers() = default;
 
+void EmbedderLayers::Reset(SkISize frame_size,
+                           double device_pixel_ratio,
+                           SkMatrix root_surface_transformation) {
+  frame_size_ = frame_size;
+  device_pixel_ratio_ = device_pixel_ratio;
+  root_surface_transformation_ = root_surface_transformation;
+  presented_layers_.clear();
+  platform_views_.clear();
+  mutations_.clear();
+  mutation_pointers_.clear();
+  platform_view_params_.clear();
+}
+
 void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
   FlutterLayer layer = {};
 
@@ -38,15 +47,15 @@ void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
   presented_layers_.push_back(layer);
 }
 
-static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
+static FlutterPlatformViewMutation ConvertMutation(
     double opacity) {
   FlutterPlatformViewMutation mutation = {};
   mutation.type = kFlutterPlatformViewMutationTypeOpacity;
   mutation.opacity = opacity;
-  return std::make_unique<FlutterPlatformViewMutation>(mutation);
+  return mutation;
 }
 
-static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
+static FlutterPlatformViewMutation ConvertMutation(
     const SkRect& rect) {
   FlutterPlatformViewMutation mutation = {};
   mutation.type = kFlutterPlatformViewMutationTypeClipRect;
@@ -54,7 +63,7 @@ static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
   mutation.clip_rect.top = rect.top();
   mutation.clip_rect.right = rect.right();
   mutation.clip_rect.bottom = rect.bottom();
-  return std::make_unique<FlutterPlatformViewMutation>(mutation);
+  return mutation;
 }
 
 static FlutterSize VectorToSize(const SkVector& vector) {
@@ -64,7 +73,7 @@ static FlutterSize VectorToSize(const SkVector& vector) {
   return size;
 }
 
-static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
+static FlutterPlatformViewMutation ConvertMutation(
     const SkRRect& rrect) {
   FlutterPlatformViewMutation mutation = {};
   mutation.type = kFlutterPlatformViewMutationTypeClipRoundedRect;
@@ -81,10 +90,10 @@ static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
       VectorToSize(rrect.radii(SkRRect::Corner::kLowerRight_Corner));
   mutation.clip_rounded_rect.lower_left_corner_radius =
       VectorToSize(rrect.radii(SkRRect::Corner::kLowerLeft_Corner));
-  return std::make_unique<FlutterPlatformViewMutation>(mutation);
+  return mutation;
 }
 
-static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
+static FlutterPlatformViewMutation ConvertMutation(
     const SkMatrix& matrix) {
   FlutterPlatformViewMutation mutation = {};
   mutation.type = kFlutterPlatformViewMutationTypeTransformation;
@@ -97,87 +106,65 @@ static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
   mutation.transformation.pers0 = matrix[SkMatrix::kMPersp0];
   mutation.transformation.pers1 = matrix[SkMatrix::kMPersp1];
   mutation.transformation.pers2 = matrix[SkMatrix::kMPersp2];
-  return std::make_unique<FlutterPlatformViewMutation>(mutation);
+  return mutation;
 }
 
 void EmbedderLayers::PushPlatformViewLayer(
     FlutterPlatformViewIdentifier identifier,
     const EmbeddedViewParams& params) {
-  {
-    FlutterPlatformView view = {};
-    view.struct_size = sizeof(FlutterPlatformView);
-    view.identifier = identifier;
-
-    const auto& mutators = params.mutatorsStack();
-
-    std::vector<const FlutterPlatformViewMutation*> mutations_array;
-
-    for (auto i = mutators.Bottom(); i != mutators.Top(); ++i) {
-      const auto& mutator = *i;
-      switch (mutator->GetType()) {
-        case MutatorType::clip_rect: {
-          mutations_array.push_back(
-              mutations_referenced_
-                  .emplace_back(ConvertMutation(mutator->GetRect()))
-                  .get());
-        } break;
-        case MutatorType::clip_rrect: {
-          mutations_array.push_back(
-              mutations_referenced_
-                  .emplace_back(ConvertMutation(mutator->GetRRect()))
-                  .get());
-        } break;
-        case MutatorType::clip_path: {
-          // Unsupported mutation.
-        } break;
-        case MutatorType::transform: {
-          const auto& matrix = mutator->GetMatrix();
-          if (!matrix.isIdentity()) {
-            mutations_array.push_back(
-                mutations_referenced_.emplace_back(ConvertMutation(matrix))
-                    .get());
-          }
-        } break;
-        case MutatorType::opacity: {
-          const double opacity =
-              std::clamp(mutator->GetAlphaFloat(), 0.0f, 1.0f);
-          if (opacity < 1.0) {
-            mutations_array.push_back(
-                mutations_referenced_.emplace_back(ConvertMutation(opacity))
-                    .get());
-          }
-        } break;
-      }
+  FlutterPlatformView view = {};
+  view.struct_size = sizeof(FlutterPlatformView);
+  view.identifier = identifier;
+
+  // The mutations are presented from the root to the platform view, the
+  // pointers to them are set in |InvokePresentCallback|.
+  const size_t mutations_start = mutations_.size();
+  const auto& mutators = params.mutatorsStack();
+  for (auto i = mutators.Begin(); i != mutators.End(); ++i) {
+    const auto& mutator = *i;
+    switch (mutator.GetType()) {
+      case MutatorType::clip_rect: {
+        mutations_.push_back(ConvertMutation(mutator.GetRect()));
+      } break;
+      case MutatorType::clip_rrect: {
+        mutations_.push_back(ConvertMutation(mutator.GetRRect()));
+      } break;
+      case MutatorType::clip_path: {
+        // Unsupported mutation.
+      } break;
+      case MutatorType::transform: {
+        const auto& matrix = mutator.GetMatrix();
+        if (!matrix.isIdentity()) {
+          mutations_.push_back(ConvertMutation(matrix));
+        }
+      } break;
+      case MutatorType::opacity: {
+        const double opacity =
+            std::clamp(mutator.GetAlphaFloat(), 0.0f, 1.0f);
+        if (opacity < 1.0) {
+          mutations_.push_back(ConvertMutation(opacity));
+        }
+      } break;
     }
+  }
 
-    if (!mutations_array.empty()) {
-      // If there are going to be any mutations, they must first take into
-      // account the root surface transformation.
-      if (!root_surface_transformation_.isIdentity()) {
-        mutations_array.push_back(
-            mutations_referenced_
-                .emplace_back(ConvertMutation(root_surface_transformation_))
-                .get());
-      }
-
-      auto mutations =
-          std::make_unique<std::vector<const FlutterPlatformViewMutation*>>(
-              mutations_array.rbegin(), mutations_array.rend());
-      mutations_arrays_referenced_.emplace_back(std::move(mutations));
-
-      view.mutations_count = mutations_array.size();
-      view.mutations = mutations_arrays_referenced_.back().get()->data();
+  if (mutations_.size() > mutations_start) {
+    // If there are going to be any mutations, they must first take into
+    // account the root surface transformation.
+    if (!root_surface_transformation_.isIdentity()) {
+      mutations_.insert(mutations_.begin() + mutations_start,
+                        ConvertMutation(root_surface_transformation_));
     }
-
-    platform_views_referenced_.emplace_back(
-        std::make_unique<FlutterPlatformView>(view));
+    view.mutations_count = mutations_.size() - mutations_start;
   }
 
+  platform_views_.push_back(view);
+  platform_view_params_.push_back(params);
+
   FlutterLayer layer = {};
 
   layer.struct_size = sizeof(FlutterLayer);
   layer.type = kFlutterLayerContentTypePlatformView;
-  layer.platform_view = platform_views_referenced_.back().get();
 
   const auto layer_bounds =
       SkRect::MakeXYWH(params.finalBoundingRect().x(),                     //
@@ -197,14 +184,70 @@ void EmbedderLayers::PushPlatformViewLayer(
   presented_layers_.push_back(layer);
 }
 
-void EmbedderLayers::InvokePresentCallback(
-    const PresentCallback& callback) const {
-  std::vector<const FlutterLayer*> presented_layers_pointers;
-  presented_layers_pointers.reserve(presented_layers_.size());
-  for (const auto& layer : presented_layers_) {
-    presented_layers_pointers.push_back(&layer);
+bool EmbedderLayers::IsUnchangedSinceLastFrame(size_t index) const {
+  // A layer that was added or removed uncovers or covers the layers below it,
+  // so then none of the layers count as unchanged.
+  if (frame_size_ != last_frame_size_ ||
+      root_surface_transformation_ != last_root_surface_transformation_ ||
+      presented_layers_.size() != last_presented_layers_.size()) {
+    return false;
+  }
+  const FlutterLayer& layer = presented_layers_[index];
+  const FlutterLayer& last_layer = last_presented_layers_[index];
+  if (layer.type != last_layer.type ||
+      layer.offset.x != last_layer.offset.x ||
+      layer.offset.y != last_layer.offset.y ||
+      layer.size.width != last_layer.size.width ||
+      layer.size.height != last_layer.size.height) {
+    return false;
+  }
+  switch (layer.type) {
+    case kFlutterLayerContentTypeBackingStore:
+      return layer.backing_store == last_layer.backing_store;
+    case kFlutterLayerContentTypePlatformView: {
+      const size_t view_index = layer.platform_view - platform_views_.data();
+      const size_t last_view_index =
+          last_layer.platform_view - last_platform_views_.data();
+      return layer.platform_view->identifier ==
+                 last_layer.platform_view->identifier &&
+             platform_view_params_[view_index] ==
+                 last_platform_view_params_[last_view_index];
+    }
+  }
+  return false;
+}
+
+void EmbedderLayers::InvokePresentCallback(const PresentCallback& callback) {
+  for (const auto& mutation : mutations_) {
+    mutation_pointers_.push_back(&mutation);
   }
-  callback(std::move(presented_layers_pointers));
+  size_t mutations_start = 0;
+  for (auto& view : platform_views_) {
+    if (view.mutations_count > 0) {
+      view.mutations = mutation_pointers_.data() + mutations_start;
+      mutations_start += view.mutations_count;
+    }
+  }
+
+  presented_layer_pointers_.clear();
+  size_t view_index = 0;
+  for (size_t i = 0; i < presented_layers_.size(); i++) {
+    FlutterLayer& layer = presented_layers_[i];
+    if (layer.type == kFlutterLayerContentTypePlatformView) {
+      layer.platform_view = &platform_views_[view_index++];
+    }
+    layer.unchanged_since_last_frame = IsUnchangedSinceLastFrame(i);
+    presented_layer_pointers_.push_back(&layer);
+  }
+
+  callback(presented_layer_pointers_);
+
+  // The storage of the frame before the last one is reused by the next frame.
+  last_frame_size_ = frame_size_;
+  last_root_surface_transformation_ = root_surface_transformation_;
+  std::swap(presented_layers_, last_presented_layers_);
+  std::swap(platform_views_, last_platform_views_);
+  std::swap(platform_view_params_, last_platform_view_params_);
 }
 
 }  // namespace flutter
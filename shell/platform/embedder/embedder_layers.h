@@ -16,14 +16,20 @@
 
 namespace flutter {
 
+// Converts the layers of a frame of a view into the structures that are
+// presented to the embedder. The structures are reused from frame to frame, so
+// an instance should be kept for every view.
 class EmbedderLayers {
  public:
-  EmbedderLayers(SkISize frame_size,
-                 double device_pixel_ratio,
-                 SkMatrix root_surface_transformation);
+  EmbedderLayers();
 
   ~EmbedderLayers();
 
+  // Starts collecting the layers of the next frame.
+  void Reset(SkISize frame_size,
+             double device_pixel_ratio,
+             SkMatrix root_surface_transformation);
+
   void PushBackingStoreLayer(const FlutterBackingStore* store);
 
   void PushPlatformViewLayer(FlutterPlatformViewIdentifier identifier,
@@ -31,18 +37,32 @@ class EmbedderLayers {
 
   using PresentCallback =
       std::function<bool(const std::vector<const FlutterLayer*>& layers)>;
-  void InvokePresentCallback(const PresentCallback& callback) const;
+  // The presented layers are compared with the layers of the next frame to
+  // set |FlutterLayer::unchanged_since_last_frame|.
+  void InvokePresentCallback(const PresentCallback& callback);
 
  private:
-  const SkISize frame_size_;
-  const double device_pixel_ratio_;
-  const SkMatrix root_surface_transformation_;
-  std::vector<std::unique_ptr<FlutterPlatformView>> platform_views_referenced_;
-  std::vector<std::unique_ptr<FlutterPlatformViewMutation>>
-      mutations_referenced_;
-  std::vector<std::unique_ptr<std::vector<const FlutterPlatformViewMutation*>>>
-      mutations_arrays_referenced_;
+  SkISize frame_size_ = SkISize::Make(0, 0);
+  double device_pixel_ratio_ = 1.0;
+  SkMatrix root_surface_transformation_;
   std::vector<FlutterLayer> presented_layers_;
+  // Platform views and mutations are referred to by pointers, which are only
+  // set when all layers were pushed, as the vectors may grow until then.
+  std::vector<FlutterPlatformView> platform_views_;
+  std::vector<FlutterPlatformViewMutation> mutations_;
+  std::vector<const FlutterPlatformViewMutation*> mutation_pointers_;
+  std::vector<const FlutterLayer*> presented_layer_pointers_;
+  std::vector<EmbeddedViewParams> platform_view_params_;
+
+  // The previously presented frame. Its platform view layers point into
+  // |last_platform_views_|.
+  SkISize last_frame_size_ = SkISize::Make(0, 0);
+  SkMatrix last_root_surface_transformation_;
+  std::vector<FlutterLayer> last_presented_layers_;
+  std::vector<FlutterPlatformView> last_platform_views_;
+  std::vector<EmbeddedViewParams> last_platform_view_params_;
+
+  bool IsUnchangedSinceLastFrame(size_t index) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderLayers);
 };
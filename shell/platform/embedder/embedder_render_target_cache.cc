@@ -4,9 +4,13 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(size_t retained_frames)
+    : retained_frames_(std::max<size_t>(retained_frames, 1)) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
@@ -16,34 +20,83 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
     const EmbedderExternalView::PendingViews& pending_views) {
   RenderTargets resolved_render_targets;
   EmbedderExternalView::ViewIdentifierSet unmatched_identifiers;
+  std::vector<const EmbedderExternalView*> views_without_target;
 
+  // Views first get back the render target they rendered into last so that
+  // the embedder sees the same backing store for a view from frame to frame.
   for (const auto& view : pending_views) {
     const auto& external_view = view.second;
     if (!external_view->HasEngineRenderedContents()) {
       continue;
     }
-    auto& compatible_targets =
-        cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
-    if (compatible_targets.size() == 0) {
+    auto found = cached_render_targets_.find(
+        external_view->GetRenderSurfaceSize());
+    if (found == cached_render_targets_.end()) {
       unmatched_identifiers.insert(view.first);
-    } else {
-      std::unique_ptr<EmbedderRenderTarget> target =
-          std::move(compatible_targets.top());
-      compatible_targets.pop();
-      resolved_render_targets[view.first] = std::move(target);
+      continue;
+    }
+    auto& compatible_targets = found->second;
+    auto target = std::find_if(
+        compatible_targets.rbegin(), compatible_targets.rend(),
+        [&](const auto& cached) {
+          return EmbedderExternalView::ViewIdentifier::Equal{}(
+              cached.view_identifier, view.first);
+        });
+    if (target == compatible_targets.rend()) {
+      views_without_target.push_back(external_view.get());
+      continue;
+    }
+    resolved_render_targets[view.first] = std::move(target->target);
+    compatible_targets.erase(std::next(target).base());
+  }
+
+  // The remaining views take any cached render target of their size.
+  for (const auto* external_view : views_without_target) {
+    const auto view_identifier = external_view->GetViewIdentifier();
+    auto& compatible_targets =
+        cached_render_targets_[external_view->GetRenderSurfaceSize()];
+    if (compatible_targets.empty()) {
+      unmatched_identifiers.insert(view_identifier);
+      continue;
     }
+    resolved_render_targets[view_identifier] =
+        std::move(compatible_targets.back().target);
+    compatible_targets.pop_back();
   }
+
+  stats_.reused_targets += resolved_render_targets.size();
+  stats_.missed_targets += unmatched_identifiers.size();
   return {std::move(resolved_render_targets), std::move(unmatched_identifiers)};
 }
 
+std::set<std::unique_ptr<EmbedderRenderTarget>>
+EmbedderRenderTargetCache::EvictUnusedRenderTargets() {
+  frame_++;
+  std::set<std::unique_ptr<EmbedderRenderTarget>> evicted_targets;
+  for (auto it = cached_render_targets_.begin();
+       it != cached_render_targets_.end();) {
+    auto& targets = it->second;
+    while (!targets.empty() &&
+           frame_ - targets.front().cached_frame >= retained_frames_) {
+      evicted_targets.emplace(std::move(targets.front().target));
+      targets.pop_front();
+    }
+    if (targets.empty()) {
+      it = cached_render_targets_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  stats_.evicted_targets += evicted_targets.size();
+  return evicted_targets;
+}
+
 std::set<std::unique_ptr<EmbedderRenderTarget>>
 EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
   std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
   for (auto& targets : cached_render_targets_) {
-    auto& targets_stack = targets.second;
-    while (!targets_stack.empty()) {
-      cleared_targets.emplace(std::move(targets_stack.top()));
-      targets_stack.pop();
+    for (auto& cached : targets.second) {
+      cleared_targets.emplace(std::move(cached.target));
     }
   }
   cached_render_targets_.clear();
@@ -57,9 +110,9 @@ void EmbedderRenderTargetCache::CacheRenderTarget(
     return;
   }
   auto surface = target->GetRenderSurface();
-  auto desc = EmbedderExternalView::RenderTargetDescriptor{
-      view_identifier, SkISize::Make(surface->width(), surface->height())};
-  cached_render_targets_[desc].push(std::move(target));
+  auto size = SkISize::Make(surface->width(), surface->height());
+  cached_render_targets_[size].push_back(
+      {view_identifier, std::move(target), frame_});
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
@@ -70,4 +123,9 @@ size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
   return count;
 }
 
+const EmbedderRenderTargetCache::Stats& EmbedderRenderTargetCache::GetStats()
+    const {
+  return stats_;
+}
+
 }  // namespace flutter
@@ -5,11 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
+#include <deque>
 #include <set>
-#include <stack>
 #include <tuple>
 #include <unordered_map>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
 
@@ -19,9 +20,37 @@ namespace flutter {
 /// @brief      A cache used to reference render targets that are owned by the
 ///             embedder but needed by th engine to render a frame.
 ///
+///             Render targets are pooled by their size. A view prefers the
+///             render target it rendered into the last time it was presented
+///             but may use any cached render target of the same size. Unused
+///             render targets are held for a configurable number of frames
+///             before they are handed back to the embedder for collection.
+///
 class EmbedderRenderTargetCache {
  public:
-  EmbedderRenderTargetCache();
+  //----------------------------------------------------------------------------
+  /// @brief      Counters of the render targets that went through the cache
+  ///             since it was created.
+  ///
+  struct Stats {
+    /// Render targets that were handed back out of the cache.
+    size_t reused_targets = 0;
+    /// Requests for render targets that the cache could not fulfill.
+    size_t missed_targets = 0;
+    /// Render targets that were evicted after going unused.
+    size_t evicted_targets = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a render target cache.
+  ///
+  /// @param[in]  retained_frames  The number of frames an unused render
+  ///                              target is held in the cache before it is
+  ///                              evicted. A value of 1 only reuses render
+  ///                              targets that were used in the previous
+  ///                              frame.
+  ///
+  explicit EmbedderRenderTargetCache(size_t retained_frames = 1);
 
   ~EmbedderRenderTargetCache();
 
@@ -35,6 +64,15 @@ class EmbedderRenderTargetCache {
   GetExistingTargetsInCache(
       const EmbedderExternalView::PendingViews& pending_views);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Moves the cache to the next frame and removes the render
+  ///             targets that went unused for the configured number of
+  ///             frames.
+  ///
+  /// @return     The evicted render targets.
+  ///
+  std::set<std::unique_ptr<EmbedderRenderTarget>> EvictUnusedRenderTargets();
+
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
@@ -43,14 +81,30 @@ class EmbedderRenderTargetCache {
 
   size_t GetCachedTargetsCount() const;
 
- private:
-  using CachedRenderTargets =
-      std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
-                         std::stack<std::unique_ptr<EmbedderRenderTarget>>,
-                         EmbedderExternalView::RenderTargetDescriptor::Hash,
-                         EmbedderExternalView::RenderTargetDescriptor::Equal>;
+  const Stats& GetStats() const;
 
+ private:
+  struct CachedRenderTarget {
+    EmbedderExternalView::ViewIdentifier view_identifier;
+    std::unique_ptr<EmbedderRenderTarget> target;
+    size_t cached_frame;
+  };
+
+  struct SizeHash {
+    std::size_t operator()(const SkISize& size) const {
+      return fml::HashCombine(size.width(), size.height());
+    }
+  };
+
+  // Render targets of each size, from the least to the most recently cached.
+  using CachedRenderTargets = std::unordered_map<SkISize,
+                                                 std::deque<CachedRenderTarget>,
+                                                 SizeHash>;
+
+  const size_t retained_frames_;
+  size_t frame_ = 0;
   CachedRenderTargets cached_render_targets_;
+  Stats stats_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
 };
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/embedder/embedder_surface_gl.h"
 
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/shell_io_manager.h"
 
 namespace flutter {
@@ -11,9 +12,11 @@ namespace flutter {
 EmbedderSurfaceGL::EmbedderSurfaceGL(
     GLDispatchTable gl_dispatch_table,
     bool fbo_reset_after_present,
+    bool skip_redundant_make_current,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : gl_dispatch_table_(gl_dispatch_table),
       fbo_reset_after_present_(fbo_reset_after_present),
+      skip_redundant_make_current_(skip_redundant_make_current),
       external_view_embedder_(external_view_embedder) {
   // Make sure all required members of the dispatch table are checked.
   if (!gl_dispatch_table_.gl_make_current_callback ||
@@ -35,18 +38,55 @@ bool EmbedderSurfaceGL::IsValid() const {
 
 // |GPUSurfaceGLDelegate|
 std::unique_ptr<GLContextResult> EmbedderSurfaceGL::GLContextMakeCurrent() {
-  return std::make_unique<GLContextDefaultResult>(
-      gl_dispatch_table_.gl_make_current_callback());
+  const auto this_thread = std::this_thread::get_id();
+  if (skip_redundant_make_current_ && current_thread_ == this_thread) {
+    ++skipped_make_current_calls_;
+    TraceContextCalls();
+    return std::make_unique<GLContextDefaultResult>(true);
+  }
+
+  bool result = false;
+  {
+    TRACE_EVENT0("flutter", "EmbedderSurfaceGL::MakeCurrent");
+    result = gl_dispatch_table_.gl_make_current_callback();
+  }
+  current_thread_ = result ? this_thread : std::thread::id();
+  ++make_current_calls_;
+  TraceContextCalls();
+  return std::make_unique<GLContextDefaultResult>(result);
 }
 
 // |GPUSurfaceGLDelegate|
 bool EmbedderSurfaceGL::GLContextClearCurrent() {
+  TRACE_EVENT0("flutter", "EmbedderSurfaceGL::ClearCurrent");
+  current_thread_ = std::thread::id();
+  ++clear_current_calls_;
+  TraceContextCalls();
   return gl_dispatch_table_.gl_clear_current_callback();
 }
 
+void EmbedderSurfaceGL::TraceContextCalls() {
+  FML_TRACE_COUNTER("flutter", "EmbedderSurfaceGL::ContextCalls",
+                    reinterpret_cast<int64_t>(this), "MakeCurrent",
+                    make_current_calls_.load(), "SkippedMakeCurrent",
+                    skipped_make_current_calls_.load(), "ClearCurrent",
+                    clear_current_calls_.load());
+}
+
 // |GPUSurfaceGLDelegate|
 bool EmbedderSurfaceGL::GLContextPresent(uint32_t fbo_id) {
-  return gl_dispatch_table_.gl_present_callback(fbo_id);
+  GLPresentInfo present_info = {
+      fbo_id,        // fbo_id
+      std::nullopt,  // frame_damage
+      std::nullopt,  // buffer_damage
+  };
+  return gl_dispatch_table_.gl_present_callback(present_info);
+}
+
+// |GPUSurfaceGLDelegate|
+bool EmbedderSurfaceGL::GLContextPresentWithInfo(
+    const GLPresentInfo& present_info) {
+  return gl_dispatch_table_.gl_present_callback(present_info);
 }
 
 // |GPUSurfaceGLDelegate|
@@ -54,6 +94,20 @@ intptr_t EmbedderSurfaceGL::GLContextFBO(GLFrameInfo frame_info) const {
   return gl_dispatch_table_.gl_fbo_callback(frame_info);
 }
 
+// |GPUSurfaceGLDelegate|
+bool EmbedderSurfaceGL::GLContextSupportsPartialRepaint() const {
+  return static_cast<bool>(gl_dispatch_table_.gl_populate_existing_damage);
+}
+
+// |GPUSurfaceGLDelegate|
+std::optional<SkIRect> EmbedderSurfaceGL::GLContextFBOExistingDamage(
+    intptr_t fbo_id) const {
+  if (!gl_dispatch_table_.gl_populate_existing_damage) {
+    return std::nullopt;
+  }
+  return gl_dispatch_table_.gl_populate_existing_damage(fbo_id);
+}
+
 // |GPUSurfaceGLDelegate|
 bool EmbedderSurfaceGL::GLContextFBOResetAfterPresent() const {
   return fbo_reset_after_present_;
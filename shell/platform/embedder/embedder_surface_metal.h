@@ -26,6 +26,7 @@ class EmbedderSurfaceMetal final : public EmbedderSurface,
       GPUMTLDeviceHandle device,
       GPUMTLCommandQueueHandle command_queue,
       MetalDispatchTable dispatch_table,
+      bool textures_retain_contents,
       std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
 
   ~EmbedderSurfaceMetal() override;
@@ -33,6 +34,7 @@ class EmbedderSurfaceMetal final : public EmbedderSurface,
  private:
   bool valid_ = false;
   MetalDispatchTable metal_dispatch_table_;
+  bool textures_retain_contents_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
   sk_sp<SkSurface> surface_;
   sk_sp<GrDirectContext> main_context_;
@@ -60,6 +62,9 @@ class EmbedderSurfaceMetal final : public EmbedderSurface,
   // |GPUSurfaceMetalDelegate|
   bool PresentTexture(GPUMTLTextureInfo texture) const override;
 
+  // |GPUSurfaceMetalDelegate|
+  bool TexturesRetainContents() const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceMetal);
 };
 
@@ -16,9 +16,11 @@ EmbedderSurfaceMetal::EmbedderSurfaceMetal(
     GPUMTLDeviceHandle device,
     GPUMTLCommandQueueHandle command_queue,
     MetalDispatchTable metal_dispatch_table,
+    bool textures_retain_contents,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : GPUSurfaceMetalDelegate(MTLRenderTargetType::kMTLTexture),
       metal_dispatch_table_(metal_dispatch_table),
+      textures_retain_contents_(textures_retain_contents),
       external_view_embedder_(external_view_embedder) {
   main_context_ = [FlutterDarwinContextMetal createGrContext:(id<MTLDevice>)device
                                                 commandQueue:(id<MTLCommandQueue>)command_queue];
@@ -71,4 +73,8 @@ bool EmbedderSurfaceMetal::PresentTexture(GPUMTLTextureInfo texture) const {
   return metal_dispatch_table_.present(texture);
 }
 
+bool EmbedderSurfaceMetal::TexturesRetainContents() const {
+  return textures_retain_contents_;
+}
+
 }  // namespace flutter
@@ -13,8 +13,12 @@ EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     SoftwareDispatchTable software_dispatch_table,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : software_dispatch_table_(software_dispatch_table),
+      renders_into_framebuffers_(
+          software_dispatch_table_.software_acquire_framebuffer &&
+          software_dispatch_table_.software_present_framebuffer),
       external_view_embedder_(external_view_embedder) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+  if (!renders_into_framebuffers_ &&
+      !software_dispatch_table_.software_present_backing_store) {
     return;
   }
   valid_ = true;
@@ -57,6 +61,10 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
     return nullptr;
   }
 
+  if (renders_into_framebuffers_) {
+    return AcquireFramebuffer(size);
+  }
+
   if (sk_surface_ != nullptr &&
       SkISize::Make(sk_surface_->width(), sk_surface_->height()) == size) {
     // The old and new surface sizes are the same. Nothing to do here.
@@ -106,4 +114,72 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
   );
 }
 
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::PresentBackingStoreWithInfo(
+    sk_sp<SkSurface> backing_store,
+    const SoftwarePresentInfo& present_info) {
+  if (!renders_into_framebuffers_) {
+    return PresentBackingStore(std::move(backing_store));
+  }
+
+  if (!framebuffer_.has_value() || backing_store != sk_surface_) {
+    FML_LOG(ERROR) << "Tried to present a software framebuffer that was not "
+                      "acquired from the embedder.";
+    return false;
+  }
+
+  // The embedder may reuse the memory as soon as it is presented, so the
+  // surface wrapping it must not be drawn into again.
+  void* framebuffer_user_data = framebuffer_->user_data;
+  framebuffer_.reset();
+  sk_surface_ = nullptr;
+
+  return software_dispatch_table_.software_present_framebuffer(
+      framebuffer_user_data, present_info);
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::BackingStoreSupportsPartialRepaint() const {
+  return renders_into_framebuffers_;
+}
+
+// |GPUSurfaceSoftwareDelegate|
+std::optional<SkIRect> EmbedderSurfaceSoftware::BackingStoreExistingDamage()
+    const {
+  if (!framebuffer_.has_value()) {
+    return std::nullopt;
+  }
+  return framebuffer_->existing_damage;
+}
+
+sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireFramebuffer(
+    const SkISize& size) {
+  SoftwareFramebuffer framebuffer;
+  if (!software_dispatch_table_.software_acquire_framebuffer(size,
+                                                             framebuffer) ||
+      framebuffer.allocation == nullptr) {
+    FML_LOG(ERROR) << "The embedder did not provide a software framebuffer.";
+    return nullptr;
+  }
+
+  const SkAlphaType alpha_type = framebuffer.color_type == kRGB_565_SkColorType
+                                     ? kOpaque_SkAlphaType
+                                     : kPremul_SkAlphaType;
+  SkImageInfo info =
+      SkImageInfo::Make(size.fWidth, size.fHeight, framebuffer.color_type,
+                        alpha_type, SkColorSpace::MakeSRGB());
+  // Fails if the row bytes are too small for the width of the frame.
+  sk_surface_ = SkSurface::MakeRasterDirect(info, framebuffer.allocation,
+                                            framebuffer.row_bytes);
+  if (sk_surface_ == nullptr) {
+    FML_LOG(ERROR) << "Could not wrap the software framebuffer of the "
+                      "embedder. Its row bytes or pixel format are invalid.";
+    framebuffer_.reset();
+    return nullptr;
+  }
+
+  framebuffer_ = std::move(framebuffer);
+  return sk_surface_;
+}
+
 }  // namespace flutter
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 
+#include <optional>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_software.h"
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
@@ -15,9 +17,27 @@ namespace flutter {
 class EmbedderSurfaceSoftware final : public EmbedderSurface,
                                       public GPUSurfaceSoftwareDelegate {
  public:
+  // A buffer of the embedder that a frame is rendered into directly.
+  struct SoftwareFramebuffer {
+    void* allocation = nullptr;
+    size_t row_bytes = 0;
+    SkColorType color_type = kUnknown_SkColorType;
+    // The region of the buffer that does not hold the previously presented
+    // frame. Unset if the contents of the buffer are unknown.
+    std::optional<SkIRect> existing_damage;
+    void* user_data = nullptr;
+  };
+
+  // Either |software_present_backing_store| or both framebuffer callbacks are
+  // required. The framebuffer callbacks are used if they are specified.
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;  // optional
+    std::function<bool(const SkISize& size, SoftwareFramebuffer& framebuffer)>
+        software_acquire_framebuffer;  // optional
+    std::function<bool(void* framebuffer_user_data,
+                       const SoftwarePresentInfo& present_info)>
+        software_present_framebuffer;  // optional
   };
 
   EmbedderSurfaceSoftware(
@@ -29,7 +49,10 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
  private:
   bool valid_ = false;
   SoftwareDispatchTable software_dispatch_table_;
+  const bool renders_into_framebuffers_;
   sk_sp<SkSurface> sk_surface_;
+  // The embedder buffer the current frame is rendered into, if any.
+  std::optional<SoftwareFramebuffer> framebuffer_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
 
   // |EmbedderSurface|
@@ -47,6 +70,19 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStoreWithInfo(
+      sk_sp<SkSurface> backing_store,
+      const SoftwarePresentInfo& present_info) override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool BackingStoreSupportsPartialRepaint() const override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  std::optional<SkIRect> BackingStoreExistingDamage() const override;
+
+  sk_sp<SkSurface> AcquireFramebuffer(const SkISize& size);
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceSoftware);
 };
 
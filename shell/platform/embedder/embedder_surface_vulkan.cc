@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_surface_vulkan.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/vulkan/vulkan_application.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/vk/GrVkBackendContext.h"
+
+namespace flutter {
+
+EmbedderSurfaceVulkan::EmbedderSurfaceVulkan(
+    uint32_t version,
+    VkInstance instance,
+    VkPhysicalDevice physical_device,
+    VkDevice device,
+    uint32_t queue_family_index,
+    VkQueue queue,
+    std::vector<std::string> instance_extensions,
+    std::vector<std::string> device_extensions,
+    VulkanDispatchTable vulkan_dispatch_table,
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    : vulkan_dispatch_table_(vulkan_dispatch_table),
+      external_view_embedder_(external_view_embedder) {
+  // Make sure all required members of the dispatch table are checked.
+  if (!vulkan_dispatch_table_.get_instance_proc_address ||
+      !vulkan_dispatch_table_.get_next_image ||
+      !vulkan_dispatch_table_.present_image) {
+    return;
+  }
+
+  vk_ = fml::MakeRefCounted<vulkan::VulkanProcTable>(
+      vulkan_dispatch_table_.get_instance_proc_address);
+  if (!vk_->HasAcquiredMandatoryProcAddresses() ||
+      !vk_->SetupInstanceProcAddresses({instance, nullptr}) ||
+      !vk_->SetupDeviceProcAddresses({device, nullptr})) {
+    FML_LOG(ERROR) << "Could not acquire the Vulkan procs of the embedder.";
+    return;
+  }
+
+  main_context_ = CreateGrContext(version, instance, physical_device, device,
+                                  queue_family_index, queue,
+                                  instance_extensions, device_extensions);
+  valid_ = main_context_ != nullptr;
+}
+
+EmbedderSurfaceVulkan::~EmbedderSurfaceVulkan() = default;
+
+// |GPUSurfaceVulkanDelegate|
+fml::RefPtr<vulkan::VulkanProcTable> EmbedderSurfaceVulkan::vk() {
+  return vk_;
+}
+
+// |GPUSurfaceVulkanDelegate|
+GPUVulkanImage EmbedderSurfaceVulkan::AcquireImage(const SkISize& size) {
+  return vulkan_dispatch_table_.get_next_image(size);
+}
+
+// |GPUSurfaceVulkanDelegate|
+bool EmbedderSurfaceVulkan::PresentImage(const GPUVulkanImage& image) {
+  return vulkan_dispatch_table_.present_image(image);
+}
+
+// |EmbedderSurface|
+bool EmbedderSurfaceVulkan::IsValid() const {
+  return valid_;
+}
+
+// |EmbedderSurface|
+std::unique_ptr<Surface> EmbedderSurfaceVulkan::CreateGPUSurface() {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  const bool render_to_surface = !external_view_embedder_;
+  auto surface = std::make_unique<GPUSurfaceVulkan>(this, main_context_,
+                                                    render_to_surface);
+
+  if (!surface->IsValid()) {
+    return nullptr;
+  }
+
+  return surface;
+}
+
+// |EmbedderSurface|
+sk_sp<GrDirectContext> EmbedderSurfaceVulkan::CreateResourceContext() const {
+  // The queue is only used on the raster thread, so there is no context for
+  // the IO thread. Images are uploaded on the raster thread instead.
+  return nullptr;
+}
+
+sk_sp<GrDirectContext> EmbedderSurfaceVulkan::CreateGrContext(
+    uint32_t version,
+    VkInstance instance,
+    VkPhysicalDevice physical_device,
+    VkDevice device,
+    uint32_t queue_family_index,
+    VkQueue queue,
+    const std::vector<std::string>& instance_extensions,
+    const std::vector<std::string>& device_extensions) {
+  auto get_proc = vk_->CreateSkiaGetProc();
+  if (get_proc == nullptr) {
+    return nullptr;
+  }
+
+  uint32_t extensions = 0;
+  for (const auto& extension : instance_extensions) {
+    if (extension == VK_KHR_SURFACE_EXTENSION_NAME) {
+      extensions |= kKHR_surface_GrVkExtensionFlag;
+    }
+  }
+  for (const auto& extension : device_extensions) {
+    if (extension == VK_KHR_SWAPCHAIN_EXTENSION_NAME) {
+      extensions |= kKHR_swapchain_GrVkExtensionFlag;
+    }
+  }
+
+  VkPhysicalDeviceFeatures device_features;
+  vk_->GetPhysicalDeviceFeatures(physical_device, &device_features);
+  uint32_t features = 0;
+  if (device_features.geometryShader) {
+    features |= kGeometryShader_GrVkFeatureFlag;
+  }
+  if (device_features.dualSrcBlend) {
+    features |= kDualSrcBlend_GrVkFeatureFlag;
+  }
+  if (device_features.sampleRateShading) {
+    features |= kSampleRateShading_GrVkFeatureFlag;
+  }
+
+  GrVkBackendContext backend_context;
+  backend_context.fInstance = instance;
+  backend_context.fPhysicalDevice = physical_device;
+  backend_context.fDevice = device;
+  backend_context.fQueue = queue;
+  backend_context.fGraphicsQueueIndex = queue_family_index;
+  backend_context.fMinAPIVersion = version;
+  backend_context.fExtensions = extensions;
+  backend_context.fFeatures = features;
+  backend_context.fGetProc = std::move(get_proc);
+  backend_context.fOwnsInstanceAndDevice = false;
+
+  sk_sp<GrDirectContext> context =
+      GrDirectContext::MakeVulkan(backend_context);
+  if (context == nullptr) {
+    FML_LOG(ERROR) << "Could not create the Skia context for the Vulkan "
+                      "device of the embedder.";
+    return nullptr;
+  }
+
+  context->setResourceCacheLimits(vulkan::kGrCacheMaxCount,
+                                  vulkan::kGrCacheMaxByteSize);
+  return context;
+}
+
+}  // namespace flutter
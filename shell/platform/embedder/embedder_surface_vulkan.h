@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_VULKAN_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_VULKAN_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/shell/gpu/gpu_surface_vulkan.h"
+#include "flutter/shell/gpu/gpu_surface_vulkan_delegate.h"
+#include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
+#include "flutter/shell/platform/embedder/embedder_surface.h"
+#include "flutter/vulkan/vulkan_proc_table.h"
+
+namespace flutter {
+
+class EmbedderSurfaceVulkan final : public EmbedderSurface,
+                                    public GPUSurfaceVulkanDelegate {
+ public:
+  struct VulkanDispatchTable {
+    vulkan::VulkanProcTable::GetInstanceProcAddrCallback
+        get_instance_proc_address;  // required
+    std::function<GPUVulkanImage(const SkISize& frame_size)>
+        get_next_image;  // required
+    std::function<bool(const GPUVulkanImage& image)>
+        present_image;  // required
+  };
+
+  EmbedderSurfaceVulkan(
+      uint32_t version,
+      VkInstance instance,
+      VkPhysicalDevice physical_device,
+      VkDevice device,
+      uint32_t queue_family_index,
+      VkQueue queue,
+      std::vector<std::string> instance_extensions,
+      std::vector<std::string> device_extensions,
+      VulkanDispatchTable vulkan_dispatch_table,
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+
+  ~EmbedderSurfaceVulkan() override;
+
+  // |GPUSurfaceVulkanDelegate|
+  fml::RefPtr<vulkan::VulkanProcTable> vk() override;
+
+  // |GPUSurfaceVulkanDelegate|
+  GPUVulkanImage AcquireImage(const SkISize& size) override;
+
+  // |GPUSurfaceVulkanDelegate|
+  bool PresentImage(const GPUVulkanImage& image) override;
+
+ private:
+  bool valid_ = false;
+  fml::RefPtr<vulkan::VulkanProcTable> vk_;
+  VulkanDispatchTable vulkan_dispatch_table_;
+  std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+  sk_sp<GrDirectContext> main_context_;
+
+  // |EmbedderSurface|
+  bool IsValid() const override;
+
+  // |EmbedderSurface|
+  std::unique_ptr<Surface> CreateGPUSurface() override;
+
+  // |EmbedderSurface|
+  sk_sp<GrDirectContext> CreateResourceContext() const override;
+
+  sk_sp<GrDirectContext> CreateGrContext(
+      uint32_t version,
+      VkInstance instance,
+      VkPhysicalDevice physical_device,
+      VkDevice device,
+      uint32_t queue_family_index,
+      VkQueue queue,
+      const std::vector<std::string>& instance_extensions,
+      const std::vector<std::string>& device_extensions);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceVulkan);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_VULKAN_H_
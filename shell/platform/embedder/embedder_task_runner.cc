@@ -53,6 +53,23 @@ void EmbedderTaskRunner::PostDelayedTask(const fml::closure& task,
   PostTaskForTime(task, fml::TimePoint::Now() + delay);
 }
 
+void EmbedderTaskRunner::PostTaskWithPriority(const fml::closure& task,
+                                              fml::TimePoint target_time,
+                                              fml::TaskPriority priority,
+                                              fml::TimePoint deadline) {
+  // The embedder API has no notion of priorities, so tasks run in the order
+  // the embedder schedules them.
+  PostTaskForTime(task, target_time);
+}
+
+void EmbedderTaskRunner::PostDelayedTaskWithLeeway(const fml::closure& task,
+                                                   fml::TimeDelta delay,
+                                                   fml::TimeDelta leeway) {
+  // The embedder is asked to run the task at its target time, and may
+  // coalesce timers on its own.
+  PostDelayedTask(task, delay);
+}
+
 bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
   return dispatch_table_.runs_task_on_current_thread_callback();
 }
@@ -89,6 +89,17 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
   // |fml::TaskRunner|
   void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay) override;
 
+  // |fml::TaskRunner|
+  void PostTaskWithPriority(const fml::closure& task,
+                            fml::TimePoint target_time,
+                            fml::TaskPriority priority,
+                            fml::TimePoint deadline) override;
+
+  // |fml::TaskRunner|
+  void PostDelayedTaskWithLeeway(const fml::closure& task,
+                                 fml::TimeDelta delay,
+                                 fml::TimeDelta leeway) override;
+
   // |fml::TaskRunner|
   bool RunsTasksOnCurrentThread() override;
 
@@ -79,11 +79,106 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
                     SAFE_ACCESS(description, identifier, 0u))};
 }
 
+static fml::Thread::ThreadPriority GetThreadPriority(
+    FlutterThreadPriority priority) {
+  switch (priority) {
+    case kFlutterThreadPriorityBackground:
+      return fml::Thread::ThreadPriority::kBackground;
+    case kFlutterThreadPriorityNormal:
+      return fml::Thread::ThreadPriority::kNormal;
+    case kFlutterThreadPriorityDisplay:
+      return fml::Thread::ThreadPriority::kDisplay;
+    case kFlutterThreadPriorityRaster:
+      return fml::Thread::ThreadPriority::kRaster;
+    case kFlutterThreadPriorityRealtime:
+      return fml::Thread::ThreadPriority::kRealtime;
+  }
+  return fml::Thread::ThreadPriority::kNormal;
+}
+
+static fml::CpuAffinity GetCpuAffinity(FlutterCpuAffinity affinity) {
+  switch (affinity) {
+    case kFlutterCpuAffinityAny:
+      return fml::CpuAffinity::kAny;
+    case kFlutterCpuAffinityPerformance:
+      return fml::CpuAffinity::kPerformance;
+    case kFlutterCpuAffinityEfficiency:
+      return fml::CpuAffinity::kEfficiency;
+  }
+  return fml::CpuAffinity::kAny;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Converts the thread configurations specified by the embedder to
+///             the ones of the thread host. The threads the embedder did not
+///             specify a configuration for use the default one.
+///
+static ThreadHost::ThreadConfigs GetThreadConfigs(
+    const FlutterEngineThreadConfigs* thread_configs) {
+  ThreadHost::ThreadConfigs configs;
+  if (thread_configs == nullptr) {
+    return configs;
+  }
+
+  auto add_config = [&configs](ThreadHost::Type type,
+                               const FlutterThreadConfig* config) {
+    if (config == nullptr) {
+      return;
+    }
+    fml::Thread::ThreadConfig& thread_config = configs[type];
+    thread_config.priority = GetThreadPriority(
+        SAFE_ACCESS(config, priority, kFlutterThreadPriorityNormal));
+    thread_config.affinity = GetCpuAffinity(
+        SAFE_ACCESS(config, affinity, kFlutterCpuAffinityAny));
+    thread_config.cpu_mask = SAFE_ACCESS(config, cpu_mask, 0u);
+    thread_config.stack_size = SAFE_ACCESS(config, stack_size, 0u);
+  };
+
+  add_config(ThreadHost::Type::UI,
+             SAFE_ACCESS(thread_configs, ui_thread_config, nullptr));
+  add_config(ThreadHost::Type::RASTER,
+             SAFE_ACCESS(thread_configs, raster_thread_config, nullptr));
+  add_config(ThreadHost::Type::IO,
+             SAFE_ACCESS(thread_configs, io_thread_config, nullptr));
+  return configs;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Makes the threads the engine creates invoke the thread start
+///             callback of the embedder, if it specified one.
+///
+static void AddThreadStartCallback(
+    const FlutterCustomTaskRunners* custom_task_runners,
+    ThreadHost::ThreadConfigs& configs) {
+  FlutterThreadStartCallback callback =
+      SAFE_ACCESS(custom_task_runners, thread_start_callback, nullptr);
+  if (callback == nullptr) {
+    return;
+  }
+  void* user_data = SAFE_ACCESS(custom_task_runners,
+                                thread_start_callback_user_data, nullptr);
+
+  auto add_callback = [&](ThreadHost::Type type,
+                          FlutterEngineThreadType thread_type) {
+    configs[type].on_start = [callback, thread_type, user_data]() {
+      callback(thread_type, user_data);
+    };
+  };
+  add_callback(ThreadHost::Type::UI, kFlutterEngineThreadTypeUI);
+  add_callback(ThreadHost::Type::RASTER, kFlutterEngineThreadTypeRaster);
+  add_callback(ThreadHost::Type::IO, kFlutterEngineThreadTypeIO);
+}
+
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-    const FlutterCustomTaskRunners* custom_task_runners) {
+    const FlutterCustomTaskRunners* custom_task_runners,
+    const FlutterEngineThreadConfigs* thread_configs) {
+  ThreadHost::ThreadConfigs engine_thread_configs =
+      GetThreadConfigs(thread_configs);
+  AddThreadStartCallback(custom_task_runners, engine_thread_configs);
   {
-    auto host = CreateEmbedderManagedThreadHost(custom_task_runners);
+    auto host = CreateEmbedderManagedThreadHost(custom_task_runners,
+                                                engine_thread_configs);
     if (host && host->IsValid()) {
       return host;
     }
@@ -94,7 +189,7 @@ EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
   // configuration if the embedder attempted to specify a configuration but
   // messed up with an incorrect configuration.
   if (custom_task_runners == nullptr) {
-    auto host = CreateEngineManagedThreadHost();
+    auto host = CreateEngineManagedThreadHost(engine_thread_configs);
     if (host && host->IsValid()) {
       return host;
     }
@@ -113,7 +208,8 @@ constexpr const char* kFlutterThreadName = "io.flutter";
 // static
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderManagedThreadHost(
-    const FlutterCustomTaskRunners* custom_task_runners) {
+    const FlutterCustomTaskRunners* custom_task_runners,
+    const ThreadHost::ThreadConfigs& thread_configs) {
   if (custom_task_runners == nullptr) {
     return nullptr;
   }
@@ -154,7 +250,8 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 
   // Create a thread host with just the threads that need to be managed by the
   // engine. The embedder has provided the rest.
-  ThreadHost thread_host(kFlutterThreadName, engine_thread_host_mask);
+  ThreadHost thread_host(kFlutterThreadName, engine_thread_host_mask,
+                         thread_configs);
 
   // If the embedder has supplied a platform task runner, use that. If not, use
   // the current thread task runner.
@@ -205,12 +302,14 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 
 // static
 std::unique_ptr<EmbedderThreadHost>
-EmbedderThreadHost::CreateEngineManagedThreadHost() {
+EmbedderThreadHost::CreateEngineManagedThreadHost(
+    const ThreadHost::ThreadConfigs& thread_configs) {
   // Create a thread host with the current thread as the platform thread and all
   // other threads managed.
-  ThreadHost thread_host(kFlutterThreadName, ThreadHost::Type::RASTER |
-                                                 ThreadHost::Type::IO |
-                                                 ThreadHost::Type::UI);
+  ThreadHost thread_host(
+      kFlutterThreadName,
+      ThreadHost::Type::RASTER | ThreadHost::Type::IO | ThreadHost::Type::UI,
+      thread_configs);
 
   // For embedder platforms that don't have native message loop interop, this
   // will reference a task runner that points to a null message loop
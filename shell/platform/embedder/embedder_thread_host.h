@@ -21,7 +21,8 @@ class EmbedderThreadHost {
  public:
   static std::unique_ptr<EmbedderThreadHost>
   CreateEmbedderOrEngineManagedThreadHost(
-      const FlutterCustomTaskRunners* custom_task_runners);
+      const FlutterCustomTaskRunners* custom_task_runners,
+      const FlutterEngineThreadConfigs* thread_configs = nullptr);
 
   EmbedderThreadHost(
       ThreadHost host,
@@ -42,9 +43,11 @@ class EmbedderThreadHost {
   std::map<int64_t, fml::RefPtr<EmbedderTaskRunner>> runners_map_;
 
   static std::unique_ptr<EmbedderThreadHost> CreateEmbedderManagedThreadHost(
-      const FlutterCustomTaskRunners* custom_task_runners);
+      const FlutterCustomTaskRunners* custom_task_runners,
+      const ThreadHost::ThreadConfigs& thread_configs);
 
-  static std::unique_ptr<EmbedderThreadHost> CreateEngineManagedThreadHost();
+  static std::unique_ptr<EmbedderThreadHost> CreateEngineManagedThreadHost(
+      const ThreadHost::ThreadConfigs& thread_configs);
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderThreadHost);
 };
@@ -873,6 +873,42 @@ void render_targets_are_recycled() {
   PlatformDispatcher.instance.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+void render_targets_are_pooled_across_views() {
+  int frame_count = 0;
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    SceneBuilder builder = SceneBuilder();
+    // Alternate between 5 and 3 layers with new platform views every frame.
+    int layer_count = frame_count.isEven ? 5 : 3;
+    for (int i = 0; i < layer_count; i++) {
+      builder.addPicture(Offset(0.0, 0.0), CreateGradientBox(Size(30.0, 20.0)));
+      builder.addPlatformView(frame_count * 10 + i, width: 30.0, height: 20.0);
+    }
+    PlatformDispatcher.instance.views.first.render(builder.build());
+    PlatformDispatcher.instance.scheduleFrame();
+    frame_count++;
+    if (frame_count == 8) {
+      signalNativeTest();
+    }
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
+@pragma('vm:entry-point')
+void render_every_view() {
+  PlatformDispatcher.instance.onMetricsChanged = () {
+    PlatformDispatcher.instance.scheduleFrame();
+  };
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    for (final FlutterView view in PlatformDispatcher.instance.views) {
+      SceneBuilder builder = SceneBuilder();
+      builder.addPicture(Offset(0.0, 0.0), CreateGradientBox(Size(30.0, 20.0)));
+      view.render(builder.build());
+    }
+  };
+  signalNativeTest();
+}
+
 void nativeArgumentsCallback(List<String> args) native 'NativeArgumentsCallback';
 
 @pragma('vm:entry-point')
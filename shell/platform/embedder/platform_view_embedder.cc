@@ -25,6 +25,7 @@ PlatformViewEmbedder::PlatformViewEmbedder(
     flutter::TaskRunners task_runners,
     EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table,
     bool fbo_reset_after_present,
+    bool skip_redundant_make_current,
     PlatformDispatchTable platform_dispatch_table,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : PlatformView(delegate, std::move(task_runners)),
@@ -32,6 +33,7 @@ PlatformViewEmbedder::PlatformViewEmbedder(
       embedder_surface_(
           std::make_unique<EmbedderSurfaceGL>(gl_dispatch_table,
                                               fbo_reset_after_present,
+                                              skip_redundant_make_current,
                                               external_view_embedder_)),
       platform_dispatch_table_(platform_dispatch_table) {}
 #endif
@@ -49,6 +51,19 @@ PlatformViewEmbedder::PlatformViewEmbedder(
       platform_dispatch_table_(platform_dispatch_table) {}
 #endif
 
+#ifdef SHELL_ENABLE_VULKAN
+PlatformViewEmbedder::PlatformViewEmbedder(
+    PlatformView::Delegate& delegate,
+    flutter::TaskRunners task_runners,
+    std::unique_ptr<EmbedderSurfaceVulkan> embedder_surface,
+    PlatformDispatchTable platform_dispatch_table,
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    : PlatformView(delegate, std::move(task_runners)),
+      external_view_embedder_(external_view_embedder),
+      embedder_surface_(std::move(embedder_surface)),
+      platform_dispatch_table_(platform_dispatch_table) {}
+#endif
+
 PlatformViewEmbedder::~PlatformViewEmbedder() = default;
 
 void PlatformViewEmbedder::UpdateSemantics(
@@ -81,6 +96,12 @@ void PlatformViewEmbedder::HandlePlatformMessage(
       std::move(message));
 }
 
+void PlatformViewEmbedder::SetFrameRateRange(const FrameRateRange& range) {
+  if (platform_dispatch_table_.frame_rate_range_callback) {
+    platform_dispatch_table_.frame_rate_range_callback(range);
+  }
+}
+
 // |PlatformView|
 std::unique_ptr<Surface> PlatformViewEmbedder::CreateRenderingSurface() {
   if (embedder_surface_ == nullptr) {
@@ -75,6 +75,16 @@ inline bool operator==(const FlutterMetalBackingStore& a,
   return a.texture == b.texture;
 }
 
+inline bool operator==(const FlutterVulkanImage& a,
+                       const FlutterVulkanImage& b) {
+  return a.image == b.image && a.format == b.format;
+}
+
+inline bool operator==(const FlutterVulkanBackingStore& a,
+                       const FlutterVulkanBackingStore& b) {
+  return a.image == b.image;
+}
+
 inline bool operator==(const FlutterOpenGLBackingStore& a,
                        const FlutterOpenGLBackingStore& b) {
   if (!(a.type == b.type)) {
@@ -112,6 +122,8 @@ inline bool operator==(const FlutterBackingStore& a,
       return a.software == b.software;
     case kFlutterBackingStoreTypeMetal:
       return a.metal == b.metal;
+    case kFlutterBackingStoreTypeVulkan:
+      return a.vulkan == b.vulkan;
   }
 
   return false;
@@ -230,6 +242,8 @@ inline std::string FlutterBackingStoreTypeToString(
       return "kFlutterBackingStoreTypeSoftware";
     case kFlutterBackingStoreTypeMetal:
       return "kFlutterBackingStoreTypeMetal";
+    case kFlutterBackingStoreTypeVulkan:
+      return "kFlutterBackingStoreTypeVulkan";
   }
   return "Unknown";
 }
@@ -347,6 +361,11 @@ inline std::ostream& operator<<(std::ostream& out,
   return out << "(FlutterMetalBackingStore) Texture: " << item.texture;
 }
 
+inline std::ostream& operator<<(std::ostream& out,
+                                const FlutterVulkanBackingStore& item) {
+  return out << "(FlutterVulkanBackingStore) Image: " << item.image;
+}
+
 inline std::ostream& operator<<(std::ostream& out,
                                 const FlutterBackingStore& backing_store) {
   out << "(FlutterBackingStore) Struct size: " << backing_store.struct_size
@@ -366,6 +385,10 @@ inline std::ostream& operator<<(std::ostream& out,
     case kFlutterBackingStoreTypeMetal:
       out << backing_store.metal;
       break;
+
+    case kFlutterBackingStoreTypeVulkan:
+      out << backing_store.vulkan;
+      break;
   }
 
   return out;
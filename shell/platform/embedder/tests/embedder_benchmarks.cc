@@ -0,0 +1,179 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "embedder.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_test_context_software.h"
+#include "flutter/testing/testing.h"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// How a payload is encoded before it is sent to Dart and decoded once Dart
+// echoed it back. The codecs are the ones the desktop embeddings use.
+enum class PayloadCodec {
+  kBinary,
+  kStandard,
+  kJson,
+};
+
+std::vector<uint8_t> EncodePayload(PayloadCodec codec,
+                                   const std::vector<uint8_t>& payload) {
+  switch (codec) {
+    case PayloadCodec::kBinary:
+      return payload;
+    case PayloadCodec::kStandard:
+      return *StandardMessageCodec::GetInstance().EncodeMessage(
+          EncodableValue(payload));
+    case PayloadCodec::kJson: {
+      rapidjson::StringBuffer buffer;
+      rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+      writer.StartObject();
+      writer.Key("data");
+      writer.String(reinterpret_cast<const char*>(payload.data()),
+                    payload.size());
+      writer.EndObject();
+      const uint8_t* begin =
+          reinterpret_cast<const uint8_t*>(buffer.GetString());
+      return std::vector<uint8_t>(begin, begin + buffer.GetSize());
+    }
+  }
+  return {};
+}
+
+size_t DecodePayload(PayloadCodec codec, const uint8_t* data, size_t size) {
+  switch (codec) {
+    case PayloadCodec::kBinary:
+      return size;
+    case PayloadCodec::kStandard: {
+      auto value = StandardMessageCodec::GetInstance().DecodeMessage(data, size);
+      return std::get<std::vector<uint8_t>>(*value).size();
+    }
+    case PayloadCodec::kJson: {
+      rapidjson::Document document;
+      document.Parse(reinterpret_cast<const char*>(data), size);
+      return document["data"].GetStringLength();
+    }
+  }
+  return 0;
+}
+
+// Sends platform messages with |state.range(0)| bytes of payload to a Dart
+// isolate that echoes every message back, and waits for each response before
+// sending the next message. The time per iteration is the round-trip
+// latency. Encoding and decoding the payload with |codec| is included.
+void BM_PlatformMessageRoundTrip(benchmark::State& state, PayloadCodec codec) {
+  // Text that is valid in all codecs.
+  const std::vector<uint8_t> payload(state.range(0), 'a');
+
+  fml::Thread platform_thread("io.flutter.bench.platform");
+  auto platform_task_runner = platform_thread.GetTaskRunner();
+
+  EmbedderTestContextSoftware context(GetFixturesPath());
+  UniqueEngine engine;
+  fml::AutoResetWaitableEvent ready;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+
+  fml::AutoResetWaitableEvent launched;
+  platform_task_runner->PostTask([&]() {
+    EmbedderConfigBuilder builder(context);
+    builder.SetSoftwareRendererConfig();
+    builder.SetDartEntrypoint("platform_messages_response");
+    engine = builder.LaunchEngine();
+    launched.Signal();
+  });
+  launched.Wait();
+  FML_CHECK(engine.is_valid());
+  ready.Wait();
+
+  struct Captures {
+    PayloadCodec codec;
+    size_t decoded_size = 0;
+    fml::AutoResetWaitableEvent response;
+  };
+  Captures captures;
+  captures.codec = codec;
+
+  auto send_message = [&]() {
+    std::vector<uint8_t> message_data = EncodePayload(codec, payload);
+
+    FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+    auto callback = [](const uint8_t* data, size_t size, void* user_data) {
+      auto captures = reinterpret_cast<Captures*>(user_data);
+      captures->decoded_size = DecodePayload(captures->codec, data, size);
+      captures->response.Signal();
+    };
+    FML_CHECK(FlutterPlatformMessageCreateResponseHandle(
+                  engine.get(), callback, &captures, &response_handle) ==
+              kSuccess);
+
+    FlutterPlatformMessage message = {};
+    message.struct_size = sizeof(FlutterPlatformMessage);
+    message.channel = "test_channel";
+    message.message = message_data.data();
+    message.message_size = message_data.size();
+    message.response_handle = response_handle;
+    FML_CHECK(FlutterEngineSendPlatformMessage(engine.get(), &message) ==
+              kSuccess);
+    FML_CHECK(FlutterPlatformMessageReleaseResponseHandle(
+                  engine.get(), response_handle) == kSuccess);
+  };
+
+  while (state.KeepRunning()) {
+    platform_task_runner->PostTask(send_message);
+    captures.response.Wait();
+    FML_CHECK(captures.decoded_size == payload.size());
+  }
+
+  // Each message crosses the channel twice.
+  state.SetBytesProcessed(state.iterations() * payload.size() * 2);
+  state.SetItemsProcessed(state.iterations());
+
+  fml::AutoResetWaitableEvent shutdown;
+  platform_task_runner->PostTask([&]() {
+    engine.reset();
+    shutdown.Signal();
+  });
+  shutdown.Wait();
+}
+
+}  // namespace
+
+// Payloads from 16 bytes to 16 MiB.
+BENCHMARK_CAPTURE(BM_PlatformMessageRoundTrip, Binary, PayloadCodec::kBinary)
+    ->RangeMultiplier(16)
+    ->Range(16, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PlatformMessageRoundTrip,
+                  Standard,
+                  PayloadCodec::kStandard)
+    ->RangeMultiplier(16)
+    ->Range(16, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PlatformMessageRoundTrip, Json, PayloadCodec::kJson)
+    ->RangeMultiplier(16)
+    ->Range(16, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace testing
+}  // namespace flutter
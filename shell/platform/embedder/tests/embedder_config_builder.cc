@@ -126,6 +126,25 @@ void EmbedderConfigBuilder::SetSoftwareRendererConfig(SkISize surface_size) {
   context_.SetupSurface(surface_size);
 }
 
+void EmbedderConfigBuilder::SetSoftwareFramebufferCallbacks(
+    FlutterSoftwarePixelFormat pixel_format) {
+  static_cast<EmbedderTestContextSoftware&>(context_)
+      .SetFramebufferPixelFormat(pixel_format);
+  renderer_config_.software.surface_present_callback = nullptr;
+  renderer_config_.software.acquire_framebuffer_callback =
+      [](void* context, const FlutterFrameInfo* frame_info,
+         FlutterSoftwareFramebuffer* framebuffer) -> bool {
+    return reinterpret_cast<EmbedderTestContextSoftware*>(context)
+        ->AcquireFramebuffer(frame_info, framebuffer);
+  };
+  renderer_config_.software.present_framebuffer_callback =
+      [](void* context, const FlutterSoftwarePresentInfo* present_info)
+      -> bool {
+    return reinterpret_cast<EmbedderTestContextSoftware*>(context)
+        ->PresentFramebuffer(present_info);
+  };
+}
+
 void EmbedderConfigBuilder::SetOpenGLFBOCallBack() {
 #ifdef SHELL_ENABLE_GL
   // SetOpenGLRendererConfig must be called before this.
@@ -222,6 +241,11 @@ void EmbedderConfigBuilder::SetLogTag(std::string tag) {
   project_args_.log_tag = log_tag_.c_str();
 }
 
+void EmbedderConfigBuilder::SetFrameTimingsCallbackHook() {
+  project_args_.frame_timings_callback =
+      EmbedderTestContext::GetFrameTimingsCallbackHook();
+}
+
 void EmbedderConfigBuilder::SetLocalizationCallbackHooks() {
   project_args_.compute_platform_resolved_locale_callback =
       EmbedderTestContext::GetComputePlatformResolvedLocaleCallbackHook();
@@ -271,12 +295,21 @@ void EmbedderConfigBuilder::SetRenderTaskRunner(
   project_args_.custom_task_runners = &custom_task_runners_;
 }
 
+void EmbedderConfigBuilder::SetThreadStartCallback(
+    FlutterThreadStartCallback callback,
+    void* user_data) {
+  custom_task_runners_.thread_start_callback = callback;
+  custom_task_runners_.thread_start_callback_user_data = user_data;
+  project_args_.custom_task_runners = &custom_task_runners_;
+}
+
 void EmbedderConfigBuilder::SetPlatformMessageCallback(
     const std::function<void(const FlutterPlatformMessage*)>& callback) {
   context_.SetPlatformMessageCallback(callback);
 }
 
-void EmbedderConfigBuilder::SetCompositor(bool avoid_backing_store_cache) {
+void EmbedderConfigBuilder::SetCompositor(bool avoid_backing_store_cache,
+                                          bool use_present_view_callback) {
   context_.SetupCompositor();
   auto& compositor = context_.GetCompositor();
   compositor_.struct_size = sizeof(compositor_);
@@ -296,16 +329,24 @@ void EmbedderConfigBuilder::SetCompositor(bool avoid_backing_store_cache) {
         return reinterpret_cast<EmbedderTestCompositor*>(user_data)
             ->CollectBackingStore(backing_store);
       };
-  compositor_.present_layers_callback = [](const FlutterLayer** layers,  //
-                                           size_t layers_count,          //
-                                           void* user_data               //
-                                        ) {
-    return reinterpret_cast<EmbedderTestCompositor*>(user_data)->Present(
-        layers,       //
-        layers_count  //
-
-    );
-  };
+  if (use_present_view_callback) {
+    compositor_.present_view_callback =
+        [](const FlutterPresentViewInfo* info) {
+          return reinterpret_cast<EmbedderTestCompositor*>(info->user_data)
+              ->PresentView(info->view_id, info->layers, info->layers_count);
+        };
+  } else {
+    compositor_.present_layers_callback = [](const FlutterLayer** layers,  //
+                                             size_t layers_count,          //
+                                             void* user_data               //
+                                          ) {
+      return reinterpret_cast<EmbedderTestCompositor*>(user_data)->Present(
+          layers,       //
+          layers_count  //
+
+      );
+    };
+  }
   compositor_.avoid_backing_store_cache = avoid_backing_store_cache;
   project_args_.compositor = &compositor_;
 }
@@ -46,6 +46,13 @@ class EmbedderConfigBuilder {
 
   void SetSoftwareRendererConfig(SkISize surface_size = SkISize::Make(1, 1));
 
+  // Makes the software renderer render straight into framebuffers of the
+  // given pixel format that are owned by the test context, instead of handing
+  // its own buffers to `software.surface_present_callback`. Must be called
+  // after |SetSoftwareRendererConfig|.
+  void SetSoftwareFramebufferCallbacks(
+      FlutterSoftwarePixelFormat pixel_format);
+
   void SetOpenGLRendererConfig(SkISize surface_size);
 
   void SetMetalRendererConfig(SkISize surface_size);
@@ -78,6 +85,9 @@ class EmbedderConfigBuilder {
   // Used to set a custom log tag.
   void SetLogTag(std::string tag);
 
+  // Used to receive the timings of the rasterized frames.
+  void SetFrameTimingsCallbackHook();
+
   void SetLocalizationCallbackHooks();
 
   void SetDartEntrypoint(std::string entrypoint);
@@ -90,10 +100,14 @@ class EmbedderConfigBuilder {
 
   void SetRenderTaskRunner(const FlutterTaskRunnerDescription* runner);
 
+  void SetThreadStartCallback(FlutterThreadStartCallback callback,
+                              void* user_data);
+
   void SetPlatformMessageCallback(
       const std::function<void(const FlutterPlatformMessage*)>& callback);
 
-  void SetCompositor(bool avoid_backing_store_cache = false);
+  void SetCompositor(bool avoid_backing_store_cache = false,
+                     bool use_present_view_callback = false);
 
   FlutterCompositor& GetCompositor();
 
@@ -80,6 +80,18 @@ bool EmbedderTestCompositor::Present(const FlutterLayer** layers,
   return true;
 }
 
+bool EmbedderTestCompositor::PresentView(FlutterViewId view_id,
+                                         const FlutterLayer** layers,
+                                         size_t layers_count) {
+  if (present_view_callback_) {
+    present_view_callback_(view_id, layers, layers_count);
+  }
+  if (view_id == kFlutterImplicitViewId) {
+    return Present(layers, layers_count);
+  }
+  return true;
+}
+
 void EmbedderTestCompositor::SetNextPresentCallback(
     const PresentCallback& next_present_callback) {
   SetPresentCallback(next_present_callback, true);
@@ -93,6 +105,12 @@ void EmbedderTestCompositor::SetPresentCallback(
   present_callback_is_one_shot_ = one_shot;
 }
 
+void EmbedderTestCompositor::SetPresentViewCallback(
+    const PresentViewCallback& present_view_callback) {
+  FML_CHECK(!present_view_callback_);
+  present_view_callback_ = present_view_callback;
+}
+
 void EmbedderTestCompositor::SetNextSceneCallback(
     const NextSceneCallback& next_scene_callback) {
   FML_CHECK(!next_scene_callback_);
@@ -23,6 +23,9 @@ class EmbedderTestCompositor {
                                    GrDirectContext* context)>;
   using PresentCallback =
       std::function<void(const FlutterLayer** layers, size_t layers_count)>;
+  using PresentViewCallback = std::function<void(FlutterViewId view_id,
+                                                 const FlutterLayer** layers,
+                                                 size_t layers_count)>;
 
   EmbedderTestCompositor(SkISize surface_size, sk_sp<GrDirectContext> context);
 
@@ -38,6 +41,15 @@ class EmbedderTestCompositor {
 
   bool Present(const FlutterLayer** layers, size_t layers_count);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Presents the layers of a view. The implicit view is composed
+  ///             like in |Present|, the layers of other views are only handed
+  ///             to the present view callback.
+  ///
+  bool PresentView(FlutterViewId view_id,
+                   const FlutterLayer** layers,
+                   size_t layers_count);
+
   void SetPlatformViewRendererCallback(
       const PlatformViewRendererCallback& callback);
 
@@ -53,6 +65,8 @@ class EmbedderTestCompositor {
   void SetPresentCallback(const PresentCallback& present_callback,
                           bool one_shot);
 
+  void SetPresentViewCallback(const PresentViewCallback& present_view_callback);
+
   using NextSceneCallback = std::function<void(sk_sp<SkImage> image)>;
   void SetNextSceneCallback(const NextSceneCallback& next_scene_callback);
 
@@ -84,6 +98,7 @@ class EmbedderTestCompositor {
   PlatformViewRendererCallback platform_view_renderer_callback_;
   bool present_callback_is_one_shot_ = false;
   PresentCallback present_callback_;
+  PresentViewCallback present_view_callback_;
   NextSceneCallback next_scene_callback_;
   sk_sp<SkImage> last_composition_;
   size_t backing_stores_created_ = 0;
@@ -146,6 +146,11 @@ void EmbedderTestContext::SetLogMessageCallback(
   log_message_callback_ = callback;
 }
 
+void EmbedderTestContext::SetFrameTimingsCallback(
+    const FrameTimingsCallback& callback) {
+  frame_timings_callback_ = callback;
+}
+
 FlutterUpdateSemanticsNodeCallback
 EmbedderTestContext::GetUpdateSemanticsNodeCallbackHook() {
   return [](const FlutterSemanticsNode* semantics_node, void* user_data) {
@@ -175,6 +180,15 @@ FlutterLogMessageCallback EmbedderTestContext::GetLogMessageCallbackHook() {
   };
 }
 
+FlutterFrameTimingsCallback EmbedderTestContext::GetFrameTimingsCallbackHook() {
+  return [](const FlutterFrameTiming* timings, size_t count, void* user_data) {
+    auto context = reinterpret_cast<EmbedderTestContext*>(user_data);
+    if (auto callback = context->frame_timings_callback_) {
+      callback(timings, count);
+    }
+  };
+}
+
 FlutterComputePlatformResolvedLocaleCallback
 EmbedderTestContext::GetComputePlatformResolvedLocaleCallbackHook() {
   return [](const FlutterLocale** supported_locales,
@@ -29,6 +29,8 @@ using SemanticsActionCallback =
     std::function<void(const FlutterSemanticsCustomAction*)>;
 using LogMessageCallback =
     std::function<void(const char* tag, const char* message)>;
+using FrameTimingsCallback =
+    std::function<void(const FlutterFrameTiming* timings, size_t count)>;
 
 struct AOTDataDeleter {
   void operator()(FlutterEngineAOTData aot_data) {
@@ -81,6 +83,8 @@ class EmbedderTestContext {
 
   void SetLogMessageCallback(const LogMessageCallback& log_message_callback);
 
+  void SetFrameTimingsCallback(const FrameTimingsCallback& callback);
+
   std::future<sk_sp<SkImage>> GetNextSceneImage();
 
   EmbedderTestCompositor& GetCompositor();
@@ -109,6 +113,7 @@ class EmbedderTestContext {
   SemanticsActionCallback update_semantics_custom_action_callback_;
   std::function<void(const FlutterPlatformMessage*)> platform_message_callback_;
   LogMessageCallback log_message_callback_;
+  FrameTimingsCallback frame_timings_callback_;
   std::unique_ptr<EmbedderTestCompositor> compositor_;
   NextSceneCallback next_scene_callback_;
   SkMatrix root_surface_transformation_;
@@ -123,6 +128,8 @@ class EmbedderTestContext {
 
   static FlutterLogMessageCallback GetLogMessageCallbackHook();
 
+  static FlutterFrameTimingsCallback GetFrameTimingsCallbackHook();
+
   static FlutterComputePlatformResolvedLocaleCallback
   GetComputePlatformResolvedLocaleCallbackHook();
 
@@ -30,6 +30,59 @@ bool EmbedderTestContextSoftware::Present(sk_sp<SkImage> image) {
   return true;
 }
 
+void EmbedderTestContextSoftware::SetFramebufferPixelFormat(
+    FlutterSoftwarePixelFormat pixel_format) {
+  framebuffer_pixel_format_ = pixel_format;
+}
+
+bool EmbedderTestContextSoftware::AcquireFramebuffer(
+    const FlutterFrameInfo* frame_info,
+    FlutterSoftwareFramebuffer* framebuffer) {
+  SkColorType color_type = kN32_SkColorType;
+  SkAlphaType alpha_type = kPremul_SkAlphaType;
+  switch (framebuffer_pixel_format_) {
+    case kFlutterSoftwarePixelFormatNative32:
+      break;
+    case kFlutterSoftwarePixelFormatRGBA8888:
+      color_type = kRGBA_8888_SkColorType;
+      break;
+    case kFlutterSoftwarePixelFormatBGRA8888:
+      color_type = kBGRA_8888_SkColorType;
+      break;
+    case kFlutterSoftwarePixelFormatRGB565:
+      color_type = kRGB_565_SkColorType;
+      alpha_type = kOpaque_SkAlphaType;
+      break;
+  }
+  framebuffer_info_ =
+      SkImageInfo::Make(frame_info->size.width, frame_info->size.height,
+                        color_type, alpha_type, SkColorSpace::MakeSRGB());
+  framebuffer_row_bytes_ = framebuffer_info_.minRowBytes() + 64;
+  framebuffer_.resize(framebuffer_row_bytes_ * frame_info->size.height);
+  framebuffer_acquire_count_++;
+
+  framebuffer->allocation = framebuffer_.data();
+  framebuffer->row_bytes = framebuffer_row_bytes_;
+  framebuffer->pixel_format = framebuffer_pixel_format_;
+  framebuffer->user_data = this;
+  return true;
+}
+
+bool EmbedderTestContextSoftware::PresentFramebuffer(
+    const FlutterSoftwarePresentInfo* present_info) {
+  if (present_info->framebuffer_user_data != this) {
+    FML_LOG(ERROR) << "Presented a framebuffer the test did not hand out.";
+    return false;
+  }
+  SkPixmap pixmap(framebuffer_info_, framebuffer_.data(),
+                  framebuffer_row_bytes_);
+  return Present(SkImage::MakeRasterCopy(pixmap));
+}
+
+size_t EmbedderTestContextSoftware::GetFramebufferAcquireCount() const {
+  return framebuffer_acquire_count_;
+}
+
 size_t EmbedderTestContextSoftware::GetSurfacePresentCount() const {
   return software_surface_present_count_;
 }
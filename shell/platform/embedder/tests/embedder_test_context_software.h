@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_TESTS_EMBEDDER_CONTEXT_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_TESTS_EMBEDDER_CONTEXT_SOFTWARE_H_
 
+#include <vector>
+
 #include "flutter/shell/platform/embedder/tests/embedder_test_context.h"
 
 namespace flutter {
@@ -23,6 +25,17 @@ class EmbedderTestContextSoftware : public EmbedderTestContext {
 
   bool Present(sk_sp<SkImage> image);
 
+  void SetFramebufferPixelFormat(FlutterSoftwarePixelFormat pixel_format);
+
+  // Hands out a framebuffer whose rows are padded past the width of the frame
+  // to exercise the row bytes of the embedder.
+  bool AcquireFramebuffer(const FlutterFrameInfo* frame_info,
+                          FlutterSoftwareFramebuffer* framebuffer);
+
+  bool PresentFramebuffer(const FlutterSoftwarePresentInfo* present_info);
+
+  size_t GetFramebufferAcquireCount() const;
+
  protected:
   virtual void SetupCompositor() override;
 
@@ -30,6 +43,12 @@ class EmbedderTestContextSoftware : public EmbedderTestContext {
   sk_sp<SkSurface> surface_;
   SkISize surface_size_;
   size_t software_surface_present_count_ = 0;
+  FlutterSoftwarePixelFormat framebuffer_pixel_format_ =
+      kFlutterSoftwarePixelFormatNative32;
+  SkImageInfo framebuffer_info_;
+  size_t framebuffer_row_bytes_ = 0;
+  std::vector<uint8_t> framebuffer_;
+  size_t framebuffer_acquire_count_ = 0;
   void SetupSurface(SkISize surface_size) override;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderTestContextSoftware);
@@ -4,7 +4,10 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "embedder.h"
@@ -124,6 +127,38 @@ TEST_F(EmbedderTest, CanInvokeCustomEntrypointMacro) {
 
 std::atomic_size_t EmbedderTestTaskRunner::sEmbedderTaskRunnerIdentifiers = {};
 
+TEST_F(EmbedderTest, ThreadStartCallbackIsInvokedOnEveryEngineThread) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  struct StartedThreads {
+    std::mutex mutex;
+    std::map<FlutterEngineThreadType, std::thread::id> ids;
+  } started_threads;
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetThreadStartCallback(
+      [](FlutterEngineThreadType type, void* user_data) {
+        auto* started_threads = reinterpret_cast<StartedThreads*>(user_data);
+        std::scoped_lock lock(started_threads->mutex);
+        ASSERT_EQ(started_threads->ids.count(type), 0u);
+        started_threads->ids[type] = std::this_thread::get_id();
+      },
+      &started_threads);
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // The engine starts its threads while it is launched.
+  std::scoped_lock lock(started_threads.mutex);
+  ASSERT_EQ(started_threads.ids.size(), 3u);
+  for (auto type : {kFlutterEngineThreadTypeUI, kFlutterEngineThreadTypeRaster,
+                    kFlutterEngineThreadTypeIO}) {
+    ASSERT_EQ(started_threads.ids.count(type), 1u);
+    ASSERT_NE(started_threads.ids[type], std::this_thread::get_id());
+  }
+}
+
 TEST_F(EmbedderTest, CanSpecifyCustomPlatformTaskRunner) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
   fml::AutoResetWaitableEvent latch;
@@ -452,6 +487,85 @@ TEST_F(EmbedderTest, InvalidPlatformMessages) {
   ASSERT_EQ(result, kInvalidArguments);
 }
 
+//------------------------------------------------------------------------------
+/// Tests that a batch of platform messages is delivered to the isolate in
+/// order.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeSentInBatches) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_no_response");
+
+  const std::vector<std::string> message_data = {"one", "two", "three"};
+
+  fml::AutoResetWaitableEvent ready, messages_received;
+  std::vector<std::string> received_messages;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(([&](Dart_NativeArguments args) {
+        received_messages.push_back(
+            tonic::DartConverter<std::string>::FromDart(
+                Dart_GetNativeArgument(args, 0)));
+        if (received_messages.size() == message_data.size()) {
+          messages_received.Signal();
+        }
+      })));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  std::vector<FlutterPlatformMessage> platform_messages(message_data.size());
+  for (size_t i = 0; i < message_data.size(); i++) {
+    FlutterPlatformMessage& platform_message = platform_messages[i];
+    platform_message.struct_size = sizeof(FlutterPlatformMessage);
+    platform_message.channel = "test_channel";
+    platform_message.message =
+        reinterpret_cast<const uint8_t*>(message_data[i].data());
+    platform_message.message_size = message_data[i].size();
+    platform_message.response_handle = nullptr;  // No response needed.
+  }
+
+  auto result = FlutterEngineSendPlatformMessages(
+      engine.get(), platform_messages.data(), platform_messages.size());
+  ASSERT_EQ(result, kSuccess);
+  messages_received.Wait();
+  ASSERT_EQ(received_messages, message_data);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that no message of a batch is sent if one of them is invalid.
+///
+TEST_F(EmbedderTest, InvalidPlatformMessageBatches) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterPlatformMessage platform_messages[2] = {};
+  for (auto& platform_message : platform_messages) {
+    platform_message.struct_size = sizeof(FlutterPlatformMessage);
+    platform_message.channel = "test_channel";
+  }
+  platform_messages[1].message_size = 1;
+
+  ASSERT_EQ(FlutterEngineSendPlatformMessages(engine.get(), platform_messages,
+                                              2),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineSendPlatformMessages(engine.get(), nullptr, 1),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineSendPlatformMessages(engine.get(), nullptr, 0),
+            kSuccess);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that setting a custom log callback works as expected and defaults to
 /// using tag "flutter".
@@ -791,6 +905,87 @@ TEST_F(EmbedderTest, CaDeinitializeAnEngine) {
   engine.reset();
 }
 
+//------------------------------------------------------------------------------
+/// Test that an engine is not created with a Vulkan renderer config that does
+/// not say how images are acquired and presented.
+///
+TEST_F(EmbedderTest, MustNotRunWithIncompleteVulkanRendererConfig) {
+  EmbedderConfigBuilder builder(
+      GetEmbedderContext(EmbedderTestContextType::kSoftwareContext));
+  builder.SetSoftwareRendererConfig();
+
+  static int handle;
+  FlutterRendererConfig config = {};
+  config.type = kVulkan;
+  config.vulkan.struct_size = sizeof(FlutterVulkanRendererConfig);
+  config.vulkan.instance = &handle;
+  config.vulkan.physical_device = &handle;
+  config.vulkan.device = &handle;
+  config.vulkan.queue = &handle;
+  config.vulkan.get_instance_proc_address_callback =
+      [](void* user_data, FlutterVulkanInstanceHandle instance,
+         const char* name) -> void* { return nullptr; };
+
+  FLUTTER_API_SYMBOL(FlutterEngine) engine = nullptr;
+  ASSERT_EQ(FlutterEngineInitialize(FLUTTER_ENGINE_VERSION, &config,
+                                    &builder.GetProjectArgs(), nullptr,
+                                    &engine),
+            kInvalidArguments);
+  ASSERT_EQ(engine, nullptr);
+}
+
+TEST_F(EmbedderTest, SoftwareRendererCanRenderIntoEmbedderFramebuffers) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+  builder.SetSoftwareFramebufferCallbacks(kFlutterSoftwarePixelFormatRGB565);
+  builder.SetDartEntrypoint("render_gradient");
+
+  auto rendered_scene = context.GetNextSceneImage();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  sk_sp<SkImage> image = rendered_scene.get();
+  ASSERT_TRUE(image);
+  ASSERT_EQ(image->width(), 800);
+  ASSERT_EQ(image->height(), 600);
+  ASSERT_EQ(image->colorType(), kRGB_565_SkColorType);
+  ASSERT_GE(static_cast<EmbedderTestContextSoftware&>(context)
+                .GetFramebufferAcquireCount(),
+            1u);
+}
+
+TEST_F(EmbedderTest, MustNotRunWithOnlyOneSoftwareFramebufferCallback) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  FlutterRendererConfig config = {};
+  config.type = kSoftware;
+  config.software.struct_size = sizeof(FlutterSoftwareRendererConfig);
+  config.software.acquire_framebuffer_callback =
+      [](void* user_data, const FlutterFrameInfo* frame_info,
+         FlutterSoftwareFramebuffer* framebuffer) { return false; };
+
+  FLUTTER_API_SYMBOL(FlutterEngine) engine = nullptr;
+  ASSERT_EQ(FlutterEngineInitialize(FLUTTER_ENGINE_VERSION, &config,
+                                    &builder.GetProjectArgs(), nullptr,
+                                    &engine),
+            kInvalidArguments);
+  ASSERT_EQ(engine, nullptr);
+}
+
 TEST_F(EmbedderTest, CanUpdateLocales) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
   EmbedderConfigBuilder builder(context);
@@ -1019,6 +1214,142 @@ TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   ASSERT_EQ(FlutterEngineNotifyLowMemoryWarning(engine.get()), kSuccess);
 }
 
+TEST_F(EmbedderTest, CanPostMemoryPressureNotificationsOfEachLevel) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  for (auto level :
+       {kFlutterMemoryPressureLevelModerate,
+        kFlutterMemoryPressureLevelCritical,
+        kFlutterMemoryPressureLevelBackground}) {
+    ASSERT_EQ(FlutterEngineNotifyMemoryPressure(engine.get(), level),
+              kSuccess);
+  }
+  ASSERT_EQ(FlutterEngineNotifyMemoryPressure(
+                engine.get(), static_cast<FlutterMemoryPressureLevel>(42)),
+            kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, CanStartObservatoryOnRequest) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.AddCommandLineArgument("--lazy-observatory-startup");
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ASSERT_EQ(FlutterEngineStartObservatory(engine.get()), kSuccess);
+  ASSERT_EQ(FlutterEngineStartObservatory(nullptr), kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, FrameTimingsAreReportedWithoutDart) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("render_gradient");
+  builder.SetFrameTimingsCallbackHook();
+
+  const uint64_t start = FlutterEngineGetCurrentTime();
+  fml::AutoResetWaitableEvent latch;
+  std::vector<FlutterFrameTiming> timings;
+  context.SetFrameTimingsCallback(
+      [&](const FlutterFrameTiming* frame_timings, size_t count) {
+        timings.assign(frame_timings, frame_timings + count);
+        latch.Signal();
+      });
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  // The timings of the first frame are reported right away.
+  latch.Wait();
+  const uint64_t finish = FlutterEngineGetCurrentTime();
+  ASSERT_EQ(timings.size(), 1u);
+  const FlutterFrameTiming& timing = timings[0];
+  EXPECT_EQ(timing.struct_size, sizeof(FlutterFrameTiming));
+  EXPECT_LE(start, timing.vsync_start);
+  EXPECT_LE(timing.vsync_start, timing.build_start);
+  EXPECT_LE(timing.build_start, timing.build_finish);
+  EXPECT_LE(timing.build_finish, timing.raster_start);
+  EXPECT_LE(timing.raster_start, timing.raster_finish);
+  EXPECT_LE(timing.raster_finish, finish);
+  EXPECT_LE(timing.preroll_duration + timing.paint_duration,
+            timing.raster_finish - timing.raster_start);
+}
+
+TEST_F(EmbedderTest, CanAddPrecompileAndExportShaderBundles) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  const std::string invalid_bundle = "{}";
+  ASSERT_EQ(FlutterEngineAddShaderBundle(
+                engine.get(),
+                reinterpret_cast<const uint8_t*>(invalid_bundle.data()),
+                invalid_bundle.size()),
+            kInvalidArguments);
+  const std::string bundle = "{\"data\": {\"IE\": \"eA==\"}}";
+  ASSERT_EQ(FlutterEngineAddShaderBundle(
+                engine.get(), reinterpret_cast<const uint8_t*>(bundle.data()),
+                bundle.size()),
+            kSuccess);
+
+  // The software surface has no context to precompile the shaders with.
+  fml::AutoResetWaitableEvent precompile_latch;
+  ASSERT_EQ(FlutterEnginePrecompileShaders(
+                engine.get(),
+                [](size_t count, void* user_data) {
+                  EXPECT_EQ(count, 0u);
+                  reinterpret_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &precompile_latch),
+            kSuccess);
+  precompile_latch.Wait();
+
+  std::string exported;
+  fml::AutoResetWaitableEvent export_latch;
+  struct Captures {
+    std::string* exported;
+    fml::AutoResetWaitableEvent* latch;
+  } captures = {&exported, &export_latch};
+  ASSERT_EQ(FlutterEngineExportShaderBundle(
+                engine.get(),
+                [](const uint8_t* bundle, size_t bundle_size, void* user_data) {
+                  auto captures = reinterpret_cast<Captures*>(user_data);
+                  captures->exported->assign(
+                      reinterpret_cast<const char*>(bundle), bundle_size);
+                  captures->latch->Signal();
+                },
+                &captures),
+            kSuccess);
+  export_latch.Wait();
+  ASSERT_NE(exported.find("\"IE\":\"eA==\""), std::string::npos);
+}
+
 TEST_F(EmbedderTest, CanPostTaskToAllNativeThreads) {
   UniqueEngine engine;
   size_t worker_count = 0;
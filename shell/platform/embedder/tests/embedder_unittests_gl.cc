@@ -4,6 +4,8 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -2953,6 +2955,103 @@ TEST_F(EmbedderTest, CompositorRenderTargetsAreRecycled) {
   ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 10u);
 }
 
+TEST_F(EmbedderTest, CompositorRenderTargetsArePooledAcrossViews) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(300, 200));
+  builder.SetCompositor();
+  builder.GetCompositor().backing_store_cache_frames = 2;
+  builder.SetDartEntrypoint("render_targets_are_pooled_across_views");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLTexture);
+
+  fml::CountDownLatch latch(2);
+
+  context.AddNativeCallback("SignalNativeTest",
+                            CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                              latch.CountDown();
+                            }));
+
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 10u);
+        latch.CountDown();
+      });
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 300;
+  event.height = 200;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+  // The backing stores of the first frame are reused by the layers of all
+  // later frames even though their platform views change every frame.
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCreatedCount(), 5u);
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 0u);
+  engine.reset();
+  ASSERT_EQ(context.GetCompositor().GetPendingBackingStoresCount(), 0u);
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 5u);
+}
+
+TEST_F(EmbedderTest, CompositorPresentsEveryViewOfTheEngine) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(300, 200));
+  builder.SetCompositor(/*avoid_backing_store_cache=*/false,
+                        /*use_present_view_callback=*/true);
+  builder.SetDartEntrypoint("render_every_view");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLTexture);
+
+  fml::AutoResetWaitableEvent ready;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) { ready.Signal(); }));
+
+  std::mutex mutex;
+  std::set<FlutterViewId> presented_views;
+  fml::CountDownLatch latch(2);
+  context.GetCompositor().SetPresentViewCallback(
+      [&](FlutterViewId view_id, const FlutterLayer** layers,
+          size_t layers_count) {
+        ASSERT_EQ(layers_count, 1u);
+        std::scoped_lock lock(mutex);
+        if (presented_views.insert(view_id).second) {
+          latch.CountDown();
+        }
+      });
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 300;
+  event.height = 200;
+  event.pixel_ratio = 1.0;
+  event.view_id = kFlutterImplicitViewId;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  event.width = 100;
+  event.height = 50;
+  event.view_id = 1;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+  std::scoped_lock lock(mutex);
+  ASSERT_EQ(presented_views, std::set<FlutterViewId>({0, 1}));
+}
+
 TEST_F(EmbedderTest, CompositorRenderTargetsAreInStableOrder) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
 
@@ -3146,7 +3245,7 @@ TEST_F(EmbedderTest, SetSingleDisplayConfigurationWithDisplayId) {
 
   ASSERT_TRUE(engine.is_valid());
 
-  FlutterEngineDisplay display;
+  FlutterEngineDisplay display = {};
   display.struct_size = sizeof(FlutterEngineDisplay);
   display.display_id = 1;
   display.refresh_rate = 20;
@@ -3188,7 +3287,7 @@ TEST_F(EmbedderTest, SetSingleDisplayConfigurationWithoutDisplayId) {
 
   ASSERT_TRUE(engine.is_valid());
 
-  FlutterEngineDisplay display;
+  FlutterEngineDisplay display = {};
   display.struct_size = sizeof(FlutterEngineDisplay);
   display.single_display = true;
   display.refresh_rate = 20;
@@ -3230,13 +3329,13 @@ TEST_F(EmbedderTest, SetValidMultiDisplayConfiguration) {
 
   ASSERT_TRUE(engine.is_valid());
 
-  FlutterEngineDisplay display_1;
+  FlutterEngineDisplay display_1 = {};
   display_1.struct_size = sizeof(FlutterEngineDisplay);
   display_1.display_id = 1;
   display_1.single_display = false;
   display_1.refresh_rate = 20;
 
-  FlutterEngineDisplay display_2;
+  FlutterEngineDisplay display_2 = {};
   display_2.struct_size = sizeof(FlutterEngineDisplay);
   display_2.display_id = 2;
   display_2.single_display = false;
@@ -3263,6 +3362,64 @@ TEST_F(EmbedderTest, SetValidMultiDisplayConfiguration) {
   latch.Wait();
 }
 
+TEST_F(EmbedderTest, DisplaysAreReadWithTheirStructSize) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("empty_scene");
+  fml::AutoResetWaitableEvent latch;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) { latch.Signal(); }));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  // FlutterEngineDisplay as embedders compiled before the refresh rate range
+  // was added lay it out.
+  struct OldFlutterEngineDisplay {
+    size_t struct_size;
+    FlutterEngineDisplayId display_id;
+    bool single_display;
+    double refresh_rate;
+  };
+  std::vector<OldFlutterEngineDisplay> displays = {
+      {sizeof(OldFlutterEngineDisplay), 1, false, 20},
+      {sizeof(OldFlutterEngineDisplay), 2, false, 60},
+      {sizeof(OldFlutterEngineDisplay), 3, false, 120},
+  };
+
+  const FlutterEngineResult result = FlutterEngineNotifyDisplayUpdate(
+      engine.get(), kFlutterEngineDisplaysUpdateTypeStartup,
+      reinterpret_cast<const FlutterEngineDisplay*>(displays.data()),
+      displays.size());
+  ASSERT_EQ(result, kSuccess);
+
+  flutter::Shell& shell = ToEmbedderEngine(engine.get())->GetShell();
+  ASSERT_EQ(shell.GetMainDisplayRefreshRate(), 20);
+
+  // Displays of different sizes can't be told apart.
+  displays[1].struct_size = sizeof(FlutterEngineDisplay);
+  ASSERT_NE(FlutterEngineNotifyDisplayUpdate(
+                engine.get(), kFlutterEngineDisplaysUpdateTypeStartup,
+                reinterpret_cast<const FlutterEngineDisplay*>(displays.data()),
+                displays.size()),
+            kSuccess);
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+}
+
 TEST_F(EmbedderTest, MultipleDisplaysWithSingleDisplayTrueIsInvalid) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
 
@@ -3279,13 +3436,13 @@ TEST_F(EmbedderTest, MultipleDisplaysWithSingleDisplayTrueIsInvalid) {
 
   ASSERT_TRUE(engine.is_valid());
 
-  FlutterEngineDisplay display_1;
+  FlutterEngineDisplay display_1 = {};
   display_1.struct_size = sizeof(FlutterEngineDisplay);
   display_1.display_id = 1;
   display_1.single_display = true;
   display_1.refresh_rate = 20;
 
-  FlutterEngineDisplay display_2;
+  FlutterEngineDisplay display_2 = {};
   display_2.struct_size = sizeof(FlutterEngineDisplay);
   display_2.display_id = 2;
   display_2.single_display = true;
@@ -3325,13 +3482,13 @@ TEST_F(EmbedderTest, MultipleDisplaysWithSameDisplayIdIsInvalid) {
 
   ASSERT_TRUE(engine.is_valid());
 
-  FlutterEngineDisplay display_1;
+  FlutterEngineDisplay display_1 = {};
   display_1.struct_size = sizeof(FlutterEngineDisplay);
   display_1.display_id = 1;
   display_1.single_display = false;
   display_1.refresh_rate = 20;
 
-  FlutterEngineDisplay display_2;
+  FlutterEngineDisplay display_2 = {};
   display_2.struct_size = sizeof(FlutterEngineDisplay);
   display_2.display_id = 1;
   display_2.single_display = false;
@@ -201,19 +201,21 @@ bool DartComponentController::SetupFromKernel() {
     return false;
   }
 
-  if (!dart_utils::MappedResource::LoadFromNamespace(
-          nullptr, "/pkg/data/isolate_core_snapshot_data.bin",
-          isolate_snapshot_data_)) {
+  isolate_snapshot_data_ = dart_utils::MappedResource::LoadSharedFromNamespace(
+      nullptr, "/pkg/data/isolate_core_snapshot_data.bin");
+  if (!isolate_snapshot_data_) {
     return false;
   }
-  if (!dart_utils::MappedResource::LoadFromNamespace(
+  isolate_snapshot_instructions_ =
+      dart_utils::MappedResource::LoadSharedFromNamespace(
           nullptr, "/pkg/data/isolate_core_snapshot_instructions.bin",
-          isolate_snapshot_instructions_, true /* executable */)) {
+          true /* executable */);
+  if (!isolate_snapshot_instructions_) {
     return false;
   }
 
-  if (!CreateIsolate(isolate_snapshot_data_.address(),
-                     isolate_snapshot_instructions_.address())) {
+  if (!CreateIsolate(isolate_snapshot_data_->address(),
+                     isolate_snapshot_instructions_->address())) {
     return false;
   }
 
@@ -277,16 +279,21 @@ bool DartComponentController::SetupFromAppSnapshot() {
       return false;
     }
   } else {
-    if (!dart_utils::MappedResource::LoadFromNamespace(
-            namespace_, data_path_ + "/isolate_snapshot_data.bin",
-            isolate_snapshot_data_)) {
+    isolate_snapshot_data_ =
+        dart_utils::MappedResource::LoadSharedFromNamespace(
+            namespace_, data_path_ + "/isolate_snapshot_data.bin");
+    if (!isolate_snapshot_data_) {
       return false;
     }
-    if (!dart_utils::MappedResource::LoadFromNamespace(
+    isolate_snapshot_instructions_ =
+        dart_utils::MappedResource::LoadSharedFromNamespace(
             namespace_, data_path_ + "/isolate_snapshot_instructions.bin",
-            isolate_snapshot_instructions_, true /* executable */)) {
+            true /* executable */);
+    if (!isolate_snapshot_instructions_) {
       return false;
     }
+    isolate_data = isolate_snapshot_data_->address();
+    isolate_instructions = isolate_snapshot_instructions_->address();
   }
   return CreateIsolate(isolate_data, isolate_instructions);
 #endif  // defined(AOT_RUNTIME)
@@ -72,9 +72,11 @@ class DartComponentController : public fuchsia::sys::ComponentController {
   fdio_ns_t* namespace_ = nullptr;
   int stdoutfd_ = -1;
   int stderrfd_ = -1;
-  dart_utils::ElfSnapshot elf_snapshot_;                      // AOT snapshot
-  dart_utils::MappedResource isolate_snapshot_data_;          // JIT snapshot
-  dart_utils::MappedResource isolate_snapshot_instructions_;  // JIT snapshot
+  dart_utils::ElfSnapshot elf_snapshot_;  // AOT snapshot
+  // JIT snapshot, shared with the other components of the runner.
+  std::shared_ptr<const dart_utils::MappedResource> isolate_snapshot_data_;
+  std::shared_ptr<const dart_utils::MappedResource>
+      isolate_snapshot_instructions_;
   std::vector<dart_utils::MappedResource> kernel_peices_;
 
   Dart_Isolate isolate_;
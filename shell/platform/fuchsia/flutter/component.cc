@@ -40,13 +40,6 @@
 #include "task_observers.h"
 #include "task_runner_adapter.h"
 
-// TODO(kaushikiska): Use these constants from ::llcpp::fuchsia::io
-// Can read from target object.
-constexpr uint32_t OPEN_RIGHT_READABLE = 1u;
-
-// Connection can map target object executable.
-constexpr uint32_t OPEN_RIGHT_EXECUTABLE = 8u;
-
 namespace flutter_runner {
 namespace {
 
@@ -56,96 +49,30 @@ constexpr char kTmpPath[] = "/tmp";
 constexpr char kServiceRootPath[] = "/svc";
 constexpr char kRunnerConfigPath[] = "/config/data/flutter_runner_config";
 
-class FileInNamespaceBuffer final : public fml::Mapping {
- public:
-  FileInNamespaceBuffer(int namespace_fd, const char* path, bool executable)
-      : address_(nullptr), size_(0) {
-    fuchsia::mem::Buffer buffer;
-    if (!dart_utils::VmoFromFilenameAt(namespace_fd, path, executable,
-                                       &buffer)) {
-      return;
-    }
-    if (buffer.size == 0) {
-      return;
-    }
-
-    uint32_t flags = ZX_VM_PERM_READ;
-    if (executable) {
-      flags |= ZX_VM_PERM_EXECUTE;
-    }
-    uintptr_t addr;
-    zx_status_t status =
-        zx::vmar::root_self()->map(flags, 0, buffer.vmo, 0, buffer.size, &addr);
-    if (status != ZX_OK) {
-      FML_LOG(FATAL) << "Failed to map " << path << ": "
-                     << zx_status_get_string(status);
-    }
-
-    address_ = reinterpret_cast<void*>(addr);
-    size_ = buffer.size;
-  }
-
-  ~FileInNamespaceBuffer() {
-    if (address_ != nullptr) {
-      zx::vmar::root_self()->unmap(reinterpret_cast<uintptr_t>(address_),
-                                   size_);
-      address_ = nullptr;
-      size_ = 0;
-    }
-  }
-
-  // |fml::Mapping|
-  const uint8_t* GetMapping() const override {
-    return reinterpret_cast<const uint8_t*>(address_);
+// Wraps a mapping that is shared with the other components of the runner. The
+// mapping is kept alive for as long as the returned one is.
+std::unique_ptr<fml::Mapping> MakeSharedMapping(
+    std::shared_ptr<const dart_utils::MappedResource> resource) {
+  if (!resource) {
+    return nullptr;
   }
-
-  // |fml::Mapping|
-  size_t GetSize() const override { return size_; }
-
- private:
-  void* address_;
-  size_t size_;
-
-  FML_DISALLOW_COPY_AND_ASSIGN(FileInNamespaceBuffer);
-};
+  return std::make_unique<fml::NonOwnedMapping>(
+      resource->address(), resource->size(),
+      [resource](const uint8_t* data, size_t size) {});
+}
 
 std::unique_ptr<fml::Mapping> CreateWithContentsOfFile(int namespace_fd,
                                                        const char* file_path,
                                                        bool executable) {
   FML_TRACE_EVENT("flutter", "LoadFile", "path", file_path);
-  return std::make_unique<FileInNamespaceBuffer>(namespace_fd, file_path,
-                                                 executable);
+  return MakeSharedMapping(dart_utils::MappedResource::LoadSharedFromDir(
+      namespace_fd, file_path, executable));
 }
 
-std::unique_ptr<fml::FileMapping> MakeFileMapping(const char* path,
-                                                  bool executable) {
-  uint32_t flags = OPEN_RIGHT_READABLE;
-  if (executable) {
-    flags |= OPEN_RIGHT_EXECUTABLE;
-  }
-
-  int fd = 0;
-  // The returned file descriptor is compatible with standard posix operations
-  // such as close, mmap, etc. We only need to treat open/open_at specially.
-  zx_status_t status = fdio_open_fd(path, flags, &fd);
-
-  if (status != ZX_OK) {
-    return nullptr;
-  }
-
-  using Protection = fml::FileMapping::Protection;
-
-  std::initializer_list<Protection> protection_execute = {Protection::kRead,
-                                                          Protection::kExecute};
-  std::initializer_list<Protection> protection_read = {Protection::kRead};
-  auto mapping = std::make_unique<fml::FileMapping>(
-      fml::UniqueFD{fd}, executable ? protection_execute : protection_read);
-
-  if (!mapping->IsValid()) {
-    return nullptr;
-  }
-
-  return mapping;
+std::unique_ptr<fml::Mapping> MakeFileMapping(const char* path,
+                                              bool executable) {
+  return MakeSharedMapping(dart_utils::MappedResource::LoadSharedFromNamespace(
+      nullptr, path, executable));
 }
 
 std::string DebugLabelForURL(const std::string& url) {
@@ -52,9 +52,11 @@ void UpdateNativeThreadLabelNames(const std::string& label,
 
 fml::RefPtr<flutter::PlatformMessage> MakeLocalizationPlatformMessage(
     const fuchsia::intl::Profile& intl_profile) {
+  const std::vector<uint8_t> data =
+      MakeLocalizationPlatformMessageData(intl_profile);
   return fml::MakeRefCounted<flutter::PlatformMessage>(
-      "flutter/localization", MakeLocalizationPlatformMessageData(intl_profile),
-      nullptr);
+      "flutter/localization",
+      fml::MallocMapping::Copy(data.data(), data.size()), nullptr);
 }
 
 }  // namespace
@@ -11,7 +11,6 @@
 #include <algorithm>  // For std::clamp
 
 #include "flutter/fml/trace_event.h"
-#include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter_runner {
@@ -27,9 +26,9 @@ SkScalar OpacityFromMutatorStack(const flutter::MutatorsStack& mutatorsStack) {
   SkScalar mutatorsOpacity = 1.f;
   for (auto i = mutatorsStack.Bottom(); i != mutatorsStack.Top(); ++i) {
     const auto& mutator = *i;
-    switch (mutator->GetType()) {
+    switch (mutator.GetType()) {
       case flutter::MutatorType::opacity: {
-        mutatorsOpacity *= std::clamp(mutator->GetAlphaFloat(), 0.f, 1.f);
+        mutatorsOpacity *= std::clamp(mutator.GetAlphaFloat(), 0.f, 1.f);
       } break;
       default: {
         break;
@@ -45,9 +44,9 @@ SkMatrix TransformFromMutatorStack(
   SkMatrix mutatorsTransform;
   for (auto i = mutatorsStack.Bottom(); i != mutatorsStack.Top(); ++i) {
     const auto& mutator = *i;
-    switch (mutator->GetType()) {
+    switch (mutator.GetType()) {
       case flutter::MutatorType::transform: {
-        mutatorsTransform.preConcat(mutator->GetMatrix());
+        mutatorsTransform.preConcat(mutator.GetMatrix());
       } break;
       default: {
         break;
@@ -110,7 +109,7 @@ SkCanvas* FuchsiaExternalViewEmbedder::GetRootCanvas() {
     return nullptr;
   }
 
-  return found->second.canvas_spy->GetSpyingCanvas();
+  return found->second.recorder.get();
 }
 
 std::vector<SkCanvas*> FuchsiaExternalViewEmbedder::GetCurrentCanvases() {
@@ -118,7 +117,7 @@ std::vector<SkCanvas*> FuchsiaExternalViewEmbedder::GetCurrentCanvases() {
   for (const auto& layer : frame_layers_) {
     // This method (for legacy reasons) expects non-root current canvases.
     if (layer.first.has_value()) {
-      canvases.push_back(layer.second.canvas_spy->GetSpyingCanvas());
+      canvases.push_back(layer.second.recorder.get());
     }
   }
   return canvases;
@@ -140,7 +139,7 @@ SkCanvas* FuchsiaExternalViewEmbedder::CompositeEmbeddedView(int view_id) {
   auto found = frame_layers_.find(handle);
   FML_DCHECK(found != frame_layers_.end());
 
-  return found->second.canvas_spy->GetSpyingCanvas();
+  return found->second.recorder.get();
 }
 
 flutter::PostPrerollResult FuchsiaExternalViewEmbedder::PostPrerollAction(
@@ -210,7 +209,7 @@ void FuchsiaExternalViewEmbedder::SubmitFrame(
     TRACE_EVENT0("flutter", "CreateSurfaces");
 
     for (const auto& layer : frame_layers_) {
-      if (!layer.second.canvas_spy->DidDrawIntoCanvas()) {
+      if (!layer.second.recorder->did_draw()) {
         continue;
       }
 
@@ -338,7 +337,7 @@ void FuchsiaExternalViewEmbedder::SubmitFrame(
         embedded_views_height += kScenicZElevationForPlatformView;
       }
 
-      if (layer->second.canvas_spy->DidDrawIntoCanvas()) {
+      if (layer->second.recorder->did_draw()) {
         const auto& surface_index = frame_surface_indices.find(layer_id);
         FML_DCHECK(surface_index != frame_surface_indices.end());
         uint32_t surface_image_id =
@@ -435,7 +434,7 @@ void FuchsiaExternalViewEmbedder::SubmitFrame(
     session_.Present();
   }
 
-  // Render the recorded SkPictures into the surfaces.
+  // Render the recorded display lists into the surfaces.
   {
     TRACE_EVENT0("flutter", "RasterizeSurfaces");
 
@@ -444,9 +443,8 @@ void FuchsiaExternalViewEmbedder::SubmitFrame(
 
       const auto& layer = frame_layers_.find(surface_index.first);
       FML_DCHECK(layer != frame_layers_.end());
-      sk_sp<SkPicture> picture =
-          layer->second.recorder->finishRecordingAsPicture();
-      FML_DCHECK(picture);
+      sk_sp<flutter::DisplayList> display_list =
+          layer->second.recorder->Build();
 
       sk_sp<SkSurface> sk_surface =
           frame_surfaces[surface_index.second]->GetSkiaSurface();
@@ -459,7 +457,9 @@ void FuchsiaExternalViewEmbedder::SubmitFrame(
 
       canvas->setMatrix(SkMatrix::I());
       canvas->clear(SK_ColorTRANSPARENT);
-      canvas->drawPicture(picture);
+      canvas->clipRect(
+          SkRect::Make(layer->second.recorder->draw_bounds().roundOut()));
+      display_list->RenderTo(canvas);
       canvas->flush();
     }
   }
@@ -16,12 +16,11 @@
 #include <unordered_map>
 #include <vector>
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
-#include "flutter/shell/common/canvas_spy.h"
 #include "third_party/skia/include/core/SkCanvas.h"
-#include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/core/SkPoint.h"
 #include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
@@ -108,15 +107,12 @@ class FuchsiaExternalViewEmbedder final : public flutter::ExternalViewEmbedder {
     EmbedderLayer(const SkISize& frame_size,
                   std::optional<flutter::EmbeddedViewParams> view_params)
         : embedded_view_params(std::move(view_params)),
-          recorder(std::make_unique<SkPictureRecorder>()),
-          canvas_spy(std::make_unique<flutter::CanvasSpy>(
-              recorder->beginRecording(frame_size.width(),
-                                       frame_size.height()))),
+          recorder(std::make_unique<flutter::DisplayListCanvasRecorder>(
+              SkRect::Make(frame_size))),
           surface_size(frame_size) {}
 
     std::optional<flutter::EmbeddedViewParams> embedded_view_params;
-    std::unique_ptr<SkPictureRecorder> recorder;
-    std::unique_ptr<flutter::CanvasSpy> canvas_spy;
+    std::unique_ptr<flutter::DisplayListCanvasRecorder> recorder;
     SkISize surface_size;
   };
 
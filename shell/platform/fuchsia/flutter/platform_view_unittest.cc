@@ -87,6 +87,13 @@ class MockPlatformViewDelegate : public flutter::PlatformView::Delegate {
     message_ = std::move(message);
   }
   // |flutter::PlatformView::Delegate|
+  void OnPlatformViewDispatchPlatformMessages(
+      std::vector<fml::RefPtr<flutter::PlatformMessage>> messages) {
+    if (!messages.empty()) {
+      message_ = std::move(messages.back());
+    }
+  }
+  // |flutter::PlatformView::Delegate|
   void OnPlatformViewDispatchPointerDataPacket(
       std::unique_ptr<flutter::PointerDataPacket> packet) {}
   // |flutter::PlatformView::Delegate|
@@ -571,7 +578,7 @@ TEST_F(PlatformViewTests, EnableWireframeTest) {
   fml::RefPtr<flutter::PlatformMessage> message =
       fml::MakeRefCounted<flutter::PlatformMessage>(
           "flutter/platform_views",
-          std::vector<uint8_t>(txt, txt + sizeof(txt)),
+          fml::MallocMapping::Copy(txt, sizeof(txt)),
           fml::RefPtr<flutter::PlatformMessageResponse>());
   base_view->HandlePlatformMessage(message);
 
@@ -631,7 +638,7 @@ TEST_F(PlatformViewTests, CreateViewTest) {
   fml::RefPtr<flutter::PlatformMessage> message =
       fml::MakeRefCounted<flutter::PlatformMessage>(
           "flutter/platform_views",
-          std::vector<uint8_t>(txt, txt + sizeof(txt)),
+          fml::MallocMapping::Copy(txt, sizeof(txt)),
           fml::RefPtr<flutter::PlatformMessageResponse>());
   base_view->HandlePlatformMessage(message);
 
@@ -682,7 +689,7 @@ TEST_F(PlatformViewTests, UpdateViewTest) {
   fml::RefPtr<flutter::PlatformMessage> message =
       fml::MakeRefCounted<flutter::PlatformMessage>(
           "flutter/platform_views",
-          std::vector<uint8_t>(txt, txt + sizeof(txt)),
+          fml::MallocMapping::Copy(txt, sizeof(txt)),
           fml::RefPtr<flutter::PlatformMessageResponse>());
   base_view->HandlePlatformMessage(message);
 
@@ -739,7 +746,7 @@ TEST_F(PlatformViewTests, DestroyViewTest) {
   fml::RefPtr<flutter::PlatformMessage> message =
       fml::MakeRefCounted<flutter::PlatformMessage>(
           "flutter/platform_views",
-          std::vector<uint8_t>(txt, txt + sizeof(txt)),
+          fml::MallocMapping::Copy(txt, sizeof(txt)),
           fml::RefPtr<flutter::PlatformMessageResponse>());
   base_view->HandlePlatformMessage(message);
 
@@ -800,8 +807,8 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
   static_cast<flutter::PlatformView*>(&platform_view)
       ->HandlePlatformMessage(fml::MakeRefCounted<flutter::PlatformMessage>(
           "flutter/platform_views",
-          std::vector<uint8_t>(create_view_call.begin(),
-                               create_view_call.end()),
+          fml::MallocMapping::Copy(create_view_call.c_str(),
+                                   create_view_call.size()),
           fml::RefPtr<flutter::PlatformMessageResponse>()));
   RunLoopUntilIdle();
 
@@ -827,8 +834,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
       << "  }"
       << "}";
   EXPECT_EQ(view_connected_expected_out.str(),
-            std::string(view_connected_msg->data().begin(),
-                        view_connected_msg->data().end()));
+            std::string(reinterpret_cast<const char*>(
+                            view_connected_msg->data().GetMapping()),
+                        view_connected_msg->data().GetSize()));
 
   // ViewDisconnected event.
   delegate.Reset();
@@ -852,8 +860,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
       << "  }"
       << "}";
   EXPECT_EQ(view_disconnected_expected_out.str(),
-            std::string(view_disconnected_msg->data().begin(),
-                        view_disconnected_msg->data().end()));
+            std::string(reinterpret_cast<const char*>(
+                            view_disconnected_msg->data().GetMapping()),
+                        view_disconnected_msg->data().GetSize()));
 
   // ViewStateChanged event.
   delegate.Reset();
@@ -883,8 +892,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
       << "  }"
       << "}";
   EXPECT_EQ(view_state_changed_expected_out.str(),
-            std::string(view_state_changed_msg->data().begin(),
-                        view_state_changed_msg->data().end()));
+            std::string(reinterpret_cast<const char*>(
+                            view_state_changed_msg->data().GetMapping()),
+                        view_state_changed_msg->data().GetSize()));
 }
 
 // This test makes sure that the PlatformView forwards messages on the
@@ -939,7 +949,7 @@ TEST_F(PlatformViewTests, RequestFocusTest) {
   fml::RefPtr<flutter::PlatformMessage> message =
       fml::MakeRefCounted<flutter::PlatformMessage>(
           "flutter/platform_views",
-          std::vector<uint8_t>(buff, buff + sizeof(buff)), response);
+          fml::MallocMapping::Copy(buff, sizeof(buff)), response);
   base_view->HandlePlatformMessage(message);
 
   RunLoopUntilIdle();
@@ -1002,7 +1012,7 @@ TEST_F(PlatformViewTests, RequestFocusFailTest) {
   fml::RefPtr<flutter::PlatformMessage> message =
       fml::MakeRefCounted<flutter::PlatformMessage>(
           "flutter/platform_views",
-          std::vector<uint8_t>(buff, buff + sizeof(buff)), response);
+          fml::MallocMapping::Copy(buff, sizeof(buff)), response);
   base_view->HandlePlatformMessage(message);
 
   RunLoopUntilIdle();
@@ -1094,8 +1104,9 @@ TEST_F(PlatformViewTests, OnKeyEvent) {
           key_event_status = status;
         });
     RunLoopUntilIdle();
-    const std::vector<uint8_t> data = delegate.message()->data();
-    const std::string message = std::string(data.begin(), data.end());
+    const fml::MallocMapping& data = delegate.message()->data();
+    const std::string message = std::string(
+        reinterpret_cast<const char*>(data.GetMapping()), data.GetSize());
 
     EXPECT_EQ(event.expected_platform_message, message);
     EXPECT_EQ(key_event_status, event.expected_key_event_status);
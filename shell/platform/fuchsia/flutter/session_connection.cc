@@ -43,6 +43,8 @@ SessionConnection::SessionConnection(
                      kMaxFramesInFlight);
         FML_DCHECK(frames_in_flight_ >= 0);
 
+        RecordLatchedPresents(info);
+
         VsyncRecorder::GetInstance().UpdateFramePresentedInfo(
             zx::time(info.actual_presentation_time));
 
@@ -165,12 +167,13 @@ void SessionConnection::PresentSession() {
       VsyncRecorder::GetInstance().GetCurrentVsyncInfo().presentation_interval;
 
   fml::TimePoint next_latch_point = CalculateNextLatchPoint(
-      fml::TimePoint::Now(), present_requested_time_,
+      present_requested_time_, fml::TimePoint::Now(),
       last_latch_point_targeted_,
       fml::TimeDelta::FromMicroseconds(0),  // flutter_frame_build_time
       presentation_interval, future_presentation_infos_);
 
   last_latch_point_targeted_ = next_latch_point;
+  targeted_latch_points_.push_back(next_latch_point);
 
   session_wrapper_.Present2(
       /*requested_presentation_time=*/next_latch_point.ToEpochDelta()
@@ -197,6 +200,31 @@ void SessionConnection::PresentSession() {
       });
 }
 
+void SessionConnection::RecordLatchedPresents(
+    const fuchsia::scenic::scheduling::FramePresentedInfo& info) {
+  for (const auto& present_info : info.presentation_infos) {
+    if (targeted_latch_points_.empty()) {
+      break;
+    }
+    fml::TimePoint targeted_latch_point = targeted_latch_points_.front();
+    targeted_latch_points_.pop_front();
+
+    if (!present_info.has_latched_time()) {
+      continue;
+    }
+    fml::TimePoint latched_time = fml::TimePoint::FromEpochDelta(
+        fml::TimeDelta::FromNanoseconds(present_info.latched_time()));
+    if (latched_time > targeted_latch_point) {
+      missed_latch_count_++;
+      TRACE_EVENT_INSTANT1(
+          "gfx", "SessionConnection::MissedLatch", "late_by_us",
+          (latched_time - targeted_latch_point).ToMicroseconds());
+    }
+  }
+  TRACE_COUNTER("gfx", "SessionConnection", 0u, "MissedLatches",
+                missed_latch_count_);
+}
+
 void SessionConnection::ToggleSignal(zx_handle_t handle, bool set) {
   const auto signal = VsyncWaiter::SessionPresentSignal;
   auto status = zx_object_signal(handle,            // handle
@@ -35,6 +35,10 @@ class SessionConnection final : public flutter::SessionWrapper {
   scenic::Session* get() override { return &session_wrapper_; }
   void Present() override;
 
+  // The number of presented frames that Scenic latched after the latch point
+  // they targeted, which usually means that they missed their vsync.
+  uint64_t missed_latch_count() const { return missed_latch_count_; }
+
   static fml::TimePoint CalculateNextLatchPoint(
       fml::TimePoint present_requested_time,
       fml::TimePoint now,
@@ -59,6 +63,11 @@ class SessionConnection final : public flutter::SessionWrapper {
   std::deque<std::pair<fml::TimePoint, fml::TimePoint>>
       future_presentation_infos_ = {};
 
+  // The latch points targeted by the presents that Scenic has not reported as
+  // presented yet, oldest first.
+  std::deque<fml::TimePoint> targeted_latch_points_;
+  uint64_t missed_latch_count_ = 0;
+
   bool initialized_ = false;
 
   // A flow event trace id for following |Session::Present| calls into
@@ -81,6 +90,11 @@ class SessionConnection final : public flutter::SessionWrapper {
 
   void PresentSession();
 
+  // Compares the latch times of the presents reported in |info| to the latch
+  // points they targeted, and counts the ones that were missed.
+  void RecordLatchedPresents(
+      const fuchsia::scenic::scheduling::FramePresentedInfo& info);
+
   static void ToggleSignal(zx_handle_t handle, bool raise);
 
   FML_DISALLOW_COPY_AND_ASSIGN(SessionConnection);
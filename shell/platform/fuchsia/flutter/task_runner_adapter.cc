@@ -36,6 +36,21 @@ class CompatTaskRunner : public fml::TaskRunner {
                            zx::duration(delay.ToNanoseconds()));
   }
 
+  void PostTaskWithPriority(const fml::closure& task,
+                            fml::TimePoint target_time,
+                            fml::TaskPriority priority,
+                            fml::TimePoint deadline) override {
+    // The dispatcher runs tasks in the order of their target times.
+    PostTaskForTime(task, target_time);
+  }
+
+  void PostDelayedTaskWithLeeway(const fml::closure& task,
+                                 fml::TimeDelta delay,
+                                 fml::TimeDelta leeway) override {
+    // The dispatcher has no notion of timer slack.
+    PostDelayedTask(task, delay);
+  }
+
   bool RunsTasksOnCurrentThread() override {
     return forwarding_target_ == async_get_default_dispatcher();
   }
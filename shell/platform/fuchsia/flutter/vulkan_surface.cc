@@ -293,6 +293,11 @@ bool VulkanSurface::AllocateDeviceMemory(
       .memoryTypeIndex = static_cast<uint32_t>(__builtin_ctz(bits)),
   };
 
+  // This memory is imported from the sysmem buffer collection shared with
+  // Scenic, so it cannot be suballocated from a larger heap allocation like
+  // the memory Skia allocates through its GrVkMemoryAllocator. The number of
+  // these allocations is instead bounded by the reuse of surfaces in
+  // VulkanSurfacePool.
   {
     TRACE_EVENT1("flutter", "vkAllocateMemory", "allocationSize",
                  allocation_info.allocationSize);
@@ -76,6 +76,8 @@ std::unique_ptr<VulkanSurface> VulkanSurfacePool::GetCachedOrCreateSurface(
     if (exact_match_it != available_surfaces_.end()) {
       auto acquired_surface = std::move(*exact_match_it);
       available_surfaces_.erase(exact_match_it);
+      trace_surfaces_reused_++;
+      stats_.surfaces_reused++;
       TRACE_EVENT_INSTANT0("flutter", "Exact match found");
       return acquired_surface;
     }
@@ -120,6 +122,7 @@ std::unique_ptr<VulkanSurface> VulkanSurfacePool::CreateSurface(
     return nullptr;
   }
   trace_surfaces_created_++;
+  stats_.surfaces_created++;
   return surface;
 }
 
@@ -147,13 +150,24 @@ void VulkanSurfacePool::RecycleSurface(std::unique_ptr<VulkanSurface> surface) {
   }
 
   TRACE_EVENT0("flutter", "VulkanSurfacePool::RecycleSurface");
-  // Recycle the buffer by putting it in the list of available surfaces if we
-  // have not reached the maximum amount of cached surfaces.
-  if (available_surfaces_.size() < kMaxSurfaces) {
-    available_surfaces_.push_back(std::move(surface));
-  } else {
-    TRACE_EVENT_INSTANT0("flutter", "Too many surfaces in pool, dropping");
+  const size_t surface_bytes = surface->GetAllocationSize();
+  if (surface_bytes > kMaxCachedBytes) {
+    TRACE_EVENT_INSTANT0("flutter", "Surface larger than pool, dropping");
+    stats_.surfaces_evicted++;
+    TraceStats();
+    return;
+  }
+
+  // Recycle the buffer by putting it in the list of available surfaces,
+  // evicting the least recently used ones until it fits in the budget.
+  size_t cached_bytes = CachedBytes();
+  while (cached_bytes + surface_bytes > kMaxCachedBytes) {
+    TRACE_EVENT_INSTANT0("flutter", "Pool over budget, evicting surface");
+    cached_bytes -= available_surfaces_.front()->GetAllocationSize();
+    available_surfaces_.erase(available_surfaces_.begin());
+    stats_.surfaces_evicted++;
   }
+  available_surfaces_.push_back(std::move(surface));
   TraceStats();
 }
 
@@ -223,12 +237,25 @@ void VulkanSurfacePool::ShrinkToFit() {
   TraceStats();
 }
 
-void VulkanSurfacePool::TraceStats() {
-  // Resources held in cached buffers.
-  size_t cached_surfaces_bytes = 0;
+VulkanSurfacePool::Stats VulkanSurfacePool::GetStats() const {
+  Stats stats = stats_;
+  stats.cached_surfaces = available_surfaces_.size();
+  stats.cached_bytes = CachedBytes();
+  stats.pending_surfaces = pending_surfaces_.size();
+  return stats;
+}
+
+size_t VulkanSurfacePool::CachedBytes() const {
+  size_t cached_bytes = 0;
   for (const auto& surface : available_surfaces_) {
-    cached_surfaces_bytes += surface->GetAllocationSize();
+    cached_bytes += surface->GetAllocationSize();
   }
+  return cached_bytes;
+}
+
+void VulkanSurfacePool::TraceStats() {
+  // Resources held in cached buffers.
+  const size_t cached_surfaces_bytes = CachedBytes();
 
   // Resources held by Skia.
   int skia_resources = 0;
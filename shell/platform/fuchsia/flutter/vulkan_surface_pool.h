@@ -14,12 +14,24 @@ namespace flutter_runner {
 
 class VulkanSurfacePool final {
  public:
-  // Only keep 12 surfaces at a time.  This value was based on how many
-  // surfaces got cached in the old, exact-match-only caching logic.
-  static constexpr int kMaxSurfaces = 12;
+  // Only keep this many bytes of device memory in cached surfaces at a time,
+  // about 12 full HD surfaces. Surfaces are weighed by their memory rather
+  // than counted, so that many small surfaces can be cached at once.
+  static constexpr size_t kMaxCachedBytes = 96 * 1024 * 1024;
   // If a surface doesn't get used for 3 or more generations, we discard it.
   static constexpr int kMaxSurfaceAge = 3;
 
+  // Totals since the pool was created, for diagnostics beyond the per frame
+  // trace counters.
+  struct Stats {
+    size_t surfaces_created = 0;
+    size_t surfaces_reused = 0;
+    size_t surfaces_evicted = 0;
+    size_t cached_surfaces = 0;
+    size_t cached_bytes = 0;
+    size_t pending_surfaces = 0;
+  };
+
   VulkanSurfacePool(vulkan::VulkanProvider& vulkan_provider,
                     sk_sp<GrDirectContext> context,
                     scenic::Session* scenic_session);
@@ -37,6 +49,8 @@ class VulkanSurfacePool final {
   // small as they can be.
   void ShrinkToFit();
 
+  Stats GetStats() const;
+
  private:
   vulkan::VulkanProvider& vulkan_provider_;
   sk_sp<GrDirectContext> context_;
@@ -49,6 +63,7 @@ class VulkanSurfacePool final {
 
   size_t trace_surfaces_created_ = 0;
   size_t trace_surfaces_reused_ = 0;
+  Stats stats_;
 
   std::unique_ptr<VulkanSurface> GetCachedOrCreateSurface(const SkISize& size);
 
@@ -56,6 +71,9 @@ class VulkanSurfacePool final {
 
   void RecyclePendingSurface(uintptr_t surface_key);
 
+  // The device memory held by |available_surfaces_|.
+  size_t CachedBytes() const;
+
   void TraceStats();
 
   FML_DISALLOW_COPY_AND_ASSIGN(VulkanSurfacePool);
@@ -11,9 +11,11 @@
 #include <string>
 #include <vector>
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/gpu/GrBackendSemaphore.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrContextOptions.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/vk/GrVkBackendContext.h"
 #include "third_party/skia/include/gpu/vk/GrVkExtensions.h"
@@ -138,7 +140,15 @@ bool VulkanSurfaceProducer::Initialize(scenic::Session* scenic_session) {
                      countof(device_extensions), device_extensions);
   backend_context.fVkExtensions = &vk_extensions;
 
-  context_ = GrDirectContext::MakeVulkan(backend_context);
+  GrContextOptions options;
+  if (flutter::PersistentCache::cache_sksl()) {
+    options.fShaderCacheStrategy = GrContextOptions::ShaderCacheStrategy::kSkSL;
+  }
+  flutter::PersistentCache::MarkStrategySet();
+  // Lets Skia reuse the VkPipelineCache of previous runs.
+  options.fPersistentCache = flutter::PersistentCache::GetCacheForProcess();
+
+  context_ = GrDirectContext::MakeVulkan(backend_context, options);
 
   if (context_ == nullptr) {
     FML_LOG(ERROR) << "Failed to create GrDirectContext.";
@@ -148,6 +158,9 @@ bool VulkanSurfaceProducer::Initialize(scenic::Session* scenic_session) {
   // Use local limits specified in this file above instead of flutter defaults.
   context_->setResourceCacheLimits(kGrCacheMaxCount, kGrCacheMaxByteSize);
 
+  flutter::PersistentCache::GetCacheForProcess()->PrecompileKnownSkSLs(
+      context_.get());
+
   surface_pool_ =
       std::make_unique<VulkanSurfacePool>(*this, context_, scenic_session);
 
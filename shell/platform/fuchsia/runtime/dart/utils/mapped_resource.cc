@@ -18,6 +18,10 @@
 #include <zircon/dlfcn.h>
 #include <zircon/status.h>
 
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include "third_party/dart/runtime/include/dart_api.h"
 
 #include "inlines.h"
@@ -60,6 +64,84 @@ static bool OpenVmo(fuchsia::mem::Buffer* resource_vmo,
   return true;
 }
 
+namespace {
+
+// Identifies the content of a mapping. The files of blobfs hand out clones of
+// the VMO of their blob, which is shared by all the files with the same
+// content, so the koid of the parent of a VMO identifies its content.
+struct SharedMappingKey {
+  zx_koid_t content_koid;
+  uint64_t size;
+  bool executable;
+
+  bool operator<(const SharedMappingKey& other) const {
+    return std::tie(content_koid, size, executable) <
+           std::tie(other.content_koid, other.size, other.executable);
+  }
+};
+
+std::mutex shared_mappings_mutex;
+
+// The mappings that are alive in the process. They are unmapped when the last
+// of their users releases them.
+std::map<SharedMappingKey, std::weak_ptr<const MappedResource>>&
+SharedMappings() {
+  static auto* shared_mappings =
+      new std::map<SharedMappingKey, std::weak_ptr<const MappedResource>>();
+  return *shared_mappings;
+}
+
+bool GetContentKoid(const zx::vmo& vmo, zx_koid_t* content_koid) {
+  zx_info_vmo_t info;
+  zx_status_t status =
+      vmo.get_info(ZX_INFO_VMO, &info, sizeof(info), nullptr, nullptr);
+  if (status != ZX_OK) {
+    FX_LOGF(ERROR, LOG_TAG, "Failed to get VMO info: %s",
+            zx_status_get_string(status));
+    return false;
+  }
+  *content_koid =
+      info.parent_koid != ZX_KOID_INVALID ? info.parent_koid : info.koid;
+  return true;
+}
+
+std::shared_ptr<const MappedResource> LoadShared(
+    const std::string& path,
+    fuchsia::mem::Buffer resource_vmo,
+    bool executable) {
+  zx_koid_t content_koid;
+  if (!GetContentKoid(resource_vmo.vmo, &content_koid)) {
+    return nullptr;
+  }
+  const SharedMappingKey key = {content_koid, resource_vmo.size, executable};
+
+  std::scoped_lock lock(shared_mappings_mutex);
+  auto& shared_mappings = SharedMappings();
+  auto found = shared_mappings.find(key);
+  if (found != shared_mappings.end()) {
+    if (auto resource = found->second.lock()) {
+      TRACE_INSTANT("dart", "ReuseSharedMapping", TRACE_SCOPE_THREAD, "path",
+                    path);
+      return resource;
+    }
+  }
+
+  auto resource = std::make_shared<MappedResource>();
+  if (!MappedResource::LoadFromVmo(path, std::move(resource_vmo), *resource,
+                                   executable)) {
+    return nullptr;
+  }
+
+  // Drop the entries of the mappings that have been released since.
+  for (auto it = shared_mappings.begin(); it != shared_mappings.end();) {
+    it = it->second.expired() ? shared_mappings.erase(it) : std::next(it);
+  }
+  shared_mappings[key] = resource;
+  return resource;
+}
+
+}  // namespace
+
 bool MappedResource::LoadFromNamespace(fdio_ns_t* namespc,
                                        const std::string& path,
                                        MappedResource& resource,
@@ -69,6 +151,30 @@ bool MappedResource::LoadFromNamespace(fdio_ns_t* namespc,
          LoadFromVmo(path, std::move(resource_vmo), resource, executable);
 }
 
+std::shared_ptr<const MappedResource> MappedResource::LoadSharedFromNamespace(
+    fdio_ns_t* namespc,
+    const std::string& path,
+    bool executable) {
+  fuchsia::mem::Buffer resource_vmo;
+  if (!OpenVmo(&resource_vmo, namespc, path, executable)) {
+    return nullptr;
+  }
+  return LoadShared(path, std::move(resource_vmo), executable);
+}
+
+std::shared_ptr<const MappedResource> MappedResource::LoadSharedFromDir(
+    int dirfd,
+    const std::string& path,
+    bool executable) {
+  TRACE_DURATION("dart", "LoadFromDir", "path", path);
+  dart_utils::Check(path[0] != '/', LOG_TAG);
+  fuchsia::mem::Buffer resource_vmo;
+  if (!VmoFromFilenameAt(dirfd, path, executable, &resource_vmo)) {
+    return nullptr;
+  }
+  return LoadShared(path, std::move(resource_vmo), executable);
+}
+
 bool MappedResource::LoadFromVmo(const std::string& path,
                                  fuchsia::mem::Buffer resource_vmo,
                                  MappedResource& resource,
@@ -8,6 +8,9 @@
 #include <fuchsia/mem/cpp/fidl.h>
 #include <lib/fdio/namespace.h>
 
+#include <memory>
+#include <string>
+
 #include "third_party/dart/runtime/bin/elf_loader.h"
 
 namespace dart_utils {
@@ -89,6 +92,23 @@ class MappedResource {
                           MappedResource& resource,
                           bool executable = false);
 
+  // Same as LoadFromNamespace, but shares the mapping with every other caller
+  // in the process that loads the same content with the same protection, as
+  // long as one of them holds on to it. Files are identified by the VMO that
+  // backs them, so this must only be used for immutable package content, such
+  // as the files of blobfs. Returns nullptr on failure.
+  static std::shared_ptr<const MappedResource> LoadSharedFromNamespace(
+      fdio_ns_t* namespc,
+      const std::string& path,
+      bool executable = false);
+
+  // Same as LoadSharedFromNamespace, but takes a file descriptor to an opened
+  // directory instead of a namespace.
+  static std::shared_ptr<const MappedResource> LoadSharedFromDir(
+      int dirfd,
+      const std::string& path,
+      bool executable = false);
+
   const uint8_t* address() const {
     return reinterpret_cast<const uint8_t*>(address_);
   }
@@ -22,7 +22,7 @@ bool EventLoop::RunsTasksOnCurrentThread() const {
 
 void EventLoop::WaitForEvents(std::chrono::nanoseconds max_wait) {
   const auto now = TaskTimePoint::clock::now();
-  std::vector<FlutterTask> expired_tasks;
+  std::vector<Task> expired_tasks;
 
   // Process expired tasks.
   {
@@ -39,7 +39,7 @@ void EventLoop::WaitForEvents(std::chrono::nanoseconds max_wait) {
       // because we are still holding onto the task queue mutex. We don't want
       // other threads to block on posting tasks onto this thread till we are
       // done processing expired tasks.
-      expired_tasks.push_back(task_queue_.top().task);
+      expired_tasks.push_back(task_queue_.top());
 
       // Remove the tasks from the delayed tasks queue.
       task_queue_.pop();
@@ -50,7 +50,11 @@ void EventLoop::WaitForEvents(std::chrono::nanoseconds max_wait) {
   {
     // Flushing tasks here without holing onto the task queue mutex.
     for (const auto& task : expired_tasks) {
-      on_task_expired_(&task);
+      if (task.closure) {
+        task.closure();
+      } else {
+        on_task_expired_(&task.task);
+      }
     }
   }
 
@@ -80,18 +84,29 @@ EventLoop::TaskTimePoint EventLoop::TimePointFromFlutterTime(
   return now + std::chrono::nanoseconds(flutter_duration);
 }
 
+static std::atomic_uint64_t sGlobalTaskOrder(0);
+
 void EventLoop::PostTask(FlutterTask flutter_task,
                          uint64_t flutter_target_time_nanos) {
-  static std::atomic_uint64_t sGlobalTaskOrder(0);
-
   Task task;
   task.order = ++sGlobalTaskOrder;
   task.fire_time = TimePointFromFlutterTime(flutter_target_time_nanos);
   task.task = flutter_task;
+  PushTask(std::move(task));
+}
+
+void EventLoop::PostTask(std::function<void()> closure) {
+  Task task = {};
+  task.order = ++sGlobalTaskOrder;
+  task.fire_time = TaskTimePoint::clock::now();
+  task.closure = std::move(closure);
+  PushTask(std::move(task));
+}
 
+void EventLoop::PushTask(Task task) {
   {
     std::lock_guard<std::mutex> lock(task_queue_mutex_);
-    task_queue_.push(task);
+    task_queue_.push(std::move(task));
 
     // Make sure the queue mutex is unlocked before waking up the loop. In case
     // the wake causes this thread to be descheduled for the primary thread to
@@ -46,6 +46,9 @@ class EventLoop {
   // Posts a Flutter engine task to the event loop for delayed execution.
   void PostTask(FlutterTask flutter_task, uint64_t flutter_target_time_nanos);
 
+  // Posts a closure to the event loop to run as soon as possible.
+  void PostTask(std::function<void()> closure);
+
  protected:
   using TaskTimePoint = std::chrono::steady_clock::time_point;
 
@@ -67,6 +70,8 @@ class EventLoop {
     uint64_t order;
     TaskTimePoint fire_time;
     FlutterTask task;
+    // Run instead of |task| if set.
+    std::function<void()> closure;
 
     struct Comparer {
       bool operator()(const Task& a, const Task& b) {
@@ -81,6 +86,10 @@ class EventLoop {
   TaskExpiredCallback on_task_expired_;
   std::mutex task_queue_mutex_;
   std::priority_queue<Task, std::deque<Task>, Task::Comparer> task_queue_;
+
+ private:
+  // Queues |task| and wakes the event loop.
+  void PushTask(Task task);
 };
 
 }  // namespace flutter
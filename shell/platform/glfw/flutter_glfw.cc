@@ -12,6 +12,8 @@
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
+#include <mutex>
+#include <optional>
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/plugin_registrar.h"
 #include "flutter/shell/platform/common/incoming_message_dispatcher.h"
@@ -24,6 +26,7 @@
 #include "flutter/shell/platform/glfw/platform_handler.h"
 #include "flutter/shell/platform/glfw/system_utils.h"
 #include "flutter/shell/platform/glfw/text_input_plugin.h"
+#include "flutter/shell/platform/glfw/vsync_tracker.h"
 
 // GLFW_TRUE & GLFW_FALSE are introduced since libglfw-3.3,
 // add definitions here to compile under the old versions.
@@ -136,6 +139,14 @@ struct FlutterDesktopEngineState {
 
   // AOT data for this engine instance, if applicable.
   UniqueAotDataPtr aot_data = nullptr;
+
+  // Tracks the vblanks of the monitor to pace frames with. This will always be
+  // null for a headless engine.
+  std::unique_ptr<flutter::VsyncTracker> vsync_tracker;
+
+  // The vsync baton the engine is waiting for, if any.
+  std::mutex vsync_mutex;
+  std::optional<intptr_t> pending_vsync_baton;
 };
 
 // State associated with the plugin registrar.
@@ -203,6 +214,16 @@ static double GetScreenCoordinatesPerInch() {
   return primary_monitor_mode->width / (primary_monitor_width_mm / 25.4);
 }
 
+// Returns the refresh rate of the main monitor in Hz, or 0 if it is unknown.
+static int GetRefreshRate() {
+  auto* primary_monitor = glfwGetPrimaryMonitor();
+  if (primary_monitor == nullptr) {
+    return 0;
+  }
+  auto* primary_monitor_mode = glfwGetVideoMode(primary_monitor);
+  return primary_monitor_mode ? primary_monitor_mode->refreshRate : 0;
+}
+
 // Sends a window metrics update to the Flutter engine using the given
 // framebuffer size and the current window information in |state|.
 static void SendWindowMetrics(FlutterDesktopWindowControllerState* controller,
@@ -558,10 +579,47 @@ static bool EnginePresent(void* user_data) {
   if (!window_controller) {
     return false;
   }
+  // The swap waits for the next vblank, which paces the frames of the engine.
+  const uint64_t swap_start_time = FlutterEngineGetCurrentTime();
   glfwSwapBuffers(window_controller->window.get());
+  engine_state->vsync_tracker->OnSwap(swap_start_time,
+                                      FlutterEngineGetCurrentTime());
   return true;
 }
 
+// Returns the vsync baton the engine is waiting for, if any, with the times of
+// a frame that starts at the next vblank. Called on the platform thread.
+static void ReturnVsyncBaton(FlutterDesktopEngineState* engine_state) {
+  std::optional<intptr_t> baton;
+  {
+    std::scoped_lock lock(engine_state->vsync_mutex);
+    baton = engine_state->pending_vsync_baton;
+    engine_state->pending_vsync_baton.reset();
+  }
+  if (!baton) {
+    return;
+  }
+  const flutter::VsyncTracker& tracker = *engine_state->vsync_tracker;
+  const uint64_t frame_start_time =
+      tracker.GetFrameStartTime(FlutterEngineGetCurrentTime());
+  FlutterEngineOnVsync(engine_state->flutter_engine, *baton, frame_start_time,
+                       frame_start_time + tracker.GetRefreshPeriodNanos());
+}
+
+// Called on an engine thread when the engine waits for a vsync. The engine
+// only runs the frame at its start time, so the baton can be returned right
+// away, but it must be returned on the platform thread.
+static void EngineOnVsync(void* user_data, intptr_t baton) {
+  FlutterDesktopEngineState* engine_state =
+      static_cast<FlutterDesktopEngineState*>(user_data);
+  {
+    std::scoped_lock lock(engine_state->vsync_mutex);
+    engine_state->pending_vsync_baton = baton;
+  }
+  engine_state->event_loop->PostTask(
+      [engine_state]() { ReturnVsyncBaton(engine_state); });
+}
+
 static uint32_t EngineGetActiveFbo(void* user_data) {
   return 0;
 }
@@ -586,6 +644,8 @@ static void GLFWClearCanvas(GLFWwindow* window) {
   glClearColor(236.0f / 255.0f, 239.0f / 255.0f, 241.0f / 255.0f, 0.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
   glFlush();
+  // Swaps wait for a vblank, which the frames of the engine are paced with.
+  glfwSwapInterval(1);
   glfwSwapBuffers(window);
   glfwMakeContextCurrent(nullptr);
 }
@@ -697,6 +757,12 @@ static bool RunFlutterEngine(
   args.command_line_argv = &argv[0];
   args.platform_message_callback = EngineOnFlutterPlatformMessage;
   args.custom_task_runners = &task_runners;
+  // Without a window, frames are paced by the engine.
+  if (engine_state->window_controller != nullptr) {
+    engine_state->vsync_tracker =
+        std::make_unique<flutter::VsyncTracker>(GetRefreshRate());
+    args.vsync_callback = EngineOnVsync;
+  }
 
   if (FlutterEngineRunsAOTCompiledDartCode()) {
     engine_state->aot_data = LoadAotData(lib_path_string);
@@ -856,6 +922,10 @@ void FlutterDesktopDestroyWindow(FlutterDesktopWindowControllerRef controller) {
   if (registrar->destruction_handler) {
     registrar->destruction_handler(registrar);
   }
+  // The handlers on the task queues may still respond to their messages.
+  controller->engine->message_dispatcher->StopTaskQueues();
+  // All batons must be returned to the engine before it shuts down.
+  ReturnVsyncBaton(controller->engine.get());
   FlutterEngineShutdown(controller->engine->flutter_engine);
   delete controller;
 }
@@ -1009,6 +1079,8 @@ void FlutterDesktopRunEngineEventLoopWithTimeout(
 }
 
 bool FlutterDesktopShutDownEngine(FlutterDesktopEngineRef engine) {
+  // The handlers on the task queues may still respond to their messages.
+  engine->message_dispatcher->StopTaskQueues();
   auto result = FlutterEngineShutdown(engine->flutter_engine);
   delete engine;
   return (result == kSuccess);
@@ -1101,6 +1173,24 @@ void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
                                                             user_data);
 }
 
+FlutterDesktopTaskQueueRef FlutterDesktopMessengerCreateTaskQueue(
+    FlutterDesktopMessengerRef messenger) {
+  return reinterpret_cast<FlutterDesktopTaskQueueRef>(
+      messenger->engine->message_dispatcher->CreateTaskQueue());
+}
+
+void FlutterDesktopMessengerSetCallbackOnTaskQueue(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageCallback callback,
+    void* user_data,
+    FlutterDesktopTaskQueueRef task_queue) {
+  messenger->engine->message_dispatcher->SetMessageCallback(
+      channel, callback, user_data,
+      reinterpret_cast<flutter::IncomingMessageDispatcher::TaskQueue*>(
+          task_queue));
+}
+
 FlutterDesktopTextureRegistrarRef FlutterDesktopRegistrarGetTextureRegistrar(
     FlutterDesktopPluginRegistrarRef registrar) {
   std::cerr << "GLFW Texture support is not implemented yet." << std::endl;
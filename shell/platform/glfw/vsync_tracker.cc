@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/glfw/vsync_tracker.h"
+
+namespace flutter {
+
+VsyncTracker::VsyncTracker(int refresh_rate)
+    : refresh_period_nanos_(refresh_rate > 0 ? 1000000000 / refresh_rate
+                                             : kDefaultRefreshPeriodNanos) {}
+
+VsyncTracker::~VsyncTracker() = default;
+
+void VsyncTracker::OnSwap(uint64_t swap_start_nanos, uint64_t swap_end_nanos) {
+  if (swap_end_nanos < swap_start_nanos + kMinBlockingSwapNanos) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  last_vblank_nanos_ = swap_end_nanos;
+}
+
+uint64_t VsyncTracker::GetFrameStartTime(uint64_t now_nanos) const {
+  uint64_t last_vblank;
+  {
+    std::scoped_lock lock(mutex_);
+    last_vblank = last_vblank_nanos_;
+  }
+  if (last_vblank == 0) {
+    return now_nanos;
+  }
+  if (last_vblank >= now_nanos) {
+    return last_vblank;
+  }
+  // The first vblank after |now_nanos| in the phase of the last one.
+  const uint64_t periods =
+      (now_nanos - last_vblank + refresh_period_nanos_ - 1) /
+      refresh_period_nanos_;
+  return last_vblank + periods * refresh_period_nanos_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_GLFW_VSYNC_TRACKER_H_
+#define FLUTTER_SHELL_PLATFORM_GLFW_VSYNC_TRACKER_H_
+
+#include <cstdint>
+#include <mutex>
+
+namespace flutter {
+
+// Tracks the vblanks of a monitor from the buffer swaps of a window that
+// waits for them, so that the engine starts frames in phase with the refresh
+// of the monitor rather than on a timer that drifts against it.
+//
+// GLFW has no portable way to wait for a vblank other than a swap with a
+// swap interval of one, which returns right after the vblank it waited for.
+// Swaps that return without having waited, for example because the driver
+// queues them, do not move the tracked phase.
+//
+// All methods are thread-safe.
+class VsyncTracker {
+ public:
+  // The minimum duration of a swap for it to be considered to have waited for
+  // a vblank.
+  static constexpr uint64_t kMinBlockingSwapNanos = 500000;
+
+  // The refresh period that is assumed when the monitor does not report a
+  // refresh rate.
+  static constexpr uint64_t kDefaultRefreshPeriodNanos = 1000000000 / 60;
+
+  // Creates a tracker for a monitor with the given refresh rate in Hz, or 0 if
+  // it is unknown.
+  explicit VsyncTracker(int refresh_rate);
+
+  ~VsyncTracker();
+
+  // Prevent copying.
+  VsyncTracker(VsyncTracker const&) = delete;
+  VsyncTracker& operator=(VsyncTracker const&) = delete;
+
+  // Records a buffer swap that started and ended at the given times.
+  void OnSwap(uint64_t swap_start_nanos, uint64_t swap_end_nanos);
+
+  // Returns the start time of a frame requested at |now_nanos|, which is the
+  // next vblank. The target time of the frame is a refresh period later.
+  uint64_t GetFrameStartTime(uint64_t now_nanos) const;
+
+  uint64_t GetRefreshPeriodNanos() const { return refresh_period_nanos_; }
+
+ private:
+  const uint64_t refresh_period_nanos_;
+
+  mutable std::mutex mutex_;
+
+  // The time of the last vblank a swap waited for, or 0 if none did yet.
+  uint64_t last_vblank_nanos_ = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_GLFW_VSYNC_TRACKER_H_
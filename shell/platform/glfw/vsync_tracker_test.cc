@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/glfw/vsync_tracker.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+constexpr uint64_t kMillisecond = 1000000;
+}  // namespace
+
+TEST(VsyncTracker, UsesRefreshRateOfMonitor) {
+  EXPECT_EQ(VsyncTracker(120).GetRefreshPeriodNanos(), 1000000000u / 120);
+  EXPECT_EQ(VsyncTracker(0).GetRefreshPeriodNanos(),
+            VsyncTracker::kDefaultRefreshPeriodNanos);
+}
+
+TEST(VsyncTracker, StartsFramesImmediatelyWithoutVblank) {
+  VsyncTracker tracker(60);
+  EXPECT_EQ(tracker.GetFrameStartTime(100 * kMillisecond), 100 * kMillisecond);
+}
+
+TEST(VsyncTracker, StartsFramesAtNextVblank) {
+  VsyncTracker tracker(100);
+  tracker.OnSwap(95 * kMillisecond, 100 * kMillisecond);
+
+  EXPECT_EQ(tracker.GetFrameStartTime(100 * kMillisecond), 100 * kMillisecond);
+  EXPECT_EQ(tracker.GetFrameStartTime(101 * kMillisecond), 110 * kMillisecond);
+  EXPECT_EQ(tracker.GetFrameStartTime(110 * kMillisecond), 110 * kMillisecond);
+  EXPECT_EQ(tracker.GetFrameStartTime(135 * kMillisecond), 140 * kMillisecond);
+}
+
+TEST(VsyncTracker, IgnoresSwapsThatDidNotWait) {
+  VsyncTracker tracker(100);
+  tracker.OnSwap(95 * kMillisecond, 100 * kMillisecond);
+  // Returned right away, so it tells nothing about the vblanks.
+  tracker.OnSwap(104 * kMillisecond, 104 * kMillisecond + 1000);
+
+  EXPECT_EQ(tracker.GetFrameStartTime(105 * kMillisecond), 110 * kMillisecond);
+}
+
+}  // namespace testing
+}  // namespace flutter
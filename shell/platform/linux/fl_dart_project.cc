@@ -16,6 +16,7 @@ struct _FlDartProject {
   GObject parent_instance;
 
   gboolean enable_mirrors;
+  gboolean direct_rendering;
   gchar* aot_library_path;
   gchar* assets_path;
   gchar* icu_data_path;
@@ -82,6 +83,19 @@ fl_dart_project_get_enable_mirrors(FlDartProject* self) {
   return self->enable_mirrors;
 }
 
+G_MODULE_EXPORT void fl_dart_project_set_direct_rendering(
+    FlDartProject* self,
+    gboolean direct_rendering) {
+  g_return_if_fail(FL_IS_DART_PROJECT(self));
+  self->direct_rendering = direct_rendering;
+}
+
+G_MODULE_EXPORT gboolean
+fl_dart_project_get_direct_rendering(FlDartProject* self) {
+  g_return_val_if_fail(FL_IS_DART_PROJECT(self), FALSE);
+  return self->direct_rendering;
+}
+
 G_MODULE_EXPORT const gchar* fl_dart_project_get_aot_library_path(
     FlDartProject* self) {
   g_return_val_if_fail(FL_IS_DART_PROJECT(self), nullptr);
@@ -38,6 +38,13 @@ TEST(FlDartProjectTest, EnableMirrors) {
   G_GNUC_END_IGNORE_DEPRECATIONS
 }
 
+TEST(FlDartProjectTest, DirectRendering) {
+  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  EXPECT_FALSE(fl_dart_project_get_direct_rendering(project));
+  fl_dart_project_set_direct_rendering(project, TRUE);
+  EXPECT_TRUE(fl_dart_project_get_direct_rendering(project));
+}
+
 TEST(FlDartProjectTest, SwitchesEmpty) {
   g_autoptr(FlDartProject) project = fl_dart_project_new();
 
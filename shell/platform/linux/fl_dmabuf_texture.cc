@@ -0,0 +1,287 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+#include <gmodule.h>
+
+// The modifier of buffers that were allocated without an explicit modifier,
+// from drm_fourcc.h.
+static constexpr uint64_t kDrmFormatModInvalid = (1ULL << 56) - 1;
+
+// The EGL attributes of the file descriptor, offset, pitch and modifier of
+// each plane.
+static constexpr EGLint kPlaneAttributes[FL_DMABUF_TEXTURE_MAX_PLANES][5] = {
+    {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE0_PITCH_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE1_PITCH_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE2_PITCH_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE3_FD_EXT, EGL_DMA_BUF_PLANE3_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE3_PITCH_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT},
+};
+
+G_DEFINE_QUARK(fl_dmabuf_texture_error_quark, fl_dmabuf_texture_error)
+
+typedef enum {
+  FL_DMABUF_TEXTURE_ERROR_FAILED,
+} FlDmabufTextureError;
+
+// A frame that was set by the producer.
+typedef struct {
+  uint32_t width;
+  uint32_t height;
+  uint32_t fourcc;
+  uint64_t modifier;
+  FlDmabufPlane planes[FL_DMABUF_TEXTURE_MAX_PLANES];
+  size_t n_planes;
+  gpointer user_data;
+  GDestroyNotify destroy_notify;
+} FlDmabufFrame;
+
+struct _FlDmabufTexture {
+  FlTextureGL parent_instance;
+
+  // Protects |pending_frame|, which is set by the producer thread.
+  GMutex mutex;
+
+  // The frame to import at the next Flutter frame, if any.
+  FlDmabufFrame* pending_frame;
+
+  // The frame the texture shows, and the image it was imported as.
+  FlDmabufFrame* frame;
+  EGLDisplay display;
+  EGLImageKHR image;
+
+  GLuint texture_id;
+};
+
+G_DEFINE_TYPE(FlDmabufTexture, fl_dmabuf_texture, fl_texture_gl_get_type())
+
+// Added here to stop the compiler from optimizing this function away.
+G_MODULE_EXPORT GType fl_dmabuf_texture_get_type();
+
+// Returns a frame to its producer.
+static void fl_dmabuf_frame_free(FlDmabufFrame* frame) {
+  if (frame->destroy_notify != nullptr) {
+    frame->destroy_notify(frame->user_data);
+  }
+  g_free(frame);
+}
+
+// Destroys the image of the current frame, and returns it to its producer.
+static void release_frame(FlDmabufTexture* self) {
+  if (self->image != EGL_NO_IMAGE_KHR) {
+    eglDestroyImageKHR(self->display, self->image);
+    self->image = EGL_NO_IMAGE_KHR;
+  }
+  g_clear_pointer(&self->frame, fl_dmabuf_frame_free);
+}
+
+// Imports |frame| as an EGL image on the current display.
+static EGLImageKHR import_frame(FlDmabufTexture* self,
+                                const FlDmabufFrame* frame,
+                                GError** error) {
+  EGLDisplay display = eglGetCurrentDisplay();
+  if (display == EGL_NO_DISPLAY) {
+    g_set_error(error, fl_dmabuf_texture_error_quark(),
+                FL_DMABUF_TEXTURE_ERROR_FAILED,
+                "DMA-BUF textures require Flutter to render with EGL");
+    return EGL_NO_IMAGE_KHR;
+  }
+  if (!epoxy_has_egl_extension(display, "EGL_EXT_image_dma_buf_import")) {
+    g_set_error(error, fl_dmabuf_texture_error_quark(),
+                FL_DMABUF_TEXTURE_ERROR_FAILED,
+                "EGL_EXT_image_dma_buf_import is not supported");
+    return EGL_NO_IMAGE_KHR;
+  }
+  gboolean has_modifier = frame->modifier != kDrmFormatModInvalid;
+  if (has_modifier &&
+      !epoxy_has_egl_extension(display,
+                               "EGL_EXT_image_dma_buf_import_modifiers")) {
+    g_set_error(error, fl_dmabuf_texture_error_quark(),
+                FL_DMABUF_TEXTURE_ERROR_FAILED,
+                "EGL_EXT_image_dma_buf_import_modifiers is not supported");
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  EGLint attributes[6 + FL_DMABUF_TEXTURE_MAX_PLANES * 10 + 1];
+  size_t n = 0;
+  attributes[n++] = EGL_WIDTH;
+  attributes[n++] = frame->width;
+  attributes[n++] = EGL_HEIGHT;
+  attributes[n++] = frame->height;
+  attributes[n++] = EGL_LINUX_DRM_FOURCC_EXT;
+  attributes[n++] = frame->fourcc;
+  for (size_t i = 0; i < frame->n_planes; i++) {
+    attributes[n++] = kPlaneAttributes[i][0];
+    attributes[n++] = frame->planes[i].fd;
+    attributes[n++] = kPlaneAttributes[i][1];
+    attributes[n++] = frame->planes[i].offset;
+    attributes[n++] = kPlaneAttributes[i][2];
+    attributes[n++] = frame->planes[i].stride;
+    if (has_modifier) {
+      attributes[n++] = kPlaneAttributes[i][3];
+      attributes[n++] = frame->modifier & 0xffffffff;
+      attributes[n++] = kPlaneAttributes[i][4];
+      attributes[n++] = frame->modifier >> 32;
+    }
+  }
+  attributes[n++] = EGL_NONE;
+
+  EGLImageKHR image = eglCreateImageKHR(display, EGL_NO_CONTEXT,
+                                        EGL_LINUX_DMA_BUF_EXT, nullptr,
+                                        attributes);
+  if (image == EGL_NO_IMAGE_KHR) {
+    g_set_error(error, fl_dmabuf_texture_error_quark(),
+                FL_DMABUF_TEXTURE_ERROR_FAILED,
+                "Failed to import DMA-BUF frame: EGL error 0x%x",
+                eglGetError());
+    return EGL_NO_IMAGE_KHR;
+  }
+  self->display = display;
+  return image;
+}
+
+// Implements FlTextureGL::populate.
+static gboolean fl_dmabuf_texture_populate(FlTextureGL* texture,
+                                           uint32_t* target,
+                                           uint32_t* name,
+                                           uint32_t* width,
+                                           uint32_t* height,
+                                           GError** error) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+
+  FlDmabufFrame* pending_frame;
+  {
+    g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);
+    pending_frame = self->pending_frame;
+    self->pending_frame = nullptr;
+  }
+
+  if (pending_frame != nullptr) {
+    EGLImageKHR image = import_frame(self, pending_frame, error);
+    if (image == EGL_NO_IMAGE_KHR) {
+      fl_dmabuf_frame_free(pending_frame);
+      return FALSE;
+    }
+
+    if (self->texture_id == 0) {
+      glGenTextures(1, &self->texture_id);
+      glBindTexture(GL_TEXTURE_EXTERNAL_OES, self->texture_id);
+      glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_S,
+                      GL_CLAMP_TO_EDGE);
+      glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_T,
+                      GL_CLAMP_TO_EDGE);
+      glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER,
+                      GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER,
+                      GL_LINEAR);
+    } else {
+      glBindTexture(GL_TEXTURE_EXTERNAL_OES, self->texture_id);
+    }
+    glEGLImageTargetTexture2DOES(GL_TEXTURE_EXTERNAL_OES, image);
+
+    // The texture no longer refers to the previous frame.
+    release_frame(self);
+    self->frame = pending_frame;
+    self->image = image;
+  }
+
+  if (self->frame == nullptr) {
+    g_set_error(error, fl_dmabuf_texture_error_quark(),
+                FL_DMABUF_TEXTURE_ERROR_FAILED, "No frame was set");
+    return FALSE;
+  }
+
+  *target = GL_TEXTURE_EXTERNAL_OES;
+  *name = self->texture_id;
+  *width = self->frame->width;
+  *height = self->frame->height;
+  return TRUE;
+}
+
+static void fl_dmabuf_texture_dispose(GObject* object) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(object);
+
+  g_clear_pointer(&self->pending_frame, fl_dmabuf_frame_free);
+  release_frame(self);
+  if (self->texture_id != 0) {
+    glDeleteTextures(1, &self->texture_id);
+    self->texture_id = 0;
+  }
+
+  G_OBJECT_CLASS(fl_dmabuf_texture_parent_class)->dispose(object);
+}
+
+static void fl_dmabuf_texture_finalize(GObject* object) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(object);
+
+  g_mutex_clear(&self->mutex);
+
+  G_OBJECT_CLASS(fl_dmabuf_texture_parent_class)->finalize(object);
+}
+
+static void fl_dmabuf_texture_class_init(FlDmabufTextureClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_dmabuf_texture_dispose;
+  G_OBJECT_CLASS(klass)->finalize = fl_dmabuf_texture_finalize;
+  FL_TEXTURE_GL_CLASS(klass)->populate = fl_dmabuf_texture_populate;
+}
+
+static void fl_dmabuf_texture_init(FlDmabufTexture* self) {
+  g_mutex_init(&self->mutex);
+  self->display = EGL_NO_DISPLAY;
+  self->image = EGL_NO_IMAGE_KHR;
+}
+
+G_MODULE_EXPORT FlDmabufTexture* fl_dmabuf_texture_new() {
+  return FL_DMABUF_TEXTURE(
+      g_object_new(fl_dmabuf_texture_get_type(), nullptr));
+}
+
+G_MODULE_EXPORT void fl_dmabuf_texture_set_frame(
+    FlDmabufTexture* self,
+    uint32_t width,
+    uint32_t height,
+    uint32_t fourcc,
+    uint64_t modifier,
+    const FlDmabufPlane* planes,
+    size_t n_planes,
+    gpointer user_data,
+    GDestroyNotify destroy_notify) {
+  g_return_if_fail(FL_IS_DMABUF_TEXTURE(self));
+  g_return_if_fail(planes != nullptr);
+  g_return_if_fail(n_planes > 0 && n_planes <= FL_DMABUF_TEXTURE_MAX_PLANES);
+
+  FlDmabufFrame* frame = g_new0(FlDmabufFrame, 1);
+  frame->width = width;
+  frame->height = height;
+  frame->fourcc = fourcc;
+  frame->modifier = modifier;
+  for (size_t i = 0; i < n_planes; i++) {
+    frame->planes[i] = planes[i];
+  }
+  frame->n_planes = n_planes;
+  frame->user_data = user_data;
+  frame->destroy_notify = destroy_notify;
+
+  FlDmabufFrame* replaced_frame;
+  {
+    g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);
+    replaced_frame = self->pending_frame;
+    self->pending_frame = frame;
+  }
+
+  // Frames that were never shown are returned right away.
+  if (replaced_frame != nullptr) {
+    fl_dmabuf_frame_free(replaced_frame);
+  }
+}
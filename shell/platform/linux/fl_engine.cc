@@ -14,7 +14,10 @@
 #include "flutter/shell/platform/linux/fl_plugin_registrar_private.h"
 #include "flutter/shell/platform/linux/fl_renderer.h"
 #include "flutter/shell/platform/linux/fl_renderer_headless.h"
+#include "flutter/shell/platform/linux/fl_renderer_offscreen.h"
 #include "flutter/shell/platform/linux/fl_settings_plugin.h"
+#include "flutter/shell/platform/linux/fl_texture_gl_private.h"
+#include "flutter/shell/platform/linux/fl_texture_registrar_private.h"
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_plugin_registry.h"
 
 static constexpr int kMicrosecondsPerNanosecond = 1000;
@@ -32,6 +35,7 @@ struct _FlEngine {
   FlRenderer* renderer;
   FlBinaryMessenger* binary_messenger;
   FlSettingsPlugin* settings_plugin;
+  FlTextureRegistrar* texture_registrar;
   FlutterEngineAOTData aot_data;
   FLUTTER_API_SYMBOL(FlutterEngine) engine;
   FlutterEngineProcTable embedder_api;
@@ -246,16 +250,25 @@ static uint32_t fl_engine_gl_get_fbo(void* user_data) {
   return fl_renderer_get_fbo(self->renderer);
 }
 
-static bool fl_engine_gl_present(void* user_data) {
+static bool fl_engine_gl_present(void* user_data,
+                                 const FlutterPresentInfo* info) {
   FlEngine* self = static_cast<FlEngine*>(user_data);
   g_autoptr(GError) error = nullptr;
-  gboolean result = fl_renderer_present(self->renderer, &error);
+  gboolean result = fl_renderer_present(self->renderer, info, &error);
   if (!result) {
     g_warning("%s", error->message);
   }
   return result;
 }
 
+static void fl_engine_gl_populate_existing_damage(
+    void* user_data,
+    const intptr_t fbo_id,
+    FlutterDamage* existing_damage) {
+  FlEngine* self = static_cast<FlEngine*>(user_data);
+  fl_renderer_get_existing_damage(self->renderer, existing_damage);
+}
+
 static bool fl_engine_gl_make_resource_current(void* user_data) {
   FlEngine* self = static_cast<FlEngine*>(user_data);
   g_autoptr(GError) error = nullptr;
@@ -266,6 +279,56 @@ static bool fl_engine_gl_make_resource_current(void* user_data) {
   return result;
 }
 
+// Called when rendering offscreen on the CPU. Frames are delivered to the
+// caller in present_layers, so there is nothing to present here.
+static bool fl_engine_software_present(void* user_data,
+                                       const void* allocation,
+                                       size_t row_bytes,
+                                       size_t height) {
+  return true;
+}
+
+// Called when the engine wants to build the next frame. Frames rendered
+// offscreen are not paced by the display, so they start straight away.
+static void fl_engine_offscreen_vsync_cb(void* user_data, intptr_t baton) {
+  FlEngine* self = static_cast<FlEngine*>(user_data);
+  uint64_t now = self->embedder_api.GetCurrentTime();
+  self->embedder_api.OnVsync(self->engine, baton, now, now);
+}
+
+static bool fl_engine_gl_external_texture_frame_callback(
+    void* user_data,
+    int64_t texture_id,
+    size_t width,
+    size_t height,
+    FlutterOpenGLTexture* opengl_texture) {
+  FlEngine* self = static_cast<FlEngine*>(user_data);
+  if (!self->texture_registrar) {
+    return false;
+  }
+
+  // Held until populating is done, the texture may be unregistered on the GTK
+  // thread meanwhile.
+  g_autoptr(FlTexture) texture =
+      fl_texture_registrar_lookup_texture(self->texture_registrar, texture_id);
+  if (texture == nullptr) {
+    g_warning("Unable to find texture %" G_GINT64_FORMAT, texture_id);
+    return false;
+  }
+
+  g_autoptr(GError) error = nullptr;
+  if (!FL_IS_TEXTURE_GL(texture)) {
+    g_warning("Unsupported texture type %" G_GINT64_FORMAT, texture_id);
+    return false;
+  }
+  if (!fl_texture_gl_populate(FL_TEXTURE_GL(texture), width, height,
+                              opengl_texture, &error)) {
+    g_warning("%s", error->message);
+    return false;
+  }
+  return true;
+}
+
 // Called by the engine to determine if it is on the GTK thread.
 static bool fl_engine_runs_task_on_current_thread(void* user_data) {
   FlEngine* self = static_cast<FlEngine*>(user_data);
@@ -289,6 +352,43 @@ static void fl_engine_post_task(FlutterTask task,
   g_source_attach(source, nullptr);
 }
 
+// Data of a platform message taken over from the engine.
+typedef struct {
+  FlutterPlatformMessageReleaseDataFnPtr release;
+  uint8_t* data;
+} MessageData;
+
+static void message_data_free(gpointer user_data) {
+  MessageData* message_data = static_cast<MessageData*>(user_data);
+  message_data->release(message_data->data);
+  g_free(message_data);
+}
+
+// Wraps the data of a platform message from the engine in a GBytes. The data
+// is taken over from the engine rather than copied where the engine allows it,
+// and released along with the GBytes.
+static GBytes* take_message_data(FlEngine* self,
+                                 const FlutterPlatformMessage* message) {
+  uint8_t* data = nullptr;
+  if (message->message_size > 0 &&
+      self->embedder_api.PlatformMessageTakeData != nullptr &&
+      self->embedder_api.PlatformMessageReleaseData != nullptr &&
+      self->embedder_api.PlatformMessageTakeData(
+          self->engine, message->response_handle, &data) == kSuccess) {
+    MessageData* message_data = g_new(MessageData, 1);
+    message_data->release = self->embedder_api.PlatformMessageReleaseData;
+    message_data->data = data;
+    return g_bytes_new_with_free_func(data, message->message_size,
+                                      message_data_free, message_data);
+  }
+  return g_bytes_new(message->message, message->message_size);
+}
+
+// Called when the engine no longer uses the data of a response.
+static void fl_engine_response_release_cb(void* user_data) {
+  g_bytes_unref(static_cast<GBytes*>(user_data));
+}
+
 // Called when a platform message is received from the engine.
 static void fl_engine_platform_message_cb(const FlutterPlatformMessage* message,
                                           void* user_data) {
@@ -296,8 +396,7 @@ static void fl_engine_platform_message_cb(const FlutterPlatformMessage* message,
 
   gboolean handled = FALSE;
   if (self->platform_message_handler != nullptr) {
-    g_autoptr(GBytes) data =
-        g_bytes_new(message->message, message->message_size);
+    g_autoptr(GBytes) data = take_message_data(self, message);
     handled = self->platform_message_handler(
         self, message->channel, data, message->response_handle,
         self->platform_message_handler_data);
@@ -336,7 +435,8 @@ static FlPluginRegistrar* fl_engine_get_registrar_for_plugin(
     const gchar* name) {
   FlEngine* self = FL_ENGINE(registry);
 
-  return fl_plugin_registrar_new(nullptr, self->binary_messenger);
+  return fl_plugin_registrar_new(nullptr, self->binary_messenger,
+                                 self->texture_registrar);
 }
 
 static void fl_engine_plugin_registry_iface_init(
@@ -361,6 +461,7 @@ static void fl_engine_dispose(GObject* object) {
   g_clear_object(&self->renderer);
   g_clear_object(&self->binary_messenger);
   g_clear_object(&self->settings_plugin);
+  g_clear_object(&self->texture_registrar);
 
   if (self->platform_message_handler_destroy_notify) {
     self->platform_message_handler_destroy_notify(
@@ -390,6 +491,7 @@ static void fl_engine_init(FlEngine* self) {
   FlutterEngineGetProcAddresses(&self->embedder_api);
 
   self->binary_messenger = fl_binary_messenger_new(self);
+  self->texture_registrar = fl_texture_registrar_new(self);
 }
 
 FlEngine* fl_engine_new(FlDartProject* project, FlRenderer* renderer) {
@@ -407,9 +509,25 @@ G_MODULE_EXPORT FlEngine* fl_engine_new_headless(FlDartProject* project) {
   return fl_engine_new(project, FL_RENDERER(renderer));
 }
 
+G_MODULE_EXPORT FlEngine* fl_engine_new_offscreen(
+    FlDartProject* project,
+    gboolean use_gpu,
+    FlEngineOffscreenBufferHandler buffer_handler,
+    FlEngineOffscreenFrameHandler frame_handler,
+    gpointer user_data,
+    GDestroyNotify destroy_notify) {
+  g_autoptr(FlRendererOffscreen) renderer = fl_renderer_offscreen_new(
+      use_gpu, buffer_handler, frame_handler, user_data, destroy_notify);
+  FlEngine* self = fl_engine_new(project, FL_RENDERER(renderer));
+  fl_renderer_offscreen_set_engine(renderer, self);
+  return self;
+}
+
 gboolean fl_engine_start(FlEngine* self, GError** error) {
   g_return_val_if_fail(FL_IS_ENGINE(self), FALSE);
 
+  gboolean offscreen = FL_IS_RENDERER_OFFSCREEN(self->renderer);
+
   FlutterRendererConfig config = {};
   config.type = kOpenGL;
   config.open_gl.struct_size = sizeof(FlutterOpenGLRendererConfig);
@@ -417,8 +535,21 @@ gboolean fl_engine_start(FlEngine* self, GError** error) {
   config.open_gl.make_current = fl_engine_gl_make_current;
   config.open_gl.clear_current = fl_engine_gl_clear_current;
   config.open_gl.fbo_callback = fl_engine_gl_get_fbo;
-  config.open_gl.present = fl_engine_gl_present;
+  config.open_gl.present_with_info = fl_engine_gl_present;
   config.open_gl.make_resource_current = fl_engine_gl_make_resource_current;
+  config.open_gl.gl_external_texture_frame_callback =
+      fl_engine_gl_external_texture_frame_callback;
+  if (fl_renderer_get_supports_partial_repaint(self->renderer)) {
+    config.open_gl.populate_existing_damage =
+        fl_engine_gl_populate_existing_damage;
+  }
+  if (offscreen && !fl_renderer_offscreen_get_use_gpu(
+                       FL_RENDERER_OFFSCREEN(self->renderer))) {
+    config = {};
+    config.type = kSoftware;
+    config.software.struct_size = sizeof(FlutterSoftwareRendererConfig);
+    config.software.surface_present_callback = fl_engine_software_present;
+  }
 
   FlutterTaskRunnerDescription platform_task_runner = {};
   platform_task_runner.struct_size = sizeof(FlutterTaskRunnerDescription);
@@ -431,7 +562,10 @@ gboolean fl_engine_start(FlEngine* self, GError** error) {
   FlutterCustomTaskRunners custom_task_runners = {};
   custom_task_runners.struct_size = sizeof(FlutterCustomTaskRunners);
   custom_task_runners.platform_task_runner = &platform_task_runner;
-  custom_task_runners.render_task_runner = &platform_task_runner;
+  // Offscreen frames are rasterized on a thread of the engine, so the next
+  // frame can be built while the last one is rasterized.
+  custom_task_runners.render_task_runner =
+      offscreen ? nullptr : &platform_task_runner;
 
   g_autoptr(GPtrArray) command_line_args =
       fl_dart_project_get_switches(self->project);
@@ -458,6 +592,9 @@ gboolean fl_engine_start(FlEngine* self, GError** error) {
       dart_entrypoint_args != nullptr ? g_strv_length(dart_entrypoint_args) : 0;
   args.dart_entrypoint_argv =
       reinterpret_cast<const char* const*>(dart_entrypoint_args);
+  if (offscreen) {
+    args.vsync_callback = fl_engine_offscreen_vsync_cb;
+  }
 
   FlutterCompositor compositor = {};
   compositor.struct_size = sizeof(FlutterCompositor);
@@ -467,7 +604,11 @@ gboolean fl_engine_start(FlEngine* self, GError** error) {
   compositor.collect_backing_store_callback =
       compositor_collect_backing_store_callback;
   compositor.present_layers_callback = compositor_present_layers_callback;
-  args.compositor = &compositor;
+  // Renderers that render straight to the screen have Flutter render the
+  // whole frame into frame buffer object 0.
+  if (fl_renderer_get_uses_compositor(self->renderer)) {
+    args.compositor = &compositor;
+  }
 
   if (self->embedder_api.RunsAOTCompiledDartCode()) {
     FlutterEngineAOTDataSource source = {};
@@ -502,9 +643,31 @@ gboolean fl_engine_start(FlEngine* self, GError** error) {
   self->settings_plugin = fl_settings_plugin_new(self->binary_messenger);
   fl_settings_plugin_start(self->settings_plugin);
 
-  result = self->embedder_api.UpdateSemanticsEnabled(self->engine, TRUE);
-  if (result != kSuccess)
-    g_warning("Failed to enable accessibility features on Flutter engine");
+  // There is no one to read offscreen frames out loud to.
+  if (!offscreen) {
+    result = self->embedder_api.UpdateSemanticsEnabled(self->engine, TRUE);
+    if (result != kSuccess)
+      g_warning("Failed to enable accessibility features on Flutter engine");
+  }
+
+  return TRUE;
+}
+
+G_MODULE_EXPORT gboolean fl_engine_start_offscreen(FlEngine* self,
+                                                   size_t width,
+                                                   size_t height,
+                                                   double pixel_ratio,
+                                                   GError** error) {
+  g_return_val_if_fail(FL_IS_ENGINE(self), FALSE);
+  g_return_val_if_fail(FL_IS_RENDERER_OFFSCREEN(self->renderer), FALSE);
+
+  if (!fl_renderer_start(self->renderer, nullptr, error)) {
+    return FALSE;
+  }
+  if (!fl_engine_start(self, error)) {
+    return FALSE;
+  }
+  fl_engine_send_window_metrics_event(self, width, height, pixel_ratio);
 
   return TRUE;
 }
@@ -568,8 +731,17 @@ gboolean fl_engine_send_platform_message_response(
     data =
         static_cast<const uint8_t*>(g_bytes_get_data(response, &data_length));
   }
-  FlutterEngineResult result = self->embedder_api.SendPlatformMessageResponse(
-      self->engine, handle, data, data_length);
+  FlutterEngineResult result;
+  if (response != nullptr &&
+      self->embedder_api.SendPlatformMessageResponseNoCopy != nullptr) {
+    // The engine keeps a reference to the response until it is done with it.
+    result = self->embedder_api.SendPlatformMessageResponseNoCopy(
+        self->engine, handle, data, data_length, fl_engine_response_release_cb,
+        g_bytes_ref(response));
+  } else {
+    result = self->embedder_api.SendPlatformMessageResponse(
+        self->engine, handle, data, data_length);
+  }
 
   if (result != kSuccess) {
     g_set_error(error, fl_engine_error_quark(), FL_ENGINE_ERROR_FAILED,
@@ -717,8 +889,43 @@ void fl_engine_dispatch_semantics_action(FlEngine* self,
                                              action_data, action_data_length);
 }
 
+gboolean fl_engine_mark_texture_frame_available(FlEngine* self,
+                                                int64_t texture_id) {
+  g_return_val_if_fail(FL_IS_ENGINE(self), FALSE);
+  return self->embedder_api.MarkExternalTextureFrameAvailable(
+             self->engine, texture_id) == kSuccess;
+}
+
+gboolean fl_engine_register_external_texture(FlEngine* self,
+                                             int64_t texture_id) {
+  g_return_val_if_fail(FL_IS_ENGINE(self), FALSE);
+  return self->embedder_api.RegisterExternalTexture(self->engine,
+                                                    texture_id) == kSuccess;
+}
+
+gboolean fl_engine_unregister_external_texture(FlEngine* self,
+                                               int64_t texture_id) {
+  g_return_val_if_fail(FL_IS_ENGINE(self), FALSE);
+  return self->embedder_api.UnregisterExternalTexture(self->engine,
+                                                      texture_id) == kSuccess;
+}
+
+gboolean fl_engine_post_render_thread_task(FlEngine* self,
+                                           VoidCallback callback,
+                                           gpointer user_data) {
+  g_return_val_if_fail(FL_IS_ENGINE(self), FALSE);
+  return self->embedder_api.PostRenderThreadTask(self->engine, callback,
+                                                 user_data) == kSuccess;
+}
+
 G_MODULE_EXPORT FlBinaryMessenger* fl_engine_get_binary_messenger(
     FlEngine* self) {
   g_return_val_if_fail(FL_IS_ENGINE(self), nullptr);
   return self->binary_messenger;
 }
+
+G_MODULE_EXPORT FlTextureRegistrar* fl_engine_get_texture_registrar(
+    FlEngine* self) {
+  g_return_val_if_fail(FL_IS_ENGINE(self), nullptr);
+  return self->texture_registrar;
+}
@@ -182,7 +182,8 @@ void fl_engine_dispatch_semantics_action(FlEngine* engine,
  * @error: (allow-none): #GError location to store the error occurring, or %NULL
  * to ignore.
  *
- * Responds to a platform message.
+ * Responds to a platform message. The engine keeps a reference to @response
+ * rather than copying it, and may release it on another thread.
  *
  * Returns: %TRUE on success.
  */
@@ -226,6 +227,59 @@ GBytes* fl_engine_send_platform_message_finish(FlEngine* engine,
                                                GAsyncResult* result,
                                                GError** error);
 
+/**
+ * fl_engine_mark_texture_frame_available:
+ * @engine: an #FlEngine.
+ * @texture_id: the identifier of the texture whose frame has been updated.
+ *
+ * Tells the Flutter engine that a new texture frame is available for the given
+ * texture.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean fl_engine_mark_texture_frame_available(FlEngine* engine,
+                                                int64_t texture_id);
+
+/**
+ * fl_engine_register_external_texture:
+ * @engine: an #FlEngine.
+ * @texture_id: the identifier of the texture that is available.
+ *
+ * Tells the Flutter engine that a new external texture is available.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean fl_engine_register_external_texture(FlEngine* engine,
+                                             int64_t texture_id);
+
+/**
+ * fl_engine_unregister_external_texture:
+ * @engine: an #FlEngine.
+ * @texture_id: the identifier of the texture that is not available anymore.
+ *
+ * Tells the Flutter engine that an existing external texture is not available
+ * anymore.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean fl_engine_unregister_external_texture(FlEngine* engine,
+                                               int64_t texture_id);
+
+/**
+ * fl_engine_post_render_thread_task:
+ * @engine: an #FlEngine.
+ * @callback: function to call on the raster thread.
+ * @user_data: user data to pass to @callback.
+ *
+ * Calls @callback on the thread the engine rasterizes frames on, after the
+ * frames that are being rasterized.
+ *
+ * Returns: %TRUE if the task was posted.
+ */
+gboolean fl_engine_post_render_thread_task(FlEngine* engine,
+                                           VoidCallback callback,
+                                           gpointer user_data);
+
 G_END_DECLS
 
 #endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_ENGINE_PRIVATE_H_
@@ -145,22 +145,27 @@ TEST(FlEngineTest, PlatformMessageResponse) {
   g_autoptr(FlEngine) engine = make_mock_engine();
   FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
 
+  g_autoptr(GBytes) response = g_bytes_new_static("test", 4);
   bool called = false;
-  embedder_api->SendPlatformMessageResponse = MOCK_ENGINE_PROC(
-      SendPlatformMessageResponse,
-      ([&called](auto engine,
-                 const FlutterPlatformMessageResponseHandle* handle,
-                 const uint8_t* data, size_t data_length) {
+  embedder_api->SendPlatformMessageResponseNoCopy = MOCK_ENGINE_PROC(
+      SendPlatformMessageResponseNoCopy,
+      ([&called, &response](
+           auto engine, const FlutterPlatformMessageResponseHandle* handle,
+           const uint8_t* data, size_t data_length,
+           VoidCallback release_callback, void* release_user_data) {
         called = true;
 
         EXPECT_EQ(
             handle,
             reinterpret_cast<const FlutterPlatformMessageResponseHandle*>(42));
+        // The response is not copied.
+        EXPECT_EQ(data, g_bytes_get_data(response, nullptr));
         EXPECT_EQ(data_length, static_cast<size_t>(4));
         EXPECT_EQ(data[0], 't');
         EXPECT_EQ(data[1], 'e');
         EXPECT_EQ(data[2], 's');
         EXPECT_EQ(data[3], 't');
+        release_callback(release_user_data);
 
         return kSuccess;
       }));
@@ -168,7 +173,6 @@ TEST(FlEngineTest, PlatformMessageResponse) {
   g_autoptr(GError) error = nullptr;
   EXPECT_TRUE(fl_engine_start(engine, &error));
   EXPECT_EQ(error, nullptr);
-  g_autoptr(GBytes) response = g_bytes_new_static("test", 4);
   EXPECT_TRUE(fl_engine_send_platform_message_response(
       engine, reinterpret_cast<const FlutterPlatformMessageResponseHandle*>(42),
       response, &error));
@@ -177,6 +181,57 @@ TEST(FlEngineTest, PlatformMessageResponse) {
   EXPECT_TRUE(called);
 }
 
+// Checks the data of platform messages from the engine is not copied.
+TEST(FlEngineTest, PlatformMessageDataTaken) {
+  g_autoptr(GMainLoop) loop = g_main_loop_new(nullptr, 0);
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
+
+  static const uint8_t* taken_data = nullptr;
+  FlutterPlatformMessageTakeDataFnPtr old_take_data =
+      embedder_api->PlatformMessageTakeData;
+  embedder_api->PlatformMessageTakeData = MOCK_ENGINE_PROC(
+      PlatformMessageTakeData,
+      ([old_take_data](auto engine,
+                       const FlutterPlatformMessageResponseHandle* handle,
+                       uint8_t** data_out) {
+        FlutterEngineResult result = old_take_data(engine, handle, data_out);
+        if (result == kSuccess) {
+          taken_data = *data_out;
+        }
+        return result;
+      }));
+
+  fl_engine_set_platform_message_handler(
+      engine,
+      [](FlEngine* engine, const gchar* channel, GBytes* message,
+         const FlutterPlatformMessageResponseHandle* response_handle,
+         gpointer user_data) -> gboolean {
+        if (strcmp(channel, "test/messages") == 0) {
+          EXPECT_NE(taken_data, nullptr);
+          EXPECT_EQ(g_bytes_get_data(message, nullptr), taken_data);
+          EXPECT_EQ(g_bytes_get_size(message), static_cast<gsize>(4));
+          g_main_loop_quit(static_cast<GMainLoop*>(user_data));
+        }
+        EXPECT_TRUE(fl_engine_send_platform_message_response(
+            engine, response_handle, nullptr, nullptr));
+        return TRUE;
+      },
+      loop, nullptr);
+
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_engine_start(engine, &error));
+  EXPECT_EQ(error, nullptr);
+
+  // Trigger the engine to send a message.
+  g_autoptr(GBytes) message = g_bytes_new_static("test", 4);
+  fl_engine_send_platform_message(engine, "test/send-message", message,
+                                  nullptr, nullptr, nullptr);
+
+  // Blocks here until the message is received.
+  g_main_loop_run(loop);
+}
+
 // Checks settings plugin sends settings on startup.
 TEST(FlEngineTest, SettingsPlugin) {
   g_autoptr(FlEngine) engine = make_mock_engine();
@@ -224,3 +279,99 @@ TEST(FlEngineTest, SettingsPlugin) {
 
   EXPECT_TRUE(called);
 }
+
+static gpointer offscreen_buffer_cb(FlEngine* engine,
+                                    size_t size,
+                                    gpointer user_data) {
+  GByteArray* pixels = static_cast<GByteArray*>(user_data);
+  g_byte_array_set_size(pixels, size);
+  return pixels->data;
+}
+
+static void offscreen_frame_cb(FlEngine* engine,
+                               gpointer buffer,
+                               size_t width,
+                               size_t height,
+                               size_t row_bytes,
+                               gpointer user_data) {
+  GByteArray* pixels = static_cast<GByteArray*>(user_data);
+  EXPECT_EQ(buffer, pixels->data);
+  EXPECT_EQ(width, static_cast<size_t>(2));
+  EXPECT_EQ(height, static_cast<size_t>(2));
+  EXPECT_EQ(row_bytes, static_cast<size_t>(8));
+}
+
+// Checks frames rendered offscreen on the CPU are written into the buffers of
+// the caller, without waiting for vsync.
+TEST(FlEngineTest, OffscreenSoftware) {
+  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  g_autoptr(GByteArray) pixels = g_byte_array_new();
+  g_autoptr(FlEngine) engine =
+      fl_engine_new_offscreen(project, FALSE, offscreen_buffer_cb,
+                              offscreen_frame_cb, pixels, nullptr);
+  FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
+
+  auto initialize = embedder_api->Initialize;
+  bool initialized = false;
+  embedder_api->Initialize = MOCK_ENGINE_PROC(
+      Initialize,
+      ([&initialized, initialize](size_t version,
+                                  const FlutterRendererConfig* config,
+                                  const FlutterProjectArgs* args,
+                                  void* user_data, auto engine_out) {
+        initialized = true;
+        EXPECT_EQ(config->type, kSoftware);
+        EXPECT_EQ(args->custom_task_runners->render_task_runner, nullptr);
+        EXPECT_NE(args->vsync_callback, nullptr);
+
+        // Render a frame of two by two pixels.
+        const FlutterCompositor* compositor = args->compositor;
+        EXPECT_NE(compositor, nullptr);
+        FlutterBackingStoreConfig backing_store_config = {};
+        backing_store_config.struct_size = sizeof(FlutterBackingStoreConfig);
+        backing_store_config.size = {2, 2};
+        FlutterBackingStore backing_store = {};
+        EXPECT_TRUE(compositor->create_backing_store_callback(
+            &backing_store_config, &backing_store, compositor->user_data));
+        EXPECT_EQ(backing_store.type, kFlutterBackingStoreTypeSoftware);
+        uint8_t* allocation = static_cast<uint8_t*>(
+            const_cast<void*>(backing_store.software.allocation));
+        for (size_t i = 0; i < 16; i++) {
+          allocation[i] = i;
+        }
+
+        FlutterLayer layer = {};
+        layer.struct_size = sizeof(FlutterLayer);
+        layer.type = kFlutterLayerContentTypeBackingStore;
+        layer.backing_store = &backing_store;
+        layer.size = {2, 2};
+        const FlutterLayer* layers[] = {&layer};
+        EXPECT_TRUE(compositor->present_layers_callback(
+            layers, 1, compositor->user_data));
+        EXPECT_TRUE(compositor->collect_backing_store_callback(
+            &backing_store, compositor->user_data));
+
+        return initialize(version, config, args, user_data, engine_out);
+      }));
+
+  bool metrics_sent = false;
+  embedder_api->SendWindowMetricsEvent = MOCK_ENGINE_PROC(
+      SendWindowMetricsEvent,
+      ([&metrics_sent](auto engine, const FlutterWindowMetricsEvent* event) {
+        metrics_sent = true;
+        EXPECT_EQ(event->width, static_cast<size_t>(2));
+        EXPECT_EQ(event->height, static_cast<size_t>(2));
+        return kSuccess;
+      }));
+
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_engine_start_offscreen(engine, 2, 2, 1.0, &error));
+  EXPECT_EQ(error, nullptr);
+
+  EXPECT_TRUE(initialized);
+  EXPECT_TRUE(metrics_sent);
+  ASSERT_EQ(pixels->len, static_cast<guint>(16));
+  for (guint i = 0; i < pixels->len; i++) {
+    EXPECT_EQ(pixels->data[i], i);
+  }
+}
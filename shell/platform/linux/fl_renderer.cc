@@ -30,6 +30,10 @@ gboolean fl_renderer_start(FlRenderer* self, FlView* view, GError** error) {
   FlRendererPrivate* priv = reinterpret_cast<FlRendererPrivate*>(
       fl_renderer_get_instance_private(self));
   priv->view = view;
+  if (FL_RENDERER_GET_CLASS(self)->start != nullptr) {
+    return FL_RENDERER_GET_CLASS(self)->start(self, view, error);
+  }
+
   gboolean result = FL_RENDERER_GET_CLASS(self)->create_contexts(
       self, GTK_WIDGET(view), &priv->main_context, &priv->resource_context,
       error);
@@ -61,6 +65,10 @@ void* fl_renderer_get_proc_address(FlRenderer* self, const char* name) {
 }
 
 gboolean fl_renderer_make_current(FlRenderer* self, GError** error) {
+  if (FL_RENDERER_GET_CLASS(self)->make_current != nullptr) {
+    return FL_RENDERER_GET_CLASS(self)->make_current(self, error);
+  }
+
   FlRendererPrivate* priv = reinterpret_cast<FlRendererPrivate*>(
       fl_renderer_get_instance_private(self));
   if (priv->main_context) {
@@ -71,6 +79,10 @@ gboolean fl_renderer_make_current(FlRenderer* self, GError** error) {
 }
 
 gboolean fl_renderer_make_resource_current(FlRenderer* self, GError** error) {
+  if (FL_RENDERER_GET_CLASS(self)->make_resource_current != nullptr) {
+    return FL_RENDERER_GET_CLASS(self)->make_resource_current(self, error);
+  }
+
   FlRendererPrivate* priv = reinterpret_cast<FlRendererPrivate*>(
       fl_renderer_get_instance_private(self));
   if (priv->resource_context) {
@@ -81,6 +93,10 @@ gboolean fl_renderer_make_resource_current(FlRenderer* self, GError** error) {
 }
 
 gboolean fl_renderer_clear_current(FlRenderer* self, GError** error) {
+  if (FL_RENDERER_GET_CLASS(self)->clear_current != nullptr) {
+    return FL_RENDERER_GET_CLASS(self)->clear_current(self, error);
+  }
+
   gdk_gl_context_clear_current();
   return TRUE;
 }
@@ -90,10 +106,44 @@ guint32 fl_renderer_get_fbo(FlRenderer* self) {
   return 0;
 }
 
-gboolean fl_renderer_present(FlRenderer* self, GError** error) {
+gboolean fl_renderer_present(FlRenderer* self,
+                             const FlutterPresentInfo* info,
+                             GError** error) {
+  if (FL_RENDERER_GET_CLASS(self)->present != nullptr) {
+    return FL_RENDERER_GET_CLASS(self)->present(self, info, error);
+  }
+
   return TRUE;
 }
 
+gboolean fl_renderer_get_uses_compositor(FlRenderer* self) {
+  return FL_RENDERER_GET_CLASS(self)->present_layers != nullptr;
+}
+
+gboolean fl_renderer_get_supports_partial_repaint(FlRenderer* self) {
+  return FL_RENDERER_GET_CLASS(self)->get_existing_damage != nullptr;
+}
+
+void fl_renderer_get_existing_damage(FlRenderer* self,
+                                     FlutterDamage* existing_damage) {
+  if (FL_RENDERER_GET_CLASS(self)->get_existing_damage == nullptr) {
+    // The contents of the frame buffer are unknown.
+    existing_damage->num_rects = 0;
+    existing_damage->damage = nullptr;
+    return;
+  }
+
+  FL_RENDERER_GET_CLASS(self)->get_existing_damage(self, existing_damage);
+}
+
+void fl_renderer_set_geometry(FlRenderer* self,
+                              const GdkRectangle* geometry,
+                              gint scale_factor) {
+  if (FL_RENDERER_GET_CLASS(self)->set_geometry != nullptr) {
+    FL_RENDERER_GET_CLASS(self)->set_geometry(self, geometry, scale_factor);
+  }
+}
+
 gboolean fl_renderer_create_backing_store(
     FlRenderer* self,
     const FlutterBackingStoreConfig* config,
@@ -97,6 +97,87 @@ struct _FlRendererClass {
   gboolean (*present_layers)(FlRenderer* renderer,
                              const FlutterLayer** layers,
                              size_t layers_count);
+
+  /**
+   * Virtual method called when the renderer is started, in place of
+   * create_contexts, by renderers that do not render through #GdkGLContext.
+   * @renderer: an #FlRenderer.
+   * @view: the view Flutter is renderering to.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Returns: %TRUE if successfully started.
+   */
+  gboolean (*start)(FlRenderer* renderer, FlView* view, GError** error);
+
+  /**
+   * Optional virtual method called when Flutter needs its rendering context to
+   * be current. Makes the #GdkGLContext current if not set.
+   * @renderer: an #FlRenderer.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Returns %TRUE if successful.
+   */
+  gboolean (*make_current)(FlRenderer* renderer, GError** error);
+
+  /**
+   * Optional virtual method called when Flutter needs its resource context to
+   * be current. Makes the resource #GdkGLContext current if not set.
+   * @renderer: an #FlRenderer.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Returns %TRUE if successful.
+   */
+  gboolean (*make_resource_current)(FlRenderer* renderer, GError** error);
+
+  /**
+   * Optional virtual method called when Flutter no longer needs a context to
+   * be current. Clears the current #GdkGLContext if not set.
+   * @renderer: an #FlRenderer.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Returns %TRUE if successful.
+   */
+  gboolean (*clear_current)(FlRenderer* renderer, GError** error);
+
+  /**
+   * Optional virtual method called when Flutter rendered a frame into frame
+   * buffer object 0, which only happens if present_layers is not set.
+   * @renderer: an #FlRenderer.
+   * @info: the regions of the frame that changed.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Returns %TRUE if successful.
+   */
+  gboolean (*present)(FlRenderer* renderer,
+                      const FlutterPresentInfo* info,
+                      GError** error);
+
+  /**
+   * Optional virtual method called before Flutter renders a frame into frame
+   * buffer object 0, that enables partial repaints if set.
+   * @renderer: an #FlRenderer.
+   * @existing_damage: (out): the region of the frame buffer that does not
+   * hold the previously presented frame, with rectangles that are owned by
+   * @renderer until it is called again.
+   */
+  void (*get_existing_damage)(FlRenderer* renderer,
+                              FlutterDamage* existing_damage);
+
+  /**
+   * Optional virtual method called when the view Flutter renders to is moved
+   * or resized.
+   * @renderer: an #FlRenderer.
+   * @geometry: the geometry of the view, in logical pixels.
+   * @scale_factor: the scale factor of the view.
+   */
+  void (*set_geometry)(FlRenderer* renderer,
+                       const GdkRectangle* geometry,
+                       gint scale_factor);
 };
 
 /**
@@ -189,6 +270,7 @@ guint32 fl_renderer_get_fbo(FlRenderer* renderer);
 /**
  * fl_renderer_present:
  * @renderer: an #FlRenderer.
+ * @info: the regions of the frame that changed.
  * @error: (allow-none): #GError location to store the error occurring, or %NULL
  * to ignore.
  *
@@ -196,7 +278,56 @@ guint32 fl_renderer_get_fbo(FlRenderer* renderer);
  *
  * Returns %TRUE if successful.
  */
-gboolean fl_renderer_present(FlRenderer* renderer, GError** error);
+gboolean fl_renderer_present(FlRenderer* renderer,
+                             const FlutterPresentInfo* info,
+                             GError** error);
+
+/**
+ * fl_renderer_get_uses_compositor:
+ * @renderer: an #FlRenderer.
+ *
+ * Checks if Flutter composites its layers through the backing stores of
+ * @renderer, rather than rendering the whole frame into frame buffer object
+ * 0.
+ *
+ * Returns: %TRUE if @renderer implements present_layers.
+ */
+gboolean fl_renderer_get_uses_compositor(FlRenderer* renderer);
+
+/**
+ * fl_renderer_get_supports_partial_repaint:
+ * @renderer: an #FlRenderer.
+ *
+ * Checks if @renderer can report the damage of frame buffer object 0, so that
+ * Flutter only repaints the regions of a frame that changed.
+ *
+ * Returns: %TRUE if @renderer implements get_existing_damage.
+ */
+gboolean fl_renderer_get_supports_partial_repaint(FlRenderer* renderer);
+
+/**
+ * fl_renderer_get_existing_damage:
+ * @renderer: an #FlRenderer.
+ * @existing_damage: (out): the region of frame buffer object 0 that does not
+ * hold the previously presented frame.
+ *
+ * Gets the region of frame buffer object 0 that Flutter has to repaint in
+ * addition to the region of the next frame that changed.
+ */
+void fl_renderer_get_existing_damage(FlRenderer* renderer,
+                                     FlutterDamage* existing_damage);
+
+/**
+ * fl_renderer_set_geometry:
+ * @renderer: an #FlRenderer.
+ * @geometry: the geometry of the view, in logical pixels.
+ * @scale_factor: the scale factor of the view.
+ *
+ * Tells @renderer that the view Flutter renders to was moved or resized.
+ */
+void fl_renderer_set_geometry(FlRenderer* renderer,
+                              const GdkRectangle* geometry,
+                              gint scale_factor);
 
 /**
  * fl_renderer_create_backing_store:
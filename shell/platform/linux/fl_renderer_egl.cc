@@ -0,0 +1,582 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/fl_renderer_egl.h"
+
+#include <epoxy/egl.h>
+
+#include <cstring>
+
+#ifdef GDK_WINDOWING_X11
+#include <gdk/gdkx.h>
+#endif
+#ifdef GDK_WINDOWING_WAYLAND
+#include <gdk/gdkwayland.h>
+#include <wayland-client.h>
+#include <wayland-egl.h>
+#endif
+
+// The number of presented frames whose damage is kept, which is the oldest
+// buffer age that a partial repaint is possible for.
+static constexpr guint kMaxBufferAge = 4;
+
+struct _FlRendererEGL {
+  FlRenderer parent_instance;
+
+  EGLDisplay display;
+  EGLConfig config;
+  EGLContext main_context;
+  EGLContext resource_context;
+
+  // Surface Flutter renders frames into.
+  EGLSurface surface;
+
+  // Surface the resource context is made current with, or EGL_NO_SURFACE if
+  // EGL_KHR_surfaceless_context is supported.
+  EGLSurface resource_surface;
+
+  // TRUE if EGL_EXT_buffer_age is supported.
+  gboolean has_buffer_age;
+
+  // TRUE if EGL_KHR_swap_buffers_with_damage or its EXT variant is supported.
+  gboolean has_swap_buffers_with_damage_khr;
+  gboolean has_swap_buffers_with_damage_ext;
+
+  // Damage of the most recently presented frames, newest first, each a #GArray
+  // of #FlutterRect.
+  GPtrArray* damage_history;
+
+  // Region returned by the last call to get_existing_damage.
+  GArray* existing_damage;
+
+  // Size of the surface in physical pixels.
+  gint width;
+  gint height;
+
+  // Native window on X11, that GTK never draws into.
+  GdkWindow* window;
+
+#ifdef GDK_WINDOWING_WAYLAND
+  struct wl_event_queue* queue;
+  struct wl_compositor* compositor;
+  struct wl_subcompositor* subcompositor;
+  struct wl_surface* wl_surface;
+  struct wl_subsurface* subsurface;
+  struct wl_egl_window* egl_window;
+#endif
+};
+
+G_DEFINE_TYPE(FlRendererEGL, fl_renderer_egl, fl_renderer_get_type())
+
+// Sets @error from the last EGL error.
+static void set_egl_error(GError** error, const gchar* operation) {
+  g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+              "%s failed: EGL error 0x%x", operation, eglGetError());
+}
+
+// Gets the position of @window in the toplevel window it is in.
+static void get_toplevel_position(GdkWindow* window, gint* x, gint* y) {
+  *x = 0;
+  *y = 0;
+  GdkWindow* toplevel = gdk_window_get_toplevel(window);
+  for (GdkWindow* w = window; w != nullptr && w != toplevel;
+       w = gdk_window_get_parent(w)) {
+    gint window_x, window_y;
+    gdk_window_get_position(w, &window_x, &window_y);
+    *x += window_x;
+    *y += window_y;
+  }
+}
+
+#ifdef GDK_WINDOWING_WAYLAND
+static void registry_handle_global(void* data,
+                                   struct wl_registry* registry,
+                                   uint32_t name,
+                                   const char* interface,
+                                   uint32_t version) {
+  FlRendererEGL* self = FL_RENDERER_EGL(data);
+  if (strcmp(interface, wl_compositor_interface.name) == 0) {
+    self->compositor = static_cast<struct wl_compositor*>(
+        wl_registry_bind(registry, name, &wl_compositor_interface, 3));
+  } else if (strcmp(interface, wl_subcompositor_interface.name) == 0) {
+    self->subcompositor = static_cast<struct wl_subcompositor*>(
+        wl_registry_bind(registry, name, &wl_subcompositor_interface, 1));
+  }
+}
+
+static void registry_handle_global_remove(void* data,
+                                          struct wl_registry* registry,
+                                          uint32_t name) {}
+
+static const struct wl_registry_listener registry_listener = {
+    registry_handle_global,
+    registry_handle_global_remove,
+};
+
+// Creates a subsurface of the toplevel window that @view is in, to present
+// frames in without GTK compositing them.
+static gboolean create_wayland_surface(FlRendererEGL* self,
+                                       FlView* view,
+                                       struct wl_display* wl_display,
+                                       GError** error) {
+  GdkWindow* window = gtk_widget_get_window(GTK_WIDGET(view));
+  struct wl_surface* parent_surface =
+      gdk_wayland_window_get_wl_surface(gdk_window_get_toplevel(window));
+  if (parent_surface == nullptr) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Failed to get the Wayland surface of the window");
+    return FALSE;
+  }
+
+  // Bind the globals on a private queue so GDK's events are not dispatched.
+  self->queue = wl_display_create_queue(wl_display);
+  struct wl_display* wrapper =
+      static_cast<struct wl_display*>(wl_proxy_create_wrapper(wl_display));
+  wl_proxy_set_queue(reinterpret_cast<struct wl_proxy*>(wrapper), self->queue);
+  struct wl_registry* registry = wl_display_get_registry(wrapper);
+  wl_proxy_wrapper_destroy(wrapper);
+  wl_registry_add_listener(registry, &registry_listener, self);
+  wl_display_roundtrip_queue(wl_display, self->queue);
+  wl_registry_destroy(registry);
+  if (self->compositor == nullptr || self->subcompositor == nullptr) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "The Wayland compositor does not support subsurfaces");
+    return FALSE;
+  }
+
+  self->wl_surface = wl_compositor_create_surface(self->compositor);
+  // Input is handled by the view, which is below the subsurface.
+  struct wl_region* input_region =
+      wl_compositor_create_region(self->compositor);
+  wl_surface_set_input_region(self->wl_surface, input_region);
+  wl_region_destroy(input_region);
+  self->subsurface = wl_subcompositor_get_subsurface(
+      self->subcompositor, self->wl_surface, parent_surface);
+  // Present frames as soon as they are swapped, not when GTK commits.
+  wl_subsurface_set_desync(self->subsurface);
+
+  gint scale_factor = gtk_widget_get_scale_factor(GTK_WIDGET(view));
+  gint x, y;
+  get_toplevel_position(window, &x, &y);
+  wl_subsurface_set_position(self->subsurface, x, y);
+  wl_surface_set_buffer_scale(self->wl_surface, scale_factor);
+  self->egl_window = wl_egl_window_create(
+      self->wl_surface, gdk_window_get_width(window) * scale_factor,
+      gdk_window_get_height(window) * scale_factor);
+
+  return TRUE;
+}
+#endif
+
+#ifdef GDK_WINDOWING_X11
+// Creates a native child window of @view to present frames in, that GTK does
+// not draw into.
+static void create_x11_window(FlRendererEGL* self, FlView* view) {
+  GtkAllocation allocation;
+  gtk_widget_get_allocation(GTK_WIDGET(view), &allocation);
+
+  GdkWindowAttr attributes;
+  attributes.window_type = GDK_WINDOW_CHILD;
+  attributes.x = 0;
+  attributes.y = 0;
+  attributes.width = allocation.width;
+  attributes.height = allocation.height;
+  attributes.wclass = GDK_INPUT_OUTPUT;
+  attributes.visual = gtk_widget_get_visual(GTK_WIDGET(view));
+  attributes.event_mask = 0;
+  gint attributes_mask = GDK_WA_X | GDK_WA_Y | GDK_WA_VISUAL;
+  self->window = gdk_window_new(gtk_widget_get_window(GTK_WIDGET(view)),
+                                &attributes, attributes_mask);
+  gdk_window_ensure_native(self->window);
+
+  // Input is handled by the view, which is below this window.
+  cairo_region_t* input_region = cairo_region_create();
+  gdk_window_input_shape_combine_region(self->window, input_region, 0, 0);
+  cairo_region_destroy(input_region);
+
+  gdk_window_lower(self->window);
+  gdk_window_show(self->window);
+}
+
+// Chooses a config that matches the visual of @window, so the native window
+// can be used as a surface.
+static EGLConfig choose_x11_config(EGLDisplay display,
+                                   const EGLConfig* configs,
+                                   EGLint config_count,
+                                   GdkWindow* window) {
+  VisualID visual_id =
+      gdk_x11_visual_get_xvisual(gdk_window_get_visual(window))->visualid;
+  for (EGLint i = 0; i < config_count; i++) {
+    EGLint config_visual_id;
+    if (eglGetConfigAttrib(display, configs[i], EGL_NATIVE_VISUAL_ID,
+                           &config_visual_id) &&
+        static_cast<VisualID>(config_visual_id) == visual_id) {
+      return configs[i];
+    }
+  }
+  return configs[0];
+}
+#endif
+
+// Creates the rendering and resource contexts, that share resources.
+static gboolean create_contexts(FlRendererEGL* self, GError** error) {
+  const EGLint context_attributes[] = {EGL_CONTEXT_CLIENT_VERSION, 2,
+                                       EGL_NONE};
+  self->main_context = eglCreateContext(self->display, self->config,
+                                        EGL_NO_CONTEXT, context_attributes);
+  if (self->main_context == EGL_NO_CONTEXT) {
+    set_egl_error(error, "eglCreateContext");
+    return FALSE;
+  }
+  self->resource_context = eglCreateContext(
+      self->display, self->config, self->main_context, context_attributes);
+  if (self->resource_context == EGL_NO_CONTEXT) {
+    set_egl_error(error, "eglCreateContext");
+    return FALSE;
+  }
+
+  if (!epoxy_has_egl_extension(self->display,
+                               "EGL_KHR_surfaceless_context")) {
+    const EGLint pbuffer_attributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1,
+                                         EGL_NONE};
+    self->resource_surface = eglCreatePbufferSurface(
+        self->display, self->config, pbuffer_attributes);
+    if (self->resource_surface == EGL_NO_SURFACE) {
+      set_egl_error(error, "eglCreatePbufferSurface");
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+// Implements FlRenderer::start.
+static gboolean fl_renderer_egl_start(FlRenderer* renderer,
+                                      FlView* view,
+                                      GError** error) {
+  FlRendererEGL* self = FL_RENDERER_EGL(renderer);
+
+  GdkDisplay* gdk_display = gtk_widget_get_display(GTK_WIDGET(view));
+  EGLNativeWindowType native_window = 0;
+#ifdef GDK_WINDOWING_X11
+  if (GDK_IS_X11_DISPLAY(gdk_display)) {
+    self->display = eglGetDisplay(static_cast<EGLNativeDisplayType>(
+        gdk_x11_display_get_xdisplay(gdk_display)));
+    create_x11_window(self, view);
+    native_window =
+        static_cast<EGLNativeWindowType>(gdk_x11_window_get_xid(self->window));
+  }
+#endif
+#ifdef GDK_WINDOWING_WAYLAND
+  if (GDK_IS_WAYLAND_DISPLAY(gdk_display)) {
+    struct wl_display* wl_display =
+        gdk_wayland_display_get_wl_display(gdk_display);
+    self->display =
+        eglGetDisplay(reinterpret_cast<EGLNativeDisplayType>(wl_display));
+    if (!create_wayland_surface(self, view, wl_display, error)) {
+      return FALSE;
+    }
+    native_window = reinterpret_cast<EGLNativeWindowType>(self->egl_window);
+  }
+#endif
+  if (self->display == EGL_NO_DISPLAY) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Rendering straight to the window requires X11 or Wayland");
+    return FALSE;
+  }
+
+  if (!eglInitialize(self->display, nullptr, nullptr)) {
+    set_egl_error(error, "eglInitialize");
+    return FALSE;
+  }
+  if (!eglBindAPI(EGL_OPENGL_ES_API)) {
+    set_egl_error(error, "eglBindAPI");
+    return FALSE;
+  }
+
+  const EGLint config_attributes[] = {EGL_SURFACE_TYPE,
+                                      EGL_WINDOW_BIT,
+                                      EGL_RENDERABLE_TYPE,
+                                      EGL_OPENGL_ES2_BIT,
+                                      EGL_RED_SIZE,
+                                      8,
+                                      EGL_GREEN_SIZE,
+                                      8,
+                                      EGL_BLUE_SIZE,
+                                      8,
+                                      EGL_NONE};
+  EGLConfig configs[64];
+  EGLint config_count = 0;
+  if (!eglChooseConfig(self->display, config_attributes, configs,
+                       G_N_ELEMENTS(configs), &config_count) ||
+      config_count == 0) {
+    set_egl_error(error, "eglChooseConfig");
+    return FALSE;
+  }
+  self->config = configs[0];
+#ifdef GDK_WINDOWING_X11
+  if (self->window != nullptr) {
+    self->config =
+        choose_x11_config(self->display, configs, config_count, self->window);
+  }
+#endif
+
+  if (!create_contexts(self, error)) {
+    return FALSE;
+  }
+
+  self->surface = eglCreateWindowSurface(self->display, self->config,
+                                         native_window, nullptr);
+  if (self->surface == EGL_NO_SURFACE) {
+    set_egl_error(error, "eglCreateWindowSurface");
+    return FALSE;
+  }
+
+  self->has_buffer_age =
+      epoxy_has_egl_extension(self->display, "EGL_EXT_buffer_age");
+  self->has_swap_buffers_with_damage_khr = epoxy_has_egl_extension(
+      self->display, "EGL_KHR_swap_buffers_with_damage");
+  self->has_swap_buffers_with_damage_ext = epoxy_has_egl_extension(
+      self->display, "EGL_EXT_swap_buffers_with_damage");
+
+#ifdef GDK_WINDOWING_WAYLAND
+  // The compositor never tears, so do not block the GTK main loop until the
+  // subsurface is shown.
+  if (self->egl_window != nullptr) {
+    eglMakeCurrent(self->display, self->surface, self->surface,
+                   self->main_context);
+    eglSwapInterval(self->display, 0);
+    eglMakeCurrent(self->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                   EGL_NO_CONTEXT);
+  }
+#endif
+
+  return TRUE;
+}
+
+// Implements FlRenderer::make_current.
+static gboolean fl_renderer_egl_make_current(FlRenderer* renderer,
+                                             GError** error) {
+  FlRendererEGL* self = FL_RENDERER_EGL(renderer);
+  if (!eglMakeCurrent(self->display, self->surface, self->surface,
+                      self->main_context)) {
+    set_egl_error(error, "eglMakeCurrent");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// Implements FlRenderer::make_resource_current.
+static gboolean fl_renderer_egl_make_resource_current(FlRenderer* renderer,
+                                                      GError** error) {
+  FlRendererEGL* self = FL_RENDERER_EGL(renderer);
+  if (!eglMakeCurrent(self->display, self->resource_surface,
+                      self->resource_surface, self->resource_context)) {
+    set_egl_error(error, "eglMakeCurrent");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// Implements FlRenderer::clear_current.
+static gboolean fl_renderer_egl_clear_current(FlRenderer* renderer,
+                                              GError** error) {
+  FlRendererEGL* self = FL_RENDERER_EGL(renderer);
+  if (!eglMakeCurrent(self->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                      EGL_NO_CONTEXT)) {
+    set_egl_error(error, "eglMakeCurrent");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// Records the damage of a frame that is presented, or the whole surface if
+// @damage is empty.
+static void push_damage(FlRendererEGL* self, const FlutterDamage* damage) {
+  GArray* rects = g_array_new(FALSE, FALSE, sizeof(FlutterRect));
+  if (damage->num_rects == 0) {
+    FlutterRect full = {0, 0, static_cast<double>(self->width),
+                        static_cast<double>(self->height)};
+    g_array_append_val(rects, full);
+  } else {
+    g_array_append_vals(rects, damage->damage, damage->num_rects);
+  }
+  g_ptr_array_insert(self->damage_history, 0, rects);
+  if (self->damage_history->len > kMaxBufferAge) {
+    g_ptr_array_set_size(self->damage_history, kMaxBufferAge);
+  }
+}
+
+// Implements FlRenderer::present.
+static gboolean fl_renderer_egl_present(FlRenderer* renderer,
+                                        const FlutterPresentInfo* info,
+                                        GError** error) {
+  FlRendererEGL* self = FL_RENDERER_EGL(renderer);
+
+  EGLint width = 0, height = 0;
+  eglQuerySurface(self->display, self->surface, EGL_WIDTH, &width);
+  eglQuerySurface(self->display, self->surface, EGL_HEIGHT, &height);
+  if (width != self->width || height != self->height) {
+    // The buffers were reallocated, so no earlier damage applies.
+    g_ptr_array_set_size(self->damage_history, 0);
+    self->width = width;
+    self->height = height;
+  }
+
+  const FlutterDamage* damage = &info->frame_damage;
+  push_damage(self, damage);
+
+  EGLBoolean result;
+  if (damage->num_rects > 0 && (self->has_swap_buffers_with_damage_khr ||
+                                self->has_swap_buffers_with_damage_ext)) {
+    // EGL rectangles have their origin at the bottom left corner.
+    g_autofree EGLint* rects = g_new(EGLint, damage->num_rects * 4);
+    for (size_t i = 0; i < damage->num_rects; i++) {
+      const FlutterRect& rect = damage->damage[i];
+      rects[i * 4] = rect.left;
+      rects[i * 4 + 1] = height - rect.bottom;
+      rects[i * 4 + 2] = rect.right - rect.left;
+      rects[i * 4 + 3] = rect.bottom - rect.top;
+    }
+    result = self->has_swap_buffers_with_damage_khr
+                 ? eglSwapBuffersWithDamageKHR(self->display, self->surface,
+                                               rects, damage->num_rects)
+                 : eglSwapBuffersWithDamageEXT(self->display, self->surface,
+                                               rects, damage->num_rects);
+  } else {
+    result = eglSwapBuffers(self->display, self->surface);
+  }
+  if (!result) {
+    set_egl_error(error, "eglSwapBuffers");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// Implements FlRenderer::get_existing_damage.
+static void fl_renderer_egl_get_existing_damage(
+    FlRenderer* renderer,
+    FlutterDamage* existing_damage) {
+  FlRendererEGL* self = FL_RENDERER_EGL(renderer);
+
+  existing_damage->num_rects = 0;
+  existing_damage->damage = nullptr;
+
+  // The age of the back buffer is the number of frames presented since it was
+  // last presented, or 0 if its contents are undefined.
+  EGLint age = 0;
+  if (!self->has_buffer_age ||
+      !eglQuerySurface(self->display, self->surface, EGL_BUFFER_AGE_EXT,
+                       &age) ||
+      age <= 0 || static_cast<guint>(age) - 1 > self->damage_history->len) {
+    return;
+  }
+
+  // The back buffer misses the frames presented after it.
+  g_array_set_size(self->existing_damage, 0);
+  for (EGLint i = 0; i < age - 1; i++) {
+    GArray* rects =
+        static_cast<GArray*>(g_ptr_array_index(self->damage_history, i));
+    g_array_append_vals(self->existing_damage, rects->data, rects->len);
+  }
+  existing_damage->num_rects = self->existing_damage->len;
+  // A non-null array with no rectangles marks a back buffer that holds the
+  // previous frame.
+  existing_damage->damage =
+      reinterpret_cast<FlutterRect*>(self->existing_damage->data);
+}
+
+// Implements FlRenderer::set_geometry.
+static void fl_renderer_egl_set_geometry(FlRenderer* renderer,
+                                         const GdkRectangle* geometry,
+                                         gint scale_factor) {
+  FlRendererEGL* self = FL_RENDERER_EGL(renderer);
+
+  if (self->window != nullptr) {
+    gdk_window_resize(self->window, geometry->width, geometry->height);
+  }
+
+#ifdef GDK_WINDOWING_WAYLAND
+  if (self->egl_window != nullptr) {
+    FlView* view = fl_renderer_get_view(renderer);
+    gint x, y;
+    get_toplevel_position(gtk_widget_get_window(GTK_WIDGET(view)), &x, &y);
+    wl_subsurface_set_position(self->subsurface, x, y);
+    wl_surface_set_buffer_scale(self->wl_surface, scale_factor);
+    wl_egl_window_resize(self->egl_window, geometry->width * scale_factor,
+                         geometry->height * scale_factor, 0, 0);
+  }
+#endif
+}
+
+static void fl_renderer_egl_dispose(GObject* object) {
+  FlRendererEGL* self = FL_RENDERER_EGL(object);
+
+  // The display is not terminated, as GDK may be using it too.
+  if (self->display != EGL_NO_DISPLAY) {
+    eglMakeCurrent(self->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                   EGL_NO_CONTEXT);
+    if (self->surface != EGL_NO_SURFACE) {
+      eglDestroySurface(self->display, self->surface);
+      self->surface = EGL_NO_SURFACE;
+    }
+    if (self->resource_surface != EGL_NO_SURFACE) {
+      eglDestroySurface(self->display, self->resource_surface);
+      self->resource_surface = EGL_NO_SURFACE;
+    }
+    if (self->resource_context != EGL_NO_CONTEXT) {
+      eglDestroyContext(self->display, self->resource_context);
+      self->resource_context = EGL_NO_CONTEXT;
+    }
+    if (self->main_context != EGL_NO_CONTEXT) {
+      eglDestroyContext(self->display, self->main_context);
+      self->main_context = EGL_NO_CONTEXT;
+    }
+    self->display = EGL_NO_DISPLAY;
+  }
+
+#ifdef GDK_WINDOWING_WAYLAND
+  g_clear_pointer(&self->egl_window, wl_egl_window_destroy);
+  g_clear_pointer(&self->subsurface, wl_subsurface_destroy);
+  g_clear_pointer(&self->wl_surface, wl_surface_destroy);
+  g_clear_pointer(&self->subcompositor, wl_subcompositor_destroy);
+  g_clear_pointer(&self->compositor, wl_compositor_destroy);
+  g_clear_pointer(&self->queue, wl_event_queue_destroy);
+#endif
+  g_clear_pointer(&self->window, gdk_window_destroy);
+  g_clear_pointer(&self->damage_history, g_ptr_array_unref);
+  g_clear_pointer(&self->existing_damage, g_array_unref);
+
+  G_OBJECT_CLASS(fl_renderer_egl_parent_class)->dispose(object);
+}
+
+static void fl_renderer_egl_class_init(FlRendererEGLClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_renderer_egl_dispose;
+
+  FL_RENDERER_CLASS(klass)->start = fl_renderer_egl_start;
+  FL_RENDERER_CLASS(klass)->make_current = fl_renderer_egl_make_current;
+  FL_RENDERER_CLASS(klass)->make_resource_current =
+      fl_renderer_egl_make_resource_current;
+  FL_RENDERER_CLASS(klass)->clear_current = fl_renderer_egl_clear_current;
+  FL_RENDERER_CLASS(klass)->present = fl_renderer_egl_present;
+  FL_RENDERER_CLASS(klass)->get_existing_damage =
+      fl_renderer_egl_get_existing_damage;
+  FL_RENDERER_CLASS(klass)->set_geometry = fl_renderer_egl_set_geometry;
+}
+
+static void fl_renderer_egl_init(FlRendererEGL* self) {
+  self->display = EGL_NO_DISPLAY;
+  self->main_context = EGL_NO_CONTEXT;
+  self->resource_context = EGL_NO_CONTEXT;
+  self->surface = EGL_NO_SURFACE;
+  self->resource_surface = EGL_NO_SURFACE;
+  self->damage_history = g_ptr_array_new_with_free_func(
+      reinterpret_cast<GDestroyNotify>(g_array_unref));
+  self->existing_damage =
+      g_array_sized_new(FALSE, FALSE, sizeof(FlutterRect), kMaxBufferAge);
+}
+
+FlRendererEGL* fl_renderer_egl_new() {
+  return FL_RENDERER_EGL(g_object_new(fl_renderer_egl_get_type(), nullptr));
+}
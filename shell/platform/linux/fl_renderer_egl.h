@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_RENDERER_EGL_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_RENDERER_EGL_H_
+
+#include "flutter/shell/platform/linux/fl_renderer.h"
+
+G_BEGIN_DECLS
+
+G_DECLARE_FINAL_TYPE(FlRendererEGL,
+                     fl_renderer_egl,
+                     FL,
+                     RENDERER_EGL,
+                     FlRenderer)
+
+/**
+ * FlRendererEGL:
+ *
+ * #FlRendererEGL is an implementation of #FlRenderer that renders by OpenGL ES
+ * straight into an EGL window surface: a native child window on X11, or a
+ * subsurface on Wayland. Unlike #FlRendererGL, frames are not copied into the
+ * window by GTK, and only the regions of a frame that changed are repainted
+ * and presented, using EGL_EXT_buffer_age and EGL_KHR_swap_buffers_with_damage
+ * if they are supported.
+ *
+ * Platform views cannot be shown, as Flutter renders the whole frame into the
+ * window surface.
+ */
+
+/**
+ * fl_renderer_egl_new:
+ *
+ * Creates an object that allows Flutter to render straight into a window by
+ * OpenGL ES.
+ *
+ * Returns: a new #FlRendererEGL.
+ */
+FlRendererEGL* fl_renderer_egl_new();
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_RENDERER_EGL_H_
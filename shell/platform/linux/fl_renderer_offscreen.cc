@@ -0,0 +1,550 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/fl_renderer_offscreen.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+
+#include <cstring>
+
+#include "flutter/shell/platform/linux/fl_backing_store_provider.h"
+#include "flutter/shell/platform/linux/fl_engine_private.h"
+
+// The number of frames that are read back from the GPU at the same time.
+// Rendering waits for the oldest one once this many are in flight.
+static constexpr guint kMaxReadbacksInFlight = 3;
+
+// The longest time to wait for a frame to be read back from the GPU.
+static constexpr GLuint64 kReadbackTimeoutNanoseconds = 1000000000;
+
+static constexpr size_t kBytesPerPixel = 4;
+
+// A frame that is being copied from the GPU into a pixel buffer object.
+typedef struct {
+  GLuint pixel_buffer;
+  GLsync fence;
+  size_t width;
+  size_t height;
+} FlOffscreenReadback;
+
+struct _FlRendererOffscreen {
+  FlRenderer parent_instance;
+
+  gboolean use_gpu;
+
+  // Engine frames are rendered for, not referenced.
+  FlEngine* engine;
+
+  FlEngineOffscreenBufferHandler buffer_handler;
+  FlEngineOffscreenFrameHandler frame_handler;
+  gpointer user_data;
+  GDestroyNotify destroy_notify;
+
+  EGLDisplay display;
+  EGLContext main_context;
+  EGLContext resource_context;
+
+  // Surfaces the contexts are made current with, or EGL_NO_SURFACE if
+  // EGL_KHR_surfaceless_context is supported.
+  EGLSurface main_surface;
+  EGLSurface resource_surface;
+
+  // TRUE if frames can be read back in BGRA order, which avoids swizzling.
+  gboolean read_bgra;
+
+  // Readbacks in flight, oldest first, and ones that can be reused. Only used
+  // on the raster thread.
+  GQueue pending_readbacks;
+  GQueue free_readbacks;
+};
+
+G_DEFINE_TYPE(FlRendererOffscreen,
+              fl_renderer_offscreen,
+              fl_renderer_get_type())
+
+// Sets @error from the last EGL error.
+static void set_egl_error(GError** error, const gchar* operation) {
+  g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+              "%s failed: EGL error 0x%x", operation, eglGetError());
+}
+
+// Copies a frame of @width x @height pixels into a buffer from the caller
+// and passes it on. Rows are copied in reverse order if @flip is TRUE, and red
+// and blue are swapped if @swizzle is TRUE.
+static void deliver_frame(FlRendererOffscreen* self,
+                          const uint8_t* pixels,
+                          size_t width,
+                          size_t height,
+                          size_t source_row_bytes,
+                          gboolean flip,
+                          gboolean swizzle) {
+  size_t row_bytes = width * kBytesPerPixel;
+  uint8_t* buffer = static_cast<uint8_t*>(
+      self->buffer_handler(self->engine, row_bytes * height, self->user_data));
+  if (buffer == nullptr) {
+    return;
+  }
+
+  for (size_t y = 0; y < height; y++) {
+    const uint8_t* source = pixels + (flip ? height - 1 - y : y) *
+                                         source_row_bytes;
+    uint8_t* row = buffer + y * row_bytes;
+    memcpy(row, source, row_bytes);
+    if (swizzle) {
+      for (size_t x = 0; x < row_bytes; x += kBytesPerPixel) {
+        uint8_t red = row[x];
+        row[x] = row[x + 2];
+        row[x + 2] = red;
+      }
+    }
+  }
+
+  self->frame_handler(self->engine, buffer, width, height, row_bytes,
+                      self->user_data);
+}
+
+static void fl_offscreen_readback_free(FlOffscreenReadback* readback) {
+  if (readback->fence != nullptr) {
+    glDeleteSync(readback->fence);
+  }
+  glDeleteBuffers(1, &readback->pixel_buffer);
+  g_free(readback);
+}
+
+// Waits for the oldest readback in flight and delivers its frame.
+static void finish_readback(FlRendererOffscreen* self) {
+  FlOffscreenReadback* readback = static_cast<FlOffscreenReadback*>(
+      g_queue_pop_head(&self->pending_readbacks));
+
+  GLenum status = glClientWaitSync(readback->fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                   kReadbackTimeoutNanoseconds);
+  glDeleteSync(readback->fence);
+  readback->fence = nullptr;
+  if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED) {
+    g_warning("Failed to read back offscreen frame");
+    g_queue_push_tail(&self->free_readbacks, readback);
+    return;
+  }
+
+  size_t row_bytes = readback->width * kBytesPerPixel;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pixel_buffer);
+  const uint8_t* pixels = static_cast<const uint8_t*>(
+      glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, row_bytes * readback->height,
+                       GL_MAP_READ_BIT));
+  if (pixels != nullptr) {
+    // GL frame buffers have their origin at the bottom left corner.
+    deliver_frame(self, pixels, readback->width, readback->height, row_bytes,
+                  TRUE, !self->read_bgra);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  g_queue_push_tail(&self->free_readbacks, readback);
+}
+
+// Delivers all frames in flight. Posted to the raster thread after a readback
+// is started, so later frames can be rendered before waiting for it.
+static void finish_readbacks_cb(void* user_data) {
+  g_autoptr(FlRendererOffscreen) self = FL_RENDERER_OFFSCREEN(user_data);
+
+  if (!eglMakeCurrent(self->display, self->main_surface, self->main_surface,
+                      self->main_context)) {
+    g_warning("Failed to make offscreen renderer current: EGL error 0x%x",
+              eglGetError());
+    return;
+  }
+  while (!g_queue_is_empty(&self->pending_readbacks)) {
+    finish_readback(self);
+  }
+}
+
+// Starts copying the frame in @framebuffer into a pixel buffer object.
+static void start_readback(FlRendererOffscreen* self,
+                           uint32_t framebuffer,
+                           size_t width,
+                           size_t height) {
+  if (g_queue_get_length(&self->pending_readbacks) >= kMaxReadbacksInFlight) {
+    finish_readback(self);
+  }
+
+  size_t size = width * height * kBytesPerPixel;
+  FlOffscreenReadback* readback = static_cast<FlOffscreenReadback*>(
+      g_queue_pop_head(&self->free_readbacks));
+  if (readback == nullptr) {
+    readback = g_new0(FlOffscreenReadback, 1);
+    glGenBuffers(1, &readback->pixel_buffer);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pixel_buffer);
+  if (readback->width != width || readback->height != height) {
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    readback->width = width;
+    readback->height = height;
+  }
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+  glReadPixels(0, 0, width, height, self->read_bgra ? GL_BGRA_EXT : GL_RGBA,
+               GL_UNSIGNED_BYTE, nullptr);
+  readback->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  glFlush();
+  g_queue_push_tail(&self->pending_readbacks, readback);
+
+  if (!fl_engine_post_render_thread_task(self->engine, finish_readbacks_cb,
+                                         g_object_ref(self))) {
+    g_object_unref(self);
+  }
+}
+
+// Implements FlRenderer::start.
+static gboolean fl_renderer_offscreen_start(FlRenderer* renderer,
+                                            FlView* view,
+                                            GError** error) {
+  FlRendererOffscreen* self = FL_RENDERER_OFFSCREEN(renderer);
+  if (!self->use_gpu) {
+    return TRUE;
+  }
+
+  // Prefer a display that does not need a window system.
+  if (epoxy_has_egl_extension(EGL_NO_DISPLAY,
+                              "EGL_MESA_platform_surfaceless")) {
+    self->display = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA,
+                                             EGL_DEFAULT_DISPLAY, nullptr);
+  }
+  if (self->display == EGL_NO_DISPLAY) {
+    self->display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  }
+  if (!eglInitialize(self->display, nullptr, nullptr)) {
+    set_egl_error(error, "eglInitialize");
+    return FALSE;
+  }
+  if (!eglBindAPI(EGL_OPENGL_ES_API)) {
+    set_egl_error(error, "eglBindAPI");
+    return FALSE;
+  }
+
+  // Pixel buffer objects need OpenGL ES 3.
+  const EGLint config_attributes[] = {EGL_SURFACE_TYPE,
+                                      EGL_PBUFFER_BIT,
+                                      EGL_RENDERABLE_TYPE,
+                                      EGL_OPENGL_ES3_BIT,
+                                      EGL_RED_SIZE,
+                                      8,
+                                      EGL_GREEN_SIZE,
+                                      8,
+                                      EGL_BLUE_SIZE,
+                                      8,
+                                      EGL_ALPHA_SIZE,
+                                      8,
+                                      EGL_NONE};
+  EGLConfig config;
+  EGLint config_count = 0;
+  if (!eglChooseConfig(self->display, config_attributes, &config, 1,
+                       &config_count) ||
+      config_count == 0) {
+    set_egl_error(error, "eglChooseConfig");
+    return FALSE;
+  }
+
+  const EGLint context_attributes[] = {EGL_CONTEXT_CLIENT_VERSION, 3,
+                                       EGL_NONE};
+  self->main_context = eglCreateContext(self->display, config, EGL_NO_CONTEXT,
+                                        context_attributes);
+  if (self->main_context == EGL_NO_CONTEXT) {
+    set_egl_error(error, "eglCreateContext");
+    return FALSE;
+  }
+  self->resource_context = eglCreateContext(self->display, config,
+                                            self->main_context,
+                                            context_attributes);
+  if (self->resource_context == EGL_NO_CONTEXT) {
+    set_egl_error(error, "eglCreateContext");
+    return FALSE;
+  }
+
+  // Each context is current on its own thread, so needs its own surface.
+  if (!epoxy_has_egl_extension(self->display,
+                               "EGL_KHR_surfaceless_context")) {
+    const EGLint pbuffer_attributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1,
+                                         EGL_NONE};
+    self->main_surface =
+        eglCreatePbufferSurface(self->display, config, pbuffer_attributes);
+    self->resource_surface =
+        eglCreatePbufferSurface(self->display, config, pbuffer_attributes);
+    if (self->main_surface == EGL_NO_SURFACE ||
+        self->resource_surface == EGL_NO_SURFACE) {
+      set_egl_error(error, "eglCreatePbufferSurface");
+      return FALSE;
+    }
+  }
+
+  if (!eglMakeCurrent(self->display, self->main_surface, self->main_surface,
+                      self->main_context)) {
+    set_egl_error(error, "eglMakeCurrent");
+    return FALSE;
+  }
+  self->read_bgra = epoxy_has_gl_extension("GL_EXT_read_format_bgra");
+  eglMakeCurrent(self->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                 EGL_NO_CONTEXT);
+
+  return TRUE;
+}
+
+// Implements FlRenderer::make_current.
+static gboolean fl_renderer_offscreen_make_current(FlRenderer* renderer,
+                                                   GError** error) {
+  FlRendererOffscreen* self = FL_RENDERER_OFFSCREEN(renderer);
+  if (!self->use_gpu) {
+    return TRUE;
+  }
+  if (!eglMakeCurrent(self->display, self->main_surface, self->main_surface,
+                      self->main_context)) {
+    set_egl_error(error, "eglMakeCurrent");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// Implements FlRenderer::make_resource_current.
+static gboolean fl_renderer_offscreen_make_resource_current(
+    FlRenderer* renderer,
+    GError** error) {
+  FlRendererOffscreen* self = FL_RENDERER_OFFSCREEN(renderer);
+  if (!self->use_gpu) {
+    return TRUE;
+  }
+  if (!eglMakeCurrent(self->display, self->resource_surface,
+                      self->resource_surface, self->resource_context)) {
+    set_egl_error(error, "eglMakeCurrent");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// Implements FlRenderer::clear_current.
+static gboolean fl_renderer_offscreen_clear_current(FlRenderer* renderer,
+                                                    GError** error) {
+  FlRendererOffscreen* self = FL_RENDERER_OFFSCREEN(renderer);
+  if (!self->use_gpu) {
+    return TRUE;
+  }
+  if (!eglMakeCurrent(self->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                      EGL_NO_CONTEXT)) {
+    set_egl_error(error, "eglMakeCurrent");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// Implements FlRenderer::create_backing_store.
+static gboolean fl_renderer_offscreen_create_backing_store(
+    FlRenderer* renderer,
+    const FlutterBackingStoreConfig* config,
+    FlutterBackingStore* backing_store_out) {
+  FlRendererOffscreen* self = FL_RENDERER_OFFSCREEN(renderer);
+
+  if (!self->use_gpu) {
+    size_t row_bytes = config->size.width * kBytesPerPixel;
+    size_t height = config->size.height;
+    gpointer allocation = g_malloc0(row_bytes * height);
+    backing_store_out->type = kFlutterBackingStoreTypeSoftware;
+    backing_store_out->software.allocation = allocation;
+    backing_store_out->software.row_bytes = row_bytes;
+    backing_store_out->software.height = height;
+    backing_store_out->software.user_data = allocation;
+    backing_store_out->software.destruction_callback = [](void* p) {
+      // Backing store destroyed in fl_renderer_offscreen_collect_backing_store.
+    };
+    return TRUE;
+  }
+
+  g_autoptr(GError) error = nullptr;
+  if (!fl_renderer_offscreen_make_current(renderer, &error)) {
+    g_warning("Failed to make renderer current when creating backing store: %s",
+              error->message);
+    return FALSE;
+  }
+
+  FlBackingStoreProvider* provider =
+      fl_backing_store_provider_new(config->size.width, config->size.height);
+  if (!provider) {
+    g_warning("Failed to create backing store");
+    return FALSE;
+  }
+
+  backing_store_out->type = kFlutterBackingStoreTypeOpenGL;
+  backing_store_out->open_gl.type = kFlutterOpenGLTargetTypeFramebuffer;
+  backing_store_out->open_gl.framebuffer.user_data = provider;
+  backing_store_out->open_gl.framebuffer.name =
+      fl_backing_store_provider_get_gl_framebuffer_id(provider);
+  backing_store_out->open_gl.framebuffer.target =
+      fl_backing_store_provider_get_gl_format(provider);
+  backing_store_out->open_gl.framebuffer.destruction_callback = [](void* p) {
+    // Backing store destroyed in fl_renderer_offscreen_collect_backing_store.
+  };
+
+  return TRUE;
+}
+
+// Implements FlRenderer::collect_backing_store.
+static gboolean fl_renderer_offscreen_collect_backing_store(
+    FlRenderer* renderer,
+    const FlutterBackingStore* backing_store) {
+  if (backing_store->type == kFlutterBackingStoreTypeSoftware) {
+    g_free(backing_store->software.user_data);
+    return TRUE;
+  }
+
+  g_autoptr(GError) error = nullptr;
+  if (!fl_renderer_offscreen_make_current(renderer, &error)) {
+    g_warning(
+        "Failed to make renderer current when collecting backing store: %s",
+        error->message);
+    return FALSE;
+  }
+
+  // OpenGL context is required when destroying #FlBackingStoreProvider.
+  g_object_unref(backing_store->open_gl.framebuffer.user_data);
+  return TRUE;
+}
+
+// Implements FlRenderer::present_layers.
+static gboolean fl_renderer_offscreen_present_layers(
+    FlRenderer* renderer,
+    const FlutterLayer** layers,
+    size_t layers_count) {
+  FlRendererOffscreen* self = FL_RENDERER_OFFSCREEN(renderer);
+
+  // Without platform views there is a single layer, that holds the frame.
+  if (layers_count == 0 ||
+      layers[0]->type != kFlutterLayerContentTypeBackingStore) {
+    return TRUE;
+  }
+  if (layers_count > 1) {
+    g_warning("Platform views are not supported when rendering offscreen");
+  }
+
+  const FlutterBackingStore* backing_store = layers[0]->backing_store;
+  size_t width = layers[0]->size.width;
+  size_t height = layers[0]->size.height;
+  if (backing_store->type == kFlutterBackingStoreTypeSoftware) {
+    const FlutterSoftwareBackingStore* software = &backing_store->software;
+    deliver_frame(self, static_cast<const uint8_t*>(software->allocation),
+                  width, height, software->row_bytes, FALSE, FALSE);
+    return TRUE;
+  }
+
+  g_autoptr(GError) error = nullptr;
+  if (!fl_renderer_offscreen_make_current(renderer, &error)) {
+    g_warning("Failed to make renderer current when presenting: %s",
+              error->message);
+    return FALSE;
+  }
+  FlBackingStoreProvider* provider = FL_BACKING_STORE_PROVIDER(
+      backing_store->open_gl.framebuffer.user_data);
+  start_readback(self,
+                 fl_backing_store_provider_get_gl_framebuffer_id(provider),
+                 width, height);
+  return TRUE;
+}
+
+static void fl_renderer_offscreen_dispose(GObject* object) {
+  FlRendererOffscreen* self = FL_RENDERER_OFFSCREEN(object);
+
+  // The engine has shut down, so the contexts are not current anywhere else.
+  if (self->display != EGL_NO_DISPLAY) {
+    if (eglMakeCurrent(self->display, self->main_surface, self->main_surface,
+                       self->main_context)) {
+      g_queue_clear_full(&self->pending_readbacks,
+                         reinterpret_cast<GDestroyNotify>(
+                             fl_offscreen_readback_free));
+      g_queue_clear_full(&self->free_readbacks,
+                         reinterpret_cast<GDestroyNotify>(
+                             fl_offscreen_readback_free));
+    }
+    eglMakeCurrent(self->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                   EGL_NO_CONTEXT);
+    if (self->main_surface != EGL_NO_SURFACE) {
+      eglDestroySurface(self->display, self->main_surface);
+      self->main_surface = EGL_NO_SURFACE;
+    }
+    if (self->resource_surface != EGL_NO_SURFACE) {
+      eglDestroySurface(self->display, self->resource_surface);
+      self->resource_surface = EGL_NO_SURFACE;
+    }
+    if (self->resource_context != EGL_NO_CONTEXT) {
+      eglDestroyContext(self->display, self->resource_context);
+      self->resource_context = EGL_NO_CONTEXT;
+    }
+    if (self->main_context != EGL_NO_CONTEXT) {
+      eglDestroyContext(self->display, self->main_context);
+      self->main_context = EGL_NO_CONTEXT;
+    }
+    self->display = EGL_NO_DISPLAY;
+  }
+
+  if (self->destroy_notify != nullptr) {
+    self->destroy_notify(self->user_data);
+  }
+  self->user_data = nullptr;
+  self->destroy_notify = nullptr;
+
+  G_OBJECT_CLASS(fl_renderer_offscreen_parent_class)->dispose(object);
+}
+
+static void fl_renderer_offscreen_class_init(FlRendererOffscreenClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_renderer_offscreen_dispose;
+
+  FL_RENDERER_CLASS(klass)->start = fl_renderer_offscreen_start;
+  FL_RENDERER_CLASS(klass)->make_current = fl_renderer_offscreen_make_current;
+  FL_RENDERER_CLASS(klass)->make_resource_current =
+      fl_renderer_offscreen_make_resource_current;
+  FL_RENDERER_CLASS(klass)->clear_current = fl_renderer_offscreen_clear_current;
+  FL_RENDERER_CLASS(klass)->create_backing_store =
+      fl_renderer_offscreen_create_backing_store;
+  FL_RENDERER_CLASS(klass)->collect_backing_store =
+      fl_renderer_offscreen_collect_backing_store;
+  FL_RENDERER_CLASS(klass)->present_layers =
+      fl_renderer_offscreen_present_layers;
+}
+
+static void fl_renderer_offscreen_init(FlRendererOffscreen* self) {
+  self->display = EGL_NO_DISPLAY;
+  self->main_context = EGL_NO_CONTEXT;
+  self->resource_context = EGL_NO_CONTEXT;
+  self->main_surface = EGL_NO_SURFACE;
+  self->resource_surface = EGL_NO_SURFACE;
+  g_queue_init(&self->pending_readbacks);
+  g_queue_init(&self->free_readbacks);
+}
+
+FlRendererOffscreen* fl_renderer_offscreen_new(
+    gboolean use_gpu,
+    FlEngineOffscreenBufferHandler buffer_handler,
+    FlEngineOffscreenFrameHandler frame_handler,
+    gpointer user_data,
+    GDestroyNotify destroy_notify) {
+  g_return_val_if_fail(buffer_handler != nullptr, nullptr);
+  g_return_val_if_fail(frame_handler != nullptr, nullptr);
+
+  FlRendererOffscreen* self = FL_RENDERER_OFFSCREEN(
+      g_object_new(fl_renderer_offscreen_get_type(), nullptr));
+  self->use_gpu = use_gpu;
+  self->buffer_handler = buffer_handler;
+  self->frame_handler = frame_handler;
+  self->user_data = user_data;
+  self->destroy_notify = destroy_notify;
+  return self;
+}
+
+void fl_renderer_offscreen_set_engine(FlRendererOffscreen* self,
+                                      FlEngine* engine) {
+  g_return_if_fail(FL_IS_RENDERER_OFFSCREEN(self));
+  self->engine = engine;
+}
+
+gboolean fl_renderer_offscreen_get_use_gpu(FlRendererOffscreen* self) {
+  g_return_val_if_fail(FL_IS_RENDERER_OFFSCREEN(self), FALSE);
+  return self->use_gpu;
+}
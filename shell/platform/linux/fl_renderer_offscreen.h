@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_RENDERER_OFFSCREEN_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_RENDERER_OFFSCREEN_H_
+
+#include "flutter/shell/platform/linux/fl_renderer.h"
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_engine.h"
+
+G_BEGIN_DECLS
+
+G_DECLARE_FINAL_TYPE(FlRendererOffscreen,
+                     fl_renderer_offscreen,
+                     FL,
+                     RENDERER_OFFSCREEN,
+                     FlRenderer)
+
+/**
+ * FlRendererOffscreen:
+ *
+ * #FlRendererOffscreen is an implementation of #FlRenderer that renders frames
+ * into buffers provided by the caller, either on the CPU or by OpenGL ES on an
+ * EGL display without a window.
+ */
+
+/**
+ * fl_renderer_offscreen_new:
+ * @use_gpu: %TRUE to render by OpenGL ES.
+ * @buffer_handler: function to get the buffers frames are written into.
+ * @frame_handler: function to call with every rendered frame.
+ * @user_data: (closure): user data to pass to the handlers.
+ * @destroy_notify: (allow-none): a function which gets called to free
+ * @user_data, or %NULL.
+ *
+ * Creates an object that allows Flutter to render without a display.
+ *
+ * Returns: a new #FlRendererOffscreen.
+ */
+FlRendererOffscreen* fl_renderer_offscreen_new(
+    gboolean use_gpu,
+    FlEngineOffscreenBufferHandler buffer_handler,
+    FlEngineOffscreenFrameHandler frame_handler,
+    gpointer user_data,
+    GDestroyNotify destroy_notify);
+
+/**
+ * fl_renderer_offscreen_set_engine:
+ * @renderer: an #FlRendererOffscreen.
+ * @engine: the engine rendering with @renderer.
+ *
+ * Sets the engine that frames are rendered for. @renderer does not keep a
+ * reference to @engine.
+ */
+void fl_renderer_offscreen_set_engine(FlRendererOffscreen* renderer,
+                                      FlEngine* engine);
+
+/**
+ * fl_renderer_offscreen_get_use_gpu:
+ * @renderer: an #FlRendererOffscreen.
+ *
+ * Returns: %TRUE if @renderer renders by OpenGL ES, %FALSE if it renders on
+ * the CPU.
+ */
+gboolean fl_renderer_offscreen_get_use_gpu(FlRendererOffscreen* renderer);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_RENDERER_OFFSCREEN_H_
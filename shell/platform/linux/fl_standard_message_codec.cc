@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
 #include "flutter/shell/platform/linux/fl_standard_message_codec_private.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -319,6 +320,14 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
   return value;
 }
 
+// Returns the number of children to reserve space for when reading a list or
+// map of @length children from @buffer at @offset. Every child takes at least
+// one byte, so a corrupt length cannot cause a huge allocation.
+static size_t reserved_length(GBytes* buffer, size_t offset, uint32_t length) {
+  size_t remaining = g_bytes_get_size(buffer) - offset;
+  return MIN(static_cast<size_t>(length), remaining);
+}
+
 // Reads a list from @buffer in standard codec format.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_LIST if successful or %NULL on
 // error.
@@ -332,14 +341,15 @@ static FlValue* read_list_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) list = fl_value_new_list();
+  g_autoptr(FlValue) list =
+      fl_value_new_list_sized(reserved_length(buffer, *offset, length));
   for (size_t i = 0; i < length; i++) {
-    g_autoptr(FlValue) child =
+    FlValue* child =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
     if (child == nullptr) {
       return nullptr;
     }
-    fl_value_append(list, child);
+    fl_value_append_take(list, child);
   }
 
   return fl_value_ref(list);
@@ -358,19 +368,22 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) map = fl_value_new_map();
+  g_autoptr(FlValue) map =
+      fl_value_new_map_sized(reserved_length(buffer, *offset, length));
   for (size_t i = 0; i < length; i++) {
     g_autoptr(FlValue) key =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
     if (key == nullptr) {
       return nullptr;
     }
-    g_autoptr(FlValue) value =
+    FlValue* value =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
     if (value == nullptr) {
       return nullptr;
     }
-    fl_value_set(map, key, value);
+    // Maps encoded by the framework never contain duplicate keys, so skip the
+    // linear search fl_value_set() does for each entry.
+    fl_value_map_append_take(map, fl_value_ref(key), value);
   }
 
   return fl_value_ref(map);
@@ -702,6 +702,11 @@ TEST(FlStandardMessageCodecTest, DecodeListShortData2) {
       FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
 }
 
+TEST(FlStandardMessageCodecTest, DecodeListHugeLength) {
+  decode_error_value("0cffffffff7f00", FL_MESSAGE_CODEC_ERROR,
+                     FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
+}
+
 TEST(FlStandardMessageCodecTest, EncodeDecodeLargeList) {
   g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
 
@@ -964,6 +969,11 @@ TEST(FlStandardMessageCodecTest, DecodeMapNoData) {
                      FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
 }
 
+TEST(FlStandardMessageCodecTest, DecodeMapHugeLength) {
+  decode_error_value("0dffffffff7f00", FL_MESSAGE_CODEC_ERROR,
+                     FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
+}
+
 TEST(FlStandardMessageCodecTest, DecodeMapLengthNoData) {
   decode_error_value("0d07", FL_MESSAGE_CODEC_ERROR,
                      FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
@@ -0,0 +1,16 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_texture.h"
+
+#include <gmodule.h>
+
+G_DEFINE_INTERFACE(FlTexture, fl_texture, G_TYPE_OBJECT)
+
+static void fl_texture_default_init(FlTextureInterface* self) {}
+
+G_MODULE_EXPORT int64_t fl_texture_get_id(FlTexture* self) {
+  g_return_val_if_fail(FL_IS_TEXTURE(self), -1);
+  return reinterpret_cast<int64_t>(self);
+}
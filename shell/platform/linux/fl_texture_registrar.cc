@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_texture_registrar.h"
+
+#include <gmodule.h>
+
+#include "flutter/shell/platform/linux/fl_engine_private.h"
+#include "flutter/shell/platform/linux/fl_texture_registrar_private.h"
+
+struct _FlTextureRegistrar {
+  GObject parent_instance;
+
+  // Weak reference to the engine this texture registrar is created for.
+  FlEngine* engine;
+
+  // ID to texture mapping. Looked up on the raster thread, so guarded by
+  // textures_mutex.
+  GHashTable* textures;
+  GMutex textures_mutex;
+};
+
+// Added here to stop the compiler from optimizing this function away.
+G_MODULE_EXPORT GType fl_texture_registrar_get_type();
+
+G_DEFINE_TYPE(FlTextureRegistrar, fl_texture_registrar, G_TYPE_OBJECT)
+
+static void engine_weak_notify_cb(gpointer user_data,
+                                  GObject* where_the_object_was) {
+  FlTextureRegistrar* self = FL_TEXTURE_REGISTRAR(user_data);
+  self->engine = nullptr;
+
+  // The engine is gone, so are the textures it knew about.
+  g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->textures_mutex);
+  g_hash_table_remove_all(self->textures);
+}
+
+static void fl_texture_registrar_dispose(GObject* object) {
+  FlTextureRegistrar* self = FL_TEXTURE_REGISTRAR(object);
+
+  if (self->engine != nullptr) {
+    g_object_weak_unref(G_OBJECT(self->engine), engine_weak_notify_cb, self);
+    self->engine = nullptr;
+  }
+
+  {
+    g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->textures_mutex);
+    g_clear_pointer(&self->textures, g_hash_table_unref);
+  }
+
+  G_OBJECT_CLASS(fl_texture_registrar_parent_class)->dispose(object);
+}
+
+static void fl_texture_registrar_finalize(GObject* object) {
+  FlTextureRegistrar* self = FL_TEXTURE_REGISTRAR(object);
+
+  g_mutex_clear(&self->textures_mutex);
+
+  G_OBJECT_CLASS(fl_texture_registrar_parent_class)->finalize(object);
+}
+
+static void fl_texture_registrar_class_init(FlTextureRegistrarClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_texture_registrar_dispose;
+  G_OBJECT_CLASS(klass)->finalize = fl_texture_registrar_finalize;
+}
+
+static void fl_texture_registrar_init(FlTextureRegistrar* self) {
+  self->textures = g_hash_table_new_full(g_direct_hash, g_direct_equal, nullptr,
+                                         g_object_unref);
+  g_mutex_init(&self->textures_mutex);
+}
+
+G_MODULE_EXPORT gboolean fl_texture_registrar_register_texture(
+    FlTextureRegistrar* self,
+    FlTexture* texture) {
+  g_return_val_if_fail(FL_IS_TEXTURE_REGISTRAR(self), FALSE);
+  g_return_val_if_fail(FL_IS_TEXTURE(texture), FALSE);
+
+  if (self->engine == nullptr) {
+    return FALSE;
+  }
+
+  int64_t id = fl_texture_get_id(texture);
+  if (!fl_engine_register_external_texture(self->engine, id)) {
+    return FALSE;
+  }
+  g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->textures_mutex);
+  g_hash_table_insert(self->textures, GINT_TO_POINTER(id),
+                      g_object_ref(texture));
+  return TRUE;
+}
+
+G_MODULE_EXPORT gboolean fl_texture_registrar_mark_texture_frame_available(
+    FlTextureRegistrar* self,
+    FlTexture* texture) {
+  g_return_val_if_fail(FL_IS_TEXTURE_REGISTRAR(self), FALSE);
+  g_return_val_if_fail(FL_IS_TEXTURE(texture), FALSE);
+
+  if (self->engine == nullptr) {
+    return FALSE;
+  }
+
+  return fl_engine_mark_texture_frame_available(self->engine,
+                                                fl_texture_get_id(texture));
+}
+
+G_MODULE_EXPORT gboolean fl_texture_registrar_unregister_texture(
+    FlTextureRegistrar* self,
+    FlTexture* texture) {
+  g_return_val_if_fail(FL_IS_TEXTURE_REGISTRAR(self), FALSE);
+  g_return_val_if_fail(FL_IS_TEXTURE(texture), FALSE);
+
+  if (self->engine == nullptr) {
+    return FALSE;
+  }
+
+  int64_t id = fl_texture_get_id(texture);
+  gboolean result = fl_engine_unregister_external_texture(self->engine, id);
+  g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->textures_mutex);
+  g_hash_table_remove(self->textures, GINT_TO_POINTER(id));
+  return result;
+}
+
+FlTexture* fl_texture_registrar_lookup_texture(FlTextureRegistrar* self,
+                                               int64_t texture_id) {
+  g_return_val_if_fail(FL_IS_TEXTURE_REGISTRAR(self), nullptr);
+  g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->textures_mutex);
+  if (self->textures == nullptr) {
+    return nullptr;
+  }
+  gpointer texture =
+      g_hash_table_lookup(self->textures, GINT_TO_POINTER(texture_id));
+  return texture != nullptr ? FL_TEXTURE(g_object_ref(texture)) : nullptr;
+}
+
+FlTextureRegistrar* fl_texture_registrar_new(FlEngine* engine) {
+  FlTextureRegistrar* self = FL_TEXTURE_REGISTRAR(
+      g_object_new(fl_texture_registrar_get_type(), nullptr));
+
+  self->engine = engine;
+  g_object_weak_ref(G_OBJECT(engine), engine_weak_notify_cb, self);
+
+  return self;
+}
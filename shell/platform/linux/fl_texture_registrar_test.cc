@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Included first as it collides with the X11 headers.
+#include "gtest/gtest.h"
+
+#include "flutter/shell/platform/embedder/test_utils/proc_table_replacement.h"
+#include "flutter/shell/platform/linux/fl_engine_private.h"
+#include "flutter/shell/platform/linux/fl_texture_registrar_private.h"
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_texture_registrar.h"
+#include "flutter/shell/platform/linux/testing/fl_test.h"
+
+// Checks that textures are registered with and unregistered from the engine.
+TEST(FlTextureRegistrarTest, RegisterTexture) {
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
+
+  int64_t registered_id = 0;
+  embedder_api->RegisterExternalTexture = MOCK_ENGINE_PROC(
+      RegisterExternalTexture, ([&registered_id](auto engine, int64_t id) {
+        registered_id = id;
+        return kSuccess;
+      }));
+  int mark_count = 0;
+  embedder_api->MarkExternalTextureFrameAvailable = MOCK_ENGINE_PROC(
+      MarkExternalTextureFrameAvailable,
+      ([&registered_id, &mark_count](auto engine, int64_t id) {
+        EXPECT_EQ(id, registered_id);
+        mark_count++;
+        return kSuccess;
+      }));
+  bool unregistered = false;
+  embedder_api->UnregisterExternalTexture = MOCK_ENGINE_PROC(
+      UnregisterExternalTexture,
+      ([&registered_id, &unregistered](auto engine, int64_t id) {
+        EXPECT_EQ(id, registered_id);
+        unregistered = true;
+        return kSuccess;
+      }));
+
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_engine_start(engine, &error));
+
+  FlTextureRegistrar* registrar = fl_engine_get_texture_registrar(engine);
+  g_autoptr(FlDmabufTexture) texture = fl_dmabuf_texture_new();
+  int64_t id = fl_texture_get_id(FL_TEXTURE(texture));
+
+  EXPECT_EQ(fl_texture_registrar_lookup_texture(registrar, id), nullptr);
+  EXPECT_TRUE(fl_texture_registrar_register_texture(registrar,
+                                                    FL_TEXTURE(texture)));
+  EXPECT_EQ(registered_id, id);
+  g_autoptr(FlTexture) found_texture =
+      fl_texture_registrar_lookup_texture(registrar, id);
+  EXPECT_EQ(found_texture, FL_TEXTURE(texture));
+
+  EXPECT_TRUE(fl_texture_registrar_mark_texture_frame_available(
+      registrar, FL_TEXTURE(texture)));
+  EXPECT_EQ(mark_count, 1);
+
+  EXPECT_TRUE(fl_texture_registrar_unregister_texture(registrar,
+                                                      FL_TEXTURE(texture)));
+  EXPECT_TRUE(unregistered);
+  EXPECT_EQ(fl_texture_registrar_lookup_texture(registrar, id), nullptr);
+  // The reference returned by the lookup outlives the registration.
+  EXPECT_TRUE(FL_IS_TEXTURE(found_texture));
+}
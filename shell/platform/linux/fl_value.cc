@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -68,6 +69,14 @@ typedef struct {
   GPtrArray* values;
 } FlValueMap;
 
+// Strings and typed lists store their contents directly after the value in
+// the same allocation, so these must keep that storage suitably aligned.
+static_assert(sizeof(FlValueString) % alignof(double) == 0);
+static_assert(sizeof(FlValueUint8List) % alignof(double) == 0);
+static_assert(sizeof(FlValueInt32List) % alignof(double) == 0);
+static_assert(sizeof(FlValueInt64List) % alignof(double) == 0);
+static_assert(sizeof(FlValueFloatList) % alignof(double) == 0);
+
 static FlValue* fl_value_new(FlValueType type, size_t size) {
   FlValue* self = static_cast<FlValue*>(g_malloc0(size));
   self->type = type;
@@ -244,28 +253,37 @@ G_MODULE_EXPORT FlValue* fl_value_new_float(double value) {
   return reinterpret_cast<FlValue*>(self);
 }
 
-G_MODULE_EXPORT FlValue* fl_value_new_string(const gchar* value) {
-  FlValueString* self = reinterpret_cast<FlValueString*>(
-      fl_value_new(FL_VALUE_TYPE_STRING, sizeof(FlValueString)));
-  self->value = g_strdup(value);
+// Creates a string value holding the first @value_length characters of @value.
+static FlValue* fl_value_new_string_inline(const gchar* value,
+                                           size_t value_length) {
+  FlValueString* self = reinterpret_cast<FlValueString*>(fl_value_new(
+      FL_VALUE_TYPE_STRING, sizeof(FlValueString) + value_length + 1));
+  self->value = reinterpret_cast<gchar*>(self + 1);
+  if (value_length > 0) {
+    memcpy(self->value, value, value_length);
+  }
+  self->value[value_length] = '\0';
   return reinterpret_cast<FlValue*>(self);
 }
 
+G_MODULE_EXPORT FlValue* fl_value_new_string(const gchar* value) {
+  return fl_value_new_string_inline(value,
+                                    value != nullptr ? strlen(value) : 0);
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_string_sized(const gchar* value,
                                                    size_t value_length) {
-  FlValueString* self = reinterpret_cast<FlValueString*>(
-      fl_value_new(FL_VALUE_TYPE_STRING, sizeof(FlValueString)));
-  self->value =
-      value_length == 0 ? g_strdup("") : g_strndup(value, value_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_string_inline(
+      value, value_length == 0 ? 0 : strnlen(value, value_length));
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_uint8_list(const uint8_t* data,
                                                  size_t data_length) {
   FlValueUint8List* self = reinterpret_cast<FlValueUint8List*>(
-      fl_value_new(FL_VALUE_TYPE_UINT8_LIST, sizeof(FlValueUint8List)));
+      fl_value_new(FL_VALUE_TYPE_UINT8_LIST,
+                   sizeof(FlValueUint8List) + sizeof(uint8_t) * data_length));
   self->values_length = data_length;
-  self->values = static_cast<uint8_t*>(g_malloc(sizeof(uint8_t) * data_length));
+  self->values = reinterpret_cast<uint8_t*>(self + 1);
   memcpy(self->values, data, sizeof(uint8_t) * data_length);
   return reinterpret_cast<FlValue*>(self);
 }
@@ -280,9 +298,10 @@ G_MODULE_EXPORT FlValue* fl_value_new_uint8_list_from_bytes(GBytes* data) {
 G_MODULE_EXPORT FlValue* fl_value_new_int32_list(const int32_t* data,
                                                  size_t data_length) {
   FlValueInt32List* self = reinterpret_cast<FlValueInt32List*>(
-      fl_value_new(FL_VALUE_TYPE_INT32_LIST, sizeof(FlValueInt32List)));
+      fl_value_new(FL_VALUE_TYPE_INT32_LIST,
+                   sizeof(FlValueInt32List) + sizeof(int32_t) * data_length));
   self->values_length = data_length;
-  self->values = static_cast<int32_t*>(g_malloc(sizeof(int32_t) * data_length));
+  self->values = reinterpret_cast<int32_t*>(self + 1);
   memcpy(self->values, data, sizeof(int32_t) * data_length);
   return reinterpret_cast<FlValue*>(self);
 }
@@ -290,9 +309,10 @@ G_MODULE_EXPORT FlValue* fl_value_new_int32_list(const int32_t* data,
 G_MODULE_EXPORT FlValue* fl_value_new_int64_list(const int64_t* data,
                                                  size_t data_length) {
   FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(
-      fl_value_new(FL_VALUE_TYPE_INT64_LIST, sizeof(FlValueInt64List)));
+      fl_value_new(FL_VALUE_TYPE_INT64_LIST,
+                   sizeof(FlValueInt64List) + sizeof(int64_t) * data_length));
   self->values_length = data_length;
-  self->values = static_cast<int64_t*>(g_malloc(sizeof(int64_t) * data_length));
+  self->values = reinterpret_cast<int64_t*>(self + 1);
   memcpy(self->values, data, sizeof(int64_t) * data_length);
   return reinterpret_cast<FlValue*>(self);
 }
@@ -300,17 +320,22 @@ G_MODULE_EXPORT FlValue* fl_value_new_int64_list(const int64_t* data,
 G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
                                                  size_t data_length) {
   FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
-      fl_value_new(FL_VALUE_TYPE_FLOAT_LIST, sizeof(FlValueFloatList)));
+      fl_value_new(FL_VALUE_TYPE_FLOAT_LIST,
+                   sizeof(FlValueFloatList) + sizeof(double) * data_length));
   self->values_length = data_length;
-  self->values = static_cast<double*>(g_malloc(sizeof(double) * data_length));
+  self->values = reinterpret_cast<double*>(self + 1);
   memcpy(self->values, data, sizeof(double) * data_length);
   return reinterpret_cast<FlValue*>(self);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_list() {
+  return fl_value_new_list_sized(0);
+}
+
+FlValue* fl_value_new_list_sized(size_t reserved_length) {
   FlValueList* self = reinterpret_cast<FlValueList*>(
       fl_value_new(FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
+  self->values = g_ptr_array_new_full(reserved_length, fl_value_destroy);
   return reinterpret_cast<FlValue*>(self);
 }
 
@@ -325,10 +350,14 @@ G_MODULE_EXPORT FlValue* fl_value_new_list_from_strv(
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_map() {
+  return fl_value_new_map_sized(0);
+}
+
+FlValue* fl_value_new_map_sized(size_t reserved_length) {
   FlValueMap* self = reinterpret_cast<FlValueMap*>(
       fl_value_new(FL_VALUE_TYPE_MAP, sizeof(FlValueMap)));
-  self->keys = g_ptr_array_new_with_free_func(fl_value_destroy);
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
+  self->keys = g_ptr_array_new_full(reserved_length, fl_value_destroy);
+  self->values = g_ptr_array_new_full(reserved_length, fl_value_destroy);
   return reinterpret_cast<FlValue*>(self);
 }
 
@@ -347,31 +376,6 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
   }
 
   switch (self->type) {
-    case FL_VALUE_TYPE_STRING: {
-      FlValueString* v = reinterpret_cast<FlValueString*>(self);
-      g_free(v->value);
-      break;
-    }
-    case FL_VALUE_TYPE_UINT8_LIST: {
-      FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
-      break;
-    }
-    case FL_VALUE_TYPE_INT32_LIST: {
-      FlValueInt32List* v = reinterpret_cast<FlValueInt32List*>(self);
-      g_free(v->values);
-      break;
-    }
-    case FL_VALUE_TYPE_INT64_LIST: {
-      FlValueInt64List* v = reinterpret_cast<FlValueInt64List*>(self);
-      g_free(v->values);
-      break;
-    }
-    case FL_VALUE_TYPE_FLOAT_LIST: {
-      FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
-      break;
-    }
     case FL_VALUE_TYPE_LIST: {
       FlValueList* v = reinterpret_cast<FlValueList*>(self);
       g_ptr_array_unref(v->values);
@@ -387,6 +391,12 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     case FL_VALUE_TYPE_BOOL:
     case FL_VALUE_TYPE_INT:
     case FL_VALUE_TYPE_FLOAT:
+    // The contents of these are freed along with the value.
+    case FL_VALUE_TYPE_STRING:
+    case FL_VALUE_TYPE_UINT8_LIST:
+    case FL_VALUE_TYPE_INT32_LIST:
+    case FL_VALUE_TYPE_INT64_LIST:
+    case FL_VALUE_TYPE_FLOAT_LIST:
       break;
   }
   g_free(self);
@@ -550,6 +560,17 @@ G_MODULE_EXPORT void fl_value_set_take(FlValue* self,
   }
 }
 
+void fl_value_map_append_take(FlValue* self, FlValue* key, FlValue* value) {
+  g_return_if_fail(self != nullptr);
+  g_return_if_fail(self->type == FL_VALUE_TYPE_MAP);
+  g_return_if_fail(key != nullptr);
+  g_return_if_fail(value != nullptr);
+
+  FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
+  g_ptr_array_add(v->keys, key);
+  g_ptr_array_add(v->values, value);
+}
+
 G_MODULE_EXPORT void fl_value_set_string(FlValue* self,
                                          const gchar* key,
                                          FlValue* value) {
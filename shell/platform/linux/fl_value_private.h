@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+
+G_BEGIN_DECLS
+
+/**
+ * fl_value_new_list_sized:
+ * @reserved_length: number of children to allocate space for.
+ *
+ * Creates an ordered list like fl_value_new_list() that can hold
+ * @reserved_length children before it needs to grow.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_list_sized(size_t reserved_length);
+
+/**
+ * fl_value_new_map_sized:
+ * @reserved_length: number of entries to allocate space for.
+ *
+ * Creates an ordered associative array like fl_value_new_map() that can hold
+ * @reserved_length entries before it needs to grow.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_map_sized(size_t reserved_length);
+
+/**
+ * fl_value_map_append_take:
+ * @value: an #FlValue of type #FL_VALUE_TYPE_MAP.
+ * @key: (transfer full): an #FlValue.
+ * @child_value: (transfer full): an #FlValue.
+ *
+ * Adds an entry to the end of a map, taking ownership of @key and
+ * @child_value. Unlike fl_value_set_take() this does not look for an existing
+ * entry with the same key, so the caller must ensure there is none. This is
+ * used when decoding messages, whose maps cannot contain duplicate keys.
+ */
+void fl_value_map_append_take(FlValue* value,
+                              FlValue* key,
+                              FlValue* child_value);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
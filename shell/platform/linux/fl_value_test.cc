@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -566,6 +567,17 @@ TEST(FlValueTest, ListNotEqualDifferentSize) {
   EXPECT_FALSE(fl_value_equal(value1, value2));
 }
 
+TEST(FlValueTest, ListSized) {
+  g_autoptr(FlValue) value = fl_value_new_list_sized(2);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(0));
+  fl_value_append_take(value, fl_value_new_int(1));
+  fl_value_append_take(value, fl_value_new_int(2));
+  fl_value_append_take(value, fl_value_new_int(3));
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(3));
+  EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(value, 2)), 3);
+}
+
 TEST(FlValueTest, ListEmptyNotEqual) {
   g_autoptr(FlValue) value1 = fl_value_new_list();
   g_autoptr(FlValue) value2 = fl_value_new_list();
@@ -626,6 +638,22 @@ TEST(FlValueTest, MapSetTake) {
   EXPECT_EQ(fl_value_get_int(fl_value_get_map_value(value, 0)), 42);
 }
 
+TEST(FlValueTest, MapAppendTake) {
+  g_autoptr(FlValue) value = fl_value_new_map_sized(2);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(0));
+  fl_value_map_append_take(value, fl_value_new_string("one"),
+                           fl_value_new_int(1));
+  fl_value_map_append_take(value, fl_value_new_string("two"),
+                           fl_value_new_int(2));
+  fl_value_map_append_take(value, fl_value_new_string("three"),
+                           fl_value_new_int(3));
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(3));
+  EXPECT_STREQ(fl_value_get_string(fl_value_get_map_key(value, 2)), "three");
+  FlValue* two = fl_value_lookup_string(value, "two");
+  ASSERT_NE(two, nullptr);
+  EXPECT_EQ(fl_value_get_int(two), 2);
+}
+
 TEST(FlValueTest, MapSetString) {
   g_autoptr(FlValue) value = fl_value_new_map();
   g_autoptr(FlValue) v = fl_value_new_int(42);
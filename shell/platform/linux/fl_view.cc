@@ -14,6 +14,7 @@
 #include "flutter/shell/platform/linux/fl_mouse_cursor_plugin.h"
 #include "flutter/shell/platform/linux/fl_platform_plugin.h"
 #include "flutter/shell/platform/linux/fl_plugin_registrar_private.h"
+#include "flutter/shell/platform/linux/fl_renderer_egl.h"
 #include "flutter/shell/platform/linux/fl_renderer_gl.h"
 #include "flutter/shell/platform/linux/fl_text_input_plugin.h"
 #include "flutter/shell/platform/linux/fl_view_accessible.h"
@@ -134,6 +135,7 @@ static void fl_view_geometry_changed(FlView* self) {
   GtkAllocation allocation;
   gtk_widget_get_allocation(GTK_WIDGET(self), &allocation);
   gint scale_factor = gtk_widget_get_scale_factor(GTK_WIDGET(self));
+  fl_renderer_set_geometry(self->renderer, &allocation, scale_factor);
   fl_engine_send_window_metrics_event(
       self->engine, allocation.width * scale_factor,
       allocation.height * scale_factor, scale_factor);
@@ -146,7 +148,8 @@ static FlPluginRegistrar* fl_view_get_registrar_for_plugin(
   FlView* self = FL_VIEW(registry);
 
   return fl_plugin_registrar_new(self,
-                                 fl_engine_get_binary_messenger(self->engine));
+                                 fl_engine_get_binary_messenger(self->engine),
+                                 fl_engine_get_texture_registrar(self->engine));
 }
 
 static void fl_view_plugin_registry_iface_init(
@@ -173,7 +176,11 @@ static gboolean event_box_motion_notify_event(GtkWidget* widget,
 static void fl_view_constructed(GObject* object) {
   FlView* self = FL_VIEW(object);
 
-  self->renderer = FL_RENDERER(fl_renderer_gl_new());
+  if (fl_dart_project_get_direct_rendering(self->project)) {
+    self->renderer = FL_RENDERER(fl_renderer_egl_new());
+  } else {
+    self->renderer = FL_RENDERER(fl_renderer_gl_new());
+  }
   self->engine = fl_engine_new(self->project, self->renderer);
   fl_engine_set_update_semantics_node_handler(
       self->engine, fl_view_update_semantics_node_cb, self, nullptr);
@@ -188,6 +195,11 @@ static void fl_view_constructed(GObject* object) {
   self->platform_plugin = fl_platform_plugin_new(messenger);
 
   self->event_box = gtk_event_box_new();
+  // Frames rendered straight into the window are below the event box, so it
+  // must not draw over them.
+  if (FL_IS_RENDERER_EGL(self->renderer)) {
+    gtk_event_box_set_visible_window(GTK_EVENT_BOX(self->event_box), FALSE);
+  }
   gtk_widget_set_parent(self->event_box, GTK_WIDGET(self));
   gtk_widget_show(self->event_box);
   gtk_widget_add_events(self->event_box,
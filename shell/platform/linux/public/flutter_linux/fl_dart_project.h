@@ -62,6 +62,31 @@ void fl_dart_project_set_enable_mirrors(FlDartProject* project,
 gboolean fl_dart_project_get_enable_mirrors(FlDartProject* project)
     G_DEPRECATED;
 
+/**
+ * fl_dart_project_set_direct_rendering:
+ * @project: an #FlDartProject.
+ * @direct_rendering: %TRUE if Flutter should render straight into the window.
+ *
+ * Sets if views running this project render straight into an EGL window
+ * surface, rather than into textures that GTK then draws into the window.
+ * This saves copying every frame, and lets Flutter only repaint and present
+ * the regions of a frame that changed, but platform views are not shown.
+ * If not set, views render through GTK.
+ */
+void fl_dart_project_set_direct_rendering(FlDartProject* project,
+                                          gboolean direct_rendering);
+
+/**
+ * fl_dart_project_get_direct_rendering:
+ * @project: an #FlDartProject.
+ *
+ * Gets if views running this project render straight into the window. See
+ * fl_dart_project_set_direct_rendering().
+ *
+ * Returns: %TRUE if Flutter renders straight into the window.
+ */
+gboolean fl_dart_project_get_direct_rendering(FlDartProject* project);
+
 /**
  * fl_dart_project_get_aot_library_path:
  * @project: an #FlDartProject.
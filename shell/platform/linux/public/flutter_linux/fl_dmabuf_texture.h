@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
+
+#if !defined(__FLUTTER_LINUX_INSIDE__) && !defined(FLUTTER_LINUX_COMPILATION)
+#error "Only <flutter_linux/flutter_linux.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fl_texture_gl.h"
+
+G_BEGIN_DECLS
+
+/**
+ * FL_DMABUF_TEXTURE_MAX_PLANES:
+ *
+ * The maximum number of planes of a frame of an #FlDmabufTexture.
+ */
+#define FL_DMABUF_TEXTURE_MAX_PLANES 4
+
+G_DECLARE_FINAL_TYPE(FlDmabufTexture,
+                     fl_dmabuf_texture,
+                     FL,
+                     DMABUF_TEXTURE,
+                     FlTextureGL)
+
+/**
+ * FlDmabufTexture:
+ *
+ * #FlDmabufTexture is an #FlTextureGL that shows frames that are stored in
+ * DMA-BUFs, such as the ones decoded by GStreamer or captured with V4L2.
+ *
+ * Frames are imported into OpenGL as EGL images with
+ * EGL_EXT_image_dma_buf_import, so the pixels are never copied by the CPU.
+ * Frames of any format that the GPU driver supports can be imported,
+ * including YUV formats, as they are sampled as GL_TEXTURE_EXTERNAL_OES
+ * textures. This requires Flutter to render with EGL.
+ */
+
+/**
+ * FlDmabufPlane:
+ * @fd: the DMA-BUF file descriptor of the plane.
+ * @offset: the offset of the plane in the DMA-BUF, in bytes.
+ * @stride: the stride of the rows of the plane, in bytes.
+ *
+ * A plane of a frame of an #FlDmabufTexture.
+ */
+typedef struct {
+  int fd;
+  uint32_t offset;
+  uint32_t stride;
+} FlDmabufPlane;
+
+/**
+ * fl_dmabuf_texture_new:
+ *
+ * Creates a new texture that shows DMA-BUF frames. Register it with
+ * fl_texture_registrar_register_texture() and set its frames with
+ * fl_dmabuf_texture_set_frame().
+ *
+ * Returns: a new #FlDmabufTexture.
+ */
+FlDmabufTexture* fl_dmabuf_texture_new();
+
+/**
+ * fl_dmabuf_texture_set_frame:
+ * @texture: an #FlDmabufTexture.
+ * @width: the width of the frame in pixels.
+ * @height: the height of the frame in pixels.
+ * @fourcc: the DRM fourcc format of the frame, e.g. DRM_FORMAT_NV12.
+ * @modifier: the DRM format modifier of the frame, or DRM_FORMAT_MOD_INVALID
+ * to let the driver pick the one the buffers were allocated with.
+ * @planes: (array length=n_planes): the planes of the frame.
+ * @n_planes: the number of planes, at most #FL_DMABUF_TEXTURE_MAX_PLANES.
+ * @user_data: (closure): user data to pass to @destroy_notify.
+ * @destroy_notify: (allow-none): a function which gets called once Flutter no
+ * longer uses the frame, and its buffers can be reused.
+ *
+ * Sets the frame that is shown at the next Flutter frame, replacing the
+ * previous one. The file descriptors of @planes must stay valid until
+ * @destroy_notify is called. Call
+ * fl_texture_registrar_mark_texture_frame_available() afterwards for Flutter
+ * to draw the frame.
+ *
+ * This function can be called from any thread.
+ */
+void fl_dmabuf_texture_set_frame(FlDmabufTexture* texture,
+                                 uint32_t width,
+                                 uint32_t height,
+                                 uint32_t fourcc,
+                                 uint64_t modifier,
+                                 const FlDmabufPlane* planes,
+                                 size_t n_planes,
+                                 gpointer user_data,
+                                 GDestroyNotify destroy_notify);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
@@ -13,6 +13,7 @@
 
 #include "fl_binary_messenger.h"
 #include "fl_dart_project.h"
+#include "fl_texture_registrar.h"
 
 G_BEGIN_DECLS
 
@@ -34,6 +35,92 @@ G_DECLARE_FINAL_TYPE(FlEngine, fl_engine, FL, ENGINE, GObject)
  */
 FlEngine* fl_engine_new_headless(FlDartProject* project);
 
+/**
+ * FlEngineOffscreenBufferHandler:
+ * @engine: an #FlEngine.
+ * @size: the number of bytes the frame needs.
+ * @user_data: (closure): data provided when registering this handler.
+ *
+ * Function called on the engine's raster thread to get the buffer to write a
+ * rendered frame into.
+ *
+ * Returns: a buffer of at least @size bytes, that is written to and then
+ * passed to the #FlEngineOffscreenFrameHandler, or %NULL to drop the frame.
+ */
+typedef gpointer (*FlEngineOffscreenBufferHandler)(FlEngine* engine,
+                                                   size_t size,
+                                                   gpointer user_data);
+
+/**
+ * FlEngineOffscreenFrameHandler:
+ * @engine: an #FlEngine.
+ * @buffer: the buffer returned by the #FlEngineOffscreenBufferHandler.
+ * @width: the width of the frame in pixels.
+ * @height: the height of the frame in pixels.
+ * @row_bytes: the number of bytes between the starts of two rows.
+ * @user_data: (closure): data provided when registering this handler.
+ *
+ * Function called on the engine's raster thread once a frame was written into
+ * @buffer. The pixels are premultiplied 32 bit ARGB values in native byte
+ * order, the same as %CAIRO_FORMAT_ARGB32, with the top row first. The buffer
+ * belongs to the caller again.
+ */
+typedef void (*FlEngineOffscreenFrameHandler)(FlEngine* engine,
+                                              gpointer buffer,
+                                              size_t width,
+                                              size_t height,
+                                              size_t row_bytes,
+                                              gpointer user_data);
+
+/**
+ * fl_engine_new_offscreen:
+ * @project: an #FlDartProject.
+ * @use_gpu: %TRUE to render with OpenGL ES on an EGL display without a
+ * window, %FALSE to render on the CPU.
+ * @buffer_handler: function to get the buffers frames are written into.
+ * @frame_handler: function to call with every rendered frame.
+ * @user_data: (closure): user data to pass to @buffer_handler and
+ * @frame_handler.
+ * @destroy_notify: (allow-none): a function which gets called to free
+ * @user_data, or %NULL.
+ *
+ * Creates new Flutter engine that renders frames as fast as it can into
+ * buffers provided by the caller, for instance to render images in batch
+ * jobs. Frames are not paced by vsync, and are rasterized on a thread of
+ * their own so the next frame is built while the previous one is rasterized.
+ * When rendering with the GPU, frames are read back asynchronously, so the
+ * GPU is not stalled until the pixels of several frames are needed.
+ *
+ * Start rendering with fl_engine_start_offscreen().
+ *
+ * Returns: a new #FlEngine.
+ */
+FlEngine* fl_engine_new_offscreen(FlDartProject* project,
+                                  gboolean use_gpu,
+                                  FlEngineOffscreenBufferHandler buffer_handler,
+                                  FlEngineOffscreenFrameHandler frame_handler,
+                                  gpointer user_data,
+                                  GDestroyNotify destroy_notify);
+
+/**
+ * fl_engine_start_offscreen:
+ * @engine: an #FlEngine created with fl_engine_new_offscreen().
+ * @width: the width of the frames in pixels.
+ * @height: the height of the frames in pixels.
+ * @pixel_ratio: the number of pixels per logical pixel.
+ * @error: (allow-none): #GError location to store the error occurring, or
+ * %NULL to ignore.
+ *
+ * Starts the engine, rendering frames of the given size.
+ *
+ * Returns: %TRUE if the engine was started.
+ */
+gboolean fl_engine_start_offscreen(FlEngine* engine,
+                                   size_t width,
+                                   size_t height,
+                                   double pixel_ratio,
+                                   GError** error);
+
 /**
  * fl_engine_get_binary_messenger:
  * @engine: an #FlEngine.
@@ -44,6 +131,16 @@ FlEngine* fl_engine_new_headless(FlDartProject* project);
  */
 FlBinaryMessenger* fl_engine_get_binary_messenger(FlEngine* engine);
 
+/**
+ * fl_engine_get_texture_registrar:
+ * @engine: an #FlEngine.
+ *
+ * Gets the texture registrar for registering textures.
+ *
+ * Returns: an #FlTextureRegistrar.
+ */
+FlTextureRegistrar* fl_engine_get_texture_registrar(FlEngine* engine);
+
 G_END_DECLS
 
 #endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_ENGINE_H_
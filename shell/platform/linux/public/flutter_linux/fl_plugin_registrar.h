@@ -12,6 +12,7 @@
 #include <glib-object.h>
 
 #include "fl_binary_messenger.h"
+#include "fl_texture_registrar.h"
 #include "fl_view.h"
 
 G_BEGIN_DECLS
@@ -39,6 +40,17 @@ G_DECLARE_FINAL_TYPE(FlPluginRegistrar,
 FlBinaryMessenger* fl_plugin_registrar_get_messenger(
     FlPluginRegistrar* registrar);
 
+/**
+ * fl_plugin_registrar_get_texture_registrar:
+ * @registrar: an #FlPluginRegistrar.
+ *
+ * Gets the texture registrar this plugin can communicate with.
+ *
+ * Returns: an #FlTextureRegistrar.
+ */
+FlTextureRegistrar* fl_plugin_registrar_get_texture_registrar(
+    FlPluginRegistrar* registrar);
+
 /**
  * fl_plugin_registrar_get_view:
  * @registrar: an #FlPluginRegistrar.
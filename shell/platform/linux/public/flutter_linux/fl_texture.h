@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_TEXTURE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_TEXTURE_H_
+
+#if !defined(__FLUTTER_LINUX_INSIDE__) && !defined(FLUTTER_LINUX_COMPILATION)
+#error "Only <flutter_linux/flutter_linux.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+#include <stdint.h>
+
+G_BEGIN_DECLS
+
+G_DECLARE_INTERFACE(FlTexture, fl_texture, FL, TEXTURE, GObject)
+
+/**
+ * FlTexture:
+ *
+ * #FlTexture is an abstract class that represents a texture that is drawn by
+ * a plugin and composited by Flutter, see #FlTextureGL and #FlDmabufTexture.
+ */
+
+struct _FlTextureInterface {
+  GTypeInterface g_iface;
+};
+
+/**
+ * fl_texture_get_id:
+ * @texture: an #FlTexture.
+ *
+ * Gets the ID of this texture, which the Texture widget of the Dart side uses
+ * to refer to it.
+ *
+ * Returns: the ID of this texture.
+ */
+int64_t fl_texture_get_id(FlTexture* texture);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_TEXTURE_H_
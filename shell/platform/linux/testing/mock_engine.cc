@@ -39,19 +39,25 @@ struct _FlutterPlatformMessageResponseHandle {
   FlutterDataCallback data_callback;
   void* user_data;
   std::string channel;
+  // The data of the message, for handles generated by the engine.
+  uint8_t** message;
   bool released;
 
   // Constructor for a response handle generated by the engine.
-  explicit _FlutterPlatformMessageResponseHandle(std::string channel)
+  _FlutterPlatformMessageResponseHandle(std::string channel, uint8_t** message)
       : data_callback(nullptr),
         user_data(nullptr),
         channel(channel),
+        message(message),
         released(false) {}
 
   // Constructor for a response handle generated by the shell.
   _FlutterPlatformMessageResponseHandle(FlutterDataCallback data_callback,
                                         void* user_data)
-      : data_callback(data_callback), user_data(user_data), released(false) {}
+      : data_callback(data_callback),
+        user_data(user_data),
+        message(nullptr),
+        released(false) {}
 };
 
 struct _FlutterTaskRunner {
@@ -167,7 +173,7 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
 
   EXPECT_NE(user_data, nullptr);
 
-  EXPECT_EQ(config->type, kOpenGL);
+  EXPECT_TRUE(config->type == kOpenGL || config->type == kSoftware);
 
   *engine_out = new _FlutterEngine(
       args->platform_message_callback,
@@ -402,6 +408,43 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* release_user_data) {
+  FlutterEngineResult result = FlutterEngineSendPlatformMessageResponse(
+      engine, handle, data, data_length);
+  if (release_callback != nullptr) {
+    release_callback(release_user_data);
+  }
+  return result;
+}
+
+FlutterEngineResult FlutterPlatformMessageTakeData(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    uint8_t** data_out) {
+  EXPECT_NE(engine, nullptr);
+  EXPECT_NE(handle, nullptr);
+
+  EXPECT_TRUE(engine->running);
+
+  if (handle->message == nullptr || *handle->message == nullptr) {
+    return kInvalidArguments;
+  }
+  *data_out = *handle->message;
+  *handle->message = nullptr;
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterPlatformMessageReleaseData(uint8_t* data) {
+  free(data);
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                              engine,
                                          const FlutterTask* task) {
@@ -419,7 +462,8 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                    response_handle->user_data);
   } else {
     _FlutterPlatformMessageResponseHandle* handle =
-        new _FlutterPlatformMessageResponseHandle(runner->channel);
+        new _FlutterPlatformMessageResponseHandle(runner->channel,
+                                                  &runner->message);
 
     FlutterPlatformMessage message;
     message.struct_size = sizeof(FlutterPlatformMessage);
@@ -461,6 +505,24 @@ FlutterEngineResult FlutterEngineDispatchSemanticsAction(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineRegisterExternalTexture(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier) {
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier) {
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineUnregisterExternalTexture(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier) {
+  return kSuccess;
+}
+
 }  // namespace
 
 FlutterEngineResult FlutterEngineGetProcAddresses(
@@ -488,11 +550,19 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
       &FlutterPlatformMessageReleaseResponseHandle;
   table->SendPlatformMessageResponse =
       &FlutterEngineSendPlatformMessageResponse;
+  table->SendPlatformMessageResponseNoCopy =
+      &FlutterEngineSendPlatformMessageResponseNoCopy;
+  table->PlatformMessageTakeData = &FlutterPlatformMessageTakeData;
+  table->PlatformMessageReleaseData = &FlutterPlatformMessageReleaseData;
   table->RunTask = &FlutterEngineRunTask;
   table->UpdateLocales = &FlutterEngineUpdateLocales;
   table->UpdateSemanticsEnabled = &FlutterEngineUpdateSemanticsEnabled;
   table->DispatchSemanticsAction = &FlutterEngineDispatchSemanticsAction;
   table->RunsAOTCompiledDartCode = &FlutterEngineRunsAOTCompiledDartCode;
+  table->RegisterExternalTexture = &FlutterEngineRegisterExternalTexture;
+  table->MarkExternalTextureFrameAvailable =
+      &FlutterEngineMarkExternalTextureFrameAvailable;
+  table->UnregisterExternalTexture = &FlutterEngineUnregisterExternalTexture;
 
   return kSuccess;
 }
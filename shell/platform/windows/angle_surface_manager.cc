@@ -4,6 +4,9 @@
 
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 
+#include <dxgi.h>
+
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -178,9 +181,55 @@ bool AngleSurfaceManager::Initialize() {
     return false;
   }
 
+  const char* extensions = eglQueryString(egl_display_, EGL_EXTENSIONS);
+  supports_direct_composition_ =
+      extensions &&
+      std::strstr(extensions, "EGL_ANGLE_direct_composition") != nullptr;
+  LimitFrameLatency();
+
+  return true;
+}
+
+bool AngleSurfaceManager::GetDevice(ID3D11Device** device) {
+  auto egl_query_display_attrib_EXT =
+      reinterpret_cast<PFNEGLQUERYDISPLAYATTRIBEXTPROC>(
+          eglGetProcAddress("eglQueryDisplayAttribEXT"));
+  auto egl_query_device_attrib_EXT =
+      reinterpret_cast<PFNEGLQUERYDEVICEATTRIBEXTPROC>(
+          eglGetProcAddress("eglQueryDeviceAttribEXT"));
+  if (!egl_query_display_attrib_EXT || !egl_query_device_attrib_EXT) {
+    return false;
+  }
+
+  EGLAttrib egl_device = 0;
+  EGLAttrib d3d11_device = 0;
+  if (!egl_query_display_attrib_EXT(egl_display_, EGL_DEVICE_EXT,
+                                    &egl_device) ||
+      !egl_query_device_attrib_EXT(reinterpret_cast<EGLDeviceEXT>(egl_device),
+                                   EGL_D3D11_DEVICE_ANGLE, &d3d11_device)) {
+    // ANGLE runs on D3D9.
+    return false;
+  }
+
+  *device = reinterpret_cast<ID3D11Device*>(d3d11_device);
+  (*device)->AddRef();
   return true;
 }
 
+void AngleSurfaceManager::LimitFrameLatency() {
+  Microsoft::WRL::ComPtr<ID3D11Device> device;
+  if (!GetDevice(&device)) {
+    return;
+  }
+
+  Microsoft::WRL::ComPtr<IDXGIDevice1> dxgi_device;
+  if (FAILED(device.As(&dxgi_device)) ||
+      FAILED(dxgi_device->SetMaximumFrameLatency(1))) {
+    std::cerr << "Failed to limit the frame latency of the D3D11 device."
+              << std::endl;
+  }
+}
+
 void AngleSurfaceManager::CleanUp() {
   EGLBoolean result = EGL_FALSE;
 
@@ -226,8 +275,15 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
   const EGLint surfaceAttributes[] = {EGL_NONE};
 #else
   const EGLint surfaceAttributes[] = {
-      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
-      EGL_HEIGHT,           height,   EGL_NONE};
+      EGL_FIXED_SIZE_ANGLE,
+      EGL_TRUE,
+      EGL_WIDTH,
+      width,
+      EGL_HEIGHT,
+      height,
+      EGL_DIRECT_COMPOSITION_ANGLE,
+      supports_direct_composition_ ? EGL_TRUE : EGL_FALSE,
+      EGL_NONE};
 #endif
 
 #ifdef WINUWP
@@ -326,4 +382,12 @@ EGLBoolean AngleSurfaceManager::SwapBuffers() {
   return (eglSwapBuffers(egl_display_, render_surface_));
 }
 
+EGLSurface AngleSurfaceManager::CreateSurfaceFromHandle(
+    EGLenum handle_type,
+    EGLClientBuffer handle,
+    const EGLint* attributes) const {
+  return eglCreatePbufferFromClientBuffer(egl_display_, handle_type, handle,
+                                          egl_config_, attributes);
+}
+
 }  // namespace flutter
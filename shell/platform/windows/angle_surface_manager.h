@@ -13,7 +13,9 @@
 #include <GLES2/gl2ext.h>
 
 // Windows platform specific includes
+#include <d3d11.h>
 #include <windows.h>
+#include <wrl/client.h>
 #include <memory>
 
 #include "window_binding_handler.h"
@@ -25,7 +27,7 @@ namespace flutter {
 class AngleSurfaceManager {
  public:
   static std::unique_ptr<AngleSurfaceManager> Create();
-  ~AngleSurfaceManager();
+  virtual ~AngleSurfaceManager();
 
   // Disallow copy/move.
   AngleSurfaceManager(const AngleSurfaceManager&) = delete;
@@ -43,20 +45,20 @@ class AngleSurfaceManager {
   // based on width and height for the specific case when width and height do
   // not match current surface dimensions.  Target represents the visual entity
   // to bind to.
-  void ResizeSurface(WindowsRenderTarget* render_target,
-                     EGLint width,
-                     EGLint height);
+  virtual void ResizeSurface(WindowsRenderTarget* render_target,
+                             EGLint width,
+                             EGLint height);
 
   // queries EGL for the dimensions of surface in physical
   // pixels returning width and height as out params.
-  void GetSurfaceDimensions(EGLint* width, EGLint* height);
+  virtual void GetSurfaceDimensions(EGLint* width, EGLint* height);
 
   // Releases the pass-in EGLSurface wrapping and backing resources if not null.
   void DestroySurface();
 
   // Binds egl_context_ to the current rendering thread and to the draw and read
   // surfaces returning a boolean result reflecting success.
-  bool MakeCurrent();
+  virtual bool MakeCurrent();
 
   // Clears current egl_context_
   bool ClearContext();
@@ -67,23 +69,40 @@ class AngleSurfaceManager {
 
   // Swaps the front and back buffers of the DX11 swapchain backing surface if
   // not null.
-  EGLBoolean SwapBuffers();
+  virtual EGLBoolean SwapBuffers();
 
- private:
-  bool Initialize();
-  void CleanUp();
+  // Creates a |EGLSurface| from the provided handle.
+  EGLSurface CreateSurfaceFromHandle(EGLenum handle_type,
+                                     EGLClientBuffer handle,
+                                     const EGLint* attributes) const;
 
- private:
+  // Gets the |EGLDisplay|.
+  EGLDisplay egl_display() const { return egl_display_; }
+
+  // Gets the |ID3D11Device| chosen by ANGLE.
+  bool GetDevice(ID3D11Device** device);
+
+ protected:
   // Creates a new surface manager retaining reference to the passed-in target
   // for the lifetime of the manager.
+  //
+  // Protected so that tests can mock the surface manager.
   AngleSurfaceManager();
 
+ private:
+  bool Initialize();
+  void CleanUp();
+
   // Attempts to initialize EGL using ANGLE.
   bool InitializeEGL(
       PFNEGLGETPLATFORMDISPLAYEXTPROC egl_get_platform_display_EXT,
       const EGLint* config,
       bool should_log);
 
+  // Limits the frames that the D3D11 device of ANGLE queues ahead of the
+  // display to one, as each queued frame adds a frame of input latency.
+  void LimitFrameLatency();
+
   // EGL representation of native display.
   EGLDisplay egl_display_;
 
@@ -101,6 +120,11 @@ class AngleSurfaceManager {
   // creating surfaces.
   bool initialize_succeeded_;
 
+  // Whether window surfaces can be presented with DirectComposition, which
+  // uses flip-model swapchains rather than the blt model, saving a copy and a
+  // frame of latency in the desktop window manager.
+  bool supports_direct_composition_ = false;
+
   // Current render_surface that engine will draw into.
   EGLSurface render_surface_ = EGL_NO_SURFACE;
 
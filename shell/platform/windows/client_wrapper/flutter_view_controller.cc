@@ -46,6 +46,11 @@ FlutterViewController::~FlutterViewController() {
   }
 }
 
+void FlutterViewController::SetNonBlockingResize(bool non_blocking_resize) {
+  FlutterDesktopViewControllerSetNonBlockingResize(controller_,
+                                                   non_blocking_resize);
+}
+
 #ifndef WINUWP
 std::optional<LRESULT> FlutterViewController::HandleTopLevelWindowProc(
     HWND hwnd,
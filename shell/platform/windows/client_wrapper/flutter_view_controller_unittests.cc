@@ -27,6 +27,11 @@ class TestWindowsApi : public testing::StubFlutterWindowsApi {
   // |flutter::testing::StubFlutterWindowsApi|
   void ViewControllerDestroy() override { view_controller_destroyed_ = true; }
 
+  // |flutter::testing::StubFlutterWindowsApi|
+  void ViewControllerSetNonBlockingResize(bool non_blocking_resize) override {
+    non_blocking_resize_ = non_blocking_resize;
+  }
+
   // |flutter::testing::StubFlutterWindowsApi|
   FlutterDesktopEngineRef EngineCreate(
       const FlutterDesktopEngineProperties& engine_properties) override {
@@ -41,10 +46,12 @@ class TestWindowsApi : public testing::StubFlutterWindowsApi {
 
   bool engine_destroyed() { return engine_destroyed_; }
   bool view_controller_destroyed() { return view_controller_destroyed_; }
+  bool non_blocking_resize() { return non_blocking_resize_; }
 
  private:
   bool engine_destroyed_ = false;
   bool view_controller_destroyed_ = false;
+  bool non_blocking_resize_ = false;
 };
 
 }  // namespace
@@ -79,4 +86,16 @@ TEST(FlutterViewControllerTest, GetView) {
   EXPECT_NE(controller.view(), nullptr);
 }
 
+TEST(FlutterViewControllerTest, SetNonBlockingResize) {
+  DartProject project(L"data");
+  testing::ScopedStubFlutterWindowsApi scoped_api_stub(
+      std::make_unique<TestWindowsApi>());
+  auto test_api = static_cast<TestWindowsApi*>(scoped_api_stub.stub());
+  FlutterViewController controller(100, 100, project);
+  controller.SetNonBlockingResize(true);
+  EXPECT_TRUE(test_api->non_blocking_resize());
+  controller.SetNonBlockingResize(false);
+  EXPECT_FALSE(test_api->non_blocking_resize());
+}
+
 }  // namespace flutter
@@ -64,6 +64,13 @@ class FlutterViewController {
   // Returns the view managed by this controller.
   FlutterView* view() { return view_.get(); }
 
+  // Sets whether resizing the window blocks the platform thread until the
+  // engine has presented a frame at the new size, which is the default.
+  //
+  // When resizing does not block, the window keeps showing the last frame,
+  // stretched to the window, until a frame at the new size is presented.
+  void SetNonBlockingResize(bool non_blocking_resize);
+
 #ifndef WINUWP
   // Allows the Flutter engine and any interested plugins an opportunity to
   // handle the given message.
@@ -67,6 +67,15 @@ FlutterDesktopViewRef FlutterDesktopViewControllerGetView(
 void FlutterDesktopViewControllerForceRedraw(
     FlutterDesktopViewControllerRef controller) {}
 
+void FlutterDesktopViewControllerSetNonBlockingResize(
+    FlutterDesktopViewControllerRef controller,
+    bool non_blocking_resize) {
+  if (s_stub_implementation) {
+    s_stub_implementation->ViewControllerSetNonBlockingResize(
+        non_blocking_resize);
+  }
+}
+
 bool FlutterDesktopViewControllerHandleTopLevelWindowProc(
     FlutterDesktopViewControllerRef controller,
     HWND hwnd,
@@ -38,6 +38,9 @@ class StubFlutterWindowsApi {
   // Called for FlutterDesktopViewControllerDestroy.
   virtual void ViewControllerDestroy() {}
 
+  // Called for FlutterDesktopViewControllerSetNonBlockingResize.
+  virtual void ViewControllerSetNonBlockingResize(bool non_blocking_resize) {}
+
   // Called for FlutterDesktopViewControllerHandleTopLevelWindowProc.
   virtual bool ViewControllerHandleTopLevelWindowProc(HWND hwnd,
                                                       UINT message,
@@ -0,0 +1,204 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/external_texture_d3d.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <dxgi.h>
+
+#include <iostream>
+
+namespace flutter {
+
+namespace {
+
+// How long to wait for the producer to release the keyed mutex of a surface
+// before the frame is skipped.
+constexpr DWORD kKeyedMutexTimeoutMillis = 100;
+
+}  // namespace
+
+ExternalTextureD3d::ExternalTextureD3d(
+    FlutterDesktopGpuSurfaceType type,
+    const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
+    void* user_data,
+    AngleSurfaceManager* surface_manager)
+    : type_(type),
+      texture_callback_(texture_callback),
+      user_data_(user_data),
+      surface_manager_(surface_manager) {}
+
+ExternalTextureD3d::~ExternalTextureD3d() {
+  ReleaseSurface();
+  const auto& gl = ResolveGlProcs();
+  if (gl.valid && gl_texture_ != 0) {
+    gl.glDeleteTextures(1, &gl_texture_);
+  }
+}
+
+bool ExternalTextureD3d::PopulateTexture(size_t width,
+                                         size_t height,
+                                         FlutterOpenGLTexture* opengl_texture) {
+  const FlutterDesktopGpuSurfaceDescriptor* descriptor =
+      texture_callback_(width, height, user_data_);
+  if (!descriptor || !descriptor->handle) {
+    return false;
+  }
+
+  bool populated = true;
+  if (descriptor->handle != surface_handle_ ||
+      descriptor->width != surface_width_ ||
+      descriptor->height != surface_height_) {
+    populated = ImportSurface(descriptor);
+  }
+  if (populated && keyed_mutex_) {
+    populated = CopySurface();
+  }
+
+  // The surface was opened, or copied, and can be reused by the producer.
+  if (descriptor->release_callback) {
+    descriptor->release_callback(descriptor->release_context);
+  }
+  if (!populated) {
+    return false;
+  }
+
+  // Populate the texture object used by the engine.
+  opengl_texture->target = GL_TEXTURE_2D;
+  opengl_texture->name = gl_texture_;
+  opengl_texture->format = GL_RGBA8;
+  opengl_texture->destruction_callback = nullptr;
+  opengl_texture->user_data = nullptr;
+  opengl_texture->width = surface_width_;
+  opengl_texture->height = surface_height_;
+
+  return true;
+}
+
+bool ExternalTextureD3d::ImportSurface(
+    const FlutterDesktopGpuSurfaceDescriptor* descriptor) {
+  const auto& gl = ResolveGlProcs();
+  if (!gl.valid) {
+    return false;
+  }
+  ReleaseSurface();
+
+  Microsoft::WRL::ComPtr<ID3D11Device> device;
+  if (!surface_manager_->GetDevice(&device)) {
+    std::cerr << "GPU surface textures require ANGLE to use D3D11."
+              << std::endl;
+    return false;
+  }
+
+  if (type_ == kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle) {
+    if (FAILED(device->OpenSharedResource(
+            static_cast<HANDLE>(descriptor->handle),
+            IID_PPV_ARGS(&source_texture_)))) {
+      std::cerr << "Failed to open the shared handle of a GPU surface."
+                << std::endl;
+      return false;
+    }
+  } else {
+    source_texture_ = static_cast<ID3D11Texture2D*>(descriptor->handle);
+  }
+
+  EGLenum buffer_type = EGL_D3D_TEXTURE_ANGLE;
+  EGLClientBuffer buffer = source_texture_.Get();
+  if (SUCCEEDED(source_texture_.As(&keyed_mutex_))) {
+    D3D11_TEXTURE2D_DESC desc;
+    source_texture_->GetDesc(&desc);
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+    desc.CPUAccessFlags = 0;
+    desc.MiscFlags = 0;
+    if (FAILED(device->CreateTexture2D(&desc, nullptr, &copy_texture_))) {
+      std::cerr << "Failed to create the copy of a GPU surface." << std::endl;
+      ReleaseSurface();
+      return false;
+    }
+    buffer = copy_texture_.Get();
+  } else if (type_ == kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle) {
+    // The handle is imported through EGL_ANGLE_d3d_share_handle_client_buffer.
+    buffer_type = EGL_D3D_TEXTURE_2D_SHARE_HANDLE_ANGLE;
+    buffer = static_cast<EGLClientBuffer>(descriptor->handle);
+  }
+
+  const EGLint attributes[] = {EGL_WIDTH,
+                               static_cast<EGLint>(descriptor->width),
+                               EGL_HEIGHT,
+                               static_cast<EGLint>(descriptor->height),
+                               EGL_TEXTURE_TARGET,
+                               EGL_TEXTURE_2D,
+                               EGL_TEXTURE_FORMAT,
+                               EGL_TEXTURE_RGBA,
+                               EGL_NONE};
+  egl_surface_ = surface_manager_->CreateSurfaceFromHandle(buffer_type, buffer,
+                                                          attributes);
+  if (egl_surface_ == EGL_NO_SURFACE) {
+    std::cerr << "Failed to import a GPU surface into ANGLE." << std::endl;
+    ReleaseSurface();
+    return false;
+  }
+
+  if (gl_texture_ == 0) {
+    gl.glGenTextures(1, &gl_texture_);
+
+    gl.glBindTexture(GL_TEXTURE_2D, gl_texture_);
+
+    gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+
+    gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  } else {
+    gl.glBindTexture(GL_TEXTURE_2D, gl_texture_);
+  }
+  if (eglBindTexImage(surface_manager_->egl_display(), egl_surface_,
+                      EGL_BACK_BUFFER) != EGL_TRUE) {
+    std::cerr << "Failed to bind a GPU surface to a texture." << std::endl;
+    ReleaseSurface();
+    return false;
+  }
+
+  surface_handle_ = descriptor->handle;
+  surface_width_ = descriptor->width;
+  surface_height_ = descriptor->height;
+  return true;
+}
+
+bool ExternalTextureD3d::CopySurface() {
+  HRESULT result = keyed_mutex_->AcquireSync(0, kKeyedMutexTimeoutMillis);
+  if (result != S_OK) {
+    // The producer did not release the surface in time, or it was abandoned.
+    return false;
+  }
+  Microsoft::WRL::ComPtr<ID3D11Device> device;
+  Microsoft::WRL::ComPtr<ID3D11DeviceContext> context;
+  source_texture_->GetDevice(&device);
+  device->GetImmediateContext(&context);
+  context->CopySubresourceRegion(copy_texture_.Get(), 0, 0, 0, 0,
+                                 source_texture_.Get(), 0, nullptr);
+  keyed_mutex_->ReleaseSync(0);
+  return true;
+}
+
+void ExternalTextureD3d::ReleaseSurface() {
+  if (egl_surface_ != EGL_NO_SURFACE) {
+    EGLDisplay display = surface_manager_->egl_display();
+    eglReleaseTexImage(display, egl_surface_, EGL_BACK_BUFFER);
+    eglDestroySurface(display, egl_surface_);
+    egl_surface_ = EGL_NO_SURFACE;
+  }
+  copy_texture_.Reset();
+  keyed_mutex_.Reset();
+  source_texture_.Reset();
+  surface_handle_ = nullptr;
+  surface_width_ = 0;
+  surface_height_ = 0;
+}
+
+}  // namespace flutter
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
+#define FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
+
+#include <stdint.h>
+
+#include "flutter/shell/platform/common/public/flutter_texture_registrar.h"
+#include "flutter/shell/platform/windows/angle_surface_manager.h"
+#include "flutter/shell/platform/windows/external_texture.h"
+
+namespace flutter {
+
+// An external texture that is backed by a Direct3D 11 texture, which is
+// imported into ANGLE without copying it.
+//
+// Textures that were created with a keyed mutex are copied on the GPU while
+// their mutex is acquired with key 0 instead, as the engine samples them at
+// a later point that the producer cannot synchronize with.
+class ExternalTextureD3d : public ExternalTexture {
+ public:
+  ExternalTextureD3d(
+      FlutterDesktopGpuSurfaceType type,
+      const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
+      void* user_data,
+      AngleSurfaceManager* surface_manager);
+  virtual ~ExternalTextureD3d();
+
+  // |ExternalTexture|
+  bool PopulateTexture(size_t width,
+                       size_t height,
+                       FlutterOpenGLTexture* opengl_texture) override;
+
+ private:
+  // Imports the surface of |descriptor| into a pbuffer that is bound to
+  // |gl_texture_|. Returns true on success.
+  bool ImportSurface(const FlutterDesktopGpuSurfaceDescriptor* descriptor);
+
+  // Copies the surface of a keyed mutex into |copy_texture_|, waiting for the
+  // producer to release it. Returns true on success.
+  bool CopySurface();
+
+  // Releases the pbuffer and the Direct3D resources of the imported surface.
+  void ReleaseSurface();
+
+  const FlutterDesktopGpuSurfaceType type_;
+  const FlutterDesktopGpuSurfaceTextureCallback texture_callback_;
+  void* const user_data_;
+  AngleSurfaceManager* const surface_manager_;
+
+  // The handle, width and height of the imported surface.
+  void* surface_handle_ = nullptr;
+  size_t surface_width_ = 0;
+  size_t surface_height_ = 0;
+
+  // The texture of the imported surface, and its keyed mutex if it has one.
+  Microsoft::WRL::ComPtr<ID3D11Texture2D> source_texture_;
+  Microsoft::WRL::ComPtr<IDXGIKeyedMutex> keyed_mutex_;
+  // The texture that surfaces with a keyed mutex are copied into.
+  Microsoft::WRL::ComPtr<ID3D11Texture2D> copy_texture_;
+
+  EGLSurface egl_surface_ = EGL_NO_SURFACE;
+  GLuint gl_texture_ = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
@@ -8,57 +8,6 @@
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
 
-namespace {
-
-typedef void (*glGenTexturesProc)(GLsizei n, GLuint* textures);
-typedef void (*glDeleteTexturesProc)(GLsizei n, const GLuint* textures);
-typedef void (*glBindTextureProc)(GLenum target, GLuint texture);
-typedef void (*glTexParameteriProc)(GLenum target, GLenum pname, GLint param);
-typedef void (*glTexImage2DProc)(GLenum target,
-                                 GLint level,
-                                 GLint internalformat,
-                                 GLsizei width,
-                                 GLsizei height,
-                                 GLint border,
-                                 GLenum format,
-                                 GLenum type,
-                                 const void* data);
-
-// A struct containing pointers to resolved gl* functions.
-struct GlProcs {
-  glGenTexturesProc glGenTextures;
-  glDeleteTexturesProc glDeleteTextures;
-  glBindTextureProc glBindTexture;
-  glTexParameteriProc glTexParameteri;
-  glTexImage2DProc glTexImage2D;
-  bool valid;
-};
-
-static const GlProcs& GlProcs() {
-  static struct GlProcs procs = {};
-  static bool initialized = false;
-  if (!initialized) {
-    procs.glGenTextures =
-        reinterpret_cast<glGenTexturesProc>(eglGetProcAddress("glGenTextures"));
-    procs.glDeleteTextures = reinterpret_cast<glDeleteTexturesProc>(
-        eglGetProcAddress("glDeleteTextures"));
-    procs.glBindTexture =
-        reinterpret_cast<glBindTextureProc>(eglGetProcAddress("glBindTexture"));
-    procs.glTexParameteri = reinterpret_cast<glTexParameteriProc>(
-        eglGetProcAddress("glTexParameteri"));
-    procs.glTexImage2D =
-        reinterpret_cast<glTexImage2DProc>(eglGetProcAddress("glTexImage2D"));
-
-    procs.valid = procs.glGenTextures && procs.glDeleteTextures &&
-                  procs.glBindTexture && procs.glTexParameteri &&
-                  procs.glTexImage2D;
-    initialized = true;
-  }
-  return procs;
-}
-
-}  // namespace
-
 namespace flutter {
 
 struct ExternalTextureGLState {
@@ -73,7 +22,7 @@ ExternalTextureGL::ExternalTextureGL(
       user_data_(user_data) {}
 
 ExternalTextureGL::~ExternalTextureGL() {
-  const auto& gl = GlProcs();
+  const auto& gl = ResolveGlProcs();
   if (gl.valid && state_->gl_texture != 0) {
     gl.glDeleteTextures(1, &state_->gl_texture);
   }
@@ -101,7 +50,7 @@ bool ExternalTextureGL::PopulateTexture(size_t width,
 bool ExternalTextureGL::CopyPixelBuffer(size_t& width, size_t& height) {
   const FlutterDesktopPixelBuffer* pixel_buffer =
       texture_callback_(width, height, user_data_);
-  const auto& gl = GlProcs();
+  const auto& gl = ResolveGlProcs();
   if (!gl.valid || !pixel_buffer || !pixel_buffer->buffer) {
     return false;
   }
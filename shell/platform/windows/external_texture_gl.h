@@ -11,31 +11,30 @@
 
 #include "flutter/shell/platform/common/public/flutter_texture_registrar.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/windows/external_texture.h"
 
 namespace flutter {
 
 typedef struct ExternalTextureGLState ExternalTextureGLState;
 
-// An abstraction of an OpenGL texture.
-class ExternalTextureGL {
+// An abstraction of an OpenGL texture that is uploaded from a pixel buffer.
+class ExternalTextureGL : public ExternalTexture {
  public:
   ExternalTextureGL(FlutterDesktopPixelBufferTextureCallback texture_callback,
                     void* user_data);
 
   virtual ~ExternalTextureGL();
 
-  // Returns the unique id of this texture.
-  int64_t texture_id() { return reinterpret_cast<int64_t>(this); }
-
   void MarkFrameAvailable();
 
+  // |ExternalTexture|
   // Attempts to populate the specified |opengl_texture| with texture details
   // such as the name, width, height and the pixel format upon successfully
   // copying the buffer provided by |texture_callback_|. See |CopyPixelBuffer|.
   // Returns true on success or false if the pixel buffer could not be copied.
   bool PopulateTexture(size_t width,
                        size_t height,
-                       FlutterOpenGLTexture* opengl_texture);
+                       FlutterOpenGLTexture* opengl_texture) override;
 
  private:
   // Attempts to copy the pixel buffer returned by |texture_callback_| to
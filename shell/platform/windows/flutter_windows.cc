@@ -81,6 +81,12 @@ void FlutterDesktopViewControllerForceRedraw(
   controller->view->ForceRedraw();
 }
 
+void FlutterDesktopViewControllerSetNonBlockingResize(
+    FlutterDesktopViewControllerRef controller,
+    bool non_blocking_resize) {
+  controller->view->SetNonBlockingResize(non_blocking_resize);
+}
+
 FlutterDesktopEngineRef FlutterDesktopEngineCreate(
     const FlutterDesktopEngineProperties* engine_properties) {
   flutter::FlutterProjectBundle project(*engine_properties);
@@ -195,6 +201,24 @@ void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
                                                               user_data);
 }
 
+FlutterDesktopTaskQueueRef FlutterDesktopMessengerCreateTaskQueue(
+    FlutterDesktopMessengerRef messenger) {
+  return reinterpret_cast<FlutterDesktopTaskQueueRef>(
+      messenger->engine->message_dispatcher()->CreateTaskQueue());
+}
+
+void FlutterDesktopMessengerSetCallbackOnTaskQueue(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageCallback callback,
+    void* user_data,
+    FlutterDesktopTaskQueueRef task_queue) {
+  messenger->engine->message_dispatcher()->SetMessageCallback(
+      channel, callback, user_data,
+      reinterpret_cast<flutter::IncomingMessageDispatcher::TaskQueue*>(
+          task_queue));
+}
+
 FlutterDesktopTextureRegistrarRef FlutterDesktopRegistrarGetTextureRegistrar(
     FlutterDesktopPluginRegistrarRef registrar) {
   return HandleForTextureRegistrar(registrar->engine->texture_registrar());
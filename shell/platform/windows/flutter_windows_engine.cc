@@ -169,6 +169,19 @@ FlutterWindowsEngine::FlutterWindowsEngine(const FlutterProjectBundle& project)
 #ifndef WINUWP
   window_proc_delegate_manager_ =
       std::make_unique<WindowProcDelegateManagerWin32>();
+  // The engine must be given vsync batons on the platform thread.
+  vsync_waiter_ = std::make_unique<VsyncWaiterWin32>(
+      embedder_api_.GetCurrentTime,
+      [this](intptr_t baton, uint64_t frame_start_time_nanos,
+             uint64_t frame_target_time_nanos) {
+        task_runner_->PostTask([this, baton, frame_start_time_nanos,
+                                frame_target_time_nanos]() {
+          if (engine_) {
+            embedder_api_.OnVsync(engine_, baton, frame_start_time_nanos,
+                                  frame_target_time_nanos);
+          }
+        });
+      });
 #endif
 
   // Set up internal channels.
@@ -256,6 +269,12 @@ bool FlutterWindowsEngine::RunWithEntrypoint(const char* entrypoint) {
   };
 
   args.custom_task_runners = &custom_task_runners;
+#ifndef WINUWP
+  args.vsync_callback = [](void* user_data, intptr_t baton) -> void {
+    auto host = static_cast<FlutterWindowsEngine*>(user_data);
+    host->vsync_waiter_->AwaitVsync(baton);
+  };
+#endif
 
   if (aot_data_) {
     args.aot_data = aot_data_.get();
@@ -286,6 +305,17 @@ bool FlutterWindowsEngine::Stop() {
     if (plugin_registrar_destruction_callback_) {
       plugin_registrar_destruction_callback_(plugin_registrar_.get());
     }
+#ifndef WINUWP
+    // All batons must be returned to the engine before it shuts down.
+    std::optional<intptr_t> baton = vsync_waiter_->Stop();
+    if (baton) {
+      uint64_t now = embedder_api_.GetCurrentTime();
+      embedder_api_.OnVsync(engine_, *baton, now,
+                            now + vsync_waiter_->GetRefreshPeriodNanos());
+    }
+#endif
+    // The handlers on the task queues may still respond to their messages.
+    message_dispatcher_->StopTaskQueues();
     FlutterEngineResult result = embedder_api_.Shutdown(engine_);
     engine_ = nullptr;
     return (result == kSuccess);
@@ -23,6 +23,7 @@
 #include "third_party/rapidjson/include/rapidjson/document.h"
 
 #ifndef WINUWP
+#include "flutter/shell/platform/windows/vsync_waiter_win32.h"  // nogncheck
 #include "flutter/shell/platform/windows/window_proc_delegate_manager_win32.h"  // nogncheck
 #endif
 
@@ -198,6 +199,10 @@ class FlutterWindowsEngine {
 #ifndef WINUWP
   // The manager for WindowProc delegate registration and callbacks.
   std::unique_ptr<WindowProcDelegateManagerWin32> window_proc_delegate_manager_;
+
+  // The waiter that paces frames with the compositions of the desktop window
+  // manager.
+  std::unique_ptr<VsyncWaiterWin32> vsync_waiter_;
 #endif
 };
 
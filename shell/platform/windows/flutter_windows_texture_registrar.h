@@ -9,7 +9,7 @@
 #include <mutex>
 #include <unordered_map>
 
-#include "flutter/shell/platform/windows/external_texture_gl.h"
+#include "flutter/shell/platform/windows/external_texture.h"
 
 namespace flutter {
 
@@ -42,10 +42,14 @@ class FlutterWindowsTextureRegistrar {
                        FlutterOpenGLTexture* texture);
 
  private:
+  // Stores |texture| and registers it with the engine.
+  // Returns the texture id.
+  int64_t EmplaceTexture(std::unique_ptr<ExternalTexture> texture);
+
   FlutterWindowsEngine* engine_ = nullptr;
 
   // All registered textures, keyed by their IDs.
-  std::unordered_map<int64_t, std::unique_ptr<flutter::ExternalTextureGL>>
+  std::unordered_map<int64_t, std::unique_ptr<flutter::ExternalTexture>>
       textures_;
   std::mutex map_mutex_;
 };
@@ -102,6 +102,32 @@ TEST(FlutterWindowsTextureRegistrarTest, RegisterUnknownTextureType) {
   EXPECT_EQ(texture_id, -1);
 }
 
+TEST(FlutterWindowsTextureRegistrarTest, RegisterInvalidGpuSurfaceTexture) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  EngineModifier modifier(engine.get());
+
+  FlutterWindowsTextureRegistrar registrar(engine.get());
+
+  FlutterDesktopTextureInfo texture_info = {};
+  texture_info.type = kFlutterDesktopGpuSurfaceTexture;
+  texture_info.gpu_surface_config.struct_size =
+      sizeof(FlutterDesktopGpuSurfaceTextureConfig);
+  texture_info.gpu_surface_config.type =
+      kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle;
+
+  // Textures without a callback are rejected.
+  EXPECT_EQ(registrar.RegisterTexture(&texture_info), -1);
+
+  // Textures of unknown surface types are rejected.
+  texture_info.gpu_surface_config.callback =
+      [](size_t width, size_t height,
+         void* user_data) -> const FlutterDesktopGpuSurfaceDescriptor* {
+    return nullptr;
+  };
+  texture_info.gpu_surface_config.type = kFlutterDesktopGpuSurfaceTypeNone;
+  EXPECT_EQ(registrar.RegisterTexture(&texture_info), -1);
+}
+
 TEST(FlutterWindowsTextureRegistrarTest, PopulateInvalidTexture) {
   std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
 
@@ -109,18 +109,24 @@ uint32_t FlutterWindowsView::GetFrameBufferId(size_t width, size_t height) {
   // Called on an engine-controlled (non-platform) thread.
   std::unique_lock<std::mutex> lock(resize_mutex_);
 
-  if (resize_status_ != ResizeState::kResizeStarted) {
-    return kWindowFrameBufferID;
-  }
-
-  if (resize_target_width_ == width && resize_target_height_ == height) {
-    // Platform thread is blocked for the entire duration until the
-    // resize_status_ is set to kDone.
+  if (resize_status_ == ResizeState::kResizeStarted &&
+      resize_target_width_ == width && resize_target_height_ == height) {
+    // Unless resizes do not block, the platform thread is blocked for the
+    // entire duration until the resize_status_ is set to kDone.
     engine_->surface_manager()->ResizeSurface(GetRenderTarget(), width, height);
     engine_->surface_manager()->MakeCurrent();
     resize_status_ = ResizeState::kFrameGenerated;
   }
 
+  if (non_blocking_resize_) {
+    // The window may be resized again before the frame is swapped.
+    EGLint surface_width, surface_height;
+    engine_->surface_manager()->GetSurfaceDimensions(&surface_width,
+                                                     &surface_height);
+    frame_matches_surface_ = static_cast<size_t>(surface_width) == width &&
+                             static_cast<size_t>(surface_height) == height;
+  }
+
   return kWindowFrameBufferID;
 }
 
@@ -134,6 +140,11 @@ void FlutterWindowsView::ForceRedraw() {
   }
 }
 
+void FlutterWindowsView::SetNonBlockingResize(bool non_blocking_resize) {
+  std::unique_lock<std::mutex> lock(resize_mutex_);
+  non_blocking_resize_ = non_blocking_resize;
+}
+
 void FlutterWindowsView::OnWindowSizeChanged(size_t width, size_t height) {
   // Called on the platform thread.
   std::unique_lock<std::mutex> lock(resize_mutex_);
@@ -153,11 +164,19 @@ void FlutterWindowsView::OnWindowSizeChanged(size_t width, size_t height) {
     resize_status_ = ResizeState::kResizeStarted;
     resize_target_width_ = width;
     resize_target_height_ = height;
+  } else if (non_blocking_resize_ &&
+             resize_status_ == ResizeState::kResizeStarted) {
+    // The window was resized back to the size of the surface before a frame
+    // at the size it was resized to in between was generated.
+    resize_status_ = ResizeState::kDone;
   }
 
   SendWindowMetrics(width, height, binding_handler_->GetDpiScale());
 
-  if (surface_will_update) {
+  // Without blocking, sizes the window is resized to before the engine
+  // produces a frame are coalesced, as only a frame at the last one resizes
+  // the surface.
+  if (surface_will_update && !non_blocking_resize_) {
     // Block the platform thread until:
     //   1. GetFrameBufferId is called with the right frame size.
     //   2. Any pending SwapBuffers calls have been invoked.
@@ -447,6 +466,12 @@ bool FlutterWindowsView::SwapBuffers() {
     // right dimensions has been generated. This is marked with
     // kFrameGenerated resize status.
     case ResizeState::kResizeStarted:
+      // Without blocking, frames that fit the surface are presented until the
+      // frame with the right dimensions has been generated. This includes a
+      // frame that resized the surface before the window was resized again.
+      if (non_blocking_resize_ && frame_matches_surface_) {
+        return engine_->surface_manager()->SwapBuffers();
+      }
       return false;
     case ResizeState::kFrameGenerated: {
       bool swap_buffers_result = engine_->surface_manager()->SwapBuffers();
@@ -65,6 +65,16 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate,
   // Tells the engine to generate a new frame
   void ForceRedraw();
 
+  // Sets whether window resizes block the platform thread until the engine
+  // has presented a frame at the new size, which is the default.
+  //
+  // When resizes do not block, the window keeps showing the last frame,
+  // stretched to the window by the swapchain, until a frame at the new size is
+  // presented. Frames at the previous size are still presented in the
+  // meantime, and frames at sizes the window has already been resized past are
+  // dropped.
+  void SetNonBlockingResize(bool non_blocking_resize);
+
   // Callbacks for clearing context, settings context and swapping buffers,
   // these are typically called on an engine-controlled (non-platform) thread.
   bool ClearContext();
@@ -304,7 +314,8 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate,
   std::condition_variable resize_cv_;
 
   // Indicates the state of a window resize event. Platform thread will be
-  // blocked while this is not done. Guarded by resize_mutex_.
+  // blocked while this is not done, unless non_blocking_resize_ is set.
+  // Guarded by resize_mutex_.
   ResizeState resize_status_ = ResizeState::kDone;
 
   // Target for the window width. Valid when resize_pending_ is set. Guarded by
@@ -314,6 +325,14 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate,
   // Target for the window width. Valid when resize_pending_ is set. Guarded by
   // resize_mutex_.
   size_t resize_target_height_ = 0;
+
+  // Whether resize events do not block the platform thread. Guarded by
+  // resize_mutex_.
+  bool non_blocking_resize_ = false;
+
+  // Whether the frame being generated has the size of the surface. Guarded by
+  // resize_mutex_.
+  bool frame_matches_surface_ = true;
 };
 
 }  // namespace flutter
@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/flutter_windows_view.h"
+
+#include <memory>
+
+#include "flutter/shell/platform/windows/flutter_windows_engine.h"
+#include "flutter/shell/platform/windows/testing/engine_modifier.h"
+#include "flutter/shell/platform/windows/testing/mock_angle_surface_manager.h"
+#include "flutter/shell/platform/windows/testing/mock_window_binding_handler.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace flutter {
+namespace testing {
+
+namespace {
+// Returns an engine instance configured with dummy project path values.
+std::unique_ptr<FlutterWindowsEngine> GetTestEngine() {
+  FlutterDesktopEngineProperties properties = {};
+  properties.assets_path = L"C:\\foo\\flutter_assets";
+  properties.icu_data_path = L"C:\\foo\\icudtl.dat";
+  properties.aot_library_path = L"C:\\foo\\aot.so";
+  FlutterProjectBundle project(properties);
+  return std::make_unique<FlutterWindowsEngine>(project);
+}
+
+// A surface manager whose surface is resized by |ResizeSurface| and has the
+// given initial size.
+NiceMock<MockAngleSurfaceManager>* CreateSurfaceManager(EGLint width,
+                                                        EGLint height) {
+  auto surface_manager = new NiceMock<MockAngleSurfaceManager>();
+  auto size = std::make_shared<std::pair<EGLint, EGLint>>(width, height);
+  ON_CALL(*surface_manager, GetSurfaceDimensions(_, _))
+      .WillByDefault(Invoke([size](EGLint* width, EGLint* height) {
+        *width = size->first;
+        *height = size->second;
+      }));
+  ON_CALL(*surface_manager, ResizeSurface(_, _, _))
+      .WillByDefault(
+          Invoke([size](WindowsRenderTarget*, EGLint width, EGLint height) {
+            *size = {width, height};
+          }));
+  ON_CALL(*surface_manager, MakeCurrent()).WillByDefault(Return(true));
+  ON_CALL(*surface_manager, SwapBuffers()).WillByDefault(Return(EGL_TRUE));
+  return surface_manager;
+}
+}  // namespace
+
+// Tests that, without blocking, only the frame at the size the window was last
+// resized to resizes the surface.
+TEST(FlutterWindowsViewTest, NonBlockingResizesAreCoalesced) {
+  auto window_binding_handler =
+      std::make_unique<NiceMock<MockWindowBindingHandler>>();
+  MockWindowBindingHandler* binding_handler = window_binding_handler.get();
+  FlutterWindowsView view(std::move(window_binding_handler));
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  NiceMock<MockAngleSurfaceManager>* surface_manager =
+      CreateSurfaceManager(100, 100);
+  EngineModifier modifier(engine.get());
+  modifier.SetSurfaceManager(surface_manager);
+  view.SetEngine(std::move(engine));
+  view.SetNonBlockingResize(true);
+
+  // These return without waiting for a frame, or the test would hang.
+  view.OnWindowSizeChanged(200, 200);
+  view.OnWindowSizeChanged(300, 300);
+  view.OnWindowSizeChanged(400, 400);
+
+  EXPECT_CALL(*surface_manager, ResizeSurface(_, _, _)).Times(0);
+  EXPECT_CALL(*surface_manager, ResizeSurface(_, 400, 400)).Times(1);
+  EXPECT_CALL(*binding_handler, OnWindowResized()).Times(1);
+
+  view.GetFrameBufferId(200, 200);
+  EXPECT_FALSE(view.SwapBuffers());
+  view.GetFrameBufferId(300, 300);
+  EXPECT_FALSE(view.SwapBuffers());
+  view.GetFrameBufferId(400, 400);
+  EXPECT_TRUE(view.SwapBuffers());
+}
+
+// Tests that, without blocking, a frame that fits the surface is presented
+// while the frame at the size the window was resized to is pending.
+TEST(FlutterWindowsViewTest, NonBlockingResizePresentsFrameMatchingSurface) {
+  auto window_binding_handler =
+      std::make_unique<NiceMock<MockWindowBindingHandler>>();
+  MockWindowBindingHandler* binding_handler = window_binding_handler.get();
+  FlutterWindowsView view(std::move(window_binding_handler));
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  NiceMock<MockAngleSurfaceManager>* surface_manager =
+      CreateSurfaceManager(100, 100);
+  EngineModifier modifier(engine.get());
+  modifier.SetSurfaceManager(surface_manager);
+  view.SetEngine(std::move(engine));
+  view.SetNonBlockingResize(true);
+
+  view.OnWindowSizeChanged(200, 200);
+
+  EXPECT_CALL(*surface_manager, ResizeSurface(_, _, _)).Times(0);
+  EXPECT_CALL(*surface_manager, SwapBuffers()).WillOnce(Return(EGL_TRUE));
+  EXPECT_CALL(*binding_handler, OnWindowResized()).Times(0);
+
+  // A frame at the size of the surface, produced before the resize was seen.
+  view.GetFrameBufferId(100, 100);
+  EXPECT_TRUE(view.SwapBuffers());
+}
+
+// Tests that, without blocking, a frame at a size the window has already been
+// resized past is dropped rather than blocking either thread.
+TEST(FlutterWindowsViewTest, NonBlockingResizeDropsStaleFrame) {
+  auto window_binding_handler =
+      std::make_unique<NiceMock<MockWindowBindingHandler>>();
+  MockWindowBindingHandler* binding_handler = window_binding_handler.get();
+  FlutterWindowsView view(std::move(window_binding_handler));
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  NiceMock<MockAngleSurfaceManager>* surface_manager =
+      CreateSurfaceManager(100, 100);
+  EngineModifier modifier(engine.get());
+  modifier.SetSurfaceManager(surface_manager);
+  view.SetEngine(std::move(engine));
+  view.SetNonBlockingResize(true);
+
+  view.OnWindowSizeChanged(200, 200);
+  view.OnWindowSizeChanged(300, 300);
+
+  {
+    ::testing::InSequence in_sequence;
+    // The stale frame neither resizes the surface nor is presented.
+    EXPECT_CALL(*surface_manager, ResizeSurface(_, 300, 300)).Times(1);
+    EXPECT_CALL(*surface_manager, SwapBuffers()).WillOnce(Return(EGL_TRUE));
+    EXPECT_CALL(*binding_handler, OnWindowResized()).Times(1);
+  }
+
+  view.GetFrameBufferId(200, 200);
+  EXPECT_FALSE(view.SwapBuffers());
+
+  // The frame at the current size is still presented afterwards.
+  view.GetFrameBufferId(300, 300);
+  EXPECT_TRUE(view.SwapBuffers());
+
+  // Later resizes are not blocked by the dropped frame either.
+  view.OnWindowSizeChanged(400, 400);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -114,6 +114,17 @@ FlutterDesktopViewControllerGetView(FlutterDesktopViewControllerRef controller);
 FLUTTER_EXPORT void FlutterDesktopViewControllerForceRedraw(
     FlutterDesktopViewControllerRef controller);
 
+// Sets whether resizing the window blocks the platform thread until the engine
+// has presented a frame at the new size, which is the default.
+//
+// When resizing does not block, the window keeps showing the last frame,
+// stretched to the window, until a frame at the new size is presented. This
+// keeps dragging the window edges smooth when frames take long to produce, at
+// the cost of briefly showing stretched content.
+FLUTTER_EXPORT void FlutterDesktopViewControllerSetNonBlockingResize(
+    FlutterDesktopViewControllerRef controller,
+    bool non_blocking_resize);
+
 #ifndef WINUWP
 // Allows the Flutter engine and any interested plugins an opportunity to
 // handle the given message.
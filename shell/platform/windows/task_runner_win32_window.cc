@@ -7,6 +7,11 @@
 #include <algorithm>
 #include <iostream>
 
+// Older SDKs don't define the flag, though the system may support it.
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 namespace flutter {
 
 TaskRunnerWin32Window::TaskRunnerWin32Window() {
@@ -29,9 +34,12 @@ TaskRunnerWin32Window::TaskRunnerWin32Window() {
     OutputDebugString(message);
     LocalFree(message);
   }
+
+  CreateHighResolutionTimer();
 }
 
 TaskRunnerWin32Window::~TaskRunnerWin32Window() {
+  DestroyHighResolutionTimer();
   if (window_handle_) {
     DestroyWindow(window_handle_);
     window_handle_ = nullptr;
@@ -83,6 +91,24 @@ void TaskRunnerWin32Window::ProcessTasks() {
 }
 
 void TaskRunnerWin32Window::SetTimer(std::chrono::nanoseconds when) {
+  if (high_resolution_timer_) {
+    if (when == std::chrono::nanoseconds::max()) {
+      SetThreadpoolWait(timer_wait_, nullptr, nullptr);
+      CancelWaitableTimer(high_resolution_timer_);
+      return;
+    }
+    // Negative due times are relative, in units of 100 nanoseconds.
+    LARGE_INTEGER due_time;
+    due_time.QuadPart = -std::max<LONGLONG>(when.count() / 100, 1);
+    if (SetWaitableTimer(high_resolution_timer_, &due_time, 0, nullptr,
+                         nullptr, FALSE)) {
+      // Waits are one-shot, so the wait is set again every time the timer is.
+      SetThreadpoolWait(timer_wait_, high_resolution_timer_, nullptr);
+      return;
+    }
+    std::cerr << "Failed to set high resolution timer." << std::endl;
+  }
+
   if (when == std::chrono::nanoseconds::max()) {
     KillTimer(window_handle_, 0);
   } else {
@@ -91,6 +117,50 @@ void TaskRunnerWin32Window::SetTimer(std::chrono::nanoseconds when) {
   }
 }
 
+void TaskRunnerWin32Window::CreateHighResolutionTimer() {
+  if (!window_handle_) {
+    return;
+  }
+  // Supported since Windows 10, version 1803.
+  high_resolution_timer_ = CreateWaitableTimerExW(
+      nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+      TIMER_ALL_ACCESS);
+  if (!high_resolution_timer_) {
+    return;
+  }
+  timer_wait_ =
+      CreateThreadpoolWait(&OnHighResolutionTimerFired, this, nullptr);
+  if (!timer_wait_) {
+    CloseHandle(high_resolution_timer_);
+    high_resolution_timer_ = nullptr;
+  }
+}
+
+void TaskRunnerWin32Window::DestroyHighResolutionTimer() {
+  if (timer_wait_) {
+    // Cancels the pending wait and waits for a running callback to finish, as
+    // it uses the window.
+    SetThreadpoolWait(timer_wait_, nullptr, nullptr);
+    WaitForThreadpoolWaitCallbacks(timer_wait_, TRUE);
+    CloseThreadpoolWait(timer_wait_);
+    timer_wait_ = nullptr;
+  }
+  if (high_resolution_timer_) {
+    CloseHandle(high_resolution_timer_);
+    high_resolution_timer_ = nullptr;
+  }
+}
+
+void CALLBACK TaskRunnerWin32Window::OnHighResolutionTimerFired(
+    PTP_CALLBACK_INSTANCE instance,
+    PVOID context,
+    PTP_WAIT wait,
+    TP_WAIT_RESULT wait_result) {
+  // Runs on a thread pool thread, so the tasks are processed by posting a
+  // message to the main thread like |WakeUp| does.
+  static_cast<TaskRunnerWin32Window*>(context)->WakeUp();
+}
+
 WNDCLASS TaskRunnerWin32Window::RegisterWindowClass() {
   window_class_name_ = L"FlutterTaskRunnerWindow";
 
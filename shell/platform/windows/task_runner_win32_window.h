@@ -15,6 +15,14 @@
 namespace flutter {
 
 // Hidden HWND responsible for processing flutter tasks on main thread
+//
+// Delayed tasks are scheduled with a high resolution waitable timer where
+// available, which fires within a fraction of a millisecond instead of at the
+// default system timer resolution of 15.6 ms, without raising the timer
+// resolution of the whole system with timeBeginPeriod. A thread pool wait on
+// the timer posts a message to the window once it fires, so tasks still run
+// in the message loop of the main thread. On versions of Windows without high
+// resolution waitable timers, a window timer is used instead.
 class TaskRunnerWin32Window {
  public:
   class Delegate {
@@ -39,6 +47,18 @@ class TaskRunnerWin32Window {
 
   void SetTimer(std::chrono::nanoseconds when);
 
+  // Creates |high_resolution_timer_| and |timer_wait_|, or neither if high
+  // resolution timers are not supported.
+  void CreateHighResolutionTimer();
+
+  void DestroyHighResolutionTimer();
+
+  static void CALLBACK
+  OnHighResolutionTimerFired(PTP_CALLBACK_INSTANCE instance,
+                             PVOID context,
+                             PTP_WAIT wait,
+                             TP_WAIT_RESULT wait_result);
+
   WNDCLASS RegisterWindowClass();
 
   LRESULT
@@ -54,6 +74,8 @@ class TaskRunnerWin32Window {
   HWND window_handle_;
   std::wstring window_class_name_;
   std::vector<Delegate*> delegates_;
+  HANDLE high_resolution_timer_ = nullptr;
+  PTP_WAIT timer_wait_ = nullptr;
 };
 }  // namespace flutter
 
@@ -0,0 +1,32 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_TESTING_MOCK_ANGLE_SURFACE_MANAGER_H_
+#define FLUTTER_SHELL_PLATFORM_WINDOWS_TESTING_MOCK_ANGLE_SURFACE_MANAGER_H_
+
+#include "flutter/shell/platform/windows/angle_surface_manager.h"
+#include "gmock/gmock.h"
+
+namespace flutter {
+namespace testing {
+
+/// Mock for the |AngleSurfaceManager| base class.
+class MockAngleSurfaceManager : public AngleSurfaceManager {
+ public:
+  MockAngleSurfaceManager() {}
+
+  // Prevent copying.
+  MockAngleSurfaceManager(MockAngleSurfaceManager const&) = delete;
+  MockAngleSurfaceManager& operator=(MockAngleSurfaceManager const&) = delete;
+
+  MOCK_METHOD3(ResizeSurface, void(WindowsRenderTarget*, EGLint, EGLint));
+  MOCK_METHOD2(GetSurfaceDimensions, void(EGLint*, EGLint*));
+  MOCK_METHOD0(MakeCurrent, bool());
+  MOCK_METHOD0(SwapBuffers, EGLBoolean());
+};
+
+}  // namespace testing
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_WINDOWS_TESTING_MOCK_ANGLE_SURFACE_MANAGER_H_
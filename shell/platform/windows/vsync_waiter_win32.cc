@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/vsync_waiter_win32.h"
+
+#include <dwmapi.h>
+
+namespace flutter {
+
+namespace {
+
+// The refresh period that is assumed when the desktop window manager does not
+// report one.
+constexpr uint64_t kDefaultRefreshPeriodNanos = 1000000000 / 60;
+
+}  // namespace
+
+VsyncWaiterWin32::VsyncWaiterWin32(CurrentTimeProc get_current_time,
+                                   VsyncCallback on_vsync)
+    : get_current_time_(get_current_time),
+      on_vsync_(std::move(on_vsync)),
+      thread_(&VsyncWaiterWin32::ThreadMain, this) {}
+
+VsyncWaiterWin32::~VsyncWaiterWin32() {
+  Stop();
+}
+
+void VsyncWaiterWin32::AwaitVsync(intptr_t baton) {
+  {
+    std::scoped_lock lock(mutex_);
+    pending_baton_ = baton;
+  }
+  pending_baton_changed_.notify_one();
+}
+
+std::optional<intptr_t> VsyncWaiterWin32::Stop() {
+  std::optional<intptr_t> baton;
+  {
+    std::scoped_lock lock(mutex_);
+    stopped_ = true;
+    baton = pending_baton_;
+    pending_baton_.reset();
+  }
+  pending_baton_changed_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  return baton;
+}
+
+uint64_t VsyncWaiterWin32::GetRefreshPeriodNanos() const {
+  DWM_TIMING_INFO timing_info = {};
+  timing_info.cbSize = sizeof(timing_info);
+  LARGE_INTEGER frequency;
+  if (FAILED(::DwmGetCompositionTimingInfo(nullptr, &timing_info)) ||
+      timing_info.qpcRefreshPeriod == 0 ||
+      !::QueryPerformanceFrequency(&frequency)) {
+    return kDefaultRefreshPeriodNanos;
+  }
+  return timing_info.qpcRefreshPeriod * 1000000000 / frequency.QuadPart;
+}
+
+void VsyncWaiterWin32::ThreadMain() {
+  while (true) {
+    {
+      std::unique_lock lock(mutex_);
+      pending_baton_changed_.wait(
+          lock, [this] { return stopped_ || pending_baton_.has_value(); });
+      if (stopped_) {
+        return;
+      }
+    }
+
+    // Blocks until the next composition. Fails when composition is disabled,
+    // in which case the frame starts a refresh period from now.
+    const uint64_t refresh_period = GetRefreshPeriodNanos();
+    if (FAILED(::DwmFlush())) {
+      ::Sleep(static_cast<DWORD>(refresh_period / 1000000));
+    }
+    const uint64_t frame_start_time = get_current_time_();
+
+    std::optional<intptr_t> baton;
+    {
+      std::scoped_lock lock(mutex_);
+      if (stopped_) {
+        return;
+      }
+      baton = pending_baton_;
+      pending_baton_.reset();
+    }
+    if (baton) {
+      on_vsync_(*baton, frame_start_time, frame_start_time + refresh_period);
+    }
+  }
+}
+
+}  // namespace flutter
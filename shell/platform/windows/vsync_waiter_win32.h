@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_VSYNC_WAITER_WIN32_H_
+#define FLUTTER_SHELL_PLATFORM_WINDOWS_VSYNC_WAITER_WIN32_H_
+
+#include <windows.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "flutter/shell/platform/windows/task_runner.h"
+
+namespace flutter {
+
+// Delivers the vsync batons of the engine from a thread that waits for the
+// compositions of the desktop window manager, which flip-model swapchains
+// are presented with.
+//
+// Without a waiter, the engine paces frames with a timer that is not aligned
+// with the compositions, which adds up to a frame of latency.
+class VsyncWaiterWin32 {
+ public:
+  // Called on the vsync thread with a baton and the start and target times of
+  // its frame, in the timebase of |get_current_time|.
+  using VsyncCallback = std::function<void(intptr_t baton,
+                                           uint64_t frame_start_time_nanos,
+                                           uint64_t frame_target_time_nanos)>;
+
+  VsyncWaiterWin32(CurrentTimeProc get_current_time, VsyncCallback on_vsync);
+
+  // Stops the vsync thread if |Stop| was not called.
+  ~VsyncWaiterWin32();
+
+  // Prevent copying.
+  VsyncWaiterWin32(VsyncWaiterWin32 const&) = delete;
+  VsyncWaiterWin32& operator=(VsyncWaiterWin32 const&) = delete;
+
+  // Delivers |baton| at the next composition. The engine waits for at most
+  // one vsync at a time.
+  void AwaitVsync(intptr_t baton);
+
+  // Stops the vsync thread, and returns the baton that was not delivered yet,
+  // if any, so that it can be returned to the engine before it shuts down.
+  std::optional<intptr_t> Stop();
+
+  // The refresh period of the compositions, in nanoseconds.
+  uint64_t GetRefreshPeriodNanos() const;
+
+ private:
+  void ThreadMain();
+
+  CurrentTimeProc get_current_time_;
+  VsyncCallback on_vsync_;
+
+  std::mutex mutex_;
+  std::condition_variable pending_baton_changed_;
+  std::optional<intptr_t> pending_baton_;
+  bool stopped_ = false;
+
+  std::thread thread_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_WINDOWS_VSYNC_WAITER_WIN32_H_
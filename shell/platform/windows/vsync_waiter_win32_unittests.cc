@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/vsync_waiter_win32.h"
+
+#include <atomic>
+#include <chrono>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+uint64_t MockGetCurrentTime() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+}  // namespace
+
+TEST(VsyncWaiterWin32Test, DeliversBatonAtNextComposition) {
+  std::mutex mutex;
+  std::condition_variable delivered;
+  std::optional<intptr_t> delivered_baton;
+  uint64_t frame_start_time = 0;
+  uint64_t frame_target_time = 0;
+  VsyncWaiterWin32 waiter(MockGetCurrentTime,
+                          [&](intptr_t baton, uint64_t start, uint64_t target) {
+                            std::scoped_lock lock(mutex);
+                            delivered_baton = baton;
+                            frame_start_time = start;
+                            frame_target_time = target;
+                            delivered.notify_one();
+                          });
+
+  waiter.AwaitVsync(42);
+  std::unique_lock lock(mutex);
+  delivered.wait(lock, [&] { return delivered_baton.has_value(); });
+
+  EXPECT_EQ(*delivered_baton, 42);
+  EXPECT_GT(frame_target_time, frame_start_time);
+}
+
+TEST(VsyncWaiterWin32Test, StopReturnsPendingBaton) {
+  std::atomic<int> delivered_count = 0;
+  VsyncWaiterWin32 waiter(
+      MockGetCurrentTime,
+      [&](intptr_t baton, uint64_t start, uint64_t target) {
+        delivered_count++;
+      });
+
+  waiter.AwaitVsync(7);
+  std::optional<intptr_t> baton = waiter.Stop();
+
+  // The baton is either delivered or returned, never both.
+  EXPECT_EQ(baton.has_value() ? 1 : 0, 1 - delivered_count);
+  EXPECT_FALSE(waiter.Stop().has_value());
+}
+
+}  // namespace testing
+}  // namespace flutter
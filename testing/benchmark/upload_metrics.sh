@@ -12,5 +12,6 @@ set -ex
 pub get
 dart bin/parse_and_send.dart ../../../out/host_release/txt_benchmarks.json
 dart bin/parse_and_send.dart ../../../out/host_release/fml_benchmarks.json
+dart bin/parse_and_send.dart ../../../out/host_release/flow_benchmarks.json
 dart bin/parse_and_send.dart ../../../out/host_release/shell_benchmarks.json
 dart bin/parse_and_send.dart ../../../out/host_release/ui_benchmarks.json
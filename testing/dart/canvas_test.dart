@@ -269,4 +269,80 @@ void main() {
     expectArgumentError(() => canvas.drawRawAtlas(image, Float32List(0), Float32List(4), null, null, rect, paint));
     expectArgumentError(() => canvas.drawRawAtlas(image, Float32List(4), Float32List(4), Int32List(2), BlendMode.src, rect, paint));
   });
+
+  test('drawBatch draws the same as the individual draw calls', () async {
+    Future<Image> draw(void Function(Canvas canvas, Paint paint) callback) {
+      final PictureRecorder recorder = PictureRecorder();
+      final Canvas canvas = Canvas(recorder);
+      final Paint paint = Paint()
+        ..isAntiAlias = false
+        ..color = const Color(0xFF0000FF);
+      callback(canvas, paint);
+      return recorder.endRecording().toImage(100, 100);
+    }
+
+    final Image individual = await draw((Canvas canvas, Paint paint) {
+      canvas.drawRect(const Rect.fromLTWH(10, 10, 20, 20), paint);
+      paint.color = const Color(0xFF00FF00);
+      canvas.drawOval(const Rect.fromLTWH(40, 10, 20, 30), paint);
+      canvas.drawCircle(const Offset(80, 20), 10, paint);
+      paint
+        ..style = PaintingStyle.stroke
+        ..strokeWidth = 4;
+      canvas.drawLine(const Offset(10, 60), const Offset(90, 90), paint);
+    });
+    final Image batched = await draw((Canvas canvas, Paint paint) {
+      final DrawBatch batch = DrawBatch()
+        ..drawRect(const Rect.fromLTWH(10, 10, 20, 20))
+        ..setColor(const Color(0xFF00FF00))
+        ..drawOval(const Rect.fromLTWH(40, 10, 20, 30))
+        ..drawCircle(const Offset(80, 20), 10)
+        ..setStrokeWidth(4);
+      canvas.drawBatch(batch, paint);
+      batch
+        ..clear()
+        ..setColor(const Color(0xFF00FF00))
+        ..setStrokeWidth(4)
+        ..drawLine(const Offset(10, 60), const Offset(90, 90));
+      expect(batch.length, 9);
+      canvas.drawBatch(batch, paint..style = PaintingStyle.stroke);
+    });
+
+    expect(await fuzzyCompareImages(individual, batched), true);
+  });
+
+  test('Vertices.raw draws the same as Vertices', () async {
+    Future<Image> draw(Vertices vertices) {
+      final PictureRecorder recorder = PictureRecorder();
+      final Canvas canvas = Canvas(recorder);
+      canvas.drawVertices(vertices, BlendMode.src, Paint());
+      return recorder.endRecording().toImage(100, 100);
+    }
+
+    const List<Offset> positions = <Offset>[
+      Offset(10, 10), Offset(90, 10), Offset(10, 90), Offset(90, 90),
+    ];
+    const List<Color> colors = <Color>[
+      Color(0xFFFF0000), Color(0xFF00FF00), Color(0xFF0000FF), Color(0xFFFFFFFF),
+    ];
+    const List<int> indices = <int>[0, 1, 2, 1, 2, 3];
+    final Image fromLists = await draw(Vertices(
+      VertexMode.triangles,
+      positions,
+      colors: colors,
+      indices: indices,
+    ));
+    final Image fromTypedData = await draw(Vertices.raw(
+      VertexMode.triangles,
+      Float32List.fromList(<double>[
+        for (final Offset position in positions) ...<double>[position.dx, position.dy],
+      ]),
+      colors: Int32List.fromList(<int>[
+        for (final Color color in colors) color.value,
+      ]),
+      indices: Uint16List.fromList(indices),
+    ));
+
+    expect(await fuzzyCompareImages(fromLists, fromTypedData), true);
+  });
 }
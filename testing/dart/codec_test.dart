@@ -67,6 +67,26 @@ void main() {
     ]));
   });
 
+  test('frames are the same in every loop', () async {
+    for (final String fileName in <String>['test640x479.gif', 'alphabetAnim.gif']) {
+      final Uint8List data = await _getSkiaResource(fileName).readAsBytes();
+      final ui.Codec codec = await ui.instantiateImageCodec(data);
+      final List<Uint8List> firstLoop = <Uint8List>[];
+      for (int i = 0; i < codec.frameCount * 2; i++) {
+        final ui.FrameInfo frameInfo = await codec.getNextFrame();
+        final ByteData bytes = await frameInfo.image.toByteData();
+        final Uint8List pixels = bytes.buffer.asUint8List();
+        if (i < codec.frameCount) {
+          firstLoop.add(pixels);
+        } else {
+          expect(pixels, equals(firstLoop[i - codec.frameCount]),
+              reason: '$fileName frame ${i - codec.frameCount}');
+        }
+      }
+      codec.dispose();
+    }
+  });
+
   test('non animated image', () async {
     final Uint8List data = await _getSkiaResource('baby_tux.png').readAsBytes();
     final ui.Codec codec = await ui.instantiateImageCodec(data);
@@ -58,6 +58,56 @@ void main() {
         final List<int> expected = await readFile('square.png');
         expect(Uint8List.view(data.buffer), expected);
       });
+
+      test('is smaller at higher compression levels', () async {
+        final Image image = await Square4x4Image.image;
+        final ByteData stored =
+            await image.toByteData(format: ImageByteFormat.png, quality: 0);
+        final ByteData compressed =
+            await image.toByteData(format: ImageByteFormat.png, quality: 9);
+        expect(compressed.lengthInBytes, lessThan(stored.lengthInBytes));
+        expect(await decodeSize(stored), _kWidth);
+        expect(await decodeSize(compressed), _kWidth);
+      });
+    });
+
+    group('JPEG format', () {
+      test('works with simple image', () async {
+        final Image image = await Square4x4Image.image;
+        final ByteData data = await image.toByteData(format: ImageByteFormat.jpeg);
+        expect(data.getUint16(0), 0xFFD8);
+        expect(await decodeSize(data), _kWidth);
+      });
+
+      test('is smaller at lower qualities', () async {
+        final Image image = await Square4x4Image.image;
+        final ByteData low =
+            await image.toByteData(format: ImageByteFormat.jpeg, quality: 10);
+        final ByteData high =
+            await image.toByteData(format: ImageByteFormat.jpeg, quality: 100);
+        expect(low.lengthInBytes, lessThan(high.lengthInBytes));
+      });
+    });
+
+    group('WebP format', () {
+      test('works with simple image', () async {
+        final Image image = await Square4x4Image.image;
+        final ByteData data = await image.toByteData(format: ImageByteFormat.webp);
+        expect(String.fromCharCodes(Uint8List.view(data.buffer, 0, 4)), 'RIFF');
+        expect(await decodeSize(data), _kWidth);
+      });
+    });
+
+    test('encodes several images at once', () async {
+      final Image image = await Square4x4Image.image;
+      final List<ByteData> encoded = await Future.wait(<Future<ByteData>>[
+        for (int i = 0; i < 8; i++)
+          image.toByteData(format: ImageByteFormat.png),
+      ]);
+      final List<int> expected = await readFile('square.png');
+      for (final ByteData data in encoded) {
+        expect(Uint8List.view(data.buffer), expected);
+      }
     });
   });
 }
@@ -133,6 +183,12 @@ class GrayscaleImage {
   static List<int> get bytesUnmodified => <int>[255, 127, 127, 0];
 }
 
+Future<int> decodeSize(ByteData data) async {
+  final Codec codec = await instantiateImageCodec(Uint8List.view(data.buffer));
+  final FrameInfo frame = await codec.getNextFrame();
+  return frame.image.width;
+}
+
 Future<Uint8List> readFile(String fileName) async {
   final File file = File(path.join('flutter', 'testing', 'resources', fileName));
   return file.readAsBytes();
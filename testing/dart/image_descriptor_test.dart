@@ -25,6 +25,28 @@ void main() {
     expect(codec.frameCount, 1);
   });
 
+  test('basic image descriptor - encoded - mapped file', () async {
+    final String filePath =
+        path.join('flutter', 'testing', 'resources', 'square.png');
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromFilePath(filePath);
+    expect(buffer.length, File(filePath).lengthSync());
+    final ImageDescriptor descriptor = await ImageDescriptor.encoded(buffer);
+
+    expect(descriptor.width, 10);
+    expect(descriptor.height, 10);
+
+    final Codec codec = await descriptor.instantiateCodec();
+    expect(codec.frameCount, 1);
+  });
+
+  test('ImmutableBuffer.fromFilePath fails for missing files', () async {
+    expect(
+      ImmutableBuffer.fromFilePath(
+          path.join('flutter', 'testing', 'resources', 'missing.png')),
+      throwsException,
+    );
+  });
+
   test('basic image descriptor - encoded - square', () async {
     final Uint8List bytes = await readFile('square.png');
     final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
@@ -71,6 +93,51 @@ void main() {
     expect(codec.frameCount, 1);
   });
 
+  test('image descriptor - encoded - subset', () async {
+    final Uint8List bytes = await readFile('square.png');
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
+    final ImageDescriptor descriptor = await ImageDescriptor.encoded(buffer);
+
+    Codec codec = await descriptor.instantiateCodec(
+      subset: const Rect.fromLTRB(2, 3, 7, 9),
+    );
+    FrameInfo frame = await codec.getNextFrame();
+    expect(frame.image.width, 5);
+    expect(frame.image.height, 6);
+
+    codec = await descriptor.instantiateCodec(
+      targetWidth: 10,
+      subset: const Rect.fromLTRB(2.5, 3.5, 7, 9),
+    );
+    frame = await codec.getNextFrame();
+    expect(frame.image.width, 10);
+    expect(frame.image.height, 12);
+
+    expect(
+      () => descriptor.instantiateCodec(subset: const Rect.fromLTWH(10, 0, 5, 5)),
+      throwsArgumentError,
+    );
+  });
+
+  test('image descriptor - raw - subset', () async {
+    final Uint8List bytes = Uint8List.fromList(List<int>.filled(4 * 4 * 4, 0xAB));
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
+    final ImageDescriptor descriptor = ImageDescriptor.raw(
+      buffer,
+      width: 4,
+      height: 4,
+      rowBytes: 4 * 4,
+      pixelFormat: PixelFormat.rgba8888,
+    );
+
+    final Codec codec = await descriptor.instantiateCodec(
+      subset: const Rect.fromLTWH(1, 1, 2, 3),
+    );
+    final FrameInfo frame = await codec.getNextFrame();
+    expect(frame.image.width, 2);
+    expect(frame.image.height, 3);
+  });
+
   test('HEIC image', () async {
     final Uint8List bytes = await readFile('grill_chicken.heic');
     final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
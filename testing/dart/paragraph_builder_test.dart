@@ -70,4 +70,52 @@ void main() {
     expect(metrics.first.baseline, closeTo(11.200042724609375, epsillon));
     expect(metrics.first.lineNumber, 0);
   });
+
+  test('addStyledText lays out like pushStyle, addText and pop', () {
+    final TextStyle large = TextStyle(fontSize: 28.0);
+    final TextStyle wide = TextStyle(letterSpacing: 4.0);
+
+    final ParagraphBuilder expectedBuilder = ParagraphBuilder(ParagraphStyle());
+    expectedBuilder.addText('a ');
+    expectedBuilder.pushStyle(large);
+    expectedBuilder.addText('large ');
+    expectedBuilder.pushStyle(wide);
+    expectedBuilder.addText('wide');
+    expectedBuilder.pop();
+    expectedBuilder.addText(' text');
+    expectedBuilder.pop();
+    final Paragraph expected = expectedBuilder.build();
+
+    final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle());
+    builder.addStyledText('a large wide text', <TextStyle>[large, wide], <int>[
+      0, 2,
+      1, 8,
+      ParagraphBuilder.popStyle, 12,
+    ]);
+    final Paragraph paragraph = builder.build();
+
+    expected.layout(const ParagraphConstraints(width: 800.0));
+    paragraph.layout(const ParagraphConstraints(width: 800.0));
+    expect(paragraph.height, closeTo(expected.height, epsillon));
+    expect(paragraph.maxIntrinsicWidth, closeTo(expected.maxIntrinsicWidth, epsillon));
+    final TextBox expectedBox = expected.getBoxesForRange(8, 12).single;
+    final TextBox box = paragraph.getBoxesForRange(8, 12).single;
+    expect(box.left, closeTo(expectedBox.left, epsillon));
+    expect(box.right, closeTo(expectedBox.right, epsillon));
+  });
+
+  test('addStyledText rejects malformed runs', () {
+    final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle());
+    final List<TextStyle> styles = <TextStyle>[TextStyle()];
+    expect(() => builder.addStyledText('text', styles, <int>[0]), throwsArgumentError);
+    expect(() => builder.addStyledText('text', styles, <int>[1, 2]), throwsArgumentError);
+    expect(() => builder.addStyledText('text', styles, <int>[ParagraphBuilder.popStyle, 2]), throwsArgumentError);
+    expect(() => builder.addStyledText('text', styles, <int>[0, 3, 0, 2]), throwsArgumentError);
+    expect(() => builder.addStyledText('text', styles, <int>[0, 5]), throwsArgumentError);
+
+    builder.addStyledText('text', styles, <int>[0, 2]);
+    final Paragraph paragraph = builder.build();
+    paragraph.layout(const ParagraphConstraints(width: 800.0));
+    expect(paragraph.getBoxesForRange(0, 4), isNotEmpty);
+  });
 }
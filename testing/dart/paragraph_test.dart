@@ -60,4 +60,49 @@ void main() {
       );
     }
   });
+
+  test('lays out a prepared paragraph like any other', () async {
+    const double fontSize = 10.0;
+    final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+      fontFamily: 'Ahem',
+      fontStyle: FontStyle.normal,
+      fontWeight: FontWeight.normal,
+      fontSize: fontSize,
+    ));
+    builder.addText('Test Ahem');
+    final Paragraph paragraph = builder.build();
+    await paragraph.prepareLayout();
+    paragraph.layout(const ParagraphConstraints(width: fontSize * 5.0));
+
+    expect(paragraph.height, closeTo(fontSize * 2.0, 0.001));
+    expect(paragraph.minIntrinsicWidth, closeTo(fontSize * 4.0, 0.001));
+    expect(paragraph.maxIntrinsicWidth, closeTo(fontSize * 9.0, 0.001));
+  });
+
+  test('measures a paragraph laid out for metrics only, then paints it', () {
+    const double fontSize = 10.0;
+    final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+      fontFamily: 'Ahem',
+      fontStyle: FontStyle.normal,
+      fontWeight: FontWeight.normal,
+      fontSize: fontSize,
+    ));
+    builder.addText('Test Ahem');
+    final Paragraph paragraph = builder.build();
+    paragraph.layoutMetricsOnly(
+        const ParagraphConstraints(width: fontSize * 5.0));
+
+    expect(paragraph.height, closeTo(fontSize * 2.0, 0.001));
+    expect(paragraph.minIntrinsicWidth, closeTo(fontSize * 4.0, 0.001));
+    expect(paragraph.maxIntrinsicWidth, closeTo(fontSize * 9.0, 0.001));
+    final List<TextBox> boxes = paragraph.getBoxesForRange(0, 9);
+    expect(boxes.length, 2);
+    expect(boxes[1].top, closeTo(fontSize, 0.001));
+
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    canvas.drawParagraph(paragraph, Offset.zero);
+    recorder.endRecording().dispose();
+    expect(paragraph.height, closeTo(fontSize * 2.0, 0.001));
+  });
 }
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 // @dart = 2.6
+import 'dart:math' as math;
 import 'dart:typed_data' show Float64List;
 import 'dart:ui';
 
@@ -227,4 +228,34 @@ void main() {
     expect(newFirstMetric.getTangentForOffset(4.0).vector, const Offset(0.0, 1.0));
     expect(newFirstMetric.extractPath(4.0, 10.0).computeMetrics().first.length, 6.0);
   });
+
+  test('PathMetric.getTangentsForOffsets matches getTangentForOffset', () {
+    final Path path = Path()
+      ..moveTo(0, 0)
+      ..lineTo(10, 0)
+      ..quadraticBezierTo(20, 0, 20, 10)
+      ..lineTo(20, 30);
+    final PathMetric metric = path.computeMetrics().single;
+    final List<double> distances = <double>[-1.0, 0.0, 4.0, 12.5, 30.0, 100.0];
+    final List<Tangent> tangents = metric.getTangentsForOffsets(distances)!;
+    expect(tangents.length, distances.length);
+    for (int i = 0; i < distances.length; i++) {
+      final Tangent expected = metric.getTangentForOffset(distances[i])!;
+      expect(tangents[i].position, expected.position);
+      expect(tangents[i].vector, expected.vector);
+    }
+    expect(metric.getTangentsForOffsets(<double>[]), isEmpty);
+  });
+
+  test('PathMetrics are measured again after the path is mutated', () {
+    final Path path = Path()..lineTo(0, 10);
+    expect(path.computeMetrics().single.length, 10);
+    expect(path.computeMetrics(forceClosed: true).single.length, 20);
+    expect(path.computeMetrics().single.length, 10);
+
+    path.lineTo(10, 10);
+    expect(path.computeMetrics().single.length, 20);
+    expect(path.computeMetrics(forceClosed: true).single.length,
+        closeTo(20 + math.sqrt(200), 0.001));
+  });
 }
@@ -32,6 +32,26 @@ void main() {
     expect(timing.toString(), 'FrameTiming(buildDuration: 7.0ms, rasterDuration: 10.5ms, vsyncOverhead: 0.5ms, totalSpan: 19.0ms)');
   });
 
+  test('requestFrameRateRange satisfies the most demanding active request', () {
+    final PlatformDispatcher dispatcher = PlatformDispatcher.instance;
+    expect(dispatcher.frameRateRange, FrameRateRange.unspecified);
+
+    final FrameRateRequest spinner = dispatcher.requestFrameRateRange(
+      const FrameRateRange(minimum: 10.0, maximum: 30.0));
+    expect(dispatcher.frameRateRange, const FrameRateRange(minimum: 10.0, maximum: 30.0));
+
+    final FrameRateRequest scroll = dispatcher.requestFrameRateRange(
+      const FrameRateRange(minimum: 60.0, maximum: 120.0, preferred: 120.0));
+    expect(dispatcher.frameRateRange, const FrameRateRange(minimum: 60.0, maximum: 120.0, preferred: 120.0));
+
+    scroll.cancel();
+    scroll.cancel();
+    expect(dispatcher.frameRateRange, const FrameRateRange(minimum: 10.0, maximum: 30.0));
+
+    spinner.cancel();
+    expect(dispatcher.frameRateRange, FrameRateRange.unspecified);
+  });
+
   test('computePlatformResolvedLocale basic', () {
     final List<Locale> supportedLocales = <Locale>[
       const Locale.fromSubtags(languageCode: 'zh', scriptCode: 'Hans', countryCode: 'CN'),
@@ -5,6 +5,9 @@
 #ifndef LIB_TONIC_DART_ARGS_H_
 #define LIB_TONIC_DART_ARGS_H_
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
 
@@ -14,15 +17,48 @@
 
 namespace tonic {
 
+// Describes how an argument of type |T| is fetched by
+// Dart_GetNativeArguments. Only booleans, integers, enums and floating point
+// values are primitive; every other type goes through its DartConverter.
+template <typename T>
+struct DartNativeArgument {
+  static constexpr bool kIsPrimitive =
+      std::is_arithmetic<T>::value || std::is_enum<T>::value;
+
+  static constexpr uint8_t kType =
+      std::is_same<T, bool>::value ? Dart_NativeArgument_kBool
+      : std::is_floating_point<T>::value ? Dart_NativeArgument_kDouble
+                                         : Dart_NativeArgument_kInt64;
+
+  static T FromValue(const Dart_NativeArgument_Value& value) {
+    if constexpr (std::is_same<T, bool>::value) {
+      return value.as_bool;
+    } else if constexpr (std::is_floating_point<T>::value) {
+      return static_cast<T>(value.as_double);
+    } else {
+      return static_cast<T>(value.as_int64);
+    }
+  }
+};
+
 class DartArgIterator {
  public:
   DartArgIterator(Dart_NativeArguments args, int start_index = 1)
-      : args_(args), index_(start_index), had_exception_(false) {}
+      : args_(args),
+        start_index_(start_index),
+        index_(start_index),
+        had_exception_(false) {}
 
   template <typename T>
   T GetNext() {
     if (had_exception_)
       return T();
+    if constexpr (DartNativeArgument<T>::kIsPrimitive) {
+      if (prefetched_) {
+        return DartNativeArgument<T>::FromValue(
+            prefetched_[index_++ - start_index_]);
+      }
+    }
     Dart_Handle exception = nullptr;
     T arg = DartConverter<T>::FromArguments(args_, index_++, exception);
     if (exception) {
@@ -36,14 +72,85 @@ class DartArgIterator {
 
   Dart_NativeArguments args() const { return args_; }
 
+  int start_index() const { return start_index_; }
+
+  // Makes GetNext read primitive arguments from |values| instead of asking the
+  // VM for each of them. |values| is indexed by argument position relative to
+  // the start index and must outlive the iterator.
+  void SetPrefetchedValues(const Dart_NativeArgument_Value* values) {
+    prefetched_ = values;
+  }
+
  private:
   Dart_NativeArguments args_;
+  int start_index_;
   int index_;
   bool had_exception_;
+  const Dart_NativeArgument_Value* prefetched_ = nullptr;
 
   TONIC_DISALLOW_COPY_AND_ASSIGN(DartArgIterator);
 };
 
+// Fetches all the primitive arguments of a native call with a single
+// Dart_GetNativeArguments call. Calls that take fewer than two primitive
+// arguments keep using the per-argument path.
+template <typename... ArgTypes>
+class DartPrimitiveArgs {
+ public:
+  static constexpr size_t kCount = sizeof...(ArgTypes);
+  static constexpr size_t kPrimitiveCount =
+      (size_t{0} + ... +
+       static_cast<size_t>(
+           DartNativeArgument<typename std::remove_const<
+               typename std::remove_reference<ArgTypes>::type>::type>::
+               kIsPrimitive));
+
+  // Returns false if the arguments could not be fetched in bulk, for example
+  // because one of them is null. The caller then falls back to the
+  // DartConverters, which handle these cases one argument at a time.
+  bool Fetch(Dart_NativeArguments args, int start_index) {
+    if constexpr (kPrimitiveCount < 2) {
+      return false;
+    } else {
+      constexpr bool kIsPrimitive[] = {
+          DartNativeArgument<typename std::remove_const<
+              typename std::remove_reference<ArgTypes>::type>::type>::
+              kIsPrimitive...};
+      constexpr uint8_t kTypes[] = {
+          DartNativeArgument<typename std::remove_const<
+              typename std::remove_reference<ArgTypes>::type>::type>::kType...};
+
+      Dart_NativeArgument_Descriptor descriptors[kPrimitiveCount];
+      Dart_NativeArgument_Value values[kPrimitiveCount];
+      size_t primitive_index = 0;
+      for (size_t i = 0; i < kCount; i++) {
+        if (kIsPrimitive[i]) {
+          descriptors[primitive_index].type = kTypes[i];
+          descriptors[primitive_index].index =
+              static_cast<uint8_t>(start_index + i);
+          primitive_index++;
+        }
+      }
+      if (Dart_IsError(Dart_GetNativeArguments(args, kPrimitiveCount,
+                                               descriptors, values))) {
+        return false;
+      }
+      primitive_index = 0;
+      for (size_t i = 0; i < kCount; i++) {
+        if (kIsPrimitive[i]) {
+          values_[i] = values[primitive_index++];
+        }
+      }
+      return true;
+    }
+  }
+
+  const Dart_NativeArgument_Value* values() const { return values_.data(); }
+
+ private:
+  std::array<Dart_NativeArgument_Value, kCount> values_;
+};
+
 // Classes for generating and storing an argument pack of integer indices
 // (based on well-known "indices trick", see: http://goo.gl/bKKojn):
 template <size_t... indices>
@@ -68,18 +175,21 @@ template <typename ResultType, typename... ArgTypes>
 struct IndicesForSignature<ResultType (*)(ArgTypes...)> {
   static const size_t count = sizeof...(ArgTypes);
   using type = typename IndicesGenerator<count>::type;
+  using PrimitiveArgs = DartPrimitiveArgs<ArgTypes...>;
 };
 
 template <typename C, typename ResultType, typename... ArgTypes>
 struct IndicesForSignature<ResultType (C::*)(ArgTypes...)> {
   static const size_t count = sizeof...(ArgTypes);
   using type = typename IndicesGenerator<count>::type;
+  using PrimitiveArgs = DartPrimitiveArgs<ArgTypes...>;
 };
 
 template <typename C, typename ResultType, typename... ArgTypes>
 struct IndicesForSignature<ResultType (C::*)(ArgTypes...) const> {
   static const size_t count = sizeof...(ArgTypes);
   using type = typename IndicesGenerator<count>::type;
+  using PrimitiveArgs = DartPrimitiveArgs<ArgTypes...>;
 };
 
 template <size_t index, typename ArgType>
@@ -198,6 +308,9 @@ template <typename Sig>
 void DartCall(Sig func, Dart_NativeArguments args) {
   DartArgIterator it(args);
   using Indices = typename IndicesForSignature<Sig>::type;
+  typename IndicesForSignature<Sig>::PrimitiveArgs primitive_args;
+  if (primitive_args.Fetch(args, it.start_index()))
+    it.SetPrefetchedValues(primitive_args.values());
   DartDispatcher<Indices, Sig> decoder(&it);
   if (it.had_exception())
     return;
@@ -208,6 +321,9 @@ template <typename Sig>
 void DartCallStatic(Sig func, Dart_NativeArguments args) {
   DartArgIterator it(args, 0);
   using Indices = typename IndicesForSignature<Sig>::type;
+  typename IndicesForSignature<Sig>::PrimitiveArgs primitive_args;
+  if (primitive_args.Fetch(args, it.start_index()))
+    it.SetPrefetchedValues(primitive_args.values());
   DartDispatcher<Indices, Sig> decoder(&it);
   if (it.had_exception())
     return;
@@ -221,6 +337,9 @@ void DartCallConstructor(Sig func, Dart_NativeArguments args) {
   using Wrappable = typename DartDispatcher<Indices, Sig>::CtorResultType;
   Wrappable wrappable;
   {
+    typename IndicesForSignature<Sig>::PrimitiveArgs primitive_args;
+    if (primitive_args.Fetch(args, it.start_index()))
+      it.SetPrefetchedValues(primitive_args.values());
     DartDispatcher<Indices, Sig> decoder(&it);
     if (it.had_exception())
       return;
@@ -19,7 +19,8 @@ DartMessageHandler::DartMessageHandler()
       isolate_had_uncaught_exception_error_(false),
       isolate_had_fatal_error_(false),
       isolate_last_error_(kNoError),
-      task_dispatcher_(nullptr) {}
+      task_dispatcher_(nullptr),
+      pending_message_count_(0) {}
 
 DartMessageHandler::~DartMessageHandler() {
   task_dispatcher_ = nullptr;
@@ -32,18 +33,49 @@ void DartMessageHandler::Initialize(TaskDispatcher dispatcher) {
   Dart_SetMessageNotifyCallback(MessageNotifyCallback);
 }
 
+constexpr std::chrono::microseconds DartMessageHandler::kMessageBatchBudget;
+
 void DartMessageHandler::OnMessage(DartState* dart_state) {
-  auto task_dispatcher_ = dart_state->message_handler().task_dispatcher_;
+  auto& message_handler = dart_state->message_handler();
+  // If messages were already pending, a scheduled task will handle this one
+  // too.
+  if (message_handler.pending_message_count_.fetch_add(1) > 0) {
+    return;
+  }
+  message_handler.ScheduleHandlePendingMessages(dart_state);
+}
 
+void DartMessageHandler::ScheduleHandlePendingMessages(DartState* dart_state) {
   // Schedule a task to run on the message loop thread.
   auto weak_dart_state = dart_state->GetWeakPtr();
   task_dispatcher_([weak_dart_state]() {
     if (auto dart_state = weak_dart_state.lock()) {
-      dart_state->message_handler().OnHandleMessage(dart_state.get());
+      dart_state->message_handler().OnHandlePendingMessages(dart_state.get());
     }
   });
 }
 
+void DartMessageHandler::OnHandlePendingMessages(DartState* dart_state) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + kMessageBatchBudget;
+  do {
+    OnHandleMessage(dart_state);
+    if (isolate_exited_ || isolate_had_fatal_error_) {
+      // No more messages will be handled for this isolate.
+      pending_message_count_ = 0;
+      return;
+    }
+    if (pending_message_count_.fetch_sub(1) == 1) {
+      // All notified messages have been handled.
+      return;
+    }
+  } while (std::chrono::steady_clock::now() < deadline);
+
+  // Out of budget with messages left. Let other tasks, such as frame
+  // callbacks, run before handling the rest.
+  ScheduleHandlePendingMessages(dart_state);
+}
+
 void DartMessageHandler::UnhandledError(Dart_Handle error) {
   TONIC_DCHECK(Dart_CurrentIsolate());
   TONIC_DCHECK(Dart_IsError(error));
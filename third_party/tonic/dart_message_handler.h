@@ -5,6 +5,8 @@
 #ifndef LIB_TONIC_DART_MESSAGE_HANDLER_H_
 #define LIB_TONIC_DART_MESSAGE_HANDLER_H_
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 
 #include "third_party/dart/runtime/include/dart_api.h"
@@ -39,10 +41,17 @@ class DartMessageHandler {
   DartErrorHandleType isolate_last_error() const { return isolate_last_error_; }
 
  protected:
+  // Messages that arrive while a task is already scheduled are handled by
+  // that task. A task handles pending messages until this much time has passed
+  // and then yields the task runner by scheduling a new task for the rest.
+  static constexpr std::chrono::microseconds kMessageBatchBudget{2000};
+
   // Called from an unknown thread for each message.
   void OnMessage(DartState* dart_state);
   // By default, called on the task runner's thread for each message.
   void OnHandleMessage(DartState* dart_state);
+  // Called on the task runner's thread to handle a batch of pending messages.
+  void OnHandlePendingMessages(DartState* dart_state);
 
   bool handled_first_message() const { return handled_first_message_; }
 
@@ -56,8 +65,12 @@ class DartMessageHandler {
   bool isolate_had_fatal_error_;
   DartErrorHandleType isolate_last_error_;
   TaskDispatcher task_dispatcher_;
+  // Number of messages notified but not yet handled.
+  std::atomic<int64_t> pending_message_count_;
 
  private:
+  void ScheduleHandlePendingMessages(DartState* dart_state);
+
   static void MessageNotifyCallback(Dart_Isolate dest_isolate);
 };
 
@@ -12,28 +12,39 @@ namespace tonic {
 
 namespace {
 
-// For large objects it is more efficient to use an external typed data object
-// with a buffer allocated outside the Dart heap.
-const int kExternalSizeThreshold = 1000;
-
 void FreeFinalizer(void* isolate_callback_data, void* peer) {
   free(peer);
 }
 
 }  // anonymous namespace
 
+constexpr size_t DartByteData::kExternalSizeThreshold;
+
 Dart_Handle DartByteData::Create(const void* data, size_t length) {
   if (length < kExternalSizeThreshold) {
     auto handle = DartByteData{data, length}.dart_handle();
     // The destructor should release the typed data.
     return handle;
   } else {
+    // For large objects it is more efficient to use an external typed data
+    // object with a buffer allocated outside the Dart heap.
     void* buf = ::malloc(length);
     TONIC_DCHECK(buf);
     ::memcpy(buf, data, length);
-    return Dart_NewExternalTypedDataWithFinalizer(
-        Dart_TypedData_kByteData, buf, length, buf, length, FreeFinalizer);
+    return CreateExternal(buf, length, buf, FreeFinalizer);
+  }
+}
+
+Dart_Handle DartByteData::CreateExternal(void* data,
+                                         size_t length,
+                                         void* peer,
+                                         Dart_HandleFinalizer finalizer) {
+  Dart_Handle handle = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, data, length, peer, length, finalizer);
+  if (Dart_IsError(handle)) {
+    finalizer(nullptr, peer);
   }
+  return handle;
 }
 
 DartByteData::DartByteData()
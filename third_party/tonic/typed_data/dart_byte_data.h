@@ -12,10 +12,30 @@
 
 namespace tonic {
 
+// A scoped view of a Dart ByteData. The constructor acquires the underlying
+// buffer with Dart_TypedDataAcquireData so it can be read without a copy, and
+// the buffer stays acquired until Release() is called or this object is
+// destroyed. No other Dart API calls may be made while the data is acquired,
+// so callers should release it as soon as they are done with it and use
+// Copy() to keep a snapshot of the bytes beyond that point.
 class DartByteData {
  public:
+  // Payloads at least this large are handed to Dart as external typed data
+  // instead of being copied into the Dart heap.
+  static constexpr size_t kExternalSizeThreshold = 1000;
+
+  // Creates a ByteData holding a copy of |data|.
   static Dart_Handle Create(const void* data, size_t length);
 
+  // Creates a ByteData backed by |data| without copying it. |finalizer| is
+  // called with |peer| once Dart no longer references the ByteData, or
+  // immediately if the ByteData could not be created, so ownership of |peer|
+  // is always transferred. |data| must be writable and outlive |peer|.
+  static Dart_Handle CreateExternal(void* data,
+                                    size_t length,
+                                    void* peer,
+                                    Dart_HandleFinalizer finalizer);
+
   explicit DartByteData(Dart_Handle list);
   DartByteData(DartByteData&& other);
   DartByteData();
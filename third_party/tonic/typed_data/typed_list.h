@@ -12,7 +12,9 @@ namespace tonic {
 
 // A simple wrapper around Dart TypedData objects. It uses
 // Dart_TypedDataAcquireData to obtain a raw pointer to the data, which is
-// released when this object is destroyed.
+// released when this object is destroyed or Release() is called. No other
+// Dart API calls may be made while the data is acquired, so callers that keep
+// the list around should copy what they need and release it early.
 //
 // This is designed to be used with DartConverter only.
 template <Dart_TypedData_Type kTypeName, typename ElemType>
@@ -22,6 +22,7 @@
 #include "flutter/fml/logging.h"
 #include "flutter/third_party/txt/tests/txt_test_utils.h"
 #include "minikin/LayoutUtils.h"
+#include "minikin/WordBreaker.h"
 #include "third_party/benchmark/include/benchmark/benchmark_api.h"
 #include "third_party/icu/source/common/unicode/unistr.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -426,6 +427,52 @@ BENCHMARK_REGISTER_F(ParagraphFixture, AddStyleRun)
     ->Range(1 << 7, 1 << 14)
     ->Complexity(benchmark::oN);
 
+// Breaks Latin text into words with the vectorized fast path of the word
+// breaker if |fast_path| is true, and with the ICU break iterator otherwise.
+static void BreakLatinWords(benchmark::State& state, bool fast_path) {
+  const char16_t* words[] = {u"The", u"quick", u"brown", u"fox", u"jumps",
+                             u"over", u"the", u"lazy", u"dog."};
+  std::u16string text;
+  for (size_t i = 0; text.size() < static_cast<size_t>(state.range(0)); ++i) {
+    text += words[i % 9];
+    text += u' ';
+  }
+  text.resize(state.range(0));
+  if (text.back() == u' ') {
+    text.back() = u'x';
+  }
+
+  minikin::WordBreaker breaker;
+  breaker.setLocale();
+  breaker.setLatinFastPathEnabled(fast_path);
+  while (state.KeepRunning()) {
+    breaker.setText(reinterpret_cast<const uint16_t*>(text.data()),
+                    text.size());
+    while (breaker.next() >= 0) {
+    }
+  }
+  breaker.finish();
+  state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_DEFINE_F(ParagraphFixture, WordBreakLatinFastPath)
+(benchmark::State& state) {
+  BreakLatinWords(state, true);
+}
+BENCHMARK_REGISTER_F(ParagraphFixture, WordBreakLatinFastPath)
+    ->RangeMultiplier(4)
+    ->Range(1 << 7, 1 << 14)
+    ->Complexity(benchmark::oN);
+
+BENCHMARK_DEFINE_F(ParagraphFixture, WordBreakLatinIcu)
+(benchmark::State& state) {
+  BreakLatinWords(state, false);
+}
+BENCHMARK_REGISTER_F(ParagraphFixture, WordBreakLatinIcu)
+    ->RangeMultiplier(4)
+    ->Range(1 << 7, 1 << 14)
+    ->Complexity(benchmark::oN);
+
 BENCHMARK_DEFINE_F(ParagraphFixture, SkTextBlobAlloc)(benchmark::State& state) {
   SkFont font;
   font.setEdging(SkFont::Edging::kAntiAlias);
@@ -0,0 +1,254 @@
+/*
+ * Copyright 2017 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Layout benchmarks over a corpus of realistic multilingual paragraphs.
+//
+// Unlike the synthetic Latin strings of paragraph_benchmarks.cc, these
+// exercise font fallback between families, bidi resolution, complex shaping
+// and emoji sequences. The results are part of the txt_benchmarks JSON output
+// (see testing/benchmark/generate_metrics.sh), so regressions show up in the
+// metrics history on a per-script basis. The label of each result records the
+// number of lines and code units laid out, which must stay the same for the
+// timings of two runs to be comparable.
+
+#include <string>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/third_party/txt/tests/txt_test_utils.h"
+#include "third_party/benchmark/include/benchmark/benchmark_api.h"
+#include "third_party/icu/source/common/unicode/unistr.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "txt/font_collection.h"
+#include "txt/paragraph_builder_txt.h"
+#include "txt/paragraph_txt.h"
+
+namespace txt {
+
+namespace {
+
+struct CorpusSample {
+  const char* text;
+  TextDirection direction;
+};
+
+const CorpusSample kChinese = {
+    "Flutter 是谷歌的移动应用软件开发工具包，用于为安卓、苹果、网页和桌面平台"
+    "开发应用程序。它使用一套代码库构建界面，并通过自带的渲染引擎直接在画布上"
+    "绘制每一个像素。文本排版需要处理分行、标点挤压以及中文、日文和韩文字符的"
+    "字体回退。在长段落中，每一行都可能包含数百个字形，因此排版的性能对滚动的"
+    "流畅程度有直接的影响。",
+    TextDirection::ltr};
+
+const CorpusSample kJapanese = {
+    "吾輩は猫である。名前はまだ無い。どこで生れたかとんと見当がつかぬ。何でも"
+    "薄暗いじめじめした所でニャーニャー泣いていた事だけは記憶している。吾輩は"
+    "ここで始めて人間というものを見た。しかもあとで聞くとそれは書生という人間"
+    "中で一番獰悪な種族であったそうだ。この書生というのは時々我々を捕えて煮て"
+    "食うという話である。Flutter のテキストエンジンは、かなと漢字とラテン文字が"
+    "混在する段落を一度にレイアウトする。",
+    TextDirection::ltr};
+
+const CorpusSample kArabic = {
+    "فلاتر هي مجموعة أدوات لتطوير واجهات المستخدم مفتوحة المصدر أنشأتها شركة "
+    "جوجل. تُستخدم لتطوير تطبيقات لأنظمة Android و iOS و Linux و Windows "
+    "انطلاقًا من قاعدة شيفرة واحدة. صدر الإصدار 1.0 في 4 ديسمبر 2018، ويبلغ عدد "
+    "المطورين الذين يستخدمونها أكثر من 2,000,000 مطور حول العالم. يتطلب عرض "
+    "النص العربي تشكيل الحروف حسب موقعها في الكلمة، وتحديد اتجاه كل جزء من "
+    "النص عندما يختلط بالأرقام والكلمات اللاتينية مثل (Hello, world!).",
+    TextDirection::rtl};
+
+const CorpusSample kDevanagari = {
+    "फ़्लटर गूगल द्वारा बनाया गया एक मुक्त स्रोत यूज़र इंटरफ़ेस सॉफ़्टवेयर डेवलपमेंट "
+    "किट है। इसका उपयोग एंड्रॉइड, आईओएस, लिनक्स, मैक और विंडोज़ के लिए एक ही "
+    "कोडबेस से अनुप्रयोग विकसित करने के लिए किया जाता है। देवनागरी लिपि में "
+    "संयुक्ताक्षर, मात्राएँ और हलंत होते हैं, इसलिए प्रत्येक शब्द को सही ढंग से "
+    "दिखाने के लिए जटिल आकार देने की आवश्यकता होती है।",
+    TextDirection::ltr};
+
+const CorpusSample kKhmer = {
+    "ភាសាខ្មែរ គឺជាភាសាកំណើតរបស់ជនជាតិខ្មែរ និងជាភាសាផ្លូវការរបស់ប្រទេសកម្ពុជា។ "
+    "អក្សរខ្មែរមានព្យញ្ជនៈ ស្រៈ និងជើងអក្សរជាច្រើន ដែលត្រូវការការរៀបចំរូបរាងស្មុគស្មាញ។ "
+    "ពាក្យខ្មែរមិនត្រូវបានបំបែកដោយដកឃ្លាទេ ដូច្នេះការកាត់បន្ទាត់ត្រូវការវចនានុក្រម។",
+    TextDirection::ltr};
+
+const CorpusSample kEmoji = {
+    "Family photos 👨‍👩‍👧‍👦 👩‍👩‍👦 and a thumbs up 👍🏽👍🏿 from "
+    "everyone! Flags 🇯🇵 🇧🇷 🇮🇳 🇪🇬 🏳️‍🌈 keycaps 1️⃣ 2️⃣ #️⃣ and more: "
+    "🧑🏻‍💻 👩🏾‍🚀 🤷‍♀️ 🙇🏼‍♂️ ❤️‍🔥 🐈‍⬛ ☕ ✈️ 🎉🎉🎉 Let's ship it 🚀!",
+    TextDirection::ltr};
+
+// The fonts in the test fixtures that cover the scripts of the corpus. There
+// is no fixture font for Devanagari, which is therefore shaped with the
+// missing glyph of the last family after searching all of them.
+std::vector<std::string> GetCorpusFontFamilies() {
+  return {"Roboto", "Noto Naskh Arabic", "Noto Sans CJK JP", "Noto Sans Khmer",
+          "Noto Color Emoji"};
+}
+
+std::shared_ptr<FontCollection> GetCorpusFontCollection() {
+  static std::shared_ptr<FontCollection> collection = GetTestFontCollection();
+  return collection;
+}
+
+std::u16string ToUTF16(const char* text) {
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  return std::u16string(icu_text.getBuffer(),
+                        icu_text.getBuffer() + icu_text.length());
+}
+
+// Whether a new style run may start after |c|.
+bool IsStyleRunBoundary(char16_t c) {
+  return c == u' ' || c == u'，' || c == u'。' || c == u'、' || c == u'।' ||
+         c == u'។';
+}
+
+// Builds a paragraph of |text|. If |many_style_runs| is true, the style
+// changes after every word or clause.
+std::unique_ptr<ParagraphTxt> BuildCorpusParagraph(
+    const std::u16string& text,
+    TextDirection direction,
+    bool many_style_runs) {
+  ParagraphStyle paragraph_style;
+  paragraph_style.text_direction = direction;
+  TextStyle text_style;
+  text_style.font_families = GetCorpusFontFamilies();
+  text_style.font_size = 16;
+  text_style.color = SK_ColorBLACK;
+
+  ParagraphBuilderTxt builder(paragraph_style, GetCorpusFontCollection());
+  if (!many_style_runs) {
+    builder.PushStyle(text_style);
+    builder.AddText(text);
+    builder.Pop();
+    return BuildParagraph(builder);
+  }
+
+  size_t run_start = 0;
+  size_t run_count = 0;
+  for (size_t i = 0; i < text.size(); ++i) {
+    if (!IsStyleRunBoundary(text[i]) && i + 1 < text.size()) {
+      continue;
+    }
+    TextStyle run_style = text_style;
+    run_style.font_size = 14 + run_count % 3 * 2;
+    run_style.font_weight =
+        run_count % 2 == 0 ? FontWeight::w400 : FontWeight::w700;
+    run_style.color = run_count % 4 == 0 ? SK_ColorBLUE : SK_ColorBLACK;
+    builder.PushStyle(run_style);
+    builder.AddText(text.substr(run_start, i + 1 - run_start));
+    builder.Pop();
+    run_start = i + 1;
+    run_count++;
+  }
+  return BuildParagraph(builder);
+}
+
+// All samples of the corpus concatenated, which is also how they commonly
+// appear in chat and social applications.
+std::u16string GetMixedCorpusText() {
+  std::u16string text;
+  for (const CorpusSample* sample :
+       {&kChinese, &kArabic, &kEmoji, &kDevanagari, &kJapanese, &kKhmer}) {
+    text += ToUTF16(sample->text);
+    text += u' ';
+  }
+  return text;
+}
+
+constexpr double kLayoutWidth = 400;
+
+void SetCorpusLabel(benchmark::State& state,
+                    ParagraphTxt& paragraph,
+                    size_t code_units) {
+  state.SetLabel("lines=" + std::to_string(paragraph.GetLineCount()) +
+                 " code_units=" + std::to_string(code_units));
+  state.SetItemsProcessed(state.iterations() * code_units);
+}
+
+}  // namespace
+
+static void BM_ParagraphCorpusLayout(benchmark::State& state,
+                                     const CorpusSample& sample) {
+  const std::u16string text = ToUTF16(sample.text);
+  auto paragraph = BuildCorpusParagraph(text, sample.direction, false);
+  while (state.KeepRunning()) {
+    paragraph->SetDirty();
+    paragraph->Layout(kLayoutWidth);
+  }
+  SetCorpusLabel(state, *paragraph, text.size());
+}
+BENCHMARK_CAPTURE(BM_ParagraphCorpusLayout, Chinese, kChinese);
+BENCHMARK_CAPTURE(BM_ParagraphCorpusLayout, Japanese, kJapanese);
+BENCHMARK_CAPTURE(BM_ParagraphCorpusLayout, Arabic, kArabic);
+BENCHMARK_CAPTURE(BM_ParagraphCorpusLayout, Devanagari, kDevanagari);
+BENCHMARK_CAPTURE(BM_ParagraphCorpusLayout, Khmer, kKhmer);
+BENCHMARK_CAPTURE(BM_ParagraphCorpusLayout, Emoji, kEmoji);
+
+// Building includes resolving the bidi runs and style runs of the text, and
+// the first layout includes shaping without any layout cache entries for
+// the new paragraph's runs.
+static void BM_ParagraphCorpusBuildAndLayout(benchmark::State& state,
+                                             const CorpusSample& sample) {
+  const std::u16string text = ToUTF16(sample.text);
+  size_t line_count = 0;
+  while (state.KeepRunning()) {
+    auto paragraph = BuildCorpusParagraph(text, sample.direction, false);
+    paragraph->Layout(kLayoutWidth);
+    line_count = paragraph->GetLineCount();
+  }
+  state.SetLabel("lines=" + std::to_string(line_count) +
+                 " code_units=" + std::to_string(text.size()));
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+BENCHMARK_CAPTURE(BM_ParagraphCorpusBuildAndLayout, Chinese, kChinese);
+BENCHMARK_CAPTURE(BM_ParagraphCorpusBuildAndLayout, Arabic, kArabic);
+BENCHMARK_CAPTURE(BM_ParagraphCorpusBuildAndLayout, Devanagari, kDevanagari);
+BENCHMARK_CAPTURE(BM_ParagraphCorpusBuildAndLayout, Emoji, kEmoji);
+
+static void BM_ParagraphCorpusMixedLayout(benchmark::State& state) {
+  const std::u16string text = GetMixedCorpusText();
+  auto paragraph =
+      BuildCorpusParagraph(text, TextDirection::ltr, state.range(0) != 0);
+  while (state.KeepRunning()) {
+    paragraph->SetDirty();
+    paragraph->Layout(kLayoutWidth);
+  }
+  SetCorpusLabel(state, *paragraph, text.size());
+}
+// The argument selects a single style run (0) or a run per word (1).
+BENCHMARK(BM_ParagraphCorpusMixedLayout)->Arg(0)->Arg(1);
+
+static void BM_ParagraphCorpusMixedPaint(benchmark::State& state) {
+  const std::u16string text = GetMixedCorpusText();
+  auto paragraph = BuildCorpusParagraph(text, TextDirection::ltr, true);
+  paragraph->Layout(kLayoutWidth);
+
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(static_cast<int>(kLayoutWidth), 1000);
+  SkCanvas canvas(bitmap);
+  canvas.clear(SK_ColorWHITE);
+  while (state.KeepRunning()) {
+    paragraph->Paint(&canvas, 0, 0);
+  }
+  SetCorpusLabel(state, *paragraph, text.size());
+}
+BENCHMARK(BM_ParagraphCorpusMixedPaint);
+
+}  // namespace txt
@@ -536,6 +536,31 @@ void FontCollection::itemize(const uint16_t* string,
     }
     prevCh = ch;
     run->end = nextUtf16Pos;  // exclusive
+
+    // libtxt: characters supported by the first family always use it unless
+    // they are followed by a variation selector, so the run of the first
+    // family can be extended over all of them at once. The last covered
+    // character and any character followed by a variation selector are left
+    // to the loop, which checks the character after them.
+    if (lastFamily == mFamilies[0].get() && nextCh != kEndOfString) {
+      const uint16_t* next = string + nextUtf16Pos;
+      const size_t covered = lastFamily->getCoverage().getCoveredLength(
+          next, string_size - nextUtf16Pos);
+      size_t skipped = covered > 1 ? covered - 1 : 0;
+      for (size_t i = 1; i < skipped + 1; i++) {
+        if (isVariationSelector(next[i])) {
+          skipped = i - 1;
+          break;
+        }
+      }
+      if (skipped > 0) {
+        nextUtf16Pos += skipped;
+        prevCh = string[nextUtf16Pos - 1];
+        run->end = nextUtf16Pos;
+        readLength = nextUtf16Pos;
+        U16_NEXT(string, readLength, string_size, nextCh);
+      }
+    }
   } while (nextCh != kEndOfString);
 }
 
@@ -136,6 +136,15 @@ class FontFamily {
   FontFamily(int variant, std::vector<Font>&& fonts);
   FontFamily(uint32_t langId, int variant, std::vector<Font>&& fonts);
 
+  // libtxt extension: creates a family with a coverage that was computed
+  // earlier for the same fonts, e.g. from the getCoverage().getRanges() saved
+  // by a previous run, instead of parsing the cmap table again.
+  FontFamily(uint32_t langId,
+             int variant,
+             std::vector<Font>&& fonts,
+             SparseBitSet&& coverage,
+             bool hasVSTable);
+
   // TODO: Good to expose FontUtil.h.
   static bool analyzeStyle(const std::shared_ptr<MinikinFont>& typeface,
                            int* weight,
@@ -175,6 +184,7 @@ class FontFamily {
 
  private:
   void computeCoverage();
+  void computeSupportedAxesLocked();
 
   uint32_t mLangId;
   int mVariant;
@@ -19,8 +19,12 @@
 #include "HbFontCache.h"
 
 #include <log/log.h>
+#include <utils/JenkinsHash.h>
 #include <utils/LruCache.h>
 
+#include <cstring>
+#include <unordered_map>
+
 #include <hb-ot.h>
 #include <hb.h>
 
@@ -31,27 +35,89 @@ namespace minikin {
 
 class HbFontCache : private android::OnEntryRemoved<int32_t, hb_font_t*> {
  public:
-  HbFontCache() : mCache(kMaxEntries) {
+  HbFontCache()
+      : mCache(android::LruCache<int32_t, hb_font_t*>::kUnlimitedCapacity),
+        mCapacity(kDefaultHbFontCacheCapacity) {
     mCache.setOnEntryRemovedListener(this);
   }
 
   // callback for OnEntryRemoved
   void operator()(int32_t& /* key */, hb_font_t*& value) {
+    auto found = mFonts.find(value);
+    if (found != mFonts.end() && --found->second.users == 0) {
+      if (found->second.contentKey != 0) {
+        mFontsByContent.erase(found->second.contentKey);
+      }
+      mFonts.erase(found);
+    }
     hb_font_destroy(value);
   }
 
   hb_font_t* get(int32_t fontId) { return mCache.get(fontId); }
 
-  void put(int32_t fontId, hb_font_t* font) { mCache.put(fontId, font); }
+  // libtxt extension: returns a font created for another font id with the
+  // same content key, without adding a reference, or nullptr.
+  hb_font_t* getByContent(size_t contentKey) {
+    if (contentKey == 0) {
+      return nullptr;
+    }
+    auto found = mFontsByContent.find(contentKey);
+    return found == mFontsByContent.end() ? nullptr : found->second;
+  }
+
+  // Takes ownership of one reference to |font|.
+  void put(int32_t fontId, hb_font_t* font, size_t contentKey) {
+    auto found = mFonts.find(font);
+    if (found != mFonts.end()) {
+      found->second.users++;
+    } else {
+      hb_face_t* face = hb_font_get_face(font);
+      hb_blob_t* blob = hb_face_reference_blob(face);
+      mFonts[font] = {contentKey, 1, hb_blob_get_length(blob)};
+      hb_blob_destroy(blob);
+      if (contentKey != 0) {
+        mFontsByContent[contentKey] = font;
+      }
+    }
+    mCache.put(fontId, font);
+    trim();
+  }
 
   void clear() { mCache.clear(); }
 
   void remove(int32_t fontId) { mCache.remove(fontId); }
 
+  void setCapacity(size_t capacity) {
+    mCapacity = capacity;
+    trim();
+  }
+
+  HbFontCacheStats getStats() const {
+    HbFontCacheStats stats = {mCache.size(), mFonts.size(), 0};
+    for (const auto& font : mFonts) {
+      stats.sharedDataBytes += font.second.dataBytes;
+    }
+    return stats;
+  }
+
  private:
-  static const size_t kMaxEntries = 100;
+  struct FontEntry {
+    size_t contentKey;
+    // The number of font ids in mCache referring to the font.
+    size_t users;
+    size_t dataBytes;
+  };
+
+  void trim() {
+    while (mCache.size() > mCapacity) {
+      mCache.removeOldest();
+    }
+  }
 
   android::LruCache<int32_t, hb_font_t*> mCache;
+  size_t mCapacity;
+  std::unordered_map<hb_font_t*, FontEntry> mFonts;
+  std::unordered_map<size_t, hb_font_t*> mFontsByContent;
 };
 
 HbFontCache* getFontCacheLocked() {
@@ -68,6 +134,32 @@ void purgeHbFontCacheLocked() {
   getFontCacheLocked()->clear();
 }
 
+void setHbFontCacheCapacityLocked(size_t capacity) {
+  assertMinikinLocked();
+  getFontCacheLocked()->setCapacity(capacity);
+}
+
+HbFontCacheStats getHbFontCacheStatsLocked() {
+  assertMinikinLocked();
+  return getFontCacheLocked()->getStats();
+}
+
+// libtxt extension: the key under which fonts with the same data and
+// variations share a HarfBuzz font, or 0 if the data can not be identified.
+static size_t getContentKey(const MinikinFont* minikinFont) {
+  const size_t contentHash = minikinFont->GetContentHash();
+  if (contentHash == 0) {
+    return 0;
+  }
+  size_t key = contentHash;
+  for (const FontVariation& variation : minikinFont->GetAxes()) {
+    uint32_t value;
+    memcpy(&value, &variation.value, sizeof(value));
+    key = key * 31 + android::JenkinsHashMix(variation.axisTag, value);
+  }
+  return key == 0 ? 1 : key;
+}
+
 void purgeHbFontLocked(const MinikinFont* minikinFont) {
   assertMinikinLocked();
   const int32_t fontId = minikinFont->GetUniqueId();
@@ -94,6 +186,13 @@ hb_font_t* getHbFontLocked(const MinikinFont* minikinFont) {
     return hb_font_reference(font);
   }
 
+  const size_t contentKey = getContentKey(minikinFont);
+  font = fontCache->getByContent(contentKey);
+  if (font != nullptr) {
+    fontCache->put(fontId, hb_font_reference(font), contentKey);
+    return hb_font_reference(font);
+  }
+
   hb_face_t* face = minikinFont->CreateHarfBuzzFace();
 
   hb_font_t* parent_font = hb_font_create(face);
@@ -110,7 +209,7 @@ hb_font_t* getHbFontLocked(const MinikinFont* minikinFont) {
   hb_font_set_variations(font, variations.data(), variations.size());
   hb_font_destroy(parent_font);
   hb_face_destroy(face);
-  fontCache->put(fontId, font);
+  fontCache->put(fontId, font, contentKey);
   return hb_font_reference(font);
 }
 
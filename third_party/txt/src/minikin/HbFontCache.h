@@ -17,6 +17,8 @@
 #ifndef MINIKIN_HBFONT_CACHE_H
 #define MINIKIN_HBFONT_CACHE_H
 
+#include <cstddef>
+
 struct hb_font_t;
 
 namespace minikin {
@@ -26,5 +28,23 @@ void purgeHbFontCacheLocked();
 void purgeHbFontLocked(const MinikinFont* minikinFont);
 hb_font_t* getHbFontLocked(const MinikinFont* minikinFont);
 
+// libtxt extension: the number of font ids for which HarfBuzz fonts are
+// retained. Defaults to kDefaultHbFontCacheCapacity.
+const size_t kDefaultHbFontCacheCapacity = 100;
+void setHbFontCacheCapacityLocked(size_t capacity);
+
+// libtxt extension: memory accounting of the HarfBuzz font cache.
+struct HbFontCacheStats {
+  // The number of cached font ids.
+  size_t entryCount;
+  // The number of distinct HarfBuzz fonts, which is lower than entryCount when
+  // fonts with different ids share the same data.
+  size_t fontCount;
+  // The size of the font data that the HarfBuzz faces map from the Skia
+  // typefaces without copying it.
+  size_t sharedDataBytes;
+};
+HbFontCacheStats getHbFontCacheStatsLocked();
+
 }  // namespace minikin
 #endif  // MINIKIN_HBFONT_CACHE_H
@@ -20,6 +20,7 @@
 #include <unicode/ubidi.h>
 #include <unicode/utf16.h>
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>  // for debugging
 #include <string>
@@ -30,6 +31,8 @@
 #include <utils/LruCache.h>
 #include <utils/WindowsUtils.h>
 
+#include "flutter/fml/trace_event.h"
+
 #include <hb-icu.h>
 #include <hb-ot.h>
 
@@ -89,6 +92,10 @@ class LayoutCacheKey {
 
   android::hash_t hash() const { return mHash; }
 
+  size_t getMemoryUsage() const {
+    return sizeof(*this) + mNchars * sizeof(uint16_t);
+  }
+
   void copyText() {
     uint16_t* charsCopy = new uint16_t[mNchars];
     memcpy(charsCopy, mChars, mNchars * sizeof(uint16_t));
@@ -129,42 +136,147 @@ class LayoutCacheKey {
   android::hash_t computeHash() const;
 };
 
-class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
+// libtxt extension: the cache is split into shards selected by the key hash,
+// each with its own lock and an equal share of the byte budget. Lookups never
+// take gMinikinLock, only the shaping of words that miss the cache does, so
+// threads laying out text that is already cached don't wait for each other.
+class LayoutCache {
  public:
-  LayoutCache() : mCache(kMaxEntries) {
-    mCache.setOnEntryRemovedListener(this);
+  LayoutCache() : mMaxBytes(0), mHitCount(0), mMissCount(0) {
+    setMaxBytes(kDefaultMaxBytes);
+  }
+
+  void clear() {
+    for (Shard& shard : mShards) {
+      std::scoped_lock _l(shard.mutex);
+      shard.cache.clear();
+    }
+    traceStats();
+  }
+
+  void setMaxBytes(size_t maxBytes) {
+    mMaxBytes = maxBytes;
+    for (Shard& shard : mShards) {
+      std::scoped_lock _l(shard.mutex);
+      shard.maxBytes = maxBytes / kShardCount;
+      shard.evictLocked();
+    }
+    traceStats();
+  }
+
+  LayoutCacheStats getStats() {
+    LayoutCacheStats stats = {0, 0, mMaxBytes, mHitCount, mMissCount};
+    for (Shard& shard : mShards) {
+      std::scoped_lock _l(shard.mutex);
+      stats.entryCount += shard.cache.size();
+      stats.byteCount += shard.byteCount;
+    }
+    return stats;
   }
 
-  void clear() { mCache.clear(); }
-
-  Layout* get(LayoutCacheKey& key,
-              LayoutContext* ctx,
-              const std::shared_ptr<FontCollection>& collection) {
-    Layout* layout = mCache.get(key);
-    if (layout == NULL) {
-      key.copyText();
-      layout = new Layout();
-      key.doLayout(layout, ctx, collection);
-      mCache.put(key, layout);
+  std::shared_ptr<Layout> get(
+      LayoutCacheKey& key,
+      LayoutContext* ctx,
+      const std::shared_ptr<FontCollection>& collection) {
+    Shard& shard = mShards[key.hash() % kShardCount];
+    std::shared_ptr<Layout> layout;
+    {
+      std::scoped_lock _l(shard.mutex);
+      layout = shard.cache.get(key);
     }
+    if (layout != nullptr) {
+      countLookup(&mHitCount);
+      return layout;
+    }
+    countLookup(&mMissCount);
+
+    // The shard is not locked while shaping, so another thread may lay out
+    // the same word concurrently. The first one to finish caches it.
+    layout = std::make_shared<Layout>();
+    {
+      std::scoped_lock _l(gMinikinLock);
+      key.doLayout(layout.get(), ctx, collection);
+      ctx->clearHbFonts();
+    }
+
+    std::scoped_lock _l(shard.mutex);
+    if (getEntryBytes(key, layout) > shard.maxBytes) {
+      return layout;
+    }
+    key.copyText();
+    if (!shard.cache.put(key, layout)) {
+      key.freeText();
+      return layout;
+    }
+    shard.byteCount += getEntryBytes(key, layout);
+    shard.evictLocked();
     return layout;
   }
 
  private:
-  // callback for OnEntryRemoved
-  void operator()(LayoutCacheKey& key, Layout*& value) {
-    key.freeText();
-    delete value;
+  typedef android::LruCache<LayoutCacheKey, std::shared_ptr<Layout>> Cache;
+
+  class Shard
+      : private android::OnEntryRemoved<LayoutCacheKey,
+                                        std::shared_ptr<Layout>> {
+   public:
+    Shard() : cache(Cache::kUnlimitedCapacity), maxBytes(0), byteCount(0) {
+      cache.setOnEntryRemovedListener(this);
+    }
+
+    void evictLocked() {
+      while (byteCount > maxBytes && cache.removeOldest()) {
+      }
+    }
+
+    std::mutex mutex;
+    Cache cache;
+    size_t maxBytes;
+    size_t byteCount;
+
+   private:
+    // callback for OnEntryRemoved
+    void operator()(LayoutCacheKey& key, std::shared_ptr<Layout>& value) {
+      byteCount -= getEntryBytes(key, value);
+      key.freeText();
+      // Layouts that are still being appended elsewhere stay alive until
+      // they're done.
+      value.reset();
+    }
+  };
+
+  static size_t getEntryBytes(const LayoutCacheKey& key,
+                              const std::shared_ptr<Layout>& layout) {
+    return key.getMemoryUsage() + layout->getMemoryUsage();
   }
 
-  android::LruCache<LayoutCacheKey, Layout*> mCache;
+  void countLookup(std::atomic<uint64_t>* counter) {
+    const uint64_t count = ++*counter;
+    if (count % kTraceInterval == 0) {
+      traceStats();
+    }
+  }
+
+  void traceStats() {
+#if !FLUTTER_RELEASE
+    const LayoutCacheStats stats = getStats();
+    FML_TRACE_COUNTER("flutter", "LayoutCache",
+                      reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                      "Entries", stats.entryCount, "Bytes", stats.byteCount,
+                      "Hits", stats.hitCount, "Misses", stats.missCount);
+#endif  // !FLUTTER_RELEASE
+  }
 
-  // static const size_t kMaxEntries = LruCache<LayoutCacheKey,
-  // Layout*>::kUnlimitedCapacity;
+  // Roughly the size of the previous limit of 5000 words.
+  static const size_t kDefaultMaxBytes = 2 * 1024 * 1024;
+  static const size_t kShardCount = 16;
+  // The number of hits or misses between updates of the trace counters.
+  static const uint64_t kTraceInterval = 1024;
 
-  // TODO: eviction based on memory footprint; for now, we just use a constant
-  // number of strings
-  static const size_t kMaxEntries = 5000;
+  Shard mShards[kShardCount];
+  std::atomic<size_t> mMaxBytes;
+  std::atomic<uint64_t> mHitCount;
+  std::atomic<uint64_t> mMissCount;
 };
 
 class LayoutEngine {
@@ -588,8 +700,6 @@ void Layout::doLayout(const uint16_t* buf,
                       const FontStyle& style,
                       const MinikinPaint& paint,
                       const std::shared_ptr<FontCollection>& collection) {
-  std::scoped_lock _l(gMinikinLock);
-
   LayoutContext ctx;
   ctx.style = style;
   ctx.paint = paint;
@@ -599,8 +709,6 @@ void Layout::doLayout(const uint16_t* buf,
 
   doLayoutRunCached(buf, start, count, bufSize, isRtl, &ctx, start, collection,
                     this, NULL);
-
-  ctx.clearHbFonts();
 }
 
 float Layout::measureText(const uint16_t* buf,
@@ -612,16 +720,12 @@ float Layout::measureText(const uint16_t* buf,
                           const MinikinPaint& paint,
                           const std::shared_ptr<FontCollection>& collection,
                           float* advances) {
-  std::scoped_lock _l(gMinikinLock);
-
   LayoutContext ctx;
   ctx.style = style;
   ctx.paint = paint;
 
   float advance = doLayoutRunCached(buf, start, count, bufSize, isRtl, &ctx, 0,
                                     collection, NULL, advances);
-
-  ctx.clearHbFonts();
   return advance;
 }
 
@@ -711,7 +815,11 @@ float Layout::doLayoutWord(const uint16_t* buf,
   float advance;
   if (ctx->paint.skipCache()) {
     Layout layoutForWord;
-    key.doLayout(&layoutForWord, ctx, collection);
+    {
+      std::scoped_lock _l(gMinikinLock);
+      key.doLayout(&layoutForWord, ctx, collection);
+      ctx->clearHbFonts();
+    }
     if (layout) {
       layout->appendLayout(&layoutForWord, bufStart, wordSpacing);
     }
@@ -720,9 +828,9 @@ float Layout::doLayoutWord(const uint16_t* buf,
     }
     advance = layoutForWord.getAdvance();
   } else {
-    Layout* layoutForWord = cache.get(key, ctx, collection);
+    std::shared_ptr<Layout> layoutForWord = cache.get(key, ctx, collection);
     if (layout) {
-      layout->appendLayout(layoutForWord, bufStart, wordSpacing);
+      layout->appendLayout(layoutForWord.get(), bufStart, wordSpacing);
     }
     if (advances) {
       layoutForWord->getAdvances(advances);
@@ -1192,11 +1300,24 @@ void Layout::getBounds(MinikinRect* bounds) const {
   bounds->set(mBounds);
 }
 
+size_t Layout::getMemoryUsage() const {
+  return sizeof(*this) + mGlyphs.capacity() * sizeof(LayoutGlyph) +
+         mAdvances.capacity() * sizeof(float) +
+         mFaces.capacity() * sizeof(FakedFont);
+}
+
 void Layout::purgeCaches() {
+  LayoutEngine::getInstance().layoutCache.clear();
   std::scoped_lock _l(gMinikinLock);
-  LayoutCache& layoutCache = LayoutEngine::getInstance().layoutCache;
-  layoutCache.clear();
   purgeHbFontCacheLocked();
 }
 
+void Layout::setCacheMaxBytes(size_t maxBytes) {
+  LayoutEngine::getInstance().layoutCache.setMaxBytes(maxBytes);
+}
+
+LayoutCacheStats Layout::getCacheStats() {
+  return LayoutEngine::getInstance().layoutCache.getStats();
+}
+
 }  // namespace minikin
@@ -57,6 +57,15 @@ enum {
   kBidi_Mask = 0x7
 };
 
+// libtxt extension: usage of the process wide cache of laid out words.
+struct LayoutCacheStats {
+  size_t entryCount;
+  size_t byteCount;
+  size_t maxBytes;
+  uint64_t hitCount;
+  uint64_t missCount;
+};
+
 // Lifecycle and threading assumptions for Layout:
 // The object is assumed to be owned by a single thread; multiple threads
 // may not mutate it at the same time.
@@ -117,7 +126,15 @@ class Layout {
   // Purge all caches, useful in low memory conditions
   static void purgeCaches();
 
+  // libtxt extension: the cache of laid out words is shared by every thread
+  // and split into shards with their own locks, so that only the shaping of
+  // words that are not cached yet is serialized. Changing the budget evicts
+  // the least recently used words that no longer fit.
+  static void setCacheMaxBytes(size_t maxBytes);
+  static LayoutCacheStats getCacheStats();
+
  private:
+  friend class LayoutCache;
   friend class LayoutCacheKey;
 
   // Find a face in the mFaces vector, or create a new entry
@@ -165,6 +182,9 @@ class Layout {
   // Append another layout (for example, cached value) into this one
   void appendLayout(Layout* src, size_t start, float extraAdvance);
 
+  // An estimate of the memory held by this layout, used for the cache budget
+  size_t getMemoryUsage() const;
+
   std::vector<LayoutGlyph> mGlyphs;
   std::vector<float> mAdvances;
 
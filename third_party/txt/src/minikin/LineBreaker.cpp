@@ -83,6 +83,8 @@ void LineBreaker::setText() {
   Candidate cand = {0,   0, 0.0, 0.0, 0.0,
                     0.0, 0, 0,   0,   HyphenationType::DONT_BREAK};
   mCandidates.push_back(cand);
+  mWordBreaks.clear();
+  mHyphenPenaltyPerWidth = 0.0f;
 
   // reset greedy breaker state
   mBreaks.clear();
@@ -129,28 +131,34 @@ float LineBreaker::addStyleRun(MinikinPaint* paint,
                                bool isRtl) {
   float width = 0.0f;
 
-  float hyphenPenalty = 0.0;
+  // libtxt: the penalties are kept relative to the line width so that the
+  // word breaks can be replayed at another width by addWordBreaks.
+  float hyphenPenaltyPerWidth = 0.0;
   if (paint != nullptr) {
     width = Layout::measureText(mTextBuf.data(), start, end - start,
                                 mTextBuf.size(), isRtl, style, *paint, typeface,
                                 mCharWidths.data() + start);
 
     // a heuristic that seems to perform well
-    hyphenPenalty =
-        0.5 * paint->size * paint->scaleX * mLineWidths.getLineWidth(0);
+    hyphenPenaltyPerWidth = 0.5 * paint->size * paint->scaleX;
     if (mHyphenationFrequency == kHyphenationFrequency_Normal) {
-      hyphenPenalty *=
+      hyphenPenaltyPerWidth *=
           4.0;  // TODO: Replace with a better value after some testing
     }
 
     if (mJustified) {
       // Make hyphenation more aggressive for fully justified text (so that
       // "normal" in justified mode is the same as "full" in ragged-right).
-      hyphenPenalty *= 0.25;
-    } else {
+      hyphenPenaltyPerWidth *= 0.25;
+    }
+    mHyphenPenaltyPerWidth =
+        std::max(mHyphenPenaltyPerWidth, hyphenPenaltyPerWidth);
+    if (!mJustified) {
       // Line penalty is zero for justified text.
       mLinePenalty =
-          std::max(mLinePenalty, hyphenPenalty * LINE_PENALTY_MULTIPLIER);
+          std::max(mLinePenalty, hyphenPenaltyPerWidth *
+                                     mLineWidths.getLineWidth(0) *
+                                     LINE_PENALTY_MULTIPLIER);
     }
   }
 
@@ -209,8 +217,10 @@ float LineBreaker::addStyleRun(MinikinPaint* paint,
                 style, *paint, typeface, nullptr);
             ParaWidth hyphPreBreak = postBreak - secondPartWidth;
 
-            addWordBreak(j, hyphPreBreak, hyphPostBreak, postSpaceCount,
-                         postSpaceCount, hyphenPenalty, hyph);
+            mWordBreaks.push_back({j, hyphPreBreak, hyphPostBreak,
+                                   postSpaceCount, postSpaceCount,
+                                   hyphenPenaltyPerWidth, hyph});
+            addRecordedWordBreak(mWordBreaks.back());
 
             paint->hyphenEdit = HyphenEdit::NO_EDIT;
           }
@@ -219,9 +229,12 @@ float LineBreaker::addStyleRun(MinikinPaint* paint,
 
       // Skip break for zero-width characters inside replacement span
       if (paint != nullptr || current == end || mCharWidths[current] > 0) {
-        float penalty = hyphenPenalty * mWordBreaker.breakBadness();
-        addWordBreak(current, mWidth, postBreak, mSpaceCount, postSpaceCount,
-                     penalty, HyphenationType::DONT_BREAK);
+        float penaltyPerWidth =
+            hyphenPenaltyPerWidth * mWordBreaker.breakBadness();
+        mWordBreaks.push_back({current, mWidth, postBreak, mSpaceCount,
+                               postSpaceCount, penaltyPerWidth,
+                               HyphenationType::DONT_BREAK});
+        addRecordedWordBreak(mWordBreaks.back());
       }
       lastBreak = current;
       lastBreakWidth = mWidth;
@@ -232,6 +245,27 @@ float LineBreaker::addStyleRun(MinikinPaint* paint,
   return width;
 }
 
+void LineBreaker::addWordBreaks(const std::vector<WordBreak>& wordBreaks,
+                                float hyphenPenaltyPerWidth) {
+  mHyphenPenaltyPerWidth = hyphenPenaltyPerWidth;
+  if (!mJustified) {
+    mLinePenalty = std::max(mLinePenalty, hyphenPenaltyPerWidth *
+                                              mLineWidths.getLineWidth(0) *
+                                              LINE_PENALTY_MULTIPLIER);
+  }
+  for (const WordBreak& wordBreak : wordBreaks) {
+    mWordBreaks.push_back(wordBreak);
+    addRecordedWordBreak(wordBreak);
+  }
+}
+
+void LineBreaker::addRecordedWordBreak(const WordBreak& wordBreak) {
+  addWordBreak(wordBreak.offset, wordBreak.preBreak, wordBreak.postBreak,
+               wordBreak.preSpaceCount, wordBreak.postSpaceCount,
+               wordBreak.penaltyPerWidth * mLineWidths.getLineWidth(0),
+               wordBreak.hyphenType);
+}
+
 // add a word break (possibly for a hyphenated fragment), and add desperate
 // breaks if needed (ie when word exceeds current line width)
 void LineBreaker::addWordBreak(size_t offset,
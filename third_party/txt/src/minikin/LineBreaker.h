@@ -165,6 +165,33 @@ class LineBreaker {
 
   const int* getFlags() const { return mFlags.data(); }
 
+  // libtxt extension: a break opportunity found by addStyleRun. Unlike the
+  // resulting candidates, these only depend on the text and its styles, so
+  // they can be replayed to break the same text at another width without
+  // measuring it again.
+  struct WordBreak {
+    size_t offset;
+    double preBreak;
+    double postBreak;
+    size_t preSpaceCount;
+    size_t postSpaceCount;
+    float penaltyPerWidth;  // multiplied by the first line width
+    HyphenationType hyphenType;
+  };
+
+  // libtxt extension: the word breaks added by addStyleRun since setText.
+  const std::vector<WordBreak>& getWordBreaks() const { return mWordBreaks; }
+
+  // libtxt extension: the largest hyphen penalty per unit of line width of the
+  // style runs added since setText.
+  float getHyphenPenaltyPerWidth() const { return mHyphenPenaltyPerWidth; }
+
+  // libtxt extension: adds the word breaks previously returned by
+  // getWordBreaks for the same text instead of calling addStyleRun. The char
+  // widths measured for that text must have been restored in charWidths().
+  void addWordBreaks(const std::vector<WordBreak>& wordBreaks,
+                     float hyphenPenaltyPerWidth);
+
   void finish();
 
  private:
@@ -201,6 +228,8 @@ class LineBreaker {
                     float penalty,
                     HyphenationType hyph);
 
+  void addRecordedWordBreak(const WordBreak& wordBreak);
+
   void addCandidate(Candidate cand);
   void pushGreedyBreak();
 
@@ -237,6 +266,8 @@ class LineBreaker {
   ParaWidth mWidth = 0;
   std::vector<Candidate> mCandidates;
   float mLinePenalty = 0.0f;
+  std::vector<WordBreak> mWordBreaks;
+  float mHyphenPenaltyPerWidth = 0.0f;
 
   // the following are state for greedy breaker (updated while adding style
   // runs)
@@ -103,6 +103,13 @@ class MinikinFont {
 
   virtual hb_face_t* CreateHarfBuzzFace() const { return nullptr; }
 
+  // libtxt extension: a hash identifying the font data, equal for fonts with
+  // different unique ids that were loaded from the same data, or 0 if the
+  // data can not be identified. Fonts with equal hashes share HarfBuzz fonts.
+  // The face returned by CreateHarfBuzzFace() must then stay valid after this
+  // font is destroyed.
+  virtual size_t GetContentHash() const { return 0; }
+
   virtual const std::vector<minikin::FontVariation>& GetAxes() const = 0;
 
   virtual std::shared_ptr<MinikinFont> createFontWithVariation(
@@ -105,6 +105,49 @@ void SparseBitSet::initFromRanges(const uint32_t* ranges, size_t nRanges) {
     }
     nonzeroPageEnd = endPage + 1;
   }
+  shareFullPages(nPages);
+}
+
+// libtxt extension: fonts for CJK and other large scripts cover many complete
+// pages, which can all use a single page of ones the same way that missing
+// pages use a single page of zeros.
+void SparseBitSet::shareFullPages(uint32_t nPages) {
+  const uint32_t elementsPerPage = 1 << (kLogValuesPerPage - kLogBitsPerEl);
+  const uint32_t nIndices = (mMaxVal + kPageMask) >> kLogValuesPerPage;
+  std::vector<uint16_t> newIndexForPage(nPages, noZeroPage);
+  uint32_t nNewPages = 0;
+  uint16_t fullPageIndex = noZeroPage;
+  for (uint32_t page = 0; page < nPages; page++) {
+    const element* bitmap = &mBitmaps[page * elementsPerPage];
+    bool isFull = true;
+    for (uint32_t j = 0; j < elementsPerPage && isFull; j++) {
+      isFull = bitmap[j] == kElAllOnes;
+    }
+    if (isFull && fullPageIndex != noZeroPage) {
+      newIndexForPage[page] = fullPageIndex;
+      continue;
+    }
+    newIndexForPage[page] = (nNewPages++) * elementsPerPage;
+    if (isFull) {
+      fullPageIndex = newIndexForPage[page];
+    }
+  }
+  if (nNewPages == nPages) {
+    return;
+  }
+
+  std::unique_ptr<element[]> bitmaps(new element[nNewPages * elementsPerPage]);
+  for (uint32_t page = 0; page < nPages; page++) {
+    memcpy(&bitmaps[newIndexForPage[page]], &mBitmaps[page * elementsPerPage],
+           elementsPerPage * sizeof(element));
+  }
+  for (uint32_t i = 0; i < nIndices; i++) {
+    mIndices[i] = newIndexForPage[mIndices[i] / elementsPerPage];
+  }
+  if (mZeroPageIndex != noZeroPage) {
+    mZeroPageIndex = newIndexForPage[mZeroPageIndex / elementsPerPage];
+  }
+  mBitmaps = std::move(bitmaps);
 }
 
 #if defined(_WIN32)
@@ -118,6 +161,56 @@ int SparseBitSet::CountLeadingZeros(element x) {
 }
 #endif
 
+std::vector<uint32_t> SparseBitSet::getRanges() const {
+  std::vector<uint32_t> ranges;
+  const uint32_t nElements = (mMaxVal + kElMask) >> kLogBitsPerEl;
+  bool inRange = false;
+  for (uint32_t i = 0; i < nElements; i++) {
+    const uint32_t base = i << kLogBitsPerEl;
+    const element e =
+        mBitmaps[mIndices[base >> kLogValuesPerPage] +
+                 ((base & kPageMask) >> kLogBitsPerEl)];
+    if (e == (inRange ? kElAllOnes : 0)) {
+      continue;
+    }
+    for (uint32_t bit = 0; bit <= kElMask; bit++) {
+      if (((e & (kElFirst >> bit)) != 0) != inRange) {
+        ranges.push_back(base + bit);
+        inRange = !inRange;
+      }
+    }
+  }
+  if (inRange) {
+    ranges.push_back(mMaxVal);
+  }
+  return ranges;
+}
+
+size_t SparseBitSet::getCoveredLength(const uint16_t* text,
+                                      size_t size) const {
+  const uint32_t bmpEnd = mMaxVal < 0x10000 ? mMaxVal : 0x10000;
+  uint32_t currentPage = kNotFound;
+  const element* bitmap = nullptr;
+  size_t i = 0;
+  for (; i < size; i++) {
+    const uint32_t ch = text[i];
+    if (ch >= bmpEnd || (ch >= 0xD800 && ch < 0xE000)) {
+      break;
+    }
+    const uint32_t page = ch >> kLogValuesPerPage;
+    if (page != currentPage) {
+      currentPage = page;
+      bitmap = &mBitmaps[mIndices[page]];
+    }
+    const uint32_t index = ch & kPageMask;
+    if ((bitmap[index >> kLogBitsPerEl] & (kElFirst >> (index & kElMask))) ==
+        0) {
+      break;
+    }
+  }
+  return i;
+}
+
 uint32_t SparseBitSet::nextSetBit(uint32_t fromIndex) const {
   if (fromIndex >= mMaxVal) {
     return kNotFound;
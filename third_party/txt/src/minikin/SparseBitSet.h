@@ -21,6 +21,7 @@
 #include <sys/types.h>
 
 #include <memory>
+#include <vector>
 
 // ---------------------------------------------------------------------------
 
@@ -65,6 +66,15 @@ class SparseBitSet {
 
   static const uint32_t kNotFound = ~0u;
 
+  // libtxt extension: the values in the set as pairs of range starts
+  // (inclusive) and ends (exclusive), in the form accepted by the constructor.
+  std::vector<uint32_t> getRanges() const;
+
+  // libtxt extension: the number of leading UTF-16 code units of |text| that
+  // are in the set, stopping at the first surrogate. Consecutive values in the
+  // same page share a single index lookup.
+  size_t getCoveredLength(const uint16_t* text, size_t size) const;
+
  private:
   void initFromRanges(const uint32_t* ranges, size_t nRanges);
 
@@ -81,6 +91,7 @@ class SparseBitSet {
   static const uint16_t noZeroPage = 0xFFFF;
 
   static uint32_t calcNumPages(const uint32_t* ranges, size_t nRanges);
+  void shareFullPages(uint32_t nPages);
   static int CountLeadingZeros(element x);
 
   uint32_t mMaxVal;
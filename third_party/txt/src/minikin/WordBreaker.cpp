@@ -26,6 +26,12 @@
 #include <unicode/uchar.h>
 #include <unicode/utf16.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace minikin {
 
 const uint32_t CHAR_SOFT_HYPHEN = 0x00AD;
@@ -51,6 +57,136 @@ void WordBreaker::setLocale() {
   mIteratorWasReset = true;
 }
 
+// libtxt extension: the characters for which the line break class is AL
+// (alphabetic) or NU (numeric), and which therefore never allow a break
+// between each other.
+static bool isLatinLetterOrDigit(uint16_t c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || (c >= 0x00C0 && c <= 0x017F && c != 0x00D7 &&
+                                    c != 0x00F7);
+}
+
+// libtxt extension: the IS (infix separator) and EX (exclamation) punctuation
+// characters, which never allow a break before them.
+static bool isSentencePunctuation(uint16_t c) {
+  return c == '.' || c == ',' || c == ';' || c == ':' || c == '!' || c == '?';
+}
+
+// libtxt extension: returns the number of leading characters of |text| that
+// are ASCII letters or spaces, looking at several characters at a time.
+static size_t countLettersAndSpaces(const uint16_t* text, size_t size) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i caseBit = _mm_set1_epi16(0x20);
+  const __m128i lowerA = _mm_set1_epi16('a');
+  const __m128i lastLetter = _mm_set1_epi16('z' - 'a');
+  for (; i + 8 <= size; i += 8) {
+    const __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+    // (c | 0x20) - 'a' is at most 'z' - 'a' exactly for ASCII letters.
+    const __m128i offset = _mm_sub_epi16(_mm_or_si128(chars, caseBit), lowerA);
+    const __m128i isLetter = _mm_cmpeq_epi16(
+        _mm_subs_epu16(offset, lastLetter), _mm_setzero_si128());
+    const __m128i isSpace = _mm_cmpeq_epi16(chars, caseBit);
+    if (_mm_movemask_epi8(_mm_or_si128(isLetter, isSpace)) != 0xFFFF) {
+      break;
+    }
+  }
+#elif defined(__ARM_NEON)
+  const uint16x8_t caseBit = vdupq_n_u16(0x20);
+  const uint16x8_t lowerA = vdupq_n_u16('a');
+  const uint16x8_t lastLetter = vdupq_n_u16('z' - 'a');
+  for (; i + 8 <= size; i += 8) {
+    const uint16x8_t chars = vld1q_u16(text + i);
+    const uint16x8_t offset = vsubq_u16(vorrq_u16(chars, caseBit), lowerA);
+    const uint16x8_t matches =
+        vorrq_u16(vcleq_u16(offset, lastLetter), vceqq_u16(chars, caseBit));
+    const uint8x8_t narrowed = vmovn_u16(matches);
+    if (vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) != ~0ull) {
+      break;
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    const uint16_t c = text[i];
+    if (c != ' ' && !((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))) {
+      break;
+    }
+  }
+  return i;
+}
+
+// libtxt extension: returns the offset of the first space in |text| at or
+// after |start|, or |size| if there is none.
+static size_t findSpace(const uint16_t* text, size_t start, size_t size) {
+  size_t i = start;
+#if defined(__SSE2__)
+  const __m128i space = _mm_set1_epi16(' ');
+  for (; i + 8 <= size; i += 8) {
+    const __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+    const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(chars, space));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask) / 2;
+    }
+  }
+#elif defined(__ARM_NEON)
+  const uint16x8_t space = vdupq_n_u16(' ');
+  for (; i + 8 <= size; i += 8) {
+    const uint8x8_t matches = vmovn_u16(vceqq_u16(vld1q_u16(text + i), space));
+    const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(matches), 0);
+    if (mask != 0) {
+      return i + __builtin_ctzll(mask) / 8;
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    if (text[i] == ' ') {
+      break;
+    }
+  }
+  return i;
+}
+
+// libtxt extension: whether the only line break opportunities in |text| are
+// after runs of spaces. This holds for Latin letters, digits and spaces (UAX
+// #14 rules LB18, LB23 and LB28), and for punctuation that never allows a
+// break before it (LB13) as long as it does not follow a space and is not
+// followed by a letter or digit (which may be a break opportunity).
+static bool isSimpleLatinText(const uint16_t* text, size_t size) {
+  size_t i = 0;
+  while ((i += countLettersAndSpaces(text + i, size - i)) < size) {
+    const uint16_t c = text[i];
+    if (isSentencePunctuation(c)) {
+      if (i > 0 && text[i - 1] == ' ') {
+        return false;
+      }
+      if (i + 1 < size && isLatinLetterOrDigit(text[i + 1])) {
+        return false;
+      }
+    } else if (!isLatinLetterOrDigit(c)) {
+      return false;
+    }
+    i++;
+  }
+  return true;
+}
+
+// libtxt extension: the break following |current| in text for which
+// isSimpleLatinText() holds, matching what the ICU iterator would return.
+static ssize_t nextLatinBreak(const uint16_t* text,
+                              size_t size,
+                              ssize_t current) {
+  if (current < 0 || (size_t)current >= size) {
+    return icu::BreakIterator::DONE;
+  }
+  size_t i = findSpace(text, current, size);
+  while (i < size && text[i] == ' ') {
+    i++;
+  }
+  return i;
+}
+
 void WordBreaker::setText(const uint16_t* data, size_t size) {
   mText = data;
   mTextSize = size;
@@ -59,9 +195,14 @@ void WordBreaker::setText(const uint16_t* data, size_t size) {
   mCurrent = 0;
   mScanOffset = 0;
   mInEmailOrUrl = false;
+  mUseLatinFastPath = mLatinFastPathEnabled && isSimpleLatinText(data, size);
   UErrorCode status = U_ZERO_ERROR;
   utext_openUChars(&mUText, reinterpret_cast<const UChar*>(data), size,
                    &status);
+  if (mUseLatinFastPath) {
+    // The break iterator is not used until the next call to setText.
+    return;
+  }
   mBreakIterator->setText(&mUText, status);
   mBreakIterator->first();
 }
@@ -232,6 +373,12 @@ ssize_t WordBreaker::findNextBreakInEmailOrUrl() {
 ssize_t WordBreaker::next() {
   mLast = mCurrent;
 
+  if (mUseLatinFastPath) {
+    // Such text contains neither email addresses nor URLs.
+    mCurrent = nextLatinBreak(mText, mTextSize, mCurrent);
+    return mCurrent;
+  }
+
   detectEmailOrUrl();
   if (mInEmailOrUrl) {
     mCurrent = findNextBreakInEmailOrUrl();
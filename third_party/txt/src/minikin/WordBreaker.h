@@ -39,6 +39,17 @@ class WordBreaker {
 
   void setText(const uint16_t* data, size_t size);
 
+  // libtxt extension: text made only of Latin letters, digits, spaces and
+  // trailing sentence punctuation has a break opportunity after every run of
+  // spaces and nowhere else, so it is broken with a vectorized scan instead of
+  // the ICU break iterator. Takes effect on the next call to setText().
+  void setLatinFastPathEnabled(bool enabled) {
+    mLatinFastPathEnabled = enabled;
+  }
+
+  // Whether the current text is broken without the ICU break iterator.
+  bool isUsingLatinFastPath() const { return mUseLatinFastPath; }
+
   // Advance iterator to next word break. Return offset, or -1 if EOT
   ssize_t next();
 
@@ -68,6 +79,8 @@ class WordBreaker {
   ssize_t mLast;
   ssize_t mCurrent;
   bool mIteratorWasReset;
+  bool mLatinFastPathEnabled = true;
+  bool mUseLatinFastPath = false;
 
   // state for the email address / url detector
   ssize_t mScanOffset;
@@ -0,0 +1,280 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fallback_font_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+
+namespace txt {
+
+namespace {
+
+constexpr char kHeader[] = "flutter fallback fonts 2";
+
+// The first field of the records that hold the coverage of a family. All
+// other records start with a range number.
+constexpr char kCoverageRecord[] = "coverage";
+
+// Family names and locales are stored as tab separated fields, one record per
+// line.
+bool IsValidField(const std::string& field) {
+  return field.find_first_of("\t\n") == std::string::npos;
+}
+
+std::vector<std::string_view> SplitFields(std::string_view line) {
+  std::vector<std::string_view> fields;
+  size_t start = 0;
+  while (true) {
+    size_t end = line.find('\t', start);
+    fields.push_back(line.substr(start, end - start));
+    if (end == std::string_view::npos) {
+      return fields;
+    }
+    start = end + 1;
+  }
+}
+
+bool ParseNumber(std::string_view field, int base, uint64_t* value) {
+  std::string number(field);
+  char* end = nullptr;
+  *value = std::strtoull(number.c_str(), &end, base);
+  return !number.empty() && *end == '\0';
+}
+
+// Ranges are written as space separated hexadecimal numbers.
+bool ParseRanges(std::string_view field, std::vector<uint32_t>* ranges) {
+  size_t start = 0;
+  while (start < field.size()) {
+    size_t end = std::min(field.find(' ', start), field.size());
+    uint64_t value;
+    if (!ParseNumber(field.substr(start, end - start), 16, &value) ||
+        value > UINT32_MAX || (!ranges->empty() && value < ranges->back())) {
+      return false;
+    }
+    ranges->push_back(static_cast<uint32_t>(value));
+    start = end + 1;
+  }
+  return ranges->size() % 2 == 0;
+}
+
+}  // anonymous namespace
+
+bool FallbackFontCache::Key::operator==(const Key& other) const {
+  return range == other.range && locale == other.locale;
+}
+
+size_t FallbackFontCache::Key::Hasher::operator()(const Key& key) const {
+  return fml::HashCombine(key.range, key.locale);
+}
+
+FallbackFontCache::FallbackFontCache() = default;
+
+FallbackFontCache::~FallbackFontCache() = default;
+
+std::vector<std::string> FallbackFontCache::GetFamilies(
+    uint32_t ch,
+    const std::string& locale) const {
+  std::scoped_lock lock(mutex_);
+  auto found = families_.find({ch / kRangeSize, locale});
+  if (found == families_.end()) {
+    return {};
+  }
+  return found->second;
+}
+
+void FallbackFontCache::Add(uint32_t ch,
+                            const std::string& locale,
+                            const std::string& family) {
+  if (family.empty() || !IsValidField(family) || !IsValidField(locale)) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  std::vector<std::string>& families = families_[{ch / kRangeSize, locale}];
+  auto found = std::find(families.begin(), families.end(), family);
+  if (found == families.begin() && found != families.end()) {
+    return;
+  }
+  if (found != families.end()) {
+    families.erase(found);
+  } else if (families.size() == kMaxFamiliesPerRange) {
+    families.pop_back();
+  }
+  families.insert(families.begin(), family);
+  dirty_ = true;
+}
+
+size_t FallbackFontCache::GetRangeCount() const {
+  std::scoped_lock lock(mutex_);
+  return families_.size();
+}
+
+bool FallbackFontCache::GetCoverage(const std::string& family,
+                                    size_t content_hash,
+                                    Coverage* coverage) const {
+  std::scoped_lock lock(mutex_);
+  auto found = coverages_.find(family);
+  if (found == coverages_.end() || found->second.first != content_hash) {
+    return false;
+  }
+  *coverage = found->second.second;
+  return true;
+}
+
+void FallbackFontCache::AddCoverage(const std::string& family,
+                                    size_t content_hash,
+                                    Coverage coverage) {
+  if (family.empty() || !IsValidField(family)) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  auto& entry = coverages_[family];
+  if (entry.first == content_hash &&
+      entry.second.has_vs_table == coverage.has_vs_table &&
+      entry.second.ranges == coverage.ranges) {
+    return;
+  }
+  entry = {content_hash, std::move(coverage)};
+  dirty_ = true;
+}
+
+size_t FallbackFontCache::GetCoverageCount() const {
+  std::scoped_lock lock(mutex_);
+  return coverages_.size();
+}
+
+bool FallbackFontCache::Load(const fml::UniqueFD& directory) {
+  TRACE_EVENT0("flutter", "FallbackFontCache::Load");
+  auto mapping = fml::FileMapping::CreateReadOnly(directory, kFileName);
+  if (!mapping || mapping->GetSize() == 0) {
+    Deserialize({});
+    return false;
+  }
+  if (!Deserialize({reinterpret_cast<const char*>(mapping->GetMapping()),
+                    mapping->GetSize()})) {
+    FML_LOG(ERROR) << "Ignoring fallback font cache with unknown format.";
+    return false;
+  }
+  return true;
+}
+
+bool FallbackFontCache::Save(const fml::UniqueFD& directory) {
+  {
+    std::scoped_lock lock(mutex_);
+    if (!dirty_) {
+      return true;
+    }
+    dirty_ = false;
+  }
+  TRACE_EVENT0("flutter", "FallbackFontCache::Save");
+  if (!fml::WriteAtomically(directory, kFileName,
+                            fml::DataMapping(Serialize()))) {
+    std::scoped_lock lock(mutex_);
+    dirty_ = true;
+    return false;
+  }
+  return true;
+}
+
+std::string FallbackFontCache::Serialize() const {
+  std::scoped_lock lock(mutex_);
+  std::ostringstream stream;
+  stream << kHeader << '\n';
+  for (const auto& entry : families_) {
+    // Families are written from the least to the most recently resolved so
+    // that adding them in order restores the same order.
+    for (auto family = entry.second.rbegin(); family != entry.second.rend();
+         ++family) {
+      stream << entry.first.range << '\t' << entry.first.locale << '\t'
+             << *family << '\n';
+    }
+  }
+  for (const auto& entry : coverages_) {
+    const Coverage& coverage = entry.second.second;
+    stream << kCoverageRecord << '\t' << entry.first << '\t'
+           << entry.second.first << '\t' << (coverage.has_vs_table ? 1 : 0)
+           << '\t' << std::hex;
+    for (size_t i = 0; i < coverage.ranges.size(); i++) {
+      stream << (i == 0 ? "" : " ") << coverage.ranges[i];
+    }
+    stream << std::dec << '\n';
+  }
+  return stream.str();
+}
+
+bool FallbackFontCache::Deserialize(std::string_view data) {
+  std::unordered_map<Key, std::vector<std::string>, Key::Hasher> families;
+  std::unordered_map<std::string, std::pair<size_t, Coverage>> coverages;
+  bool valid = data.substr(0, data.find('\n')) == kHeader;
+  size_t line_start = data.find('\n');
+  while (valid && line_start != std::string_view::npos &&
+         line_start + 1 < data.size()) {
+    line_start++;
+    size_t line_end = data.find('\n', line_start);
+    if (line_end == std::string_view::npos) {
+      // The last record was not completely written.
+      break;
+    }
+    std::vector<std::string_view> fields =
+        SplitFields(data.substr(line_start, line_end - line_start));
+    line_start = line_end;
+
+    if (fields[0] == kCoverageRecord) {
+      uint64_t content_hash;
+      Coverage coverage;
+      if (fields.size() != 5 || fields[1].empty() ||
+          !ParseNumber(fields[2], 10, &content_hash) ||
+          (fields[3] != "0" && fields[3] != "1") ||
+          !ParseRanges(fields[4], &coverage.ranges)) {
+        valid = false;
+        break;
+      }
+      coverage.has_vs_table = fields[3] == "1";
+      coverages[std::string(fields[1])] = {static_cast<size_t>(content_hash),
+                                           std::move(coverage)};
+      continue;
+    }
+
+    uint64_t range;
+    if (fields.size() != 3 || !ParseNumber(fields[0], 10, &range) ||
+        range > UINT32_MAX || fields[2].empty()) {
+      valid = false;
+      break;
+    }
+    Key key = {static_cast<uint32_t>(range), std::string(fields[1])};
+    std::vector<std::string>& range_families = families[key];
+    range_families.insert(range_families.begin(), std::string(fields[2]));
+    if (range_families.size() > kMaxFamiliesPerRange) {
+      range_families.pop_back();
+    }
+  }
+
+  std::scoped_lock lock(mutex_);
+  families_ = valid ? std::move(families) : decltype(families_){};
+  coverages_ = valid ? std::move(coverages) : decltype(coverages_){};
+  dirty_ = false;
+  return valid;
+}
+
+}  // namespace txt
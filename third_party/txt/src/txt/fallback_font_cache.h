@@ -0,0 +1,126 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIB_TXT_SRC_FALLBACK_FONT_CACHE_H_
+#define LIB_TXT_SRC_FALLBACK_FONT_CACHE_H_
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace txt {
+
+// Remembers which font families the platform font manager resolved as the
+// fallback for ranges of code points in a given locale.
+//
+// Asking the platform for a fallback font is slow, especially for CJK and
+// emoji, while checking whether a known family covers a code point is cheap.
+// A FontCollection therefore first tries the families recorded for the range
+// of a code point. The cache is safe to share between font collections on
+// different threads and can be saved to and loaded from a directory so that
+// it survives restarts of the process.
+//
+// The cache also keeps the code point coverage of the families, so that a
+// restarted process does not need to parse their cmap tables again.
+class FallbackFontCache {
+ public:
+  static constexpr char kFileName[] = "io.flutter.fallback_fonts";
+
+  // Code points are grouped in aligned ranges of this size.
+  static constexpr uint32_t kRangeSize = 128;
+
+  // The number of families remembered for each range and locale.
+  static constexpr size_t kMaxFamiliesPerRange = 4;
+
+  FallbackFontCache();
+
+  ~FallbackFontCache();
+
+  // The families resolved for code points in the range of |ch|, the most
+  // recently resolved first.
+  std::vector<std::string> GetFamilies(uint32_t ch,
+                                       const std::string& locale) const;
+
+  // Records that the platform resolved |family| as the fallback for |ch|.
+  void Add(uint32_t ch, const std::string& locale, const std::string& family);
+
+  // The number of ranges that have at least one family.
+  size_t GetRangeCount() const;
+
+  // The code points covered by a font family.
+  struct Coverage {
+    // Pairs of range starts (inclusive) and ends (exclusive), in the form of
+    // minikin::SparseBitSet::getRanges().
+    std::vector<uint32_t> ranges;
+    bool has_vs_table = false;
+  };
+
+  // The coverage recorded for |family|, if it was recorded for fonts with the
+  // same |content_hash|.
+  bool GetCoverage(const std::string& family,
+                   size_t content_hash,
+                   Coverage* coverage) const;
+
+  // Records the coverage of |family|, whose fonts have |content_hash|.
+  void AddCoverage(const std::string& family,
+                   size_t content_hash,
+                   Coverage coverage);
+
+  size_t GetCoverageCount() const;
+
+  // Replaces the contents with the cache saved in |directory|.
+  //
+  // Returns false, leaving the cache empty, if there is no valid saved cache.
+  bool Load(const fml::UniqueFD& directory);
+
+  // Saves the cache to |directory| if anything was added since it was last
+  // loaded or saved.
+  //
+  // Returns false if the cache could not be written.
+  bool Save(const fml::UniqueFD& directory);
+
+  std::string Serialize() const;
+
+  bool Deserialize(std::string_view data);
+
+ private:
+  struct Key {
+    uint32_t range;
+    std::string locale;
+
+    bool operator==(const Key& other) const;
+
+    struct Hasher {
+      size_t operator()(const Key& key) const;
+    };
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<Key, std::vector<std::string>, Key::Hasher> families_;
+  std::unordered_map<std::string, std::pair<size_t, Coverage>> coverages_;
+  bool dirty_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FallbackFontCache);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_FALLBACK_FONT_CACHE_H_
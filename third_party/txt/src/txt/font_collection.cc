@@ -24,9 +24,11 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "font_skia.h"
+#include "minikin/FontLanguageListCache.h"
 #include "minikin/Layout.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
@@ -147,6 +149,11 @@ std::vector<sk_sp<SkFontMgr>> FontCollection::GetFontManagerOrder() const {
   return order;
 }
 
+void FontCollection::SetFallbackFontCache(
+    std::shared_ptr<FallbackFontCache> cache) {
+  fallback_font_cache_ = std::move(cache);
+}
+
 void FontCollection::DisableFontFallback() {
   enable_font_fallback_ = false;
 
@@ -302,16 +309,38 @@ std::shared_ptr<minikin::FontFamily> FontCollection::CreateMinikinFontFamily(
   SortSkTypefaces(skia_typefaces);
 
   std::vector<minikin::Font> minikin_fonts;
+  size_t content_hash = 0;
   for (const sk_sp<SkTypeface>& skia_typeface : skia_typefaces) {
     // Create the minikin font from the skia typeface.
     // Divide by 100 because the weights are given as "100", "200", etc.
+    auto font = std::make_shared<FontSkia>(skia_typeface);
     minikin_fonts.emplace_back(
-        std::make_shared<FontSkia>(skia_typeface),
-        minikin::FontStyle{skia_typeface->fontStyle().weight() / 100,
-                           skia_typeface->isItalic()});
+        font, minikin::FontStyle{skia_typeface->fontStyle().weight() / 100,
+                                 skia_typeface->isItalic()});
+    if (fallback_font_cache_ && manager == default_font_manager_) {
+      fml::HashCombineSeed(content_hash, font->GetContentHash());
+    }
   }
 
-  return std::make_shared<minikin::FontFamily>(std::move(minikin_fonts));
+  // The coverage of platform fonts is kept in the fallback font cache, which
+  // avoids parsing their cmap tables again after a restart.
+  if (content_hash == 0) {
+    return std::make_shared<minikin::FontFamily>(std::move(minikin_fonts));
+  }
+  FallbackFontCache::Coverage coverage;
+  if (fallback_font_cache_->GetCoverage(family_name, content_hash, &coverage)) {
+    return std::make_shared<minikin::FontFamily>(
+        minikin::FontLanguageListCache::kEmptyListId, 0,
+        std::move(minikin_fonts),
+        minikin::SparseBitSet(coverage.ranges.data(),
+                              coverage.ranges.size() / 2),
+        coverage.has_vs_table);
+  }
+  auto family = std::make_shared<minikin::FontFamily>(std::move(minikin_fonts));
+  fallback_font_cache_->AddCoverage(
+      family_name, content_hash,
+      {family->getCoverage().getRanges(), family->hasVSTable()});
+  return family;
 }
 
 const std::shared_ptr<minikin::FontFamily>& FontCollection::MatchFallbackFont(
@@ -334,6 +363,22 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
     uint32_t ch,
     std::string locale) {
   for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
+    // Asking the platform font manager is slow, so first try the families it
+    // resolved for nearby code points before.
+    const bool use_fallback_font_cache =
+        fallback_font_cache_ && manager == default_font_manager_;
+    if (use_fallback_font_cache) {
+      for (const std::string& family_name :
+           fallback_font_cache_->GetFamilies(ch, locale)) {
+        const std::shared_ptr<minikin::FontFamily>& family =
+            GetFallbackFontFamily(manager, family_name);
+        if (family && family->hasGlyph(ch, 0)) {
+          AddFallbackFontForLocale(locale, family_name);
+          return family;
+        }
+      }
+    }
+
     std::vector<const char*> bcp47;
     if (!locale.empty())
       bcp47.push_back(locale.c_str());
@@ -346,16 +391,24 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
     typeface->getFamilyName(&sk_family_name);
     std::string family_name(sk_family_name.c_str());
 
-    if (std::find(fallback_fonts_for_locale_[locale].begin(),
-                  fallback_fonts_for_locale_[locale].end(),
-                  family_name) == fallback_fonts_for_locale_[locale].end())
-      fallback_fonts_for_locale_[locale].push_back(family_name);
+    AddFallbackFontForLocale(locale, family_name);
+    if (use_fallback_font_cache) {
+      fallback_font_cache_->Add(ch, locale, family_name);
+    }
 
     return GetFallbackFontFamily(manager, family_name);
   }
   return g_null_family;
 }
 
+void FontCollection::AddFallbackFontForLocale(const std::string& locale,
+                                              const std::string& family_name) {
+  std::vector<std::string>& families = fallback_fonts_for_locale_[locale];
+  if (std::find(families.begin(), families.end(), family_name) ==
+      families.end())
+    families.push_back(family_name);
+}
+
 const std::shared_ptr<minikin::FontFamily>&
 FontCollection::GetFallbackFontFamily(const sk_sp<SkFontMgr>& manager,
                                       const std::string& family_name) {
@@ -18,7 +18,11 @@
 
 #include <minikin/MinikinFont.h>
 
+#include <string>
+#include <vector>
+
 #include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkStream.h"
 
 namespace txt {
 namespace {
@@ -42,6 +46,51 @@ hb_blob_t* GetTable(hb_face_t* face, hb_tag_t tag, void* context) {
                         HB_MEMORY_MODE_WRITABLE, buffer, free);
 }
 
+template <typename T>
+void AppendBytes(std::string* bytes, const T& value) {
+  bytes->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Identifies the font data by its table directory, its 'head' table (which
+// holds a checksum of the whole font file) and its 'name' table (which differs
+// between the fonts of a collection), together with the variation position of
+// the typeface.
+size_t ComputeContentHash(const SkTypeface& typeface) {
+  const int table_count = typeface.countTables();
+  if (table_count <= 0) {
+    return 0;
+  }
+  std::vector<SkFontTableTag> tags(table_count);
+  if (typeface.getTableTags(tags.data()) != table_count) {
+    return 0;
+  }
+
+  std::string identity;
+  for (SkFontTableTag tag : tags) {
+    AppendBytes(&identity, tag);
+    AppendBytes(&identity, typeface.getTableSize(tag));
+  }
+  for (SkFontTableTag tag : {SkSetFourByteTag('h', 'e', 'a', 'd'),
+                             SkSetFourByteTag('n', 'a', 'm', 'e')}) {
+    const size_t offset = identity.size();
+    identity.resize(offset + typeface.getTableSize(tag));
+    typeface.getTableData(tag, 0, identity.size() - offset, &identity[offset]);
+  }
+  const int axis_count = typeface.getVariationDesignPosition(nullptr, 0);
+  if (axis_count > 0) {
+    std::vector<SkFontArguments::VariationPosition::Coordinate> coordinates(
+        axis_count);
+    typeface.getVariationDesignPosition(coordinates.data(), axis_count);
+    for (const auto& coordinate : coordinates) {
+      AppendBytes(&identity, coordinate.axis);
+      AppendBytes(&identity, coordinate.value);
+    }
+  }
+
+  const size_t hash = std::hash<std::string>{}(identity);
+  return hash == 0 ? 1 : hash;
+}
+
 }  // namespace
 
 FontSkia::FontSkia(sk_sp<SkTypeface> typeface)
@@ -83,7 +132,30 @@ void FontSkia::GetBounds(minikin::MinikinRect* bounds,
 }
 
 hb_face_t* FontSkia::CreateHarfBuzzFace() const {
-  return hb_face_create_for_tables(GetTable, typeface_.get(), 0);
+  // Faces may be shared with other fonts that have the same content hash and
+  // outlive this font, so they keep the typeface data alive themselves.
+  int index = 0;
+  std::unique_ptr<SkStreamAsset> stream = typeface_->openStream(&index);
+  if (stream != nullptr && stream->getMemoryBase() != nullptr) {
+    // Reference the font data without copying it.
+    const char* data = static_cast<const char*>(stream->getMemoryBase());
+    const size_t size = stream->getLength();
+    hb_blob_t* blob = hb_blob_create(
+        data, size, HB_MEMORY_MODE_READONLY, stream.release(),
+        [](void* context) { delete static_cast<SkStreamAsset*>(context); });
+    hb_face_t* face = hb_face_create(blob, index);
+    hb_blob_destroy(blob);
+    return face;
+  }
+  return hb_face_create_for_tables(
+      GetTable, SkRef(typeface_.get()),
+      [](void* context) { static_cast<SkTypeface*>(context)->unref(); });
+}
+
+size_t FontSkia::GetContentHash() const {
+  std::call_once(content_hash_once_,
+                 [this] { content_hash_ = ComputeContentHash(*typeface_); });
+  return content_hash_;
 }
 
 const std::vector<minikin::FontVariation>& FontSkia::GetAxes() const {
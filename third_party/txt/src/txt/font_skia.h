@@ -16,6 +16,8 @@
 
 #include <minikin/MinikinFont.h>
 
+#include <mutex>
+
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkTypeface.h"
@@ -37,6 +39,8 @@ class FontSkia : public minikin::MinikinFont {
 
   hb_face_t* CreateHarfBuzzFace() const override;
 
+  size_t GetContentHash() const override;
+
   const std::vector<minikin::FontVariation>& GetAxes() const override;
 
   const sk_sp<SkTypeface>& GetSkTypeface() const;
@@ -44,6 +48,8 @@ class FontSkia : public minikin::MinikinFont {
  private:
   sk_sp<SkTypeface> typeface_;
   std::vector<minikin::FontVariation> variations_;
+  mutable std::once_flag content_hash_once_;
+  mutable size_t content_hash_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontSkia);
 };
@@ -18,6 +18,8 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_H_
 #define LIB_TXT_SRC_PARAGRAPH_H_
 
+#include <functional>
+
 #include "line_metrics.h"
 #include "paragraph_style.h"
 
@@ -142,6 +144,18 @@ class Paragraph {
   // before Painting and getting any statistics from this class.
   virtual void Layout(double width) = 0;
 
+  // Like Layout(), but skips building what is only needed to paint, such as
+  // text blobs. All metrics, line metrics and glyph positions are the same as
+  // after Layout(). The first Paint() afterwards completes the layout. Prefer
+  // this for paragraphs that are measured far more often than painted.
+  virtual void LayoutMetricsOnly(double width) { Layout(width); }
+
+  // Returns a task that shapes the text ahead of Layout() so that the shaping
+  // results are already cached when Layout() is called, or nullptr if there is
+  // nothing to prepare. The task only holds copies of what it needs and may
+  // run on any thread, even after the paragraph has been destroyed.
+  virtual std::function<void()> CreateWarmUpTask() { return nullptr; }
+
   // Paints the laid out text onto the supplied SkCanvas at (x, y) offset from
   // the origin. Only valid after Layout() is called.
   virtual void Paint(SkCanvas* canvas, double x, double y) = 0;
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "font_collection.h"
 #include "font_skia.h"
 #include "minikin/FontLanguageListCache.h"
@@ -41,6 +42,7 @@
 #include "third_party/skia/include/core/SkFontMetrics.h"
 #include "third_party/skia/include/core/SkMaskFilter.h"
 #include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/core/SkTextBlob.h"
 #include "third_party/skia/include/core/SkTypeface.h"
 #include "third_party/skia/include/effects/SkDashPathEffect.h"
@@ -266,6 +268,14 @@ bool ParagraphTxt::ComputeLineBreaks() {
   // Break at the end of the paragraph.
   newline_positions.push_back(text_.size());
 
+  // Only the line breaking depends on the width, so the text is measured once
+  // and the recorded word breaks are replayed for later widths.
+  const bool measure_blocks = block_breaks_.size() != newline_positions.size();
+  if (measure_blocks) {
+    block_breaks_.clear();
+    block_breaks_.resize(newline_positions.size());
+  }
+
   // Calculate and add any breaks due to a line being too long.
   size_t run_index = 0;
   size_t inline_placeholder_index = 0;
@@ -294,9 +304,17 @@ bool ParagraphTxt::ComputeLineBreaks() {
            block_size * sizeof(text_[0]));
     breaker_.setText();
 
+    BlockBreaks& block_breaks = block_breaks_[newline_index];
+    if (!measure_blocks) {
+      std::copy(block_breaks.char_widths.begin(),
+                block_breaks.char_widths.end(), breaker_.charWidths());
+      breaker_.addWordBreaks(block_breaks.word_breaks,
+                             block_breaks.hyphen_penalty_per_width);
+    }
+
     // Add the runs that include this line to the LineBreaker.
-    double block_total_width = 0;
-    while (run_index < runs_.size()) {
+    double block_total_width = measure_blocks ? 0 : block_breaks.total_width;
+    while (measure_blocks && run_index < runs_.size()) {
       StyledRuns::Run run = runs_.GetRun(run_index);
       if (run.start >= block_end)
         break;
@@ -316,6 +334,7 @@ bool ParagraphTxt::ComputeLineBreaks() {
                               ? ""
                               : run.style.font_families[0])
                       << "\".";
+        block_breaks_.clear();
         return false;
       }
       size_t run_start = std::max(run.start, block_start) - block_start;
@@ -353,6 +372,14 @@ bool ParagraphTxt::ComputeLineBreaks() {
         break;
       run_index++;
     }
+    if (measure_blocks) {
+      block_breaks.char_widths.assign(breaker_.charWidths(),
+                                      breaker_.charWidths() + block_size);
+      block_breaks.word_breaks = breaker_.getWordBreaks();
+      block_breaks.hyphen_penalty_per_width =
+          breaker_.getHyphenPenaltyPerWidth();
+      block_breaks.total_width = block_total_width;
+    }
     max_intrinsic_width_ = std::max(max_intrinsic_width_, block_total_width);
 
     size_t breaks_count = breaker_.computeBreaks();
@@ -648,6 +675,50 @@ void ParagraphTxt::ComputePlaceholder(PlaceholderRun* placeholder_run,
   }
 }
 
+std::function<void()> ParagraphTxt::CreateWarmUpTask() {
+  struct WarmUpRun {
+    size_t start;
+    size_t end;
+    minikin::FontStyle font;
+    minikin::MinikinPaint paint;
+    std::shared_ptr<minikin::FontCollection> collection;
+  };
+
+  // Resolve the fonts here as the font collection is not thread safe.
+  std::vector<WarmUpRun> warm_up_runs;
+  for (size_t i = 0; i < runs_.size(); ++i) {
+    StyledRuns::Run run = runs_.GetRun(i);
+    if (run.end <= run.start ||
+        (run.end - run.start == 1 &&
+         obj_replacement_char_indexes_.count(run.start) != 0)) {
+      continue;
+    }
+    WarmUpRun warm_up_run;
+    warm_up_run.start = run.start;
+    warm_up_run.end = run.end;
+    GetFontAndMinikinPaint(run.style, &warm_up_run.font, &warm_up_run.paint);
+    warm_up_run.collection = GetMinikinFontCollectionForStyle(run.style);
+    if (warm_up_run.collection != nullptr) {
+      warm_up_runs.push_back(std::move(warm_up_run));
+    }
+  }
+  if (warm_up_runs.empty()) {
+    return nullptr;
+  }
+
+  const bool is_rtl = paragraph_style_.text_direction == TextDirection::rtl;
+  return [text = text_, runs = std::move(warm_up_runs), is_rtl]() {
+    TRACE_EVENT0("flutter", "ParagraphTxt::WarmUp");
+    // Measuring goes through the same per word layout cache as the line
+    // breaker, so a later Layout() only needs to look the words up.
+    for (const WarmUpRun& run : runs) {
+      minikin::Layout::measureText(text.data(), run.start, run.end - run.start,
+                                   text.size(), is_rtl, run.font, run.paint,
+                                   run.collection, nullptr);
+    }
+  };
+}
+
 // Implementation outline:
 //
 // -For each line:
@@ -665,17 +736,33 @@ void ParagraphTxt::ComputePlaceholder(PlaceholderRun* placeholder_run,
 //   -Calculate line vertical layout (ascent, descent, etc)
 //   -Store per-line metrics
 void ParagraphTxt::Layout(double width) {
+  PerformLayout(width, true);
+}
+
+void ParagraphTxt::LayoutMetricsOnly(double width) {
+  PerformLayout(width, false);
+}
+
+void ParagraphTxt::PerformLayout(double width, bool build_text_blobs) {
   double rounded_width = floor(width);
   // Do not allow calling layout multiple times without changing anything.
-  if (!needs_layout_ && rounded_width == width_) {
+  if (!needs_layout_ && rounded_width == width_ &&
+      !(build_text_blobs && text_blobs_deferred_)) {
     return;
   }
 
   width_ = rounded_width;
 
+  // Anything but the width changed, so the text has to be measured again.
+  if (needs_layout_) {
+    block_breaks_.clear();
+  }
   needs_layout_ = false;
 
   records_.clear();
+  paint_picture_ = nullptr;
+  paint_count_ = 0;
+  text_blobs_deferred_ = !build_text_blobs;
   glyph_lines_.clear();
   code_unit_runs_.clear();
   inline_placeholder_code_unit_runs_.clear();
@@ -902,8 +989,11 @@ void ParagraphTxt::Layout(double width) {
         std::vector<GlyphPosition> glyph_positions;
 
         GetGlyphTypeface(layout, glyph_blob.start).apply(font);
-        const SkTextBlobBuilder::RunBuffer& blob_buffer =
-            builder.allocRunPos(font, glyph_blob.end - glyph_blob.start);
+        const SkTextBlobBuilder::RunBuffer* blob_buffer = nullptr;
+        if (build_text_blobs) {
+          blob_buffer =
+              &builder.allocRunPos(font, glyph_blob.end - glyph_blob.start);
+        }
 
         double justify_x_offset_delta = 0;
         for (size_t glyph_index = glyph_blob.start;
@@ -913,17 +1003,19 @@ void ParagraphTxt::Layout(double width) {
           double glyph_x_offset;
           // Add all the glyphs in this cluster to the text blob.
           do {
-            size_t blob_index = glyph_index - glyph_blob.start;
-            blob_buffer.glyphs[blob_index] = layout.getGlyphId(glyph_index);
-
-            size_t pos_index = blob_index * 2;
-            blob_buffer.pos[pos_index] = layout.getX(glyph_index) +
-                                         justify_x_offset +
-                                         justify_x_offset_delta;
-            blob_buffer.pos[pos_index + 1] = layout.getY(glyph_index);
+            const SkScalar glyph_x = layout.getX(glyph_index) +
+                                     justify_x_offset + justify_x_offset_delta;
+            if (blob_buffer != nullptr) {
+              size_t blob_index = glyph_index - glyph_blob.start;
+              blob_buffer->glyphs[blob_index] = layout.getGlyphId(glyph_index);
+
+              size_t pos_index = blob_index * 2;
+              blob_buffer->pos[pos_index] = glyph_x;
+              blob_buffer->pos[pos_index + 1] = layout.getY(glyph_index);
+            }
 
             if (glyph_index == cluster_start_glyph_index)
-              glyph_x_offset = blob_buffer.pos[pos_index];
+              glyph_x_offset = glyph_x;
 
             glyph_index++;
           } while (glyph_index < glyph_blob.end &&
@@ -1037,10 +1129,11 @@ void ParagraphTxt::Layout(double width) {
         Range<double> record_x_pos(
             glyph_positions.front().x_pos.start - run_x_offset,
             glyph_positions.back().x_pos.end - run_x_offset);
-        paint_records.emplace_back(run.style(), SkPoint::Make(run_x_offset, 0),
-                                   builder.make(), *metrics, line_number,
-                                   record_x_pos.start, record_x_pos.end,
-                                   run.is_ghost(), run.placeholder_run());
+        paint_records.emplace_back(
+            run.style(), SkPoint::Make(run_x_offset, 0),
+            build_text_blobs ? builder.make() : nullptr, *metrics, line_number,
+            record_x_pos.start, record_x_pos.end, run.is_ghost(),
+            run.placeholder_run());
 
         justify_x_offset += justify_x_offset_delta;
 
@@ -1183,7 +1276,10 @@ void ParagraphTxt::Layout(double width) {
 
   std::sort(code_unit_runs_.begin(), code_unit_runs_.end(),
             [](const CodeUnitRun& a, const CodeUnitRun& b) {
-              return a.code_units.start < b.code_units.start;
+              if (a.code_units.start != b.code_units.start) {
+                return a.code_units.start < b.code_units.start;
+              }
+              return a.line_number < b.line_number;
             });
 
   longest_line_ = max_right_ - min_left_;
@@ -1408,7 +1504,37 @@ sk_sp<SkTypeface> ParagraphTxt::GetDefaultSkiaTypeface(const TextStyle& style) {
 // The x,y coordinates will be the very top left corner of the rendered
 // paragraph.
 void ParagraphTxt::Paint(SkCanvas* canvas, double x, double y) {
-  SkPoint base_offset = SkPoint::Make(x, y);
+  if (text_blobs_deferred_) {
+    PerformLayout(width_, true);
+  }
+  // A paragraph that is painted again at the same offset, like the static text
+  // of a screen that keeps repainting, replays a recording of its second paint
+  // instead of drawing every record again. Paragraphs painted only once never
+  // pay for the recording. The recording is made at the real offset because
+  // shaders in the paints are positioned in canvas coordinates.
+  SkPoint offset = SkPoint::Make(x, y);
+  if (paint_count_ > 0 && offset != paint_offset_) {
+    paint_picture_ = nullptr;
+    paint_count_ = 0;
+  }
+  paint_offset_ = offset;
+  if (paint_count_ == 1) {
+    std::optional<SkRect> bounds = ComputePaintBounds();
+    if (bounds) {
+      SkPictureRecorder recorder;
+      PaintRecords(recorder.beginRecording(bounds->makeOffset(x, y)), offset);
+      paint_picture_ = recorder.finishRecordingAsPicture();
+    }
+  }
+  paint_count_++;
+  if (paint_picture_) {
+    canvas->drawPicture(paint_picture_);
+    return;
+  }
+  PaintRecords(canvas, offset);
+}
+
+void ParagraphTxt::PaintRecords(SkCanvas* canvas, SkPoint base_offset) {
   SkPaint paint;
   // Paint the background first before painting any text to prevent
   // potential overlap.
@@ -1431,6 +1557,56 @@ void ParagraphTxt::Paint(SkCanvas* canvas, double x, double y) {
   }
 }
 
+std::optional<SkRect> ParagraphTxt::ComputePaintBounds() const {
+  SkRect bounds = SkRect::MakeEmpty();
+  for (const PaintRecord& record : records_) {
+    const TextStyle& style = record.style();
+    const SkFontMetrics& metrics = record.metrics();
+    SkRect record_bounds = SkRect::MakeLTRB(
+        record.x_start(), metrics.fAscent, record.x_end(), metrics.fDescent);
+    if (record.text() != nullptr) {
+      record_bounds.join(record.text()->bounds());
+    }
+    // Strokes, mask filters and image filters of the foreground and the
+    // background draw outside of the text.
+    for (const SkPaint* paint :
+         {style.has_foreground ? &style.foreground : nullptr,
+          style.has_background ? &style.background : nullptr}) {
+      if (paint == nullptr) {
+        continue;
+      }
+      if (!paint->canComputeFastBounds()) {
+        return std::nullopt;
+      }
+      SkRect storage;
+      record_bounds.join(paint->computeFastBounds(record_bounds, &storage));
+    }
+    // Decorations are stroked a little outside of the metrics, wavy ones by
+    // up to their thickness.
+    if (style.decoration != TextDecoration::kNone) {
+      SkScalar outset =
+          style.font_size * (1 + style.decoration_thickness_multiplier) / 2;
+      record_bounds.outset(outset, outset);
+    }
+    record_bounds.offset(record.offset());
+    bounds.join(record_bounds);
+    if (record.GetPlaceholderRun() != nullptr || record.text() == nullptr) {
+      continue;
+    }
+    for (const TextShadow& text_shadow : style.text_shadows) {
+      if (!text_shadow.hasShadow()) {
+        continue;
+      }
+      SkRect shadow_bounds = record.text()->bounds();
+      shadow_bounds.offset(record.offset() + text_shadow.offset);
+      shadow_bounds.outset(3 * text_shadow.blur_sigma,
+                           3 * text_shadow.blur_sigma);
+      bounds.join(shadow_bounds);
+    }
+  }
+  return bounds;
+}
+
 void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
                                     const PaintRecord& record,
                                     SkPoint base_offset) {
@@ -1659,6 +1835,23 @@ void ParagraphTxt::PaintShadow(SkCanvas* canvas,
   }
 }
 
+size_t ParagraphTxt::FirstLineEndingAfter(size_t offset) const {
+  return std::upper_bound(line_metrics_.begin(), line_metrics_.end(), offset,
+                          [](size_t value, const LineMetrics& line) {
+                            return value < line.end_including_newline;
+                          }) -
+         line_metrics_.begin();
+}
+
+std::vector<ParagraphTxt::CodeUnitRun>::const_iterator
+ParagraphTxt::FirstCodeUnitRunOfLine(size_t line_number) const {
+  return std::lower_bound(code_unit_runs_.begin(), code_unit_runs_.end(),
+                          line_number,
+                          [](const CodeUnitRun& run, size_t value) {
+                            return run.line_number < value;
+                          });
+}
+
 std::vector<Paragraph::TextBox> ParagraphTxt::GetRectsForRange(
     size_t start,
     size_t end,
@@ -1686,8 +1879,13 @@ std::vector<Paragraph::TextBox> ParagraphTxt::GetRectsForRange(
   size_t min_line = INT_MAX;
   size_t glyph_length = 0;
 
+  // Lines ending at or before start contribute nothing, so skip their runs.
+  size_t first_line = FirstLineEndingAfter(start);
+
   // Generate initial boxes and calculate metrics.
-  for (const CodeUnitRun& run : code_unit_runs_) {
+  for (auto it = FirstCodeUnitRunOfLine(first_line);
+       it != code_unit_runs_.end(); ++it) {
+    const CodeUnitRun& run = *it;
     // Check to see if we are finished.
     if (run.code_units.start >= end)
       break;
@@ -1756,7 +1954,7 @@ std::vector<Paragraph::TextBox> ParagraphTxt::GetRectsForRange(
 
   // Add empty rectangles representing any newline characters within the
   // range.
-  for (size_t line_number = 0; line_number < line_metrics_.size();
+  for (size_t line_number = first_line; line_number < line_metrics_.size();
        ++line_number) {
     LineMetrics& line = line_metrics_[line_number];
     if (line.start_index >= end)
@@ -1886,45 +2084,40 @@ Paragraph::PositionWithAffinity ParagraphTxt::GetGlyphPositionAtCoordinate(
   if (final_line_count_ <= 0)
     return PositionWithAffinity(0, DOWNSTREAM);
 
-  size_t y_index;
-  for (y_index = 0; y_index < final_line_count_ - 1; ++y_index) {
-    if (dy < line_metrics_[y_index].height)
-      break;
-  }
+  // Line bottoms only grow, so the first line ending below dy is found with a
+  // binary search. Points below the last line hit the last line.
+  auto line_end = line_metrics_.begin() + (final_line_count_ - 1);
+  size_t y_index = std::upper_bound(line_metrics_.begin(), line_end, dy,
+                                    [](double y, const LineMetrics& line) {
+                                      return y < line.height;
+                                    }) -
+                   line_metrics_.begin();
 
   const std::vector<GlyphPosition>& line_glyph_position =
       glyph_lines_[y_index].positions;
   if (line_glyph_position.empty()) {
-    int line_start_index =
-        std::accumulate(glyph_lines_.begin(), glyph_lines_.begin() + y_index, 0,
-                        [](const int a, const GlyphLine& b) {
-                          return a + static_cast<int>(b.total_code_units);
-                        });
-    return PositionWithAffinity(line_start_index, DOWNSTREAM);
-  }
-
-  size_t x_index;
-  const GlyphPosition* gp = nullptr;
-  for (x_index = 0; x_index < line_glyph_position.size(); ++x_index) {
-    double glyph_end = (x_index < line_glyph_position.size() - 1)
-                           ? line_glyph_position[x_index + 1].x_pos.start
-                           : line_glyph_position[x_index].x_pos.end;
-    if (dx < glyph_end) {
-      gp = &line_glyph_position[x_index];
-      break;
-    }
+    return PositionWithAffinity(line_metrics_[y_index].start_index,
+                                DOWNSTREAM);
   }
 
-  if (gp == nullptr) {
-    gp = &line_glyph_position.back();
-  }
+  // Glyphs of a line are stored in visual order, each one extending up to the
+  // start of the next. Points past the end of the line hit the last glyph.
+  auto glyph_end =
+      std::upper_bound(line_glyph_position.begin() + 1,
+                       line_glyph_position.end(), dx,
+                       [](double x, const GlyphPosition& next) {
+                         return x < next.x_pos.start;
+                       });
+  const GlyphPosition* gp =
+      &line_glyph_position[glyph_end - (line_glyph_position.begin() + 1)];
 
   // Find the direction of the run that contains this glyph.
   TextDirection direction = TextDirection::ltr;
-  for (const CodeUnitRun& run : code_unit_runs_) {
-    if (gp->code_units.start >= run.code_units.start &&
-        gp->code_units.end <= run.code_units.end) {
-      direction = run.direction;
+  for (auto run = FirstCodeUnitRunOfLine(y_index);
+       run != code_unit_runs_.end() && run->line_number == y_index; ++run) {
+    if (gp->code_units.start >= run->code_units.start &&
+        gp->code_units.end <= run->code_units.end) {
+      direction = run->direction;
       break;
     }
   }
@@ -17,6 +17,8 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_TXT_H_
 #define LIB_TXT_SRC_PARAGRAPH_TXT_H_
 
+#include <functional>
+#include <optional>
 #include <set>
 #include <utility>
 #include <vector>
@@ -34,6 +36,7 @@
 #include "styled_runs.h"
 #include "third_party/googletest/googletest/include/gtest/gtest_prod.h"  // nogncheck
 #include "third_party/skia/include/core/SkFontMetrics.h"
+#include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkRect.h"
 #include "utils/LinuxUtils.h"
 #include "utils/MacUtils.h"
@@ -73,6 +76,10 @@ class ParagraphTxt : public Paragraph {
   // (10k+ characters) to ensure speedy layout.
   virtual void Layout(double width) override;
 
+  void LayoutMetricsOnly(double width) override;
+
+  std::function<void()> CreateWarmUpTask() override;
+
   virtual void Paint(SkCanvas* canvas, double x, double y) override;
 
   // Getter for paragraph_style_.
@@ -153,6 +160,8 @@ class ParagraphTxt : public Paragraph {
   FRIEND_TEST_LINUX_ONLY(ParagraphTest, EmojiMultiLineRectsParagraph);
   FRIEND_TEST(ParagraphTest, HyphenBreakParagraph);
   FRIEND_TEST(ParagraphTest, RepeatLayoutParagraph);
+  FRIEND_TEST(ParagraphTest, RelayoutAtOtherWidthsMatchesFreshLayout);
+  FRIEND_TEST(ParagraphTest, LayoutMetricsOnlyDefersTextBlobs);
   FRIEND_TEST(ParagraphTest, Ellipsize);
   FRIEND_TEST(ParagraphTest, UnderlineShiftParagraph);
   FRIEND_TEST(ParagraphTest, WavyDecorationParagraph);
@@ -164,6 +173,8 @@ class ParagraphTxt : public Paragraph {
   FRIEND_TEST(ParagraphTest, GetGlyphPositionAtCoordinateSegfault);
   FRIEND_TEST(ParagraphTest, KhmerLineBreaker);
   FRIEND_TEST(ParagraphTest, TextHeightBehaviorRectsParagraph);
+  FRIEND_TEST(ParagraphTest, RepaintReplaysRecordedPicture);
+  FRIEND_TEST(ParagraphTest, RepaintRecordingCoversStrokedForeground);
 
   // Starting data to layout.
   std::vector<uint16_t> text_;
@@ -190,9 +201,28 @@ class ParagraphTxt : public Paragraph {
   size_t final_line_count_;
   std::vector<double> line_widths_;
 
+  // The measurements of a block of text between hard breaks. They are recorded
+  // by the first layout and only depend on the text and its styles, so layouts
+  // at other widths reuse them to redo the line breaking without shaping the
+  // text again.
+  struct BlockBreaks {
+    std::vector<float> char_widths;
+    std::vector<minikin::LineBreaker::WordBreak> word_breaks;
+    float hyphen_penalty_per_width = 0;
+    double total_width = 0;
+  };
+  // One entry per hard break block, or empty if the text must be measured.
+  std::vector<BlockBreaks> block_breaks_;
+
   // Stores the result of Layout().
   std::vector<PaintRecord> records_;
 
+  // The recorded drawing of records_ at paint_offset_, made on the second paint
+  // at that offset after a layout and replayed by the paints that follow it.
+  sk_sp<SkPicture> paint_picture_;
+  size_t paint_count_ = 0;
+  SkPoint paint_offset_ = SkPoint::Make(0, 0);
+
   bool did_exceed_max_lines_;
 
   // Strut metrics of zero will have no effect on the layout.
@@ -304,7 +334,7 @@ class ParagraphTxt : public Paragraph {
   std::vector<GlyphLine> glyph_lines_;
 
   // Holds the positions of each range of code units in the text.
-  // Sorted in code unit index order.
+  // Sorted in code unit index order, which also groups them by line.
   std::vector<CodeUnitRun> code_unit_runs_;
   // Holds the positions of the inline placeholders.
   std::vector<CodeUnitRun> inline_placeholder_code_unit_runs_;
@@ -319,6 +349,8 @@ class ParagraphTxt : public Paragraph {
   double ideographic_baseline_ = std::numeric_limits<double>::max();
 
   bool needs_layout_ = true;
+  // Whether the paint records of the last layout have no text blobs yet.
+  bool text_blobs_deferred_ = false;
 
   struct WaveCoordinates {
     double x_start;
@@ -342,6 +374,9 @@ class ParagraphTxt : public Paragraph {
       std::vector<PlaceholderRun> inline_placeholders,
       std::unordered_set<size_t> obj_replacement_char_indexes);
 
+  // Shared implementation of Layout() and LayoutMetricsOnly().
+  void PerformLayout(double width, bool build_text_blobs);
+
   // Break the text into lines.
   bool ComputeLineBreaks();
 
@@ -373,6 +408,21 @@ class ParagraphTxt : public Paragraph {
   // alignment.
   double GetLineXOffset(double line_total_advance, bool justify_line);
 
+  // Index of the first line in line_metrics_ whose text, including its
+  // newline, ends after the given code unit offset.
+  size_t FirstLineEndingAfter(size_t offset) const;
+
+  // The first of code_unit_runs_ laid out on the given line or a later one.
+  std::vector<CodeUnitRun>::const_iterator FirstCodeUnitRunOfLine(
+      size_t line_number) const;
+
+  // Draws all of records_ with the paragraph's top left corner at base_offset.
+  void PaintRecords(SkCanvas* canvas, SkPoint base_offset);
+
+  // Bounds of everything PaintRecords draws at the origin, or nullopt if a
+  // paint of the records can not compute its bounds.
+  std::optional<SkRect> ComputePaintBounds() const;
+
   // Creates and draws the decorations onto the canvas.
   void PaintDecorations(SkCanvas* canvas,
                         const PaintRecord& record,
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <minikin/WordBreaker.h>
+
+#include <string>
+#include <vector>
+
+namespace minikin {
+
+struct Break {
+  ssize_t offset;
+  ssize_t wordStart;
+  ssize_t wordEnd;
+
+  bool operator==(const Break& other) const {
+    return offset == other.offset && wordStart == other.wordStart &&
+           wordEnd == other.wordEnd;
+  }
+};
+
+static std::vector<Break> GetBreaks(const std::u16string& text,
+                                    bool fastPath,
+                                    bool* usedFastPath = nullptr) {
+  WordBreaker breaker;
+  breaker.setLocale();
+  breaker.setLatinFastPathEnabled(fastPath);
+  breaker.setText(reinterpret_cast<const uint16_t*>(text.data()),
+                  text.size());
+  if (usedFastPath != nullptr) {
+    *usedFastPath = breaker.isUsingLatinFastPath();
+  }
+  std::vector<Break> breaks;
+  for (ssize_t offset = breaker.next(); offset >= 0;
+       offset = breaker.next()) {
+    breaks.push_back({offset, breaker.wordStart(), breaker.wordEnd()});
+  }
+  breaker.finish();
+  return breaks;
+}
+
+static void ExpectSameBreaks(const std::u16string& text, bool usesFastPath) {
+  bool usedFastPath = false;
+  EXPECT_EQ(GetBreaks(text, true, &usedFastPath), GetBreaks(text, false));
+  EXPECT_EQ(usedFastPath, usesFastPath);
+}
+
+TEST(LatinWordBreakerTest, MatchesIcuForSimpleText) {
+  ExpectSameBreaks(u"", true);
+  ExpectSameBreaks(u"hello", true);
+  ExpectSameBreaks(u"hello world", true);
+  ExpectSameBreaks(u"  leading and trailing spaces  ", true);
+  ExpectSameBreaks(u"     ", true);
+  ExpectSameBreaks(u"The quick brown fox jumps over the lazy dog 42 times.",
+                   true);
+  ExpectSameBreaks(u"Hello, world! Is this fine? Yes; it is: really...", true);
+  ExpectSameBreaks(u"Crème brûlée, Łódź", true);
+  ExpectSameBreaks(u"abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+                   true);
+}
+
+TEST(LatinWordBreakerTest, FallsBackToIcuForOtherText) {
+  ExpectSameBreaks(u"sugar-free", false);
+  ExpectSameBreaks(u"a . b", false);
+  ExpectSameBreaks(u"1,5 and 2.5", false);
+  ExpectSameBreaks(u"wow!yes", false);
+  ExpectSameBreaks(u"mail foo@example.com now", false);
+  ExpectSameBreaks(u"see http://example.com/path", false);
+  ExpectSameBreaks(u"tab\tseparated", false);
+  ExpectSameBreaks(u"non breaking", false);
+  ExpectSameBreaks(u"(quoted) \"text\"", false);
+  ExpectSameBreaks(u"你好 world", false);
+}
+
+}  // namespace minikin
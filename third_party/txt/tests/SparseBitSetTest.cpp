@@ -15,6 +15,7 @@
  */
 
 #include <random>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <minikin/SparseBitSet.h>
@@ -51,4 +52,60 @@ TEST(SparseBitSetTest, randomTest) {
   }
 }
 
+TEST(SparseBitSetTest, fullPagesTest) {
+  const std::vector<uint32_t> range = {0x20,   0x7F,   0x400,  0x800,
+                                       0x4E00, 0xA000, 0xAC00, 0xD7A4};
+  SparseBitSet bitset(range.data(), range.size() / 2);
+
+  EXPECT_FALSE(bitset.get(0x1F));
+  EXPECT_TRUE(bitset.get(0x20));
+  EXPECT_TRUE(bitset.get(0x7FF));
+  EXPECT_FALSE(bitset.get(0x800));
+  EXPECT_FALSE(bitset.get(0x4DFF));
+  EXPECT_TRUE(bitset.get(0x4E00));
+  EXPECT_TRUE(bitset.get(0x9FFF));
+  EXPECT_FALSE(bitset.get(0xA000));
+  EXPECT_TRUE(bitset.get(0xD7A3));
+  EXPECT_FALSE(bitset.get(0xD7A4));
+  EXPECT_EQ(0x4E00u, bitset.nextSetBit(0x800));
+  EXPECT_EQ(0xAC00u, bitset.nextSetBit(0xA000));
+  EXPECT_EQ(range, bitset.getRanges());
+}
+
+TEST(SparseBitSetTest, getRangesTest) {
+  EXPECT_TRUE(SparseBitSet().getRanges().empty());
+
+  std::mt19937 mt;
+  std::uniform_int_distribution<uint16_t> distribution(1, 512);
+  std::vector<uint32_t> range{distribution(mt)};
+  for (size_t i = 1; i < 1024 * 2; ++i) {
+    range.push_back((range.back() - 1) + distribution(mt));
+  }
+  SparseBitSet bitset(range.data(), range.size() / 2);
+
+  const std::vector<uint32_t> ranges = bitset.getRanges();
+  ASSERT_EQ(0u, ranges.size() % 2);
+  SparseBitSet copy(ranges.data(), ranges.size() / 2);
+  EXPECT_EQ(bitset.length(), copy.length());
+  for (uint32_t ch = 0; ch < bitset.length() + 1024; ++ch) {
+    ASSERT_EQ(bitset.get(ch), copy.get(ch)) << std::hex << ch;
+  }
+}
+
+TEST(SparseBitSetTest, getCoveredLengthTest) {
+  const std::vector<uint32_t> range = {'a', 'z' + 1, 0x4E00, 0xA000,
+                                       0x1F600, 0x1F650};
+  SparseBitSet bitset(range.data(), range.size() / 2);
+
+  const uint16_t text[] = {'a', 'b', 0x4E00, 0x9FFF, 'c', 0xD83D, 0xDE00};
+  EXPECT_EQ(0u, bitset.getCoveredLength(text, 0));
+  EXPECT_EQ(2u, bitset.getCoveredLength(text, 2));
+  // Stops at the surrogate pair even though U+1F600 is in the set.
+  EXPECT_EQ(5u, bitset.getCoveredLength(text, 7));
+
+  const uint16_t uncovered[] = {'a', 'A', 'b'};
+  EXPECT_EQ(1u, bitset.getCoveredLength(uncovered, 3));
+  EXPECT_EQ(0u, SparseBitSet().getCoveredLength(uncovered, 3));
+}
+
 }  // namespace minikin
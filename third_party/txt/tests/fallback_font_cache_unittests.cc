@@ -0,0 +1,173 @@
+/*
+ * Copyright 2017 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+#include "txt/fallback_font_cache.h"
+
+namespace txt {
+namespace testing {
+
+using Families = std::vector<std::string>;
+
+TEST(FallbackFontCacheTest, GroupsCodePointsByRangeAndLocale) {
+  FallbackFontCache cache;
+  EXPECT_TRUE(cache.GetFamilies(0x4E00, "zh-Hans").empty());
+
+  cache.Add(0x4E00, "zh-Hans", "Noto Sans CJK SC");
+  EXPECT_EQ(cache.GetFamilies(0x4E01, "zh-Hans"), Families{"Noto Sans CJK SC"});
+  EXPECT_TRUE(cache.GetFamilies(0x4E00, "ja").empty());
+  EXPECT_TRUE(
+      cache.GetFamilies(0x4E00 + FallbackFontCache::kRangeSize, "zh-Hans")
+          .empty());
+  EXPECT_EQ(cache.GetRangeCount(), 1u);
+}
+
+TEST(FallbackFontCacheTest, KeepsMostRecentFamiliesFirst) {
+  FallbackFontCache cache;
+  cache.Add(0x1F600, "", "A");
+  cache.Add(0x1F601, "", "B");
+  EXPECT_EQ(cache.GetFamilies(0x1F600, ""), (Families{"B", "A"}));
+
+  cache.Add(0x1F602, "", "A");
+  EXPECT_EQ(cache.GetFamilies(0x1F600, ""), (Families{"A", "B"}));
+
+  for (size_t i = 0; i < FallbackFontCache::kMaxFamiliesPerRange; i++) {
+    cache.Add(0x1F600, "", "Family " + std::to_string(i));
+  }
+  Families families = cache.GetFamilies(0x1F600, "");
+  EXPECT_EQ(families.size(), FallbackFontCache::kMaxFamiliesPerRange);
+  EXPECT_EQ(std::find(families.begin(), families.end(), "B"), families.end());
+}
+
+TEST(FallbackFontCacheTest, IgnoresFamiliesThatCannotBeStored) {
+  FallbackFontCache cache;
+  cache.Add(0x41, "", "");
+  cache.Add(0x41, "", "Tab\tFamily");
+  cache.Add(0x41, "en\n", "Family");
+  EXPECT_EQ(cache.GetRangeCount(), 0u);
+}
+
+TEST(FallbackFontCacheTest, RoundTripsThroughSerialization) {
+  FallbackFontCache cache;
+  cache.Add(0x4E00, "zh-Hans", "Noto Sans CJK SC");
+  cache.Add(0x4E00, "zh-Hans", "Droid Sans Fallback");
+  cache.Add(0x1F600, "", "Noto Color Emoji");
+
+  FallbackFontCache restored;
+  ASSERT_TRUE(restored.Deserialize(cache.Serialize()));
+  EXPECT_EQ(restored.GetRangeCount(), 2u);
+  EXPECT_EQ(restored.GetFamilies(0x4E00, "zh-Hans"),
+            (Families{"Droid Sans Fallback", "Noto Sans CJK SC"}));
+  EXPECT_EQ(restored.GetFamilies(0x1F600, ""), Families{"Noto Color Emoji"});
+}
+
+TEST(FallbackFontCacheTest, RejectsUnknownFormats) {
+  FallbackFontCache cache;
+  cache.Add(0x41, "", "Roboto");
+  EXPECT_FALSE(cache.Deserialize("not a fallback font cache\n"));
+  EXPECT_EQ(cache.GetRangeCount(), 0u);
+
+  FallbackFontCache source;
+  source.Add(0x41, "", "Roboto");
+  std::string data = source.Serialize();
+  EXPECT_FALSE(cache.Deserialize(data.substr(0, data.find('\n') + 1) +
+                                 "x\t\tRoboto\n"));
+  EXPECT_EQ(cache.GetRangeCount(), 0u);
+}
+
+TEST(FallbackFontCacheTest, IgnoresIncompleteLastRecord) {
+  FallbackFontCache source;
+  source.Add(0x41, "", "Roboto");
+  std::string data = source.Serialize() + "0\t\tCut off";
+
+  FallbackFontCache cache;
+  ASSERT_TRUE(cache.Deserialize(data));
+  EXPECT_EQ(cache.GetFamilies(0x41, ""), Families{"Roboto"});
+}
+
+TEST(FallbackFontCacheTest, KeepsCoverageForSameFontContent) {
+  FallbackFontCache cache;
+  FallbackFontCache::Coverage coverage;
+  EXPECT_FALSE(cache.GetCoverage("Noto Sans CJK SC", 42, &coverage));
+
+  cache.AddCoverage("Noto Sans CJK SC", 42,
+                    {{0x20, 0x7F, 0x4E00, 0xA000}, true});
+  ASSERT_TRUE(cache.GetCoverage("Noto Sans CJK SC", 42, &coverage));
+  EXPECT_EQ(coverage.ranges,
+            (std::vector<uint32_t>{0x20, 0x7F, 0x4E00, 0xA000}));
+  EXPECT_TRUE(coverage.has_vs_table);
+
+  // The fonts of the family changed, e.g. after a system update.
+  EXPECT_FALSE(cache.GetCoverage("Noto Sans CJK SC", 43, &coverage));
+  cache.AddCoverage("Noto Sans CJK SC", 43, {{0x20, 0x7F}, false});
+  EXPECT_EQ(cache.GetCoverageCount(), 1u);
+  EXPECT_FALSE(cache.GetCoverage("Noto Sans CJK SC", 42, &coverage));
+}
+
+TEST(FallbackFontCacheTest, RoundTripsCoverageThroughSerialization) {
+  FallbackFontCache cache;
+  cache.Add(0x4E00, "zh-Hans", "Noto Sans CJK SC");
+  cache.AddCoverage("Noto Sans CJK SC", 1234567890123u,
+                    {{0x20, 0x7F, 0x4E00, 0xA000, 0x20000, 0x2A6E0}, true});
+  cache.AddCoverage("Empty", 1, {});
+
+  FallbackFontCache restored;
+  ASSERT_TRUE(restored.Deserialize(cache.Serialize()));
+  EXPECT_EQ(restored.GetRangeCount(), 1u);
+  EXPECT_EQ(restored.GetCoverageCount(), 2u);
+  FallbackFontCache::Coverage coverage;
+  ASSERT_TRUE(
+      restored.GetCoverage("Noto Sans CJK SC", 1234567890123u, &coverage));
+  EXPECT_EQ(coverage.ranges, (std::vector<uint32_t>{0x20, 0x7F, 0x4E00, 0xA000,
+                                                    0x20000, 0x2A6E0}));
+  EXPECT_TRUE(coverage.has_vs_table);
+  ASSERT_TRUE(restored.GetCoverage("Empty", 1, &coverage));
+  EXPECT_TRUE(coverage.ranges.empty());
+  EXPECT_FALSE(coverage.has_vs_table);
+
+  std::string data = cache.Serialize();
+  // Ranges must be in increasing order.
+  EXPECT_FALSE(
+      restored.Deserialize(data + "coverage\tBroken\t1\t0\t20 7f 10 11\n"));
+  EXPECT_EQ(restored.GetCoverageCount(), 0u);
+}
+
+TEST(FallbackFontCacheTest, SavesAndLoadsFromDirectory) {
+  fml::ScopedTemporaryDirectory directory;
+  FallbackFontCache cache;
+  EXPECT_FALSE(cache.Load(directory.fd()));
+
+  cache.Add(0x4E00, "zh-Hans", "Noto Sans CJK SC");
+  ASSERT_TRUE(cache.Save(directory.fd()));
+  ASSERT_TRUE(fml::FileExists(directory.fd(), FallbackFontCache::kFileName));
+
+  FallbackFontCache loaded;
+  ASSERT_TRUE(loaded.Load(directory.fd()));
+  EXPECT_EQ(loaded.GetFamilies(0x4E00, "zh-Hans"),
+            Families{"Noto Sans CJK SC"});
+
+  // Nothing changed since the cache was loaded, so it is not written again.
+  ASSERT_TRUE(fml::UnlinkFile(directory.fd(), FallbackFontCache::kFileName));
+  ASSERT_TRUE(loaded.Save(directory.fd()));
+  EXPECT_FALSE(fml::FileExists(directory.fd(), FallbackFontCache::kFileName));
+}
+
+}  // namespace testing
+}  // namespace txt
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2017 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "txt/font_skia.h"
+
+#include <hb.h>
+
+#include <mutex>
+
+#include "gtest/gtest.h"
+#include "minikin/HbFontCache.h"
+#include "minikin/MinikinInternal.h"
+#include "txt_test_utils.h"
+
+namespace txt {
+
+namespace {
+
+std::shared_ptr<FontSkia> LoadFont(const std::string& file_name) {
+  const std::string path = GetFontDir() + "/" + file_name;
+  return std::make_shared<FontSkia>(SkTypeface::MakeFromFile(path.c_str()));
+}
+
+}  // namespace
+
+class FontSkiaTest : public ::testing::Test {
+ public:
+  void TearDown() override {
+    std::scoped_lock lock(minikin::gMinikinLock);
+    minikin::purgeHbFontCacheLocked();
+    minikin::setHbFontCacheCapacityLocked(
+        minikin::kDefaultHbFontCacheCapacity);
+  }
+};
+
+TEST_F(FontSkiaTest, ContentHashIdentifiesFontData) {
+  auto regular = LoadFont("Roboto-Regular.ttf");
+  auto regular_copy = LoadFont("Roboto-Regular.ttf");
+  auto bold = LoadFont("Roboto-Bold.ttf");
+  ASSERT_NE(regular->GetUniqueId(), regular_copy->GetUniqueId());
+
+  EXPECT_NE(regular->GetContentHash(), 0u);
+  EXPECT_EQ(regular->GetContentHash(), regular_copy->GetContentHash());
+  EXPECT_NE(regular->GetContentHash(), bold->GetContentHash());
+}
+
+TEST_F(FontSkiaTest, FontsWithSameDataShareHarfBuzzFont) {
+  auto regular = LoadFont("Roboto-Regular.ttf");
+  auto regular_copy = LoadFont("Roboto-Regular.ttf");
+  auto bold = LoadFont("Roboto-Bold.ttf");
+
+  std::scoped_lock lock(minikin::gMinikinLock);
+  minikin::purgeHbFontCacheLocked();
+  hb_font_t* font = minikin::getHbFontLocked(regular.get());
+  hb_font_t* font_copy = minikin::getHbFontLocked(regular_copy.get());
+  hb_font_t* bold_font = minikin::getHbFontLocked(bold.get());
+  EXPECT_EQ(font, font_copy);
+  EXPECT_NE(font, bold_font);
+
+  minikin::HbFontCacheStats stats = minikin::getHbFontCacheStatsLocked();
+  EXPECT_EQ(stats.entryCount, 3u);
+  EXPECT_EQ(stats.fontCount, 2u);
+
+  // The shared font outlives the font it was created for.
+  minikin::purgeHbFontLocked(regular.get());
+  regular.reset();
+  EXPECT_EQ(minikin::getHbFontLocked(regular_copy.get()), font_copy);
+  EXPECT_GT(hb_face_get_glyph_count(hb_font_get_face(font_copy)), 0u);
+  EXPECT_EQ(minikin::getHbFontCacheStatsLocked().fontCount, 2u);
+
+  hb_font_destroy(font);
+  hb_font_destroy(font_copy);
+  hb_font_destroy(font_copy);
+  hb_font_destroy(bold_font);
+}
+
+TEST_F(FontSkiaTest, HarfBuzzFontCacheCapacityIsConfigurable) {
+  auto regular = LoadFont("Roboto-Regular.ttf");
+  auto bold = LoadFont("Roboto-Bold.ttf");
+
+  std::scoped_lock lock(minikin::gMinikinLock);
+  minikin::purgeHbFontCacheLocked();
+  minikin::setHbFontCacheCapacityLocked(1);
+  hb_font_destroy(minikin::getHbFontLocked(regular.get()));
+  hb_font_destroy(minikin::getHbFontLocked(bold.get()));
+
+  minikin::HbFontCacheStats stats = minikin::getHbFontCacheStatsLocked();
+  EXPECT_EQ(stats.entryCount, 1u);
+  EXPECT_EQ(stats.fontCount, 1u);
+
+  minikin::setHbFontCacheCapacityLocked(0);
+  stats = minikin::getHbFontCacheStatsLocked();
+  EXPECT_EQ(stats.entryCount, 0u);
+  EXPECT_EQ(stats.fontCount, 0u);
+  EXPECT_EQ(stats.sharedDataBytes, 0u);
+}
+
+}  // namespace txt
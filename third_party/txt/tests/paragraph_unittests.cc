@@ -16,8 +16,10 @@
 
 #include <cstring>
 #include <iostream>
+#include <thread>
 
 #include "flutter/fml/logging.h"
+#include "minikin/Layout.h"
 #include "render_test.h"
 #include "third_party/icu/source/common/unicode/unistr.h"
 #include "third_party/skia/include/core/SkColor.h"
@@ -5919,6 +5921,58 @@ TEST_F(ParagraphTest, RepeatLayoutParagraph) {
   ASSERT_TRUE(Snapshot());
 }
 
+TEST_F(ParagraphTest, RelayoutAtOtherWidthsMatchesFreshLayout) {
+  const char* text =
+      "Sentence to layout at diff widths to get diff line counts. short words "
+      "short words short words short words short words\nAfter a hard break "
+      "short words short words Supercalifragilisticexpialidocious end";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  for (auto strategy :
+       {minikin::kBreakStrategy_Greedy, minikin::kBreakStrategy_HighQuality}) {
+    txt::ParagraphStyle paragraph_style;
+    paragraph_style.break_strategy = strategy;
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    text_style.font_size = 31;
+    text_style.color = SK_ColorBLACK;
+
+    auto build_paragraph = [&]() {
+      txt::ParagraphBuilderTxt builder(paragraph_style,
+                                       GetTestFontCollection());
+      builder.PushStyle(text_style);
+      builder.AddText(u16_text);
+      builder.Pop();
+      return BuildParagraph(builder);
+    };
+
+    auto paragraph = build_paragraph();
+    for (double width : {600.0, 300.0, 100.0, 450.0, 600.0}) {
+      paragraph->Layout(width);
+      auto fresh_paragraph = build_paragraph();
+      fresh_paragraph->Layout(width);
+
+      ASSERT_EQ(paragraph->GetLineCount(), fresh_paragraph->GetLineCount());
+      for (size_t i = 0; i < paragraph->GetLineCount(); i++) {
+        EXPECT_EQ(paragraph->line_metrics_[i].start_index,
+                  fresh_paragraph->line_metrics_[i].start_index);
+        EXPECT_EQ(paragraph->line_metrics_[i].end_index,
+                  fresh_paragraph->line_metrics_[i].end_index);
+        EXPECT_DOUBLE_EQ(paragraph->line_widths_[i],
+                         fresh_paragraph->line_widths_[i]);
+      }
+      EXPECT_DOUBLE_EQ(paragraph->GetMaxIntrinsicWidth(),
+                       fresh_paragraph->GetMaxIntrinsicWidth());
+      EXPECT_DOUBLE_EQ(paragraph->GetMinIntrinsicWidth(),
+                       fresh_paragraph->GetMinIntrinsicWidth());
+      EXPECT_DOUBLE_EQ(paragraph->GetHeight(), fresh_paragraph->GetHeight());
+      EXPECT_EQ(paragraph->block_breaks_.size(), 2ull);
+    }
+  }
+}
+
 TEST_F(ParagraphTest, Ellipsize) {
   const char* text =
       "This is a very long sentence to test if the text will properly wrap "
@@ -7117,4 +7171,276 @@ TEST_F(ParagraphTest, MixedTextHeightBehaviorRectsParagraph) {
 
   ASSERT_TRUE(Snapshot());
 }
+
+TEST_F(ParagraphTest, LayoutCacheIsReusedWithinBudget) {
+  const char* text = "Cached words are cached";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+
+  auto layout_text = [&]() {
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    auto paragraph = BuildParagraph(builder);
+    paragraph->Layout(GetTestCanvasWidth());
+  };
+
+  minikin::Layout::purgeCaches();
+  layout_text();
+  minikin::LayoutCacheStats first = minikin::Layout::getCacheStats();
+  EXPECT_GT(first.entryCount, 0u);
+  EXPECT_GT(first.byteCount, 0u);
+  EXPECT_LE(first.byteCount, first.maxBytes);
+
+  layout_text();
+  minikin::LayoutCacheStats second = minikin::Layout::getCacheStats();
+  EXPECT_EQ(second.entryCount, first.entryCount);
+  EXPECT_EQ(second.missCount, first.missCount);
+  EXPECT_GT(second.hitCount, first.hitCount);
+
+  const size_t max_bytes = first.maxBytes;
+  minikin::Layout::setCacheMaxBytes(0);
+  EXPECT_EQ(minikin::Layout::getCacheStats().entryCount, 0u);
+  layout_text();
+  EXPECT_EQ(minikin::Layout::getCacheStats().entryCount, 0u);
+  EXPECT_EQ(minikin::Layout::getCacheStats().byteCount, 0u);
+  minikin::Layout::setCacheMaxBytes(max_bytes);
+}
+
+TEST_F(ParagraphTest, WarmUpTaskFillsLayoutCache) {
+  const char* text = "Words shaped on another thread";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+
+  auto build_paragraph = [&]() {
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    return BuildParagraph(builder);
+  };
+
+  minikin::Layout::purgeCaches();
+  std::function<void()> task = build_paragraph()->CreateWarmUpTask();
+  ASSERT_TRUE(task);
+  EXPECT_EQ(minikin::Layout::getCacheStats().entryCount, 0u);
+
+  // The paragraph that created the task is already gone.
+  std::thread worker(task);
+  worker.join();
+  minikin::LayoutCacheStats warmed = minikin::Layout::getCacheStats();
+  EXPECT_GT(warmed.entryCount, 0u);
+
+  auto paragraph = build_paragraph();
+  paragraph->Layout(GetTestCanvasWidth());
+  ASSERT_EQ(paragraph->GetLineCount(), 1ull);
+  minikin::LayoutCacheStats laid_out = minikin::Layout::getCacheStats();
+  EXPECT_EQ(laid_out.missCount, warmed.missCount);
+  EXPECT_GT(laid_out.hitCount, warmed.hitCount);
+}
+
+TEST_F(ParagraphTest, LayoutMetricsOnlyDefersTextBlobs) {
+  const char* text =
+      "A paragraph that is measured many times but painted only once, "
+      "wrapping onto several lines.";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.font_size = 26;
+  text_style.color = SK_ColorBLACK;
+
+  auto build_paragraph = [&]() {
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    return BuildParagraph(builder);
+  };
+
+  auto full = build_paragraph();
+  full->Layout(300);
+  auto measured = build_paragraph();
+  measured->LayoutMetricsOnly(300);
+
+  ASSERT_GT(measured->GetLineCount(), 1ull);
+  EXPECT_EQ(measured->GetLineCount(), full->GetLineCount());
+  EXPECT_EQ(measured->GetHeight(), full->GetHeight());
+  EXPECT_EQ(measured->GetLongestLine(), full->GetLongestLine());
+  EXPECT_EQ(measured->GetMinIntrinsicWidth(), full->GetMinIntrinsicWidth());
+  EXPECT_EQ(measured->GetMaxIntrinsicWidth(), full->GetMaxIntrinsicWidth());
+  EXPECT_EQ(measured->GetAlphabeticBaseline(), full->GetAlphabeticBaseline());
+  auto measured_boxes = measured->GetRectsForRange(
+      0, u16_text.length(), Paragraph::RectHeightStyle::kTight,
+      Paragraph::RectWidthStyle::kTight);
+  auto full_boxes = full->GetRectsForRange(0, u16_text.length(),
+                                           Paragraph::RectHeightStyle::kTight,
+                                           Paragraph::RectWidthStyle::kTight);
+  ASSERT_EQ(measured_boxes.size(), full_boxes.size());
+  for (size_t i = 0; i < full_boxes.size(); ++i) {
+    EXPECT_EQ(measured_boxes[i].rect, full_boxes[i].rect);
+  }
+  EXPECT_EQ(measured->GetGlyphPositionAtCoordinate(120, 40).position,
+            full->GetGlyphPositionAtCoordinate(120, 40).position);
+
+  ASSERT_EQ(measured->records_.size(), full->records_.size());
+  for (const PaintRecord& record : measured->records_) {
+    EXPECT_EQ(record.text(), nullptr);
+  }
+
+  // Measuring again at the same width keeps the text blobs deferred.
+  measured->LayoutMetricsOnly(300);
+  EXPECT_EQ(measured->records_[0].text(), nullptr);
+
+  measured->Paint(GetCanvas(), 10.0, 15.0);
+  ASSERT_EQ(measured->records_.size(), full->records_.size());
+  for (size_t i = 0; i < full->records_.size(); ++i) {
+    ASSERT_NE(measured->records_[i].text(), nullptr);
+    EXPECT_EQ(measured->records_[i].text()->bounds(),
+              full->records_[i].text()->bounds());
+    EXPECT_EQ(measured->records_[i].offset(), full->records_[i].offset());
+  }
+  EXPECT_EQ(measured->GetHeight(), full->GetHeight());
+
+  ASSERT_TRUE(Snapshot());
+}
+
+TEST_F(ParagraphTest, RepaintReplaysRecordedPicture) {
+  const char* text = "Static text that is painted every frame";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.font_size = 26;
+  text_style.color = SK_ColorBLACK;
+  text_style.decoration = TextDecoration::kUnderline;
+  text_style.text_shadows.emplace_back(SK_ColorRED, SkPoint::Make(5, 40), 2);
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(GetTestCanvasWidth());
+
+  paragraph->Paint(GetCanvas(), 10.0, 15.0);
+  EXPECT_EQ(paragraph->paint_picture_, nullptr);
+
+  paragraph->Paint(GetCanvas(), 10.0, 15.0);
+  ASSERT_NE(paragraph->paint_picture_, nullptr);
+  SkPicture* picture = paragraph->paint_picture_.get();
+  // The recording is made at the painted offset and covers the shadow drawn
+  // below the text.
+  EXPECT_GE(picture->cullRect().bottom(),
+            15.0 + paragraph->records_[0].metrics().fDescent + 40);
+
+  paragraph->Paint(GetCanvas(), 10.0, 15.0);
+  EXPECT_EQ(paragraph->paint_picture_.get(), picture);
+  ASSERT_TRUE(Snapshot());
+
+  // Painting at another offset drops the recording.
+  paragraph->Paint(GetCanvas(), 10.0, 65.0);
+  EXPECT_EQ(paragraph->paint_picture_, nullptr);
+
+  paragraph->Paint(GetCanvas(), 10.0, 65.0);
+  ASSERT_NE(paragraph->paint_picture_, nullptr);
+
+  paragraph->Layout(GetTestCanvasWidth() / 2);
+  EXPECT_EQ(paragraph->paint_picture_, nullptr);
+}
+
+TEST_F(ParagraphTest, RepaintRecordingCoversStrokedForeground) {
+  const char* text = "Outlined text";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.font_size = 26;
+  text_style.has_foreground = true;
+  text_style.foreground.setStyle(SkPaint::kStroke_Style);
+  text_style.foreground.setStrokeWidth(20);
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(GetTestCanvasWidth());
+
+  paragraph->Paint(GetCanvas(), 0, 0);
+  paragraph->Paint(GetCanvas(), 0, 0);
+  ASSERT_NE(paragraph->paint_picture_, nullptr);
+  const PaintRecord& record = paragraph->records_[0];
+  SkRect text_bounds = record.text()->bounds().makeOffset(record.offset());
+  EXPECT_TRUE(paragraph->paint_picture_->cullRect().contains(
+      text_bounds.makeOutset(10, 10)));
+}
+
+TEST_F(ParagraphTest, HitTestingAndRangesOnLongParagraph) {
+  std::u16string u16_text;
+  for (int i = 0; i < 200; i++) {
+    u16_text += u"Editor paragraph line with several words ";
+  }
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.font_size = 20;
+  text_style.color = SK_ColorBLACK;
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(300);
+
+  std::vector<LineMetrics>& lines = paragraph->GetLineMetrics();
+  ASSERT_GT(lines.size(), 50ull);
+  double line_top = 0;
+  for (const LineMetrics& line : lines) {
+    EXPECT_EQ(paragraph->GetGlyphPositionAtCoordinate(-10, line.height - 1)
+                  .position,
+              line.start_index);
+    auto boxes = paragraph->GetRectsForRange(
+        line.start_index, line.end_index, Paragraph::RectHeightStyle::kMax,
+        Paragraph::RectWidthStyle::kTight);
+    ASSERT_FALSE(boxes.empty());
+    for (const Paragraph::TextBox& box : boxes) {
+      EXPECT_GE(box.rect.top(), line_top - 1);
+      EXPECT_LE(box.rect.bottom(), line.height + 1);
+    }
+    line_top = line.height;
+  }
+  // Points below the text hit the last line.
+  EXPECT_EQ(paragraph->GetGlyphPositionAtCoordinate(-10, line_top + 100)
+                .position,
+            lines.back().start_index);
+}
+
 }  // namespace txt
@@ -6,6 +6,7 @@
 
 #include <limits>
 
+#include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/gpu/vk/GrVkTypes.h"
 #include "vulkan/vulkan.h"
 #include "vulkan_proc_table.h"
@@ -14,11 +15,12 @@ namespace vulkan {
 
 VulkanBackbuffer::VulkanBackbuffer(const VulkanProcTable& p_vk,
                                    const VulkanHandle<VkDevice>& device,
-                                   const VulkanHandle<VkCommandPool>& pool)
+                                   uint32_t queue_family_index)
     : vk(p_vk),
       device_(device),
-      usage_command_buffer_(p_vk, device, pool),
-      render_command_buffer_(p_vk, device, pool),
+      pool_(CreateCommandPool(queue_family_index)),
+      usage_command_buffer_(p_vk, device, pool_),
+      render_command_buffer_(p_vk, device, pool_),
       valid_(false) {
   if (!usage_command_buffer_.IsValid() || !render_command_buffer_.IsValid()) {
     FML_DLOG(INFO) << "Command buffers were not valid.";
@@ -46,6 +48,28 @@ bool VulkanBackbuffer::IsValid() const {
   return valid_;
 }
 
+VulkanHandle<VkCommandPool> VulkanBackbuffer::CreateCommandPool(
+    uint32_t queue_family_index) {
+  // The command buffers are only reset all at once through their pool, and
+  // re-recorded every frame.
+  const VkCommandPoolCreateInfo create_info = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+      .queueFamilyIndex = queue_family_index,
+  };
+
+  VkCommandPool pool = VK_NULL_HANDLE;
+  if (VK_CALL_LOG_ERROR(vk.CreateCommandPool(device_, &create_info, nullptr,
+                                             &pool)) != VK_SUCCESS) {
+    return {};
+  }
+
+  return {pool, [this](VkCommandPool pool) {
+            vk.DestroyCommandPool(device_, pool, nullptr);
+          }};
+}
+
 bool VulkanBackbuffer::CreateSemaphores() {
   const VkSemaphoreCreateInfo create_info = {
       .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
@@ -97,6 +121,10 @@ bool VulkanBackbuffer::CreateFences() {
 }
 
 bool VulkanBackbuffer::WaitFences() {
+  // Shows how long the CPU is stalled waiting for the GPU to release this
+  // backbuffer.
+  TRACE_EVENT0("flutter", "VulkanBackbuffer::WaitFences");
+
   VkFence fences[use_fences_.size()];
 
   for (size_t i = 0; i < use_fences_.size(); i++) {
@@ -120,6 +148,11 @@ bool VulkanBackbuffer::ResetFences() {
          VK_SUCCESS;
 }
 
+bool VulkanBackbuffer::ResetCommandBuffers() {
+  return VK_CALL_LOG_ERROR(vk.ResetCommandPool(device_, pool_, 0)) ==
+         VK_SUCCESS;
+}
+
 const VulkanHandle<VkFence>& VulkanBackbuffer::GetUsageFence() const {
   return use_fences_[0];
 }
@@ -18,9 +18,11 @@ namespace vulkan {
 
 class VulkanBackbuffer {
  public:
+  // Creates a backbuffer whose command buffers are allocated from a pool of
+  // its own, on the queue family at |queue_family_index|.
   VulkanBackbuffer(const VulkanProcTable& vk,
                    const VulkanHandle<VkDevice>& device,
-                   const VulkanHandle<VkCommandPool>& pool);
+                   uint32_t queue_family_index);
 
   ~VulkanBackbuffer();
 
@@ -30,6 +32,10 @@ class VulkanBackbuffer {
 
   [[nodiscard]] bool ResetFences();
 
+  // Resets both command buffers at once by resetting their pool. The fences
+  // must have been waited on so that the GPU is done with them.
+  [[nodiscard]] bool ResetCommandBuffers();
+
   const VulkanHandle<VkFence>& GetUsageFence() const;
 
   const VulkanHandle<VkFence>& GetRenderFence() const;
@@ -45,12 +51,16 @@ class VulkanBackbuffer {
  private:
   const VulkanProcTable& vk;
   const VulkanHandle<VkDevice>& device_;
+  // Declared before the command buffers, which are allocated from it.
+  VulkanHandle<VkCommandPool> pool_;
   std::array<VulkanHandle<VkSemaphore>, 2> semaphores_;
   std::array<VulkanHandle<VkFence>, 2> use_fences_;
   VulkanCommandBuffer usage_command_buffer_;
   VulkanCommandBuffer render_command_buffer_;
   bool valid_;
 
+  VulkanHandle<VkCommandPool> CreateCommandPool(uint32_t queue_family_index);
+
   bool CreateSemaphores();
 
   bool CreateFences();
@@ -52,7 +52,9 @@ bool VulkanCommandBuffer::Begin() const {
   const VkCommandBufferBeginInfo info{
       .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
       .pNext = nullptr,
-      .flags = 0,
+      // Command buffers are recorded again before every submission, which lets
+      // the driver skip preparing them for reuse.
+      .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
       .pInheritanceInfo = nullptr,
   };
 
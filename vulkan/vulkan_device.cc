@@ -4,6 +4,7 @@
 
 #include "vulkan_device.h"
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <vector>
@@ -316,6 +317,7 @@ int VulkanDevice::ChooseSurfaceFormat(const VulkanSurface& surface,
 }
 
 bool VulkanDevice::ChoosePresentMode(const VulkanSurface& surface,
+                                     VkPresentModeKHR desired_present_mode,
                                      VkPresentModeKHR* present_mode) const {
   if (!surface.IsValid() || present_mode == nullptr) {
     return false;
@@ -328,10 +330,37 @@ bool VulkanDevice::ChoosePresentMode(const VulkanSurface& surface,
   // powered by Vsync pulses instead of depending the submit to block.
   // However, for platforms that don't have VSync providers set up, it is better
   // to fall back to FIFO. For platforms that do have VSync providers, there
-  // should be little difference. In case there is a need for a mode other than
-  // FIFO, availability checks must be performed here before returning the
-  // result. FIFO is always present.
+  // should be little difference. Other modes, which may lower the latency, are
+  // only used when requested and available. FIFO is always present.
   *present_mode = VK_PRESENT_MODE_FIFO_KHR;
+
+#if OS_ANDROID
+  if (desired_present_mode == VK_PRESENT_MODE_FIFO_KHR) {
+    return true;
+  }
+
+  uint32_t mode_count = 0;
+  if (VK_CALL_LOG_ERROR(vk.GetPhysicalDeviceSurfacePresentModesKHR(
+          physical_device_, surface.Handle(), &mode_count, nullptr)) !=
+      VK_SUCCESS) {
+    return true;
+  }
+
+  std::vector<VkPresentModeKHR> modes(mode_count);
+  if (VK_CALL_LOG_ERROR(vk.GetPhysicalDeviceSurfacePresentModesKHR(
+          physical_device_, surface.Handle(), &mode_count, modes.data())) !=
+      VK_SUCCESS) {
+    return true;
+  }
+
+  if (std::find(modes.begin(), modes.end(), desired_present_mode) !=
+      modes.end()) {
+    *present_mode = desired_present_mode;
+  } else {
+    FML_DLOG(INFO) << "Present mode " << desired_present_mode
+                   << " is not supported. Falling back to FIFO.";
+  }
+#endif  // OS_ANDROID
   return true;
 }
 
@@ -52,7 +52,10 @@ class VulkanDevice {
                                         std::vector<VkFormat> desired_formats,
                                         VkSurfaceFormatKHR* format) const;
 
+  // Chooses |desired_present_mode| if the surface supports it, and FIFO,
+  // which every surface supports, otherwise.
   [[nodiscard]] bool ChoosePresentMode(const VulkanSurface& surface,
+                                       VkPresentModeKHR desired_present_mode,
                                        VkPresentModeKHR* present_mode) const;
 
   [[nodiscard]] bool QueueSubmit(
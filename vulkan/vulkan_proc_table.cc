@@ -22,6 +22,20 @@ VulkanProcTable::VulkanProcTable()
       OpenLibraryHandle() && SetupLoaderProcAddresses();
 }
 
+VulkanProcTable::VulkanProcTable(
+    GetInstanceProcAddrCallback get_instance_proc_addr)
+    : handle_(nullptr),
+      acquired_mandatory_proc_addresses_(false),
+      get_instance_proc_addr_(std::move(get_instance_proc_addr)) {
+  VulkanHandle<VkInstance> null_instance(VK_NULL_HANDLE, nullptr);
+  acquired_mandatory_proc_addresses_ = [&]() -> bool {
+    ACQUIRE_PROC(CreateInstance, null_instance);
+    ACQUIRE_PROC(EnumerateInstanceExtensionProperties, null_instance);
+    ACQUIRE_PROC(EnumerateInstanceLayerProperties, null_instance);
+    return true;
+  }();
+}
+
 VulkanProcTable::~VulkanProcTable() {
   CloseLibraryHandle();
 }
@@ -127,6 +141,7 @@ bool VulkanProcTable::SetupDeviceProcAddresses(
   ACQUIRE_PROC(QueueSubmit, handle);
   ACQUIRE_PROC(QueueWaitIdle, handle);
   ACQUIRE_PROC(ResetCommandBuffer, handle);
+  ACQUIRE_PROC(ResetCommandPool, handle);
   ACQUIRE_PROC(ResetFences, handle);
   ACQUIRE_PROC(WaitForFences, handle);
 #if OS_ANDROID
@@ -185,7 +200,15 @@ bool VulkanProcTable::CloseLibraryHandle() {
 PFN_vkVoidFunction VulkanProcTable::AcquireProc(
     const char* proc_name,
     const VulkanHandle<VkInstance>& instance) const {
-  if (proc_name == nullptr || !GetInstanceProcAddr) {
+  if (proc_name == nullptr) {
+    return nullptr;
+  }
+
+  if (get_instance_proc_addr_) {
+    return get_instance_proc_addr_(instance, proc_name);
+  }
+
+  if (!GetInstanceProcAddr) {
     return nullptr;
   }
 
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_VULKAN_VULKAN_PROC_TABLE_H_
 #define FLUTTER_VULKAN_VULKAN_PROC_TABLE_H_
 
+#include <functional>
+
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
@@ -20,6 +22,9 @@ class VulkanProcTable : public fml::RefCountedThreadSafe<VulkanProcTable> {
   FML_FRIEND_MAKE_REF_COUNTED(VulkanProcTable);
 
  public:
+  using GetInstanceProcAddrCallback =
+      std::function<PFN_vkVoidFunction(VkInstance, const char*)>;
+
   template <class T>
   class Proc {
    public:
@@ -103,6 +108,7 @@ class VulkanProcTable : public fml::RefCountedThreadSafe<VulkanProcTable> {
   DEFINE_PROC(QueueSubmit);
   DEFINE_PROC(QueueWaitIdle);
   DEFINE_PROC(ResetCommandBuffer);
+  DEFINE_PROC(ResetCommandPool);
   DEFINE_PROC(ResetFences);
   DEFINE_PROC(WaitForFences);
 #if OS_ANDROID
@@ -130,8 +136,13 @@ class VulkanProcTable : public fml::RefCountedThreadSafe<VulkanProcTable> {
   bool acquired_mandatory_proc_addresses_;
   VulkanHandle<VkInstance> instance_;
   VulkanHandle<VkDevice> device_;
+  GetInstanceProcAddrCallback get_instance_proc_addr_;
 
   VulkanProcTable();
+  // Creates a proc table that looks up procs through the given callback
+  // instead of opening the Vulkan library, for instances and devices created
+  // by an embedder.
+  explicit VulkanProcTable(GetInstanceProcAddrCallback get_instance_proc_addr);
   ~VulkanProcTable();
   bool OpenLibraryHandle();
   bool SetupLoaderProcAddresses();
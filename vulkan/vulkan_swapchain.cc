@@ -4,6 +4,8 @@
 
 #include "vulkan_swapchain.h"
 
+#include <algorithm>
+
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/vk/GrVkTypes.h"
@@ -41,7 +43,8 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
                                  const VulkanSurface& surface,
                                  GrDirectContext* skia_context,
                                  std::unique_ptr<VulkanSwapchain> old_swapchain,
-                                 uint32_t queue_family_index)
+                                 uint32_t queue_family_index,
+                                 const VulkanSwapchainConfig& config)
     : vk(p_vk),
       device_(device),
       capabilities_(),
@@ -79,7 +82,8 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
   }
 
   VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
-  if (!device_.ChoosePresentMode(surface, &present_mode)) {
+  if (!device_.ChoosePresentMode(surface, config.present_mode,
+                                 &present_mode)) {
     FML_DLOG(INFO) << "Could not choose present mode.";
     return;
   }
@@ -113,6 +117,14 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
 
   VkSurfaceKHR surface_handle = surface.Handle();
 
+  // Keep an image available for presentation while the frames in flight are
+  // being rendered.
+  uint32_t image_count = std::max(capabilities_.minImageCount,
+                                  config.frames_in_flight + 1);
+  if (capabilities_.maxImageCount > 0) {
+    image_count = std::min(image_count, capabilities_.maxImageCount);
+  }
+
   VkImageUsageFlags usage_flags = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
                                   VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
                                   VK_IMAGE_USAGE_TRANSFER_DST_BIT;
@@ -122,7 +134,7 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
       .pNext = nullptr,
       .flags = 0,
       .surface = surface_handle,
-      .minImageCount = capabilities_.minImageCount,
+      .minImageCount = image_count,
       .imageFormat = surface_format_.format,
       .imageColorSpace = surface_format_.colorSpace,
       .imageExtent = capabilities_.currentExtent,
@@ -155,7 +167,8 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
 
   if (!CreateSwapchainImages(
           skia_context, format_infos[format_index].color_type_,
-          format_infos[format_index].color_space_, usage_flags)) {
+          format_infos[format_index].color_space_, usage_flags,
+          config.frames_in_flight)) {
     FML_DLOG(INFO) << "Could not create swapchain images.";
     return;
   }
@@ -254,26 +267,34 @@ sk_sp<SkSurface> VulkanSwapchain::CreateSkiaSurface(
 bool VulkanSwapchain::CreateSwapchainImages(GrDirectContext* skia_context,
                                             SkColorType color_type,
                                             sk_sp<SkColorSpace> color_space,
-                                            VkImageUsageFlags usage_flags) {
+                                            VkImageUsageFlags usage_flags,
+                                            uint32_t frames_in_flight) {
   std::vector<VkImage> images = GetImages();
 
   if (images.size() == 0) {
     return false;
   }
 
-  const SkISize surface_size = GetSize();
+  // The backbuffers bound the frames in flight, independently of the images.
+  size_t backbuffer_count = images.size();
+  if (frames_in_flight > 0 && frames_in_flight < backbuffer_count) {
+    backbuffer_count = frames_in_flight;
+  }
 
-  for (const VkImage& image : images) {
-    // Populate the backbuffer.
+  for (size_t i = 0; i < backbuffer_count; i++) {
     auto backbuffer = std::make_unique<VulkanBackbuffer>(
-        vk, device_.GetHandle(), device_.GetCommandPool());
+        vk, device_.GetHandle(), device_.GetGraphicsQueueIndex());
 
     if (!backbuffer->IsValid()) {
       return false;
     }
 
     backbuffers_.emplace_back(std::move(backbuffer));
+  }
 
+  const SkISize surface_size = GetSize();
+
+  for (const VkImage& image : images) {
     // Populate the image.
     auto vulkan_image = std::make_unique<VulkanImage>(image);
 
@@ -294,7 +315,7 @@ bool VulkanSwapchain::CreateSwapchainImages(GrDirectContext* skia_context,
     surfaces_.emplace_back(std::move(surface));
   }
 
-  FML_DCHECK(backbuffers_.size() == images_.size());
+  FML_DCHECK(backbuffers_.size() <= images_.size());
   FML_DCHECK(images_.size() == surfaces_.size());
 
   return true;
@@ -357,6 +378,13 @@ VulkanSwapchain::AcquireResult VulkanSwapchain::AcquireSurface() {
     return error;
   }
 
+  // The GPU is done with the command buffers of the backbuffer, so they can
+  // all be reset with a single call before this frame records them again.
+  if (!backbuffer->ResetCommandBuffers()) {
+    FML_DLOG(INFO) << "Could not reset the command buffers.";
+    return error;
+  }
+
   // ---------------------------------------------------------------------------
   // Step 3:
   // Acquire the next image index.
@@ -23,6 +23,19 @@ class VulkanSurface;
 class VulkanBackbuffer;
 class VulkanImage;
 
+/// How a swapchain presents its images.
+struct VulkanSwapchainConfig {
+  /// The present mode to use if the surface supports it. MAILBOX or
+  /// FIFO_RELAXED can lower the latency. Falls back to FIFO otherwise.
+  VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
+
+  /// The number of frames that may be rendered before the oldest one has been
+  /// consumed by the GPU, each with its own backbuffer. The swapchain has at
+  /// least one more image than this, if the surface allows it. Zero uses one
+  /// frame per swapchain image.
+  uint32_t frames_in_flight = 0;
+};
+
 class VulkanSwapchain {
  public:
   VulkanSwapchain(const VulkanProcTable& vk,
@@ -30,7 +43,8 @@ class VulkanSwapchain {
                   const VulkanSurface& surface,
                   GrDirectContext* skia_context,
                   std::unique_ptr<VulkanSwapchain> old_swapchain,
-                  uint32_t queue_family_index);
+                  uint32_t queue_family_index,
+                  const VulkanSwapchainConfig& config);
 
   ~VulkanSwapchain();
 
@@ -80,7 +94,8 @@ class VulkanSwapchain {
   bool CreateSwapchainImages(GrDirectContext* skia_context,
                              SkColorType color_type,
                              sk_sp<SkColorSpace> color_space,
-                             VkImageUsageFlags usage_flags);
+                             VkImageUsageFlags usage_flags,
+                             uint32_t frames_in_flight);
 
   sk_sp<SkSurface> CreateSkiaSurface(GrDirectContext* skia_context,
                                      VkImage image,
@@ -9,6 +9,8 @@
 #include <memory>
 #include <string>
 
+#include "flutter/common/graphics/persistent_cache.h"
+#include "third_party/skia/include/gpu/GrContextOptions.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "vulkan_application.h"
 #include "vulkan_device.h"
@@ -30,7 +32,21 @@ VulkanWindow::VulkanWindow(const sk_sp<GrDirectContext>& context,
                            fml::RefPtr<VulkanProcTable> proc_table,
                            std::unique_ptr<VulkanNativeSurface> native_surface,
                            bool render_to_surface)
-    : valid_(false), vk(std::move(proc_table)), skia_gr_context_(context) {
+    : VulkanWindow(context,
+                   std::move(proc_table),
+                   std::move(native_surface),
+                   render_to_surface,
+                   VulkanSwapchainConfig{}) {}
+
+VulkanWindow::VulkanWindow(const sk_sp<GrDirectContext>& context,
+                           fml::RefPtr<VulkanProcTable> proc_table,
+                           std::unique_ptr<VulkanNativeSurface> native_surface,
+                           bool render_to_surface,
+                           const VulkanSwapchainConfig& swapchain_config)
+    : valid_(false),
+      vk(std::move(proc_table)),
+      swapchain_config_(swapchain_config),
+      skia_gr_context_(context) {
   if (!vk || !vk->HasAcquiredMandatoryProcAddresses()) {
     FML_DLOG(INFO) << "Proc table has not acquired mandatory proc addresses.";
     return;
@@ -119,7 +135,17 @@ bool VulkanWindow::CreateSkiaGrContext() {
     return false;
   }
 
-  sk_sp<GrDirectContext> context = GrDirectContext::MakeVulkan(backend_context);
+  GrContextOptions options;
+  if (flutter::PersistentCache::cache_sksl()) {
+    options.fShaderCacheStrategy = GrContextOptions::ShaderCacheStrategy::kSkSL;
+  }
+  flutter::PersistentCache::MarkStrategySet();
+  // Skia also loads and stores the VkPipelineCache through this cache, which
+  // it validates against the vendor, device and pipeline cache UUID.
+  options.fPersistentCache = flutter::PersistentCache::GetCacheForProcess();
+
+  sk_sp<GrDirectContext> context =
+      GrDirectContext::MakeVulkan(backend_context, options);
 
   if (context == nullptr) {
     return false;
@@ -127,6 +153,9 @@ bool VulkanWindow::CreateSkiaGrContext() {
 
   context->setResourceCacheLimits(kGrCacheMaxCount, kGrCacheMaxByteSize);
 
+  flutter::PersistentCache::GetCacheForProcess()->PrecompileKnownSkSLs(
+      context.get());
+
   skia_gr_context_ = context;
 
   return true;
@@ -256,7 +285,8 @@ bool VulkanWindow::RecreateSwapchain() {
 
   auto swapchain = std::make_unique<VulkanSwapchain>(
       *vk, *logical_device_, *surface_, skia_gr_context_.get(),
-      std::move(old_swapchain), logical_device_->GetGraphicsQueueIndex());
+      std::move(old_swapchain), logical_device_->GetGraphicsQueueIndex(),
+      swapchain_config_);
 
   if (!swapchain->IsValid()) {
     return false;
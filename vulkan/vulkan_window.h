@@ -18,13 +18,13 @@
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/vk/GrVkBackendContext.h"
 #include "vulkan_proc_table.h"
+#include "vulkan_swapchain.h"
 
 namespace vulkan {
 
 class VulkanNativeSurface;
 class VulkanDevice;
 class VulkanSurface;
-class VulkanSwapchain;
 class VulkanImage;
 class VulkanApplication;
 class VulkanBackbuffer;
@@ -48,6 +48,17 @@ class VulkanWindow {
                std::unique_ptr<VulkanNativeSurface> native_surface,
                bool render_to_surface);
 
+  //------------------------------------------------------------------------------
+  /// @brief      Construct a VulkanWindow whose swapchains present with
+  ///             `swapchain_config`. The context may be null, in which case
+  ///             the window creates its own GrDirectContext.
+  ///
+  VulkanWindow(const sk_sp<GrDirectContext>& context,
+               fml::RefPtr<VulkanProcTable> proc_table,
+               std::unique_ptr<VulkanNativeSurface> native_surface,
+               bool render_to_surface,
+               const VulkanSwapchainConfig& swapchain_config);
+
   ~VulkanWindow();
 
   bool IsValid() const;
@@ -65,6 +76,7 @@ class VulkanWindow {
   std::unique_ptr<VulkanDevice> logical_device_;
   std::unique_ptr<VulkanSurface> surface_;
   std::unique_ptr<VulkanSwapchain> swapchain_;
+  VulkanSwapchainConfig swapchain_config_;
   sk_sp<GrDirectContext> skia_gr_context_;
 
   bool CreateSkiaGrContext();